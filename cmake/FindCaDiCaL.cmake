@@ -23,16 +23,28 @@ if(CaDiCaL_INCLUDE_DIR AND CaDiCaL_LIBRARIES)
   set(CaDiCaL_FOUND_SYSTEM TRUE)
 
   # Unfortunately it is not part of the headers
-  find_library(CaDiCaL_BINARY NAMES cadical)
+  find_program(CaDiCaL_BINARY NAMES cadical)
   if(CaDiCaL_BINARY)
     execute_process(
-      COMMAND ${CaDiCaL_BINARY} --version OUTPUT_VARIALE CaDiCaL_VERSION
+      COMMAND ${CaDiCaL_BINARY} --version
+      OUTPUT_VARIABLE CaDiCaL_VERSION
+      OUTPUT_STRIP_TRAILING_WHITESPACE
     )
   else()
     set(CaDiCaL_VERSION "")
   endif()
 
   check_system_version("CaDiCaL")
+  if(NOT CaDiCaL_FOUND_SYSTEM)
+    # the CDCL(T) backend needs the external propagator interface of 2.0.0
+    if(CaDiCaL_VERSION)
+      message(STATUS "System CaDiCaL ${CaDiCaL_VERSION} is older than the \
+required ${CaDiCaL_FIND_VERSION}, building CaDiCaL from source instead")
+    else()
+      message(STATUS "Could not determine the version of the system CaDiCaL \
+(no cadical binary found), building CaDiCaL from source instead")
+    endif()
+  endif()
 endif()
 
 if(NOT CaDiCaL_FOUND_SYSTEM)
@@ -41,7 +53,7 @@ if(NOT CaDiCaL_FOUND_SYSTEM)
 
   fail_if_include_missing("sys/resource.h" "CaDiCaL")
 
-  set(CaDiCaL_VERSION "1.2.1")
+  set(CaDiCaL_VERSION "2.0.0")
 
   # avoid configure script and instantiate the makefile manually the configure
   # scripts unnecessarily fails for cross compilation thus we do the bare
@@ -58,7 +70,7 @@ if(NOT CaDiCaL_FOUND_SYSTEM)
     ${COMMON_EP_CONFIG}
     BUILD_IN_SOURCE ON
     URL https://github.com/arminbiere/cadical/archive/refs/tags/rel-${CaDiCaL_VERSION}.tar.gz
-    URL_HASH SHA1=9de1176737b74440921ba86395fe5edbb3b131eb
+    URL_HASH SHA256=9afe5f6439442d854e56fc1fac3244ce241dbb490735939def8fd03584f89331
     CONFIGURE_COMMAND mkdir -p <SOURCE_DIR>/build
     # avoid configure script, prepare the makefile manually
     COMMAND ${CMAKE_COMMAND} -E copy <SOURCE_DIR>/makefile.in
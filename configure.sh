@@ -43,6 +43,7 @@ The following flags enable optional features (disable with --no-<option name>).
   --coverage               support for gcov coverage testing
   --profiling              support for gprof profiling
   --unit-testing           support for unit testing
+  --benchmarks             build microbenchmarks (requires Google Benchmark)
   --python2                force Python 2 (deprecated)
   --python-bindings        build Python bindings based on new C++ API
   --java-bindings          build Java bindings based on new C++ API
@@ -137,6 +138,7 @@ tracing=default
 tsan=default
 ubsan=default
 unit_testing=default
+benchmarks=default
 valgrind=default
 win64=default
 arm64=default
@@ -265,6 +267,9 @@ do
     --unit-testing) unit_testing=ON;;
     --no-unit-testing) unit_testing=OFF;;
 
+    --benchmarks) benchmarks=ON;;
+    --no-benchmarks) benchmarks=OFF;;
+
     --python2) python2=ON;;
     --no-python2) python2=OFF;;
 
@@ -377,6 +382,8 @@ cmake_opts=""
   && cmake_opts="$cmake_opts -DENABLE_TRACING=$tracing"
 [ $unit_testing != default ] \
   && cmake_opts="$cmake_opts -DENABLE_UNIT_TESTING=$unit_testing"
+[ $benchmarks != default ] \
+  && cmake_opts="$cmake_opts -DENABLE_BENCHMARKS=$benchmarks"
 [ $python2 != default ] \
   && cmake_opts="$cmake_opts -DUSE_PYTHON2=$python2"
 [ $python_bindings != default ] \
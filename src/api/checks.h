@@ -160,7 +160,7 @@ namespace api {
  * with.
  */
 #define CVC4_API_ARG_CHECK_SOLVER(what, arg)                              \
-  CVC4_API_CHECK(this->d_solver == arg.d_solver)                          \
+  CVC4_API_CHECK(Solver::sharesTerms(this->d_solver, arg.d_solver))       \
       << "Given " << (what) << " is not associated with the solver this " \
       << "object is associated with";
 
@@ -185,19 +185,19 @@ namespace api {
  * Check if each sort in the given container of sorts is not null and
  * associated with the solver object this object is associated with.
  */
-#define CVC4_API_CHECK_SORTS(sorts)                                         \
-  do                                                                        \
-  {                                                                         \
-    size_t i = 0;                                                           \
-    for (const auto& s : sorts)                                             \
-    {                                                                       \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("sort", s, sorts, i);            \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                 \
-          this->d_solver == s.d_solver, "sort", sorts, i)                   \
-          << "a sort associated with the solver this object is associated " \
-             "with";                                                        \
-      i += 1;                                                               \
-    }                                                                       \
+#define CVC4_API_CHECK_SORTS(sorts)                                          \
+  do                                                                         \
+  {                                                                          \
+    size_t i = 0;                                                            \
+    for (const auto& s : sorts)                                              \
+    {                                                                        \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("sort", s, sorts, i);             \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                  \
+          Solver::sharesTerms(this->d_solver, s.d_solver), "sort", sorts, i) \
+          << "a sort associated with the solver this object is associated "  \
+             "with";                                                         \
+      i += 1;                                                                \
+    }                                                                        \
   } while (0)
 
 /* -------------------------------------------------------------------------- */
@@ -221,19 +221,19 @@ namespace api {
  * Check if each term in the given container of terms is not null and
  * associated with the solver object this object is associated with.
  */
-#define CVC4_API_CHECK_TERMS(terms)                                         \
-  do                                                                        \
-  {                                                                         \
-    size_t i = 0;                                                           \
-    for (const auto& s : terms)                                             \
-    {                                                                       \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", s, terms, i);            \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                 \
-          this->d_solver == s.d_solver, "term", terms, i)                   \
-          << "a term associated with the solver this object is associated " \
-             "with";                                                        \
-      i += 1;                                                               \
-    }                                                                       \
+#define CVC4_API_CHECK_TERMS(terms)                                          \
+  do                                                                         \
+  {                                                                          \
+    size_t i = 0;                                                            \
+    for (const auto& s : terms)                                              \
+    {                                                                        \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", s, terms, i);             \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                  \
+          Solver::sharesTerms(this->d_solver, s.d_solver), "term", terms, i) \
+          << "a term associated with the solver this object is associated "  \
+             "with";                                                         \
+      i += 1;                                                                \
+    }                                                                        \
   } while (0)
 
 /**
@@ -250,12 +250,18 @@ namespace api {
     {                                                                       \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", p.first, map, i);        \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                 \
-          this->d_solver == p.first.d_solver, "term", map, i)               \
+          Solver::sharesTerms(this->d_solver, p.first.d_solver),            \
+          "term",                                                           \
+          map,                                                              \
+          i)                                                                \
           << "a term associated with the solver this object is associated " \
              "with";                                                        \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("sort", p.second, map, i);       \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                 \
-          this->d_solver == p.second.d_solver, "sort", map, i)              \
+          Solver::sharesTerms(this->d_solver, p.second.d_solver),           \
+          "sort",                                                           \
+          map,                                                              \
+          i)                                                                \
           << "a sort associated with the solver this object is associated " \
              "with";                                                        \
       i += 1;                                                               \
@@ -275,7 +281,7 @@ namespace api {
     {                                                                          \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", t, terms, i);               \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                    \
-          this->d_solver == t.d_solver, "term", terms, i)                      \
+          Solver::sharesTerms(this->d_solver, t.d_solver), "term", terms, i)   \
           << "a term associated with the solver this object is associated "    \
              "with";                                                           \
       CVC4_API_CHECK(t.getSort() == sort)                                      \
@@ -291,27 +297,27 @@ namespace api {
  * the solver object this object is associated with, and their sorts are
  * pairwise comparable to.
  */
-#define CVC4_API_TERM_CHECK_TERMS_WITH_TERMS_COMPARABLE_TO(terms1, terms2)  \
-  do                                                                        \
-  {                                                                         \
-    size_t i = 0;                                                           \
-    for (const auto& t1 : terms1)                                           \
-    {                                                                       \
-      const auto& t2 = terms2[i];                                           \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", t1, terms1, i);          \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                 \
-          this->d_solver == t1.d_solver, "term", terms1, i)                 \
-          << "a term associated with the solver this object is associated " \
-             "with";                                                        \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", t2, terms2, i);          \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                 \
-          this->d_solver == t2.d_solver, "term", terms2, i)                 \
-          << "a term associated with the solver this object is associated " \
-             "with";                                                        \
-      CVC4_API_CHECK(t1.getSort().isComparableTo(t2.getSort()))             \
-          << "Expecting terms of comparable sort at index " << i;           \
-      i += 1;                                                               \
-    }                                                                       \
+#define CVC4_API_TERM_CHECK_TERMS_WITH_TERMS_COMPARABLE_TO(terms1, terms2)     \
+  do                                                                           \
+  {                                                                            \
+    size_t i = 0;                                                              \
+    for (const auto& t1 : terms1)                                              \
+    {                                                                          \
+      const auto& t2 = terms2[i];                                              \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", t1, terms1, i);             \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                    \
+          Solver::sharesTerms(this->d_solver, t1.d_solver), "term", terms1, i) \
+          << "a term associated with the solver this object is associated "    \
+             "with";                                                           \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", t2, terms2, i);             \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                    \
+          Solver::sharesTerms(this->d_solver, t2.d_solver), "term", terms2, i) \
+          << "a term associated with the solver this object is associated "    \
+             "with";                                                           \
+      CVC4_API_CHECK(t1.getSort().isComparableTo(t2.getSort()))                \
+          << "Expecting terms of comparable sort at index " << i;              \
+      i += 1;                                                                  \
+    }                                                                          \
   } while (0)
 
 /* -------------------------------------------------------------------------- */
@@ -344,7 +350,7 @@ namespace api {
   do                                                        \
   {                                                         \
     CVC4_API_ARG_CHECK_NOT_NULL(sort);                      \
-    CVC4_API_CHECK(this == sort.d_solver)                   \
+    CVC4_API_CHECK(sharesTerms(this, sort.d_solver))        \
         << "Given sort is not associated with this solver"; \
   } while (0)
 
@@ -361,7 +367,7 @@ namespace api {
     {                                                             \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("sorts", s, sorts, i); \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                       \
-          this == s.d_solver, "sort", sorts, i)                   \
+          sharesTerms(this, s.d_solver), "sort", sorts, i)        \
           << "a sort associated with this solver";                \
       i += 1;                                                     \
     }                                                             \
@@ -380,7 +386,7 @@ namespace api {
     {                                                             \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("sorts", s, sorts, i); \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                       \
-          this == s.d_solver, "sort", sorts, i)                   \
+          sharesTerms(this, s.d_solver), "sort", sorts, i)        \
           << "a sorts associated with this solver";               \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                       \
           !s.isFunctionLike(), "sort", sorts, i)                  \
@@ -394,14 +400,14 @@ namespace api {
  * Check if domain sort is not null, associated with this solver, and a
  * first-class sort.
  */
-#define CVC4_API_SOLVER_CHECK_DOMAIN_SORT(sort)                           \
-  do                                                                      \
-  {                                                                       \
-    CVC4_API_ARG_CHECK_NOT_NULL(sort);                                    \
-    CVC4_API_CHECK(this == sort.d_solver)                                 \
-        << "Given sort is not associated with this solver";               \
-    CVC4_API_ARG_CHECK_EXPECTED(sort.isFirstClass(), sort)                \
-        << "first-class sort as domain sort";                             \
+#define CVC4_API_SOLVER_CHECK_DOMAIN_SORT(sort)             \
+  do                                                        \
+  {                                                         \
+    CVC4_API_ARG_CHECK_NOT_NULL(sort);                      \
+    CVC4_API_CHECK(sharesTerms(this, sort.d_solver))        \
+        << "Given sort is not associated with this solver"; \
+    CVC4_API_ARG_CHECK_EXPECTED(sort.isFirstClass(), sort)  \
+        << "first-class sort as domain sort";               \
   } while (0)
 
 /**
@@ -409,21 +415,21 @@ namespace api {
  * Check if each domain sort in the given container of sorts is not null,
  * associated with this solver, and a first-class sort.
  */
-#define CVC4_API_SOLVER_CHECK_DOMAIN_SORTS(sorts)                        \
-  do                                                                     \
-  {                                                                      \
-    size_t i = 0;                                                        \
-    for (const auto& s : sorts)                                          \
-    {                                                                    \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("domain sort", s, sorts, i);  \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                              \
-          this == s.d_solver, "domain sort", sorts, i)                   \
-          << "a sort associated with this solver object";                \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                              \
-          s.isFirstClass(), "domain sort", sorts, i)                     \
-          << "first-class sort as domain sort";                          \
-      i += 1;                                                            \
-    }                                                                    \
+#define CVC4_API_SOLVER_CHECK_DOMAIN_SORTS(sorts)                       \
+  do                                                                    \
+  {                                                                     \
+    size_t i = 0;                                                       \
+    for (const auto& s : sorts)                                         \
+    {                                                                   \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("domain sort", s, sorts, i); \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                             \
+          sharesTerms(this, s.d_solver), "domain sort", sorts, i)       \
+          << "a sort associated with this solver object";               \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                             \
+          s.isFirstClass(), "domain sort", sorts, i)                    \
+          << "first-class sort as domain sort";                         \
+      i += 1;                                                           \
+    }                                                                   \
   } while (0)
 
 /**
@@ -435,7 +441,7 @@ namespace api {
   do                                                        \
   {                                                         \
     CVC4_API_ARG_CHECK_NOT_NULL(sort);                      \
-    CVC4_API_CHECK(this == sort.d_solver)                   \
+    CVC4_API_CHECK(sharesTerms(this, sort.d_solver))        \
         << "Given sort is not associated with this solver"; \
     CVC4_API_ARG_CHECK_EXPECTED(sort.isFirstClass(), sort)  \
         << "first-class sort as codomain sort";             \
@@ -453,7 +459,7 @@ namespace api {
   do                                                        \
   {                                                         \
     CVC4_API_ARG_CHECK_NOT_NULL(term);                      \
-    CVC4_API_CHECK(this == term.d_solver)                   \
+    CVC4_API_CHECK(sharesTerms(this, term.d_solver))        \
         << "Given term is not associated with this solver"; \
   } while (0)
 
@@ -470,7 +476,7 @@ namespace api {
     {                                                             \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("terms", t, terms, i); \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                       \
-          this == t.d_solver, "term", terms, i)                   \
+          sharesTerms(this, t.d_solver), "term", terms, i)        \
           << "a term associated with this solver";                \
       i += 1;                                                     \
     }                                                             \
@@ -502,7 +508,7 @@ namespace api {
     {                                                                          \
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL("term", t, terms, i);               \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                    \
-          this == t.d_solver, "term", terms, i)                                \
+          sharesTerms(this, t.d_solver), "term", terms, i)                     \
           << "a term associated with this solver";                             \
       CVC4_API_CHECK(t.getSort() == sort)                                      \
           << "Expected term with sort " << sort << " at index " << i << " in " \
@@ -516,25 +522,25 @@ namespace api {
  * Check if each term in the given container is not null, associated with this
  * solver, and a bound variable.
  */
-#define CVC4_API_SOLVER_CHECK_BOUND_VARS(bound_vars)            \
-  do                                                            \
-  {                                                             \
-    size_t i = 0;                                               \
-    for (const auto& bv : bound_vars)                           \
-    {                                                           \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL(                     \
-          "bound variable", bv, bound_vars, i);                 \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                     \
-          this == bv.d_solver, "bound variable", bound_vars, i) \
-          << "a term associated with this solver object";       \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                     \
-          bv.d_node->getKind() == cvc5::Kind::BOUND_VARIABLE,   \
-          "bound variable",                                     \
-          bound_vars,                                           \
-          i)                                                    \
-          << "a bound variable";                                \
-      i += 1;                                                   \
-    }                                                           \
+#define CVC4_API_SOLVER_CHECK_BOUND_VARS(bound_vars)                       \
+  do                                                                       \
+  {                                                                        \
+    size_t i = 0;                                                          \
+    for (const auto& bv : bound_vars)                                      \
+    {                                                                      \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL(                                \
+          "bound variable", bv, bound_vars, i);                            \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                \
+          sharesTerms(this, bv.d_solver), "bound variable", bound_vars, i) \
+          << "a term associated with this solver object";                  \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                \
+          bv.d_node->getKind() == cvc5::Kind::BOUND_VARIABLE,              \
+          "bound variable",                                                \
+          bound_vars,                                                      \
+          i)                                                               \
+          << "a bound variable";                                           \
+      i += 1;                                                              \
+    }                                                                      \
   } while (0)
 
 /**
@@ -557,7 +563,7 @@ namespace api {
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL(                                   \
           "bound variable", bv, bound_vars, i);                               \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                   \
-          this == bv.d_solver, "bound variable", bound_vars, i)               \
+          sharesTerms(this, bv.d_solver), "bound variable", bound_vars, i)    \
           << "a term associated with this solver object";                     \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                   \
           bv.d_node->getKind() == cvc5::Kind::BOUND_VARIABLE,                 \
@@ -587,7 +593,7 @@ namespace api {
   do                                                            \
   {                                                             \
     CVC4_API_ARG_CHECK_NOT_NULL(op);                            \
-    CVC4_API_CHECK(this == op.d_solver)                         \
+    CVC4_API_CHECK(sharesTerms(this, op.d_solver))              \
         << "Given operator is not associated with this solver"; \
   } while (0)
 
@@ -602,7 +608,7 @@ namespace api {
   do                                                                           \
   {                                                                            \
     CVC4_API_ARG_CHECK_NOT_NULL(decl);                                         \
-    CVC4_API_CHECK(this == decl.d_solver)                                      \
+    CVC4_API_CHECK(sharesTerms(this, decl.d_solver))                           \
         << "Given datatype declaration is not associated with this solver";    \
     CVC4_API_ARG_CHECK_EXPECTED(dtypedecl.getNumConstructors() > 0, dtypedecl) \
         << "a datatype declaration with at least one constructor";             \
@@ -613,22 +619,22 @@ namespace api {
  * Check if each datatype declaration in the given container of declarations is
  * not null and associated with this solver.
  */
-#define CVC4_API_SOLVER_CHECK_DTDECLS(decls)                            \
-  do                                                                    \
-  {                                                                     \
-    size_t i = 0;                                                       \
-    for (const auto& d : decls)                                         \
-    {                                                                   \
-      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL(                             \
-          "datatype declaration", d, decls, i);                         \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                             \
-          this == d.d_solver, "datatype declaration", decls, i)         \
-          << "a datatype declaration associated with this solver";      \
-      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                             \
-          d.getNumConstructors() > 0, "datatype declaration", decls, i) \
-          << "a datatype declaration with at least one constructor";    \
-      i += 1;                                                           \
-    }                                                                   \
+#define CVC4_API_SOLVER_CHECK_DTDECLS(decls)                               \
+  do                                                                       \
+  {                                                                        \
+    size_t i = 0;                                                          \
+    for (const auto& d : decls)                                            \
+    {                                                                      \
+      CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL(                                \
+          "datatype declaration", d, decls, i);                            \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                \
+          sharesTerms(this, d.d_solver), "datatype declaration", decls, i) \
+          << "a datatype declaration associated with this solver";         \
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                \
+          d.getNumConstructors() > 0, "datatype declaration", decls, i)    \
+          << "a datatype declaration with at least one constructor";       \
+      i += 1;                                                              \
+    }                                                                      \
   } while (0)
 
 /**
@@ -645,7 +651,10 @@ namespace api {
       CVC4_API_ARG_AT_INDEX_CHECK_NOT_NULL(                                    \
           "datatype constructor declaration", d, decls, i);                    \
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(                                    \
-          this == d.d_solver, "datatype constructor declaration", decls, i)    \
+          sharesTerms(this, d.d_solver),                                       \
+          "datatype constructor declaration",                                  \
+          decls,                                                               \
+          i)                                                                   \
           << "a datatype constructor declaration associated with this solver " \
              "object";                                                         \
       i += 1;                                                                  \
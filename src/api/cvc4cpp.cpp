@@ -33,12 +33,16 @@
 
 #include "api/cvc4cpp.h"
 
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <sstream>
 
 #include "api/checks.h"
+#include "api/trace_recorder.h"
 #include "base/check.h"
 #include "base/configuration.h"
+#include "base/listener.h"
 #include "expr/dtype.h"
 #include "expr/dtype_cons.h"
 #include "expr/dtype_selector.h"
@@ -49,16 +53,20 @@
 #include "expr/node_manager.h"
 #include "expr/sequence.h"
 #include "expr/type_node.h"
+#include "options/expr_options.h"
 #include "options/main_options.h"
 #include "options/options.h"
+#include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "proof/unsat_core.h"
 #include "smt/model.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_mode.h"
+#include "smt/sygus_solution_listener.h"
 #include "theory/logic_info.h"
 #include "theory/theory_model.h"
 #include "util/random.h"
+#include "util/resource_manager.h"
 #include "util/result.h"
 #include "util/statistics_registry.h"
 #include "util/stats_histogram.h"
@@ -4061,9 +4069,20 @@ size_t RoundingModeHashFunction::operator()(const RoundingMode& rm) const
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
 
-Solver::Solver(Options* opts)
+Solver::Solver(Options* opts) : Solver(nullptr, opts) {}
+
+Solver::Solver(Solver& peer, Options* opts) : Solver(&peer, opts) {}
+
+Solver::Solver(Solver* peer, Options* opts)
 {
-  d_nodeMgr.reset(new NodeManager());
+  if (peer != nullptr)
+  {
+    d_nodeMgr = peer->d_nodeMgr;
+  }
+  else
+  {
+    d_nodeMgr.reset(new NodeManager());
+  }
   d_originalOptions.reset(new Options());
   if (opts != nullptr)
   {
@@ -4072,12 +4091,18 @@ Solver::Solver(Options* opts)
   d_smtEngine.reset(new SmtEngine(d_nodeMgr.get(), d_originalOptions.get()));
   d_smtEngine->setSolver(this);
   d_rng.reset(new Random(d_smtEngine->getOptions()[options::seed]));
+  setTypeCheckingLevel();
 #if CVC4_STATISTICS_ON
   d_stats.reset(new Statistics());
   d_smtEngine->getStatisticsRegistry()->registerStat(&d_stats->d_consts);
   d_smtEngine->getStatisticsRegistry()->registerStat(&d_stats->d_vars);
   d_smtEngine->getStatisticsRegistry()->registerStat(&d_stats->d_terms);
 #endif
+  const std::string& trace = d_smtEngine->getOptions()[options::apiTrace];
+  if (!trace.empty())
+  {
+    d_trace.reset(new TraceRecorder(trace));
+  }
 }
 
 Solver::~Solver() {}
@@ -4232,6 +4257,7 @@ Term Solver::mkTermFromKind(Kind kind) const
       kind == PI || kind == REGEXP_EMPTY || kind == REGEXP_SIGMA, kind)
       << "PI or REGEXP_EMPTY or REGEXP_SIGMA";
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_TERM);
   Node res;
   if (kind == REGEXP_EMPTY || kind == REGEXP_SIGMA)
   {
@@ -4246,6 +4272,8 @@ Term Solver::mkTermFromKind(Kind kind) const
   }
   (void)res.getType(true); /* kick off type checking */
   increment_term_stats(kind);
+  tc.addInt(kind);
+  tc.doneTerm(res);
   return Term(this, res);
 }
 
@@ -4253,8 +4281,21 @@ Term Solver::mkTermHelper(Kind kind, const std::vector<Term>& children) const
 {
   // Note: Kind and children are checked in the caller to avoid double checks
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_TERM);
+  Node res = mkNodeHelper(kind, Term::termVectorToNodes(children));
+  tc.addInt(kind);
+  for (const Term& c : children)
+  {
+    tc.addTerm(*c.d_node);
+  }
+  tc.doneTerm(res);
+  return Term(this, res);
+}
 
-  std::vector<Node> echildren = Term::termVectorToNodes(children);
+Node Solver::mkNodeHelper(Kind kind, const std::vector<Node>& echildren) const
+{
+  // Note: Kind and children are checked in the caller to avoid double checks
+  //////// all checks before this line
   cvc5::Kind k = extToIntKind(kind);
   Node res;
   if (echildren.size() > 2)
@@ -4285,7 +4326,10 @@ Term Solver::mkTermHelper(Kind kind, const std::vector<Term>& children) const
     else
     {
       // default case, must check kind
-      checkMkTerm(kind, children.size());
+      if (checkArgs())
+      {
+        checkMkTerm(kind, echildren.size());
+      }
       res = d_nodeMgr->mkNode(k, echildren);
     }
   }
@@ -4297,31 +4341,33 @@ Term Solver::mkTermHelper(Kind kind, const std::vector<Term>& children) const
   else
   {
     // default case, same as above
-    checkMkTerm(kind, children.size());
+    if (checkArgs())
+    {
+      checkMkTerm(kind, echildren.size());
+    }
     if (kind == api::SINGLETON)
     {
       // the type of the term is the same as the type of the internal node
       // see Term::getSort()
-      TypeNode type = children[0].d_node->getType();
+      TypeNode type = echildren[0].getType();
       // Internally NodeManager::mkSingleton needs a type argument
       // to construct a singleton, since there is no difference between
       // integers and reals (both are Rationals).
       // At the API, mkReal and mkInteger are different and therefore the
       // element type can be used safely here.
-      res = getNodeManager()->mkSingleton(type, *children[0].d_node);
+      res = getNodeManager()->mkSingleton(type, echildren[0]);
     }
     else if (kind == api::MK_BAG)
     {
       // the type of the term is the same as the type of the internal node
       // see Term::getSort()
-      TypeNode type = children[0].d_node->getType();
+      TypeNode type = echildren[0].getType();
       // Internally NodeManager::mkBag needs a type argument
       // to construct a bag, since there is no difference between
       // integers and reals (both are Rationals).
       // At the API, mkReal and mkInteger are different and therefore the
       // element type can be used safely here.
-      res = getNodeManager()->mkBag(
-          type, *children[0].d_node, *children[1].d_node);
+      res = getNodeManager()->mkBag(type, echildren[0], echildren[1]);
     }
     else
     {
@@ -4329,15 +4375,21 @@ Term Solver::mkTermHelper(Kind kind, const std::vector<Term>& children) const
     }
   }
 
-  (void)res.getType(true); /* kick off type checking */
+  if (checkTypes())
+  {
+    (void)res.getType(true); /* kick off type checking */
+  }
   increment_term_stats(kind);
-  return Term(this, res);
+  return res;
 }
 
 Term Solver::mkTermHelper(const Op& op, const std::vector<Term>& children) const
 {
   // Note: Op and children are checked in the caller to avoid double checks
-  checkMkTerm(op.d_kind, children.size());
+  if (checkArgs())
+  {
+    checkMkTerm(op.d_kind, children.size());
+  }
   //////// all checks before this line
 
   if (!op.isIndexedHelper())
@@ -4345,6 +4397,7 @@ Term Solver::mkTermHelper(const Op& op, const std::vector<Term>& children) const
     return mkTermHelper(op.d_kind, children);
   }
 
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_TERM_OP);
   const cvc5::Kind int_kind = extToIntKind(op.d_kind);
   std::vector<Node> echildren = Term::termVectorToNodes(children);
 
@@ -4353,7 +4406,16 @@ Term Solver::mkTermHelper(const Op& op, const std::vector<Term>& children) const
   nb.append(echildren);
   Node res = nb.constructNode();
 
-  (void)res.getType(true); /* kick off type checking */
+  if (checkTypes())
+  {
+    (void)res.getType(true); /* kick off type checking */
+  }
+  tc.addOp(op.d_kind, *op.d_node);
+  for (const Node& c : echildren)
+  {
+    tc.addTerm(c);
+  }
+  tc.doneTerm(res);
   return Term(this, res);
 }
 
@@ -4452,7 +4514,7 @@ Term Solver::ensureTermSort(const Term& term, const Sort& sort) const
 
 Term Solver::ensureRealSort(const Term& t) const
 {
-  Assert(this == t.d_solver);
+  Assert(sharesTerms(this, t.d_solver));
   CVC4_API_ARG_CHECK_EXPECTED(
       t.getSort() == getIntegerSort() || t.getSort() == getRealSort(),
       " an integer or real term");
@@ -4527,6 +4589,30 @@ void Solver::checkMkTerm(Kind kind, uint32_t nchildren) const
       << " children (the one under construction has " << nchildren << ")";
 }
 
+bool Solver::sharesTerms(const Solver* s1, const Solver* s2)
+{
+  return s1 == s2
+         || (s1 != nullptr && s2 != nullptr && s1->d_nodeMgr == s2->d_nodeMgr);
+}
+
+bool Solver::checkArgs() const
+{
+  return d_smtEngine->getOptions()[options::apiChecks]
+         != options::ApiChecksMode::NONE;
+}
+
+bool Solver::checkTypes() const
+{
+  return d_smtEngine->getOptions()[options::apiChecks]
+         == options::ApiChecksMode::FULL;
+}
+
+void Solver::setTypeCheckingLevel() const
+{
+  d_nodeMgr->setTypeChecking(d_smtEngine->getOptions()[options::apiChecks]
+                             != options::ApiChecksMode::NONE);
+}
+
 /* Solver Configuration                                                       */
 /* -------------------------------------------------------------------------- */
 
@@ -4539,6 +4625,20 @@ bool Solver::supportsFloatingPoint() const
   CVC4_API_TRY_CATCH_END;
 }
 
+std::unique_ptr<Solver> Solver::cloneConfiguration()
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  // finalize the logic and the options of this solver, which are copied by
+  // the new solver
+  d_smtEngine->finishInit();
+  std::unique_ptr<Solver> res(new Solver(this, &d_smtEngine->getOptions()));
+  res->d_smtEngine->configureFrom(*d_smtEngine);
+  return res;
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
 /* Sorts Handling                                                             */
 /* -------------------------------------------------------------------------- */
 
@@ -4556,8 +4656,11 @@ Sort Solver::getBooleanSort(void) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::GET_BOOLEAN_SORT);
   //////// all checks before this line
-  return Sort(this, getNodeManager()->booleanType());
+  Sort res(this, getNodeManager()->booleanType());
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4566,8 +4669,11 @@ Sort Solver::getIntegerSort(void) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::GET_INTEGER_SORT);
   //////// all checks before this line
-  return Sort(this, getNodeManager()->integerType());
+  Sort res(this, getNodeManager()->integerType());
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4576,8 +4682,11 @@ Sort Solver::getRealSort(void) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::GET_REAL_SORT);
   //////// all checks before this line
-  return Sort(this, getNodeManager()->realType());
+  Sort res(this, getNodeManager()->realType());
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4596,8 +4705,11 @@ Sort Solver::getStringSort(void) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::GET_STRING_SORT);
   //////// all checks before this line
-  return Sort(this, getNodeManager()->stringType());
+  Sort res(this, getNodeManager()->stringType());
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4620,11 +4732,16 @@ Sort Solver::mkArraySort(const Sort& indexSort, const Sort& elemSort) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_ARRAY_SORT);
   CVC4_API_SOLVER_CHECK_SORT(indexSort);
   CVC4_API_SOLVER_CHECK_SORT(elemSort);
   //////// all checks before this line
-  return Sort(
-      this, getNodeManager()->mkArrayType(*indexSort.d_type, *elemSort.d_type));
+  Sort res(this,
+           getNodeManager()->mkArrayType(*indexSort.d_type, *elemSort.d_type));
+  tc.addSort(*indexSort.d_type);
+  tc.addSort(*elemSort.d_type);
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4633,9 +4750,13 @@ Sort Solver::mkBitVectorSort(uint32_t size) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BV_SORT);
   CVC4_API_ARG_CHECK_EXPECTED(size > 0, size) << "size > 0";
   //////// all checks before this line
-  return Sort(this, getNodeManager()->mkBitVectorType(size));
+  Sort res(this, getNodeManager()->mkBitVectorType(size));
+  tc.addInt(size);
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4695,11 +4816,16 @@ Sort Solver::mkFunctionSort(const Sort& domain, const Sort& codomain) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_FUNCTION_SORT);
   CVC4_API_SOLVER_CHECK_DOMAIN_SORT(domain);
   CVC4_API_SOLVER_CHECK_CODOMAIN_SORT(codomain);
   //////// all checks before this line
-  return Sort(
-      this, getNodeManager()->mkFunctionType(*domain.d_type, *codomain.d_type));
+  Sort res(this,
+           getNodeManager()->mkFunctionType(*domain.d_type, *codomain.d_type));
+  tc.addSort(*domain.d_type);
+  tc.addSort(*codomain.d_type);
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4709,14 +4835,21 @@ Sort Solver::mkFunctionSort(const std::vector<Sort>& sorts,
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_FUNCTION_SORT);
   CVC4_API_ARG_SIZE_CHECK_EXPECTED(sorts.size() >= 1, sorts)
       << "at least one parameter sort for function sort";
   CVC4_API_SOLVER_CHECK_DOMAIN_SORTS(sorts);
   CVC4_API_SOLVER_CHECK_CODOMAIN_SORT(codomain);
   //////// all checks before this line
   std::vector<TypeNode> argTypes = Sort::sortVectorToTypeNodes(sorts);
-  return Sort(this,
-              getNodeManager()->mkFunctionType(argTypes, *codomain.d_type));
+  Sort res(this, getNodeManager()->mkFunctionType(argTypes, *codomain.d_type));
+  for (const TypeNode& tn : argTypes)
+  {
+    tc.addSort(tn);
+  }
+  tc.addSort(*codomain.d_type);
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4760,7 +4893,7 @@ Sort Solver::mkRecordSort(
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(!p.second.isNull(), "sort", fields, i)
         << "non-null sort";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        this == p.second.d_solver, "sort", fields, i)
+        sharesTerms(this, p.second.d_solver), "sort", fields, i)
         << "sort associated with this solver object";
     f.emplace_back(p.first, *p.second.d_type);
   }
@@ -4807,8 +4940,12 @@ Sort Solver::mkUninterpretedSort(const std::string& symbol) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_UNINTERPRETED_SORT);
   //////// all checks before this line
-  return Sort(this, getNodeManager()->mkSort(symbol));
+  Sort res(this, getNodeManager()->mkSort(symbol));
+  tc.addString(symbol);
+  tc.doneSort(*res.d_type);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4843,8 +4980,12 @@ Term Solver::mkTrue(void) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BOOLEAN);
   //////// all checks before this line
-  return Term(this, d_nodeMgr->mkConst<bool>(true));
+  Term res(this, d_nodeMgr->mkConst<bool>(true));
+  tc.addInt(true);
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4853,8 +4994,12 @@ Term Solver::mkFalse(void) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BOOLEAN);
   //////// all checks before this line
-  return Term(this, d_nodeMgr->mkConst<bool>(false));
+  Term res(this, d_nodeMgr->mkConst<bool>(false));
+  tc.addInt(false);
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4863,8 +5008,12 @@ Term Solver::mkBoolean(bool val) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BOOLEAN);
   //////// all checks before this line
-  return Term(this, d_nodeMgr->mkConst<bool>(val));
+  Term res(this, d_nodeMgr->mkConst<bool>(val));
+  tc.addInt(val);
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4886,11 +5035,14 @@ Term Solver::mkInteger(const std::string& s) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_INTEGER);
   CVC4_API_ARG_CHECK_EXPECTED(isValidInteger(s), s) << " an integer ";
   Term integer = mkRealFromStrHelper(s);
   CVC4_API_ARG_CHECK_EXPECTED(integer.getSort() == getIntegerSort(), s)
       << " a string representing an integer";
   //////// all checks before this line
+  tc.addString(s);
+  tc.doneTerm(*integer.d_node);
   return integer;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -4900,9 +5052,12 @@ Term Solver::mkInteger(int64_t val) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_INTEGER);
   //////// all checks before this line
   Term integer = mkValHelper<cvc5::Rational>(cvc5::Rational(val));
   Assert(integer.getSort() == getIntegerSort());
+  tc.addString(std::to_string(val));
+  tc.doneTerm(*integer.d_node);
   return integer;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -4915,11 +5070,14 @@ Term Solver::mkReal(const std::string& s) const
   /* CLN and GMP handle this case differently, CLN interprets it as 0, GMP
    * throws an std::invalid_argument exception. For consistency, we treat it
    * as invalid. */
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_REAL);
   CVC4_API_ARG_CHECK_EXPECTED(s != ".", s)
       << "a string representing a real or rational value.";
   //////// all checks before this line
-  Term rational = mkRealFromStrHelper(s);
-  return ensureRealSort(rational);
+  Term rational = ensureRealSort(mkRealFromStrHelper(s));
+  tc.addString(s);
+  tc.doneTerm(*rational.d_node);
+  return rational;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4928,9 +5086,13 @@ Term Solver::mkReal(int64_t val) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_REAL);
   //////// all checks before this line
-  Term rational = mkValHelper<cvc5::Rational>(cvc5::Rational(val));
-  return ensureRealSort(rational);
+  Term rational = ensureRealSort(
+      mkValHelper<cvc5::Rational>(cvc5::Rational(val)));
+  tc.addString(std::to_string(val));
+  tc.doneTerm(*rational.d_node);
+  return rational;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4939,9 +5101,13 @@ Term Solver::mkReal(int64_t num, int64_t den) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_REAL);
   //////// all checks before this line
-  Term rational = mkValHelper<cvc5::Rational>(cvc5::Rational(num, den));
-  return ensureRealSort(rational);
+  Term rational = ensureRealSort(
+      mkValHelper<cvc5::Rational>(cvc5::Rational(num, den)));
+  tc.addString(std::to_string(num) + "/" + std::to_string(den));
+  tc.doneTerm(*rational.d_node);
+  return rational;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -4978,7 +5144,8 @@ Term Solver::mkEmptySet(const Sort& sort) const
   CVC4_API_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(sort.isNull() || sort.isSet(), sort)
       << "null sort or set sort";
-  CVC4_API_ARG_CHECK_EXPECTED(sort.isNull() || this == sort.d_solver, sort)
+  CVC4_API_ARG_CHECK_EXPECTED(
+      sort.isNull() || sharesTerms(this, sort.d_solver), sort)
       << "set sort associated with this solver object";
   //////// all checks before this line
   return mkValHelper<cvc5::EmptySet>(cvc5::EmptySet(*sort.d_type));
@@ -4992,7 +5159,8 @@ Term Solver::mkEmptyBag(const Sort& sort) const
   CVC4_API_TRY_CATCH_BEGIN;
   CVC4_API_ARG_CHECK_EXPECTED(sort.isNull() || sort.isBag(), sort)
       << "null sort or bag sort";
-  CVC4_API_ARG_CHECK_EXPECTED(sort.isNull() || this == sort.d_solver, sort)
+  CVC4_API_ARG_CHECK_EXPECTED(
+      sort.isNull() || sharesTerms(this, sort.d_solver), sort)
       << "bag sort associated with this solver object";
   //////// all checks before this line
   return mkValHelper<cvc5::EmptyBag>(cvc5::EmptyBag(*sort.d_type));
@@ -5018,8 +5186,13 @@ Term Solver::mkString(const std::string& s, bool useEscSequences) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_STRING);
   //////// all checks before this line
-  return mkValHelper<cvc5::String>(cvc5::String(s, useEscSequences));
+  Term res = mkValHelper<cvc5::String>(cvc5::String(s, useEscSequences));
+  tc.addInt(useEscSequences);
+  tc.addString(s);
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5087,8 +5260,14 @@ Term Solver::mkBitVector(uint32_t size, uint64_t val) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BV);
   //////// all checks before this line
-  return mkBVFromIntHelper(size, val);
+  Term res = mkBVFromIntHelper(size, val);
+  const cvc5::BitVector& bv = res.d_node->getConst<cvc5::BitVector>();
+  tc.addInt(bv.getSize());
+  tc.addString(bv.toString(10));
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5097,8 +5276,14 @@ Term Solver::mkBitVector(const std::string& s, uint32_t base) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BV);
   //////// all checks before this line
-  return mkBVFromStrHelper(s, base);
+  Term res = mkBVFromStrHelper(s, base);
+  const cvc5::BitVector& bv = res.d_node->getConst<cvc5::BitVector>();
+  tc.addInt(bv.getSize());
+  tc.addString(bv.toString(10));
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5109,8 +5294,14 @@ Term Solver::mkBitVector(uint32_t size,
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_BV);
   //////// all checks before this line
-  return mkBVFromStrHelper(size, s, base);
+  Term res = mkBVFromStrHelper(size, s, base);
+  const cvc5::BitVector& bv = res.d_node->getConst<cvc5::BitVector>();
+  tc.addInt(bv.getSize());
+  tc.addString(bv.toString(10));
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5289,11 +5480,18 @@ Term Solver::mkConst(const Sort& sort, const std::string& symbol) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_SORT(sort);
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_CONST);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_SORT(sort);
+  }
   //////// all checks before this line
   Node res = d_nodeMgr->mkVar(symbol, *sort.d_type);
   (void)res.getType(true); /* kick off type checking */
   increment_vars_consts_stats(sort, false);
+  tc.addSort(*sort.d_type);
+  tc.addString(symbol);
+  tc.doneTerm(res);
   return Term(this, res);
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5303,11 +5501,17 @@ Term Solver::mkConst(const Sort& sort) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_SORT(sort);
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_CONST);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_SORT(sort);
+  }
   //////// all checks before this line
   Node res = d_nodeMgr->mkVar(*sort.d_type);
   (void)res.getType(true); /* kick off type checking */
   increment_vars_consts_stats(sort, false);
+  tc.addSort(*sort.d_type);
+  tc.doneTerm(res);
   return Term(this, res);
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5320,12 +5524,19 @@ Term Solver::mkVar(const Sort& sort, const std::string& symbol) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_SORT(sort);
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_VAR);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_SORT(sort);
+  }
   //////// all checks before this line
   Node res = symbol.empty() ? d_nodeMgr->mkBoundVar(*sort.d_type)
                             : d_nodeMgr->mkBoundVar(symbol, *sort.d_type);
   (void)res.getType(true); /* kick off type checking */
   increment_vars_consts_stats(sort, true);
+  tc.addSort(*sort.d_type);
+  tc.addString(symbol);
+  tc.doneTerm(res);
   return Term(this, res);
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5391,7 +5602,10 @@ Term Solver::mkTerm(Kind kind) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_KIND_CHECK(kind);
+  if (checkArgs())
+  {
+    CVC4_API_KIND_CHECK(kind);
+  }
   //////// all checks before this line
   return mkTermFromKind(kind);
   ////////
@@ -5402,8 +5616,11 @@ Term Solver::mkTerm(Kind kind, const Term& child) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_KIND_CHECK(kind);
-  CVC4_API_SOLVER_CHECK_TERM(child);
+  if (checkArgs())
+  {
+    CVC4_API_KIND_CHECK(kind);
+    CVC4_API_SOLVER_CHECK_TERM(child);
+  }
   //////// all checks before this line
   return mkTermHelper(kind, std::vector<Term>{child});
   ////////
@@ -5414,9 +5631,12 @@ Term Solver::mkTerm(Kind kind, const Term& child1, const Term& child2) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_KIND_CHECK(kind);
-  CVC4_API_SOLVER_CHECK_TERM(child1);
-  CVC4_API_SOLVER_CHECK_TERM(child2);
+  if (checkArgs())
+  {
+    CVC4_API_KIND_CHECK(kind);
+    CVC4_API_SOLVER_CHECK_TERM(child1);
+    CVC4_API_SOLVER_CHECK_TERM(child2);
+  }
   //////// all checks before this line
   return mkTermHelper(kind, std::vector<Term>{child1, child2});
   ////////
@@ -5430,10 +5650,13 @@ Term Solver::mkTerm(Kind kind,
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_KIND_CHECK(kind);
-  CVC4_API_SOLVER_CHECK_TERM(child1);
-  CVC4_API_SOLVER_CHECK_TERM(child2);
-  CVC4_API_SOLVER_CHECK_TERM(child3);
+  if (checkArgs())
+  {
+    CVC4_API_KIND_CHECK(kind);
+    CVC4_API_SOLVER_CHECK_TERM(child1);
+    CVC4_API_SOLVER_CHECK_TERM(child2);
+    CVC4_API_SOLVER_CHECK_TERM(child3);
+  }
   //////// all checks before this line
   // need to use internal term call to check e.g. associative construction
   return mkTermHelper(kind, std::vector<Term>{child1, child2, child3});
@@ -5445,20 +5668,85 @@ Term Solver::mkTerm(Kind kind, const std::vector<Term>& children) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_KIND_CHECK(kind);
-  CVC4_API_SOLVER_CHECK_TERMS(children);
+  if (checkArgs())
+  {
+    CVC4_API_KIND_CHECK(kind);
+    CVC4_API_SOLVER_CHECK_TERMS(children);
+  }
   //////// all checks before this line
   return mkTermHelper(kind, children);
   ////////
   CVC4_API_TRY_CATCH_END;
 }
 
+std::vector<Term> Solver::mkTerms(const std::vector<Term>& leaves,
+                                  const std::vector<Kind>& kinds,
+                                  const std::vector<uint32_t>& children) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_TERMS(leaves);
+  // check the structure of the records, the arities of the kinds are checked
+  // when building each term
+  size_t nleaves = leaves.size();
+  size_t pos = 0;
+  for (size_t i = 0, nterms = kinds.size(); i < nterms; i++)
+  {
+    CVC4_API_KIND_CHECK(kinds[i]);
+    CVC4_API_CHECK(pos < children.size())
+        << "Missing the number of children of the term at index " << i;
+    size_t end = pos + 1 + children[pos];
+    CVC4_API_CHECK(end <= children.size())
+        << "Missing children of the term at index " << i;
+    for (pos = pos + 1; pos < end; pos++)
+    {
+      CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+          children[pos] < nleaves + i, "child", children, pos)
+          << "the index of a leaf or of a term before the term at index " << i;
+    }
+  }
+  CVC4_API_CHECK(pos == children.size())
+      << "Unexpected children after the last term";
+  //////// all checks before this line
+  // the terms are recorded as separate calls of mkTerm
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_TERM);
+  std::vector<Node> nodes = Term::termVectorToNodes(leaves);
+  nodes.reserve(nleaves + kinds.size());
+  std::vector<Node> echildren;
+  pos = 0;
+  for (Kind kind : kinds)
+  {
+    echildren.clear();
+    size_t end = pos + 1 + children[pos];
+    tc.addInt(kind);
+    for (pos = pos + 1; pos < end; pos++)
+    {
+      echildren.push_back(nodes[children[pos]]);
+      tc.addTerm(echildren.back());
+    }
+    nodes.push_back(mkNodeHelper(kind, echildren));
+    tc.doneTerm(nodes.back());
+  }
+  std::vector<Term> res;
+  res.reserve(kinds.size());
+  for (size_t i = nleaves, nnodes = nodes.size(); i < nnodes; i++)
+  {
+    res.push_back(Term(this, nodes[i]));
+  }
+  return res;
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
 Term Solver::mkTerm(const Op& op) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_OP(op);
-  checkMkTerm(op.d_kind, 0);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_OP(op);
+    checkMkTerm(op.d_kind, 0);
+  }
   //////// all checks before this line
 
   if (!op.isIndexedHelper())
@@ -5466,10 +5754,16 @@ Term Solver::mkTerm(const Op& op) const
     return mkTermFromKind(op.d_kind);
   }
 
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_TERM_OP);
   const cvc5::Kind int_kind = extToIntKind(op.d_kind);
   Term res = Term(this, getNodeManager()->mkNode(int_kind, *op.d_node));
 
-  (void)res.d_node->getType(true); /* kick off type checking */
+  if (checkTypes())
+  {
+    (void)res.d_node->getType(true); /* kick off type checking */
+  }
+  tc.addOp(op.d_kind, *op.d_node);
+  tc.doneTerm(*res.d_node);
   return res;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5479,8 +5773,11 @@ Term Solver::mkTerm(const Op& op, const Term& child) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_OP(op);
-  CVC4_API_SOLVER_CHECK_TERM(child);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_OP(op);
+    CVC4_API_SOLVER_CHECK_TERM(child);
+  }
   //////// all checks before this line
   return mkTermHelper(op, std::vector<Term>{child});
   ////////
@@ -5491,9 +5788,12 @@ Term Solver::mkTerm(const Op& op, const Term& child1, const Term& child2) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_OP(op);
-  CVC4_API_SOLVER_CHECK_TERM(child1);
-  CVC4_API_SOLVER_CHECK_TERM(child2);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_OP(op);
+    CVC4_API_SOLVER_CHECK_TERM(child1);
+    CVC4_API_SOLVER_CHECK_TERM(child2);
+  }
   //////// all checks before this line
   return mkTermHelper(op, std::vector<Term>{child1, child2});
   ////////
@@ -5507,10 +5807,13 @@ Term Solver::mkTerm(const Op& op,
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_OP(op);
-  CVC4_API_SOLVER_CHECK_TERM(child1);
-  CVC4_API_SOLVER_CHECK_TERM(child2);
-  CVC4_API_SOLVER_CHECK_TERM(child3);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_OP(op);
+    CVC4_API_SOLVER_CHECK_TERM(child1);
+    CVC4_API_SOLVER_CHECK_TERM(child2);
+    CVC4_API_SOLVER_CHECK_TERM(child3);
+  }
   //////// all checks before this line
   return mkTermHelper(op, std::vector<Term>{child1, child2, child3});
   ////////
@@ -5521,8 +5824,11 @@ Term Solver::mkTerm(const Op& op, const std::vector<Term>& children) const
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
-  CVC4_API_SOLVER_CHECK_OP(op);
-  CVC4_API_SOLVER_CHECK_TERMS(children);
+  if (checkArgs())
+  {
+    CVC4_API_SOLVER_CHECK_OP(op);
+    CVC4_API_SOLVER_CHECK_TERMS(children);
+  }
   //////// all checks before this line
   return mkTermHelper(op, children);
   ////////
@@ -5567,6 +5873,9 @@ Op Solver::mkOp(Kind kind) const
   CVC4_API_CHECK(s_indexed_kinds.find(kind) == s_indexed_kinds.end())
       << "Expected a kind for a non-indexed operator.";
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_OP);
+  tc.addInt(kind);
+  tc.doneOp(kind, Node());
   return Op(this, kind);
   ////////
   CVC4_API_TRY_CATCH_END
@@ -5599,6 +5908,10 @@ Op Solver::mkOp(Kind kind, const std::string& arg) const
              *mkValHelper<cvc5::Divisible>(cvc5::Divisible(cvc5::Integer(arg)))
                   .d_node);
   }
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_OP);
+  tc.addInt(kind);
+  tc.addString(arg);
+  tc.doneOp(kind, *res.d_node);
   return res;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5691,6 +6004,10 @@ Op Solver::mkOp(Kind kind, uint32_t arg) const
           << "operator kind with uint32_t argument";
   }
   Assert(!res.isNull());
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_OP);
+  tc.addInt(kind);
+  tc.addInt(arg);
+  tc.doneOp(kind, *res.d_node);
   return res;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5765,6 +6082,11 @@ Op Solver::mkOp(Kind kind, uint32_t arg1, uint32_t arg2) const
           << "operator kind with two uint32_t arguments";
   }
   Assert(!res.isNull());
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_OP);
+  tc.addInt(kind);
+  tc.addInt(arg1);
+  tc.addInt(arg2);
+  tc.doneOp(kind, *res.d_node);
   return res;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5795,6 +6117,13 @@ Op Solver::mkOp(Kind kind, const std::vector<uint32_t>& args) const
     }
   }
   Assert(!res.isNull());
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::MK_OP);
+  tc.addInt(kind);
+  for (uint32_t arg : args)
+  {
+    tc.addInt(arg);
+  }
+  tc.doneOp(kind, *res.d_node);
   return res;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5807,9 +6136,13 @@ Term Solver::simplify(const Term& term)
 {
   NodeManagerScope scope(getNodeManager());
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::SIMPLIFY);
   CVC4_API_SOLVER_CHECK_TERM(term);
   //////// all checks before this line
-  return Term(this, d_smtEngine->simplify(*term.d_node));
+  Term res(this, d_smtEngine->simplify(*term.d_node));
+  tc.addTerm(*term.d_node);
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5854,10 +6187,13 @@ Result Solver::checkEntailed(const std::vector<Term>& terms) const
 void Solver::assertFormula(const Term& term) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::ASSERT);
   CVC4_API_SOLVER_CHECK_TERM(term);
   CVC4_API_SOLVER_CHECK_TERM_WITH_SORT(term, getBooleanSort());
   //////// all checks before this line
   d_smtEngine->assertFormula(*term.d_node);
+  tc.addTerm(*term.d_node);
+  tc.done();
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5874,12 +6210,75 @@ Result Solver::checkSat(void) const
       << "Cannot make multiple queries unless incremental solving is enabled "
          "(try --incremental)";
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::CHECK_SAT);
   cvc5::Result r = d_smtEngine->checkSat();
+  tc.done();
   return Result(r);
   ////////
   CVC4_API_TRY_CATCH_END;
 }
 
+namespace {
+
+/**
+ * The internal listener for the progress of a check started by
+ * Solver::checkSatAsync, which is registered with the resource manager for
+ * the duration of the check.
+ */
+class CheckProgressNotify : public cvc5::Listener
+{
+ public:
+  CheckProgressNotify(cvc5::ResourceManager* rm,
+                      CheckProgressListener* l,
+                      uint64_t intervalMs)
+      : d_rm(rm), d_listener(l)
+  {
+    d_rm->setProgressListener(this, intervalMs);
+  }
+  ~CheckProgressNotify() { d_rm->setProgressListener(nullptr, 0); }
+  void notify() override
+  {
+    d_listener->notify(d_rm->getConflictsThisCall(),
+                       d_rm->getLemmasThisCall(),
+                       d_rm->getTimeThisCall());
+  }
+
+ private:
+  cvc5::ResourceManager* d_rm;
+  CheckProgressListener* d_listener;
+};
+
+}  // namespace
+
+std::future<Result> Solver::checkSatAsync(CheckProgressListener* listener,
+                                          uint64_t intervalMs) const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_CHECK(!d_smtEngine->isQueryMade()
+                 || d_smtEngine->getOptions()[options::incrementalSolving])
+      << "Cannot make multiple queries unless incremental solving is enabled "
+         "(try --incremental)";
+  //////// all checks before this line
+  cvc5::ResourceManager* rm = d_smtEngine->getResourceManager();
+  rm->clearInterrupt();
+  return std::async(std::launch::async, [this, rm, listener, intervalMs]() {
+    std::unique_ptr<CheckProgressNotify> cpn;
+    if (listener != nullptr)
+    {
+      cpn.reset(new CheckProgressNotify(rm, listener, intervalMs));
+    }
+    return checkSat();
+  });
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+void Solver::cancel() const
+{
+  // no checks or scopes here, this may be called from a different thread
+  d_smtEngine->getResourceManager()->interrupt();
+}
+
 /**
  *  ( check-sat-assuming ( <prop_literal> ) )
  */
@@ -5891,9 +6290,12 @@ Result Solver::checkSatAssuming(const Term& assumption) const
                  || d_smtEngine->getOptions()[options::incrementalSolving])
       << "Cannot make multiple queries unless incremental solving is enabled "
          "(try --incremental)";
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::CHECK_SAT_ASSUMING);
   CVC4_API_SOLVER_CHECK_TERM_WITH_SORT(assumption, getBooleanSort());
   //////// all checks before this line
   cvc5::Result r = d_smtEngine->checkSat(*assumption.d_node);
+  tc.addTerm(*assumption.d_node);
+  tc.done();
   return Result(r);
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5910,6 +6312,7 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
                  || d_smtEngine->getOptions()[options::incrementalSolving])
       << "Cannot make multiple queries unless incremental solving is enabled "
          "(try --incremental)";
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::CHECK_SAT_ASSUMING);
   CVC4_API_SOLVER_CHECK_TERMS_WITH_SORT(assumptions, getBooleanSort());
   //////// all checks before this line
   for (const Term& term : assumptions)
@@ -5918,6 +6321,11 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
   }
   std::vector<Node> eassumptions = Term::termVectorToNodes(assumptions);
   cvc5::Result r = d_smtEngine->checkSat(eassumptions);
+  for (const Node& a : eassumptions)
+  {
+    tc.addTerm(a);
+  }
+  tc.done();
   return Result(r);
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -5953,6 +6361,7 @@ Term Solver::declareFun(const std::string& symbol,
                         const Sort& sort) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::DECLARE_FUN);
   CVC4_API_SOLVER_CHECK_DOMAIN_SORTS(sorts);
   CVC4_API_SOLVER_CHECK_CODOMAIN_SORT(sort);
   //////// all checks before this line
@@ -5963,7 +6372,15 @@ Term Solver::declareFun(const std::string& symbol,
     std::vector<TypeNode> types = Sort::sortVectorToTypeNodes(sorts);
     type = getNodeManager()->mkFunctionType(types, type);
   }
-  return Term(this, d_nodeMgr->mkVar(symbol, type));
+  Node res = d_nodeMgr->mkVar(symbol, type);
+  for (const Sort& s : sorts)
+  {
+    tc.addSort(*s.d_type);
+  }
+  tc.addSort(*sort.d_type);
+  tc.addString(symbol);
+  tc.doneTerm(res);
+  return Term(this, res);
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5974,12 +6391,15 @@ Term Solver::declareFun(const std::string& symbol,
 Sort Solver::declareSort(const std::string& symbol, uint32_t arity) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::DECLARE_SORT);
   //////// all checks before this line
-  if (arity == 0)
-  {
-    return Sort(this, getNodeManager()->mkSort(symbol));
-  }
-  return Sort(this, getNodeManager()->mkSortConstructor(symbol, arity));
+  TypeNode res = arity == 0
+                     ? getNodeManager()->mkSort(symbol)
+                     : getNodeManager()->mkSortConstructor(symbol, arity);
+  tc.addInt(arity);
+  tc.addString(symbol);
+  tc.doneSort(res);
+  return Sort(this, res);
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -5994,6 +6414,7 @@ Term Solver::defineFun(const std::string& symbol,
                        bool global) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::DEFINE_FUN);
   CVC4_API_SOLVER_CHECK_CODOMAIN_SORT(sort);
   CVC4_API_SOLVER_CHECK_TERM(term);
   CVC4_API_CHECK(sort == term.getSort())
@@ -6018,6 +6439,15 @@ Term Solver::defineFun(const std::string& symbol,
 
   d_smtEngine->defineFunction(
       *fun.d_node, Term::termVectorToNodes(bound_vars), *term.d_node, global);
+  tc.addSort(*sort.d_type);
+  tc.addTerm(*term.d_node);
+  tc.addInt(global);
+  for (const Term& bv : bound_vars)
+  {
+    tc.addTerm(*bv.d_node);
+  }
+  tc.addString(symbol);
+  tc.doneTerm(*fun.d_node);
   return fun;
   ////////
   CVC4_API_TRY_CATCH_END;
@@ -6178,10 +6608,10 @@ void Solver::defineFunsRec(const std::vector<Term>& funs,
     const Term& term = terms[j];
 
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        this == fun.d_solver, "function", funs, j)
+        sharesTerms(this, fun.d_solver), "function", funs, j)
         << "function associated with this solver object";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        this == term.d_solver, "term", terms, j)
+        sharesTerms(this, term.d_solver), "term", terms, j)
         << "term associated with this solver object";
 
     if (fun.getSort().isFunction())
@@ -6224,6 +6654,56 @@ void Solver::echo(std::ostream& out, const std::string& str) const
 /**
  *  ( get-assertions )
  */
+std::vector<Term> Solver::getLearnedClauses(uint32_t maxSize,
+                                            uint32_t maxLbd) const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  //////// all checks before this line
+  std::vector<Node> clauses = d_smtEngine->getLearnedClauses(maxSize, maxLbd);
+  std::vector<Term> res;
+  for (const Node& c : clauses)
+  {
+    res.push_back(Term(this, c));
+  }
+  return res;
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+void Solver::addLearnedClauses(const std::vector<Term>& clauses) const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_SOLVER_CHECK_TERMS_WITH_SORT(clauses, getBooleanSort());
+  //////// all checks before this line
+  d_smtEngine->addLearnedClauses(Term::termVectorToNodes(clauses));
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+void Solver::saveSnapshot(const std::string& filename) const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  //////// all checks before this line
+  d_smtEngine->saveSnapshot(filename);
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
+void Solver::loadSnapshot(const std::string& filename,
+                          const std::vector<Term>& decls) const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_SOLVER_CHECK_TERMS(decls);
+  //////// all checks before this line
+  d_smtEngine->loadSnapshot(filename, Term::termVectorToNodes(decls));
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
 std::vector<Term> Solver::getAssertions(void) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
@@ -6307,7 +6787,8 @@ std::vector<Term> Solver::getUnsatCore(void) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
   NodeManagerScope scope(getNodeManager());
-  CVC4_API_CHECK(d_smtEngine->getOptions()[options::unsatCores])
+  CVC4_API_CHECK(d_smtEngine->getOptions()[options::unsatCores]
+                 || d_smtEngine->getOptions()[options::unsatCoresAssumptions])
       << "Cannot get unsat core unless explicitly enabled "
          "(try --produce-unsat-cores)";
   CVC4_API_RECOVERABLE_CHECK(d_smtEngine->getSmtMode() == SmtMode::UNSAT)
@@ -6335,7 +6816,11 @@ Term Solver::getValue(const Term& term) const
   CVC4_API_TRY_CATCH_BEGIN;
   CVC4_API_SOLVER_CHECK_TERM(term);
   //////// all checks before this line
-  return getValueHelper(term);
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::GET_VALUE);
+  Term res = getValueHelper(term);
+  tc.addTerm(*term.d_node);
+  tc.doneTerm(*res.d_node);
+  return res;
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -6456,10 +6941,13 @@ void Solver::pop(uint32_t nscopes) const
   CVC4_API_CHECK(nscopes <= d_smtEngine->getNumUserLevels())
       << "Cannot pop beyond first pushed context";
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::POP);
   for (uint32_t n = 0; n < nscopes; ++n)
   {
     d_smtEngine->pop();
   }
+  tc.addInt(nscopes);
+  tc.done();
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -6569,6 +7057,35 @@ void Solver::blockModelValues(const std::vector<Term>& terms) const
   CVC4_API_TRY_CATCH_END;
 }
 
+Result Solver::enumerateModels(const std::vector<Term>& terms,
+                               ModelListener& l,
+                               uint64_t limit) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_CHECK(d_smtEngine->getOptions()[options::produceModels])
+      << "Cannot enumerate models unless model generation is enabled "
+         "(try --produce-models)";
+  CVC4_API_CHECK(d_smtEngine->getOptions()[options::incrementalSolving])
+      << "Cannot enumerate models unless incremental solving is enabled "
+         "(try --incremental)";
+  CVC4_API_SOLVER_CHECK_TERMS(terms);
+  //////// all checks before this line
+  std::function<bool(const std::vector<cvc5::Node>&)> notify =
+      [this, &l, &terms](const std::vector<cvc5::Node>& values) {
+        std::vector<Term> vals;
+        for (const cvc5::Node& v : values)
+        {
+          vals.push_back(Term(this, v));
+        }
+        return l.notify(terms, vals);
+      };
+  return Result(d_smtEngine->enumerateModels(
+      Term::termVectorToNodes(terms), notify, limit));
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
 void Solver::printInstantiations(std::ostream& out) const
 {
   NodeManagerScope scope(getNodeManager());
@@ -6589,10 +7106,13 @@ void Solver::push(uint32_t nscopes) const
   CVC4_API_CHECK(d_smtEngine->getOptions()[options::incrementalSolving])
       << "Cannot push when not solving incrementally (use --incremental)";
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::PUSH);
   for (uint32_t n = 0; n < nscopes; ++n)
   {
     d_smtEngine->push();
   }
+  tc.addInt(nscopes);
+  tc.done();
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -6604,7 +7124,9 @@ void Solver::resetAssertions(void) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::RESET_ASSERTIONS);
   d_smtEngine->resetAssertions();
+  tc.done();
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -6648,7 +7170,10 @@ void Solver::setLogic(const std::string& logic) const
       << "Invalid call to 'setLogic', solver is already fully initialized";
   cvc5::LogicInfo logic_info(logic);
   //////// all checks before this line
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::SET_LOGIC);
   d_smtEngine->setLogic(logic_info);
+  tc.addString(logic);
+  tc.done();
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -6664,6 +7189,18 @@ void Solver::setOption(const std::string& option,
       << "Invalid call to 'setOption', solver is already fully initialized";
   //////// all checks before this line
   d_smtEngine->setOption(option, value);
+  setTypeCheckingLevel();
+  if (option == "api-trace")
+  {
+    // the option itself is not recorded, since the replay would overwrite
+    // the trace
+    d_trace.reset(value.empty() ? nullptr : new TraceRecorder(value));
+    return;
+  }
+  TraceRecorder::Call tc(d_trace.get(), TraceOp::SET_OPTION);
+  tc.addString(option);
+  tc.addString(value);
+  tc.done();
   ////////
   CVC4_API_TRY_CATCH_END;
 }
@@ -6824,6 +7361,65 @@ Result Solver::checkSynth() const
   CVC4_API_TRY_CATCH_END;
 }
 
+namespace {
+
+/**
+ * The internal listener for the solutions of Solver::checkSynthAnytime, which
+ * is registered with the SMT engine for the duration of the call.
+ */
+class SynthSolutionNotify : public cvc5::smt::SygusSolutionListener
+{
+ public:
+  SynthSolutionNotify(
+      cvc5::SmtEngine* smte,
+      std::function<bool(const std::map<cvc5::Node, cvc5::Node>&)> notify)
+      : d_smte(smte), d_notify(notify)
+  {
+    d_smte->setSygusSolutionListener(this);
+  }
+  ~SynthSolutionNotify() { d_smte->setSygusSolutionListener(nullptr); }
+  bool notifySolution(const std::map<cvc5::Node, cvc5::Node>& sols) override
+  {
+    return d_notify(sols);
+  }
+
+ private:
+  cvc5::SmtEngine* d_smte;
+  std::function<bool(const std::map<cvc5::Node, cvc5::Node>&)> d_notify;
+};
+
+}  // namespace
+
+Result Solver::checkSynthAnytime(SynthSolutionListener& l) const
+{
+  CVC4_API_TRY_CATCH_BEGIN;
+  CVC4_API_CHECK(d_smtEngine->getOptions()[options::sygusStream])
+      << "Cannot check synthesis in anytime mode unless sygus-stream is "
+         "enabled (try --sygus-stream)";
+  //////// all checks before this line
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::function<bool(const std::map<cvc5::Node, cvc5::Node>&)> notify =
+      [this, &l, start](const std::map<cvc5::Node, cvc5::Node>& m) {
+        std::vector<Term> fs;
+        std::vector<Term> sols;
+        for (const std::pair<const cvc5::Node, cvc5::Node>& s : m)
+        {
+          fs.push_back(Term(this, s.first));
+          sols.push_back(Term(this, s.second));
+        }
+        uint64_t elapsedMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count();
+        return l.notify(fs, sols, elapsedMs);
+      };
+  SynthSolutionNotify ssn(d_smtEngine.get(), notify);
+  return d_smtEngine->checkSynth();
+  ////////
+  CVC4_API_TRY_CATCH_END;
+}
+
 Term Solver::getSynthSolution(Term term) const
 {
   CVC4_API_TRY_CATCH_BEGIN;
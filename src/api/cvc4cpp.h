@@ -21,6 +21,7 @@
 
 #include "api/cvc4cppkind.h"
 
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -51,6 +52,7 @@ namespace api {
 
 class Solver;
 struct Statistics;
+class TraceRecorder;
 
 /* -------------------------------------------------------------------------- */
 /* Exception                                                                  */
@@ -2254,6 +2256,76 @@ struct CVC4_EXPORT RoundingModeHashFunction
   inline size_t operator()(const RoundingMode& rm) const;
 };
 
+/* -------------------------------------------------------------------------- */
+/* Synthesis Solution Listener                                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A listener for the solutions found by Solver::checkSynthAnytime.
+ */
+class CVC4_EXPORT SynthSolutionListener
+{
+ public:
+  virtual ~SynthSolutionListener() {}
+  /**
+   * Notify that sols[i] is a solution for the function-to-synthesize fs[i],
+   * for all i, which was found after the given number of milliseconds since
+   * the start of the call to Solver::checkSynthAnytime.
+   * @param fs the functions-to-synthesize
+   * @param sols the solutions
+   * @param elapsedMs the time to find this solution, in milliseconds
+   * @return true if the search should stop with this solution
+   */
+  virtual bool notify(const std::vector<Term>& fs,
+                      const std::vector<Term>& sols,
+                      uint64_t elapsedMs) = 0;
+};
+
+/* -------------------------------------------------------------------------- */
+/* Model Listener                                                             */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A listener for the models found by Solver::enumerateModels.
+ */
+class CVC4_EXPORT ModelListener
+{
+ public:
+  virtual ~ModelListener() {}
+  /**
+   * Notify that there is a model in which terms[i] has the value values[i],
+   * for all i, which is distinct from the models notified before.
+   * @param terms the terms given to Solver::enumerateModels
+   * @param values the values of the terms in the model
+   * @return true if the enumeration should stop with this model
+   */
+  virtual bool notify(const std::vector<Term>& terms,
+                      const std::vector<Term>& values) = 0;
+};
+
+/* -------------------------------------------------------------------------- */
+/* Check Progress Listener                                                    */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A listener for the progress of the checks started by Solver::checkSatAsync.
+ */
+class CVC4_EXPORT CheckProgressListener
+{
+ public:
+  virtual ~CheckProgressListener() {}
+  /**
+   * Notify about the progress of the running check. This is called on the
+   * thread running the check, which is blocked until it returns.
+   * @param conflicts the number of conflicts of the SAT solver in this check
+   * @param lemmas the number of lemmas in this check
+   * @param elapsedMs the time since the start of this check, in milliseconds
+   */
+  virtual void notify(uint64_t conflicts,
+                      uint64_t lemmas,
+                      uint64_t elapsedMs) = 0;
+};
+
 /* -------------------------------------------------------------------------- */
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
@@ -2286,6 +2358,24 @@ class CVC4_EXPORT Solver
    */
   Solver(Options* opts = nullptr);
 
+  /**
+   * Constructor for a solver that shares the terms of another solver.
+   *
+   * Both solvers use the same term store, so that the terms and sorts of
+   * one of them can be used by the other one without being exported, and
+   * each term is stored once no matter how many solvers use it. Each solver
+   * has its own assertions and options. The term store is not thread-safe:
+   * solvers that share terms must not be used concurrently. A term must not
+   * be used after the solver that created it has been destroyed, whereas
+   * the term store lives as long as one of the solvers that share it.
+   *
+   * @param peer the solver whose terms are shared
+   * @param opts a pointer to a solver options object, or nullptr for the
+   *             default options
+   * @return the Solver
+   */
+  Solver(Solver& peer, Options* opts);
+
   /**
    * Destructor.
    */
@@ -2303,6 +2393,23 @@ class CVC4_EXPORT Solver
 
   bool supportsFloatingPoint() const;
 
+  /**
+   * Create a solver that is configured as this solver, i.e., this solver is
+   * used as a template for the new one.
+   *
+   * The new solver has the logic and the options of this solver, after they
+   * have been finalized by the heuristics that choose the default options
+   * for the logic, and shares the terms of this solver as described at
+   * Solver(Solver&, Options*). The options and the logic are finalized only
+   * once, which makes creating many short-lived solvers with the same
+   * configuration cheaper. The new solver has none of the assertions of this
+   * solver. Both solvers are fully initialized by this call, i.e., their
+   * logic and options cannot be changed anymore.
+   *
+   * @return the new solver
+   */
+  std::unique_ptr<Solver> cloneConfiguration();
+
   /* .................................................................... */
   /* Sorts Handling                                                       */
   /* .................................................................... */
@@ -2534,6 +2641,25 @@ class CVC4_EXPORT Solver
    */
   Term mkTerm(Kind kind, const std::vector<Term>& children) const;
 
+  /**
+   * Create a DAG of terms of given kinds in one call, which avoids the
+   * overhead of calling mkTerm() for each term. The terms are described by
+   * records in the order of creation: the i-th term has kind kinds[i], and
+   * its record in children consists of its number of children followed by
+   * their indices. An index j < leaves.size() refers to leaves[j], and an
+   * index leaves.size() + k refers to the k-th created term, which must come
+   * before the term that refers to it. For example, with leaves x and y,
+   * kinds { PLUS, MULT } and children { 2, 0, 1, 2, 2, 0 } create the terms
+   * (+ x y) and (* (+ x y) x).
+   * @param leaves the terms the DAG refers to
+   * @param kinds the kinds of the terms to create
+   * @param children the records of the children of the terms to create
+   * @return the created terms, in the order of kinds
+   */
+  std::vector<Term> mkTerms(const std::vector<Term>& leaves,
+                            const std::vector<Kind>& kinds,
+                            const std::vector<uint32_t>& children) const;
+
   /**
    * Create nullary term of given kind from a given operator.
    * Create operators with mkOp().
@@ -3031,6 +3157,28 @@ class CVC4_EXPORT Solver
    */
   Result checkSat() const;
 
+  /**
+   * Check satisfiability on a new thread, as checkSat() does. Until the
+   * returned future is ready, this solver must not be used except for
+   * calling cancel(), and the terms of this solver must not be created or
+   * destroyed. A cancel() request before this call is discarded.
+   * @param listener if not null, the listener that is notified about the
+   *                 progress of the check
+   * @param intervalMs the time between two notifications of listener, in
+   *                   milliseconds
+   * @return the future result of the satisfiability check
+   */
+  std::future<Result> checkSatAsync(CheckProgressListener* listener = nullptr,
+                                    uint64_t intervalMs = 1000) const;
+
+  /**
+   * Cancel the running check started by checkSatAsync(), which then returns
+   * an unknown result with explanation INTERRUPTED. Unlike all other methods
+   * of this class, this method may be called from any thread; it only sets
+   * a flag that the check polls.
+   */
+  void cancel() const;
+
   /**
    * Check satisfiability assuming the given formula.
    * SMT-LIB: ( check-sat-assuming ( <prop_literal> ) )
@@ -3189,6 +3337,55 @@ class CVC4_EXPORT Solver
    */
   std::vector<Term> getAssertions() const;
 
+  /**
+   * Get the clauses learned so far by the SAT solver with at most maxSize
+   * literals and literal block distance at most maxLbd, where 0 means no
+   * bound. The clauses are disjunctions of literals over the declared symbols
+   * that are consequences of the current assertions. Clauses over internal
+   * symbols are omitted. Requires a SAT solver that supports it, which is
+   * currently only Minisat.
+   * @param maxSize the maximal number of literals of the clauses
+   * @param maxLbd the maximal literal block distance of the clauses
+   * @return the learned clauses
+   */
+  std::vector<Term> getLearnedClauses(uint32_t maxSize = 0,
+                                      uint32_t maxLbd = 0) const;
+
+  /**
+   * Add clauses learned for the current assertions, e.g. the result of
+   * getLearnedClauses() on another solver instance for the same assertions,
+   * as redundant clauses of the SAT solver. The clauses must be consequences
+   * of the current assertions, which is not checked. Not permitted when
+   * producing proofs or unsat cores.
+   * @param clauses the learned clauses
+   */
+  void addLearnedClauses(const std::vector<Term>& clauses) const;
+
+  /**
+   * Preprocess the current assertions and write the resulting state (the
+   * preprocessed assertions, their skolem definitions and the substitutions
+   * learned from them) to a file, from which it can be restored by
+   * loadSnapshot() in another solver instance. Only permitted before the
+   * first check and at user level 0, and not when producing proofs or unsat
+   * cores.
+   * @param filename the name of the file
+   */
+  void saveSnapshot(const std::string& filename) const;
+
+  /**
+   * Restore the state written by saveSnapshot() to a file, without
+   * preprocessing its assertions again. The symbols of the file that have
+   * the name of one of the given declared symbols are mapped to it, and
+   * similarly for the uninterpreted sorts of their sorts; the other symbols
+   * are created fresh. The restored assertions are not returned by
+   * getAssertions(). Only permitted under the same conditions as
+   * saveSnapshot().
+   * @param filename the name of the file
+   * @param decls the declared symbols of this solver used by the file
+   */
+  void loadSnapshot(const std::string& filename,
+                    const std::vector<Term>& decls) const;
+
   /**
    * Get info from the solver.
    * SMT-LIB: ( get-info <info_flag> )
@@ -3371,6 +3568,26 @@ class CVC4_EXPORT Solver
    */
   void blockModelValues(const std::vector<Term>& terms) const;
 
+  /**
+   * Enumerate the models of the current assertions that differ in the values
+   * of the given terms, which are passed to the listener. This is equivalent
+   * to calling checkSat() and then alternating blockModelValues(terms) and
+   * checkSat() until the result is not sat, except that the blocking clauses
+   * are added directly to the SAT solver, which keeps its state between the
+   * models, and that they are not added to the assertions.
+   *
+   * Requires enabling the 'produce-models' and 'incremental' options.
+   *
+   * @param terms the terms whose values distinguish the models
+   * @param l the listener for the models
+   * @param limit the maximal number of models, 0 for no limit
+   * @return the result of the last check, which is unsat if all models were
+   * enumerated, and sat if the listener or the limit stopped the enumeration.
+   */
+  Result enumerateModels(const std::vector<Term>& terms,
+                         ModelListener& l,
+                         uint64_t limit = 0) const;
+
   /**
    * Print all instantiations made by the quantifiers module.
    * @param out the output stream
@@ -3520,6 +3737,21 @@ class CVC4_EXPORT Solver
    */
   Result checkSynth() const;
 
+  /**
+   * Try to find a solution for the synthesis conjecture as in checkSynth, in
+   * anytime mode. Each solution that is found is passed to the listener,
+   * instead of being printed. If the listener returns true, the search stops
+   * and the result is unsat, where the last solution is the solution of the
+   * conjecture (see getSynthSolution). Otherwise, the solution is excluded
+   * and the search continues.
+   *
+   * Requires to enable option 'sygus-stream'.
+   *
+   * @param l the listener for the solutions
+   * @return the result of the synthesis conjecture.
+   */
+  Result checkSynthAnytime(SynthSolutionListener& l) const;
+
   /**
    * Get the synthesis solution of the given term. This method should be called
    * immediately after the solver answers unsat for sygus input.
@@ -3552,11 +3784,40 @@ class CVC4_EXPORT Solver
   Options& getOptions(void);
 
  private:
+  /**
+   * Constructor, which shares the terms of peer if it is not null.
+   * @param peer the solver whose terms are shared, or nullptr
+   * @param opts a pointer to a solver options object, or nullptr
+   */
+  Solver(Solver* peer, Options* opts);
+
   /** @return the node manager of this solver */
   NodeManager* getNodeManager(void) const;
 
   /** Helper to check for API misuse in mkOp functions. */
   void checkMkTerm(Kind kind, uint32_t nchildren) const;
+
+  /**
+   * @return true if the objects of solvers s1 and s2 can be mixed, i.e., if
+   * they are the same solver or share their terms
+   */
+  static bool sharesTerms(const Solver* s1, const Solver* s2);
+
+  /**
+   * @return true if the arguments of the term construction functions are
+   * checked, which is the case unless option api-checks is none
+   */
+  bool checkArgs() const;
+  /**
+   * @return true if created terms are type checked eagerly, which is the
+   * case if option api-checks is full
+   */
+  bool checkTypes() const;
+  /**
+   * Enable type checking in the node manager unless option api-checks is
+   * none.
+   */
+  void setTypeCheckingLevel() const;
   /** Helper for mk-functions that call d_nodeMgr->mkConst(). */
   template <typename T>
   Term mkValHelper(T t) const;
@@ -3600,6 +3861,16 @@ class CVC4_EXPORT Solver
    */
   Term mkTermHelper(Kind kind, const std::vector<Term>& children) const;
 
+  /**
+   * Create the node of the n-ary term of given kind, as mkTermHelper() does,
+   * from the nodes of its children.
+   * @param kind the kind of the term
+   * @param echildren the nodes of the children of the term
+   * @return the node of the term
+   */
+  cvc5::Node mkNodeHelper(Kind kind,
+                          const std::vector<cvc5::Node>& echildren) const;
+
   /**
    * Create n-ary term of given kind from a given operator.
    * @param op the operator
@@ -3644,14 +3915,19 @@ class CVC4_EXPORT Solver
 
   /** Keep a copy of the original option settings (for resets). */
   std::unique_ptr<Options> d_originalOptions;
-  /** The node manager of this solver. */
-  std::unique_ptr<NodeManager> d_nodeMgr;
+  /**
+   * The node manager of this solver, which is shared with the solvers that
+   * are constructed from it, see Solver(Solver&, Options*).
+   */
+  std::shared_ptr<NodeManager> d_nodeMgr;
   /** The statistics collected on the Api level. */
   std::unique_ptr<Statistics> d_stats;
   /** The SMT engine of this solver. */
   std::unique_ptr<SmtEngine> d_smtEngine;
   /** The random number generator of this solver. */
   std::unique_ptr<Random> d_rng;
+  /** The recorder of the trace of the calls, see option --api-trace. */
+  mutable std::unique_ptr<TraceRecorder> d_trace;
 };
 
 }  // namespace api
@@ -148,6 +148,9 @@ cdef extern from "api/cvc4cpp.h" namespace "cvc5::api":
         Sort mkTupleSort(const vector[Sort]& sorts) except +
         Term mkTerm(Op op) except +
         Term mkTerm(Op op, const vector[Term]& children) except +
+        vector[Term] mkTerms(const vector[Term]& leaves,
+                             const vector[Kind]& kinds,
+                             const vector[uint32_t]& children) except +
         Op mkOp(Kind kind) except +
         Op mkOp(Kind kind, Kind k) except +
         Op mkOp(Kind kind, const string& arg) except +
@@ -212,8 +215,8 @@ cdef extern from "api/cvc4cpp.h" namespace "cvc5::api":
         Term mkVar(Sort sort) except +
         Term simplify(const Term& t) except +
         void assertFormula(Term term) except +
-        Result checkSat() except +
-        Result checkSatAssuming(const vector[Term]& assumptions) except +
+        Result checkSat() nogil except +
+        Result checkSatAssuming(const vector[Term]& assumptions) nogil except +
         Result checkEntailed(const vector[Term]& assumptions) except +
         Sort declareDatatype(const string& symbol, const vector[DatatypeConstructorDecl]& ctors)
         Term declareFun(const string& symbol, Sort sort) except +
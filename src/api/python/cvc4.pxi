@@ -2,8 +2,11 @@ from collections import defaultdict
 from fractions import Fraction
 import sys
 
+from array import array
 from libc.stdint cimport int32_t, int64_t, uint32_t, uint64_t
 
+from cpython cimport array as c_array
+
 from libcpp.pair cimport pair
 from libcpp.set cimport set
 from libcpp.string cimport string
@@ -610,6 +613,36 @@ cdef class Solver:
             term.cterm = self.csolver.mkTerm((<Op?> op).cop, v)
         return term
 
+    def mkTerms(self, leaves, kinds, children):
+        '''
+            Creates a DAG of terms in one call, see Solver::mkTerms in the
+            C++ API. The i-th created term has kind kinds[i], and children
+            is a flat sequence of integers, e.g. an array('I') or a numpy
+            array, that consists of the number of children of each created
+            term followed by their indices. An index j < len(leaves) refers
+            to leaves[j], and an index len(leaves) + k to the k-th created
+            term.
+
+            Returns the list of created terms.
+        '''
+        cdef vector[c_Term] cleaves
+        cdef vector[c_Kind] ckinds
+        cdef vector[uint32_t] cchildren
+        for l in leaves:
+            cleaves.push_back((<Term?> l).cterm)
+        ckinds.reserve(len(kinds))
+        for k in kinds:
+            ckinds.push_back((<kind?> k).k)
+        cchildren.reserve(len(children))
+        for c in children:
+            cchildren.push_back(c)
+        terms = []
+        for t in self.csolver.mkTerms(cleaves, ckinds, cchildren):
+            term = Term(self)
+            term.cterm = t
+            terms.append(term)
+        return terms
+
     def mkOp(self, kind k, arg0=None, arg1 = None):
         '''
         Supports the following uses:
@@ -883,8 +916,13 @@ cdef class Solver:
         self.csolver.assertFormula(term.cterm)
 
     def checkSat(self):
+        '''
+            The GIL is released while solving, so that other Python threads
+            may run, but they must not use this solver in the meantime.
+        '''
         cdef Result r = Result()
-        r.cr = self.csolver.checkSat()
+        with nogil:
+            r.cr = self.csolver.checkSat()
         return r
 
     def mkSygusGrammar(self, boundVars, ntSymbols):
@@ -958,7 +996,8 @@ cdef class Solver:
         cdef vector[c_Term] v
         for a in assumptions:
             v.push_back((<Term?> a).cterm)
-        r.cr = self.csolver.checkSatAssuming(<const vector[c_Term]&> v)
+        with nogil:
+            r.cr = self.csolver.checkSatAssuming(<const vector[c_Term]&> v)
         return r
 
     @expand_list_arg(num_req_args=0)
@@ -1117,6 +1156,52 @@ cdef class Solver:
         term.cterm = self.csolver.getValue(t.cterm)
         return term
 
+    def getValues(self, terms):
+        '''
+            Returns the list of the values of terms in the current model,
+            which are computed in a single call.
+        '''
+        cdef vector[c_Term] v
+        v.reserve(len(terms))
+        for t in terms:
+            v.push_back((<Term?> t).cterm)
+        values = []
+        for c in self.csolver.getValue(<const vector[c_Term]&> v):
+            term = Term(self)
+            term.cterm = c
+            values.append(term)
+        return values
+
+    def getBitVectorValues(self, terms):
+        '''
+            Returns the values of the bit-vector terms in the current model
+            as an array('Q') of unsigned integers, which supports the buffer
+            protocol, e.g. for numpy.frombuffer. The terms must have
+            bit-vector sorts of width at most 64.
+        '''
+        cdef vector[c_Term] v
+        cdef vector[c_Term] cvalues
+        cdef string s
+        cdef uint64_t val
+        cdef size_t i, j
+        v.reserve(len(terms))
+        for t in terms:
+            if not t.getSort().isBitVector() or t.getSort().getBVSize() > 64:
+                raise ValueError("Expected a bit-vector term of width at most"
+                                 " 64, got {}".format(t))
+            v.push_back((<Term?> t).cterm)
+        cvalues = self.csolver.getValue(<const vector[c_Term]&> v)
+        cdef c_array.array res = c_array.clone(array('Q'), cvalues.size(),
+                                               zero=False)
+        for i in range(cvalues.size()):
+            # values are printed in the format #b<bits>
+            s = cvalues[i].toString()
+            val = 0
+            for j in range(2, s.size()):
+                val = (val << 1) | (s[j] == b'1')
+            res.data.as_ulonglongs[i] = val
+        return res
+
     def getSeparationHeap(self):
         cdef Term term = Term(self)
         term.cterm = self.csolver.getSeparationHeap()
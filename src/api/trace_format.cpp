@@ -0,0 +1,200 @@
+/*********************                                                        */
+/*! \file trace_format.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The binary format of the traces of API calls.
+ **/
+
+#include "api/trace_format.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace cvc5 {
+namespace api {
+
+namespace {
+
+/** The magic number and version at the start of a trace */
+const char s_traceMagic[] = "CVC4TRC1";
+const size_t s_traceMagicSize = sizeof(s_traceMagic) - 1;
+/** The bound on the lengths of the lists and strings of a call */
+const uint64_t s_maxLength = uint64_t(1) << 32;
+
+void writeVarint(std::ostream& out, uint64_t v)
+{
+  char buf[10];
+  size_t n = 0;
+  while (v >= 0x80)
+  {
+    buf[n++] = static_cast<char>((v & 0x7f) | 0x80);
+    v >>= 7;
+  }
+  buf[n++] = static_cast<char>(v);
+  out.write(buf, n);
+}
+
+uint64_t zigzag(int64_t v)
+{
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v)
+{
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+}  // namespace
+
+const char* toString(TraceOp op)
+{
+  switch (op)
+  {
+    case TraceOp::SET_OPTION: return "setOption";
+    case TraceOp::SET_LOGIC: return "setLogic";
+    case TraceOp::GET_BOOLEAN_SORT: return "getBooleanSort";
+    case TraceOp::GET_INTEGER_SORT: return "getIntegerSort";
+    case TraceOp::GET_REAL_SORT: return "getRealSort";
+    case TraceOp::GET_STRING_SORT: return "getStringSort";
+    case TraceOp::MK_BV_SORT: return "mkBitVectorSort";
+    case TraceOp::MK_ARRAY_SORT: return "mkArraySort";
+    case TraceOp::MK_FUNCTION_SORT: return "mkFunctionSort";
+    case TraceOp::MK_UNINTERPRETED_SORT: return "mkUninterpretedSort";
+    case TraceOp::DECLARE_SORT: return "declareSort";
+    case TraceOp::MK_BOOLEAN: return "mkBoolean";
+    case TraceOp::MK_INTEGER: return "mkInteger";
+    case TraceOp::MK_REAL: return "mkReal";
+    case TraceOp::MK_STRING: return "mkString";
+    case TraceOp::MK_BV: return "mkBitVector";
+    case TraceOp::MK_CONST: return "mkConst";
+    case TraceOp::MK_VAR: return "mkVar";
+    case TraceOp::DECLARE_FUN: return "declareFun";
+    case TraceOp::MK_TERM: return "mkTerm";
+    case TraceOp::MK_OP: return "mkOp";
+    case TraceOp::MK_TERM_OP: return "mkTermOp";
+    case TraceOp::DEFINE_FUN: return "defineFun";
+    case TraceOp::ASSERT: return "assertFormula";
+    case TraceOp::CHECK_SAT: return "checkSat";
+    case TraceOp::CHECK_SAT_ASSUMING: return "checkSatAssuming";
+    case TraceOp::PUSH: return "push";
+    case TraceOp::POP: return "pop";
+    case TraceOp::RESET_ASSERTIONS: return "resetAssertions";
+    case TraceOp::GET_VALUE: return "getValue";
+    case TraceOp::SIMPLIFY: return "simplify";
+    default: return "?";
+  }
+}
+
+void writeTraceHeader(std::ostream& out)
+{
+  out.write(s_traceMagic, s_traceMagicSize);
+}
+
+void writeTraceCall(std::ostream& out, const TraceCall& call)
+{
+  out.put(static_cast<char>(call.d_op));
+  writeVarint(out, call.d_ints.size());
+  for (int64_t i : call.d_ints)
+  {
+    writeVarint(out, zigzag(i));
+  }
+  writeVarint(out, call.d_strs.size());
+  for (const std::string& s : call.d_strs)
+  {
+    writeVarint(out, s.size());
+    out.write(s.data(), s.size());
+  }
+}
+
+TraceReader::TraceReader(std::istream& in) : d_in(in), d_valid(false)
+{
+  char magic[s_traceMagicSize];
+  d_in.read(magic, s_traceMagicSize);
+  d_valid = d_in.gcount() == static_cast<std::streamsize>(s_traceMagicSize)
+            && std::memcmp(magic, s_traceMagic, s_traceMagicSize) == 0;
+}
+
+bool TraceReader::readVarint(uint64_t& v)
+{
+  v = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    int c = d_in.get();
+    if (c == std::istream::traits_type::eof())
+    {
+      return false;
+    }
+    v |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if ((c & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TraceReader::read(TraceCall& call)
+{
+  if (!d_valid)
+  {
+    return false;
+  }
+  int op = d_in.get();
+  if (op == std::istream::traits_type::eof())
+  {
+    // the end of the trace
+    return false;
+  }
+  d_valid = false;
+  if (op >= static_cast<int>(TraceOp::LAST))
+  {
+    return false;
+  }
+  call.d_op = static_cast<TraceOp>(op);
+  call.d_ints.clear();
+  call.d_strs.clear();
+  uint64_t n, v;
+  if (!readVarint(n) || n > s_maxLength)
+  {
+    return false;
+  }
+  for (uint64_t i = 0; i < n; i++)
+  {
+    if (!readVarint(v))
+    {
+      return false;
+    }
+    call.d_ints.push_back(unzigzag(v));
+  }
+  if (!readVarint(n) || n > s_maxLength)
+  {
+    return false;
+  }
+  for (uint64_t i = 0; i < n; i++)
+  {
+    if (!readVarint(v) || v > s_maxLength)
+    {
+      return false;
+    }
+    std::string s(v, '\0');
+    d_in.read(&s[0], v);
+    if (d_in.gcount() != static_cast<std::streamsize>(v))
+    {
+      return false;
+    }
+    call.d_strs.push_back(std::move(s));
+  }
+  d_valid = true;
+  return true;
+}
+
+}  // namespace api
+}  // namespace cvc5
@@ -0,0 +1,162 @@
+/*********************                                                        */
+/*! \file trace_format.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The binary format of the traces of API calls.
+ **
+ ** The binary format of the traces of API calls, which are recorded by
+ ** --api-trace and re-executed by cvc4-replay.
+ **/
+
+#include "cvc4_export.h"
+
+#ifndef CVC4__API__TRACE_FORMAT_H
+#define CVC4__API__TRACE_FORMAT_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace cvc5 {
+namespace api {
+
+/**
+ * The operations of the calls of a trace. The arguments of a call are a list
+ * of integers, which are kinds, numbers, and the ids of terms, sorts and
+ * operators, and a list of strings, as documented for each operation. Each
+ * call that returns a term, sort or operator assigns it the next id among
+ * the terms, sorts or operators, respectively, starting from 0.
+ */
+enum class TraceOp : uint8_t
+{
+  /** Solver::setOption, strings: name, value */
+  SET_OPTION,
+  /** Solver::setLogic, strings: logic */
+  SET_LOGIC,
+  /** Solver::getBooleanSort, returns a sort */
+  GET_BOOLEAN_SORT,
+  /** Solver::getIntegerSort, returns a sort */
+  GET_INTEGER_SORT,
+  /** Solver::getRealSort, returns a sort */
+  GET_REAL_SORT,
+  /** Solver::getStringSort, returns a sort */
+  GET_STRING_SORT,
+  /** Solver::mkBitVectorSort, integers: size, returns a sort */
+  MK_BV_SORT,
+  /** Solver::mkArraySort, integers: index sort, element sort */
+  MK_ARRAY_SORT,
+  /** Solver::mkFunctionSort, integers: domain sorts..., codomain sort */
+  MK_FUNCTION_SORT,
+  /** Solver::mkUninterpretedSort, strings: symbol, returns a sort */
+  MK_UNINTERPRETED_SORT,
+  /** Solver::declareSort, integers: arity, strings: symbol, returns a sort */
+  DECLARE_SORT,
+  /** Solver::mkBoolean, integers: value, returns a term */
+  MK_BOOLEAN,
+  /** Solver::mkInteger, strings: value, returns a term */
+  MK_INTEGER,
+  /** Solver::mkReal, strings: value, returns a term */
+  MK_REAL,
+  /** Solver::mkString, integers: useEscSequences, strings: value */
+  MK_STRING,
+  /** Solver::mkBitVector, integers: size, strings: decimal value */
+  MK_BV,
+  /** Solver::mkConst, integers: sort, strings: symbol (optional) */
+  MK_CONST,
+  /** Solver::mkVar, integers: sort, strings: symbol */
+  MK_VAR,
+  /** Solver::declareFun, integers: domain sorts..., codomain, strings: name */
+  DECLARE_FUN,
+  /** Solver::mkTerm, integers: kind, children..., returns a term */
+  MK_TERM,
+  /** Solver::mkOp, integers: kind, indices..., returns an operator */
+  MK_OP,
+  /** Solver::mkTerm, integers: operator, children..., returns a term */
+  MK_TERM_OP,
+  /**
+   * Solver::defineFun, integers: sort, body, global, bound variables...,
+   * strings: symbol, returns a term
+   */
+  DEFINE_FUN,
+  /** Solver::assertFormula, integers: term */
+  ASSERT,
+  /** Solver::checkSat */
+  CHECK_SAT,
+  /** Solver::checkSatAssuming, integers: assumptions... */
+  CHECK_SAT_ASSUMING,
+  /** Solver::push, integers: number of scopes */
+  PUSH,
+  /** Solver::pop, integers: number of scopes */
+  POP,
+  /** Solver::resetAssertions */
+  RESET_ASSERTIONS,
+  /** Solver::getValue, integers: term, returns a term */
+  GET_VALUE,
+  /** Solver::simplify, integers: term, returns a term */
+  SIMPLIFY,
+  /** The number of operations */
+  LAST
+};
+
+/** Get the name of the given operation */
+CVC4_EXPORT const char* toString(TraceOp op);
+
+/** A call of a trace */
+struct CVC4_EXPORT TraceCall
+{
+  TraceCall() : d_op(TraceOp::LAST) {}
+  /** The operation */
+  TraceOp d_op;
+  /** The integer arguments */
+  std::vector<int64_t> d_ints;
+  /** The string arguments */
+  std::vector<std::string> d_strs;
+};
+
+/** Write the header of a trace to out */
+CVC4_EXPORT void writeTraceHeader(std::ostream& out);
+
+/**
+ * Write the given call to out. The operation is written as a byte, followed
+ * by the number of integers and the integers, and the number of strings and
+ * the strings, each preceded by its length. All numbers are written as
+ * variable-length integers, where the signed ones are zigzag-encoded.
+ */
+CVC4_EXPORT void writeTraceCall(std::ostream& out, const TraceCall& call);
+
+/** Reads the calls of a trace */
+class CVC4_EXPORT TraceReader
+{
+ public:
+  /** Reads the header of the trace from in. */
+  TraceReader(std::istream& in);
+  /** Whether the trace has a valid header */
+  bool isValid() const { return d_valid; }
+  /**
+   * Read the next call into call. Returns false at the end of the trace or if
+   * the trace is truncated or malformed, in which case the trace becomes
+   * invalid.
+   */
+  bool read(TraceCall& call);
+
+ private:
+  /** Read a variable-length integer into v */
+  bool readVarint(uint64_t& v);
+  /** The input stream */
+  std::istream& d_in;
+  /** Whether the trace is valid */
+  bool d_valid;
+};
+
+}  // namespace api
+}  // namespace cvc5
+
+#endif
@@ -0,0 +1,192 @@
+/*********************                                                        */
+/*! \file trace_recorder.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The recorder of the traces of the calls of an API solver.
+ **/
+
+#include "api/trace_recorder.h"
+
+#include "base/output.h"
+#include "options/option_exception.h"
+
+namespace cvc5 {
+namespace api {
+
+namespace {
+
+/** The size of the buffer of a trace file */
+const size_t s_bufferSize = 1 << 20;
+
+}  // namespace
+
+TraceRecorder::TraceRecorder(const std::string& filename)
+    : d_buffer(new char[s_bufferSize]),
+      d_depth(0),
+      d_numSkipped(0),
+      d_numTerms(0),
+      d_numSorts(0),
+      d_numOps(0)
+{
+  d_out.rdbuf()->pubsetbuf(d_buffer.get(), s_bufferSize);
+  d_out.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!d_out)
+  {
+    throw OptionException("Cannot open API trace file: " + filename);
+  }
+  writeTraceHeader(d_out);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+  d_out.close();
+  if (d_numSkipped > 0)
+  {
+    Warning() << "API trace: " << d_numSkipped
+              << " calls with arguments that were not built by recorded calls "
+                 "were not recorded"
+              << std::endl;
+  }
+}
+
+TraceRecorder::Call::Call(TraceRecorder* tr, TraceOp op)
+    : d_tr(tr), d_active(false), d_known(true)
+{
+  // the calls made by a recorded call are not recorded
+  if (d_tr != nullptr && d_tr->d_depth++ == 0)
+  {
+    d_active = true;
+    d_tr->d_call.d_op = op;
+    d_tr->d_call.d_ints.clear();
+    d_tr->d_call.d_strs.clear();
+  }
+}
+
+TraceRecorder::Call::~Call()
+{
+  if (d_tr != nullptr)
+  {
+    d_tr->d_depth--;
+  }
+}
+
+void TraceRecorder::Call::addInt(int64_t i)
+{
+  if (d_active)
+  {
+    d_tr->d_call.d_ints.push_back(i);
+  }
+}
+
+void TraceRecorder::Call::addString(const std::string& s)
+{
+  if (d_active)
+  {
+    d_tr->d_call.d_strs.push_back(s);
+  }
+}
+
+void TraceRecorder::Call::addTerm(const Node& n)
+{
+  if (d_active)
+  {
+    auto it = d_tr->d_terms.find(n);
+    if (it == d_tr->d_terms.end())
+    {
+      d_known = false;
+      return;
+    }
+    d_tr->d_call.d_ints.push_back(it->second);
+  }
+}
+
+void TraceRecorder::Call::addSort(const TypeNode& tn)
+{
+  if (d_active)
+  {
+    auto it = d_tr->d_sorts.find(tn);
+    if (it == d_tr->d_sorts.end())
+    {
+      d_known = false;
+      return;
+    }
+    d_tr->d_call.d_ints.push_back(it->second);
+  }
+}
+
+void TraceRecorder::Call::addOp(int32_t kind, const Node& n)
+{
+  if (d_active)
+  {
+    auto it = d_tr->d_ops.find(std::make_pair(kind, n));
+    if (it == d_tr->d_ops.end())
+    {
+      d_known = false;
+      return;
+    }
+    d_tr->d_call.d_ints.push_back(it->second);
+  }
+}
+
+bool TraceRecorder::Call::write()
+{
+  if (!d_active)
+  {
+    return false;
+  }
+  bool known = d_known;
+  if (known)
+  {
+    writeTraceCall(d_tr->d_out, d_tr->d_call);
+    if (d_tr->d_call.d_op == TraceOp::CHECK_SAT
+        || d_tr->d_call.d_op == TraceOp::CHECK_SAT_ASSUMING)
+    {
+      // the trace is complete up to the last check if the process dies
+      d_tr->d_out.flush();
+    }
+  }
+  else
+  {
+    d_tr->d_numSkipped++;
+  }
+  d_tr->d_call.d_ints.clear();
+  d_tr->d_call.d_strs.clear();
+  d_known = true;
+  return known;
+}
+
+void TraceRecorder::Call::done() { write(); }
+
+void TraceRecorder::Call::doneTerm(const Node& n)
+{
+  if (write())
+  {
+    d_tr->d_terms[n] = d_tr->d_numTerms++;
+  }
+}
+
+void TraceRecorder::Call::doneSort(const TypeNode& tn)
+{
+  if (write())
+  {
+    d_tr->d_sorts[tn] = d_tr->d_numSorts++;
+  }
+}
+
+void TraceRecorder::Call::doneOp(int32_t kind, const Node& n)
+{
+  if (write())
+  {
+    d_tr->d_ops[std::make_pair(kind, n)] = d_tr->d_numOps++;
+  }
+}
+
+}  // namespace api
+}  // namespace cvc5
@@ -0,0 +1,123 @@
+/*********************                                                        */
+/*! \file trace_recorder.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The recorder of the traces of the calls of an API solver.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__API__TRACE_RECORDER_H
+#define CVC4__API__TRACE_RECORDER_H
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "api/trace_format.h"
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace cvc5 {
+namespace api {
+
+/**
+ * Records the calls of an API solver to a file in the format of
+ * trace_format.h, which can be re-executed by cvc4-replay.
+ *
+ * The terms, sorts and operators that are arguments of the calls are written
+ * as the ids they were assigned as the results of earlier calls. A call with
+ * an argument that was not the result of a recorded call, e.g. a term
+ * obtained by Term::getChild, is not recorded, since it cannot be replayed,
+ * and neither are the calls that use its result.
+ */
+class TraceRecorder
+{
+ public:
+  /** Open the trace file filename, throws an OptionException on failure. */
+  TraceRecorder(const std::string& filename);
+  ~TraceRecorder();
+
+  /**
+   * A call of the solver that is being recorded, which should be constructed
+   * before the API calls made by the checks of the arguments of the call.
+   * Only the outermost call is recorded, and a call is not recorded if it is
+   * not finished by one of the done methods, e.g. since it raised an
+   * exception.
+   */
+  class Call
+  {
+   public:
+    /** Start a call of operation op, where tr may be null */
+    Call(TraceRecorder* tr, TraceOp op);
+    ~Call();
+    /** Add an integer argument */
+    void addInt(int64_t i);
+    /** Add a string argument */
+    void addString(const std::string& s);
+    /** Add a term argument */
+    void addTerm(const Node& n);
+    /** Add a sort argument */
+    void addSort(const TypeNode& tn);
+    /** Add an operator argument of the given kind and indices */
+    void addOp(int32_t kind, const Node& n);
+    /** Finish a call that has no result */
+    void done();
+    /** Finish a call whose result is the term n */
+    void doneTerm(const Node& n);
+    /** Finish a call whose result is the sort tn */
+    void doneSort(const TypeNode& tn);
+    /** Finish a call whose result is the operator of the given kind */
+    void doneOp(int32_t kind, const Node& n);
+
+   private:
+    /**
+     * Write the call if it is recorded, and reset its arguments for another
+     * call of the same operation, e.g. the terms of Solver::mkTerms.
+     */
+    bool write();
+    /** The recorder, or null if no trace is recorded */
+    TraceRecorder* d_tr;
+    /** Whether the call is recorded */
+    bool d_active;
+    /** Whether all arguments are known */
+    bool d_known;
+  };
+
+ private:
+  /** The trace file */
+  std::ofstream d_out;
+  /** The buffer of the trace file */
+  std::unique_ptr<char[]> d_buffer;
+  /** The call being recorded */
+  TraceCall d_call;
+  /** The number of active calls */
+  size_t d_depth;
+  /** The number of calls that were not recorded */
+  size_t d_numSkipped;
+  /** The ids of the terms */
+  std::unordered_map<Node, int64_t, NodeHashFunction> d_terms;
+  /** The ids of the sorts */
+  std::unordered_map<TypeNode, int64_t, TypeNodeHashFunction> d_sorts;
+  /** The ids of the operators, by kind and indices */
+  std::map<std::pair<int32_t, Node>, int64_t> d_ops;
+  /** The number of the assigned ids of terms, sorts and operators */
+  int64_t d_numTerms;
+  int64_t d_numSorts;
+  int64_t d_numOps;
+};
+
+}  // namespace api
+}  // namespace cvc5
+
+#endif
@@ -0,0 +1,390 @@
+/*********************                                                        */
+/*! \file cdchunk_list.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Context-dependent list class stored in chunks (only supports append)
+ **
+ ** Context-dependent list class whose elements are stored in chunks of
+ ** increasing size, such that the list never copies its elements when it
+ ** grows.  As CDList, this list only supports appending to the list; on
+ ** backtrack, the list is simply shortened.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__CONTEXT__CDCHUNK_LIST_H
+#define CVC4__CONTEXT__CDCHUNK_LIST_H
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+
+#include "base/check.h"
+#include "context/cdlist_forward.h"
+#include "context/context.h"
+#include "context/context_mm.h"
+
+namespace cvc5 {
+namespace context {
+
+/**
+ * Generic context-dependent list that is stored in chunks.  It provides the
+ * interface of CDList, with the following differences:
+ *
+ * 1. Growing the list allocates a new chunk instead of copying the list to a
+ *    larger array.  Hence, push_back takes constant time in the worst case
+ *    (besides the allocation) rather than amortized, and the addresses of
+ *    the elements remain valid until the elements are removed by a pop.
+ *
+ * 2. T objects are not required to be copyable by memcpy.
+ *
+ * 3. Access by index and iteration are slightly more expensive, since they
+ *    locate the chunk of an element first.
+ *
+ * Chunk k stores 2^(k+s_firstChunkBits) elements, hence the chunk and the
+ * position of an element are computed from its index by bit operations, and
+ * a list of any size has less than 64 chunks.  The chunks are kept when the
+ * list is shortened by a pop, as CDList keeps its allocated array, and freed
+ * when the list is destroyed.
+ *
+ * This list is preferable to CDList for the lists that grow very large, e.g.
+ * millions of elements, where copying the list on growth causes latency
+ * spikes and doubles the peak memory.
+ */
+template <class T,
+          class CleanUpT = DefaultCleanUp<T>,
+          class AllocatorT = std::allocator<T> >
+class CDChunkList : public ContextObj
+{
+ public:
+  /** The value type with which this CDChunkList<> was instantiated. */
+  typedef T value_type;
+
+  /** The cleanup type with which this CDChunkList<> was instantiated. */
+  typedef CleanUpT CleanUp;
+
+  /** The allocator type with which this CDChunkList<> was instantiated. */
+  typedef AllocatorT Allocator;
+
+ private:
+  typedef std::allocator_traits<Allocator> AllocatorTraits;
+
+  /** The number of bits of the size of the first chunk */
+  static const size_t s_firstChunkBits = 4;
+  /** The maximal number of chunks */
+  static const size_t s_maxChunks = 64 - s_firstChunkBits;
+
+  /** The size of chunk k */
+  static size_t chunkSize(size_t k)
+  {
+    return size_t(1) << (k + s_firstChunkBits);
+  }
+
+  /** The index of the chunk of the element with index i */
+  static size_t chunkIndex(size_t i)
+  {
+    // chunk k starts at index 2^(k+s_firstChunkBits) - 2^s_firstChunkBits
+    uint64_t j = uint64_t(i) + (uint64_t(1) << s_firstChunkBits);
+    return 63 - __builtin_clzll(j) - s_firstChunkBits;
+  }
+
+  /** The position of the element with index i in chunk k */
+  static size_t chunkOffset(size_t i, size_t k)
+  {
+    return i + chunkSize(0) - chunkSize(k);
+  }
+
+  /** The chunks, of which the first d_numChunks are allocated */
+  T* d_chunks[s_maxChunks];
+
+  /** The number of allocated chunks */
+  size_t d_numChunks;
+
+  /** The number of elements of the list */
+  size_t d_size;
+
+  /**
+   * The chunk of the next element to be added, and the position of the next
+   * element in that chunk, which are chunkIndex(d_size) and
+   * chunkOffset(d_size, d_tailChunk).
+   */
+  size_t d_tailChunk;
+  size_t d_tailOffset;
+
+  /**
+   * Whether to call the destructor when items are popped from the
+   * list.  True by default, but can be set to false by setting the
+   * second argument in the constructor to false.
+   */
+  bool d_callDestructor;
+
+  /** The CleanUp functor. */
+  CleanUp d_cleanUp;
+
+  /** Our allocator. */
+  Allocator d_allocator;
+
+  /**
+   * Private copy constructor used only by save().  The chunks are not copied:
+   * only the base class information and d_size are needed in restore.
+   */
+  CDChunkList(const CDChunkList& l)
+      : ContextObj(l),
+        d_numChunks(0),
+        d_size(l.d_size),
+        d_tailChunk(0),
+        d_tailOffset(0),
+        d_callDestructor(false),
+        d_cleanUp(l.d_cleanUp),
+        d_allocator(l.d_allocator)
+  {
+  }
+  CDChunkList& operator=(const CDChunkList& l) = delete;
+
+  /**
+   * Implementation of mandatory ContextObj method save: simply copies the
+   * current size to a copy using the copy constructor.  The saved
+   * information is allocated using the ContextMemoryManager.
+   */
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    return new (pCMM) CDChunkList<T, CleanUp, Allocator>(*this);
+  }
+
+ protected:
+  /**
+   * Implementation of mandatory ContextObj method restore: simply
+   * restores the previous size.  The chunks are not freed.
+   */
+  void restore(ContextObj* data) override
+  {
+    truncateList(((CDChunkList<T, CleanUp, Allocator>*)data)->d_size);
+  }
+
+  /**
+   * Given a size parameter smaller than d_size, truncateList() removes the
+   * elements from the end of the list until d_size equals size.  As for
+   * CDList, it is up to the user of the function to ensure that the saved
+   * d_size values at lower context levels are less than or equal to size.
+   */
+  void truncateList(const size_t size)
+  {
+    Assert(size <= d_size);
+    if (d_callDestructor)
+    {
+      while (d_size != size)
+      {
+        if (d_tailOffset == 0)
+        {
+          d_tailChunk--;
+          d_tailOffset = chunkSize(d_tailChunk);
+        }
+        --d_tailOffset;
+        --d_size;
+        T* t = &d_chunks[d_tailChunk][d_tailOffset];
+        d_cleanUp(t);
+        AllocatorTraits::destroy(d_allocator, t);
+      }
+    }
+    else if (size != d_size)
+    {
+      d_size = size;
+      d_tailChunk = chunkIndex(size);
+      d_tailOffset = chunkOffset(size, d_tailChunk);
+    }
+  }
+
+ public:
+  /** Main constructor: no chunks are allocated, size is 0 */
+  CDChunkList(Context* context,
+              bool callDestructor = true,
+              const CleanUp& cleanup = CleanUp(),
+              const Allocator& alloc = Allocator())
+      : ContextObj(context),
+        d_numChunks(0),
+        d_size(0),
+        d_tailChunk(0),
+        d_tailOffset(0),
+        d_callDestructor(callDestructor),
+        d_cleanUp(cleanup),
+        d_allocator(alloc)
+  {
+  }
+
+  /** Destructor: delete the chunks */
+  ~CDChunkList()
+  {
+    this->destroy();
+
+    if (d_callDestructor)
+    {
+      truncateList(0);
+    }
+    for (size_t k = 0; k < d_numChunks; k++)
+    {
+      AllocatorTraits::deallocate(d_allocator, d_chunks[k], chunkSize(k));
+    }
+  }
+
+  /** Return the current size of the list. */
+  size_t size() const { return d_size; }
+
+  /** Return true iff there are no valid objects in the list. */
+  bool empty() const { return d_size == 0; }
+
+  /** Add an item to the end of the list. */
+  void push_back(const T& data)
+  {
+    makeCurrent();
+    if (d_tailChunk == d_numChunks)
+    {
+      Assert(d_numChunks < s_maxChunks);
+      d_chunks[d_numChunks] =
+          AllocatorTraits::allocate(d_allocator, chunkSize(d_numChunks));
+      d_numChunks++;
+    }
+    AllocatorTraits::construct(
+        d_allocator, &d_chunks[d_tailChunk][d_tailOffset], data);
+    ++d_size;
+    if (++d_tailOffset == chunkSize(d_tailChunk))
+    {
+      d_tailChunk++;
+      d_tailOffset = 0;
+    }
+  }
+
+  /** Access to the ith item in the list. */
+  const T& operator[](size_t i) const
+  {
+    Assert(i < d_size) << "index out of bounds in CDChunkList::operator[]";
+    size_t k = chunkIndex(i);
+    return d_chunks[k][chunkOffset(i, k)];
+  }
+
+  /** Returns the most recent item added to the list. */
+  const T& back() const
+  {
+    Assert(d_size > 0) << "CDChunkList::back() called on empty list";
+    return (*this)[d_size - 1];
+  }
+
+  /**
+   * Iterator for CDChunkList class.  It has to be const because we don't
+   * allow items in the list to be changed.  It stores the position of the
+   * current element in its chunk, such that incrementing and dereferencing
+   * do not have to locate the chunk.
+   */
+  class const_iterator
+  {
+    const CDChunkList* d_list;
+    size_t d_chunk;
+    size_t d_offset;
+
+    const_iterator(const CDChunkList* list, size_t chunk, size_t offset)
+        : d_list(list), d_chunk(chunk), d_offset(offset)
+    {
+    }
+
+    friend class CDChunkList<T, CleanUp, Allocator>;
+
+   public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    const_iterator() : d_list(nullptr), d_chunk(0), d_offset(0) {}
+
+    bool operator==(const const_iterator& i) const
+    {
+      return d_chunk == i.d_chunk && d_offset == i.d_offset;
+    }
+
+    bool operator!=(const const_iterator& i) const { return !(*this == i); }
+
+    const T& operator*() const { return d_list->d_chunks[d_chunk][d_offset]; }
+
+    const T* operator->() const { return &**this; }
+
+    /** Prefix increment */
+    const_iterator& operator++()
+    {
+      if (++d_offset == chunkSize(d_chunk))
+      {
+        d_chunk++;
+        d_offset = 0;
+      }
+      return *this;
+    }
+
+    /** Prefix decrement */
+    const_iterator& operator--()
+    {
+      if (d_offset == 0)
+      {
+        d_chunk--;
+        d_offset = chunkSize(d_chunk);
+      }
+      --d_offset;
+      return *this;
+    }
+
+    /** operator+ */
+    const_iterator operator+(long signed int off) const
+    {
+      size_t i = chunkSize(d_chunk) - chunkSize(0) + d_offset + off;
+      size_t k = chunkIndex(i);
+      return const_iterator(d_list, k, chunkOffset(i, k));
+    }
+
+    /** Postfix increment: returns the iterator with the old value. */
+    const_iterator operator++(int)
+    {
+      const_iterator it = *this;
+      ++(*this);
+      return it;
+    }
+
+    /** Postfix decrement: returns the iterator with the old value. */
+    const_iterator operator--(int)
+    {
+      const_iterator it = *this;
+      --(*this);
+      return it;
+    }
+  }; /* class CDChunkList<>::const_iterator */
+  typedef const_iterator iterator;
+
+  /** Returns an iterator pointing to the first item in the list. */
+  const_iterator begin() const { return const_iterator(this, 0, 0); }
+
+  /** Returns an iterator pointing one past the last item in the list. */
+  const_iterator end() const
+  {
+    return const_iterator(this, d_tailChunk, d_tailOffset);
+  }
+}; /* class CDChunkList<> */
+
+template <class T, class CleanUp>
+class CDChunkList<T, CleanUp, ContextMemoryAllocator<T> > : public ContextObj
+{
+  /* As CDList, CDChunkList is incompatible for use with a
+   * ContextMemoryAllocator, since a chunk that is allocated at a deeper
+   * context level could be destroyed on pop while the list keeps it.
+   */
+  static_assert(sizeof(T) == 0,
+                "Cannot create a CDChunkList with a ContextMemoryAllocator.");
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC4__CONTEXT__CDCHUNK_LIST_H */
@@ -0,0 +1,170 @@
+/*********************                                                        */
+/*! \file cdpriority_queue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Context-dependent priority queue class
+ **
+ ** Context-dependent priority queue class.
+ ** The elements are stored in a CDList, and the context-dependent count of
+ ** dequeued elements is a CDO<size_t>. The heap of the indices of the elements
+ ** that are not dequeued, and the trail of the dequeued indices, are not
+ ** context-dependent, they are brought in sync with the context when the
+ ** queue is accessed after a backtrack.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__CONTEXT__CDPRIORITY_QUEUE_H
+#define CVC4__CONTEXT__CDPRIORITY_QUEUE_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "base/check.h"
+#include "context/cdlist.h"
+#include "context/cdo.h"
+
+namespace cvc5 {
+namespace context {
+
+class Context;
+
+/**
+ * A priority queue whose content is restored on backtracking: elements
+ * enqueued in a context are removed when the context is popped, and elements
+ * dequeued in a context are put back. As for std::priority_queue, the front
+ * of the queue is the greatest element with respect to the comparator.
+ */
+template <class T, class CmpFcn = std::less<T> >
+class CDPriorityQueue
+{
+ public:
+  /** Creates a new CDPriorityQueue associated with the given context. */
+  CDPriorityQueue(Context* context, const CmpFcn& cmp = CmpFcn())
+      : d_list(context), d_dequeued(context, 0), d_heapSize(0), d_cmp(cmp)
+  {
+  }
+
+  /** Returns true if the queue is empty in the current context. */
+  bool empty() const
+  {
+    restore();
+    return d_heap.empty();
+  }
+
+  /** Returns the number of elements in the queue in the current context. */
+  size_t size() const
+  {
+    restore();
+    return d_heap.size();
+  }
+
+  /** Enqueues an element in the current context. */
+  void enqueue(const T& data)
+  {
+    restore();
+    d_list.push_back(data);
+    push(d_list.size() - 1);
+    d_heapSize = d_list.size();
+  }
+
+  /** Returns the greatest element of the queue. */
+  const T& front() const
+  {
+    restore();
+    Assert(!d_heap.empty()) << "Attempting to access an empty queue.";
+    return d_list[d_heap.front()];
+  }
+
+  /** Removes the greatest element of the queue in the current context. */
+  void dequeue()
+  {
+    restore();
+    Assert(!d_heap.empty()) << "Attempting to dequeue from an empty queue.";
+    std::pop_heap(d_heap.begin(), d_heap.end(), IndexCmp(this));
+    d_trail.push_back(d_heap.back());
+    d_heap.pop_back();
+    d_dequeued = d_dequeued + 1;
+  }
+
+ private:
+  /** Compares the indices of d_list by the comparator on their elements */
+  class IndexCmp
+  {
+   public:
+    IndexCmp(const CDPriorityQueue* q) : d_queue(q) {}
+    bool operator()(size_t i, size_t j) const
+    {
+      const T& a = d_queue->d_list[i];
+      const T& b = d_queue->d_list[j];
+      // ties are broken by the order of insertion
+      return d_queue->d_cmp(a, b) || (!d_queue->d_cmp(b, a) && i > j);
+    }
+
+   private:
+    const CDPriorityQueue* d_queue;
+  };
+
+  /** Push index i of d_list to the heap */
+  void push(size_t i) const
+  {
+    d_heap.push_back(i);
+    std::push_heap(d_heap.begin(), d_heap.end(), IndexCmp(this));
+  }
+
+  /**
+   * Bring the heap in sync with the current context after a backtrack, by
+   * putting back the elements that were dequeued in the popped contexts and
+   * removing the elements that were enqueued in them.
+   */
+  void restore() const
+  {
+    size_t listSize = d_list.size();
+    // remove the indices of the elements that were removed from the list
+    if (d_heapSize > listSize)
+    {
+      d_heap.erase(std::remove_if(d_heap.begin(),
+                                  d_heap.end(),
+                                  [listSize](size_t i) { return i >= listSize; }),
+                   d_heap.end());
+      std::make_heap(d_heap.begin(), d_heap.end(), IndexCmp(this));
+      d_heapSize = listSize;
+    }
+    // put back the dequeued elements that are still in the list
+    while (d_trail.size() > d_dequeued)
+    {
+      size_t i = d_trail.back();
+      d_trail.pop_back();
+      if (i < listSize)
+      {
+        push(i);
+      }
+    }
+  }
+
+  /** The elements of the queue, including the dequeued ones. */
+  CDList<T> d_list;
+  /** The number of dequeued elements in the current context. */
+  CDO<size_t> d_dequeued;
+  /** The heap of the indices in d_list of the elements not dequeued. */
+  mutable std::vector<size_t> d_heap;
+  /** The indices of the dequeued elements, in the order of dequeuing. */
+  mutable std::vector<size_t> d_trail;
+  /** The size of d_list when d_heap was last brought in sync with it. */
+  mutable size_t d_heapSize;
+  /** The comparator. */
+  CmpFcn d_cmp;
+}; /* class CDPriorityQueue<> */
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC4__CONTEXT__CDPRIORITY_QUEUE_H */
@@ -0,0 +1,306 @@
+/*********************                                                        */
+/*! \file cdundo_hashmap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Context-dependent hashmap built using an undo log
+ **
+ ** Context-dependent hashmap that is a single context object, as opposed to
+ ** CDHashMap, which has a context object per element. The modifications of
+ ** the map are recorded in an undo log, and popping a context replays the
+ ** part of the log of that context in one call to restore().
+ **
+ ** See also:
+ **  CDInsertHashMap : A CD hash map allowing one insertion per element.
+ **  CDHashMap : A fully featured CD hash map. (The closest to <ext/hash_map>)
+ **
+ ** Notes:
+ ** - The elements are stored contiguously in insertion order, which is also
+ **   the order of iteration.
+ ** - Iterators and references to elements are invalidated by insert() and
+ **   by popping a context.
+ ** - operator[] is only supported as a const dereference (must succeed).
+ ** - Elements cannot be erased.
+ ** - Does not accept TNodes as keys.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "context/context.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace context {
+
+template <class Key, class Data, class HashFcn = std::hash<Key> >
+class CDUndoHashMap : public ContextObj
+{
+  /** Marks the empty slots of the table */
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  /** A record of the undo log */
+  struct UndoRecord
+  {
+    /** The index of the modified element in d_entries */
+    size_t d_index;
+    /** Whether the element was inserted, as opposed to updated */
+    bool d_inserted;
+    /** For updates, the previous value of d_lastRecord[d_index] */
+    size_t d_prevRecord;
+    /** For updates, the previous data of the element */
+    Data d_prevData;
+  };
+
+ public:
+  /** The type of the <key, data> values in the hashmap. */
+  using value_type = std::pair<Key, Data>;
+  /** An iterator over the elements in the hashmap. */
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  CDUndoHashMap(Context* context, const HashFcn& hash = HashFcn())
+      : ContextObj(context),
+        d_table(16, npos),
+        d_levelStart(0),
+        d_hash(hash)
+  {
+  }
+
+  ~CDUndoHashMap() { this->destroy(); }
+
+  /** Returns true if the map is empty in the current context. */
+  bool empty() const { return d_entries.empty(); }
+
+  /** Returns the size of the map in the current context. */
+  size_t size() const { return d_entries.size(); }
+
+  /** Returns true if k is a mapped key in the current context. */
+  bool contains(const Key& k) const { return find(k) != end(); }
+
+  /** Returns 1 if k is a mapped key in the current context, 0 otherwise. */
+  size_t count(const Key& k) const { return contains(k) ? 1 : 0; }
+
+  /**
+   * Returns a const_iterator to the value_type if k is a mapped key in
+   * the current context, and end() otherwise.
+   */
+  const_iterator find(const Key& k) const
+  {
+    size_t i = d_table[findSlot(k)];
+    return i == npos ? end() : d_entries.begin() + i;
+  }
+
+  /**
+   * Returns a reference to the data mapped by k.
+   * k must be in the map in this context.
+   */
+  const Data& operator[](const Key& k) const
+  {
+    const_iterator it = find(k);
+    Assert(it != end());
+    return (*it).second;
+  }
+
+  /**
+   * Maps k to d in the current context. Returns true if k was not mapped
+   * before.
+   */
+  bool insert(const Key& k, const Data& d)
+  {
+    if (!isCurrent())
+    {
+      makeCurrent();
+      d_levelStart = d_log.size();
+    }
+    size_t slot = findSlot(k);
+    size_t i = d_table[slot];
+    if (i != npos)
+    {
+      // an update, which needs to be recorded once per context
+      size_t last = d_lastRecord[i];
+      if (last < d_levelStart)
+      {
+        d_log.push_back(UndoRecord{i, false, last, d_entries[i].second});
+        d_lastRecord[i] = d_log.size() - 1;
+      }
+      d_entries[i].second = d;
+      return false;
+    }
+    i = d_entries.size();
+    d_entries.push_back(value_type(k, d));
+    d_lastRecord.push_back(d_log.size());
+    d_log.push_back(UndoRecord{i, true, npos, Data()});
+    d_table[slot] = i;
+    if (2 * d_entries.size() > d_table.size())
+    {
+      grow();
+    }
+    return true;
+  }
+
+  /**
+   * Returns an iterator to the beginning of the map.
+   */
+  const_iterator begin() const { return d_entries.begin(); }
+
+  /**
+   * Returns an iterator to the end of the map.
+   */
+  const_iterator end() const { return d_entries.end(); }
+
+ private:
+  /**
+   * Private copy constructor used only by save(). Only d_levelStart is
+   * needed by restore, the elements, the table and the log are not copied.
+   */
+  CDUndoHashMap(const CDUndoHashMap& m)
+      : ContextObj(m), d_levelStart(m.d_levelStart), d_hash(m.d_hash)
+  {
+  }
+  CDUndoHashMap& operator=(const CDUndoHashMap&) = delete;
+
+  /**
+   * Implementation of mandatory ContextObj method save: copies the start of
+   * the log of the current context to a copy allocated using the
+   * ContextMemoryManager.
+   */
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    ContextObj* data = new (pCMM) CDUndoHashMap(*this);
+    Debug("CDUndoHashMap") << "save " << this << " at level "
+                           << this->getContext()->getLevel() << " log size "
+                           << d_log.size() << std::endl;
+    return data;
+  }
+
+ protected:
+  /**
+   * Implementation of mandatory ContextObj method restore: undoes the records
+   * of the log of the popped context, in reverse order.
+   */
+  void restore(ContextObj* data) override
+  {
+    Debug("CDUndoHashMap") << "restore " << this << " level "
+                           << this->getContext()->getLevel() << " log size "
+                           << d_log.size() << " to " << d_levelStart
+                           << std::endl;
+    while (d_log.size() > d_levelStart)
+    {
+      UndoRecord& r = d_log.back();
+      if (r.d_inserted)
+      {
+        // elements are undone in the reverse order of their insertion
+        Assert(r.d_index + 1 == d_entries.size());
+        eraseSlot(findSlot(d_entries.back().first));
+        d_entries.pop_back();
+        d_lastRecord.pop_back();
+      }
+      else
+      {
+        d_entries[r.d_index].second = r.d_prevData;
+        d_lastRecord[r.d_index] = r.d_prevRecord;
+      }
+      d_log.pop_back();
+    }
+    d_levelStart = static_cast<CDUndoHashMap*>(data)->d_levelStart;
+  }
+
+ private:
+  /**
+   * Get the slot of the table for k, which is either the slot of the element
+   * for k or the empty slot where it would be inserted.
+   */
+  size_t findSlot(const Key& k) const
+  {
+    size_t mask = d_table.size() - 1;
+    size_t slot = d_hash(k) & mask;
+    while (d_table[slot] != npos && !(d_entries[d_table[slot]].first == k))
+    {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  /**
+   * Empty the given slot of the table, and move the elements that follow it
+   * in their probe sequence so that no lookup goes through an empty slot.
+   */
+  void eraseSlot(size_t slot)
+  {
+    size_t mask = d_table.size() - 1;
+    size_t next = slot;
+    while (true)
+    {
+      next = (next + 1) & mask;
+      if (d_table[next] == npos)
+      {
+        break;
+      }
+      size_t home = d_hash(d_entries[d_table[next]].first) & mask;
+      // the element in next stays if its home slot is cyclically in
+      // (slot, next]
+      bool stays = slot <= next ? (slot < home && home <= next)
+                                : (slot < home || home <= next);
+      if (!stays)
+      {
+        d_table[slot] = d_table[next];
+        slot = next;
+      }
+    }
+    d_table[slot] = npos;
+  }
+
+  /** Double the size of the table */
+  void grow()
+  {
+    d_table.assign(2 * d_table.size(), npos);
+    for (size_t i = 0, size = d_entries.size(); i < size; ++i)
+    {
+      d_table[findSlot(d_entries[i].first)] = i;
+    }
+  }
+
+  /** The elements, in the order of insertion */
+  std::vector<value_type> d_entries;
+  /** The index in d_log of the last record of each element */
+  std::vector<size_t> d_lastRecord;
+  /**
+   * The open addressing table with linear probing, storing indices in
+   * d_entries. Its size is a power of two.
+   */
+  std::vector<size_t> d_table;
+  /** The undo log */
+  std::vector<UndoRecord> d_log;
+  /** The index in d_log of the first record of the current context */
+  size_t d_levelStart;
+  /** The hash function */
+  HashFcn d_hash;
+}; /* class CDUndoHashMap<> */
+
+template <class Data, class HashFcn>
+class CDUndoHashMap<TNode, Data, HashFcn> : public ContextObj
+{
+  /* As for CDInsertHashMap, the keys are hashed when they are removed on
+   * backtracking, at which point the nodes of TNode keys may have been
+   * deleted. Consider using CDHashMap<TNode,...> instead.
+   */
+  static_assert(sizeof(Data) == 0,
+                "Cannot create a CDUndoHashMap with TNode keys");
+};
+
+}  // namespace context
+}  // namespace cvc5
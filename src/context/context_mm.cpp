@@ -14,6 +14,7 @@
  ** Implementation of Context Memory Manager
  **/
 
+#include <algorithm>
 #include <cstdlib>
 #include <deque>
 #include <limits>
@@ -21,6 +22,10 @@
 #include <ostream>
 #include <vector>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif /* __linux__ */
+
 #ifdef CVC4_VALGRIND
 #include <valgrind/memcheck.h>
 #endif /* CVC4_VALGRIND */
@@ -34,7 +39,46 @@ namespace context {
 
 #ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
 
+ContextMemoryManager::Chunk ContextMemoryManager::allocateChunk(size_t size)
+{
+  Chunk c;
+  c.d_size = size;
+  c.d_data = nullptr;
+#ifdef MADV_HUGEPAGE
+  if (size >= maxChunkSizeBytes)
+  {
+    // align large chunks to the huge page size, so that they can be backed
+    // by huge pages entirely
+    void* data = nullptr;
+    if (posix_memalign(&data, maxChunkSizeBytes, size) == 0)
+    {
+      madvise(data, size, MADV_HUGEPAGE);
+      c.d_data = static_cast<char*>(data);
+    }
+  }
+#endif /* MADV_HUGEPAGE */
+  if (c.d_data == nullptr)
+  {
+    c.d_data = (char*)malloc(size);
+  }
+  if (c.d_data == NULL)
+  {
+    throw std::bad_alloc();
+  }
+
+#ifdef CVC4_VALGRIND
+  VALGRIND_MAKE_MEM_NOACCESS(c.d_data, size);
+#endif /* CVC4_VALGRIND */
+  return c;
+}
+
 void ContextMemoryManager::newChunk() {
+  // The number of chunks the current region has so far.  Regions that need
+  // many chunks get larger ones, to reduce the number of chunks per region.
+  unsigned regionChunks =
+      d_indexChunkList
+      - (d_indexChunkListStack.empty() ? 0 : d_indexChunkListStack.back())
+      + 1;
 
   // Increment index to chunk list
   ++d_indexChunkList;
@@ -43,14 +87,14 @@ void ContextMemoryManager::newChunk() {
 
   // Create new chunk if no free chunk available
   if(d_freeChunks.empty()) {
-    d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-    if(d_chunkList.back() == NULL) {
-      throw std::bad_alloc();
+    size_t size = chunkSizeBytes;
+    while (regionChunks > 1 && size < maxChunkSizeBytes)
+    {
+      size *= 2;
+      --regionChunks;
     }
-
-#ifdef CVC4_VALGRIND
-    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
-#endif /* CVC4_VALGRIND */
+    d_chunkList.push_back(allocateChunk(size));
+    d_chunkBytes += size;
   }
   // If there is a free chunk, use that
   else {
@@ -58,23 +102,26 @@ void ContextMemoryManager::newChunk() {
     d_freeChunks.pop_back();
   }
   // Set up the current chunk pointers
-  d_nextFree = d_chunkList.back();
-  d_endChunk = d_nextFree + chunkSizeBytes;
+  d_nextFree = d_chunkList.back().d_data;
+  d_endChunk = d_nextFree + d_chunkList.back().d_size;
 }
 
 
-ContextMemoryManager::ContextMemoryManager() : d_indexChunkList(0) {
+ContextMemoryManager::ContextMemoryManager()
+    : d_indexChunkList(0),
+      d_bytesSaved(0),
+      d_bytesRestored(0),
+      d_maxBytesPerPush(0),
+      d_numPushes(0),
+      d_chunkBytes(chunkSizeBytes)
+{
   // Create initial chunk
-  d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-  d_nextFree = d_chunkList.back();
-  if(d_nextFree == NULL) {
-    throw std::bad_alloc();
-  }
+  d_chunkList.push_back(allocateChunk(chunkSizeBytes));
+  d_nextFree = d_chunkList.back().d_data;
   d_endChunk = d_nextFree + chunkSizeBytes;
 
 #ifdef CVC4_VALGRIND
   VALGRIND_CREATE_MEMPOOL(this, 0, false);
-  VALGRIND_MAKE_MEM_NOACCESS(d_nextFree, chunkSizeBytes);
   d_allocations.push_back(std::vector<char*>());
 #endif /* CVC4_VALGRIND */
 }
@@ -87,11 +134,11 @@ ContextMemoryManager::~ContextMemoryManager() {
 
   // Delete all chunks
   while(!d_chunkList.empty()) {
-    free(d_chunkList.back());
+    free(d_chunkList.back().d_data);
     d_chunkList.pop_back();
   }
   while(!d_freeChunks.empty()) {
-    free(d_freeChunks.back());
+    free(d_freeChunks.back().d_data);
     d_freeChunks.pop_back();
   }
 }
@@ -109,6 +156,7 @@ void* ContextMemoryManager::newData(size_t size) {
     AlwaysAssert(d_nextFree <= d_endChunk)
         << "Request is bigger than memory chunk size";
   }
+  d_bytesSaved += size;
   Debug("context") << "ContextMemoryManager::newData(" << size
                    << ") returning " << res << " at level "
                    << d_chunkList.size() << std::endl;
@@ -131,6 +179,8 @@ void ContextMemoryManager::push() {
   d_nextFreeStack.push_back(d_nextFree);
   d_endChunkStack.push_back(d_endChunk);
   d_indexChunkListStack.push_back(d_indexChunkList);
+  d_bytesSavedStack.push_back(d_bytesSaved);
+  ++d_numPushes;
 }
 
 
@@ -155,19 +205,44 @@ void ContextMemoryManager::pop() {
   while(d_indexChunkList > d_indexChunkListStack.back()) {
     d_freeChunks.push_back(d_chunkList.back());
 #ifdef CVC4_VALGRIND
-    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
+    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back().d_data,
+                               d_chunkList.back().d_size);
 #endif /* CVC4_VALGRIND */
     d_chunkList.pop_back();
     --d_indexChunkList;
   }
   d_indexChunkListStack.pop_back();
 
-  // Delete excess free chunks
-  while(d_freeChunks.size() > maxFreeChunks) {
-    free(d_freeChunks.front());
+  // Account for the memory of the popped region
+  uint64_t bytes = d_bytesSaved - d_bytesSavedStack.back();
+  d_bytesSavedStack.pop_back();
+  d_bytesRestored += bytes;
+  if (bytes > d_maxBytesPerPush)
+  {
+    d_maxBytesPerPush = bytes;
+  }
+
+  // Delete excess free chunks.  As many free chunks as there are chunks in
+  // use are kept, so that regions pushed again after backtracking mostly
+  // reuse memory instead of allocating it.
+  size_t maxFree = std::max<size_t>(maxFreeChunks, d_chunkList.size());
+  while (d_freeChunks.size() > maxFree)
+  {
+    d_chunkBytes -= d_freeChunks.front().d_size;
+    free(d_freeChunks.front().d_data);
     d_freeChunks.pop_front();
   }
 }
+
+void ContextMemoryManager::releaseFreeChunks()
+{
+  while (!d_freeChunks.empty())
+  {
+    d_chunkBytes -= d_freeChunks.back().d_size;
+    free(d_freeChunks.back().d_data);
+    d_freeChunks.pop_back();
+  }
+}
 #else
 
 unsigned ContextMemoryManager::getMaxAllocationSize()
@@ -20,6 +20,8 @@
 #ifndef CVC4__CONTEXT__CONTEXT_MM_H
 #define CVC4__CONTEXT__CONTEXT_MM_H
 
+#include <algorithm>
+#include <cstdint>
 #ifndef CVC4_DEBUG_CONTEXT_MEMORY_MANAGER
 #include <deque>
 #endif
@@ -43,25 +45,43 @@ namespace context {
 class ContextMemoryManager {
 
   /**
-   * Memory in regions is allocated in chunks.  This is the chunk size
+   * Memory in regions is allocated in chunks.  This is the size of the first
+   * chunk of a region, and the minimum size of a chunk.
    */
   static const unsigned chunkSizeBytes = 16384;
 
   /**
-   * A list of free chunks is maintained.  This is the maximum number of
-   * free chunks.
+   * The size of the chunks doubles with each chunk that a region needs, up to
+   * this size.  Chunks of this size are backed by huge pages where the
+   * platform supports it.
+   */
+  static const size_t maxChunkSizeBytes = 2 * 1024 * 1024;
+
+  /**
+   * A list of free chunks is maintained.  This is the minimum number of free
+   * chunks that are kept; more are kept as long as they do not exceed the
+   * number of chunks in use.
    */
   static const unsigned maxFreeChunks = 100;
 
+  /** A chunk of memory */
+  struct Chunk
+  {
+    /** The start of the chunk */
+    char* d_data;
+    /** The size of the chunk in bytes */
+    size_t d_size;
+  };
+
   /**
    * List of all chunks that are currently active
    */
-  std::vector<char*> d_chunkList;
+  std::vector<Chunk> d_chunkList;
 
   /**
    * Queue of free chunks (for best cache performance, LIFO order is used)
    */
-  std::deque<char*> d_freeChunks;
+  std::deque<Chunk> d_freeChunks;
 
   /**
    * Pointer to the beginning of available memory in the current chunk in
@@ -98,6 +118,27 @@ class ContextMemoryManager {
    */
   std::vector<unsigned> d_indexChunkListStack;
 
+  /**
+   * Part of the stack of saved regions.  This vector stores the saved value
+   * of d_bytesSaved
+   */
+  std::vector<uint64_t> d_bytesSavedStack;
+
+  /** The number of bytes allocated in all regions so far */
+  uint64_t d_bytesSaved;
+
+  /** The number of bytes released by pop so far */
+  uint64_t d_bytesRestored;
+
+  /** The maximal number of bytes allocated in a single region */
+  uint64_t d_maxBytesPerPush;
+
+  /** The number of calls to push so far */
+  uint64_t d_numPushes;
+
+  /** The number of bytes of the chunks in use and of the free chunks */
+  uint64_t d_chunkBytes;
+
   /**
    * Private method to grab a new chunk for the current region.  Uses chunk
    * from d_freeChunks if available.  Creates a new one otherwise.  Sets the
@@ -105,6 +146,12 @@ class ContextMemoryManager {
    */
   void newChunk();
 
+  /**
+   * Allocate a chunk of size bytes, advising the kernel to back it with huge
+   * pages if it is large enough.
+   */
+  static Chunk allocateChunk(size_t size);
+
 #ifdef CVC4_VALGRIND
   /**
    * Vector of allocations for each level. Used for accurately marking
@@ -147,6 +194,24 @@ class ContextMemoryManager {
    */
   void pop();
 
+  /** Get the number of bytes allocated in all regions so far */
+  const uint64_t& getBytesSaved() const { return d_bytesSaved; }
+
+  /** Get the number of bytes released by pop so far */
+  const uint64_t& getBytesRestored() const { return d_bytesRestored; }
+
+  /** Get the maximal number of bytes allocated in a single region */
+  const uint64_t& getMaxBytesPerPush() const { return d_maxBytesPerPush; }
+
+  /** Get the number of calls to push so far */
+  const uint64_t& getNumPushes() const { return d_numPushes; }
+
+  /** Get the number of bytes of the chunks in use and of the free chunks */
+  const uint64_t& getChunkBytes() const { return d_chunkBytes; }
+
+  /** Release the memory of the free chunks, e.g. when memory is low */
+  void releaseFreeChunks();
+
 };/* class ContextMemoryManager */
 
 #else /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -164,7 +229,11 @@ class ContextMemoryManager
  public:
   static unsigned getMaxAllocationSize();
 
-  ContextMemoryManager() { d_allocations.push_back(std::vector<char*>()); }
+  ContextMemoryManager()
+      : d_bytesSaved(0), d_bytesRestored(0), d_maxBytesPerPush(0), d_numPushes(0)
+  {
+    d_allocations.push_back(std::vector<char*>());
+  }
   ~ContextMemoryManager()
   {
     for (const auto& levelAllocs : d_allocations)
@@ -180,10 +249,16 @@ class ContextMemoryManager
   {
     void* alloc = malloc(size);
     d_allocations.back().push_back(static_cast<char*>(alloc));
+    d_bytesSaved += size;
     return alloc;
   }
 
-  void push() { d_allocations.push_back(std::vector<char*>()); }
+  void push()
+  {
+    d_allocations.push_back(std::vector<char*>());
+    d_bytesSavedStack.push_back(d_bytesSaved);
+    ++d_numPushes;
+  }
 
   void pop()
   {
@@ -192,10 +267,28 @@ class ContextMemoryManager
       free(alloc);
     }
     d_allocations.pop_back();
+    uint64_t bytes = d_bytesSaved - d_bytesSavedStack.back();
+    d_bytesSavedStack.pop_back();
+    d_bytesRestored += bytes;
+    d_maxBytesPerPush = std::max(d_maxBytesPerPush, bytes);
   }
 
+  const uint64_t& getBytesSaved() const { return d_bytesSaved; }
+  const uint64_t& getBytesRestored() const { return d_bytesRestored; }
+  const uint64_t& getMaxBytesPerPush() const { return d_maxBytesPerPush; }
+  const uint64_t& getNumPushes() const { return d_numPushes; }
+  // this version allocates no chunks
+  const uint64_t& getChunkBytes() const { return d_chunkBytes; }
+  void releaseFreeChunks() {}
+
  private:
   std::vector<std::vector<char*>> d_allocations;
+  std::vector<uint64_t> d_bytesSavedStack;
+  uint64_t d_bytesSaved;
+  uint64_t d_bytesRestored;
+  uint64_t d_maxBytesPerPush;
+  uint64_t d_numPushes;
+  uint64_t d_chunkBytes = 0;
 }; /* ContextMemoryManager */
 
 #endif /* CVC4_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -17,6 +17,7 @@
 
 #include "decision/decision_attributes.h"
 #include "decision/justification_heuristic.h"
+#include "decision/justification_strategy.h"
 #include "expr/node.h"
 #include "options/decision_options.h"
 #include "options/smt_options.h"
@@ -57,6 +58,12 @@ void DecisionEngine::init()
     d_enabledITEStrategy.reset(new decision::JustificationHeuristic(
         this, d_userContext, d_satContext));
   }
+  else if (options::decisionMode()
+           == options::DecisionMode::JUSTIFICATION_INC)
+  {
+    d_enabledITEStrategy.reset(new decision::JustificationStrategy(
+        this, d_userContext, d_satContext));
+  }
 }
 
 void DecisionEngine::shutdown()
@@ -0,0 +1,494 @@
+/*********************                                                        */
+/*! \file justification_strategy.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Justification strategy with incremental justification state
+ **/
+
+#include "decision/justification_strategy.h"
+
+#include "decision/decision_engine.h"
+#include "expr/kind.h"
+#include "smt/smt_statistics_registry.h"
+
+using namespace cvc5::prop;
+
+namespace cvc5 {
+namespace decision {
+
+JustificationStrategy::JustificationStrategy(DecisionEngine* de,
+                                             context::UserContext* uc,
+                                             context::Context* c)
+    : ITEDecisionStrategy(de, c),
+      d_assertions(uc),
+      d_assertionIndex(c, 0),
+      d_skolemAssertions(uc),
+      d_skolemCache(uc),
+      d_relevantSkolemDefs(c),
+      d_relevantSkolems(c),
+      d_skolemDefIndex(c, 0),
+      d_justified(c),
+      d_stackSize(c, 0),
+      d_satContext(c),
+      d_decisions("decision::js::decisions", 0),
+      d_giveup("decision::js::giveup", 0),
+      d_timestat("decision::js::time")
+{
+  smtStatisticsRegistry()->registerStat(&d_decisions);
+  smtStatisticsRegistry()->registerStat(&d_giveup);
+  smtStatisticsRegistry()->registerStat(&d_timestat);
+  Trace("decision") << "Justification strategy enabled" << std::endl;
+}
+
+JustificationStrategy::~JustificationStrategy()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_decisions);
+  smtStatisticsRegistry()->unregisterStat(&d_giveup);
+  smtStatisticsRegistry()->unregisterStat(&d_timestat);
+}
+
+SatLiteral JustificationStrategy::getNext(bool& stopSearch)
+{
+  Trace("decision::js") << "JustificationStrategy::getNext(), stack size "
+                        << d_stackSize.get() << std::endl;
+  TimerStat::CodeTimer codeTimer(d_timestat);
+
+  refreshStack();
+  TNode decisionNode;
+  SatValue decisionVal = SAT_VALUE_UNKNOWN;
+  while (decisionNode.isNull())
+  {
+    if (d_stackSize.get() == 0)
+    {
+      TNode root = getNextRoot();
+      if (root.isNull())
+      {
+        Trace("decision") << "js: Nothing to split on " << std::endl;
+        // SAT solver can stop...
+        stopSearch = true;
+        d_decisionEngine->setResult(SAT_VALUE_TRUE);
+        return undefSatLiteral;
+      }
+      SatValue rootVal = SAT_VALUE_TRUE;
+      while (root.getKind() == kind::NOT)
+      {
+        root = root[0];
+        rootVal = invertValue(rootVal);
+      }
+      Trace("decision::js") << "--- justify root " << root << std::endl;
+      JustifyStatus status = getStatus(root, rootVal);
+      if (status == JustifyStatus::JUSTIFIED)
+      {
+        advanceRoot();
+        continue;
+      }
+      else if (status == JustifyStatus::OPPOSITE)
+      {
+        // Sanity check: if it was false, aren't we inconsistent? See bug 374
+        // of JustificationHeuristic, we leave the decision to the SAT solver.
+        ++d_giveup;
+        return undefSatLiteral;
+      }
+      else if (status == JustifyStatus::DECIDE)
+      {
+        decisionNode = root;
+        decisionVal = rootVal;
+        break;
+      }
+      pushFrame(root, rootVal);
+    }
+
+    // resume justifying the formula on top of the stack
+    JustifyFrame& frame = *d_stack[d_stackSize.get() - 1];
+    TNode node = frame.d_node.get();
+    SatValue desiredVal = frame.d_desiredVal.get();
+    bool easy = isEasy(node, desiredVal);
+    bool pushed = false;
+    bool justified = false;
+    for (size_t i = frame.d_index.get();; ++i)
+    {
+      SatValue childVal = SAT_VALUE_UNKNOWN;
+      TNode child = getChild(node, desiredVal, i, childVal);
+      if (child.isNull())
+      {
+        // all children were considered
+        justified = !easy;
+        break;
+      }
+      JustifyStatus status = getStatus(child, childVal);
+      if (status == JustifyStatus::JUSTIFIED)
+      {
+        if (easy)
+        {
+          justified = true;
+          break;
+        }
+        continue;
+      }
+      else if (status == JustifyStatus::OPPOSITE)
+      {
+        if (easy)
+        {
+          continue;
+        }
+        justified = false;
+        break;
+      }
+      if (i != frame.d_index.get())
+      {
+        frame.d_index = i;
+      }
+      if (status == JustifyStatus::DECIDE)
+      {
+        decisionNode = child;
+        decisionVal = childVal;
+      }
+      else
+      {
+        pushFrame(child, childVal);
+      }
+      pushed = true;
+      break;
+    }
+    if (pushed)
+    {
+      continue;
+    }
+    // we are done with node
+    d_stackSize = d_stackSize.get() - 1;
+    if (!justified)
+    {
+      // no controlling input found, which can only happen if the SAT solver
+      // is in an inconsistent state, we leave the decision to the SAT solver
+      Trace("decision::js") << "js: no controlling input found for " << node
+                            << std::endl;
+      d_stackSize = 0;
+      ++d_giveup;
+      return undefSatLiteral;
+    }
+    Trace("decision::js") << "  justified " << node << " with " << desiredVal
+                          << std::endl;
+    d_justified.insert(node, desiredVal);
+  }
+
+  Assert(d_decisionEngine->hasSatLiteral(decisionNode));
+  SatVariable v = d_decisionEngine->getSatLiteral(decisionNode).getSatVariable();
+  SatLiteral decision(v, /* negated = */ decisionVal != SAT_VALUE_TRUE);
+  Trace("decision-node") << "[decision-node] requesting split on " << decision
+                         << ", node: " << decisionNode << ", polarity: "
+                         << (decisionVal == SAT_VALUE_TRUE ? "true" : "false")
+                         << std::endl;
+  ++d_decisions;
+  return decision;
+}
+
+void JustificationStrategy::addAssertion(TNode assertion)
+{
+  // As for JustificationHeuristic, the assertions generated by term removal
+  // are also justified, so that we assign a value to all the Boolean term
+  // variables.
+  d_assertions.push_back(assertion);
+}
+
+void JustificationStrategy::addSkolemDefinition(TNode lem, TNode skolem)
+{
+  Trace("decision::js::ite")
+      << " js-ite: " << skolem << " maps to " << lem << std::endl;
+  d_skolemAssertions[skolem] = lem;
+}
+
+void JustificationStrategy::refreshStack()
+{
+  for (size_t i = 0, size = d_stackSize.get(); i < size; ++i)
+  {
+    JustifyFrame& frame = *d_stack[i];
+    if (getValue(frame.d_node.get()) == invertValue(frame.d_desiredVal.get()))
+    {
+      Trace("decision::js") << "js: pop " << (size - i)
+                            << " frames, which were falsified" << std::endl;
+      d_stackSize = i;
+      return;
+    }
+  }
+}
+
+TNode JustificationStrategy::getNextRoot()
+{
+  if (d_assertionIndex.get() < d_assertions.size())
+  {
+    return d_assertions[d_assertionIndex.get()];
+  }
+  if (d_skolemDefIndex.get() < d_relevantSkolemDefs.size())
+  {
+    return d_relevantSkolemDefs[d_skolemDefIndex.get()];
+  }
+  return TNode::null();
+}
+
+void JustificationStrategy::advanceRoot()
+{
+  if (d_assertionIndex.get() < d_assertions.size())
+  {
+    d_assertionIndex = d_assertionIndex.get() + 1;
+  }
+  else
+  {
+    Assert(d_skolemDefIndex.get() < d_relevantSkolemDefs.size());
+    d_skolemDefIndex = d_skolemDefIndex.get() + 1;
+  }
+}
+
+void JustificationStrategy::pushFrame(TNode n, SatValue desiredVal)
+{
+  Trace("decision::js") << "  push " << n << " with " << desiredVal
+                        << std::endl;
+  size_t size = d_stackSize.get();
+  if (size == d_stack.size())
+  {
+    d_stack.emplace_back(new JustifyFrame(d_satContext));
+  }
+  JustifyFrame& frame = *d_stack[size];
+  frame.d_node = n;
+  frame.d_desiredVal = desiredVal;
+  frame.d_index = 0;
+  d_stackSize = size + 1;
+}
+
+JustificationStrategy::JustifyStatus JustificationStrategy::getStatus(
+    TNode n, SatValue desiredVal)
+{
+  Assert(n.getKind() != kind::NOT);
+  Assert(desiredVal != SAT_VALUE_UNKNOWN) << "expected known value";
+  if (n.getKind() == kind::CONST_BOOLEAN)
+  {
+    return n.getConst<bool>() == (desiredVal == SAT_VALUE_TRUE)
+               ? JustifyStatus::JUSTIFIED
+               : JustifyStatus::OPPOSITE;
+  }
+  if (isAtom(n))
+  {
+    // if n has embedded skolems due to term removal, their definitions must
+    // be justified as well
+    notifySkolems(n);
+    Assert(d_decisionEngine->hasSatLiteral(n));
+    SatValue val = d_decisionEngine->getSatValue(n);
+    if (val == SAT_VALUE_UNKNOWN)
+    {
+      return JustifyStatus::DECIDE;
+    }
+    return val == desiredVal ? JustifyStatus::JUSTIFIED
+                             : JustifyStatus::OPPOSITE;
+  }
+  JustifiedMap::const_iterator it = d_justified.find(n);
+  if (it != d_justified.end())
+  {
+    return (*it).second == desiredVal ? JustifyStatus::JUSTIFIED
+                                      : JustifyStatus::OPPOSITE;
+  }
+  if (getValue(n) == invertValue(desiredVal))
+  {
+    return JustifyStatus::OPPOSITE;
+  }
+  return JustifyStatus::PUSH;
+}
+
+bool JustificationStrategy::isEasy(TNode n, SatValue desiredVal)
+{
+  switch (n.getKind())
+  {
+    case kind::AND: return desiredVal == SAT_VALUE_FALSE;
+    case kind::OR:
+    case kind::IMPLIES: return desiredVal == SAT_VALUE_TRUE;
+    default: return false;
+  }
+}
+
+TNode JustificationStrategy::getChild(TNode n,
+                                      SatValue desiredVal,
+                                      size_t i,
+                                      SatValue& childVal)
+{
+  TNode child;
+  switch (n.getKind())
+  {
+    case kind::AND:
+    case kind::OR:
+      if (i < n.getNumChildren())
+      {
+        child = n[i];
+        childVal = desiredVal;
+      }
+      break;
+
+    case kind::IMPLIES:
+      if (i < 2)
+      {
+        child = n[i];
+        childVal = i == 0 ? invertValue(desiredVal) : desiredVal;
+      }
+      break;
+
+    case kind::XOR:
+    case kind::EQUAL:
+      if (i < 2)
+      {
+        // Choose the desired values of the children based on their current
+        // values, as JustificationHeuristic does
+        SatValue desiredVal1 = getValue(n[0]);
+        SatValue desiredVal2 = getValue(n[1]);
+        bool shouldInvert =
+            (desiredVal == SAT_VALUE_TRUE) == (n.getKind() == kind::EQUAL);
+        if (desiredVal1 == SAT_VALUE_UNKNOWN
+            && desiredVal2 == SAT_VALUE_UNKNOWN)
+        {
+          // CHOICE: pick one of them arbitarily
+          desiredVal1 = SAT_VALUE_FALSE;
+        }
+        if (desiredVal2 == SAT_VALUE_UNKNOWN)
+        {
+          desiredVal2 = shouldInvert ? invertValue(desiredVal1) : desiredVal1;
+        }
+        else if (desiredVal1 == SAT_VALUE_UNKNOWN)
+        {
+          desiredVal1 = shouldInvert ? invertValue(desiredVal2) : desiredVal2;
+        }
+        child = n[i];
+        childVal = i == 0 ? desiredVal1 : desiredVal2;
+      }
+      break;
+
+    case kind::ITE:
+      if (i == 0)
+      {
+        // justify the condition with its value if it has one, otherwise
+        // pick the value selecting the branch that is more likely to be
+        // justified
+        child = n[0];
+        childVal = getValue(n[0]);
+        if (childVal == SAT_VALUE_UNKNOWN)
+        {
+          SatValue thenVal = getValue(n[1]);
+          SatValue elseVal = getValue(n[2]);
+          if (thenVal == desiredVal || elseVal == invertValue(desiredVal))
+          {
+            childVal = SAT_VALUE_TRUE;
+          }
+          else if (thenVal == invertValue(desiredVal) || elseVal == desiredVal)
+          {
+            childVal = SAT_VALUE_FALSE;
+          }
+          else
+          {
+            childVal = SAT_VALUE_TRUE;
+          }
+        }
+      }
+      else if (i == 1)
+      {
+        // the condition is justified, justify the branch it selects
+        SatValue condVal = getValue(n[0]);
+        Assert(condVal != SAT_VALUE_UNKNOWN);
+        child = n[condVal == SAT_VALUE_FALSE ? 2 : 1];
+        childVal = desiredVal;
+      }
+      break;
+
+    default: Unreachable() << "Unexpected Boolean operator " << n.getKind();
+  }
+  while (!child.isNull() && child.getKind() == kind::NOT)
+  {
+    child = child[0];
+    childVal = invertValue(childVal);
+  }
+  return child;
+}
+
+SatValue JustificationStrategy::getValue(TNode n)
+{
+  bool negated = false;
+  while (n.getKind() == kind::NOT)
+  {
+    n = n[0];
+    negated = !negated;
+  }
+  SatValue val = SAT_VALUE_UNKNOWN;
+  JustifiedMap::const_iterator it = d_justified.find(n);
+  if (it != d_justified.end())
+  {
+    val = (*it).second;
+  }
+  else if (d_decisionEngine->hasSatLiteral(n))
+  {
+    val = d_decisionEngine->getSatValue(n);
+  }
+  return negated ? invertValue(val) : val;
+}
+
+bool JustificationStrategy::isAtom(TNode n)
+{
+  Kind k = n.getKind();
+  theory::TheoryId tId = theory::kindToTheoryId(k);
+  return k == kind::BOOLEAN_TERM_VARIABLE
+         || (tId != theory::THEORY_BOOL
+             && (k != kind::EQUAL || !n[0].getType().isBoolean()));
+}
+
+void JustificationStrategy::notifySkolems(TNode n)
+{
+  const SkolemList& l = getSkolems(n);
+  for (const std::pair<Node, Node>& s : l)
+  {
+    if (d_relevantSkolems.insert(s.first))
+    {
+      Trace("decision::js::ite")
+          << " js-ite: " << s.second << " is relevant" << std::endl;
+      d_relevantSkolemDefs.push_back(s.second);
+    }
+  }
+}
+
+const JustificationStrategy::SkolemList& JustificationStrategy::getSkolems(
+    TNode n)
+{
+  SkolemCache::const_iterator it = d_skolemCache.find(n);
+  if (it == d_skolemCache.end())
+  {
+    SkolemList l;
+    std::unordered_set<TNode, TNodeHashFunction> visited;
+    computeSkolems(n, l, visited);
+    d_skolemCache.insert(n, l);
+    it = d_skolemCache.find(n);
+  }
+  return (*it).second;
+}
+
+void JustificationStrategy::computeSkolems(
+    TNode n,
+    SkolemList& l,
+    std::unordered_set<TNode, TNodeHashFunction>& visited)
+{
+  visited.insert(n);
+  for (const Node& nc : n)
+  {
+    SkolemMap::const_iterator it = d_skolemAssertions.find(nc);
+    if (it != d_skolemAssertions.end())
+    {
+      l.push_back(std::make_pair(nc, (*it).second));
+      Assert(nc.getNumChildren() == 0);
+    }
+    if (visited.find(nc) == visited.end())
+    {
+      computeSkolems(nc, l, visited);
+    }
+  }
+}
+
+}  // namespace decision
+}  // namespace cvc5
@@ -0,0 +1,213 @@
+/*********************                                                        */
+/*! \file justification_strategy.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Justification strategy with incremental justification state
+ **
+ ** A justification-based decision strategy that, unlike
+ ** JustificationHeuristic, does not search for a splitter from the assertions
+ ** on each decision, but resumes the search where the previous decision left
+ ** it.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__DECISION__JUSTIFICATION_STRATEGY_H
+#define CVC4__DECISION__JUSTIFICATION_STRATEGY_H
+
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
+#include "context/cdlist.h"
+#include "context/cdo.h"
+#include "decision/decision_strategy.h"
+#include "expr/node.h"
+#include "prop/sat_solver_types.h"
+#include "util/statistics_registry.h"
+#include "util/stats_timer.h"
+
+namespace cvc5 {
+namespace decision {
+
+/**
+ * A justification-based decision strategy whose state is maintained
+ * incrementally in the SAT context.
+ *
+ * As JustificationHeuristic, this strategy tries to justify each assertion,
+ * i.e. to make it true, by descending into the Boolean structure of the
+ * assertion until it finds an unassigned atom that, given the desired value
+ * of the formula it occurs in, is a good candidate for a decision. The
+ * formulas on the path from the assertion to that atom are kept on a stack
+ * of frames, each storing the formula, its desired value and the index of
+ * the child that is being justified. Since the frames, the set of justified
+ * formulas and the index of the next assertion to justify are all
+ * context-dependent in the SAT context, the next call to getNext() resumes
+ * the search from the top of the stack, and backtracking restores the
+ * state of the search at the decision level it backtracks to. The cost of a
+ * decision is thus proportional to the part of the formulas explored since
+ * the last decision, instead of a walk from the assertions.
+ *
+ * Assignments made since the last decision (by propagation or after
+ * backtracking) are taken into account lazily: the values of the children
+ * of the frames are checked when the frames are resumed, and frames whose
+ * formula was assigned the opposite of its desired value are popped, so that
+ * their parent can reconsider them.
+ *
+ * The definitions of the skolems introduced by term formula removal are
+ * justified once an atom containing the skolem was reached.
+ */
+class JustificationStrategy : public ITEDecisionStrategy
+{
+  /** The status of a formula with respect to its desired value */
+  enum class JustifyStatus
+  {
+    /** the formula is justified with its desired value */
+    JUSTIFIED,
+    /** the formula has the opposite of its desired value */
+    OPPOSITE,
+    /** the formula is an unassigned atom which we can decide on */
+    DECIDE,
+    /** the formula needs to be justified via its children */
+    PUSH
+  };
+  /** A frame of the justification stack */
+  struct JustifyFrame
+  {
+    JustifyFrame(context::Context* c)
+        : d_node(c), d_desiredVal(c, prop::SAT_VALUE_UNKNOWN), d_index(c, 0)
+    {
+    }
+    /** The formula that is being justified */
+    context::CDO<Node> d_node;
+    /** The value it is justified with */
+    context::CDO<prop::SatValue> d_desiredVal;
+    /** The index of the child of d_node that is being justified */
+    context::CDO<size_t> d_index;
+  };
+  typedef std::vector<std::pair<Node, Node> > SkolemList;
+  typedef context::CDHashMap<Node, SkolemList, NodeHashFunction> SkolemCache;
+  typedef context::CDHashMap<Node, Node, NodeHashFunction> SkolemMap;
+  typedef context::CDHashMap<Node, prop::SatValue, NodeHashFunction>
+      JustifiedMap;
+
+ public:
+  JustificationStrategy(DecisionEngine* de,
+                        context::UserContext* uc,
+                        context::Context* c);
+  ~JustificationStrategy();
+
+  prop::SatLiteral getNext(bool& stopSearch) override;
+
+  /**
+   * Notify this class that assertion is an (input) assertion, not
+   * corresponding to a skolem definition.
+   */
+  void addAssertion(TNode assertion) override;
+  /**
+   * Notify this class that lem is the skolem definition for skolem, which is
+   * a part of the current assertions.
+   */
+  void addSkolemDefinition(TNode lem, TNode skolem) override;
+
+ private:
+  /**
+   * Pop the frames of the stack whose formula was assigned the opposite of
+   * its desired value since the frame was pushed.
+   */
+  void refreshStack();
+  /**
+   * Get the next assertion or relevant skolem definition to justify, or the
+   * null node if all of them are justified.
+   */
+  TNode getNextRoot();
+  /** Mark the root returned by getNextRoot() as justified */
+  void advanceRoot();
+  /** Push a frame for justifying n with desiredVal */
+  void pushFrame(TNode n, prop::SatValue desiredVal);
+  /**
+   * Get the status of n with respect to desiredVal, where n is not a
+   * negation. If n is an atom, this makes the definitions of the skolems
+   * occurring in it relevant.
+   */
+  JustifyStatus getStatus(TNode n, prop::SatValue desiredVal);
+  /**
+   * Whether n with desiredVal is justified as soon as one of its children is,
+   * as opposed to when all of them are.
+   */
+  static bool isEasy(TNode n, prop::SatValue desiredVal);
+  /**
+   * Get the i^th child to justify for justifying n with desiredVal, where the
+   * desired value of the child is stored in childVal, with NOTs removed. This
+   * returns the null node if n has no i^th child to justify. The choice of
+   * children may depend on the current values of the children.
+   */
+  TNode getChild(TNode n,
+                 prop::SatValue desiredVal,
+                 size_t i,
+                 prop::SatValue& childVal);
+  /**
+   * The value of n, which is either the value it is justified with or the
+   * value of its literal, if any.
+   */
+  prop::SatValue getValue(TNode n);
+  /** Whether n is an atom for the purposes of justification */
+  static bool isAtom(TNode n);
+  /** Make the definitions of the skolems occurring in the atom n relevant */
+  void notifySkolems(TNode n);
+  /** Get the list of skolems of term formula removal occurring in n */
+  const SkolemList& getSkolems(TNode n);
+  /** Compute the skolems occurring in n recursively */
+  void computeSkolems(TNode n,
+                      SkolemList& l,
+                      std::unordered_set<TNode, TNodeHashFunction>& visited);
+
+  /** The assertions, not including skolem definitions */
+  context::CDList<Node> d_assertions;
+  /** The index of the first assertion that is not justified */
+  context::CDO<size_t> d_assertionIndex;
+  /** Map from skolems to their definitions */
+  SkolemMap d_skolemAssertions;
+  /** Cache for the skolems occurring in atoms */
+  SkolemCache d_skolemCache;
+  /** The skolem definitions that have become relevant */
+  context::CDList<Node> d_relevantSkolemDefs;
+  /** The skolems whose definition is in d_relevantSkolemDefs */
+  context::CDHashSet<Node, NodeHashFunction> d_relevantSkolems;
+  /** The index of the first relevant skolem definition that is not justified */
+  context::CDO<size_t> d_skolemDefIndex;
+  /** Maps justified formulas to the value they are justified with */
+  JustifiedMap d_justified;
+  /**
+   * The frames of the justification stack, of which the first d_stackSize
+   * are in use. Frames are allocated the first time the stack grows to them
+   * and reused afterwards.
+   */
+  std::vector<std::unique_ptr<JustifyFrame>> d_stack;
+  /** The size of the justification stack */
+  context::CDO<size_t> d_stackSize;
+  /** The SAT context */
+  context::Context* d_satContext;
+
+  /** The number of decisions made by this strategy */
+  IntStat d_decisions;
+  /** The number of times we had to leave the decision to the SAT solver */
+  IntStat d_giveup;
+  /** The time spent in getNext */
+  TimerStat d_timestat;
+}; /* class JustificationStrategy */
+
+}  // namespace decision
+}  // namespace cvc5
+
+#endif /* CVC4__DECISION__JUSTIFICATION_STRATEGY_H */
@@ -0,0 +1,280 @@
+/*********************                                                        */
+/*! \file alpha_hash.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of structural hashing modulo alpha-renaming
+ **/
+
+#include "expr/alpha_hash.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/attribute.h"
+#include "expr/node_algorithm.h"
+#include "util/hash.h"
+
+namespace cvc5 {
+namespace expr {
+
+struct AlphaHashAttributeId
+{
+};
+typedef expr::Attribute<AlphaHashAttributeId, uint64_t> AlphaHashAttr;
+
+namespace {
+
+/** The seeds that distinguish the kinds of leaves */
+const uint64_t s_groundSeed = 0x9e3779b97f4a7c15ull;
+const uint64_t s_boundVarSeed = 0xc2b2ae3d27d4eb4full;
+
+/** Whether the variable list of a closure of kind k is unordered */
+bool isUnorderedBinder(Kind k)
+{
+  return k == kind::FORALL || k == kind::EXISTS;
+}
+
+/** Hash a multiset of types by a commutative combination of their hashes */
+uint64_t hashTypeMultiset(TNode vars)
+{
+  uint64_t h = 0;
+  for (TNode v : vars)
+  {
+    h += fnv1a::fnv1a_64(v.getType().getId());
+  }
+  return h;
+}
+
+}  // namespace
+
+uint64_t getAlphaHash(TNode q)
+{
+  Assert(q.isClosure());
+  uint64_t h;
+  if (q.getAttribute(AlphaHashAttr(), h))
+  {
+    return h;
+  }
+  // the indices of the bound variables
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction> index;
+  // the hashes of the subterms of the body with bound variables
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction> visited;
+  std::unordered_map<TNode, uint64_t, TNodeHashFunction>::iterator it;
+  if (isUnorderedBinder(q.getKind()))
+  {
+    h = hashTypeMultiset(q[0]);
+  }
+  else
+  {
+    // variables of ordered binders are indexed by their position
+    for (TNode v : q[0])
+    {
+      index.emplace(v, index.size());
+    }
+    h = fnv1a::fnv1a_64(q[0].getNumChildren());
+  }
+  h = fnv1a::fnv1a_64(q.getKind(), h);
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(q[1]);
+  do
+  {
+    cur = visit.back();
+    it = visited.find(cur);
+    if (it != visited.end())
+    {
+      visit.pop_back();
+      if (it->second != 0)
+      {
+        continue;
+      }
+      // all children are hashed
+      uint64_t ch = fnv1a::fnv1a_64(cur.getKind());
+      if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        ch = fnv1a::fnv1a_64(visited[cur.getOperator()], ch);
+      }
+      for (TNode cn : cur)
+      {
+        ch = fnv1a::fnv1a_64(visited[cn], ch);
+      }
+      // 0 marks the terms that are being visited
+      it->second = ch == 0 ? 1 : ch;
+      continue;
+    }
+    if (!hasBoundVar(cur))
+    {
+      visit.pop_back();
+      visited[cur] = fnv1a::fnv1a_64(cur.getId(), s_groundSeed);
+      continue;
+    }
+    if (cur.getKind() == kind::BOUND_VARIABLE)
+    {
+      visit.pop_back();
+      // the first occurrence determines the index of a variable
+      uint64_t i = index.emplace(cur, index.size()).first->second;
+      visited[cur] = fnv1a::fnv1a_64(
+          i, fnv1a::fnv1a_64(cur.getType().getId(), s_boundVarSeed));
+      continue;
+    }
+    visited[cur] = 0;
+    // Push the children in reverse order, so that they are visited from left
+    // to right, which determines the indices of the variables.
+    for (size_t i = cur.getNumChildren(); i > 0; i--)
+    {
+      visit.push_back(cur[i - 1]);
+    }
+    if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      visit.push_back(cur.getOperator());
+    }
+  } while (!visit.empty());
+  h = fnv1a::fnv1a_64(visited[q[1]], h);
+  q.setAttribute(AlphaHashAttr(), h);
+  return h;
+}
+
+bool isAlphaEquivalent(TNode q1, TNode q2)
+{
+  Assert(q1.isClosure() && q2.isClosure());
+  if (q1 == q2)
+  {
+    return true;
+  }
+  if (q1.getKind() != q2.getKind()
+      || q1[0].getNumChildren() != q2[0].getNumChildren())
+  {
+    return false;
+  }
+  // the variables bound in q1 and q2, where those of the variable lists of
+  // q1 and q2 are marked by true
+  std::unordered_map<TNode, bool, TNodeHashFunction> bound1;
+  std::unordered_map<TNode, bool, TNodeHashFunction> bound2;
+  for (size_t i = 0; i < 2; i++)
+  {
+    TNode q = i == 0 ? q1 : q2;
+    std::unordered_map<TNode, bool, TNodeHashFunction>& bound =
+        i == 0 ? bound1 : bound2;
+    for (TNode v : q[0])
+    {
+      bound[v] = true;
+    }
+    std::unordered_set<Node, NodeHashFunction> bvls;
+    getKindSubterms(q[1], kind::BOUND_VAR_LIST, false, bvls);
+    for (TNode bvl : bvls)
+    {
+      for (TNode v : bvl)
+      {
+        bound.emplace(v, false);
+      }
+    }
+  }
+  // the bijection between the bound variables of q1 and q2
+  std::unordered_map<TNode, TNode, TNodeHashFunction> vmap;
+  std::unordered_map<TNode, TNode, TNodeHashFunction> vmapInv;
+  std::vector<std::pair<TNode, TNode>> visit;
+  std::unordered_set<std::pair<TNode, TNode>, TNodePairHashFunction> visited;
+  if (isUnorderedBinder(q1.getKind()))
+  {
+    // the variable lists must have the same multiset of types
+    std::vector<TypeNode> types1;
+    std::vector<TypeNode> types2;
+    for (size_t i = 0, nvars = q1[0].getNumChildren(); i < nvars; i++)
+    {
+      types1.push_back(q1[0][i].getType());
+      types2.push_back(q2[0][i].getType());
+    }
+    std::sort(types1.begin(), types1.end());
+    std::sort(types2.begin(), types2.end());
+    if (types1 != types2)
+    {
+      return false;
+    }
+  }
+  else
+  {
+    visit.emplace_back(q1[0], q2[0]);
+  }
+  visit.emplace_back(q1[1], q2[1]);
+  std::unordered_map<TNode, bool, TNodeHashFunction>::iterator itb1, itb2;
+  std::unordered_map<TNode, TNode, TNodeHashFunction>::iterator itm;
+  do
+  {
+    std::pair<TNode, TNode> cur = visit.back();
+    visit.pop_back();
+    TNode a = cur.first;
+    TNode b = cur.second;
+    if (a == b && !hasBoundVar(a))
+    {
+      continue;
+    }
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (a.getKind() != b.getKind() || a.getNumChildren() != b.getNumChildren())
+    {
+      return false;
+    }
+    if (a.getKind() == kind::BOUND_VARIABLE)
+    {
+      itb1 = bound1.find(a);
+      itb2 = bound2.find(b);
+      if (itb1 == bound1.end() || itb2 == bound2.end())
+      {
+        // free variables are not renamed
+        if (a != b || itb1 != bound1.end() || itb2 != bound2.end())
+        {
+          return false;
+        }
+        continue;
+      }
+      if (itb1->second != itb2->second || a.getType() != b.getType())
+      {
+        return false;
+      }
+      itm = vmap.find(a);
+      if (itm != vmap.end())
+      {
+        if (itm->second != b)
+        {
+          return false;
+        }
+        continue;
+      }
+      if (vmapInv.find(b) != vmapInv.end())
+      {
+        return false;
+      }
+      vmap[a] = b;
+      vmapInv[b] = a;
+      continue;
+    }
+    if (a.getNumChildren() == 0)
+    {
+      // distinct leaves other than variables
+      return false;
+    }
+    if (a.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      visit.emplace_back(a.getOperator(), b.getOperator());
+    }
+    for (size_t i = 0, nchild = a.getNumChildren(); i < nchild; i++)
+    {
+      visit.emplace_back(a[i], b[i]);
+    }
+  } while (!visit.empty());
+  return true;
+}
+
+}  // namespace expr
+}  // namespace cvc5
@@ -0,0 +1,55 @@
+/*********************                                                        */
+/*! \file alpha_hash.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Structural hashing of terms with binders modulo alpha-renaming
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__ALPHA_HASH_H
+#define CVC4__EXPR__ALPHA_HASH_H
+
+#include <cstdint>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace expr {
+
+/**
+ * Get the alpha-hash of the closure q, e.g. a quantified formula, which is
+ * computed once and stored as an attribute of q.
+ *
+ * The hash is a structural hash of the body q[1] of q in which each bound
+ * variable is replaced by its index in the order of first occurrence in the
+ * body, similar to de Bruijn indices, and the variable list q[0] of q is
+ * hashed as the multiset of the types of its variables. The subterms without
+ * bound variables are hashed by their identity without being traversed. The
+ * annotation of q, if any, is ignored.
+ *
+ * Hence, if isAlphaEquivalent(q1, q2) holds, then q1 and q2 have the same
+ * alpha-hash.
+ */
+uint64_t getAlphaHash(TNode q);
+
+/**
+ * Return true if q2 may be obtained from the closure q1 by a bijective
+ * renaming of its bound variables, up to the order of the variables of q1[0],
+ * whose binder must be FORALL or EXISTS if that order differs. As for
+ * getAlphaHash, annotations are ignored. The variables that are free in q1
+ * and q2 are not renamed.
+ */
+bool isAlphaEquivalent(TNode q1, TNode q2);
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC4__EXPR__ALPHA_HASH_H */
@@ -50,6 +50,10 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  d_denseInts.erase(nv);
+  d_denseTNodes.erase(nv);
+  d_denseNodes.erase(nv);
+  d_denseTypes.erase(nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
@@ -59,6 +63,12 @@ void AttributeManager::deleteAllAttributes() {
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  d_inGarbageCollection = true;
+  d_denseInts.clear();
+  d_denseTNodes.clear();
+  d_denseNodes.clear();
+  d_denseTypes.clear();
+  d_inGarbageCollection = false;
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
@@ -96,6 +106,18 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
     case AttrTableString:
       deleteAttributesFromTable(d_strings, ids);
       break;
+    case AttrTableDenseUInt64:
+      d_denseInts.eraseColumns(ids);
+      break;
+    case AttrTableDenseTNode:
+      d_denseTNodes.eraseColumns(ids);
+      break;
+    case AttrTableDenseNode:
+      d_denseNodes.eraseColumns(ids);
+      break;
+    case AttrTableDenseTypeNode:
+      d_denseTypes.eraseColumns(ids);
+      break;
 
     case AttrTableCDBool:
     case AttrTableCDUInt64:
@@ -73,6 +73,11 @@ namespace attr {
  * should be unique for each Attribute. Then via some template messiness when
  * InstLevelAttribute() is passed as the argument to getAttribute(...) the load
  * time id is instantiated.
+ *
+ * Attributes that are set for most nodes and read often, e.g. the types of
+ * nodes, may be defined as expr::DenseAttribute instead, whose values are
+ * stored in vectors indexed by the ids of the nodes (AttrColumns<>) rather
+ * than in hash tables.
  */
 // ATTRIBUTE MANAGER ===========================================================
 
@@ -125,6 +130,14 @@ public:
   AttrHash<TypeNode> d_types;
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
+  /** Underlying table for dense integral-valued attributes */
+  AttrColumns<uint64_t> d_denseInts;
+  /** Underlying table for dense node-valued attributes */
+  AttrColumns<TNode> d_denseTNodes;
+  /** Underlying table for dense node-valued attributes */
+  AttrColumns<Node> d_denseNodes;
+  /** Underlying table for dense type attributes */
+  AttrColumns<TypeNode> d_denseTypes;
 
   /**
    * Get a particular attribute on a particular node.
@@ -178,6 +191,15 @@ public:
                     const AttrKind& attr,
                     const typename AttrKind::value_type& value);
 
+  /**
+   * Remove a particular attribute from a particular node, if it is set.
+   *
+   * @param nv the node from which to remove the attribute
+   * @param attr the attribute kind to remove
+   */
+  template <class AttrKind>
+  void removeAttribute(NodeValue* nv, const AttrKind& attr);
+
   /**
    * Remove all attributes associated to the given node.
    *
@@ -318,6 +340,97 @@ struct getTable<std::string, false> {
   }
 };
 
+/**
+ * The getDenseTable<> template provides (static) access to the
+ * AttributeManager field holding the table of DenseAttribute kinds.
+ */
+template <class T, class Enable = void>
+struct getDenseTable;
+
+/** Access the "d_denseInts" member of AttributeManager. */
+template <class T>
+struct getDenseTable<
+    T,
+    // Use this specialization only for unsigned integers
+    typename std::enable_if<std::is_unsigned<T>::value>::type>
+{
+  static const AttrTableId id = AttrTableDenseUInt64;
+  typedef AttrColumns<uint64_t> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseInts;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseInts;
+  }
+};
+
+/** Access the "d_denseTNodes" member of AttributeManager. */
+template <>
+struct getDenseTable<TNode>
+{
+  static const AttrTableId id = AttrTableDenseTNode;
+  typedef AttrColumns<TNode> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseTNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseTNodes;
+  }
+};
+
+/** Access the "d_denseNodes" member of AttributeManager. */
+template <>
+struct getDenseTable<Node>
+{
+  static const AttrTableId id = AttrTableDenseNode;
+  typedef AttrColumns<Node> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+};
+
+/** Access the "d_denseTypes" member of AttributeManager. */
+template <>
+struct getDenseTable<TypeNode>
+{
+  static const AttrTableId id = AttrTableDenseTypeNode;
+  typedef AttrColumns<TypeNode> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+};
+
+/**
+ * The getAttrTable<> template gives the table of an attribute kind, i.e.
+ * getDenseTable<> for DenseAttribute kinds and getTable<> otherwise.
+ */
+template <class AttrKind, bool dense = AttrKind::dense>
+struct getAttrTable
+    : public getTable<typename AttrKind::value_type,
+                      AttrKind::context_dependent>
+{
+};
+
+template <class AttrKind>
+struct getAttrTable<AttrKind, true>
+    : public getDenseTable<typename AttrKind::value_type>
+{
+};
+
 }  // namespace attr
 
 // ATTRIBUTE MANAGER IMPLEMENTATIONS ===========================================
@@ -330,11 +443,10 @@ typename AttrKind::value_type
 AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
+  typedef typename getAttrTable<AttrKind>::table_type table_type;
 
   const table_type& ah =
-    getTable<value_type, AttrKind::context_dependent>::get(*this);
+    getAttrTable<AttrKind>::get(*this);
   typename table_type::const_iterator i =
     ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -372,12 +484,10 @@ struct HasAttribute<true, AttrKind> {
                                   typename AttrKind::value_type& ret) {
     typedef typename AttrKind::value_type value_type;
     typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type,
-                              AttrKind::context_dependent>::table_type
-      table_type;
+    typedef typename getAttrTable<AttrKind>::table_type table_type;
 
     const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
+      getAttrTable<AttrKind>::get(*am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -399,13 +509,10 @@ template <class AttrKind>
 struct HasAttribute<false, AttrKind> {
   static inline bool hasAttribute(const AttributeManager* am,
                                   NodeValue* nv) {
-    typedef typename AttrKind::value_type value_type;
-    //typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
+    typedef typename getAttrTable<AttrKind>::table_type table_type;
 
     const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
+      getAttrTable<AttrKind>::get(*am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -421,11 +528,10 @@ struct HasAttribute<false, AttrKind> {
                                   typename AttrKind::value_type& ret) {
     typedef typename AttrKind::value_type value_type;
     typedef KindValueToTableValueMapping<value_type> mapping;
-    typedef typename getTable<value_type, AttrKind::context_dependent>::
-              table_type table_type;
+    typedef typename getAttrTable<AttrKind>::table_type table_type;
 
     const table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*am);
+      getAttrTable<AttrKind>::get(*am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
 
@@ -461,14 +567,20 @@ AttributeManager::setAttribute(NodeValue* nv,
                                const typename AttrKind::value_type& value) {
   typedef typename AttrKind::value_type value_type;
   typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type, AttrKind::context_dependent>::
-            table_type table_type;
+  typedef typename getAttrTable<AttrKind>::table_type table_type;
 
   table_type& ah =
-      getTable<value_type, AttrKind::context_dependent>::get(*this);
+      getAttrTable<AttrKind>::get(*this);
   ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
 }
 
+template <class AttrKind>
+inline void AttributeManager::removeAttribute(NodeValue* nv, const AttrKind&)
+{
+  getAttrTable<AttrKind>::get(*this).erase(
+      std::make_pair(AttrKind::getId(), nv));
+}
+
 /** Search for the NodeValue in all attribute tables and remove it. */
 template <class T>
 inline void AttributeManager::deleteFromTable(AttrHash<T>& table,
@@ -493,9 +605,7 @@ inline void AttributeManager::deleteAllFromTable(AttrHash<T>& table) {
 
 template <class AttrKind>
 AttributeUniqueId AttributeManager::getAttributeId(const AttrKind& attr){
-  typedef typename AttrKind::value_type value_type;
-  AttrTableId tableId = getTable<value_type,
-                                 AttrKind::context_dependent>::id;
+  AttrTableId tableId = getAttrTable<AttrKind>::id;
   return AttributeUniqueId(tableId, attr.getId());
 }
 
@@ -595,6 +705,12 @@ NodeManager::setAttribute(TNode n, const AttrKind&,
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
+template <class AttrKind>
+inline void NodeManager::removeAttribute(TNode n, const AttrKind&)
+{
+  d_attrManager->removeAttribute(n.d_nv, AttrKind());
+}
+
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TypeNode n, const AttrKind&) const {
@@ -23,7 +23,10 @@
 #ifndef CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 #define CVC4__EXPR__ATTRIBUTE_INTERNALS_H
 
+#include <array>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace cvc5 {
 namespace expr {
@@ -43,17 +46,6 @@ struct AttrHashFunction {
   }
 };/* struct AttrHashFunction */
 
-/**
- * A hash function for boolean-valued attribute table keys; here we
- * don't have to store a pair as the key, because we use a known bit
- * in [0..63] for each attribute
- */
-struct AttrBoolHashFunction {
-  std::size_t operator()(NodeValue* nv) const {
-    return (size_t)nv->getId();
-  }
-};/* struct AttrBoolHashFunction */
-
 }  // namespace attr
 
 // ATTRIBUTE TYPE MAPPINGS =====================================================
@@ -145,6 +137,251 @@ inline uint64_t GetBitSet(uint64_t bit)
   return kOne << bit;
 }
 
+/**
+ * A table from nodes to values of value_type that is indexed by the ids of
+ * the nodes, which the node manager assigns consecutively. The values are
+ * stored in pages of consecutive ids. A page is allocated when the first node
+ * in its range is inserted and freed when the last one is erased, e.g. when
+ * the nodes are reclaimed, so that the ids of reclaimed nodes do not keep
+ * their memory.
+ */
+template <class value_type>
+class AttrPages
+{
+ public:
+  AttrPages() : d_size(0) {}
+
+  /** Get the value of nv, or nullptr if nv is not in the table */
+  const value_type* find(const NodeValue* nv) const
+  {
+    uint64_t id = nv->getId();
+    uint64_t p = id >> s_pageBits;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return nullptr;
+    }
+    const Page& page = *d_pages[p];
+    uint64_t i = id & s_pageMask;
+    return page.isSet(i) ? &page.d_values[i] : nullptr;
+  }
+
+  /** Get the value of nv, or nullptr if nv is not in the table */
+  value_type* find(const NodeValue* nv)
+  {
+    return const_cast<value_type*>(
+        static_cast<const AttrPages*>(this)->find(nv));
+  }
+
+  /**
+   * Get the value of nv, which is inserted with a default-constructed value
+   * if it is not in the table.
+   */
+  value_type& operator[](const NodeValue* nv)
+  {
+    uint64_t id = nv->getId();
+    uint64_t p = id >> s_pageBits;
+    if (p >= d_pages.size())
+    {
+      d_pages.resize(p + 1);
+    }
+    if (d_pages[p] == nullptr)
+    {
+      d_pages[p].reset(new Page());
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & s_pageMask;
+    if (!page.isSet(i))
+    {
+      page.d_set[i >> 6] |= GetBitSet(i & 63);
+      ++page.d_count;
+      ++d_size;
+    }
+    return page.d_values[i];
+  }
+
+  /** Erase nv from the table, if it is in the table */
+  void erase(const NodeValue* nv)
+  {
+    uint64_t id = nv->getId();
+    uint64_t p = id >> s_pageBits;
+    if (p >= d_pages.size() || d_pages[p] == nullptr)
+    {
+      return;
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & s_pageMask;
+    if (!page.isSet(i))
+    {
+      return;
+    }
+    page.d_set[i >> 6] &= ~GetBitSet(i & 63);
+    --d_size;
+    if (--page.d_count == 0)
+    {
+      d_pages[p].reset();
+    }
+    else
+    {
+      // release the value, e.g. a reference to a node
+      page.d_values[i] = value_type();
+    }
+  }
+
+  /** Erase all nodes from the table */
+  void clear()
+  {
+    d_pages.clear();
+    d_size = 0;
+  }
+
+  /** Is the table empty? */
+  bool empty() const { return d_size == 0; }
+
+  /** The number of nodes in the table */
+  size_t size() const { return d_size; }
+
+ private:
+  /** The number of bits of the ids that are the index in a page */
+  static constexpr uint64_t s_pageBits = 8;
+  /** The number of ids of a page */
+  static constexpr uint64_t s_pageSize = uint64_t(1) << s_pageBits;
+  /** The mask of the index of an id in its page */
+  static constexpr uint64_t s_pageMask = s_pageSize - 1;
+
+  /** The values of a range of s_pageSize consecutive ids */
+  struct Page
+  {
+    Page() : d_values(), d_set(), d_count(0) {}
+    /** Is the i-th id of the page in the table? */
+    bool isSet(uint64_t i) const
+    {
+      return (d_set[i >> 6] & GetBitSet(i & 63)) != 0;
+    }
+    /** The values of the ids */
+    std::array<value_type, s_pageSize> d_values;
+    /** The bit set of the ids that are in the table */
+    std::array<uint64_t, s_pageSize / 64> d_set;
+    /** The number of ids that are in the table */
+    uint32_t d_count;
+  };
+
+  /** The pages, indexed by the ids shifted by s_pageBits */
+  std::vector<std::unique_ptr<Page>> d_pages;
+  /** The number of nodes in the table */
+  size_t d_size;
+};/* class AttrPages<> */
+
+/**
+ * An "AttrColumns<value_type>" is the table underlying dense attributes (see
+ * DenseAttribute). It stores the values of each attribute in a separate
+ * column that is indexed by the ids of the nodes, so that a lookup is an
+ * indexed access instead of a hash table probe. It provides the part of the
+ * interface of AttrHash<value_type> that is used by the AttributeManager.
+ */
+template <class value_type>
+class AttrColumns
+{
+ public:
+  /**
+   * A (somewhat degenerate) const_iterator over the values of a column.
+   * This const_iterator doesn't support anything except comparison and
+   * dereference.  It's intended just for the result of find() on the
+   * table.
+   */
+  class const_iterator
+  {
+    NodeValue* d_nv;
+
+    const value_type* d_value;
+
+   public:
+    const_iterator() : d_nv(nullptr), d_value(nullptr) {}
+
+    const_iterator(NodeValue* nv, const value_type* value)
+        : d_nv(nv), d_value(value)
+    {
+    }
+
+    std::pair<NodeValue* const, const value_type&> operator*() const
+    {
+      return std::pair<NodeValue* const, const value_type&>(d_nv, *d_value);
+    }
+
+    bool operator==(const const_iterator& i) const
+    {
+      return d_value == i.d_value;
+    }
+  };/* class AttrColumns<>::const_iterator */
+
+  /**
+   * Find the value of attribute k.first for node k.second.  Returns
+   * something == end() if not found.
+   */
+  const_iterator find(const std::pair<uint64_t, NodeValue*>& k) const
+  {
+    if (k.first >= d_columns.size())
+    {
+      return const_iterator();
+    }
+    const value_type* value = d_columns[k.first].find(k.second);
+    return value == nullptr ? const_iterator()
+                            : const_iterator(k.second, value);
+  }
+
+  /** The "off the end" const_iterator */
+  const_iterator end() const { return const_iterator(); }
+
+  /**
+   * Get the value of attribute k.first for node k.second, which is inserted
+   * with a default-constructed value if it is not already there.
+   */
+  value_type& operator[](const std::pair<uint64_t, NodeValue*>& k)
+  {
+    if (k.first >= d_columns.size())
+    {
+      d_columns.resize(k.first + 1);
+    }
+    return d_columns[k.first][k.second];
+  }
+
+  /** Remove attribute k.first from node k.second. */
+  void erase(const std::pair<uint64_t, NodeValue*>& k)
+  {
+    if (k.first < d_columns.size())
+    {
+      d_columns[k.first].erase(k.second);
+    }
+  }
+
+  /** Remove all attributes from node nv. */
+  void erase(NodeValue* nv)
+  {
+    for (AttrPages<value_type>& column : d_columns)
+    {
+      column.erase(nv);
+    }
+  }
+
+  /** Remove the attributes with the given ids from all nodes. */
+  void eraseColumns(const std::vector<uint64_t>& ids)
+  {
+    for (uint64_t id : ids)
+    {
+      if (id < d_columns.size())
+      {
+        d_columns[id].clear();
+      }
+    }
+  }
+
+  /** Remove all attributes from all nodes. */
+  void clear() { d_columns.clear(); }
+
+ private:
+  /** The columns, indexed by the ids of the attributes */
+  std::vector<AttrPages<value_type>> d_columns;
+};/* class AttrColumns<> */
+
 /**
  * An "AttrHash<value_type>"---the hash table underlying
  * attributes---is simply a mapping of pair<unique-attribute-id, Node>
@@ -159,16 +396,15 @@ class AttrHash :
 
 /**
  * In the case of Boolean-valued attributes we have a special
- * "AttrHash<bool>" to pack bits together in words.
+ * "AttrHash<bool>" to pack bits together in words.  Since most nodes have
+ * some flags, e.g. whether they were type checked, the words are not hashed
+ * but stored in a table indexed by the ids of the nodes.
  */
 template <>
-class AttrHash<bool> :
-    protected std::unordered_map<NodeValue*,
-                                  uint64_t,
-                                  AttrBoolHashFunction> {
-
+class AttrHash<bool> : protected AttrPages<uint64_t>
+{
   /** A "super" type, like in Java, for easy reference below. */
-  typedef std::unordered_map<NodeValue*, uint64_t, AttrBoolHashFunction> super;
+  typedef AttrPages<uint64_t> super;
 
   /**
    * BitAccessor allows us to return a bit "by reference."  Of course,
@@ -207,29 +443,31 @@ class AttrHash<bool> :
    */
   class BitIterator {
 
-    std::pair<NodeValue* const, uint64_t>* d_entry;
+    NodeValue* d_nv;
+
+    uint64_t* d_word;
 
     uint64_t d_bit;
 
    public:
 
     BitIterator() :
-      d_entry(NULL),
+      d_nv(NULL),
+      d_word(NULL),
       d_bit(0) {
     }
 
-    BitIterator(std::pair<NodeValue* const, uint64_t>& entry, uint64_t bit)
-        : d_entry(&entry), d_bit(bit)
+    BitIterator(NodeValue* nv, uint64_t& word, uint64_t bit)
+        : d_nv(nv), d_word(&word), d_bit(bit)
     {
     }
 
     std::pair<NodeValue* const, BitAccessor> operator*() {
-      return std::make_pair(d_entry->first,
-                            BitAccessor(d_entry->second, d_bit));
+      return std::make_pair(d_nv, BitAccessor(*d_word, d_bit));
     }
 
     bool operator==(const BitIterator& b) {
-      return d_entry == b.d_entry && d_bit == b.d_bit;
+      return d_word == b.d_word && d_bit == b.d_bit;
     }
   };/* class AttrHash<bool>::BitIterator */
 
@@ -241,31 +479,33 @@ class AttrHash<bool> :
    */
   class ConstBitIterator {
 
-    const std::pair<NodeValue* const, uint64_t>* d_entry;
+    NodeValue* d_nv;
+
+    const uint64_t* d_word;
 
     uint64_t d_bit;
 
    public:
 
     ConstBitIterator() :
-      d_entry(NULL),
+      d_nv(NULL),
+      d_word(NULL),
       d_bit(0) {
     }
 
-    ConstBitIterator(const std::pair<NodeValue* const, uint64_t>& entry,
-                     uint64_t bit)
-        : d_entry(&entry), d_bit(bit)
+    ConstBitIterator(NodeValue* nv, const uint64_t& word, uint64_t bit)
+        : d_nv(nv), d_word(&word), d_bit(bit)
     {
     }
 
     std::pair<NodeValue* const, bool> operator*()
     {
-      return std::make_pair(
-          d_entry->first, (d_entry->second & GetBitSet(d_bit)) ? true : false);
+      return std::make_pair(d_nv,
+                            (*d_word & GetBitSet(d_bit)) ? true : false);
     }
 
     bool operator==(const ConstBitIterator& b) {
-      return d_entry == b.d_entry && d_bit == b.d_bit;
+      return d_word == b.d_word && d_bit == b.d_bit;
     }
   };/* class AttrHash<bool>::ConstBitIterator */
 
@@ -285,8 +525,9 @@ public:
    * end() if not found.
    */
   BitIterator find(const std::pair<uint64_t, NodeValue*>& k) {
-    super::iterator i = super::find(k.second);
-    if(i == super::end()) {
+    uint64_t* word = super::find(k.second);
+    if (word == nullptr)
+    {
       return BitIterator();
     }
     /*
@@ -296,7 +537,7 @@ public:
                  (uint64_t)((*i).second),
                  uint64_t(k.first));
     */
-    return BitIterator(*i, k.first);
+    return BitIterator(k.second, *word, k.first);
   }
 
   /** The "off the end" iterator */
@@ -309,8 +550,9 @@ public:
    * end() if not found.
    */
   ConstBitIterator find(const std::pair<uint64_t, NodeValue*>& k) const {
-    super::const_iterator i = super::find(k.second);
-    if(i == super::end()) {
+    const uint64_t* word = super::find(k.second);
+    if (word == nullptr)
+    {
       return ConstBitIterator();
     }
     /*
@@ -320,7 +562,7 @@ public:
                  (uint64_t)((*i).second),
                  uint64_t(k.first));
     */
-    return ConstBitIterator(*i, k.first);
+    return ConstBitIterator(k.second, *word, k.first);
   }
 
   /** The "off the end" const_iterator */
@@ -437,6 +679,9 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /** The values are stored in a hash table (see DenseAttribute). */
+  static const bool dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -485,6 +730,12 @@ public:
    */
   static const bool context_dependent = context_dep;
 
+  /**
+   * Flags are stored in AttrHash<bool>, which packs the flags of a node into
+   * one word, not in an AttrColumns table (see DenseAttribute).
+   */
+  static const bool dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -498,6 +749,55 @@ public:
   }
 };/* class Attribute<..., bool, ...> */
 
+/**
+ * An "attribute type" structure for attributes whose values are stored in a
+ * column indexed by the ids of the nodes (see AttrColumns) instead of a hash
+ * table.  Accessing them is faster, but the memory of a column is
+ * proportional to the range of ids of the nodes that have the attribute, so
+ * this is meant for attributes that are set for most nodes and read often,
+ * e.g. the type of nodes.  The value type must be an unsigned integer, TNode,
+ * Node or TypeNode.
+ *
+ * @param T the tag for the attribute kind.
+ *
+ * @param value_t the underlying value_type for the attribute kind
+ */
+template <class T, class value_t>
+class DenseAttribute
+{
+  /**
+   * The unique ID associated to this attribute.  Assigned statically,
+   * at load time.
+   */
+  static const uint64_t s_id;
+
+ public:
+  /** The value type for this attribute. */
+  typedef value_t value_type;
+
+  /** Get the unique ID associated to this attribute. */
+  static inline uint64_t getId() { return s_id; }
+
+  /** As for Attribute, there is no default value. */
+  static const bool has_default_value = false;
+
+  /** Dense attributes are not context-dependent. */
+  static const bool context_dependent = false;
+
+  /** The values are stored in the columns of an AttrColumns table. */
+  static const bool dense = true;
+
+  /** Register this attribute kind and return its id. */
+  static inline uint64_t registerAttribute()
+  {
+    typedef typename attr::KindValueToTableValueMapping<value_t>::
+        table_value_type table_value_type;
+    // the ids are the indices of the columns of the table
+    return attr::LastAttributeId<attr::AttrColumns<table_value_type>,
+                                 false>::getNextId();
+  }
+};/* class DenseAttribute<> */
+
 // ATTRIBUTE IDENTIFIER ASSIGNMENT =============================================
 
 /** Assign unique IDs to attributes at load time. */
@@ -511,6 +811,11 @@ template <class T, bool context_dep>
 const uint64_t Attribute<T, bool, context_dep>::s_id =
     Attribute<T, bool, context_dep>::registerAttribute();
 
+/** Assign unique IDs to attributes at load time. */
+template <class T, class value_t>
+const uint64_t DenseAttribute<T, value_t>::s_id =
+    DenseAttribute<T, value_t>::registerAttribute();
+
 }  // namespace expr
 }  // namespace cvc5
 
@@ -33,6 +33,10 @@ enum AttrTableId {
   AttrTableNode,
   AttrTableTypeNode,
   AttrTableString,
+  AttrTableDenseUInt64,
+  AttrTableDenseTNode,
+  AttrTableDenseNode,
+  AttrTableDenseTypeNode,
   AttrTableCDBool,
   AttrTableCDUInt64,
   AttrTableCDTNode,
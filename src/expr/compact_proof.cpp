@@ -0,0 +1,296 @@
+/*********************                                                        */
+/*! \file compact_proof.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of a proof that stores its steps compactly
+ **/
+
+#include "expr/compact_proof.h"
+
+#include <unordered_set>
+
+#include "expr/proof.h"
+#include "expr/proof_ensure_closed.h"
+#include "expr/proof_node.h"
+#include "expr/proof_node_manager.h"
+#include "expr/proof_step_buffer.h"
+
+namespace cvc5 {
+
+CompactProof::CompactProof(ProofNodeManager* pnm,
+                           context::Context* c,
+                           std::string name)
+    : d_manager(pnm),
+      d_context(),
+      d_steps(c ? c : &d_context),
+      d_stepNodes(c ? c : &d_context),
+      d_stepIndex(c ? c : &d_context),
+      d_gens(c ? c : &d_context),
+      d_name(name)
+{
+}
+
+CompactProof::~CompactProof() {}
+
+void CompactProof::addStep(Node expected,
+                           PfRule id,
+                           const std::vector<Node>& children,
+                           const std::vector<Node>& args)
+{
+  Trace("compact-proof") << "CompactProof::addStep: " << identify() << " : "
+                         << id << " " << expected << std::endl;
+  Assert(!expected.isNull());
+  if (id == PfRule::ASSUME || hasStep(expected))
+  {
+    // an assumption is the default, and we don't overwrite existing steps
+    Trace("compact-proof") << "...no overwrite" << std::endl;
+    return;
+  }
+  Step s;
+  s.d_rule = id;
+  s.d_begin = d_stepNodes.size();
+  s.d_numChildren = children.size();
+  s.d_numArgs = args.size();
+  for (const Node& c : children)
+  {
+    d_stepNodes.push_back(c);
+  }
+  for (const Node& a : args)
+  {
+    d_stepNodes.push_back(a);
+  }
+  d_stepIndex.insert(expected, d_steps.size());
+  d_steps.push_back(s);
+}
+
+void CompactProof::addStep(Node expected, const ProofStep& step)
+{
+  addStep(expected, step.d_rule, step.d_children, step.d_args);
+}
+
+void CompactProof::addLazyStep(Node expected,
+                               ProofGenerator* pg,
+                               PfRule idNull,
+                               bool isClosed,
+                               const char* ctx)
+{
+  if (pg == nullptr)
+  {
+    // null generator, should have given a proof rule
+    if (idNull == PfRule::ASSUME)
+    {
+      Unreachable() << "CompactProof::addLazyStep: " << identify()
+                    << ": failed to provide proof generator for " << expected;
+      return;
+    }
+    addStep(expected, idNull, {}, {expected});
+    return;
+  }
+  Trace("compact-proof") << "CompactProof::addLazyStep: " << expected
+                         << " set to generator " << pg->identify() << "\n";
+  if (d_gens.find(expected) != d_gens.end())
+  {
+    // don't overwrite something that is already there
+    return;
+  }
+  d_gens.insert(expected, pg);
+  // debug checking
+  if (isClosed)
+  {
+    pfgEnsureClosed(expected, pg, "compact-proof-debug", ctx);
+  }
+}
+
+bool CompactProof::hasStep(Node fact) const
+{
+  bool isSym;
+  return getStepFor(fact, isSym) != nullptr;
+}
+
+bool CompactProof::hasGenerator(Node fact) const
+{
+  bool isSym;
+  return getGeneratorFor(fact, isSym) != nullptr;
+}
+
+const CompactProof::Step* CompactProof::getStepFor(Node fact,
+                                                   bool& isSym) const
+{
+  isSym = false;
+  NodeStepMap::const_iterator it = d_stepIndex.find(fact);
+  if (it != d_stepIndex.end())
+  {
+    return &d_steps[(*it).second];
+  }
+  Node factSym = CDProof::getSymmFact(fact);
+  if (!factSym.isNull())
+  {
+    it = d_stepIndex.find(factSym);
+    if (it != d_stepIndex.end())
+    {
+      isSym = true;
+      return &d_steps[(*it).second];
+    }
+  }
+  return nullptr;
+}
+
+ProofGenerator* CompactProof::getGeneratorFor(Node fact, bool& isSym) const
+{
+  isSym = false;
+  NodeProofGeneratorMap::const_iterator it = d_gens.find(fact);
+  if (it != d_gens.end())
+  {
+    return (*it).second;
+  }
+  Node factSym = CDProof::getSymmFact(fact);
+  if (!factSym.isNull())
+  {
+    it = d_gens.find(factSym);
+    if (it != d_gens.end())
+    {
+      isSym = true;
+      return (*it).second;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<ProofNode> CompactProof::getProofFor(Node fact)
+{
+  Trace("compact-proof") << "CompactProof::getProofFor " << fact << std::endl;
+  // The proofs of the facts below fact, built in post-order. A fact is
+  // visited but not built while its premises are being built, in which case
+  // a premise that refers back to it (due to a cyclic step) is an assumption.
+  NodeProofNodeMap built;
+  std::unordered_set<Node, NodeHashFunction> visited;
+  std::vector<Node> visit;
+  Node cur;
+  visit.push_back(fact);
+  do
+  {
+    cur = visit.back();
+    if (visited.find(cur) == visited.end())
+    {
+      visited.insert(cur);
+      bool isSym;
+      const Step* s = getStepFor(cur, isSym);
+      if (s == nullptr)
+      {
+        continue;
+      }
+      if (isSym)
+      {
+        Node factSym = CDProof::getSymmFact(cur);
+        if (visited.find(factSym) == visited.end())
+        {
+          visit.push_back(factSym);
+        }
+        continue;
+      }
+      for (uint32_t i = s->d_begin, end = s->d_begin + s->d_numChildren;
+           i < end;
+           i++)
+      {
+        const Node& c = d_stepNodes[i];
+        if (visited.find(c) == visited.end())
+        {
+          visit.push_back(c);
+        }
+      }
+    }
+    else
+    {
+      visit.pop_back();
+      if (built.find(cur) == built.end())
+      {
+        built[cur] = mkProof(cur, built);
+      }
+    }
+  } while (!visit.empty());
+  Assert(built.find(fact) != built.end());
+  return built[fact];
+}
+
+std::shared_ptr<ProofNode> CompactProof::mkProof(
+    Node fact, const NodeProofNodeMap& built)
+{
+  bool isSym;
+  const Step* s = getStepFor(fact, isSym);
+  if (s != nullptr)
+  {
+    std::vector<std::shared_ptr<ProofNode>> pchildren;
+    std::vector<Node> args;
+    if (isSym)
+    {
+      pchildren.push_back(getBuilt(CDProof::getSymmFact(fact), built));
+    }
+    else
+    {
+      uint32_t i = s->d_begin;
+      for (uint32_t end = i + s->d_numChildren; i < end; i++)
+      {
+        pchildren.push_back(getBuilt(d_stepNodes[i], built));
+      }
+      for (uint32_t end = i + s->d_numArgs; i < end; i++)
+      {
+        args.push_back(d_stepNodes[i]);
+      }
+    }
+    std::shared_ptr<ProofNode> pf = d_manager->mkNode(
+        isSym ? PfRule::SYMM : s->d_rule, pchildren, args, fact);
+    if (pf != nullptr)
+    {
+      return pf;
+    }
+    // the step failed to check, which CDProof would not have added
+    Trace("compact-proof") << "...failed to check step for " << fact
+                           << std::endl;
+  }
+  std::shared_ptr<ProofNode> pfa = d_manager->mkAssume(fact);
+  ProofGenerator* pg = getGeneratorFor(fact, isSym);
+  if (pg != nullptr)
+  {
+    Trace("compact-proof") << "CompactProof: Call generator " << pg->identify()
+                           << " for assumption " << fact << std::endl;
+    Node factGen = isSym ? CDProof::getSymmFact(fact) : fact;
+    // As in LazyCDProof, we update the assumption instead of returning the
+    // proof of the generator, so that we never take ownership of the latter
+    std::shared_ptr<ProofNode> pgc = pg->getProofFor(factGen);
+    if (pgc != nullptr)
+    {
+      if (isSym)
+      {
+        d_manager->updateNode(pfa.get(), PfRule::SYMM, {pgc}, {});
+      }
+      else
+      {
+        d_manager->updateNode(pfa.get(), pgc.get());
+      }
+    }
+  }
+  return pfa;
+}
+
+std::shared_ptr<ProofNode> CompactProof::getBuilt(
+    Node fact, const NodeProofNodeMap& built)
+{
+  NodeProofNodeMap::const_iterator it = built.find(fact);
+  if (it != built.end())
+  {
+    return it->second;
+  }
+  // fact is a premise of a cyclic step, whose proof is still being built
+  return d_manager->mkAssume(fact);
+}
+
+std::string CompactProof::identify() const { return d_name; }
+
+}  // namespace cvc5
@@ -0,0 +1,154 @@
+/*********************                                                        */
+/*! \file compact_proof.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A proof that stores its steps compactly
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__COMPACT_PROOF_H
+#define CVC4__EXPR__COMPACT_PROOF_H
+
+#include <unordered_map>
+
+#include "context/cdhashmap.h"
+#include "context/cdlist.h"
+#include "expr/node.h"
+#include "expr/proof_generator.h"
+#include "expr/proof_rule.h"
+
+namespace cvc5 {
+
+class ProofNode;
+class ProofNodeManager;
+class ProofStep;
+
+/**
+ * A (context-dependent) lazy proof whose steps are stored compactly. This
+ * class has the same interface and semantics as a LazyCDProof with the
+ * default overwrite policy and no default generator, but does not construct
+ * a ProofNode when a step is added. Instead, each step is a record of its
+ * rule and the number of its children and arguments, which are stored in a
+ * single list of nodes. Since nodes are hash-consed, a premise is identified
+ * with the step concluding it by a lookup of the conclusion.
+ *
+ * The proof nodes are only constructed by getProofFor, which expands the DAG
+ * of steps below the given fact. Hence this class is suited for proofs where
+ * most steps are never part of a final proof, e.g. the clausification steps
+ * of the CNF stream. Since the expansion is done on each call, the proof
+ * nodes of separate calls are not shared.
+ */
+class CompactProof : public ProofGenerator
+{
+ public:
+  /** Constructor
+   *
+   * @param pnm The proof node manager for constructing ProofNode objects.
+   * @param c The context that this class depends on. If none is provided,
+   * this class is context-independent.
+   */
+  CompactProof(ProofNodeManager* pnm,
+               context::Context* c = nullptr,
+               std::string name = "CompactProof");
+  ~CompactProof();
+  /**
+   * Get the proof for fact. This constructs the proof nodes for the steps
+   * below fact, calls the generators for the premises that have no step and
+   * makes the remaining premises ASSUME leaves. This method always returns
+   * a non-null proof.
+   */
+  std::shared_ptr<ProofNode> getProofFor(Node fact) override;
+  /**
+   * Add step, which concludes expected using rule id from the given children
+   * and arguments. As for CDProof with the ASSUME_ONLY policy, this does
+   * nothing if expected or its symmetric form already has a step.
+   */
+  void addStep(Node expected,
+               PfRule id,
+               const std::vector<Node>& children,
+               const std::vector<Node>& args);
+  /** Add step, as above */
+  void addStep(Node expected, const ProofStep& step);
+  /**
+   * Add step by generator, with the same semantics as
+   * LazyCDProof::addLazyStep without overwriting.
+   */
+  void addLazyStep(Node expected,
+                   ProofGenerator* pg,
+                   PfRule trustId = PfRule::ASSUME,
+                   bool isClosed = false,
+                   const char* ctx = "CompactProof::addLazyStep");
+  /** Does fact or its symmetric form have a step? */
+  bool hasStep(Node fact) const;
+  /** Does fact or its symmetric form have a generator? */
+  bool hasGenerator(Node fact) const;
+  /** Identify this generator (for debugging, etc..) */
+  std::string identify() const override;
+
+ private:
+  /**
+   * A step, whose children and arguments are d_numChildren and d_numArgs
+   * consecutive entries of d_stepNodes, starting at d_begin.
+   */
+  struct Step
+  {
+    /** The rule */
+    PfRule d_rule;
+    /** The index of the first child in d_stepNodes */
+    uint32_t d_begin;
+    /** The number of children */
+    uint32_t d_numChildren;
+    /** The number of arguments */
+    uint32_t d_numArgs;
+  };
+  typedef context::CDHashMap<Node, uint32_t, NodeHashFunction> NodeStepMap;
+  typedef context::CDHashMap<Node, ProofGenerator*, NodeHashFunction>
+      NodeProofGeneratorMap;
+  typedef std::
+      unordered_map<Node, std::shared_ptr<ProofNode>, NodeHashFunction>
+          NodeProofNodeMap;
+  /**
+   * Get the step concluding fact, or nullptr if none exists. This method is
+   * robust to symmetry of (dis)equality, in which case isSym is set to true
+   * and the step concludes the symmetric form of fact.
+   */
+  const Step* getStepFor(Node fact, bool& isSym) const;
+  /** Same as above, for generators */
+  ProofGenerator* getGeneratorFor(Node fact, bool& isSym) const;
+  /**
+   * Make the proof node for fact, where the proofs of its premises are
+   * looked up in built.
+   */
+  std::shared_ptr<ProofNode> mkProof(Node fact, const NodeProofNodeMap& built);
+  /**
+   * Get the proof of fact in built, or an assumption if fact is not in built,
+   * which is the case for a fact whose proof is being built by mkProof.
+   */
+  std::shared_ptr<ProofNode> getBuilt(Node fact, const NodeProofNodeMap& built);
+  /** The proof manager, used for allocating new ProofNode objects */
+  ProofNodeManager* d_manager;
+  /** A dummy context used by this class if none is provided */
+  context::Context d_context;
+  /** The steps */
+  context::CDList<Step> d_steps;
+  /** The children and arguments of the steps */
+  context::CDList<Node> d_stepNodes;
+  /** Maps facts to the index of the step concluding them in d_steps */
+  NodeStepMap d_stepIndex;
+  /** Maps facts that can be proven to generators */
+  NodeProofGeneratorMap d_gens;
+  /** Name identifier */
+  std::string d_name;
+};
+
+}  // namespace cvc5
+
+#endif /* CVC4__EXPR__COMPACT_PROOF_H */
@@ -859,6 +859,18 @@ const DTypeConstructor& DType::operator[](size_t index) const
   return *d_constructors[index];
 }
 
+DTypeEnumerationCache* DType::getEnumerationCache(TypeNode t) const
+{
+  std::map<TypeNode, std::shared_ptr<DTypeEnumerationCache>>::const_iterator
+      it = d_enumCache.find(t);
+  return it == d_enumCache.end() ? nullptr : it->second.get();
+}
+
+void DType::setEnumerationCache(TypeNode t, DTypeEnumerationCache* c) const
+{
+  d_enumCache[t].reset(c);
+}
+
 Node DType::getSharedSelector(TypeNode dtt, TypeNode t, size_t index) const
 {
   Assert(isResolved());
@@ -18,6 +18,7 @@
 #define CVC4__EXPR__DTYPE_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "expr/attribute.h"
@@ -76,6 +77,16 @@ typedef expr::Attribute<DTypeUFiniteComputedTag, bool> DTypeUFiniteComputedAttr;
 
 class DTypeConstructor;
 
+/**
+ * The base class of the caches that the enumerators of the values of
+ * datatypes store in their datatype, see DType::getEnumerationCache.
+ */
+class DTypeEnumerationCache
+{
+ public:
+  virtual ~DTypeEnumerationCache() {}
+};
+
 /**
  * The Node-level representation of an inductive datatype, which currently
  * resides within the Expr-level Datatype class (expr/datatype.h).
@@ -447,6 +458,16 @@ class DType
   const std::vector<std::shared_ptr<DTypeConstructor> >& getConstructors()
       const;
 
+  /**
+   * Get the cache of the enumeration of the values of t, which is an
+   * instance of this datatype, or nullptr if none was set. The cache is
+   * stored in this datatype so that it is shared by all enumerators of t,
+   * and lives as long as the datatype.
+   */
+  DTypeEnumerationCache* getEnumerationCache(TypeNode t) const;
+  /** Set the cache of the enumeration of t to c, which this takes over */
+  void setEnumerationCache(TypeNode t, DTypeEnumerationCache* c) const;
+
   /** prints this datatype to stream */
   void toStream(std::ostream& out) const;
 
@@ -639,6 +660,9 @@ class DType
   /** cache of shared selectors for this datatype */
   mutable std::map<TypeNode, std::map<TypeNode, std::map<unsigned, Node> > >
       d_sharedSel;
+  /** the caches of the enumerations of the instances of this datatype */
+  mutable std::map<TypeNode, std::shared_ptr<DTypeEnumerationCache>>
+      d_enumCache;
 }; /* class DType */
 
 /**
@@ -266,6 +266,19 @@ public:
    */
   NodeTemplate(const NodeTemplate& node);
 
+  /**
+   * Move constructor, which takes over the reference of node without changing
+   * the reference count. If ref_count is true, node becomes the null node.
+   * @param node the node to move
+   */
+  NodeTemplate(NodeTemplate&& node) noexcept : d_nv(node.d_nv)
+  {
+    if (ref_count)
+    {
+      node.d_nv = &expr::NodeValue::null();
+    }
+  }
+
   /**
    * Assignment operator for nodes, copies the relevant information from node
    * to this node.
@@ -274,6 +287,25 @@ public:
    */
   NodeTemplate& operator=(const NodeTemplate& node);
 
+  /**
+   * Move assignment operator, which exchanges the node values of this node and
+   * node if ref_count is true, so that no reference count changes here.
+   * @param node the node to move
+   * @return reference to this node
+   */
+  NodeTemplate& operator=(NodeTemplate&& node) noexcept
+  {
+    if (ref_count)
+    {
+      std::swap(d_nv, node.d_nv);
+    }
+    else
+    {
+      d_nv = node.d_nv;
+    }
+    return *this;
+  }
+
   /**
    * Assignment operator for nodes, copies the relevant information from node
    * to this node.
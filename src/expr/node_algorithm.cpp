@@ -23,12 +23,176 @@
 namespace cvc5 {
 namespace expr {
 
+struct NodeSummaryTag
+{
+};
+/**
+ * The summary of the structure of a node (see getSummary). Since it is
+ * computed for all subterms of the nodes that are queried, it is stored in
+ * a dense table.
+ */
+typedef expr::DenseAttribute<NodeSummaryTag, uint64_t> NodeSummaryAttr;
+
+namespace {
+
+/** The number of bits of the kind signature of a summary */
+const uint64_t s_kindSigBits = 24;
+/** The number of bits of the leaf signature of a summary */
+const uint64_t s_leafSigBits = 24;
+/** The mask of the kind signature of a summary */
+const uint64_t s_kindSigMask = (uint64_t(1) << s_kindSigBits) - 1;
+/** The mask of the leaf signature of a summary */
+const uint64_t s_leafSigMask = ((uint64_t(1) << s_leafSigBits) - 1)
+                               << s_kindSigBits;
+/** The position of the depth in a summary */
+const uint64_t s_depthShift = s_kindSigBits + s_leafSigBits;
+/** The maximal depth of a summary, larger depths are saturated */
+const uint64_t s_maxDepth = (uint64_t(1) << 14) - 1;
+/** The bit of a summary that is set if the node has a bound variable */
+const uint64_t s_hasBoundVarBit = uint64_t(1) << 62;
+/** The bit of a summary that is set if the node has a skolem */
+const uint64_t s_hasSkolemBit = uint64_t(1) << 63;
+
+/** The bit of the kind signature for kind k */
+uint64_t getKindSignature(Kind k)
+{
+  return uint64_t(1) << (static_cast<uint64_t>(k) % s_kindSigBits);
+}
+
+/** The depth stored in summary s */
+uint64_t getDepth(uint64_t s) { return (s >> s_depthShift) & s_maxDepth; }
+
+/**
+ * Get the summary of the structure of n, which is computed once for each
+ * node. It consists of:
+ * - a signature of the kinds of the subterms of n, in which the bit of the
+ *   kind of each subterm is set,
+ * - a signature of the leaves of n, in which a bit chosen by the id of each
+ *   subterm without children is set,
+ * - the depth of n, which is 0 for terms without children,
+ * - whether n has a bound variable and whether n has a skolem.
+ * The subterms include the operators of parameterized nodes. Since the
+ * signatures and the depth of a subterm of n are included in those of n, the
+ * summaries allow to rule out that a term is a subterm of n without
+ * traversing n.
+ */
+uint64_t getSummary(TNode n)
+{
+  uint64_t s;
+  if (n.getAttribute(NodeSummaryAttr(), s))
+  {
+    return s;
+  }
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    if (cur.hasAttribute(NodeSummaryAttr()))
+    {
+      visit.pop_back();
+      continue;
+    }
+    bool hasOp = cur.getMetaKind() == kind::metakind::PARAMETERIZED;
+    // the children without a summary, which are processed first
+    size_t nvisit = visit.size();
+    if (hasOp && !cur.getOperator().hasAttribute(NodeSummaryAttr()))
+    {
+      visit.push_back(cur.getOperator());
+    }
+    for (const TNode& cn : cur)
+    {
+      if (!cn.hasAttribute(NodeSummaryAttr()))
+      {
+        visit.push_back(cn);
+      }
+    }
+    if (visit.size() > nvisit)
+    {
+      continue;
+    }
+    visit.pop_back();
+    Kind k = cur.getKind();
+    s = getKindSignature(k);
+    if (k == kind::BOUND_VARIABLE)
+    {
+      s |= s_hasBoundVarBit;
+    }
+    else if (k == kind::SKOLEM)
+    {
+      s |= s_hasSkolemBit;
+    }
+    if (cur.getNumChildren() == 0 && !hasOp)
+    {
+      uint64_t h = cur.getId() * 0x9e3779b97f4a7c15ull;
+      s |= uint64_t(1) << (s_kindSigBits + (h >> 32) % s_leafSigBits);
+    }
+    else
+    {
+      uint64_t depth = 0;
+      for (size_t i = 0, nchild = cur.getNumChildren(); i <= nchild; i++)
+      {
+        uint64_t cs;
+        if (i < nchild)
+        {
+          cs = cur[i].getAttribute(NodeSummaryAttr());
+        }
+        else if (hasOp)
+        {
+          cs = cur.getOperator().getAttribute(NodeSummaryAttr());
+        }
+        else
+        {
+          break;
+        }
+        // the signatures and the flags are unions, the depth a maximum
+        s |= cs & ~(s_maxDepth << s_depthShift);
+        depth = std::max(depth, getDepth(cs));
+      }
+      s |= std::min(depth + 1, s_maxDepth) << s_depthShift;
+    }
+    cur.setAttribute(NodeSummaryAttr(), s);
+  } while (!visit.empty());
+  return n.getAttribute(NodeSummaryAttr());
+}
+
+/**
+ * Returns false if the summaries sn and st of n and t show that t is not a
+ * proper subterm of n, i.e. a subterm of n that is not n itself.
+ */
+bool maybeProperSubterm(uint64_t sn, uint64_t st)
+{
+  uint64_t sigMask = s_kindSigMask | s_leafSigMask;
+  if ((st & ~sn & sigMask) != 0)
+  {
+    return false;
+  }
+  // a proper subterm is less deep, unless the depth of n is saturated
+  uint64_t dn = getDepth(sn);
+  return dn == s_maxDepth || getDepth(st) < dn;
+}
+
+}  // namespace
+
 bool hasSubterm(TNode n, TNode t, bool strict)
 {
   if (!strict && n == t)
   {
     return true;
   }
+  // The operators of non-parameterized nodes, which are of kind BUILTIN, are
+  // not included in the summaries.
+  bool useSummary = !n.isNull() && !t.isNull() && t.getKind() != kind::BUILTIN;
+  uint64_t st = 0;
+  if (useSummary)
+  {
+    st = getSummary(t);
+    if (n == t || !maybeProperSubterm(getSummary(n), st))
+    {
+      return false;
+    }
+  }
 
   std::unordered_set<TNode, TNodeHashFunction> visited;
   std::vector<TNode> toProcess;
@@ -66,7 +230,11 @@ bool hasSubterm(TNode n, TNode t, bool strict)
       else
       {
         visited.insert(child);
-        toProcess.push_back(child);
+        // skip the children that cannot contain t
+        if (!useSummary || maybeProperSubterm(getSummary(child), st))
+        {
+          toProcess.push_back(child);
+        }
       }
     }
   }
@@ -131,6 +299,11 @@ bool hasSubtermMulti(TNode n, TNode t)
 
 bool hasSubtermKind(Kind k, Node n)
 {
+  uint64_t ksig = getKindSignature(k);
+  if ((getSummary(n) & ksig) == 0)
+  {
+    return false;
+  }
   std::unordered_set<TNode, TNodeHashFunction> visited;
   std::vector<TNode> visit;
   TNode cur;
@@ -148,7 +321,10 @@ bool hasSubtermKind(Kind k, Node n)
       }
       for (const Node& cn : cur)
       {
-        visit.push_back(cn);
+        if ((getSummary(cn) & ksig) != 0)
+        {
+          visit.push_back(cn);
+        }
       }
     }
   } while (!visit.empty());
@@ -162,6 +338,15 @@ bool hasSubtermKinds(const std::unordered_set<Kind, kind::KindHashFunction>& ks,
   {
     return false;
   }
+  uint64_t ksig = 0;
+  for (Kind k : ks)
+  {
+    ksig |= getKindSignature(k);
+  }
+  if ((getSummary(n) & ksig) == 0)
+  {
+    return false;
+  }
   std::unordered_set<TNode, TNodeHashFunction> visited;
   std::vector<TNode> visit;
   TNode cur;
@@ -193,6 +378,24 @@ bool hasSubterm(TNode n, const std::vector<Node>& t, bool strict)
   {
     return true;
   }
+  if (!n.isNull())
+  {
+    uint64_t sn = getSummary(n);
+    bool maybe = false;
+    for (const Node& tt : t)
+    {
+      if (tt.isNull() || tt.getKind() == kind::BUILTIN
+          || (tt != n && maybeProperSubterm(sn, getSummary(tt))))
+      {
+        maybe = true;
+        break;
+      }
+    }
+    if (!maybe)
+    {
+      return false;
+    }
+  }
 
   std::unordered_set<TNode, TNodeHashFunction> visited;
   std::vector<TNode> toProcess;
@@ -238,51 +441,18 @@ bool hasSubterm(TNode n, const std::vector<Node>& t, bool strict)
   return false;
 }
 
-struct HasBoundVarTag
-{
-};
-struct HasBoundVarComputedTag
-{
-};
-/** Attribute true for expressions with bound variables in them */
-typedef expr::Attribute<HasBoundVarTag, bool> HasBoundVarAttr;
-typedef expr::Attribute<HasBoundVarComputedTag, bool> HasBoundVarComputedAttr;
+bool hasBoundVar(TNode n) { return (getSummary(n) & s_hasBoundVarBit) != 0; }
 
-bool hasBoundVar(TNode n)
-{
-  if (!n.getAttribute(HasBoundVarComputedAttr()))
-  {
-    bool hasBv = false;
-    if (n.getKind() == kind::BOUND_VARIABLE)
-    {
-      hasBv = true;
-    }
-    else
-    {
-      for (auto i = n.begin(); i != n.end() && !hasBv; ++i)
-      {
-        if (hasBoundVar(*i))
-        {
-          hasBv = true;
-          break;
-        }
-      }
-    }
-    if (!hasBv && n.hasOperator())
-    {
-      hasBv = hasBoundVar(n.getOperator());
-    }
-    n.setAttribute(HasBoundVarAttr(), hasBv);
-    n.setAttribute(HasBoundVarComputedAttr(), true);
-    Debug("bva") << n << " has bva : " << n.getAttribute(HasBoundVarAttr())
-                 << std::endl;
-    return hasBv;
-  }
-  return n.getAttribute(HasBoundVarAttr());
-}
+bool hasSkolem(TNode n) { return (getSummary(n) & s_hasSkolemBit) != 0; }
+
+uint64_t getDagDepth(TNode n) { return getDepth(getSummary(n)); }
 
 bool hasFreeVar(TNode n)
 {
+  if (!hasBoundVar(n))
+  {
+    return false;
+  }
   std::unordered_set<Node, NodeHashFunction> fvs;
   return getFreeVariables(n, fvs, false);
 }
@@ -76,6 +76,22 @@ bool hasSubterm(TNode n, const std::vector<Node>& t, bool strict = false);
  */
 bool hasBoundVar(TNode n);
 
+/**
+ * Returns true iff the node n contains a skolem, that is a node of kind
+ * SKOLEM.
+ * @param n The node under investigation
+ * @return true iff this node contains a skolem
+ */
+bool hasSkolem(TNode n);
+
+/**
+ * Get the depth of the DAG of n, which is 0 if n has no children, and one
+ * more than the maximal depth of its children (including the operator of
+ * parameterized nodes) otherwise. Depths larger than 16383 are returned as
+ * 16383.
+ */
+uint64_t getDagDepth(TNode n);
+
 /**
  * Returns true iff the node n contains a free variable, that is, a node
  * of kind BOUND_VARIABLE that is not bound in n.
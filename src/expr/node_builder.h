@@ -600,6 +600,24 @@ public:
     return append(n);
   }
 
+  /**
+   * Same as above, but takes over the reference of n, which becomes null,
+   * instead of incrementing the reference count of its node value.
+   */
+  NodeBuilder<nchild_thresh>& operator<<(Node&& n)
+  {
+    Assert(!isUsed()) << "NodeBuilder is one-shot only; "
+                         "attempt to access it after conversion";
+    if (__builtin_expect(
+            (d_nv->d_id == 0 && getKind() != kind::UNDEFINED_KIND), false))
+    {
+      Node n2 = operator Node();
+      clear();
+      append(std::move(n2));
+    }
+    return append(std::move(n));
+  }
+
   /**
    * If this Node-under-construction has a Kind set, collapse it and
    * append the given Node as a child.  Otherwise, simply append.
@@ -663,6 +681,26 @@ public:
     return *this;
   }
 
+  /**
+   * Append a child to this Node-under-construction, taking over the
+   * reference of n, which becomes null.
+   */
+  NodeBuilder<nchild_thresh>& append(Node&& n)
+  {
+    Assert(!isUsed()) << "NodeBuilder is one-shot only; "
+                         "attempt to access it after conversion";
+    Assert(!n.isNull()) << "Cannot use NULL Node as a child of a Node";
+    if (n.getKind() == kind::BUILTIN)
+    {
+      return *this << NodeManager::operatorToKind(n);
+    }
+    allocateNvIfNecessaryForAppend();
+    d_nv->d_children[d_nv->d_nchildren++] = n.d_nv;
+    n.d_nv = &expr::NodeValue::null();
+    Assert(d_nv->d_nchildren <= d_nvMaxChildren);
+    return *this;
+  }
+
   /** Append a child to this Node-under-construction. */
   NodeBuilder<nchild_thresh>& append(const TypeNode& typeNode) {
     Assert(!isUsed()) << "NodeBuilder is one-shot only; "
@@ -933,11 +971,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->d_nvAllocator.allocate(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
@@ -1011,12 +1045,8 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->d_nvAllocator.allocate(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
@@ -1071,8 +1101,27 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() {
        * it had is placed into the NodeManager's pool and returned in
        * a Node wrapper. */
 
-      crop();
-      expr::NodeValue* nv = d_nv;
+      expr::NodeValue* nv;
+      if (d_nv->d_nchildren
+          <= expr::NodeValueAllocator::s_maxSlabChildren)
+      {
+        // Small node values must come from the allocator of the
+        // NodeManager, which deallocates them. This only happens for
+        // NodeBuilders with a small nchild_thresh.
+        nv = d_nm->d_nvAllocator.allocate(d_nv->d_nchildren);
+        nv->d_nchildren = d_nv->d_nchildren;
+        nv->d_kind = d_nv->d_kind;
+        nv->d_rc = 0;
+        std::copy(d_nv->d_children,
+                  d_nv->d_children + d_nv->d_nchildren,
+                  nv->d_children);
+        free(d_nv);
+      }
+      else
+      {
+        crop();
+        nv = d_nv;
+      }
       nv->d_id = d_nm->next_id++;// FIXME multithreading
       d_nv = &d_inlineNv;
       d_nvMaxChildren = nchild_thresh;
@@ -1113,11 +1162,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv = (expr::NodeValue*)
-      std::malloc(sizeof(expr::NodeValue));
-    if(nv == NULL) {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->d_nvAllocator.allocate(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
@@ -1188,12 +1233,8 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->d_nvAllocator.allocate(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
@@ -1242,12 +1283,7 @@ expr::NodeValue* NodeBuilder<nchild_thresh>::constructNV() const {
        * decremented to match at NodeBuilder destruction time. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)
-        std::malloc(sizeof(expr::NodeValue) +
-                    ( sizeof(expr::NodeValue*) * d_nv->d_nchildren ));
-      if(nv == NULL) {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv = d_nm->d_nvAllocator.allocate(d_nv->d_nchildren);
       nv->d_nchildren = d_nv->d_nchildren;
       nv->d_kind = d_nv->d_kind;
       nv->d_id = d_nm->next_id++;// FIXME multithreading
@@ -0,0 +1,710 @@
+/*********************                                                        */
+/*! \file node_dag_io.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of a binary format for storing and loading DAGs of
+ ** nodes
+ **/
+
+#include "expr/node_dag_io.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* ! _WIN32 */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+
+#include "base/check.h"
+#include "base/exception.h"
+#include "base/output.h"
+#include "expr/node_manager_attributes.h"
+#include "expr/uninterpreted_constant.h"
+#include "util/bitvector.h"
+#include "util/floatingpoint_size.h"
+#include "util/rational.h"
+#include "util/roundingmode.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+namespace {
+
+/** The magic number at the start of the header */
+const char s_magic[] = "CVC4DAG1";
+/** The number of words of the header */
+const size_t s_headerWords = 7;
+/** The name index of variables that have no name */
+const uint32_t s_noName = static_cast<uint32_t>(-1);
+
+/** Return true if s is a decimal numeral, possibly negative */
+bool isNumeral(const std::string& s, bool allowNegative)
+{
+  size_t start = allowNegative && !s.empty() && s[0] == '-' ? 1 : 0;
+  if (start == s.size())
+  {
+    return false;
+  }
+  for (size_t i = start, size = s.size(); i < size; i++)
+  {
+    if (s[i] < '0' || s[i] > '9')
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if s is written as Rational::toString() does, i.e., as an
+ * integer or as a fraction with a non-zero denominator.
+ */
+bool isRationalString(const std::string& s)
+{
+  size_t slash = s.find('/');
+  if (slash == std::string::npos)
+  {
+    return isNumeral(s, true);
+  }
+  std::string den = s.substr(slash + 1);
+  return isNumeral(s.substr(0, slash), true) && isNumeral(den, false)
+         && den.find_first_not_of('0') != std::string::npos;
+}
+
+/** Return true if rm is the value of a rounding mode */
+bool isRoundingMode(uint32_t rm)
+{
+  switch (rm)
+  {
+    case ROUND_NEAREST_TIES_TO_EVEN:
+    case ROUND_TOWARD_POSITIVE:
+    case ROUND_TOWARD_NEGATIVE:
+    case ROUND_TOWARD_ZERO:
+    case ROUND_NEAREST_TIES_TO_AWAY: return true;
+    default: return false;
+  }
+}
+
+/** Return true if k is a kind with the given number of children */
+bool isValidArity(Kind k, size_t nchildren)
+{
+  return nchildren >= kind::metakind::getMinArityForKind(k)
+         && nchildren <= kind::metakind::getMaxArityForKind(k);
+}
+
+}  // namespace
+
+void NodeDagWriter::write(std::ostream& out, const std::vector<Node>& roots)
+{
+  d_strings.clear();
+  d_stringIndex.clear();
+  d_types.clear();
+  d_typeIndex.clear();
+  d_nodes.clear();
+  d_nodeIndex.clear();
+  std::unordered_map<TNode, bool, TNodeHashFunction> visited;
+  std::unordered_map<TNode, bool, TNodeHashFunction>::iterator it;
+  std::vector<TNode> visit(roots.begin(), roots.end());
+  TNode cur;
+  while (!visit.empty())
+  {
+    cur = visit.back();
+    visit.pop_back();
+    it = visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = false;
+      visit.push_back(cur);
+      if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        visit.push_back(cur.getOperator());
+      }
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else if (!it->second)
+    {
+      it->second = true;
+      addNode(cur);
+    }
+  }
+  std::vector<uint32_t> buf(s_headerWords);
+  std::memcpy(buf.data(), s_magic, 8);
+  buf[2] = static_cast<uint32_t>(kind::LAST_KIND);
+  buf[3] = d_strings.size();
+  buf[4] = d_typeIndex.size();
+  buf[5] = d_nodeIndex.size();
+  buf[6] = roots.size();
+  for (const std::string& s : d_strings)
+  {
+    buf.push_back(s.size());
+    size_t start = buf.size();
+    buf.resize(start + (s.size() + 3) / 4, 0);
+    std::memcpy(buf.data() + start, s.data(), s.size());
+  }
+  buf.insert(buf.end(), d_types.begin(), d_types.end());
+  buf.insert(buf.end(), d_nodes.begin(), d_nodes.end());
+  for (const Node& r : roots)
+  {
+    buf.push_back(d_nodeIndex[r]);
+  }
+  Trace("node-dag-io") << "Write " << d_nodeIndex.size() << " nodes, "
+                       << d_typeIndex.size() << " types and "
+                       << d_strings.size() << " strings" << std::endl;
+  out.write(reinterpret_cast<const char*>(buf.data()),
+            buf.size() * sizeof(uint32_t));
+}
+
+void NodeDagWriter::writeFile(const std::string& filename,
+                              const std::vector<Node>& roots)
+{
+  std::ofstream out(filename, std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    throw Exception("Couldn't open file for writing: " + filename);
+  }
+  write(out, roots);
+  if (!out)
+  {
+    throw Exception("Couldn't write file: " + filename);
+  }
+}
+
+uint32_t NodeDagWriter::mkString(const std::string& s)
+{
+  std::unordered_map<std::string, uint32_t>::iterator it =
+      d_stringIndex.find(s);
+  if (it != d_stringIndex.end())
+  {
+    return it->second;
+  }
+  uint32_t index = d_strings.size();
+  d_strings.push_back(s);
+  d_stringIndex[s] = index;
+  return index;
+}
+
+uint32_t NodeDagWriter::mkType(TypeNode tn)
+{
+  std::unordered_map<TypeNode, uint32_t, TypeNodeHashFunction>::iterator it =
+      d_typeIndex.find(tn);
+  if (it != d_typeIndex.end())
+  {
+    return it->second;
+  }
+  std::vector<uint32_t> args;
+  Kind k = tn.getKind();
+  if (k == kind::TYPE_CONSTANT)
+  {
+    args.push_back(tn.getConst<TypeConstant>());
+  }
+  else if (k == kind::BITVECTOR_TYPE)
+  {
+    args.push_back(tn.getBitVectorSize());
+  }
+  else if (k == kind::FLOATINGPOINT_TYPE)
+  {
+    args.push_back(tn.getFloatingPointExponentSize());
+    args.push_back(tn.getFloatingPointSignificandSize());
+  }
+  else if (tn.isSort() && tn.getNumChildren() == 0)
+  {
+    args.push_back(mkString(tn.getAttribute(expr::VarNameAttr())));
+  }
+  else if (tn.getMetaKind() == kind::metakind::OPERATOR
+           && tn.getNumChildren() > 0)
+  {
+    for (unsigned i = 0, nchildren = tn.getNumChildren(); i < nchildren; i++)
+    {
+      args.push_back(mkType(tn[i]));
+    }
+  }
+  else
+  {
+    throw Exception("Cannot write the type " + tn.toString()
+                    + " in the binary DAG format");
+  }
+  uint32_t index = d_typeIndex.size();
+  d_typeIndex[tn] = index;
+  d_types.push_back(static_cast<uint32_t>(k));
+  d_types.push_back(args.size());
+  d_types.insert(d_types.end(), args.begin(), args.end());
+  return index;
+}
+
+void NodeDagWriter::addNode(TNode n)
+{
+  d_args.clear();
+  Kind k = n.getKind();
+  switch (n.getMetaKind())
+  {
+    case kind::metakind::VARIABLE:
+    {
+      if (k != kind::VARIABLE && k != kind::BOUND_VARIABLE
+          && k != kind::SKOLEM)
+      {
+        throw Exception("Cannot write the variable " + n.toString()
+                        + " of kind " + kind::kindToString(k)
+                        + " in the binary DAG format");
+      }
+      d_args.push_back(mkType(n.getType()));
+      std::string name;
+      d_args.push_back(n.getAttribute(expr::VarNameAttr(), name)
+                           ? mkString(name)
+                           : s_noName);
+      break;
+    }
+    case kind::metakind::CONSTANT: addConstArgs(n); break;
+    case kind::metakind::NULLARY_OPERATOR:
+      d_args.push_back(mkType(n.getType()));
+      break;
+    case kind::metakind::PARAMETERIZED:
+      d_args.push_back(d_nodeIndex[n.getOperator()]);
+      CVC4_FALLTHROUGH;
+    default:
+      for (TNode c : n)
+      {
+        d_args.push_back(d_nodeIndex[c]);
+      }
+      break;
+  }
+  uint32_t index = d_nodeIndex.size();
+  d_nodeIndex[n] = index;
+  d_nodes.push_back(static_cast<uint32_t>(k));
+  d_nodes.push_back(d_args.size());
+  d_nodes.insert(d_nodes.end(), d_args.begin(), d_args.end());
+}
+
+void NodeDagWriter::addConstArgs(TNode n)
+{
+  Kind k = n.getKind();
+  switch (k)
+  {
+    case kind::CONST_BOOLEAN: d_args.push_back(n.getConst<bool>()); break;
+    case kind::CONST_RATIONAL:
+      d_args.push_back(mkString(n.getConst<Rational>().toString()));
+      break;
+    case kind::CONST_BITVECTOR:
+    {
+      const BitVector& bv = n.getConst<BitVector>();
+      d_args.push_back(bv.getSize());
+      d_args.push_back(mkString(bv.getValue().toString()));
+      break;
+    }
+    case kind::CONST_STRING:
+    {
+      const std::vector<unsigned>& vec = n.getConst<String>().getVec();
+      d_args.insert(d_args.end(), vec.begin(), vec.end());
+      break;
+    }
+    case kind::CONST_ROUNDINGMODE:
+      d_args.push_back(n.getConst<RoundingMode>());
+      break;
+    case kind::UNINTERPRETED_CONSTANT:
+    {
+      const UninterpretedConstant& uc = n.getConst<UninterpretedConstant>();
+      d_args.push_back(mkType(uc.getType()));
+      d_args.push_back(mkString(uc.getIndex().toString()));
+      break;
+    }
+    case kind::BUILTIN: d_args.push_back(n.getConst<Kind>()); break;
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      const BitVectorExtract& e = n.getConst<BitVectorExtract>();
+      d_args.push_back(e.d_high);
+      d_args.push_back(e.d_low);
+      break;
+    }
+    case kind::BITVECTOR_BITOF_OP:
+      d_args.push_back(n.getConst<BitVectorBitOf>().d_bitIndex);
+      break;
+    case kind::BITVECTOR_REPEAT_OP:
+      d_args.push_back(n.getConst<BitVectorRepeat>().d_repeatAmount);
+      break;
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      d_args.push_back(n.getConst<BitVectorZeroExtend>().d_zeroExtendAmount);
+      break;
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      d_args.push_back(n.getConst<BitVectorSignExtend>().d_signExtendAmount);
+      break;
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      d_args.push_back(n.getConst<BitVectorRotateLeft>().d_rotateLeftAmount);
+      break;
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      d_args.push_back(
+          n.getConst<BitVectorRotateRight>().d_rotateRightAmount);
+      break;
+    case kind::INT_TO_BITVECTOR_OP:
+      d_args.push_back(n.getConst<IntToBitVector>().d_size);
+      break;
+    default:
+      throw Exception("Cannot write the constant " + n.toString() + " of kind "
+                      + kind::kindToString(k) + " in the binary DAG format");
+  }
+}
+
+void NodeDagReader::bind(TNode v)
+{
+  Assert(v.isVar());
+  d_vars[v.getAttribute(expr::VarNameAttr())] = v;
+}
+
+void NodeDagReader::bind(TypeNode s)
+{
+  Assert(s.isSort());
+  d_sorts[s.getAttribute(expr::VarNameAttr())] = s;
+}
+
+void NodeDagReader::read(const char* data,
+                         size_t size,
+                         std::vector<Node>& roots)
+{
+  size_t nwords = size / sizeof(uint32_t);
+  size_t pos = 0;
+  // reads the next word, which the buffer may not be aligned for
+  auto word = [&]() {
+    if (pos >= nwords)
+    {
+      throw Exception("Truncated input in the binary DAG format");
+    }
+    uint32_t w;
+    std::memcpy(&w, data + pos * sizeof(uint32_t), sizeof(uint32_t));
+    pos++;
+    return w;
+  };
+  if (nwords < s_headerWords || std::memcmp(data, s_magic, 8) != 0)
+  {
+    throw Exception("Input is not in the binary DAG format");
+  }
+  pos = 2;
+  if (word() != static_cast<uint32_t>(kind::LAST_KIND))
+  {
+    throw Exception("Input in the binary DAG format was written by a build "
+                    "with other kinds");
+  }
+  uint32_t nstrings = word();
+  uint32_t ntypes = word();
+  uint32_t nnodes = word();
+  uint32_t nroots = word();
+  // each string takes at least one word and each record at least two
+  if (nstrings + 2 * (static_cast<size_t>(ntypes) + nnodes) + nroots
+      > nwords - pos)
+  {
+    throw Exception("Truncated input in the binary DAG format");
+  }
+  std::vector<std::string> strings;
+  strings.reserve(nstrings);
+  for (uint32_t i = 0; i < nstrings; i++)
+  {
+    uint32_t len = word();
+    size_t lenWords = (static_cast<size_t>(len) + 3) / 4;
+    if (lenWords > nwords - pos)
+    {
+      throw Exception("Truncated input in the binary DAG format");
+    }
+    strings.emplace_back(data + pos * sizeof(uint32_t), len);
+    pos += lenWords;
+  }
+  std::vector<uint32_t> args;
+  // reads the arguments of the next record, returning its kind
+  auto record = [&]() {
+    uint32_t k = word();
+    if (k >= static_cast<uint32_t>(kind::LAST_KIND))
+    {
+      throw Exception("Invalid kind in the binary DAG format");
+    }
+    uint32_t nargs = word();
+    args.clear();
+    for (uint32_t j = 0; j < nargs; j++)
+    {
+      args.push_back(word());
+    }
+    return static_cast<Kind>(k);
+  };
+  auto checkArgs = [&](bool valid) {
+    if (!valid)
+    {
+      throw Exception("Invalid record in the binary DAG format");
+    }
+  };
+  auto getString = [&](uint32_t j) -> const std::string& {
+    checkArgs(j < strings.size());
+    return strings[j];
+  };
+  auto getInteger = [&](uint32_t j, bool allowNegative) {
+    const std::string& s = getString(j);
+    checkArgs(isNumeral(s, allowNegative));
+    return Integer(s);
+  };
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<TypeNode> types;
+  types.reserve(ntypes);
+  auto getType = [&](uint32_t j) {
+    checkArgs(j < types.size());
+    return types[j];
+  };
+  for (uint32_t i = 0; i < ntypes; i++)
+  {
+    Kind k = record();
+    switch (k)
+    {
+      case kind::TYPE_CONSTANT:
+        checkArgs(args.size() == 1 && args[0] < LAST_TYPE);
+        types.push_back(nm->mkTypeConst(static_cast<TypeConstant>(args[0])));
+        break;
+      case kind::BITVECTOR_TYPE:
+        checkArgs(args.size() == 1 && args[0] > 0);
+        types.push_back(nm->mkBitVectorType(args[0]));
+        break;
+      case kind::FLOATINGPOINT_TYPE:
+        checkArgs(args.size() == 2 && validExponentSize(args[0])
+                  && validSignificandSize(args[1]));
+        types.push_back(nm->mkFloatingPointType(args[0], args[1]));
+        break;
+      case kind::SORT_TYPE:
+      {
+        checkArgs(args.size() == 1);
+        const std::string& name = getString(args[0]);
+        std::unordered_map<std::string, TypeNode>::iterator it =
+            d_sorts.find(name);
+        types.push_back(it != d_sorts.end() ? it->second : nm->mkSort(name));
+        break;
+      }
+      default:
+      {
+        checkArgs(kind::metaKindOf(k) == kind::metakind::OPERATOR
+                  && !args.empty() && isValidArity(k, args.size()));
+        std::vector<TypeNode> children;
+        for (uint32_t j : args)
+        {
+          children.push_back(getType(j));
+        }
+        types.push_back(nm->mkTypeNode(k, children));
+        break;
+      }
+    }
+  }
+  std::vector<Node> nodes;
+  nodes.reserve(nnodes);
+  auto getNode = [&](uint32_t j) {
+    checkArgs(j < nodes.size());
+    return nodes[j];
+  };
+  for (uint32_t i = 0; i < nnodes; i++)
+  {
+    Kind k = record();
+    switch (kind::metaKindOf(k))
+    {
+      case kind::metakind::VARIABLE:
+      {
+        checkArgs(args.size() == 2);
+        TypeNode tn = getType(args[0]);
+        bool hasName = args[1] != s_noName;
+        std::string name = hasName ? getString(args[1]) : std::string();
+        if (k == kind::VARIABLE)
+        {
+          std::unordered_map<std::string, Node>::iterator it =
+              d_vars.find(name);
+          if (hasName && it != d_vars.end() && it->second.getType() == tn)
+          {
+            nodes.push_back(it->second);
+          }
+          else
+          {
+            nodes.push_back(hasName ? nm->mkVar(name, tn) : nm->mkVar(tn));
+          }
+        }
+        else if (k == kind::BOUND_VARIABLE)
+        {
+          nodes.push_back(hasName ? nm->mkBoundVar(name, tn)
+                                  : nm->mkBoundVar(tn));
+        }
+        else
+        {
+          checkArgs(k == kind::SKOLEM);
+          nodes.push_back(
+              hasName ? nm->mkSkolem(name,
+                                     tn,
+                                     "a skolem loaded from a binary DAG",
+                                     NodeManager::SKOLEM_EXACT_NAME)
+                      : nm->mkSkolem(
+                          "k", tn, "a skolem loaded from a binary DAG"));
+        }
+        break;
+      }
+      case kind::metakind::CONSTANT:
+        switch (k)
+        {
+          case kind::CONST_BOOLEAN:
+            checkArgs(args.size() == 1);
+            nodes.push_back(nm->mkConst<bool>(args[0] != 0));
+            break;
+          case kind::CONST_RATIONAL:
+            checkArgs(args.size() == 1
+                      && isRationalString(getString(args[0])));
+            nodes.push_back(nm->mkConst(Rational(getString(args[0]))));
+            break;
+          case kind::CONST_BITVECTOR:
+          {
+            checkArgs(args.size() == 2 && args[0] > 0);
+            Integer val = getInteger(args[1], false);
+            checkArgs(val.length() <= args[0]);
+            nodes.push_back(nm->mkConst(BitVector(args[0], val)));
+            break;
+          }
+          case kind::CONST_STRING:
+            for (uint32_t c : args)
+            {
+              checkArgs(c < String::num_codes());
+            }
+            nodes.push_back(nm->mkConst(
+                String(std::vector<unsigned>(args.begin(), args.end()))));
+            break;
+          case kind::CONST_ROUNDINGMODE:
+            checkArgs(args.size() == 1 && isRoundingMode(args[0]));
+            nodes.push_back(nm->mkConst(static_cast<RoundingMode>(args[0])));
+            break;
+          case kind::UNINTERPRETED_CONSTANT:
+            checkArgs(args.size() == 2 && getType(args[0]).isSort());
+            nodes.push_back(nm->mkConst(UninterpretedConstant(
+                getType(args[0]), getInteger(args[1], false))));
+            break;
+          case kind::BUILTIN:
+            checkArgs(args.size() == 1
+                      && args[0] < static_cast<uint32_t>(kind::LAST_KIND));
+            nodes.push_back(nm->operatorOf(static_cast<Kind>(args[0])));
+            break;
+          case kind::BITVECTOR_EXTRACT_OP:
+            checkArgs(args.size() == 2 && args[0] >= args[1]);
+            nodes.push_back(nm->mkConst(BitVectorExtract(args[0], args[1])));
+            break;
+          case kind::BITVECTOR_BITOF_OP:
+            checkArgs(args.size() == 1);
+            nodes.push_back(nm->mkConst(BitVectorBitOf(args[0])));
+            break;
+          case kind::BITVECTOR_REPEAT_OP:
+            checkArgs(args.size() == 1 && args[0] > 0);
+            nodes.push_back(nm->mkConst(BitVectorRepeat(args[0])));
+            break;
+          case kind::BITVECTOR_ZERO_EXTEND_OP:
+            checkArgs(args.size() == 1);
+            nodes.push_back(nm->mkConst(BitVectorZeroExtend(args[0])));
+            break;
+          case kind::BITVECTOR_SIGN_EXTEND_OP:
+            checkArgs(args.size() == 1);
+            nodes.push_back(nm->mkConst(BitVectorSignExtend(args[0])));
+            break;
+          case kind::BITVECTOR_ROTATE_LEFT_OP:
+            checkArgs(args.size() == 1);
+            nodes.push_back(nm->mkConst(BitVectorRotateLeft(args[0])));
+            break;
+          case kind::BITVECTOR_ROTATE_RIGHT_OP:
+            checkArgs(args.size() == 1);
+            nodes.push_back(nm->mkConst(BitVectorRotateRight(args[0])));
+            break;
+          case kind::INT_TO_BITVECTOR_OP:
+            checkArgs(args.size() == 1 && args[0] > 0);
+            nodes.push_back(nm->mkConst(IntToBitVector(args[0])));
+            break;
+          default: checkArgs(false); break;
+        }
+        break;
+      case kind::metakind::NULLARY_OPERATOR:
+        checkArgs(args.size() == 1);
+        nodes.push_back(nm->mkNullaryOperator(getType(args[0]), k));
+        break;
+      case kind::metakind::OPERATOR:
+      case kind::metakind::PARAMETERIZED:
+      {
+        bool isParam =
+            kind::metaKindOf(k) == kind::metakind::PARAMETERIZED;
+        checkArgs(!isParam || !args.empty());
+        checkArgs(isValidArity(k, args.size() - (isParam ? 1 : 0)));
+        NodeBuilder<> nb(k);
+        for (uint32_t j : args)
+        {
+          nb << getNode(j);
+        }
+        nodes.push_back(nb);
+        break;
+      }
+      default: checkArgs(false); break;
+    }
+  }
+  std::vector<Node> newRoots;
+  for (uint32_t i = 0; i < nroots; i++)
+  {
+    newRoots.push_back(getNode(word()));
+  }
+  // type checking a root checks all nodes below it
+  for (const Node& r : newRoots)
+  {
+    try
+    {
+      r.getType(true);
+    }
+    catch (TypeCheckingExceptionPrivate& e)
+    {
+      throw Exception("Ill-typed node in the binary DAG format: "
+                      + e.getMessage());
+    }
+  }
+  roots.insert(roots.end(), newRoots.begin(), newRoots.end());
+  Trace("node-dag-io") << "Read " << nodes.size() << " nodes, "
+                       << types.size() << " types and " << strings.size()
+                       << " strings" << std::endl;
+}
+
+void NodeDagReader::readFile(const std::string& filename,
+                             std::vector<Node>& roots)
+{
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd != -1 && fstat(fd, &st) != -1 && st.st_size > 0)
+  {
+    size_t size = st.st_size;
+    void* map = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map != MAP_FAILED)
+    {
+      try
+      {
+        read(static_cast<const char*>(map), size, roots);
+      }
+      catch (...)
+      {
+        munmap(map, size);
+        throw;
+      }
+      munmap(map, size);
+      return;
+    }
+  }
+  else if (fd != -1)
+  {
+    close(fd);
+  }
+#endif /* ! _WIN32 */
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  if (!in)
+  {
+    throw Exception("Couldn't open file: " + filename);
+  }
+  std::string data((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  read(data.data(), data.size(), roots);
+}
+
+}  // namespace cvc5
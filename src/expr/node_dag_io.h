@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file node_dag_io.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A binary format for storing and loading DAGs of nodes
+ **
+ ** The format consists of a header, a table of strings, a table of types, a
+ ** table of nodes and the list of the roots. All fields are 32-bit words in
+ ** the byte order of the host:
+ **
+ **   header:  "CVC4DAG1", kind::LAST_KIND, #strings, #types, #nodes, #roots
+ **   string:  length, characters (padded to a multiple of 4 bytes)
+ **   type:    kind, #args, args
+ **   node:    kind, #args, args
+ **   root:    node index
+ **
+ ** The nodes are in topological order, i.e. the arguments of a node that refer
+ ** to other nodes are indices of earlier entries of the node table. Types are
+ ** stored in a separate table in the same way. The arguments of a constant
+ ** depend on its kind; large numbers and names are indices in the string
+ ** table. Since the kinds are stored by their number, a file can only be
+ ** loaded by a build with the same kinds, which is checked using the number
+ ** of kinds in the header.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_DAG_IO_H
+#define CVC4__EXPR__NODE_DAG_IO_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace cvc5 {
+
+/**
+ * Writes DAGs of nodes in the binary format of node_dag_io.h. Each node and
+ * each type that is reachable from the roots is written once.
+ *
+ * Variables are written by their kind, type and name. The supported
+ * constants are those of the core theories, arithmetic, bit-vectors, strings
+ * and rounding modes; the types are the builtin types, uninterpreted sorts,
+ * bit-vector and floating-point types, and the types built from them, e.g.
+ * function and array types. Datatypes, sort constructors and the other
+ * constants are not supported, for which an Exception is thrown.
+ */
+class NodeDagWriter
+{
+ public:
+  /** Write the DAG of roots to out */
+  void write(std::ostream& out, const std::vector<Node>& roots);
+  /** Write the DAG of roots to the file with the given name */
+  void writeFile(const std::string& filename, const std::vector<Node>& roots);
+
+ private:
+  /** Get the index of string s, adding it to the table if necessary */
+  uint32_t mkString(const std::string& s);
+  /** Get the index of type tn, adding it and its components if necessary */
+  uint32_t mkType(TypeNode tn);
+  /** Add the node n, whose children are already in the table */
+  void addNode(TNode n);
+  /** Add the arguments of the constant n to d_args */
+  void addConstArgs(TNode n);
+  /** The table of strings */
+  std::vector<std::string> d_strings;
+  /** Maps strings to their index in d_strings */
+  std::unordered_map<std::string, uint32_t> d_stringIndex;
+  /** The records of the types */
+  std::vector<uint32_t> d_types;
+  /** Maps types to their index */
+  std::unordered_map<TypeNode, uint32_t, TypeNodeHashFunction> d_typeIndex;
+  /** The records of the nodes */
+  std::vector<uint32_t> d_nodes;
+  /** Maps nodes to their index */
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> d_nodeIndex;
+  /** The arguments of the current record */
+  std::vector<uint32_t> d_args;
+};
+
+/**
+ * Loads DAGs of nodes written by NodeDagWriter. The nodes are built in the
+ * order of the node table, so that the children of each node are looked up
+ * by index; apart from the bindings below, no text is hashed.
+ *
+ * By default, each variable and each uninterpreted sort of the input is
+ * created fresh. The variables and sorts that already exist, e.g. those
+ * declared by the user, may be bound by name beforehand, in which case the
+ * variables and sorts of the input with that name are mapped to them.
+ * Loading a truncated, malformed or ill-typed input throws an Exception, and
+ * adds no roots.
+ */
+class NodeDagReader
+{
+ public:
+  /** Map the variables of the input named as v to v */
+  void bind(TNode v);
+  /** Map the uninterpreted sorts of the input named as s to s */
+  void bind(TypeNode s);
+  /** Load the DAG in the buffer [data, data + size), adding its roots */
+  void read(const char* data, size_t size, std::vector<Node>& roots);
+  /**
+   * Load the DAG in the file with the given name, which is memory mapped if
+   * possible, adding its roots.
+   */
+  void readFile(const std::string& filename, std::vector<Node>& roots);
+
+ private:
+  /** The variables given to bind, by name */
+  std::unordered_map<std::string, Node> d_vars;
+  /** The sorts given to bind, by name */
+  std::unordered_map<std::string, TypeNode> d_sorts;
+};
+
+}  // namespace cvc5
+
+#endif /* CVC4__EXPR__NODE_DAG_IO_H */
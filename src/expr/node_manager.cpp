@@ -18,9 +18,11 @@
 #include "expr/node_manager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <sstream>
-#include <stack>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "base/check.h"
 #include "base/listener.h"
@@ -33,6 +35,8 @@
 #include "expr/skolem_manager.h"
 #include "expr/type_checker.h"
 #include "util/resource_manager.h"
+#include "util/statistics_registry.h"
+#include "util/stats_histogram.h"
 
 using namespace std;
 using namespace cvc5::expr;
@@ -85,6 +89,35 @@ struct NVReclaim {
 
 } // namespace
 
+/** Statistics about garbage collection of a node manager */
+struct NodeManager::Statistics
+{
+  Statistics(const expr::NodeValuePool& pool);
+
+  /** The number of reclaimed zombies */
+  IntStat d_zombiesReclaimed;
+  /** The number of calls to reclaimZombies() */
+  IntStat d_reclaimCalls;
+  /** The number of calls to reclaimZombies() that ran out of budget */
+  IntStat d_reclaimInterrupted;
+  /**
+   * Histogram of the pause times of reclaimZombies(), where a pause of t
+   * microseconds is counted in bucket floor(log2(t + 1))
+   */
+  IntegralHistogramStat<int64_t> d_pauseLog2Micros;
+  /** The number of node values in the pool */
+  SizeStat<expr::NodeValuePool> d_poolSize;
+};
+
+NodeManager::Statistics::Statistics(const expr::NodeValuePool& pool)
+    : d_zombiesReclaimed("expr::NodeManager::zombiesReclaimed", 0),
+      d_reclaimCalls("expr::NodeManager::reclaimCalls", 0),
+      d_reclaimInterrupted("expr::NodeManager::reclaimInterrupted", 0),
+      d_pauseLog2Micros("expr::NodeManager::reclaimPauseLog2Micros"),
+      d_poolSize("expr::NodeManager::poolSize", pool)
+{
+}
+
 namespace attr {
   struct LambdaBoundVarListTag { };
   }  // namespace attr
@@ -99,6 +132,11 @@ NodeManager::NodeManager()
       d_attrManager(new expr::attr::AttributeManager()),
       d_nodeUnderDeletion(nullptr),
       d_inReclaimZombies(false),
+      d_zombieThreshold(5000),
+      d_zombieTrigger(5000),
+      d_gcSliceBudget(0),
+      d_typeChecking(true),
+      d_statistics(new Statistics(d_nodeValuePool)),
       d_abstractValueCount(0),
       d_skolemCounter(0)
 {
@@ -255,15 +293,10 @@ NodeManager::~NodeManager() {
 
   if(Debug.isOn("gc:leaks")) {
     Debug("gc:leaks") << "still in pool:" << endl;
-    for(NodeValuePool::const_iterator i = d_nodeValuePool.begin(),
-          iend = d_nodeValuePool.end();
-        i != iend;
-        ++i) {
-      Debug("gc:leaks") << "  " << *i
-                        << " id=" << (*i)->d_id
-                        << " rc=" << (*i)->d_rc
-                        << " " << **i << endl;
-    }
+    d_nodeValuePool.forEach([](NodeValue* nv) {
+      Debug("gc:leaks") << "  " << nv << " id=" << nv->d_id
+                        << " rc=" << nv->d_rc << " " << *nv << endl;
+    });
     Debug("gc:leaks") << ":end:" << endl;
   }
 
@@ -280,12 +313,17 @@ const DType& NodeManager::getDTypeForIndex(size_t index) const
   return *d_dtypes[index];
 }
 
-void NodeManager::reclaimZombies() {
+void NodeManager::reclaimZombies(uint64_t budget) {
   // FIXME multithreading
   Assert(!d_attrManager->inGarbageCollection());
 
   Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)!\n";
 
+  using clock = std::chrono::steady_clock;
+  clock::time_point start = clock::now();
+  clock::time_point deadline = start + std::chrono::microseconds(budget);
+  ++d_statistics->d_reclaimCalls;
+
   // during reclamation, reclaimZombies() is never supposed to be called
   Assert(!d_inReclaimZombies)
       << "NodeManager::reclaimZombies() not re-entrant!";
@@ -322,6 +360,23 @@ void NodeManager::reclaimZombies() {
       i != zombies.end();
       ++i) {
     NodeValue* nv = *i;
+    // check the budget only every so often, reading the clock is not free
+    size_t index = i - zombies.begin();
+    if (budget > 0 && index % 64 == 63 && clock::now() >= deadline)
+    {
+      // leave the remaining zombies for the next slice
+      for (; i != zombies.end(); ++i)
+      {
+        if ((*i)->d_rc == 0)
+        {
+          d_zombies.insert(*i);
+        }
+      }
+      ++d_statistics->d_reclaimInterrupted;
+      Debug("gc") << "out of budget, " << d_zombies.size()
+                  << " zombie(s) remaining\n";
+      break;
+    }
 #ifdef _LIBCPP_VERSION
     // Work around an apparent bug in libc++'s hash_set<> which can
     // (very occasionally) have an element repeated.
@@ -380,11 +435,60 @@ void NodeManager::reclaimZombies() {
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
       }
-      free(nv);
+      d_nvAllocator.deallocate(nv);
+      ++d_statistics->d_zombiesReclaimed;
     }
   }
+
+  // With a budget, zombies may remain. Wait for d_zombieThreshold new ones
+  // before the next slice, otherwise every markForDeletion() would start one.
+  d_zombieTrigger = budget == 0 ? d_zombieThreshold
+                                : d_zombies.size() + d_zombieThreshold;
+
+  int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                       clock::now() - start)
+                       .count();
+  int64_t bucket = 0;
+  while ((micros + 1) >> (bucket + 1) != 0)
+  {
+    ++bucket;
+  }
+  d_statistics->d_pauseLog2Micros << bucket;
 }/* NodeManager::reclaimZombies() */
 
+void NodeManager::setGcOptions(size_t zombieThreshold, uint64_t sliceBudget)
+{
+  d_zombieThreshold = zombieThreshold;
+  d_zombieTrigger = zombieThreshold;
+  d_gcSliceBudget = sliceBudget;
+}
+
+void NodeManager::reclaimZombiesSlice()
+{
+  if (d_gcSliceBudget > 0 && !d_zombies.empty() && safeToReclaimZombies())
+  {
+    reclaimZombies(d_gcSliceBudget);
+  }
+}
+
+void NodeManager::registerStatistics(StatisticsRegistry& reg)
+{
+  reg.registerStat(&d_statistics->d_zombiesReclaimed);
+  reg.registerStat(&d_statistics->d_reclaimCalls);
+  reg.registerStat(&d_statistics->d_reclaimInterrupted);
+  reg.registerStat(&d_statistics->d_pauseLog2Micros);
+  reg.registerStat(&d_statistics->d_poolSize);
+}
+
+void NodeManager::unregisterStatistics(StatisticsRegistry& reg)
+{
+  reg.unregisterStat(&d_statistics->d_zombiesReclaimed);
+  reg.unregisterStat(&d_statistics->d_reclaimCalls);
+  reg.unregisterStat(&d_statistics->d_reclaimInterrupted);
+  reg.unregisterStat(&d_statistics->d_pauseLog2Micros);
+  reg.unregisterStat(&d_statistics->d_poolSize);
+}
+
 std::vector<NodeValue*> NodeManager::TopologicalSort(
     const std::vector<NodeValue*>& roots) {
   std::vector<NodeValue*> order;
@@ -441,6 +545,7 @@ TypeNode NodeManager::getType(TNode n, bool check)
   //
   NodeManagerScope nms(this);
 
+  check = check && d_typeChecking;
   TypeNode typeNode;
   bool hasType = getAttribute(n, TypeAttr(), typeNode);
   bool needsCheck = check && !getAttribute(n, TypeCheckedAttr());
@@ -456,34 +561,42 @@ TypeNode NodeManager::getType(TNode n, bool check)
 #endif
   if (needsCheck && doTypeCheck)
   {
-    /* Iterate and compute the children bottom up. This avoids stack
-       overflows in computeType() when the Node graph is really deep,
-       which should only affect us when we're type checking lazily. */
-    stack<TNode> worklist;
-    worklist.push(n);
-
-    while( !worklist.empty() ) {
-      TNode m = worklist.top();
-
-      bool readyToCompute = true;
-
-      for( TNode::iterator it = m.begin(), end = m.end();
-           it != end;
-           ++it ) {
-        if( !hasAttribute(*it, TypeAttr())
-            || (check && !getAttribute(*it, TypeCheckedAttr())) ) {
-          readyToCompute = false;
-          worklist.push(*it);
+    /* Iterate and compute the children bottom up, i.e. in topological
+       order. This avoids stack overflows in computeType() when the Node
+       graph is really deep, which should only affect us when we're type
+       checking lazily, e.g. when the root of a large term is asserted.
+       The subterms that are already type checked are skipped, and each
+       shared subterm is checked once. */
+    std::unordered_map<TNode, bool, TNodeHashFunction> visited;
+    std::unordered_map<TNode, bool, TNodeHashFunction>::iterator itv;
+    std::vector<TNode> visit;
+    TNode m;
+    visit.push_back(n);
+    do
+    {
+      m = visit.back();
+      itv = visited.find(m);
+      if (itv == visited.end())
+      {
+        visited[m] = false;
+        for (TNode mc : m)
+        {
+          if (!getAttribute(mc, TypeCheckedAttr()))
+          {
+            visit.push_back(mc);
+          }
         }
+        // compute the type of m once its children are checked
+        continue;
       }
-
-      if( readyToCompute ) {
-        Assert(check || m.getMetaKind() != kind::metakind::NULLARY_OPERATOR);
+      visit.pop_back();
+      if (!itv->second)
+      {
+        itv->second = true;
         /* All the children have types, time to compute */
         typeNode = TypeChecker::computeType(this, m, check);
-        worklist.pop();
       }
-    } // end while
+    } while (!visit.empty());
 
     /* Last type computed in loop should be the type of n */
     Assert(typeNode == getAttribute(n, TypeAttr()));
@@ -26,14 +26,20 @@
 #ifndef CVC4__NODE_MANAGER_H
 #define CVC4__NODE_MANAGER_H
 
-#include <vector>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "base/check.h"
 #include "expr/kind.h"
 #include "expr/metakind.h"
 #include "expr/node_value.h"
+#include "expr/node_value_allocator.h"
+#include "expr/node_value_pool.h"
 
 namespace cvc5 {
 
@@ -43,6 +49,7 @@ class Solver;
 
 class ResourceManager;
 class SkolemManager;
+class StatisticsRegistry;
 class BoundVarManager;
 
 class DType;
@@ -91,6 +98,8 @@ class NodeManager
   template <unsigned nchild_thresh>
   friend class NodeBuilder;
   friend class NodeManagerScope;
+  // for restoring the variables of a DAG in the binary format
+  friend class NodeDagReader;
 
  public:
   /**
@@ -106,9 +115,6 @@ class NodeManager
     bool operator()(expr::NodeValue* nv) { return nv->d_rc > 0; }
   };
 
-  typedef std::unordered_set<expr::NodeValue*,
-                             expr::NodeValuePoolHashFunction,
-                             expr::NodeValuePoolEq> NodeValuePool;
   typedef std::unordered_set<expr::NodeValue*,
                              expr::NodeValueIDHashFunction,
                              expr::NodeValueIDEquality> NodeValueIDSet;
@@ -120,7 +126,13 @@ class NodeManager
   /** The bound variable manager */
   std::unique_ptr<BoundVarManager> d_bvManager;
 
-  NodeValuePool d_nodeValuePool;
+  /**
+   * The allocator of the node values of this node manager. This must be
+   * declared before the pool, since the pool refers to its memory.
+   */
+  expr::NodeValueAllocator d_nvAllocator;
+
+  expr::NodeValuePool d_nodeValuePool;
 
   size_t next_id;
 
@@ -151,6 +163,30 @@ class NodeManager
    */
   NodeValueIDSet d_zombies;
 
+  /** The number of zombies above which zombies are reclaimed */
+  size_t d_zombieThreshold;
+
+  /**
+   * The number of zombies above which markForDeletion() next reclaims
+   * zombies. After a budgeted reclamation, this is the number of remaining
+   * zombies plus d_zombieThreshold, so that slices are not started on every
+   * new zombie.
+   */
+  size_t d_zombieTrigger;
+
+  /**
+   * The time budget in microseconds of a single zombie reclamation slice, or
+   * zero if zombies are always reclaimed all at once.
+   */
+  uint64_t d_gcSliceBudget;
+
+  /** Whether getType() type checks nodes when asked to */
+  bool d_typeChecking;
+
+  /** Statistics about garbage collection of this node manager */
+  struct Statistics;
+  std::unique_ptr<Statistics> d_statistics;
+
   /**
    * NodeValues with maxed out reference counts. These live as long as the
    * NodeManager. They have a custom deallocation procedure at the very end.
@@ -287,8 +323,8 @@ class NodeManager
     d_zombies.insert(nv);
 
     if(safeToReclaimZombies()) {
-      if(d_zombies.size() > 5000) {
-        reclaimZombies();
+      if(d_zombies.size() > d_zombieTrigger) {
+        reclaimZombies(d_gcSliceBudget);
       }
     }
   }
@@ -307,9 +343,11 @@ class NodeManager
   }
 
   /**
-   * Reclaim all zombies.
+   * Reclaim zombies. If budget is zero, all zombies are reclaimed. Otherwise,
+   * reclamation stops once (about) budget microseconds have passed, and the
+   * remaining zombies are left for a later call.
    */
-  void reclaimZombies();
+  void reclaimZombies(uint64_t budget = 0);
 
   /**
    * It is safe to collect zombies.
@@ -341,6 +379,24 @@ class NodeManager
     expr::NodeValue* child[N];
   };/* struct NodeManager::NVStorage<N> */
 
+  /**
+   * The maximal number of children of the nodes that mkNodeInternal looks up
+   * using a node value on the stack.
+   */
+  static constexpr size_t s_mkNodeStackChildren = 10;
+
+  /**
+   * Make the node of the given kind whose children are op, if op is not null,
+   * followed by the nodes in [begin, end).
+   *
+   * Unlike NodeBuilder, which takes a reference to each child when it is
+   * appended and releases them if the node already exists, this looks up the
+   * node first, so that the reference counts of the children only change if
+   * the node is new. The children must be kept alive by the caller.
+   */
+  template <class Iterator>
+  Node mkNodeInternal(Kind kind, TNode op, Iterator begin, Iterator end);
+
   /* A note on isAtomic() and isAtomicFormula() (in CVC3 parlance)..
    *
    * It has been decided for now to hold off on implementations of
@@ -387,6 +443,31 @@ class NodeManager
   /** Get this node manager's bound variable manager */
   BoundVarManager* getBoundVarManager() { return d_bvManager.get(); }
 
+  /**
+   * Set the parameters of garbage collection: zombies are reclaimed once
+   * there are more than zombieThreshold of them, in slices of at most
+   * sliceBudget microseconds (or all at once if sliceBudget is zero).
+   */
+  void setGcOptions(size_t zombieThreshold, uint64_t sliceBudget);
+
+  /**
+   * Set whether getType() type checks nodes when asked to. If not, it only
+   * computes their types, which is meant for trusted inputs.
+   */
+  void setTypeChecking(bool typeChecking) { d_typeChecking = typeChecking; }
+
+  /**
+   * Reclaim zombies for at most one slice of the configured budget (if
+   * possible). Does nothing if no slice budget is configured. This is meant
+   * to be called at natural pause points of the solver, e.g., SAT restarts.
+   */
+  void reclaimZombiesSlice();
+
+  /** Register the garbage collection statistics of this node manager */
+  void registerStatistics(StatisticsRegistry& reg);
+  /** Unregister the garbage collection statistics of this node manager */
+  void unregisterStatistics(StatisticsRegistry& reg);
+
   /** Subscribe to NodeManager events */
   void subscribeEvents(NodeManagerListener* listener) {
     Assert(std::find(d_listeners.begin(), d_listeners.end(), listener)
@@ -460,6 +541,11 @@ class NodeManager
   /** Create a node with an arbitrary number of children. */
   template <bool ref_count>
   Node mkNode(Kind kind, const std::vector<NodeTemplate<ref_count> >& children);
+  /**
+   * Create a node with the given children, e.g. mkNode(kind::AND, {a, b, c}),
+   * which does not require a temporary vector of reference-counted nodes.
+   */
+  Node mkNode(Kind kind, std::initializer_list<TNode> children);
   template <bool ref_count>
   Node* mkNodePtr(Kind kind, const std::vector<NodeTemplate<ref_count> >& children);
 
@@ -516,6 +602,8 @@ class NodeManager
   /** Create a node by applying an operator to the children. */
   template <bool ref_count>
   Node mkNode(TNode opNode, const std::vector<NodeTemplate<ref_count> >& children);
+  /** Create a node by applying an operator to the given children. */
+  Node mkNode(TNode opNode, std::initializer_list<TNode> children);
   template <bool ref_count>
   Node* mkNodePtr(TNode opNode, const std::vector<NodeTemplate<ref_count> >& children);
 
@@ -779,6 +867,15 @@ class NodeManager
                            const AttrKind& attr,
                            const typename AttrKind::value_type& value);
 
+  /**
+   * Remove an attribute from a node, if it is set.
+   *
+   * @param n the node
+   * @param attr an instance of the attribute kind to remove
+   */
+  template <class AttrKind>
+  inline void removeAttribute(TNode n, const AttrKind& attr);
+
   /**
    * Retrieve an attribute for a TypeNode.
    *
@@ -1072,7 +1169,8 @@ class NodeManager
    *
    * @param n the Node for which we want a type
    * @param check whether we should check the type as we compute it
-   * (default: false)
+   * (default: false), which is ignored if type checking is disabled by
+   * setTypeChecking()
    */
   TypeNode getType(TNode n, bool check = false);
 
@@ -1085,6 +1183,20 @@ class NodeManager
   /** Size of the node pool. */
   size_t poolSize() const;
 
+  /**
+   * The maximal size of the node pool since the last call to
+   * resetPoolPeakSize(). It is only tracked after a call to
+   * setTrackPoolPeakSize(true).
+   */
+  size_t poolPeakSize() const { return d_nodeValuePool.peakSize(); }
+  /** Reset the peak size of the node pool to its current size. */
+  void resetPoolPeakSize() { d_nodeValuePool.resetPeakSize(); }
+  /** Enable or disable tracking the peak size of the node pool. */
+  void setTrackPoolPeakSize(bool track)
+  {
+    d_nodeValuePool.setTrackPeakSize(track);
+  }
+
   /** Deletes a list of attributes from the NM's AttributeManager.*/
   void deleteAttributes(const std::vector< const expr::attr::AttributeUniqueId* >& ids);
 
@@ -1182,22 +1294,17 @@ inline TypeNode NodeManager::mkTesterType(TypeNode domain) {
 }
 
 inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
-  NodeValuePool::const_iterator find = d_nodeValuePool.find(nv);
-  if(find == d_nodeValuePool.end()) {
-    return NULL;
-  } else {
-    return *find;
-  }
+  return d_nodeValuePool.find(nv);
 }
 
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
+  Assert(d_nodeValuePool.find(nv) == nullptr)
       << "NodeValue already in the pool!";
   d_nodeValuePool.insert(nv);// FIXME multithreading
 }
 
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
+  Assert(d_nodeValuePool.find(nv) != nullptr)
       << "NodeValue is not in the pool!";
 
   d_nodeValuePool.erase(nv);// FIXME multithreading
@@ -1239,9 +1346,8 @@ inline Kind NodeManager::operatorToKind(TNode n) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1) {
-  NodeBuilder<1> nb(this, kind);
-  nb << child1;
-  return nb.constructNode();
+  TNode children[] = {child1};
+  return mkNodeInternal(kind, TNode(), children, children + 1);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1) {
@@ -1251,9 +1357,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1) {
 }
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2) {
-  NodeBuilder<2> nb(this, kind);
-  nb << child1 << child2;
-  return nb.constructNode();
+  TNode children[] = {child1, child2};
+  return mkNodeInternal(kind, TNode(), children, children + 2);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2) {
@@ -1264,9 +1369,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2) {
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3) {
-  NodeBuilder<3> nb(this, kind);
-  nb << child1 << child2 << child3;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3};
+  return mkNodeInternal(kind, TNode(), children, children + 3);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
@@ -1278,9 +1382,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4) {
-  NodeBuilder<4> nb(this, kind);
-  nb << child1 << child2 << child3 << child4;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4};
+  return mkNodeInternal(kind, TNode(), children, children + 4);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
@@ -1292,9 +1395,8 @@ inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
 
 inline Node NodeManager::mkNode(Kind kind, TNode child1, TNode child2,
                                 TNode child3, TNode child4, TNode child5) {
-  NodeBuilder<5> nb(this, kind);
-  nb << child1 << child2 << child3 << child4 << child5;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4, child5};
+  return mkNodeInternal(kind, TNode(), children, children + 5);
 }
 
 inline Node* NodeManager::mkNodePtr(Kind kind, TNode child1, TNode child2,
@@ -1309,9 +1411,13 @@ template <bool ref_count>
 inline Node NodeManager::mkNode(Kind kind,
                                 const std::vector<NodeTemplate<ref_count> >&
                                 children) {
-  NodeBuilder<> nb(this, kind);
-  nb.append(children);
-  return nb.constructNode();
+  return mkNodeInternal(kind, TNode(), children.begin(), children.end());
+}
+
+inline Node NodeManager::mkNode(Kind kind,
+                                std::initializer_list<TNode> children)
+{
+  return mkNodeInternal(kind, TNode(), children.begin(), children.end());
 }
 
 template <bool ref_count>
@@ -1369,12 +1475,11 @@ inline Node* NodeManager::mkNodePtr(TNode opNode) {
 }
 
 inline Node NodeManager::mkNode(TNode opNode, TNode child1) {
-  NodeBuilder<2> nb(this, operatorToKind(opNode));
-  if(opNode.getKind() != kind::BUILTIN) {
-    nb << opNode;
-  }
-  nb << child1;
-  return nb.constructNode();
+  TNode children[] = {child1};
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children,
+                        children + 1);
 }
 
 inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1) {
@@ -1387,12 +1492,11 @@ inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1) {
 }
 
 inline Node NodeManager::mkNode(TNode opNode, TNode child1, TNode child2) {
-  NodeBuilder<3> nb(this, operatorToKind(opNode));
-  if(opNode.getKind() != kind::BUILTIN) {
-    nb << opNode;
-  }
-  nb << child1 << child2;
-  return nb.constructNode();
+  TNode children[] = {child1, child2};
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children,
+                        children + 2);
 }
 
 inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2) {
@@ -1406,12 +1510,11 @@ inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2) {
 
 inline Node NodeManager::mkNode(TNode opNode, TNode child1, TNode child2,
                                 TNode child3) {
-  NodeBuilder<4> nb(this, operatorToKind(opNode));
-  if(opNode.getKind() != kind::BUILTIN) {
-    nb << opNode;
-  }
-  nb << child1 << child2 << child3;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3};
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children,
+                        children + 3);
 }
 
 inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2,
@@ -1426,12 +1529,11 @@ inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2,
 
 inline Node NodeManager::mkNode(TNode opNode, TNode child1, TNode child2,
                                 TNode child3, TNode child4) {
-  NodeBuilder<5> nb(this, operatorToKind(opNode));
-  if(opNode.getKind() != kind::BUILTIN) {
-    nb << opNode;
-  }
-  nb << child1 << child2 << child3 << child4;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4};
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children,
+                        children + 4);
 }
 
 inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2,
@@ -1446,12 +1548,11 @@ inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2,
 
 inline Node NodeManager::mkNode(TNode opNode, TNode child1, TNode child2,
                                 TNode child3, TNode child4, TNode child5) {
-  NodeBuilder<6> nb(this, operatorToKind(opNode));
-  if(opNode.getKind() != kind::BUILTIN) {
-    nb << opNode;
-  }
-  nb << child1 << child2 << child3 << child4 << child5;
-  return nb.constructNode();
+  TNode children[] = {child1, child2, child3, child4, child5};
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children,
+                        children + 5);
 }
 
 inline Node* NodeManager::mkNodePtr(TNode opNode, TNode child1, TNode child2,
@@ -1469,12 +1570,109 @@ template <bool ref_count>
 inline Node NodeManager::mkNode(TNode opNode,
                                 const std::vector<NodeTemplate<ref_count> >&
                                 children) {
-  NodeBuilder<> nb(this, operatorToKind(opNode));
-  if(opNode.getKind() != kind::BUILTIN) {
-    nb << opNode;
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children.begin(),
+                        children.end());
+}
+
+inline Node NodeManager::mkNode(TNode opNode,
+                                std::initializer_list<TNode> children)
+{
+  return mkNodeInternal(operatorToKind(opNode),
+                        opNode.getKind() == kind::BUILTIN ? TNode() : opNode,
+                        children.begin(),
+                        children.end());
+}
+
+template <class Iterator>
+Node NodeManager::mkNodeInternal(Kind kind,
+                                 TNode op,
+                                 Iterator begin,
+                                 Iterator end)
+{
+  size_t nchildren = std::distance(begin, end) + (op.isNull() ? 0 : 1);
+  kind::MetaKind mk = kind::metaKindOf(kind);
+  if (nchildren == 0 || mk == kind::metakind::VARIABLE
+      || mk == kind::metakind::NULLARY_OPERATOR)
+  {
+    // leave the special cases to the node builder
+    NodeBuilder<> nb(this, kind);
+    if (!op.isNull())
+    {
+      nb << op;
+    }
+    nb.append(begin, end);
+    return nb.constructNode();
   }
-  nb.append(children);
-  return nb.constructNode();
+  Assert(mk != kind::metakind::CONSTANT)
+      << "Cannot make Nodes with NodeBuilder that have CONSTANT-kinded kinds";
+  Assert(nchildren >= kind::metakind::getMinArityForKind(kind))
+      << "Nodes with kind " << kind << " must have at least "
+      << kind::metakind::getMinArityForKind(kind) << " children";
+  Assert(nchildren <= kind::metakind::getMaxArityForKind(kind))
+      << "Nodes with kind " << kind << " must have at most "
+      << kind::metakind::getMaxArityForKind(kind) << " children";
+
+  // Look up the node before taking references to its children, using a node
+  // value on the stack if it is small enough.
+  NVStorage<s_mkNodeStackChildren> nvStorage;
+  bool onStack = nchildren <= s_mkNodeStackChildren;
+  expr::NodeValue* nv = onStack
+                            ? reinterpret_cast<expr::NodeValue*>(&nvStorage)
+                            : d_nvAllocator.allocate(nchildren);
+  nv->d_id = 0;
+  nv->d_rc = 0;
+  nv->d_kind = expr::NodeValue::kindToDKind(kind);
+  nv->d_nchildren = nchildren;
+  expr::NodeValue** child = nv->d_children;
+  if (!op.isNull())
+  {
+    *child++ = op.d_nv;
+  }
+  for (; begin != end; ++begin)
+  {
+    TNode c = *begin;
+    Assert(!c.isNull()) << "Cannot use NULL Node as a child of a Node";
+    *child++ = c.d_nv;
+  }
+  expr::NodeValue* poolNv = poolLookup(nv);
+  if (poolNv != nullptr)
+  {
+    if (!onStack)
+    {
+      d_nvAllocator.deallocate(nv);
+    }
+    nv = poolNv;
+  }
+  else
+  {
+    if (onStack)
+    {
+      expr::NodeValue* nvStack = nv;
+      nv = d_nvAllocator.allocate(nchildren);
+      nv->d_rc = 0;
+      nv->d_kind = nvStack->d_kind;
+      nv->d_nchildren = nchildren;
+      std::copy(nvStack->d_children,
+                nvStack->d_children + nchildren,
+                nv->d_children);
+    }
+    for (size_t i = 0; i < nchildren; ++i)
+    {
+      nv->d_children[i]->inc();
+    }
+    nv->d_id = next_id++;  // FIXME multithreading
+    poolInsert(nv);
+    Debug("gc") << "creating node value " << nv << " [" << nv->d_id
+                << "]: " << *nv << "\n";
+  }
+  Node n(nv);
+#ifdef CVC4_DEBUG
+  // type check eagerly, as done by the node builder
+  getType(n, true);
+#endif
+  return n;
 }
 
 template <bool ref_count>
@@ -78,6 +78,7 @@ class NodeValue
   friend void ::cvc5::kind::metakind::deleteNodeValueConstant(NodeValue* nv);
 
   friend class RefCountGuard;
+  friend class NodeValueAllocator;
 
   /* ------------------------------------------------------------------------ */
  public:
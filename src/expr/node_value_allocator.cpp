@@ -0,0 +1,69 @@
+/*********************                                                        */
+/*! \file node_value_allocator.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A size-class allocator for the node values of a NodeManager.
+ **/
+
+#include "expr/node_value_allocator.h"
+
+#include "base/check.h"
+#include "base/output.h"
+
+namespace cvc5 {
+namespace expr {
+
+NodeValueAllocator::NodeValueAllocator() : d_numLive(0)
+{
+  d_freeLists.fill(nullptr);
+}
+
+NodeValueAllocator::~NodeValueAllocator()
+{
+  if (d_numLive > 0)
+  {
+    // some node values leaked, keep their memory valid
+    Debug("gc:leaks") << "node value allocator: " << d_numLive
+                      << " node values still allocated, not releasing "
+                      << d_slabs.size() << " slabs" << std::endl;
+    return;
+  }
+  for (void* slab : d_slabs)
+  {
+    std::free(slab);
+  }
+}
+
+void NodeValueAllocator::refill(size_t nchildren)
+{
+  Assert(nchildren <= s_maxSlabChildren);
+  Assert(d_freeLists[nchildren] == nullptr);
+  char* slab = static_cast<char*>(std::malloc(s_slabSize));
+  if (slab == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  d_slabs.push_back(slab);
+  size_t bsize = blockSize(nchildren);
+  size_t nblocks = s_slabSize / bsize;
+  // thread the blocks in address order, so that consecutive allocations are
+  // adjacent in memory
+  FreeBlock* next = nullptr;
+  for (size_t i = nblocks; i > 0; --i)
+  {
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(slab + (i - 1) * bsize);
+    b->d_next = next;
+    next = b;
+  }
+  d_freeLists[nchildren] = next;
+}
+
+}  // namespace expr
+}  // namespace cvc5
@@ -0,0 +1,146 @@
+/*********************                                                        */
+/*! \file node_value_allocator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A size-class allocator for the node values of a NodeManager.
+ **/
+
+#include "cvc4_private.h"
+
+// circular dependency
+#include "expr/node_value.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_ALLOCATOR_H
+#define CVC4__EXPR__NODE_VALUE_ALLOCATOR_H
+
+#include <array>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace cvc5 {
+namespace expr {
+
+/**
+ * The allocator for the node values of a NodeManager.
+ *
+ * Node values with at most s_maxSlabChildren children (which are the vast
+ * majority of node values) are carved out of large slabs, one size class per
+ * number of children. Freed node values are kept on a free list of their size
+ * class and are reused by later allocations of the same size class. This
+ * avoids the per-node overhead of malloc, reduces fragmentation, and places
+ * node values that are created together close to each other in memory.
+ *
+ * Node values with more children are allocated with malloc. Constants are
+ * never allocated by this class, since their size depends on the type of
+ * their payload; deallocate() passes them back to free.
+ *
+ * The slabs are released when the allocator is destroyed, provided that all
+ * node values allocated from them have been deallocated. Otherwise (i.e., if
+ * node values leaked), the slabs are kept alive so that outstanding
+ * references remain valid.
+ */
+class NodeValueAllocator
+{
+ public:
+  /** The maximal number of children of node values allocated from slabs */
+  static constexpr size_t s_maxSlabChildren = 4;
+
+  NodeValueAllocator();
+  ~NodeValueAllocator();
+  NodeValueAllocator(const NodeValueAllocator&) = delete;
+  NodeValueAllocator& operator=(const NodeValueAllocator&) = delete;
+
+  /**
+   * Allocate (uninitialized) memory for a non-constant node value with
+   * nchildren children.
+   * @throws bad_alloc if the allocation fails
+   */
+  NodeValue* allocate(size_t nchildren)
+  {
+    if (nchildren > s_maxSlabChildren)
+    {
+      NodeValue* nv = static_cast<NodeValue*>(
+          std::malloc(sizeof(NodeValue) + sizeof(NodeValue*) * nchildren));
+      if (nv == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+      return nv;
+    }
+    if (d_freeLists[nchildren] == nullptr)
+    {
+      refill(nchildren);
+    }
+    FreeBlock* b = d_freeLists[nchildren];
+    d_freeLists[nchildren] = b->d_next;
+    ++d_numLive;
+    return reinterpret_cast<NodeValue*>(b);
+  }
+
+  /**
+   * Deallocate nv, which was allocated by allocate() or, if nv is a
+   * constant, by malloc. The children and kind of nv must still be set.
+   */
+  void deallocate(NodeValue* nv)
+  {
+    size_t nchildren = nv->d_nchildren;
+    if (nchildren > s_maxSlabChildren
+        || nv->getMetaKind() == kind::metakind::CONSTANT)
+    {
+      std::free(nv);
+      return;
+    }
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(nv);
+    b->d_next = d_freeLists[nchildren];
+    d_freeLists[nchildren] = b;
+    --d_numLive;
+  }
+
+  /** The number of node values currently allocated from slabs */
+  size_t getNumLive() const { return d_numLive; }
+
+  /** The total number of bytes in slabs */
+  size_t getSlabBytes() const { return d_slabs.size() * s_slabSize; }
+
+ private:
+  /** A free block, which reuses the memory of a deallocated node value */
+  struct FreeBlock
+  {
+    FreeBlock* d_next;
+  };
+  static_assert(sizeof(FreeBlock) <= sizeof(NodeValue),
+                "free blocks must fit into a childless node value");
+  /** The size of a slab in bytes */
+  static constexpr size_t s_slabSize = 64 * 1024;
+
+  /** The size of a node value with nchildren children */
+  static constexpr size_t blockSize(size_t nchildren)
+  {
+    return sizeof(NodeValue) + sizeof(NodeValue*) * nchildren;
+  }
+  /**
+   * Allocate a new slab for node values with nchildren children and put its
+   * blocks on the corresponding free list.
+   */
+  void refill(size_t nchildren);
+
+  /** The free lists, one per number of children */
+  std::array<FreeBlock*, s_maxSlabChildren + 1> d_freeLists;
+  /** The slabs */
+  std::vector<void*> d_slabs;
+  /** The number of node values currently allocated from slabs */
+  size_t d_numLive;
+};
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC4__EXPR__NODE_VALUE_ALLOCATOR_H */
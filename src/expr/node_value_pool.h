@@ -0,0 +1,106 @@
+/*********************                                                        */
+/*! \file node_value_pool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The hash-consing pool of node values of a NodeManager.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__EXPR__NODE_VALUE_POOL_H
+#define CVC4__EXPR__NODE_VALUE_POOL_H
+
+#include <unordered_set>
+
+#include "expr/node_value.h"
+
+namespace cvc5 {
+namespace expr {
+
+/**
+ * The pool of (hash-consed) node values owned by a NodeManager, a hash set of
+ * node values that additionally keeps track of its peak size.
+ *
+ * Like the rest of the NodeManager (node ids, reference counts, garbage
+ * collection), the pool is not thread-safe.
+ */
+class NodeValuePool
+{
+  using Set = std::unordered_set<NodeValue*,
+                                 NodeValuePoolHashFunction,
+                                 NodeValuePoolEq>;
+
+ public:
+  NodeValuePool() : d_peakSize(0), d_trackPeakSize(false) {}
+
+  /**
+   * Return the node value in the pool equal to nv (see NodeValuePoolEq), or
+   * nullptr if there is none. As for NodeManager::poolLookup(), nv need not
+   * be fully constructed.
+   */
+  NodeValue* find(NodeValue* nv) const
+  {
+    Set::const_iterator it = d_set.find(nv);
+    return it == d_set.end() ? nullptr : *it;
+  }
+
+  /**
+   * Insert nv into the pool, unless an equal node value is already in it.
+   * Returns the node value that is in the pool afterwards.
+   */
+  NodeValue* insert(NodeValue* nv)
+  {
+    std::pair<Set::iterator, bool> res = d_set.insert(nv);
+    if (res.second && d_trackPeakSize && d_set.size() > d_peakSize)
+    {
+      d_peakSize = d_set.size();
+    }
+    return *res.first;
+  }
+
+  /** Remove nv from the pool. Returns the number of removed node values. */
+  size_t erase(NodeValue* nv) { return d_set.erase(nv); }
+
+  /** The number of node values in the pool */
+  size_t size() const { return d_set.size(); }
+
+  /**
+   * The maximal number of node values in the pool since the last reset. It
+   * is only tracked after a call to setTrackPeakSize(true).
+   */
+  size_t peakSize() const { return d_peakSize; }
+  /** Reset the peak size to the current size */
+  void resetPeakSize() { d_peakSize = d_set.size(); }
+  /** Enable or disable tracking the peak size, which is disabled by default */
+  void setTrackPeakSize(bool track) { d_trackPeakSize = track; }
+
+  /** Call f on all node values in the pool. */
+  template <class F>
+  void forEach(F f) const
+  {
+    for (NodeValue* nv : d_set)
+    {
+      f(nv);
+    }
+  }
+
+ private:
+  /** The node values */
+  Set d_set;
+  /** The maximal size of d_set since the last call to resetPeakSize() */
+  size_t d_peakSize;
+  /** Whether d_peakSize is updated */
+  bool d_trackPeakSize;
+};
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC4__EXPR__NODE_VALUE_POOL_H */
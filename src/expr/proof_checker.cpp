@@ -77,16 +77,19 @@ Node ProofRuleChecker::mkKindNode(Kind k)
 
 ProofCheckerStatistics::ProofCheckerStatistics()
     : d_ruleChecks("ProofCheckerStatistics::ruleChecks"),
-    d_totalRuleChecks("ProofCheckerStatistics::totalRuleChecks", 0)
+    d_totalRuleChecks("ProofCheckerStatistics::totalRuleChecks", 0),
+    d_cachedRuleChecks("ProofCheckerStatistics::cachedRuleChecks", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_ruleChecks);
   smtStatisticsRegistry()->registerStat(&d_totalRuleChecks);
+  smtStatisticsRegistry()->registerStat(&d_cachedRuleChecks);
 }
 
 ProofCheckerStatistics::~ProofCheckerStatistics()
 {
   smtStatisticsRegistry()->unregisterStat(&d_ruleChecks);
   smtStatisticsRegistry()->unregisterStat(&d_totalRuleChecks);
+  smtStatisticsRegistry()->unregisterStat(&d_cachedRuleChecks);
 }
 
 Node ProofChecker::check(ProofNode* pn, Node expected)
@@ -217,8 +220,28 @@ Node ProofChecker::checkInternal(PfRule id,
       return Node::null();
     }
   }
-  // check it with the corresponding checker
-  Node res = it->second->check(id, cchildren, args);
+  // check it with the corresponding checker, unless it is cached
+  Node res;
+  Node key;
+  if (d_caching)
+  {
+    key = mkCacheKey(id, cchildren, args);
+    std::unordered_map<Node, Node, NodeHashFunction>::iterator itc =
+        d_cache.find(key);
+    if (itc != d_cache.end())
+    {
+      ++d_stats.d_cachedRuleChecks;
+      res = itc->second;
+    }
+  }
+  if (res.isNull())
+  {
+    res = it->second->check(id, cchildren, args);
+    if (d_caching && !res.isNull())
+    {
+      d_cache[key] = res;
+    }
+  }
   if (!expected.isNull())
   {
     Node expectedw = expected;
@@ -266,6 +289,29 @@ Node ProofChecker::checkInternal(PfRule id,
   return res;
 }
 
+void ProofChecker::setCaching(bool caching)
+{
+  d_caching = caching;
+  if (!caching)
+  {
+    d_cache.clear();
+  }
+}
+
+Node ProofChecker::mkCacheKey(PfRule id,
+                              const std::vector<Node>& cchildren,
+                              const std::vector<Node>& args)
+{
+  // the key is (id, #children, children, args), which is not type checked
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> key;
+  key.push_back(nm->mkConst(Rational(static_cast<uint32_t>(id))));
+  key.push_back(nm->mkConst(Rational(cchildren.size())));
+  key.insert(key.end(), cchildren.begin(), cchildren.end());
+  key.insert(key.end(), args.begin(), args.end());
+  return nm->mkNode(SEXPR, key);
+}
+
 void ProofChecker::registerChecker(PfRule id, ProofRuleChecker* psc)
 {
   std::map<PfRule, ProofRuleChecker*>::iterator it = d_checker.find(id);
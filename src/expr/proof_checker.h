@@ -18,6 +18,7 @@
 #define CVC4__EXPR__PROOF_CHECKER_H
 
 #include <map>
+#include <unordered_map>
 
 #include "expr/node.h"
 #include "expr/proof_rule.h"
@@ -96,13 +97,15 @@ class ProofCheckerStatistics
   IntegralHistogramStat<PfRule> d_ruleChecks;
   /** Total number of rule checks */
   IntStat d_totalRuleChecks;
+  /** Number of rule checks whose result was cached */
+  IntStat d_cachedRuleChecks;
 };
 
 /** A class for checking proofs */
 class ProofChecker
 {
  public:
-  ProofChecker(uint32_t pclevel = 0) : d_pclevel(pclevel) {}
+  ProofChecker(uint32_t pclevel = 0) : d_pclevel(pclevel), d_caching(false) {}
   ~ProofChecker() {}
   /**
    * Return the formula that is proven by proof node pn, or null if pn is not
@@ -177,6 +180,15 @@ class ProofChecker
   bool isPedanticFailure(PfRule id,
                          std::ostream& out,
                          bool enableOutput = true) const;
+  /**
+   * Set whether to cache the results of the rule checkers. While caching is
+   * enabled, a proof step that has the same rule, conclusions of children and
+   * arguments as a step checked before is not checked again, which is
+   * typically the case for the many copies of the same step that are
+   * introduced when post-processing a proof. Disabling caching clears the
+   * cache.
+   */
+  void setCaching(bool caching);
 
  private:
   /** statistics class */
@@ -187,6 +199,14 @@ class ProofChecker
   std::map<PfRule, uint32_t> d_plevel;
   /** The pedantic level of this checker */
   uint32_t d_pclevel;
+  /** Whether to cache the results of the rule checkers */
+  bool d_caching;
+  /** Maps the keys computed by mkCacheKey to the result of the checker */
+  std::unordered_map<Node, Node, NodeHashFunction> d_cache;
+  /** Make the key of a proof step for d_cache */
+  static Node mkCacheKey(PfRule id,
+                         const std::vector<Node>& cchildren,
+                         const std::vector<Node>& args);
   /**
    * Check internal. This is used by check and checkDebug above. It writes
    * checking errors on out when enableOutput is true. We treat trusted checkers
@@ -196,9 +196,16 @@ Node SkolemManager::getOriginalForm(Node n)
   {
     return n;
   }
+  OriginalFormAttribute ofa;
+  Node nOrig;
+  // the original forms of all terms visited below are cached, hence we avoid
+  // the allocation of the traversal in the common case that n was visited
+  if (n.getAttribute(ofa, nOrig))
+  {
+    return nOrig;
+  }
   Trace("sk-manager-debug")
       << "SkolemManager::getOriginalForm " << n << std::endl;
-  OriginalFormAttribute ofa;
   NodeManager* nm = NodeManager::currentNM();
   std::unordered_map<TNode, Node, TNodeHashFunction> visited;
   std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it;
@@ -255,6 +262,9 @@ Node SkolemManager::getOriginalForm(Node n)
       if (childChanged)
       {
         ret = nm->mkNode(cur.getKind(), children);
+        // the original form is its own original form, which we cache since
+        // original forms are often converted again, e.g. by proof checkers
+        ret.setAttribute(ofa, ret);
       }
       cur.setAttribute(ofa, ret);
       visited[cur] = ret;
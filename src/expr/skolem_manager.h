@@ -199,6 +199,11 @@ class SkolemManager
    * Convert to original form, which recursively replaces all skolems terms in n
    * by the term they purify.
    *
+   * The original forms of n and of its subterms are cached as attributes,
+   * as well as the original form of each computed original form, which is
+   * itself. Hence, this method takes constant time on all terms it has visited
+   * and their original forms.
+   *
    * @param n The term or formula to convert to original form described above
    * @return n in original form.
    */
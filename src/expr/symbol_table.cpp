@@ -18,21 +18,18 @@
 
 #include "expr/symbol_table.h"
 
+#include <iterator>
 #include <ostream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 
 #include "api/cvc4cpp.h"
-#include "context/cdhashmap.h"
-#include "context/cdhashset.h"
-#include "context/context.h"
+#include "base/check.h"
+#include "base/output.h"
 
 namespace cvc5 {
 
-using ::cvc5::context::CDHashMap;
-using ::cvc5::context::CDHashSet;
-using ::cvc5::context::Context;
 using ::std::copy;
 using ::std::endl;
 using ::std::ostream_iterator;
@@ -40,11 +37,102 @@ using ::std::pair;
 using ::std::string;
 using ::std::vector;
 
+/**
+ * A map whose bindings are scoped. A binding made by insert shadows the
+ * previous binding of its key until the scope in which it was made is popped.
+ *
+ * Unlike a context-dependent map, this map stores one entry per key, which
+ * holds the current binding. Each scope has an undo log recording the
+ * previous binding of each key bound in that scope, so that pushing a scope
+ * takes constant time and popping a scope takes time linear in the number of
+ * bindings made in that scope. This matters for parsing deeply nested binders,
+ * e.g. the let terms of machine-generated benchmarks.
+ */
+template <class K, class V, class H = std::hash<K>>
+class ScopedMap
+{
+  using Map = std::unordered_map<K, V, H>;
+
+ public:
+  /** Get the value bound to k, or nullptr if k is not bound */
+  const V* find(const K& k) const
+  {
+    typename Map::const_iterator it = d_map.find(k);
+    return it == d_map.end() ? nullptr : &it->second;
+  }
+  /** Bind k to v in the current scope */
+  void insert(const K& k, const V& v)
+  {
+    std::pair<typename Map::iterator, bool> res = d_map.try_emplace(k, v);
+    Assert(!d_scopes.empty());
+    // the elements of an unordered map are not moved by rehashing, hence we
+    // can refer to them by pointer in the undo log
+    d_undo.emplace_back(&*res.first, !res.second);
+    if (!res.second)
+    {
+      d_undo.back().d_value = res.first->second;
+      res.first->second = v;
+    }
+  }
+  /** Bind k to v in all scopes, where k must not be bound */
+  void insertAtLevelZero(const K& k, const V& v)
+  {
+    AlwaysAssert(d_map.find(k) == d_map.end());
+    d_map.emplace(k, v);
+  }
+  /** Push a scope */
+  void pushScope() { d_scopes.push_back(d_undo.size()); }
+  /** Pop the current scope, undoing the bindings made in it */
+  void popScope()
+  {
+    Assert(!d_scopes.empty());
+    size_t start = d_scopes.back();
+    d_scopes.pop_back();
+    while (d_undo.size() > start)
+    {
+      Undo& u = d_undo.back();
+      if (u.d_hadValue)
+      {
+        std::swap(u.d_elem->second, u.d_value);
+      }
+      else
+      {
+        d_map.erase(d_map.find(u.d_elem->first));
+      }
+      d_undo.pop_back();
+    }
+  }
+  /** Get the number of scopes */
+  size_t getLevel() const { return d_scopes.size(); }
+
+ private:
+  /** An entry of the undo log */
+  struct Undo
+  {
+    Undo(typename Map::value_type* elem, bool hadValue)
+        : d_elem(elem), d_hadValue(hadValue)
+    {
+    }
+    /** The element of the binding */
+    typename Map::value_type* d_elem;
+    /** Whether the key was bound before, in which case d_value is its value */
+    bool d_hadValue;
+    /** The value of the key before the binding */
+    V d_value;
+  };
+  /** The current bindings */
+  Map d_map;
+  /** The undo log of all scopes */
+  std::vector<Undo> d_undo;
+  /** The start of the undo log of each scope */
+  std::vector<size_t> d_scopes;
+};
+
 /** Overloaded type trie.
  *
  * This data structure stores a trie of expressions with
  * the same name, and must be distinguished by their argument types.
- * It is context-dependent.
+ * It is scoped.
  *
  * Using the argument allowFunVariants,
  * it may either be configured to allow function variants or not,
@@ -91,13 +179,15 @@ using ::std::vector;
  */
 class OverloadedTypeTrie {
  public:
-  OverloadedTypeTrie(Context* c, bool allowFunVariants = false)
-      : d_overloaded_symbols(
-            new (true) CDHashSet<api::Term, api::TermHashFunction>(c)),
-        d_allowFunctionVariants(allowFunVariants)
+  OverloadedTypeTrie(bool allowFunVariants = false)
+      : d_allowFunctionVariants(allowFunVariants)
   {
   }
-  ~OverloadedTypeTrie() { d_overloaded_symbols->deleteSelf(); }
+
+  /** push a scope */
+  void pushScope() { d_overloaded_symbols.pushScope(); }
+  /** pop a scope */
+  void popScope() { d_overloaded_symbols.popScope(); }
 
   /** is this function overloaded? */
   bool isOverloadedFunction(api::Term fun) const;
@@ -142,7 +232,7 @@ class OverloadedTypeTrie {
   api::Term d_nullTerm;
   // The (context-independent) trie storing that maps expected argument
   // vectors to symbols. All expressions stored in d_symbols are only
-  // interpreted as active if they also appear in the context-dependent
+  // interpreted as active if they also appear in the scoped
   // set d_overloaded_symbols.
   class TypeArgTrie {
    public:
@@ -155,7 +245,7 @@ class OverloadedTypeTrie {
    * above. */
   std::unordered_map<std::string, TypeArgTrie> d_overload_type_arg_trie;
   /** The set of overloaded symbols. */
-  CDHashSet<api::Term, api::TermHashFunction>* d_overloaded_symbols;
+  ScopedMap<api::Term, bool, api::TermHashFunction> d_overloaded_symbols;
   /** allow function variants
    * This is true if we allow overloading (non-constant) functions that expect
    * the same argument types.
@@ -173,7 +263,7 @@ class OverloadedTypeTrie {
 
 bool OverloadedTypeTrie::isOverloadedFunction(api::Term fun) const
 {
-  return d_overloaded_symbols->find(fun) != d_overloaded_symbols->end();
+  return d_overloaded_symbols.find(fun) != nullptr;
 }
 
 api::Term OverloadedTypeTrie::getOverloadedConstantForType(
@@ -298,7 +388,7 @@ bool OverloadedTypeTrie::markOverloaded(const string& name, api::Term obj)
   }
 
   // otherwise, update the symbols
-  d_overloaded_symbols->insert(obj);
+  d_overloaded_symbols.insert(obj, true);
   tat->d_symbols[rangeType] = obj;
   return true;
 }
@@ -339,17 +429,11 @@ api::Term OverloadedTypeTrie::getOverloadedFunctionAt(
 class SymbolTable::Implementation {
  public:
   Implementation()
-      : d_context(),
-        d_exprMap(&d_context),
-        d_typeMap(&d_context),
-        d_overload_trie(&d_context)
   {
     // use an outermost push, to be able to clear definitions not at level zero
-    d_context.push();
+    pushScope();
   }
 
-  ~Implementation() { d_context.pop(); }
-
   bool bind(const string& name, api::Term obj, bool levelZero, bool doOverload);
   void bindType(const string& name, api::Sort t, bool levelZero = false);
   void bindType(const string& name,
@@ -381,14 +465,11 @@ class SymbolTable::Implementation {
       const std::string& name, const std::vector<api::Sort>& argTypes) const;
   //------------------------ end operator overloading
  private:
-  /** The context manager for the scope maps. */
-  Context d_context;
-
   /** A map for expressions. */
-  CDHashMap<string, api::Term> d_exprMap;
+  ScopedMap<string, api::Term> d_exprMap;
 
   /** A map for types. */
-  using TypeMap = CDHashMap<string, std::pair<vector<api::Sort>, api::Sort>>;
+  using TypeMap = ScopedMap<string, std::pair<vector<api::Sort>, api::Sort>>;
   TypeMap d_typeMap;
 
   //------------------------ operator overloading
@@ -420,7 +501,7 @@ bool SymbolTable::Implementation::bind(const string& name,
     }
   }
   if (levelZero) {
-    d_exprMap.insertAtContextLevelZero(name, obj);
+    d_exprMap.insertAtLevelZero(name, obj);
   } else {
     d_exprMap.insert(name, obj);
   }
@@ -428,13 +509,13 @@ bool SymbolTable::Implementation::bind(const string& name,
 }
 
 bool SymbolTable::Implementation::isBound(const string& name) const {
-  return d_exprMap.find(name) != d_exprMap.end();
+  return d_exprMap.find(name) != nullptr;
 }
 
 api::Term SymbolTable::Implementation::lookup(const string& name) const
 {
   Assert(isBound(name));
-  api::Term expr = (*d_exprMap.find(name)).second;
+  api::Term expr = *d_exprMap.find(name);
   if (isOverloadedFunction(expr)) {
     return d_nullTerm;
   } else {
@@ -447,7 +528,7 @@ void SymbolTable::Implementation::bindType(const string& name,
                                            bool levelZero)
 {
   if (levelZero) {
-    d_typeMap.insertAtContextLevelZero(name, make_pair(vector<api::Sort>(), t));
+    d_typeMap.insertAtLevelZero(name, make_pair(vector<api::Sort>(), t));
   } else {
     d_typeMap.insert(name, make_pair(vector<api::Sort>(), t));
   }
@@ -469,20 +550,20 @@ void SymbolTable::Implementation::bindType(const string& name,
     Debug("sort") << "], " << t << ")" << endl;
   }
   if (levelZero) {
-    d_typeMap.insertAtContextLevelZero(name, make_pair(params, t));
+    d_typeMap.insertAtLevelZero(name, make_pair(params, t));
   } else {
     d_typeMap.insert(name, make_pair(params, t));
   }
 }
 
 bool SymbolTable::Implementation::isBoundType(const string& name) const {
-  return d_typeMap.find(name) != d_typeMap.end();
+  return d_typeMap.find(name) != nullptr;
 }
 
 api::Sort SymbolTable::Implementation::lookupType(const string& name) const
 {
-  std::pair<std::vector<api::Sort>, api::Sort> p =
-      (*d_typeMap.find(name)).second;
+  const std::pair<std::vector<api::Sort>, api::Sort>& p =
+      *d_typeMap.find(name);
   PrettyCheckArgument(p.first.size() == 0, name,
                       "type constructor arity is wrong: "
                       "`%s' requires %u parameters but was provided 0",
@@ -493,8 +574,8 @@ api::Sort SymbolTable::Implementation::lookupType(const string& name) const
 api::Sort SymbolTable::Implementation::lookupType(
     const string& name, const vector<api::Sort>& params) const
 {
-  std::pair<std::vector<api::Sort>, api::Sort> p =
-      (*d_typeMap.find(name)).second;
+  const std::pair<std::vector<api::Sort>, api::Sort>& p =
+      *d_typeMap.find(name);
   PrettyCheckArgument(p.first.size() == params.size(), params,
                       "type constructor arity is wrong: "
                       "`%s' requires %u parameters but was provided %u",
@@ -537,24 +618,31 @@ api::Sort SymbolTable::Implementation::lookupType(
 }
 
 size_t SymbolTable::Implementation::lookupArity(const string& name) {
-  std::pair<std::vector<api::Sort>, api::Sort> p =
-      (*d_typeMap.find(name)).second;
+  const std::pair<std::vector<api::Sort>, api::Sort>& p =
+      *d_typeMap.find(name);
   return p.first.size();
 }
 
 void SymbolTable::Implementation::popScope() {
   // should not pop beyond level one
-  if (d_context.getLevel() == 1)
+  if (getLevel() == 1)
   {
     throw ScopeException();
   }
-  d_context.pop();
+  d_exprMap.popScope();
+  d_typeMap.popScope();
+  d_overload_trie.popScope();
 }
 
-void SymbolTable::Implementation::pushScope() { d_context.push(); }
+void SymbolTable::Implementation::pushScope()
+{
+  d_exprMap.pushScope();
+  d_typeMap.pushScope();
+  d_overload_trie.pushScope();
+}
 
 size_t SymbolTable::Implementation::getLevel() const {
-  return d_context.getLevel();
+  return d_exprMap.getLevel();
 }
 
 void SymbolTable::Implementation::reset() {
@@ -566,12 +654,14 @@ void SymbolTable::Implementation::reset() {
 void SymbolTable::Implementation::resetAssertions()
 {
   Trace("sym-table") << "SymbolTable: resetAssertions" << std::endl;
-  // pop all contexts
-  while (d_context.getLevel() > 0)
+  // pop all scopes
+  while (getLevel() > 0)
   {
-    d_context.pop();
+    d_exprMap.popScope();
+    d_typeMap.popScope();
+    d_overload_trie.popScope();
   }
-  d_context.push();
+  pushScope();
 }
 
 bool SymbolTable::Implementation::isOverloadedFunction(api::Term fun) const
@@ -594,10 +684,10 @@ api::Term SymbolTable::Implementation::getOverloadedFunctionForTypes(
 bool SymbolTable::Implementation::bindWithOverloading(const string& name,
                                                       api::Term obj)
 {
-  CDHashMap<string, api::Term>::const_iterator it = d_exprMap.find(name);
-  if (it != d_exprMap.end())
+  const api::Term* it = d_exprMap.find(name);
+  if (it != nullptr)
   {
-    const api::Term& prev_bound_obj = (*it).second;
+    const api::Term& prev_bound_obj = *it;
     if (prev_bound_obj != obj) {
       return d_overload_trie.bind(name, prev_bound_obj, obj);
     }
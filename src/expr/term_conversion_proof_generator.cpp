@@ -160,6 +160,7 @@ Node TConvProofGenerator::registerRewriteStep(Node t,
   {
     // clear the cache
     d_cache.clear();
+    d_cacheUnchanged.clear();
   }
   return t.eqNode(s);
 }
@@ -301,6 +302,11 @@ Node TConvProofGenerator::getProofForRewriting(Node t,
       pf.addProof(itc->second);
       continue;
     }
+    if (d_cacheUnchanged.find(curHash) != d_cacheUnchanged.end())
+    {
+      visited[curHash] = cur;
+      continue;
+    }
     it = visited.find(curHash);
     if (it == visited.end())
     {
@@ -563,6 +569,12 @@ void TConvProofGenerator::doCache(Node curHash,
 {
   if (d_cpolicy != TConvCachePolicy::NEVER)
   {
+    if (cur == r)
+    {
+      // the proof is trivial, we do not construct it
+      d_cacheUnchanged.insert(curHash);
+      return;
+    }
     Node eq = cur.eqNode(r);
     d_cache[curHash] = pf.getProofFor(eq);
   }
@@ -17,6 +17,8 @@
 #ifndef CVC4__EXPR__TERM_CONVERSION_PROOF_GENERATOR_H
 #define CVC4__EXPR__TERM_CONVERSION_PROOF_GENERATOR_H
 
+#include <unordered_set>
+
 #include "context/cdhashmap.h"
 #include "expr/lazy_proof.h"
 #include "expr/proof_generator.h"
@@ -215,6 +217,11 @@ class TConvProofGenerator : public ProofGenerator
   std::string d_name;
   /** The cache for terms */
   std::map<Node, std::shared_ptr<ProofNode> > d_cache;
+  /**
+   * The cache for (the hashes of) terms that are unchanged by the rewrite
+   * steps, which are not stored in d_cache since their proofs are trivial.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_cacheUnchanged;
   /** An (optional) term context object */
   TermContext* d_tcontext;
   /**
@@ -141,6 +141,13 @@ bool CommandExecutor::doCommandSingleton(Command* cmd)
   if(q != nullptr) {
     d_result = res = q->getResult();
   }
+  // the result of synthesis is recorded for the portfolio (see
+  // --sygus-enum-shards), where unsat means a solution was found
+  const CheckSynthCommand* csy = dynamic_cast<const CheckSynthCommand*>(cmd);
+  if (csy != nullptr)
+  {
+    d_result = csy->getResult();
+  }
 
   if((cs != nullptr || q != nullptr) && d_options.getStatsEveryQuery()) {
     std::ostringstream ossCurStats;
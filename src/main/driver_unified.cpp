@@ -12,6 +12,7 @@
  ** \brief Driver for CVC4 executable (cvc4)
  **/
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <unistd.h>
 
@@ -22,6 +23,7 @@
 #include <iostream>
 #include <memory>
 #include <new>
+#include <sstream>
 
 #include "cvc4autoconfig.h"
 
@@ -31,7 +33,11 @@
 #include "main/command_executor.h"
 #include "main/interactive_shell.h"
 #include "main/main.h"
+#include "main/pipe_output.h"
+#include "main/portfolio.h"
+#include "main/server.h"
 #include "main/signal_handlers.h"
+#include "main/stats_sampler.h"
 #include "main/time_limit.h"
 #include "options/options.h"
 #include "options/set_language.h"
@@ -135,7 +141,8 @@ int runCvc4(int argc, char* argv[], Options& opts) {
 
   // if we're reading from stdin on a TTY, default to interactive mode
   if(!opts.wasSetByUserInteractive()) {
-    opts.setInteractive(inputFromStdin && isatty(fileno(stdin)));
+    opts.setInteractive(inputFromStdin && isatty(fileno(stdin))
+                        && !opts.getPipe());
   }
 
   // Auto-detect input language by filename extension
@@ -148,7 +155,13 @@ int runCvc4(int argc, char* argv[], Options& opts) {
   const char* filename = filenameStr.c_str();
 
   if(opts.getInputLanguage() == language::input::LANG_AUTO) {
-    if( inputFromStdin ) {
+    if (!opts.getServer().empty() || opts.getPipe())
+    {
+      // requests and pipe commands are SMT-LIB 2
+      opts.setInputLanguage(language::input::LANG_SMTLIB_V2_6);
+    }
+    else if (inputFromStdin)
+    {
       // We can't do any fancy detection on stdin
       opts.setInputLanguage(language::input::LANG_CVC4);
     } else {
@@ -183,6 +196,14 @@ int runCvc4(int argc, char* argv[], Options& opts) {
     WarningChannel.setStream(&cvc5::null_os);
   }
 
+  // In pipe mode, the responses are buffered until they are flushed
+  // explicitly, see below.
+  std::unique_ptr<PipeOutputBuffer> pipeOut;
+  if (opts.getPipe())
+  {
+    pipeOut = std::make_unique<PipeOutputBuffer>(*opts.getOut());
+  }
+
   // important even for muzzled builds (to get result output right)
   (*(opts.getOut())) << language::SetLanguage(opts.getOutputLanguage());
 
@@ -197,7 +218,88 @@ int runCvc4(int argc, char* argv[], Options& opts) {
     // Parse and execute commands until we are done
     std::unique_ptr<Command> cmd;
     bool status = true;
-    if(opts.getInteractive() && inputFromStdin) {
+    if (!opts.getServer().empty())
+    {
+      runServer(opts);
+    }
+    else if (opts.getPipe())
+    {
+      if (!opts.wasSetByUserIncrementalSolving())
+      {
+        cmd.reset(new SetOptionCommand("incremental", "true"));
+        cmd->setMuted(true);
+        pExecutor->doCommand(cmd);
+      }
+      // The commands are parsed directly from the pipe, which is standard
+      // input or the input file (e.g. a named pipe), one at a time. The
+      // responses are flushed after check-sat answers, and whenever the
+      // parser is about to wait for the next command, so that a client that
+      // waits for a response (e.g. to get-value, or a success) never blocks.
+      int fd = fileno(stdin);
+      if (!inputFromStdin)
+      {
+        fd = open(filename, O_RDONLY);
+        if (fd == -1)
+        {
+          throw Exception("Couldn't open file: " + filenameStr);
+        }
+      }
+      ParserBuilder parserBuilder(pExecutor->getSolver(),
+                                  pExecutor->getSymbolManager(),
+                                  filename,
+                                  opts);
+      parserBuilder.withPipeInput(fd, [&pipeOut]() { pipeOut->flush(); });
+      std::unique_ptr<Parser> parser(parserBuilder.build());
+      while (true)
+      {
+        size_t scopeLevel = parser->scopeLevel();
+        try
+        {
+          cmd.reset(parser->nextCommand());
+        }
+        catch (UnsafeInterruptException& e)
+        {
+          (*opts.getOut()) << CommandInterrupted();
+          break;
+        }
+        catch (ParserException& e)
+        {
+          // The next command is read afresh from the pipe, it only remains to
+          // close the scopes opened by the command with the error, e.g. by a
+          // let binder.
+          while (parser->scopeLevel() > scopeLevel)
+          {
+            parser->popScope();
+          }
+          parser->setDone(false);
+          (*opts.getOut()) << "(error \"" << e << "\")" << endl;
+          pipeOut->flush();
+          status = false;
+          continue;
+        }
+        if (cmd == nullptr)
+        {
+          break;
+        }
+        status = pExecutor->doCommand(cmd) && status;
+        if (cmd->interrupted()
+            || dynamic_cast<QuitCommand*>(cmd.get()) != nullptr)
+        {
+          break;
+        }
+        if (dynamic_cast<CheckSatCommand*>(cmd.get()) != nullptr
+            || dynamic_cast<CheckSatAssumingCommand*>(cmd.get()) != nullptr)
+        {
+          pipeOut->flush();
+        }
+      }
+      if (!inputFromStdin)
+      {
+        close(fd);
+      }
+    }
+    else if (opts.getInteractive() && inputFromStdin)
+    {
       if(opts.getTearDownIncremental() > 0) {
         throw Exception(
             "--tear-down-incremental doesn't work in interactive mode");
@@ -403,6 +505,21 @@ int runCvc4(int argc, char* argv[], Options& opts) {
           }
         }
       }
+    } else if (opts.getPortfolioJobs() > 1 || opts.getCubeDepth() > 0
+               || opts.getSygusEnumShards() > 1
+               || opts.getSygusRewSynthShards() > 1) {
+      if (inputFromStdin)
+      {
+        // every worker parses the input separately, read it only once
+        std::stringstream ss;
+        ss << cin.rdbuf();
+        std::string input = ss.str();
+        status = runPortfolio(opts, filenameStr, &input);
+      }
+      else
+      {
+        status = runPortfolio(opts, filenameStr, nullptr);
+      }
     } else {
       if(!opts.wasSetByUserIncrementalSolving()) {
         cmd.reset(new SetOptionCommand("incremental", "false"));
@@ -424,11 +541,18 @@ int runCvc4(int argc, char* argv[], Options& opts) {
       }
 
       std::unique_ptr<Parser> parser(parserBuilder.build());
+      std::unique_ptr<StatsSampler> sampler;
+      if (opts.getStatsSnapshotInterval() > 0)
+      {
+        sampler.reset(new StatsSampler(opts, pExecutor->getSmtEngine()));
+      }
       bool interrupted = false;
       while (status)
       {
         if (interrupted) {
           (*opts.getOut()) << CommandInterrupted();
+          // the statistics of the solver are destroyed by the reset
+          sampler.reset();
           pExecutor->reset();
           break;
         }
@@ -462,6 +586,7 @@ int runCvc4(int argc, char* argv[], Options& opts) {
     }
 
 #ifdef CVC4_COMPETITION_MODE
+    pipeOut.reset();
     opts.flushOut();
     // exit, don't return (don't want destructors to run)
     // _exit() from unistd.h doesn't run global destructors
@@ -470,7 +595,15 @@ int runCvc4(int argc, char* argv[], Options& opts) {
 #endif /* CVC4_COMPETITION_MODE */
 
     totalTime.reset();
-    pExecutor->flushOutputStreams();
+    if ((opts.getPortfolioJobs() <= 1 && opts.getCubeDepth() == 0
+         && opts.getSygusEnumShards() <= 1
+         && opts.getSygusRewSynthShards() <= 1)
+        || opts.getInteractive() || opts.getTearDownIncremental() > 0)
+    {
+      pExecutor->flushOutputStreams();
+    }
+    // restore the output stream before an early exit
+    pipeOut.reset();
 
 #ifdef CVC4_DEBUG
     if(opts.getEarlyExit() && opts.wasSetByUserEarlyExit()) {
@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file pipe_output.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Buffered output of the responses in pipe mode (--pipe).
+ **/
+
+#include "main/pipe_output.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/** The size of the buffer, beyond which the output is written anyway */
+const size_t s_bufferSize = 1 << 16;
+
+}  // namespace
+
+PipeOutputBuffer::PipeOutputBuffer(std::ostream& out)
+    : d_out(out), d_target(out.rdbuf()), d_data(s_bufferSize)
+{
+  setp(d_data.data(), d_data.data() + d_data.size());
+  d_out.rdbuf(this);
+}
+
+PipeOutputBuffer::~PipeOutputBuffer()
+{
+  flush();
+  d_out.rdbuf(d_target);
+}
+
+void PipeOutputBuffer::flush()
+{
+  writePending();
+  d_target->pubsync();
+}
+
+bool PipeOutputBuffer::writePending()
+{
+  std::streamsize n = pptr() - pbase();
+  bool ret = n == 0 || d_target->sputn(pbase(), n) == n;
+  setp(d_data.data(), d_data.data() + d_data.size());
+  return ret;
+}
+
+PipeOutputBuffer::int_type PipeOutputBuffer::overflow(int_type c)
+{
+  if (!writePending())
+  {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize PipeOutputBuffer::xsputn(const char* s, std::streamsize n)
+{
+  if (n > epptr() - pptr())
+  {
+    // large outputs, e.g. models, bypass the buffer
+    if (!writePending())
+    {
+      return 0;
+    }
+    if (n >= static_cast<std::streamsize>(d_data.size()))
+    {
+      return d_target->sputn(s, n);
+    }
+  }
+  traits_type::copy(pptr(), s, n);
+  pbump(n);
+  return n;
+}
+
+int PipeOutputBuffer::sync() { return 0; }
+
+}  // namespace main
+}  // namespace cvc5
@@ -0,0 +1,64 @@
+/*********************                                                        */
+/*! \file pipe_output.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Buffered output of the responses in pipe mode (--pipe).
+ **/
+
+#ifndef CVC4__MAIN__PIPE_OUTPUT_H
+#define CVC4__MAIN__PIPE_OUTPUT_H
+
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * A stream buffer that takes the place of the buffer of an output stream,
+ * and that writes to the original buffer only when flush is called.
+ *
+ * In particular, it ignores the synchronizations requested by std::endl and
+ * std::flush, so that the responses to a sequence of commands, which the
+ * printers end with std::endl, are written to the underlying stream (and
+ * hence to the file descriptor) at once instead of one by one.
+ */
+class PipeOutputBuffer : public std::streambuf
+{
+ public:
+  /** Install this buffer as the buffer of out */
+  PipeOutputBuffer(std::ostream& out);
+  /** Flush, and restore the original buffer of the stream */
+  ~PipeOutputBuffer();
+  /** Write the pending output to the original buffer, and synchronize it */
+  void flush();
+
+ protected:
+  int_type overflow(int_type c) override;
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+  /** Does nothing, the output is only written by flush */
+  int sync() override;
+
+ private:
+  /** Write the pending output to the original buffer */
+  bool writePending();
+  /** The stream */
+  std::ostream& d_out;
+  /** The original buffer of the stream */
+  std::streambuf* d_target;
+  /** The pending output */
+  std::vector<char> d_data;
+};
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC4__MAIN__PIPE_OUTPUT_H */
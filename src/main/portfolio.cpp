@@ -0,0 +1,375 @@
+/*********************                                                        */
+/*! \file portfolio.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Portfolio mode of the driver (--portfolio-jobs=N).
+ **/
+
+#include "main/portfolio.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "base/exception.h"
+#include "main/command_executor.h"
+#include "options/set_language.h"
+#include "parser/parser.h"
+#include "parser/parser_builder.h"
+#include "smt/command.h"
+#include "util/resource_manager.h"
+#include "util/unsafe_interrupt_exception.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/**
+ * The configurations the portfolio cycles through. Worker i uses
+ * configuration i modulo the number of configurations, on top of the options
+ * given by the user. Workers additionally get distinct SAT solver seeds, so
+ * that workers sharing a configuration still diverge.
+ */
+const std::vector<std::vector<std::pair<std::string, std::string>>>
+    s_portfolioConfigs = {
+        {},
+        {{"decision", "internal"}},
+        {{"simplification", "none"}},
+        {{"restart-int-base", "100"}},
+        {{"random-freq", "0.05"}},
+        {{"decision", "internal"}, {"simplification", "none"}},
+};
+
+/** State shared between the workers of a portfolio run. */
+class PortfolioState
+{
+ public:
+  PortfolioState(size_t njobs, bool cubes)
+      : d_executors(njobs, nullptr), d_cubes(cubes), d_winner(-1)
+  {
+  }
+  /**
+   * Called by worker i once its command executor is constructed (or, with
+   * nullptr, before it is destroyed). Interrupts it right away if a winner
+   * is already known.
+   */
+  void publish(size_t i, CommandExecutor* exec)
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_executors[i] = exec;
+    if (exec != nullptr && d_winner >= 0)
+    {
+      exec->getSmtEngine()->getResourceManager()->interrupt();
+    }
+  }
+  /**
+   * Called by worker i when it is done with a winning answer. Returns true
+   * if it is the first such worker, in which case all other workers are
+   * interrupted.
+   */
+  bool claimWin(size_t i)
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (d_winner >= 0)
+    {
+      return false;
+    }
+    d_winner = static_cast<int>(i);
+    d_done.store(true);
+    for (size_t j = 0, n = d_executors.size(); j < n; j++)
+    {
+      if (j != i && d_executors[j] != nullptr)
+      {
+        d_executors[j]->getSmtEngine()->getResourceManager()->interrupt();
+      }
+    }
+    return true;
+  }
+  /**
+   * Whether r is a winning answer. When solving cubes, only a satisfiable
+   * cube decides the problem, otherwise any definitive answer does.
+   */
+  bool isWinning(const api::Result& r) const
+  {
+    if (d_cubes)
+    {
+      return r.isSat() || r.isNotEntailed();
+    }
+    return r.isSat() || r.isUnsat() || r.isEntailed() || r.isNotEntailed();
+  }
+  /** Whether some worker has won */
+  bool isDone() const { return d_done.load(); }
+  /** The index of the winning worker, or -1 if there is none */
+  int getWinner() const { return d_winner; }
+  /**
+   * The mutex protecting the executors. Workers hold it while they execute a
+   * command that reconstructs their solver (reset), so that they are never
+   * interrupted through a stale resource manager.
+   */
+  std::mutex& getMutex() { return d_mutex; }
+
+ private:
+  std::mutex d_mutex;
+  std::vector<CommandExecutor*> d_executors;
+  /** Whether the workers solve the cubes of a cube-and-conquer run */
+  bool d_cubes;
+  int d_winner;
+  std::atomic<bool> d_done{false};
+};
+
+/**
+ * Publishes a command executor to the portfolio state for the lifetime of
+ * this object, so that it cannot be interrupted after its destruction.
+ */
+class PortfolioPublisher
+{
+ public:
+  PortfolioPublisher(PortfolioState& state, size_t i, CommandExecutor* exec)
+      : d_state(state), d_index(i)
+  {
+    d_state.publish(d_index, exec);
+  }
+  ~PortfolioPublisher() { d_state.publish(d_index, nullptr); }
+
+ private:
+  PortfolioState& d_state;
+  size_t d_index;
+};
+
+/** The outcome of a single portfolio worker. */
+struct PortfolioResult
+{
+  /** The buffered regular output */
+  std::stringstream d_out;
+  /** The buffered diagnostic output */
+  std::stringstream d_err;
+  /** Whether all commands were executed successfully */
+  bool d_status = false;
+  /** The result of the last check-sat or query */
+  api::Result d_result;
+};
+
+/**
+ * The body of portfolio worker i. Parses and executes the full input with
+ * its own solver and reports its outcome to state and res. If cubes (resp.
+ * shards, rrShards) is true, the worker solves cube i (resp. verifies the
+ * sygus candidates of shard i, checks the candidate rewrites of shard i) with
+ * the user's configuration. Workers of rrShards never win, since all shards
+ * must be checked.
+ */
+void runWorker(size_t i,
+               bool cubes,
+               bool shards,
+               bool rrShards,
+               const Options& baseOpts,
+               const std::string& filename,
+               const std::string* input,
+               PortfolioState& state,
+               PortfolioResult& res)
+{
+  Options opts;
+  opts.copyValues(baseOpts);
+  opts.setOut(&res.d_out);
+  opts.setErr(&res.d_err);
+  res.d_out << language::SetLanguage(opts.getOutputLanguage());
+  try
+  {
+    if (cubes)
+    {
+      // all workers must agree on the splitting atoms, hence they all use
+      // the user's configuration
+      opts.setOption("cube-index", std::to_string(i));
+    }
+    else if (shards)
+    {
+      // all workers must enumerate the same stream of candidates
+      opts.setOption("sygus-enum-shard", std::to_string(i));
+    }
+    else if (rrShards)
+    {
+      // all workers must use the same sample points
+      opts.setOption("sygus-rr-synth-shard", std::to_string(i));
+    }
+    else
+    {
+      const std::vector<std::pair<std::string, std::string>>& config =
+          s_portfolioConfigs[i % s_portfolioConfigs.size()];
+      for (const std::pair<std::string, std::string>& o : config)
+      {
+        opts.setOption(o.first, o.second);
+      }
+      if (i > 0)
+      {
+        opts.setOption("random-seed", std::to_string(i));
+      }
+    }
+    CommandExecutor exec(opts);
+    PortfolioPublisher publisher(state, i, &exec);
+    std::unique_ptr<Command> cmd;
+    if (!opts.wasSetByUserIncrementalSolving())
+    {
+      cmd.reset(new SetOptionCommand("incremental", "false"));
+      cmd->setMuted(true);
+      exec.doCommand(cmd);
+    }
+    parser::ParserBuilder parserBuilder(
+        exec.getSolver(), exec.getSymbolManager(), filename, opts);
+    if (input != nullptr)
+    {
+      parserBuilder.withStringInput(*input);
+    }
+    std::unique_ptr<parser::Parser> parser(parserBuilder.build());
+    bool status = true;
+    while (status && !state.isDone())
+    {
+      cmd.reset(parser->nextCommand());
+      if (cmd == nullptr)
+      {
+        break;
+      }
+      if (dynamic_cast<ResetCommand*>(cmd.get()) != nullptr)
+      {
+        std::lock_guard<std::mutex> lock(state.getMutex());
+        status = exec.doCommand(cmd);
+      }
+      else
+      {
+        status = exec.doCommand(cmd);
+      }
+      if (cmd->interrupted()
+          || dynamic_cast<QuitCommand*>(cmd.get()) != nullptr)
+      {
+        break;
+      }
+    }
+    res.d_status = status;
+    res.d_result = exec.getResult();
+    if (!rrShards && !state.isDone() && state.isWinning(res.d_result)
+        && state.claimWin(i))
+    {
+      exec.flushOutputStreams();
+    }
+  }
+  catch (UnsafeInterruptException& e)
+  {
+    res.d_status = false;
+  }
+  catch (Exception& e)
+  {
+    res.d_err << "(error \"" << e << "\")" << std::endl;
+    res.d_status = false;
+  }
+}
+
+}  // namespace
+
+bool runPortfolio(Options& opts,
+                  const std::string& filename,
+                  const std::string* input)
+{
+  bool cubes = opts.getCubeDepth() > 0;
+  bool shards = !cubes && opts.getSygusEnumShards() > 1;
+  bool rrShards = !cubes && !shards && opts.getSygusRewSynthShards() > 1;
+  size_t njobs = cubes ? (size_t(1) << opts.getCubeDepth())
+                       : (shards ? opts.getSygusEnumShards()
+                                 : (rrShards ? opts.getSygusRewSynthShards()
+                                             : opts.getPortfolioJobs()));
+  // the cubes are queued and solved by a bounded number of threads, all
+  // other modes run one thread per job
+  size_t nthreads = njobs;
+  if (cubes)
+  {
+    size_t maxThreads = opts.getPortfolioJobs() > 1
+                            ? opts.getPortfolioJobs()
+                            : std::thread::hardware_concurrency();
+    nthreads = std::min(njobs, std::max<size_t>(maxThreads, 1));
+  }
+  PortfolioState state(njobs, cubes);
+  std::vector<std::unique_ptr<PortfolioResult>> results;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < njobs; i++)
+  {
+    results.emplace_back(new PortfolioResult);
+  }
+  std::atomic<size_t> nextJob{0};
+  for (size_t t = 0; t < nthreads; t++)
+  {
+    threads.emplace_back([&]() {
+      // jobs that are not started once a winner is known keep their default
+      // (failed) result, which is never reported
+      for (size_t i = nextJob++; i < njobs && !state.isDone(); i = nextJob++)
+      {
+        runWorker(i,
+                  cubes,
+                  shards,
+                  rrShards,
+                  opts,
+                  filename,
+                  input,
+                  state,
+                  *results[i]);
+      }
+    });
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  if (rrShards)
+  {
+    // the candidate rewrites of the shards are disjoint, report all of them
+    bool status = true;
+    for (const std::unique_ptr<PortfolioResult>& r : results)
+    {
+      *opts.getOut() << r->d_out.str();
+      *opts.getErr() << r->d_err.str();
+      status = status && r->d_status;
+    }
+    opts.flushOut();
+    opts.flushErr();
+    return status;
+  }
+  int winner = state.getWinner();
+  if (winner < 0)
+  {
+    winner = 0;
+    if (cubes)
+    {
+      // the problem is only refuted if all cubes are, otherwise report a
+      // worker that failed to refute its cube
+      for (size_t i = 0; i < njobs; i++)
+      {
+        const PortfolioResult& r = *results[i];
+        if (!r.d_status || !(r.d_result.isUnsat() || r.d_result.isEntailed()))
+        {
+          winner = static_cast<int>(i);
+          break;
+        }
+      }
+    }
+  }
+  const PortfolioResult& res = *results[winner];
+  *opts.getOut() << res.d_out.str();
+  *opts.getErr() << res.d_err.str();
+  opts.flushOut();
+  opts.flushErr();
+  return res.d_status;
+}
+
+}  // namespace main
+}  // namespace cvc5
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file portfolio.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Portfolio mode of the driver (--portfolio-jobs=N).
+ **
+ ** Races several differently configured solver instances on the same input,
+ ** each in its own thread, and reports the output of the first instance that
+ ** finishes with a definitive answer. The same machinery implements the
+ ** cube-and-conquer mode (--cube-depth=N), where the instances solve the
+ ** 2^N cubes of the problem.
+ **/
+
+#ifndef CVC4__MAIN__PORTFOLIO_H
+#define CVC4__MAIN__PORTFOLIO_H
+
+#include <string>
+
+#include "options/options.h"
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * Runs the given input on opts.getPortfolioJobs() solver instances in
+ * parallel. Each instance has its own copy of opts (with a configuration
+ * specific to that instance applied on top of it), its own command executor
+ * and hence its own NodeManager and SmtEngine, and its own parser over the
+ * same input. Output of each instance is buffered. As soon as one instance
+ * has processed the full input and its last check-sat answer is definitive
+ * (i.e., not unknown), all other instances are interrupted via their
+ * resource manager and the buffered output of the winner is written to the
+ * output streams of opts. If no instance gives a definitive answer, the
+ * output of the instance with the smallest index is reported.
+ *
+ * If opts.getCubeDepth() is N > 0, 2^N instances with identical options are
+ * run instead, where instance i solves cube i (see --cube-index). The cubes
+ * are queued and at most opts.getPortfolioJobs() of them (if greater than
+ * one, otherwise the number of hardware threads) are solved at a time. The
+ * first instance that finds its cube satisfiable wins, and no further cubes
+ * are started. The problem is unsatisfiable if all instances refute their
+ * cube, in which case the output of the first instance is reported;
+ * otherwise the output of the first instance that did not refute its cube is
+ * reported.
+ *
+ * If opts.getSygusEnumShards() is N > 1, N instances with identical options
+ * are run instead, where instance i only verifies the sygus candidates of
+ * shard i (see --sygus-enum-shard). The first instance that finds a solution
+ * wins.
+ *
+ * If opts.getSygusRewSynthShards() is N > 1, N instances with identical
+ * options are run instead, where instance i only checks the candidate
+ * rewrites of shard i (see --sygus-rr-synth-shard). All instances run to
+ * completion and the outputs of all of them are reported, in order.
+ *
+ * @param opts The options given on the command line
+ * @param filename The name of the input file
+ * @param input The contents of the input if it was read from standard input,
+ * or nullptr if the input should be read from the file filename
+ * @return true if the reported instance processed all commands successfully
+ */
+bool runPortfolio(Options& opts,
+                  const std::string& filename,
+                  const std::string* input);
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC4__MAIN__PORTFOLIO_H */
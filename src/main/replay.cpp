@@ -0,0 +1,450 @@
+/*********************                                                        */
+/*! \file replay.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Driver that re-executes a trace of API calls
+ **
+ ** Driver that re-executes a trace of API calls recorded by --api-trace and
+ ** reports the time spent in each call, e.g. for comparing the performance of
+ ** two versions of CVC4 on the same sequence of API calls.
+ **/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "api/trace_format.h"
+
+using namespace cvc5::api;
+
+namespace {
+
+/** The time spent in the calls of an operation */
+struct OpTime
+{
+  OpTime() : d_count(0), d_total(0), d_max(0) {}
+  /** The number of calls */
+  size_t d_count;
+  /** The total and maximal time of a call in milliseconds */
+  double d_total;
+  double d_max;
+};
+
+/** Re-executes the calls of a trace */
+class Replayer
+{
+ public:
+  Replayer(Solver& slv) : d_slv(slv) {}
+
+  /**
+   * Execute call. Returns false if the call raised an exception, in which case
+   * a null result is assigned the id of the result of the call, so that the
+   * ids of the later results are the same as in the recorded session.
+   */
+  bool execute(const TraceCall& call, std::ostream& err)
+  {
+    try
+    {
+      executeInternal(call);
+      return true;
+    }
+    catch (const std::exception& e)
+    {
+      err << "error in " << toString(call.d_op) << ": " << e.what()
+          << std::endl;
+    }
+    switch (call.d_op)
+    {
+      case TraceOp::GET_BOOLEAN_SORT:
+      case TraceOp::GET_INTEGER_SORT:
+      case TraceOp::GET_REAL_SORT:
+      case TraceOp::GET_STRING_SORT:
+      case TraceOp::MK_BV_SORT:
+      case TraceOp::MK_ARRAY_SORT:
+      case TraceOp::MK_FUNCTION_SORT:
+      case TraceOp::MK_UNINTERPRETED_SORT:
+      case TraceOp::DECLARE_SORT: d_sorts.push_back(Sort()); break;
+      case TraceOp::MK_OP: d_ops.push_back(Op()); break;
+      case TraceOp::SET_OPTION:
+      case TraceOp::SET_LOGIC:
+      case TraceOp::ASSERT:
+      case TraceOp::CHECK_SAT:
+      case TraceOp::CHECK_SAT_ASSUMING:
+      case TraceOp::PUSH:
+      case TraceOp::POP:
+      case TraceOp::RESET_ASSERTIONS: break;
+      default: d_terms.push_back(Term()); break;
+    }
+    return false;
+  }
+
+  /** The options given on the command line, which override those recorded */
+  std::set<std::string> d_userOptions;
+
+ private:
+  void executeInternal(const TraceCall& call)
+  {
+    const std::vector<int64_t>& a = call.d_ints;
+    const std::vector<std::string>& s = call.d_strs;
+    switch (call.d_op)
+    {
+      case TraceOp::SET_OPTION:
+        if (d_userOptions.find(str(s, 0)) == d_userOptions.end())
+        {
+          d_slv.setOption(str(s, 0), str(s, 1));
+        }
+        break;
+      case TraceOp::SET_LOGIC: d_slv.setLogic(str(s, 0)); break;
+      case TraceOp::GET_BOOLEAN_SORT:
+        d_sorts.push_back(d_slv.getBooleanSort());
+        break;
+      case TraceOp::GET_INTEGER_SORT:
+        d_sorts.push_back(d_slv.getIntegerSort());
+        break;
+      case TraceOp::GET_REAL_SORT:
+        d_sorts.push_back(d_slv.getRealSort());
+        break;
+      case TraceOp::GET_STRING_SORT:
+        d_sorts.push_back(d_slv.getStringSort());
+        break;
+      case TraceOp::MK_BV_SORT:
+        d_sorts.push_back(d_slv.mkBitVectorSort(num(a, 0)));
+        break;
+      case TraceOp::MK_ARRAY_SORT:
+        d_sorts.push_back(d_slv.mkArraySort(sort(a, 0), sort(a, 1)));
+        break;
+      case TraceOp::MK_FUNCTION_SORT:
+      {
+        std::vector<Sort> dom = sorts(a, 0, a.size() - 1);
+        d_sorts.push_back(d_slv.mkFunctionSort(dom, sort(a, a.size() - 1)));
+        break;
+      }
+      case TraceOp::MK_UNINTERPRETED_SORT:
+        d_sorts.push_back(d_slv.mkUninterpretedSort(str(s, 0)));
+        break;
+      case TraceOp::DECLARE_SORT:
+        d_sorts.push_back(d_slv.declareSort(str(s, 0), num(a, 0)));
+        break;
+      case TraceOp::MK_BOOLEAN:
+        d_terms.push_back(d_slv.mkBoolean(num(a, 0) != 0));
+        break;
+      case TraceOp::MK_INTEGER:
+        d_terms.push_back(d_slv.mkInteger(str(s, 0)));
+        break;
+      case TraceOp::MK_REAL: d_terms.push_back(d_slv.mkReal(str(s, 0))); break;
+      case TraceOp::MK_STRING:
+        d_terms.push_back(d_slv.mkString(str(s, 0), num(a, 0) != 0));
+        break;
+      case TraceOp::MK_BV:
+        d_terms.push_back(d_slv.mkBitVector(num(a, 0), str(s, 0), 10));
+        break;
+      case TraceOp::MK_CONST:
+        d_terms.push_back(s.empty() ? d_slv.mkConst(sort(a, 0))
+                                    : d_slv.mkConst(sort(a, 0), str(s, 0)));
+        break;
+      case TraceOp::MK_VAR:
+        d_terms.push_back(d_slv.mkVar(sort(a, 0), str(s, 0)));
+        break;
+      case TraceOp::DECLARE_FUN:
+      {
+        std::vector<Sort> dom = sorts(a, 0, a.size() - 1);
+        d_terms.push_back(
+            d_slv.declareFun(str(s, 0), dom, sort(a, a.size() - 1)));
+        break;
+      }
+      case TraceOp::MK_TERM:
+      {
+        Kind k = static_cast<Kind>(num(a, 0));
+        d_terms.push_back(a.size() == 1
+                              ? d_slv.mkTerm(k)
+                              : d_slv.mkTerm(k, terms(a, 1, a.size())));
+        break;
+      }
+      case TraceOp::MK_OP: d_ops.push_back(mkOp(a, s)); break;
+      case TraceOp::MK_TERM_OP:
+      {
+        Op op = get(d_ops, a, 0);
+        d_terms.push_back(a.size() == 1
+                              ? d_slv.mkTerm(op)
+                              : d_slv.mkTerm(op, terms(a, 1, a.size())));
+        break;
+      }
+      case TraceOp::DEFINE_FUN:
+        d_terms.push_back(d_slv.defineFun(str(s, 0),
+                                          terms(a, 3, a.size()),
+                                          sort(a, 0),
+                                          term(a, 1),
+                                          num(a, 2) != 0));
+        break;
+      case TraceOp::ASSERT: d_slv.assertFormula(term(a, 0)); break;
+      case TraceOp::CHECK_SAT:
+        std::cout << d_slv.checkSat() << std::endl;
+        break;
+      case TraceOp::CHECK_SAT_ASSUMING:
+        std::cout << d_slv.checkSatAssuming(terms(a, 0, a.size()))
+                  << std::endl;
+        break;
+      case TraceOp::PUSH: d_slv.push(num(a, 0)); break;
+      case TraceOp::POP: d_slv.pop(num(a, 0)); break;
+      case TraceOp::RESET_ASSERTIONS: d_slv.resetAssertions(); break;
+      case TraceOp::GET_VALUE:
+        d_terms.push_back(d_slv.getValue(term(a, 0)));
+        break;
+      case TraceOp::SIMPLIFY:
+        d_terms.push_back(d_slv.simplify(term(a, 0)));
+        break;
+      default: throw std::invalid_argument("unknown operation");
+    }
+  }
+
+  Op mkOp(const std::vector<int64_t>& a, const std::vector<std::string>& s)
+  {
+    Kind k = static_cast<Kind>(num(a, 0));
+    if (k == TUPLE_PROJECT)
+    {
+      std::vector<uint32_t> args;
+      for (size_t i = 1; i < a.size(); i++)
+      {
+        args.push_back(num(a, i));
+      }
+      return d_slv.mkOp(k, args);
+    }
+    if (!s.empty())
+    {
+      return d_slv.mkOp(k, str(s, 0));
+    }
+    switch (a.size())
+    {
+      case 1: return d_slv.mkOp(k);
+      case 2: return d_slv.mkOp(k, num(a, 1));
+      case 3: return d_slv.mkOp(k, num(a, 1), num(a, 2));
+      default: throw std::invalid_argument("unexpected operator indices");
+    }
+  }
+
+  static const std::string& str(const std::vector<std::string>& s, size_t i)
+  {
+    if (i >= s.size())
+    {
+      throw std::invalid_argument("missing string argument");
+    }
+    return s[i];
+  }
+
+  static uint32_t num(const std::vector<int64_t>& a, size_t i)
+  {
+    if (i >= a.size())
+    {
+      throw std::invalid_argument("missing integer argument");
+    }
+    return static_cast<uint32_t>(a[i]);
+  }
+
+  template <class T>
+  static const T& get(const std::vector<T>& v,
+                      const std::vector<int64_t>& a,
+                      size_t i)
+  {
+    if (i >= a.size() || a[i] < 0 || static_cast<size_t>(a[i]) >= v.size())
+    {
+      throw std::invalid_argument("unknown id");
+    }
+    return v[a[i]];
+  }
+
+  const Term& term(const std::vector<int64_t>& a, size_t i) const
+  {
+    return get(d_terms, a, i);
+  }
+
+  const Sort& sort(const std::vector<int64_t>& a, size_t i) const
+  {
+    return get(d_sorts, a, i);
+  }
+
+  std::vector<Term> terms(const std::vector<int64_t>& a,
+                          size_t begin,
+                          size_t end) const
+  {
+    std::vector<Term> res;
+    for (size_t i = begin; i < end; i++)
+    {
+      res.push_back(term(a, i));
+    }
+    return res;
+  }
+
+  std::vector<Sort> sorts(const std::vector<int64_t>& a,
+                          size_t begin,
+                          size_t end) const
+  {
+    std::vector<Sort> res;
+    for (size_t i = begin; i < end; i++)
+    {
+      res.push_back(sort(a, i));
+    }
+    return res;
+  }
+
+  /** The solver */
+  Solver& d_slv;
+  /** The results of the calls, by id */
+  std::vector<Term> d_terms;
+  std::vector<Sort> d_sorts;
+  std::vector<Op> d_ops;
+};
+
+void printUsage(const char* binary)
+{
+  std::cerr << "usage: " << binary
+            << " [--times] [--slow=MS] [--opt=NAME=VALUE]... TRACE" << std::endl
+            << std::endl
+            << "Re-executes the API calls recorded by --api-trace in TRACE, "
+               "prints the results"
+            << std::endl
+            << "of the checks to stdout and a summary of the time spent in "
+               "each operation to"
+            << std::endl
+            << "stderr." << std::endl
+            << std::endl
+            << "  --times            print the time of each call" << std::endl
+            << "  --slow=MS          print the calls that take at least MS "
+               "milliseconds"
+            << std::endl
+            << "  --opt=NAME=VALUE   set option NAME to VALUE, overriding the "
+               "recorded value"
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  bool times = false;
+  double slow = -1;
+  std::vector<std::pair<std::string, std::string>> opts;
+  const char* filename = nullptr;
+  for (int i = 1; i < argc; i++)
+  {
+    if (std::strcmp(argv[i], "--times") == 0)
+    {
+      times = true;
+    }
+    else if (std::strncmp(argv[i], "--slow=", 7) == 0)
+    {
+      slow = std::atof(argv[i] + 7);
+    }
+    else if (std::strncmp(argv[i], "--opt=", 6) == 0)
+    {
+      std::string opt(argv[i] + 6);
+      size_t pos = opt.find('=');
+      if (pos == std::string::npos)
+      {
+        printUsage(argv[0]);
+        return 1;
+      }
+      opts.emplace_back(opt.substr(0, pos), opt.substr(pos + 1));
+    }
+    else if (argv[i][0] != '-' && filename == nullptr)
+    {
+      filename = argv[i];
+    }
+    else
+    {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (filename == nullptr)
+  {
+    printUsage(argv[0]);
+    return 1;
+  }
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  TraceReader reader(in);
+  if (!in || !reader.isValid())
+  {
+    std::cerr << "cannot read trace file: " << filename << std::endl;
+    return 1;
+  }
+
+  Solver slv;
+  Replayer replayer(slv);
+  try
+  {
+    for (const std::pair<std::string, std::string>& opt : opts)
+    {
+      slv.setOption(opt.first, opt.second);
+      replayer.d_userOptions.insert(opt.first);
+    }
+  }
+  catch (const CVC4ApiException& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  std::map<TraceOp, OpTime> summary;
+  TraceCall call;
+  size_t ncalls = 0, nerrors = 0;
+  std::cerr << std::fixed << std::setprecision(3);
+  while (reader.read(call))
+  {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    if (!replayer.execute(call, std::cerr))
+    {
+      nerrors++;
+    }
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    if (times || (slow >= 0 && ms >= slow))
+    {
+      std::cerr << "call " << ncalls << " " << toString(call.d_op) << ": " << ms
+                << " ms" << std::endl;
+    }
+    OpTime& ot = summary[call.d_op];
+    ot.d_count++;
+    ot.d_total += ms;
+    ot.d_max = std::max(ot.d_max, ms);
+    ncalls++;
+  }
+  if (!reader.isValid())
+  {
+    std::cerr << "truncated or malformed trace after call " << ncalls
+              << std::endl;
+  }
+
+  double total = 0;
+  std::cerr << std::left << std::setw(22) << "operation" << std::right
+            << std::setw(10) << "calls" << std::setw(14) << "total ms"
+            << std::setw(12) << "max ms" << std::endl;
+  for (const std::pair<const TraceOp, OpTime>& st : summary)
+  {
+    std::cerr << std::left << std::setw(22) << toString(st.first) << std::right
+              << std::setw(10) << st.second.d_count << std::setw(14)
+              << st.second.d_total << std::setw(12) << st.second.d_max
+              << std::endl;
+    total += st.second.d_total;
+  }
+  std::cerr << ncalls << " calls, " << nerrors << " errors, " << total
+            << " ms" << std::endl;
+  return nerrors > 0 || !reader.isValid() ? 1 : 0;
+}
@@ -0,0 +1,231 @@
+/*********************                                                        */
+/*! \file server.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Server mode of the driver (--server=ADDR).
+ **/
+
+#include "main/server.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "base/exception.h"
+#include "base/output.h"
+#include "main/command_executor.h"
+#include "options/set_language.h"
+#include "parser/parser.h"
+#include "parser/parser_builder.h"
+#include "smt/command.h"
+#include "util/unsafe_interrupt_exception.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/** Throws an Exception for the failed system call what */
+void throwSystemError(const std::string& what)
+{
+  throw Exception("server: " + what + " failed: " + std::strerror(errno));
+}
+
+/** Opens a socket listening on address, see runServer() */
+int openSocket(const std::string& address)
+{
+  bool tcp = !address.empty()
+             && address.find_first_not_of("0123456789") == std::string::npos;
+  int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    throwSystemError("socket");
+  }
+  int res;
+  if (tcp)
+  {
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    unsigned long port = std::stoul(address);
+    if (port > 65535)
+    {
+      throw Exception("server: invalid port " + address);
+    }
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    res = bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+  else
+  {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    if (address.empty() || address.size() >= sizeof(addr.sun_path))
+    {
+      throw Exception("server: invalid socket path " + address);
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, address.c_str(), address.size());
+    // remove the socket of a previous run
+    unlink(address.c_str());
+    res = bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+  if (res < 0)
+  {
+    throwSystemError("bind");
+  }
+  if (listen(fd, SOMAXCONN) < 0)
+  {
+    throwSystemError("listen");
+  }
+  return fd;
+}
+
+/** Reads from fd until the end of the stream into request */
+bool readRequest(int fd, std::string& request)
+{
+  char buf[1 << 16];
+  while (true)
+  {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n == 0)
+    {
+      return true;
+    }
+    if (n < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    request.append(buf, n);
+  }
+}
+
+/** Writes response to fd, as far as the client accepts it */
+void writeResponse(int fd, const std::string& response)
+{
+  size_t pos = 0;
+  while (pos < response.size())
+  {
+    // the client may have gone away, which must not kill the server
+    ssize_t n =
+        send(fd, response.data() + pos, response.size() - pos, MSG_NOSIGNAL);
+    if (n < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return;
+    }
+    pos += n;
+  }
+}
+
+/**
+ * Serves the request of the connection fd with a fresh solver whose options
+ * are a copy of baseOpts, and closes the connection.
+ */
+void serveRequest(const Options& baseOpts, int fd)
+{
+  std::string request;
+  if (!readRequest(fd, request))
+  {
+    close(fd);
+    return;
+  }
+  std::stringstream out;
+  Options opts;
+  opts.copyValues(baseOpts);
+  opts.setOut(&out);
+  opts.setErr(&out);
+  out << language::SetLanguage(opts.getOutputLanguage());
+  try
+  {
+    CommandExecutor exec(opts);
+    std::unique_ptr<Command> cmd;
+    if (!opts.wasSetByUserIncrementalSolving())
+    {
+      cmd.reset(new SetOptionCommand("incremental", "false"));
+      cmd->setMuted(true);
+      exec.doCommand(cmd);
+    }
+    parser::ParserBuilder parserBuilder(
+        exec.getSolver(), exec.getSymbolManager(), "<request>", opts);
+    parserBuilder.withStringInput(request);
+    std::unique_ptr<parser::Parser> parser(parserBuilder.build());
+    bool status = true;
+    while (status)
+    {
+      cmd.reset(parser->nextCommand());
+      if (cmd == nullptr)
+      {
+        break;
+      }
+      status = exec.doCommand(cmd);
+      if (cmd->interrupted()
+          || dynamic_cast<QuitCommand*>(cmd.get()) != nullptr)
+      {
+        break;
+      }
+    }
+    // prints the statistics of this request if they are enabled
+    exec.flushOutputStreams();
+  }
+  catch (UnsafeInterruptException& e)
+  {
+    out << CommandInterrupted();
+  }
+  catch (Exception& e)
+  {
+    out << "(error \"" << e << "\")" << std::endl;
+  }
+  writeResponse(fd, out.str());
+  close(fd);
+}
+
+}  // namespace
+
+void runServer(Options& opts)
+{
+  int fd = openSocket(opts.getServer());
+  Chat() << "server: listening on " << opts.getServer() << std::endl;
+  while (true)
+  {
+    int conn = accept(fd, nullptr, nullptr);
+    if (conn < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+      {
+        continue;
+      }
+      throwSystemError("accept");
+    }
+    // the options outlive the thread, since this loop never ends normally
+    std::thread(serveRequest, std::cref(opts), conn).detach();
+  }
+}
+
+}  // namespace main
+}  // namespace cvc5
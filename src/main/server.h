@@ -0,0 +1,49 @@
+/*********************                                                        */
+/*! \file server.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Server mode of the driver (--server=ADDR).
+ **
+ ** Serves SMT-LIB 2 scripts over a socket from a long-lived process, so that
+ ** the start up of the process is paid once rather than for each script.
+ **/
+
+#ifndef CVC4__MAIN__SERVER_H
+#define CVC4__MAIN__SERVER_H
+
+#include "options/options.h"
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * Listens on the socket given by opts.getServer() and serves each connection
+ * as a request. The address is either a TCP port, which is bound on the
+ * loopback interface only, or the path of a unix socket.
+ *
+ * A request is the script sent by the client until it shuts down its side
+ * of the connection. The script is run by a fresh solver with its own copy
+ * of opts, as if it were the input file of a separate invocation, so that no
+ * state is shared between requests. The output of the solver, followed by
+ * its statistics if statistics are enabled, is sent back as the response,
+ * after which the connection is closed. Requests are served concurrently,
+ * each on its own thread.
+ *
+ * This function only returns by throwing an Exception, e.g., if the socket
+ * cannot be opened.
+ *
+ * @param opts The options given on the command line
+ */
+void runServer(Options& opts);
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC4__MAIN__SERVER_H */
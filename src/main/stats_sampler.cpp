@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file stats_sampler.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Periodic snapshots of the statistics (--stats-snapshot-interval).
+ **/
+
+#include "main/stats_sampler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "smt/smt_engine.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/** Write s as a JSON string */
+void writeJsonString(std::ostream& out, const std::string& s)
+{
+  out << '"';
+  for (char c : s)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+/** Write s as a Prometheus metric name */
+void writeMetricName(std::ostream& out, const std::string& s)
+{
+  out << "cvc4_";
+  for (char c : s)
+  {
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                 || (c >= '0' && c <= '9') || c == '_';
+    out << (valid ? c : '_');
+  }
+}
+
+}  // namespace
+
+StatsSampler::StatsSampler(const Options& opts, SmtEngine* smt)
+    : d_smt(smt),
+      d_interval(opts.getStatsSnapshotInterval()),
+      d_file(opts.getStatsSnapshotFile()),
+      d_json(opts.getStatsSnapshotJson()),
+      d_stop(false)
+{
+  d_thread = std::thread(&StatsSampler::run, this);
+}
+
+StatsSampler::~StatsSampler()
+{
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_stop = true;
+  }
+  d_cv.notify_one();
+  d_thread.join();
+  write();
+}
+
+void StatsSampler::run()
+{
+  std::unique_lock<std::mutex> lock(d_mutex);
+  while (!d_cv.wait_for(lock, d_interval, [this]() { return d_stop; }))
+  {
+    write();
+  }
+}
+
+void StatsSampler::write()
+{
+  std::vector<std::pair<std::string, int64_t>> values;
+  d_smt->snapshotStatistics(values);
+  std::stringstream ss;
+  if (d_json)
+  {
+    ss << "{";
+    for (size_t i = 0, nvalues = values.size(); i < nvalues; i++)
+    {
+      ss << (i == 0 ? "" : ", ");
+      writeJsonString(ss, values[i].first);
+      ss << ": " << values[i].second;
+    }
+    ss << "}" << std::endl;
+  }
+  else
+  {
+    for (const std::pair<std::string, int64_t>& v : values)
+    {
+      writeMetricName(ss, v.first);
+      ss << " " << v.second << std::endl;
+    }
+  }
+  if (d_file.empty())
+  {
+    std::cerr << ss.str() << std::flush;
+    return;
+  }
+  // write to a temporary file first, so that the file is replaced atomically
+  std::string tmp = d_file + ".tmp";
+  {
+    std::ofstream out(tmp);
+    out << ss.str();
+  }
+  std::rename(tmp.c_str(), d_file.c_str());
+}
+
+}  // namespace main
+}  // namespace cvc5
@@ -0,0 +1,82 @@
+/*********************                                                        */
+/*! \file stats_sampler.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Periodic snapshots of the statistics (--stats-snapshot-interval).
+ **
+ ** Writes the integer statistics of a solver while it runs, e.g. for a
+ ** monitoring system that polls the file of the snapshots.
+ **/
+
+#ifndef CVC4__MAIN__STATS_SAMPLER_H
+#define CVC4__MAIN__STATS_SAMPLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "options/options.h"
+
+namespace cvc5 {
+
+class SmtEngine;
+
+namespace main {
+
+/**
+ * Writes a snapshot of the statistics of an SmtEngine (see
+ * SmtEngine::snapshotStatistics) every opts.getStatsSnapshotInterval()
+ * milliseconds on a separate thread, so that the solver is not paused.
+ *
+ * The snapshot is written in the Prometheus text format, i.e. one line
+ * "cvc4_<name> <value>" per statistic, where the characters of the name that
+ * are not allowed in metric names are replaced by underscores, or as a JSON
+ * object mapping the names to the values if opts.getStatsSnapshotJson() is
+ * true. If opts.getStatsSnapshotFile() is not empty, each snapshot replaces
+ * that file atomically, so that readers never see a partial snapshot;
+ * otherwise it is written to std::cerr, which may be used concurrently.
+ */
+class StatsSampler
+{
+ public:
+  /** Start writing snapshots of smt, which must outlive this object */
+  StatsSampler(const Options& opts, SmtEngine* smt);
+  /** Stop the thread, after writing a last snapshot */
+  ~StatsSampler();
+
+ private:
+  /** The loop of the thread */
+  void run();
+  /** Write a snapshot */
+  void write();
+  /** The SmtEngine whose statistics are written */
+  SmtEngine* d_smt;
+  /** The time between snapshots */
+  std::chrono::milliseconds d_interval;
+  /** The file the snapshots are written to */
+  std::string d_file;
+  /** Whether to write JSON */
+  bool d_json;
+  /** Protects d_stop */
+  std::mutex d_mutex;
+  /** Notified when d_stop is set */
+  std::condition_variable d_cv;
+  /** Whether the thread should stop */
+  bool d_stop;
+  /** The thread writing the snapshots */
+  std::thread d_thread;
+};
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC4__MAIN__STATS_SAMPLER_H */
@@ -19,17 +19,47 @@
 
 
 #include <cerrno>
+#include <fstream>
 #include <iostream>
 #include <ostream>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "lib/strtok_r.h"
 #include "options/parser_options.h"
 
 namespace cvc5 {
 
+namespace {
+
+/**
+ * A file output stream with a large buffer, which reduces the number of
+ * writes to the file when printing large outputs, e.g. dumps of models or
+ * of preprocessed assertions.
+ */
+class BufferedOfstream : public std::ofstream
+{
+ public:
+  BufferedOfstream(const std::string& filename) : d_buf(s_bufferSize)
+  {
+    // the buffer must be set before opening the file
+    rdbuf()->pubsetbuf(d_buf.data(), d_buf.size());
+    open(filename.c_str(), std::ofstream::out | std::ofstream::trunc);
+  }
+  /** Closes the file, which flushes the buffer before it is deallocated */
+  ~BufferedOfstream() { close(); }
+
+ private:
+  /** The size of the buffer */
+  static const size_t s_bufferSize = 1 << 20;
+  /** The buffer */
+  std::vector<char> d_buf;
+};
+
+}  // namespace
+
 OstreamOpener::OstreamOpener(const char* channelName)
     : d_channelName(channelName)
     , d_specialCases()
@@ -55,8 +85,7 @@ std::pair< bool, std::ostream* > OstreamOpener::open(const std::string& optarg)
   } else {
     errno = 0;
     std::ostream* outStream;
-    outStream = new std::ofstream(optarg.c_str(),
-                                    std::ofstream::out | std::ofstream::trunc);
+    outStream = new BufferedOfstream(optarg);
     if(outStream == NULL || !*outStream) {
       std::stringstream ss;
       ss << "Cannot open " << d_channelName << " file: `"
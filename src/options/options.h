@@ -170,11 +170,22 @@ public:
   bool getProduceModels() const;
   bool getSegvSpin() const;
   bool getSemanticChecks() const;
+  bool getSmt2FastParser() const;
+  unsigned getSmt2FastParserThreads() const;
   bool getStatistics() const;
   bool getStatsEveryQuery() const;
   bool getStatsHideZeros() const;
   bool getStrictParsing() const;
   int getTearDownIncremental() const;
+  unsigned getPortfolioJobs() const;
+  const std::string& getServer() const;
+  bool getPipe() const;
+  unsigned getStatsSnapshotInterval() const;
+  const std::string& getStatsSnapshotFile() const;
+  bool getStatsSnapshotJson() const;
+  unsigned getCubeDepth() const;
+  unsigned getSygusEnumShards() const;
+  unsigned getSygusRewSynthShards() const;
   unsigned long getCumulativeTimeLimit() const;
   bool getVersion() const;
   const std::string& getForceLogicString() const;
@@ -190,6 +201,7 @@ public:
   void setInputLanguage(InputLanguage);
   void setInteractive(bool);
   void setOut(std::ostream*);
+  void setErr(std::ostream*);
   void setOutputLanguage(OutputLanguage);
 
   bool wasSetByUserEarlyExit() const;
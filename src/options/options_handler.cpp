@@ -115,6 +115,19 @@ void OptionsHandler::abcEnabledBuild(std::string option, std::string value)
 #endif /* CVC4_USE_ABC */
 }
 
+void OptionsHandler::checkCDCLTSatSolver(std::string option,
+                                         CDCLTSatSolverMode m)
+{
+  if (m == CDCLTSatSolverMode::CADICAL && !Configuration::isBuiltWithCadical())
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "' requires a CaDiCaL build of CVC4; this binary was not built with "
+          "CaDiCaL support";
+    throw OptionException(ss.str());
+  }
+}
+
 void OptionsHandler::checkBvSatSolver(std::string option, SatSolverMode m)
 {
   if (m == SatSolverMode::CRYPTOMINISAT
@@ -28,6 +28,7 @@
 #include "options/language.h"
 #include "options/option_exception.h"
 #include "options/printer_modes.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 
 namespace cvc5 {
@@ -53,6 +54,11 @@ public:
     options::less_equal(2)(option, value);
   }
 
+  /** The driver solves 2^N cubes, hence N is bounded */
+  void checkCubeDepth(const std::string& option, unsigned value) {
+    options::less_equal(16)(option, value);
+  }
+
   void doubleGreaterOrEqual0(const std::string& option, double value) {
     options::greater_equal(0.0)(option, value);
   }
@@ -75,6 +81,9 @@ public:
 
   void setBitblastAig(std::string option, bool arg);
 
+  // prop/options_handlers.h
+  void checkCDCLTSatSolver(std::string option, CDCLTSatSolverMode m);
+
   // printer/options_handlers.h
   InstFormatMode stringToInstFormatMode(std::string option, std::string optarg);
 
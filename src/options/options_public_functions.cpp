@@ -32,6 +32,7 @@
 #include "options/parser_options.h"
 #include "options/printer_modes.h"
 #include "options/printer_options.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "options/uf_options.h"
@@ -124,6 +125,11 @@ bool Options::getSemanticChecks() const{
   return (*this)[options::semanticChecks];
 }
 
+bool Options::getSmt2FastParser() const
+{
+  return (*this)[options::smt2FastParser];
+}
+
 bool Options::getStatistics() const{
   // statsEveryQuery enables stats
   return (*this)[options::statistics] || (*this)[options::statsEveryQuery];
@@ -145,6 +151,50 @@ int Options::getTearDownIncremental() const{
   return (*this)[options::tearDownIncremental];
 }
 
+unsigned Options::getPortfolioJobs() const
+{
+  return (*this)[options::portfolioJobs];
+}
+
+const std::string& Options::getServer() const
+{
+  return (*this)[options::server];
+}
+
+bool Options::getPipe() const { return (*this)[options::pipe]; }
+
+unsigned Options::getStatsSnapshotInterval() const
+{
+  return (*this)[options::statsSnapshotInterval];
+}
+
+const std::string& Options::getStatsSnapshotFile() const
+{
+  return (*this)[options::statsSnapshotFile];
+}
+
+bool Options::getStatsSnapshotJson() const
+{
+  return (*this)[options::statsSnapshotJson];
+}
+
+unsigned Options::getCubeDepth() const { return (*this)[options::cubeDepth]; }
+
+unsigned Options::getSygusEnumShards() const
+{
+  return (*this)[options::sygusEnumShards];
+}
+
+unsigned Options::getSygusRewSynthShards() const
+{
+  return (*this)[options::sygusRewSynthShards];
+}
+
+unsigned Options::getSmt2FastParserThreads() const
+{
+  return (*this)[options::smt2FastParserThreads];
+}
+
 unsigned long Options::getCumulativeTimeLimit() const {
   return (*this)[options::cumulativeMillisecondLimit];
 }
@@ -205,6 +255,8 @@ void Options::setOut(std::ostream* value) {
   set(options::out, value);
 }
 
+void Options::setErr(std::ostream* value) { set(options::err, value); }
+
 void Options::setOutputLanguage(OutputLanguage value) {
   set(options::outputLanguage, value);
 }
@@ -18,6 +18,7 @@
 #include "parser/parser_builder.h"
 
 #include <string>
+#include <utility>
 
 #include "api/cvc4cpp.h"
 #include "base/check.h"
@@ -27,6 +28,7 @@
 #include "parser/input.h"
 #include "parser/parser.h"
 #include "smt2/smt2.h"
+#include "smt2/smt2_fast_input.h"
 #include "tptp/tptp.h"
 
 namespace cvc5 {
@@ -58,12 +60,16 @@ void ParserBuilder::init(api::Solver* solver,
   d_lang = language::input::LANG_AUTO;
   d_filename = filename;
   d_streamInput = NULL;
+  d_pipeInput = -1;
+  d_pipeOnIdle = nullptr;
   d_solver = solver;
   d_symman = sm;
   d_checksEnabled = true;
   d_strictMode = false;
   d_canIncludeFile = true;
   d_mmap = false;
+  d_smt2FastParser = false;
+  d_smt2FastParserThreads = 1;
   d_parseOnly = false;
   d_logicIsForced = false;
   d_forcedLogic = "";
@@ -72,21 +78,62 @@ void ParserBuilder::init(api::Solver* solver,
 Parser* ParserBuilder::build()
 {
   Input* input = NULL;
-  switch( d_inputType ) {
-  case FILE_INPUT:
-    input = Input::newFileInput(d_lang, d_filename, d_mmap);
-    break;
-  case LINE_BUFFERED_STREAM_INPUT:
-    Assert(d_streamInput != NULL);
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
-    break;
-  case STREAM_INPUT:
-    Assert(d_streamInput != NULL);
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
-    break;
-  case STRING_INPUT:
-    input = Input::newStringInput(d_lang, d_stringInput, d_filename);
-    break;
+  bool isSmt2 = language::isInputLang_smt2(d_lang)
+                && !language::isInputLangSygus(d_lang);
+  if (d_inputType == PIPE_INPUT)
+  {
+    if (!isSmt2)
+    {
+      throw InputStreamException("Pipe input is only supported for SMT-LIB 2");
+    }
+    Smt2FastInputStream* inputStream = Smt2FastInputStream::newPipeInputStream(
+        d_pipeInput, d_pipeOnIdle, d_filename);
+    input = new Smt2FastInput(*inputStream);
+  }
+  else if (d_smt2FastParser && d_inputType != LINE_BUFFERED_STREAM_INPUT
+           && isSmt2)
+  {
+    Smt2FastInputStream* inputStream = NULL;
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        inputStream =
+            Smt2FastInputStream::newFileInputStream(d_filename, d_mmap);
+        break;
+      case STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        inputStream = Smt2FastInputStream::newStreamInputStream(*d_streamInput,
+                                                                d_filename);
+        break;
+      case STRING_INPUT:
+        inputStream = Smt2FastInputStream::newStringInputStream(d_stringInput,
+                                                                d_filename);
+        break;
+      default: Unreachable();
+    }
+    input = new Smt2FastInput(*inputStream, d_smt2FastParserThreads);
+  }
+  else
+  {
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        input = Input::newFileInput(d_lang, d_filename, d_mmap);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        input =
+            Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
+        break;
+      case STREAM_INPUT:
+        Assert(d_streamInput != NULL);
+        input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
+        break;
+      case STRING_INPUT:
+        input = Input::newStringInput(d_lang, d_stringInput, d_filename);
+        break;
+      default: Unreachable();
+    }
   }
 
   Assert(input != NULL);
@@ -162,6 +209,18 @@ ParserBuilder& ParserBuilder::withMmap(bool flag) {
   return *this;
 }
 
+ParserBuilder& ParserBuilder::withSmt2FastParser(bool flag)
+{
+  d_smt2FastParser = flag;
+  return *this;
+}
+
+ParserBuilder& ParserBuilder::withSmt2FastParserThreads(unsigned n)
+{
+  d_smt2FastParserThreads = n;
+  return *this;
+}
+
 ParserBuilder& ParserBuilder::withParseOnly(bool flag) {
   d_parseOnly = flag;
   return *this;
@@ -172,6 +231,8 @@ ParserBuilder& ParserBuilder::withOptions(const Options& options) {
   retval =
       retval.withInputLanguage(options.getInputLanguage())
       .withMmap(options.getMemoryMap())
+      .withSmt2FastParser(options.getSmt2FastParser())
+      .withSmt2FastParserThreads(options.getSmt2FastParserThreads())
       .withChecks(options.getSemanticChecks())
       .withStrictMode(options.getStrictParsing())
       .withParseOnly(options.getParseOnly())
@@ -217,5 +278,14 @@ ParserBuilder& ParserBuilder::withStringInput(const std::string& input) {
   return *this;
 }
 
+ParserBuilder& ParserBuilder::withPipeInput(int fd,
+                                            std::function<void()> onIdle)
+{
+  d_inputType = PIPE_INPUT;
+  d_pipeInput = fd;
+  d_pipeOnIdle = std::move(onIdle);
+  return *this;
+}
+
 }  // namespace parser
 }  // namespace cvc5
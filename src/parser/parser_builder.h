@@ -19,6 +19,7 @@
 #ifndef CVC4__PARSER__PARSER_BUILDER_H
 #define CVC4__PARSER__PARSER_BUILDER_H
 
+#include <functional>
 #include <string>
 
 #include "cvc4_export.h"
@@ -49,7 +50,8 @@ class CVC4_EXPORT ParserBuilder
     FILE_INPUT,
     LINE_BUFFERED_STREAM_INPUT,
     STREAM_INPUT,
-    STRING_INPUT
+    STRING_INPUT,
+    PIPE_INPUT
   };
 
   /** The input type. */
@@ -67,6 +69,12 @@ class CVC4_EXPORT ParserBuilder
   /** The stream input, if any. */
   std::istream* d_streamInput;
 
+  /** The file descriptor of the pipe input, if any. */
+  int d_pipeInput;
+
+  /** The function called before waiting for the pipe input, if any. */
+  std::function<void()> d_pipeOnIdle;
+
   /** The API Solver object. */
   api::Solver* d_solver;
 
@@ -85,6 +93,12 @@ class CVC4_EXPORT ParserBuilder
   /** Should we memory-map a file input? */
   bool d_mmap;
 
+  /** Should we use the hand-written parser for SMT-LIB 2 inputs? */
+  bool d_smt2FastParser;
+
+  /** The number of threads used by the hand-written parser for lexing */
+  unsigned d_smt2FastParserThreads;
+
   /** Are we parsing only? */
   bool d_parseOnly;
 
@@ -145,6 +159,23 @@ class CVC4_EXPORT ParserBuilder
    */
   ParserBuilder& withMmap(bool flag = true);
 
+  /**
+   * Should the parser use the hand-written parser Smt2FastInput? This is only
+   * relevant if the input language is a version of SMT-LIB 2 (but not SyGuS)
+   * and the input is not line-buffered.
+   *
+   * (Default: no)
+   */
+  ParserBuilder& withSmt2FastParser(bool flag = true);
+
+  /**
+   * The number of threads used by the hand-written parser Smt2FastInput to
+   * lex the input ahead of parsing.
+   *
+   * (Default: 1)
+   */
+  ParserBuilder& withSmt2FastParserThreads(unsigned n);
+
   /**
    * Are we only parsing, or doing something with the resulting
    * commands and expressions?  This setting affects whether the
@@ -184,6 +215,16 @@ class CVC4_EXPORT ParserBuilder
   /** Set the parser to use the given string for its input. */
   ParserBuilder& withStringInput(const std::string& input);
 
+  /**
+   * Set the parser to use the given pipe (file descriptor) for its input,
+   * which is read one command at a time by the hand-written parser
+   * Smt2FastInput, so that each command is parsed as soon as it is received.
+   * The function onIdle, if given, is called whenever the parser is about to
+   * wait for more input, e.g. to flush the responses. This is only supported
+   * for the versions of SMT-LIB 2 (but not SyGuS).
+   */
+  ParserBuilder& withPipeInput(int fd, std::function<void()> onIdle = nullptr);
+
   /** Set the parser to use the given logic string. */
   ParserBuilder& withForcedLogic(const std::string& logic);
 }; /* class ParserBuilder */
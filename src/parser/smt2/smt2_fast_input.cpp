@@ -0,0 +1,1632 @@
+/*********************                                                        */
+/*! \file smt2_fast_input.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of a hand-written parser for SMT-LIB 2
+ **/
+
+#include "parser/smt2/smt2_fast_input.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* ! _WIN32 */
+
+#include <cctype>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "parser/smt2/smt2.h"
+#include "smt/command.h"
+#include "util/floatingpoint_size.h"
+
+namespace cvc5 {
+namespace parser {
+
+namespace {
+
+/**
+ * Is s the name of a command that is supported by the default parser, but not
+ * by this one?
+ */
+bool isDefaultParserCommand(std::string_view s)
+{
+  static const std::unordered_set<std::string_view> cmds = {
+      "block-model",      "block-model-values", "check-synth",
+      "constraint",       "declare-codatatype", "declare-codatatypes",
+      "declare-datatype", "declare-datatypes",  "declare-funs",
+      "declare-heap",     "declare-preds",      "declare-sorts",
+      "declare-var",      "define",             "define-const",
+      "get-abduct",       "get-interpol",       "get-qe",
+      "get-qe-disjunct",  "include",            "inv-constraint",
+      "set-options",      "simplify",           "synth-fun",
+      "synth-inv"};
+  return cmds.find(s) != cmds.end();
+}
+
+/** The size of the chunks read from a pipe */
+const size_t s_pipeChunkSize = 1 << 16;
+
+}  // namespace
+
+Smt2FastInputStream::Smt2FastInputStream(const std::string& name)
+    : InputStream(name),
+      d_map(nullptr),
+      d_mapSize(0),
+      d_fd(-1),
+      d_chunkPos(0),
+      d_chunkSize(0),
+      d_eof(false),
+      d_line(1),
+      d_column(0),
+      d_nextLine(1),
+      d_nextColumn(0)
+{
+}
+
+Smt2FastInputStream::~Smt2FastInputStream()
+{
+#ifndef _WIN32
+  if (d_map != nullptr)
+  {
+    munmap(d_map, d_mapSize);
+  }
+#endif /* ! _WIN32 */
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newFileInputStream(
+    const std::string& name, bool useMmap)
+{
+  std::unique_ptr<Smt2FastInputStream> s(new Smt2FastInputStream(name));
+#ifndef _WIN32
+  if (useMmap)
+  {
+    int fd = open(name.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd == -1 || fstat(fd, &st) == -1)
+    {
+      if (fd != -1)
+      {
+        close(fd);
+      }
+      throw InputStreamException("Couldn't open file: " + name);
+    }
+    size_t size = st.st_size;
+    // an empty file cannot be mapped, and its buffer is empty
+    if (size > 0)
+    {
+      void* map = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED)
+      {
+        close(fd);
+        throw InputStreamException("Couldn't memory map file: " + name);
+      }
+      s->d_map = map;
+      s->d_mapSize = size;
+      s->d_buf = std::string_view(static_cast<const char*>(map), size);
+    }
+    close(fd);
+    return s.release();
+  }
+#endif /* ! _WIN32 */
+  std::ifstream in(name, std::ios::in | std::ios::binary);
+  if (!in)
+  {
+    throw InputStreamException("Couldn't open file: " + name);
+  }
+  s->d_data.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  if (in.bad())
+  {
+    throw InputStreamException("Stream input failed: " + name);
+  }
+  s->d_buf = s->d_data;
+  return s.release();
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newStreamInputStream(
+    std::istream& input, const std::string& name)
+{
+  std::unique_ptr<Smt2FastInputStream> s(new Smt2FastInputStream(name));
+  s->d_data.assign(std::istreambuf_iterator<char>(input),
+                   std::istreambuf_iterator<char>());
+  if (input.bad())
+  {
+    throw InputStreamException("Stream input failed: " + name);
+  }
+  s->d_buf = s->d_data;
+  return s.release();
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newStringInputStream(
+    const std::string& input, const std::string& name)
+{
+  Smt2FastInputStream* s = new Smt2FastInputStream(name);
+  s->d_data = input;
+  s->d_buf = s->d_data;
+  return s;
+}
+
+Smt2FastInputStream* Smt2FastInputStream::newPipeInputStream(
+    int fd, std::function<void()> onIdle, const std::string& name)
+{
+#ifdef _WIN32
+  throw InputStreamException("Pipe input is not supported on Windows: "
+                             + name);
+#else  /* _WIN32 */
+  Smt2FastInputStream* s = new Smt2FastInputStream(name);
+  s->d_fd = fd;
+  s->d_onIdle = std::move(onIdle);
+  s->d_chunk.resize(s_pipeChunkSize);
+  return s;
+#endif /* _WIN32 */
+}
+
+bool Smt2FastInputStream::fill()
+{
+  if (d_eof)
+  {
+    return false;
+  }
+  // all of the input so far is consumed, hence reading may block
+  if (d_onIdle)
+  {
+    d_onIdle();
+  }
+#ifndef _WIN32
+  ssize_t n;
+  do
+  {
+    n = read(d_fd, d_chunk.data(), d_chunk.size());
+  } while (n == -1 && errno == EINTR);
+  if (n == -1)
+  {
+    throw InputStreamException("Stream input failed: " + getName());
+  }
+  d_chunkPos = 0;
+  d_chunkSize = n;
+#endif /* ! _WIN32 */
+  d_eof = d_chunkSize == 0;
+  return !d_eof;
+}
+
+int Smt2FastInputStream::peek()
+{
+  if (d_chunkPos == d_chunkSize && !fill())
+  {
+    return EOF;
+  }
+  return static_cast<unsigned char>(d_chunk[d_chunkPos]);
+}
+
+int Smt2FastInputStream::get()
+{
+  int c = peek();
+  if (c != EOF)
+  {
+    d_chunkPos++;
+    if (c == '\n')
+    {
+      d_nextLine++;
+      d_nextColumn = 0;
+    }
+    else
+    {
+      d_nextColumn++;
+    }
+  }
+  return c;
+}
+
+bool Smt2FastInputStream::readCommand(bool escapeDupDblQuote)
+{
+  Assert(isPipe());
+  d_data.clear();
+  d_buf = d_data;
+  int c;
+  // skip whitespace and comments
+  while ((c = get()) != EOF)
+  {
+    if (c == ';')
+    {
+      while ((c = peek()) != EOF && c != '\n')
+      {
+        get();
+      }
+    }
+    else if (!std::isspace(c))
+    {
+      break;
+    }
+  }
+  if (c == EOF)
+  {
+    return false;
+  }
+  d_line = d_nextLine;
+  d_column = d_nextColumn - 1;
+  size_t depth = 0;
+  while (c != EOF)
+  {
+    d_data.push_back(c);
+    switch (c)
+    {
+      case '(': depth++; break;
+      case ')':
+        if (depth > 0)
+        {
+          depth--;
+        }
+        break;
+      case ';':
+        while ((c = peek()) != EOF && c != '\n')
+        {
+          d_data.push_back(get());
+        }
+        break;
+      case '|':
+        while ((c = get()) != EOF)
+        {
+          d_data.push_back(c);
+          if (c == '|')
+          {
+            break;
+          }
+        }
+        break;
+      case '"':
+        while ((c = get()) != EOF)
+        {
+          d_data.push_back(c);
+          if (c == '"')
+          {
+            // "" escapes the double quote
+            if (!escapeDupDblQuote || peek() != '"')
+            {
+              break;
+            }
+            d_data.push_back(get());
+          }
+          else if (c == '\\' && !escapeDupDblQuote && peek() != EOF)
+          {
+            d_data.push_back(get());
+          }
+        }
+        break;
+      default: break;
+    }
+    if (depth == 0)
+    {
+      // An s-expression ends with its closing parenthesis, and an atom ends
+      // with the next character that is not part of it.
+      if (c == ')')
+      {
+        break;
+      }
+      c = peek();
+      if (c == EOF || std::isspace(c) || c == '(' || c == ')' || c == ';')
+      {
+        break;
+      }
+    }
+    c = get();
+  }
+  d_buf = d_data;
+  return true;
+}
+
+Smt2FastInput::Smt2FastInput(Smt2FastInputStream& inputStream,
+                             unsigned threads)
+    : Input(inputStream),
+      d_inputStream(inputStream),
+      d_tokenizer(inputStream.getBuffer()),
+      d_state(nullptr)
+{
+  d_tokenizer.setThreads(threads);
+}
+
+Smt2FastInput::~Smt2FastInput() {}
+
+void Smt2FastInput::setParser(Parser& parser)
+{
+  // the parser state of SMT-LIB 2 inputs is an Smt2 object
+  d_state = static_cast<Smt2*>(&parser);
+}
+
+bool Smt2FastInput::readPipeCommand()
+{
+  if (!d_inputStream.isPipe())
+  {
+    return true;
+  }
+  if (!d_inputStream.readCommand(d_state->escapeDupDblQuote()))
+  {
+    return false;
+  }
+  d_tokenizer.reset(d_inputStream.getBuffer(),
+                    d_inputStream.getLine(),
+                    d_inputStream.getColumn());
+  return true;
+}
+
+Command* Smt2FastInput::parseCommand()
+{
+  d_tokenizer.setEscapeDupDblQuote(d_state->escapeDupDblQuote());
+  if (!readPipeCommand()
+      || d_tokenizer.peek().d_kind == Smt2TokenKind::END_OF_FILE)
+  {
+    return nullptr;
+  }
+  std::unique_ptr<Command> cmd;
+  expect(Smt2TokenKind::LPAREN, "`(' at the start of a command");
+  parseCommandBody(&cmd);
+  expect(Smt2TokenKind::RPAREN, "`)' at the end of the command");
+  return cmd.release();
+}
+
+api::Term Smt2FastInput::parseExpr()
+{
+  d_tokenizer.setEscapeDupDblQuote(d_state->escapeDupDblQuote());
+  if (!readPipeCommand()
+      || d_tokenizer.peek().d_kind == Smt2TokenKind::END_OF_FILE)
+  {
+    return api::Term();
+  }
+  api::Term expr2;
+  return parseTerm(expr2);
+}
+
+void Smt2FastInput::warning(const std::string& msg)
+{
+  size_t line, column;
+  d_tokenizer.getLineColumn(d_tokenizer.getLastOffset(), line, column);
+  Warning() << getInputStream()->getName() << ':' << line << '.' << column
+            << ": " << msg << std::endl;
+}
+
+void Smt2FastInput::parseError(const std::string& msg, bool eofException)
+{
+  size_t line, column;
+  d_tokenizer.getLineColumn(d_tokenizer.getLastOffset(), line, column);
+  const std::string name = getInputStream()->getName();
+  Debug("parser") << "Throwing exception: " << name << ":" << line << "."
+                  << column << ": " << msg << std::endl;
+  if (eofException)
+  {
+    throw ParserEndOfFileException(msg, name, line, column);
+  }
+  throw ParserException(msg, name, line, column);
+}
+
+const std::string& Smt2FastInput::mkSymbol(std::string_view s)
+{
+  std::unordered_map<std::string_view, std::string>::iterator it =
+      d_symbols.find(s);
+  if (it == d_symbols.end())
+  {
+    // The key is rebound to the (stable) text of the value, which the node of
+    // the map owns.
+    std::unordered_map<std::string_view, std::string>::node_type nh =
+        d_symbols.extract(d_symbols.emplace(s, std::string(s)).first);
+    nh.key() = nh.mapped();
+    it = d_symbols.insert(std::move(nh)).position;
+  }
+  return it->second;
+}
+
+Smt2Token Smt2FastInput::nextToken()
+{
+  Smt2Token t = d_tokenizer.next();
+  if ((t.d_kind == Smt2TokenKind::NUMERAL
+       || t.d_kind == Smt2TokenKind::DECIMAL)
+      && t.d_text.size() > 1 && t.d_text[0] == '0' && t.d_text[1] != '.'
+      && d_state->strictModeEnabled())
+  {
+    parseError(
+        "Numerals with leading zeroes are not permitted while operating in "
+        "strict compliance mode.");
+  }
+  return t;
+}
+
+Smt2Token Smt2FastInput::expect(Smt2TokenKind k, const char* what)
+{
+  Smt2Token t = nextToken();
+  if (t.d_kind != k)
+  {
+    unexpectedToken(t, what);
+  }
+  return t;
+}
+
+bool Smt2FastInput::isNextSymbol(const char* s)
+{
+  const Smt2Token& t = d_tokenizer.peek();
+  return t.d_kind == Smt2TokenKind::SYMBOL && t.d_text == s;
+}
+
+void Smt2FastInput::unexpectedToken(const Smt2Token& t,
+                                    const std::string& expected)
+{
+  switch (t.d_kind)
+  {
+    case Smt2TokenKind::END_OF_FILE:
+      parseError("Expected " + expected + ", got end of input", true);
+      break;
+    case Smt2TokenKind::UNTERMINATED_QUOTED_SYMBOL:
+      parseError(t.d_text.back() == '\\'
+                     ? "backslash not permitted in |quoted| symbol"
+                     : "unterminated |quoted| symbol",
+                 true);
+      break;
+    case Smt2TokenKind::UNTERMINATED_STRING:
+      parseError("unterminated string literal", true);
+      break;
+    default: break;
+  }
+  std::stringstream ss;
+  ss << "Expected " << expected << ", got `" << t.d_text << "'";
+  parseError(ss.str());
+}
+
+void Smt2FastInput::unsupported(const std::string& what)
+{
+  parseError(what
+             + " is not supported by --smt2-fast-parser, use the default "
+               "parser instead");
+}
+
+std::string Smt2FastInput::processString(const Smt2Token& t, bool fsmtlib)
+{
+  Assert(t.d_kind == Smt2TokenKind::STRING);
+  // strip off the quotes
+  std::string_view s = t.d_text.substr(1, t.d_text.size() - 2);
+  for (char c : s)
+  {
+    unsigned char uc = static_cast<unsigned char>(c);
+    if (uc > 127 && !isprint(uc))
+    {
+      parseError(
+          "Extended/unprintable characters are not "
+          "part of SMT-LIB, and they must be encoded "
+          "as escape sequences");
+    }
+  }
+  bool dupDblQuote = d_state->escapeDupDblQuote();
+  if (!fsmtlib && !dupDblQuote)
+  {
+    return std::string(s);
+  }
+  std::string res;
+  res.reserve(s.size());
+  for (size_t i = 0, size = s.size(); i < size; i++)
+  {
+    if (dupDblQuote && s[i] == '"')
+    {
+      // Handle SMT-LIB >=2.5 standard escape '""'.
+      i++;
+      Assert(i < size && s[i] == '"');
+    }
+    else if (!dupDblQuote && s[i] == '\\')
+    {
+      i++;
+      Assert(i < size);
+      // Handle SMT-LIB 2.0 standard escapes '\\' and '\"'.
+      if (s[i] != '\\' && s[i] != '"')
+      {
+        res.push_back('\\');
+      }
+    }
+    res.push_back(s[i]);
+  }
+  return res;
+}
+
+void Smt2FastInput::parseCommandBody(std::unique_ptr<Command>* cmd)
+{
+  Smt2Token ct = nextToken();
+  if (ct.d_kind != Smt2TokenKind::SYMBOL)
+  {
+    unexpectedToken(ct, "an SMT-LIBv2 command");
+  }
+  std::string_view c = ct.d_text;
+  SymbolManager* sm = d_state->getSymbolManager();
+  if (c == "set-logic")
+  {
+    const std::string& name = parseSymbol(CHECK_NONE, SYM_SORT);
+    cmd->reset(d_state->setLogic(name));
+  }
+  else if (c == "set-info")
+  {
+    std::string name = parseKeyword();
+    api::Term sexpr = parseSymbolicExpr();
+    cmd->reset(new SetInfoCommand(name.c_str() + 1, sexprToString(sexpr)));
+  }
+  else if (c == "get-info")
+  {
+    std::string name = parseKeyword();
+    cmd->reset(new GetInfoCommand(name.c_str() + 1));
+  }
+  else if (c == "set-option")
+  {
+    std::string name = parseKeyword();
+    api::Term sexpr = parseSymbolicExpr();
+    cmd->reset(new SetOptionCommand(name.c_str() + 1, sexprToString(sexpr)));
+    // global-declarations affects parsing, see the default parser
+    if (name == ":global-declarations")
+    {
+      sm->setGlobalDeclarations(sexprToString(sexpr) == "true");
+    }
+  }
+  else if (c == "get-option")
+  {
+    std::string name = parseKeyword();
+    cmd->reset(new GetOptionCommand(name.c_str() + 1));
+  }
+  else if (c == "declare-sort")
+  {
+    d_state->checkThatLogicIsSet();
+    d_state->checkLogicAllowsFreeSorts();
+    const std::string& name = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    d_state->checkUserSymbol(name);
+    uint64_t arity = parseNumeral();
+    Debug("parser") << "declare sort: '" << name << "' arity=" << arity
+                    << std::endl;
+    api::Sort type = arity == 0 ? d_state->mkSort(name)
+                                : d_state->mkSortConstructor(name, arity);
+    cmd->reset(new DeclareSortCommand(name, arity, type));
+  }
+  else if (c == "define-sort")
+  {
+    d_state->checkThatLogicIsSet();
+    const std::string& name = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    d_state->checkUserSymbol(name);
+    expect(Smt2TokenKind::LPAREN, "`(' for the parameters of define-sort");
+    std::vector<std::string> names;
+    while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN)
+    {
+      names.push_back(parseSymbol(CHECK_NONE, SYM_SORT));
+    }
+    nextToken();
+    d_state->pushScope();
+    std::vector<api::Sort> sorts;
+    for (const std::string& n : names)
+    {
+      sorts.push_back(d_state->mkSort(n));
+    }
+    api::Sort t = parseSort(CHECK_DECLARED);
+    d_state->popScope();
+    // Do NOT call mkSort, since that creates a new sort!
+    // This name is not its own distinct sort, it's an alias.
+    d_state->defineParameterizedType(name, sorts, t);
+    cmd->reset(new DefineSortCommand(name, sorts, t));
+  }
+  else if (c == "declare-fun")
+  {
+    d_state->checkThatLogicIsSet();
+    const std::string& name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(name);
+    expect(Smt2TokenKind::LPAREN, "`(' for the argument sorts of declare-fun");
+    std::vector<api::Sort> sorts;
+    parseSortList(sorts);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    Debug("parser") << "declare fun: '" << name << "'" << std::endl;
+    if (!sorts.empty())
+    {
+      t = d_state->mkFlatFunctionType(sorts, t);
+    }
+    if (t.isFunction())
+    {
+      d_state->checkLogicAllowsFunctions();
+    }
+    if (d_state->sygus())
+    {
+      d_state->parseErrorLogic(
+          "declare-fun are not allowed in sygus version 2.0");
+    }
+    // we allow overloading for function declarations
+    api::Term func = d_state->bindVar(name, t, false, true);
+    cmd->reset(new DeclareFunctionCommand(name, func, t));
+  }
+  else if (c == "define-fun")
+  {
+    d_state->checkThatLogicIsSet();
+    const std::string& name = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+    d_state->checkUserSymbol(name);
+    expect(Smt2TokenKind::LPAREN, "`(' for the arguments of define-fun");
+    std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+    parseSortedVarList(sortedVarNames);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    Debug("parser") << "define fun: '" << name << "'" << std::endl;
+    std::vector<api::Sort> sorts;
+    for (const std::pair<std::string, api::Sort>& svn : sortedVarNames)
+    {
+      sorts.push_back(svn.second);
+    }
+    std::vector<api::Term> flattenVars;
+    t = d_state->mkFlatFunctionType(sorts, t, flattenVars);
+    d_state->pushScope();
+    std::vector<api::Term> terms = d_state->bindBoundVars(sortedVarNames);
+    api::Term expr2;
+    api::Term expr = parseTerm(expr2);
+    if (!flattenVars.empty())
+    {
+      // if this function has any implicit variables flattenVars,
+      // we apply the body of the definition to the flatten vars
+      expr = d_state->mkHoApply(expr, flattenVars);
+      terms.insert(terms.end(), flattenVars.begin(), flattenVars.end());
+    }
+    d_state->popScope();
+    // declare the name after parsing the body, since no recursion is
+    // permitted, and allow overloading for function definitions
+    api::Term func = d_state->bindVar(name, t, false, true);
+    cmd->reset(new DefineFunctionCommand(
+        name, func, terms, expr, sm->getGlobalDeclarations()));
+  }
+  else if (c == "get-value" || c == "check-sat-assuming")
+  {
+    d_state->checkThatLogicIsSet();
+    bool isGetValue = c == "get-value";
+    if (d_tokenizer.peek().d_kind != Smt2TokenKind::LPAREN)
+    {
+      parseError("The " + std::string(c)
+                 + " command expects a list of terms.  Perhaps you forgot a "
+                   "pair of parentheses?");
+    }
+    nextToken();
+    std::vector<api::Term> terms;
+    parseTermList(terms);
+    if (isGetValue)
+    {
+      cmd->reset(new GetValueCommand(terms));
+    }
+    else
+    {
+      cmd->reset(new CheckSatAssumingCommand(terms));
+    }
+  }
+  else if (c == "assert")
+  {
+    d_state->checkThatLogicIsSet();
+    d_state->clearLastNamedTerm();
+    api::Term expr2;
+    api::Term expr = parseTerm(expr2);
+    bool inUnsatCore = d_state->lastNamedTerm().first == expr;
+    cmd->reset(new AssertCommand(expr, inUnsatCore));
+    if (inUnsatCore)
+    {
+      // set the expression name, if there was a named term
+      std::pair<api::Term, std::string> namedTerm = d_state->lastNamedTerm();
+      sm->setExpressionName(namedTerm.first, namedTerm.second, true);
+    }
+  }
+  else if (c == "check-sat")
+  {
+    d_state->checkThatLogicIsSet();
+    if (d_state->sygus())
+    {
+      parseError("Sygus does not support check-sat command.");
+    }
+    api::Term expr;
+    if (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN)
+    {
+      api::Term expr2;
+      expr = parseTerm(expr2);
+      if (d_state->strictModeEnabled())
+      {
+        parseError(
+            "Extended commands (such as check-sat with an argument) are not "
+            "permitted while operating in strict compliance mode.");
+      }
+    }
+    cmd->reset(new CheckSatCommand(expr));
+  }
+  else if (c == "push" || c == "pop")
+  {
+    d_state->checkThatLogicIsSet();
+    bool isPush = c == "push";
+    if (d_state->sygus())
+    {
+      parseError(isPush ? "Sygus does not support push command."
+                        : "Sygus does not support pop command.");
+    }
+    uint64_t num = 1;
+    if (d_tokenizer.peek().d_kind == Smt2TokenKind::NUMERAL)
+    {
+      num = parseNumeral();
+    }
+    else if (d_state->strictModeEnabled())
+    {
+      parseError(isPush ? "Strict compliance mode demands an integer to be "
+                          "provided to PUSH.  Maybe you want (push 1)?"
+                        : "Strict compliance mode demands an integer to be "
+                          "provided to POP.  Maybe you want (pop 1)?");
+    }
+    if (!isPush && num > d_state->scopeLevel())
+    {
+      parseError("Attempted to pop above the top stack frame.");
+    }
+    std::unique_ptr<CommandSequence> seq;
+    if (num > 1)
+    {
+      seq.reset(new CommandSequence());
+    }
+    for (; num > 0; --num)
+    {
+      Command* pcmd;
+      if (isPush)
+      {
+        d_state->pushScope(true);
+        pcmd = new PushCommand();
+      }
+      else
+      {
+        d_state->popScope();
+        pcmd = new PopCommand();
+      }
+      if (seq == nullptr)
+      {
+        cmd->reset(pcmd);
+        break;
+      }
+      pcmd->setMuted(num > 1);
+      seq->addCommand(pcmd);
+    }
+    if (seq != nullptr)
+    {
+      cmd->reset(seq.release());
+    }
+    else if (*cmd == nullptr)
+    {
+      cmd->reset(new EmptyCommand());
+    }
+  }
+  else if (c == "exit")
+  {
+    cmd->reset(new QuitCommand());
+  }
+  else if (c == "declare-const")
+  {
+    d_state->checkThatLogicIsSet();
+    const std::string& name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(name);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    // allow overloading here
+    api::Term v = d_state->bindVar(name, t, false, true);
+    cmd->reset(new DeclareFunctionCommand(name, v, t));
+  }
+  else if (c == "get-model" || c == "get-assignment" || c == "get-assertions"
+           || c == "get-proof" || c == "get-unsat-assumptions"
+           || c == "get-unsat-core")
+  {
+    d_state->checkThatLogicIsSet();
+    if (c == "get-model")
+    {
+      cmd->reset(new GetModelCommand());
+    }
+    else if (c == "get-assignment")
+    {
+      cmd->reset(new GetAssignmentCommand());
+    }
+    else if (c == "get-assertions")
+    {
+      cmd->reset(new GetAssertionsCommand());
+    }
+    else if (c == "get-proof")
+    {
+      cmd->reset(new GetProofCommand());
+    }
+    else if (c == "get-unsat-assumptions")
+    {
+      cmd->reset(new GetUnsatAssumptionsCommand());
+    }
+    else
+    {
+      cmd->reset(new GetUnsatCoreCommand());
+    }
+  }
+  else if (c == "echo")
+  {
+    if (d_tokenizer.peek().d_kind == Smt2TokenKind::RPAREN)
+    {
+      cmd->reset(new EchoCommand());
+    }
+    else
+    {
+      cmd->reset(new EchoCommand(parseSimpleSymbolicExpr(true)));
+    }
+  }
+  else if (c == "reset")
+  {
+    cmd->reset(new ResetCommand());
+    // reset the state of the parser, which is independent of the symbol
+    // manager
+    d_state->reset();
+  }
+  else if (c == "reset-assertions")
+  {
+    cmd->reset(new ResetAssertionsCommand());
+  }
+  else if (c == "define-fun-rec")
+  {
+    d_state->checkThatLogicIsSet();
+    const std::string& fname = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(fname);
+    expect(Smt2TokenKind::LPAREN, "`(' for the arguments of define-fun-rec");
+    std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+    parseSortedVarList(sortedVarNames);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    std::vector<api::Term> flattenVars;
+    std::vector<api::Term> bvs;
+    api::Term func =
+        d_state->bindDefineFunRec(fname, sortedVarNames, t, flattenVars);
+    d_state->pushDefineFunRecScope(sortedVarNames, func, flattenVars, bvs);
+    api::Term expr2;
+    api::Term expr = parseTerm(expr2);
+    d_state->popScope();
+    if (!flattenVars.empty())
+    {
+      expr = d_state->mkHoApply(expr, flattenVars);
+    }
+    cmd->reset(new DefineFunctionRecCommand(
+        func, bvs, expr, sm->getGlobalDeclarations()));
+  }
+  else if (c == "define-funs-rec")
+  {
+    d_state->checkThatLogicIsSet();
+    expect(Smt2TokenKind::LPAREN,
+           "`(' for the declarations of define-funs-rec");
+    std::vector<std::vector<std::pair<std::string, api::Sort>>>
+        sortedVarNamesList;
+    std::vector<std::vector<api::Term>> flattenVarsList;
+    std::vector<api::Term> funcs;
+    do
+    {
+      expect(Smt2TokenKind::LPAREN, "`(' for a declaration of define-funs-rec");
+      const std::string& fname = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+      d_state->checkUserSymbol(fname);
+      expect(Smt2TokenKind::LPAREN, "`(' for the arguments of a function");
+      std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+      parseSortedVarList(sortedVarNames);
+      api::Sort t = parseSort(CHECK_DECLARED);
+      expect(Smt2TokenKind::RPAREN, "`)' at the end of the declaration");
+      std::vector<api::Term> flattenVars;
+      funcs.push_back(
+          d_state->bindDefineFunRec(fname, sortedVarNames, t, flattenVars));
+      // remember the lists for when parsing the bodies
+      sortedVarNamesList.push_back(sortedVarNames);
+      flattenVarsList.push_back(flattenVars);
+    } while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN);
+    nextToken();
+    expect(Smt2TokenKind::LPAREN, "`(' for the bodies of define-funs-rec");
+    std::vector<std::vector<api::Term>> formals;
+    std::vector<api::Term> funcDefs;
+    for (size_t j = 0, nfuncs = funcs.size(); j < nfuncs; j++)
+    {
+      std::vector<api::Term> bvs;
+      d_state->pushDefineFunRecScope(
+          sortedVarNamesList[j], funcs[j], flattenVarsList[j], bvs);
+      api::Term expr2;
+      api::Term expr = parseTerm(expr2);
+      if (!flattenVarsList[j].empty())
+      {
+        expr = d_state->mkHoApply(expr, flattenVarsList[j]);
+      }
+      funcDefs.push_back(expr);
+      formals.push_back(bvs);
+      d_state->popScope();
+    }
+    if (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN)
+    {
+      parseError(
+          "Number of functions defined does not match number listed in "
+          "define-funs-rec");
+    }
+    nextToken();
+    cmd->reset(new DefineFunctionRecCommand(
+        funcs, formals, funcDefs, sm->getGlobalDeclarations()));
+  }
+  else if (isDefaultParserCommand(c))
+  {
+    unsupported("The command `" + std::string(c) + "'");
+  }
+  else if (c == "benchmark")
+  {
+    parseError(
+        "In SMT-LIBv2 mode, but got something that looks like SMT-LIBv1, "
+        "which is not supported anymore.");
+  }
+  else
+  {
+    parseError("expected SMT-LIBv2 command, got `" + std::string(c) + "'.");
+  }
+}
+
+const std::string& Smt2FastInput::parseSymbol(DeclarationCheck check,
+                                              SymbolType type)
+{
+  Smt2Token t = nextToken();
+  if (t.d_kind != Smt2TokenKind::QUOTED_SYMBOL
+      && (t.d_kind != Smt2TokenKind::SYMBOL || t.d_text == "_"
+          || t.d_text == "!"))
+  {
+    unexpectedToken(t, "a symbol");
+  }
+  const std::string& id = mkSymbol(t.d_text);
+  if (!d_state->isAbstractValue(id))
+  {
+    // if an abstract value, SmtEngine handles declaration
+    d_state->checkDeclaration(id, check, type);
+  }
+  return id;
+}
+
+uint64_t Smt2FastInput::parseNumeral()
+{
+  Smt2Token t = expect(Smt2TokenKind::NUMERAL, "a numeral");
+  uint64_t n = 0;
+  for (char c : t.d_text)
+  {
+    uint64_t d = c - '0';
+    if (n > (std::numeric_limits<uint64_t>::max() - d) / 10)
+    {
+      parseError("Numeral is too large: " + std::string(t.d_text));
+    }
+    n = n * 10 + d;
+  }
+  return n;
+}
+
+void Smt2FastInput::parseNumeralList(std::vector<uint64_t>& numerals)
+{
+  do
+  {
+    numerals.push_back(parseNumeral());
+  } while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN);
+  nextToken();
+}
+
+std::string Smt2FastInput::parseKeyword()
+{
+  return std::string(expect(Smt2TokenKind::KEYWORD, "a keyword").d_text);
+}
+
+std::string Smt2FastInput::parseSimpleSymbolicExpr(bool allowKeyword)
+{
+  Smt2Token t = nextToken();
+  switch (t.d_kind)
+  {
+    case Smt2TokenKind::NUMERAL:
+    case Smt2TokenKind::DECIMAL:
+    case Smt2TokenKind::HEX:
+    case Smt2TokenKind::BINARY:
+    case Smt2TokenKind::QUOTED_SYMBOL: return std::string(t.d_text);
+    case Smt2TokenKind::STRING: return processString(t, false);
+    case Smt2TokenKind::SYMBOL:
+      if (t.d_text != "_" && t.d_text != "!")
+      {
+        return std::string(t.d_text);
+      }
+      break;
+    case Smt2TokenKind::KEYWORD:
+      if (allowKeyword)
+      {
+        return std::string(t.d_text);
+      }
+      break;
+    default: break;
+  }
+  unexpectedToken(t, "a symbolic expression");
+  return std::string();
+}
+
+api::Term Smt2FastInput::parseSymbolicExpr()
+{
+  api::Solver* slv = d_state->getSolver();
+  if (d_tokenizer.peek().d_kind == Smt2TokenKind::LPAREN)
+  {
+    nextToken();
+    std::vector<api::Term> children;
+    while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN)
+    {
+      children.push_back(parseSymbolicExpr());
+    }
+    nextToken();
+    return slv->mkTerm(api::SEXPR, children);
+  }
+  std::string s = parseSimpleSymbolicExpr(true);
+  return slv->mkString(d_state->processAdHocStringEsc(s));
+}
+
+api::Sort Smt2FastInput::parseSort(DeclarationCheck check)
+{
+  if (d_tokenizer.peek().d_kind != Smt2TokenKind::LPAREN)
+  {
+    const std::string& name = parseSymbol(CHECK_NONE, SYM_SORT);
+    if (check == CHECK_DECLARED || d_state->isDeclared(name, SYM_SORT))
+    {
+      return d_state->getSort(name);
+    }
+    return d_state->mkUnresolvedType(name);
+  }
+  nextToken();
+  api::Solver* slv = d_state->getSolver();
+  std::vector<api::Sort> args;
+  if (isNextSymbol("->") && d_state->isHoEnabled())
+  {
+    nextToken();
+    parseSortList(args);
+    if (args.size() < 2)
+    {
+      parseError("Arrow types must have at least 2 arguments");
+    }
+    // flatten the type
+    api::Sort rangeType = args.back();
+    args.pop_back();
+    return d_state->mkFlatFunctionType(args, rangeType);
+  }
+  bool indexed = isNextSymbol("_");
+  if (indexed)
+  {
+    nextToken();
+  }
+  const std::string& name = parseSymbol(CHECK_NONE, SYM_SORT);
+  std::stringstream ss;
+  if (d_tokenizer.peek().d_kind == Smt2TokenKind::NUMERAL)
+  {
+    std::vector<uint64_t> numerals;
+    parseNumeralList(numerals);
+    if (!indexed)
+    {
+      ss << "SMT-LIB requires use of an indexed sort here, e.g. (_ " << name
+         << " ...)";
+      parseError(ss.str());
+    }
+    if (name == "BitVec")
+    {
+      if (numerals.size() != 1)
+      {
+        parseError("Illegal bitvector type.");
+      }
+      if (numerals.front() == 0)
+      {
+        parseError("Illegal bitvector size: 0");
+      }
+      return slv->mkBitVectorSort(numerals.front());
+    }
+    if (name == "FloatingPoint")
+    {
+      if (numerals.size() != 2)
+      {
+        parseError("Illegal floating-point type.");
+      }
+      if (!validExponentSize(numerals[0]))
+      {
+        parseError("Illegal floating-point exponent size");
+      }
+      if (!validSignificandSize(numerals[1]))
+      {
+        parseError("Illegal floating-point significand size");
+      }
+      return slv->mkFloatingPointSort(numerals[0], numerals[1]);
+    }
+    ss << "unknown indexed sort symbol `" << name << "'";
+    parseError(ss.str());
+  }
+  parseSortList(args);
+  if (indexed)
+  {
+    ss << "Unexpected use of indexing operator `_' before `" << name
+       << "', try leaving it out";
+    parseError(ss.str());
+  }
+  if (args.empty())
+  {
+    parseError(
+        "Extra parentheses around sort name not permitted in SMT-LIB");
+  }
+  if (name == "Array" && d_state->isTheoryEnabled(theory::THEORY_ARRAYS))
+  {
+    if (args.size() != 2)
+    {
+      parseError("Illegal array type.");
+    }
+    return slv->mkArraySort(args[0], args[1]);
+  }
+  if (name == "Set" && d_state->isTheoryEnabled(theory::THEORY_SETS))
+  {
+    if (args.size() != 1)
+    {
+      parseError("Illegal set type.");
+    }
+    return slv->mkSetSort(args[0]);
+  }
+  if (name == "Bag" && d_state->isTheoryEnabled(theory::THEORY_BAGS))
+  {
+    if (args.size() != 1)
+    {
+      parseError("Illegal bag type.");
+    }
+    return slv->mkBagSort(args[0]);
+  }
+  if (name == "Seq" && !d_state->strictModeEnabled()
+      && d_state->isTheoryEnabled(theory::THEORY_STRINGS))
+  {
+    if (args.size() != 1)
+    {
+      parseError("Illegal sequence type.");
+    }
+    return slv->mkSequenceSort(args[0]);
+  }
+  if (name == "Tuple" && !d_state->strictModeEnabled())
+  {
+    return slv->mkTupleSort(args);
+  }
+  if (check == CHECK_DECLARED || d_state->isDeclared(name, SYM_SORT))
+  {
+    return d_state->getSort(name, args);
+  }
+  // make unresolved type
+  api::Sort t = d_state->mkUnresolvedTypeConstructor(name, args);
+  return t.instantiate(args);
+}
+
+void Smt2FastInput::parseSortList(std::vector<api::Sort>& sorts)
+{
+  while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN)
+  {
+    sorts.push_back(parseSort(CHECK_DECLARED));
+  }
+  nextToken();
+}
+
+void Smt2FastInput::parseSortedVarList(
+    std::vector<std::pair<std::string, api::Sort>>& sortedVars)
+{
+  while (d_tokenizer.peek().d_kind == Smt2TokenKind::LPAREN)
+  {
+    nextToken();
+    const std::string& name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    api::Sort t = parseSort(CHECK_DECLARED);
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of a sorted variable");
+    sortedVars.emplace_back(name, t);
+  }
+  expect(Smt2TokenKind::RPAREN, "`)' at the end of the sorted variables");
+}
+
+api::Term Smt2FastInput::parseBoundVarList()
+{
+  expect(Smt2TokenKind::LPAREN, "`(' for a list of sorted variables");
+  std::vector<std::pair<std::string, api::Sort>> sortedVarNames;
+  parseSortedVarList(sortedVarNames);
+  std::vector<api::Term> args = d_state->bindBoundVars(sortedVarNames);
+  return d_state->getSolver()->mkTerm(api::BOUND_VAR_LIST, args);
+}
+
+api::Term Smt2FastInput::parseTerm(api::Term& expr2)
+{
+  const Smt2Token& t = d_tokenizer.peek();
+  if (t.d_kind == Smt2TokenKind::LPAREN)
+  {
+    nextToken();
+    return parseCompoundTerm(expr2);
+  }
+  if (t.d_kind == Smt2TokenKind::SYMBOL && t.d_text == "mkTuple"
+      && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+  {
+    nextToken();
+    // the empty tuple
+    return d_state->getSolver()->mkTuple(std::vector<api::Sort>(),
+                                         std::vector<api::Term>());
+  }
+  if (t.d_kind == Smt2TokenKind::SYMBOL
+      || t.d_kind == Smt2TokenKind::QUOTED_SYMBOL)
+  {
+    // a qualified identifier that is a symbol
+    ParseOp p;
+    p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    return d_state->parseOpToExpr(p);
+  }
+  return parseLiteral();
+}
+
+void Smt2FastInput::parseTermList(std::vector<api::Term>& terms)
+{
+  api::Term expr2;
+  do
+  {
+    terms.push_back(parseTerm(expr2));
+  } while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN);
+  nextToken();
+}
+
+api::Term Smt2FastInput::parseCompoundTerm(api::Term& expr2)
+{
+  api::Solver* slv = d_state->getSolver();
+  const Smt2Token& t = d_tokenizer.peek();
+  std::string_view s =
+      t.d_kind == Smt2TokenKind::SYMBOL ? t.d_text : std::string_view();
+  if (s == "forall" || s == "exists")
+  {
+    nextToken();
+    if (!d_state->isTheoryEnabled(theory::THEORY_QUANTIFIERS))
+    {
+      parseError("Quantifier used in non-quantified logic.");
+    }
+    api::Kind kind = s == "forall" ? api::FORALL : api::EXISTS;
+    d_state->pushScope();
+    std::vector<api::Term> args;
+    args.push_back(parseBoundVarList());
+    api::Term f2;
+    args.push_back(parseTerm(f2));
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of the quantified formula");
+    d_state->popScope();
+    if (!f2.isNull())
+    {
+      args.push_back(f2);
+    }
+    return slv->mkTerm(kind, args);
+  }
+  if (s == "let")
+  {
+    nextToken();
+    expect(Smt2TokenKind::LPAREN, "`(' for the bindings of let");
+    d_state->pushScope();
+    // this is a parallel let, so we have to save up all the contributions of
+    // the let and define them only later on; the names are the strings of the
+    // symbol table of this class
+    std::unordered_set<const std::string*> names;
+    std::vector<std::pair<const std::string*, api::Term>> binders;
+    do
+    {
+      expect(Smt2TokenKind::LPAREN, "`(' for a binding of let");
+      const std::string& name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+      api::Term f2;
+      api::Term expr = parseTerm(f2);
+      expect(Smt2TokenKind::RPAREN, "`)' at the end of a binding of let");
+      if (!names.insert(&name).second)
+      {
+        std::stringstream ss;
+        ss << "warning: symbol `" << name << "' bound multiple times by let;"
+           << " the last binding will be used, shadowing earlier ones";
+        warning(ss.str());
+      }
+      binders.emplace_back(&name, expr);
+    } while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN);
+    nextToken();
+    // now implement these bindings
+    for (const std::pair<const std::string*, api::Term>& binder : binders)
+    {
+      d_state->defineVar(*binder.first, binder.second);
+    }
+    api::Term f2;
+    api::Term expr = parseTerm(f2);
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of let");
+    d_state->popScope();
+    return expr;
+  }
+  if (s == "!")
+  {
+    nextToken();
+    return parseAttributedTerm(expr2);
+  }
+  if (s == "_")
+  {
+    nextToken();
+    return parseIndexedConstant();
+  }
+  if (s == "as")
+  {
+    nextToken();
+    ParseOp p;
+    parseAscribedIdentifier(p);
+    return d_state->parseOpToExpr(p);
+  }
+  if (s == "lambda" && d_state->isHoEnabled())
+  {
+    nextToken();
+    d_state->pushScope();
+    std::vector<api::Term> args;
+    args.push_back(parseBoundVarList());
+    api::Term f2;
+    args.push_back(parseTerm(f2));
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of lambda");
+    d_state->popScope();
+    return slv->mkTerm(api::LAMBDA, args);
+  }
+  bool dts = d_state->isTheoryEnabled(theory::THEORY_DATATYPES);
+  if (s == "mkTuple" && dts)
+  {
+    nextToken();
+    std::vector<api::Term> terms;
+    parseTermList(terms);
+    std::vector<api::Sort> sorts;
+    for (const api::Term& arg : terms)
+    {
+      sorts.push_back(arg.getSort());
+    }
+    return slv->mkTuple(sorts, terms);
+  }
+  if (s == "tuple_project" && dts)
+  {
+    nextToken();
+    api::Term f2;
+    api::Term expr = parseTerm(f2);
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of tuple_project");
+    api::Op op = slv->mkOp(api::TUPLE_PROJECT, std::vector<uint32_t>());
+    return slv->mkTerm(op, expr);
+  }
+  if (s == "match" && dts && (d_state->v2_6() || d_state->sygus()))
+  {
+    unsupported("The match term");
+  }
+  if (s == "comprehension" && d_state->isTheoryEnabled(theory::THEORY_SETS))
+  {
+    unsupported("The comprehension term");
+  }
+  // the application of a qualified identifier
+  ParseOp p;
+  parseQualIdentifier(p);
+  std::vector<api::Term> args;
+  parseTermList(args);
+  return d_state->applyParseOp(p, args);
+}
+
+api::Term Smt2FastInput::parseLiteral()
+{
+  api::Solver* slv = d_state->getSolver();
+  Smt2Token t = nextToken();
+  switch (t.d_kind)
+  {
+    case Smt2TokenKind::NUMERAL: return slv->mkInteger(std::string(t.d_text));
+    case Smt2TokenKind::DECIMAL:
+      return slv->ensureTermSort(slv->mkReal(std::string(t.d_text)),
+                                 slv->getRealSort());
+    case Smt2TokenKind::HEX:
+      return slv->mkBitVector(std::string(t.d_text.substr(2)), 16);
+    case Smt2TokenKind::BINARY:
+      return slv->mkBitVector(std::string(t.d_text.substr(2)), 2);
+    case Smt2TokenKind::STRING:
+      return d_state->mkStringConstant(processString(t, false));
+    default: break;
+  }
+  unexpectedToken(t, "a term");
+  return api::Term();
+}
+
+api::Term Smt2FastInput::parseIndexedConstant()
+{
+  api::Solver* slv = d_state->getSolver();
+  if (isNextSymbol("emp") && d_state->isTheoryEnabled(theory::THEORY_SEP))
+  {
+    nextToken();
+    api::Sort type = parseSort(CHECK_DECLARED);
+    api::Sort type2 = parseSort(CHECK_DECLARED);
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of emp");
+    // Empty heap constant in seperation logic
+    api::Term v1 = slv->mkConst(type, "_emp1");
+    api::Term v2 = slv->mkConst(type2, "_emp2");
+    return slv->mkTerm(api::SEP_EMP, v1, v2);
+  }
+  if (isNextSymbol("char") && d_state->isTheoryEnabled(theory::THEORY_STRINGS))
+  {
+    nextToken();
+    Smt2Token h = expect(Smt2TokenKind::HEX, "a hexadecimal constant");
+    expect(Smt2TokenKind::RPAREN, "`)' at the end of char");
+    return slv->mkChar(std::string(h.d_text.substr(2)));
+  }
+  Smt2Token sym = expect(Smt2TokenKind::SYMBOL, "an indexed symbol");
+  std::vector<uint64_t> numerals;
+  parseNumeralList(numerals);
+  return d_state->mkIndexedConstant(std::string(sym.d_text), numerals);
+}
+
+api::Term Smt2FastInput::parseAttributedTerm(api::Term& expr2)
+{
+  api::Term f2;
+  api::Term expr = parseTerm(f2);
+  std::vector<api::Term> patexprs;
+  do
+  {
+    api::Term attexpr;
+    parseAttribute(expr, attexpr);
+    if (!attexpr.isNull())
+    {
+      patexprs.push_back(attexpr);
+    }
+  } while (d_tokenizer.peek().d_kind != Smt2TokenKind::RPAREN);
+  nextToken();
+  if (patexprs.empty())
+  {
+    expr2 = f2;
+    return expr;
+  }
+  if (!f2.isNull() && f2.getKind() == api::INST_PATTERN_LIST)
+  {
+    for (size_t i = 0, nchild = f2.getNumChildren(); i < nchild; i++)
+    {
+      if (f2[i].getKind() == api::INST_PATTERN)
+      {
+        patexprs.push_back(f2[i]);
+      }
+      else
+      {
+        std::stringstream ss;
+        ss << "warning: rewrite rules do not support " << f2[i]
+           << " within instantiation pattern list";
+        warning(ss.str());
+      }
+    }
+  }
+  expr2 = d_state->getSolver()->mkTerm(api::INST_PATTERN_LIST, patexprs);
+  return expr;
+}
+
+void Smt2FastInput::parseAttribute(api::Term& expr, api::Term& retExpr)
+{
+  api::Solver* slv = d_state->getSolver();
+  std::string attr = parseKeyword();
+  if (attr == ":pattern")
+  {
+    expect(Smt2TokenKind::LPAREN, "`(' for the terms of the pattern");
+    std::vector<api::Term> patexprs;
+    parseTermList(patexprs);
+    retExpr = slv->mkTerm(api::INST_PATTERN, patexprs);
+  }
+  else if (attr == ":no-pattern")
+  {
+    api::Term e2;
+    retExpr = slv->mkTerm(api::INST_NO_PATTERN, parseTerm(e2));
+  }
+  else if (attr == ":quant-inst-max-level")
+  {
+    Smt2Token n = expect(Smt2TokenKind::NUMERAL, "a numeral");
+    std::vector<api::Term> values;
+    values.push_back(slv->mkInteger(std::string(n.d_text)));
+    std::string attrName = attr.substr(1);
+    api::Term avar = d_state->bindVar(attrName, slv->getBooleanSort());
+    retExpr = slv->mkTerm(api::INST_ATTRIBUTE, avar);
+    Command* c = new SetUserAttributeCommand(attrName, avar, values);
+    c->setMuted(true);
+    d_state->preemptCommand(c);
+  }
+  else if (attr == ":qid")
+  {
+    api::Term sexpr = parseSymbolicExpr();
+    api::Term avar =
+        slv->mkConst(slv->getBooleanSort(), sexprToString(sexpr));
+    retExpr = slv->mkTerm(api::INST_ATTRIBUTE, avar);
+    Command* c = new SetUserAttributeCommand("qid", avar);
+    c->setMuted(true);
+    d_state->preemptCommand(c);
+  }
+  else if (attr == ":named")
+  {
+    api::Term sexpr = parseSymbolicExpr();
+    // notify that expression was given a name
+    d_state->notifyNamedExpression(expr, sexprToString(sexpr));
+  }
+  else
+  {
+    // an unsupported attribute, with an optional simple value
+    Smt2TokenKind k = d_tokenizer.peek().d_kind;
+    if (k != Smt2TokenKind::RPAREN && k != Smt2TokenKind::LPAREN
+        && k != Smt2TokenKind::KEYWORD)
+    {
+      parseSimpleSymbolicExpr(false);
+    }
+    d_state->attributeNotSupported(attr);
+  }
+}
+
+void Smt2FastInput::parseQualIdentifier(ParseOp& p)
+{
+  if (d_tokenizer.peek().d_kind != Smt2TokenKind::LPAREN)
+  {
+    p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    return;
+  }
+  nextToken();
+  if (isNextSymbol("as"))
+  {
+    nextToken();
+    parseAscribedIdentifier(p);
+    return;
+  }
+  if (!isNextSymbol("_"))
+  {
+    unexpectedToken(nextToken(), "`as' or `_'");
+  }
+  nextToken();
+  parseIndexedIdentifier(p);
+}
+
+void Smt2FastInput::parseAscribedIdentifier(ParseOp& p)
+{
+  if (isNextSymbol("const") && !d_state->strictModeEnabled())
+  {
+    nextToken();
+    api::Sort type = parseSort(CHECK_DECLARED);
+    p.d_kind = api::CONST_ARRAY;
+    d_state->parseOpApplyTypeAscription(p, type);
+  }
+  else
+  {
+    parseIdentifier(p);
+    api::Sort type = parseSort(CHECK_DECLARED);
+    d_state->parseOpApplyTypeAscription(p, type);
+  }
+  expect(Smt2TokenKind::RPAREN, "`)' at the end of the ascription");
+}
+
+void Smt2FastInput::parseIdentifier(ParseOp& p)
+{
+  if (d_tokenizer.peek().d_kind != Smt2TokenKind::LPAREN)
+  {
+    p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    return;
+  }
+  nextToken();
+  if (!isNextSymbol("_"))
+  {
+    unexpectedToken(nextToken(), "`_'");
+  }
+  nextToken();
+  parseIndexedIdentifier(p);
+}
+
+void Smt2FastInput::parseIndexedIdentifier(ParseOp& p)
+{
+  std::vector<uint64_t> numerals;
+  if (d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+  {
+    if (isNextSymbol("is") && (d_state->v2_6() || d_state->sygus()))
+    {
+      // testers require datatypes declarations
+      unsupported("The tester (_ is C)");
+    }
+    if (isNextSymbol("tupSel"))
+    {
+      nextToken();
+      // we adopt a special syntax (_ tupSel n)
+      p.d_kind = api::APPLY_SELECTOR;
+      // put n in expr so that the caller can deal with this case
+      p.d_expr = d_state->getSolver()->mkInteger(
+          static_cast<int64_t>(parseNumeral()));
+      expect(Smt2TokenKind::RPAREN, "`)' at the end of tupSel");
+      return;
+    }
+    if (isNextSymbol("tuple_project"))
+    {
+      nextToken();
+      parseNumeralList(numerals);
+      // we adopt a special syntax (_ tuple_project i_1 ... i_n) where
+      // i_1, ..., i_n are numerals
+      p.d_kind = api::TUPLE_PROJECT;
+      std::vector<uint32_t> indices(numerals.begin(), numerals.end());
+      p.d_op = d_state->getSolver()->mkOp(api::TUPLE_PROJECT, indices);
+      return;
+    }
+  }
+  Smt2Token sym = expect(Smt2TokenKind::SYMBOL, "an indexed symbol");
+  parseNumeralList(numerals);
+  p.d_op = d_state->mkIndexedOp(std::string(sym.d_text), numerals);
+}
+
+}  // namespace parser
+}  // namespace cvc5
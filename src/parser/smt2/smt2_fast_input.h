@@ -0,0 +1,279 @@
+/*********************                                                        */
+/*! \file smt2_fast_input.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written parser for SMT-LIB 2
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__SMT2__SMT2_FAST_INPUT_H
+#define CVC4__PARSER__SMT2__SMT2_FAST_INPUT_H
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "parser/input.h"
+#include "parser/parse_op.h"
+#include "parser/parser.h"
+#include "parser/smt2/smt2_tokenizer.h"
+
+namespace cvc5 {
+
+class Command;
+
+namespace parser {
+
+class Smt2;
+
+/**
+ * An input stream whose characters are in a contiguous buffer, which is
+ * either a memory mapped file or a string owned by the stream.
+ *
+ * The input stream of a pipe is read one command at a time instead, so that
+ * each command can be executed as soon as it is received: its buffer holds
+ * the last top-level s-expression read by readCommand.
+ */
+class Smt2FastInputStream : public InputStream
+{
+ public:
+  ~Smt2FastInputStream();
+  /**
+   * Create an input stream for the file with the given name, which is memory
+   * mapped if useMmap is true and read into memory otherwise.
+   */
+  static Smt2FastInputStream* newFileInputStream(const std::string& name,
+                                                 bool useMmap);
+  /** Create an input stream for the (entire) contents of input */
+  static Smt2FastInputStream* newStreamInputStream(std::istream& input,
+                                                   const std::string& name);
+  /** Create an input stream for the given string */
+  static Smt2FastInputStream* newStringInputStream(const std::string& input,
+                                                   const std::string& name);
+  /**
+   * Create an input stream for the pipe (or any other file descriptor) fd,
+   * which calls onIdle, if it is given, whenever it is about to wait for more
+   * input, e.g. to flush the responses to the commands read so far.
+   */
+  static Smt2FastInputStream* newPipeInputStream(int fd,
+                                                 std::function<void()> onIdle,
+                                                 const std::string& name);
+  /** Get the buffer of this stream */
+  std::string_view getBuffer() const { return d_buf; }
+  /** Is this the input stream of a pipe? */
+  bool isPipe() const { return d_fd != -1; }
+  /**
+   * For the input stream of a pipe, read the next top-level s-expression (or
+   * atom) into the buffer, skipping the whitespace and comments before it.
+   * This does not wait for input after the closing parenthesis of the
+   * s-expression, which the writer may only send after the response.
+   * Returns false if the end of the input is reached before it.
+   *
+   * @param escapeDupDblQuote Whether "" is the escape sequence for the double
+   * quote in string literals, instead of \".
+   */
+  bool readCommand(bool escapeDupDblQuote);
+  /** The line of the input at which the buffer starts, for a pipe */
+  size_t getLine() const { return d_line; }
+  /** The column of the input at which the buffer starts, for a pipe */
+  size_t getColumn() const { return d_column; }
+
+ private:
+  Smt2FastInputStream(const std::string& name);
+  /**
+   * Get the next character of a pipe, or EOF at the end of its input. Reads
+   * a chunk of the pipe when all of the previous chunk is consumed.
+   */
+  int get();
+  /** Get the next character of a pipe, or EOF, without consuming it */
+  int peek();
+  /** Read the next chunk of a pipe, returns false at the end of its input */
+  bool fill();
+  /** The contents, if they are not memory mapped */
+  std::string d_data;
+  /** The memory mapped region, if any */
+  void* d_map;
+  /** The size of the memory mapped region */
+  size_t d_mapSize;
+  /** The buffer, which is a view of d_map or d_data */
+  std::string_view d_buf;
+  /** The file descriptor of a pipe, or -1 */
+  int d_fd;
+  /** The function called before waiting for the input of a pipe, if any */
+  std::function<void()> d_onIdle;
+  /** The last chunk read from a pipe */
+  std::vector<char> d_chunk;
+  /** The position of the next character of the pipe in d_chunk */
+  size_t d_chunkPos;
+  /** The number of characters in d_chunk */
+  size_t d_chunkSize;
+  /** Whether the end of the input of a pipe was reached */
+  bool d_eof;
+  /** The line and column at which the buffer starts */
+  size_t d_line;
+  size_t d_column;
+  /** The line and column of the next character of a pipe */
+  size_t d_nextLine;
+  size_t d_nextColumn;
+};
+
+/** Smt2FastInput
+ *
+ * A recursive descent parser for SMT-LIB 2 that is an alternative to the
+ * ANTLR parser of Smt2Input, selected by the option --smt2-fast-parser. It
+ * uses the same parser state (the Smt2 object) to build terms and commands,
+ * and it reports errors in the same way.
+ *
+ * This parser operates on a contiguous buffer by way of Smt2Tokenizer, whose
+ * tokens are views into the input. It copies the text of a symbol only once,
+ * when the symbol is first seen, into a table that maps the text of symbols to
+ * the strings used for them, so that the frequent occurrences of a symbol do
+ * not allocate.
+ *
+ * It supports the commands and terms of SMT-LIB 2.6 that do not involve
+ * datatypes declarations, match terms, set comprehensions, the include command
+ * and the CVC4-specific extended commands, as well as the syntax of the
+ * theories of the logic, i.e. indexed and ascribed identifiers, attributes
+ * and higher-order terms. For the unsupported commands and terms, it raises a
+ * parse error asking to use the default parser.
+ */
+class Smt2FastInput : public Input
+{
+ public:
+  /**
+   * Create an input, which takes ownership of inputStream, and which lexes
+   * the input ahead of parsing with the given number of threads if it is
+   * greater than one.
+   */
+  Smt2FastInput(Smt2FastInputStream& inputStream, unsigned threads = 1);
+  ~Smt2FastInput();
+
+ protected:
+  /**
+   * Parse a command from the input. Returns <code>NULL</code> if
+   * there is no command there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  Command* parseCommand() override;
+  /**
+   * Parse an expression from the input. Returns a null
+   * <code>api::Term</code> if there is no expression there to parse.
+   *
+   * @throws ParserException if an error is encountered during parsing.
+   */
+  api::Term parseExpr() override;
+  /** Issue a warning at the position of the last token */
+  void warning(const std::string& msg) override;
+  /** Throws a ParserException at the position of the last token */
+  void parseError(const std::string& msg, bool eofException = false) override;
+  /** Set the parser state, which must be an Smt2 object */
+  void setParser(Parser& parser) override;
+
+ private:
+  /** Get the string of the symbol whose text is s */
+  const std::string& mkSymbol(std::string_view s);
+  /**
+   * Get and consume the next token, checking that numerals have no leading
+   * zeroes in strict mode.
+   */
+  Smt2Token nextToken();
+  /** Consume the next token, which must be of kind k, described by what */
+  Smt2Token expect(Smt2TokenKind k, const char* what);
+  /** Is the next token the (simple) symbol s? */
+  bool isNextSymbol(const char* s);
+  /** Raise a parse error for the unexpected token t */
+  void unexpectedToken(const Smt2Token& t, const std::string& expected);
+  /** Raise a parse error for a construct not supported by this parser */
+  void unsupported(const std::string& what);
+  /** The text of a string literal, processed as in the str rule of Smt2.g */
+  std::string processString(const Smt2Token& t, bool fsmtlib);
+
+  //------------------------- the rules of the grammar
+  /** Parse the command after its left parenthesis, up to its right one */
+  void parseCommandBody(std::unique_ptr<Command>* cmd);
+  /** Parse a symbol, after checking its declaration */
+  const std::string& parseSymbol(DeclarationCheck check, SymbolType type);
+  /** Parse a numeral */
+  uint64_t parseNumeral();
+  /** Parse a nonempty list of numerals, up to a right parenthesis */
+  void parseNumeralList(std::vector<uint64_t>& numerals);
+  /** Parse a keyword, including its colon */
+  std::string parseKeyword();
+  /** Parse a simple symbolic expression, possibly a keyword if allowKeyword */
+  std::string parseSimpleSymbolicExpr(bool allowKeyword);
+  /** Parse a symbolic expression */
+  api::Term parseSymbolicExpr();
+  /** Parse a sort */
+  api::Sort parseSort(DeclarationCheck check);
+  /** Parse a list of sorts, up to a right parenthesis */
+  void parseSortList(std::vector<api::Sort>& sorts);
+  /** Parse a list of sorted variables, up to a right parenthesis */
+  void parseSortedVarList(
+      std::vector<std::pair<std::string, api::Sort>>& sortedVars);
+  /**
+   * Parse a parenthesized list of sorted variables, and bind them as bound
+   * variables in the current scope.
+   */
+  api::Term parseBoundVarList();
+  /** Parse a term, whose annotation (if any) is stored in expr2 */
+  api::Term parseTerm(api::Term& expr2);
+  /** Parse a nonempty list of terms, up to a right parenthesis */
+  void parseTermList(std::vector<api::Term>& terms);
+  /** Parse a term that is not a symbol, after its left parenthesis */
+  api::Term parseCompoundTerm(api::Term& expr2);
+  /** Parse a constant, i.e. a literal */
+  api::Term parseLiteral();
+  /** Parse an indexed constant (_ ...) after its index symbol "_" */
+  api::Term parseIndexedConstant();
+  /** Parse an attributed term (! ...) after its attribute symbol "!" */
+  api::Term parseAttributedTerm(api::Term& expr2);
+  /** Parse an attribute of expr, whose pattern (if any) is stored in retExpr */
+  void parseAttribute(api::Term& expr, api::Term& retExpr);
+  /** Parse a qualified identifier */
+  void parseQualIdentifier(ParseOp& p);
+  /** Parse an ascribed identifier (as ...) after its symbol "as" */
+  void parseAscribedIdentifier(ParseOp& p);
+  /** Parse an identifier */
+  void parseIdentifier(ParseOp& p);
+  /** Parse an indexed identifier (_ ...) after its index symbol "_" */
+  void parseIndexedIdentifier(ParseOp& p);
+  //------------------------- end the rules of the grammar
+
+  /**
+   * If the input stream is a pipe, read its next command and restart the
+   * tokenizer on it. Returns false at the end of the input.
+   */
+  bool readPipeCommand();
+  /** The input stream */
+  Smt2FastInputStream& d_inputStream;
+  /** The tokenizer over the buffer of the input stream */
+  Smt2Tokenizer d_tokenizer;
+  /** The parser state */
+  Smt2* d_state;
+  /**
+   * Maps the text of symbols to the strings used for them. The keys are views
+   * of the values rather than of the input, since the buffer of a pipe is
+   * replaced by each command.
+   */
+  std::unordered_map<std::string_view, std::string> d_symbols;
+};
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC4__PARSER__SMT2__SMT2_FAST_INPUT_H */
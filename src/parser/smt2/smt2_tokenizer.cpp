@@ -0,0 +1,423 @@
+/*********************                                                        */
+/*! \file smt2_tokenizer.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of a hand-written lexer for SMT-LIB 2
+ **/
+
+#include "parser/smt2/smt2_tokenizer.h"
+
+#include <thread>
+
+#include "base/output.h"
+
+namespace cvc5 {
+namespace parser {
+
+namespace {
+
+bool isAlpha(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool isHexDigit(char c)
+{
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/** Is c one of the characters + - / * = % ? ! . $ _ ~ & ^ < > @ ? */
+bool isSymbolChar(char c)
+{
+  switch (c)
+  {
+    case '+':
+    case '-':
+    case '/':
+    case '*':
+    case '=':
+    case '%':
+    case '?':
+    case '!':
+    case '.':
+    case '$':
+    case '_':
+    case '~':
+    case '&':
+    case '^':
+    case '<':
+    case '>':
+    case '@': return true;
+    default: return false;
+  }
+}
+
+bool isSimpleSymbolChar(char c)
+{
+  return isAlpha(c) || isDigit(c) || isSymbolChar(c);
+}
+
+/** The number of characters lexed in a batch ahead of the parser */
+const size_t s_batchSize = 1 << 24;
+
+}  // namespace
+
+Smt2Tokenizer::Smt2Tokenizer(std::string_view buf)
+    : d_buf(buf),
+      d_firstLine(1),
+      d_firstColumn(0),
+      d_pos(0),
+      d_lastOffset(0),
+      d_hasPeeked(false),
+      d_peeked{Smt2TokenKind::END_OF_FILE, std::string_view()},
+      d_escapeDupDblQuote(false),
+      d_threads(1),
+      d_lexedIndex(0),
+      d_scanStop(0)
+{
+}
+
+void Smt2Tokenizer::reset(std::string_view buf,
+                          size_t firstLine,
+                          size_t firstColumn)
+{
+  d_buf = buf;
+  d_firstLine = firstLine;
+  d_firstColumn = firstColumn;
+  d_pos = 0;
+  d_lastOffset = 0;
+  d_hasPeeked = false;
+  d_lexed.clear();
+  d_lexedIndex = 0;
+  d_scanStop = 0;
+}
+
+const Smt2Token& Smt2Tokenizer::peek()
+{
+  if (!d_hasPeeked)
+  {
+    d_peeked = nextLexed();
+    d_hasPeeked = true;
+  }
+  d_lastOffset = d_peeked.d_text.data() - d_buf.data();
+  return d_peeked;
+}
+
+Smt2Token Smt2Tokenizer::next()
+{
+  peek();
+  d_hasPeeked = false;
+  return d_peeked;
+}
+
+void Smt2Tokenizer::getLineColumn(size_t offset,
+                                  size_t& line,
+                                  size_t& column) const
+{
+  line = d_firstLine;
+  size_t lineStart = 0;
+  bool firstLine = true;
+  for (size_t i = 0; i < offset && i < d_buf.size(); i++)
+  {
+    if (d_buf[i] == '\n')
+    {
+      line++;
+      lineStart = i + 1;
+      firstLine = false;
+    }
+  }
+  column = offset - lineStart + (firstLine ? d_firstColumn : 0);
+}
+
+void Smt2Tokenizer::skipWhitespace()
+{
+  size_t size = d_buf.size();
+  while (d_pos < size)
+  {
+    char c = d_buf[d_pos];
+    if (c == ' ' || c == '\t' || c == '\f' || c == '\r' || c == '\n')
+    {
+      d_pos++;
+    }
+    else if (c == ';')
+    {
+      while (d_pos < size && d_buf[d_pos] != '\n' && d_buf[d_pos] != '\r')
+      {
+        d_pos++;
+      }
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+Smt2Token Smt2Tokenizer::mkToken(Smt2TokenKind k, size_t start) const
+{
+  return Smt2Token{k, d_buf.substr(start, d_pos - start)};
+}
+
+Smt2Token Smt2Tokenizer::nextLexed()
+{
+  if (d_lexedIndex < d_lexed.size())
+  {
+    return d_lexed[d_lexedIndex++];
+  }
+  if (d_threads > 1 && d_pos >= d_scanStop && lexBatch())
+  {
+    return d_lexed[d_lexedIndex++];
+  }
+  return lex();
+}
+
+bool Smt2Tokenizer::lexBatch()
+{
+  d_lexed.clear();
+  d_lexedIndex = 0;
+  std::vector<size_t> ends;
+  size_t stop = scanTopLevel(d_pos + s_batchSize, ends);
+  if (ends.empty())
+  {
+    d_scanStop = stop;
+    return false;
+  }
+  // split the top-level s-expressions into runs of about the same size
+  size_t start = d_pos;
+  size_t chunkSize = (ends.back() - start) / d_threads + 1;
+  std::vector<std::string_view> chunks;
+  for (size_t end : ends)
+  {
+    if (end - start >= chunkSize || end == ends.back())
+    {
+      chunks.push_back(d_buf.substr(start, end - start));
+      start = end;
+    }
+  }
+  Trace("smt2-lexer") << "Lex " << ends.size() << " top-level s-expressions in "
+                      << chunks.size() << " chunks" << std::endl;
+  std::vector<std::vector<Smt2Token>> tokens(chunks.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0, nchunks = chunks.size(); i < nchunks; i++)
+  {
+    threads.emplace_back([this, &chunks, &tokens, i]() {
+      // the tokens of the subtokenizer are views into our buffer
+      Smt2Tokenizer sub(chunks[i]);
+      sub.setEscapeDupDblQuote(d_escapeDupDblQuote);
+      for (Smt2Token t = sub.lex(); t.d_kind != Smt2TokenKind::END_OF_FILE;
+           t = sub.lex())
+      {
+        tokens[i].push_back(t);
+      }
+    });
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  for (const std::vector<Smt2Token>& ts : tokens)
+  {
+    d_lexed.insert(d_lexed.end(), ts.begin(), ts.end());
+  }
+  d_pos = ends.back();
+  return !d_lexed.empty();
+}
+
+size_t Smt2Tokenizer::scanTopLevel(size_t limit,
+                                   std::vector<size_t>& ends) const
+{
+  size_t size = d_buf.size();
+  size_t pos = d_pos;
+  size_t depth = 0;
+  while (pos < size)
+  {
+    switch (d_buf[pos++])
+    {
+      case '(': depth++; break;
+      case ')':
+        if (depth > 0 && --depth == 0)
+        {
+          ends.push_back(pos);
+          if (pos >= limit)
+          {
+            return pos;
+          }
+        }
+        break;
+      case ';':
+        while (pos < size && d_buf[pos] != '\n' && d_buf[pos] != '\r')
+        {
+          pos++;
+        }
+        break;
+      case '|':
+        while (pos < size && d_buf[pos] != '|' && d_buf[pos] != '\\')
+        {
+          pos++;
+        }
+        if (pos == size || d_buf[pos] == '\\')
+        {
+          return pos;
+        }
+        pos++;
+        break;
+      case '"':
+      {
+        bool terminated = false;
+        while (pos < size && !terminated)
+        {
+          char s = d_buf[pos++];
+          if (s == '"')
+          {
+            // with "" as an escape, this ends the literal only if it is not
+            // followed by another double quote
+            terminated = !d_escapeDupDblQuote || pos == size
+                         || d_buf[pos] != '"';
+            if (!terminated)
+            {
+              pos++;
+            }
+          }
+          else if (s == '\\' && !d_escapeDupDblQuote && pos < size)
+          {
+            pos++;
+          }
+        }
+        if (!terminated)
+        {
+          return pos;
+        }
+        break;
+      }
+      default: break;
+    }
+  }
+  return pos;
+}
+
+Smt2Token Smt2Tokenizer::lex()
+{
+  skipWhitespace();
+  size_t size = d_buf.size();
+  size_t start = d_pos;
+  if (d_pos == size)
+  {
+    return mkToken(Smt2TokenKind::END_OF_FILE, start);
+  }
+  char c = d_buf[d_pos++];
+  switch (c)
+  {
+    case '(': return mkToken(Smt2TokenKind::LPAREN, start);
+    case ')': return mkToken(Smt2TokenKind::RPAREN, start);
+    case '|':
+    {
+      while (d_pos < size && d_buf[d_pos] != '|' && d_buf[d_pos] != '\\')
+      {
+        d_pos++;
+      }
+      if (d_pos == size || d_buf[d_pos] == '\\')
+      {
+        if (d_pos < size)
+        {
+          // the text includes the backslash
+          d_pos++;
+        }
+        return mkToken(Smt2TokenKind::UNTERMINATED_QUOTED_SYMBOL, start);
+      }
+      d_pos++;
+      // the text excludes the bars
+      return Smt2Token{Smt2TokenKind::QUOTED_SYMBOL,
+                       d_buf.substr(start + 1, d_pos - start - 2)};
+    }
+    case ':':
+    {
+      while (d_pos < size && isSimpleSymbolChar(d_buf[d_pos]))
+      {
+        d_pos++;
+      }
+      return mkToken(d_pos == start + 1 ? Smt2TokenKind::INVALID
+                                        : Smt2TokenKind::KEYWORD,
+                     start);
+    }
+    case '#':
+    {
+      if (d_pos < size && (d_buf[d_pos] == 'x' || d_buf[d_pos] == 'b'))
+      {
+        bool isHex = d_buf[d_pos] == 'x';
+        d_pos++;
+        size_t dstart = d_pos;
+        while (d_pos < size
+               && (isHex ? isHexDigit(d_buf[d_pos])
+                         : (d_buf[d_pos] == '0' || d_buf[d_pos] == '1')))
+        {
+          d_pos++;
+        }
+        if (d_pos > dstart)
+        {
+          return mkToken(isHex ? Smt2TokenKind::HEX : Smt2TokenKind::BINARY,
+                         start);
+        }
+      }
+      return mkToken(Smt2TokenKind::INVALID, start);
+    }
+    case '"':
+    {
+      while (d_pos < size)
+      {
+        char s = d_buf[d_pos++];
+        if (s == '"')
+        {
+          if (!d_escapeDupDblQuote || d_pos == size || d_buf[d_pos] != '"')
+          {
+            return mkToken(Smt2TokenKind::STRING, start);
+          }
+          d_pos++;
+        }
+        else if (s == '\\' && !d_escapeDupDblQuote && d_pos < size)
+        {
+          d_pos++;
+        }
+      }
+      return mkToken(Smt2TokenKind::UNTERMINATED_STRING, start);
+    }
+    default: break;
+  }
+  if (isDigit(c))
+  {
+    while (d_pos < size && isDigit(d_buf[d_pos]))
+    {
+      d_pos++;
+    }
+    if (d_pos + 1 < size && d_buf[d_pos] == '.' && isDigit(d_buf[d_pos + 1]))
+    {
+      d_pos++;
+      while (d_pos < size && isDigit(d_buf[d_pos]))
+      {
+        d_pos++;
+      }
+      return mkToken(Smt2TokenKind::DECIMAL, start);
+    }
+    return mkToken(Smt2TokenKind::NUMERAL, start);
+  }
+  if (isAlpha(c) || isSymbolChar(c))
+  {
+    while (d_pos < size && isSimpleSymbolChar(d_buf[d_pos]))
+    {
+      d_pos++;
+    }
+    return mkToken(Smt2TokenKind::SYMBOL, start);
+  }
+  return mkToken(Smt2TokenKind::INVALID, start);
+}
+
+}  // namespace parser
+}  // namespace cvc5
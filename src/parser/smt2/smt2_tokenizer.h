@@ -0,0 +1,167 @@
+/*********************                                                        */
+/*! \file smt2_tokenizer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A hand-written lexer for SMT-LIB 2
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__SMT2__SMT2_TOKENIZER_H
+#define CVC4__PARSER__SMT2__SMT2_TOKENIZER_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace cvc5 {
+namespace parser {
+
+/** The kinds of tokens of SMT-LIB 2 */
+enum class Smt2TokenKind
+{
+  LPAREN,
+  RPAREN,
+  // a simple symbol, including the reserved words and '_' and '!'
+  SYMBOL,
+  // a |quoted| symbol, whose text excludes the bars
+  QUOTED_SYMBOL,
+  // a keyword, whose text includes the colon
+  KEYWORD,
+  NUMERAL,
+  DECIMAL,
+  // #x..., whose text includes the prefix
+  HEX,
+  // #b..., whose text includes the prefix
+  BINARY,
+  // a string literal, whose text includes the quotes
+  STRING,
+  // a quoted symbol that is not terminated, or that contains a backslash, in
+  // which case its text ends with the backslash
+  UNTERMINATED_QUOTED_SYMBOL,
+  UNTERMINATED_STRING,
+  INVALID,
+  END_OF_FILE
+};
+
+/** A token, whose text is a view into the buffer of its tokenizer */
+struct Smt2Token
+{
+  Smt2TokenKind d_kind;
+  std::string_view d_text;
+};
+
+/** Smt2Tokenizer
+ *
+ * A lexer for SMT-LIB 2 over a contiguous character buffer, e.g. a memory
+ * mapped input file. The text of its tokens are views into the buffer, so
+ * that lexing does not allocate or copy; it is up to the parser to copy the
+ * text of the tokens that it keeps. The buffer must outlive the tokenizer and
+ * its tokens.
+ *
+ * Line and column information is not maintained while lexing; it is computed
+ * from the offset of a token when it is needed, e.g. for an error message.
+ *
+ * If the number of lexing threads is greater than one, the tokenizer lexes
+ * the buffer ahead of the parser in batches: it first scans a batch for the
+ * ends of its top-level s-expressions, which only involves parentheses,
+ * string literals, quoted symbols and comments, and then it lexes runs of
+ * consecutive top-level s-expressions in parallel. Since lexing is
+ * independent of the parser state, this produces the same tokens as lexing
+ * sequentially.
+ */
+class Smt2Tokenizer
+{
+ public:
+  Smt2Tokenizer(std::string_view buf);
+  /**
+   * Set whether string literals use the SMT-LIB 2.5 escape sequence "" for
+   * the double quote, instead of the SMT-LIB 2.0 escape sequence \".
+   */
+  void setEscapeDupDblQuote(bool flag) { d_escapeDupDblQuote = flag; }
+  /** Set the number of threads used for lexing ahead of the parser */
+  void setThreads(size_t n) { d_threads = n; }
+  /**
+   * Restart lexing at the beginning of buf, whose first character is at the
+   * given line and column of the input, e.g. for the next command read from
+   * a pipe. This discards the tokens lexed from the previous buffer.
+   */
+  void reset(std::string_view buf, size_t firstLine, size_t firstColumn);
+  /** Get the next token, without consuming it */
+  const Smt2Token& peek();
+  /** Get and consume the next token */
+  Smt2Token next();
+  /** Get the offset in the buffer of the last token returned by peek or next */
+  size_t getLastOffset() const { return d_lastOffset; }
+  /**
+   * Get the line (starting at 1) and the column (starting at 0) in the input
+   * of the given offset in the buffer. This takes time linear in offset.
+   */
+  void getLineColumn(size_t offset, size_t& line, size_t& column) const;
+
+ private:
+  /**
+   * Get the next token, either from the tokens lexed ahead or by lexing the
+   * token starting at position d_pos
+   */
+  Smt2Token nextLexed();
+  /** Lex the token starting at position d_pos */
+  Smt2Token lex();
+  /**
+   * Lex the next batch of top-level s-expressions starting at position d_pos
+   * into d_lexed using d_threads threads, and advance d_pos past them.
+   * Returns false if no complete top-level s-expression starts at d_pos.
+   */
+  bool lexBatch();
+  /**
+   * Add to ends the offsets just after the top-level s-expressions starting
+   * at position d_pos, until the first such offset that is at least limit.
+   * This stops early before a string literal or a quoted symbol that is not
+   * terminated, or a quoted symbol that contains a backslash, which are left
+   * to be lexed sequentially. Returns the offset where the scan stopped.
+   */
+  size_t scanTopLevel(size_t limit, std::vector<size_t>& ends) const;
+  /** Skip whitespace and comments */
+  void skipWhitespace();
+  /** Make the token of kind k whose text is [start, d_pos) */
+  Smt2Token mkToken(Smt2TokenKind k, size_t start) const;
+  /** The buffer */
+  std::string_view d_buf;
+  /** The line of the input of the first character of the buffer */
+  size_t d_firstLine;
+  /** The column of the input of the first character of the buffer */
+  size_t d_firstColumn;
+  /** The current position in the buffer */
+  size_t d_pos;
+  /** The offset of the last token returned by peek or next */
+  size_t d_lastOffset;
+  /** Whether d_peeked holds the next token */
+  bool d_hasPeeked;
+  /** The next token, if d_hasPeeked */
+  Smt2Token d_peeked;
+  /** Whether "" is the escape sequence for the double quote */
+  bool d_escapeDupDblQuote;
+  /** The number of threads used for lexing ahead of the parser */
+  size_t d_threads;
+  /** The tokens lexed ahead of the parser */
+  std::vector<Smt2Token> d_lexed;
+  /** The index of the next token in d_lexed */
+  size_t d_lexedIndex;
+  /**
+   * The offset up to which the last scan found no complete top-level
+   * s-expression, before which the tokens are lexed sequentially
+   */
+  size_t d_scanStop;
+};
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC4__PARSER__SMT2__SMT2_TOKENIZER_H */
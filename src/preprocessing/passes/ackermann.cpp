@@ -23,6 +23,7 @@
 
 #include "preprocessing/passes/ackermann.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "base/check.h"
@@ -43,35 +44,40 @@ namespace passes {
 
 namespace {
 
-void addLemmaForPair(TNode args1,
-                     TNode args2,
-                     const TNode func,
-                     AssertionPipeline* assertionsToPreprocess,
-                     NodeManager* nm)
+/* Returns true if all arguments of the application term are constants */
+bool hasConstantArgs(TNode term)
+{
+  return std::all_of(
+      term.begin(), term.end(), [](TNode arg) { return arg.isConst(); });
+}
+
+/* Returns true if some arguments of the applications args1 and args2 at the
+ * same position are distinct constants, in which case args1 and args2 may
+ * have different values. */
+bool hasDistinctConstantArgs(TNode args1, TNode args2)
 {
-  Node args_eq;
+  Assert(args1.getNumChildren() == args2.getNumChildren());
+  for (size_t i = 0, n = args1.getNumChildren(); i < n; ++i)
+  {
+    if (args1[i] != args2[i] && args1[i].isConst() && args2[i].isConst())
+    {
+      return true;
+    }
+  }
+  return false;
+}
 
+/* Returns the conjunction of the equalities between the arguments of the
+ * applications args1 and args2 of func, omitting those between identical
+ * arguments. */
+Node mkArgsEqual(TNode args1, TNode args2, const TNode func, NodeManager* nm)
+{
   if (args1.getKind() == kind::APPLY_UF)
   {
     Assert(args1.getOperator() == func);
     Assert(args2.getKind() == kind::APPLY_UF && args2.getOperator() == func);
     Assert(args1.getNumChildren() == args2.getNumChildren());
     Assert(args1.getNumChildren() >= 1);
-
-    std::vector<Node> eqs(args1.getNumChildren());
-
-    for (unsigned i = 0, n = args1.getNumChildren(); i < n; ++i)
-    {
-      eqs[i] = nm->mkNode(kind::EQUAL, args1[i], args2[i]);
-    }
-    if (eqs.size() >= 2)
-    {
-      args_eq = nm->mkNode(kind::AND, eqs);
-    }
-    else
-    {
-      args_eq = eqs[0];
-    }
   }
   else
   {
@@ -79,42 +85,76 @@ void addLemmaForPair(TNode args1,
     Assert(args2.getKind() == kind::SELECT && args2.getOperator() == func);
     Assert(args1.getNumChildren() == 2);
     Assert(args2.getNumChildren() == 2);
-    args_eq = nm->mkNode(Kind::AND,
-      nm->mkNode(kind::EQUAL, args1[0], args2[0]),
-      nm->mkNode(kind::EQUAL, args1[1], args2[1])
-    );
   }
+
+  std::vector<Node> eqs;
+  for (size_t i = 0, n = args1.getNumChildren(); i < n; ++i)
+  {
+    if (args1[i] != args2[i])
+    {
+      eqs.push_back(nm->mkNode(kind::EQUAL, args1[i], args2[i]));
+    }
+  }
+  /* the applications are distinct, hence so are some arguments */
+  Assert(!eqs.empty());
+  return eqs.size() == 1 ? eqs[0] : nm->mkNode(kind::AND, eqs);
+}
+
+void addLemmaForPair(TNode args1,
+                     TNode args2,
+                     const TNode func,
+                     AssertionPipeline* assertionsToPreprocess,
+                     NodeManager* nm)
+{
+  Node args_eq = mkArgsEqual(args1, args2, func, nm);
   Node func_eq = nm->mkNode(kind::EQUAL, args1, args2);
   Node lemma = nm->mkNode(kind::IMPLIES, args_eq, func_eq);
   assertionsToPreprocess->push_back(lemma);
 }
 
+Node mkAckermannSkolem(TNode term, NodeManager* nm)
+{
+  return nm->mkSkolem("SKOLEM$$",
+                      term.getType(),
+                      "is a variable created by the ackermannization "
+                      "preprocessing pass");
+}
+
+/* Store the application term of func. Unless useIte is true, in which case
+ * the substitutions are added by addIteSubstitutions once all applications
+ * are known, term is mapped to a fresh skolem and the lemmas for the pairs
+ * of term and the previous applications are added. */
 void storeFunctionAndAddLemmas(TNode func,
                                TNode term,
                                FunctionToArgsMap& fun_to_args,
                                SubstitutionMap& fun_to_skolem,
                                AssertionPipeline* assertions,
                                NodeManager* nm,
-                               std::vector<TNode>* vec)
+                               std::vector<TNode>* vec,
+                               bool useIte)
 {
-  if (fun_to_args.find(func) == fun_to_args.end())
-  {
-    fun_to_args.insert(make_pair(func, TNodeSet()));
-  }
-  TNodeSet& set = fun_to_args[func];
+  FunctionApplications& apps = fun_to_args[func];
+  TNodeSet& set = apps.d_set;
   if (set.find(term) == set.end())
   {
-    TypeNode tn = term.getType();
-    Node skolem = nm->mkSkolem("SKOLEM$$",
-                               tn,
-                               "is a variable created by the ackermannization "
-                               "preprocessing pass");
-    for (const auto& t : set)
+    bool isConst = hasConstantArgs(term);
+    if (!useIte)
     {
-      addLemmaForPair(t, term, func, assertions, nm);
+      for (TNode t : isConst ? apps.d_nonConstTerms : apps.d_terms)
+      {
+        if (!hasDistinctConstantArgs(t, term))
+        {
+          addLemmaForPair(t, term, func, assertions, nm);
+        }
+      }
+      fun_to_skolem.addSubstitution(term, mkAckermannSkolem(term, nm));
     }
-    fun_to_skolem.addSubstitution(term, skolem);
     set.insert(term);
+    apps.d_terms.push_back(term);
+    if (!isConst)
+    {
+      apps.d_nonConstTerms.push_back(term);
+    }
     /* Add the arguments of term (newest element in set) to the vector, so that
      * collectFunctionsAndLemmas will process them as well.
      * This is only needed if the set has at least two elements
@@ -149,7 +189,8 @@ void storeFunctionAndAddLemmas(TNode func,
 void collectFunctionsAndLemmas(FunctionToArgsMap& fun_to_args,
                                SubstitutionMap& fun_to_skolem,
                                std::vector<TNode>* vec,
-                               AssertionPipeline* assertions)
+                               AssertionPipeline* assertions,
+                               bool useIte)
 {
   TNodeSet seen;
   NodeManager* nm = NodeManager::currentNM();
@@ -169,7 +210,8 @@ void collectFunctionsAndLemmas(FunctionToArgsMap& fun_to_args,
                                   fun_to_skolem,
                                   assertions,
                                   nm,
-                                  vec);
+                                  vec,
+                                  useIte);
       }
       else
       {
@@ -186,6 +228,55 @@ void collectFunctionsAndLemmas(FunctionToArgsMap& fun_to_args,
   }
 }
 
+/* Map the applications of each function to the nested if-then-else terms of
+ * the encoding of Bryant et al., where the i-th application f(X_i) becomes
+ *   ite(X_i = X_1, f_X_1, ite(X_i = X_2, f_X_2, ... f_X_i)).
+ * The applications are ordered by id, such that the arguments of an
+ * application contain only smaller applications. This ensures that the
+ * substitutions of the applications in the conditions are not cyclic. */
+void addIteSubstitutions(FunctionToArgsMap& fun_to_args,
+                         SubstitutionMap& fun_to_skolem)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  for (std::pair<const TNode, FunctionApplications>& f : fun_to_args)
+  {
+    TNode func = f.first;
+    std::vector<TNode> terms = f.second.d_terms;
+    std::sort(terms.begin(), terms.end(), [](TNode t1, TNode t2) {
+      return t1.getId() < t2.getId();
+    });
+    /* the previous applications and their skolems */
+    std::vector<std::pair<TNode, Node>> prev;
+    std::vector<std::pair<TNode, Node>> prevNonConst;
+    for (TNode term : terms)
+    {
+      Node skolem = mkAckermannSkolem(term, nm);
+      bool isConst = hasConstantArgs(term);
+      const std::vector<std::pair<TNode, Node>>& cands =
+          isConst ? prevNonConst : prev;
+      Node res = skolem;
+      for (size_t i = cands.size(); i-- > 0;)
+      {
+        if (!hasDistinctConstantArgs(cands[i].first, term))
+        {
+          res = nm->mkNode(kind::ITE,
+                           mkArgsEqual(term, cands[i].first, func, nm),
+                           cands[i].second,
+                           res);
+        }
+      }
+      Trace("ackermann") << "Ackermann::addIteSubstitutions: " << term
+                         << " -> " << res << std::endl;
+      fun_to_skolem.addSubstitution(term, res);
+      prev.emplace_back(term, skolem);
+      if (!isConst)
+      {
+        prevNonConst.emplace_back(term, skolem);
+      }
+    }
+  }
+}
+
 }  // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -314,8 +405,16 @@ PreprocessingPassResult Ackermann::applyInternal(
   {
     to_process.push_back(a);
   }
-  collectFunctionsAndLemmas(
-      d_funcToArgs, d_funcToSkolem, &to_process, assertionsToPreprocess);
+  bool useIte = options::ackermannIte();
+  collectFunctionsAndLemmas(d_funcToArgs,
+                            d_funcToSkolem,
+                            &to_process,
+                            assertionsToPreprocess,
+                            useIte);
+  if (useIte)
+  {
+    addIteSubstitutions(d_funcToArgs, d_funcToSkolem);
+  }
 
   /* replace applications of UF by skolems */
   // FIXME for model building, github issue #1901
@@ -27,6 +27,7 @@
 #define CVC4__PREPROCESSING__PASSES__ACKERMANN_H
 
 #include <unordered_map>
+#include <vector>
 
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
@@ -38,8 +39,21 @@ namespace preprocessing {
 namespace passes {
 
 using TNodeSet = std::unordered_set<TNode, TNodeHashFunction>;
+
+/* The applications of a function */
+struct FunctionApplications
+{
+  /* All applications */
+  TNodeSet d_set;
+  /* All applications, in the order in which they were found */
+  std::vector<TNode> d_terms;
+  /* The applications with some non-constant argument, in the same order.
+   * Two applications whose arguments are all constant differ in some
+   * argument, hence no consistency constraint is needed between them. */
+  std::vector<TNode> d_nonConstTerms;
+};
 using FunctionToArgsMap =
-    std::unordered_map<TNode, TNodeSet, TNodeHashFunction>;
+    std::unordered_map<TNode, FunctionApplications, TNodeHashFunction>;
 using USortToBVSizeMap =
     std::unordered_map<TypeNode, size_t, TypeNode::HashFunction>;
 
@@ -58,6 +72,13 @@ class Ackermann : public PreprocessingPass
    * - For each f(X) and f(Y) with X = (x1, . . . , xn) and Y = (y1, . . . , yn)
    *   occurring in the input formula, add the following lemma:
    *     (x_1 = y_1 /\ ... /\ x_n = y_n) => f_X = f_Y
+   *   Pairs where some x_i and y_i are distinct constants are skipped, and
+   *   equalities x_i = y_i where x_i and y_i are identical are omitted.
+   *
+   * - Alternatively, with option ackermannIte, replace the i-th application
+   *   f(X_i) of f by the nested if-then-else term
+   *     ite(X_i = X_1, f_X_1, ite(X_i = X_2, f_X_2, ... f_X_i))
+   *   over the previous applications, which needs no lemmas.
    *
    * - For each uninterpreted sort S, suppose k is the number of variables with
    *   sort S, then for each such variable X, introduce a fresh variable BV_X
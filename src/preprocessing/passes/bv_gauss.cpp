@@ -17,6 +17,8 @@
 
 #include "preprocessing/passes/bv_gauss.h"
 
+#include <algorithm>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 
@@ -56,6 +58,89 @@ Integer get_bv_const_value(Node n)
   return get_bv_const(n).getConst<BitVector>().getValue();
 }
 
+using SparseRow = std::vector<std::pair<size_t, uint64_t>>;
+
+/* Arithmetic modulo a word-size number mod, where mod = 0 stands for 2^64. */
+
+uint64_t word_add(uint64_t a, uint64_t b, uint64_t mod)
+{
+  if (mod == 0) { return a + b; }
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(a) + b) % mod);
+}
+
+uint64_t word_neg(uint64_t a, uint64_t mod)
+{
+  if (mod == 0) { return -a; }
+  return a == 0 ? 0 : mod - a;
+}
+
+uint64_t word_mul(uint64_t a, uint64_t b, uint64_t mod)
+{
+  if (mod == 0) { return a * b; }
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) % mod);
+}
+
+/* Returns the multiplicative inverse of a, or 0 if none exists. */
+uint64_t word_inverse(uint64_t a, uint64_t mod)
+{
+  if (mod == 0)
+  {
+    if (a % 2 == 0) { return 0; }
+    /* Newton iteration, doubles the number of correct low bits each step */
+    uint64_t inv = a;
+    for (size_t i = 0; i < 5; ++i)
+    {
+      inv *= 2 - a * inv;
+    }
+    return inv;
+  }
+  /* extended Euclidean algorithm */
+  __int128 r0 = mod, r1 = a, t0 = 0, t1 = 1;
+  while (r1 != 0)
+  {
+    __int128 q = r0 / r1;
+    std::swap(r0, r1);
+    r1 -= q * r0;
+    std::swap(t0, t1);
+    t1 -= q * t0;
+  }
+  if (r0 != 1) { return 0; }
+  return static_cast<uint64_t>(t0 < 0 ? t0 + mod : t0);
+}
+
+/* Returns row - factor * prow modulo mod. */
+SparseRow sub_row(const SparseRow& row,
+                           uint64_t factor,
+                           const SparseRow& prow,
+                           uint64_t mod)
+{
+  SparseRow res;
+  res.reserve(row.size() + prow.size());
+  uint64_t nfactor = word_neg(factor, mod);
+  size_t i = 0, j = 0;
+  while (i < row.size() || j < prow.size())
+  {
+    if (j == prow.size() || (i < row.size() && row[i].first < prow[j].first))
+    {
+      res.push_back(row[i++]);
+    }
+    else
+    {
+      size_t col = prow[j].first;
+      uint64_t val = word_mul(nfactor, prow[j++].second, mod);
+      if (i < row.size() && row[i].first == col)
+      {
+        val = word_add(val, row[i++].second, mod);
+      }
+      if (val != 0)
+      {
+        res.emplace_back(col, val);
+      }
+    }
+  }
+  return res;
+}
+
 }  // namespace
 
 /**
@@ -398,6 +483,117 @@ BVGauss::Result BVGauss::gaussElim(Integer prime,
   return BVGauss::Result::UNIQUE;
 }
 
+BVGauss::Result BVGauss::gaussElimSparse(uint64_t mod,
+                                         size_t ncols,
+                                         std::vector<uint64_t>& rhs,
+                                         std::vector<SparseRow>& lhs,
+                                         std::vector<size_t>& pivots)
+{
+  Assert(mod != 1);
+  Assert(lhs.size() == rhs.size());
+
+  size_t nrows = lhs.size();
+  pivots = std::vector<size_t>(nrows, ncols);
+  /* number of elements per column in the rows that are not yet reduced */
+  std::vector<size_t> colcount(ncols, 0);
+  for (const SparseRow& row : lhs)
+  {
+    for (const std::pair<size_t, uint64_t>& e : row)
+    {
+      Assert(e.first < ncols);
+      Assert(e.second != 0 && (mod == 0 || e.second < mod));
+      colcount[e.first] += 1;
+    }
+  }
+  std::vector<bool> reduced(nrows, false);
+  size_t npivots = 0;
+
+  for (;;)
+  {
+    /* select pivot */
+    size_t prow = nrows, pcol = ncols;
+    uint64_t pinv = 0;
+    size_t pcost = std::numeric_limits<size_t>::max();
+    bool nonzero = false;
+    for (size_t i = 0; i < nrows; ++i)
+    {
+      if (reduced[i] || lhs[i].empty()) continue;
+      nonzero = true;
+      size_t rcost = lhs[i].size() - 1;
+      for (const std::pair<size_t, uint64_t>& e : lhs[i])
+      {
+        size_t cost = rcost * (colcount[e.first] - 1);
+        if (cost > pcost || (cost == pcost && e.first >= pcol)) continue;
+        uint64_t inv = word_inverse(e.second, mod);
+        if (inv == 0) continue; /* not coprime */
+        prow = i;
+        pcol = e.first;
+        pinv = inv;
+        pcost = cost;
+      }
+    }
+    if (prow == nrows)
+    {
+      if (nonzero)
+      {
+        return BVGauss::Result::INVALID;
+      }
+      break;
+    }
+
+    /* normalize the pivot row */
+    SparseRow& row = lhs[prow];
+    for (std::pair<size_t, uint64_t>& e : row)
+    {
+      e.second = word_mul(e.second, pinv, mod);
+      colcount[e.first] -= 1;
+    }
+    rhs[prow] = word_mul(rhs[prow], pinv, mod);
+    reduced[prow] = true;
+    pivots[prow] = pcol;
+    npivots += 1;
+
+    /* eliminate the pivot column in all other rows */
+    for (size_t i = 0; i < nrows; ++i)
+    {
+      if (i == prow) continue;
+      SparseRow::const_iterator it = std::lower_bound(
+          lhs[i].begin(),
+          lhs[i].end(),
+          std::make_pair(pcol, uint64_t(0)));
+      if (it == lhs[i].end() || it->first != pcol) continue;
+      uint64_t factor = it->second;
+      if (!reduced[i])
+      {
+        for (const std::pair<size_t, uint64_t>& e : lhs[i])
+        {
+          colcount[e.first] -= 1;
+        }
+      }
+      lhs[i] = sub_row(lhs[i], factor, row, mod);
+      rhs[i] = word_add(
+          rhs[i], word_neg(word_mul(factor, rhs[prow], mod), mod), mod);
+      if (!reduced[i])
+      {
+        for (const std::pair<size_t, uint64_t>& e : lhs[i])
+        {
+          colcount[e.first] += 1;
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < nrows; ++i)
+  {
+    if (pivots[i] == ncols && rhs[i] != 0)
+    {
+      /* no solution */
+      return BVGauss::Result::NONE;
+    }
+  }
+  return npivots == ncols ? BVGauss::Result::UNIQUE : BVGauss::Result::PARTIAL;
+}
+
 /**
  * Apply Gaussian Elimination on a set of equations modulo some (prime)
  * number given as bit-vector equations.
@@ -427,11 +623,13 @@ BVGauss::Result BVGauss::gaussElimRewriteForUrem(
 
   Node prime;
   Integer iprime;
-  std::unordered_map<Node, std::vector<Integer>, NodeHashFunction> vars;
+  /* the columns of the matrix, i.e., the unknowns */
+  std::unordered_map<Node, size_t, NodeHashFunction> cols;
+  std::vector<Node> vvars;
   size_t neqs = equations.size();
   std::vector<Integer> rhs;
-  std::vector<std::vector<Integer>> lhs =
-      std::vector<std::vector<Integer>>(neqs, std::vector<Integer>());
+  /* the non-zero elements of the rows by column */
+  std::vector<std::vector<std::pair<size_t, Integer>>> rows(neqs);
 
   res = std::unordered_map<Node, Node, NodeHashFunction>();
 
@@ -552,136 +750,154 @@ BVGauss::Result BVGauss::gaussElimRewriteForUrem(
 
     for (const auto& p : tmp)
     {
-      Node var = p.first;
-      Integer val = p.second;
-      if (i > 0 && vars.find(var) == vars.end())
+      auto it = cols.emplace(p.first, vvars.size());
+      if (it.second)
       {
-        /* Add column and fill column elements of rows above with 0. */
-        vars[var].insert(vars[var].end(), i, Integer(0));
-      }
-      vars[var].push_back(val);
-    }
-
-    for (const auto& p : vars)
-    {
-      if (tmp.find(p.first) == tmp.end())
-      {
-        vars[p.first].push_back(Integer(0));
+        vvars.push_back(p.first);
       }
+      rows[i].emplace_back(it.first->second, p.second);
     }
   }
 
-  size_t nvars = vars.size();
+  size_t nvars = vvars.size();
   if (nvars == 0)
   {
     return BVGauss::Result::INVALID;
   }
-  size_t nrows = vars.begin()->second.size();
-#ifdef CVC4_ASSERTIONS
-  for (const auto& p : vars)
-  {
-    Assert(p.second.size() == nrows);
-  }
-#endif
-
-  if (nrows < 1)
+  size_t nrows = neqs;
+  Assert(rows.size() == rhs.size());
+  if (nrows > nvars)
   {
     return BVGauss::Result::INVALID;
   }
 
-  for (size_t i = 0; i < nrows; ++i)
+  /* The result of the elimination: the pivot column of each row (nvars if
+   * none), and the elements of the row in non-pivot columns. */
+  std::vector<size_t> pivots;
+  std::vector<std::vector<std::pair<size_t, Integer>>> reslhs(nrows);
+  BVGauss::Result ret;
+
+  Integer wordmod = Integer(1).multiplyByPow2(64);
+  if (iprime > 1 && iprime <= wordmod)
   {
-    for (const auto& p : vars)
+    /* modulo a word-size number, use sparse elimination */
+    uint64_t mod = iprime == wordmod ? 0 : iprime.getUnsignedLong();
+    std::vector<uint64_t> wrhs;
+    std::vector<SparseRow> wlhs(nrows);
+    for (size_t i = 0; i < nrows; ++i)
     {
-      lhs[i].push_back(p.second[i]);
+      wrhs.push_back(rhs[i].euclidianDivideRemainder(iprime).getUnsignedLong());
+      for (const std::pair<size_t, Integer>& e : rows[i])
+      {
+        Integer val = e.second.euclidianDivideRemainder(iprime);
+        if (val != 0)
+        {
+          wlhs[i].emplace_back(e.first, val.getUnsignedLong());
+        }
+      }
+      std::sort(wlhs[i].begin(), wlhs[i].end());
     }
-  }
 
-#ifdef CVC4_ASSERTIONS
-  for (const auto& row : lhs)
-  {
-    Assert(row.size() == nvars);
-  }
-  Assert(lhs.size() == rhs.size());
-#endif
+    Trace("bv-gauss-elim") << "Applying sparse Gaussian Elimination on "
+                           << nrows << " x " << nvars << " matrix..."
+                           << std::endl;
+    ret = gaussElimSparse(mod, nvars, wrhs, wlhs, pivots);
 
-  if (lhs.size() > lhs[0].size())
-  {
-    return BVGauss::Result::INVALID;
+    for (size_t i = 0; i < nrows; ++i)
+    {
+      rhs[i] = Integer(wrhs[i]);
+      for (const std::pair<size_t, uint64_t>& e : wlhs[i])
+      {
+        if (e.first != pivots[i])
+        {
+          reslhs[i].emplace_back(e.first, Integer(e.second));
+        }
+      }
+    }
   }
-
-  Trace("bv-gauss-elim") << "Applying Gaussian Elimination..." << std::endl;
-  BVGauss::Result ret = gaussElim(iprime, rhs, lhs);
-
-  if (ret != BVGauss::Result::NONE && ret != BVGauss::Result::INVALID)
+  else
   {
-    std::vector<Node> vvars;
-    for (const auto& p : vars) { vvars.push_back(p.first); }
-    Assert(nvars == vvars.size());
-    Assert(nrows == lhs.size());
-    Assert(nrows == rhs.size());
-    NodeManager *nm = NodeManager::currentNM();
-    if (ret == BVGauss::Result::UNIQUE)
+    std::vector<std::vector<Integer>> lhs(
+        nrows, std::vector<Integer>(nvars, Integer(0)));
+    for (size_t i = 0; i < nrows; ++i)
     {
-      for (size_t i = 0; i < nvars; ++i)
+      for (const std::pair<size_t, Integer>& e : rows[i])
       {
-        res[vvars[i]] = nm->mkConst<BitVector>(
-            BitVector(bv::utils::getSize(vvars[i]), rhs[i]));
+        lhs[i][e.first] = e.second;
       }
     }
-    else
-    {
-      Assert(ret == BVGauss::Result::PARTIAL);
 
-      for (size_t pcol = 0, prow = 0; pcol < nvars && prow < nrows;
-           ++pcol, ++prow)
+    Trace("bv-gauss-elim") << "Applying Gaussian Elimination..." << std::endl;
+    ret = gaussElim(iprime, rhs, lhs);
+
+    pivots = std::vector<size_t>(nrows, nvars);
+    size_t npivots = 0;
+    for (size_t i = 0; i < nrows; ++i)
+    {
+      for (size_t j = 0; j < nvars; ++j)
       {
-        Assert(lhs[prow][pcol] == 0 || lhs[prow][pcol] == 1);
-        while (pcol < nvars && lhs[prow][pcol] == 0) pcol += 1;
-        if (pcol >= nvars)
-        {
-          Assert(rhs[prow] == 0);
-          break;
-        }
-        if (lhs[prow][pcol] == 0)
+        if (lhs[i][j] == 0) continue;
+        if (pivots[i] == nvars)
         {
-          Assert(rhs[prow] == 0);
-          continue;
+          Assert(lhs[i][j] == 1);
+          pivots[i] = j;
+          npivots += 1;
         }
-        Assert(lhs[prow][pcol] == 1);
-        std::vector<Node> stack;
-        for (size_t i = pcol + 1; i < nvars; ++i)
+        else
         {
-          if (lhs[prow][i] == 0) continue;
-          /* Normalize (no negative numbers, hence no subtraction)
-           * e.g., x = 4 - 2y  --> x = 4 + 9y (modulo 11) */
-          Integer m = iprime - lhs[prow][i];
-          Node bv = bv::utils::mkConst(bv::utils::getSize(vvars[i]), m);
-          Node mult = nm->mkNode(kind::BITVECTOR_MULT, vvars[i], bv);
-          stack.push_back(mult);
+          reslhs[i].emplace_back(j, lhs[i][j]);
         }
+      }
+    }
+    if (ret == BVGauss::Result::UNIQUE && npivots < nvars)
+    {
+      ret = BVGauss::Result::PARTIAL;
+    }
+  }
 
-        if (stack.empty())
-        {
-          res[vvars[pcol]] = nm->mkConst<BitVector>(
-              BitVector(bv::utils::getSize(vvars[pcol]), rhs[prow]));
-        }
-        else
-        {
-          Node tmp = stack.size() == 1
-                         ? stack[0]
-                         : nm->mkNode(kind::BITVECTOR_PLUS, stack);
+  if (ret != BVGauss::Result::NONE && ret != BVGauss::Result::INVALID)
+  {
+    NodeManager *nm = NodeManager::currentNM();
+    for (size_t prow = 0; prow < nrows; ++prow)
+    {
+      size_t pcol = pivots[prow];
+      if (pcol == nvars)
+      {
+        Assert(rhs[prow] == 0);
+        continue;
+      }
+      std::vector<Node> stack;
+      for (const std::pair<size_t, Integer>& e : reslhs[prow])
+      {
+        size_t i = e.first;
+        /* Normalize (no negative numbers, hence no subtraction)
+         * e.g., x = 4 - 2y  --> x = 4 + 9y (modulo 11) */
+        Integer m = iprime - e.second;
+        Node bv = bv::utils::mkConst(bv::utils::getSize(vvars[i]), m);
+        Node mult = nm->mkNode(kind::BITVECTOR_MULT, vvars[i], bv);
+        stack.push_back(mult);
+      }
 
-          if (rhs[prow] != 0)
-          {
-            tmp = nm->mkNode(kind::BITVECTOR_PLUS,
-                             bv::utils::mkConst(
-                                 bv::utils::getSize(vvars[pcol]), rhs[prow]),
-                             tmp);
-          }
-          Assert(!is_bv_const(tmp));
-          res[vvars[pcol]] = nm->mkNode(kind::BITVECTOR_UREM, tmp, prime);
+      if (stack.empty())
+      {
+        res[vvars[pcol]] = nm->mkConst<BitVector>(
+            BitVector(bv::utils::getSize(vvars[pcol]), rhs[prow]));
+      }
+      else
+      {
+        Node tmp = stack.size() == 1
+                       ? stack[0]
+                       : nm->mkNode(kind::BITVECTOR_PLUS, stack);
+
+        if (rhs[prow] != 0)
+        {
+          tmp = nm->mkNode(kind::BITVECTOR_PLUS,
+                           bv::utils::mkConst(
+                               bv::utils::getSize(vvars[pcol]), rhs[prow]),
+                           tmp);
         }
+        Assert(!is_bv_const(tmp));
+        res[vvars[pcol]] = nm->mkNode(kind::BITVECTOR_UREM, tmp, prime);
       }
     }
   }
@@ -20,6 +20,10 @@
 #ifndef CVC4__PREPROCESSING__PASSES__BV_GAUSS_ELIM_H
 #define CVC4__PREPROCESSING__PASSES__BV_GAUSS_ELIM_H
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
 
@@ -95,6 +99,33 @@ class BVGauss : public PreprocessingPass
                           std::vector<Integer>& rhs,
                           std::vector<std::vector<Integer>>& lhs);
 
+  /** A sparse row: its non-zero elements by increasing column index. */
+  using SparseRow = std::vector<std::pair<size_t, uint64_t>>;
+
+  /**
+   * Apply Gauss-Jordan Elimination on the sparse matrix lhs with ncols
+   * columns modulo the word-size number mod, where mod = 0 stands for 2^64
+   * and mod != 1. The elements of lhs and rhs must be smaller than mod.
+   *
+   * Pivots are selected according to the Markowitz criterion, i.e., an
+   * element (i, j) whose multiplicative inverse exists and for which
+   * (#elements in row i - 1) * (#elements in column j - 1) is minimal among
+   * the rows that are not yet reduced, in order to limit fill-in. Ties are
+   * broken by the smallest column, and then the smallest row.
+   *
+   * On return, pivots[i] is the pivot column of row i, which is ncols if row
+   * i is zero. The pivot elements are 1 and no other row has an element in a
+   * pivot column. Returns INVALID if there is a non-zero row left for which
+   * no element has an inverse, NONE if there is a zero row with a non-zero
+   * right-hand side, UNIQUE if all columns are pivot columns, and PARTIAL,
+   * otherwise.
+   */
+  static Result gaussElimSparse(uint64_t mod,
+                                size_t ncols,
+                                std::vector<uint64_t>& rhs,
+                                std::vector<SparseRow>& lhs,
+                                std::vector<size_t>& pivots);
+
   static Result gaussElimRewriteForUrem(
       const std::vector<Node>& equations,
       std::unordered_map<Node, Node, NodeHashFunction>& res);
@@ -0,0 +1,196 @@
+/*********************                                                        */
+/*! \file bv_slice.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The BvSlice preprocessing pass
+ **
+ ** Slices bit-vector variables at the cut points of their extracts.
+ **/
+
+#include "preprocessing/passes/bv_slice.h"
+
+#include <unordered_set>
+
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/rewriter.h"
+#include "theory/trust_substitutions.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+using namespace cvc5::theory;
+using namespace cvc5::theory::bv;
+
+namespace {
+
+/** Whether n is a free bit-vector variable */
+bool isBVVar(TNode n)
+{
+  return n.isVar() && n.getKind() != kind::BOUND_VARIABLE
+         && n.getType().isBitVector();
+}
+
+}  // namespace
+
+BvSlice::BvSlice(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "bv-slice"){};
+
+void BvSlice::collectCuts(TNode n,
+                          Bases& bases,
+                          std::vector<std::pair<Node, Node>>& equalities)
+{
+  std::vector<TNode> visit;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.getKind() == kind::BITVECTOR_EXTRACT && isBVVar(cur[0]))
+    {
+      uint32_t size = utils::getSize(cur[0]);
+      auto it = bases.find(cur[0]);
+      if (it == bases.end())
+      {
+        it = bases.emplace(cur[0], Base(size)).first;
+      }
+      it->second.sliceAt(utils::getExtractLow(cur));
+      it->second.sliceAt(utils::getExtractHigh(cur) + 1);
+    }
+    else if (cur.getKind() == kind::EQUAL && isBVVar(cur[0])
+             && isBVVar(cur[1]))
+    {
+      equalities.emplace_back(cur[0], cur[1]);
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  } while (!visit.empty());
+}
+
+bool BvSlice::addCuts(const Base& from, Base& to, uint32_t size)
+{
+  bool changed = false;
+  for (uint32_t i = 1; i < size; ++i)
+  {
+    if (from.isCutPoint(i) && !to.isCutPoint(i))
+    {
+      to.sliceAt(i);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+Node BvSlice::mkSlices(TNode x, const Base& base)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  uint32_t size = utils::getSize(x);
+  std::vector<Node> slices;
+  uint32_t high = size;
+  for (uint32_t i = size; i-- > 0;)
+  {
+    if (base.isCutPoint(i))
+    {
+      slices.push_back(nm->mkSkolem(
+          "bvslice",
+          nm->mkBitVectorType(high - i),
+          "is a slice of a variable created by the bv-slice preprocessing "
+          "pass"));
+      high = i;
+    }
+  }
+  return utils::mkConcat(slices);
+}
+
+PreprocessingPassResult BvSlice::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  Bases bases;
+  std::vector<std::pair<Node, Node>> equalities;
+  for (const Node& assertion : assertionsToPreprocess->ref())
+  {
+    collectCuts(assertion, bases, equalities);
+  }
+
+  // share the cut points of equal variables until a fixpoint
+  bool changed = !equalities.empty();
+  while (changed)
+  {
+    changed = false;
+    for (const std::pair<Node, Node>& eq : equalities)
+    {
+      auto it0 = bases.find(eq.first);
+      auto it1 = bases.find(eq.second);
+      if (it0 == bases.end() && it1 == bases.end())
+      {
+        continue;
+      }
+      uint32_t size = utils::getSize(eq.first);
+      if (it0 == bases.end())
+      {
+        it0 = bases.emplace(eq.first, Base(size)).first;
+      }
+      else if (it1 == bases.end())
+      {
+        it1 = bases.emplace(eq.second, Base(size)).first;
+      }
+      changed |= addCuts(it0->second, it1->second, size);
+      changed |= addCuts(it1->second, it0->second, size);
+    }
+  }
+
+  std::vector<Node> vars, slices;
+  TrustSubstitutionMap& tlsm = d_preprocContext->getTopLevelSubstitutions();
+  for (const std::pair<const Node, Base>& p : bases)
+  {
+    uint32_t size = utils::getSize(p.first);
+    bool sliced = false;
+    for (uint32_t i = 1; i < size && !sliced; ++i)
+    {
+      sliced = p.second.isCutPoint(i);
+    }
+    if (!sliced)
+    {
+      continue;
+    }
+    Node s = mkSlices(p.first, p.second);
+    Debug("bv-slice") << "slice " << p.first << " " << p.second.debugPrint()
+                      << " as " << s << std::endl;
+    vars.push_back(p.first);
+    slices.push_back(s);
+    tlsm.addSubstitution(p.first, s);
+  }
+  if (vars.empty())
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    Node cur = (*assertionsToPreprocess)[i];
+    Node res =
+        cur.substitute(vars.begin(), vars.end(), slices.begin(), slices.end());
+    if (res != cur)
+    {
+      assertionsToPreprocess->replace(i, Rewriter::rewrite(res));
+    }
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
@@ -0,0 +1,78 @@
+/*********************                                                        */
+/*! \file bv_slice.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The BvSlice preprocessing pass
+ **
+ ** Slices bit-vector variables at the cut points of their extracts, and
+ ** replaces them by the concatenation of fresh variables, one per slice.
+ ** Enabled via option `--bv-slice`.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__BV_SLICE_H
+#define CVC4__PREPROCESSING__PASSES__BV_SLICE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "theory/bv/slicer.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * Every extract of a bit-vector variable x cuts x at its bounds. The cut
+ * points of variables that are equal are shared, until a fixpoint. Each
+ * variable with cut points is then replaced by the concatenation of fresh
+ * variables, one for each slice in between consecutive cut points, and the
+ * rewriter turns the extracts into the slices they cover. The slices are
+ * independent variables, so that extracts of disjoint parts of x do not
+ * share any bits, and the bit-blaster sees narrow variables.
+ *
+ * The substitutions of the variables by their slices are added to the
+ * top-level substitutions, which gives their values in the model.
+ */
+class BvSlice : public PreprocessingPass
+{
+ public:
+  BvSlice(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  using Bases = std::unordered_map<Node, theory::bv::Base, NodeHashFunction>;
+
+  /**
+   * Collect the cut points of the variables of n in bases, and the
+   * equalities between variables in equalities.
+   */
+  void collectCuts(TNode n,
+                   Bases& bases,
+                   std::vector<std::pair<Node, Node>>& equalities);
+  /** Add the cut points of from to to, returns true if to changed */
+  static bool addCuts(const theory::bv::Base& from,
+                      theory::bv::Base& to,
+                      uint32_t size);
+  /** Make the concatenation of the fresh slices of x at base */
+  static Node mkSlices(TNode x, const theory::bv::Base& base);
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC4__PREPROCESSING__PASSES__BV_SLICE_H */
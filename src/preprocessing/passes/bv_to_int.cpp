@@ -351,7 +351,21 @@ Node BVToInt::translateWithChildren(Node original,
       uint64_t bvsize = original[0].getType().getBitVectorSize();
       Node plus = d_nm->mkNode(kind::PLUS, translated_children);
       Node p2 = pow2(bvsize);
-      returnNode = d_nm->mkNode(kind::INTS_MODULUS_TOTAL, plus, p2);
+      if (options::solveBVAsIntOverflowIte())
+      {
+        // Both children are in [0, 2^k), so their sum overflows at most
+        // once. Splitting on the overflow keeps the translation linear
+        // without introducing the integer quotient of the modulus.
+        returnNode =
+            d_nm->mkNode(kind::ITE,
+                         d_nm->mkNode(kind::LT, plus, p2),
+                         plus,
+                         d_nm->mkNode(kind::MINUS, plus, p2));
+      }
+      else
+      {
+        returnNode = d_nm->mkNode(kind::INTS_MODULUS_TOTAL, plus, p2);
+      }
       break;
     }
     case kind::BITVECTOR_MULT:
@@ -19,7 +19,8 @@
  **         integer variable.
  ** Tr(c) = the integer value of c, for any bit-vector constant c.
  ** Tr((bvadd s t)) = Tr(s) + Tr(t) mod 2^k, where k is the bit width of
- **         s and t.
+ **         s and t. With --solve-bv-as-int-overflow-ite, it is
+ **         ite(Tr(s) + Tr(t) < 2^k, Tr(s) + Tr(t), Tr(s) + Tr(t) - 2^k).
  ** Similar transformations are done for bvmul, bvsub, bvudiv, bvurem, bvneg,
  **         bvnot, bvconcat, bvextract
  ** Tr((_ zero_extend m) x) = Tr(x)
@@ -28,16 +28,24 @@ namespace passes {
 ExtRewPre::ExtRewPre(PreprocessingPassContext* preprocContext)
     : PreprocessingPass(preprocContext, "ext-rew-pre"){};
 
+ExtRewPre::~ExtRewPre() {}
+
 PreprocessingPassResult ExtRewPre::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
-  theory::quantifiers::ExtendedRewriter extr(options::extRewPrepAgg());
-  for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  d_extr.reset(
+      new theory::quantifiers::ExtendedRewriter(options::extRewPrepAgg()));
+  return applyToEachAssertion(assertionsToPreprocess);
+}
+
+theory::TrustNode ExtRewPre::applyToAssertion(TNode assertion)
+{
+  Node ret = d_extr->extendedRewrite(assertion);
+  if (ret == assertion)
   {
-    assertionsToPreprocess->replace(
-        i, extr.extendedRewrite((*assertionsToPreprocess)[i]));
+    return theory::TrustNode::null();
   }
-  return PreprocessingPassResult::NO_CONFLICT;
+  return theory::TrustNode::mkTrustRewrite(assertion, ret, nullptr);
 }
 
 
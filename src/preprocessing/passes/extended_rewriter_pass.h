@@ -19,9 +19,16 @@
 #ifndef CVC4__PREPROCESSING__PASSES__EXTENDED_REWRITER_PASS_H
 #define CVC4__PREPROCESSING__PASSES__EXTENDED_REWRITER_PASS_H
 
+#include <memory>
+
 #include "preprocessing/preprocessing_pass.h"
 
 namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+class ExtendedRewriter;
+}
+}  // namespace theory
 namespace preprocessing {
 namespace passes {
 
@@ -29,10 +36,16 @@ class ExtRewPre : public PreprocessingPass
 {
  public:
   ExtRewPre(PreprocessingPassContext* preprocContext);
+  ~ExtRewPre();
 
  protected:
   PreprocessingPassResult applyInternal(
       AssertionPipeline* assertionsToPreprocess) override;
+  theory::TrustNode applyToAssertion(TNode assertion) override;
+
+ private:
+  /** The extended rewriter, created by each call to applyInternal */
+  std::unique_ptr<theory::quantifiers::ExtendedRewriter> d_extr;
 };
 
 }  // namespace passes
@@ -108,14 +108,17 @@ void compressBeforeRealAssertions(AssertionPipeline* assertionsToPreprocess,
 
 ITESimp::Statistics::Statistics()
     : d_arithSubstitutionsAdded(
-          "preprocessing::passes::ITESimp::ArithSubstitutionsAdded", 0)
+          "preprocessing::passes::ITESimp::ArithSubstitutionsAdded", 0),
+      d_cacheClears("preprocessing::passes::ITESimp::CacheClears", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_arithSubstitutionsAdded);
+  smtStatisticsRegistry()->registerStat(&d_cacheClears);
 }
 
 ITESimp::Statistics::~Statistics()
 {
   smtStatisticsRegistry()->unregisterStat(&d_arithSubstitutionsAdded);
+  smtStatisticsRegistry()->unregisterStat(&d_cacheClears);
 }
 
 bool ITESimp::doneSimpITE(AssertionPipeline* assertionsToPreprocess)
@@ -238,6 +241,7 @@ PreprocessingPassResult ITESimp::applyInternal(
   d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
 
   size_t nasserts = assertionsToPreprocess->size();
+  size_t cacheLimit = options::iteSimpCacheLimit();
   for (size_t i = 0; i < nasserts; ++i)
   {
     d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
@@ -247,6 +251,15 @@ PreprocessingPassResult ITESimp::applyInternal(
     {
       return PreprocessingPassResult::CONFLICT;
     }
+    // The caches are only used to share work between the assertions, hence
+    // they are cleared when they get too large. This also bounds their size
+    // across the calls of incremental solving.
+    if (cacheLimit > 0 && d_iteUtilities.cacheSize() > cacheLimit)
+    {
+      Trace("ite-simp") << "clear caches after assertion " << i << std::endl;
+      d_iteUtilities.clearSimpITECaches();
+      ++d_statistics.d_cacheClears;
+    }
   }
   bool done = doneSimpITE(assertionsToPreprocess);
   if (nasserts < assertionsToPreprocess->size())
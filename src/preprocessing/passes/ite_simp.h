@@ -38,6 +38,7 @@ class ITESimp : public PreprocessingPass
   struct Statistics
   {
     IntStat d_arithSubstitutionsAdded;
+    IntStat d_cacheClears;
     Statistics();
     ~Statistics();
   };
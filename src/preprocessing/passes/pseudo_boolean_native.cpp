@@ -0,0 +1,282 @@
+/*********************                                                        */
+/*! \file pseudo_boolean_native.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Moves pseudo-Boolean constraints to the SAT solver
+ **/
+
+#include "preprocessing/passes/pseudo_boolean_native.h"
+
+#include "expr/skolem_manager.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "prop/prop_engine.h"
+#include "smt/smt_statistics_registry.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+namespace {
+
+/**
+ * The bound on the weights of the constraints, which ensures that their sums
+ * do not overflow in the SAT solver.
+ */
+const Rational s_maxWeight(Integer(1L << 31));
+
+}  // namespace
+
+PseudoBooleanNative::PseudoBooleanNative(
+    PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "pseudo-boolean-native")
+{
+}
+
+PreprocessingPassResult PseudoBooleanNative::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  prop::PropEngine* pe = d_preprocContext->getPropEngine();
+  Node tn = nm->mkConst(true);
+  // the purification variables of the conditions that are not variables
+  std::map<Node, Node> purify;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    Node a = (*assertionsToPreprocess)[i];
+    std::vector<Constraint> cons;
+    if (!getConstraints(a, cons))
+    {
+      continue;
+    }
+    Trace("pb-native") << "Pseudo-Boolean assertion: " << a << std::endl;
+    bool added = true;
+    for (Constraint& c : cons)
+    {
+      for (Node& lit : c.d_lits)
+      {
+        bool pol = lit.getKind() != NOT;
+        Node atom = pol ? lit : lit[0];
+        if (!atom.isVar())
+        {
+          Node& k = purify[atom];
+          if (k.isNull())
+          {
+            k = sm->mkPurifySkolem(
+                atom, "pbk", "a literal of a pseudo-Boolean constraint");
+            assertionsToPreprocess->push_back(k.eqNode(atom));
+          }
+          atom = k;
+        }
+        lit = pol ? atom : atom.notNode();
+      }
+      if (!pe->addCardinalityConstraint(c.d_lits, c.d_weights, c.d_bound))
+      {
+        // the SAT solver does not support native constraints
+        Assert(&c == &cons[0]);
+        added = false;
+        break;
+      }
+      ++(d_statistics.d_numConstraints);
+    }
+    if (!added)
+    {
+      break;
+    }
+    ++(d_statistics.d_numAssertions);
+    assertionsToPreprocess->replace(i, tn);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+bool PseudoBooleanNative::addSum(TNode n,
+                                 const Rational& c,
+                                 std::map<Node, Rational>& coeffs,
+                                 Rational& constant)
+{
+  Kind k = n.getKind();
+  if (k == CONST_RATIONAL)
+  {
+    constant += c * n.getConst<Rational>();
+    return true;
+  }
+  if (k == PLUS)
+  {
+    for (TNode nc : n)
+    {
+      if (!addSum(nc, c, coeffs, constant))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (k == MULT && n.getNumChildren() == 2 && n[0].getKind() == CONST_RATIONAL)
+  {
+    return addSum(n[1], c * n[0].getConst<Rational>(), coeffs, constant);
+  }
+  if (k == ITE && n[1].getKind() == CONST_RATIONAL
+      && n[2].getKind() == CONST_RATIONAL)
+  {
+    // (ite b t e) is e + (t - e) * b
+    const Rational& t = n[1].getConst<Rational>();
+    const Rational& e = n[2].getConst<Rational>();
+    Rational d = c * (t - e);
+    constant += c * e;
+    if (n[0].getKind() == NOT)
+    {
+      // (not b) is 1 - b
+      constant += d;
+      coeffs[n[0][0]] -= d;
+    }
+    else
+    {
+      coeffs[n[0]] += d;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool PseudoBooleanNative::addAtMost(const std::map<Node, Rational>& coeffs,
+                                    Rational bound,
+                                    bool strict,
+                                    std::vector<Constraint>& cons)
+{
+  // scale the constraint to integers
+  Integer d = bound.getDenominator();
+  for (const std::pair<const Node, Rational>& c : coeffs)
+  {
+    d = d.lcm(c.second.getDenominator());
+  }
+  Rational scale(d);
+  bound = bound * scale;
+  if (strict)
+  {
+    bound = bound - Rational(1);
+  }
+  Constraint con;
+  Rational total(0);
+  for (const std::pair<const Node, Rational>& c : coeffs)
+  {
+    Rational w = c.second * scale;
+    Node lit = c.first;
+    if (w.sgn() == 0)
+    {
+      continue;
+    }
+    if (w.sgn() < 0)
+    {
+      // w * b is w + (-w) * (not b)
+      bound = bound - w;
+      w = -w;
+      lit = lit.notNode();
+    }
+    if (w >= s_maxWeight)
+    {
+      return false;
+    }
+    con.d_lits.push_back(lit);
+    con.d_weights.push_back(w.getNumerator().getUnsignedLong());
+    total += w;
+  }
+  if (bound.sgn() < 0)
+  {
+    // unsatisfiable, which we leave to arithmetic
+    return false;
+  }
+  if (total <= bound)
+  {
+    // trivially satisfied
+    return true;
+  }
+  con.d_bound = bound.getNumerator().getUnsignedLong();
+  cons.push_back(con);
+  return true;
+}
+
+bool PseudoBooleanNative::getConstraints(TNode lit,
+                                         std::vector<Constraint>& cons)
+{
+  bool pol = lit.getKind() != NOT;
+  TNode atom = pol ? lit : lit[0];
+  Kind k = atom.getKind();
+  if ((k != GEQ && k != GT && k != LEQ && k != LT && k != EQUAL)
+      || !atom[0].getType().isReal() || (k == EQUAL && !pol))
+  {
+    return false;
+  }
+  // the literal is a relation between sum_b coeffs[b] * b + constant and 0
+  std::map<Node, Rational> coeffs;
+  Rational constant(0);
+  if (!addSum(atom[0], Rational(1), coeffs, constant)
+      || !addSum(atom[1], Rational(-1), coeffs, constant))
+  {
+    return false;
+  }
+  std::map<Node, Rational> neg;
+  for (const std::pair<const Node, Rational>& c : coeffs)
+  {
+    if (c.second.sgn() != 0)
+    {
+      neg[c.first] = -c.second;
+    }
+  }
+  if (neg.size() < 2)
+  {
+    // not worth a constraint
+    return false;
+  }
+  std::vector<Constraint> lcons;
+  if (k == EQUAL)
+  {
+    if (!addAtMost(coeffs, -constant, false, lcons)
+        || !addAtMost(neg, constant, false, lcons))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    // whether the sum is greater than 0, and whether strictly
+    bool geq = (k == GEQ || k == GT) == pol;
+    bool strict = (k == GT || k == LT) == pol;
+    if (!(geq ? addAtMost(neg, constant, strict, lcons)
+              : addAtMost(coeffs, -constant, strict, lcons)))
+    {
+      return false;
+    }
+  }
+  cons.insert(cons.end(), lcons.begin(), lcons.end());
+  return true;
+}
+
+PseudoBooleanNative::Statistics::Statistics()
+    : d_numAssertions(
+        "preprocessing::passes::PseudoBooleanNative::NumAssertions", 0),
+      d_numConstraints(
+          "preprocessing::passes::PseudoBooleanNative::NumConstraints", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numAssertions);
+  smtStatisticsRegistry()->registerStat(&d_numConstraints);
+}
+
+PseudoBooleanNative::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numAssertions);
+  smtStatisticsRegistry()->unregisterStat(&d_numConstraints);
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
@@ -0,0 +1,107 @@
+/*********************                                                        */
+/*! \file pseudo_boolean_native.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Moves pseudo-Boolean constraints to the SAT solver
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__PSEUDO_BOOLEAN_NATIVE_H
+#define CVC4__PREPROCESSING__PASSES__PSEUDO_BOOLEAN_NATIVE_H
+
+#include <map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "util/rational.h"
+#include "util/stats_base.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * Detects the top-level assertions that are linear constraints over 0/1
+ * terms, i.e. terms (ite c a b) for constants a and b, such as the
+ * cardinality constraint
+ *   (<= (+ (ite c1 1 0) ... (ite cn 1 0)) k)
+ * and gives them to the SAT solver, which propagates them natively by
+ * counting the weight of the true literals and explains its propagations by
+ * clauses on demand. The assertions are then replaced by true, so that
+ * neither arithmetic nor the CNF sees them.
+ *
+ * Each constraint is normalized to the form
+ *   w1 * l1 + ... + wm * lm <= K
+ * for positive integer weights wi and literals li, where equalities give two
+ * such constraints. The conditions that are not Boolean variables are
+ * purified by fresh Boolean variables, whose definitions are added as
+ * new assertions. This pass must be run after the passes that apply
+ * substitutions, since the variables of the constraints are fixed when they
+ * are given to the SAT solver.
+ */
+class PseudoBooleanNative : public PreprocessingPass
+{
+ public:
+  PseudoBooleanNative(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** A constraint sum_i d_weights[i] * d_lits[i] <= d_bound */
+  struct Constraint
+  {
+    std::vector<Node> d_lits;
+    std::vector<uint64_t> d_weights;
+    uint64_t d_bound;
+  };
+  /**
+   * Add c * n to the sum whose coefficients of the conditions are coeffs and
+   * whose constant is constant. Returns false if n is not a linear combination
+   * of 0/1 terms.
+   */
+  static bool addSum(TNode n,
+                     const Rational& c,
+                     std::map<Node, Rational>& coeffs,
+                     Rational& constant);
+  /**
+   * Add the constraint sum_x coeffs[x] * x <= bound, or < bound if strict, to
+   * cons. Returns false if it is unsatisfiable or its weights are too large.
+   */
+  static bool addAtMost(const std::map<Node, Rational>& coeffs,
+                        Rational bound,
+                        bool strict,
+                        std::vector<Constraint>& cons);
+  /**
+   * Get the pseudo-Boolean constraints that are equivalent to the literal
+   * lit. Returns false if there are none.
+   */
+  static bool getConstraints(TNode lit, std::vector<Constraint>& cons);
+
+  struct Statistics
+  {
+    /** The number of assertions given to the SAT solver */
+    IntStat d_numAssertions;
+    /** The number of constraints given to the SAT solver */
+    IntStat d_numConstraints;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC4__PREPROCESSING__PASSES__PSEUDO_BOOLEAN_NATIVE_H */
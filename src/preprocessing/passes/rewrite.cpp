@@ -32,8 +32,10 @@ Rewrite::Rewrite(PreprocessingPassContext* preprocContext)
 PreprocessingPassResult Rewrite::applyInternal(
   AssertionPipeline* assertionsToPreprocess)
 {
+  std::vector<Node> rewritten = assertionsToPreprocess->ref();
+  Rewriter::rewriteAll(rewritten);
   for (unsigned i = 0; i < assertionsToPreprocess->size(); ++i) {
-    assertionsToPreprocess->replace(i, Rewriter::rewrite((*assertionsToPreprocess)[i]));
+    assertionsToPreprocess->replace(i, rewritten[i]);
   }
 
   return PreprocessingPassResult::NO_CONFLICT;
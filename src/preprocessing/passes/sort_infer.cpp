@@ -49,10 +49,10 @@ PreprocessingPassResult SortInferencePass::applyInternal(
     for (unsigned i = 0, size = assertionsToPreprocess->size(); i < size; i++)
     {
       Node prev = (*assertionsToPreprocess)[i];
+      // the simplified form is rewritten
       Node next = si->simplify(prev, model_replace_f, visited);
       if (next != prev)
       {
-        next = theory::Rewriter::rewrite(next);
         assertionsToPreprocess->replace(i, next);
         Trace("sort-infer-preprocess")
             << "*** Preprocess SortInferencePass " << prev << endl;
@@ -62,9 +62,9 @@ PreprocessingPassResult SortInferencePass::applyInternal(
     }
     std::vector<Node> newAsserts;
     si->getNewAssertions(newAsserts);
-    for (const Node& na : newAsserts)
+    theory::Rewriter::rewriteAll(newAsserts);
+    for (const Node& nar : newAsserts)
     {
-      Node nar = theory::Rewriter::rewrite(na);
       Trace("sort-infer-preprocess")
           << "*** Preprocess SortInferencePass : new constraint " << nar
           << endl;
@@ -0,0 +1,316 @@
+/*********************                                                        */
+/*! \file strings_len_check.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The strings length check preprocessing pass
+ **
+ ** Checks the length abstraction of the input with a subsolver.
+ **/
+
+#include "preprocessing/passes/strings_len_check.h"
+
+#include <algorithm>
+
+#include "options/strings_options.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "smt/smt_engine.h"
+#include "theory/rewriter.h"
+#include "theory/smt_engine_subsolver.h"
+#include "theory/strings/regexp_entail.h"
+#include "theory/strings/theory_strings_utils.h"
+#include "theory/strings/word.h"
+
+using namespace cvc5::kind;
+using namespace cvc5::theory;
+using namespace cvc5::theory::strings;
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+StringsLenCheck::StringsLenCheck(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "strings-len-check"),
+      d_hasQuant(false){};
+
+Node StringsLenCheck::mkPurify(Node n, TypeNode tn)
+{
+  Node k = NodeManager::currentNM()->mkSkolem(
+      "lenabs",
+      tn,
+      "is a variable of the length abstraction of the strings length check");
+  Trace("strings-len-check-debug")
+      << "abstract " << n << " by " << k << std::endl;
+  return k;
+}
+
+size_t StringsLenCheck::getMinLength(Node r)
+{
+  switch (r.getKind())
+  {
+    case STRING_TO_REGEXP:
+      return r[0].isConst() ? Word::getLength(r[0]) : 0;
+    case REGEXP_CONCAT:
+    {
+      size_t sum = 0;
+      for (const Node& rc : r)
+      {
+        sum += getMinLength(rc);
+      }
+      return sum;
+    }
+    case REGEXP_UNION:
+    {
+      size_t min = getMinLength(r[0]);
+      for (size_t i = 1, nchild = r.getNumChildren(); i < nchild; ++i)
+      {
+        min = std::min(min, getMinLength(r[i]));
+      }
+      return min;
+    }
+    case REGEXP_INTER:
+    {
+      size_t max = 0;
+      for (const Node& rc : r)
+      {
+        max = std::max(max, getMinLength(rc));
+      }
+      return max;
+    }
+    case REGEXP_PLUS: return getMinLength(r[0]);
+    case REGEXP_LOOP:
+      return utils::getLoopMinOccurrences(r) * getMinLength(r[0]);
+    case REGEXP_SIGMA:
+    case REGEXP_RANGE: return 1;
+    default:
+      // in particular, the empty language is conservatively assumed to
+      // contain the empty word
+      return 0;
+  }
+}
+
+Node StringsLenCheck::abstractLength(Node x)
+{
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+      d_lenAbs.find(x);
+  if (it != d_lenAbs.end())
+  {
+    return it->second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = x.getKind();
+  Node ret;
+  if (x.isConst())
+  {
+    ret = nm->mkConst(Rational(Word::getLength(x)));
+  }
+  else if (k == STRING_CONCAT)
+  {
+    std::vector<Node> lens;
+    for (const Node& xc : x)
+    {
+      lens.push_back(abstractLength(xc));
+    }
+    ret = nm->mkNode(PLUS, lens);
+  }
+  else if (k == SEQ_UNIT)
+  {
+    ret = nm->mkConst(Rational(1));
+  }
+  else if (k == ITE)
+  {
+    ret = nm->mkNode(
+        ITE, abstract(x[0]), abstractLength(x[1]), abstractLength(x[2]));
+  }
+  else
+  {
+    ret = mkPurify(x, nm->integerType());
+    d_axioms.push_back(nm->mkNode(GEQ, ret, nm->mkConst(Rational(0))));
+    if (k == STRING_SUBSTR)
+    {
+      d_axioms.push_back(nm->mkNode(LEQ, ret, abstractLength(x[0])));
+    }
+    else if (k == STRING_UPDATE || k == STRING_TOLOWER || k == STRING_TOUPPER
+             || k == STRING_REV)
+    {
+      d_axioms.push_back(ret.eqNode(abstractLength(x[0])));
+    }
+    else if (k == STRING_ITOS)
+    {
+      d_axioms.push_back(nm->mkNode(GEQ, ret, nm->mkConst(Rational(1))));
+    }
+    else if (k == STRING_FROM_CODE)
+    {
+      d_axioms.push_back(nm->mkNode(LEQ, ret, nm->mkConst(Rational(1))));
+    }
+  }
+  d_lenAbs[x] = ret;
+  return ret;
+}
+
+Node StringsLenCheck::abstract(Node n)
+{
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+      d_abs.find(n);
+  if (it != d_abs.end())
+  {
+    return it->second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = n.getKind();
+  TypeNode tn = n.getType();
+  Assert(tn.isBoolean() || tn.isReal());
+  Node ret;
+  if (k == FORALL || k == EXISTS)
+  {
+    d_hasQuant = true;
+    ret = n;
+  }
+  else if (n.isConst() || n.isVar())
+  {
+    ret = n;
+  }
+  else if (k == STRING_LENGTH)
+  {
+    ret = abstractLength(n[0]);
+  }
+  else if (k == EQUAL && n[0].getType().isStringLike())
+  {
+    ret = mkPurify(n, tn);
+    d_axioms.push_back(nm->mkNode(
+        IMPLIES, ret, abstractLength(n[0]).eqNode(abstractLength(n[1]))));
+  }
+  else if (k == STRING_IN_REGEXP)
+  {
+    ret = mkPurify(n, tn);
+    Node len = abstractLength(n[0]);
+    Node fixed = RegExpEntail::getFixedLengthForRegexp(n[1]);
+    if (!fixed.isNull())
+    {
+      d_axioms.push_back(nm->mkNode(IMPLIES, ret, len.eqNode(fixed)));
+    }
+    else
+    {
+      size_t min = getMinLength(n[1]);
+      if (min > 0)
+      {
+        d_axioms.push_back(nm->mkNode(
+            IMPLIES, ret, nm->mkNode(GEQ, len, nm->mkConst(Rational(min)))));
+      }
+    }
+  }
+  else if (k == STRING_STRCTN || k == STRING_PREFIX || k == STRING_SUFFIX)
+  {
+    // the string that is contained, or the prefix or suffix, is not longer
+    // than the other one
+    ret = mkPurify(n, tn);
+    Node contained = k == STRING_STRCTN ? n[1] : n[0];
+    Node other = k == STRING_STRCTN ? n[0] : n[1];
+    d_axioms.push_back(nm->mkNode(
+        IMPLIES,
+        ret,
+        nm->mkNode(GEQ, abstractLength(other), abstractLength(contained))));
+  }
+  else if (k == STRING_STRIDOF)
+  {
+    // -1 <= str.indexof(s, t, i) <= str.len(s)
+    ret = mkPurify(n, tn);
+    d_axioms.push_back(nm->mkNode(GEQ, ret, nm->mkConst(Rational(-1))));
+    d_axioms.push_back(nm->mkNode(LEQ, ret, abstractLength(n[0])));
+  }
+  else if (k == STRING_STOI)
+  {
+    ret = mkPurify(n, tn);
+    d_axioms.push_back(nm->mkNode(GEQ, ret, nm->mkConst(Rational(-1))));
+  }
+  else
+  {
+    // Boolean connectives and arithmetic operators are kept if their
+    // arguments are Boolean or arithmetic
+    bool keep = n.getMetaKind() != metakind::PARAMETERIZED
+                && (k == NOT || k == AND || k == OR || k == IMPLIES || k == XOR
+                    || k == ITE || k == EQUAL
+                    || kindToTheoryId(k) == THEORY_ARITH);
+    for (const Node& nc : n)
+    {
+      TypeNode tnc = nc.getType();
+      keep = keep && (tnc.isBoolean() || tnc.isReal());
+    }
+    if (keep)
+    {
+      std::vector<Node> children;
+      for (const Node& nc : n)
+      {
+        children.push_back(abstract(nc));
+      }
+      ret = nm->mkNode(k, children);
+    }
+    else
+    {
+      ret = mkPurify(n, tn);
+    }
+  }
+  d_abs[n] = ret;
+  return ret;
+}
+
+PreprocessingPassResult StringsLenCheck::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  d_abs.clear();
+  d_lenAbs.clear();
+  d_axioms.clear();
+  d_hasQuant = false;
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> conj;
+  for (const Node& assertion : assertionsToPreprocess->ref())
+  {
+    conj.push_back(abstract(assertion));
+    if (d_hasQuant)
+    {
+      Trace("strings-len-check") << "...quantified input" << std::endl;
+      return PreprocessingPassResult::NO_CONFLICT;
+    }
+  }
+  if (d_lenAbs.empty())
+  {
+    // no string terms
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  conj.insert(conj.end(), d_axioms.begin(), d_axioms.end());
+  Node query = Rewriter::rewrite(nm->mkAnd(conj));
+  Trace("strings-len-check") << "Length abstraction: " << query << std::endl;
+  bool unsat = false;
+  if (query.isConst())
+  {
+    unsat = !query.getConst<bool>();
+  }
+  else
+  {
+    std::unique_ptr<SmtEngine> lenChecker;
+    initializeSubsolver(lenChecker, true, options::stringLenCheckTimeout());
+    lenChecker->setOption("strings-len-check", "false");
+    lenChecker->assertFormula(query);
+    Result r = lenChecker->checkSat();
+    Trace("strings-len-check") << "...result " << r << std::endl;
+    unsat = r.asSatisfiabilityResult().isSat() == Result::UNSAT;
+  }
+  if (unsat)
+  {
+    Trace("strings-len-check") << "...length conflict" << std::endl;
+    assertionsToPreprocess->clear();
+    assertionsToPreprocess->push_back(nm->mkConst<bool>(false));
+    return PreprocessingPassResult::CONFLICT;
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
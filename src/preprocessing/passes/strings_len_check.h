@@ -0,0 +1,89 @@
+/*********************                                                        */
+/*! \file strings_len_check.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The strings length check preprocessing pass
+ **
+ ** Checks the length abstraction of the input with a subsolver, and replaces
+ ** the input by false if it is unsatisfiable.
+ ** Enabled via option `--strings-len-check`.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__STRINGS_LEN_CHECK_H
+#define CVC4__PREPROCESSING__PASSES__STRINGS_LEN_CHECK_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * The length abstraction of the assertions replaces each string term x by an
+ * integer variable for str.len(x), and is implied by the assertions:
+ * - concatenations and constants have the sum of the lengths of their
+ *   components, and the lengths of the other string terms are non-negative,
+ * - the string literals are abstracted by fresh Boolean variables that imply
+ *   the constraints entailed by the literals on the lengths, e.g.
+ *   (= x y) implies str.len(x) = str.len(y) and (str.in_re x R) implies
+ *   the minimal length of the words of R is at most str.len(x),
+ * - the other terms, which are not arithmetic nor Boolean, are abstracted by
+ *   fresh variables.
+ * The abstraction is checked by a subsolver, which only needs arithmetic. If
+ * it is unsatisfiable, so are the assertions, which are replaced by false.
+ * This finds the length conflicts of the input without search in the strings
+ * solver.
+ *
+ * Quantified assertions are not abstracted, in which case the pass does
+ * nothing.
+ */
+class StringsLenCheck : public PreprocessingPass
+{
+ public:
+  StringsLenCheck(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** Get the abstraction of the Boolean or arithmetic term n */
+  Node abstract(Node n);
+  /** Get the abstraction of str.len(x) for the string term x */
+  Node abstractLength(Node x);
+  /** Make a fresh variable of type tn for the abstraction of n */
+  static Node mkPurify(Node n, TypeNode tn);
+  /**
+   * Get the minimal length of the words of the regular expression r, or 0
+   * if it is not a constant regular expression.
+   */
+  static size_t getMinLength(Node r);
+
+  /** The abstraction of each Boolean or arithmetic term */
+  std::unordered_map<Node, Node, NodeHashFunction> d_abs;
+  /** The abstraction of the length of each string term */
+  std::unordered_map<Node, Node, NodeHashFunction> d_lenAbs;
+  /** The constraints on the variables of the abstraction */
+  std::vector<Node> d_axioms;
+  /** Whether the assertions contain quantifiers */
+  bool d_hasQuant;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC4__PREPROCESSING__PASSES__STRINGS_LEN_CHECK_H */
@@ -31,20 +31,10 @@ PreprocessingPassResult TheoryRewriteEq::applyInternal(
     AssertionPipeline* assertions)
 {
   // apply ppRewrite to all equalities in assertions
-  for (std::size_t i = 0, size = assertions->size(); i < size; ++i)
-  {
-    Node assertion = (*assertions)[i];
-    TrustNode trn = rewriteAssertion(assertion);
-    if (!trn.isNull())
-    {
-      // replace based on the trust node
-      assertions->replaceTrusted(i, trn);
-    }
-  }
-  return PreprocessingPassResult::NO_CONFLICT;
+  return applyToEachAssertion(assertions);
 }
 
-theory::TrustNode TheoryRewriteEq::rewriteAssertion(TNode n)
+theory::TrustNode TheoryRewriteEq::applyToAssertion(TNode n)
 {
   NodeManager* nm = NodeManager::currentNM();
   TheoryEngine* te = d_preprocContext->getTheoryEngine();
@@ -46,7 +46,7 @@ class TheoryRewriteEq : public PreprocessingPass
    *   (= x y) ---> (and (>= x y) (<= x y))
    * Returns the trust node corresponding to the rewrite.
    */
-  theory::TrustNode rewriteAssertion(TNode assertion);
+  theory::TrustNode applyToAssertion(TNode assertion) override;
 };
 
 }  // namespace passes
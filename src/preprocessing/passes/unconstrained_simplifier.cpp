@@ -19,6 +19,8 @@
 #include "preprocessing/passes/unconstrained_simplifier.h"
 
 #include "expr/dtype.h"
+#include "expr/node_algorithm.h"
+#include "options/smt_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "preprocessing/preprocessing_pass_context.h"
 #include "smt/logic_exception.h"
@@ -38,7 +40,11 @@ UnconstrainedSimplifier::UnconstrainedSimplifier(
     : PreprocessingPass(preprocContext, "unconstrained-simplifier"),
       d_numUnconstrainedElim("preprocessor::number of unconstrained elims", 0),
       d_context(preprocContext->getDecisionContext()),
-      d_substitutions(preprocContext->getDecisionContext())
+      d_substitutions(preprocContext->getDecisionContext()),
+      d_constrained(preprocContext->getUserContext()),
+      d_definitions(preprocContext->getUserContext()),
+      d_eliminated(preprocContext->getUserContext()),
+      d_definitionsAdded(preprocContext->getUserContext())
 {
   smtStatisticsRegistry()->registerStat(&d_numUnconstrainedElim);
 }
@@ -840,18 +846,99 @@ void UnconstrainedSimplifier::processUnconstrained()
   }
 }
 
+void UnconstrainedSimplifier::addDefinitions(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  std::vector<Node> defs;
+  for (const std::pair<const TNode, unsigned>& v : d_visited)
+  {
+    NodeRangeMap::const_iterator it = d_eliminated.find(v.first);
+    if (it == d_eliminated.end())
+    {
+      continue;
+    }
+    for (size_t i = (*it).second.first, end = (*it).second.second; i < end;
+         ++i)
+    {
+      Node def = d_definitions[i];
+      if (d_definitionsAdded.find(def) == d_definitionsAdded.end())
+      {
+        d_definitionsAdded.insert(def);
+        defs.push_back(def);
+      }
+    }
+  }
+  for (const Node& def : defs)
+  {
+    Trace("unc-simp") << "UnconstrainedSimplifier::addDefinitions: " << def
+                      << std::endl;
+    assertionsToPreprocess->push_back(def);
+    visitAll(def);
+  }
+  // the variables of previous assertions are constrained by them
+  for (TNodeSet::iterator it = d_unconstrained.begin();
+       it != d_unconstrained.end();)
+  {
+    if (d_constrained.find(*it) != d_constrained.end())
+    {
+      it = d_unconstrained.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void UnconstrainedSimplifier::recordApplication(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  std::unordered_set<Node, NodeHashFunction> syms;
+  for (const Node& a : assertionsToPreprocess->ref())
+  {
+    expr::getSymbols(a, syms);
+  }
+  size_t start = d_definitions.size();
+  for (const std::pair<const Node, const Node>& s : d_substitutions)
+  {
+    Node def = Rewriter::rewrite(s.first.eqNode(s.second));
+    d_definitions.push_back(def);
+    expr::getSymbols(def, syms);
+  }
+  size_t end = d_definitions.size();
+  if (end > start)
+  {
+    for (TNode v : d_unconstrained)
+    {
+      if (v.getKind() == kind::VARIABLE || v.getKind() == kind::SKOLEM)
+      {
+        d_eliminated[v] = std::pair<size_t, size_t>(start, end);
+      }
+    }
+  }
+  for (const Node& v : syms)
+  {
+    d_constrained.insert(v);
+  }
+}
+
 PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
     AssertionPipeline* assertionsToPreprocess)
 {
   d_preprocContext->spendResource(ResourceManager::Resource::PreprocessStep);
 
   const std::vector<Node>& assertions = assertionsToPreprocess->ref();
+  bool incremental = options::incrementalSolving();
 
   d_context->push();
 
-  for (const Node& assertion : assertions)
+  for (size_t i = 0, asize = assertions.size(); i < asize; ++i)
+  {
+    visitAll(assertions[i]);
+  }
+  if (incremental)
   {
-    visitAll(assertion);
+    addDefinitions(assertionsToPreprocess);
   }
 
   if (!d_unconstrained.empty())
@@ -866,6 +953,10 @@ PreprocessingPassResult UnconstrainedSimplifier::applyInternal(
       assertionsToPreprocess->replace(i, as);
     }
   }
+  if (incremental)
+  {
+    recordApplication(assertionsToPreprocess);
+  }
 
   // to clear substitutions map
   d_context->pop();
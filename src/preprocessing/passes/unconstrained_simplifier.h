@@ -24,6 +24,9 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
+#include "context/cdlist.h"
 #include "expr/node.h"
 #include "preprocessing/preprocessing_pass.h"
 #include "theory/substitutions.h"
@@ -60,6 +63,33 @@ class UnconstrainedSimplifier : public PreprocessingPass
   context::Context* d_context;
   theory::SubstitutionMap d_substitutions;
 
+  using NodeSet = context::CDHashSet<Node, NodeHashFunction>;
+  using NodeRangeMap = context::
+      CDHashMap<Node, std::pair<size_t, size_t>, NodeHashFunction>;
+
+  /*
+   * The following are used in incremental mode, where each application only
+   * sees the assertions of the current check-sat call. They depend on the
+   * user context. Replacing a term t containing an unconstrained variable x
+   * by a fresh variable v remains sound if x occurs in a later assertion,
+   * provided that the definition t = v is asserted as well. This includes
+   * the assumptions of check-sat-assuming, which are asserted in their own
+   * user context; hence the assumptions must not be passed to the SAT solver
+   * directly, which is why --assumption-solving is disabled with this pass
+   * (see setDefaults).
+   */
+  /** The variables occurring in the assertions of previous applications */
+  NodeSet d_constrained;
+  /** The definitions t = v of the previous applications */
+  context::CDList<Node> d_definitions;
+  /**
+   * Maps each variable that was unconstrained in a previous application to
+   * the range of d_definitions introduced by that application.
+   */
+  NodeRangeMap d_eliminated;
+  /** The definitions that have been added as assertions */
+  NodeSet d_definitionsAdded;
+
   /**
    * Visit all subterms in assertion. This method throws a LogicException if
    * there is a subterm that is unhandled by this preprocessing pass (e.g. a
@@ -68,6 +98,16 @@ class UnconstrainedSimplifier : public PreprocessingPass
   void visitAll(TNode assertion);
   Node newUnconstrainedVar(TypeNode t, TNode var);
   void processUnconstrained();
+  /**
+   * Add the definitions of the previous applications for the variables of
+   * the visited assertions that were eliminated, and visit them.
+   */
+  void addDefinitions(AssertionPipeline* assertionsToPreprocess);
+  /**
+   * Record the variables of the simplified assertions as constrained, and the
+   * substitutions of this application as definitions.
+   */
+  void recordApplication(AssertionPipeline* assertionsToPreprocess);
 };
 
 }  // namespace passes
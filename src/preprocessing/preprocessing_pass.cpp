@@ -33,12 +33,48 @@ PreprocessingPassResult PreprocessingPass::apply(
   Trace("preprocessing") << "PRE " << d_name << std::endl;
   Chat() << d_name << "..." << std::endl;
   dumpAssertions(("pre-" + d_name).c_str(), *assertionsToPreprocess);
+  PreprocessingProfiler* profiler = d_preprocContext->getProfiler();
+  std::unique_ptr<PreprocessingProfiler::Scope> profile;
+  if (profiler != nullptr)
+  {
+    profile.reset(new PreprocessingProfiler::Scope(
+        *profiler, d_name, *assertionsToPreprocess));
+  }
   PreprocessingPassResult result = applyInternal(assertionsToPreprocess);
+  if (profile != nullptr)
+  {
+    profile->finish(*assertionsToPreprocess, result == CONFLICT);
+  }
   dumpAssertions(("post-" + d_name).c_str(), *assertionsToPreprocess);
   Trace("preprocessing") << "POST " << d_name << std::endl;
   return result;
 }
 
+PreprocessingPassResult PreprocessingPass::applyToEachAssertion(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  std::unordered_map<Node, theory::TrustNode, NodeHashFunction> results;
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    Node assertion = (*assertionsToPreprocess)[i];
+    std::unordered_map<Node, theory::TrustNode, NodeHashFunction>::iterator
+        it = results.find(assertion);
+    if (it == results.end())
+    {
+      theory::TrustNode trn = applyToAssertion(assertion);
+      it = results.emplace(assertion, trn).first;
+    }
+    assertionsToPreprocess->replaceTrusted(i, it->second);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+theory::TrustNode PreprocessingPass::applyToAssertion(TNode assertion)
+{
+  Unreachable() << "Preprocessing pass " << d_name
+                << " does not transform single assertions";
+}
+
 void PreprocessingPass::dumpAssertions(const char* key,
                                        const AssertionPipeline& assertionList) {
   if (Dump.isOn("assertions") && Dump.isOn(std::string("assertions:") + key))
@@ -33,6 +33,7 @@
 
 #include <string>
 
+#include "theory/trust_node.h"
 #include "util/statistics_registry.h"
 #include "util/stats_timer.h"
 
@@ -70,6 +71,25 @@ class PreprocessingPass {
   virtual PreprocessingPassResult applyInternal(
       AssertionPipeline* assertionsToPreprocess) = 0;
 
+  /*
+   * Helper for passes that transform each assertion independently of the
+   * other assertions, which can implement applyInternal() by calling this
+   * method. It replaces each assertion by the result of applyToAssertion(),
+   * which is called only once for identical assertions. The assertions are
+   * processed sequentially: node construction and the rewrite caches are
+   * not thread-safe, so no parallelism is provided.
+   */
+  PreprocessingPassResult applyToEachAssertion(
+      AssertionPipeline* assertionsToPreprocess);
+
+  /*
+   * Transform a single assertion, for passes using applyToEachAssertion().
+   * Returns the trust node of kind TrustNodeKind::REWRITE for the rewrite
+   * of the assertion, or the null trust node if it does not change. This
+   * method must not depend on the other assertions.
+   */
+  virtual theory::TrustNode applyToAssertion(TNode assertion);
+
   /* Context for Preprocessing Passes that initializes necessary variables */
   PreprocessingPassContext* d_preprocContext;
 
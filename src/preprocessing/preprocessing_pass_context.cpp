@@ -17,6 +17,7 @@
 #include "preprocessing/preprocessing_pass_context.h"
 
 #include "expr/node_algorithm.h"
+#include "options/smt_options.h"
 
 namespace cvc5 {
 namespace preprocessing {
@@ -32,6 +33,13 @@ PreprocessingPassContext::PreprocessingPassContext(
       d_pnm(pnm),
       d_symsInAssertions(smt->getUserContext())
 {
+  // internal subsolvers inherit the options, but must not overwrite the
+  // report of the user's solver
+  if (!options::ppProfile().empty() && !smt->isInternalSubsolver())
+  {
+    d_profiler.reset(new PreprocessingProfiler(
+        options::ppProfile(), smt->getNodeManager(), smt->getRewriter()));
+  }
 }
 
 theory::TrustSubstitutionMap&
@@ -30,6 +30,7 @@
 #include "preprocessing/passes/bv_eager_atoms.h"
 #include "preprocessing/passes/bv_gauss.h"
 #include "preprocessing/passes/bv_intro_pow2.h"
+#include "preprocessing/passes/bv_slice.h"
 #include "preprocessing/passes/bv_to_bool.h"
 #include "preprocessing/passes/bv_to_int.h"
 #include "preprocessing/passes/extended_rewriter_pass.h"
@@ -43,6 +44,7 @@
 #include "preprocessing/passes/miplib_trick.h"
 #include "preprocessing/passes/nl_ext_purify.h"
 #include "preprocessing/passes/non_clausal_simp.h"
+#include "preprocessing/passes/pseudo_boolean_native.h"
 #include "preprocessing/passes/pseudo_boolean_processor.h"
 #include "preprocessing/passes/quantifier_macros.h"
 #include "preprocessing/passes/quantifiers_preprocess.h"
@@ -52,6 +54,7 @@
 #include "preprocessing/passes/sort_infer.h"
 #include "preprocessing/passes/static_learning.h"
 #include "preprocessing/passes/strings_eager_pp.h"
+#include "preprocessing/passes/strings_len_check.h"
 #include "preprocessing/passes/sygus_inference.h"
 #include "preprocessing/passes/synth_rew_rules.h"
 #include "preprocessing/passes/theory_preprocess.h"
@@ -132,6 +135,7 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("sygus-infer", callCtor<SygusInference>);
   registerPassInfo("bv-to-bool", callCtor<BVToBool>);
   registerPassInfo("bv-intro-pow2", callCtor<BvIntroPow2>);
+  registerPassInfo("bv-slice", callCtor<BvSlice>);
   registerPassInfo("sort-inference", callCtor<SortInferencePass>);
   registerPassInfo("sep-skolem-emp", callCtor<SepSkolemEmp>);
   registerPassInfo("rewrite", callCtor<Rewrite>);
@@ -139,6 +143,7 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("bv-eager-atoms", callCtor<BvEagerAtoms>);
   registerPassInfo("pseudo-boolean-processor",
                    callCtor<PseudoBooleanProcessor>);
+  registerPassInfo("pseudo-boolean-native", callCtor<PseudoBooleanNative>);
   registerPassInfo("unconstrained-simplifier",
                    callCtor<UnconstrainedSimplifier>);
   registerPassInfo("quantifiers-preprocess", callCtor<QuantifiersPreprocess>);
@@ -155,6 +160,7 @@ PreprocessingPassRegistry::PreprocessingPassRegistry()
   registerPassInfo("fun-def-fmf", callCtor<FunDefFmf>);
   registerPassInfo("theory-rewrite-eq", callCtor<TheoryRewriteEq>);
   registerPassInfo("strings-eager-pp", callCtor<StringsEagerPp>);
+  registerPassInfo("strings-len-check", callCtor<StringsLenCheck>);
 }
 
 }  // namespace preprocessing
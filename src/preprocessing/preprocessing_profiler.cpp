@@ -0,0 +1,133 @@
+/*********************                                                        */
+/*! \file preprocessing_profiler.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A profiler for the invocations of preprocessing passes.
+ **/
+
+#include "preprocessing/preprocessing_profiler.h"
+
+#include <fstream>
+#include <unordered_set>
+
+#include "base/output.h"
+#include "expr/node_manager.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "theory/rewriter.h"
+
+namespace cvc5 {
+namespace preprocessing {
+
+PreprocessingProfiler::Scope::Scope(PreprocessingProfiler& profiler,
+                                    const std::string& pass,
+                                    const AssertionPipeline& assertions)
+    : d_profiler(profiler), d_index(profiler.d_records.size())
+{
+  NodeManager* nm = profiler.d_nm;
+  Record r;
+  r.d_pass = pass;
+  r.d_millis = 0;
+  r.d_assertionsBefore = assertions.size();
+  r.d_assertionsAfter = 0;
+  r.d_dagSizeBefore = dagSize(assertions);
+  r.d_dagSizeAfter = 0;
+  r.d_poolSizeBefore = nm->poolSize();
+  r.d_poolPeakGrowth = 0;
+  r.d_cacheHits = 0;
+  r.d_conflict = false;
+  profiler.d_records.push_back(r);
+  nm->resetPoolPeakSize();
+  d_cacheHitsBefore = profiler.d_rewriter->getNumCacheHits();
+  // start the clock last, so that the measurements above are not included
+  d_start = std::chrono::steady_clock::now();
+}
+
+void PreprocessingProfiler::Scope::finish(const AssertionPipeline& assertions,
+                                          bool conflict)
+{
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - d_start;
+  NodeManager* nm = d_profiler.d_nm;
+  // look up the record only now, nested invocations may have added records
+  Record& r = d_profiler.d_records[d_index];
+  r.d_millis = elapsed.count();
+  r.d_assertionsAfter = assertions.size();
+  r.d_dagSizeAfter = dagSize(assertions);
+  size_t peak = nm->poolPeakSize();
+  r.d_poolPeakGrowth =
+      peak > r.d_poolSizeBefore ? peak - r.d_poolSizeBefore : 0;
+  r.d_cacheHits =
+      d_profiler.d_rewriter->getNumCacheHits() - d_cacheHitsBefore;
+  r.d_conflict = conflict;
+}
+
+PreprocessingProfiler::PreprocessingProfiler(const std::string& filename,
+                                             NodeManager* nm,
+                                             theory::Rewriter* rr)
+    : d_filename(filename), d_nm(nm), d_rewriter(rr)
+{
+  d_nm->setTrackPoolPeakSize(true);
+  d_rewriter->setCountCacheHits(true);
+}
+
+PreprocessingProfiler::~PreprocessingProfiler()
+{
+  d_rewriter->setCountCacheHits(false);
+  // the tracking of the pool is left enabled, other solvers using the same
+  // node manager may be profiling
+  std::ofstream out(d_filename);
+  if (!out)
+  {
+    Warning() << "cannot write preprocessing profile to " << d_filename
+              << std::endl;
+    return;
+  }
+  toStreamJson(out);
+}
+
+void PreprocessingProfiler::toStreamJson(std::ostream& out) const
+{
+  out << "{\"passes\": [";
+  for (size_t i = 0, size = d_records.size(); i < size; ++i)
+  {
+    const Record& r = d_records[i];
+    // pass names are identifiers, so they need no escaping
+    out << (i == 0 ? "\n" : ",\n") << "  {\"pass\": \"" << r.d_pass << "\""
+        << ", \"millis\": " << r.d_millis
+        << ", \"assertions_before\": " << r.d_assertionsBefore
+        << ", \"assertions_after\": " << r.d_assertionsAfter
+        << ", \"dag_size_before\": " << r.d_dagSizeBefore
+        << ", \"dag_size_after\": " << r.d_dagSizeAfter
+        << ", \"pool_size_before\": " << r.d_poolSizeBefore
+        << ", \"pool_peak_growth\": " << r.d_poolPeakGrowth
+        << ", \"rewrite_cache_hits\": " << r.d_cacheHits
+        << ", \"conflict\": " << (r.d_conflict ? "true" : "false") << "}";
+  }
+  out << "\n]}" << std::endl;
+}
+
+size_t PreprocessingProfiler::dagSize(const AssertionPipeline& assertions)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (visited.insert(cur).second)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  }
+  return visited.size();
+}
+
+}  // namespace preprocessing
+}  // namespace cvc5
@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file preprocessing_profiler.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A profiler for the invocations of preprocessing passes.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PREPROCESSING_PROFILER_H
+#define CVC4__PREPROCESSING__PREPROCESSING_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cvc5 {
+
+class NodeManager;
+
+namespace theory {
+class Rewriter;
+}
+
+namespace preprocessing {
+
+class AssertionPipeline;
+
+/**
+ * Records a profile of each invocation of a preprocessing pass, and writes
+ * all of them as a JSON report to a file when destroyed. The report is an
+ * object with a single field "passes", whose value is an array of objects
+ * with the following fields, in the order of invocation:
+ *
+ * - "pass": the name of the pass,
+ * - "millis": the wall time of the invocation in milliseconds,
+ * - "assertions_before", "assertions_after": the number of assertions,
+ * - "dag_size_before", "dag_size_after": the number of distinct nodes of
+ *   the assertions,
+ * - "pool_size_before": the size of the node pool at the start,
+ * - "pool_peak_growth": the maximal growth of the node pool during the
+ *   invocation,
+ * - "rewrite_cache_hits": the number of hits in the rewrite caches during
+ *   the invocation,
+ * - "conflict": whether the pass found a conflict.
+ *
+ * The DAG sizes are computed outside of the timed part of an invocation,
+ * but they do add to the total preprocessing time. If passes are nested,
+ * the peak of the outer invocation only covers the part after the last
+ * nested invocation started.
+ *
+ * Tracking the peak size of the node pool and counting the hits in the
+ * rewrite caches is only enabled when a profiler is created. A profiler is
+ * only created by the SmtEngine of the user, as the report of an internal
+ * subsolver would overwrite it.
+ */
+class PreprocessingProfiler
+{
+ public:
+  /** The profile of an invocation in progress */
+  class Scope
+  {
+    friend class PreprocessingProfiler;
+
+   public:
+    Scope(PreprocessingProfiler& profiler,
+          const std::string& pass,
+          const AssertionPipeline& assertions);
+    /** Finish the invocation, and record its profile */
+    void finish(const AssertionPipeline& assertions, bool conflict);
+
+   private:
+    PreprocessingProfiler& d_profiler;
+    size_t d_index;
+    std::chrono::steady_clock::time_point d_start;
+    uint64_t d_cacheHitsBefore;
+  };
+
+  /**
+   * Create a profiler that writes its report to the given file, which
+   * enables the tracking of the peak pool size of nm and of the cache hits
+   * of rr.
+   */
+  PreprocessingProfiler(const std::string& filename,
+                        NodeManager* nm,
+                        theory::Rewriter* rr);
+  ~PreprocessingProfiler();
+
+  /** Write the report in JSON to out */
+  void toStreamJson(std::ostream& out) const;
+
+  /** The number of distinct nodes of the given assertions */
+  static size_t dagSize(const AssertionPipeline& assertions);
+
+ private:
+  /** The profile of an invocation */
+  struct Record
+  {
+    std::string d_pass;
+    double d_millis;
+    size_t d_assertionsBefore;
+    size_t d_assertionsAfter;
+    size_t d_dagSizeBefore;
+    size_t d_dagSizeAfter;
+    size_t d_poolSizeBefore;
+    size_t d_poolPeakGrowth;
+    uint64_t d_cacheHits;
+    bool d_conflict;
+  };
+  /** The file to write the report to */
+  std::string d_filename;
+  /** The node manager whose pool is tracked */
+  NodeManager* d_nm;
+  /** The rewriter whose cache hits are counted */
+  theory::Rewriter* d_rewriter;
+  /** The records, in the order of invocation */
+  std::vector<Record> d_records;
+};
+
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC4__PREPROCESSING__PREPROCESSING_PROFILER_H */
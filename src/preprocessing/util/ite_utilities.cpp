@@ -166,6 +166,25 @@ void ITEUtilities::clear()
   d_containsVisitor->garbageCollect();
 }
 
+size_t ITEUtilities::cacheSize() const
+{
+  size_t size = d_containsVisitor->cache_size();
+  if (d_simplifier != NULL)
+  {
+    size += d_simplifier->cacheSize();
+  }
+  return size;
+}
+
+void ITEUtilities::clearSimpITECaches()
+{
+  if (d_simplifier != NULL)
+  {
+    d_simplifier->clearCaches();
+  }
+  d_containsVisitor->garbageCollect();
+}
+
 /*********************                                                        */
 /* ContainsTermITEVisitor
  */
@@ -679,12 +698,27 @@ bool ITESimplifier::leavesAreConst(TNode e)
 void ITESimplifier::clearSimpITECaches()
 {
   Chat() << "clear ite caches " << endl;
+  clearCaches();
+  d_citeEqConstApplications = 0;
+  d_simpVars.clear();
+}
+
+size_t ITESimplifier::cacheSize() const
+{
+  return d_constantLeaves.size() + d_termITEHeight.cache_size()
+         + d_constantIteEqualsConstantCache.size() + d_replaceOverCache.size()
+         + d_replaceOverTermIteCache.size() + d_leavesConstCache.size()
+         + d_simpConstCache.size() + d_simpContextCache.size()
+         + d_simpITECache.size();
+}
+
+void ITESimplifier::clearCaches()
+{
   for (size_t i = 0, N = d_allocatedConstantLeaves.size(); i < N; ++i)
   {
     NodeVec* curr = d_allocatedConstantLeaves[i];
     delete curr;
   }
-  d_citeEqConstApplications = 0;
   d_constantLeaves.clear();
   d_allocatedConstantLeaves.clear();
   d_termITEHeight.clear();
@@ -692,7 +726,6 @@ void ITESimplifier::clearSimpITECaches()
   d_replaceOverCache.clear();
   d_replaceOverTermIteCache.clear();
   d_simpITECache.clear();
-  d_simpVars.clear();
   d_simpConstCache.clear();
   d_leavesConstCache.clear();
   d_simpContextCache.clear();
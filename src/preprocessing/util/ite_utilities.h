@@ -82,6 +82,15 @@ class ITEUtilities
 
   void clear();
 
+  /** returns the number of entries of the caches of simpITE(). */
+  size_t cacheSize() const;
+
+  /**
+   * Clears the caches of simpITE(), but not its heuristic counters, so that
+   * simpIteDidALotOfWorkHeuristic() still refers to all calls.
+   */
+  void clearSimpITECaches();
+
   ContainsTermITEVisitor* getContainsVisitor()
   {
     return d_containsVisitor.get();
@@ -214,6 +223,14 @@ class ITESimplifier
   bool doneALotOfWorkHeuristic() const;
   void clearSimpITECaches();
 
+  /** returns the number of entries of the caches. */
+  size_t cacheSize() const;
+  /**
+   * Clears the caches, but keeps the heuristic counters and the variables
+   * introduced for simplification.
+   */
+  void clearCaches();
+
  private:
   Node d_true;
   Node d_false;
@@ -149,10 +149,75 @@ void Smt2Printer::toStream(std::ostream& out,
                            int toDepth,
                            LetBinding* lbind) const
 {
+  // The children of applications are printed using an explicit stack, so
+  // that printing deep terms does not overflow the call stack. Each frame is
+  // an application whose operator is printed, and whose children are printed
+  // one at a time.
+  std::vector<PrintFrame> visit;
+  PrintFrame f{n, toDepth, 0, 0, false};
+  if (!toStreamOperator(out, n, toDepth, lbind, f.d_forceBinary))
+  {
+    return;
+  }
+  visit.push_back(f);
+  while (!visit.empty())
+  {
+    PrintFrame& cur = visit.back();
+    size_t nchildren = cur.d_node.getNumChildren();
+    if (cur.d_index == nchildren)
+    {
+      if (nchildren != 0)
+      {
+        // close the binary applications of forceBinary and the application
+        out << std::string(cur.d_nparens, ')') << ')';
+      }
+      visit.pop_back();
+      continue;
+    }
+    size_t i = cur.d_index++;
+    if (i > 0)
+    {
+      if (cur.d_forceBinary && i < nchildren - 1)
+      {
+        // not going to work properly for parameterized kinds!
+        Assert(cur.d_node.getMetaKind() != kind::metakind::PARAMETERIZED);
+        out << " (" << smtKindString(cur.d_node.getKind(), d_variant) << ' ';
+        ++cur.d_nparens;
+      }
+      else
+      {
+        out << ' ';
+      }
+    }
+    if (cur.d_toDepth == 0)
+    {
+      out << "(...)";
+      continue;
+    }
+    TNode c = cur.d_node[i];
+    int cdepth = cur.d_toDepth < 0
+                     ? cur.d_toDepth
+                     : cur.d_toDepth - static_cast<int>(cur.d_nparens + 1);
+    PrintFrame cf{c, cdepth, 0, 0, false};
+    // this may add to visit, after which cur is no longer valid
+    if (toStreamOperator(out, c, cdepth, lbind, cf.d_forceBinary))
+    {
+      visit.push_back(cf);
+    }
+  }
+}
+
+bool Smt2Printer::toStreamOperator(std::ostream& out,
+                                   TNode n,
+                                   int toDepth,
+                                   LetBinding* lbind,
+                                   bool& forceBinary) const
+{
+  forceBinary = false;
   // null
   if(n.getKind() == kind::NULL_EXPR) {
     out << "null";
-    return;
+    return false;
   }
 
   NodeManager* nm = NodeManager::currentNM();
@@ -428,7 +493,7 @@ void Smt2Printer::toStream(std::ostream& out,
       kind::metakind::NodeValueConstPrinter::toStream(out, n);
     }
 
-    return;
+    return false;
   }
 
   if(n.getKind() == kind::SORT_TYPE) {
@@ -446,7 +511,7 @@ void Smt2Printer::toStream(std::ostream& out,
       }
       out << ')';
     }
-    return;
+    return false;
   }
 
   // determine if we are printing out a type ascription, store the argument of
@@ -500,7 +565,7 @@ void Smt2Printer::toStream(std::ostream& out,
       toStream(out, type_asc_arg, toDepth < 0 ? toDepth : toDepth - 1, lbind);
       out << " " << force_nt << ")";
     }
-    return;
+    return false;
   }
 
   // variable
@@ -523,11 +588,10 @@ void Smt2Printer::toStream(std::ostream& out,
       }
       out << n.getId();
     }
-    return;
+    return false;
   }
 
   bool stillNeedToPrintParams = true;
-  bool forceBinary = false; // force N-ary to binary when outputing children
   // operator
   if (n.getNumChildren() != 0 && k != kind::INST_PATTERN_LIST
       && k != kind::CONSTRUCTOR_TYPE)
@@ -548,7 +612,7 @@ void Smt2Printer::toStream(std::ostream& out,
       toStream(out, nc, toDepth);
     }
     out << ")";
-    return;
+    return false;
   case kind::SEXPR: break;
 
     // bool theory
@@ -590,7 +654,7 @@ void Smt2Printer::toStream(std::ostream& out,
       }
       out << ")";
     }
-    return;
+    return false;
 
   case kind::MATCH:
     out << smtKindString(k, d_variant) << " ";
@@ -605,14 +669,14 @@ void Smt2Printer::toStream(std::ostream& out,
       toStream(out, n[i], toDepth, lbind);
     }
     out << "))";
-    return;
+    return false;
   case kind::MATCH_BIND_CASE:
     // ignore the binder
     toStream(out, n[1], toDepth, lbind);
     out << " ";
     toStream(out, n[2], toDepth, lbind);
     out << ")";
-    return;
+    return false;
   case kind::MATCH_CASE:
     // do nothing
     break;
@@ -800,7 +864,7 @@ void Smt2Printer::toStream(std::ostream& out,
     toStreamCastToType(
         out, n[0], toDepth < 0 ? toDepth : toDepth - 1, elemType);
     out << ")";
-    return;
+    return false;
   }
   break;
   case kind::MEMBER:
@@ -834,7 +898,7 @@ void Smt2Printer::toStream(std::ostream& out,
     toStreamCastToType(
         out, n[0], toDepth < 0 ? toDepth : toDepth - 1, elemType);
     out << " " << n[1] << ")";
-    return;
+    return false;
   }
 
     // fp theory
@@ -909,12 +973,12 @@ void Smt2Printer::toStream(std::ostream& out,
       // e.g. ((_ tuple_project 2 4 4) tuple)
       out << "(_ tuple_project" << op << ") " << n[0] << ")";
     }
-    return;
+    return false;
   }
   case kind::CONSTRUCTOR_TYPE:
   {
     out << n[n.getNumChildren()-1];
-    return;
+    return false;
     break;
   }
   case kind::APPLY_TESTER:
@@ -969,7 +1033,7 @@ void Smt2Printer::toStream(std::ostream& out,
     size_t dag = lbind == nullptr ? 0 : lbind->getThreshold()-1;
     toStream(out, n[1], toDepth - 1, dag);
     out << annot.str() << ")";
-    return;
+    return false;
     break;
   }
   case kind::BOUND_VAR_LIST:
@@ -988,7 +1052,7 @@ void Smt2Printer::toStream(std::ostream& out,
       }
     }
     out << ')';
-    return;
+    return false;
   }
   case kind::INST_PATTERN:
   case kind::INST_NO_PATTERN:
@@ -1022,30 +1086,7 @@ void Smt2Printer::toStream(std::ostream& out,
       out << ' ';
     }
   }
-  stringstream parens;
-  
-  for(size_t i = 0, c = 1; i < n.getNumChildren(); ) {
-    if(toDepth != 0) {
-      toStream(out, n[i], toDepth < 0 ? toDepth : toDepth - c, lbind);
-    } else {
-      out << "(...)";
-    }
-    if(++i < n.getNumChildren()) {
-      if(forceBinary && i < n.getNumChildren() - 1) {
-        // not going to work properly for parameterized kinds!
-        Assert(n.getMetaKind() != kind::metakind::PARAMETERIZED);
-        out << " (" << smtKindString(n.getKind(), d_variant) << ' ';
-        parens << ')';
-        ++c;
-      } else {
-        out << ' ';
-      }
-    }
-  }
-  if (n.getNumChildren() != 0)
-  {
-    out << parens.str() << ')';
-  }
+  return true;
 }
 
 void Smt2Printer::toStreamCastToType(std::ostream& out,
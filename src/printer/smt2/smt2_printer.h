@@ -229,6 +229,20 @@ class Smt2Printer : public cvc5::Printer
   static std::string smtKindString(Kind k, Variant v = smt2_6_variant);
 
  private:
+  /** An application whose children are being printed, see toStream */
+  struct PrintFrame
+  {
+    /** The application */
+    TNode d_node;
+    /** The depth to print it to */
+    int d_toDepth;
+    /** The index of its next child to print */
+    size_t d_index;
+    /** The number of binary applications opened when forcing binary */
+    size_t d_nparens;
+    /** Whether its N-ary application is printed as binary applications */
+    bool d_forceBinary;
+  };
   /**
    * The main printing method for nodes n.
    */
@@ -236,6 +250,19 @@ class Smt2Printer : public cvc5::Printer
                 TNode n,
                 int toDepth,
                 LetBinding* lbind = nullptr) const;
+  /**
+   * Print n, except for the children of an application. Returns true if n is
+   * an application whose children remain to be printed by the caller,
+   * followed by the closing parenthesis; in this case, the opening
+   * parenthesis, the operator and the space before the first child are
+   * printed, and forceBinary is set to whether the children are printed as
+   * nested binary applications. Returns false if n is printed entirely.
+   */
+  bool toStreamOperator(std::ostream& out,
+                        TNode n,
+                        int toDepth,
+                        LetBinding* lbind,
+                        bool& forceBinary) const;
   /**
    * To stream, with a forced type. This method is used in some corner cases
    * to force a node n to be printed as if it had type tn. This is used e.g.
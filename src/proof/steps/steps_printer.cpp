@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file steps_printer.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the module for printing proofs as lists of steps
+ **/
+
+#include "proof/steps/steps_printer.h"
+
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace cvc5 {
+namespace proof {
+
+void StepsPrinter::print(std::ostream& out, const ProofNode* pn)
+{
+  // Maps proof nodes to their name, e.g. "t3", or to the empty string while
+  // their children are being printed.
+  std::unordered_map<const ProofNode*, std::string> names;
+  std::unordered_map<const ProofNode*, std::string>::iterator it;
+  std::vector<const ProofNode*> visit;
+  const ProofNode* cur;
+  uint64_t stepId = 0;
+  out << "(proof" << std::endl;
+  visit.push_back(pn);
+  do
+  {
+    cur = visit.back();
+    it = names.find(cur);
+    if (it == names.end())
+    {
+      names[cur] = "";
+      const std::vector<std::shared_ptr<ProofNode>>& cs = cur->getChildren();
+      for (const std::shared_ptr<ProofNode>& cp : cs)
+      {
+        if (names.find(cp.get()) == names.end())
+        {
+          visit.push_back(cp.get());
+        }
+      }
+      continue;
+    }
+    visit.pop_back();
+    if (!it->second.empty())
+    {
+      continue;
+    }
+    PfRule r = cur->getRule();
+    std::stringstream ss;
+    ss << (r == PfRule::ASSUME ? "a" : "t") << stepId++;
+    it->second = ss.str();
+    if (r == PfRule::ASSUME)
+    {
+      out << "(assume " << it->second << " " << cur->getResult() << ")"
+          << std::endl;
+      continue;
+    }
+    out << "(step " << it->second << " " << cur->getResult() << " :rule " << r;
+    const std::vector<std::shared_ptr<ProofNode>>& cs = cur->getChildren();
+    if (!cs.empty())
+    {
+      out << " :premises (";
+      for (size_t i = 0, size = cs.size(); i < size; i++)
+      {
+        Assert(!names[cs[i].get()].empty());
+        out << (i == 0 ? "" : " ") << names[cs[i].get()];
+      }
+      out << ")";
+    }
+    const std::vector<Node>& args = cur->getArguments();
+    if (!args.empty())
+    {
+      out << " :args (";
+      for (size_t i = 0, size = args.size(); i < size; i++)
+      {
+        out << (i == 0 ? "" : " ") << args[i];
+      }
+      out << ")";
+    }
+    out << ")" << std::endl;
+  } while (!visit.empty());
+  out << ")" << std::endl;
+}
+
+}  // namespace proof
+}  // namespace cvc5
@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file steps_printer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The module for printing proofs as lists of steps
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROOF__STEPS__STEPS_PRINTER_H
+#define CVC4__PROOF__STEPS__STEPS_PRINTER_H
+
+#include <iostream>
+
+#include "expr/proof_node.h"
+
+namespace cvc5 {
+namespace proof {
+
+/**
+ * Prints a proof as a list of steps in topological order, where each step
+ * refers to its premises by the name of the step proving them. Unlike the
+ * default printer, which first converts the whole proof to an s-expression,
+ * each step is written to the output as soon as its premises are, and the
+ * only memory used for printing is the map from proof nodes to their names.
+ * The format is:
+ *
+ *   (proof
+ *   (assume a0 F0)
+ *   (step t1 F1 :rule RULE :premises (a0 ...) :args (...))
+ *   ...
+ *   )
+ *
+ * where the last step is the conclusion of the proof.
+ */
+class StepsPrinter
+{
+ public:
+  /**
+   * Print the proof pn in the format above.
+   * @param out the output stream
+   * @param pn the root node of the proof to print
+   */
+  static void print(std::ostream& out, const ProofNode* pn);
+};
+
+}  // namespace proof
+}  // namespace cvc5
+
+#endif /* CVC4__PROOF__STEPS__STEPS_PRINTER_H */
@@ -11,14 +11,20 @@
  **
  ** \brief Wrapper for CaDiCaL SAT Solver.
  **
- ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors).
+ ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors), and of
+ ** a CDCL(T) SAT solver for the main search based on CaDiCaL's external
+ ** propagator interface.
  **/
 
 #include "prop/cadical.h"
 
 #ifdef CVC4_USE_CADICAL
 
+#include <deque>
+
 #include "base/check.h"
+#include "base/output.h"
+#include "prop/theory_proxy.h"
 
 namespace cvc5 {
 namespace prop {
@@ -53,6 +59,11 @@ CadicalLit toCadicalLit(const SatLiteral lit)
 
 CadicalVar toCadicalVar(SatVariable var) { return var; }
 
+SatLiteral toSatLiteral(CadicalLit lit)
+{
+  return lit < 0 ? SatLiteral(-lit, true) : SatLiteral(lit, false);
+}
+
 }  // namespace helper functions
 
 CadicalSolver::CadicalSolver(StatisticsRegistry* registry,
@@ -199,6 +210,744 @@ CadicalSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_solveTime);
 }
 
+/* -------------------------------------------------------------------------- */
+
+/**
+ * The propagator connecting CaDiCaL to the theories.
+ *
+ * It mirrors the trail of CaDiCaL, pushes the SAT context for every decision
+ * level and enqueues assigned theory atoms to the theory proxy. Literals that
+ * CaDiCaL fixes (at the root level) stay assigned when backtracking, but the
+ * theories forget them with the SAT context. Fixed theory literals are
+ * therefore kept in buckets by the SAT context level at which they were last
+ * enqueued, and enqueued again when the SAT context is popped below that
+ * level.
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator,
+                          public CaDiCaL::FixedAssignmentListener
+{
+ public:
+  CadicalPropagator(TheoryProxy* proxy,
+                    context::Context* context,
+                    CaDiCaL::Solver& solver,
+                    IntStat& numTheoryPropagations)
+      : d_proxy(proxy),
+        d_context(context),
+        d_solver(solver),
+        d_numTheoryPropagations(numTheoryPropagations),
+        d_inSearch(false),
+        d_baseLevel(0),
+        d_numAssigned(0),
+        d_numBacktracks(0),
+        d_checked(false),
+        d_inReason(false),
+        d_reasonIndex(0),
+        d_clauseIndex(0)
+  {
+    // the theories are checked and propagate on partial assignments too
+    is_lazy = false;
+  }
+
+  /* FixedAssignmentListener --------------------------------------------- */
+
+  void notify_fixed_assignment(int lit) override
+  {
+    SatLiteral slit = toSatLiteral(lit);
+    SatVariable var = slit.getSatVariable();
+    Assert(var < d_varInfo.size());
+    VarInfo& info = d_varInfo[var];
+    if (info.d_isFixed)
+    {
+      return;
+    }
+    if (info.d_value == SAT_VALUE_UNKNOWN)
+    {
+      assign(slit);
+    }
+    markFixed(var);
+  }
+
+  /* ExternalPropagator -------------------------------------------------- */
+
+  void notify_assignment(const std::vector<int>& lits) override
+  {
+    for (int lit : lits)
+    {
+      SatLiteral slit = toSatLiteral(lit);
+      SatVariable var = slit.getSatVariable();
+      Assert(var < d_varInfo.size());
+      if (d_varInfo[var].d_value != SAT_VALUE_UNKNOWN)
+      {
+        // already assigned as a fixed literal
+        continue;
+      }
+      assign(slit);
+      if (d_levelLimits.empty())
+      {
+        markFixed(var);
+      }
+    }
+  }
+
+  void notify_new_decision_level() override
+  {
+    d_levelLimits.push_back(d_trail.size());
+    d_context->push();
+  }
+
+  void notify_backtrack(size_t level) override { backtrack(level); }
+
+  bool cb_check_found_model(const std::vector<int>& model) override
+  {
+    Trace("cadical::propagator") << "cb_check_found_model" << std::endl;
+    do
+    {
+      d_proxy->theoryCheck(theory::Theory::EFFORT_FULL);
+      if (!d_newClauses.empty())
+      {
+        return false;
+      }
+    } while (d_proxy->theoryNeedCheck());
+    return true;
+  }
+
+  int cb_decide() override
+  {
+    SatLiteral lit = d_proxy->getNextTheoryDecisionRequest();
+    while (lit != undefSatLiteral && value(lit) != SAT_VALUE_UNKNOWN)
+    {
+      lit = d_proxy->getNextTheoryDecisionRequest();
+    }
+    if (lit == undefSatLiteral)
+    {
+      // CaDiCaL can not stop the search early, hence stopSearch is ignored
+      bool stopSearch = false;
+      lit = d_proxy->getNextDecisionEngineRequest(stopSearch);
+      if (lit == undefSatLiteral || value(lit) != SAT_VALUE_UNKNOWN)
+      {
+        return 0;
+      }
+    }
+    Trace("cadical::propagator") << "cb_decide: " << lit << std::endl;
+    return toCadicalLit(lit);
+  }
+
+  int cb_propagate() override
+  {
+    if (d_propagations.empty() && !d_checked)
+    {
+      d_checked = true;
+      d_proxy->theoryCheck(theory::Theory::EFFORT_STANDARD);
+      SatClause propagations;
+      d_proxy->theoryPropagate(propagations);
+      for (const SatLiteral& lit : propagations)
+      {
+        SatValue val = value(lit);
+        if (val == SAT_VALUE_FALSE)
+        {
+          // the explanation is a conflict clause
+          SatClause explanation;
+          d_proxy->explainPropagation(lit, explanation);
+          addClause(explanation, true);
+        }
+        else if (val == SAT_VALUE_UNKNOWN)
+        {
+          d_propagations.push_back(lit);
+        }
+      }
+    }
+    while (!d_propagations.empty())
+    {
+      SatLiteral lit = d_propagations.front();
+      d_propagations.pop_front();
+      if (value(lit) != SAT_VALUE_TRUE)
+      {
+        Trace("cadical::propagator") << "cb_propagate: " << lit << std::endl;
+        ++d_numTheoryPropagations;
+        return toCadicalLit(lit);
+      }
+    }
+    return 0;
+  }
+
+  int cb_add_reason_clause_lit(int propagatedLit) override
+  {
+    if (!d_inReason)
+    {
+      d_reason.clear();
+      d_proxy->explainPropagation(toSatLiteral(propagatedLit), d_reason);
+      d_reasonIndex = 0;
+      d_inReason = true;
+    }
+    if (d_reasonIndex < d_reason.size())
+    {
+      return toCadicalLit(d_reason[d_reasonIndex++]);
+    }
+    d_inReason = false;
+    return 0;
+  }
+
+  bool cb_has_external_clause(bool& isForgettable) override
+  {
+    if (d_newClauses.empty())
+    {
+      return false;
+    }
+    isForgettable = d_newClauses.front().second;
+    return true;
+  }
+
+  int cb_add_external_clause_lit() override
+  {
+    Assert(!d_newClauses.empty());
+    const SatClause& clause = d_newClauses.front().first;
+    if (d_clauseIndex < clause.size())
+    {
+      return toCadicalLit(clause[d_clauseIndex++]);
+    }
+    d_newClauses.pop_front();
+    d_clauseIndex = 0;
+    return 0;
+  }
+
+  /* Interface for CDCLTCadicalSolver ------------------------------------ */
+
+  /** Add a variable, created at the given user level */
+  void addVariable(SatVariable var,
+                   bool isTheoryAtom,
+                   bool preRegister,
+                   unsigned userLevel)
+  {
+    if (var >= d_varInfo.size())
+    {
+      d_varInfo.resize(var + 1);
+    }
+    VarInfo& info = d_varInfo[var];
+    info.d_isTheoryAtom = isTheoryAtom;
+    info.d_userLevel = userLevel;
+    // Variables introduced during search must be registered again with the
+    // theories when backtracking below the level they were introduced at.
+    if (preRegister && !d_levelLimits.empty())
+    {
+      d_varsToRegister.emplace_back(var, d_levelLimits.size());
+    }
+    // Observed variables are frozen, so that CaDiCaL does not eliminate
+    // them. This is required since the CNF stream reuses the literals of
+    // formulas in later clauses.
+    d_solver.add_observed_var(toCadicalVar(var));
+  }
+
+  /** Queue a clause added during search, to be given to CaDiCaL */
+  void addClause(const SatClause& clause, bool removable)
+  {
+    d_newClauses.emplace_back(clause, removable);
+  }
+
+  /** Whether we are inside a call to solve() */
+  bool inSearch() const { return d_inSearch; }
+
+  /** The value of lit on the trail */
+  SatValue value(SatLiteral lit) const
+  {
+    SatVariable var = lit.getSatVariable();
+    Assert(var < d_varInfo.size());
+    SatValue val = d_varInfo[var].d_value;
+    if (val == SAT_VALUE_UNKNOWN || !lit.isNegated())
+    {
+      return val;
+    }
+    return val == SAT_VALUE_TRUE ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+  }
+
+  /** Whether expl was assigned true before lit was */
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const
+  {
+    return value(lit) == SAT_VALUE_TRUE && value(expl) == SAT_VALUE_TRUE
+           && d_varInfo[expl.getSatVariable()].d_trailIndex
+                  < d_varInfo[lit.getSatVariable()].d_trailIndex;
+  }
+
+  /** The number of backtracks so far */
+  uint64_t getNumBacktracks() const { return d_numBacktracks; }
+
+  /** Called at the beginning of solve() */
+  void startSearch()
+  {
+    resetTrail();
+    d_baseLevel = d_context->getLevel();
+    // user-level pops may have popped the levels of fixed theory literals
+    renotifyFixed();
+    d_inSearch = true;
+  }
+
+  /**
+   * Called at the end of solve(). Clauses that were not given to CaDiCaL yet
+   * (e.g. when the search was interrupted) are added directly.
+   */
+  void endSearch()
+  {
+    d_inSearch = false;
+    for (const std::pair<SatClause, bool>& c : d_newClauses)
+    {
+      for (const SatLiteral& lit : c.first)
+      {
+        d_solver.add(toCadicalLit(lit));
+      }
+      d_solver.add(0);
+    }
+    d_newClauses.clear();
+    d_clauseIndex = 0;
+    d_inReason = false;
+  }
+
+  /** Backtrack the trail and the SAT context to the base level */
+  void resetTrail() { backtrack(0); }
+
+  /**
+   * Called after popping to the given user level. Variables created above
+   * it are no longer known to the CNF stream.
+   */
+  void userPop(unsigned userLevel)
+  {
+    for (VarInfo& info : d_varInfo)
+    {
+      if (info.d_userLevel > userLevel)
+      {
+        info.d_isTheoryAtom = false;
+      }
+    }
+    for (std::vector<SatVariable>& bucket : d_fixedTheoryLits)
+    {
+      size_t j = 0;
+      for (SatVariable var : bucket)
+      {
+        if (d_varInfo[var].d_isTheoryAtom)
+        {
+          bucket[j++] = var;
+        }
+      }
+      bucket.resize(j);
+    }
+    d_varsToRegister.clear();
+  }
+
+ private:
+  /** Information about a variable */
+  struct VarInfo
+  {
+    /** The current value */
+    SatValue d_value = SAT_VALUE_UNKNOWN;
+    /** Whether it is a theory atom */
+    bool d_isTheoryAtom = false;
+    /** Whether it is fixed by CaDiCaL */
+    bool d_isFixed = false;
+    /** The user level at which it was created */
+    unsigned d_userLevel = 0;
+    /** The SAT context level at which it was last enqueued */
+    uint32_t d_enqueueLevel = 0;
+    /** The position of its assignment in the order of all assignments */
+    uint64_t d_trailIndex = 0;
+  };
+
+  /** Assign lit, and enqueue it if it is a theory literal */
+  void assign(SatLiteral lit)
+  {
+    SatVariable var = lit.getSatVariable();
+    VarInfo& info = d_varInfo[var];
+    info.d_value = lit.isNegated() ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+    info.d_trailIndex = d_numAssigned++;
+    d_trail.push_back(var);
+    if (info.d_isTheoryAtom)
+    {
+      info.d_enqueueLevel = d_context->getLevel();
+      d_proxy->enqueueTheoryLiteral(lit);
+      d_checked = false;
+    }
+  }
+
+  /** Mark the assigned variable var as fixed */
+  void markFixed(SatVariable var)
+  {
+    VarInfo& info = d_varInfo[var];
+    info.d_isFixed = true;
+    if (info.d_isTheoryAtom)
+    {
+      if (d_fixedTheoryLits.size() <= info.d_enqueueLevel)
+      {
+        d_fixedTheoryLits.resize(info.d_enqueueLevel + 1);
+      }
+      d_fixedTheoryLits[info.d_enqueueLevel].push_back(var);
+    }
+  }
+
+  /**
+   * Enqueue again the fixed theory literals that were enqueued above the
+   * current SAT context level.
+   */
+  void renotifyFixed()
+  {
+    size_t level = d_context->getLevel();
+    if (d_fixedTheoryLits.size() <= level + 1)
+    {
+      return;
+    }
+    std::vector<SatVariable>& target = d_fixedTheoryLits[level];
+    for (size_t i = level + 1, size = d_fixedTheoryLits.size(); i < size; ++i)
+    {
+      for (SatVariable var : d_fixedTheoryLits[i])
+      {
+        VarInfo& info = d_varInfo[var];
+        info.d_enqueueLevel = level;
+        d_proxy->enqueueTheoryLiteral(
+            SatLiteral(var, info.d_value == SAT_VALUE_FALSE));
+        target.push_back(var);
+      }
+    }
+    d_fixedTheoryLits.resize(level + 1);
+    d_checked = false;
+  }
+
+  /** Backtrack to the given decision level */
+  void backtrack(size_t level)
+  {
+    if (level >= d_levelLimits.size())
+    {
+      return;
+    }
+    Trace("cadical::propagator") << "backtrack to " << level << std::endl;
+    ++d_numBacktracks;
+    size_t limit = d_levelLimits[level];
+    for (size_t i = d_trail.size(); i > limit; --i)
+    {
+      VarInfo& info = d_varInfo[d_trail[i - 1]];
+      if (!info.d_isFixed)
+      {
+        info.d_value = SAT_VALUE_UNKNOWN;
+      }
+    }
+    d_trail.resize(limit);
+    d_levelLimits.resize(level);
+    d_context->popto(d_baseLevel + level);
+    d_propagations.clear();
+    d_checked = false;
+    d_inReason = false;
+    renotifyFixed();
+    for (size_t i = d_varsToRegister.size();
+         i > 0 && d_varsToRegister[i - 1].second > level;
+         --i)
+    {
+      d_varsToRegister[i - 1].second = level;
+      d_proxy->variableNotify(d_varsToRegister[i - 1].first);
+    }
+  }
+
+  /** The theory proxy */
+  TheoryProxy* d_proxy;
+  /** The SAT context */
+  context::Context* d_context;
+  /** The CaDiCaL instance */
+  CaDiCaL::Solver& d_solver;
+  /** The statistic for the number of theory propagations */
+  IntStat& d_numTheoryPropagations;
+  /** Whether we are inside a call to solve() */
+  bool d_inSearch;
+  /** The SAT context level at decision level 0 */
+  size_t d_baseLevel;
+
+  /** Information about each variable */
+  std::vector<VarInfo> d_varInfo;
+  /** The assigned variables, in the order of their assignment */
+  std::vector<SatVariable> d_trail;
+  /** The size of the trail at the beginning of each decision level */
+  std::vector<size_t> d_levelLimits;
+  /** The number of assignments so far */
+  uint64_t d_numAssigned;
+  /** The number of backtracks so far */
+  uint64_t d_numBacktracks;
+  /**
+   * The fixed theory literals, by the SAT context level at which they were
+   * last enqueued.
+   */
+  std::vector<std::vector<SatVariable>> d_fixedTheoryLits;
+  /** Variables to register again on backtracks, with their decision level */
+  std::vector<std::pair<SatVariable, size_t>> d_varsToRegister;
+
+  /** Whether the theories were checked since the last assignment */
+  bool d_checked;
+  /** The theory propagations that were not given to CaDiCaL yet */
+  std::deque<SatLiteral> d_propagations;
+  /** Whether we are in the middle of giving a reason clause to CaDiCaL */
+  bool d_inReason;
+  /** The current reason clause */
+  SatClause d_reason;
+  /** The next literal of d_reason to give to CaDiCaL */
+  size_t d_reasonIndex;
+  /** The clauses added during search, and whether they are removable */
+  std::deque<std::pair<SatClause, bool>> d_newClauses;
+  /** The next literal of the first clause of d_newClauses */
+  size_t d_clauseIndex;
+};
+
+/* -------------------------------------------------------------------------- */
+
+CDCLTCadicalSolver::CDCLTCadicalSolver(StatisticsRegistry* registry)
+    : d_solver(new CaDiCaL::Solver()),
+      d_context(nullptr),
+      d_nextVarIdx(1),
+      d_inSatMode(false),
+      d_statistics(registry)
+{
+}
+
+CDCLTCadicalSolver::~CDCLTCadicalSolver()
+{
+  if (d_propagator != nullptr)
+  {
+    d_solver->disconnect_fixed_listener();
+    d_solver->disconnect_external_propagator();
+  }
+}
+
+void CDCLTCadicalSolver::initialize(context::Context* context,
+                                    prop::TheoryProxy* theoryProxy,
+                                    context::UserContext* userContext,
+                                    ProofNodeManager* pnm)
+{
+  Assert(pnm == nullptr) << "CaDiCaL does not support proofs";
+  d_context = context;
+  d_solver->set("quiet", 1);  // CaDiCaL is verbose by default
+  d_propagator.reset(new CadicalPropagator(
+      theoryProxy, context, *d_solver, d_statistics.d_numTheoryPropagations));
+  d_solver->connect_external_propagator(d_propagator.get());
+  d_solver->connect_fixed_listener(d_propagator.get());
+
+  d_true = newVar(false, false, false);
+  d_false = newVar(false, false, false);
+  d_solver->add(toCadicalVar(d_true));
+  d_solver->add(0);
+  d_solver->add(-toCadicalVar(d_false));
+  d_solver->add(0);
+}
+
+ClauseId CDCLTCadicalSolver::addClause(SatClause& clause, bool removable)
+{
+  SatClause guarded;
+  const SatClause* c = &clause;
+  if (!d_activationLits.empty())
+  {
+    guarded = clause;
+    guarded.push_back(~d_activationLits.back());
+    c = &guarded;
+  }
+  if (d_propagator->inSearch())
+  {
+    d_propagator->addClause(*c, removable);
+    ++d_statistics.d_numLemmas;
+  }
+  else
+  {
+    for (const SatLiteral& lit : *c)
+    {
+      d_solver->add(toCadicalLit(lit));
+    }
+    d_solver->add(0);
+    d_inSatMode = false;
+  }
+  ++d_statistics.d_numClauses;
+  return ClauseIdError;
+}
+
+ClauseId CDCLTCadicalSolver::addXorClause(SatClause& clause,
+                                          bool rhs,
+                                          bool removable)
+{
+  Unreachable() << "CaDiCaL does not support adding XOR clauses.";
+}
+
+SatVariable CDCLTCadicalSolver::newVar(bool isTheoryAtom,
+                                       bool preRegister,
+                                       bool canErase)
+{
+  ++d_statistics.d_numVariables;
+  SatVariable var = d_nextVarIdx++;
+  d_propagator->addVariable(
+      var, isTheoryAtom, preRegister, getAssertionLevel());
+  return var;
+}
+
+SatVariable CDCLTCadicalSolver::trueVar() { return d_true; }
+
+SatVariable CDCLTCadicalSolver::falseVar() { return d_false; }
+
+SatValue CDCLTCadicalSolver::solve()
+{
+  d_assumptions.clear();
+  return solveInternal();
+}
+
+SatValue CDCLTCadicalSolver::solve(long unsigned int& resource)
+{
+  Trace("limit") << "SatSolver::solve(): have limit of " << resource
+                 << " conflicts" << std::endl;
+  if (resource != 0)
+  {
+    d_solver->limit("conflicts", static_cast<int>(resource));
+  }
+  // CaDiCaL does not report the number of conflicts of a call, we count the
+  // backtracks instead
+  uint64_t backtracksBefore = d_propagator->getNumBacktracks();
+  SatValue result = solve();
+  resource = d_propagator->getNumBacktracks() - backtracksBefore;
+  Trace("limit") << "SatSolver::solve(): it took " << resource
+                 << " conflicts" << std::endl;
+  return result;
+}
+
+SatValue CDCLTCadicalSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  d_assumptions = assumptions;
+  return solveInternal();
+}
+
+SatValue CDCLTCadicalSolver::solveInternal()
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
+  d_propagator->startSearch();
+  for (const SatLiteral& lit : d_activationLits)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+  for (const SatLiteral& lit : d_assumptions)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+  SatValue res = toSatValue(d_solver->solve());
+  d_propagator->endSearch();
+  d_inSatMode = (res == SAT_VALUE_TRUE);
+  ++d_statistics.d_numSatCalls;
+  return res;
+}
+
+void CDCLTCadicalSolver::getUnsatAssumptions(
+    std::vector<SatLiteral>& assumptions)
+{
+  for (const SatLiteral& lit : d_assumptions)
+  {
+    if (d_solver->failed(toCadicalLit(lit)))
+    {
+      assumptions.push_back(lit);
+    }
+  }
+}
+
+void CDCLTCadicalSolver::interrupt() { d_solver->terminate(); }
+
+SatValue CDCLTCadicalSolver::value(SatLiteral l)
+{
+  return d_propagator->value(l);
+}
+
+SatValue CDCLTCadicalSolver::modelValue(SatLiteral l)
+{
+  Assert(d_inSatMode);
+  return toSatValueLit(d_solver->val(toCadicalLit(l)));
+}
+
+unsigned CDCLTCadicalSolver::getAssertionLevel() const
+{
+  return d_activationLits.size();
+}
+
+bool CDCLTCadicalSolver::ok() const
+{
+  // an unsatisfiable result without assumptions means that the clauses are
+  // inconsistent
+  return d_solver->status() != 20 || !d_assumptions.empty()
+         || !d_activationLits.empty();
+}
+
+void CDCLTCadicalSolver::push()
+{
+  Assert(!d_propagator->inSearch());
+  d_propagator->resetTrail();
+  SatVariable var = newVar(false, false, false);
+  d_activationLits.push_back(SatLiteral(var));
+  d_context->push();
+}
+
+void CDCLTCadicalSolver::pop()
+{
+  Assert(!d_propagator->inSearch());
+  Assert(!d_activationLits.empty());
+  d_propagator->resetTrail();
+  // deactivate the clauses of the popped level
+  d_solver->add(toCadicalLit(~d_activationLits.back()));
+  d_solver->add(0);
+  d_activationLits.pop_back();
+  d_context->pop();
+  d_propagator->userPop(getAssertionLevel());
+  d_inSatMode = false;
+}
+
+void CDCLTCadicalSolver::resetTrail() { d_propagator->resetTrail(); }
+
+bool CDCLTCadicalSolver::properExplanation(SatLiteral lit,
+                                           SatLiteral expl) const
+{
+  return d_propagator->properExplanation(lit, expl);
+}
+
+void CDCLTCadicalSolver::requirePhase(SatLiteral lit)
+{
+  d_solver->phase(toCadicalLit(lit));
+}
+
+bool CDCLTCadicalSolver::isDecision(SatVariable decn) const
+{
+  return d_solver->is_decision(toCadicalVar(decn));
+}
+
+double CDCLTCadicalSolver::getActivity(SatVariable var) const { return 0; }
+
+void CDCLTCadicalSolver::getLearnedClauses(std::vector<SatClause>& clauses,
+                                           uint32_t maxSize,
+                                           uint32_t maxLbd)
+{
+  Trace("cadical") << "learned clauses are not supported" << std::endl;
+}
+
+std::shared_ptr<ProofNode> CDCLTCadicalSolver::getProof()
+{
+  Unreachable() << "CaDiCaL does not support proofs.";
+}
+
+CDCLTCadicalSolver::Statistics::Statistics(StatisticsRegistry* registry)
+    : d_registry(registry),
+      d_numSatCalls("prop::cadical::calls_to_solve", 0),
+      d_numVariables("prop::cadical::variables", 0),
+      d_numClauses("prop::cadical::clauses", 0),
+      d_numLemmas("prop::cadical::lemmas", 0),
+      d_numTheoryPropagations("prop::cadical::theory_propagations", 0),
+      d_solveTime("prop::cadical::solve_time")
+{
+  d_registry->registerStat(&d_numSatCalls);
+  d_registry->registerStat(&d_numVariables);
+  d_registry->registerStat(&d_numClauses);
+  d_registry->registerStat(&d_numLemmas);
+  d_registry->registerStat(&d_numTheoryPropagations);
+  d_registry->registerStat(&d_solveTime);
+}
+
+CDCLTCadicalSolver::Statistics::~Statistics()
+{
+  d_registry->unregisterStat(&d_numSatCalls);
+  d_registry->unregisterStat(&d_numVariables);
+  d_registry->unregisterStat(&d_numClauses);
+  d_registry->unregisterStat(&d_numLemmas);
+  d_registry->unregisterStat(&d_numTheoryPropagations);
+  d_registry->unregisterStat(&d_solveTime);
+}
+
 }  // namespace prop
 }  // namespace cvc5
 
@@ -11,7 +11,9 @@
  **
  ** \brief Wrapper for CaDiCaL SAT Solver.
  **
- ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors).
+ ** Implementation of the CaDiCaL SAT solver for CVC4 (bitvectors), and of
+ ** a CDCL(T) SAT solver for the main search based on CaDiCaL's external
+ ** propagator interface.
  **/
 
 #include "cvc4_private.h"
@@ -21,11 +23,12 @@
 
 #ifdef CVC4_USE_CADICAL
 
+#include <cadical.hpp>
+
+#include "context/context.h"
 #include "prop/sat_solver.h"
 #include "util/stats_timer.h"
 
-#include <cadical.hpp>
-
 namespace cvc5 {
 namespace prop {
 
@@ -102,6 +105,145 @@ class CadicalSolver : public SatSolver
   Statistics d_statistics;
 };
 
+class CadicalPropagator;
+
+/**
+ * A CDCL(T) SAT solver based on CaDiCaL (version 2.0 or later), which is
+ * connected to the theories via CaDiCaL's external propagator interface
+ * (IPASIR-UP).
+ *
+ * All variables are observed by the propagator, so that it can maintain the
+ * SAT context, enqueue theory literals, answer value() queries during search
+ * and ask the theories for propagations, decisions and full checks. Clauses
+ * added during search (lemmas and conflicts) are handed to CaDiCaL as
+ * external clauses. User-level push and pop are implemented with activation
+ * literals that are assumed by each call to solve().
+ *
+ * Proofs are not supported.
+ */
+class CDCLTCadicalSolver : public CDCLTSatSolverInterface
+{
+  friend class SatSolverFactory;
+
+ public:
+  ~CDCLTCadicalSolver() override;
+
+  /* SatSolver interface ------------------------------------------------- */
+
+  ClauseId addClause(SatClause& clause, bool removable) override;
+
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
+
+  SatVariable newVar(bool isTheoryAtom,
+                     bool preRegister,
+                     bool canErase) override;
+
+  SatVariable trueVar() override;
+
+  SatVariable falseVar() override;
+
+  SatValue solve() override;
+  SatValue solve(long unsigned int& resource) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+  void getUnsatAssumptions(std::vector<SatLiteral>& assumptions) override;
+
+  void interrupt() override;
+
+  SatValue value(SatLiteral l) override;
+
+  SatValue modelValue(SatLiteral l) override;
+
+  unsigned getAssertionLevel() const override;
+
+  bool ok() const override;
+
+  /* CDCLTSatSolverInterface --------------------------------------------- */
+
+  void initialize(context::Context* context,
+                  prop::TheoryProxy* theoryProxy,
+                  context::UserContext* userContext,
+                  ProofNodeManager* pnm) override;
+
+  void push() override;
+
+  void pop() override;
+
+  void resetTrail() override;
+
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+  /**
+   * CaDiCaL does not expose the scores of its heuristics, so all variables
+   * have activity 0.
+   */
+  double getActivity(SatVariable var) const override;
+
+  /**
+   * CaDiCaL only reports learned clauses while they are learned, without
+   * their literal block distance, and they may contain the activation
+   * literals of the user levels, which have no node. Learned clauses are
+   * therefore not supported.
+   */
+  bool supportsLearnedClauses() const override { return false; }
+
+  /** Adds no clauses, see supportsLearnedClauses(). */
+  void getLearnedClauses(std::vector<SatClause>& clauses,
+                         uint32_t maxSize,
+                         uint32_t maxLbd) override;
+
+  std::shared_ptr<ProofNode> getProof() override;
+
+ private:
+  /**
+   * Private to disallow creation outside of SatSolverFactory.
+   * Function initialize() must be called after creation.
+   */
+  CDCLTCadicalSolver(StatisticsRegistry* registry);
+
+  /** Solve under the activation literals and d_assumptions */
+  SatValue solveInternal();
+
+  /** The CaDiCaL instance */
+  std::unique_ptr<CaDiCaL::Solver> d_solver;
+  /** The propagator connecting d_solver to the theories */
+  std::unique_ptr<CadicalPropagator> d_propagator;
+  /** The SAT context, which is pushed per decision level */
+  context::Context* d_context;
+  /** The assumptions of the last call to solve() */
+  std::vector<SatLiteral> d_assumptions;
+  /**
+   * The activation literal of each user level. Clauses added at a user level
+   * are guarded by its activation literal.
+   */
+  std::vector<SatLiteral> d_activationLits;
+
+  unsigned d_nextVarIdx;
+  bool d_inSatMode;
+  SatVariable d_true;
+  SatVariable d_false;
+
+  struct Statistics
+  {
+    StatisticsRegistry* d_registry;
+    IntStat d_numSatCalls;
+    IntStat d_numVariables;
+    IntStat d_numClauses;
+    IntStat d_numLemmas;
+    IntStat d_numTheoryPropagations;
+    TimerStat d_solveTime;
+    Statistics(StatisticsRegistry* registry);
+    ~Statistics();
+  };
+
+  Statistics d_statistics;
+
+  friend class CadicalPropagator;
+};
+
 }  // namespace prop
 }  // namespace cvc5
 
@@ -17,7 +17,9 @@
  **/
 #include "prop/cnf_stream.h"
 
+#include <algorithm>
 #include <queue>
+#include <unordered_set>
 
 #include "base/check.h"
 #include "base/output.h"
@@ -58,7 +60,12 @@ CnfStream::CnfStream(SatSolver* satSolver,
       d_name(name),
       d_cnfProof(nullptr),
       d_removable(false),
-      d_resourceManager(rm)
+      d_resourceManager(rm),
+      d_gateSimp(false),
+      d_pgEncoding(false),
+      d_definedPolarity(context),
+      d_gates(context),
+      d_andGateInputs(context)
 {
 }
 
@@ -151,6 +158,11 @@ void CnfStream::ensureLiteral(TNode n)
   Trace("cnf") << "ensureLiteral(" << n << ")\n";
   if (hasLiteral(n))
   {
+    if (d_pgEncoding)
+    {
+      // the literal must be equivalent to n
+      toCNF(n);
+    }
     ensureMappingForLiteral(n);
     return;
   }
@@ -194,6 +206,13 @@ void CnfStream::ensureLiteral(TNode n)
   }
 }
 
+SatLiteral CnfStream::newDefinedLiteral(TNode n)
+{
+  Assert(n.getKind() != kind::NOT && !hasLiteral(n));
+  Assert(!d_pgEncoding) << "partial definitions are not supported";
+  return newLiteral(n);
+}
+
 SatLiteral CnfStream::newLiteral(TNode node, bool isTheoryAtom, bool preRegister, bool canEliminate) {
   Trace("cnf") << d_name << "::newLiteral(" << node << ", " << isTheoryAtom
                << ")\n"
@@ -324,9 +343,9 @@ SatLiteral CnfStream::getLiteral(TNode node) {
   return literal;
 }
 
-SatLiteral CnfStream::handleXor(TNode xorNode)
+SatLiteral CnfStream::handleXor(TNode xorNode, uint8_t pol)
 {
-  Assert(!hasLiteral(xorNode)) << "Atom already mapped!";
+  Assert(d_pgEncoding || !hasLiteral(xorNode)) << "Atom already mapped!";
   Assert(xorNode.getKind() == kind::XOR) << "Expecting an XOR expression!";
   Assert(xorNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -335,19 +354,31 @@ SatLiteral CnfStream::handleXor(TNode xorNode)
   SatLiteral a = toCNF(xorNode[0]);
   SatLiteral b = toCNF(xorNode[1]);
 
-  SatLiteral xorLit = newLiteral(xorNode);
+  if (d_gateSimp)
+  {
+    return mkXorGate(xorNode, a, b, false);
+  }
+
+  SatLiteral xorLit = getOrNewLiteral(xorNode);
 
-  assertClause(xorNode.negate(), a, b, ~xorLit);
-  assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
-  assertClause(xorNode, a, ~b, xorLit);
-  assertClause(xorNode, ~a, b, xorLit);
+  if (pol & s_polPos)
+  {
+    assertClause(xorNode.negate(), a, b, ~xorLit);
+    assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
+  }
+  if (pol & s_polNeg)
+  {
+    assertClause(xorNode, a, ~b, xorLit);
+    assertClause(xorNode, ~a, b, xorLit);
+  }
+  addDefinedPolarity(xorNode, pol);
 
   return xorLit;
 }
 
-SatLiteral CnfStream::handleOr(TNode orNode)
+SatLiteral CnfStream::handleOr(TNode orNode, uint8_t pol)
 {
-  Assert(!hasLiteral(orNode)) << "Atom already mapped!";
+  Assert(d_pgEncoding || !hasLiteral(orNode)) << "Atom already mapped!";
   Assert(orNode.getKind() == kind::OR) << "Expecting an OR expression!";
   Assert(orNode.getNumChildren() > 1) << "Expecting more then 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -356,37 +387,58 @@ SatLiteral CnfStream::handleOr(TNode orNode)
   // Number of children
   unsigned n_children = orNode.getNumChildren();
 
-  // Transform all the children first
+  // Transform all the children first, which occur with the polarity of the
+  // node
   TNode::const_iterator node_it = orNode.begin();
   TNode::const_iterator node_it_end = orNode.end();
   SatClause clause(n_children + 1);
   for(int i = 0; node_it != node_it_end; ++node_it, ++i) {
-    clause[i] = toCNF(*node_it);
+    clause[i] = toCNF(*node_it, false, pol);
+  }
+
+  if (d_gateSimp)
+  {
+    // (a_1 | ... | a_n) is ~(~a_1 & ... & ~a_n)
+    std::vector<SatLiteral> lits;
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      lits.push_back(~clause[i]);
+    }
+    return mkAndGate(orNode, lits, true);
   }
 
   // Get the literal for this node
-  SatLiteral orLit = newLiteral(orNode);
+  SatLiteral orLit = getOrNewLiteral(orNode);
 
   // lit <- (a_1 | a_2 | a_3 | ... | a_n)
   // lit | ~(a_1 | a_2 | a_3 | ... | a_n)
   // (lit | ~a_1) & (lit | ~a_2) & (lit & ~a_3) & ... & (lit & ~a_n)
-  for(unsigned i = 0; i < n_children; ++i) {
-    assertClause(orNode, orLit, ~clause[i]);
+  if (pol & s_polNeg)
+  {
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      assertClause(orNode, orLit, ~clause[i]);
+    }
   }
 
   // lit -> (a_1 | a_2 | a_3 | ... | a_n)
   // ~lit | a_1 | a_2 | a_3 | ... | a_n
-  clause[n_children] = ~orLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(orNode.negate(), clause);
+  if (pol & s_polPos)
+  {
+    clause[n_children] = ~orLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(orNode.negate(), clause);
+  }
+  addDefinedPolarity(orNode, pol);
 
   // Return the literal
   return orLit;
 }
 
-SatLiteral CnfStream::handleAnd(TNode andNode)
+SatLiteral CnfStream::handleAnd(TNode andNode, uint8_t pol)
 {
-  Assert(!hasLiteral(andNode)) << "Atom already mapped!";
+  Assert(d_pgEncoding || !hasLiteral(andNode)) << "Atom already mapped!";
   Assert(andNode.getKind() == kind::AND) << "Expecting an AND expression!";
   Assert(andNode.getNumChildren() > 1) << "Expecting more than 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -395,65 +447,100 @@ SatLiteral CnfStream::handleAnd(TNode andNode)
   // Number of children
   unsigned n_children = andNode.getNumChildren();
 
-  // Transform all the children first (remembering the negation)
+  // Transform all the children first (remembering the negation), which occur
+  // with the polarity of the node
   TNode::const_iterator node_it = andNode.begin();
   TNode::const_iterator node_it_end = andNode.end();
   SatClause clause(n_children + 1);
   for(int i = 0; node_it != node_it_end; ++node_it, ++i) {
-    clause[i] = ~toCNF(*node_it);
+    clause[i] = ~toCNF(*node_it, false, pol);
+  }
+
+  if (d_gateSimp)
+  {
+    std::vector<SatLiteral> lits;
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      lits.push_back(~clause[i]);
+    }
+    return mkAndGate(andNode, lits, false);
   }
 
   // Get the literal for this node
-  SatLiteral andLit = newLiteral(andNode);
+  SatLiteral andLit = getOrNewLiteral(andNode);
 
   // lit -> (a_1 & a_2 & a_3 & ... & a_n)
   // ~lit | (a_1 & a_2 & a_3 & ... & a_n)
   // (~lit | a_1) & (~lit | a_2) & ... & (~lit | a_n)
-  for(unsigned i = 0; i < n_children; ++i) {
-    assertClause(andNode.negate(), ~andLit, ~clause[i]);
+  if (pol & s_polPos)
+  {
+    for (unsigned i = 0; i < n_children; ++i)
+    {
+      assertClause(andNode.negate(), ~andLit, ~clause[i]);
+    }
   }
 
   // lit <- (a_1 & a_2 & a_3 & ... a_n)
   // lit | ~(a_1 & a_2 & a_3 & ... & a_n)
   // lit | ~a_1 | ~a_2 | ~a_3 | ... | ~a_n
-  clause[n_children] = andLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(andNode, clause);
+  if (pol & s_polNeg)
+  {
+    clause[n_children] = andLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(andNode, clause);
+  }
+  addDefinedPolarity(andNode, pol);
 
   return andLit;
 }
 
-SatLiteral CnfStream::handleImplies(TNode impliesNode)
+SatLiteral CnfStream::handleImplies(TNode impliesNode, uint8_t pol)
 {
-  Assert(!hasLiteral(impliesNode)) << "Atom already mapped!";
+  Assert(d_pgEncoding || !hasLiteral(impliesNode)) << "Atom already mapped!";
   Assert(impliesNode.getKind() == kind::IMPLIES)
       << "Expecting an IMPLIES expression!";
   Assert(impliesNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "handleImplies(" << impliesNode << ")\n";
 
-  // Convert the children to cnf
-  SatLiteral a = toCNF(impliesNode[0]);
-  SatLiteral b = toCNF(impliesNode[1]);
+  // Convert the children to cnf, the antecedent occurs with the opposite
+  // polarity of the node
+  SatLiteral a = toCNF(impliesNode[0], false, flipPolarity(pol));
+  SatLiteral b = toCNF(impliesNode[1], false, pol);
+
+  if (d_gateSimp)
+  {
+    // (a -> b) is ~(a & ~b)
+    std::vector<SatLiteral> lits{a, ~b};
+    return mkAndGate(impliesNode, lits, true);
+  }
 
-  SatLiteral impliesLit = newLiteral(impliesNode);
+  SatLiteral impliesLit = getOrNewLiteral(impliesNode);
 
   // lit -> (a->b)
   // ~lit | ~ a | b
-  assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  if (pol & s_polPos)
+  {
+    assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  }
 
   // (a->b) -> lit
   // ~(~a | b) | lit
   // (a | l) & (~b | l)
-  assertClause(impliesNode, a, impliesLit);
-  assertClause(impliesNode, ~b, impliesLit);
+  if (pol & s_polNeg)
+  {
+    assertClause(impliesNode, a, impliesLit);
+    assertClause(impliesNode, ~b, impliesLit);
+  }
+  addDefinedPolarity(impliesNode, pol);
 
   return impliesLit;
 }
 
-SatLiteral CnfStream::handleIff(TNode iffNode)
+SatLiteral CnfStream::handleIff(TNode iffNode, uint8_t pol)
 {
-  Assert(!hasLiteral(iffNode)) << "Atom already mapped!";
+  Assert(d_pgEncoding || !hasLiteral(iffNode)) << "Atom already mapped!";
   Assert(iffNode.getKind() == kind::EQUAL) << "Expecting an EQUAL expression!";
   Assert(iffNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
@@ -463,40 +550,59 @@ SatLiteral CnfStream::handleIff(TNode iffNode)
   SatLiteral a = toCNF(iffNode[0]);
   SatLiteral b = toCNF(iffNode[1]);
 
+  if (d_gateSimp)
+  {
+    // (a <-> b) is ~(a xor b)
+    return mkXorGate(iffNode, a, b, true);
+  }
+
   // Get the now literal
-  SatLiteral iffLit = newLiteral(iffNode);
+  SatLiteral iffLit = getOrNewLiteral(iffNode);
 
   // lit -> ((a-> b) & (b->a))
   // ~lit | ((~a | b) & (~b | a))
   // (~a | b | ~lit) & (~b | a | ~lit)
-  assertClause(iffNode.negate(), ~a, b, ~iffLit);
-  assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  if (pol & s_polPos)
+  {
+    assertClause(iffNode.negate(), ~a, b, ~iffLit);
+    assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  }
 
   // (a<->b) -> lit
   // ~((a & b) | (~a & ~b)) | lit
   // (~(a & b)) & (~(~a & ~b)) | lit
   // ((~a | ~b) & (a | b)) | lit
   // (~a | ~b | lit) & (a | b | lit)
-  assertClause(iffNode, ~a, ~b, iffLit);
-  assertClause(iffNode, a, b, iffLit);
+  if (pol & s_polNeg)
+  {
+    assertClause(iffNode, ~a, ~b, iffLit);
+    assertClause(iffNode, a, b, iffLit);
+  }
+  addDefinedPolarity(iffNode, pol);
 
   return iffLit;
 }
 
-SatLiteral CnfStream::handleIte(TNode iteNode)
+SatLiteral CnfStream::handleIte(TNode iteNode, uint8_t pol)
 {
-  Assert(!hasLiteral(iteNode)) << "Atom already mapped!";
+  Assert(d_pgEncoding || !hasLiteral(iteNode)) << "Atom already mapped!";
   Assert(iteNode.getKind() == kind::ITE);
   Assert(iteNode.getNumChildren() == 3);
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "handleIte(" << iteNode[0] << " " << iteNode[1] << " "
                << iteNode[2] << ")\n";
 
+  // The branches occur with the polarity of the node
   SatLiteral condLit = toCNF(iteNode[0]);
-  SatLiteral thenLit = toCNF(iteNode[1]);
-  SatLiteral elseLit = toCNF(iteNode[2]);
+  SatLiteral thenLit = toCNF(iteNode[1], false, pol);
+  SatLiteral elseLit = toCNF(iteNode[2], false, pol);
 
-  SatLiteral iteLit = newLiteral(iteNode);
+  if (d_gateSimp)
+  {
+    return mkIteGate(iteNode, condLit, thenLit, elseLit);
+  }
+
+  SatLiteral iteLit = getOrNewLiteral(iteNode);
 
   // If ITE is true then one of the branches is true and the condition
   // implies which one
@@ -504,9 +610,12 @@ SatLiteral CnfStream::handleIte(TNode iteNode)
   // lit -> (t | e) & (b -> t) & (!b -> e)
   // lit -> (t | e) & (!b | t) & (b | e)
   // (!lit | t | e) & (!lit | !b | t) & (!lit | b | e)
-  assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
-  assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
-  assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  if (pol & s_polPos)
+  {
+    assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
+    assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
+    assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  }
 
   // If ITE is false then one of the branches is false and the condition
   // implies which one
@@ -514,24 +623,388 @@ SatLiteral CnfStream::handleIte(TNode iteNode)
   // !lit -> (!t | !e) & (b -> !t) & (!b -> !e)
   // !lit -> (!t | !e) & (!b | !t) & (b | !e)
   // (lit | !t | !e) & (lit | !b | !t) & (lit | b | !e)
-  assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
-  assertClause(iteNode, iteLit, ~condLit, ~thenLit);
-  assertClause(iteNode, iteLit, condLit, ~elseLit);
+  if (pol & s_polNeg)
+  {
+    assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
+    assertClause(iteNode, iteLit, ~condLit, ~thenLit);
+    assertClause(iteNode, iteLit, condLit, ~elseLit);
+  }
+  addDefinedPolarity(iteNode, pol);
 
   return iteLit;
 }
 
-SatLiteral CnfStream::toCNF(TNode node, bool negated)
+void CnfStream::enablePolarityEncoding()
+{
+  Assert(!d_gateSimp);
+  Assert(d_flitPolicy != FormulaLitPolicy::TRACK_AND_NOTIFY);
+  d_pgEncoding = true;
+}
+
+SatLiteral CnfStream::getOrNewLiteral(TNode node)
+{
+  return hasLiteral(node) ? getLiteral(node) : newLiteral(node);
+}
+
+uint8_t CnfStream::getMissingPolarity(TNode node, uint8_t pol) const
+{
+  auto it = d_definedPolarity.find(node);
+  if (it == d_definedPolarity.end())
+  {
+    // an atom, or a formula that was encoded before polarity encoding was
+    // enabled
+    return 0;
+  }
+  return pol & ~(*it).second;
+}
+
+void CnfStream::addDefinedPolarity(TNode node, uint8_t pol)
+{
+  if (!d_pgEncoding)
+  {
+    return;
+  }
+  auto it = d_definedPolarity.find(node);
+  uint8_t defined = it == d_definedPolarity.end() ? 0 : (*it).second;
+  d_definedPolarity[node] = defined | pol;
+}
+
+SatLiteral CnfStream::completeDefinition(TNode node, uint8_t pol)
+{
+  uint8_t missing = getMissingPolarity(node, pol);
+  if (missing != 0)
+  {
+    Trace("cnf") << "completeDefinition(" << node << ", " << int(missing)
+                 << ")\n";
+    switch (node.getKind())
+    {
+      case kind::XOR: return handleXor(node, missing);
+      case kind::ITE: return handleIte(node, missing);
+      case kind::IMPLIES: return handleImplies(node, missing);
+      case kind::OR: return handleOr(node, missing);
+      case kind::AND: return handleAnd(node, missing);
+      case kind::EQUAL: return handleIff(node, missing);
+      default: Unreachable();
+    }
+  }
+  return getLiteral(node);
+}
+
+void CnfStream::enableGateSimplification()
+{
+  Assert(d_cnfProof == nullptr);
+  Assert(d_flitPolicy != FormulaLitPolicy::TRACK_AND_NOTIFY);
+  d_gateSimp = true;
+}
+
+size_t CnfStream::GateKeyHashFunction::operator()(const GateKey& k) const
+{
+  size_t hash = static_cast<size_t>(k.d_kind);
+  for (const SatLiteral& lit : k.d_inputs)
+  {
+    hash = hash * 31 + lit.hash();
+  }
+  return hash;
+}
+
+bool CnfStream::isTrueLiteral(SatLiteral lit)
+{
+  return lit == SatLiteral(d_satSolver->trueVar())
+         || lit == ~SatLiteral(d_satSolver->falseVar());
+}
+
+bool CnfStream::isFalseLiteral(SatLiteral lit)
+{
+  return isTrueLiteral(~lit);
+}
+
+SatLiteral CnfStream::mapToLiteral(TNode node, SatLiteral lit)
+{
+  Trace("cnf") << "mapToLiteral(" << node << ") => " << lit << "\n";
+  Assert(!hasLiteral(node));
+  d_nodeToLiteralMap.insert(node, lit);
+  d_nodeToLiteralMap.insert(node.notNode(), ~lit);
+  if (d_flitPolicy == FormulaLitPolicy::TRACK || Dump.isOn("clauses"))
+  {
+    d_literalToNodeMap.insert_safe(lit, node);
+    d_literalToNodeMap.insert_safe(~lit, node.notNode());
+  }
+  return lit;
+}
+
+SatLiteral CnfStream::mkAndGate(TNode node,
+                                std::vector<SatLiteral>& lits,
+                                bool negated)
+{
+  SatLiteral falseLit = ~SatLiteral(d_satSolver->trueVar());
+  // Constant propagation, duplicate and complementary inputs. Complementary
+  // literals are adjacent after sorting.
+  std::sort(lits.begin(), lits.end());
+  size_t j = 0;
+  for (size_t i = 0, size = lits.size(); i < size; ++i)
+  {
+    SatLiteral lit = lits[i];
+    if (isFalseLiteral(lit) || (j > 0 && lits[j - 1] == ~lit))
+    {
+      return mapToLiteral(node, negated ? ~falseLit : falseLit);
+    }
+    if (!isTrueLiteral(lit) && (j == 0 || lits[j - 1] != lit))
+    {
+      lits[j++] = lit;
+    }
+  }
+  lits.resize(j);
+  // Two-level rules, based on the inputs of the AND gates among the inputs.
+  // An input implied by the others is dropped. Since the inputs of a gate
+  // have smaller variables than its output, dropping inputs from the largest
+  // variable down ensures that the remaining inputs imply the dropped ones.
+  std::unordered_set<SatLiteral, SatLiteralHashFunction> inputs(lits.begin(),
+                                                                lits.end());
+  for (size_t i = lits.size(); i > 0; --i)
+  {
+    SatLiteral lit = lits[i - 1];
+    auto it = d_andGateInputs.find(lit);
+    if (it != d_andGateInputs.end())
+    {
+      // lit = (c_1 & ... & c_k), which is false if some ~c_i is an input, and
+      // implied if all c_i are
+      bool implied = true;
+      for (const SatLiteral& c : (*it).second)
+      {
+        if (inputs.find(~c) != inputs.end())
+        {
+          return mapToLiteral(node, negated ? ~falseLit : falseLit);
+        }
+        implied = implied && inputs.find(c) != inputs.end();
+      }
+      if (implied)
+      {
+        inputs.erase(lit);
+      }
+      continue;
+    }
+    it = d_andGateInputs.find(~lit);
+    if (it != d_andGateInputs.end())
+    {
+      // lit = ~(c_1 & ... & c_k), which is implied if some ~c_i is an input,
+      // and false if all c_i are
+      bool implied = false;
+      bool conflict = true;
+      for (const SatLiteral& c : (*it).second)
+      {
+        implied = implied || inputs.find(~c) != inputs.end();
+        conflict = conflict && inputs.find(c) != inputs.end();
+      }
+      if (conflict)
+      {
+        return mapToLiteral(node, negated ? ~falseLit : falseLit);
+      }
+      if (implied)
+      {
+        inputs.erase(lit);
+      }
+    }
+  }
+  if (inputs.size() < lits.size())
+  {
+    j = 0;
+    for (size_t i = 0, size = lits.size(); i < size; ++i)
+    {
+      if (inputs.find(lits[i]) != inputs.end())
+      {
+        lits[j++] = lits[i];
+      }
+    }
+    lits.resize(j);
+  }
+  if (lits.empty())
+  {
+    return mapToLiteral(node, negated ? falseLit : ~falseLit);
+  }
+  if (lits.size() == 1)
+  {
+    return mapToLiteral(node, negated ? ~lits[0] : lits[0]);
+  }
+  // Structural hashing
+  GateKey key{kind::AND, lits};
+  auto it = d_gates.find(key);
+  if (it != d_gates.end())
+  {
+    SatLiteral gate = (*it).second;
+    return mapToLiteral(node, negated ? ~gate : gate);
+  }
+  SatLiteral nodeLit = newLiteral(node);
+  SatLiteral gate = negated ? ~nodeLit : nodeLit;
+  Node gnode = negated ? node.negate() : Node(node);
+  // gate <-> (l_1 & ... & l_n)
+  SatClause clause(lits.size() + 1);
+  for (size_t i = 0, size = lits.size(); i < size; ++i)
+  {
+    assertClause(gnode.negate(), ~gate, lits[i]);
+    clause[i] = ~lits[i];
+  }
+  clause[lits.size()] = gate;
+  assertClause(gnode, clause);
+  d_gates.insert(key, gate);
+  d_andGateInputs.insert(gate, lits);
+  return nodeLit;
+}
+
+SatLiteral CnfStream::mkXorGate(TNode node,
+                                SatLiteral a,
+                                SatLiteral b,
+                                bool negated)
+{
+  SatLiteral trueLit = SatLiteral(d_satSolver->trueVar());
+  // Normalize the inputs to positive literals, keeping track of the parity
+  bool parity = negated;
+  if (a.isNegated())
+  {
+    a = ~a;
+    parity = !parity;
+  }
+  if (b.isNegated())
+  {
+    b = ~b;
+    parity = !parity;
+  }
+  // Constant propagation
+  if (isTrueLiteral(a) || isFalseLiteral(a))
+  {
+    return mapToLiteral(node, (parity != isTrueLiteral(a)) ? ~b : b);
+  }
+  if (isTrueLiteral(b) || isFalseLiteral(b))
+  {
+    return mapToLiteral(node, (parity != isTrueLiteral(b)) ? ~a : a);
+  }
+  if (a == b)
+  {
+    return mapToLiteral(node, parity ? trueLit : ~trueLit);
+  }
+  if (b < a)
+  {
+    std::swap(a, b);
+  }
+  // Structural hashing
+  GateKey key{kind::XOR, {a, b}};
+  auto it = d_gates.find(key);
+  if (it != d_gates.end())
+  {
+    SatLiteral gate = (*it).second;
+    return mapToLiteral(node, parity ? ~gate : gate);
+  }
+  SatLiteral nodeLit = newLiteral(node);
+  SatLiteral gate = parity ? ~nodeLit : nodeLit;
+  Node gnode = parity ? node.negate() : Node(node);
+  // gate <-> (a xor b)
+  assertClause(gnode.negate(), a, b, ~gate);
+  assertClause(gnode.negate(), ~a, ~b, ~gate);
+  assertClause(gnode, a, ~b, gate);
+  assertClause(gnode, ~a, b, gate);
+  d_gates.insert(key, gate);
+  return nodeLit;
+}
+
+SatLiteral CnfStream::mkIteGate(TNode node,
+                                SatLiteral c,
+                                SatLiteral t,
+                                SatLiteral e)
+{
+  // Constant propagation and equal inputs, which reduce the ITE to a single
+  // literal or to an AND or XOR gate
+  if (isTrueLiteral(c) || t == e)
+  {
+    return mapToLiteral(node, t);
+  }
+  if (isFalseLiteral(c))
+  {
+    return mapToLiteral(node, e);
+  }
+  if (t == ~e)
+  {
+    // (ite c t ~t) is (c <-> t)
+    return mkXorGate(node, c, t, true);
+  }
+  if (isTrueLiteral(t) || c == t)
+  {
+    // (c | e)
+    std::vector<SatLiteral> lits{~c, ~e};
+    return mkAndGate(node, lits, true);
+  }
+  if (isFalseLiteral(t) || c == ~t)
+  {
+    // (~c & e)
+    std::vector<SatLiteral> lits{~c, e};
+    return mkAndGate(node, lits, false);
+  }
+  if (isTrueLiteral(e) || c == ~e)
+  {
+    // (~c | t)
+    std::vector<SatLiteral> lits{c, ~t};
+    return mkAndGate(node, lits, true);
+  }
+  if (isFalseLiteral(e) || c == e)
+  {
+    // (c & t)
+    std::vector<SatLiteral> lits{c, t};
+    return mkAndGate(node, lits, false);
+  }
+  // Normalize the condition and the then branch to positive literals
+  if (c.isNegated())
+  {
+    c = ~c;
+    std::swap(t, e);
+  }
+  bool parity = false;
+  if (t.isNegated())
+  {
+    t = ~t;
+    e = ~e;
+    parity = true;
+  }
+  // Structural hashing
+  GateKey key{kind::ITE, {c, t, e}};
+  auto it = d_gates.find(key);
+  if (it != d_gates.end())
+  {
+    SatLiteral gate = (*it).second;
+    return mapToLiteral(node, parity ? ~gate : gate);
+  }
+  SatLiteral nodeLit = newLiteral(node);
+  SatLiteral gate = parity ? ~nodeLit : nodeLit;
+  Node gnode = parity ? node.negate() : Node(node);
+  // gate <-> (ite c t e), see handleIte()
+  assertClause(gnode.negate(), ~gate, t, e);
+  assertClause(gnode.negate(), ~gate, ~c, t);
+  assertClause(gnode.negate(), ~gate, c, e);
+  assertClause(gnode, gate, ~t, ~e);
+  assertClause(gnode, gate, ~c, ~t);
+  assertClause(gnode, gate, c, ~e);
+  d_gates.insert(key, gate);
+  return nodeLit;
+}
+
+SatLiteral CnfStream::toCNF(TNode node, bool negated, uint8_t pol)
 {
   Trace("cnf") << "toCNF(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   SatLiteral nodeLit;
-  Node negatedNode = node.notNode();
+
+  if (!d_pgEncoding)
+  {
+    pol = s_polBoth;
+  }
+  else if (node.getKind() == kind::NOT)
+  {
+    // The literal of the negation is cached with the literal of node[0], so
+    // we look through the negation to complete the definition of node[0]
+    return toCNF(node[0], !negated, flipPolarity(pol));
+  }
 
   // If the non-negated node has already been translated, get the translation
   if(hasLiteral(node)) {
     Trace("cnf") << "toCNF(): already translated\n";
-    nodeLit = getLiteral(node);
+    nodeLit = d_pgEncoding ? completeDefinition(node, pol) : getLiteral(node);
     // Return the (maybe negated) literal
     return !negated ? nodeLit : ~nodeLit;
   }
@@ -539,14 +1012,14 @@ SatLiteral CnfStream::toCNF(TNode node, bool negated)
   switch (node.getKind())
   {
     case kind::NOT: nodeLit = ~toCNF(node[0]); break;
-    case kind::XOR: nodeLit = handleXor(node); break;
-    case kind::ITE: nodeLit = handleIte(node); break;
-    case kind::IMPLIES: nodeLit = handleImplies(node); break;
-    case kind::OR: nodeLit = handleOr(node); break;
-    case kind::AND: nodeLit = handleAnd(node); break;
+    case kind::XOR: nodeLit = handleXor(node, pol); break;
+    case kind::ITE: nodeLit = handleIte(node, pol); break;
+    case kind::IMPLIES: nodeLit = handleImplies(node, pol); break;
+    case kind::OR: nodeLit = handleOr(node, pol); break;
+    case kind::AND: nodeLit = handleAnd(node, pol); break;
     case kind::EQUAL:
-      nodeLit =
-          node[0].getType().isBoolean() ? handleIff(node) : convertAtom(node);
+      nodeLit = node[0].getType().isBoolean() ? handleIff(node, pol)
+                                              : convertAtom(node);
       break;
     default:
     {
@@ -578,7 +1051,7 @@ void CnfStream::convertAndAssertAnd(TNode node, bool negated)
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, true);
+      clause[i] = toCNF(*disjunct, true, s_polNeg);
     }
     Assert(disjunct == node.end());
     assertClause(node.negate(), clause);
@@ -597,7 +1070,7 @@ void CnfStream::convertAndAssertOr(TNode node, bool negated)
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, false);
+      clause[i] = toCNF(*disjunct, false, s_polPos);
     }
     Assert(disjunct == node.end());
     assertClause(node, clause);
@@ -685,8 +1158,8 @@ void CnfStream::convertAndAssertImplies(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
     // p => q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], false, s_polNeg);
+    SatLiteral q = toCNF(node[1], false, s_polPos);
     // Construct the clause ~p || q
     SatClause clause(2);
     clause[0] = ~p;
@@ -706,8 +1179,8 @@ void CnfStream::convertAndAssertIte(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   // ITE(p, q, r)
   SatLiteral p = toCNF(node[0], false);
-  SatLiteral q = toCNF(node[1], negated);
-  SatLiteral r = toCNF(node[2], negated);
+  SatLiteral q = toCNF(node[1], negated, negated ? s_polNeg : s_polPos);
+  SatLiteral r = toCNF(node[2], negated, negated ? s_polNeg : s_polPos);
   // Construct the clauses:
   // (p => q) and (!p => r)
   //
@@ -781,7 +1254,8 @@ void CnfStream::convertAndAssert(TNode node, bool negated)
         nnode = node.negate();
       }
       // Atoms
-      assertClause(nnode, toCNF(node, negated));
+      assertClause(nnode,
+                   toCNF(node, negated, negated ? s_polNeg : s_polPos));
   }
     break;
   }
@@ -25,6 +25,7 @@
 #ifndef CVC4__PROP__CNF_STREAM_H
 #define CVC4__PROP__CNF_STREAM_H
 
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
@@ -135,6 +136,14 @@ class CnfStream {
    */
   void ensureLiteral(TNode n);
 
+  /**
+   * Map the Boolean formula n, which must not have a literal, to a new
+   * literal whose definition in terms of the literals of the children of n is
+   * added to the SAT solver by the caller. This is for clients that do the
+   * Tseitin conversion of formulas themselves.
+   */
+  SatLiteral newDefinedLiteral(TNode n);
+
   /**
    * Returns the literal that represents the given node in the SAT CNF
    * representation.
@@ -166,7 +175,57 @@ class CnfStream {
 
   void setProof(CnfProof* proof);
 
+  /**
+   * Enable gate simplification for the formulas converted from now on. When
+   * enabled, the AND, OR, IMPLIES, XOR, equivalence and ITE gates introduced
+   * by toCNF() are simplified on the level of their literals before they are
+   * encoded: constant literals are propagated, duplicate and complementary
+   * literals are detected, AND gates are minimized using the AND gates of
+   * their children (two-level rules), and gates with the same (normalized)
+   * inputs share a single literal (structural hashing, where OR and IMPLIES
+   * are AND gates with negated inputs and output, and equivalences are
+   * negated XOR gates). A node whose gate simplifies to an existing literal
+   * is mapped to that literal instead of getting a new one.
+   *
+   * This must not be enabled when the clauses are tracked for proofs or unsat
+   * cores, nor with FormulaLitPolicy::TRACK_AND_NOTIFY.
+   */
+  void enableGateSimplification();
+
+  /**
+   * Enable the polarity-aware (Plaisted-Greenbaum) encoding for the formulas
+   * converted from now on. When enabled, the literal of a formula is only
+   * defined in the directions required by the polarities with which the
+   * formula occurs: lit -> f if f occurs positively, and f -> lit if it
+   * occurs negatively. The polarities are propagated down the formula by
+   * toCNF(). When a formula is reached again with a polarity whose direction
+   * was not encoded yet, e.g. in a later assertion or lemma, the missing
+   * clauses are added then. Formulas given to ensureLiteral() are always
+   * encoded in both directions.
+   *
+   * Since the literals of formulas are then not necessarily equivalent to
+   * them, this must not be enabled with a decision strategy that looks at
+   * their values, with FormulaLitPolicy::TRACK_AND_NOTIFY, or together with
+   * gate simplification.
+   */
+  void enablePolarityEncoding();
+
  protected:
+  /**
+   * The directions of the definition of the literal lit of a formula f:
+   * s_polPos is lit -> f, which is needed if f occurs positively, s_polNeg is
+   * f -> lit, which is needed if f occurs negatively.
+   */
+  static constexpr uint8_t s_polPos = 1;
+  static constexpr uint8_t s_polNeg = 2;
+  static constexpr uint8_t s_polBoth = s_polPos | s_polNeg;
+  /** The polarity of the children of a negation */
+  static uint8_t flipPolarity(uint8_t pol)
+  {
+    return ((pol & s_polPos) ? s_polNeg : 0)
+           | ((pol & s_polNeg) ? s_polPos : 0);
+  }
+
   /**
    * Same as above, except that uses the saved d_removable flag. It calls the
    * dedicated converter for the possible formula kinds.
@@ -190,20 +249,63 @@ class CnfStream {
    *
    * @param node the formula to transform
    * @param negated whether the literal is negated
+   * @param pol the polarity with which node occurs, which is only used with
+   * the polarity-aware encoding (see enablePolarityEncoding())
    * @return the literal representing the root of the formula
    */
-  SatLiteral toCNF(TNode node, bool negated = false);
+  SatLiteral toCNF(TNode node,
+                   bool negated = false,
+                   uint8_t pol = s_polBoth);
 
   /** Specific clausifiers, based on the formula kinds, that clausify a formula,
    * by calling toCNF into each of the formula's children under the respective
-   * kind, and introduce a literal definitionally equal to it. */
+   * kind, and introduce a literal definitionally equal to it. With the
+   * polarity-aware encoding, only the directions of the definition in pol
+   * are encoded, and the literal of node may already exist. */
   SatLiteral handleNot(TNode node);
-  SatLiteral handleXor(TNode node);
-  SatLiteral handleImplies(TNode node);
-  SatLiteral handleIff(TNode node);
-  SatLiteral handleIte(TNode node);
-  SatLiteral handleAnd(TNode node);
-  SatLiteral handleOr(TNode node);
+  SatLiteral handleXor(TNode node, uint8_t pol = s_polBoth);
+  SatLiteral handleImplies(TNode node, uint8_t pol = s_polBoth);
+  SatLiteral handleIff(TNode node, uint8_t pol = s_polBoth);
+  SatLiteral handleIte(TNode node, uint8_t pol = s_polBoth);
+  SatLiteral handleAnd(TNode node, uint8_t pol = s_polBoth);
+  SatLiteral handleOr(TNode node, uint8_t pol = s_polBoth);
+
+  /** Get the literal of node, or a new one if it does not have one */
+  SatLiteral getOrNewLiteral(TNode node);
+  /**
+   * The directions in pol of the definition of the literal of the formula
+   * node that are not encoded yet.
+   */
+  uint8_t getMissingPolarity(TNode node, uint8_t pol) const;
+  /** Record that the directions pol of the definition of node are encoded */
+  void addDefinedPolarity(TNode node, uint8_t pol);
+  /**
+   * Encode the directions in pol of the definition of the literal of node
+   * that are missing, and return that literal.
+   */
+  SatLiteral completeDefinition(TNode node, uint8_t pol);
+
+  /**
+   * Gate simplification versions of the clausifiers above, see
+   * enableGateSimplification(). Each returns the literal of node, where node
+   * is equivalent to the gate if negated is false, and to its negation
+   * otherwise.
+   *
+   * mkAndGate is for the conjunction of lits, which it modifies.
+   */
+  SatLiteral mkAndGate(TNode node, std::vector<SatLiteral>& lits, bool negated);
+  /** mkXorGate is for the exclusive or of a and b. */
+  SatLiteral mkXorGate(TNode node, SatLiteral a, SatLiteral b, bool negated);
+  /** mkIteGate is for the if-then-else of c, t and e. */
+  SatLiteral mkIteGate(TNode node, SatLiteral c, SatLiteral t, SatLiteral e);
+  /**
+   * Map node to the existing literal lit, which is equivalent to it, and
+   * return lit.
+   */
+  SatLiteral mapToLiteral(TNode node, SatLiteral lit);
+  /** Whether lit is the literal of true (resp. false) */
+  bool isTrueLiteral(SatLiteral lit);
+  bool isFalseLiteral(SatLiteral lit);
 
   /** Stores the literal of the given node in d_literalToNodeMap.
    *
@@ -315,6 +417,39 @@ class CnfStream {
 
   /** Pointer to resource manager for associated SmtEngine */
   ResourceManager* d_resourceManager;
+
+  /** The key of a gate in the structural hash table */
+  struct GateKey
+  {
+    /** The kind of the gate (AND, XOR or ITE) */
+    Kind d_kind;
+    /** The normalized input literals */
+    std::vector<SatLiteral> d_inputs;
+    bool operator==(const GateKey& k) const
+    {
+      return d_kind == k.d_kind && d_inputs == k.d_inputs;
+    }
+  };
+  struct GateKeyHashFunction
+  {
+    size_t operator()(const GateKey& k) const;
+  };
+  /** Whether gate simplification is enabled */
+  bool d_gateSimp;
+  /** Whether the polarity-aware encoding is enabled */
+  bool d_pgEncoding;
+  /**
+   * The encoded directions of the definitions of formulas, for formulas
+   * converted with the polarity-aware encoding.
+   */
+  context::CDHashMap<Node, uint8_t, NodeHashFunction> d_definedPolarity;
+  /** The structural hash table, mapping gates to their output literal */
+  context::CDInsertHashMap<GateKey, SatLiteral, GateKeyHashFunction> d_gates;
+  /** Maps the output literals of AND gates to their inputs */
+  context::CDInsertHashMap<SatLiteral,
+                           std::vector<SatLiteral>,
+                           SatLiteralHashFunction>
+      d_andGateInputs;
 }; /* class CnfStream */
 
 }  // namespace prop
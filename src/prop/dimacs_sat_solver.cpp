@@ -0,0 +1,335 @@
+/*********************                                                        */
+/*! \file dimacs_sat_solver.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A SAT solver wrapper that exports the clauses in DIMACS format
+ **
+ ** A SAT solver wrapper that exports the clauses in DIMACS format, and may
+ ** take the model from the output of an external SAT solver.
+ **/
+
+#include "prop/dimacs_sat_solver.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "base/check.h"
+#include "base/exception.h"
+#include "base/output.h"
+#include "prop/cnf_stream.h"
+
+namespace cvc5 {
+namespace prop {
+
+namespace {
+
+/** The DIMACS literal of l */
+int64_t toDimacs(SatLiteral l)
+{
+  int64_t v = static_cast<int64_t>(l.getSatVariable()) + 1;
+  return l.isNegated() ? -v : v;
+}
+
+}  // namespace
+
+DimacsSatSolver::DimacsSatSolver(SatSolver* solver,
+                                 const std::string& exportFile,
+                                 const std::string& importFile)
+    : d_solver(solver),
+      d_exportFile(exportFile),
+      d_importFile(importFile),
+      d_cnf(nullptr),
+      d_numVars(0),
+      d_true(undefSatVariable),
+      d_false(undefSatVariable),
+      d_hasModel(false)
+{
+  Assert(d_solver != nullptr);
+}
+
+DimacsSatSolver::~DimacsSatSolver() {}
+
+void DimacsSatSolver::recordVar(SatVariable v)
+{
+  d_numVars = std::max(d_numVars, v + 1);
+}
+
+ClauseId DimacsSatSolver::addClause(SatClause& clause, bool removable)
+{
+  for (const SatLiteral& l : clause)
+  {
+    recordVar(l.getSatVariable());
+  }
+  d_clauses.push_back(clause);
+  return d_solver->addClause(clause, removable);
+}
+
+ClauseId DimacsSatSolver::addXorClause(SatClause& clause,
+                                       bool rhs,
+                                       bool removable)
+{
+  // xor clauses are only added to solvers with native xor reasoning
+  Unreachable() << "DimacsSatSolver does not support xor clauses";
+  return ClauseIdError;
+}
+
+SatVariable DimacsSatSolver::newVar(bool isTheoryAtom,
+                                    bool preRegister,
+                                    bool canErase)
+{
+  // variables in the exported file must not be eliminated
+  SatVariable v = d_solver->newVar(isTheoryAtom, preRegister, false);
+  recordVar(v);
+  return v;
+}
+
+SatVariable DimacsSatSolver::trueVar()
+{
+  if (d_true == undefSatVariable)
+  {
+    // the wrapped solver asserts the constant internally
+    d_true = d_solver->trueVar();
+    recordVar(d_true);
+    d_clauses.push_back(SatClause{SatLiteral(d_true)});
+  }
+  return d_true;
+}
+
+SatVariable DimacsSatSolver::falseVar()
+{
+  if (d_false == undefSatVariable)
+  {
+    d_false = d_solver->falseVar();
+    recordVar(d_false);
+    d_clauses.push_back(SatClause{SatLiteral(d_false, true)});
+  }
+  return d_false;
+}
+
+SatValue DimacsSatSolver::solve() { return solve(std::vector<SatLiteral>()); }
+
+SatValue DimacsSatSolver::solve(long unsigned int& resource)
+{
+  if (d_exportFile.empty() && d_importFile.empty())
+  {
+    return d_solver->solve(resource);
+  }
+  return solve(std::vector<SatLiteral>());
+}
+
+SatValue DimacsSatSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  d_assumptions = assumptions;
+  d_hasModel = false;
+  if (!d_exportFile.empty())
+  {
+    exportDimacs(assumptions);
+  }
+  if (!d_importFile.empty())
+  {
+    return importModel(assumptions);
+  }
+  return assumptions.empty() ? d_solver->solve()
+                             : d_solver->solve(assumptions);
+}
+
+void DimacsSatSolver::exportDimacs(const std::vector<SatLiteral>& assumptions)
+{
+  std::ofstream out(d_exportFile);
+  if (!out)
+  {
+    throw Exception("cannot open DIMACS export file " + d_exportFile);
+  }
+  if (d_cnf != nullptr)
+  {
+    // name the variables of the atoms, in the order of the variables
+    std::vector<std::pair<SatVariable, TNode>> names;
+    for (const auto& ln : d_cnf->getNodeCache())
+    {
+      if (!ln.first.isNegated())
+      {
+        names.emplace_back(ln.first.getSatVariable(), ln.second);
+      }
+    }
+    std::sort(names.begin(),
+              names.end(),
+              [](const std::pair<SatVariable, TNode>& a,
+                 const std::pair<SatVariable, TNode>& b) {
+                return a.first < b.first;
+              });
+    for (const std::pair<SatVariable, TNode>& n : names)
+    {
+      out << "c " << (n.first + 1) << " " << n.second << "\n";
+    }
+  }
+  for (const SatLiteral& l : assumptions)
+  {
+    recordVar(l.getSatVariable());
+  }
+  out << "p cnf " << d_numVars << " " << (d_clauses.size() + assumptions.size())
+      << "\n";
+  for (const SatClause& c : d_clauses)
+  {
+    for (const SatLiteral& l : c)
+    {
+      out << toDimacs(l) << " ";
+    }
+    out << "0\n";
+  }
+  for (const SatLiteral& l : assumptions)
+  {
+    out << toDimacs(l) << " 0\n";
+  }
+  if (!out)
+  {
+    throw Exception("cannot write DIMACS export file " + d_exportFile);
+  }
+}
+
+SatValue DimacsSatSolver::importModel(
+    const std::vector<SatLiteral>& assumptions)
+{
+  std::ifstream in(d_importFile);
+  if (!in)
+  {
+    throw Exception("cannot open SAT model file " + d_importFile);
+  }
+  SatValue result = SAT_VALUE_UNKNOWN;
+  d_model.assign(d_numVars, false);
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::istringstream tokens(line);
+    std::string token;
+    if (!(tokens >> token) || token == "c")
+    {
+      continue;
+    }
+    if (token == "s")
+    {
+      tokens >> token;
+    }
+    if (token == "SATISFIABLE" || token == "SAT")
+    {
+      result = SAT_VALUE_TRUE;
+      continue;
+    }
+    if (token == "UNSATISFIABLE" || token == "UNSAT")
+    {
+      result = SAT_VALUE_FALSE;
+      continue;
+    }
+    if (token == "UNKNOWN" || token == "INDETERMINATE")
+    {
+      continue;
+    }
+    // the literals of the model, with or without the "v" prefix
+    if (token != "v")
+    {
+      tokens.clear();
+      tokens.seekg(0);
+    }
+    int64_t lit;
+    while (tokens >> lit)
+    {
+      uint64_t v = static_cast<uint64_t>(lit < 0 ? -lit : lit);
+      if (v > 0 && v <= d_numVars)
+      {
+        d_model[v - 1] = lit > 0;
+      }
+    }
+    if (!tokens.eof())
+    {
+      throw Exception("unexpected line in SAT model file " + d_importFile
+                      + ": " + line);
+    }
+  }
+  if (result == SAT_VALUE_FALSE)
+  {
+    // the external solver gives no proof that could be checked
+    Warning() << "the unsatisfiability read from " << d_importFile
+              << " is not verified" << std::endl;
+  }
+  if (result != SAT_VALUE_TRUE)
+  {
+    return result;
+  }
+  // the model must satisfy the clauses and assumptions of this solver
+  for (const SatClause& c : d_clauses)
+  {
+    if (std::none_of(c.begin(), c.end(), [this](const SatLiteral& l) {
+          return isTrueInModel(l);
+        }))
+    {
+      throw Exception("the model of " + d_importFile
+                      + " does not satisfy the clauses of the problem");
+    }
+  }
+  for (const SatLiteral& l : assumptions)
+  {
+    if (!isTrueInModel(l))
+    {
+      throw Exception("the model of " + d_importFile
+                      + " does not satisfy the assumptions of the problem");
+    }
+  }
+  d_hasModel = true;
+  return SAT_VALUE_TRUE;
+}
+
+bool DimacsSatSolver::isTrueInModel(SatLiteral l) const
+{
+  Assert(l.getSatVariable() < d_model.size());
+  return d_model[l.getSatVariable()] != l.isNegated();
+}
+
+void DimacsSatSolver::interrupt() { d_solver->interrupt(); }
+
+SatValue DimacsSatSolver::value(SatLiteral l)
+{
+  if (d_hasModel)
+  {
+    return isTrueInModel(l) ? SAT_VALUE_TRUE : SAT_VALUE_FALSE;
+  }
+  return d_solver->value(l);
+}
+
+SatValue DimacsSatSolver::modelValue(SatLiteral l)
+{
+  if (d_hasModel)
+  {
+    return isTrueInModel(l) ? SAT_VALUE_TRUE : SAT_VALUE_FALSE;
+  }
+  return d_solver->modelValue(l);
+}
+
+unsigned DimacsSatSolver::getAssertionLevel() const
+{
+  return d_solver->getAssertionLevel();
+}
+
+bool DimacsSatSolver::ok() const { return d_solver->ok(); }
+
+void DimacsSatSolver::getUnsatAssumptions(
+    std::vector<SatLiteral>& assumptions)
+{
+  if (d_importFile.empty())
+  {
+    d_solver->getUnsatAssumptions(assumptions);
+    return;
+  }
+  // the external solver gives no core, all assumptions are taken
+  assumptions.insert(
+      assumptions.end(), d_assumptions.begin(), d_assumptions.end());
+}
+
+}  // namespace prop
+}  // namespace cvc5
@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file dimacs_sat_solver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A SAT solver wrapper that exports the clauses in DIMACS format
+ **
+ ** A SAT solver wrapper that exports the clauses in DIMACS format, and may
+ ** take the model from the output of an external SAT solver.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROP__DIMACS_SAT_SOLVER_H
+#define CVC4__PROP__DIMACS_SAT_SOLVER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "prop/sat_solver.h"
+
+namespace cvc5 {
+namespace prop {
+
+class CnfStream;
+
+/**
+ * A SAT solver that forwards the clauses to another one and records them.
+ *
+ * If an export file is given, each call to solve writes the recorded clauses
+ * and the assumptions, as unit clauses, to that file in DIMACS format. The
+ * DIMACS variable of SAT variable v is v + 1. If the CNF stream is set, the
+ * file starts with comments "c <var> <node>" that map the variables of the
+ * atoms to the nodes they stand for.
+ *
+ * If an import file is given, solve does not call the SAT solver, but reads
+ * the output of an external SAT solver on the exported file, in the format
+ * of the SAT competition ("s SATISFIABLE" and "v <lits> 0" lines), whose
+ * model is then returned by value and modelValue. The model is checked
+ * against the recorded clauses and the assumptions, since the variables of
+ * the exported file only match the ones of this solver if the formulas are
+ * converted in the same way. An unsatisfiable result cannot be checked and is
+ * trusted, with a warning.
+ */
+class DimacsSatSolver : public SatSolver
+{
+ public:
+  /**
+   * Construct a wrapper of solver, which it deletes on destruction. Either
+   * file name may be empty.
+   */
+  DimacsSatSolver(SatSolver* solver,
+                  const std::string& exportFile,
+                  const std::string& importFile);
+  ~DimacsSatSolver() override;
+
+  /** Set the CNF stream whose atoms are named in the exported file */
+  void setCnfStream(CnfStream* cnf) { d_cnf = cnf; }
+
+  ClauseId addClause(SatClause& clause, bool removable) override;
+
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
+
+  SatVariable newVar(bool isTheoryAtom,
+                     bool preRegister,
+                     bool canErase) override;
+
+  SatVariable trueVar() override;
+  SatVariable falseVar() override;
+
+  SatValue solve() override;
+  SatValue solve(long unsigned int&) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+
+  void interrupt() override;
+
+  SatValue value(SatLiteral l) override;
+
+  SatValue modelValue(SatLiteral l) override;
+
+  unsigned getAssertionLevel() const override;
+
+  bool ok() const override;
+
+  void getUnsatAssumptions(std::vector<SatLiteral>& assumptions) override;
+
+ private:
+  /** Record variable v, whose DIMACS variable must be in the header */
+  void recordVar(SatVariable v);
+  /** Write the recorded clauses and the assumptions to d_exportFile */
+  void exportDimacs(const std::vector<SatLiteral>& assumptions);
+  /**
+   * Read the result and model of the external SAT solver from d_importFile,
+   * and check that the model satisfies the clauses and the assumptions.
+   */
+  SatValue importModel(const std::vector<SatLiteral>& assumptions);
+  /** Whether literal l is true in the imported model */
+  bool isTrueInModel(SatLiteral l) const;
+  /** The wrapped SAT solver */
+  std::unique_ptr<SatSolver> d_solver;
+  /** The name of the file to export to, or empty */
+  std::string d_exportFile;
+  /** The name of the file to import the model from, or empty */
+  std::string d_importFile;
+  /** The CNF stream naming the atoms, if any */
+  CnfStream* d_cnf;
+  /** The recorded clauses */
+  std::vector<SatClause> d_clauses;
+  /** The number of variables, i.e. the largest DIMACS variable */
+  SatVariable d_numVars;
+  /** The variables of the constants, or undefSatVariable */
+  SatVariable d_true;
+  SatVariable d_false;
+  /** The assumptions of the last call to solve */
+  std::vector<SatLiteral> d_assumptions;
+  /** Whether an imported model is to be used by value and modelValue */
+  bool d_hasModel;
+  /** The values of the variables in the imported model */
+  std::vector<bool> d_model;
+};
+
+}  // namespace prop
+}  // namespace cvc5
+
+#endif  // CVC4__PROP__DIMACS_SAT_SOLVER_H
@@ -22,6 +22,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
 #include <unordered_set>
 
@@ -202,7 +203,12 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      inprocessings(0),
+      vivified_clauses(0),
+      vivified_literals(0),
+      subsumed_clauses(0),
+      theory_lemmas(0)
 
       ,
       ok(true),
@@ -210,11 +216,21 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       var_inc(1),
       watches(WatcherDeleted(ca)),
       qhead(0),
+      card_qhead(0),
       simpDB_assigns(-1),
       simpDB_props(0),
       order_heap(VarOrderLt(activity)),
       progress_estimate(0),
-      remove_satisfied(!enableIncremental)
+      remove_satisfied(!enableIncremental),
+      probing(false),
+      next_inprocess(options::satInprocessInterval()),
+      inprocess_props(0),
+      record_restarts(false),
+      restart_start_conflicts(0),
+      restart_start_propagations(0),
+      restart_start_lemmas(0),
+      restart_theory_time(0),
+      lbd_counter(0)
 
       // Resource constraints:
       //
@@ -348,16 +364,24 @@ CRef Solver::reason(Var x) {
   // What's the literal we are trying to explain
   Lit l = mkLit(x, value(x) != l_True);
 
-  // Get the explanation from the theory
-  SatClause explanation_cl;
-  // FIXME: at some point return a tag with the theory that spawned you
-  d_proxy->explainPropagation(MinisatSatSolver::toSatLiteral(l),
-                              explanation_cl);
+  // Get the explanation from the cardinality constraint or the theory
   vec<Lit> explanation;
-  MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
+  bool fromCard = x < (int)card_reason.size() && card_reason[x] >= 0;
+  if (fromCard)
+  {
+    explainCard(x, explanation);
+  }
+  else
+  {
+    SatClause explanation_cl;
+    // FIXME: at some point return a tag with the theory that spawned you
+    d_proxy->explainPropagation(MinisatSatSolver::toSatLiteral(l),
+                                explanation_cl);
+    MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
 
-  Trace("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
-                   << std::endl;
+    Trace("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
+                     << std::endl;
+  }
 
   // Sort the literals by trail index level
   lemma_lt lt(*this);
@@ -428,7 +452,7 @@ CRef Solver::reason(Var x) {
     // came from (ie. the theory/sharing)
     Trace("pf::sat") << "Minisat::Solver registering a THEORY_LEMMA (1)"
                      << std::endl;
-    if (options::unsatCores() && !isProofEnabled())
+    if (options::unsatCores() && !isProofEnabled() && !fromCard)
     {
       ClauseId id = ProofManager::getSatProof()->registerClause(real_reason,
                                                                 THEORY_LEMMA);
@@ -513,6 +537,11 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
       Trace("pf::sat") << std::endl;
 
       lemmas.push();
+      if (lemmas_buffers.size() > 0)
+      {
+        lemmas_buffers.last().moveTo(lemmas.last());
+        lemmas_buffers.pop();
+      }
       ps.copyTo(lemmas.last());
       lemmas_removable.push(removable);
       if (options::unsatCores() && !isProofEnabled())
@@ -794,9 +823,16 @@ void Solver::cancelUntil(int level) {
         }
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
+            if (c < card_qhead && toInt(trail[c]) < (int)card_watches.size()){
+                // Uncount the literal in the cardinality constraints
+                for (const CardWatch& w : card_watches[toInt(trail[c])])
+                    cards[w.cons].sum -= w.weight;
+            }
+            if (x < (int)card_reason.size())
+                card_reason[x] = -1;
             assigns [x] = l_Undef;
             vardata[x].d_trail_index = -1;
-            if ((phase_saving > 1 ||
+            if (!probing && (phase_saving > 1 ||
                  ((phase_saving == 1) && c > trail_lim.last())
                  ) && ((polarity[x] & 0x2) == 0)) {
               polarity[x] = sign(trail[c]);
@@ -804,6 +840,7 @@ void Solver::cancelUntil(int level) {
             insertVarOrder(x);
         }
         qhead = trail_lim[level];
+        card_qhead = std::min(card_qhead, qhead);
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
         flipped.shrink(flipped.size() - level);
@@ -1239,6 +1276,79 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels)
 |    Calculates the (possibly empty) set of assumptions that led to the assignment of 'p', and
 |    stores the result in 'out_conflict'.
 |________________________________________________________________________________________________@*/
+int Solver::computeLbd(const vec<Lit>& c)
+{
+  // stamp the levels of the literals, so that each level is counted once
+  lbd_stamp.growTo(decisionLevel() + 1, 0);
+  lbd_counter++;
+  int lbd = 0;
+  for (int i = 0; i < c.size(); i++)
+  {
+    int l = level(var(c[i]));
+    if (lbd_stamp[l] != lbd_counter)
+    {
+      lbd_stamp[l] = lbd_counter;
+      lbd++;
+    }
+  }
+  return lbd;
+}
+
+void Solver::startRestartInterval()
+{
+  restart_start_time = std::chrono::steady_clock::now();
+  restart_start_conflicts = conflicts;
+  restart_start_propagations = propagations;
+  restart_start_lemmas = theory_lemmas;
+  restart_theory_time = std::chrono::steady_clock::duration::zero();
+}
+
+void Solver::recordRestart()
+{
+  Assert(search_stats.restart_conflict_rate != nullptr);
+  std::chrono::steady_clock::duration elapsed =
+      std::chrono::steady_clock::now() - restart_start_time;
+  double secs = std::chrono::duration<double>(elapsed).count();
+  if (secs <= 0)
+  {
+    secs = 1e-9;
+  }
+  *search_stats.restart_conflict_rate
+      << (conflicts - restart_start_conflicts) / secs;
+  *search_stats.restart_propagation_rate
+      << (propagations - restart_start_propagations) / secs;
+  *search_stats.restart_trail << static_cast<uint64_t>(trail.size());
+  *search_stats.restart_theory_share
+      << std::chrono::duration<double>(restart_theory_time).count() / secs;
+  *search_stats.restart_lemmas << (theory_lemmas - restart_start_lemmas);
+  startRestartInterval();
+}
+
+void Solver::getLearnts(vec<vec<Lit> >& out, int max_size, int max_lbd) const
+{
+  // the units are the literals assigned at level 0
+  int units_end = decisionLevel() == 0 ? trail.size() : trail_lim[0];
+  for (int i = 0; i < units_end; i++)
+  {
+    out.push();
+    out.last().push(trail[i]);
+  }
+  for (int i = 0; i < clauses_removable.size(); i++)
+  {
+    const Clause& c = ca[clauses_removable[i]];
+    if (c.mark() != 0 || (max_size > 0 && c.size() > max_size)
+        || (max_lbd > 0 && (c.lbd() == 0 || c.lbd() > max_lbd)))
+    {
+      continue;
+    }
+    out.push();
+    for (int j = 0; j < c.size(); j++)
+    {
+      out.last().push(c[j]);
+    }
+  }
+}
+
 void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict)
 {
     out_conflict.clear();
@@ -1299,7 +1409,7 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
   vardata[var(p)] = VarData(
       from, decisionLevel(), assertionLevel, intro_level(var(p)), trail.size());
   trail.push_(p);
-  if (theory[var(p)])
+  if (theory[var(p)] && !probing)
   {
     // Enqueue to the theory
     d_proxy->enqueueTheoryLiteral(MinisatSatSolver::toSatLiteral(p));
@@ -1429,6 +1539,178 @@ void Solver::propagateTheory() {
   }
 }
 
+CRef Solver::propagateCard()
+{
+  if (cards.empty())
+  {
+    card_qhead = qhead;
+    return CRef_Undef;
+  }
+  CRef confl = CRef_Undef;
+  while (confl == CRef_Undef && card_qhead < qhead)
+  {
+    Lit p = trail[card_qhead++];
+    if (toInt(p) >= (int)card_watches.size())
+    {
+      continue;
+    }
+    // Count p in all constraints, even after a conflict, since backtracking
+    // uncounts it in all of them
+    for (const CardWatch& w : card_watches[toInt(p)])
+    {
+      cards[w.cons].sum += w.weight;
+      if (confl == CRef_Undef)
+      {
+        confl = propagateCardConstraint(w.cons);
+      }
+    }
+  }
+  return confl;
+}
+
+CRef Solver::propagateCardConstraint(int ci)
+{
+  CardConstraint& c = cards[ci];
+  int64_t slack = c.bound - c.sum;
+  if (slack < 0)
+  {
+    // The conflict is the negation of the heaviest counted true literals
+    // whose weight exceeds the bound. Since the sum did not exceed the bound
+    // before the last literal was counted, it is among them.
+    vec<Lit> conflict;
+    int64_t sum = 0;
+    for (size_t i = 0, size = c.lits.size(); i < size && sum <= c.bound; i++)
+    {
+      Lit l = c.lits[i];
+      if (value(l) == l_True && trail_index(var(l)) < card_qhead)
+      {
+        conflict.push(~l);
+        sum += c.weights[i];
+      }
+    }
+    Assert(sum > c.bound && conflict.size() >= 2);
+    lemma_lt lt(*this);
+    sort(conflict, lt);
+    int clauseLevel = 0;
+    if (assertionLevelOnly())
+    {
+      clauseLevel = assertionLevel;
+    }
+    else
+    {
+      for (int i = 0; i < conflict.size(); i++)
+      {
+        clauseLevel = std::max(clauseLevel, intro_level(var(conflict[i])));
+      }
+    }
+    CRef cr = ca.alloc(clauseLevel, conflict, true);
+    clauses_removable.push(cr);
+    attachClause(cr);
+    Debug("minisat") << "Conflict in cardinality constraint " << ci
+                     << std::endl;
+    return cr;
+  }
+  // Literals that are heavier than the slack must be false. Since the literals
+  // are sorted by decreasing weights, these form a prefix.
+  for (size_t i = 0, size = c.lits.size(); i < size && c.weights[i] > slack;
+       i++)
+  {
+    Lit l = c.lits[i];
+    if (value(l) == l_Undef)
+    {
+      uncheckedEnqueue(~l, CRef_Lazy);
+      card_reason[var(l)] = ci;
+    }
+  }
+  return CRef_Undef;
+}
+
+void Solver::explainCard(Var x, vec<Lit>& explanation)
+{
+  const CardConstraint& c = cards[card_reason[x]];
+  // x was propagated since the literals that were true before it are
+  // too heavy
+  explanation.push(mkLit(x, value(x) != l_True));
+  for (Lit l : c.lits)
+  {
+    if (value(l) == l_True && trail_index(var(l)) < trail_index(x))
+    {
+      explanation.push(~l);
+    }
+  }
+}
+
+bool Solver::addCardinality(const vec<Lit>& ps,
+                            const vec<int64_t>& weights,
+                            int64_t bound)
+{
+  Assert(decisionLevel() == 0);
+  Assert(ps.size() == weights.size());
+  if (!ok)
+  {
+    return false;
+  }
+  std::vector<std::pair<int64_t, Lit>> wlits;
+  int64_t total = 0;
+  for (int i = 0; i < ps.size(); i++)
+  {
+    Assert(weights[i] > 0);
+    if (weights[i] > bound)
+    {
+      // the literal is false
+      ClauseId id = ClauseIdUndef;
+      if (!addClause(~ps[i], false, id))
+      {
+        return false;
+      }
+      continue;
+    }
+    wlits.emplace_back(weights[i], ps[i]);
+    total += weights[i];
+  }
+  if (total <= bound)
+  {
+    // trivially satisfied
+    return true;
+  }
+  std::stable_sort(wlits.begin(),
+                   wlits.end(),
+                   [](const std::pair<int64_t, Lit>& a,
+                      const std::pair<int64_t, Lit>& b) {
+                     return a.first > b.first;
+                   });
+  int ci = cards.size();
+  cards.emplace_back();
+  CardConstraint& c = cards.back();
+  c.bound = bound;
+  c.sum = 0;
+  if (card_watches.size() < 2 * (size_t)nVars())
+  {
+    card_watches.resize(2 * nVars());
+  }
+  if (card_reason.size() < (size_t)nVars())
+  {
+    card_reason.resize(nVars(), -1);
+  }
+  for (const std::pair<int64_t, Lit>& wl : wlits)
+  {
+    Lit l = wl.second;
+    c.lits.push_back(l);
+    c.weights.push_back(wl.first);
+    card_watches[toInt(l)].push_back(CardWatch{ci, wl.first});
+    if (value(l) == l_True && trail_index(var(l)) < card_qhead)
+    {
+      c.sum += wl.first;
+    }
+  }
+  if (c.sum > c.bound)
+  {
+    return ok = false;
+  }
+  propagateCardConstraint(ci);
+  return true;
+}
+
 /*_________________________________________________________________________________________________
 |
 |  theoryCheck: [void]  ->  [Clause*]
@@ -1441,7 +1723,15 @@ void Solver::propagateTheory() {
 |________________________________________________________________________________________________@*/
 void Solver::theoryCheck(cvc5::theory::Theory::Effort effort)
 {
+  if (!record_restarts)
+  {
+    d_proxy->theoryCheck(effort);
+    return;
+  }
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
   d_proxy->theoryCheck(effort);
+  restart_theory_time += std::chrono::steady_clock::now() - start;
 }
 
 /*_________________________________________________________________________________________________
@@ -1467,6 +1757,14 @@ CRef Solver::propagateBool()
         Watcher        *i, *j, *end;
         num_props++;
 
+        // Count 'p' in the cardinality constraints first, which may propagate
+        // further literals
+        confl = propagateCard();
+        if (confl != CRef_Undef){
+            qhead = trail.size();
+            break;
+        }
+
         // if propagation tracing enabled, print boolean propagation
         if (Trace.isOn("dtview::prop"))
         {
@@ -1558,6 +1856,201 @@ void Solver::reduceDB()
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  inprocess : ()  ->  [void]
+|
+|  Description:
+|    Simplify the learnt clauses at a restart, i.e. at decision level 0. This vivifies learnt
+|    clauses by probing, and removes learnt clauses that are subsumed by other clauses. Both only
+|    use Boolean propagation and never touch the problem clauses, so theory atoms and the
+|    variables of the CNF stream are unaffected.
+|________________________________________________________________________________________________@*/
+bool Solver::canInprocess() const
+{
+  // the shortened clauses would need resolution proofs, and the theory must
+  // not see the probed assignments, which requires the lemma queue to be empty
+  return options::satInprocessInterval() > 0 && !isProofEnabled()
+         && !options::unsatCores() && lemmas.size() == 0;
+}
+
+void Solver::inprocess()
+{
+  Assert(decisionLevel() == 0);
+  Assert(canInprocess());
+  next_inprocess = conflicts + options::satInprocessInterval();
+  if (!ok)
+  {
+    return;
+  }
+  inprocessings++;
+  Debug("minisat") << "inprocess: " << nLearnts() << " learnt clauses"
+                   << std::endl;
+  // Spend about a tenth of the propagations since the last inprocessing
+  int64_t budget = std::max<int64_t>(
+      10000, static_cast<int64_t>((propagations - inprocess_props) / 10));
+  vivifyLearnts(budget);
+  subsumeLearnts();
+  inprocess_props = propagations;
+  checkGarbage();
+}
+
+void Solver::vivifyLearnts(int64_t budget)
+{
+  // Vivify the most active clauses first
+  vec<CRef> candidates;
+  for (int i = 0; i < clauses_removable.size(); i++)
+  {
+    const Clause& c = ca[clauses_removable[i]];
+    // Only vivify clauses of the current assertion level, since the clauses
+    // used for probing may be removed when popping below it
+    if (c.size() > 2 && !locked(c) && c.level() == assertionLevel)
+    {
+      candidates.push(clauses_removable[i]);
+    }
+  }
+  sort(candidates, reduceDB_lt(ca));
+  uint64_t limit = propagations + budget;
+  for (int i = candidates.size() - 1; i >= 0 && propagations < limit; i--)
+  {
+    CRef cr = candidates[i];
+    detachClause(cr, true);
+    if (vivify(cr))
+    {
+      vivified_clauses++;
+    }
+    attachClause(cr);
+  }
+}
+
+bool Solver::vivify(CRef cr)
+{
+  Assert(decisionLevel() == 0);
+  Clause& c = ca[cr];
+  // Assign the negation of the literals of c one by one and propagate. A
+  // literal that becomes false is implied by the negation of the literals
+  // assigned before, and can be dropped. If a literal becomes true, or
+  // propagation finds a conflict, the remaining literals can be dropped.
+  vec<Lit>& kept = vivify_tmp;
+  kept.clear();
+  bool satisfied = false;
+  probing = true;
+  for (int k = 0; k < c.size(); k++)
+  {
+    Lit l = c[k];
+    lbool v = value(l);
+    if (v == l_True)
+    {
+      // if this is at the top level, simplify() will remove the clause
+      satisfied = decisionLevel() == 0;
+      kept.push(l);
+      break;
+    }
+    if (v == l_False)
+    {
+      continue;
+    }
+    kept.push(l);
+    newDecisionLevel();
+    uncheckedEnqueue(~l);
+    if (propagateBool() != CRef_Undef)
+    {
+      break;
+    }
+  }
+  cancelUntil(0);
+  probing = false;
+  // We do not turn clauses into units here, since units on the trail are not
+  // tied to the level of the clause
+  if (satisfied || kept.size() == c.size() || kept.size() < 2)
+  {
+    return false;
+  }
+  vivified_literals += c.size() - kept.size();
+  for (int k = 0; k < kept.size(); k++)
+  {
+    c[k] = kept[k];
+  }
+  c.shrink(c.size() - kept.size());
+  return true;
+}
+
+void Solver::subsumeLearnts()
+{
+  // Occurrence lists of all clauses that may subsume a learnt clause
+  static const int max_subsumer_size = 16;
+  vec<vec<CRef> > occs(2 * nVars());
+  vec<CRef>* lists[2] = {&clauses_persistent, &clauses_removable};
+  for (vec<CRef>* cs : lists)
+  {
+    for (int i = 0; i < cs->size(); i++)
+    {
+      const Clause& c = ca[(*cs)[i]];
+      if (c.size() <= max_subsumer_size)
+      {
+        for (int k = 0; k < c.size(); k++)
+        {
+          occs[toInt(c[k])].push((*cs)[i]);
+        }
+      }
+    }
+  }
+  vec<char> marked(2 * nVars(), 0);
+  int i, j;
+  for (i = j = 0; i < clauses_removable.size(); i++)
+  {
+    CRef cr = clauses_removable[i];
+    Clause& c = ca[cr];
+    bool subsumed = false;
+    if (!locked(c))
+    {
+      // Check the candidates in the smallest occurrence list of c
+      Lit best = c[0];
+      for (int k = 1; k < c.size(); k++)
+      {
+        if (occs[toInt(c[k])].size() < occs[toInt(best)].size())
+        {
+          best = c[k];
+        }
+      }
+      for (int k = 0; k < c.size(); k++)
+      {
+        marked[toInt(c[k])] = 1;
+      }
+      const vec<CRef>& os = occs[toInt(best)];
+      for (int o = 0; o < os.size() && !subsumed; o++)
+      {
+        const Clause& d = ca[os[o]];
+        // d must not be removed by a pop that keeps c
+        if (os[o] == cr || d.mark() == 1 || d.size() > c.size()
+            || d.level() > c.level())
+        {
+          continue;
+        }
+        subsumed = true;
+        for (int k = 0; k < d.size() && subsumed; k++)
+        {
+          subsumed = marked[toInt(d[k])];
+        }
+      }
+      for (int k = 0; k < c.size(); k++)
+      {
+        marked[toInt(c[k])] = 0;
+      }
+    }
+    if (subsumed)
+    {
+      removeClause(cr);
+      subsumed_clauses++;
+    }
+    else
+    {
+      clauses_removable[j++] = cr;
+    }
+  }
+  clauses_removable.shrink(i - j);
+}
+
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
     int i, j;
@@ -1692,6 +2185,7 @@ lbool Solver::search(int nof_conflicts)
       // Analyze the conflict
       learnt_clause.clear();
       int max_level = analyze(confl, learnt_clause, backtrack_level);
+      int lbd = computeLbd(learnt_clause);
       cancelUntil(backtrack_level);
 
       // Assert the conflict clause and the asserting literal
@@ -1712,6 +2206,11 @@ lbool Solver::search(int nof_conflicts)
         CRef cr = ca.alloc(assertionLevelOnly() ? assertionLevel : max_level,
                            learnt_clause,
                            true);
+        ca[cr].setLbd(lbd);
+        if (search_stats.lbd != nullptr)
+        {
+          *search_stats.lbd << lbd;
+        }
         clauses_removable.push(cr);
         attachClause(cr);
         claBumpActivity(ca[cr]);
@@ -1793,6 +2292,10 @@ lbool Solver::search(int nof_conflicts)
       {
         // Reached bound on number of conflicts:
         progress_estimate = progressEstimate();
+        if (record_restarts)
+        {
+          recordRestart();
+        }
         cancelUntil(0);
         // [mdeters] notify theory engine of restarts for deferred
         // theory processing
@@ -1931,12 +2434,21 @@ lbool Solver::solve_()
 
     // Search:
     int curr_restarts = 0;
+    record_restarts = search_stats.restart_conflict_rate != nullptr;
+    if (record_restarts)
+    {
+      startRestartInterval();
+    }
     while (status == l_Undef){
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
         status = search(rest_base * restart_first);
         if (!withinBudget(ResourceManager::Resource::SatConflictStep))
           break;  // FIXME add restart option?
         curr_restarts++;
+        if (status == l_Undef && conflicts >= next_inprocess && canInprocess())
+        {
+          inprocess();
+        }
     }
 
     if (!withinBudget(ResourceManager::Resource::SatConflictStep))
@@ -2248,6 +2760,18 @@ CRef Solver::updateLemmas() {
   Assert(!options::unsatCores() || isProofEnabled()
          || lemmas.size() == (int)lemmas_cnf_assertion.size());
 
+  // Make room for all the clauses at once, so that they are allocated
+  // contiguously without growing the clause arena for each of them
+  uint32_t lemmas_alloc_size = 0;
+  for (int j = 0; j < lemmas.size(); ++j)
+  {
+    if (lemmas[j].size() > 1)
+    {
+      lemmas_alloc_size += ca.allocSize(lemmas[j].size(), lemmas_removable[j]);
+    }
+  }
+  ca.reserve(lemmas_alloc_size);
+
   // Attach all the clauses and enqueue all the propagations
   for (int j = 0; j < lemmas.size(); ++j)
   {
@@ -2331,7 +2855,13 @@ CRef Solver::updateLemmas() {
 
   Assert(!options::unsatCores() || isProofEnabled()
          || lemmas.size() == (int)lemmas_cnf_assertion.size());
-  // Clear the lemmas
+  // Clear the lemmas, keeping their buffers for the next round
+  for (int j = 0; j < lemmas.size(); ++j)
+  {
+    lemmas_buffers.push();
+    lemmas[j].moveTo(lemmas_buffers.last());
+  }
+  theory_lemmas += lemmas.size();
   lemmas.clear();
   lemmas_cnf_assertion.clear();
   lemmas_removable.clear();
@@ -2366,6 +2896,7 @@ void ClauseAllocator::reloc(CRef& cr,
   // Copy extra data-fields:
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
+  to[cr].setLbd(c.lbd());
   if (to[cr].removable())         to[cr].activity() = c.activity();
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
@@ -21,7 +21,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_Solver_h
 #define Minisat_Solver_h
 
+#include <chrono>
 #include <iosfwd>
+#include <vector>
 
 #include "base/check.h"
 #include "base/output.h"
@@ -37,6 +39,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "prop/sat_proof_manager.h"
 #include "theory/theory.h"
 #include "util/resource_manager.h"
+#include "util/stats_histogram.h"
+#include "util/stats_series.h"
 
 namespace cvc5 {
 template <class Solver> class TSatProof;
@@ -101,6 +105,12 @@ class Solver {
   /** Literals propagated by lemmas */
   vec<vec<Lit> > lemmas;
 
+  /**
+   * The buffers of the lemmas of previous rounds, which are reused for new
+   * lemmas instead of being reallocated
+   */
+  vec<vec<Lit> > lemmas_buffers;
+
   /** Is the lemma removable */
   vec<bool> lemmas_removable;
 
@@ -216,6 +226,8 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, bool removable, ClauseId& id); // Add a ternary clause to the solver.
     bool    addClause_(      vec<Lit>& ps, bool removable, ClauseId& id);  // Add a clause to the solver without making superflous internal copy. Will
                                                                                  // change the passed vector 'ps'.
+    bool    addCardinality(const vec<Lit>& ps, const vec<int64_t>& weights, int64_t bound); // Add the pseudo-Boolean constraint that the weights of the
+                                                                                 // true literals of 'ps' sum up to at most 'bound'. Must be called at level 0.
 
     // Solving:
     //
@@ -257,6 +269,10 @@ public:
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
     bool    isDecision (Var x) const;       // is the given var a decision?
+    double  varActivity(Var x) const;       // The current branching activity of a variable.
+    void    getLearnts (vec<vec<Lit> >& out, int max_size, int max_lbd) const;
+                                            // Get the learnt clauses with at most 'max_size' literals and LBD at most 'max_lbd'
+                                            // (0 means no bound), and the units assigned at level 0.
 
     // Debugging SMT explanations
     //
@@ -309,6 +325,21 @@ public:
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, resources_consumed;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t inprocessings, vivified_clauses, vivified_literals, subsumed_clauses;
+    uint64_t theory_lemmas;
+
+    // Statistics recorded by the solver itself, owned by the caller (null if not recorded):
+    //
+    struct SearchStats
+    {
+      cvc5::IntegralHistogramStat<int>* lbd = nullptr;             // The LBD of the learnt clauses.
+      cvc5::SeriesStat<double>* restart_conflict_rate = nullptr;   // Conflicts per second of each restart interval.
+      cvc5::SeriesStat<double>* restart_propagation_rate = nullptr;// Propagations per second of each restart interval.
+      cvc5::SeriesStat<uint64_t>* restart_trail = nullptr;         // The size of the trail at each restart.
+      cvc5::SeriesStat<double>* restart_theory_share = nullptr;    // The share of the time of each restart interval spent in theory checks.
+      cvc5::SeriesStat<uint64_t>* restart_lemmas = nullptr;        // The number of theory lemmas of each restart interval.
+    };
+    SearchStats search_stats;
 
 protected:
 
@@ -354,6 +385,20 @@ protected:
         bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
     };
 
+    // A native pseudo-Boolean constraint 'sum of weights[i] * lits[i] <= bound' with positive weights,
+    // which is propagated by counting the weight of its true literals rather than by clauses.
+    struct CardConstraint {
+        std::vector<Lit>     lits;          // The literals, by decreasing weights.
+        std::vector<int64_t> weights;       // The weights of the literals, each at most 'bound'.
+        int64_t              bound;
+        int64_t              sum;           // The weight of the counted true literals, i.e. those before 'card_qhead' on the trail.
+    };
+
+    struct CardWatch {
+        int     cons;                       // The index of the constraint in 'cards'.
+        int64_t weight;                     // The weight of the watching literal in the constraint.
+    };
+
     struct VarOrderLt {
         const vec<double>&  activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
@@ -380,12 +425,29 @@ protected:
     vec<bool>           trail_ok;           // Stack of "whether we're in conflict" flags.
     vec<VarData>        vardata;            // Stores reason and level for each variable.
     int                 qhead;              // Head of queue (as index into the trail -- no more explicit propagation queue in MiniSat).
+    int                 card_qhead;         // Number of literals of the trail counted in the cardinality constraints (at most 'qhead').
+    std::vector<CardConstraint> cards;      // The native pseudo-Boolean constraints.
+    std::vector<std::vector<CardWatch> >
+                        card_watches;       // 'card_watches[toInt(lit)]' lists the constraints whose sum increases when 'lit' becomes true.
+    std::vector<int>    card_reason;        // The constraint that propagated each variable, or -1 if it was not propagated by one.
     int                 simpDB_assigns;     // Number of top-level assignments since last execution of 'simplify()'.
     int64_t             simpDB_props;       // Remaining number of propagations that must be made before next execution of 'simplify()'.
     vec<Lit>            assumptions;        // Current set of assumptions provided to solve by the user.
     Heap<VarOrderLt>    order_heap;         // A priority queue of variables ordered with respect to the variable activity.
     double              progress_estimate;  // Set by 'search()'.
     bool                remove_satisfied;   // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
+    bool                probing;            // TRUE while inprocessing probes assignments, which are not reported to the theory proxy.
+    uint64_t            next_inprocess;     // Number of conflicts after which to inprocess next.
+    uint64_t            inprocess_props;    // Number of propagations at the last inprocessing.
+
+    // State of the restart interval for the search statistics (if recorded):
+    //
+    bool                record_restarts;    // Whether the per-restart series of 'search_stats' are recorded.
+    std::chrono::steady_clock::time_point restart_start_time; // Start time of the current restart interval.
+    uint64_t            restart_start_conflicts;    // Conflicts at the start of the current restart interval.
+    uint64_t            restart_start_propagations; // Propagations at the start of the current restart interval.
+    uint64_t            restart_start_lemmas;       // Theory lemmas at the start of the current restart interval.
+    std::chrono::steady_clock::duration restart_theory_time; // Time spent in theory checks in the current restart interval.
 
     ClauseAllocator     ca;
 
@@ -415,6 +477,9 @@ protected:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<Lit>            vivify_tmp;
+    vec<uint64_t>       lbd_stamp;
+    uint64_t            lbd_counter;
 
     double              max_learnts;
     double              learntsize_adjust_confl;
@@ -437,6 +502,9 @@ protected:
     CRef     propagate        (TheoryCheckType type);                                  // Perform Boolean and Theory. Returns possibly conflicting clause.
     CRef     propagateBool    ();                                                      // Perform Boolean propagation. Returns possibly conflicting clause.
     void     propagateTheory  ();                                                      // Perform Theory propagation.
+    CRef     propagateCard    ();                                                      // Count the trail literals up to 'qhead' in the cardinality constraints.
+    CRef     propagateCardConstraint(int ci);                                          // Propagate the cardinality constraint 'cards[ci]' given its current sum.
+    void     explainCard      (Var x, vec<Lit>& explanation);                          // Get the clause explaining the propagation of 'x' by its cardinality constraint.
     void theoryCheck(
         cvc5::theory::Theory::Effort
             effort);  // Perform a theory satisfiability check. Adds lemmas.
@@ -445,12 +513,23 @@ protected:
     int      analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()') - true if p is redundant
+    int      computeLbd       (const vec<Lit>& c);                                     // The number of distinct decision levels of the literals of 'c'.
+    void     startRestartInterval();                                                   // Start recording a restart interval for the search statistics.
+    void     recordRestart    ();                                                      // Record the statistics of the restart interval that ends.
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
 
+    // Inprocessing of the learnt clauses at restarts:
+    //
+    bool     canInprocess     () const;                // Whether inprocessing is enabled and sound in the current mode.
+    void     inprocess        ();                      // Vivify and subsume learnt clauses, must be at decision level 0.
+    void     vivifyLearnts    (int64_t budget);        // Vivify learnt clauses, spending about 'budget' propagations.
+    bool     vivify           (CRef cr);               // Shorten a (detached) learnt clause by probing. Returns TRUE if it was shortened.
+    void     subsumeLearnts   ();                      // Remove learnt clauses subsumed by other clauses.
+
     // Maintaining Variable/Clause activity:
     //
     void     varDecayActivity ();                      // Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
@@ -625,6 +704,7 @@ inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return clauses_persistent.size(); }
 inline int      Solver::nLearnts      ()      const   { return clauses_removable.size(); }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
+inline double   Solver::varActivity   (Var x) const   { return activity[x]; }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
 inline bool     Solver::properExplanation(Lit l, Lit expl) const { return value(l) == l_True && value(expl) == l_True && trail_index(var(expl)) < trail_index(var(l)); }
 inline void     Solver::setPolarity   (Var v, bool b) { polarity[v] = b; }
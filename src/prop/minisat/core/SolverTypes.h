@@ -198,7 +198,8 @@ class Clause {
         unsigned has_extra : 1;
         unsigned reloced   : 1;
         unsigned size      : 27;
-        unsigned level     : 32; }                            header;
+        unsigned level     : 27;
+        unsigned lbd       : 5; }                             header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -212,6 +213,8 @@ class Clause {
         header.reloced   = 0;
         header.size      = ps.size();
         header.level     = level;
+        header.lbd       = 0;
+        Assert(level >= 0 && level < (1 << 27));
 
         for (int i = 0; i < ps.size(); i++) data[i].lit = ps[i];
 
@@ -233,6 +236,11 @@ public:
     }
 
     int          level       ()      const   { return header.level; }
+    // The literal block distance of a learnt clause, i.e. the number of
+    // distinct decision levels of its literals when it was learnt (saturates
+    // at 31, zero if unknown):
+    int          lbd         ()      const   { return header.lbd; }
+    void         setLbd      (int l)         { header.lbd = l < 31 ? l : 31; }
     int          size        ()      const   { return header.size; }
     void shrink(int i)
     {
@@ -293,6 +301,12 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
         to.extra_clause_field = extra_clause_field;
         RegionAllocator<uint32_t>::moveTo(to); }
 
+    // The number of units needed for allocating a clause of the given size:
+    uint32_t allocSize(int size, bool removable) const
+    {
+      return clauseWord32Size(size, removable | extra_clause_field);
+    }
+
     template<class Lits>
     CRef alloc(int level, const Lits& ps, bool removable = false)
     {
@@ -194,6 +194,30 @@ SatValue MinisatSatSolver::solve() {
   return result;
 }
 
+SatValue MinisatSatSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  setupOptions();
+  d_minisat->budgetOff();
+  Minisat::vec<Minisat::Lit> assumps;
+  for (const SatLiteral& lit : assumptions)
+  {
+    assumps.push(toMinisatLit(lit));
+  }
+  SatValue result = toSatLiteralValue(d_minisat->solve(assumps));
+  d_minisat->clearInterrupt();
+  return result;
+}
+
+void MinisatSatSolver::getUnsatAssumptions(
+    std::vector<SatLiteral>& unsat_assumptions)
+{
+  // the final conflict is a clause over the negations of the assumptions
+  for (int i = 0, size = d_minisat->d_conflict.size(); i < size; i++)
+  {
+    unsat_assumptions.push_back(toSatLiteral(~d_minisat->d_conflict[i]));
+  }
+}
+
 bool MinisatSatSolver::ok() const {
   return d_minisat->okay();
 }
@@ -225,6 +249,47 @@ bool MinisatSatSolver::isDecision(SatVariable decn) const {
   return d_minisat->isDecision( decn );
 }
 
+double MinisatSatSolver::getActivity(SatVariable var) const
+{
+  return d_minisat->varActivity(var);
+}
+
+void MinisatSatSolver::getLearnedClauses(std::vector<SatClause>& clauses,
+                                         uint32_t maxSize,
+                                         uint32_t maxLbd)
+{
+  Minisat::vec<Minisat::vec<Minisat::Lit> > learnts;
+  d_minisat->getLearnts(learnts, maxSize, maxLbd);
+  for (int i = 0; i < learnts.size(); ++i)
+  {
+    clauses.emplace_back();
+    for (int j = 0; j < learnts[i].size(); ++j)
+    {
+      clauses.back().push_back(toSatLiteral(learnts[i][j]));
+    }
+  }
+}
+
+bool MinisatSatSolver::addCardinalityConstraint(
+    const std::vector<SatLiteral>& lits,
+    const std::vector<uint64_t>& weights,
+    uint64_t bound)
+{
+  Minisat::vec<Minisat::Lit> minisat_lits;
+  Minisat::vec<int64_t> minisat_weights;
+  for (size_t i = 0, size = lits.size(); i < size; ++i)
+  {
+    Minisat::Lit l = toMinisatLit(lits[i]);
+    // the variables of the constraint must not be eliminated
+    d_minisat->setFrozen(Minisat::var(l), true);
+    minisat_lits.push(l);
+    minisat_weights.push(static_cast<int64_t>(weights[i]));
+  }
+  d_minisat->addCardinality(
+      minisat_lits, minisat_weights, static_cast<int64_t>(bound));
+  return true;
+}
+
 SatProofManager* MinisatSatSolver::getProofManager()
 {
   return d_minisat->getProofManager();
@@ -263,7 +328,18 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
     d_statClausesLiterals("sat::clauses_literals"),
     d_statLearntsLiterals("sat::learnts_literals"),
     d_statMaxLiterals("sat::max_literals"),
-    d_statTotLiterals("sat::tot_literals")
+    d_statTotLiterals("sat::tot_literals"),
+    d_statInprocessings("sat::inprocessings"),
+    d_statVivifiedClauses("sat::vivified_clauses"),
+    d_statVivifiedLiterals("sat::vivified_literals"),
+    d_statSubsumedClauses("sat::subsumed_clauses"),
+    d_statTheoryLemmas("sat::theory_lemmas"),
+    d_statLbd("sat::learnt_lbd"),
+    d_statRestartConflictRate("sat::restart::conflicts_per_sec"),
+    d_statRestartPropagationRate("sat::restart::propagations_per_sec"),
+    d_statRestartTrail("sat::restart::trail_size"),
+    d_statRestartTheoryShare("sat::restart::theory_time_share"),
+    d_statRestartLemmas("sat::restart::theory_lemmas")
 {
   d_registry->registerStat(&d_statStarts);
   d_registry->registerStat(&d_statDecisions);
@@ -274,6 +350,20 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
   d_registry->registerStat(&d_statLearntsLiterals);
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
+  d_registry->registerStat(&d_statInprocessings);
+  d_registry->registerStat(&d_statVivifiedClauses);
+  d_registry->registerStat(&d_statVivifiedLiterals);
+  d_registry->registerStat(&d_statSubsumedClauses);
+  d_registry->registerStat(&d_statTheoryLemmas);
+  d_registry->registerStat(&d_statLbd);
+  if (options::satRestartStats())
+  {
+    d_registry->registerStat(&d_statRestartConflictRate);
+    d_registry->registerStat(&d_statRestartPropagationRate);
+    d_registry->registerStat(&d_statRestartTrail);
+    d_registry->registerStat(&d_statRestartTheoryShare);
+    d_registry->registerStat(&d_statRestartLemmas);
+  }
 }
 
 MinisatSatSolver::Statistics::~Statistics() {
@@ -286,6 +376,20 @@ MinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statLearntsLiterals);
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
+  d_registry->unregisterStat(&d_statInprocessings);
+  d_registry->unregisterStat(&d_statVivifiedClauses);
+  d_registry->unregisterStat(&d_statVivifiedLiterals);
+  d_registry->unregisterStat(&d_statSubsumedClauses);
+  d_registry->unregisterStat(&d_statTheoryLemmas);
+  d_registry->unregisterStat(&d_statLbd);
+  if (options::satRestartStats())
+  {
+    d_registry->unregisterStat(&d_statRestartConflictRate);
+    d_registry->unregisterStat(&d_statRestartPropagationRate);
+    d_registry->unregisterStat(&d_statRestartTrail);
+    d_registry->unregisterStat(&d_statRestartTheoryShare);
+    d_registry->unregisterStat(&d_statRestartLemmas);
+  }
 }
 
 void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
@@ -298,6 +402,21 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
   d_statLearntsLiterals.set(minisat->learnts_literals);
   d_statMaxLiterals.set(minisat->max_literals);
   d_statTotLiterals.set(minisat->tot_literals);
+  d_statInprocessings.set(minisat->inprocessings);
+  d_statVivifiedClauses.set(minisat->vivified_clauses);
+  d_statVivifiedLiterals.set(minisat->vivified_literals);
+  d_statSubsumedClauses.set(minisat->subsumed_clauses);
+  d_statTheoryLemmas.set(minisat->theory_lemmas);
+  minisat->search_stats.lbd = &d_statLbd;
+  if (options::satRestartStats())
+  {
+    minisat->search_stats.restart_conflict_rate = &d_statRestartConflictRate;
+    minisat->search_stats.restart_propagation_rate =
+        &d_statRestartPropagationRate;
+    minisat->search_stats.restart_trail = &d_statRestartTrail;
+    minisat->search_stats.restart_theory_share = &d_statRestartTheoryShare;
+    minisat->search_stats.restart_lemmas = &d_statRestartLemmas;
+  }
 }
 
 }  // namespace prop
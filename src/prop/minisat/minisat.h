@@ -19,6 +19,8 @@
 #include "prop/sat_solver.h"
 #include "prop/minisat/simp/SimpSolver.h"
 #include "util/statistics_registry.h"
+#include "util/stats_histogram.h"
+#include "util/stats_series.h"
 
 namespace cvc5 {
 namespace prop {
@@ -57,6 +59,8 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
 
   SatValue solve() override;
   SatValue solve(long unsigned int&) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+  void getUnsatAssumptions(std::vector<SatLiteral>& unsat_assumptions) override;
 
   bool ok() const override;
 
@@ -82,6 +86,18 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
 
   bool isDecision(SatVariable decn) const override;
 
+  double getActivity(SatVariable var) const override;
+
+  bool supportsLearnedClauses() const override { return true; }
+
+  void getLearnedClauses(std::vector<SatClause>& clauses,
+                         uint32_t maxSize,
+                         uint32_t maxLbd) override;
+
+  bool addCardinalityConstraint(const std::vector<SatLiteral>& lits,
+                                const std::vector<uint64_t>& weights,
+                                uint64_t bound) override;
+
   /** Retrieve a pointer to the unerlying solver. */
   Minisat::SimpSolver* getSolver() { return d_minisat; }
 
@@ -109,6 +125,15 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
     ReferenceStat<uint64_t> d_statConflicts, d_statClausesLiterals;
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
     ReferenceStat<uint64_t> d_statTotLiterals;
+    ReferenceStat<uint64_t> d_statInprocessings, d_statVivifiedClauses;
+    ReferenceStat<uint64_t> d_statVivifiedLiterals, d_statSubsumedClauses;
+    ReferenceStat<uint64_t> d_statTheoryLemmas;
+    IntegralHistogramStat<int> d_statLbd;
+    SeriesStat<double> d_statRestartConflictRate;
+    SeriesStat<double> d_statRestartPropagationRate;
+    SeriesStat<uint64_t> d_statRestartTrail;
+    SeriesStat<double> d_statRestartTheoryShare;
+    SeriesStat<uint64_t> d_statRestartLemmas;
   public:
     Statistics(StatisticsRegistry* registry);
     ~Statistics();
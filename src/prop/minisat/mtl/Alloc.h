@@ -60,6 +60,8 @@ class RegionAllocator
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
+    // Make room for allocating 'size' more units without growing the region:
+    void     reserve   (uint32_t size) { capacity(sz + size); }
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     T& operator[](Ref r)
@@ -14,6 +14,7 @@
 
 #include "prop/proof_cnf_stream.h"
 
+#include "options/proof_options.h"
 #include "options/smt_options.h"
 #include "prop/minisat/minisat.h"
 #include "theory/builtin/proof_checker.h"
@@ -28,6 +29,8 @@ ProofCnfStream::ProofCnfStream(context::UserContext* u,
     : d_cnfStream(cnfStream),
       d_satPM(satPM),
       d_proof(pnm, nullptr, u, "ProofCnfStream::LazyCDProof"),
+      d_compactProof(pnm, u, "ProofCnfStream::CompactProof"),
+      d_compact(options::proofCompactCnf()),
       d_blocked(u)
 {
 }
@@ -44,14 +47,52 @@ bool ProofCnfStream::isBlocked(std::shared_ptr<ProofNode> pfn)
 
 std::shared_ptr<ProofNode> ProofCnfStream::getProofFor(Node f)
 {
+  if (d_compact)
+  {
+    return d_compactProof.getProofFor(f);
+  }
   return d_proof.getProofFor(f);
 }
 
 bool ProofCnfStream::hasProofFor(Node f)
 {
+  if (d_compact)
+  {
+    return d_compactProof.hasStep(f) || d_compactProof.hasGenerator(f);
+  }
   return d_proof.hasStep(f) || d_proof.hasGenerator(f);
 }
 
+void ProofCnfStream::addStep(Node expected,
+                             PfRule id,
+                             const std::vector<Node>& children,
+                             const std::vector<Node>& args)
+{
+  if (d_compact)
+  {
+    d_compactProof.addStep(expected, id, children, args);
+    return;
+  }
+  d_proof.addStep(expected, id, children, args);
+}
+
+void ProofCnfStream::addStep(Node expected, const ProofStep& step)
+{
+  addStep(expected, step.d_rule, step.d_children, step.d_args);
+}
+
+void ProofCnfStream::addLazyStep(Node expected,
+                                 ProofGenerator* pg,
+                                 const char* ctx)
+{
+  if (d_compact)
+  {
+    d_compactProof.addLazyStep(expected, pg, PfRule::ASSUME, true, ctx);
+    return;
+  }
+  d_proof.addLazyStep(expected, pg, PfRule::ASSUME, true, ctx);
+}
+
 std::string ProofCnfStream::identify() const { return "ProofCnfStream"; }
 
 void ProofCnfStream::normalizeAndRegister(TNode clauseNode)
@@ -81,18 +122,14 @@ void ProofCnfStream::convertAndAssert(TNode node,
     Trace("cnf") << "ProofCnfStream::convertAndAssert: pg: " << pg->identify()
                  << "\n";
     Node toJustify = negated ? node.notNode() : static_cast<Node>(node);
-    d_proof.addLazyStep(toJustify,
-                        pg,
-                        PfRule::ASSUME,
-                        true,
-                        "ProofCnfStream::convertAndAssert:cnf");
+    addLazyStep(toJustify, pg, "ProofCnfStream::convertAndAssert:cnf");
   }
   convertAndAssert(node, negated);
   // process saved steps in buffer
   const std::vector<std::pair<Node, ProofStep>>& steps = d_psb.getSteps();
   for (const std::pair<Node, ProofStep>& step : steps)
   {
-    d_proof.addStep(step.first, step.second);
+    addStep(step.first, step.second);
   }
   d_psb.clear();
 }
@@ -113,7 +150,7 @@ void ProofCnfStream::convertAndAssert(TNode node, bool negated)
       // track double negation elimination
       if (negated)
       {
-        d_proof.addStep(node[0], PfRule::NOT_NOT_ELIM, {node.notNode()}, {});
+        addStep(node[0], PfRule::NOT_NOT_ELIM, {node.notNode()}, {});
         Trace("cnf")
             << "ProofCnfStream::convertAndAssert: NOT_NOT_ELIM added norm "
             << node[0] << "\n";
@@ -133,7 +170,8 @@ void ProofCnfStream::convertAndAssert(TNode node, bool negated)
       // negate
       Node nnode = negated ? node.negate() : static_cast<Node>(node);
       // Atoms
-      SatLiteral lit = toCNF(node, negated);
+      uint8_t pol = negated ? CnfStream::s_polNeg : CnfStream::s_polPos;
+      SatLiteral lit = toCNF(node, negated, pol);
       bool added = d_cnfStream.assertClause(nnode, lit);
       if (negated && added && nnode != node.notNode())
       {
@@ -141,7 +179,7 @@ void ProofCnfStream::convertAndAssert(TNode node, bool negated)
         //    (not (not n))
         //   -------------- NOT_NOT_ELIM
         //        n
-        d_proof.addStep(nnode, PfRule::NOT_NOT_ELIM, {node.notNode()}, {});
+        addStep(nnode, PfRule::NOT_NOT_ELIM, {node.notNode()}, {});
         Trace("cnf")
             << "ProofCnfStream::convertAndAssert: NOT_NOT_ELIM added norm "
             << nnode << "\n";
@@ -170,7 +208,7 @@ void ProofCnfStream::convertAndAssertAnd(TNode node, bool negated)
     {
       // Create a proof step for each n_i
       Node iNode = nm->mkConst<Rational>(i);
-      d_proof.addStep(node[i], PfRule::AND_ELIM, {node}, {iNode});
+      addStep(node[i], PfRule::AND_ELIM, {node}, {iNode});
       Trace("cnf") << "ProofCnfStream::convertAndAssertAnd: AND_ELIM " << i
                    << " added norm " << node[i] << "\n";
       convertAndAssert(node[i], false);
@@ -183,7 +221,7 @@ void ProofCnfStream::convertAndAssertAnd(TNode node, bool negated)
     SatClause clause(size);
     for (i = 0; i < size; ++i)
     {
-      clause[i] = toCNF(node[i], true);
+      clause[i] = toCNF(node[i], true, CnfStream::s_polNeg);
     }
     bool added = d_cnfStream.assertClause(node.negate(), clause);
     // register proof step
@@ -195,7 +233,7 @@ void ProofCnfStream::convertAndAssertAnd(TNode node, bool negated)
         disjuncts.push_back(node[i].notNode());
       }
       Node clauseNode = NodeManager::currentNM()->mkNode(kind::OR, disjuncts);
-      d_proof.addStep(clauseNode, PfRule::NOT_AND, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_AND, {node.notNode()}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertAnd: NOT_AND added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -215,7 +253,7 @@ void ProofCnfStream::convertAndAssertOr(TNode node, bool negated)
     SatClause clause(size);
     for (unsigned i = 0; i < size; ++i)
     {
-      clause[i] = toCNF(node[i], false);
+      clause[i] = toCNF(node[i], false, CnfStream::s_polPos);
     }
     normalizeAndRegister(node);
     d_cnfStream.assertClause(node, clause);
@@ -229,7 +267,7 @@ void ProofCnfStream::convertAndAssertOr(TNode node, bool negated)
     {
       // Create a proof step for each (not n_i)
       Node iNode = nm->mkConst<Rational>(i);
-      d_proof.addStep(
+      addStep(
           node[i].notNode(), PfRule::NOT_OR_ELIM, {node.notNode()}, {iNode});
       Trace("cnf") << "ProofCnfStream::convertAndAssertOr: NOT_OR_ELIM " << i
                    << " added norm  " << node[i].notNode() << "\n";
@@ -258,7 +296,7 @@ void ProofCnfStream::convertAndAssertXor(TNode node, bool negated)
     {
       Node clauseNode =
           nm->mkNode(kind::OR, node[0].notNode(), node[1].notNode());
-      d_proof.addStep(clauseNode, PfRule::XOR_ELIM2, {node}, {});
+      addStep(clauseNode, PfRule::XOR_ELIM2, {node}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertXor: XOR_ELIM2 added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -271,7 +309,7 @@ void ProofCnfStream::convertAndAssertXor(TNode node, bool negated)
     if (added)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0], node[1]);
-      d_proof.addStep(clauseNode, PfRule::XOR_ELIM1, {node}, {});
+      addStep(clauseNode, PfRule::XOR_ELIM1, {node}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertXor: XOR_ELIM1 added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -292,7 +330,7 @@ void ProofCnfStream::convertAndAssertXor(TNode node, bool negated)
     if (added)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0].notNode(), node[1]);
-      d_proof.addStep(clauseNode, PfRule::NOT_XOR_ELIM2, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_XOR_ELIM2, {node.notNode()}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertXor: NOT_XOR_ELIM2 added "
           << clauseNode << "\n";
@@ -306,7 +344,7 @@ void ProofCnfStream::convertAndAssertXor(TNode node, bool negated)
     if (added)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0], node[1].notNode());
-      d_proof.addStep(clauseNode, PfRule::NOT_XOR_ELIM1, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_XOR_ELIM1, {node.notNode()}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertXor: NOT_XOR_ELIM1 added "
           << clauseNode << "\n";
@@ -336,7 +374,7 @@ void ProofCnfStream::convertAndAssertIff(TNode node, bool negated)
     if (added)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0].notNode(), node[1]);
-      d_proof.addStep(clauseNode, PfRule::EQUIV_ELIM1, {node}, {});
+      addStep(clauseNode, PfRule::EQUIV_ELIM1, {node}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertIff: EQUIV_ELIM1 added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -349,7 +387,7 @@ void ProofCnfStream::convertAndAssertIff(TNode node, bool negated)
     if (added)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0], node[1].notNode());
-      d_proof.addStep(clauseNode, PfRule::EQUIV_ELIM2, {node}, {});
+      addStep(clauseNode, PfRule::EQUIV_ELIM2, {node}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertIff: EQUIV_ELIM2 added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -373,8 +411,7 @@ void ProofCnfStream::convertAndAssertIff(TNode node, bool negated)
     {
       Node clauseNode =
           nm->mkNode(kind::OR, node[0].notNode(), node[1].notNode());
-      d_proof.addStep(
-          clauseNode, PfRule::NOT_EQUIV_ELIM2, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_EQUIV_ELIM2, {node.notNode()}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertIff: NOT_EQUIV_ELIM2 added "
           << clauseNode << "\n";
@@ -388,8 +425,7 @@ void ProofCnfStream::convertAndAssertIff(TNode node, bool negated)
     if (added)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0], node[1]);
-      d_proof.addStep(
-          clauseNode, PfRule::NOT_EQUIV_ELIM1, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_EQUIV_ELIM1, {node.notNode()}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertIff: NOT_EQUIV_ELIM1 added "
           << clauseNode << "\n";
@@ -405,8 +441,8 @@ void ProofCnfStream::convertAndAssertImplies(TNode node, bool negated)
   if (!negated)
   {
     // ~p v q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], false, CnfStream::s_polNeg);
+    SatLiteral q = toCNF(node[1], false, CnfStream::s_polPos);
     // Construct the clause ~p || q
     SatClause clause(2);
     clause[0] = ~p;
@@ -416,7 +452,7 @@ void ProofCnfStream::convertAndAssertImplies(TNode node, bool negated)
     {
       Node clauseNode = NodeManager::currentNM()->mkNode(
           kind::OR, node[0].notNode(), node[1]);
-      d_proof.addStep(clauseNode, PfRule::IMPLIES_ELIM, {node}, {});
+      addStep(clauseNode, PfRule::IMPLIES_ELIM, {node}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertImplies: IMPLIES_ELIM added "
           << clauseNode << "\n";
@@ -428,14 +464,13 @@ void ProofCnfStream::convertAndAssertImplies(TNode node, bool negated)
     // ~(p => q) is the same as p ^ ~q
     // process p
     convertAndAssert(node[0], false);
-    d_proof.addStep(node[0], PfRule::NOT_IMPLIES_ELIM1, {node.notNode()}, {});
+    addStep(node[0], PfRule::NOT_IMPLIES_ELIM1, {node.notNode()}, {});
     Trace("cnf")
         << "ProofCnfStream::convertAndAssertImplies: NOT_IMPLIES_ELIM1 added "
         << node[0] << "\n";
     // process ~q
     convertAndAssert(node[1], true);
-    d_proof.addStep(
-        node[1].notNode(), PfRule::NOT_IMPLIES_ELIM2, {node.notNode()}, {});
+    addStep(node[1].notNode(), PfRule::NOT_IMPLIES_ELIM2, {node.notNode()}, {});
     Trace("cnf")
         << "ProofCnfStream::convertAndAssertImplies: NOT_IMPLIES_ELIM2 added "
         << node[1].notNode() << "\n";
@@ -448,8 +483,9 @@ void ProofCnfStream::convertAndAssertIte(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   // ITE(p, q, r)
   SatLiteral p = toCNF(node[0], false);
-  SatLiteral q = toCNF(node[1], negated);
-  SatLiteral r = toCNF(node[2], negated);
+  uint8_t pol = negated ? CnfStream::s_polNeg : CnfStream::s_polPos;
+  SatLiteral q = toCNF(node[1], negated, pol);
+  SatLiteral r = toCNF(node[2], negated, pol);
   bool added;
   NodeManager* nm = NodeManager::currentNM();
   // Construct the clauses:
@@ -469,7 +505,7 @@ void ProofCnfStream::convertAndAssertIte(TNode node, bool negated)
     if (!negated)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0].notNode(), node[1]);
-      d_proof.addStep(clauseNode, PfRule::ITE_ELIM1, {node}, {});
+      addStep(clauseNode, PfRule::ITE_ELIM1, {node}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertIte: ITE_ELIM1 added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -478,7 +514,7 @@ void ProofCnfStream::convertAndAssertIte(TNode node, bool negated)
     {
       Node clauseNode =
           nm->mkNode(kind::OR, node[0].notNode(), node[1].notNode());
-      d_proof.addStep(clauseNode, PfRule::NOT_ITE_ELIM1, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_ITE_ELIM1, {node.notNode()}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertIte: NOT_ITE_ELIM1 added "
           << clauseNode << "\n";
@@ -496,7 +532,7 @@ void ProofCnfStream::convertAndAssertIte(TNode node, bool negated)
     if (!negated)
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0], node[2]);
-      d_proof.addStep(clauseNode, PfRule::ITE_ELIM2, {node}, {});
+      addStep(clauseNode, PfRule::ITE_ELIM2, {node}, {});
       Trace("cnf") << "ProofCnfStream::convertAndAssertIte: ITE_ELIM2 added "
                    << clauseNode << "\n";
       normalizeAndRegister(clauseNode);
@@ -504,7 +540,7 @@ void ProofCnfStream::convertAndAssertIte(TNode node, bool negated)
     else
     {
       Node clauseNode = nm->mkNode(kind::OR, node[0], node[2].notNode());
-      d_proof.addStep(clauseNode, PfRule::NOT_ITE_ELIM2, {node.notNode()}, {});
+      addStep(clauseNode, PfRule::NOT_ITE_ELIM2, {node.notNode()}, {});
       Trace("cnf")
           << "ProofCnfStream::convertAndAssertIte: NOT_ITE_ELIM2 added "
           << clauseNode << "\n";
@@ -522,11 +558,8 @@ void ProofCnfStream::convertPropagation(theory::TrustNode trn)
   Assert(trn.getGenerator()->getProofFor(proven)->isClosed());
   Trace("cnf-steps") << proven << " by explainPropagation "
                      << trn.identifyGenerator() << std::endl;
-  d_proof.addLazyStep(proven,
-                      trn.getGenerator(),
-                      PfRule::ASSUME,
-                      true,
-                      "ProofCnfStream::convertPropagation");
+  addLazyStep(
+      proven, trn.getGenerator(), "ProofCnfStream::convertPropagation");
   // since the propagation is added directly to the SAT solver via theoryProxy,
   // do the transformation of the lemma E1 ^ ... ^ En => P into CNF here
   NodeManager* nm = NodeManager::currentNM();
@@ -534,7 +567,7 @@ void ProofCnfStream::convertPropagation(theory::TrustNode trn)
   Trace("cnf") << "ProofCnfStream::convertPropagation: adding "
                << PfRule::IMPLIES_ELIM << " rule to conclude "
                << clauseImpliesElim << "\n";
-  d_proof.addStep(clauseImpliesElim, PfRule::IMPLIES_ELIM, {proven}, {});
+  addStep(clauseImpliesElim, PfRule::IMPLIES_ELIM, {proven}, {});
   Node clauseExp;
   // need to eliminate AND
   if (proven[0].getKind() == kind::AND)
@@ -549,12 +582,12 @@ void ProofCnfStream::convertPropagation(theory::TrustNode trn)
     disjunctsRes.push_back(proven[1]);
     Node clauseAndNeg = nm->mkNode(kind::OR, disjunctsAndNeg);
     // add proof steps to convert into clause
-    d_proof.addStep(clauseAndNeg, PfRule::CNF_AND_NEG, {}, {proven[0]});
+    addStep(clauseAndNeg, PfRule::CNF_AND_NEG, {}, {proven[0]});
     clauseExp = nm->mkNode(kind::OR, disjunctsRes);
-    d_proof.addStep(clauseExp,
-                    PfRule::RESOLUTION,
-                    {clauseAndNeg, clauseImpliesElim},
-                    {nm->mkConst(true), proven[0]});
+    addStep(clauseExp,
+            PfRule::RESOLUTION,
+            {clauseAndNeg, clauseImpliesElim},
+            {nm->mkConst(true), proven[0]});
   }
   else
   {
@@ -565,7 +598,7 @@ void ProofCnfStream::convertPropagation(theory::TrustNode trn)
   const std::vector<std::pair<Node, ProofStep>>& steps = d_psb.getSteps();
   for (const std::pair<Node, ProofStep>& step : steps)
   {
-    d_proof.addStep(step.first, step.second);
+    addStep(step.first, step.second);
   }
   d_psb.clear();
 }
@@ -575,6 +608,11 @@ void ProofCnfStream::ensureLiteral(TNode n)
   Trace("cnf") << "ProofCnfStream::ensureLiteral(" << n << ")\n";
   if (d_cnfStream.hasLiteral(n))
   {
+    if (d_cnfStream.d_pgEncoding)
+    {
+      // the literal must be equivalent to n
+      toCNF(n);
+    }
     d_cnfStream.ensureMappingForLiteral(n);
     return;
   }
@@ -598,15 +636,31 @@ void ProofCnfStream::ensureLiteral(TNode n)
 }
 
 SatLiteral ProofCnfStream::toCNF(TNode node, bool negated)
+{
+  return toCNF(node, negated, CnfStream::s_polBoth);
+}
+
+SatLiteral ProofCnfStream::toCNF(TNode node, bool negated, uint8_t pol)
 {
   Trace("cnf") << "toCNF(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   SatLiteral lit;
+  if (!d_cnfStream.d_pgEncoding)
+  {
+    pol = CnfStream::s_polBoth;
+  }
+  else if (node.getKind() == kind::NOT)
+  {
+    // look through the negation to complete the definition of node[0], see
+    // CnfStream::toCNF
+    return toCNF(node[0], !negated, CnfStream::flipPolarity(pol));
+  }
   // If the node has already has a literal, return it (maybe negated)
   if (d_cnfStream.hasLiteral(node))
   {
     Trace("cnf") << "toCNF(): already translated\n";
-    lit = d_cnfStream.getLiteral(node);
+    lit = d_cnfStream.d_pgEncoding ? completeDefinition(node, pol)
+                                   : d_cnfStream.getLiteral(node);
     // Return the (maybe negated) literal
     return !negated ? lit : ~lit;
   }
@@ -614,14 +668,14 @@ SatLiteral ProofCnfStream::toCNF(TNode node, bool negated)
   // Handle each Boolean operator case
   switch (node.getKind())
   {
-    case kind::AND: lit = handleAnd(node); break;
-    case kind::OR: lit = handleOr(node); break;
-    case kind::XOR: lit = handleXor(node); break;
-    case kind::IMPLIES: lit = handleImplies(node); break;
-    case kind::ITE: lit = handleIte(node); break;
+    case kind::AND: lit = handleAnd(node, pol); break;
+    case kind::OR: lit = handleOr(node, pol); break;
+    case kind::XOR: lit = handleXor(node, pol); break;
+    case kind::IMPLIES: lit = handleImplies(node, pol); break;
+    case kind::ITE: lit = handleIte(node, pol); break;
     case kind::NOT: lit = ~toCNF(node[0]); break;
     case kind::EQUAL:
-      lit = node[0].getType().isBoolean() ? handleIff(node)
+      lit = node[0].getType().isBoolean() ? handleIff(node, pol)
                                           : d_cnfStream.convertAtom(node);
       break;
     default:
@@ -634,9 +688,31 @@ SatLiteral ProofCnfStream::toCNF(TNode node, bool negated)
   return !negated ? lit : ~lit;
 }
 
-SatLiteral ProofCnfStream::handleAnd(TNode node)
+SatLiteral ProofCnfStream::completeDefinition(TNode node, uint8_t pol)
 {
-  Assert(!d_cnfStream.hasLiteral(node)) << "Atom already mapped!";
+  uint8_t missing = d_cnfStream.getMissingPolarity(node, pol);
+  if (missing != 0)
+  {
+    Trace("cnf") << "ProofCnfStream::completeDefinition(" << node << ", "
+                 << int(missing) << ")\n";
+    switch (node.getKind())
+    {
+      case kind::AND: return handleAnd(node, missing);
+      case kind::OR: return handleOr(node, missing);
+      case kind::XOR: return handleXor(node, missing);
+      case kind::IMPLIES: return handleImplies(node, missing);
+      case kind::ITE: return handleIte(node, missing);
+      case kind::EQUAL: return handleIff(node, missing);
+      default: Unreachable();
+    }
+  }
+  return d_cnfStream.getLiteral(node);
+}
+
+SatLiteral ProofCnfStream::handleAnd(TNode node, uint8_t pol)
+{
+  Assert(d_cnfStream.d_pgEncoding || !d_cnfStream.hasLiteral(node))
+      << "Atom already mapped!";
   Assert(node.getKind() == kind::AND) << "Expecting an AND expression!";
   Assert(node.getNumChildren() > 1) << "Expecting more than 1 child!";
   Assert(!d_cnfStream.d_removable)
@@ -649,58 +725,67 @@ SatLiteral ProofCnfStream::handleAnd(TNode node)
   for (unsigned i = 0; i < size; ++i)
   {
     Trace("cnf") << push;
-    clause[i] = ~toCNF(node[i]);
+    clause[i] = ~toCNF(node[i], false, pol);
     Trace("cnf") << pop;
   }
   // Create literal for the node
-  SatLiteral lit = d_cnfStream.newLiteral(node);
+  SatLiteral lit = d_cnfStream.getOrNewLiteral(node);
   bool added;
   NodeManager* nm = NodeManager::currentNM();
   // lit -> (a_1 & a_2 & a_3 & ... & a_n)
   // ~lit | (a_1 & a_2 & a_3 & ... & a_n)
   // (~lit | a_1) & (~lit | a_2) & ... & (~lit | a_n)
-  for (unsigned i = 0; i < size; ++i)
+  if (pol & CnfStream::s_polPos)
   {
-    Trace("cnf") << push;
-    added = d_cnfStream.assertClause(node.negate(), ~lit, ~clause[i]);
-    Trace("cnf") << pop;
-    if (added)
+    for (unsigned i = 0; i < size; ++i)
     {
-      Node clauseNode = nm->mkNode(kind::OR, node.notNode(), node[i]);
-      Node iNode = nm->mkConst<Rational>(i);
-      d_proof.addStep(clauseNode, PfRule::CNF_AND_POS, {}, {node, iNode});
-      Trace("cnf") << "ProofCnfStream::handleAnd: CNF_AND_POS " << i
-                   << " added " << clauseNode << "\n";
-      normalizeAndRegister(clauseNode);
+      Trace("cnf") << push;
+      added = d_cnfStream.assertClause(node.negate(), ~lit, ~clause[i]);
+      Trace("cnf") << pop;
+      if (added)
+      {
+        Node clauseNode = nm->mkNode(kind::OR, node.notNode(), node[i]);
+        Node iNode = nm->mkConst<Rational>(i);
+        addStep(clauseNode, PfRule::CNF_AND_POS, {}, {node, iNode});
+        Trace("cnf") << "ProofCnfStream::handleAnd: CNF_AND_POS " << i
+                     << " added " << clauseNode << "\n";
+        normalizeAndRegister(clauseNode);
+      }
     }
   }
   // lit <- (a_1 & a_2 & a_3 & ... a_n)
   // lit | ~(a_1 & a_2 & a_3 & ... & a_n)
   // lit | ~a_1 | ~a_2 | ~a_3 | ... | ~a_n
-  clause[size] = lit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  Trace("cnf") << push;
-  added = d_cnfStream.assertClause(node, clause);
-  Trace("cnf") << pop;
-  if (added)
+  if (pol & CnfStream::s_polNeg)
   {
-    std::vector<Node> disjuncts{node};
-    for (unsigned i = 0; i < size; ++i)
+    clause[size] = lit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    Trace("cnf") << push;
+    added = d_cnfStream.assertClause(node, clause);
+    Trace("cnf") << pop;
+    if (added)
     {
-      disjuncts.push_back(node[i].notNode());
+      std::vector<Node> disjuncts{node};
+      for (unsigned i = 0; i < size; ++i)
+      {
+        disjuncts.push_back(node[i].notNode());
+      }
+      Node clauseNode = nm->mkNode(kind::OR, disjuncts);
+      addStep(clauseNode, PfRule::CNF_AND_NEG, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleAnd: CNF_AND_NEG added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
     }
-    Node clauseNode = nm->mkNode(kind::OR, disjuncts);
-    d_proof.addStep(clauseNode, PfRule::CNF_AND_NEG, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleAnd: CNF_AND_NEG added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
   }
+  d_cnfStream.addDefinedPolarity(node, pol);
   return lit;
 }
 
-SatLiteral ProofCnfStream::handleOr(TNode node)
+SatLiteral ProofCnfStream::handleOr(TNode node, uint8_t pol)
 {
-  Assert(!d_cnfStream.hasLiteral(node)) << "Atom already mapped!";
+  Assert(d_cnfStream.d_pgEncoding || !d_cnfStream.hasLiteral(node))
+      << "Atom already mapped!";
   Assert(node.getKind() == kind::OR) << "Expecting an OR expression!";
   Assert(node.getNumChildren() > 1) << "Expecting more then 1 child!";
   Assert(!d_cnfStream.d_removable)
@@ -712,52 +797,61 @@ SatLiteral ProofCnfStream::handleOr(TNode node)
   SatClause clause(size + 1);
   for (unsigned i = 0; i < size; ++i)
   {
-    clause[i] = toCNF(node[i]);
+    clause[i] = toCNF(node[i], false, pol);
   }
   // Create literal for the node
-  SatLiteral lit = d_cnfStream.newLiteral(node);
+  SatLiteral lit = d_cnfStream.getOrNewLiteral(node);
   bool added;
   NodeManager* nm = NodeManager::currentNM();
   // lit <- (a_1 | a_2 | a_3 | ... | a_n)
   // lit | ~(a_1 | a_2 | a_3 | ... | a_n)
   // (lit | ~a_1) & (lit | ~a_2) & (lit & ~a_3) & ... & (lit & ~a_n)
-  for (unsigned i = 0; i < size; ++i)
+  if (pol & CnfStream::s_polNeg)
   {
-    added = d_cnfStream.assertClause(node, lit, ~clause[i]);
-    if (added)
+    for (unsigned i = 0; i < size; ++i)
     {
-      Node clauseNode = nm->mkNode(kind::OR, node, node[i].notNode());
-      Node iNode = nm->mkConst<Rational>(i);
-      d_proof.addStep(clauseNode, PfRule::CNF_OR_NEG, {}, {node, iNode});
-      Trace("cnf") << "ProofCnfStream::handleOr: CNF_OR_NEG " << i << " added "
-                   << clauseNode << "\n";
-      normalizeAndRegister(clauseNode);
+      added = d_cnfStream.assertClause(node, lit, ~clause[i]);
+      if (added)
+      {
+        Node clauseNode = nm->mkNode(kind::OR, node, node[i].notNode());
+        Node iNode = nm->mkConst<Rational>(i);
+        addStep(clauseNode, PfRule::CNF_OR_NEG, {}, {node, iNode});
+        Trace("cnf") << "ProofCnfStream::handleOr: CNF_OR_NEG " << i
+                     << " added " << clauseNode << "\n";
+        normalizeAndRegister(clauseNode);
+      }
     }
   }
   // lit -> (a_1 | a_2 | a_3 | ... | a_n)
   // ~lit | a_1 | a_2 | a_3 | ... | a_n
-  clause[size] = ~lit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  added = d_cnfStream.assertClause(node.negate(), clause);
-  if (added)
+  if (pol & CnfStream::s_polPos)
   {
-    std::vector<Node> disjuncts{node.notNode()};
-    for (unsigned i = 0; i < size; ++i)
+    clause[size] = ~lit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    added = d_cnfStream.assertClause(node.negate(), clause);
+    if (added)
     {
-      disjuncts.push_back(node[i]);
+      std::vector<Node> disjuncts{node.notNode()};
+      for (unsigned i = 0; i < size; ++i)
+      {
+        disjuncts.push_back(node[i]);
+      }
+      Node clauseNode = nm->mkNode(kind::OR, disjuncts);
+      addStep(clauseNode, PfRule::CNF_OR_POS, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleOr: CNF_OR_POS added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
     }
-    Node clauseNode = nm->mkNode(kind::OR, disjuncts);
-    d_proof.addStep(clauseNode, PfRule::CNF_OR_POS, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleOr: CNF_OR_POS added " << clauseNode
-                 << "\n";
-    normalizeAndRegister(clauseNode);
   }
+  d_cnfStream.addDefinedPolarity(node, pol);
   return lit;
 }
 
-SatLiteral ProofCnfStream::handleXor(TNode node)
+SatLiteral ProofCnfStream::handleXor(TNode node, uint8_t pol)
 {
-  Assert(!d_cnfStream.hasLiteral(node)) << "Atom already mapped!";
+  Assert(d_cnfStream.d_pgEncoding || !d_cnfStream.hasLiteral(node))
+      << "Atom already mapped!";
   Assert(node.getKind() == kind::XOR) << "Expecting an XOR expression!";
   Assert(node.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_cnfStream.d_removable)
@@ -765,54 +859,62 @@ SatLiteral ProofCnfStream::handleXor(TNode node)
   Trace("cnf") << "ProofCnfStream::handleXor(" << node << ")\n";
   SatLiteral a = toCNF(node[0]);
   SatLiteral b = toCNF(node[1]);
-  SatLiteral lit = d_cnfStream.newLiteral(node);
+  SatLiteral lit = d_cnfStream.getOrNewLiteral(node);
   bool added;
-  added = d_cnfStream.assertClause(node.negate(), a, b, ~lit);
-  if (added)
-  {
-    Node clauseNode = NodeManager::currentNM()->mkNode(
-        kind::OR, node.notNode(), node[0], node[1]);
-    d_proof.addStep(clauseNode, PfRule::CNF_XOR_POS1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_POS1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node.negate(), ~a, ~b, ~lit);
-  if (added)
+  if (pol & CnfStream::s_polPos)
   {
-    Node clauseNode = NodeManager::currentNM()->mkNode(
-        kind::OR, node.notNode(), node[0].notNode(), node[1].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_XOR_POS2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_POS2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node, a, ~b, lit);
-  if (added)
-  {
-    Node clauseNode = NodeManager::currentNM()->mkNode(
-        kind::OR, node, node[0], node[1].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_XOR_NEG2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_NEG2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node.negate(), a, b, ~lit);
+    if (added)
+    {
+      Node clauseNode = NodeManager::currentNM()->mkNode(
+          kind::OR, node.notNode(), node[0], node[1]);
+      addStep(clauseNode, PfRule::CNF_XOR_POS1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_POS1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node.negate(), ~a, ~b, ~lit);
+    if (added)
+    {
+      Node clauseNode = NodeManager::currentNM()->mkNode(
+          kind::OR, node.notNode(), node[0].notNode(), node[1].notNode());
+      addStep(clauseNode, PfRule::CNF_XOR_POS2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_POS2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
-  added = d_cnfStream.assertClause(node, ~a, b, lit);
-  if (added)
+  if (pol & CnfStream::s_polNeg)
   {
-    Node clauseNode = NodeManager::currentNM()->mkNode(
-        kind::OR, node, node[0].notNode(), node[1]);
-    d_proof.addStep(clauseNode, PfRule::CNF_XOR_NEG1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_NEG1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node, a, ~b, lit);
+    if (added)
+    {
+      Node clauseNode = NodeManager::currentNM()->mkNode(
+          kind::OR, node, node[0], node[1].notNode());
+      addStep(clauseNode, PfRule::CNF_XOR_NEG2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_NEG2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node, ~a, b, lit);
+    if (added)
+    {
+      Node clauseNode = NodeManager::currentNM()->mkNode(
+          kind::OR, node, node[0].notNode(), node[1]);
+      addStep(clauseNode, PfRule::CNF_XOR_NEG1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleXor: CNF_XOR_NEG1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
+  d_cnfStream.addDefinedPolarity(node, pol);
   return lit;
 }
 
-SatLiteral ProofCnfStream::handleIff(TNode node)
+SatLiteral ProofCnfStream::handleIff(TNode node, uint8_t pol)
 {
-  Assert(!d_cnfStream.hasLiteral(node)) << "Atom already mapped!";
+  Assert(d_cnfStream.d_pgEncoding || !d_cnfStream.hasLiteral(node))
+      << "Atom already mapped!";
   Assert(node.getKind() == kind::EQUAL) << "Expecting an EQUAL expression!";
   Assert(node.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Trace("cnf") << "handleIff(" << node << ")\n";
@@ -820,112 +922,129 @@ SatLiteral ProofCnfStream::handleIff(TNode node)
   SatLiteral a = toCNF(node[0]);
   SatLiteral b = toCNF(node[1]);
   // Create literal for the node
-  SatLiteral lit = d_cnfStream.newLiteral(node);
+  SatLiteral lit = d_cnfStream.getOrNewLiteral(node);
   bool added;
   NodeManager* nm = NodeManager::currentNM();
   // lit -> ((a-> b) & (b->a))
   // ~lit | ((~a | b) & (~b | a))
   // (~a | b | ~lit) & (~b | a | ~lit)
-  added = d_cnfStream.assertClause(node.negate(), ~a, b, ~lit);
-  if (added)
+  if (pol & CnfStream::s_polPos)
   {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node.notNode(), node[0].notNode(), node[1]);
-    d_proof.addStep(clauseNode, PfRule::CNF_EQUIV_POS1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_POS1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node.negate(), a, ~b, ~lit);
-  if (added)
-  {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node.notNode(), node[0], node[1].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_EQUIV_POS2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_POS2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node.negate(), ~a, b, ~lit);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node.notNode(), node[0].notNode(), node[1]);
+      addStep(clauseNode, PfRule::CNF_EQUIV_POS1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_POS1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node.negate(), a, ~b, ~lit);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node.notNode(), node[0], node[1].notNode());
+      addStep(clauseNode, PfRule::CNF_EQUIV_POS2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_POS2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
   // (a<->b) -> lit
   // ~((a & b) | (~a & ~b)) | lit
   // (~(a & b)) & (~(~a & ~b)) | lit
   // ((~a | ~b) & (a | b)) | lit
   // (~a | ~b | lit) & (a | b | lit)
-  added = d_cnfStream.assertClause(node, ~a, ~b, lit);
-  if (added)
+  if (pol & CnfStream::s_polNeg)
   {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node, node[0].notNode(), node[1].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_EQUIV_NEG2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_NEG2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node, a, b, lit);
-  if (added)
-  {
-    Node clauseNode = nm->mkNode(kind::OR, node, node[0], node[1]);
-    d_proof.addStep(clauseNode, PfRule::CNF_EQUIV_NEG1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_NEG1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node, ~a, ~b, lit);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node, node[0].notNode(), node[1].notNode());
+      addStep(clauseNode, PfRule::CNF_EQUIV_NEG2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_NEG2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node, a, b, lit);
+    if (added)
+    {
+      Node clauseNode = nm->mkNode(kind::OR, node, node[0], node[1]);
+      addStep(clauseNode, PfRule::CNF_EQUIV_NEG1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIff: CNF_EQUIV_NEG1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
+  d_cnfStream.addDefinedPolarity(node, pol);
   return lit;
 }
 
-SatLiteral ProofCnfStream::handleImplies(TNode node)
+SatLiteral ProofCnfStream::handleImplies(TNode node, uint8_t pol)
 {
-  Assert(!d_cnfStream.hasLiteral(node)) << "Atom already mapped!";
+  Assert(d_cnfStream.d_pgEncoding || !d_cnfStream.hasLiteral(node))
+      << "Atom already mapped!";
   Assert(node.getKind() == kind::IMPLIES) << "Expecting an IMPLIES expression!";
   Assert(node.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_cnfStream.d_removable)
       << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "ProofCnfStream::handleImplies(" << node << ")\n";
-  // Convert the children to cnf
-  SatLiteral a = toCNF(node[0]);
-  SatLiteral b = toCNF(node[1]);
-  SatLiteral lit = d_cnfStream.newLiteral(node);
+  // Convert the children to cnf, the antecedent occurs with the opposite
+  // polarity of the node
+  SatLiteral a = toCNF(node[0], false, CnfStream::flipPolarity(pol));
+  SatLiteral b = toCNF(node[1], false, pol);
+  SatLiteral lit = d_cnfStream.getOrNewLiteral(node);
   bool added;
   NodeManager* nm = NodeManager::currentNM();
   // lit -> (a->b)
   // ~lit | ~ a | b
-  added = d_cnfStream.assertClause(node.negate(), ~lit, ~a, b);
-  if (added)
+  if (pol & CnfStream::s_polPos)
   {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node.notNode(), node[0].notNode(), node[1]);
-    d_proof.addStep(clauseNode, PfRule::CNF_IMPLIES_POS, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleImplies: CNF_IMPLIES_POS added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node.negate(), ~lit, ~a, b);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node.notNode(), node[0].notNode(), node[1]);
+      addStep(clauseNode, PfRule::CNF_IMPLIES_POS, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleImplies: CNF_IMPLIES_POS added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
   // (a->b) -> lit
   // ~(~a | b) | lit
   // (a | l) & (~b | l)
-  added = d_cnfStream.assertClause(node, a, lit);
-  if (added)
-  {
-    Node clauseNode = nm->mkNode(kind::OR, node, node[0]);
-    d_proof.addStep(clauseNode, PfRule::CNF_IMPLIES_NEG1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleImplies: CNF_IMPLIES_NEG1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node, ~b, lit);
-  if (added)
+  if (pol & CnfStream::s_polNeg)
   {
-    Node clauseNode = nm->mkNode(kind::OR, node, node[1].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_IMPLIES_NEG2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleImplies: CNF_IMPLIES_NEG2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node, a, lit);
+    if (added)
+    {
+      Node clauseNode = nm->mkNode(kind::OR, node, node[0]);
+      addStep(clauseNode, PfRule::CNF_IMPLIES_NEG1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleImplies: CNF_IMPLIES_NEG1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node, ~b, lit);
+    if (added)
+    {
+      Node clauseNode = nm->mkNode(kind::OR, node, node[1].notNode());
+      addStep(clauseNode, PfRule::CNF_IMPLIES_NEG2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleImplies: CNF_IMPLIES_NEG2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
+  d_cnfStream.addDefinedPolarity(node, pol);
   return lit;
 }
 
-SatLiteral ProofCnfStream::handleIte(TNode node)
+SatLiteral ProofCnfStream::handleIte(TNode node, uint8_t pol)
 {
-  Assert(!d_cnfStream.hasLiteral(node)) << "Atom already mapped!";
+  Assert(d_cnfStream.d_pgEncoding || !d_cnfStream.hasLiteral(node))
+      << "Atom already mapped!";
   Assert(node.getKind() == kind::ITE);
   Assert(node.getNumChildren() == 3);
   Assert(!d_cnfStream.d_removable)
@@ -933,10 +1052,10 @@ SatLiteral ProofCnfStream::handleIte(TNode node)
   Trace("cnf") << "handleIte(" << node[0] << " " << node[1] << " " << node[2]
                << ")\n";
   SatLiteral condLit = toCNF(node[0]);
-  SatLiteral thenLit = toCNF(node[1]);
-  SatLiteral elseLit = toCNF(node[2]);
+  SatLiteral thenLit = toCNF(node[1], false, pol);
+  SatLiteral elseLit = toCNF(node[2], false, pol);
   // create literal to the node
-  SatLiteral lit = d_cnfStream.newLiteral(node);
+  SatLiteral lit = d_cnfStream.getOrNewLiteral(node);
   bool added;
   NodeManager* nm = NodeManager::currentNM();
   // If ITE is true then one of the branches is true and the condition
@@ -945,33 +1064,36 @@ SatLiteral ProofCnfStream::handleIte(TNode node)
   // lit -> (t | e) & (b -> t) & (!b -> e)
   // lit -> (t | e) & (!b | t) & (b | e)
   // (!lit | t | e) & (!lit | !b | t) & (!lit | b | e)
-  added = d_cnfStream.assertClause(node.negate(), ~lit, thenLit, elseLit);
-  if (added)
+  if (pol & CnfStream::s_polPos)
   {
-    Node clauseNode = nm->mkNode(kind::OR, node.notNode(), node[1], node[2]);
-    d_proof.addStep(clauseNode, PfRule::CNF_ITE_POS3, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_POS3 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node.negate(), ~lit, ~condLit, thenLit);
-  if (added)
-  {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node.notNode(), node[0].notNode(), node[1]);
-    d_proof.addStep(clauseNode, PfRule::CNF_ITE_POS1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_POS1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node.negate(), ~lit, condLit, elseLit);
-  if (added)
-  {
-    Node clauseNode = nm->mkNode(kind::OR, node.notNode(), node[0], node[2]);
-    d_proof.addStep(clauseNode, PfRule::CNF_ITE_POS2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_POS2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node.negate(), ~lit, thenLit, elseLit);
+    if (added)
+    {
+      Node clauseNode = nm->mkNode(kind::OR, node.notNode(), node[1], node[2]);
+      addStep(clauseNode, PfRule::CNF_ITE_POS3, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_POS3 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node.negate(), ~lit, ~condLit, thenLit);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node.notNode(), node[0].notNode(), node[1]);
+      addStep(clauseNode, PfRule::CNF_ITE_POS1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_POS1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node.negate(), ~lit, condLit, elseLit);
+    if (added)
+    {
+      Node clauseNode = nm->mkNode(kind::OR, node.notNode(), node[0], node[2]);
+      addStep(clauseNode, PfRule::CNF_ITE_POS2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_POS2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
   // If ITE is false then one of the branches is false and the condition
   // implies which one
@@ -979,35 +1101,39 @@ SatLiteral ProofCnfStream::handleIte(TNode node)
   // !lit -> (!t | !e) & (b -> !t) & (!b -> !e)
   // !lit -> (!t | !e) & (!b | !t) & (b | !e)
   // (lit | !t | !e) & (lit | !b | !t) & (lit | b | !e)
-  added = d_cnfStream.assertClause(node, lit, ~thenLit, ~elseLit);
-  if (added)
+  if (pol & CnfStream::s_polNeg)
   {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node, node[1].notNode(), node[2].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_ITE_NEG3, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_NEG3 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node, lit, ~condLit, ~thenLit);
-  if (added)
-  {
-    Node clauseNode =
-        nm->mkNode(kind::OR, node, node[0].notNode(), node[1].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_ITE_NEG1, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_NEG1 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
-  }
-  added = d_cnfStream.assertClause(node, lit, condLit, ~elseLit);
-  if (added)
-  {
-    Node clauseNode = nm->mkNode(kind::OR, node, node[0], node[2].notNode());
-    d_proof.addStep(clauseNode, PfRule::CNF_ITE_NEG2, {}, {node});
-    Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_NEG2 added "
-                 << clauseNode << "\n";
-    normalizeAndRegister(clauseNode);
+    added = d_cnfStream.assertClause(node, lit, ~thenLit, ~elseLit);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node, node[1].notNode(), node[2].notNode());
+      addStep(clauseNode, PfRule::CNF_ITE_NEG3, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_NEG3 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node, lit, ~condLit, ~thenLit);
+    if (added)
+    {
+      Node clauseNode =
+          nm->mkNode(kind::OR, node, node[0].notNode(), node[1].notNode());
+      addStep(clauseNode, PfRule::CNF_ITE_NEG1, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_NEG1 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
+    added = d_cnfStream.assertClause(node, lit, condLit, ~elseLit);
+    if (added)
+    {
+      Node clauseNode = nm->mkNode(kind::OR, node, node[0], node[2].notNode());
+      addStep(clauseNode, PfRule::CNF_ITE_NEG2, {}, {node});
+      Trace("cnf") << "ProofCnfStream::handleIte: CNF_ITE_NEG2 added "
+                   << clauseNode << "\n";
+      normalizeAndRegister(clauseNode);
+    }
   }
+  d_cnfStream.addDefinedPolarity(node, pol);
   return lit;
 }
 
@@ -18,6 +18,7 @@
 #define CVC4__PROP__PROOF_CNF_STREAM_H
 
 #include "context/cdhashmap.h"
+#include "expr/compact_proof.h"
 #include "expr/lazy_proof.h"
 #include "expr/node.h"
 #include "expr/proof_node.h"
@@ -129,17 +130,30 @@ class ProofCnfStream : public ProofGenerator
    * @return the literal representing the root of the formula
    */
   SatLiteral toCNF(TNode node, bool negated = false);
+  /**
+   * Same as above, where pol is the polarity with which node occurs, which is
+   * only used with the polarity-aware encoding (see
+   * CnfStream::enablePolarityEncoding()).
+   */
+  SatLiteral toCNF(TNode node, bool negated, uint8_t pol);
   /**
    * Specific clausifiers, based on the formula kinds, that clausify a formula,
    * by calling toCNF into each of the formula's children under the respective
-   * kind, and introduce a literal definitionally equal to it. */
+   * kind, and introduce a literal definitionally equal to it. With the
+   * polarity-aware encoding, only the directions of the definition in pol
+   * are encoded, each clause being justified by its CNF_* rule. */
   SatLiteral handleNot(TNode node);
-  SatLiteral handleXor(TNode node);
-  SatLiteral handleImplies(TNode node);
-  SatLiteral handleIff(TNode node);
-  SatLiteral handleIte(TNode node);
-  SatLiteral handleAnd(TNode node);
-  SatLiteral handleOr(TNode node);
+  SatLiteral handleXor(TNode node, uint8_t pol);
+  SatLiteral handleImplies(TNode node, uint8_t pol);
+  SatLiteral handleIff(TNode node, uint8_t pol);
+  SatLiteral handleIte(TNode node, uint8_t pol);
+  SatLiteral handleAnd(TNode node, uint8_t pol);
+  SatLiteral handleOr(TNode node, uint8_t pol);
+  /**
+   * Encode the directions in pol of the definition of the literal of node
+   * that are missing, and return that literal.
+   */
+  SatLiteral completeDefinition(TNode node, uint8_t pol);
 
   /** Normalizes a clause node and registers it in the SAT proof manager.
    *
@@ -151,6 +165,18 @@ class ProofCnfStream : public ProofGenerator
    * above normalizations on all added clauses.
    */
   void normalizeAndRegister(TNode clauseNode);
+  /** Add step to the proof object in use */
+  void addStep(Node expected,
+               PfRule id,
+               const std::vector<Node>& children,
+               const std::vector<Node>& args);
+  /** Add step to the proof object in use */
+  void addStep(Node expected, const ProofStep& step);
+  /**
+   * Add step by generator pg, which is expected to provide a closed proof,
+   * to the proof object in use.
+   */
+  void addLazyStep(Node expected, ProofGenerator* pg, const char* ctx);
   /** Reference to the underlying cnf stream. */
   CnfStream& d_cnfStream;
   /** The proof manager of underlying SAT solver associated with this stream. */
@@ -159,6 +185,13 @@ class ProofCnfStream : public ProofGenerator
   ProofNodeManager* d_pnm;
   /** The user-context-dependent proof object. */
   LazyCDProof d_proof;
+  /**
+   * The user-context-dependent compact proof object, which is used instead of
+   * d_proof if proofCompactCnf is true.
+   */
+  CompactProof d_compactProof;
+  /** Whether to use d_compactProof */
+  bool d_compact;
   /** An accumulator of steps that may be applied to normalize the clauses
    * generated during clausification. */
   theory::TheoryProofStepBuffer d_psb;
@@ -16,18 +16,23 @@
 
 #include "prop/prop_engine.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "base/check.h"
 #include "base/output.h"
 #include "decision/decision_engine.h"
+#include "expr/node_algorithm.h"
 #include "options/base_options.h"
 #include "options/decision_options.h"
 #include "options/main_options.h"
 #include "options/options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/proof_manager.h"
 #include "prop/cnf_stream.h"
@@ -89,7 +94,15 @@ PropEngine::PropEngine(TheoryEngine* te,
   d_decisionEngine.reset(new DecisionEngine(satContext, userContext, rm));
   d_decisionEngine->init();  // enable appropriate strategies
 
-  d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  if (options::cdcltSatSolver() == options::CDCLTSatSolverMode::CADICAL)
+  {
+    Assert(pnm == nullptr && !options::unsatCores());
+    d_satSolver = SatSolverFactory::createCDCLTCadical(smtStatisticsRegistry());
+  }
+  else
+  {
+    d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  }
 
   // CNF stream and theory proxy required pointers to each other, make the
   // theory proxy first
@@ -106,6 +119,17 @@ PropEngine::PropEngine(TheoryEngine* te,
                               rm,
                               FormulaLitPolicy::TRACK);
 
+  if (options::cnfGateSimp() && pnm == nullptr && !options::unsatCores()
+      && !options::unsatCoresAssumptions())
+  {
+    d_cnfStream->enableGateSimplification();
+  }
+  else if (options::cnfPolarity()
+           && options::decisionMode() == options::DecisionMode::INTERNAL)
+  {
+    d_cnfStream->enablePolarityEncoding();
+  }
+
   // connect theory proxy
   d_theoryProxy->finishInit(d_cnfStream);
   // connect SAT solver
@@ -201,6 +225,41 @@ void PropEngine::assertLemma(theory::TrustNode tlemma, theory::LemmaProperty p)
   // call preprocessor
   std::vector<theory::TrustNode> ppLemmas;
   std::vector<Node> ppSkolems;
+  theory::TrustNode tplemma =
+      preprocessLemmaInternal(tlemma, ppLemmas, ppSkolems);
+
+  // now, assert the lemmas
+  assertLemmasInternal(tplemma, ppLemmas, ppSkolems, removable);
+}
+
+void PropEngine::assertLemmas(
+    const std::vector<std::pair<theory::TrustNode, theory::LemmaProperty>>&
+        lems)
+{
+  // preprocess all lemmas first, so that the CNF conversion of the batch is
+  // not interleaved with preprocessing
+  size_t nlems = lems.size();
+  std::vector<theory::TrustNode> tplemmas(nlems);
+  std::vector<std::vector<theory::TrustNode>> ppLemmas(nlems);
+  std::vector<std::vector<Node>> ppSkolems(nlems);
+  for (size_t i = 0; i < nlems; ++i)
+  {
+    tplemmas[i] =
+        preprocessLemmaInternal(lems[i].first, ppLemmas[i], ppSkolems[i]);
+  }
+  // now, assert the lemmas
+  for (size_t i = 0; i < nlems; ++i)
+  {
+    bool removable = isLemmaPropertyRemovable(lems[i].second);
+    assertLemmasInternal(tplemmas[i], ppLemmas[i], ppSkolems[i], removable);
+  }
+}
+
+theory::TrustNode PropEngine::preprocessLemmaInternal(
+    theory::TrustNode tlemma,
+    std::vector<theory::TrustNode>& ppLemmas,
+    std::vector<Node>& ppSkolems)
+{
   theory::TrustNode tplemma =
       d_theoryProxy->preprocessLemma(tlemma, ppLemmas, ppSkolems);
 
@@ -228,9 +287,7 @@ void PropEngine::assertLemma(theory::TrustNode tlemma, theory::LemmaProperty p)
                         << " (skolem is " << ppSkolems[i] << ")" << std::endl;
     }
   }
-
-  // now, assert the lemmas
-  assertLemmasInternal(tplemma, ppLemmas, ppSkolems, removable);
+  return tplemma;
 }
 
 void PropEngine::assertTrustedLemmaInternal(theory::TrustNode trn,
@@ -326,10 +383,35 @@ void PropEngine::printSatisfyingAssignment(){
   }
 }
 
-Result PropEngine::checkSat() {
+Result PropEngine::checkSat() { return checkSat(std::vector<Node>()); }
+
+void PropEngine::getUnsatAssumptions(std::vector<Node>& unsatAssumptions)
+{
+  std::vector<SatLiteral> lits;
+  d_satSolver->getUnsatAssumptions(lits);
+  for (const SatLiteral& lit : lits)
+  {
+    unsatAssumptions.push_back(d_cnfStream->getNode(lit));
+  }
+}
+
+Result PropEngine::checkSat(const std::vector<Node>& assumptions)
+{
   Assert(!d_inCheckSat) << "Sat solver in solve()!";
   Debug("prop") << "PropEngine::checkSat()" << std::endl;
 
+  // get the literals of the assumptions
+  std::vector<SatLiteral> assumptionLits;
+  for (const Node& a : assumptions)
+  {
+    Node pa = ensureLiteral(a);
+    bool negated = pa.getKind() == kind::NOT;
+    SatLiteral lit = d_cnfStream->getLiteral(negated ? pa[0] : pa);
+    Trace("prop-assumptions") << "Assumption " << a << " has literal "
+                              << (negated ? ~lit : lit) << std::endl;
+    assumptionLits.push_back(negated ? ~lit : lit);
+  }
+
   // Mark that we are in the checkSat
   ScopedBool scopedBool(d_inCheckSat);
   d_inCheckSat = true;
@@ -345,13 +427,24 @@ Result PropEngine::checkSat() {
   d_interrupted = false;
 
   // Check the problem
-  SatValue result = d_satSolver->solve();
+  SatValue result;
+  if (!assumptionLits.empty())
+  {
+    Assert(options::cubeDepth() == 0);
+    result = d_satSolver->solve(assumptionLits);
+  }
+  else
+  {
+    result = options::cubeDepth() > 0 ? solveCube() : d_satSolver->solve();
+  }
 
   if( result == SAT_VALUE_UNKNOWN ) {
 
     Result::UnknownExplanation why = Result::INTERRUPTED;
     if (d_resourceManager->outOfTime())
       why = Result::TIMEOUT;
+    if (d_resourceManager->outOfMemory())
+      why = Result::MEMOUT;
     if (d_resourceManager->outOfResources())
       why = Result::RESOURCEOUT;
 
@@ -369,6 +462,60 @@ Result PropEngine::checkSat() {
   return Result(result == SAT_VALUE_TRUE ? Result::SAT : Result::UNSAT);
 }
 
+SatValue PropEngine::solveCube()
+{
+  unsigned long budget = options::cubeWarmupConflicts();
+  if (budget > 0)
+  {
+    SatValue result = d_satSolver->solve(budget);
+    if (result != SAT_VALUE_UNKNOWN || d_interrupted
+        || d_resourceManager->out())
+    {
+      return result;
+    }
+  }
+  // collect the unassigned theory atoms, ranked by their activity and, for
+  // determinism, by their variable
+  std::vector<std::pair<double, SatVariable>> atoms;
+  for (const auto& p : d_cnfStream->getTranslationCache())
+  {
+    TNode n = p.first;
+    Kind k = n.getKind();
+    if (n.isVar() || n.isConst() || k == kind::NOT || k == kind::AND
+        || k == kind::OR || k == kind::XOR || k == kind::IMPLIES
+        || k == kind::ITE || (k == kind::EQUAL && n[0].getType().isBoolean()))
+    {
+      continue;
+    }
+    SatLiteral lit = p.second;
+    if (lit.isNegated() || d_satSolver->value(lit) != SAT_VALUE_UNKNOWN)
+    {
+      continue;
+    }
+    SatVariable v = lit.getSatVariable();
+    atoms.emplace_back(-d_satSolver->getActivity(v), v);
+  }
+  std::sort(atoms.begin(), atoms.end());
+  size_t depth = std::min<size_t>(options::cubeDepth(), atoms.size());
+  unsigned index = options::cubeIndex();
+  std::vector<SatLiteral> cube;
+  for (size_t i = 0; i < depth; i++)
+  {
+    bool negated = ((index >> i) & 1) == 0;
+    cube.emplace_back(atoms[i].second, negated);
+    Trace("prop-cube") << "PropEngine::solveCube: splitting atom "
+                       << d_cnfStream->getNode(SatLiteral(atoms[i].second))
+                       << (negated ? " (negated)" : "") << std::endl;
+  }
+  if (depth < options::cubeDepth() && (index >> depth) != 0)
+  {
+    // fewer splitting atoms than requested, the cubes that are out of range
+    // are duplicates of cubes solved by others and hence trivially refuted
+    return SAT_VALUE_FALSE;
+  }
+  return d_satSolver->solve(cube);
+}
+
 Node PropEngine::getValue(TNode node) const
 {
   Assert(node.getType().isBoolean());
@@ -427,6 +574,56 @@ void PropEngine::getBooleanVariables(std::vector<TNode>& outputVariables) const
   d_cnfStream->getBooleanVariables(outputVariables);
 }
 
+bool PropEngine::supportsLearnedClauses() const
+{
+  return d_satSolver->supportsLearnedClauses();
+}
+
+void PropEngine::getLearnedClauses(std::vector<Node>& clauses,
+                                   uint32_t maxSize,
+                                   uint32_t maxLbd)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::unordered_set<Kind, kind::KindHashFunction> nonInput = {
+      kind::SKOLEM, kind::BOOLEAN_TERM_VARIABLE};
+  std::vector<SatClause> satClauses;
+  d_satSolver->getLearnedClauses(satClauses, maxSize, maxLbd);
+  for (const SatClause& sc : satClauses)
+  {
+    std::vector<Node> lits;
+    bool keep = true;
+    for (const SatLiteral& l : sc)
+    {
+      TNode n = d_cnfStream->getNode(l);
+      TNode atom = n.getKind() == kind::NOT ? n[0] : n;
+      if (atom.isConst())
+      {
+        // drop false literals, and clauses with true literals
+        if ((n.getKind() == kind::NOT) != atom.getConst<bool>())
+        {
+          keep = false;
+          break;
+        }
+        continue;
+      }
+      if (atom.isVar() ? atom.getKind() != kind::VARIABLE
+                       : (theory::Theory::theoryOf(atom) == theory::THEORY_BOOL
+                          || expr::hasSubtermKinds(nonInput, atom)))
+      {
+        keep = false;
+        break;
+      }
+      lits.push_back(n);
+    }
+    if (keep && !lits.empty())
+    {
+      clauses.push_back(lits.size() == 1 ? lits[0] : nm->mkNode(kind::OR, lits));
+    }
+  }
+  Trace("prop-learned") << "Exported " << clauses.size() << " of "
+                        << satClauses.size() << " learned clauses" << std::endl;
+}
+
 Node PropEngine::ensureLiteral(TNode n)
 {
   // must preprocess
@@ -456,6 +653,30 @@ Node PropEngine::getPreprocessedTerm(TNode n)
   return tpn.isNull() ? Node(n) : tpn.getNode();
 }
 
+bool PropEngine::addCardinalityConstraint(const std::vector<Node>& lits,
+                                          const std::vector<uint64_t>& weights,
+                                          uint64_t bound)
+{
+  Assert(lits.size() == weights.size());
+  if (isProofEnabled())
+  {
+    return false;
+  }
+  std::vector<SatLiteral> satLits;
+  for (const Node& lit : lits)
+  {
+    bool pol = lit.getKind() != kind::NOT;
+    Node atom = pol ? lit : lit[0];
+    Assert(atom.isVar() && atom.getType().isBoolean());
+    d_cnfStream->ensureLiteral(atom);
+    SatLiteral l = d_cnfStream->getLiteral(atom);
+    satLits.push_back(pol ? l : ~l);
+  }
+  Trace("prop") << "addCardinalityConstraint: " << lits.size()
+                << " literals, bound " << bound << std::endl;
+  return d_satSolver->addCardinalityConstraint(satLits, weights, bound);
+}
+
 Node PropEngine::getPreprocessedTerm(TNode n,
                                      std::vector<Node>& skAsserts,
                                      std::vector<Node>& sks)
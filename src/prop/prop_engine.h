@@ -21,8 +21,12 @@
 #ifndef CVC4__PROP_ENGINE_H
 #define CVC4__PROP_ENGINE_H
 
+#include <utility>
+#include <vector>
+
 #include "context/cdlist.h"
 #include "expr/node.h"
+#include "prop/sat_solver_types.h"
 #include "theory/output_channel.h"
 #include "theory/trust_node.h"
 #include "util/result.h"
@@ -150,6 +154,17 @@ class PropEngine
    */
   void assertLemma(theory::TrustNode tlemma, theory::LemmaProperty p);
 
+  /**
+   * Same as calling assertLemma on each of the given lemmas in order, except
+   * that all lemmas are preprocessed before any of them is converted to CNF
+   * and asserted to the SAT solver.
+   *
+   * @param lems the lemmas and their properties
+   */
+  void assertLemmas(
+      const std::vector<std::pair<theory::TrustNode, theory::LemmaProperty>>&
+          lems);
+
   /**
    * If ever n is decided upon, it must be in the given phase.  This
    * occurs *globally*, i.e., even if the literal is untranslated by
@@ -173,6 +188,25 @@ class PropEngine
    *
    */
   Result checkSat();
+  /**
+   * Checks the current context for satisfiability under the given
+   * assumptions, which are passed to the SAT solver as assumption literals
+   * instead of being asserted. Theory preprocessing is applied to the
+   * assumptions.
+   *
+   * @param assumptions the assumptions, which are Boolean formulas
+   */
+  Result checkSat(const std::vector<Node>& assumptions);
+  /**
+   * Get the assumptions of the last call to checkSat with assumptions that
+   * are sufficient for its unsatisfiability, i.e. the literals of the given
+   * assumptions that occur in the final conflict of the SAT solver. This can
+   * only be called if that call was unsatisfiable.
+   *
+   * @param unsatAssumptions The vector to add the literals of the assumptions
+   * to
+   */
+  void getUnsatAssumptions(std::vector<Node>& unsatAssumptions);
 
   /**
    * Get the value of a boolean variable.
@@ -197,6 +231,21 @@ class PropEngine
    */
   void getBooleanVariables(std::vector<TNode>& outputVariables) const;
 
+  /** Whether the SAT solver supports getLearnedClauses() */
+  bool supportsLearnedClauses() const;
+
+  /**
+   * Get the clauses learned by the SAT solver with at most maxSize literals
+   * and literal block distance at most maxLbd (where 0 means no bound), as
+   * disjunctions of literals over the input symbols. Learned clauses with
+   * literals that do not correspond to such atoms, e.g. the literals of
+   * non-atomic formulas or of atoms containing skolems, are omitted, so that
+   * the returned clauses can be added to other solvers for the same input.
+   */
+  void getLearnedClauses(std::vector<Node>& clauses,
+                         uint32_t maxSize,
+                         uint32_t maxLbd);
+
   /**
    * Ensure that the given node will have a designated SAT literal
    * that is definitionally equal to it. Note that theory preprocessing is
@@ -229,6 +278,18 @@ class PropEngine
                            std::vector<Node>& skAsserts,
                            std::vector<Node>& sks);
 
+  /**
+   * Add the pseudo-Boolean constraint that the sum of the weights of the true
+   * literals of lits is at most bound to the SAT solver, which propagates it
+   * natively. The literals must be Boolean variables or their negations, and
+   * the weights must be positive. Returns false if the SAT solver does not
+   * support such constraints or proofs are enabled, in which case the
+   * constraint is not added.
+   */
+  bool addCardinalityConstraint(const std::vector<Node>& lits,
+                                const std::vector<uint64_t>& weights,
+                                uint64_t bound);
+
   /**
    * Push the context level.
    */
@@ -301,6 +362,20 @@ class PropEngine
   /** Dump out the satisfying assignment (after SAT result) */
   void printSatisfyingAssignment();
 
+  /**
+   * Solve a single cube of the current problem (--cube-depth=N). This runs a
+   * warm-up search bounded by --cube-warmup-conflicts, which may already
+   * decide the problem. Otherwise, it selects the N most active unassigned
+   * theory atoms as splitting atoms and solves under the assumptions given by
+   * cube number --cube-index, whose bit i is the polarity of the i-th
+   * splitting atom. The selection is deterministic, so that solvers that run
+   * the same input with the same options agree on the splitting atoms.
+   *
+   * Note that a SAT_VALUE_FALSE after the warm-up search only refutes the
+   * selected cube.
+   */
+  SatValue solveCube();
+
   /**
    * Converts the given formula to CNF and asserts the CNF to the SAT solver.
    * The formula can be removed by the SAT solver after backtracking lower
@@ -325,6 +400,15 @@ class PropEngine
                       bool removable,
                       bool input,
                       ProofGenerator* pg = nullptr);
+  /**
+   * Preprocess the lemma tlemma, returning the preprocessed lemma, where the
+   * skolem definitions and skolems introduced by preprocessing are added to
+   * ppLemmas and ppSkolems.
+   */
+  theory::TrustNode preprocessLemmaInternal(
+      theory::TrustNode tlemma,
+      std::vector<theory::TrustNode>& ppLemmas,
+      std::vector<Node>& ppSkolems);
   /**
    * Assert lemmas internal, where trn is a trust node corresponding to a
    * formula to assert to the CNF stream, ppLemmas and ppSkolems are the
@@ -169,6 +169,40 @@ class CDCLTSatSolverInterface : public SatSolver
 
   virtual bool isDecision(SatVariable decn) const = 0;
 
+  /**
+   * Return the branching activity of the given variable. Variables with a
+   * higher activity were involved in more (recent) conflicts.
+   */
+  virtual double getActivity(SatVariable var) const = 0;
+
+  /** Whether this solver implements getLearnedClauses() */
+  virtual bool supportsLearnedClauses() const = 0;
+
+  /**
+   * Get the learned clauses of this solver with at most maxSize literals and
+   * literal block distance (the number of distinct decision levels of their
+   * literals when they were learned) at most maxLbd, where 0 means no bound.
+   * This includes the learned units. Solvers that do not support this, see
+   * supportsLearnedClauses(), add no clauses.
+   */
+  virtual void getLearnedClauses(std::vector<SatClause>& clauses,
+                                 uint32_t maxSize,
+                                 uint32_t maxLbd) = 0;
+
+  /**
+   * Add the pseudo-Boolean constraint that the sum of the weights of the true
+   * literals of lits is at most bound, where all weights are positive, which
+   * the solver propagates natively rather than by clauses. Returns false if
+   * the solver does not support such constraints, in which case the
+   * constraint is not added.
+   */
+  virtual bool addCardinalityConstraint(const std::vector<SatLiteral>& lits,
+                                        const std::vector<uint64_t>& weights,
+                                        uint64_t bound)
+  {
+    return false;
+  }
+
   virtual std::shared_ptr<ProofNode> getProof() = 0;
 
 }; /* class CDCLTSatSolverInterface */
@@ -39,6 +39,16 @@ MinisatSatSolver* SatSolverFactory::createCDCLTMinisat(
   return new MinisatSatSolver(registry);
 }
 
+CDCLTSatSolverInterface* SatSolverFactory::createCDCLTCadical(
+    StatisticsRegistry* registry)
+{
+#ifdef CVC4_USE_CADICAL
+  return new CDCLTCadicalSolver(registry);
+#else
+  Unreachable() << "CVC4 was not compiled with CaDiCaL support.";
+#endif
+}
+
 SatSolver* SatSolverFactory::createCryptoMinisat(StatisticsRegistry* registry,
                                                  const std::string& name)
 {
@@ -18,6 +18,7 @@
 
 #include "context/context.h"
 #include "decision/decision_engine.h"
+#include "expr/node_manager.h"
 #include "options/decision_options.h"
 #include "options/smt_options.h"
 #include "proof/cnf_proof.h"
@@ -173,6 +174,8 @@ TNode TheoryProxy::getNode(SatLiteral lit) {
 void TheoryProxy::notifyRestart() {
   d_propEngine->spendResource(ResourceManager::Resource::RestartStep);
   d_theoryEngine->notifyRestart();
+  // restarts are a good point to reclaim unused nodes incrementally
+  NodeManager::currentNM()->reclaimZombiesSlice();
 }
 
 void TheoryProxy::spendResource(ResourceManager::Resource r)
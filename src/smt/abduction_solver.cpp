@@ -16,6 +16,7 @@
 
 #include <sstream>
 
+#include "expr/node_algorithm.h"
 #include "options/smt_options.h"
 #include "smt/smt_engine.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
@@ -48,6 +49,11 @@ bool AbductionSolver::getAbduct(const Node& goal,
   // now negate
   conjn = conjn.negate();
   d_abdConj = conjn;
+  if (options::abductsReuse()
+      && getPreviousAbduct(axioms, grammarType, conjn, abd))
+  {
+    return true;
+  }
   asserts.push_back(conjn);
   std::string name("A");
   Node aconj = quantifiers::SygusAbduct::mkAbductionConjecture(
@@ -115,6 +121,10 @@ bool AbductionSolver::getAbductInternal(Node& abd)
         syms.push_back(bv.hasAttribute(sta) ? bv.getAttribute(sta) : bv);
       }
       abd = abd.substitute(vars.begin(), vars.end(), syms.begin(), syms.end());
+      if (options::abductsReuse())
+      {
+        d_prevAbducts.push_back(abd);
+      }
 
       // if check abducts option is set, we check the correctness
       if (options::checkAbducts())
@@ -130,6 +140,70 @@ bool AbductionSolver::getAbductInternal(Node& abd)
   return false;
 }
 
+bool AbductionSolver::getPreviousAbduct(const std::vector<Node>& axioms,
+                                        const TypeNode& grammarType,
+                                        const Node& conjn,
+                                        Node& abd)
+{
+  if (d_prevChecker == nullptr || axioms != d_prevAxioms
+      || grammarType != d_prevGrammarType)
+  {
+    Trace("sygus-abduct") << "SmtEngine::getAbduct: discard "
+                          << d_prevAbducts.size() << " previous abducts"
+                          << std::endl;
+    d_prevAxioms = axioms;
+    d_prevGrammarType = grammarType;
+    d_prevAbducts.clear();
+    initializeSubsolver(d_prevChecker);
+    d_prevChecker->setOption("incremental", "true");
+    for (const Node& a : axioms)
+    {
+      d_prevChecker->assertFormula(a);
+    }
+    return false;
+  }
+  // the free symbols of an abduct must occur in the problem
+  std::unordered_set<Node, NodeHashFunction> syms;
+  expr::getSymbols(conjn, syms);
+  for (const Node& a : axioms)
+  {
+    expr::getSymbols(a, syms);
+  }
+  // the most recent abducts are tried first
+  for (size_t i = d_prevAbducts.size(); i > 0; i--)
+  {
+    Node c = d_prevAbducts[i - 1];
+    std::unordered_set<Node, NodeHashFunction> csyms;
+    expr::getSymbols(c, csyms);
+    bool symsValid = true;
+    for (const Node& s : csyms)
+    {
+      if (syms.find(s) == syms.end())
+      {
+        symsValid = false;
+        break;
+      }
+    }
+    // c must be consistent with the assertions, and imply the goal
+    if (!symsValid
+        || d_prevChecker->checkSat(c).asSatisfiabilityResult().isSat()
+               != Result::SAT)
+    {
+      continue;
+    }
+    std::vector<Node> query{c, conjn};
+    if (d_prevChecker->checkSat(query).asSatisfiabilityResult().isSat()
+        == Result::UNSAT)
+    {
+      Trace("sygus-abduct") << "SmtEngine::getAbduct: reuse " << c
+                            << std::endl;
+      abd = c;
+      return true;
+    }
+  }
+  return false;
+}
+
 void AbductionSolver::checkAbduct(Node a)
 {
   Assert(a.getType().isBoolean());
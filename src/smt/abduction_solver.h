@@ -83,6 +83,17 @@ class AbductionSolver
    * problems.
    */
   bool getAbductInternal(Node& abd);
+  /**
+   * Get a previous abduct for the goal conjn (negated), if abductsReuse is
+   * true. The abducts of previous calls are reused only if the assertions
+   * axioms and the grammar type are the same as in these calls, otherwise
+   * they are discarded. If this method returns true, abd is set to an abduct
+   * for the current problem.
+   */
+  bool getPreviousAbduct(const std::vector<Node>& axioms,
+                         const TypeNode& grammarType,
+                         const Node& conjn,
+                         Node& abd);
   /** The parent SMT engine */
   SmtEngine* d_parent;
   /** The SMT engine subsolver
@@ -112,6 +123,17 @@ class AbductionSolver
    * for. This is used for the get-abduct command.
    */
   Node d_sssf;
+  /** The assertions for which the abducts in d_prevAbducts were found */
+  std::vector<Node> d_prevAxioms;
+  /** The grammar type for which the abducts in d_prevAbducts were found */
+  TypeNode d_prevGrammarType;
+  /** The abducts found by previous calls, if abductsReuse is true */
+  std::vector<Node> d_prevAbducts;
+  /**
+   * An incremental SMT engine with d_prevAxioms asserted, used for checking
+   * whether an abduct in d_prevAbducts is an abduct for a new goal.
+   */
+  std::unique_ptr<SmtEngine> d_prevChecker;
 };
 
 }  // namespace smt
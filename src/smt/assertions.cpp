@@ -35,6 +35,8 @@ Assertions::Assertions(context::UserContext* u, AbstractValues& absv)
       d_absValues(absv),
       d_assertionList(nullptr),
       d_globalNegation(false),
+      d_selectors(u),
+      d_selectedFormulas(u),
       d_assertions()
 {
 }
@@ -70,7 +72,8 @@ void Assertions::clearCurrent()
 
 void Assertions::initializeCheckSat(const std::vector<Node>& assumptions,
                                     bool inUnsatCore,
-                                    bool isEntailmentCheck)
+                                    bool isEntailmentCheck,
+                                    bool assertAssumptions)
 {
   NodeManager* nm = NodeManager::currentNM();
   // reset global negation
@@ -98,13 +101,20 @@ void Assertions::initializeCheckSat(const std::vector<Node>& assumptions,
   }
 
   Result r(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
-  for (const Node& e : d_assumptions)
+  for (Node& e : d_assumptions)
   {
     // Substitute out any abstract values in ex.
     Node n = d_absValues.substituteAbstractValues(e);
     // Ensure expr is type-checked at this point.
     ensureBoolean(n);
-    addFormula(n, inUnsatCore, true, true, false);
+    if (assertAssumptions)
+    {
+      addFormula(n, inUnsatCore, true, true, false);
+    }
+    else
+    {
+      e = n;
+    }
   }
   if (d_globalDefineFunRecLemmas != nullptr)
   {
@@ -194,10 +204,35 @@ void Assertions::addFormula(
     }
   }
 
+  if (inInput && options::unsatCoresAssumptions())
+  {
+    // guard the input formula with a selector
+    NodeManager* nm = NodeManager::currentNM();
+    Node s = nm->mkSkolem(
+        "sel", nm->booleanType(), "selector of an input formula");
+    d_selectors.push_back(s);
+    d_selectedFormulas.insert(s, n);
+    d_assertions.push_back(nm->mkNode(IMPLIES, s, n), isAssumption, true);
+    return;
+  }
+
   // Add the normalized formula to the queue
   d_assertions.push_back(n, isAssumption, true);
 }
 
+const context::CDList<Node>& Assertions::getSelectors() const
+{
+  return d_selectors;
+}
+
+Node Assertions::getSelectedFormula(const Node& s) const
+{
+  context::CDHashMap<Node, Node, NodeHashFunction>::const_iterator it =
+      d_selectedFormulas.find(s);
+  Assert(it != d_selectedFormulas.end());
+  return (*it).second;
+}
+
 void Assertions::addDefineFunRecDefinition(Node n, bool global)
 {
   n = d_absValues.substituteAbstractValues(n);
@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "context/cdhashmap.h"
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "preprocessing/assertion_pipeline.h"
@@ -64,10 +65,13 @@ class Assertions
    * @param inUnsatCore Whether assumptions are in the unsat core.
    * @param isEntailmentCheck Whether we are checking entailment of assumptions
    * in the upcoming check-sat call.
+   * @param assertAssumptions Whether the assumptions are added to the
+   * assertions. If not, they are only stored in the list of assumptions.
    */
   void initializeCheckSat(const std::vector<Node>& assumptions,
                           bool inUnsatCore,
-                          bool isEntailmentCheck);
+                          bool isEntailmentCheck,
+                          bool assertAssumptions);
   /**
    * Add a formula to the current context: preprocess, do per-theory
    * setup, use processAssertionList(), asserting to T-solver for
@@ -108,6 +112,15 @@ class Assertions
   bool isGlobalNegated() const;
   /** Flip the global negation flag. */
   void flipGlobalNegated();
+  /**
+   * Get the selectors of the input formulas, which are only used with
+   * unsatCoresAssumptions. In that mode, each input formula F is asserted as
+   * (=> s F) for a fresh Boolean variable s, its selector, and the selectors
+   * are assumed when checking satisfiability.
+   */
+  const context::CDList<Node>& getSelectors() const;
+  /** Get the input formula whose selector is s */
+  Node getSelectedFormula(const Node& s) const;
 
   //------------------------------------ for proofs
   /** Set proof generator */
@@ -167,6 +180,10 @@ class Assertions
   std::vector<Node> d_assumptions;
   /** Whether we did a global negation of the formula. */
   bool d_globalNegation;
+  /** The selectors of the input formulas */
+  context::CDList<Node> d_selectors;
+  /** Maps the selectors to their input formula */
+  context::CDHashMap<Node, Node, NodeHashFunction> d_selectedFormulas;
   /** Assertions in the preprocessing pipeline */
   preprocessing::AssertionPipeline d_assertions;
 };
@@ -0,0 +1,166 @@
+/*********************                                                        */
+/*! \file async_ostream.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An output stream that writes to another one in a background thread
+ **/
+
+#include "smt/async_ostream.h"
+
+#include "base/check.h"
+
+namespace cvc5 {
+
+AsyncOstreamBuf::AsyncOstreamBuf(std::ostream* out,
+                                 size_t chunkSize,
+                                 size_t maxQueued)
+    : d_out(out),
+      d_chunkSize(chunkSize),
+      d_maxQueued(maxQueued),
+      d_chunk(chunkSize),
+      d_queuedBytes(0),
+      d_closed(false)
+{
+  Assert(d_out != nullptr);
+  Assert(d_chunkSize > 0);
+  setp(d_chunk.data(), d_chunk.data() + d_chunk.size());
+  d_worker = std::thread(&AsyncOstreamBuf::run, this);
+}
+
+AsyncOstreamBuf::~AsyncOstreamBuf() { close(); }
+
+void AsyncOstreamBuf::close()
+{
+  if (d_closed)
+  {
+    return;
+  }
+  enqueueChunk(false);
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_closed = true;
+  }
+  d_workCv.notify_one();
+  d_worker.join();
+  setp(nullptr, nullptr);
+}
+
+AsyncOstreamBuf::int_type AsyncOstreamBuf::overflow(int_type c)
+{
+  if (d_closed)
+  {
+    return traits_type::eof();
+  }
+  enqueueChunk(false);
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+int AsyncOstreamBuf::sync()
+{
+  if (d_closed)
+  {
+    return -1;
+  }
+  enqueueChunk(true);
+  return 0;
+}
+
+void AsyncOstreamBuf::enqueueChunk(bool append)
+{
+  size_t n = pptr() - pbase();
+  if (n == 0)
+  {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    // Wait until the background thread catches up, which bounds the memory
+    // used by the chunks waiting to be written.
+    d_spaceCv.wait(lock, [this]() { return d_queuedBytes < d_maxQueued; });
+    d_queuedBytes += n;
+    // The chunks in d_queue are not accessed by the background thread, which
+    // removes a chunk from d_queue before writing it, and the background
+    // thread is already notified of the last one.
+    if (append && !d_queue.empty()
+        && d_queue.back().size() + n <= d_chunkSize)
+    {
+      d_queue.back().insert(d_queue.back().end(), pbase(), pptr());
+      lock.unlock();
+      setp(d_chunk.data(), d_chunk.data() + d_chunk.size());
+      return;
+    }
+    d_chunk.resize(n);
+    d_queue.push_back(std::move(d_chunk));
+    if (d_free.empty())
+    {
+      d_chunk = std::vector<char>();
+    }
+    else
+    {
+      d_chunk = std::move(d_free.back());
+      d_free.pop_back();
+    }
+  }
+  d_workCv.notify_one();
+  d_chunk.resize(d_chunkSize);
+  setp(d_chunk.data(), d_chunk.data() + d_chunk.size());
+}
+
+void AsyncOstreamBuf::run()
+{
+  std::unique_lock<std::mutex> lock(d_mutex);
+  while (true)
+  {
+    d_workCv.wait(lock, [this]() { return d_closed || !d_queue.empty(); });
+    if (d_queue.empty())
+    {
+      // closed and all chunks are written
+      break;
+    }
+    std::vector<char> chunk = std::move(d_queue.front());
+    d_queue.pop_front();
+    lock.unlock();
+    d_out->write(chunk.data(), chunk.size());
+    d_out->flush();
+    lock.lock();
+    d_queuedBytes -= chunk.size();
+    d_free.push_back(std::move(chunk));
+    d_spaceCv.notify_one();
+  }
+}
+
+AsyncOstream::AsyncOstream(std::ostream* os,
+                           bool owned,
+                           size_t chunkSize,
+                           size_t maxQueued)
+    : std::ostream(nullptr),
+      d_out(os),
+      d_owned(owned),
+      d_buf(os, chunkSize, maxQueued)
+{
+  rdbuf(&d_buf);
+}
+
+AsyncOstream::~AsyncOstream()
+{
+  // the background thread must be done with d_out before it is deleted
+  d_buf.close();
+  if (d_owned)
+  {
+    delete d_out;
+  }
+}
+
+}  // namespace cvc5
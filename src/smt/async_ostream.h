@@ -0,0 +1,130 @@
+/*********************                                                        */
+/*! \file async_ostream.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An output stream that writes to another one in a background thread
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__ASYNC_OSTREAM_H
+#define CVC4__SMT__ASYNC_OSTREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace cvc5 {
+
+/**
+ * A stream buffer that collects the characters written to it in chunks,
+ * which are written to an output stream by a background thread.
+ *
+ * The characters are formatted by the writing thread, since the nodes cannot
+ * be printed or reference counted by several threads, and only the writes to
+ * the output stream are asynchronous. A full chunk is handed to the
+ * background thread, and so is the current chunk when the stream buffer is
+ * flushed (e.g. by std::endl), so that flushed characters are not lost if the
+ * process terminates abnormally afterwards. The characters of a flush are
+ * appended to the last chunk waiting to be written if it has room, so that
+ * dumping line per line still writes large buffers. If the chunks waiting to
+ * be written exceed a bound, the writing thread blocks until the background
+ * thread catches up.
+ */
+class AsyncOstreamBuf : public std::streambuf
+{
+ public:
+  AsyncOstreamBuf(std::ostream* out, size_t chunkSize, size_t maxQueued);
+  ~AsyncOstreamBuf();
+  /**
+   * Write the current chunk and the waiting ones to the output stream and
+   * stop the background thread. No characters may be written afterwards.
+   */
+  void close();
+
+ protected:
+  int_type overflow(int_type c) override;
+  /** Hand the current chunk to the background thread */
+  int sync() override;
+
+ private:
+  /**
+   * Hand the current chunk to the background thread. If append is true, its
+   * characters are appended to the last chunk waiting to be written instead,
+   * if it has room for them.
+   */
+  void enqueueChunk(bool append);
+  /** The loop of the background thread */
+  void run();
+  /** The output stream */
+  std::ostream* d_out;
+  /** The size of the chunks */
+  size_t d_chunkSize;
+  /** The bound on the number of characters waiting to be written */
+  size_t d_maxQueued;
+  /** The current chunk, which is the put area of this stream buffer */
+  std::vector<char> d_chunk;
+  /** The chunks waiting to be written */
+  std::deque<std::vector<char>> d_queue;
+  /** The chunks that have been written, whose memory is reused */
+  std::vector<std::vector<char>> d_free;
+  /** The number of characters in d_queue */
+  size_t d_queuedBytes;
+  /** Whether close was called */
+  bool d_closed;
+  /** The mutex protecting the fields above that the threads share */
+  std::mutex d_mutex;
+  /** Notifies the background thread of a new chunk or of close */
+  std::condition_variable d_workCv;
+  /** Notifies the writing thread that chunks have been written */
+  std::condition_variable d_spaceCv;
+  /** The background thread */
+  std::thread d_worker;
+}; /* class AsyncOstreamBuf */
+
+/**
+ * An output stream whose characters are written to another output stream by
+ * a background thread, see AsyncOstreamBuf.
+ */
+class AsyncOstream : public std::ostream
+{
+ public:
+  /** The default size of the chunks */
+  static const size_t s_chunkSize = 1 << 20;
+  /** The default bound on the number of characters waiting to be written */
+  static const size_t s_maxQueued = 16 * s_chunkSize;
+
+  /**
+   * Construct an asynchronous stream writing to os, which it deletes on
+   * destruction if owned is true.
+   */
+  AsyncOstream(std::ostream* os,
+               bool owned,
+               size_t chunkSize = s_chunkSize,
+               size_t maxQueued = s_maxQueued);
+  /** Write all pending characters to the output stream */
+  ~AsyncOstream();
+
+ private:
+  /** The output stream */
+  std::ostream* d_out;
+  /** Whether d_out is deleted on destruction */
+  bool d_owned;
+  /** The stream buffer */
+  AsyncOstreamBuf d_buf;
+}; /* class AsyncOstream */
+
+}  // namespace cvc5
+
+#endif /* CVC4__SMT__ASYNC_OSTREAM_H */
@@ -14,6 +14,7 @@
 
 #include "smt/check_models.h"
 
+#include "expr/node_algorithm.h"
 #include "options/smt_options.h"
 #include "smt/model.h"
 #include "smt/node_command.h"
@@ -31,6 +32,37 @@ namespace smt {
 CheckModels::CheckModels(SmtSolver& s) : d_smt(s) {}
 CheckModels::~CheckModels() {}
 
+CheckModels::AssertionInfo& CheckModels::getAssertionInfo(
+    const Node& assertion)
+{
+  std::unique_ptr<AssertionInfo>& ai = d_ainfo[assertion];
+  if (ai != nullptr)
+  {
+    return *ai;
+  }
+  ai.reset(new AssertionInfo);
+  // Apply any define-funs from the problem. We do not expand theory symbols
+  // like integer division here. Hence, the code below is not able to properly
+  // evaluate e.g. divide-by-zero. This is intentional since the evaluation
+  // is not trustworthy, since the UF introduced by expanding definitions may
+  // not be properly constrained.
+  Preprocessor* pp = d_smt.getPreprocessor();
+  Node n = pp->expandDefinitions(assertion, d_expandCache, true);
+  Notice() << "SmtEngine::checkModel(): -- expands to " << n << std::endl;
+
+  n = Rewriter::rewrite(n);
+  Notice() << "SmtEngine::checkModel(): -- rewrites to " << n << std::endl;
+  ai->d_expanded = n;
+  std::unordered_set<Node, NodeHashFunction> syms;
+  expr::getSymbols(n, syms);
+  ai->d_syms.insert(ai->d_syms.end(), syms.begin(), syms.end());
+  ai->d_prepared = ai->d_peval.prepare(n, ai->d_syms);
+  Trace("check-model") << "checkModel: " << assertion << " has "
+                       << ai->d_syms.size() << " symbols, prepared is "
+                       << ai->d_prepared << std::endl;
+  return *ai;
+}
+
 void CheckModels::checkModel(Model* m,
                              context::CDList<Node>* al,
                              bool hardFailure)
@@ -56,10 +88,7 @@ void CheckModels::checkModel(Model* m,
     te->checkTheoryAssertionsWithModel(hardFailure);
   }
 
-  Preprocessor* pp = d_smt.getPreprocessor();
-
   Trace("check-model") << "checkModel: Check assertions..." << std::endl;
-  std::unordered_map<Node, Node, NodeHashFunction> cache;
   // the list of assertions that did not rewrite to true
   std::vector<Node> noCheckList;
   // Now go through all our user assertions checking if they're satisfied.
@@ -67,17 +96,33 @@ void CheckModels::checkModel(Model* m,
   {
     Notice() << "SmtEngine::checkModel(): checking assertion " << assertion
              << std::endl;
-
-    // Apply any define-funs from the problem. We do not expand theory symbols
-    // like integer division here. Hence, the code below is not able to properly
-    // evaluate e.g. divide-by-zero. This is intentional since the evaluation
-    // is not trustworthy, since the UF introduced by expanding definitions may
-    // not be properly constrained.
-    Node n = pp->expandDefinitions(assertion, cache, true);
-    Notice() << "SmtEngine::checkModel(): -- expands to " << n << std::endl;
-
-    n = Rewriter::rewrite(n);
-    Notice() << "SmtEngine::checkModel(): -- rewrites to " << n << std::endl;
+    AssertionInfo& ai = getAssertionInfo(assertion);
+    Node n = ai.d_expanded;
+    if (ai.d_prepared)
+    {
+      // the value of n is determined by the values of its symbols
+      std::vector<Node> vals;
+      for (const Node& s : ai.d_syms)
+      {
+        vals.push_back(m->getValue(s));
+      }
+      if (ai.d_checked && vals == ai.d_vals)
+      {
+        Notice() << "SmtEngine::checkModel(): -- unchanged since last check"
+                 << std::endl;
+        continue;
+      }
+      Node v = ai.d_peval.eval(vals);
+      Notice() << "SmtEngine::checkModel(): -- evaluates to " << v
+               << std::endl;
+      if (!v.isNull() && v.isConst() && v.getConst<bool>())
+      {
+        ai.d_vals = vals;
+        ai.d_checked = true;
+        continue;
+      }
+      ai.d_checked = false;
+    }
 
     // We look up the value before simplifying. If n contains quantifiers,
     // this may increases the chance of finding its value before the node is
@@ -17,8 +17,13 @@
 #ifndef CVC4__SMT__CHECK_MODELS_H
 #define CVC4__SMT__CHECK_MODELS_H
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "context/cdlist.h"
 #include "expr/node.h"
+#include "theory/evaluator.h"
 
 namespace cvc5 {
 namespace smt {
@@ -28,6 +33,13 @@ class SmtSolver;
 
 /**
  * This utility is responsible for checking the current model.
+ *
+ * It is incremental: the expanded form of each assertion is computed once.
+ * If the expanded form of an assertion can be compiled for evaluation (see
+ * theory::PreparedEvaluator), its value is determined by the values of its
+ * free symbols. It is then evaluated with the compiled code, and it is not
+ * checked again by later calls as long as the values of these symbols do
+ * not change.
  */
 class CheckModels
 {
@@ -43,8 +55,32 @@ class CheckModels
   void checkModel(Model* m, context::CDList<Node>* al, bool hardFailure);
 
  private:
+  /** Information on an assertion, computed when it is first checked */
+  struct AssertionInfo
+  {
+    AssertionInfo() : d_prepared(false), d_checked(false) {}
+    /** The assertion after expanding definitions and rewriting */
+    Node d_expanded;
+    /** The free symbols of d_expanded */
+    std::vector<Node> d_syms;
+    /** The values of d_syms when the assertion was last shown true */
+    std::vector<Node> d_vals;
+    /** The compiled form of d_expanded, if d_prepared is true */
+    theory::PreparedEvaluator d_peval;
+    /** Whether d_expanded could be compiled */
+    bool d_prepared;
+    /** Whether d_vals is set */
+    bool d_checked;
+  };
+  /** Get the information on the given assertion, computing it if necessary */
+  AssertionInfo& getAssertionInfo(const Node& assertion);
   /** Reference to the SMT solver */
   SmtSolver& d_smt;
+  /** The information on the assertions checked so far */
+  std::unordered_map<Node, std::unique_ptr<AssertionInfo>, NodeHashFunction>
+      d_ainfo;
+  /** The cache used for expanding definitions in the assertions */
+  std::unordered_map<Node, Node, NodeHashFunction> d_expandCache;
 };
 
 }  // namespace smt
@@ -255,8 +255,10 @@ TrustNode ExpandDefs::expandDefinitions(
 
         theory::Theory* t = d_smt.getTheoryEngine()->theoryOf(node);
 
-        Assert(t != NULL);
-        TrustNode trn = t->expandDefinition(n);
+        // The theories that are not enabled by the logic are not instantiated,
+        // the terms of those theories are rejected when they are registered.
+        TrustNode trn =
+            t == nullptr ? TrustNode::null() : t->expandDefinition(n);
         if (!trn.isNull())
         {
           node = trn.getNode();
@@ -22,6 +22,7 @@
 #include "base/check.h"
 #include "options/open_ostream.h"
 #include "options/smt_options.h"
+#include "smt/async_ostream.h"
 #include "smt/update_ostream.h"
 
 namespace cvc5 {
@@ -69,6 +70,22 @@ std::string ManagedDumpOStream::defaultSource() const{
   return options::dumpToFileName();
 }
 
+std::pair<bool, std::ostream*> ManagedDumpOStream::open(
+    const std::string& filename) const
+{
+  std::pair<bool, std::ostream*> pair = ManagedOstream::open(filename);
+  // standard output is shared with the regular output of the solver, whose
+  // order with the dump output would be lost
+  if (!options::dumpAsync() || !pair.first)
+  {
+    return pair;
+  }
+  // the asynchronous stream is managed, and owns the stream it wraps if the
+  // latter was managed
+  return std::pair<bool, std::ostream*>(
+      true, new AsyncOstream(pair.second, pair.first));
+}
+
 
 void ManagedDumpOStream::initialize(std::ostream* outStream) {
 #ifdef CVC4_DUMPING
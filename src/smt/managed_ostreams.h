@@ -55,7 +55,8 @@ class ManagedOstream {
    * Opens an ostream using OstreamOpener with the name getName() with the
    * special cases added by addSpecialCases().
    */
-  std::pair<bool, std::ostream*> open(const std::string& filename) const;
+  virtual std::pair<bool, std::ostream*> open(
+      const std::string& filename) const;
 
   /**
    * Updates the value of managed pointer. Whenever this changes,
@@ -87,6 +88,13 @@ class ManagedDumpOStream : public ManagedOstream {
   std::string defaultSource() const override;
 
  protected:
+  /**
+   * Opens the ostream as the base class does, and wraps it in an
+   * AsyncOstream if dumping is asynchronous.
+   */
+  std::pair<bool, std::ostream*> open(
+      const std::string& filename) const override;
+
   /** Initializes an output stream. Not necessarily managed. */
   void initialize(std::ostream* outStream) override;
 
@@ -14,6 +14,8 @@
 
 #include "smt/optimization_solver.h"
 
+#include <algorithm>
+
 #include "options/smt_options.h"
 #include "smt/smt_engine.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
@@ -24,49 +26,56 @@ using namespace cvc5::theory;
 namespace cvc5 {
 namespace smt {
 
-/**
- * d_activatedObjective is initialized to a default objective:
- * default objective constructed with Null Node and OBJECTIVE_UNDEFINED
- *
- * d_savedValue is initialized to a default node (Null Node)
- */
-
-OptimizationSolver::OptimizationSolver(SmtEngine* parent)
-    : d_parent(parent),
-      d_activatedObjective(Node(), OBJECTIVE_UNDEFINED),
-      d_savedValue()
+OptimizationSolver::OptimizationSolver(SmtEngine* parent,
+                                       OptSearchMode smode,
+                                       OptCombination comb)
+    : d_parent(parent), d_searchMode(smode), d_combination(comb)
 {
 }
 
 OptimizationSolver::~OptimizationSolver() {}
 
-OptResult OptimizationSolver::checkOpt()
+void OptimizationSolver::initializeChecker()
 {
-  // Make sure that the objective is not the default one
-  Assert(d_activatedObjective.getType() != OBJECTIVE_UNDEFINED);
-  Assert(!d_activatedObjective.getNode().isNull());
-
   // the smt engine to which we send intermediate queries
-  // for the linear search.
-  std::unique_ptr<SmtEngine> optChecker;
-  initializeSubsolver(optChecker);
-  NodeManager* nm = optChecker->getNodeManager();
+  // for the optimization loops.
+  initializeSubsolver(d_optChecker);
 
-  // we need to be in incremental mode for multiple objectives since we need to
-  // push pop we need to produce models to inrement on our objective
-  optChecker->setOption("incremental", "true");
-  optChecker->setOption("produce-models", "true");
+  // we need to be in incremental mode since the bounds are given as
+  // assumptions, we need to produce models to inrement on our objectives
+  // and unsat assumptions to relax the soft constraints
+  d_optChecker->setOption("incremental", "true");
+  d_optChecker->setOption("produce-models", "true");
+  if (!d_softConstraints.empty())
+  {
+    d_optChecker->setOption("produce-unsat-assumptions", "true");
+  }
 
   // Move assertions from the parent solver to the subsolver
   std::vector<Node> p_assertions = d_parent->getExpandedAssertions();
   for (const Node& e : p_assertions)
   {
-    optChecker->assertFormula(e);
+    d_optChecker->assertFormula(e);
+  }
+}
+
+OptResult OptimizationSolver::checkOpt()
+{
+  // Make sure that there is something to optimize
+  Assert(!d_activatedObjectives.empty() || !d_softConstraints.empty());
+
+  // In Pareto mode, the subsolver remembers the points found by the
+  // previous calls.
+  bool fresh =
+      d_optChecker == nullptr || d_combination != OPT_COMBINATION_PARETO;
+  if (fresh)
+  {
+    initializeChecker();
   }
 
   // We need to checksat once before the optimization loop so we have a
   // baseline value to increment
-  Result loop_r = optChecker->checkSat();
+  Result loop_r = d_optChecker->checkSat();
 
   if (loop_r.isUnknown())
   {
@@ -77,52 +86,281 @@ OptResult OptimizationSolver::checkOpt()
     return OPT_UNSAT;
   }
 
-  // Model-value of objective (used in optimization loop)
-  Node value;
-  // asserts objective > old_value (used in optimization loop)
-  Node increment;
+  if (fresh && !d_softConstraints.empty())
+  {
+    loop_r = optimizeSoftConstraints();
+    if (loop_r.isUnknown())
+    {
+      return OPT_UNKNOWN;
+    }
+    Assert(loop_r.isSat());
+  }
+
+  if (d_combination == OPT_COMBINATION_PARETO
+      && !d_activatedObjectives.empty())
+  {
+    loop_r = optimizePareto();
+    return loop_r.isUnknown() ? OPT_UNKNOWN : OPT_OPTIMAL;
+  }
+
+  d_savedValues.clear();
+  for (size_t i = 0, nobjs = d_activatedObjectives.size(); i < nobjs; i++)
+  {
+    Node obj = d_activatedObjectives[i].getNode();
+    // get the model-value of objective in last sat call
+    Node value = d_optChecker->getValue(obj);
+    loop_r = optimizeObjective(i, value);
+    if (loop_r.isUnknown())
+    {
+      return OPT_UNKNOWN;
+    }
+    d_savedValues.push_back(value);
+    if (i + 1 < nobjs)
+    {
+      // the optimum of this objective takes precedence over the next
+      // objectives
+      NodeManager* nm = d_optChecker->getNodeManager();
+      d_optChecker->assertFormula(nm->mkNode(kind::EQUAL, obj, value));
+      loop_r = d_optChecker->checkSat();
+      if (loop_r.isUnknown())
+      {
+        return OPT_UNKNOWN;
+      }
+      Assert(loop_r.isSat());
+    }
+  }
+
+  return OPT_OPTIMAL;
+}
+
+Result OptimizationSolver::optimizeSoftConstraints()
+{
+  NodeManager* nm = d_optChecker->getNodeManager();
+  Node zero = nm->mkConst(Rational(0));
+  Node one = nm->mkConst(Rational(1));
+  // the soft constraints that have not been relaxed so far
+  std::vector<Node> hard = d_softConstraints;
+  // the summands counting the relaxed soft constraints that are false
+  std::vector<Node> relaxed;
+  size_t k = 0;
+  Node bound;
+  for (;;)
+  {
+    std::vector<Node> assumptions = hard;
+    if (!relaxed.empty())
+    {
+      Node sum = relaxed.size() == 1 ? relaxed[0]
+                                     : nm->mkNode(kind::PLUS, relaxed);
+      bound = nm->mkNode(kind::LEQ, sum, nm->mkConst(Rational(k)));
+      assumptions.push_back(bound);
+    }
+    Result r = d_optChecker->checkSat(assumptions);
+    if (!r.isUnknown() && !r.isSat())
+    {
+      std::vector<Node> core = d_optChecker->getUnsatAssumptions();
+      size_t nrelaxed = relaxed.size();
+      for (const Node& c : core)
+      {
+        std::vector<Node>::iterator it = std::find(hard.begin(), hard.end(), c);
+        if (it == hard.end())
+        {
+          continue;
+        }
+        // relax the soft constraint, i.e. allow it to be false at the cost of
+        // one
+        Node rv = nm->mkSkolem("r", nm->booleanType());
+        d_optChecker->assertFormula(nm->mkNode(kind::OR, c, rv));
+        relaxed.push_back(nm->mkNode(kind::ITE, rv, one, zero));
+        hard.erase(it);
+      }
+      if (relaxed.size() == nrelaxed)
+      {
+        // the core consists of the bound and of hard constraints
+        Assert(k < relaxed.size());
+        k++;
+      }
+      Trace("opt-solver") << "Soft constraints: unsat core of size "
+                          << core.size() << ", " << relaxed.size()
+                          << " relaxed, bound " << k << std::endl;
+      continue;
+    }
+    if (r.isUnknown())
+    {
+      return r;
+    }
+    d_softCost = nm->mkConst(Rational(k));
+    // keep the minimal cost for the objectives
+    for (const Node& h : hard)
+    {
+      d_optChecker->assertFormula(h);
+    }
+    if (!bound.isNull())
+    {
+      d_optChecker->assertFormula(bound);
+    }
+    return d_optChecker->checkSat();
+  }
+}
+
+Result OptimizationSolver::optimizeObjective(size_t i, Node& value)
+{
+  Node obj = d_activatedObjectives[i].getNode();
+  bool isMax = d_activatedObjectives[i].getType() == OBJECTIVE_MAXIMIZE;
+  NodeManager* nm = d_optChecker->getNodeManager();
+  Result loop_r;
+  if (d_searchMode == OPT_SEARCH_BINARY && value.isConst()
+      && value.getType().isInteger())
+  {
+    // Galloping search: the distance of the bound to the last value is
+    // doubled until unsat, the optimum is then in the interval between the
+    // last value and the bound
+    Integer last = value.getConst<Rational>().getNumerator();
+    Integer step(1);
+    Integer fail;
+    for (;;)
+    {
+      Node cand = nm->mkConst(Rational(isMax ? last + step : last - step));
+      loop_r = d_optChecker->checkSat(mkBound(i, cand, false));
+      if (loop_r.isUnknown())
+      {
+        return loop_r;
+      }
+      if (!loop_r.isSat())
+      {
+        fail = cand.getConst<Rational>().getNumerator();
+        break;
+      }
+      value = d_optChecker->getValue(obj);
+      last = value.getConst<Rational>().getNumerator();
+      step = step * Integer(2);
+    }
+    // Bisection: the optimum is at least as good as last, and worse than fail
+    while ((isMax ? fail - last : last - fail) > Integer(1))
+    {
+      Integer mid = (last + fail).floorDivideQuotient(Integer(2));
+      Node midValue = nm->mkConst(Rational(mid));
+      loop_r = d_optChecker->checkSat(mkBound(i, midValue, false));
+      if (loop_r.isUnknown())
+      {
+        return loop_r;
+      }
+      if (loop_r.isSat())
+      {
+        value = d_optChecker->getValue(obj);
+        last = value.getConst<Rational>().getNumerator();
+      }
+      else
+      {
+        fail = mid;
+      }
+    }
+    value = nm->mkConst(Rational(last));
+    Trace("opt-solver") << "Optimum of " << obj << " is " << value
+                        << std::endl;
+    return loop_r;
+  }
 
   // Workhorse of linear optimization:
   // This loop will keep incrmenting the objective until unsat
   // When unsat is hit, the optimized value is the model value just before the
   // unsat call
-  while (loop_r.isSat())
+  for (;;)
   {
-    // get the model-value of objective in last sat call
-    value = optChecker->getValue(d_activatedObjective.getNode());
-
-    // We need to save the value since we need the model value just before the
-    // unsat call
-    Assert(!value.isNull());
-    d_savedValue = value;
-
-    // increment on the model-value of objective:
     // if we're maximizing increment = objective > old_objective value
     // if we're minimizing increment = objective < old_objective value
-    if (d_activatedObjective.getType() == OBJECTIVE_MAXIMIZE)
+    loop_r = d_optChecker->checkSat(mkBound(i, value, true));
+    if (loop_r.isUnknown() || !loop_r.isSat())
+    {
+      break;
+    }
+    // We need to save the value since we need the model value just before
+    // the unsat call
+    value = d_optChecker->getValue(obj);
+    Assert(!value.isNull());
+  }
+  Trace("opt-solver") << "Optimum of " << obj << " is " << value << std::endl;
+  return loop_r;
+}
+
+Result OptimizationSolver::optimizePareto()
+{
+  NodeManager* nm = d_optChecker->getNodeManager();
+  size_t nobjs = d_activatedObjectives.size();
+  Result loop_r;
+  // Guided improvement: look for a model that is at least as good in all
+  // objectives and better in one of them until unsat
+  for (;;)
+  {
+    d_savedValues.clear();
+    std::vector<Node> geq;
+    std::vector<Node> gt;
+    for (size_t i = 0; i < nobjs; i++)
+    {
+      Node value = d_optChecker->getValue(d_activatedObjectives[i].getNode());
+      d_savedValues.push_back(value);
+      geq.push_back(mkBound(i, value, false));
+      gt.push_back(mkBound(i, value, true));
+    }
+    Node better = gt.size() == 1 ? gt[0] : nm->mkNode(kind::OR, gt);
+    geq.push_back(better);
+    loop_r = d_optChecker->checkSat(geq);
+    if (loop_r.isUnknown())
     {
-      increment = nm->mkNode(kind::GT, d_activatedObjective.getNode(), value);
+      return loop_r;
     }
-    else
+    if (!loop_r.isSat())
     {
-      increment = nm->mkNode(kind::LT, d_activatedObjective.getNode(), value);
+      // d_savedValues is Pareto optimal, exclude it and the points it
+      // dominates from the next calls
+      d_optChecker->assertFormula(better);
+      return loop_r;
     }
-    optChecker->assertFormula(increment);
-    loop_r = optChecker->checkSat();
   }
+}
 
-  return OPT_OPTIMAL;
+Node OptimizationSolver::mkBound(size_t i, const Node& value, bool strict)
+{
+  NodeManager* nm = d_optChecker->getNodeManager();
+  Node obj = d_activatedObjectives[i].getNode();
+  if (d_activatedObjectives[i].getType() == OBJECTIVE_MAXIMIZE)
+  {
+    return nm->mkNode(strict ? kind::GT : kind::GEQ, obj, value);
+  }
+  return nm->mkNode(strict ? kind::LT : kind::LEQ, obj, value);
 }
 
 void OptimizationSolver::activateObj(const Node& obj, const int& type)
 {
-  d_activatedObjective = Objective(obj, (ObjectiveType)type);
+  d_activatedObjectives.push_back(Objective(obj, (ObjectiveType)type));
+  d_optChecker.reset(nullptr);
+}
+
+void OptimizationSolver::addSoftConstraint(const Node& s)
+{
+  d_softConstraints.push_back(s);
+  d_optChecker.reset(nullptr);
+}
+
+void OptimizationSolver::resetObjectives()
+{
+  d_activatedObjectives.clear();
+  d_softConstraints.clear();
+  d_savedValues.clear();
+  d_softCost = Node::null();
+  d_optChecker.reset(nullptr);
+}
+
+Node OptimizationSolver::objectiveGetValue(size_t i)
+{
+  Assert(i < d_savedValues.size());
+  Assert(!d_savedValues[i].isNull());
+  return d_savedValues[i];
 }
 
-Node OptimizationSolver::objectiveGetValue()
+Node OptimizationSolver::softConstraintsGetCost()
 {
-  Assert(!d_savedValue.isNull());
-  return d_savedValue;
+  Assert(!d_softCost.isNull());
+  return d_softCost;
 }
 
 Objective::Objective(Node obj, ObjectiveType type) : d_type(type), d_node(obj)
@@ -17,6 +17,9 @@
 #ifndef CVC4__SMT__OPTIMIZATION_SOLVER_H
 #define CVC4__SMT__OPTIMIZATION_SOLVER_H
 
+#include <memory>
+#include <vector>
+
 #include "expr/node.h"
 #include "expr/type_node.h"
 #include "smt/assertions.h"
@@ -62,6 +65,33 @@ enum OptResult
   OPT_SAT_APPROX
 };
 
+/**
+ * An enum for optimization queries.
+ *
+ * Represents how the optimum of an objective is searched for
+ */
+enum OptSearchMode
+{
+  // strengthen the bound to the value of the last model until unsat
+  OPT_SEARCH_LINEAR,
+  // for integer objectives, double the step by which the bound is
+  // strengthened until unsat, then bisect the remaining interval
+  OPT_SEARCH_BINARY
+};
+
+/**
+ * An enum for optimization queries.
+ *
+ * Represents how multiple objectives are combined
+ */
+enum OptCombination
+{
+  // optimize the objectives in the order they were activated
+  OPT_COMBINATION_LEXICOGRAPHIC,
+  // each call to checkOpt finds a new Pareto optimal point
+  OPT_COMBINATION_PARETO
+};
+
 class Objective
 {
  public:
@@ -84,33 +114,79 @@ class Objective
 
   /**
    * A solver for optimization queries.
-   * 
+   *
    * This class is responsible for responding to optmization queries. It
-   * spawns a subsolver SmtEngine that captures the parent assertions and 
-   * implements a linear optimization loop. Supports activateObjective, 
-   * checkOpt, and objectiveGetValue in that order.
+   * spawns a subsolver SmtEngine that captures the parent assertions and
+   * implements the optimization loops on it. Supports activateObjective,
+   * addSoftConstraint, checkOpt, and objectiveGetValue in that order.
+   *
+   * The loops run over one incremental subsolver: the bounds on objectives
+   * are given as assumptions to checkSat, so that the state of the subsolver,
+   * e.g. learned clauses, is reused between the steps. The soft constraints
+   * are handled first by a core-guided search (MSU3), i.e. the soft
+   * constraints in the unsat assumptions are relaxed and the number of
+   * relaxed soft constraints that may be false is increased until sat. The
+   * minimal number of false soft constraints is then kept for the objectives.
    */
   class OptimizationSolver
   {
    public:
     /** parent is the smt_solver that the user added their assertions to **/
-    OptimizationSolver(SmtEngine* parent);
+    OptimizationSolver(SmtEngine* parent,
+                       OptSearchMode smode = OPT_SEARCH_LINEAR,
+                       OptCombination comb = OPT_COMBINATION_LEXICOGRAPHIC);
     ~OptimizationSolver();
 
-    /** Runs the optimization loop for the activated objective **/
+    /**
+     * Runs the optimization loop for the activated objectives. In Pareto
+     * mode, each call returns a Pareto optimal point that is not dominated
+     * by those of the previous calls, or OPT_UNSAT if there is none left.
+     **/
     OptResult checkOpt();
     /** Activates an objective: will be optimized for **/
     void activateObj(const Node& obj, const int& type);
-    /** Gets the value of the optimized objective after checkopt is called **/
-    Node objectiveGetValue();
+    /** Adds a soft constraint, which is satisfied if possible **/
+    void addSoftConstraint(const Node& s);
+    /** Removes all objectives and soft constraints **/
+    void resetObjectives();
+    /**
+     * Gets the value of the i^th activated objective after checkopt is
+     * called
+     **/
+    Node objectiveGetValue(size_t i = 0);
+    /** Gets the number of soft constraints that are false in the optimum **/
+    Node softConstraintsGetCost();
 
    private:
+    /** Make the subsolver and assert the parent assertions to it **/
+    void initializeChecker();
+    /** Minimize the number of false soft constraints on the subsolver **/
+    Result optimizeSoftConstraints();
+    /** Optimize the i^th objective, whose value in the last model is value **/
+    Result optimizeObjective(size_t i, Node& value);
+    /** Find a Pareto optimal point, starting from the last model **/
+    Result optimizePareto();
+    /**
+     * Make the constraint that the i^th objective is at least as good as
+     * value, or better than value if strict is true.
+     **/
+    Node mkBound(size_t i, const Node& value, bool strict);
     /** The parent SMT engine **/
     SmtEngine* d_parent;
+    /** How the optimum of objectives is searched for **/
+    OptSearchMode d_searchMode;
+    /** How the objectives are combined **/
+    OptCombination d_combination;
+    /** The subsolver the optimization loops run over **/
+    std::unique_ptr<SmtEngine> d_optChecker;
     /** The objectives to optimize for **/
-    Objective d_activatedObjective;
-    /** A saved value of the objective from the last sat call. **/
-    Node d_savedValue;
+    std::vector<Objective> d_activatedObjectives;
+    /** The soft constraints **/
+    std::vector<Node> d_softConstraints;
+    /** The values of the objectives from the last optimal model. **/
+    std::vector<Node> d_savedValues;
+    /** The number of false soft constraints in the last optimal model **/
+    Node d_softCost;
   };
 
 }  // namespace smt
@@ -122,7 +122,9 @@ void OptionsManager::notifySetOption(const std::string& key)
   // otherwise, no action is necessary
 }
 
-void OptionsManager::finishInit(LogicInfo& logic, bool isInternalSubsolver)
+void OptionsManager::finishInit(LogicInfo& logic,
+                                bool isInternalSubsolver,
+                                bool applyDefaults)
 {
   // set up the timeouts and resource limits
   if ((*d_options)[options::perCallResourceLimit] != 0)
@@ -138,8 +140,15 @@ void OptionsManager::finishInit(LogicInfo& logic, bool isInternalSubsolver)
   {
     d_resourceManager->setTimeLimit(options::perCallMillisecondLimit());
   }
+  if ((*d_options)[options::memoryLimit] != 0)
+  {
+    d_resourceManager->setMemoryLimit(options::memoryLimit());
+  }
   // ensure that our heuristics are properly set up
-  setDefaults(logic, isInternalSubsolver);
+  if (applyDefaults)
+  {
+    setDefaults(logic, isInternalSubsolver);
+  }
 }
 
 }  // namespace smt
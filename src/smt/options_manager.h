@@ -57,9 +57,13 @@ class OptionsManager : public OptionsListener
   /**
    * Finish init, which is called at the beginning of SmtEngine::finishInit,
    * just before solving begins. This initializes the options pertaining to
-   * time limits, and sets the default options.
+   * time limits, and sets the default options if applyDefaults is true. The
+   * latter is false if the options and the logic were already finalized by
+   * another SmtEngine, see SmtEngine::configureFrom.
    */
-  void finishInit(LogicInfo& logic, bool isInternalSubsolver);
+  void finishInit(LogicInfo& logic,
+                  bool isInternalSubsolver,
+                  bool applyDefaults = true);
 
  private:
   /** Reference to the options object */
@@ -22,6 +22,8 @@
 #include "smt/dump.h"
 #include "smt/preprocess_proof_generator.h"
 #include "smt/smt_engine.h"
+#include "theory/theory_engine.h"
+#include "theory/theory_model.h"
 
 using namespace std;
 using namespace cvc5::theory;
@@ -99,6 +101,30 @@ bool Preprocessor::process(Assertions& as)
   return noConflict;
 }
 
+void Preprocessor::notifyPreprocessed(
+    const std::vector<Node>& assertions,
+    const std::vector<std::pair<Node, Node>>& substs)
+{
+  TrustSubstitutionMap& tls = d_ppContext->getTopLevelSubstitutions();
+  TheoryModel* m = d_ppContext->getTheoryEngine()->getModel();
+  Assert(m != nullptr);
+  for (const std::pair<Node, Node>& s : substs)
+  {
+    tls.addSubstitution(s.first, s.second);
+    m->addSubstitution(s.first, s.second);
+  }
+  if (options::incrementalSolving())
+  {
+    d_ppContext->recordSymbolsInAssertions(assertions);
+  }
+  d_assertionsProcessed = true;
+}
+
+TrustSubstitutionMap& Preprocessor::getTopLevelSubstitutions()
+{
+  return d_ppContext->getTopLevelSubstitutions();
+}
+
 void Preprocessor::clearLearnedLiterals()
 {
   d_propagator.getLearnedLiterals().clear();
@@ -143,11 +169,15 @@ Node Preprocessor::simplify(const Node& node)
     // ensure node is type-checked at this point
     nas.getType(true);
   }
+  return processAssumption(nas);
+}
+
+Node Preprocessor::processAssumption(const Node& n)
+{
   std::unordered_map<Node, Node, NodeHashFunction> cache;
-  Node n = d_exDefs.expandDefinitions(nas, cache);
-  TrustNode ts = d_ppContext->getTopLevelSubstitutions().apply(n);
-  Node ns = ts.isNull() ? n : ts.getNode();
-  return ns;
+  Node ne = d_exDefs.expandDefinitions(n, cache);
+  TrustNode ts = d_ppContext->getTopLevelSubstitutions().apply(ne);
+  return ts.isNull() ? ne : ts.getNode();
 }
 
 void Preprocessor::setProofGenerator(PreprocessProofGenerator* pppg)
@@ -18,6 +18,8 @@
 #define CVC4__SMT__PREPROCESSOR_H
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "smt/expand_definitions.h"
 #include "smt/process_assertions.h"
@@ -27,6 +29,9 @@ namespace cvc5 {
 namespace preprocessing {
 class PreprocessingPassContext;
 }
+namespace theory {
+class TrustSubstitutionMap;
+}
 namespace smt {
 
 class AbstractValues;
@@ -58,6 +63,19 @@ class Preprocessor
    * true if no conflict was discovered while preprocessing them.
    */
   bool process(Assertions& as);
+  /** Have assertions been processed in the current user context? */
+  bool hasProcessedAssertions() const { return d_assertionsProcessed; }
+  /**
+   * Notify that the given assertions were preprocessed elsewhere, e.g. they
+   * were restored from a snapshot, where substs are the top-level
+   * substitutions learned while preprocessing them. This adds the
+   * substitutions to the top-level substitutions and to the model, as the
+   * non-clausal simplification pass does.
+   */
+  void notifyPreprocessed(const std::vector<Node>& assertions,
+                          const std::vector<std::pair<Node, Node>>& substs);
+  /** Get the top-level substitutions learned while preprocessing */
+  theory::TrustSubstitutionMap& getTopLevelSubstitutions();
   /**
    * Clear learned literals from the Boolean propagator.
    */
@@ -78,6 +96,15 @@ class Preprocessor
    * @return The simplified term.
    */
   Node simplify(const Node& n);
+  /**
+   * Process an assumption of a check-sat call that is not added to the
+   * assertions. This expands the definitions in n and applies the top-level
+   * substitutions learned while preprocessing the assertions.
+   *
+   * @param n The assumption to process
+   * @return The processed assumption.
+   */
+  Node processAssumption(const Node& n);
   /**
    * Expand the definitions in a term or formula n.  No other
    * simplification or normalization is done.
@@ -16,6 +16,7 @@
 
 #include <utility>
 
+#include "expr/node_dag_io.h"
 #include "expr/node_manager_attributes.h"
 #include "options/arith_options.h"
 #include "options/base_options.h"
@@ -200,6 +201,11 @@ bool ProcessAssertions::apply(Assertions& as)
     d_passes["bv-intro-pow2"]->apply(&assertions);
   }
 
+  if (options::bvSlice())
+  {
+    d_passes["bv-slice"]->apply(&assertions);
+  }
+
   // Lift bit-vectors of size 1 to bool
   if (options::bitvectorToBool())
   {
@@ -248,6 +254,10 @@ bool ProcessAssertions::apply(Assertions& as)
       d_passes["fun-def-fmf"]->apply(&assertions);
     }
   }
+  if (options::stringLenCheck())
+  {
+    d_passes["strings-len-check"]->apply(&assertions);
+  }
   if (!options::stringLazyPreproc())
   {
     d_passes["strings-eager-pp"]->apply(&assertions);
@@ -325,6 +335,12 @@ bool ProcessAssertions::apply(Assertions& as)
   {
     d_passes["ho-elim"]->apply(&assertions);
   }
+
+  // must come after all passes that apply substitutions
+  if (options::pbNative())
+  {
+    d_passes["pseudo-boolean-native"]->apply(&assertions);
+  }
   
   // begin: INVARIANT to maintain: no reordering of assertions or
   // introducing new ones
@@ -351,6 +367,18 @@ bool ProcessAssertions::apply(Assertions& as)
 
   Trace("smt-proc") << "SmtEnginePrivate::processAssertions() end" << endl;
   dumpAssertions("post-everything", assertions);
+  if (!options::dumpAssertionsDag().empty())
+  {
+    try
+    {
+      NodeDagWriter().writeFile(options::dumpAssertionsDag(), assertions.ref());
+    }
+    catch (const Exception& e)
+    {
+      Warning() << "Could not write the preprocessed assertions: "
+                << e.getMessage() << std::endl;
+    }
+  }
 
   return noConflict;
 }
@@ -20,6 +20,7 @@
 #include "options/base_options.h"
 #include "options/proof_options.h"
 #include "proof/dot/dot_printer.h"
+#include "proof/steps/steps_printer.h"
 #include "smt/assertions.h"
 #include "smt/defined_function.h"
 #include "smt/preprocess_proof_generator.h"
@@ -104,7 +105,11 @@ void PfManager::setFinalProof(std::shared_ptr<ProofNode> pfn,
 
   Trace("smt-proof") << "SmtEngine::setFinalProof(): postprocess...\n";
   Assert(d_pfpp != nullptr);
+  // the post-processing checks many copies of the same steps, e.g. those
+  // that expand the same macro steps, hence we cache the checks while it runs
+  d_pchecker->setCaching(true);
   d_pfpp->process(pfn);
+  d_pchecker->setCaching(false);
 
   Trace("smt-proof") << "SmtEngine::setFinalProof(): make scope...\n";
 
@@ -128,6 +133,10 @@ void PfManager::printProof(std::ostream& out,
   {
     proof::DotPrinter::print(out, fp.get());
   }
+  else if (options::proofFormatMode() == options::ProofFormatMode::STEPS)
+  {
+    proof::StepsPrinter::print(out, fp.get());
+  }
   else
   {
     out << "(proof\n";
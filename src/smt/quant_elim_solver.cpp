@@ -16,6 +16,7 @@
 
 #include "expr/skolem_manager.h"
 #include "expr/subs.h"
+#include "options/quantifiers_options.h"
 #include "smt/smt_solver.h"
 #include "theory/quantifiers/cegqi/nested_qe.h"
 #include "theory/quantifiers/extended_rewrite.h"
@@ -48,7 +49,8 @@ Node QuantElimSolver::getQuantifierElimination(Assertions& as,
   // ensure the body is rewritten
   q = nm->mkNode(q.getKind(), q[0], Rewriter::rewrite(q[1]));
   // do nested quantifier elimination if necessary
-  q = quantifiers::NestedQe::doNestedQe(q, true);
+  q = quantifiers::NestedQe::doNestedQe(
+      q, true, options::cegqiNestedQeCache() ? &d_nestedQeCache : nullptr);
   Trace("smt-qe") << "QuantElimSolver: after nested quantifier elimination : "
                   << q << std::endl;
   // tag the quantified formula with the quant-elim attribute
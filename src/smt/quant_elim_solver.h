@@ -19,6 +19,7 @@
 
 #include "expr/node.h"
 #include "smt/assertions.h"
+#include "theory/quantifiers/cegqi/nested_qe.h"
 
 namespace cvc5 {
 namespace smt {
@@ -96,6 +97,12 @@ class QuantElimSolver
  private:
   /** The SMT solver, which is used during doQuantifierElimination. */
   SmtSolver& d_smtSolver;
+  /**
+   * The cache of the results of quantifier elimination on the nested
+   * quantified formulas of q, which persists across calls, since these
+   * results do not depend on the assertions.
+   */
+  theory::quantifiers::NestedQeCache d_nestedQeCache;
 };
 
 }  // namespace smt
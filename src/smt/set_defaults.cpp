@@ -75,6 +75,25 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     Notice() << "SmtEngine: setting unsatCores" << std::endl;
     options::unsatCores.set(true);
   }
+  if (options::unsatCoresAssumptions())
+  {
+    if (options::produceProofs() || options::checkUnsatCoresNew()
+        || options::cubeDepth() > 0 || options::globalNegate())
+    {
+      throw OptionException(
+          "unsat cores from assumptions are not supported when producing "
+          "proofs, with global-negate, or when solving a single cube "
+          "(--cube-depth).");
+    }
+    // the unsat cores are computed from the selectors of the input formulas,
+    // hence the unsat core infrastructure based on proofs is not used
+    if (options::unsatCores())
+    {
+      Notice() << "SmtEngine: computing unsat cores from assumptions"
+               << std::endl;
+      options::unsatCores.set(false);
+    }
+  }
   if (options::checkProofs() || options::checkUnsatCoresNew()
       || options::dumpProofs())
   {
@@ -125,9 +144,14 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
           "only supported for QF_BV. Try --bitblast=lazy.");
     }
 
-    // Force lazy solver since we don't handle EAGER_ATOMS in the
-    // BVSolver::BITBLAST solver.
-    options::bvSolver.set(options::BVSolver::LAZY);
+    // Force lazy solver unless the BVSolver::BITBLAST solver was requested,
+    // which handles EAGER_ATOMS with activation literals. It keeps the
+    // bit-blasted clauses across incremental check-sat calls.
+    if (!options::bvSolver.wasSetByUser()
+        || options::bvSolver() != options::BVSolver::BITBLAST)
+    {
+      options::bvSolver.set(options::BVSolver::LAZY);
+    }
   }
 
   /* Only BVSolver::LAZY natively supports int2bv and nat2bv, for other solvers
@@ -145,6 +169,18 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     options::bitvectorPropagate.set(false);
   }
 
+  if (options::cubeDepth() > 0)
+  {
+    // the answer of a single cube is not an answer to the full problem
+    if (options::incrementalSolving() || options::unsatCores()
+        || options::produceProofs())
+    {
+      throw OptionException(
+          "solving a single cube (--cube-depth) is not supported when solving "
+          "incrementally or producing unsat cores or proofs.");
+    }
+  }
+
   if (options::solveIntAsBV() > 0)
   {
     // not compatible with incremental
@@ -362,31 +398,49 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     options::produceAssertions.set(true);
   }
 
-  // Disable options incompatible with incremental solving, unsat cores or
-  // output an error if enabled explicitly. It is also currently incompatible
-  // with arithmetic, force the option off.
-  if (options::incrementalSolving() || options::unsatCores())
+  // the CaDiCaL CDCL(T) backend supports neither proofs nor unsat cores
+  if (options::cdcltSatSolver() == options::CDCLTSatSolverMode::CADICAL
+      && (options::produceProofs() || options::unsatCores()))
+  {
+    Notice() << "SmtEngine: using Minisat for the CDCL(T) search to support "
+                "proofs/unsat cores"
+             << std::endl;
+    options::cdcltSatSolver.set(options::CDCLTSatSolverMode::MINISAT);
+  }
+
+  // Disable options incompatible with unsat cores or output an error if
+  // enabled explicitly. With incremental solving, unconstrained
+  // simplification is supported but only used if enabled explicitly.
+  if (options::unsatCores() || options::unsatCoresAssumptions())
   {
     if (options::unconstrainedSimp())
     {
       if (options::unconstrainedSimp.wasSetByUser())
       {
         throw OptionException(
-            "unconstrained simplification not supported with unsat "
-            "cores/incremental solving");
+            "unconstrained simplification not supported with unsat cores");
       }
       Notice() << "SmtEngine: turning off unconstrained simplification to "
-                  "support unsat cores/incremental solving"
+                  "support unsat cores"
                << std::endl;
       options::unconstrainedSimp.set(false);
     }
   }
+  else if (options::incrementalSolving())
+  {
+    if (!options::unconstrainedSimp.wasSetByUser())
+    {
+      options::unconstrainedSimp.set(false);
+    }
+  }
   else
   {
-    // Turn on unconstrained simplification for QF_AUFBV
+    // Turn on unconstrained simplification for QF_AUFBV, unless the
+    // assumptions are solved by the SAT solver, which it does not see
     if (!options::unconstrainedSimp.wasSetByUser())
     {
-      bool uncSimp = !logic.isQuantified() && !options::produceModels()
+      bool uncSimp = !logic.isQuantified() && !options::assumptionSolving()
+                     && !options::produceModels()
                      && !options::produceAssignments()
                      && !options::checkModels()
                      && logic.isTheoryEnabled(THEORY_ARRAYS)
@@ -412,6 +466,17 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
                << std::endl;
       options::sygusInference.set(false);
     }
+    /* The slices of a variable would not be connected to the variable in
+     * the assertions of the previous check-sat calls. */
+    if (options::bvSlice())
+    {
+      if (options::bvSlice.wasSetByUser())
+      {
+        throw OptionException("bv-slice not supported with incremental "
+                              "solving");
+      }
+      options::bvSlice.set(false);
+    }
   }
 
   if (options::solveBVAsInt() != options::SolveBVAsIntMode::OFF)
@@ -425,11 +490,23 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     options::bitvectorToBool.set(true);
   }
 
+  // Native pseudoboolean constraints are added to the SAT solver permanently
+  // and have no proofs
+  if (options::pbNative()
+      && (options::incrementalSolving() || options::produceProofs()))
+  {
+    throw OptionException(
+        "native pseudoboolean constraints not supported with incremental "
+        "solving or proofs");
+  }
+
   // Disable options incompatible with unsat cores or output an error if enabled
-  // explicitly
-  if (options::unsatCores())
+  // explicitly. Simplification does not affect unsat cores from assumptions,
+  // since the input formulas are guarded by their selectors.
+  if (options::unsatCores() || options::unsatCoresAssumptions())
   {
-    if (options::simplificationMode() != options::SimplificationMode::NONE)
+    if (options::unsatCores()
+        && options::simplificationMode() != options::SimplificationMode::NONE)
     {
       if (options::simplificationMode.wasSetByUser())
       {
@@ -454,6 +531,19 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
       options::pbRewrites.set(false);
     }
 
+    if (options::pbNative())
+    {
+      if (options::pbNative.wasSetByUser())
+      {
+        throw OptionException(
+            "native pseudoboolean constraints not supported with unsat cores");
+      }
+      Notice() << "SmtEngine: turning off native pseudoboolean constraints "
+                  "to support unsat cores"
+               << std::endl;
+      options::pbNative.set(false);
+    }
+
     if (options::sortInference())
     {
       if (options::sortInference.wasSetByUser())
@@ -517,6 +607,30 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
       options::bvIntroducePow2.set(false);
     }
 
+    if (options::bvSlice())
+    {
+      if (options::bvSlice.wasSetByUser())
+      {
+        throw OptionException("bv-slice not supported with unsat cores");
+      }
+      Notice() << "SmtEngine: turning off bv-slice to support unsat-cores"
+               << std::endl;
+      options::bvSlice.set(false);
+    }
+
+    if (options::stringLenCheck())
+    {
+      if (options::stringLenCheck.wasSetByUser())
+      {
+        throw OptionException(
+            "strings-len-check not supported with unsat cores");
+      }
+      Notice() << "SmtEngine: turning off strings-len-check to support "
+                  "unsat-cores"
+               << std::endl;
+      options::stringLenCheck.set(false);
+    }
+
     if (options::repeatSimp())
     {
       if (options::repeatSimp.wasSetByUser())
@@ -551,7 +665,7 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
       throw OptionException("ITE simp not supported with unsat cores");
     }
   }
-  else
+  if (!options::unsatCores())
   {
     // by default, nonclausal simplification is off for QF_SAT
     if (!options::simplificationMode.wasSetByUser())
@@ -1319,6 +1433,18 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     }
   }
 
+  if (options::relevanceLazyAssert() && !options::relevanceFilter())
+  {
+    if (options::relevanceFilter.wasSetByUser())
+    {
+      Warning() << "SmtEngine: turning on relevance filtering to support "
+                   "--relevance-lazy-assert"
+                << std::endl;
+    }
+    // the relevance manager determines which literals are asserted
+    options::relevanceFilter.set(true);
+  }
+
   if (logic.isTheoryEnabled(THEORY_ARITH) && !logic.isLinear()
       && options::nlRlvMode() != options::NlRlvMode::NONE)
   {
@@ -1477,6 +1603,102 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     }
   }
 #endif
+
+  // The assumptions solved by the SAT solver (--assumption-solving) are not
+  // asserted, hence they cannot occur in unsat cores or proofs. They only have
+  // their definitions expanded and the top-level substitutions applied, hence
+  // they are not seen by the preprocessing passes that eliminate or re-encode
+  // the symbols of the assertions, e.g. unconstrained simplification could
+  // eliminate a variable that an assumption constrains. This must come last,
+  // since the options of these passes are set above.
+  if (options::assumptionSolving())
+  {
+    std::string sOptNoAssume;
+    if (options::unsatCores() || options::unsatCoresAssumptions())
+    {
+      sOptNoAssume = "unsat cores";
+    }
+    else if (options::produceProofs())
+    {
+      sOptNoAssume = "proofs";
+    }
+    else if (options::cubeDepth() > 0)
+    {
+      sOptNoAssume = "cube-depth";
+    }
+    else if (options::globalNegate())
+    {
+      sOptNoAssume = "global-negate";
+    }
+    else if (isSygus)
+    {
+      sOptNoAssume = "sygus";
+    }
+    else if (options::unconstrainedSimp())
+    {
+      sOptNoAssume = "unconstrained-simp";
+    }
+    else if (options::boolToBitvector() != options::BoolToBVMode::OFF)
+    {
+      sOptNoAssume = "bool-to-bv";
+    }
+    else if (options::bitvectorToBool())
+    {
+      sOptNoAssume = "bv-to-bool";
+    }
+    else if (options::solveBVAsInt() != options::SolveBVAsIntMode::OFF)
+    {
+      sOptNoAssume = "solve-bv-as-int";
+    }
+    else if (options::solveIntAsBV() > 0)
+    {
+      sOptNoAssume = "solve-int-as-bv";
+    }
+    else if (options::solveRealAsInt())
+    {
+      sOptNoAssume = "solve-real-as-int";
+    }
+    else if (options::ackermann())
+    {
+      sOptNoAssume = "ackermann";
+    }
+    else if (options::bvAbstraction())
+    {
+      sOptNoAssume = "bv-abstraction";
+    }
+    else if (options::bvSlice())
+    {
+      sOptNoAssume = "bv-slice";
+    }
+    else if (options::sortInference())
+    {
+      sOptNoAssume = "sort-inference";
+    }
+    else if (options::arithMLTrick())
+    {
+      sOptNoAssume = "miplib-trick";
+    }
+    else if (options::macrosQuant())
+    {
+      sOptNoAssume = "macros-quant";
+    }
+    else if (options::fmfFunWellDefined())
+    {
+      sOptNoAssume = "fmf-fun";
+    }
+    if (!sOptNoAssume.empty())
+    {
+      if (options::assumptionSolving.wasSetByUser())
+      {
+        std::stringstream ss;
+        ss << "Cannot use assumption solving with " << sOptNoAssume << ".";
+        throw OptionException(ss.str());
+      }
+      Notice() << "SmtEngine: turning off assumption solving to support "
+               << sOptNoAssume << std::endl;
+      options::assumptionSolving.set(false);
+    }
+  }
 }
 
 }  // namespace smt
@@ -24,10 +24,13 @@
 #include "expr/bound_var_manager.h"
 #include "expr/node.h"
 #include "options/base_options.h"
+#include "options/expr_options.h"
 #include "options/language.h"
 #include "options/main_options.h"
 #include "options/printer_options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
+#include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "options/theory_options.h"
 #include "printer/printer.h"
@@ -56,6 +59,7 @@
 #include "smt/smt_engine_state.h"
 #include "smt/smt_engine_stats.h"
 #include "smt/smt_solver.h"
+#include "smt/snapshot.h"
 #include "smt/sygus_solver.h"
 #include "smt/unsat_core_manager.h"
 #include "theory/quantifiers/instantiation_list.h"
@@ -64,6 +68,7 @@
 #include "theory/rewriter.h"
 #include "theory/smt_engine_subsolver.h"
 #include "theory/theory_engine.h"
+#include "theory/trust_substitutions.h"
 #include "util/random.h"
 #include "util/resource_manager.h"
 
@@ -95,10 +100,12 @@ SmtEngine::SmtEngine(NodeManager* nm, Options* optr)
       d_ucManager(nullptr),
       d_definedFunctions(nullptr),
       d_sygusSolver(nullptr),
+      d_sygusListener(nullptr),
       d_abductSolver(nullptr),
       d_interpolSolver(nullptr),
       d_quantElimSolver(nullptr),
       d_isInternalSubsolver(false),
+      d_optionsFinalized(false),
       d_stats(nullptr),
       d_outMgr(this),
       d_optm(nullptr),
@@ -129,6 +136,7 @@ SmtEngine::SmtEngine(NodeManager* nm, Options* optr)
   getResourceManager()->registerListener(d_routListener.get());
   // make statistics
   d_stats.reset(new SmtEngineStatistics());
+  getNodeManager()->registerStatistics(*getStatisticsRegistry());
   // reset the preprocessor
   d_pp.reset(new smt::Preprocessor(
       *this, getUserContext(), *d_absValues.get(), *d_stats));
@@ -211,7 +219,12 @@ void SmtEngine::finishInit()
   // Call finish init on the options manager. This inializes the resource
   // manager based on the options, and sets up the best default options
   // based on our heuristics.
-  d_optm->finishInit(d_env->d_logic, d_isInternalSubsolver);
+  d_optm->finishInit(
+      d_env->d_logic, d_isInternalSubsolver, !d_optionsFinalized);
+
+  // configure garbage collection of nodes
+  getNodeManager()->setGcOptions(options::gcZombieThreshold(),
+                                 options::gcSliceBudget());
 
   ProofNodeManager* pnm = nullptr;
   if (options::produceProofs())
@@ -340,6 +353,7 @@ SmtEngine::~SmtEngine()
 
     d_smtSolver.reset(nullptr);
 
+    getNodeManager()->unregisterStatistics(*getStatisticsRegistry());
     d_stats.reset(nullptr);
     getNodeManager()->unsubscribeEvents(d_snmListener.get());
     d_snmListener.reset(nullptr);
@@ -404,6 +418,24 @@ LogicInfo SmtEngine::getUserLogicInfo() const
   return res;
 }
 
+void SmtEngine::configureFrom(const SmtEngine& tmpl)
+{
+  SmtScope smts(this);
+  Assert(tmpl.isFullyInited());
+  if (d_state->isFullyInited())
+  {
+    throw ModalException("Cannot configure SmtEngine after the engine has "
+                         "finished initializing.");
+  }
+  // the final logic of tmpl, which was already widened by setDefaults, and
+  // the logic of the user, which determines the theories to instantiate
+  d_env->d_logic = tmpl.getLogicInfo();
+  d_userLogic = tmpl.d_userLogic;
+  setLogicInternal();
+  d_optionsFinalized = true;
+  finishInit();
+}
+
 void SmtEngine::notifyStartParsing(const std::string& filename)
 {
   d_state->setFilename(filename);
@@ -943,6 +975,8 @@ Result SmtEngine::checkSatInternal(const std::vector<Node>& assumptions,
     // check the satisfiability with the solver object
     Result r = d_smtSolver->checkSatisfiability(
         *d_asserts.get(), assumptions, inUnsatCore, isEntailmentCheck);
+    // an interrupt request is answered by the check it interrupted
+    getResourceManager()->clearInterrupt();
 
     Trace("smt") << "SmtEngine::" << (isEntailmentCheck ? "query" : "checkSat")
                  << "(" << assumptions << ") => " << r << endl;
@@ -977,6 +1011,19 @@ Result SmtEngine::checkSatInternal(const std::vector<Node>& assumptions,
         checkUnsatCore();
       }
     }
+    // Record the instantiations used in the proof in the profile of the
+    // quantified formulas.
+    if (options::quantProfile() && options::produceProofs()
+        && r.asSatisfiabilityResult().isSat() == Result::UNSAT)
+    {
+      QuantifiersEngine* qe = d_smtSolver->getQuantifiersEngine();
+      if (qe != nullptr)
+      {
+        std::map<Node, std::vector<std::vector<Node>>> insts;
+        getRelevantInstantiationTermVectors(insts);
+        qe->notifyRelevantInstantiations(insts);
+      }
+    }
 
     return r;
   }
@@ -987,9 +1034,15 @@ Result SmtEngine::checkSatInternal(const std::vector<Node>& assumptions,
     // make the solver resume a working state after an interupt, then we would
     // implement a different callback and use it here, e.g.
     // d_state.notifyCheckSatInterupt.
-    Result::UnknownExplanation why = getResourceManager()->outOfResources()
-                                         ? Result::RESOURCEOUT
-                                         : Result::TIMEOUT;
+    ResourceManager* rm = getResourceManager();
+    Result::UnknownExplanation why =
+        rm->outOfResources()
+            ? Result::RESOURCEOUT
+            : (rm->outOfMemory()
+                   ? Result::MEMOUT
+                   : (rm->interrupted() ? Result::INTERRUPTED
+                                        : Result::TIMEOUT));
+    rm->clearInterrupt();
     return Result(Result::SAT_UNKNOWN, why, d_state->getFilename());
   }
 }
@@ -1129,6 +1182,16 @@ Result SmtEngine::checkSynth()
   return d_sygusSolver->checkSynth(*d_asserts);
 }
 
+void SmtEngine::setSygusSolutionListener(smt::SygusSolutionListener* l)
+{
+  d_sygusListener = l;
+}
+
+smt::SygusSolutionListener* SmtEngine::getSygusSolutionListener() const
+{
+  return d_sygusListener;
+}
+
 /*
    --------------------------------------------------------------------------
     End of Handling SyGuS commands
@@ -1311,6 +1374,81 @@ Result SmtEngine::blockModelValues(const std::vector<Node>& exprs)
   return assertFormula(eblocker);
 }
 
+Result SmtEngine::enumerateModels(
+    const std::vector<Node>& terms,
+    std::function<bool(const std::vector<Node>&)> notify,
+    uint64_t limit)
+{
+  Trace("smt") << "SMT enumerateModels(" << terms << ", " << limit << ")"
+               << endl;
+  SmtScope smts(this);
+
+  finishInit();
+
+  if (!options::produceModels())
+  {
+    throw ModalException(
+        "Cannot enumerate models unless model generation is enabled "
+        "(try --produce-models)");
+  }
+  if (!options::incrementalSolving())
+  {
+    throw ModalException(
+        "Cannot enumerate models unless incremental solving is enabled "
+        "(try --incremental)");
+  }
+  if (options::globalNegate())
+  {
+    throw ModalException(
+        "Cannot enumerate models when global negation is enabled.");
+  }
+
+  NodeManager* nm = getNodeManager();
+  Result r = checkSat();
+  // the guard of the blocking clauses, created for the first one
+  Node guard;
+  uint64_t nmodels = 0;
+  while (r.asSatisfiabilityResult().isSat() == Result::SAT)
+  {
+    std::vector<Node> values;
+    for (const Node& t : terms)
+    {
+      values.push_back(getValue(t));
+    }
+    nmodels++;
+    Trace("smt-enum") << "enumerateModels: model #" << nmodels << " " << values
+                      << endl;
+    if (notify(values) || nmodels == limit)
+    {
+      break;
+    }
+    // block the values of terms
+    std::vector<Node> disj;
+    for (size_t i = 0, nterms = terms.size(); i < nterms; i++)
+    {
+      disj.push_back(terms[i].eqNode(values[i]).notNode());
+    }
+    Node blocker = nm->mkOr(disj);
+    if (guard.isNull())
+    {
+      guard = nm->mkSkolem("G",
+                           nm->booleanType(),
+                           "the guard of the clauses blocking the models "
+                           "enumerated by enumerateModels");
+    }
+    r = d_smtSolver->checkSatisfiabilityBlocked(blocker, guard);
+  }
+  if (!guard.isNull())
+  {
+    // The blocking clauses only hold under the assumption of the guard, which
+    // is never decided to be true from now on.
+    getPropEngine()->requirePhase(guard, false);
+  }
+  Trace("smt") << "SMT enumerateModels: " << nmodels << " models, " << r
+               << endl;
+  return r;
+}
+
 std::pair<Node, Node> SmtEngine::getSepHeapAndNilExpr(void)
 {
   if (!getLogicInfo().isTheoryEnabled(THEORY_SEP))
@@ -1400,7 +1538,7 @@ StatisticsRegistry* SmtEngine::getStatisticsRegistry()
 
 UnsatCore SmtEngine::getUnsatCoreInternal()
 {
-  if (!options::unsatCores())
+  if (!options::unsatCores() && !options::unsatCoresAssumptions())
   {
     throw ModalException(
         "Cannot get an unsat core when produce-unsat-cores option is off.");
@@ -1411,6 +1549,13 @@ UnsatCore SmtEngine::getUnsatCoreInternal()
         "Cannot get an unsat core unless immediately preceded by "
         "UNSAT/ENTAILED response.");
   }
+  // use the failed assumptions of the SAT solver
+  if (options::unsatCoresAssumptions())
+  {
+    std::vector<Node> core;
+    d_smtSolver->getAssumptionCore(*d_asserts, core);
+    return UnsatCore(core);
+  }
   // use old proof infrastructure
   if (!d_pfManager)
   {
@@ -1429,7 +1574,7 @@ UnsatCore SmtEngine::getUnsatCoreInternal()
 }
 
 void SmtEngine::checkUnsatCore() {
-  Assert(options::unsatCores())
+  Assert(options::unsatCores() || options::unsatCoresAssumptions())
       << "cannot check unsat core if unsat cores are turned off";
 
   Notice() << "SmtEngine::checkUnsatCore(): generating unsat core" << endl;
@@ -1442,6 +1587,7 @@ void SmtEngine::checkUnsatCore() {
   // disable all proof options
   coreChecker->getOptions().set(options::produceProofs, false);
   coreChecker->getOptions().set(options::checkUnsatCoresNew, false);
+  coreChecker->getOptions().set(options::unsatCoresAssumptions, false);
   // set up separation logic heap if necessary
   TypeNode sepLocType, sepDataType;
   if (getSepHeapTypes(sepLocType, sepDataType))
@@ -1721,6 +1867,100 @@ void SmtEngine::getInstantiationTermVectors(
   qe->getInstantiationTermVectors(q, tvecs);
 }
 
+std::vector<Node> SmtEngine::getLearnedClauses(uint32_t maxSize,
+                                               uint32_t maxLbd)
+{
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT getLearnedClauses(" << maxSize << ", " << maxLbd << ")"
+               << endl;
+  // the SAT solver may differ from --sat-solver, e.g. CaDiCaL falls back to
+  // Minisat when producing proofs
+  PropEngine* pe = getPropEngine();
+  if (!pe->supportsLearnedClauses())
+  {
+    throw ModalException(
+        "Cannot get learned clauses, the SAT solver does not support it.");
+  }
+  std::vector<Node> res;
+  pe->getLearnedClauses(res, maxSize, maxLbd);
+  return res;
+}
+
+void SmtEngine::addLearnedClauses(const std::vector<Node>& clauses)
+{
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT addLearnedClauses(" << clauses.size() << " clauses)"
+               << endl;
+  if (options::produceProofs() || options::unsatCores())
+  {
+    throw ModalException(
+        "Cannot add learned clauses when producing proofs or unsat cores.");
+  }
+  PropEngine* pe = getPropEngine();
+  for (const Node& c : clauses)
+  {
+    Node n = d_absValues->substituteAbstractValues(c);
+    Assert(n.getType().isBoolean());
+    // the clauses are over the input symbols, hence we expand definitions and
+    // apply the substitutions learned from the assertions
+    n = d_pp->processAssumption(n);
+    pe->assertLemma(theory::TrustNode::mkTrustLemma(n),
+                    theory::LemmaProperty::REMOVABLE);
+  }
+}
+
+void SmtEngine::saveSnapshot(const std::string& filename)
+{
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT saveSnapshot(" << filename << ")" << endl;
+  checkSnapshotMode("save");
+  smt::Snapshot snapshot;
+  d_smtSolver->processAssertions(*d_asserts, &snapshot);
+  theory::SubstitutionMap& sm = d_pp->getTopLevelSubstitutions().get();
+  for (theory::SubstitutionMap::iterator it = sm.begin(); it != sm.end(); ++it)
+  {
+    snapshot.addSubstitution((*it).first, (*it).second);
+  }
+  snapshot.write(filename);
+}
+
+void SmtEngine::loadSnapshot(const std::string& filename,
+                             const std::vector<Node>& decls)
+{
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT loadSnapshot(" << filename << ")" << endl;
+  checkSnapshotMode("load");
+  smt::Snapshot snapshot;
+  snapshot.read(filename, decls);
+  d_pp->notifyPreprocessed(snapshot.getAssertions(),
+                           snapshot.getSubstitutions());
+  d_smtSolver->assertPreprocessed(snapshot.getAssertions(),
+                                  snapshot.getIteSkolemMap());
+}
+
+void SmtEngine::checkSnapshotMode(const char* op) const
+{
+  if (options::produceProofs() || options::unsatCores())
+  {
+    throw ModalException(std::string("Cannot ") + op
+                         + " a snapshot when producing proofs or unsat cores.");
+  }
+  if (d_pp->hasProcessedAssertions() || d_state->getNumUserLevels() > 0)
+  {
+    throw ModalException(std::string("Cannot ") + op
+                         + " a snapshot after assertions have been "
+                           "preprocessed or at a user level above 0.");
+  }
+}
+
 std::vector<Node> SmtEngine::getAssertions()
 {
   SmtScope smts(this);
@@ -1870,6 +2110,12 @@ void SmtEngine::safeFlushStatistics(int fd) const
   d_env->getStatisticsRegistry()->safeFlushInformation(fd);
 }
 
+void SmtEngine::snapshotStatistics(
+    std::vector<std::pair<std::string, int64_t>>& values) const
+{
+  d_env->getStatisticsRegistry()->snapshot(values);
+}
+
 void SmtEngine::setUserAttribute(const std::string& attr,
                                  Node expr,
                                  const std::vector<Node>& expr_values,
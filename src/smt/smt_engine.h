@@ -19,9 +19,11 @@
 #ifndef CVC4__SMT_ENGINE_H
 #define CVC4__SMT_ENGINE_H
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "context/cdhashmap_forward.h"
@@ -93,6 +95,7 @@ class Preprocessor;
 class CheckModels;
 /** Subsolvers */
 class SmtSolver;
+class SygusSolutionListener;
 class SygusSolver;
 class AbductionSolver;
 class InterpolationSolver;
@@ -210,6 +213,15 @@ class CVC4_EXPORT SmtEngine
   /** Get the logic information set by the user. */
   LogicInfo getUserLogicInfo() const;
 
+  /**
+   * Configure this SmtEngine as tmpl, which must be fully initialized, and
+   * finish initializing it. This sets the logic to the final logic of tmpl
+   * and does not set the default options again, since the options of this
+   * SmtEngine must be a copy of the (finalized) options of tmpl.
+   * @throw ModalException
+   */
+  void configureFrom(const SmtEngine& tmpl);
+
   /**
    * Set information about the script executing.
    */
@@ -291,6 +303,33 @@ class CVC4_EXPORT SmtEngine
    */
   Result blockModelValues(const std::vector<Node>& exprs);
 
+  /**
+   * Enumerate the models of the current assertions that differ in the values
+   * of the given terms. Only permitted if produce-models and incremental are
+   * on.
+   *
+   * This checks satisfiability once as checkSat does. Then, for each model,
+   * the values of terms are passed to notify, and the model is blocked as in
+   * blockModelValues. In contrast to calling checkSat and blockModelValues
+   * repeatedly, the blocking clauses are added directly to the prop engine
+   * as lemmas guarded by a fresh variable, and the next model is found by the
+   * same SAT solver under the assumption of that variable, without processing
+   * the assertions again.
+   *
+   * The enumeration stops when notify returns true, when limit models were
+   * enumerated (if limit is not 0), or when a check does not answer sat. The
+   * blocking clauses do not affect subsequent checks.
+   *
+   * @param terms The terms whose values distinguish the models
+   * @param notify The callback for the values of terms in each model
+   * @param limit The maximal number of models, 0 for no limit
+   * @return The result of the last check, which is unsat if all models were
+   * enumerated and sat if the enumeration was stopped by notify or limit
+   */
+  Result enumerateModels(const std::vector<Node>& terms,
+                         std::function<bool(const std::vector<Node>&)> notify,
+                         uint64_t limit);
+
   /**
    * Declare heap. For smt2 inputs, this is called when the command
    * (declare-heap (locT datat)) is invoked by the user. This sets locT as the
@@ -495,6 +534,15 @@ class CVC4_EXPORT SmtEngine
    */
   Result checkSynth();
 
+  /**
+   * Set the listener that is notified of the solutions found while streaming
+   * solutions (--sygus-stream), or unset it if l is null. The listener is not
+   * owned by this SMT engine.
+   */
+  void setSygusSolutionListener(smt::SygusSolutionListener* l);
+  /** Get the listener set above, or null if none is set */
+  smt::SygusSolutionListener* getSygusSolutionListener() const;
+
   /*------------------------- end of sygus commands ------------------------*/
 
   /**
@@ -712,6 +760,51 @@ class CVC4_EXPORT SmtEngine
    */
   std::vector<Node> getAssertions();
 
+  /**
+   * Get the clauses learned by the SAT solver with at most maxSize literals
+   * and literal block distance at most maxLbd (where 0 means no bound), as
+   * disjunctions of literals over the input symbols. The returned clauses are
+   * consequences of the current assertions, and may be passed to
+   * addLearnedClauses of another SmtEngine for the same assertions. Only
+   * permitted when the SAT solver supports it, which is currently only
+   * Minisat.
+   */
+  std::vector<Node> getLearnedClauses(uint32_t maxSize, uint32_t maxLbd);
+
+  /**
+   * Add clauses learned for the current assertions, e.g. by another SmtEngine,
+   * as redundant clauses of the SAT solver. It is the responsibility of the
+   * caller that the clauses are consequences of the current assertions. Not
+   * permitted when producing proofs or unsat cores.
+   */
+  void addLearnedClauses(const std::vector<Node>& clauses);
+
+  /**
+   * Preprocess the current assertions and write the resulting state to the
+   * file with the given name, see smt::Snapshot. Its assertions remain
+   * asserted in this SmtEngine. Only permitted if no assertions have been
+   * preprocessed before, i.e. before any check and at user level 0, and not
+   * when producing proofs or unsat cores.
+   *
+   * @throw ModalException, Exception
+   */
+  void saveSnapshot(const std::string& filename);
+
+  /**
+   * Restore the state written by saveSnapshot to the file with the given name
+   * into this SmtEngine: its preprocessed assertions are sent to the SAT
+   * solver without preprocessing them again, and its substitutions are added
+   * to the top-level substitutions. The symbols of the file named as those in
+   * decls are mapped to them, e.g. to the symbols re-declared by the user;
+   * the other symbols are created fresh. Only permitted under the same
+   * conditions as saveSnapshot. Since they are not in the assertion list, the
+   * restored assertions are not covered by get-assertions and check-models.
+   *
+   * @throw ModalException, Exception
+   */
+  void loadSnapshot(const std::string& filename,
+                    const std::vector<Node>& decls);
+
   /**
    * Push a user-level context.
    * throw@ ModalException, LogicException, UnsafeInterruptException
@@ -832,6 +925,14 @@ class CVC4_EXPORT SmtEngine
    */
   void safeFlushStatistics(int fd) const;
 
+  /**
+   * Take a snapshot of the statistics from this SmtEngine, see
+   * StatisticsRegistry::snapshot. Unlike the other methods of this class, this
+   * may be called by another thread than the one using this SmtEngine.
+   */
+  void snapshotStatistics(
+      std::vector<std::pair<std::string, int64_t>>& values) const;
+
   /**
    * Set user attribute.
    * This function is called when an attribute is set by a user.
@@ -935,6 +1036,12 @@ class CVC4_EXPORT SmtEngine
    */
   void checkModel(bool hardFailure = true);
 
+  /**
+   * Throw a ModalException if a snapshot cannot be saved or loaded, where op
+   * is "save" or "load".
+   */
+  void checkSnapshotMode(const char* op) const;
+
   /**
    * Check that a solution to an interpolation problem is indeed a solution.
    *
@@ -1107,6 +1214,8 @@ class CVC4_EXPORT SmtEngine
 
   /** The solver for sygus queries */
   std::unique_ptr<smt::SygusSolver> d_sygusSolver;
+  /** The listener for streamed sygus solutions, if any */
+  smt::SygusSolutionListener* d_sygusListener;
 
   /** The solver for abduction queries */
   std::unique_ptr<smt::AbductionSolver> d_abductSolver;
@@ -1124,6 +1233,12 @@ class CVC4_EXPORT SmtEngine
   /** Whether this is an internal subsolver. */
   bool d_isInternalSubsolver;
 
+  /**
+   * Whether the options and the logic were finalized by another SmtEngine,
+   * see configureFrom.
+   */
+  bool d_optionsFinalized;
+
   /**
    * Verbosity of various commands.
    */
@@ -14,6 +14,8 @@
 
 #include "smt/smt_solver.h"
 
+#include <unordered_set>
+
 #include "options/smt_options.h"
 #include "prop/prop_engine.h"
 #include "smt/assertions.h"
@@ -21,6 +23,7 @@
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_state.h"
 #include "smt/smt_engine_stats.h"
+#include "smt/snapshot.h"
 #include "theory/logic_info.h"
 #include "theory/theory_engine.h"
 #include "theory/theory_traits.h"
@@ -59,11 +62,20 @@ void SmtSolver::finishInit(const LogicInfo& logicInfo)
                                         d_smt.getOutputManager(),
                                         d_pnm));
 
-  // Add the theories
+  // Add the theories. Since the logic is fixed from now on, we only add the
+  // theories that are enabled by the logic, which saves the construction of
+  // the others, including their rewriters and statistics. We also add the
+  // theories of the logic set by the user, which may contain more theories
+  // whose terms must be rewritten and preprocessed before they are
+  // eliminated, e.g. UF with --ackermann.
+  LogicInfo userLogic = d_smt.getUserLogicInfo();
   for (theory::TheoryId id = theory::THEORY_FIRST; id < theory::THEORY_LAST;
        ++id)
   {
-    theory::TheoryConstructor::addTheory(d_theoryEngine.get(), id);
+    if (logicInfo.isTheoryEnabled(id) || userLogic.isTheoryEnabled(id))
+    {
+      theory::TheoryConstructor::addTheory(d_theoryEngine.get(), id);
+    }
   }
 
   Trace("smt-debug") << "Making prop engine..." << std::endl;
@@ -136,10 +148,16 @@ Result SmtSolver::checkSatisfiability(Assertions& as,
 {
   // update the state to indicate we are about to run a check-sat
   bool hasAssumptions = !assumptions.empty();
-  d_state.notifyCheckSat(hasAssumptions);
+  // whether the assumptions are passed to the SAT solver instead of being
+  // asserted in a new context, which we do not do for entailment checks since
+  // e.g. quantifier elimination relies on their assertion
+  bool solveAssuming =
+      hasAssumptions && !isEntailmentCheck && options::assumptionSolving();
+  d_state.notifyCheckSat(hasAssumptions && !solveAssuming);
 
   // then, initialize the assertions
-  as.initializeCheckSat(assumptions, inUnsatCore, isEntailmentCheck);
+  as.initializeCheckSat(
+      assumptions, inUnsatCore, isEntailmentCheck, !solveAssuming);
 
   // make the check
   Assert(d_smt.isFullyInited());
@@ -150,7 +168,12 @@ Result SmtSolver::checkSatisfiability(Assertions& as,
   if (d_rm->out())
   {
     Result::UnknownExplanation why =
-        d_rm->outOfResources() ? Result::RESOURCEOUT : Result::TIMEOUT;
+        d_rm->outOfResources()
+            ? Result::RESOURCEOUT
+            : (d_rm->outOfMemory()
+                   ? Result::MEMOUT
+                   : (d_rm->interrupted() ? Result::INTERRUPTED
+                                          : Result::TIMEOUT));
     return Result(Result::ENTAILMENT_UNKNOWN, why, filename);
   }
   d_rm->beginCall();
@@ -164,7 +187,26 @@ Result SmtSolver::checkSatisfiability(Assertions& as,
 
   Chat() << "solving..." << endl;
   Trace("smt") << "SmtSolver::check(): running check" << endl;
-  Result result = d_propEngine->checkSat();
+  Result result;
+  if (solveAssuming)
+  {
+    std::vector<Node> ppAssumptions;
+    for (const Node& a : as.getAssumptions())
+    {
+      ppAssumptions.push_back(d_pp.processAssumption(a));
+    }
+    result = d_propEngine->checkSat(ppAssumptions);
+  }
+  else if (options::unsatCoresAssumptions())
+  {
+    const context::CDList<Node>& sels = as.getSelectors();
+    std::vector<Node> selectors(sels.begin(), sels.end());
+    result = d_propEngine->checkSat(selectors);
+  }
+  else
+  {
+    result = d_propEngine->checkSat();
+  }
 
   d_rm->endCall();
   Trace("limit") << "SmtSolver::check(): cumulative millis "
@@ -208,12 +250,103 @@ Result SmtSolver::checkSatisfiability(Assertions& as,
   Result r = Result(result, filename);
 
   // notify our state of the check-sat result
-  d_state.notifyCheckSatResult(hasAssumptions, r);
+  d_state.notifyCheckSatResult(hasAssumptions && !solveAssuming, r);
+
+  return r;
+}
+
+Result SmtSolver::checkSatisfiabilityBlocked(const Node& blocker,
+                                             const Node& guard)
+{
+  Assert(guard.isVar() && guard.getType().isBoolean());
+  d_state.notifyCheckSat(false);
+  const std::string& filename = d_state.getFilename();
+  if (d_rm->out())
+  {
+    Result::UnknownExplanation why =
+        d_rm->outOfResources()
+            ? Result::RESOURCEOUT
+            : (d_rm->outOfMemory()
+                   ? Result::MEMOUT
+                   : (d_rm->interrupted() ? Result::INTERRUPTED
+                                          : Result::TIMEOUT));
+    return Result(Result::SAT_UNKNOWN, why, filename);
+  }
+  d_rm->beginCall();
 
+  Node lem = d_pp.processAssumption(guard.impNode(blocker));
+  Trace("smt") << "SmtSolver::checkSatisfiabilityBlocked(): add " << lem
+               << endl;
+  d_propEngine->assertLemma(theory::TrustNode::mkTrustLemma(lem),
+                            theory::LemmaProperty::NONE);
+
+  TimerStat::CodeTimer solveTimer(d_stats.d_solveTime);
+  Result result = d_propEngine->checkSat({guard});
+  d_rm->endCall();
+  if ((options::solveRealAsInt() || options::solveIntAsBV() > 0)
+      && result.asSatisfiabilityResult().isSat() == Result::UNSAT)
+  {
+    result = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+  }
+  Result r = Result(result, filename);
+  d_state.notifyCheckSatResult(false, r);
   return r;
 }
 
-void SmtSolver::processAssertions(Assertions& as)
+void SmtSolver::getAssumptionCore(Assertions& as, std::vector<Node>& core)
+{
+  Assert(options::unsatCoresAssumptions());
+  std::vector<Node> sels;
+  d_propEngine->getUnsatAssumptions(sels);
+  if (options::unsatCoresMinimize())
+  {
+    Trace("smt-core") << "SmtSolver::getAssumptionCore: minimize core of size "
+                      << sels.size() << std::endl;
+    d_rm->beginCall();
+    // the selectors that have been shown to be necessary
+    std::vector<Node> needed;
+    while (!sels.empty())
+    {
+      Node s = sels.back();
+      sels.pop_back();
+      std::vector<Node> check(needed);
+      check.insert(check.end(), sels.begin(), sels.end());
+      Result r = d_propEngine->checkSat(check);
+      if (r.asSatisfiabilityResult().isSat() == Result::UNSAT)
+      {
+        // s is not needed, and neither are the remaining selectors that are
+        // not in the new conflict
+        std::vector<Node> usels;
+        d_propEngine->getUnsatAssumptions(usels);
+        std::unordered_set<Node, NodeHashFunction> uselSet(usels.begin(),
+                                                           usels.end());
+        std::vector<Node> remaining;
+        for (const Node& sr : sels)
+        {
+          if (uselSet.find(sr) != uselSet.end())
+          {
+            remaining.push_back(sr);
+          }
+        }
+        sels = remaining;
+      }
+      else
+      {
+        // we also keep s if the check was unknown
+        needed.push_back(s);
+      }
+    }
+    d_rm->endCall();
+    sels = needed;
+    Trace("smt-core") << "...minimized to size " << sels.size() << std::endl;
+  }
+  for (const Node& s : sels)
+  {
+    core.push_back(as.getSelectedFormula(s));
+  }
+}
+
+void SmtSolver::processAssertions(Assertions& as, Snapshot* snapshot)
 {
   TimerStat::CodeTimer paTimer(d_stats.d_processAssertionsTime);
   d_rm->spendResource(ResourceManager::Resource::PreprocessStep);
@@ -229,6 +362,10 @@ void SmtSolver::processAssertions(Assertions& as)
 
   // process the assertions with the preprocessor
   bool noConflict = d_pp.process(as);
+  if (snapshot != nullptr)
+  {
+    snapshot->addAssertions(ap.ref(), ap.getIteSkolemMap());
+  }
 
   // Notify the input formulas to theory engine
   if (noConflict)
@@ -241,35 +378,45 @@ void SmtSolver::processAssertions(Assertions& as)
   // introducing new ones
 
   // Push the formula to SAT
+  pushToPropEngine(ap.ref(), ap.getIteSkolemMap());
+
+  // clear the current assertions
+  as.clearCurrent();
+}
+
+void SmtSolver::assertPreprocessed(const std::vector<Node>& assertions,
+                                   const preprocessing::IteSkolemMap& ism)
+{
+  Assert(d_state.isFullyReady());
+  d_propEngine->notifyPreprocessedAssertions(assertions);
+  pushToPropEngine(assertions, ism);
+}
+
+void SmtSolver::pushToPropEngine(const std::vector<Node>& assertions,
+                                 const preprocessing::IteSkolemMap& ism)
+{
+  Chat() << "converting to CNF..." << endl;
+  TimerStat::CodeTimer codeTimer(d_stats.d_cnfConversionTime);
+  // It is important to distinguish the input assertions from the skolem
+  // definitions, as the decision justification heuristic treates the latter
+  // specially.
+  preprocessing::IteSkolemMap::const_iterator it;
+  for (size_t i = 0, asize = assertions.size(); i < asize; i++)
   {
-    Chat() << "converting to CNF..." << endl;
-    TimerStat::CodeTimer codeTimer(d_stats.d_cnfConversionTime);
-    const std::vector<Node>& assertions = ap.ref();
-    // It is important to distinguish the input assertions from the skolem
-    // definitions, as the decision justification heuristic treates the latter
-    // specially.
-    preprocessing::IteSkolemMap& ism = ap.getIteSkolemMap();
-    preprocessing::IteSkolemMap::iterator it;
-    for (size_t i = 0, asize = assertions.size(); i < asize; i++)
+    // is the assertion a skolem definition?
+    it = ism.find(i);
+    if (it == ism.end())
     {
-      // is the assertion a skolem definition?
-      it = ism.find(i);
-      if (it == ism.end())
-      {
-        Chat() << "+ input " << assertions[i] << std::endl;
-        d_propEngine->assertFormula(assertions[i]);
-      }
-      else
-      {
-        Chat() << "+ skolem definition " << assertions[i] << " (from "
-               << it->second << ")" << std::endl;
-        d_propEngine->assertSkolemDefinition(assertions[i], it->second);
-      }
+      Chat() << "+ input " << assertions[i] << std::endl;
+      d_propEngine->assertFormula(assertions[i]);
+    }
+    else
+    {
+      Chat() << "+ skolem definition " << assertions[i] << " (from "
+             << it->second << ")" << std::endl;
+      d_propEngine->assertSkolemDefinition(assertions[i], it->second);
     }
   }
-
-  // clear the current assertions
-  as.clearCurrent();
 }
 
 void SmtSolver::setProofNodeManager(ProofNodeManager* pnm) { d_pnm = pnm; }
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "expr/node.h"
+#include "preprocessing/assertion_pipeline.h"
 #include "theory/logic_info.h"
 #include "util/result.h"
 
@@ -43,6 +44,7 @@ namespace smt {
 class Assertions;
 class SmtEngineState;
 class Preprocessor;
+class Snapshot;
 struct SmtEngineStatistics;
 
 /**
@@ -107,12 +109,47 @@ class SmtSolver
                              const std::vector<Node>& assumptions,
                              bool inUnsatCore,
                              bool isEntailmentCheck);
+  /**
+   * Check satisfiability again after a satisfiable call to
+   * checkSatisfiability, with the additional clause (=> guard blocker), under
+   * the assumption guard. This is used for enumerating models.
+   *
+   * In contrast to checkSatisfiability, the assertions are not processed
+   * again: the clause is expanded and the top-level substitutions are applied
+   * to it, as for assumptions, and it is asserted directly to the prop engine
+   * as a lemma. Hence, the state of the prop engine and of the theories, e.g.
+   * learned clauses, is preserved between the calls.
+   *
+   * @param blocker The formula to add, e.g. the negation of a model
+   * @param guard The Boolean variable guarding blocker
+   */
+  Result checkSatisfiabilityBlocked(const Node& blocker, const Node& guard);
   /**
    * Process the assertions that have been asserted in as. This moves the set of
    * assertions that have been buffered into as, preprocesses them, pushes them
-   * into the SMT solver, and clears the buffer.
+   * into the SMT solver, and clears the buffer. If snapshot is non-null, the
+   * preprocessed assertions are added to it.
+   */
+  void processAssertions(Assertions& as, Snapshot* snapshot = nullptr);
+  /**
+   * Push preprocessed assertions, e.g. restored from a snapshot, into the SMT
+   * solver, where ism maps the indices of the skolem definitions among them
+   * to their skolems.
+   */
+  void assertPreprocessed(const std::vector<Node>& assertions,
+                          const preprocessing::IteSkolemMap& ism);
+  /**
+   * Get the unsat core of the last check-sat call, which was unsatisfiable,
+   * when using unsatCoresAssumptions. The core consists of the input formulas
+   * of as whose selectors are in the final conflict of the SAT solver. If
+   * unsatCoresMinimize is true, the core is made minimal by checking, for
+   * each formula in the core, whether the other formulas of the core are
+   * unsatisfiable, in which case it is removed.
+   *
+   * @param as The object managing the assertions in SmtEngine
+   * @param core The vector to add the formulas of the core to
    */
-  void processAssertions(Assertions& as);
+  void getAssumptionCore(Assertions& as, std::vector<Node>& core);
   /**
    * Set proof node manager. Enables proofs in this SmtSolver. Should be
    * called before finishInit.
@@ -129,6 +166,9 @@ class SmtSolver
   Preprocessor* getPreprocessor();
   //------------------------------------------ end access methods
  private:
+  /** Push the preprocessed assertions into the prop engine */
+  void pushToPropEngine(const std::vector<Node>& assertions,
+                        const preprocessing::IteSkolemMap& ism);
   /** Reference to the parent SMT engine */
   SmtEngine& d_smt;
   /** Reference to the state of the SmtEngine */
@@ -0,0 +1,276 @@
+/*********************                                                        */
+/*! \file snapshot.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the state of an SMT engine after preprocessing
+ **/
+
+#include "smt/snapshot.h"
+
+#include <unordered_set>
+
+#include "base/exception.h"
+#include "base/output.h"
+#include "expr/node_dag_io.h"
+#include "expr/skolem_manager.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+namespace smt {
+
+namespace {
+
+/**
+ * Get the form of skolem k that is written to a snapshot, see Snapshot. Sets
+ * isPurify to true if it is the term purified by k. Returns null if k has no
+ * such form.
+ */
+Node getSkolemForm(TNode k, bool& isPurify)
+{
+  Node orig = SkolemManager::getOriginalForm(k);
+  isPurify = orig != k;
+  return isPurify ? orig : SkolemManager::getWitnessForm(k);
+}
+
+/**
+ * Add the skolems of nodes to skolems, such that the skolems in the form of
+ * a skolem precede it.
+ */
+void getSkolems(const std::vector<Node>& nodes, std::vector<Node>& skolems)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  // the nodes to visit, and whether their children were visited
+  std::vector<std::pair<TNode, bool>> visit;
+  for (const Node& n : nodes)
+  {
+    visit.emplace_back(n, false);
+  }
+  while (!visit.empty())
+  {
+    std::pair<TNode, bool> cur = visit.back();
+    visit.pop_back();
+    if (cur.second)
+    {
+      skolems.push_back(cur.first);
+      continue;
+    }
+    if (!visited.insert(cur.first).second)
+    {
+      continue;
+    }
+    if (cur.first.getKind() == kind::SKOLEM)
+    {
+      visit.emplace_back(cur.first, true);
+      bool isPurify;
+      Node form = getSkolemForm(cur.first, isPurify);
+      if (!form.isNull())
+      {
+        // form is owned by an attribute of the skolem
+        visit.emplace_back(form, false);
+      }
+      continue;
+    }
+    if (cur.first.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      visit.emplace_back(cur.first.getOperator(), false);
+    }
+    for (TNode c : cur.first)
+    {
+      visit.emplace_back(c, false);
+    }
+  }
+}
+
+}  // namespace
+
+void Snapshot::addAssertions(const std::vector<Node>& assertions,
+                             const preprocessing::IteSkolemMap& ism)
+{
+  size_t offset = d_assertions.size();
+  d_assertions.insert(d_assertions.end(), assertions.begin(), assertions.end());
+  for (const std::pair<const size_t, Node>& s : ism)
+  {
+    d_ism[offset + s.first] = s.second;
+  }
+}
+
+void Snapshot::addSubstitution(const Node& x, const Node& t)
+{
+  d_substs.emplace_back(x, t);
+}
+
+void Snapshot::write(const std::string& filename) const
+{
+  NodeManager* nm = NodeManager::currentNM();
+  size_t nassertions = d_assertions.size();
+  std::vector<Node> nodes(d_assertions.begin(), d_assertions.end());
+  for (size_t i = 0; i < nassertions; i++)
+  {
+    preprocessing::IteSkolemMap::const_iterator it = d_ism.find(i);
+    nodes.push_back(it != d_ism.end() ? it->second : d_assertions[i]);
+  }
+  for (const std::pair<Node, Node>& s : d_substs)
+  {
+    nodes.push_back(s.first);
+    nodes.push_back(s.second);
+  }
+  std::vector<Node> skolems;
+  getSkolems(nodes, skolems);
+  std::vector<Node> roots;
+  roots.push_back(nm->mkConst(Rational(nassertions)));
+  roots.push_back(nm->mkConst(Rational(skolems.size())));
+  roots.insert(roots.end(), nodes.begin(), nodes.begin() + 2 * nassertions);
+  for (const Node& k : skolems)
+  {
+    bool isPurify;
+    Node form = getSkolemForm(k, isPurify);
+    if (form.isNull())
+    {
+      throw Exception("Cannot write the skolem " + k.toString()
+                      + ", which has no original or witness form, to a "
+                        "snapshot");
+    }
+    roots.push_back(k);
+    roots.push_back(nm->mkConst(isPurify));
+    roots.push_back(form);
+  }
+  for (const std::pair<Node, Node>& s : d_substs)
+  {
+    roots.push_back(s.first);
+    roots.push_back(s.second);
+  }
+  Trace("smt-snapshot") << "Write a snapshot of " << nassertions
+                        << " assertions, " << d_ism.size()
+                        << " skolem definitions, " << skolems.size()
+                        << " skolems and " << d_substs.size()
+                        << " substitutions" << std::endl;
+  NodeDagWriter().writeFile(filename, roots);
+}
+
+void Snapshot::read(const std::string& filename,
+                    const std::vector<Node>& decls)
+{
+  NodeDagReader reader;
+  for (const Node& d : decls)
+  {
+    if (!d.isVar())
+    {
+      continue;
+    }
+    reader.bind(d);
+    TypeNode tn = d.getType();
+    std::vector<TypeNode> types;
+    if (tn.isFunction())
+    {
+      types = tn.getArgTypes();
+      types.push_back(tn.getRangeType());
+    }
+    else
+    {
+      types.push_back(tn);
+    }
+    for (const TypeNode& t : types)
+    {
+      if (t.isSort() && t.getNumChildren() == 0)
+      {
+        reader.bind(t);
+      }
+    }
+  }
+  std::vector<Node> roots;
+  reader.readFile(filename, roots);
+  // reads the count of the given root, returning roots.size() if it is out
+  // of range
+  auto getCount = [&](size_t i) {
+    if (roots.size() <= i || roots[i].getKind() != kind::CONST_RATIONAL
+        || !roots[i].getConst<Rational>().isIntegral()
+        || roots[i].getConst<Rational>().sgn() < 0
+        || !roots[i].getConst<Rational>().getNumerator().fitsUnsignedInt())
+    {
+      return roots.size();
+    }
+    return static_cast<size_t>(
+        roots[i].getConst<Rational>().getNumerator().toUnsignedInt());
+  };
+  size_t nassertions = getCount(0);
+  size_t nskolems = getCount(1);
+  size_t start = 2 + 2 * nassertions + 3 * nskolems;
+  if (nassertions >= roots.size() || nskolems >= roots.size()
+      || start > roots.size() || (roots.size() - start) % 2 != 0)
+  {
+    throw Exception("The file " + filename + " is not a snapshot");
+  }
+  // recreate the skolems, whose forms only contain the skolems before them
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  std::vector<Node> loaded;
+  std::vector<Node> skolems;
+  for (size_t i = 2 + 2 * nassertions; i < start; i += 3)
+  {
+    Node form = roots[i + 2].substitute(
+        loaded.begin(), loaded.end(), skolems.begin(), skolems.end());
+    Node k;
+    if (roots[i].getKind() != kind::SKOLEM
+        || roots[i + 1].getKind() != kind::CONST_BOOLEAN)
+    {
+      throw Exception("The file " + filename + " is not a snapshot");
+    }
+    else if (roots[i + 1].getConst<bool>())
+    {
+      k = sm->mkPurifySkolem(form, "k", "a skolem loaded from a snapshot");
+    }
+    else if (form.getKind() == kind::WITNESS && form[0].getNumChildren() == 1)
+    {
+      k = sm->mkSkolem(
+          form[0][0], form[1], "k", "a skolem loaded from a snapshot");
+    }
+    else
+    {
+      throw Exception("The file " + filename + " is not a snapshot");
+    }
+    if (k.getType() != roots[i].getType())
+    {
+      throw Exception("The file " + filename + " is not a snapshot");
+    }
+    loaded.push_back(roots[i]);
+    skolems.push_back(k);
+  }
+  auto restore = [&](const Node& n) {
+    return n.substitute(
+        loaded.begin(), loaded.end(), skolems.begin(), skolems.end());
+  };
+  d_assertions.clear();
+  d_ism.clear();
+  d_substs.clear();
+  for (size_t i = 0; i < nassertions; i++)
+  {
+    d_assertions.push_back(restore(roots[2 + i]));
+  }
+  for (size_t i = 0; i < nassertions; i++)
+  {
+    Node s = restore(roots[2 + nassertions + i]);
+    if (s != d_assertions[i])
+    {
+      d_ism[i] = s;
+    }
+  }
+  for (size_t i = start, nroots = roots.size(); i < nroots; i += 2)
+  {
+    d_substs.emplace_back(restore(roots[i]), restore(roots[i + 1]));
+  }
+  Trace("smt-snapshot") << "Read a snapshot of " << nassertions
+                        << " assertions, " << d_ism.size()
+                        << " skolem definitions, " << skolems.size()
+                        << " skolems and " << d_substs.size()
+                        << " substitutions" << std::endl;
+}
+
+}  // namespace smt
+}  // namespace cvc5
@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file snapshot.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The state of an SMT engine after preprocessing, which can be saved
+ ** to and restored from a file
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__SNAPSHOT_H
+#define CVC4__SMT__SNAPSHOT_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/assertion_pipeline.h"
+
+namespace cvc5 {
+namespace smt {
+
+/**
+ * A snapshot of the state of an SMT engine after preprocessing, see
+ * SmtEngine::saveSnapshot. It consists of the preprocessed assertions as they
+ * are sent to the prop engine, the skolems of those assertions that are
+ * skolem definitions, and the top-level substitutions learned while
+ * preprocessing them.
+ *
+ * A snapshot is stored in the binary DAG format of expr/node_dag_io.h, whose
+ * roots are the number n of assertions and the number m of skolems (as
+ * rational constants), the n assertions, the skolem of each assertion that is
+ * a skolem definition or else the assertion itself, a triple for each of the
+ * m skolems, and the left and right hand sides of each substitution.
+ *
+ * Since the binary DAG format does not store attributes, the skolems are
+ * recreated by the SkolemManager when the snapshot is read. The triple of a
+ * skolem k is k, the Boolean constant true and the term purified by k if k is
+ * a purification skolem, and otherwise k, false and the witness form of k.
+ * The triples are ordered such that the skolems in the form of a skolem
+ * precede it. Skolems that have neither form cannot be written.
+ */
+class Snapshot
+{
+ public:
+  /**
+   * Add the preprocessed assertions, where ism maps the indices of the skolem
+   * definitions in assertions to their skolems.
+   */
+  void addAssertions(const std::vector<Node>& assertions,
+                     const preprocessing::IteSkolemMap& ism);
+  /** Add the top-level substitution x -> t */
+  void addSubstitution(const Node& x, const Node& t);
+  /** Get the preprocessed assertions */
+  const std::vector<Node>& getAssertions() const { return d_assertions; }
+  /** Get the map from indices of skolem definitions to their skolems */
+  const preprocessing::IteSkolemMap& getIteSkolemMap() const { return d_ism; }
+  /** Get the top-level substitutions */
+  const std::vector<std::pair<Node, Node>>& getSubstitutions() const
+  {
+    return d_substs;
+  }
+  /**
+   * Write this snapshot to the file with the given name
+   *
+   * @throw Exception if it contains a skolem that cannot be written
+   */
+  void write(const std::string& filename) const;
+  /**
+   * Read this snapshot from the file with the given name. The variables of
+   * the file are mapped to the variables in decls with the same name, and
+   * its uninterpreted sorts to the same-named sorts in the types of decls.
+   *
+   * @throw Exception if the file is not a snapshot
+   */
+  void read(const std::string& filename, const std::vector<Node>& decls);
+
+ private:
+  /** The preprocessed assertions */
+  std::vector<Node> d_assertions;
+  /** Maps the indices of the skolem definitions to their skolems */
+  preprocessing::IteSkolemMap d_ism;
+  /** The top-level substitutions */
+  std::vector<std::pair<Node, Node>> d_substs;
+};
+
+}  // namespace smt
+}  // namespace cvc5
+
+#endif /* CVC4__SMT__SNAPSHOT_H */
@@ -0,0 +1,50 @@
+/*********************                                                        */
+/*! \file sygus_solution_listener.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Listener for the intermediate solutions of check-synth
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__SMT__SYGUS_SOLUTION_LISTENER_H
+#define CVC4__SMT__SYGUS_SOLUTION_LISTENER_H
+
+#include <map>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace smt {
+
+/**
+ * A listener that is notified of each solution found while streaming
+ * solutions (--sygus-stream). If a listener is registered with the SMT
+ * engine (SmtEngine::setSygusSolutionListener), the solutions are passed to
+ * it instead of being printed.
+ */
+class SygusSolutionListener
+{
+ public:
+  virtual ~SygusSolutionListener() {}
+  /**
+   * Notify that sols, which maps each function-to-synthesize to a lambda, is
+   * a solution. Returns true if the search should stop with this solution,
+   * in which case check-synth answers unsat and sols are the solutions of
+   * the conjecture. Otherwise, the solution is excluded and the search
+   * continues.
+   */
+  virtual bool notifySolution(const std::map<Node, Node>& sols) = 0;
+};
+
+}  // namespace smt
+}  // namespace cvc5
+
+#endif /* CVC4__SMT__SYGUS_SOLUTION_LISTENER_H */
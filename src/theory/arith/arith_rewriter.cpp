@@ -25,6 +25,7 @@
 #include "theory/arith/arith_rewriter.h"
 #include "theory/arith/arith_utilities.h"
 #include "theory/arith/normal_form.h"
+#include "theory/rewrite_profiler.h"
 #include "theory/theory.h"
 #include "util/iand.h"
 
@@ -896,6 +897,7 @@ RewriteResponse ArithRewriter::returnRewrite(TNode t, Node ret, Rewrite r)
 {
   Trace("arith-rewrite") << "ArithRewriter : " << t << " == " << ret << " by "
                          << r << std::endl;
+  RewriteProfiler::notifyRule("arith", toString(r), t, ret);
   return RewriteResponse(REWRITE_AGAIN_FULL, ret);
 }
 
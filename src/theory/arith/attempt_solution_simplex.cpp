@@ -121,8 +121,13 @@ Result::Sat AttemptSolutionSDP::attempt(const ApproximateSimplex::Solution& sol)
         }
       }
     }
+    if (toAdd == ARITHVAR_SENTINEL)
+    {
+      // the new basis is singular in exact arithmetic, which may happen as
+      // it was computed with floating point numbers
+      break;
+    }
     Assert(toRemove != ARITHVAR_SENTINEL);
-    Assert(toAdd != ARITHVAR_SENTINEL);
 
     Trace("arith::forceNewBasis") << toRemove << " " << toAdd << endl;
     // CVC4Message() << toRemove << " " << toAdd << endl;
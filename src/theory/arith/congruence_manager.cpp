@@ -62,7 +62,8 @@ ArithCongruenceManager::ArithCongruenceManager(
       // Construct d_pfGenEe with the USER context, since its proofs are closed.
       d_pfGenExplain(new EagerProofGenerator(
           pnm, u, "ArithCongruenceManager::pfGenExplain")),
-      d_pfee(nullptr)
+      d_pfee(nullptr),
+      d_pendingConstants(c)
 {
 }
 
@@ -94,6 +95,8 @@ ArithCongruenceManager::Statistics::Statistics():
   d_watchedVariableIsZero("theory::arith::congruence::watchedVariableIsZero", 0),
   d_watchedVariableIsNotZero("theory::arith::congruence::watchedVariableIsNotZero", 0),
   d_equalsConstantCalls("theory::arith::congruence::equalsConstantCalls", 0),
+  d_deferredConstants("theory::arith::congruence::deferredConstants", 0),
+  d_entailedLiterals("theory::arith::congruence::entailedLiterals", 0),
   d_propagations("theory::arith::congruence::propagations", 0),
   d_propagateConstraints("theory::arith::congruence::propagateConstraints", 0),
   d_conflicts("theory::arith::congruence::conflicts", 0)
@@ -102,6 +105,8 @@ ArithCongruenceManager::Statistics::Statistics():
   smtStatisticsRegistry()->registerStat(&d_watchedVariableIsZero);
   smtStatisticsRegistry()->registerStat(&d_watchedVariableIsNotZero);
   smtStatisticsRegistry()->registerStat(&d_equalsConstantCalls);
+  smtStatisticsRegistry()->registerStat(&d_deferredConstants);
+  smtStatisticsRegistry()->registerStat(&d_entailedLiterals);
   smtStatisticsRegistry()->registerStat(&d_propagations);
   smtStatisticsRegistry()->registerStat(&d_propagateConstraints);
   smtStatisticsRegistry()->registerStat(&d_conflicts);
@@ -112,6 +117,8 @@ ArithCongruenceManager::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_watchedVariableIsZero);
   smtStatisticsRegistry()->unregisterStat(&d_watchedVariableIsNotZero);
   smtStatisticsRegistry()->unregisterStat(&d_equalsConstantCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_deferredConstants);
+  smtStatisticsRegistry()->unregisterStat(&d_entailedLiterals);
   smtStatisticsRegistry()->unregisterStat(&d_propagations);
   smtStatisticsRegistry()->unregisterStat(&d_propagateConstraints);
   smtStatisticsRegistry()->unregisterStat(&d_conflicts);
@@ -235,7 +242,6 @@ void ArithCongruenceManager::watchedVariableIsZero(ConstraintCP lb, ConstraintCP
     pf = d_pnm->mkNode(PfRule::MACRO_SR_PRED_TRANSFORM, {pf}, {eq});
   }
 
-  d_keepAlive.push_back(reason);
   Trace("arith-ee") << "Asserting an equality on " << s << ", on trichotomy"
                     << std::endl;
   Trace("arith-ee") << "  based on " << lb << std::endl;
@@ -270,7 +276,6 @@ void ArithCongruenceManager::watchedVariableIsZero(ConstraintCP eq){
   }
   Node reason = safeConstructNary(nb);
 
-  d_keepAlive.push_back(reason);
   assertionToEqualityEngine(true, s, reason, pf);
 }
 
@@ -334,7 +339,6 @@ void ArithCongruenceManager::watchedVariableCannotBeZero(ConstraintCP c){
     }
     Assert(pf->getResult() == disEq);
   }
-  d_keepAlive.push_back(reason);
   assertionToEqualityEngine(false, s, reason, pf);
 }
 
@@ -539,6 +543,14 @@ void ArithCongruenceManager::assertLitToEqualityEngine(
 
   Trace("arith-ee") << "Assert to Eq " << lit << ", reason " << reason
                     << std::endl;
+  if (d_ee->hasTerm(eq[0]) && d_ee->hasTerm(eq[1])
+      && (isEquality ? d_ee->areEqual(eq[0], eq[1])
+                     : d_ee->areDisequal(eq[0], eq[1], false)))
+  {
+    Trace("arith-ee") << "...already entailed" << std::endl;
+    ++(d_statistics.d_entailedLiterals);
+    return;
+  }
   if (isProofEnabled())
   {
     if (CDProof::isSame(lit, reason))
@@ -620,17 +632,19 @@ void ArithCongruenceManager::equalsConstant(ConstraintCP c){
 
   ArithVar x = c->getVariable();
   Node xAsNode = d_avariables.asNode(x);
+  if (deferConstant(xAsNode, c, NullConstraint))
+  {
+    return;
+  }
   Node asRational = mkRationalNode(c->getValue().getNoninfinitesimalPart());
 
   // No guarentee this is in normal form!
   // Note though, that it happens to be in proof normal form!
   Node eq = xAsNode.eqNode(asRational);
-  d_keepAlive.push_back(eq);
 
   NodeBuilder<> nb(Kind::AND);
   auto pf = c->externalExplainByAssertions(nb);
   Node reason = safeConstructNary(nb);
-  d_keepAlive.push_back(reason);
 
   Trace("arith-ee") << "Assert equalsConstant " << eq << ", reason " << reason << std::endl;
   assertLitToEqualityEngine(eq, reason, pf);
@@ -646,12 +660,16 @@ void ArithCongruenceManager::equalsConstant(ConstraintCP lb, ConstraintCP ub){
                           << ub << std::endl;
 
   ArithVar x = lb->getVariable();
+  Node xAsNode = d_avariables.asNode(x);
+  if (deferConstant(xAsNode, lb, ub))
+  {
+    return;
+  }
   NodeBuilder<> nb(Kind::AND);
   auto pfLb = lb->externalExplainByAssertions(nb);
   auto pfUb = ub->externalExplainByAssertions(nb);
   Node reason = safeConstructNary(nb);
 
-  Node xAsNode = d_avariables.asNode(x);
   Node asRational = mkRationalNode(lb->getValue().getNoninfinitesimalPart());
 
   // No guarentee this is in normal form!
@@ -662,14 +680,50 @@ void ArithCongruenceManager::equalsConstant(ConstraintCP lb, ConstraintCP ub){
   {
     pf = d_pnm->mkNode(PfRule::ARITH_TRICHOTOMY, {pfLb, pfUb}, {eq});
   }
-  d_keepAlive.push_back(eq);
-  d_keepAlive.push_back(reason);
 
   Trace("arith-ee") << "Assert equalsConstant2 " << eq << ", reason " << reason << std::endl;
 
   assertLitToEqualityEngine(eq, reason, pf);
 }
 
+bool ArithCongruenceManager::deferConstant(TNode x,
+                                           ConstraintCP lb,
+                                           ConstraintCP ub)
+{
+  if (!options::arithCongSharedOnly() || d_ee->hasTerm(x))
+  {
+    return false;
+  }
+  Trace("arith-ee") << "Defer equalsConstant for " << x << std::endl;
+  ++(d_statistics.d_deferredConstants);
+  d_pendingConstants[x] = std::pair<ConstraintCP, ConstraintCP>(lb, ub);
+  return true;
+}
+
+void ArithCongruenceManager::notifySharedTerm(TNode n)
+{
+  context::CDHashMap<Node,
+                     std::pair<ConstraintCP, ConstraintCP>,
+                     NodeHashFunction>::const_iterator it =
+      d_pendingConstants.find(n);
+  if (it == d_pendingConstants.end() || d_ee->hasTerm(n))
+  {
+    return;
+  }
+  std::pair<ConstraintCP, ConstraintCP> bounds = (*it).second;
+  Trace("arith-ee") << "Assert deferred equalsConstant for " << n << std::endl;
+  // n is now a term of the equality engine, hence it is not deferred again
+  d_ee->addTerm(n);
+  if (bounds.second == NullConstraint)
+  {
+    equalsConstant(bounds.first);
+  }
+  else
+  {
+    equalsConstant(bounds.first, bounds.second);
+  }
+}
+
 bool ArithCongruenceManager::isProofEnabled() const { return d_pnm != nullptr; }
 
 std::vector<Node> andComponents(TNode an)
@@ -20,7 +20,7 @@
 #pragma once
 
 #include "context/cdhashmap.h"
-#include "context/cdlist.h"
+#include "context/cdchunk_list.h"
 #include "context/cdmaybe.h"
 #include "context/cdtrail_queue.h"
 #include "theory/arith/arithvar.h"
@@ -90,7 +90,7 @@ private:
   };
   ArithCongruenceNotify d_notify;
 
-  context::CDList<Node> d_keepAlive;
+  context::CDChunkList<Node> d_keepAlive;
 
   /** Store the propagations. */
   context::CDTrailQueue<Node> d_propagatations;
@@ -181,7 +181,8 @@ private:
    *   * assertionToEqualityEngine(..)
    *   * equalsConstant(c)
    *   * equalsConstant(lb, ub)
-   * If proof is off, then just asserts.
+   * If proof is off, then just asserts. This keeps the literal and its reason
+   * alive. Literals that are already entailed by the eq engine are skipped.
    */
   void assertLitToEqualityEngine(Node lit,
                                  TNode reason,
@@ -276,7 +277,29 @@ private:
   void equalsConstant(ConstraintCP eq);
   void equalsConstant(ConstraintCP lb, ConstraintCP ub);
 
+  /**
+   * Notify that n is a shared term. This asserts the constant value of n to
+   * the equality engine if it was deferred by equalsConstant.
+   */
+  void notifySharedTerm(TNode n);
+
  private:
+  /**
+   * If options::arithCongSharedOnly() is enabled and x is not a term of the
+   * equality engine, this stores the bounds lb and ub (the latter may be
+   * null) that entail that x is constant in d_pendingConstants and returns
+   * true. Otherwise, it returns false.
+   */
+  bool deferConstant(TNode x, ConstraintCP lb, ConstraintCP ub);
+  /**
+   * Maps terms to the bounds entailing that they are constant, whose
+   * assertion to the equality engine was deferred, see deferConstant.
+   */
+  context::CDHashMap<Node,
+                     std::pair<ConstraintCP, ConstraintCP>,
+                     NodeHashFunction>
+      d_pendingConstants;
+
   class Statistics {
   public:
     IntStat d_watchedVariables;
@@ -284,6 +307,8 @@ private:
     IntStat d_watchedVariableIsNotZero;
 
     IntStat d_equalsConstantCalls;
+    IntStat d_deferredConstants;
+    IntStat d_entailedLiterals;
 
     IntStat d_propagations;
     IntStat d_propagateConstraints;
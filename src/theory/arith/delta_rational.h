@@ -50,8 +50,8 @@ private:
  cvc5::Rational k;
 
 public:
-  DeltaRational() : c(0,1), k(0,1) {}
-  DeltaRational(const cvc5::Rational& base) : c(base), k(0, 1) {}
+  DeltaRational() : c(), k() {}
+  DeltaRational(const cvc5::Rational& base) : c(base), k() {}
   DeltaRational(const cvc5::Rational& base, const cvc5::Rational& coeff)
       : c(base), k(coeff)
   {
@@ -96,13 +96,24 @@ public:
     }
   }
 
+  // The arithmetic operators skip the infinitesimal parts when they are
+  // zero, which is the common case.
+
   DeltaRational operator+(const DeltaRational& other) const{
+    if (infinitesimalIsZero() && other.infinitesimalIsZero())
+    {
+      return DeltaRational(c + other.c);
+    }
     cvc5::Rational tmpC = c + other.c;
     cvc5::Rational tmpK = k + other.k;
     return DeltaRational(tmpC, tmpK);
   }
 
   DeltaRational operator*(const Rational& a) const{
+    if (infinitesimalIsZero())
+    {
+      return DeltaRational(a * c);
+    }
     cvc5::Rational tmpC = a * c;
     cvc5::Rational tmpK = a * k;
     return DeltaRational(tmpC, tmpK);
@@ -127,8 +138,13 @@ public:
 
 
   DeltaRational operator-(const DeltaRational& a) const{
-    cvc5::Rational negOne(cvc5::Integer(-1));
-    return *(this) + (a * negOne);
+    if (infinitesimalIsZero() && a.infinitesimalIsZero())
+    {
+      return DeltaRational(c - a.c);
+    }
+    cvc5::Rational tmpC = c - a.c;
+    cvc5::Rational tmpK = k - a.k;
+    return DeltaRational(tmpC, tmpK);
   }
 
   DeltaRational operator-() const{
@@ -136,6 +152,10 @@ public:
   }
 
   DeltaRational operator/(const Rational& a) const{
+    if (infinitesimalIsZero())
+    {
+      return DeltaRational(c / a);
+    }
     cvc5::Rational tmpC = c / a;
     cvc5::Rational tmpK = k / a;
     return DeltaRational(tmpC, tmpK);
@@ -207,14 +227,20 @@ public:
   DeltaRational& operator*=(const cvc5::Rational& a)
   {
     c *=  a;
-    k *=  a;
+    if (!infinitesimalIsZero())
+    {
+      k *= a;
+    }
 
     return *(this);
   }
 
   DeltaRational& operator+=(const DeltaRational& other){
     c += other.c;
-    k += other.k;
+    if (!other.infinitesimalIsZero())
+    {
+      k += other.k;
+    }
 
     return *(this);
   }
@@ -222,7 +248,10 @@ public:
   DeltaRational& operator/=(const Rational& a){
     Assert(!a.isZero());
     c /= a;
-    k /= a;
+    if (!infinitesimalIsZero())
+    {
+      k /= a;
+    }
     return *(this);
   }
 
@@ -115,12 +115,12 @@ Node DioSolver::nextPureSubstitution(){
   Assert(d_subs[curr].d_fresh.isNull());
   Variable v = d_subs[curr].d_eliminated;
 
-  SumPair sp = d_trail[d_subs[curr].d_constraint].d_eq;
-  Polynomial p = sp.getPolynomial();
-  Constant c = -sp.getConstant();
-  Polynomial cancelV = p + Polynomial::mkPolynomial(v);
-  Node eq = NodeManager::currentNM()->mkNode(kind::EQUAL, v.getNode(), cancelV.getNode());
-  return eq;
+  // v has coefficient -1 in sp = 0, hence v = sp + v
+  TrailIndex ci = d_subs[curr].d_constraint;
+  SumPair cancelV = d_trail[ci].d_eq + SumPair::mkSumPair(v);
+  NodeManager* nm = NodeManager::currentNM();
+  Node eq = nm->mkNode(kind::EQUAL, v.getNode(), cancelV.getNode());
+  return nm->mkNode(kind::IMPLIES, proveIndex(ci), eq);
 }
 
 
@@ -636,6 +636,10 @@ std::pair<DioSolver::SubIndex, DioSolver::TrailIndex> DioSolver::solveIndex(DioS
 
   SubIndex subBy = d_subs.size();
   d_subs.push_back(Substitution(Node::null(), var, ci));
+  if (!d_usedDecomposeIndex)
+  {
+    d_lastPureSubstitution = d_subs.size();
+  }
 
   Debug("arith::dio") << "after solveIndex " <<  d_trail[ci].d_eq.getNode() << " for " << av.getNode() << endl;
   Assert(d_trail[ci].d_eq.getPolynomial().getCoefficient(vl)
@@ -167,6 +167,10 @@ private:
    */
   context::CDO<bool> d_usedDecomposeIndex;
 
+  /**
+   * The substitutions below this index use no fresh variables, which is the
+   * case for all substitutions solved before decomposeIndex() was used.
+   */
   context::CDO<SubIndex> d_lastPureSubstitution;
   context::CDO<SubIndex> d_pureSubstitionIter;
 
@@ -180,11 +184,23 @@ public:
   /** Construct a Diophantine equation solver with the given context. */
   DioSolver(context::Context* ctxt);
 
-  /** Returns true if the substitutions use no new variables. */
+  /**
+   * Returns true if there are substitutions that use no fresh variables and
+   * have not been returned by nextPureSubstitution() in this context.
+   */
   bool hasMorePureSubstitutions() const{
     return d_pureSubstitionIter < d_lastPureSubstitution;
   }
 
+  /**
+   * Returns the next substitution that uses no fresh variables as a lemma
+   * (=> exp (= v p)), where v is the eliminated variable, p is its
+   * solution over the input variables, and exp is the conjunction of the
+   * input constraints that entail it.
+   *
+   * As the substitutions are stored in the context dependent trail, these are
+   * kept across checks and undone on backtracking.
+   */
   Node nextPureSubstitution();
 
   /**
@@ -0,0 +1,417 @@
+/*********************                                                        */
+/*! \file float_simplex.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A floating point or 64-bit simplex over a copy of the tableau
+ **
+ ** A floating point or 64-bit rational simplex over a copy of the tableau.
+ **/
+#include "theory/arith/float_simplex.h"
+
+#include <cmath>
+#include <limits>
+
+#include "base/output.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+
+using namespace std;
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+/** Coefficients smaller than this (in absolute value) are dropped */
+const double s_zeroTolerance = 1e-12;
+/** Variables may violate their bounds by this much (relative) */
+const double s_feasibilityTolerance = 1e-9;
+
+/** The tolerance for violating the bound b */
+double tolerance(double b)
+{
+  return s_feasibilityTolerance * (1 + std::fabs(b));
+}
+
+/** Convert the coefficient r */
+void convert(const Rational& r, double& c) { c = r.getDouble(); }
+void convert(const Rational& r, Int64Rational& c)
+{
+  c = Int64Rational::fromRational(r);
+}
+/** Convert the value d */
+void convert(const DeltaRational& d, double& v)
+{
+  v = d.approx(ApproximateSimplex::SMALL_FIXED_DELTA);
+}
+void convert(const DeltaRational& d, Int64DeltaRational& v)
+{
+  v = Int64DeltaRational::fromDeltaRational(d);
+}
+
+/** Whether the number n did not overflow */
+bool isValid(double n) { return std::isfinite(n); }
+bool isValid(const Int64Rational& n) { return n.isValid(); }
+bool isValid(const Int64DeltaRational& n) { return n.isValid(); }
+
+/** Whether the coefficient c is zero, up to rounding errors */
+bool isNegligible(double c) { return std::fabs(c) < s_zeroTolerance; }
+bool isNegligible(const Int64Rational& c) { return c.isZero(); }
+
+/** Whether the coefficient c is too small to pivot on */
+bool isTooSmallPivot(double c) { return std::fabs(c) < s_feasibilityTolerance; }
+bool isTooSmallPivot(const Int64Rational& c) { return c.isZero(); }
+
+bool isPositive(double c) { return c > 0; }
+bool isPositive(const Int64Rational& c) { return c.sgn() > 0; }
+
+/** Whether a < b, by more than the tolerance */
+bool lessBeyondTolerance(double a, double b) { return a < b - tolerance(b); }
+bool lessBeyondTolerance(const Int64DeltaRational& a,
+                         const Int64DeltaRational& b)
+{
+  return a < b;
+}
+/** Whether a > b, by more than the tolerance */
+bool greaterBeyondTolerance(double a, double b)
+{
+  return a > b + tolerance(b);
+}
+bool greaterBeyondTolerance(const Int64DeltaRational& a,
+                            const Int64DeltaRational& b)
+{
+  return a > b;
+}
+
+/**
+ * Get the exact value of variable v for the value found by the floating
+ * point simplex. The value is snapped to the exact bounds or the exact
+ * assignment if it is close to them, otherwise it is estimated by a
+ * rational.
+ */
+DeltaRational toExactValue(const ArithVariables& vars,
+                           ArithVar v,
+                           double value,
+                           double lower,
+                           double upper)
+{
+  if (vars.hasLowerBound(v) && ApproximateSimplex::roughlyEqual(value, lower))
+  {
+    return vars.getLowerBound(v);
+  }
+  if (vars.hasUpperBound(v) && ApproximateSimplex::roughlyEqual(value, upper))
+  {
+    return vars.getUpperBound(v);
+  }
+  const DeltaRational& current = vars.getAssignment(v);
+  DeltaRational proposal = current;
+  if (!ApproximateSimplex::roughlyEqual(
+          value, current.approx(ApproximateSimplex::SMALL_FIXED_DELTA)))
+  {
+    if (Maybe<Rational> maybe = ApproximateSimplex::estimateWithCFE(value))
+    {
+      proposal = maybe.value();
+    }
+  }
+  if (vars.strictlyLessThanLowerBound(v, proposal))
+  {
+    return vars.getLowerBound(v);
+  }
+  if (vars.strictlyGreaterThanUpperBound(v, proposal))
+  {
+    return vars.getUpperBound(v);
+  }
+  return proposal;
+}
+
+/** Get the exact value of variable v for the value found by the simplex */
+DeltaRational toExactValue(const ArithVariables& vars,
+                           ArithVar v,
+                           const Int64DeltaRational& value,
+                           const Int64DeltaRational& lower,
+                           const Int64DeltaRational& upper)
+{
+  return value.toDeltaRational();
+}
+
+}  // namespace
+
+template <class Coeff, class Value>
+const size_t ShadowSimplex<Coeff, Value>::s_noRow =
+    numeric_limits<size_t>::max();
+
+template <class Coeff, class Value>
+ShadowSimplex<Coeff, Value>::ShadowSimplex(const ArithVariables& vars,
+                                           const Tableau& tableau)
+    : d_vars(vars), d_invalid(false), d_pivotLimit(10000), d_pivots(0)
+{
+  ArithVar numVars = vars.getNumberOfVariables();
+  d_basicToRow.resize(numVars, s_noRow);
+  d_cols.resize(numVars);
+  d_value.resize(numVars);
+  d_lower.resize(numVars);
+  d_upper.resize(numVars);
+
+  for (ArithVariables::var_iterator i = vars.var_begin(),
+                                    i_end = vars.var_end();
+       i != i_end;
+       ++i)
+  {
+    ArithVar v = *i;
+    convert(vars.getAssignment(v), d_value[v]);
+    d_invalid = d_invalid || !isValid(d_value[v]);
+    if (vars.hasLowerBound(v))
+    {
+      convert(vars.getLowerBound(v), d_lower[v]);
+      d_invalid = d_invalid || !isValid(d_lower[v]);
+    }
+    if (vars.hasUpperBound(v))
+    {
+      convert(vars.getUpperBound(v), d_upper[v]);
+      d_invalid = d_invalid || !isValid(d_upper[v]);
+    }
+  }
+
+  for (Tableau::BasicIterator i = tableau.beginBasic(),
+                              i_end = tableau.endBasic();
+       i != i_end;
+       ++i)
+  {
+    ArithVar basic = *i;
+    size_t r = d_rows.size();
+    d_rows.emplace_back();
+    d_rowToBasic.push_back(basic);
+    d_basicToRow[basic] = r;
+    for (Tableau::RowIterator j = tableau.basicRowIterator(basic); !j.atEnd();
+         ++j)
+    {
+      const Tableau::Entry& entry = *j;
+      ArithVar nonbasic = entry.getColVar();
+      if (nonbasic != basic)
+      {
+        Coeff c;
+        convert(entry.getCoefficient(), c);
+        addToEntry(r, nonbasic, c);
+      }
+    }
+  }
+}
+
+template <class Coeff, class Value>
+bool ShadowSimplex<Coeff, Value>::belowLower(ArithVar x) const
+{
+  return d_vars.hasLowerBound(x) && lessBeyondTolerance(d_value[x], d_lower[x]);
+}
+
+template <class Coeff, class Value>
+bool ShadowSimplex<Coeff, Value>::aboveUpper(ArithVar x) const
+{
+  return d_vars.hasUpperBound(x)
+         && greaterBeyondTolerance(d_value[x], d_upper[x]);
+}
+
+template <class Coeff, class Value>
+ArithVar ShadowSimplex<Coeff, Value>::selectEntering(ArithVar basic,
+                                                     bool inc) const
+{
+  ArithVar entering = ARITHVAR_SENTINEL;
+  for (const std::pair<const ArithVar, Coeff>& e : d_rows[d_basicToRow[basic]])
+  {
+    ArithVar x = e.first;
+    if (entering != ARITHVAR_SENTINEL && x > entering)
+    {
+      continue;
+    }
+    // avoid pivoting on entries that are zero up to rounding errors
+    if (isTooSmallPivot(e.second))
+    {
+      continue;
+    }
+    bool canMove = (isPositive(e.second) == inc)
+                       ? (!d_vars.hasUpperBound(x)
+                          || lessBeyondTolerance(d_value[x], d_upper[x]))
+                       : (!d_vars.hasLowerBound(x)
+                          || greaterBeyondTolerance(d_value[x], d_lower[x]));
+    if (canMove)
+    {
+      entering = x;
+    }
+  }
+  return entering;
+}
+
+template <class Coeff, class Value>
+void ShadowSimplex<Coeff, Value>::addToEntry(size_t r,
+                                             ArithVar x,
+                                             const Coeff& c)
+{
+  d_invalid = d_invalid || !isValid(c);
+  if (d_invalid)
+  {
+    return;
+  }
+  Row& row = d_rows[r];
+  typename Row::iterator it = row.find(x);
+  if (it == row.end())
+  {
+    if (!isNegligible(c))
+    {
+      row[x] = c;
+      d_cols[x].insert(r);
+    }
+  }
+  else
+  {
+    it->second = it->second + c;
+    d_invalid = d_invalid || !isValid(it->second);
+    if (isNegligible(it->second))
+    {
+      row.erase(it);
+      d_cols[x].erase(r);
+    }
+  }
+}
+
+template <class Coeff, class Value>
+void ShadowSimplex<Coeff, Value>::pivotAndUpdate(ArithVar basic,
+                                                 ArithVar entering,
+                                                 const Value& v)
+{
+  size_t r = d_basicToRow[basic];
+  Coeff a = d_rows[r][entering];
+
+  // update the values, for which the rows of entering are still valid
+  Value theta = (v - d_value[basic]) / a;
+  d_value[entering] = d_value[entering] + theta;
+  d_invalid = d_invalid || !isValid(d_value[entering]);
+  for (size_t s : d_cols[entering])
+  {
+    ArithVar b = d_rowToBasic[s];
+    d_value[b] = d_value[b] + d_rows[s][entering] * theta;
+    d_invalid = d_invalid || !isValid(d_value[b]);
+  }
+  d_value[basic] = v;
+
+  // solve the row of basic for entering
+  Row& row = d_rows[r];
+  row.erase(entering);
+  for (std::pair<const ArithVar, Coeff>& e : row)
+  {
+    e.second = -e.second / a;
+    d_invalid = d_invalid || !isValid(e.second);
+  }
+  row[basic] = Coeff(1) / a;
+  d_cols[basic].insert(r);
+
+  // substitute entering in the other rows
+  std::vector<size_t> rows(d_cols[entering].begin(), d_cols[entering].end());
+  d_cols[entering].clear();
+  for (size_t s : rows)
+  {
+    if (s == r)
+    {
+      continue;
+    }
+    typename Row::iterator it = d_rows[s].find(entering);
+    Coeff c = it->second;
+    d_rows[s].erase(it);
+    for (const std::pair<const ArithVar, Coeff>& e : d_rows[r])
+    {
+      addToEntry(s, e.first, c * e.second);
+    }
+  }
+
+  d_rowToBasic[r] = entering;
+  d_basicToRow[entering] = r;
+  d_basicToRow[basic] = s_noRow;
+}
+
+template <class Coeff, class Value>
+LinResult ShadowSimplex<Coeff, Value>::solve()
+{
+  while (true)
+  {
+    if (d_invalid)
+    {
+      Debug("arith::float") << "ShadowSimplex overflow after " << d_pivots
+                            << " pivots" << endl;
+      return LinUnknown;
+    }
+    // select the basic variable violating its bounds with the smallest index
+    ArithVar basic = ARITHVAR_SENTINEL;
+    bool inc = false;
+    for (ArithVar x : d_rowToBasic)
+    {
+      if (basic != ARITHVAR_SENTINEL && x > basic)
+      {
+        continue;
+      }
+      if (belowLower(x))
+      {
+        basic = x;
+        inc = true;
+      }
+      else if (aboveUpper(x))
+      {
+        basic = x;
+        inc = false;
+      }
+    }
+    if (basic == ARITHVAR_SENTINEL)
+    {
+      Debug("arith::float") << "ShadowSimplex feasible after " << d_pivots
+                            << " pivots" << endl;
+      return LinFeasible;
+    }
+    if (d_pivots >= d_pivotLimit)
+    {
+      return LinExhausted;
+    }
+    ArithVar entering = selectEntering(basic, inc);
+    if (entering == ARITHVAR_SENTINEL)
+    {
+      Debug("arith::float") << "ShadowSimplex infeasible row of " << basic
+                            << " after " << d_pivots << " pivots" << endl;
+      return LinInfeasible;
+    }
+    pivotAndUpdate(basic, entering, inc ? d_lower[basic] : d_upper[basic]);
+    ++d_pivots;
+  }
+}
+
+template <class Coeff, class Value>
+ApproximateSimplex::Solution ShadowSimplex<Coeff, Value>::extractSolution()
+    const
+{
+  Assert(!d_invalid);
+  ApproximateSimplex::Solution sol;
+  for (ArithVar basic : d_rowToBasic)
+  {
+    sol.newBasis.add(basic);
+  }
+  for (ArithVariables::var_iterator i = d_vars.var_begin(),
+                                    i_end = d_vars.var_end();
+       i != i_end;
+       ++i)
+  {
+    ArithVar v = *i;
+    sol.newValues.set(
+        v, toExactValue(d_vars, v, d_value[v], d_lower[v], d_upper[v]));
+  }
+  return sol;
+}
+
+template class ShadowSimplex<double, double>;
+template class ShadowSimplex<Int64Rational, Int64DeltaRational>;
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file float_simplex.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A floating point or 64-bit simplex over a copy of the tableau
+ **
+ ** A floating point or 64-bit rational simplex over a copy of the tableau,
+ ** used to guess the basis of a solution or of a conflict of the exact
+ ** simplex.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "theory/arith/approx_simplex.h"
+#include "theory/arith/arithvar.h"
+#include "theory/arith/int64_rational.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class Tableau;
+
+/**
+ * A simplex over a copy of the tableau where the coefficients, bounds and
+ * values are machine numbers: Coeff and Value are either both double, or
+ * Int64Rational and Int64DeltaRational. It runs the simplex of Dutertre and
+ * de Moura with Bland's rule on the copy, without any GMP arithmetic, until
+ * it finds an assignment that satisfies the bounds, or a row that cannot be
+ * repaired, or hits the pivot limit.
+ *
+ * With doubles, the bounds are satisfied up to a tolerance and the delta of
+ * the strict bounds is approximated by a fixed value. With Int64Rationals,
+ * the arithmetic is exact, and the simplex gives up as soon as a number
+ * does not fit in 64 bits.
+ *
+ * The result is only a guess. The basis it ends with, together with the
+ * values of the nonbasic variables (snapped to their exact bounds with
+ * doubles), can be imported in the exact simplex by AttemptSolutionSDP,
+ * which then verifies feasibility and produces conflicts in exact
+ * arithmetic.
+ */
+template <class Coeff, class Value>
+class ShadowSimplex
+{
+ public:
+  ShadowSimplex(const ArithVariables& vars, const Tableau& tableau);
+
+  /** Set the maximal number of pivots of solve() */
+  void setPivotLimit(int pl) { d_pivotLimit = pl; }
+
+  /**
+   * Run the simplex on the copy of the tableau. Returns LinFeasible or
+   * LinInfeasible according to the guess, LinExhausted if the pivot limit
+   * was reached and LinUnknown on numerical trouble, i.e. an overflow.
+   */
+  LinResult solve();
+
+  /** Get the basis and the values found by solve() */
+  ApproximateSimplex::Solution extractSolution() const;
+
+  /** Get the number of pivots done by solve() */
+  int getPivots() const { return d_pivots; }
+
+ private:
+  /** A row, mapping the nonbasic variables to their coefficients */
+  using Row = std::unordered_map<ArithVar, Coeff>;
+
+  /** Whether x is below its lower bound (by more than the tolerance) */
+  bool belowLower(ArithVar x) const;
+  /** Whether x is above its upper bound (by more than the tolerance) */
+  bool aboveUpper(ArithVar x) const;
+  /**
+   * Get the nonbasic variable of the row of basic with the smallest index
+   * that can increase (if inc) or decrease (otherwise) the value of basic,
+   * or ARITHVAR_SENTINEL if there is none.
+   */
+  ArithVar selectEntering(ArithVar basic, bool inc) const;
+  /**
+   * Update the nonbasic variable entering so that basic has value v, and
+   * exchange them in the basis.
+   */
+  void pivotAndUpdate(ArithVar basic, ArithVar entering, const Value& v);
+  /** Add c to the coefficient of x in row r */
+  void addToEntry(size_t r, ArithVar x, const Coeff& c);
+
+  const ArithVariables& d_vars;
+  /** The rows of the copy of the tableau */
+  std::vector<Row> d_rows;
+  /** The basic variable of each row */
+  std::vector<ArithVar> d_rowToBasic;
+  /** The row of each basic variable, or s_noRow */
+  std::vector<size_t> d_basicToRow;
+  /** The rows in which each nonbasic variable occurs */
+  std::vector<std::unordered_set<size_t>> d_cols;
+  /** The values, lower and upper bounds of the variables */
+  std::vector<Value> d_value;
+  std::vector<Value> d_lower;
+  std::vector<Value> d_upper;
+  /** Whether some number is invalid, in which case solve() gives up */
+  bool d_invalid;
+  /** The maximal number of pivots */
+  int d_pivotLimit;
+  /** The number of pivots done */
+  int d_pivots;
+
+  static const size_t s_noRow;
+}; /* class ShadowSimplex */
+
+/** The simplex in floating point arithmetic */
+using FloatSimplex = ShadowSimplex<double, double>;
+/** The simplex in exact arithmetic on 64-bit rationals */
+using Int64Simplex = ShadowSimplex<Int64Rational, Int64DeltaRational>;
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
@@ -15,6 +15,7 @@
 #include "theory/arith/inference_manager.h"
 
 #include "options/arith_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/arith/arith_state.h"
 #include "theory/arith/theory_arith.h"
 #include "theory/rewriter.h"
@@ -26,8 +27,15 @@ namespace arith {
 InferenceManager::InferenceManager(TheoryArith& ta,
                                    ArithState& astate,
                                    ProofNodeManager* pnm)
-    : InferenceManagerBuffered(ta, astate, pnm, "theory::arith")
+    : InferenceManagerBuffered(ta, astate, pnm, "theory::arith"),
+      d_duplicateLemmaIdStats("theory::arith::inferencesLemmaDuplicate")
 {
+  smtStatisticsRegistry()->registerStat(&d_duplicateLemmaIdStats);
+}
+
+InferenceManager::~InferenceManager()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_duplicateLemmaIdStats);
 }
 
 void InferenceManager::addPendingLemma(std::unique_ptr<SimpleTheoryLemma> lemma,
@@ -35,8 +43,15 @@ void InferenceManager::addPendingLemma(std::unique_ptr<SimpleTheoryLemma> lemma,
 {
   Trace("arith::infman") << "Add " << lemma->getId() << " " << lemma->d_node
                          << (isWaiting ? " as waiting" : "") << std::endl;
-  if (hasCachedLemma(lemma->d_node, lemma->d_property))
+  Node rewritten = Rewriter::rewrite(lemma->d_node);
+  // lemmas with properties are not merged with buffered lemmas, as they may
+  // only differ in their properties
+  bool trackBuffered = lemma->d_property == LemmaProperty::NONE;
+  if (TheoryInferenceManager::hasCachedLemma(rewritten, lemma->d_property)
+      || (trackBuffered && isBuffered(rewritten)))
   {
+    Trace("arith::infman") << "Drop duplicate " << lemma->getId() << std::endl;
+    d_duplicateLemmaIdStats << lemma->getId();
     return;
   }
   if (isEntailedFalse(*lemma))
@@ -44,20 +59,30 @@ void InferenceManager::addPendingLemma(std::unique_ptr<SimpleTheoryLemma> lemma,
     if (isWaiting)
     {
       d_waitingLem.clear();
+      d_waitingRewritten.clear();
     }
     else
     {
       d_pendingLem.clear();
+      d_pendingRewritten.clear();
       d_theoryState.notifyInConflict();
     }
   }
   if (isWaiting)
   {
     d_waitingLem.emplace_back(std::move(lemma));
+    if (trackBuffered)
+    {
+      d_waitingRewritten.insert(rewritten);
+    }
   }
   else
   {
     d_pendingLem.emplace_back(std::move(lemma));
+    if (trackBuffered)
+    {
+      d_pendingRewritten.insert(rewritten);
+    }
   }
 }
 void InferenceManager::addPendingLemma(const SimpleTheoryLemma& lemma,
@@ -88,10 +113,14 @@ void InferenceManager::flushWaitingLemmas()
     d_pendingLem.emplace_back(std::move(lem));
   }
   d_waitingLem.clear();
+  d_pendingRewritten.insert(d_waitingRewritten.begin(),
+                            d_waitingRewritten.end());
+  d_waitingRewritten.clear();
 }
 void InferenceManager::clearWaitingLemmas()
 {
   d_waitingLem.clear();
+  d_waitingRewritten.clear();
 }
 
 bool InferenceManager::hasUsed() const
@@ -109,6 +138,17 @@ std::size_t InferenceManager::numWaitingLemmas() const
   return d_waitingLem.size();
 }
 
+bool InferenceManager::isBuffered(const Node& rewritten)
+{
+  if (!hasPendingLemma())
+  {
+    // the pending lemmas were sent or dropped since
+    d_pendingRewritten.clear();
+  }
+  return d_pendingRewritten.find(rewritten) != d_pendingRewritten.end()
+         || d_waitingRewritten.find(rewritten) != d_waitingRewritten.end();
+}
+
 bool InferenceManager::hasCachedLemma(TNode lem, LemmaProperty p)
 {
   Node rewritten = Rewriter::rewrite(lem);
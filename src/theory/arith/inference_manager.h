@@ -17,10 +17,13 @@
 #ifndef CVC4__THEORY__ARITH__INFERENCE_MANAGER_H
 #define CVC4__THEORY__ARITH__INFERENCE_MANAGER_H
 
+#include <unordered_set>
 #include <vector>
 
+#include "expr/node.h"
 #include "theory/inference_id.h"
 #include "theory/inference_manager_buffered.h"
+#include "util/stats_histogram.h"
 
 namespace cvc5 {
 namespace theory {
@@ -46,6 +49,7 @@ class InferenceManager : public InferenceManagerBuffered
 
  public:
   InferenceManager(TheoryArith& ta, ArithState& astate, ProofNodeManager* pnm);
+  ~InferenceManager();
 
   /**
    * Add a lemma as pending lemma to this inference manager.
@@ -111,8 +115,23 @@ class InferenceManager : public InferenceManagerBuffered
    */
   bool isEntailedFalse(const SimpleTheoryLemma& lem);
 
+  /**
+   * Checks whether the lemma with the given rewritten form is pending or
+   * waiting already.
+   */
+  bool isBuffered(const Node& rewritten);
+
   /** The waiting lemmas. */
   std::vector<std::unique_ptr<SimpleTheoryLemma>> d_waitingLem;
+  /**
+   * The rewritten forms of the pending lemmas added by this class. Cleared
+   * when there are no pending lemmas anymore, i.e. they were sent or dropped.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_pendingRewritten;
+  /** The rewritten forms of the waiting lemmas. */
+  std::unordered_set<Node, NodeHashFunction> d_waitingRewritten;
+  /** The lemmas that were dropped as they were sent or buffered already. */
+  IntegralHistogramStat<InferenceId> d_duplicateLemmaIdStats;
 };
 
 }  // namespace arith
@@ -0,0 +1,218 @@
+/*********************                                                        */
+/*! \file int64_rational.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Exact rationals and delta-rationals of 64-bit integers.
+ **
+ ** Exact rationals and delta-rationals whose numerators and denominators are
+ ** 64-bit integers, with checked arithmetic.
+ **/
+
+#include "cvc4_private.h"
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "base/check.h"
+#include "theory/arith/delta_rational.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+/**
+ * An exact rational whose numerator and denominator are 64-bit integers,
+ * always in lowest terms with a positive denominator. The intermediate
+ * results of the operations are computed in 128-bit integers. An operation
+ * whose result does not fit in 64 bits returns an invalid number, and so
+ * does every operation with an invalid operand, like NaN for doubles.
+ * Comparisons are only defined on valid numbers.
+ */
+class Int64Rational
+{
+ public:
+  Int64Rational() : d_num(0), d_den(1) {}
+  explicit Int64Rational(int64_t n) : d_num(n), d_den(1) {}
+
+  /** Get r, or an invalid number if it does not fit */
+  static Int64Rational fromRational(const Rational& r)
+  {
+    Integer n = r.getNumerator();
+    Integer d = r.getDenominator();
+    if (!n.fitsSignedLong() || !d.fitsSignedLong())
+    {
+      return invalid();
+    }
+    return Int64Rational(n.getLong(), d.getLong());
+  }
+  /** Get an invalid number */
+  static Int64Rational invalid() { return Int64Rational(0, 0); }
+
+  /** Whether this number is valid, i.e. no operation overflowed */
+  bool isValid() const { return d_den != 0; }
+  /** Get this valid number as a Rational */
+  Rational toRational() const
+  {
+    Assert(isValid());
+    return Rational(d_num, d_den);
+  }
+  int sgn() const
+  {
+    Assert(isValid());
+    return d_num > 0 ? 1 : (d_num < 0 ? -1 : 0);
+  }
+  bool isZero() const { return isValid() && d_num == 0; }
+
+  Int64Rational operator-() const
+  {
+    return isValid() ? make(-static_cast<__int128>(d_num), d_den) : invalid();
+  }
+  Int64Rational operator+(const Int64Rational& b) const
+  {
+    if (!isValid() || !b.isValid())
+    {
+      return invalid();
+    }
+    return make(static_cast<__int128>(d_num) * b.d_den
+                    + static_cast<__int128>(b.d_num) * d_den,
+                static_cast<__int128>(d_den) * b.d_den);
+  }
+  Int64Rational operator-(const Int64Rational& b) const { return *this + -b; }
+  Int64Rational operator*(const Int64Rational& b) const
+  {
+    if (!isValid() || !b.isValid())
+    {
+      return invalid();
+    }
+    return make(static_cast<__int128>(d_num) * b.d_num,
+                static_cast<__int128>(d_den) * b.d_den);
+  }
+  Int64Rational operator/(const Int64Rational& b) const
+  {
+    if (!isValid() || !b.isValid() || b.d_num == 0)
+    {
+      return invalid();
+    }
+    __int128 n = static_cast<__int128>(d_num) * b.d_den;
+    __int128 d = static_cast<__int128>(d_den) * b.d_num;
+    return d < 0 ? make(-n, -d) : make(n, d);
+  }
+
+  bool operator==(const Int64Rational& b) const
+  {
+    Assert(isValid() && b.isValid());
+    return d_num == b.d_num && d_den == b.d_den;
+  }
+  bool operator!=(const Int64Rational& b) const { return !(*this == b); }
+  bool operator<(const Int64Rational& b) const
+  {
+    Assert(isValid() && b.isValid());
+    return static_cast<__int128>(d_num) * b.d_den
+           < static_cast<__int128>(b.d_num) * d_den;
+  }
+  bool operator>(const Int64Rational& b) const { return b < *this; }
+  bool operator<=(const Int64Rational& b) const { return !(b < *this); }
+  bool operator>=(const Int64Rational& b) const { return !(*this < b); }
+
+ private:
+  Int64Rational(int64_t n, int64_t d) : d_num(n), d_den(d) {}
+
+  /** Get n/d in lowest terms, where d > 0, or invalid if it does not fit */
+  static Int64Rational make(__int128 n, __int128 d)
+  {
+    Assert(d > 0);
+    __int128 a = n < 0 ? -n : n;
+    __int128 b = d;
+    while (b != 0)
+    {
+      __int128 t = a % b;
+      a = b;
+      b = t;
+    }
+    // a is the gcd of n and d, which is positive since d is
+    n /= a;
+    d /= a;
+    if (n < std::numeric_limits<int64_t>::min()
+        || n > std::numeric_limits<int64_t>::max()
+        || d > std::numeric_limits<int64_t>::max())
+    {
+      return invalid();
+    }
+    return Int64Rational(static_cast<int64_t>(n), static_cast<int64_t>(d));
+  }
+
+  int64_t d_num;
+  /** The denominator, which is 0 if this number is invalid */
+  int64_t d_den;
+}; /* class Int64Rational */
+
+/**
+ * A delta-rational c + k * delta, where c and k are Int64Rationals. It is
+ * valid if c and k are, and is ordered lexicographically like DeltaRational.
+ */
+class Int64DeltaRational
+{
+ public:
+  Int64DeltaRational() {}
+  Int64DeltaRational(const Int64Rational& c, const Int64Rational& k)
+      : d_c(c), d_k(k)
+  {
+  }
+
+  /** Get d, or an invalid number if it does not fit */
+  static Int64DeltaRational fromDeltaRational(const DeltaRational& d)
+  {
+    return Int64DeltaRational(
+        Int64Rational::fromRational(d.getNoninfinitesimalPart()),
+        Int64Rational::fromRational(d.getInfinitesimalPart()));
+  }
+
+  bool isValid() const { return d_c.isValid() && d_k.isValid(); }
+  /** Get this valid number as a DeltaRational */
+  DeltaRational toDeltaRational() const
+  {
+    return DeltaRational(d_c.toRational(), d_k.toRational());
+  }
+
+  Int64DeltaRational operator+(const Int64DeltaRational& b) const
+  {
+    return Int64DeltaRational(d_c + b.d_c, d_k + b.d_k);
+  }
+  Int64DeltaRational operator-(const Int64DeltaRational& b) const
+  {
+    return Int64DeltaRational(d_c - b.d_c, d_k - b.d_k);
+  }
+  Int64DeltaRational operator/(const Int64Rational& a) const
+  {
+    return Int64DeltaRational(d_c / a, d_k / a);
+  }
+  friend Int64DeltaRational operator*(const Int64Rational& a,
+                                      const Int64DeltaRational& b)
+  {
+    return Int64DeltaRational(a * b.d_c, a * b.d_k);
+  }
+
+  bool operator<(const Int64DeltaRational& b) const
+  {
+    return d_c < b.d_c || (d_c == b.d_c && d_k < b.d_k);
+  }
+  bool operator>(const Int64DeltaRational& b) const { return b < *this; }
+
+ private:
+  Int64Rational d_c;
+  Int64Rational d_k;
+}; /* class Int64DeltaRational */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
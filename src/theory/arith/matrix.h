@@ -19,7 +19,6 @@
 
 #pragma once
 
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -164,7 +163,11 @@ private:
   typedef std::vector<EntryType> EntryArray;
 
   EntryArray d_entries;
-  std::queue<EntryID> d_freedEntries;
+  /**
+   * The freed entries, reused last freed first so that new entries land in
+   * memory that was recently touched.
+   */
+  std::vector<EntryID> d_freedEntries;
 
   uint32_t d_size;
 
@@ -187,7 +190,7 @@ public:
     Assert(get(id).blank());
     Assert(d_size > 0);
 
-    d_freedEntries.push(id);
+    d_freedEntries.push_back(id);
     --d_size;
   }
 
@@ -197,13 +200,45 @@ public:
       newId = d_entries.size();
       d_entries.push_back(MatrixEntry<T>());
     }else{
-      newId = d_freedEntries.front();
-      d_freedEntries.pop();
+      newId = d_freedEntries.back();
+      d_freedEntries.pop_back();
     }
     ++d_size;
     return newId;
   }
 
+  /**
+   * Renumbers the entries in use so that order[i] gets the id i, and drops
+   * the freed entries. order must contain each entry in use exactly once.
+   * The links between the entries are updated, and the map from the old ids
+   * to the new ids is returned.
+   */
+  std::vector<EntryID> renumber(const std::vector<EntryID>& order){
+    Assert(order.size() == d_size);
+    std::vector<EntryID> newIds(d_entries.size(), ENTRYID_SENTINEL);
+    for(EntryID i = 0, N = order.size(); i < N; ++i){
+      newIds[order[i]] = i;
+    }
+    auto remap = [&newIds](EntryID id) {
+      return id == ENTRYID_SENTINEL ? id : newIds[id];
+    };
+
+    EntryArray entries;
+    entries.reserve(order.size());
+    for(EntryID id : order){
+      Assert(!d_entries[id].blank());
+      entries.push_back(std::move(d_entries[id]));
+      EntryType& entry = entries.back();
+      entry.setNextRowEntryID(remap(entry.getNextRowEntryID()));
+      entry.setNextColEntryID(remap(entry.getNextColEntryID()));
+      entry.setPrevRowEntryID(remap(entry.getPrevRowEntryID()));
+      entry.setPrevColEntryID(remap(entry.getPrevColEntryID()));
+    }
+    d_entries.swap(entries);
+    d_freedEntries.clear();
+    return newIds;
+  }
+
   uint32_t size() const{ return d_size; }
   uint32_t capacity() const{ return d_entries.capacity(); }
 
@@ -932,6 +967,43 @@ public:
     }
   }
 
+  /**
+   * Renumbers the entries so that the entries of each row are contiguous in
+   * memory, in the order of the row, and releases the freed entries.
+   * Pivoting scatters the entries of a row over the entry array, which makes
+   * iterating over the rows cache unfriendly; this restores the locality.
+   *
+   * Invalidates all of the iterators, EntryIDs and references to entries.
+   * The merge buffer must be clear.
+   */
+  void compact(){
+    Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
+    Assert(d_mergeBuffer.empty());
+
+    std::vector<EntryID> order;
+    order.reserve(d_entriesInUse);
+    for(RowIndex rid = 0, N = d_rows.size(); rid < N; ++rid){
+      for(RowIterator i = getRow(rid).begin(); !i.atEnd(); ++i){
+        order.push_back(i.getID());
+      }
+    }
+    Assert(order.size() == d_entriesInUse);
+
+    std::vector<EntryID> newIds = d_entries.renumber(order);
+    auto remap = [&newIds](EntryID id) {
+      return id == ENTRYID_SENTINEL ? id : newIds[id];
+    };
+    for(RowIndex rid = 0, N = d_rows.size(); rid < N; ++rid){
+      const RowVectorT& row = d_rows[rid];
+      d_rows[rid] = RowVectorT(remap(row.getHead()), row.getSize(), &d_entries);
+    }
+    for(ArithVar v = 0, N = d_columns.size(); v < N; ++v){
+      const ColumnVectorT& col = d_columns[v];
+      d_columns[v] =
+          ColumnVectorT(remap(col.getHead()), col.getSize(), &d_entries);
+    }
+  }
+
 protected:
   uint32_t numNonZeroEntries() const { return size(); }
 
@@ -54,17 +54,40 @@ CDCAC::CDCAC(context::Context* ctx,
 void CDCAC::reset()
 {
   d_constraints.reset();
+  d_constraintsByVariable.clear();
   d_assignment.clear();
 }
 
 void CDCAC::computeVariableOrdering()
 {
   // Actually compute the variable ordering
-  d_variableOrdering = d_varOrder(d_constraints.getConstraints(),
-                                  VariableOrderingStrategy::BROWN);
+  std::vector<poly::Variable> ordering = d_varOrder(
+      d_constraints.getConstraints(), VariableOrderingStrategy::BROWN);
+  if (ordering != d_variableOrdering)
+  {
+    // the cached intervals are in the first variable of the old ordering
+    d_firstVariableIntervals.clear();
+    d_variableOrdering = std::move(ordering);
+  }
   Trace("cdcac") << "Variable ordering is now " << d_variableOrdering
                  << std::endl;
 
+  d_constraintsByVariable.assign(d_variableOrdering.size(), {});
+  const Constraints::ConstraintVector& constraints =
+      d_constraints.getConstraints();
+  for (std::size_t c = 0, n = constraints.size(); c < n; ++c)
+  {
+    poly::Variable mv = main_variable(std::get<0>(constraints[c]));
+    for (std::size_t v = 0, m = d_variableOrdering.size(); v < m; ++v)
+    {
+      if (d_variableOrdering[v] == mv)
+      {
+        d_constraintsByVariable[v].push_back(c);
+        break;
+      }
+    }
+  }
+
   // Write variable ordering back to libpoly.
   lp_variable_order_t* vo = poly::Context::get_context().get_variable_order();
   lp_variable_order_clear(vo);
@@ -100,18 +123,30 @@ const std::vector<poly::Variable>& CDCAC::getVariableOrdering() const
 
 std::vector<CACInterval> CDCAC::getUnsatIntervals(std::size_t cur_variable)
 {
+  Assert(d_constraintsByVariable.size() == d_variableOrdering.size())
+      << "The variable ordering was not computed";
   std::vector<CACInterval> res;
-  for (const auto& c : d_constraints.getConstraints())
+  for (std::size_t ci : d_constraintsByVariable[cur_variable])
   {
+    const auto& c = d_constraints.getConstraints()[ci];
     const poly::Polynomial& p = std::get<0>(c);
     poly::SignCondition sc = std::get<1>(c);
     const Node& n = std::get<2>(c);
+    Assert(main_variable(p) == d_variableOrdering[cur_variable]);
 
-    if (main_variable(p) != d_variableOrdering[cur_variable])
+    bool cache = cur_variable == 0 && !isProofEnabled();
+    if (cache)
     {
-      // Constraint is in another variable, ignore it.
-      continue;
+      auto it = d_firstVariableIntervals.find(n);
+      if (it != d_firstVariableIntervals.end())
+      {
+        Trace("cdcac") << "Cached infeasible intervals for " << p << " " << sc
+                       << std::endl;
+        res.insert(res.end(), it->second.begin(), it->second.end());
+        continue;
+      }
     }
+    std::size_t first = res.size();
 
     Trace("cdcac") << "Infeasible intervals for " << p << " " << sc
                    << " 0 over " << d_assignment << std::endl;
@@ -137,6 +172,10 @@ std::vector<CACInterval> CDCAC::getUnsatIntervals(std::size_t cur_variable)
             n);
       }
     }
+    if (cache)
+    {
+      d_firstVariableIntervals[n].assign(res.begin() + first, res.end());
+    }
   }
   pruneRedundantIntervals(res);
   return res;
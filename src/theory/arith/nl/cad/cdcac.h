@@ -24,8 +24,10 @@
 
 #include <poly/polyxx.h>
 
+#include <unordered_map>
 #include <vector>
 
+#include "expr/node.h"
 #include "theory/arith/nl/cad/cdcac_utils.h"
 #include "theory/arith/nl/cad/constraints.h"
 #include "theory/arith/nl/cad/proof_generator.h"
@@ -55,7 +57,11 @@ class CDCAC
   /** Reset this instance. */
   void reset();
 
-  /** Collect variables from the constraints and compute a variable ordering. */
+  /**
+   * Collect variables from the constraints and compute a variable ordering.
+   * Must be called after the constraints are added and before
+   * getUnsatCover().
+   */
   void computeVariableOrdering();
 
   /**
@@ -87,6 +93,8 @@ class CDCAC
    * Collect all unsatisfiable intervals for the given variable.
    * Combines unsatisfiable regions from d_constraints evaluated over
    * d_assignment. Implements Algorithm 2.
+   * The intervals of the constraints in the first variable do not depend on
+   * d_assignment, and are taken from d_firstVariableIntervals if possible.
    */
   std::vector<CACInterval> getUnsatIntervals(std::size_t cur_variable);
 
@@ -196,6 +204,13 @@ class CDCAC
   /** The computed variable ordering used for this method. */
   std::vector<poly::Variable> d_variableOrdering;
 
+  /**
+   * The indices in d_constraints of the constraints by the index of their
+   * main variable in d_variableOrdering, such that getUnsatIntervals() does
+   * not go through all constraints for each sample.
+   */
+  std::vector<std::vector<std::size_t>> d_constraintsByVariable;
+
   /** The object computing the variable ordering. */
   VariableOrdering d_varOrder;
 
@@ -204,6 +219,16 @@ class CDCAC
 
   /** The proof generator */
   std::unique_ptr<CADProofGenerator> d_proof;
+
+  /**
+   * The unsatisfiable intervals of the constraints in the first variable,
+   * before pruning, by constraint. They are kept across calls to reset(), as
+   * consecutive checks mostly share their constraints, and are cleared when
+   * the variable ordering changes. Not used if proofs are enabled, as the
+   * proof steps are recorded when the intervals are computed.
+   */
+  std::unordered_map<Node, std::vector<CACInterval>, NodeHashFunction>
+      d_firstVariableIntervals;
 };
 
 }  // namespace cad
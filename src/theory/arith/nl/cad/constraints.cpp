@@ -41,7 +41,6 @@ void Constraints::addConstraint(Node n)
 {
   auto c = as_poly_constraint(n, d_varMapper);
   addConstraint(c.first, c.second, n);
-  sortConstraints();
 }
 
 const Constraints::ConstraintVector& Constraints::getConstraints() const
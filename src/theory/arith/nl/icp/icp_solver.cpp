@@ -204,6 +204,25 @@ void ICPSolver::initOrigins()
   }
 }
 
+bool ICPSolver::needsPropagation(std::size_t i) const
+{
+  std::size_t last = d_state.d_lastPropagation[i];
+  if (last == 0)
+  {
+    return true;
+  }
+  for (const Node& v : d_state.d_candidates[i].rhsVariables)
+  {
+    auto it = d_state.d_lastContraction.find(v);
+    // a candidate can contract the variables of its own right hand side
+    if (it != d_state.d_lastContraction.end() && it->second >= last)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 PropagationResult ICPSolver::doPropagationRound()
 {
   if (d_budget <= 0)
@@ -216,10 +235,22 @@ PropagationResult ICPSolver::doPropagationRound()
                   << IAWrapper{d_state.d_assignment, d_mapper} << std::endl;
   Trace("nl-icp") << "Current budget: " << d_budget << std::endl;
   PropagationResult res = PropagationResult::NOT_CHANGED;
-  for (const auto& c : d_state.d_candidates)
+  d_state.d_lastPropagation.resize(d_state.d_candidates.size(), 0);
+  for (std::size_t i = 0, n = d_state.d_candidates.size(); i < n; ++i)
   {
+    if (!needsPropagation(i))
+    {
+      continue;
+    }
+    const Candidate& c = d_state.d_candidates[i];
     --d_budget;
+    std::size_t time = ++d_state.d_time;
+    d_state.d_lastPropagation[i] = time;
     PropagationResult cres = c.propagate(d_state.d_assignment, 100);
+    if (cres != PropagationResult::NOT_CHANGED)
+    {
+      d_state.d_lastContraction[d_mapper(c.lhs)] = time;
+    }
     switch (cres)
     {
       case PropagationResult::NOT_CHANGED: break;
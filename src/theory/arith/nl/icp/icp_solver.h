@@ -21,6 +21,9 @@
 #include <poly/polyxx.h>
 #endif /* CVC4_POLY_IMP */
 
+#include <unordered_map>
+#include <vector>
+
 #include "expr/node.h"
 #include "theory/arith/bound_inference.h"
 #include "theory/arith/nl/icp/candidate.h"
@@ -71,6 +74,15 @@ class ICPSolver
     ContractionOriginManager d_origins;
     /** The conflict, if any way found. Initially empty */
     std::vector<Node> d_conflict;
+    /**
+     * The number of candidate propagations so far, used as a time stamp to
+     * only propagate candidates whose right hand side changed.
+     */
+    std::size_t d_time = 0;
+    /** The time of the last propagation of each candidate, or zero */
+    std::vector<std::size_t> d_lastPropagation;
+    /** The time of the last contraction of each variable */
+    std::unordered_map<Node, std::size_t, NodeHashFunction> d_lastContraction;
 
     /** Initialized the variable bounds with a variable mapper */
     ICPState(VariableMapper& vm) {}
@@ -83,6 +95,9 @@ class ICPSolver
       d_assignment.clear();
       d_origins = ContractionOriginManager();
       d_conflict.clear();
+      d_time = 0;
+      d_lastPropagation.clear();
+      d_lastContraction.clear();
     }
   };
 
@@ -110,7 +125,14 @@ class ICPSolver
   void initOrigins();
 
   /**
-   * Perform one contraction with every candidate.
+   * Whether some variable of the right hand side of the i-th candidate was
+   * contracted since it was last propagated, or it was never propagated.
+   */
+  bool needsPropagation(std::size_t i) const;
+
+  /**
+   * Perform one contraction with every candidate that needs it, see
+   * needsPropagation().
    * If any candidate yields a conflict stops immediately and returns
    * PropagationResult::CONFLICT. If any candidate yields a contraction returns
    * PropagationResult::CONTRACTED. Otherwise returns
@@ -147,6 +147,18 @@ std::uint64_t TaylorGenerator::getPolynomialApproximationBoundForArg(
   Assert(c.isConst());
   if (k == Kind::EXPONENTIAL && c.getConst<Rational>().sgn() == 1)
   {
+    PointKey key(k, c, d);
+    std::map<PointKey, std::uint64_t>::iterator itd = d_arg_degree.find(key);
+    if (itd != d_arg_degree.end())
+    {
+      if (itd->second > d)
+      {
+        ApproximationBounds pboundss;
+        getPolynomialApproximationBounds(k, itd->second, pboundss);
+        pbounds.d_upperPos = pboundss.d_upperPos;
+      }
+      return itd->second;
+    }
     bool success = false;
     std::uint64_t ds = d;
     TNode ttrf = getTaylorVariable();
@@ -177,6 +189,7 @@ std::uint64_t TaylorGenerator::getPolynomialApproximationBoundForArg(
       getPolynomialApproximationBounds(k, ds, pboundss);
       pbounds.d_upperPos = pboundss.d_upperPos;
     }
+    d_arg_degree[key] = ds;
     return ds;
   }
   return d;
@@ -205,13 +218,20 @@ std::pair<Node, Node> TaylorGenerator::getTfModelBounds(Node tf,
     return std::pair<Node, Node>(one, one);
   }
   bool isNeg = csign == -1;
+  PointKey key(k, c, d);
+  std::map<PointKey, std::pair<Node, Node>>::iterator itb =
+      d_model_bounds.find(key);
+  if (itb != d_model_bounds.end())
+  {
+    return itb->second;
+  }
 
   ApproximationBounds pbounds;
   getPolynomialApproximationBoundForArg(k, c, d, pbounds);
 
   std::vector<Node> bounds;
   TNode tfv = getTaylorVariable();
-  TNode tfs = tf[0];
+  TNode tc = c;
   for (unsigned d2 = 0; d2 < 2; d2++)
   {
     Node pab = (d2 == 0 ? pbounds.d_lower
@@ -224,9 +244,8 @@ std::pair<Node, Node> TaylorGenerator::getTfModelBounds(Node tf,
       // rewrite( x*x { x -> M_A(t) } ) = M_A(t)*M_A(t)
       // is not equal to
       // M_A( x*x { x -> t } ) = M_A( t*t )
-      // where M_A denotes the abstract model.
-      Node mtfs = model.computeAbstractModelValue(tfs);
-      pab = pab.substitute(tfv, mtfs);
+      // where M_A denotes the abstract model. This value is c.
+      pab = pab.substitute(tfv, tc);
       pab = Rewriter::rewrite(pab);
       Assert(pab.isConst());
       bounds.push_back(pab);
@@ -236,7 +255,9 @@ std::pair<Node, Node> TaylorGenerator::getTfModelBounds(Node tf,
       bounds.push_back(Node::null());
     }
   }
-  return std::pair<Node, Node>(bounds[0], bounds[1]);
+  std::pair<Node, Node> res(bounds[0], bounds[1]);
+  d_model_bounds[key] = res;
+  return res;
 }
 
 }  // namespace transcendental
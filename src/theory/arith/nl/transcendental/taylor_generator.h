@@ -15,6 +15,9 @@
 #ifndef CVC4__THEORY__ARITH__NL__TRANSCENDENTAL__TAYLOR_GENERATOR_H
 #define CVC4__THEORY__ARITH__NL__TRANSCENDENTAL__TAYLOR_GENERATOR_H
 
+#include <map>
+#include <tuple>
+
 #include "expr/node.h"
 
 namespace cvc5 {
@@ -88,6 +91,8 @@ class TaylorGenerator
    * d' >= d such that (1-c^{2*d'+1}/(2*d'+1)!) is positive.
    * @return the actual degree of the polynomial approximations (which may be
    * larger than d).
+   *
+   * The actual degree is cached for each (k,c,d).
    */
   std::uint64_t getPolynomialApproximationBoundForArg(
       Kind k, Node c, std::uint64_t d, ApproximationBounds& pbounds);
@@ -97,6 +102,9 @@ class TaylorGenerator
    * This returns the current lower and upper bounds of transcendental
    * function application tf based on Taylor of degree 2*d, which is dependent
    * on the model value of its argument.
+   *
+   * The bounds are cached for each (k,c,d), where c is the model value of the
+   * argument of tf.
    */
   std::pair<Node, Node> getTfModelBounds(Node tf,
                                          std::uint64_t d,
@@ -112,6 +120,12 @@ class TaylorGenerator
    */
   std::map<Kind, std::map<std::uint64_t, std::pair<Node, Node>>> d_taylor_terms;
   std::map<Kind, std::map<std::uint64_t, ApproximationBounds>> d_poly_bounds;
+  /** The key of the caches below, (k,c,d) for <k>( c ) and degree d */
+  using PointKey = std::tuple<Kind, Node, std::uint64_t>;
+  /** The actual degrees computed by getPolynomialApproximationBoundForArg */
+  std::map<PointKey, std::uint64_t> d_arg_degree;
+  /** The bounds computed by getTfModelBounds */
+  std::map<PointKey, std::pair<Node, Node>> d_model_bounds;
 };
 
 }  // namespace transcendental
@@ -226,18 +226,49 @@ void TranscendentalSolver::checkTranscendentalTangentPlanes()
     {
       // tf is Figure 3 : tf( x )
       Trace("nl-ext-tftp") << "Compute tangent planes " << tf << std::endl;
+      unsigned dstart = 1;
+      bool adapt = options::nlExtTfTaylorAdapt();
+      Rational c;
+      Rational gap;
+      std::unordered_map<Node, RefineInfo, NodeHashFunction>::iterator itr =
+          d_tf_refine.end();
+      if (adapt)
+      {
+        c = d_tstate.d_model.computeAbstractModelValue(tf[0])
+                .getConst<Rational>();
+        itr = d_tf_refine.find(tf);
+        if (itr != d_tf_refine.end())
+        {
+          gap = (c - itr->second.d_arg).abs();
+          if (itr->second.d_hasGap && gap < itr->second.d_gap)
+          {
+            dstart = std::min(itr->second.d_degree, d_taylor_degree);
+            Trace("nl-ext-tftp") << "- gap " << gap << " decreased, start at "
+                                 << "degree " << dstart << std::endl;
+          }
+        }
+      }
       // go until max degree is reached, or we don't meet bound criteria
-      for (unsigned d = 1; d <= d_taylor_degree; d++)
+      for (unsigned d = dstart; d <= d_taylor_degree; d++)
       {
         Trace("nl-ext-tftp") << "- run at degree " << d << "..." << std::endl;
         unsigned prev =
             d_tstate.d_im.numPendingLemmas() + d_tstate.d_im.numWaitingLemmas();
         if (checkTfTangentPlanesFun(tf, d))
         {
-          Trace("nl-ext-tftp") << "...fail, #lemmas = "
-                               << (d_tstate.d_im.numPendingLemmas()
-                                   + d_tstate.d_im.numWaitingLemmas() - prev)
+          unsigned nlemmas = d_tstate.d_im.numPendingLemmas()
+                             + d_tstate.d_im.numWaitingLemmas() - prev;
+          Trace("nl-ext-tftp") << "...fail, #lemmas = " << nlemmas
                                << std::endl;
+          if (adapt && nlemmas > 0)
+          {
+            bool hasGap = itr != d_tf_refine.end();
+            RefineInfo& ri = d_tf_refine[tf];
+            ri.d_hasGap = hasGap;
+            ri.d_gap = gap;
+            ri.d_arg = c;
+            ri.d_degree = d;
+          }
           break;
         }
         else
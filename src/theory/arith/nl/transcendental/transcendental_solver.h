@@ -15,12 +15,14 @@
 #ifndef CVC4__THEORY__ARITH__NL__TRANSCENDENTAL__TRANSCENDENTAL_SOLVER_H
 #define CVC4__THEORY__ARITH__NL__TRANSCENDENTAL__TRANSCENDENTAL_SOLVER_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "expr/node.h"
 #include "theory/arith/nl/transcendental/exponential_solver.h"
 #include "theory/arith/nl/transcendental/sine_solver.h"
 #include "theory/arith/nl/transcendental/transcendental_state.h"
+#include "util/rational.h"
 
 namespace cvc5 {
 namespace theory {
@@ -188,6 +190,27 @@ class TranscendentalSolver
    */
   unsigned d_taylor_degree;
 
+  /** Information about the last tangent plane refinement of a term */
+  struct RefineInfo
+  {
+    /** The model value of the argument of the term */
+    Rational d_arg;
+    /** Whether the term was refined before, in which case d_gap is set */
+    bool d_hasGap = false;
+    /** The distance of d_arg to the argument value of the refinement before */
+    Rational d_gap;
+    /** The degree at which the refinement lemma was sent */
+    unsigned d_degree = 1;
+  };
+  /**
+   * Maps master terms to their last tangent plane refinement. If
+   * options::nlExtTfTaylorAdapt() is enabled and the gap between the model
+   * values of the argument of a term decreases, the lower degrees were refined
+   * around nearly the same point already and will likely not give new lemmas,
+   * hence checkTranscendentalTangentPlanes starts at the last degree.
+   */
+  std::unordered_map<Node, RefineInfo, NodeHashFunction> d_tf_refine;
+
   /** Common state for transcendental solver */
   transcendental::TranscendentalState d_tstate;
   /** The solver responsible for the exponential function */
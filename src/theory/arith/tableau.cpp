@@ -15,6 +15,8 @@
  ** \todo document this file
  **/
 
+#include <algorithm>
+
 #include "base/output.h"
 #include "theory/arith/tableau.h"
 
@@ -62,6 +64,21 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
   Assert(!isBasic(oldBasic));
   Assert(isBasic(newBasic));
   Assert(getColLength(newBasic) == 1);
+
+  ++d_pivotsSinceCompaction;
+}
+
+bool Tableau::compactIfScattered(){
+  // a pivot reallocates the entries of the rows of the entering column, so
+  // wait for about one pivot per row before paying for a compaction
+  if(d_pivotsSinceCompaction < std::max<size_t>(getNumRows(), 64)){
+    return false;
+  }
+  Debug("tableau") << "Tableau::compactIfScattered() " << size() << " entries"
+                   << " after " << d_pivotsSinceCompaction << " pivots" << endl;
+  compact();
+  d_pivotsSinceCompaction = 0;
+  return true;
 }
 
 /**
@@ -143,6 +160,7 @@ void Tableau::addRow(ArithVar basic,
   Assert(debugNoZeroCoefficients(newRow));
   Assert(debugMatchingCountsForRow(newRow));
   Assert(getColLength(basic) == 1);
+  ++d_rowSetVersion;
 }
 
 void Tableau::removeBasicRow(ArithVar basic){
@@ -151,6 +169,7 @@ void Tableau::removeBasicRow(ArithVar basic){
   removeRow(rid);
   d_basic2RowIndex.remove(basic);
   d_rowIndex2basic.remove(rid);
+  ++d_rowSetVersion;
 }
 
 void Tableau::substitutePlusTimesConstant(ArithVar to, ArithVar from, const Rational& mult,  CoefficientChangeCallback& cb){
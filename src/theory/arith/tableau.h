@@ -48,9 +48,19 @@ private:
   typedef DenseMap<ArithVar> RowIndexToBasicMap;
   RowIndexToBasicMap d_rowIndex2basic;
 
+  /* The number of pivots since the last compaction of the matrix. */
+  uint32_t d_pivotsSinceCompaction;
+
+  /* Incremented each time a row is added or removed. */
+  uint64_t d_rowSetVersion;
+
 public:
 
-  Tableau() : Matrix<Rational>(Rational(0)) {}
+  Tableau()
+    : Matrix<Rational>(Rational(0)),
+      d_pivotsSinceCompaction(0),
+      d_rowSetVersion(0)
+  {}
 
   typedef Matrix<Rational>::ColIterator ColIterator;
   typedef Matrix<Rational>::RowIterator RowIterator;
@@ -127,6 +137,20 @@ public:
 
   void removeBasicRow(ArithVar basic);
 
+  /**
+   * Returns a number that changes each time a row is added or removed.
+   * Pivots do not change the set of rows (up to a change of basis).
+   */
+  uint64_t getRowSetVersion() const { return d_rowSetVersion; }
+
+  /**
+   * Compacts the matrix if enough pivots were done since the last compaction
+   * for the entries of the rows to be scattered in memory.
+   * Returns true if the matrix was compacted, in which case all of the
+   * iterators and references to entries are invalidated.
+   */
+  bool compactIfScattered();
+
   uint32_t basicRowLength(ArithVar basic) const{
     RowIndex ridx = basicToRowIndex(basic);
     return getRowLength(ridx);
@@ -17,6 +17,7 @@
 
 #include "theory/arith/theory_arith_private.h"
 
+#include <limits>
 #include <map>
 #include <queue>
 #include <vector>
@@ -53,6 +54,7 @@
 #include "theory/arith/cut_log.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/dio_solver.h"
+#include "theory/arith/float_simplex.h"
 #include "theory/arith/linear_equality.h"
 #include "theory/arith/matrix.h"
 #include "theory/arith/nl/nonlinear_extension.h"
@@ -147,6 +149,9 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
           d_linEq, d_errorSet, RaiseConflict(*this), TempVarMalloc(*this)),
       d_attemptSolSimplex(
           d_linEq, d_errorSet, RaiseConflict(*this), TempVarMalloc(*this)),
+      d_lastFeasible(),
+      d_lastFeasibleRowSet(std::numeric_limits<uint64_t>::max()),
+      d_tryLastFeasible(false),
       d_pass1SDP(NULL),
       d_otherSDP(NULL),
       d_lastContextIntegerAttempted(c, -1),
@@ -329,6 +334,15 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_solveIntModelsSuccessful("theory::arith::zzz::solveInt::models::successful", 0)
   , d_mipTimer("theory::arith::z::approx::mip::timer")
   , d_lpTimer("theory::arith::z::approx::lp::timer")
+  , d_floatCalls("theory::arith::float::calls", 0)
+  , d_floatPivots("theory::arith::float::pivots", 0)
+  , d_floatSuccesses("theory::arith::float::successes", 0)
+  , d_floatTimer("theory::arith::float::timer")
+  , d_int64Calls("theory::arith::float::int64Calls", 0)
+  , d_int64Overflows("theory::arith::float::int64Overflows", 0)
+  , d_tableauCompactions("theory::arith::tableau::compactions", 0)
+  , d_warmStartCalls("theory::arith::warmStart::calls", 0)
+  , d_warmStartSuccesses("theory::arith::warmStart::successes", 0)
   , d_mipProofsAttempted("theory::arith::z::mip::proofs::attempted", 0)
   , d_mipProofsSuccessful("theory::arith::z::mip::proofs::successful", 0)
   , d_numBranchesFailed("theory::arith::z::mip::branch::proof::failed", 0)
@@ -420,6 +434,15 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_solveIntModelsSuccessful);
   smtStatisticsRegistry()->registerStat(&d_mipTimer);
   smtStatisticsRegistry()->registerStat(&d_lpTimer);
+  smtStatisticsRegistry()->registerStat(&d_floatCalls);
+  smtStatisticsRegistry()->registerStat(&d_floatPivots);
+  smtStatisticsRegistry()->registerStat(&d_floatSuccesses);
+  smtStatisticsRegistry()->registerStat(&d_floatTimer);
+  smtStatisticsRegistry()->registerStat(&d_int64Calls);
+  smtStatisticsRegistry()->registerStat(&d_int64Overflows);
+  smtStatisticsRegistry()->registerStat(&d_tableauCompactions);
+  smtStatisticsRegistry()->registerStat(&d_warmStartCalls);
+  smtStatisticsRegistry()->registerStat(&d_warmStartSuccesses);
   smtStatisticsRegistry()->registerStat(&d_mipProofsAttempted);
   smtStatisticsRegistry()->registerStat(&d_mipProofsSuccessful);
   smtStatisticsRegistry()->registerStat(&d_numBranchesFailed);
@@ -514,6 +537,15 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_solveIntModelsSuccessful);
   smtStatisticsRegistry()->unregisterStat(&d_mipTimer);
   smtStatisticsRegistry()->unregisterStat(&d_lpTimer);
+  smtStatisticsRegistry()->unregisterStat(&d_floatCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_floatPivots);
+  smtStatisticsRegistry()->unregisterStat(&d_floatSuccesses);
+  smtStatisticsRegistry()->unregisterStat(&d_floatTimer);
+  smtStatisticsRegistry()->unregisterStat(&d_int64Calls);
+  smtStatisticsRegistry()->unregisterStat(&d_int64Overflows);
+  smtStatisticsRegistry()->unregisterStat(&d_tableauCompactions);
+  smtStatisticsRegistry()->unregisterStat(&d_warmStartCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_warmStartSuccesses);
   smtStatisticsRegistry()->unregisterStat(&d_mipProofsAttempted);
   smtStatisticsRegistry()->unregisterStat(&d_mipProofsSuccessful);
   smtStatisticsRegistry()->unregisterStat(&d_numBranchesFailed);
@@ -1090,6 +1122,10 @@ void TheoryArithPrivate::notifySharedTerm(TNode n)
   if(n.isConst()){
     d_partialModel.invalidateDelta();
   }
+  if (d_cmEnabled)
+  {
+    d_congruenceManager.notifySharedTerm(n);
+  }
   if(!n.isConst() && !isSetup(n)){
     Polynomial poly = Polynomial::parsePolynomial(n);
     Polynomial::iterator it = poly.begin();
@@ -1821,6 +1857,36 @@ ArithVar TheoryArithPrivate::nextIntegerViolation(bool assumeBounds) const
   return ARITHVAR_SENTINEL;
 }
 
+ArithVar TheoryArithPrivate::mostFractionalViolation() const
+{
+  ArithVar numVars = d_partialModel.getNumberOfVariables();
+  ArithVar best = ARITHVAR_SENTINEL;
+  Rational bestDist;
+  if (numVars > 0)
+  {
+    ArithVar v = d_nextIntegerCheckVar;
+    const ArithVar rrEnd = d_nextIntegerCheckVar;
+    do
+    {
+      if (isIntegerInput(v) && !d_partialModel.integralAssignment(v))
+      {
+        // the distance of the real part to the nearest integer, which is 0
+        // when the assignment is only off an integer by an infinitesimal
+        const DeltaRational& d = d_partialModel.getAssignment(v);
+        Rational f = d.getNoninfinitesimalPart().floor_frac();
+        Rational dist = std::min(f, Rational(1) - f);
+        if (best == ARITHVAR_SENTINEL || dist > bestDist)
+        {
+          best = v;
+          bestDist = dist;
+        }
+      }
+      v = (1 + v == numVars) ? 0 : (1 + v);
+    } while (v != rrEnd);
+  }
+  return best;
+}
+
 /**
  * Checks the set of integer variables I to see if each variable
  * in I has an integer assignment.
@@ -3064,6 +3130,129 @@ bool TheoryArithPrivate::solveRelaxationOrPanic(Theory::Effort effortLevel)
   return false;
 }
 
+bool TheoryArithPrivate::solveFloatRelaxation()
+{
+  if (d_errorSet.errorEmpty() && d_errorSet.noSignals())
+  {
+    // nothing to repair, the exact simplex is cheap
+    return false;
+  }
+  static const int32_t floatPivotLimit = 10000;
+  TimerStat::CodeTimer codeTimer(d_statistics.d_floatTimer);
+  ++d_statistics.d_floatCalls;
+
+  LinResult res = LinUnknown;
+  ApproximateSimplex::Solution sol;
+  if (options::arithInt64Simplex())
+  {
+    ++d_statistics.d_int64Calls;
+    Int64Simplex int64Simplex(d_partialModel, d_tableau);
+    int64Simplex.setPivotLimit(floatPivotLimit);
+    res = int64Simplex.solve();
+    d_statistics.d_floatPivots += int64Simplex.getPivots();
+    Debug("arith::float") << "solveFloatRelaxation() int64 " << res
+                          << " after " << int64Simplex.getPivots()
+                          << " pivots" << endl;
+    if (res == LinFeasible || res == LinInfeasible)
+    {
+      sol = int64Simplex.extractSolution();
+    }
+    else if (res == LinUnknown)
+    {
+      ++d_statistics.d_int64Overflows;
+    }
+  }
+  if (res == LinUnknown)
+  {
+    // a number did not fit in 64 bits, or the option is off
+    FloatSimplex floatSimplex(d_partialModel, d_tableau);
+    floatSimplex.setPivotLimit(floatPivotLimit);
+    res = floatSimplex.solve();
+    d_statistics.d_floatPivots += floatSimplex.getPivots();
+    Debug("arith::float") << "solveFloatRelaxation() " << res << " after "
+                          << floatSimplex.getPivots() << " pivots" << endl;
+    if (res == LinFeasible || res == LinInfeasible)
+    {
+      sol = floatSimplex.extractSolution();
+    }
+  }
+  if (res != LinFeasible && res != LinInfeasible)
+  {
+    return false;
+  }
+  // the exact simplex verifies the guess, and finds the conflict if any
+  importSolution(sol);
+  if (d_qflraStatus == Result::SAT_UNKNOWN)
+  {
+    return false;
+  }
+  ++d_statistics.d_floatSuccesses;
+  return true;
+}
+
+void TheoryArithPrivate::saveLastFeasible()
+{
+  d_lastFeasible.newBasis.purge();
+  d_lastFeasible.newValues.purge();
+  for (Tableau::BasicIterator i = d_tableau.beginBasic(),
+                              i_end = d_tableau.endBasic();
+       i != i_end;
+       ++i)
+  {
+    d_lastFeasible.newBasis.add(*i);
+  }
+  for (var_iterator vi = var_begin(), vend = var_end(); vi != vend; ++vi)
+  {
+    d_lastFeasible.newValues.set(*vi, d_partialModel.getAssignment(*vi));
+  }
+  d_lastFeasibleRowSet = d_tableau.getRowSetVersion();
+}
+
+bool TheoryArithPrivate::solveFromLastFeasible()
+{
+  if (d_lastFeasibleRowSet != d_tableau.getRowSetVersion()
+      || (d_errorSet.errorEmpty() && d_errorSet.noSignals()))
+  {
+    return false;
+  }
+  ++d_statistics.d_warmStartCalls;
+
+  // the nonbasic variables have to be assigned in their current bounds
+  ApproximateSimplex::Solution sol;
+  sol.newBasis = d_lastFeasible.newBasis;
+  for (var_iterator vi = var_begin(), vend = var_end(); vi != vend; ++vi)
+  {
+    ArithVar v = *vi;
+    if (!d_lastFeasible.newValues.isKey(v))
+    {
+      sol.newValues.set(v, d_partialModel.getAssignment(v));
+      continue;
+    }
+    const DeltaRational& value = d_lastFeasible.newValues[v];
+    if (d_partialModel.strictlyLessThanLowerBound(v, value))
+    {
+      sol.newValues.set(v, d_partialModel.getLowerBound(v));
+    }
+    else if (d_partialModel.strictlyGreaterThanUpperBound(v, value))
+    {
+      sol.newValues.set(v, d_partialModel.getUpperBound(v));
+    }
+    else
+    {
+      sol.newValues.set(v, value);
+    }
+  }
+  importSolution(sol);
+  Debug("arith::warmStart") << "solveFromLastFeasible() " << d_qflraStatus
+                            << endl;
+  if (d_qflraStatus == Result::SAT_UNKNOWN)
+  {
+    return false;
+  }
+  ++d_statistics.d_warmStartSuccesses;
+  return true;
+}
+
 bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
   TimerStat::CodeTimer codeTimer0(d_statistics.d_solveRealRelaxTimer);
   Assert(d_qflraStatus != Result::SAT);
@@ -3073,6 +3262,11 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
   d_partialModel.processBoundsQueue(utcb);
   d_linEq.startTrackingBoundCounts();
 
+  // no entries of the tableau are referenced between two calls to simplex
+  if(d_tableau.compactIfScattered()){
+    ++(d_statistics.d_tableauCompactions);
+  }
+
   bool noPivotLimit = Theory::fullEffort(effortLevel) ||
     !options::restrictedPivots();
 
@@ -3089,7 +3283,14 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
     << endl;
 
   bool noPivotLimitPass1 = noPivotLimit && !useApprox;
-  d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  // the last feasible basis is only tried once per query
+  bool warmStarted = d_tryLastFeasible && solveFromLastFeasible();
+  d_tryLastFeasible = false;
+  if (!warmStarted
+      && (!options::arithFloatSimplex() || !solveFloatRelaxation()))
+  {
+    d_qflraStatus = simplex.findModel(noPivotLimitPass1);
+  }
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
@@ -3158,6 +3359,12 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
 
   bool emmittedConflictOrSplit = solveRelaxationOrPanic(effortLevel);
 
+  if (options::arithWarmStart() && d_qflraStatus == Result::SAT
+      && Theory::fullEffort(effortLevel) && !anyConflict())
+  {
+    saveLastFeasible();
+  }
+
   // TODO Save zeroes with no conflicts
   d_linEq.stopTrackingBoundCounts();
   d_partialModel.startQueueingBoundCounts();
@@ -3622,6 +3829,17 @@ bool TheoryArithPrivate::postCheck(Theory::Effort effortLevel)
         outputConflicts();
         emmittedConflictOrSplit = true;
       }
+      else if (options::dioSolverSubs())
+      {
+        while (d_diosolver.hasMorePureSubstitutions())
+        {
+          Node subLemma = d_diosolver.nextPureSubstitution();
+          Debug("arith::lemma") << "dio substitution lemma " << subLemma
+                                << endl;
+          outputLemma(subLemma, InferenceId::ARITH_DIO_SUBSTITUTION);
+          emmittedConflictOrSplit = true;
+        }
+      }
     }
 
     if(!emmittedConflictOrSplit && d_hasDoneWorkSinceCut && options::arithDioSolver()){
@@ -3837,7 +4055,10 @@ TrustNode TheoryArithPrivate::roundRobinBranch()
   if(hasIntegerModel()){
     return TrustNode::null();
   }else{
-    ArithVar v = d_nextIntegerCheckVar;
+    ArithVar v = options::arithBranchVarMode()
+                         == options::ArithBranchVarMode::MOST_FRACTIONAL
+                     ? mostFractionalViolation()
+                     : d_nextIntegerCheckVar;
 
     Assert(isInteger(v));
     Assert(!isAuxiliaryVariable(v));
@@ -4329,6 +4550,8 @@ bool TheoryArithPrivate::unenqueuedVariablesAreConsistent(){
 void TheoryArithPrivate::presolve(){
   TimerStat::CodeTimer codeTimer(d_statistics.d_presolveTime);
 
+  d_tryLastFeasible = options::arithWarmStart();
+
   d_statistics.d_initialTableauSize.set(d_tableau.size());
 
   if(Debug.isOn("paranoid:check_tableau")){ d_linEq.debugCheckTableau(); }
@@ -4549,13 +4772,14 @@ void TheoryArithPrivate::propagateCandidatesNew(){
 
   Assert(d_qflraStatus == Result::SAT);
   if(d_updatedBounds.empty()){ return; }
-  dumpUpdatedBoundsToRows();
-  Assert(d_updatedBounds.empty());
-
-  if(!d_candidateRows.empty()){
+  // bring the bound counts of the rows up to date, so that only the rows
+  // that can imply a bound become candidates
+  {
     UpdateTrackingCallback utcb(&d_linEq);
     d_partialModel.processBoundsQueue(utcb);
   }
+  dumpUpdatedBoundsToRows();
+  Assert(d_updatedBounds.empty());
 
   while(!d_candidateRows.empty()){
     RowIndex candidate = d_candidateRows.back();
@@ -4861,21 +5085,33 @@ bool TheoryArithPrivate::propagateCandidateRow(RowIndex ridx){
   return success;
 }
 
+bool TheoryArithPrivate::rowMightPropagate(RowIndex ridx) const{
+  BoundCounts hasCount = d_linEq.hasBoundCount(ridx);
+  uint32_t rowLength = d_tableau.getRowLength(ridx);
+  return hasCount.lowerBoundCount() + 1 >= rowLength
+         || hasCount.upperBoundCount() + 1 >= rowLength;
+}
+
 void TheoryArithPrivate::dumpUpdatedBoundsToRows(){
   Assert(d_candidateRows.empty());
+  Assert(d_partialModel.boundsQueueEmpty());
   DenseSet::const_iterator i = d_updatedBounds.begin();
   DenseSet::const_iterator end = d_updatedBounds.end();
   for(; i != end; ++i){
     ArithVar var = *i;
     if(d_tableau.isBasic(var)){
       RowIndex ridx = d_tableau.basicToRowIndex(var);
-      d_candidateRows.softAdd(ridx);
+      if(rowMightPropagate(ridx)){
+        d_candidateRows.softAdd(ridx);
+      }
     }else{
       Tableau::ColIterator basicIter = d_tableau.colIterator(var);
       for(; !basicIter.atEnd(); ++basicIter){
         const Tableau::Entry& entry = *basicIter;
         RowIndex ridx = entry.getRowIndex();
-        d_candidateRows.softAdd(ridx);
+        if(rowMightPropagate(ridx)){
+          d_candidateRows.softAdd(ridx);
+        }
       }
     }
   }
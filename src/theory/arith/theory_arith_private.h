@@ -387,6 +387,30 @@ private:
   AttemptSolutionSDP d_attemptSolSimplex;
 
   bool solveRealRelaxation(Theory::Effort effortLevel);
+  /**
+   * Guess the basis of a solution or a conflict using Int64Simplex (with
+   * --arith-int64-simplex) or FloatSimplex, and import it. Returns true if
+   * this determined d_qflraStatus.
+   */
+  bool solveFloatRelaxation();
+
+  /**
+   * The basis and the assignment at the last full effort check where the
+   * real relaxation was satisfiable, see --arith-warm-start.
+   */
+  ApproximateSimplex::Solution d_lastFeasible;
+  /** The row set version of the tableau when d_lastFeasible was saved */
+  uint64_t d_lastFeasibleRowSet;
+  /** Whether d_lastFeasible is to be tried in the current query */
+  bool d_tryLastFeasible;
+  /** Save the current basis and assignment in d_lastFeasible */
+  void saveLastFeasible();
+  /**
+   * Import the basis of d_lastFeasible, with its assignment moved in the
+   * current bounds, if the tableau still has the same rows. Returns true if
+   * this determined d_qflraStatus.
+   */
+  bool solveFromLastFeasible();
 
   /* Returns true if this is heuristically a good time to try
    * to solve the integers.
@@ -553,6 +577,14 @@ private:
    */
   ArithVar nextIntegerViolation(bool assumeBounds) const;
 
+  /**
+   * Returns the integer variable whose assignment is the farthest from an
+   * integer, ties being broken by the order of nextIntegerViolation().
+   * If every integer variable has an integer assignment, returns
+   * ARITHVAR_SENTINEL.
+   */
+  ArithVar mostFractionalViolation() const;
+
   /**
    * Issues branches for non-auxiliary integer variables with non-integer assignments.
    * Returns a cut for a lemma.
@@ -618,7 +650,17 @@ private:
   void revertOutOfConflict();
 
   void propagateCandidatesNew();
+  /**
+   * Moves the rows of the variables in d_updatedBounds that might imply a
+   * bound to d_candidateRows. The bounds queue must be empty.
+   */
   void dumpUpdatedBoundsToRows();
+  /**
+   * Whether the row ridx might imply a bound, i.e. it has at most one
+   * variable without a bound in one of the directions. This is O(1) using
+   * the bound counts of the rows maintained by d_linEq.
+   */
+  bool rowMightPropagate(RowIndex ridx) const;
   bool propagateCandidateRow(RowIndex rid);
   bool propagateMightSucceed(ArithVar v, bool ub) const;
   /** Attempt to perform a row propagation where there is at most 1 possible variable.*/
@@ -869,6 +911,18 @@ private:
     TimerStat d_mipTimer;
     TimerStat d_lpTimer;
 
+    IntStat d_floatCalls;
+    IntStat d_floatPivots;
+    IntStat d_floatSuccesses;
+    TimerStat d_floatTimer;
+    IntStat d_int64Calls;
+    IntStat d_int64Overflows;
+
+    IntStat d_tableauCompactions;
+
+    IntStat d_warmStartCalls;
+    IntStat d_warmStartSuccesses;
+
     IntStat d_mipProofsAttempted;
     IntStat d_mipProofsSuccessful;
 
@@ -31,7 +31,10 @@ Info::Info(context::Context* c, Backtracker<TNode>* bck)
       weakEquivPointer(c,TNode()),
       weakEquivIndex(c,TNode()),
       weakEquivSecondary(c,TNode()),
-      weakEquivSecondaryReason(c,TNode())
+      weakEquivSecondaryReason(c,TNode()),
+      indexSet(c),
+      storeSet(c),
+      inStoreSet(c)
 {
   indices = new(true)CTNodeList(c);
   stores = new(true)CTNodeList(c);
@@ -116,19 +119,23 @@ void printList (List<TNode>* list) {
   Trace("arrays-info")<<"] \n";
 }
 
-void ArrayInfo::mergeLists(CTNodeList* la, const CTNodeList* lb) const{
-  std::set<TNode> temp;
-  CTNodeList::const_iterator it;
-  for (it = la->begin(); it != la->end(); ++it)
+/** Add n to the list l whose set of elements is s, if it is not in it */
+static void addToList(CTNodeList* l, CNodeSet& s, TNode n)
+{
+  if (s.insert(n))
   {
-    temp.insert((*it));
+    l->push_back(n);
   }
+}
 
+void ArrayInfo::mergeLists(CTNodeList* la,
+                           CNodeSet& sa,
+                           const CTNodeList* lb) const
+{
+  CTNodeList::const_iterator it;
   for (it = lb->begin(); it != lb->end(); ++it)
   {
-    if(temp.count(*it) == 0) {
-      la->push_back(*it);
-    }
+    addToList(la, sa, *it);
   }
 }
 
@@ -143,15 +150,12 @@ void ArrayInfo::addIndex(const Node a, const TNode i) {
   CNodeInfoMap::iterator it = info_map.find(a);
   if(it == info_map.end()) {
     temp_info = new Info(ct, bck);
-    temp_indices = temp_info->indices;
-    temp_indices->push_back(i);
     info_map[a] = temp_info;
   } else {
-    temp_indices = (*it).second->indices;
-    if (! inList(temp_indices, i)) {
-      temp_indices->push_back(i);
-    }
+    temp_info = (*it).second;
   }
+  temp_indices = temp_info->indices;
+  addToList(temp_indices, temp_info->indexSet, i);
   if(Trace.isOn("arrays-ind")) {
     printList((*(info_map.find(a))).second->indices);
   }
@@ -168,15 +172,12 @@ void ArrayInfo::addStore(const Node a, const TNode st){
   CNodeInfoMap::iterator it = info_map.find(a);
   if(it == info_map.end()) {
     temp_info = new Info(ct, bck);
-    temp_store = temp_info->stores;
-    temp_store->push_back(st);
     info_map[a]=temp_info;
   } else {
-    temp_store = (*it).second->stores;
-    if(! inList(temp_store, st)) {
-      temp_store->push_back(st);
-    }
+    temp_info = (*it).second;
   }
+  temp_store = temp_info->stores;
+  addToList(temp_store, temp_info->storeSet, st);
 };
 
 
@@ -191,15 +192,12 @@ void ArrayInfo::addInStore(const TNode a, const TNode b){
   CNodeInfoMap::iterator it = info_map.find(a);
   if(it == info_map.end()) {
     temp_info = new Info(ct, bck);
-    temp_inst = temp_info->in_stores;
-    temp_inst->push_back(b);
     info_map[a] = temp_info;
   } else {
-    temp_inst = (*it).second->in_stores;
-    if(! inList(temp_inst, b)) {
-      temp_inst->push_back(b);
-    }
+    temp_info = (*it).second;
   }
+  temp_inst = temp_info->in_stores;
+  addToList(temp_inst, temp_info->inStoreSet, b);
 };
 
 
@@ -458,9 +456,10 @@ void ArrayInfo::mergeInfo(const TNode a, const TNode b){
       CTNodeList* listb_st = (*itb).second->stores;
       CTNodeList* listb_inst = (*itb).second->in_stores;
 
-      mergeLists(lista_i, listb_i);
-      mergeLists(lista_st, listb_st);
-      mergeLists(lista_inst, listb_inst);
+      Info* infoa = (*ita).second;
+      mergeLists(lista_i, infoa->indexSet, listb_i);
+      mergeLists(lista_st, infoa->storeSet, listb_st);
+      mergeLists(lista_inst, infoa->inStoreSet, listb_inst);
 
       /* sketchy stats */
 
@@ -503,9 +502,9 @@ void ArrayInfo::mergeInfo(const TNode a, const TNode b){
 
       Info* temp_info = new Info(ct, bck);
 
-      mergeLists(temp_info->indices, listb_i);
-      mergeLists(temp_info->stores, listb_st);
-      mergeLists(temp_info->in_stores, listb_inst);
+      mergeLists(temp_info->indices, temp_info->indexSet, listb_i);
+      mergeLists(temp_info->stores, temp_info->storeSet, listb_st);
+      mergeLists(temp_info->in_stores, temp_info->inStoreSet, listb_inst);
       info_map[a] = temp_info;
 
     } else {
@@ -22,6 +22,7 @@
 #include <unordered_map>
 
 #include "context/backtrackable.h"
+#include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "util/statistics_registry.h"
@@ -32,6 +33,7 @@ namespace theory {
 namespace arrays {
 
 typedef context::CDList<TNode> CTNodeList;
+typedef context::CDHashSet<Node, NodeHashFunction> CNodeSet;
 using RowLemmaType = std::tuple<TNode, TNode, TNode, TNode>;
 
 struct RowLemmaTypeHashFunction {
@@ -68,6 +70,13 @@ public:
   CTNodeList* indices;
   CTNodeList* stores;
   CTNodeList* in_stores;
+  /**
+   * The elements of the above lists, so that adding to them and merging them
+   * does not scan them, which is linear in the length of the store chains.
+   */
+  CNodeSet indexSet;
+  CNodeSet storeSet;
+  CNodeSet inStoreSet;
 
   Info(context::Context* c, Backtracker<TNode>* bck);
   ~Info();
@@ -125,9 +134,9 @@ private:
 
   /**
    * helper method that merges two lists into the first
-   * without adding duplicates
+   * without adding duplicates, where sa is the set of elements of la
    */
-  void mergeLists(CTNodeList* la, const CTNodeList* lb) const;
+  void mergeLists(CTNodeList* la, CNodeSet& sa, const CTNodeList* lb) const;
 
 public:
   const Info* emptyInfo;
@@ -79,6 +79,8 @@ TheoryArrays::TheoryArrays(context::Context* c,
           name + "theory::arrays::number of setModelVal splits", 0),
       d_numSetModelValConflicts(
           name + "theory::arrays::number of setModelVal conflicts", 0),
+      d_numRowModelViolations(
+          name + "theory::arrays::number of violated Row model paths", 0),
       d_ppEqualityEngine(u, name + "theory::arrays::pp", true),
       d_ppFacts(u),
       d_state(c, u, valuation),
@@ -123,6 +125,7 @@ TheoryArrays::TheoryArrays(context::Context* c,
   smtStatisticsRegistry()->registerStat(&d_numGetModelValConflicts);
   smtStatisticsRegistry()->registerStat(&d_numSetModelValSplits);
   smtStatisticsRegistry()->registerStat(&d_numSetModelValConflicts);
+  smtStatisticsRegistry()->registerStat(&d_numRowModelViolations);
 
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
@@ -163,6 +166,7 @@ TheoryArrays::~TheoryArrays() {
   smtStatisticsRegistry()->unregisterStat(&d_numGetModelValConflicts);
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValSplits);
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValConflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_numRowModelViolations);
 }
 
 TheoryRewriter* TheoryArrays::getTheoryRewriter() { return &d_rewriter; }
@@ -1096,6 +1100,22 @@ bool TheoryArrays::collectModelValues(TheoryModel* m,
     }
   }
 
+  // With lazy read-over-write lemmas, the values of the arrays at the indices
+  // of the reads of the arrays weakly equivalent to them
+  RowModel rowModel;
+  if (options::arraysLazyRow())
+  {
+    std::vector<Node> reads;
+    for (const Node& n : termSet)
+    {
+      if (n.getKind() == kind::SELECT && d_equalityEngine->hasTerm(n))
+      {
+        reads.push_back(n);
+      }
+    }
+    computeRowModel(reads, nullptr, &rowModel);
+  }
+
   Node rep;
   DefValMap::iterator it;
   TypeSet defaultValuesSet;
@@ -1156,6 +1176,16 @@ bool TheoryArrays::collectModelValues(TheoryModel* m,
     }
 */
 
+    // Store the values propagated from the weakly equivalent arrays, which
+    // are overridden by the reads of this array
+    RowModel::const_iterator itr = rowModel.find(nrep);
+    if (itr != rowModel.end())
+    {
+      for (const std::pair<Node, Node>& iv : itr->second)
+      {
+        rep = nm->mkNode(kind::STORE, rep, iv.first, iv.second);
+      }
+    }
     // For each read, require that the rep stores the right value
     vector<Node>& reads = selects[nrep];
     for (unsigned j = 0; j < reads.size(); ++j) {
@@ -1315,12 +1345,20 @@ void TheoryArrays::postCheck(Effort level)
   if (!options::arraysEagerLemmas() && fullEffort(level)
       && !d_state.isInConflict() && !options::arraysWeakEquivalence())
   {
-    // generate the lemmas on the worklist
-    Trace("arrays-lem")<< "Arrays::discharging lemmas. Number of queued lemmas: " << d_RowQueue.size() << "\n";
-    while (d_RowQueue.size() > 0 && !d_state.isInConflict())
+    if (options::arraysLazyRow())
     {
-      if (dischargeLemmas()) {
-        break;
+      // generate only the lemmas violated by the model
+      checkRowModel();
+    }
+    else
+    {
+      // generate the lemmas on the worklist
+      Trace("arrays-lem")<< "Arrays::discharging lemmas. Number of queued lemmas: " << d_RowQueue.size() << "\n";
+      while (d_RowQueue.size() > 0 && !d_state.isInConflict())
+      {
+        if (dischargeLemmas()) {
+          break;
+        }
       }
     }
   }
@@ -1796,7 +1834,8 @@ void TheoryArrays::propagateRowLemma(RowLemmaType lem)
   // If propagating, check propagations
   int prop = options::arraysPropagate();
   if (prop > 0) {
-    if (d_equalityEngine->areDisequal(i, j, true) && (bothExist || prop > 1))
+    if (d_equalityEngine->areDisequal(i, j, true)
+        && (bothExist || (prop > 1 && !options::arraysLazyRow())))
     {
       Trace("arrays-lem") << spaces(getSatContext()->getLevel()) <<"Arrays::queueRowLemma: propagating aj = bj ("<<aj<<", "<<bj<<")\n";
       Node aj_eq_bj = aj.eqNode(bj);
@@ -1938,7 +1977,8 @@ void TheoryArrays::queueRowLemma(RowLemmaType lem)
         aj.eqNode(bj), InferenceId::ARRAYS_READ_OVER_WRITE, eq2.notNode(), PfRule::ARRAYS_READ_OVER_WRITE);
     ++d_numRow;
   }
-  else {
+  else if (!options::arraysLazyRow())
+  {
     d_RowQueue.push(lem);
   }
 }
@@ -1964,101 +2004,311 @@ bool TheoryArrays::dischargeLemmas()
     if (d_RowAlreadyAdded.contains(l)) {
       continue;
     }
+    if (!addRowLemma(l))
+    {
+      if (d_state.isInConflict())
+      {
+        return true;
+      }
+      continue;
+    }
+    lemmasAdded = true;
+    if (options::arraysReduceSharing()) {
+      return true;
+    }
+  }
+  return lemmasAdded;
+}
 
-    TNode a, b, i, j;
-    std::tie(a, b, i, j) = l;
-    Assert(a.getType().isArray() && b.getType().isArray());
+bool TheoryArrays::addRowLemma(RowLemmaType lem)
+{
+  TNode a, b, i, j;
+  std::tie(a, b, i, j) = lem;
+  Assert(a.getType().isArray() && b.getType().isArray());
 
-    NodeManager* nm = NodeManager::currentNM();
-    Node aj = nm->mkNode(kind::SELECT, a, j);
-    Node bj = nm->mkNode(kind::SELECT, b, j);
-    bool ajExists = d_equalityEngine->hasTerm(aj);
-    bool bjExists = d_equalityEngine->hasTerm(bj);
+  NodeManager* nm = NodeManager::currentNM();
+  Node aj = nm->mkNode(kind::SELECT, a, j);
+  Node bj = nm->mkNode(kind::SELECT, b, j);
+  bool ajExists = d_equalityEngine->hasTerm(aj);
+  bool bjExists = d_equalityEngine->hasTerm(bj);
+
+  // Check for redundant lemma
+  // TODO: more checks possible (i.e. check d_RowAlreadyAdded in context)
+  if (!d_equalityEngine->hasTerm(i) || !d_equalityEngine->hasTerm(j)
+      || d_equalityEngine->areEqual(i, j) || !d_equalityEngine->hasTerm(a)
+      || !d_equalityEngine->hasTerm(b) || d_equalityEngine->areEqual(a, b)
+      || (ajExists && bjExists && d_equalityEngine->areEqual(aj, bj)))
+  {
+    return false;
+  }
 
-    // Check for redundant lemma
-    // TODO: more checks possible (i.e. check d_RowAlreadyAdded in context)
-    if (!d_equalityEngine->hasTerm(i) || !d_equalityEngine->hasTerm(j)
-        || d_equalityEngine->areEqual(i, j) || !d_equalityEngine->hasTerm(a)
-        || !d_equalityEngine->hasTerm(b) || d_equalityEngine->areEqual(a, b)
-        || (ajExists && bjExists && d_equalityEngine->areEqual(aj, bj)))
+  int prop = options::arraysPropagate();
+  if (prop > 0) {
+    propagateRowLemma(lem);
+    if (d_state.isInConflict())
     {
-      continue;
+      return false;
     }
+  }
 
-    int prop = options::arraysPropagate();
-    if (prop > 0) {
-      propagateRowLemma(l);
-      if (d_state.isInConflict())
-      {
-        return true;
-      }
+  // Make sure that any terms introduced by rewriting are appropriately stored in the equality database
+  Node aj2 = Rewriter::rewrite(aj);
+  if (aj != aj2) {
+    if (!ajExists) {
+      preRegisterTermInternal(aj);
     }
+    if (!d_equalityEngine->hasTerm(aj2))
+    {
+      preRegisterTermInternal(aj2);
+    }
+    d_im.assertInference(
+        aj.eqNode(aj2), true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
+  }
+  Node bj2 = Rewriter::rewrite(bj);
+  if (bj != bj2) {
+    if (!bjExists) {
+      preRegisterTermInternal(bj);
+    }
+    if (!d_equalityEngine->hasTerm(bj2))
+    {
+      preRegisterTermInternal(bj2);
+    }
+    d_im.assertInference(
+        bj.eqNode(bj2), true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
+  }
+  if (aj2 == bj2) {
+    return false;
+  }
 
-    // Make sure that any terms introduced by rewriting are appropriately stored in the equality database
-    Node aj2 = Rewriter::rewrite(aj);
-    if (aj != aj2) {
-      if (!ajExists) {
-        preRegisterTermInternal(aj);
+  // construct lemma
+  Node eq1 = aj2.eqNode(bj2);
+  Node eq1_r = Rewriter::rewrite(eq1);
+  if (eq1_r == d_true) {
+    if (!d_equalityEngine->hasTerm(aj2))
+    {
+      preRegisterTermInternal(aj2);
+    }
+    if (!d_equalityEngine->hasTerm(bj2))
+    {
+      preRegisterTermInternal(bj2);
+    }
+    d_im.assertInference(eq1, true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
+    return false;
+  }
+
+  Node eq2 = i.eqNode(j);
+  Node eq2_r = Rewriter::rewrite(eq2);
+  if (eq2_r == d_true) {
+    d_im.assertInference(eq2, true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
+    return false;
+  }
+
+  Node lemma = nm->mkNode(kind::OR, eq2_r, eq1_r);
+
+  Trace("arrays-lem") << "Arrays::addRowLemma (2) adding " << lemma << "\n";
+  d_RowAlreadyAdded.insert(lem);
+  // use non-rewritten nodes, theory preprocessing will rewrite
+  d_im.arrayLemma(
+      aj.eqNode(bj), InferenceId::ARRAYS_READ_OVER_WRITE, eq2.notNode(), PfRule::ARRAYS_READ_OVER_WRITE);
+  ++d_numRow;
+  return true;
+}
+
+void TheoryArrays::computeRowModel(const std::vector<Node>& reads,
+                                   std::vector<RowLemmaType>* lemmas,
+                                   RowModel* model)
+{
+  // group the reads by the representative of their index, and record the
+  // indices that each array is read at
+  std::map<Node, std::map<Node, Node>> readsAt;
+  std::map<Node, Node> indexTerm;
+  std::map<Node, std::vector<Node>> readIndices;
+  for (const Node& r : reads)
+  {
+    Assert(r.getKind() == kind::SELECT);
+    Node a = d_equalityEngine->getRepresentative(r[0]);
+    Node j = d_equalityEngine->getRepresentative(r[1]);
+    if (readsAt[j].find(a) != readsAt[j].end())
+    {
+      continue;
+    }
+    readsAt[j][a] = r;
+    readIndices[a].push_back(j);
+    if (indexTerm.find(j) == indexTerm.end())
+    {
+      indexTerm[j] = r[1];
+    }
+  }
+  // the graph of the arrays, whose edges are the stores
+  std::map<Node, std::vector<std::pair<Node, Node>>> edges;
+  eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(d_equalityEngine);
+  for (; !eqcs_i.isFinished(); ++eqcs_i)
+  {
+    Node eqc = (*eqcs_i);
+    if (!eqc.getType().isArray())
+    {
+      continue;
+    }
+    eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, d_equalityEngine);
+    for (; !eqc_i.isFinished(); ++eqc_i)
+    {
+      Node s = *eqc_i;
+      if (s.getKind() != kind::STORE)
+      {
+        continue;
       }
-      if (!d_equalityEngine->hasTerm(aj2))
+      Node b = d_equalityEngine->getRepresentative(s[0]);
+      if (b != eqc)
       {
-        preRegisterTermInternal(aj2);
+        edges[eqc].emplace_back(b, s);
+        edges[b].emplace_back(eqc, s);
       }
-      d_im.assertInference(
-          aj.eqNode(aj2), true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
     }
-    Node bj2 = Rewriter::rewrite(bj);
-    if (bj != bj2) {
-      if (!bjExists) {
-        preRegisterTermInternal(bj);
+  }
+  for (const std::pair<const Node, std::map<Node, Node>>& jr : readsAt)
+  {
+    Node j = jr.first;
+    Node jt = indexTerm[j];
+    // maps the arrays visited at j to the store and the array they were
+    // reached by
+    std::map<Node, std::pair<Node, Node>> pred;
+    bool violated = false;
+    for (const std::pair<const Node, Node>& ar : jr.second)
+    {
+      if (violated || pred.find(ar.first) != pred.end())
+      {
+        continue;
       }
-      if (!d_equalityEngine->hasTerm(bj2))
+      // the reads of all arrays weakly equivalent at j to ar.first must be
+      // equal to ar.second
+      Node val = ar.second;
+      pred[ar.first] = std::pair<Node, Node>(Node::null(), Node::null());
+      std::vector<Node> visit;
+      visit.push_back(ar.first);
+      for (size_t k = 0; k < visit.size() && !violated; k++)
       {
-        preRegisterTermInternal(bj2);
+        Node y = visit[k];
+        if (k > 0)
+        {
+          // the value of y at j, if any
+          Node yval;
+          std::map<Node, Node>::const_iterator ity = jr.second.find(y);
+          if (ity != jr.second.end())
+          {
+            yval = ity->second;
+          }
+          else
+          {
+            TNode ca = d_infoMap.getConstArr(y);
+            if (!ca.isNull())
+            {
+              yval = ca.getConst<ArrayStoreAll>().getValue();
+            }
+          }
+          bool conflicting = false;
+          if (!yval.isNull())
+          {
+            if (d_equalityEngine->hasTerm(yval))
+            {
+              conflicting = !d_equalityEngine->areEqual(yval, val);
+            }
+            else
+            {
+              conflicting = d_equalityEngine->getRepresentative(val) != yval;
+            }
+          }
+          else
+          {
+            // if y is read at an index that may be equal to j, it must be
+            // read at j too
+            for (const Node& i : readIndices[y])
+            {
+              if (!d_equalityEngine->areDisequal(i, j, false))
+              {
+                conflicting = true;
+                break;
+              }
+            }
+          }
+          if (conflicting)
+          {
+            Trace("arrays-row-model") << "Arrays::computeRowModel: " << val
+                                      << " is not the value of " << y
+                                      << " at " << jt << std::endl;
+            ++d_numRowModelViolations;
+            violated = true;
+            if (lemmas != nullptr)
+            {
+              // the lemmas of the stores on the path from ar.first to y
+              for (Node p = y; p != ar.first; p = pred[p].second)
+              {
+                TNode s = pred[p].first;
+                lemmas->push_back(std::make_tuple(s, s[0], s[1], jt));
+              }
+            }
+            break;
+          }
+          if (yval.isNull() && model != nullptr)
+          {
+            (*model)[y].emplace_back(jt, val);
+          }
+        }
+        for (const std::pair<Node, Node>& e : edges[y])
+        {
+          if (pred.find(e.first) != pred.end()
+              || d_equalityEngine->areEqual(e.second[1], jt))
+          {
+            continue;
+          }
+          pred[e.first] = std::pair<Node, Node>(e.second, y);
+          visit.push_back(e.first);
+        }
       }
-      d_im.assertInference(
-          bj.eqNode(bj2), true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
-    }
-    if (aj2 == bj2) {
-      continue;
     }
+  }
+}
 
-    // construct lemma
-    Node eq1 = aj2.eqNode(bj2);
-    Node eq1_r = Rewriter::rewrite(eq1);
-    if (eq1_r == d_true) {
-      if (!d_equalityEngine->hasTerm(aj2))
+bool TheoryArrays::checkRowModel()
+{
+  std::vector<Node> reads;
+  eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(d_equalityEngine);
+  for (; !eqcs_i.isFinished(); ++eqcs_i)
+  {
+    eq::EqClassIterator eqc_i = eq::EqClassIterator(*eqcs_i, d_equalityEngine);
+    for (; !eqc_i.isFinished(); ++eqc_i)
+    {
+      if ((*eqc_i).getKind() == kind::SELECT)
       {
-        preRegisterTermInternal(aj2);
+        reads.push_back(*eqc_i);
       }
-      if (!d_equalityEngine->hasTerm(bj2))
-      {
-        preRegisterTermInternal(bj2);
-      }
-      d_im.assertInference(eq1, true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
-      continue;
     }
-
-    Node eq2 = i.eqNode(j);
-    Node eq2_r = Rewriter::rewrite(eq2);
-    if (eq2_r == d_true) {
-      d_im.assertInference(eq2, true, InferenceId::UNKNOWN, d_true, PfRule::MACRO_SR_PRED_INTRO);
+  }
+  std::vector<RowLemmaType> lemmas;
+  computeRowModel(reads, &lemmas, nullptr);
+  Trace("arrays-lem") << "Arrays::checkRowModel: " << lemmas.size()
+                      << " lemmas on violated paths" << std::endl;
+  bool lemmasAdded = false;
+  for (const RowLemmaType& l : lemmas)
+  {
+    if (d_RowAlreadyAdded.contains(l))
+    {
       continue;
     }
-
-    Node lem = nm->mkNode(kind::OR, eq2_r, eq1_r);
-
-    Trace("arrays-lem") << "Arrays::addRowLemma (2) adding " << lem << "\n";
-    d_RowAlreadyAdded.insert(l);
-    // use non-rewritten nodes, theory preprocessing will rewrite
-    d_im.arrayLemma(
-        aj.eqNode(bj), InferenceId::ARRAYS_READ_OVER_WRITE, eq2.notNode(), PfRule::ARRAYS_READ_OVER_WRITE);
-    ++d_numRow;
-    lemmasAdded = true;
-    if (options::arraysReduceSharing()) {
+    if (addRowLemma(l))
+    {
+      lemmasAdded = true;
+    }
+    if (d_state.isInConflict())
+    {
       return true;
     }
   }
+  if (!lemmas.empty() && !lemmasAdded)
+  {
+    // all lemmas on the violated paths were redundant
+    Trace("arrays-lem") << "Arrays::checkRowModel: no new lemma" << std::endl;
+    d_im.setIncomplete();
+  }
   return lemmasAdded;
 }
 
@@ -19,6 +19,7 @@
 #ifndef CVC4__THEORY__ARRAYS__THEORY_ARRAYS_H
 #define CVC4__THEORY__ARRAYS__THEORY_ARRAYS_H
 
+#include <map>
 #include <tuple>
 #include <unordered_map>
 
@@ -131,6 +132,8 @@ class TheoryArrays : public Theory {
   IntStat d_numSetModelValSplits;
   /** conflicts in setModelVal */
   IntStat d_numSetModelValConflicts;
+  /** violated read-over-write paths found by checkRowModel */
+  IntStat d_numRowModelViolations;
 
  public:
   TheoryArrays(context::Context* c,
@@ -446,6 +449,35 @@ class TheoryArrays : public Theory {
   void propagateRowLemma(RowLemmaType lem);
   void queueRowLemma(RowLemmaType lem);
   bool dischargeLemmas();
+  /**
+   * Send the read-over-write lemma lem unless it is redundant in the current
+   * context. Returns true if a lemma was sent.
+   */
+  bool addRowLemma(RowLemmaType lem);
+  /** Map from array representatives to (index, value) pairs */
+  using RowModel = std::map<Node, std::vector<std::pair<Node, Node>>>;
+  /**
+   * Compute the model of the arrays in the equality engine at the indices of
+   * the given reads, based on weak equivalence (Christ/Hoenicke, SMT 2014).
+   *
+   * For each index class j of a read, two arrays are weakly equivalent at j
+   * if they are connected by a path of stores whose indices are not equal to
+   * j. All arrays that are weakly equivalent at j must have the same value at
+   * j. If two reads of such arrays at j may disagree, or if propagating the
+   * value to an array would require an index of a read of that array to be
+   * distinct from j, we add the read-over-write lemmas along the path between
+   * them to lemmas, if it is not null. Otherwise, we add to model the value
+   * at j of each array that has no read at j, if model is not null.
+   */
+  void computeRowModel(const std::vector<Node>& reads,
+                       std::vector<RowLemmaType>* lemmas,
+                       RowModel* model);
+  /**
+   * The check for --arrays-lazy-row, which sends the read-over-write lemmas
+   * computed by computeRowModel for the current reads. Returns true if a
+   * lemma was sent.
+   */
+  bool checkRowModel();
 
   std::vector<Node> d_decisions;
   bool d_inCheckModel;
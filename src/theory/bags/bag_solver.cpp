@@ -32,7 +32,12 @@ namespace theory {
 namespace bags {
 
 BagSolver::BagSolver(SolverState& s, InferenceManager& im, TermRegistry& tr)
-    : d_state(s), d_ig(&s, &im), d_im(im), d_termReg(tr)
+    : d_state(s),
+      d_ig(&s, &im),
+      d_im(im),
+      d_termReg(tr),
+      d_reduced(s.getSatContext()),
+      d_nonNegative(s.getSatContext())
 {
   d_zero = NodeManager::currentNM()->mkConst(Rational(0));
   d_one = NodeManager::currentNM()->mkConst(Rational(1));
@@ -106,6 +111,10 @@ void BagSolver::checkEmpty(const Node& n)
   Assert(n.getKind() == EMPTYBAG);
   for (const Node& e : d_state.getElements(n))
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.empty(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -117,6 +126,10 @@ void BagSolver::checkUnionDisjoint(const Node& n)
   std::set<Node> elements = getElementsForBinaryOperator(n);
   for (const Node& e : elements)
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.unionDisjoint(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -128,6 +141,10 @@ void BagSolver::checkUnionMax(const Node& n)
   std::set<Node> elements = getElementsForBinaryOperator(n);
   for (const Node& e : elements)
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.unionMax(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -139,6 +156,10 @@ void BagSolver::checkIntersectionMin(const Node& n)
   std::set<Node> elements = getElementsForBinaryOperator(n);
   for (const Node& e : elements)
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.intersection(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -150,6 +171,10 @@ void BagSolver::checkDifferenceSubtract(const Node& n)
   std::set<Node> elements = getElementsForBinaryOperator(n);
   for (const Node& e : elements)
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.differenceSubtract(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -163,12 +188,21 @@ void BagSolver::checkMkBag(const Node& n)
       << " are: " << d_state.getElements(n) << std::endl;
   for (const Node& e : d_state.getElements(n))
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.mkBag(n, e);
     d_im.lemmaTheoryInference(&i);
   }
 }
 void BagSolver::checkNonNegativeCountTerms(const Node& bag, const Node& element)
 {
+  Node count = NodeManager::currentNM()->mkNode(BAG_COUNT, element, bag);
+  if (!d_nonNegative.insert(count))
+  {
+    return;
+  }
   InferInfo i = d_ig.nonNegativeCount(bag, element);
   d_im.lemmaTheoryInference(&i);
 }
@@ -179,6 +213,10 @@ void BagSolver::checkDifferenceRemove(const Node& n)
   std::set<Node> elements = getElementsForBinaryOperator(n);
   for (const Node& e : elements)
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.differenceRemove(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -196,6 +234,10 @@ void BagSolver::checkDuplicateRemoval(Node n)
 
   for (const Node& e : elements)
   {
+    if (!markReduced(n, e))
+    {
+      continue;
+    }
     InferInfo i = d_ig.duplicateRemoval(n, e);
     d_im.lemmaTheoryInference(&i);
   }
@@ -205,11 +247,21 @@ void BagSolver::checkDisequalBagTerms()
 {
   for (const Node& n : d_state.getDisequalBagTerms())
   {
+    if (!d_reduced.insert(n))
+    {
+      continue;
+    }
     InferInfo info = d_ig.bagDisequality(n);
     d_im.lemmaTheoryInference(&info);
   }
 }
 
+bool BagSolver::markReduced(const Node& n, const Node& e)
+{
+  Node count = NodeManager::currentNM()->mkNode(BAG_COUNT, e, n);
+  return d_reduced.insert(count);
+}
+
 }  // namespace bags
 }  // namespace theory
 }  // namespace cvc5
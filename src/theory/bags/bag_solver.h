@@ -17,6 +17,7 @@
 #ifndef CVC4__THEORY__BAG__SOLVER_H
 #define CVC4__THEORY__BAG__SOLVER_H
 
+#include "context/cdhashset.h"
 #include "theory/bags/inference_generator.h"
 
 namespace cvc5 {
@@ -72,6 +73,13 @@ class BagSolver
   void checkNonNegativeCountTerms(const Node& bag, const Node& element);
   /** apply inference rules for disequal bag terms */
   void checkDisequalBagTerms();
+  /**
+   * Mark the pair of bag term n and element e as reduced in the current SAT
+   * context. Returns false if it was already marked, in which case the lemma
+   * of the inference rule of n for e was already sent, and need not be
+   * generated again.
+   */
+  bool markReduced(const Node& n, const Node& e);
 
   /** The solver state object */
   SolverState& d_state;
@@ -81,6 +89,15 @@ class BagSolver
   InferenceManager& d_im;
   /** Reference to the term registry of theory of bags */
   TermRegistry& d_termReg;
+  /**
+   * The count terms (bag.count e n) such that the inference rule of bag term n
+   * was applied for e, and the bag disequalities whose lemma was sent. Lemmas
+   * are context-independent, but this set is SAT-context dependent since
+   * pending lemmas are discarded on conflict.
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_reduced;
+  /** The count terms whose non negative constraint was applied */
+  context::CDHashSet<Node, NodeHashFunction> d_nonNegative;
   /** Commonly used constants */
   Node d_true;
   Node d_false;
@@ -46,6 +46,7 @@ CircuitPropagator::CircuitPropagator(bool enableForward, bool enableBackward)
       d_backEdgesClearer(&d_context, d_backEdges),
       d_seen(&d_context),
       d_state(&d_context),
+      d_forwardCount(&d_context),
       d_forwardPropagation(enableForward),
       d_backwardPropagation(enableBackward),
       d_needsFinish(false),
@@ -458,25 +459,26 @@ void CircuitPropagator::propagateForward(TNode child, bool childAssignment)
       case kind::AND:
         if (childAssignment)
         {
-          TNode::iterator holdout;
-          holdout = find_if(parent.begin(), parent.end(), [this](TNode x) {
-            return !isAssignedTo(x, true);
-          });
-
-          if (holdout == parent.end())
+          // the number of children propagated as TRUE, including child
+          size_t count = d_forwardCount[parent] + 1;
+          d_forwardCount[parent] = count;
+          if (count == parent.getNumChildren())
           {  // all children are assigned TRUE
             // AND ...(x=TRUE)...: if all children now assigned to TRUE,
             // assign(AND = TRUE)
             assignAndEnqueue(parent, true, prover.andAllTrue());
           }
-          else if (isAssignedTo(parent, false))
+          else if (count + 1 == parent.getNumChildren()
+                   && isAssignedTo(parent, false))
           {  // the AND is FALSE
-            // is the holdout unique ?
-            TNode::iterator other =
-                find_if(holdout + 1, parent.end(), [this](TNode x) {
+            // All children but one were propagated as TRUE. The remaining
+            // one is the unique holdout, unless it is assigned TRUE but not
+            // propagated yet.
+            TNode::iterator holdout =
+                find_if(parent.begin(), parent.end(), [this](TNode x) {
                   return !isAssignedTo(x, true);
                 });
-            if (other == parent.end())
+            if (holdout != parent.end())
             {  // the holdout is unique
               // AND ...(x=TRUE)...: if all children BUT ONE now assigned to
               // TRUE, and AND == FALSE, assign(last_holdout = FALSE)
@@ -499,24 +501,26 @@ void CircuitPropagator::propagateForward(TNode child, bool childAssignment)
         }
         else
         {
-          TNode::iterator holdout;
-          holdout = find_if(parent.begin(), parent.end(), [this](TNode x) {
-            return !isAssignedTo(x, false);
-          });
-          if (holdout == parent.end())
+          // the number of children propagated as FALSE, including child
+          size_t count = d_forwardCount[parent] + 1;
+          d_forwardCount[parent] = count;
+          if (count == parent.getNumChildren())
           {  // all children are assigned FALSE
             // OR ...(x=FALSE)...: if all children now assigned to FALSE,
             // assign(OR = FALSE)
             assignAndEnqueue(parent, false, prover.orFalse());
           }
-          else if (isAssignedTo(parent, true))
+          else if (count + 1 == parent.getNumChildren()
+                   && isAssignedTo(parent, true))
           {  // the OR is TRUE
-            // is the holdout unique ?
-            TNode::iterator other =
-                find_if(holdout + 1, parent.end(), [this](TNode x) {
+            // All children but one were propagated as FALSE. The remaining
+            // one is the unique holdout, unless it is assigned FALSE but not
+            // propagated yet.
+            TNode::iterator holdout =
+                find_if(parent.begin(), parent.end(), [this](TNode x) {
                   return !isAssignedTo(x, false);
                 });
-            if (other == parent.end())
+            if (holdout != parent.end())
             {  // the holdout is unique
               // OR ...(x=FALSE)...: if all children BUT ONE now assigned to
               // FALSE, and OR == TRUE, assign(last_holdout = TRUE)
@@ -250,6 +250,14 @@ class CircuitPropagator
 
   AssignmentMap d_state;
 
+  /**
+   * The number of occurrences of children of each AND (resp. OR) node that
+   * were propagated forward with the value true (resp. false). This allows
+   * to detect that all children or all children but one have this value
+   * without scanning the children on each forward propagation.
+   */
+  context::CDHashMap<TNode, uint32_t, TNodeHashFunction> d_forwardCount;
+
   /** Whether to perform forward propagation */
   const bool d_forwardPropagation;
 
@@ -16,6 +16,8 @@
 
 #include "theory/bv/bitblast/aig_bitblaster.h"
 
+#include <sstream>
+
 #include "base/check.h"
 #include "cvc4_private.h"
 #include "options/bv_options.h"
@@ -32,6 +34,11 @@ extern "C" {
 #include "sat/cnf/cnf.h"
 
 extern Aig_Man_t* Abc_NtkToDar(Abc_Ntk_t* pNtk, int fExors, int fRegisters);
+extern void Io_WriteAiger(Abc_Ntk_t* pNtk,
+                          char* pFileName,
+                          int fWriteSymbols,
+                          int fCompact,
+                          int fUnique);
 }
 
 // Function is defined as static in ABC. Not sure how else to do this.
@@ -327,6 +334,13 @@ Abc_Obj_t* AigBitblaster::mkInput(TNode input) {
   Abc_Obj_t* aig_input = Abc_NtkCreatePi(currentAigNtk());
   // d_aigCache.insert(std::make_pair(input, aig_input));
   d_nodeToAigInput.insert(std::make_pair(input, aig_input));
+  if (!options::bvExportAiger().empty())
+  {
+    // the names of the inputs are the symbols of the exported AIG
+    std::stringstream name;
+    name << input;
+    Abc_ObjAssignName(aig_input, const_cast<char*>(name.str().c_str()), NULL);
+  }
   Debug("bitvector-aig") << "AigSimplifer::mkInput " << input << " " << aig_input <<"\n"; 
   return aig_input; 
 }
@@ -343,6 +357,11 @@ bool AigBitblaster::solve(TNode node) {
   Abc_ObjAddFanin(d_aigOutputNode, query); 
 
   simplifyAig();
+  if (!options::bvExportAiger().empty())
+  {
+    std::string file = options::bvExportAiger();
+    Io_WriteAiger(currentAigNtk(), const_cast<char*>(file.c_str()), 1, 0, 0);
+  }
   convertToCnfAndAssert();
   // no need to use abc anymore
   
@@ -362,16 +381,45 @@ void AigBitblaster::simplifyAig() {
   Abc_AigCleanup(currentAigM());
   Assert(Abc_NtkCheck(currentAigNtk()));
 
-  const char* command = options::bitvectorAigSimplifications().c_str(); 
+  d_statistics.d_numInitialAigNodes += Abc_NtkNodeNum(currentAigNtk());
+
   Abc_Frame_t* pAbc = Abc_FrameGetGlobalFrame();
   Abc_FrameSetCurrentNetwork(pAbc, currentAigNtk());
+  addAliases(pAbc);
 
-  addAliases(pAbc); 
-  if ( Cmd_CommandExecute( pAbc, command ) ) {
-    fprintf( stdout, "Cannot execute command \"%s\".\n", command );
-    exit(-1); 
+  // run the passes one at a time to record the size of the AIG after each
+  std::stringstream commands(options::bitvectorAigSimplifications());
+  std::string command;
+  size_t i = 0;
+  while (std::getline(commands, command, ';'))
+  {
+    size_t first = command.find_first_not_of(" \t");
+    if (first == std::string::npos)
+    {
+      continue;
+    }
+    command = command.substr(first, command.find_last_not_of(" \t") - first + 1);
+    int before = Abc_NtkNodeNum(Abc_FrameReadNtk(pAbc));
+    if (Cmd_CommandExecute(pAbc, command.c_str()))
+    {
+      fprintf(stdout, "Cannot execute command \"%s\".\n", command.c_str());
+      exit(-1);
+    }
+    int after = Abc_NtkNodeNum(Abc_FrameReadNtk(pAbc));
+    d_statistics.passStat(i, command) += after;
+    Trace("bitvector-aig") << "AigBitblaster::simplifyAig " << command << ": "
+                           << before << " -> " << after << " nodes\n";
+    ++i;
   }
   s_abcAigNetwork = Abc_FrameReadNtk(pAbc);
+  // passes such as fraig may leave a network that is not structurally hashed
+  if (!Abc_NtkIsStrash(s_abcAigNetwork))
+  {
+    Abc_Ntk_t* strashed = Abc_NtkStrash(s_abcAigNetwork, 0, 1, 0);
+    Abc_FrameReplaceCurrentNetwork(pAbc, strashed);
+    s_abcAigNetwork = strashed;
+  }
+  d_statistics.d_numFinalAigNodes += Abc_NtkNodeNum(s_abcAigNetwork);
 }
 
 
@@ -392,7 +440,16 @@ void AigBitblaster::convertToCnfAndAssert() {
 
   Assert(pMan != NULL);
   Assert(Aig_ManCheck(pMan));
-  pCnf = Cnf_DeriveFast( pMan, 0 );
+  if (options::bitvectorAigCnf() == options::BVAigCnfMode::MAPPED)
+  {
+    // map the AIG into cuts of small area, each cut giving the irredundant
+    // clauses of its function, which is more compact than a per-node encoding
+    pCnf = Cnf_Derive(pMan, 0);
+  }
+  else
+  {
+    pCnf = Cnf_DeriveFast(pMan, 0);
+  }
 
   assertToSatSolver(pCnf); 
     
@@ -475,12 +532,16 @@ Abc_Obj_t* AigBitblaster::getBBAtom(TNode atom) const {
 AigBitblaster::Statistics::Statistics()
   : d_numClauses("theory::bv::AigBitblaster::numClauses", 0)
   , d_numVariables("theory::bv::AigBitblaster::numVariables", 0)
+  , d_numInitialAigNodes("theory::bv::AigBitblaster::numInitialAigNodes", 0)
+  , d_numFinalAigNodes("theory::bv::AigBitblaster::numFinalAigNodes", 0)
   , d_simplificationTime("theory::bv::AigBitblaster::simplificationTime")
   , d_cnfConversionTime("theory::bv::AigBitblaster::cnfConversionTime")
   , d_solveTime("theory::bv::AigBitblaster::solveTime")
 {
   smtStatisticsRegistry()->registerStat(&d_numClauses); 
   smtStatisticsRegistry()->registerStat(&d_numVariables);
+  smtStatisticsRegistry()->registerStat(&d_numInitialAigNodes);
+  smtStatisticsRegistry()->registerStat(&d_numFinalAigNodes);
   smtStatisticsRegistry()->registerStat(&d_simplificationTime); 
   smtStatisticsRegistry()->registerStat(&d_cnfConversionTime);
   smtStatisticsRegistry()->registerStat(&d_solveTime); 
@@ -489,9 +550,30 @@ AigBitblaster::Statistics::Statistics()
 AigBitblaster::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&d_numClauses); 
   smtStatisticsRegistry()->unregisterStat(&d_numVariables);
+  smtStatisticsRegistry()->unregisterStat(&d_numInitialAigNodes);
+  smtStatisticsRegistry()->unregisterStat(&d_numFinalAigNodes);
   smtStatisticsRegistry()->unregisterStat(&d_simplificationTime); 
   smtStatisticsRegistry()->unregisterStat(&d_cnfConversionTime);
   smtStatisticsRegistry()->unregisterStat(&d_solveTime); 
+  for (std::unique_ptr<IntStat>& stat : d_passNodes)
+  {
+    smtStatisticsRegistry()->unregisterStat(stat.get());
+  }
+}
+
+IntStat& AigBitblaster::Statistics::passStat(size_t i,
+                                              const std::string& command)
+{
+  if (i >= d_passNodes.size())
+  {
+    Assert(i == d_passNodes.size());
+    std::stringstream name;
+    name << "theory::bv::AigBitblaster::pass" << i << "::" << command
+         << "::numAigNodes";
+    d_passNodes.emplace_back(new IntStat(name.str(), 0));
+    smtStatisticsRegistry()->registerStat(d_passNodes.back().get());
+  }
+  return *d_passNodes[i];
 }
 
 }  // namespace bv
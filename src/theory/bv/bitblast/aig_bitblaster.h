@@ -96,11 +96,23 @@ class AigBitblaster : public TBitblaster<Abc_Obj_t*>
    public:
     IntStat d_numClauses;
     IntStat d_numVariables;
+    /** The number of AND nodes of the AIG before and after simplification */
+    IntStat d_numInitialAigNodes;
+    IntStat d_numFinalAigNodes;
     TimerStat d_simplificationTime;
     TimerStat d_cnfConversionTime;
     TimerStat d_solveTime;
+    /**
+     * Get the statistic for the number of AND nodes of the AIG after the
+     * i-th pass of the simplifications, being command. The statistics of
+     * the passes are registered on demand.
+     */
+    IntStat& passStat(size_t i, const std::string& command);
     Statistics();
     ~Statistics();
+
+   private:
+    std::vector<std::unique_ptr<IntStat>> d_passNodes;
   };
 
   Statistics d_statistics;
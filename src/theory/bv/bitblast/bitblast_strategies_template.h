@@ -394,6 +394,40 @@ void DefaultMultBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
   }
 }
 
+template <class T>
+void WallaceMultBB(TNode node, std::vector<T>& res, TBitblaster<T>* bb)
+{
+  Debug("bitvector-bb") << "theory::bv::WallaceMultBB bitblasting " << node
+                        << "\n";
+  Assert(res.size() == 0 && node.getKind() == kind::BITVECTOR_MULT);
+
+  bb->bbTerm(node[0], res);
+  for (unsigned i = 1; i < node.getNumChildren(); ++i)
+  {
+    std::vector<T> current, newres;
+    bb->bbTerm(node[i], current);
+    wallaceMultiplier(res, current, newres);
+    res = newres;
+  }
+}
+
+template <class T>
+void BoothMultBB(TNode node, std::vector<T>& res, TBitblaster<T>* bb)
+{
+  Debug("bitvector-bb") << "theory::bv::BoothMultBB bitblasting " << node
+                        << "\n";
+  Assert(res.size() == 0 && node.getKind() == kind::BITVECTOR_MULT);
+
+  bb->bbTerm(node[0], res);
+  for (unsigned i = 1; i < node.getNumChildren(); ++i)
+  {
+    std::vector<T> current, newres;
+    bb->bbTerm(node[i], current);
+    boothMultiplier(res, current, newres);
+    res = newres;
+  }
+}
+
 template <class T>
 void DefaultPlusBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
   Debug("bitvector-bb") << "theory::bv::DefaultPlusBB bitblasting " << node << "\n";
@@ -578,6 +612,48 @@ void DefaultUremBB(TNode node, std::vector<T>& rem, TBitblaster<T>* bb)
   bb->storeBBTerm(quotient, q);
 }
 
+template <class T>
+void NonRestoringUdivBB(TNode node, std::vector<T>& q, TBitblaster<T>* bb)
+{
+  Debug("bitvector-bb") << "theory::bv::NonRestoringUdivBB bitblasting "
+                        << node << "\n";
+  Assert(node.getKind() == kind::BITVECTOR_UDIV && q.size() == 0);
+
+  std::vector<T> a, b;
+  bb->bbTerm(node[0], a);
+  bb->bbTerm(node[1], b);
+
+  // the divider already handles division by 0
+  std::vector<T> r;
+  nonRestoringDivider(a, b, q, r);
+
+  // cache the remainder in case we need it later
+  Node remainder = Rewriter::rewrite(
+      NodeManager::currentNM()->mkNode(kind::BITVECTOR_UREM, node[0], node[1]));
+  bb->storeBBTerm(remainder, r);
+}
+
+template <class T>
+void NonRestoringUremBB(TNode node, std::vector<T>& rem, TBitblaster<T>* bb)
+{
+  Debug("bitvector-bb") << "theory::bv::NonRestoringUremBB bitblasting "
+                        << node << "\n";
+  Assert(node.getKind() == kind::BITVECTOR_UREM && rem.size() == 0);
+
+  std::vector<T> a, b;
+  bb->bbTerm(node[0], a);
+  bb->bbTerm(node[1], b);
+
+  // the divider already handles division by 0
+  std::vector<T> q;
+  nonRestoringDivider(a, b, q, rem);
+
+  // cache the quotient in case we need it later
+  Node quotient = Rewriter::rewrite(
+      NodeManager::currentNM()->mkNode(kind::BITVECTOR_UDIV, node[0], node[1]));
+  bb->storeBBTerm(quotient, q);
+}
+
 template <class T>
 void DefaultSdivBB (TNode node, std::vector<T>& bits, TBitblaster<T>* bb) {
   Debug("bitvector") << "theory::bv:: Unimplemented kind "
@@ -0,0 +1,205 @@
+/*********************                                                        */
+/*! \file bitblast_template_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Cache of bit-blasting templates shared by the bit-blasters
+ **
+ ** Cache of bit-blasting templates shared by the bit-blasters.
+ **/
+
+#include "theory/bv/bitblast/bitblast_template_cache.h"
+
+#include <unordered_map>
+
+#include "expr/attribute.h"
+#include "expr/bound_var_manager.h"
+#include "options/bv_options.h"
+#include "theory/bv/bitblast/bitblaster.h"
+#include "theory/bv/theory_bv_utils.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/** Attribute for the canonical placeholders of the shapes */
+struct BBPlaceholderAttributeId
+{
+};
+using BBPlaceholderAttribute = expr::Attribute<BBPlaceholderAttributeId, Node>;
+
+/** Attribute for the templates, as SEXPR of their bits */
+struct BBTemplateAttributeId
+{
+};
+using BBTemplateAttribute = expr::Attribute<BBTemplateAttributeId, Node>;
+
+/**
+ * Bit-blaster computing the templates, which runs the strategies on the
+ * shapes and gives the placeholders their bits, without any SAT solver.
+ */
+class TemplateBitblaster : public TBitblaster<Node>
+{
+ public:
+  void bbTerm(TNode node, Bits& bits) override
+  {
+    if (hasBBTerm(node))
+    {
+      getBBTerm(node, bits);
+      return;
+    }
+    d_termBBStrategies[node.getKind()](node, bits, this);
+    storeBBTerm(node, bits);
+  }
+  void makeVariable(TNode var, Bits& bits) override
+  {
+    for (unsigned i = 0; i < utils::getSize(var); ++i)
+    {
+      bits.push_back(utils::mkBitOf(var, i));
+    }
+  }
+  void bbAtom(TNode node) override { Unreachable(); }
+  Node getBBAtom(TNode atom) const override { Unreachable(); }
+  bool hasBBAtom(TNode atom) const override { return false; }
+  void storeBBAtom(TNode atom, Node atom_bb) override { Unreachable(); }
+
+ protected:
+  Node getModelFromSatSolver(TNode node, bool fullModel) override
+  {
+    Unreachable();
+  }
+  prop::SatSolver* getSatSolver() override { Unreachable(); }
+};
+
+/** Identifies the strategies the templates are computed with */
+size_t getStrategiesId()
+{
+  return static_cast<size_t>(options::bvMultBB()) * 16
+         + static_cast<size_t>(options::bvDivBB());
+}
+
+}  // namespace
+
+bool BBTemplateCache::hasTemplate(Kind k)
+{
+  switch (k)
+  {
+    case kind::BITVECTOR_MULT:
+    case kind::BITVECTOR_UDIV:
+    case kind::BITVECTOR_UREM:
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    case kind::BITVECTOR_ASHR: return true;
+    default: return false;
+  }
+}
+
+Node BBTemplateCache::mkShape(TNode node)
+{
+  BoundVarManager* bvm = NodeManager::currentNM()->getBoundVarManager();
+  NodeBuilder<> nb(node.getKind());
+  if (node.getMetaKind() == kind::metakind::PARAMETERIZED)
+  {
+    nb << node.getOperator();
+  }
+  for (size_t i = 0, size = node.getNumChildren(); i < size; ++i)
+  {
+    // the placeholder of position i and the size of the child
+    Node key = BoundVarManager::getCacheValue(
+        utils::mkZero(utils::getSize(node[i])), i);
+    d_keys.insert(key);
+    nb << bvm->mkBoundVar<BBPlaceholderAttribute>(key, node[i].getType());
+  }
+  return nb.constructNode();
+}
+
+Node BBTemplateCache::computeTemplate(TNode shape)
+{
+  TemplateBitblaster bb;
+  std::vector<Node> bits;
+  bb.bbTerm(shape, bits);
+  return NodeManager::currentNM()->mkNode(kind::SEXPR, bits);
+}
+
+void BBTemplateCache::bbTerm(TNode node,
+                             TBitblaster<Node>* bb,
+                             std::vector<Node>& bits)
+{
+  Assert(hasTemplate(node.getKind()) && bits.empty());
+
+  Node shape = mkShape(node);
+  Node key = BoundVarManager::getCacheValue(shape, getStrategiesId());
+  d_keys.insert(key);
+  BBTemplateAttribute bbta;
+  Node tmpl = key.getAttribute(bbta);
+  if (tmpl.isNull())
+  {
+    tmpl = computeTemplate(shape);
+    key.setAttribute(bbta, tmpl);
+    Trace("bv-bb-template") << "new template for " << shape << std::endl;
+  }
+
+  // substitute the bits of the children for the bits of the placeholders
+  std::unordered_map<Node, Node, NodeHashFunction> cache;
+  for (size_t i = 0, size = node.getNumChildren(); i < size; ++i)
+  {
+    std::vector<Node> childBits;
+    bb->bbTerm(node[i], childBits);
+    for (unsigned j = 0, csize = childBits.size(); j < csize; ++j)
+    {
+      cache[utils::mkBitOf(shape[i], j)] = childBits[j];
+    }
+  }
+  std::vector<TNode> visit;
+  for (const Node& bit : tmpl)
+  {
+    visit.push_back(bit);
+    do
+    {
+      TNode cur = visit.back();
+      auto it = cache.find(cur);
+      if (it == cache.end())
+      {
+        if (cur.getNumChildren() == 0)
+        {
+          cache.emplace(cur, cur);
+          visit.pop_back();
+        }
+        else
+        {
+          cache.emplace(cur, Node());
+          visit.insert(visit.end(), cur.begin(), cur.end());
+        }
+        continue;
+      }
+      visit.pop_back();
+      if (it->second.isNull())
+      {
+        NodeBuilder<> nb(cur.getKind());
+        if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+        {
+          nb << cur.getOperator();
+        }
+        for (const Node& child : cur)
+        {
+          Assert(cache.find(child) != cache.end());
+          nb << cache.find(child)->second;
+        }
+        it->second = nb.constructNode();
+      }
+    } while (!visit.empty());
+    bits.push_back(cache[bit]);
+  }
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
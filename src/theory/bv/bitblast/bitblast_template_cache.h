@@ -0,0 +1,74 @@
+/*********************                                                        */
+/*! \file bitblast_template_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Cache of bit-blasting templates shared by the bit-blasters
+ **
+ ** Cache of bit-blasting templates shared by the bit-blasters.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__BITBLAST_TEMPLATE_CACHE_H
+#define CVC4__THEORY__BV__BITBLAST__BITBLAST_TEMPLATE_CACHE_H
+
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+template <class T>
+class TBitblaster;
+
+/**
+ * Cache of bit-blasting templates. The template of a term is the bit-blasted
+ * form of its shape, which is its operator applied to canonical placeholder
+ * variables of the sizes of its children. It is computed once with the
+ * bit-blasting strategies, and stored as an attribute of the shape, so that
+ * all the bit-blasters over nodes of a node manager share it, across BV
+ * solver instances and incremental calls. The bits of a term are obtained by
+ * substituting the bits of its children for the bits of the placeholders in
+ * the template of its shape.
+ *
+ * Templates are only used for the operators with large bit-blasted forms,
+ * i.e., multiplications, divisions and shifts. Each bit-blaster using them
+ * owns an instance of this class, which keeps the templates it used alive.
+ */
+class BBTemplateCache
+{
+ public:
+  /** Whether the terms of kind k are bit-blasted through their template */
+  static bool hasTemplate(Kind k);
+
+  /**
+   * Bit-blast node, whose kind has templates, into bits. The children of
+   * node are bit-blasted with bb, which registers their variables.
+   */
+  void bbTerm(TNode node, TBitblaster<Node>* bb, std::vector<Node>& bits);
+
+ private:
+  /** Make the shape of node, with canonical placeholders for its children */
+  Node mkShape(TNode node);
+  /** Compute the template of shape with the bit-blasting strategies */
+  static Node computeTemplate(TNode shape);
+
+  /** The cache keys of the templates and placeholders used by this cache */
+  std::unordered_set<Node, NodeHashFunction> d_keys;
+}; /* class BBTemplateCache */
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__BV__BITBLAST__BITBLAST_TEMPLATE_CACHE_H */
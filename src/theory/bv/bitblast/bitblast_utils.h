@@ -220,6 +220,193 @@ inline void shiftAddMultiplier(const std::vector<T>&a, const std::vector<T>&b, s
   }
 }
 
+/**
+ * Constructs a full adder of the bits a, b and c, setting sum and carry to
+ * the sum and carry-out bits.
+ */
+template <class T>
+inline void fullAdder(T a, T b, T c, T& sum, T& carry)
+{
+  T a_xor_b = mkXor(a, b);
+  sum = mkXor(a_xor_b, c);
+  carry = mkOr(mkAnd(a, b), mkAnd(a_xor_b, c));
+}
+
+/**
+ * Constructs a Wallace tree adder summing the bits of columns modulo
+ * 2^columns.size(), where columns[i] holds bits of weight 2^i. Each layer of
+ * the tree reduces the columns with full and half adders, until every column
+ * holds at most two bits, which are summed by a ripple carry adder.
+ *
+ * @param columns the bits to be added, which are consumed
+ * @param res the result
+ */
+template <class T>
+inline void wallaceTreeAdder(std::vector<std::vector<T>>& columns,
+                             std::vector<T>& res)
+{
+  Assert(res.size() == 0);
+  unsigned width = columns.size();
+  bool reduced = false;
+  while (!reduced)
+  {
+    reduced = true;
+    std::vector<std::vector<T>> next(width);
+    for (unsigned i = 0; i < width; ++i)
+    {
+      const std::vector<T>& col = columns[i];
+      unsigned j = 0;
+      if (col.size() > 2)
+      {
+        for (; j + 3 <= col.size(); j += 3)
+        {
+          T sum, carry;
+          fullAdder(col[j], col[j + 1], col[j + 2], sum, carry);
+          next[i].push_back(sum);
+          if (i + 1 < width)
+          {
+            next[i + 1].push_back(carry);
+          }
+        }
+        if (j + 2 == col.size())
+        {
+          next[i].push_back(mkXor(col[j], col[j + 1]));
+          if (i + 1 < width)
+          {
+            next[i + 1].push_back(mkAnd(col[j], col[j + 1]));
+          }
+          j += 2;
+        }
+      }
+      for (; j < col.size(); ++j)
+      {
+        next[i].push_back(col[j]);
+      }
+    }
+    columns.swap(next);
+    for (unsigned i = 0; i < width; ++i)
+    {
+      reduced = reduced && columns[i].size() <= 2;
+    }
+  }
+
+  std::vector<T> a, b;
+  for (unsigned i = 0; i < width; ++i)
+  {
+    a.push_back(columns[i].size() > 0 ? columns[i][0] : mkFalse<T>());
+    b.push_back(columns[i].size() > 1 ? columns[i][1] : mkFalse<T>());
+  }
+  rippleCarryAdder(a, b, res, mkFalse<T>());
+}
+
+/**
+ * Constructs a multiplier summing the array of partial products a[j] & b[i]
+ * with a Wallace tree.
+ */
+template <class T>
+inline void wallaceMultiplier(const std::vector<T>& a,
+                              const std::vector<T>& b,
+                              std::vector<T>& res)
+{
+  Assert(a.size() == b.size() && res.size() == 0);
+  unsigned width = a.size();
+  std::vector<std::vector<T>> columns(width);
+  for (unsigned i = 0; i < width; ++i)
+  {
+    for (unsigned j = 0; i + j < width; ++j)
+    {
+      columns[i + j].push_back(mkAnd(b[i], a[j]));
+    }
+  }
+  wallaceTreeAdder(columns, res);
+}
+
+/**
+ * Constructs a multiplier recoding b in radix-4 Booth digits, which halves
+ * the number of partial products, and summing the partial products with a
+ * Wallace tree. As the product is computed modulo 2^width, the partial
+ * products need no sign extension.
+ */
+template <class T>
+inline void boothMultiplier(const std::vector<T>& a,
+                            const std::vector<T>& b,
+                            std::vector<T>& res)
+{
+  Assert(a.size() == b.size() && res.size() == 0);
+  unsigned width = a.size();
+  std::vector<std::vector<T>> columns(width);
+  for (unsigned i = 0; i < width; i += 2)
+  {
+    // the digit -2 * next + cur + prev, in {-2, -1, 0, 1, 2}
+    T prev = i == 0 ? mkFalse<T>() : b[i - 1];
+    T cur = b[i];
+    T next = i + 1 < width ? b[i + 1] : mkFalse<T>();
+    T one = mkXor(cur, prev);
+    T two = mkOr(mkAnd(next, mkAnd(mkNot(cur), mkNot(prev))),
+                 mkAnd(mkNot(next), mkAnd(cur, prev)));
+    T neg = next;
+    for (unsigned j = 0; i + j < width; ++j)
+    {
+      T pp = j == 0 ? mkAnd(one, a[j])
+                    : mkOr(mkAnd(one, a[j]), mkAnd(two, a[j - 1]));
+      columns[i + j].push_back(mkXor(pp, neg));
+    }
+    // a negative partial product is the complement plus one
+    columns[i].push_back(neg);
+  }
+  wallaceTreeAdder(columns, res);
+}
+
+/**
+ * Constructs a non-restoring divider computing the quotient q and the
+ * remainder r of a and b. Each step adds or subtracts b from the partial
+ * remainder with a single adder, depending on its sign, instead of
+ * subtracting and restoring it. Division by zero yields the quotient
+ * 11..11 and the remainder a without any special case.
+ */
+template <class T>
+inline void nonRestoringDivider(const std::vector<T>& a,
+                                const std::vector<T>& b,
+                                std::vector<T>& q,
+                                std::vector<T>& r)
+{
+  Assert(a.size() == b.size() && q.size() == 0 && r.size() == 0);
+  unsigned width = a.size();
+  // the partial remainder is in [-b, b), and twice that plus one bit needs
+  // two more bits than b
+  std::vector<T> d(b);
+  d.push_back(mkFalse<T>());
+  d.push_back(mkFalse<T>());
+  std::vector<T> rem;
+  makeZero(rem, width + 2);
+  T nonNegative = mkTrue<T>();
+  q.resize(width);
+  for (unsigned k = width; k-- > 0;)
+  {
+    // rem = 2 * rem + a[k]
+    rem.pop_back();
+    rem.insert(rem.begin(), a[k]);
+    // rem = rem - d if rem was non-negative, rem + d otherwise
+    std::vector<T> operand, sum;
+    for (unsigned i = 0; i < d.size(); ++i)
+    {
+      operand.push_back(mkXor(d[i], nonNegative));
+    }
+    rippleCarryAdder(rem, operand, sum, nonNegative);
+    rem = sum;
+    nonNegative = mkNot(rem.back());
+    q[k] = nonNegative;
+  }
+  // a negative final remainder is corrected by adding d
+  std::vector<T> operand, sum;
+  for (unsigned i = 0; i < d.size(); ++i)
+  {
+    operand.push_back(mkAnd(mkNot(nonNegative), d[i]));
+  }
+  rippleCarryAdder(rem, operand, sum, mkFalse<T>());
+  extractBits(sum, r, 0, width - 1);
+}
+
 template <class T>
 T inline uLessThanBB(const std::vector<T>&a, const std::vector<T>& b, bool orEqual) {
   Assert(a.size() && b.size());
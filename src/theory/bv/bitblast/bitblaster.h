@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "expr/node.h"
+#include "options/bv_options.h"
 #include "prop/bv_sat_solver_notify.h"
 #include "prop/cnf_stream.h"
 #include "prop/registrar.h"
@@ -156,12 +157,29 @@ void TBitblaster<T>::initTermBBStrategies()
   d_termBBStrategies[kind::BITVECTOR_NAND] = DefaultNandBB<T>;
   d_termBBStrategies[kind::BITVECTOR_NOR] = DefaultNorBB<T>;
   d_termBBStrategies[kind::BITVECTOR_COMP] = DefaultCompBB<T>;
-  d_termBBStrategies[kind::BITVECTOR_MULT] = DefaultMultBB<T>;
   d_termBBStrategies[kind::BITVECTOR_PLUS] = DefaultPlusBB<T>;
   d_termBBStrategies[kind::BITVECTOR_SUB] = DefaultSubBB<T>;
   d_termBBStrategies[kind::BITVECTOR_NEG] = DefaultNegBB<T>;
-  d_termBBStrategies[kind::BITVECTOR_UDIV] = DefaultUdivBB<T>;
-  d_termBBStrategies[kind::BITVECTOR_UREM] = DefaultUremBB<T>;
+  switch (options::bvMultBB())
+  {
+    case options::BVMultBBMode::WALLACE:
+      d_termBBStrategies[kind::BITVECTOR_MULT] = WallaceMultBB<T>;
+      break;
+    case options::BVMultBBMode::BOOTH:
+      d_termBBStrategies[kind::BITVECTOR_MULT] = BoothMultBB<T>;
+      break;
+    default: d_termBBStrategies[kind::BITVECTOR_MULT] = DefaultMultBB<T>;
+  }
+  if (options::bvDivBB() == options::BVDivBBMode::NON_RESTORING)
+  {
+    d_termBBStrategies[kind::BITVECTOR_UDIV] = NonRestoringUdivBB<T>;
+    d_termBBStrategies[kind::BITVECTOR_UREM] = NonRestoringUremBB<T>;
+  }
+  else
+  {
+    d_termBBStrategies[kind::BITVECTOR_UDIV] = DefaultUdivBB<T>;
+    d_termBBStrategies[kind::BITVECTOR_UREM] = DefaultUremBB<T>;
+  }
   d_termBBStrategies[kind::BITVECTOR_SDIV] = UndefinedTermBBStrategy<T>;
   d_termBBStrategies[kind::BITVECTOR_SREM] = UndefinedTermBBStrategy<T>;
   d_termBBStrategies[kind::BITVECTOR_SMOD] = UndefinedTermBBStrategy<T>;
@@ -20,6 +20,7 @@
 #include "options/bv_options.h"
 #include "options/smt_options.h"
 #include "prop/cnf_stream.h"
+#include "prop/dimacs_sat_solver.h"
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_statistics_registry.h"
@@ -39,6 +40,7 @@ EagerBitblaster::EagerBitblaster(BVSolverLazy* theory_bv, context::Context* c)
       d_bv(theory_bv),
       d_bbAtoms(),
       d_variables(),
+      d_templates(options::bvBBTemplates() ? new BBTemplateCache() : nullptr),
       d_notify()
 {
   prop::SatSolver *solver = nullptr;
@@ -68,6 +70,14 @@ EagerBitblaster::EagerBitblaster(BVSolverLazy* theory_bv, context::Context* c)
       break;
     default: Unreachable() << "Unknown SAT solver type";
   }
+  prop::DimacsSatSolver* dimacs = nullptr;
+  if (!options::bvExportDimacs().empty()
+      || !options::bvImportSatModel().empty())
+  {
+    dimacs = new prop::DimacsSatSolver(
+        solver, options::bvExportDimacs(), options::bvImportSatModel());
+    solver = dimacs;
+  }
   d_satSolver.reset(solver);
   ResourceManager* rm = smt::currentResourceManager();
   d_cnfStream.reset(new prop::CnfStream(d_satSolver.get(),
@@ -77,6 +87,10 @@ EagerBitblaster::EagerBitblaster(BVSolverLazy* theory_bv, context::Context* c)
                                         rm,
                                         prop::FormulaLitPolicy::INTERNAL,
                                         "EagerBitblaster"));
+  if (dimacs != nullptr)
+  {
+    dimacs->setCnfStream(d_cnfStream.get());
+  }
 }
 
 EagerBitblaster::~EagerBitblaster() {}
@@ -152,7 +166,14 @@ void EagerBitblaster::bbTerm(TNode node, Bits& bits) {
   d_bv->spendResource(ResourceManager::Resource::BitblastStep);
   Debug("bitvector-bitblast") << "Bitblasting node " << node << "\n";
 
-  d_termBBStrategies[node.getKind()](node, bits, this);
+  if (d_templates != nullptr && BBTemplateCache::hasTemplate(node.getKind()))
+  {
+    d_templates->bbTerm(node, this, bits);
+  }
+  else
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+  }
 
   Assert(bits.size() == utils::getSize(node));
 
@@ -23,6 +23,7 @@
 #include <unordered_set>
 
 #include "theory/bv/bitblast/bitblaster.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
 
 #include "prop/sat_solver.h"
 
@@ -64,6 +65,8 @@ class EagerBitblaster : public TBitblaster<Node>
   BVSolverLazy* d_bv;
   TNodeSet d_bbAtoms;
   TNodeSet d_variables;
+  /** Templates for bit-blasting terms (only with options::bvBBTemplates()). */
+  std::unique_ptr<BBTemplateCache> d_templates;
 
   // This is either an MinisatEmptyNotify or NULL.
   std::unique_ptr<MinisatEmptyNotify> d_notify;
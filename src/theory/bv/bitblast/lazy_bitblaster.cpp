@@ -69,6 +69,7 @@ TLazyBitblaster::TLazyBitblaster(context::Context* c,
       d_assertedAtoms(new (true) context::CDList<prop::SatLiteral>(c)),
       d_explanations(new (true) ExplanationMap(c)),
       d_variables(),
+      d_templates(options::bvBBTemplates() ? new BBTemplateCache() : nullptr),
       d_bbAtoms(),
       d_abstraction(NULL),
       d_emptyNotify(emptyNotify),
@@ -230,7 +231,14 @@ void TLazyBitblaster::bbTerm(TNode node, Bits& bits) {
   Debug("bitvector-bitblast") << "Bitblasting term " << node <<"\n";
   ++d_statistics.d_numTerms;
 
-  d_termBBStrategies[node.getKind()] (node, bits,this);
+  if (d_templates != nullptr && BBTemplateCache::hasTemplate(node.getKind()))
+  {
+    d_templates->bbTerm(node, this, bits);
+  }
+  else
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+  }
 
   Assert(bits.size() == utils::getSize(node));
 
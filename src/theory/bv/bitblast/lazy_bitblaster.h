@@ -20,6 +20,7 @@
 #define CVC4__THEORY__BV__BITBLAST__LAZY_BITBLASTER_H
 
 #include "theory/bv/bitblast/bitblaster.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
 
 #include "context/cdhashmap.h"
 #include "context/cdlist.h"
@@ -139,6 +140,8 @@ class TLazyBitblaster : public TBitblaster<Node>
                                     for the propagated literals. Only used when
                                     bvEagerPropagate option enabled. */
   TNodeSet d_variables;
+  /** Templates for bit-blasting terms (only with options::bvBBTemplates()). */
+  std::unique_ptr<BBTemplateCache> d_templates;
   TNodeSet d_bbAtoms;
   AbstractionModule* d_abstraction;
   bool d_emptyNotify;
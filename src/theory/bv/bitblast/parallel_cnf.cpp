@@ -0,0 +1,305 @@
+/*********************                                                        */
+/*! \file parallel_cnf.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Parallel CNF conversion of bit-blasted atoms
+ **
+ ** Parallel CNF conversion of bit-blasted atoms.
+ **/
+
+#include "theory/bv/bitblast/parallel_cnf.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "smt/smt_statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+const uint32_t ParallelCnf::s_end = std::numeric_limits<uint32_t>::max();
+
+namespace {
+
+/** Remove the negations on top of n */
+TNode stripNot(TNode n, bool& negated)
+{
+  while (n.getKind() == kind::NOT)
+  {
+    negated = !negated;
+    n = n[0];
+  }
+  return n;
+}
+
+}  // namespace
+
+ParallelCnf::ParallelCnf(prop::CnfStream* cnf,
+                         prop::SatSolver* satSolver,
+                         unsigned numThreads,
+                         const std::string& name)
+    : d_cnf(cnf),
+      d_satSolver(satSolver),
+      d_numThreads(numThreads),
+      d_statistics(name)
+{
+}
+
+bool ParallelCnf::isGate(TNode n) const
+{
+  if (d_cnf->hasLiteral(n))
+  {
+    return false;
+  }
+  switch (n.getKind())
+  {
+    /* The atoms are bit-blasted, EQUAL and ITE can only be Boolean. */
+    case kind::AND:
+    case kind::OR:
+    case kind::XOR:
+    case kind::EQUAL:
+    case kind::IMPLIES:
+    case kind::ITE: return true;
+    default: return false;
+  }
+}
+
+uint32_t ParallelCnf::localLit(const Buffer& buf, TNode n)
+{
+  bool negated = false;
+  n = stripNot(n, negated);
+  auto it = buf.d_varOf.find(n);
+  Assert(it != buf.d_varOf.end());
+  return 2 * it->second + (negated ? 1 : 0);
+}
+
+void ParallelCnf::convert(const std::vector<Node>& atoms,
+                          size_t begin,
+                          size_t end,
+                          Buffer& buf) const
+{
+  /* Only TNodes are used here, which does not touch reference counts. */
+  std::vector<std::pair<TNode, bool>> visit;
+  for (size_t i = begin; i < end; ++i)
+  {
+    bool negated = false;
+    visit.emplace_back(stripNot(atoms[i], negated), false);
+    while (!visit.empty())
+    {
+      TNode cur = visit.back().first;
+      if (buf.d_varOf.find(cur) != buf.d_varOf.end())
+      {
+        visit.pop_back();
+        continue;
+      }
+      bool gate = isGate(cur);
+      if (!visit.back().second)
+      {
+        visit.back().second = true;
+        if (gate)
+        {
+          for (TNode child : cur)
+          {
+            bool neg = false;
+            visit.emplace_back(stripNot(child, neg), false);
+          }
+        }
+        continue;
+      }
+      visit.pop_back();
+
+      uint32_t var = buf.d_nodes.size();
+      buf.d_varOf[cur] = var;
+      buf.d_nodes.push_back(cur);
+      buf.d_defs.push_back(buf.d_lits.size());
+      if (!gate)
+      {
+        continue;
+      }
+
+      /* The definitional clauses of t <=> cur. */
+      std::vector<uint32_t>& lits = buf.d_lits;
+      uint32_t t = 2 * var;
+      switch (cur.getKind())
+      {
+        case kind::AND:
+        case kind::OR:
+        {
+          /* OR is AND with negated inputs and output. */
+          uint32_t flip = cur.getKind() == kind::OR ? 1 : 0;
+          for (TNode child : cur)
+          {
+            lits.insert(lits.end(),
+                        {(t ^ flip) ^ 1, localLit(buf, child) ^ flip, s_end});
+          }
+          lits.push_back(t ^ flip);
+          for (TNode child : cur)
+          {
+            lits.push_back(localLit(buf, child) ^ flip ^ 1);
+          }
+          lits.push_back(s_end);
+          break;
+        }
+        case kind::XOR:
+        case kind::EQUAL:
+        {
+          Assert(cur.getNumChildren() == 2);
+          /* EQUAL is XOR with negated output. */
+          uint32_t u = cur.getKind() == kind::EQUAL ? t ^ 1 : t;
+          uint32_t a = localLit(buf, cur[0]);
+          uint32_t b = localLit(buf, cur[1]);
+          lits.insert(lits.end(), {u ^ 1, a, b, s_end});
+          lits.insert(lits.end(), {u ^ 1, a ^ 1, b ^ 1, s_end});
+          lits.insert(lits.end(), {u, a ^ 1, b, s_end});
+          lits.insert(lits.end(), {u, a, b ^ 1, s_end});
+          break;
+        }
+        case kind::IMPLIES:
+        {
+          uint32_t a = localLit(buf, cur[0]);
+          uint32_t b = localLit(buf, cur[1]);
+          lits.insert(lits.end(), {t, a, s_end});
+          lits.insert(lits.end(), {t, b ^ 1, s_end});
+          lits.insert(lits.end(), {t ^ 1, a ^ 1, b, s_end});
+          break;
+        }
+        case kind::ITE:
+        {
+          uint32_t c = localLit(buf, cur[0]);
+          uint32_t a = localLit(buf, cur[1]);
+          uint32_t b = localLit(buf, cur[2]);
+          lits.insert(lits.end(), {t ^ 1, c ^ 1, a, s_end});
+          lits.insert(lits.end(), {t ^ 1, c, b, s_end});
+          lits.insert(lits.end(), {t, c ^ 1, a ^ 1, s_end});
+          lits.insert(lits.end(), {t, c, b ^ 1, s_end});
+          break;
+        }
+        default: Unreachable();
+      }
+    }
+  }
+  buf.d_defs.push_back(buf.d_lits.size());
+}
+
+void ParallelCnf::merge(const Buffer& buf)
+{
+  std::vector<prop::SatLiteral> global(buf.d_nodes.size());
+  for (size_t i = 0, size = buf.d_nodes.size(); i < size; ++i)
+  {
+    TNode n = buf.d_nodes[i];
+    size_t defBegin = buf.d_defs[i], defEnd = buf.d_defs[i + 1];
+    if (d_cnf->hasLiteral(n))
+    {
+      /* Defined by a buffer merged before. */
+      global[i] = d_cnf->getLiteral(n);
+      if (defBegin != defEnd)
+      {
+        ++d_statistics.d_numSharedGates;
+      }
+      continue;
+    }
+    if (defBegin == defEnd)
+    {
+      d_cnf->ensureLiteral(n);
+      global[i] = d_cnf->getLiteral(n);
+      continue;
+    }
+    global[i] = d_cnf->newDefinedLiteral(n);
+    ++d_statistics.d_numGates;
+    prop::SatClause clause;
+    for (size_t j = defBegin; j < defEnd; ++j)
+    {
+      uint32_t lit = buf.d_lits[j];
+      if (lit == s_end)
+      {
+        d_satSolver->addClause(clause, false);
+        clause.clear();
+        continue;
+      }
+      Assert((lit >> 1) <= i);
+      prop::SatLiteral glit = global[lit >> 1];
+      clause.push_back((lit & 1) ? ~glit : glit);
+    }
+    Assert(clause.empty());
+  }
+}
+
+void ParallelCnf::ensureLiterals(const std::vector<Node>& atoms)
+{
+  size_t numChunks = std::min<size_t>(d_numThreads, atoms.size());
+  if (numChunks <= 1)
+  {
+    for (const Node& atom : atoms)
+    {
+      d_cnf->ensureLiteral(atom);
+    }
+    return;
+  }
+  ++d_statistics.d_numCalls;
+
+  std::vector<Buffer> bufs(numChunks);
+  {
+    TimerStat::CodeTimer convertTimer(d_statistics.d_convertTime);
+    size_t chunkSize = (atoms.size() + numChunks - 1) / numChunks;
+    std::vector<std::thread> threads;
+    for (size_t c = 1; c < numChunks; ++c)
+    {
+      size_t begin = std::min(c * chunkSize, atoms.size());
+      size_t end = std::min(begin + chunkSize, atoms.size());
+      threads.emplace_back([this, &atoms, begin, end, &bufs, c]() {
+        convert(atoms, begin, end, bufs[c]);
+      });
+    }
+    convert(atoms, 0, std::min(chunkSize, atoms.size()), bufs[0]);
+    for (std::thread& t : threads)
+    {
+      t.join();
+    }
+  }
+
+  TimerStat::CodeTimer mergeTimer(d_statistics.d_mergeTime);
+  for (const Buffer& buf : bufs)
+  {
+    merge(buf);
+  }
+  Debug("bv-parallel-cnf") << "converted " << atoms.size() << " atoms in "
+                           << numChunks << " chunks" << std::endl;
+}
+
+ParallelCnf::Statistics::Statistics(const std::string& name)
+    : d_convertTime(name + "::ParallelCnf::ConvertTime"),
+      d_mergeTime(name + "::ParallelCnf::MergeTime"),
+      d_numCalls(name + "::ParallelCnf::NumCalls", 0),
+      d_numGates(name + "::ParallelCnf::NumGates", 0),
+      d_numSharedGates(name + "::ParallelCnf::NumSharedGates", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_convertTime);
+  smtStatisticsRegistry()->registerStat(&d_mergeTime);
+  smtStatisticsRegistry()->registerStat(&d_numCalls);
+  smtStatisticsRegistry()->registerStat(&d_numGates);
+  smtStatisticsRegistry()->registerStat(&d_numSharedGates);
+}
+
+ParallelCnf::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_convertTime);
+  smtStatisticsRegistry()->unregisterStat(&d_mergeTime);
+  smtStatisticsRegistry()->unregisterStat(&d_numCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_numGates);
+  smtStatisticsRegistry()->unregisterStat(&d_numSharedGates);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
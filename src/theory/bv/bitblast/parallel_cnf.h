@@ -0,0 +1,123 @@
+/*********************                                                        */
+/*! \file parallel_cnf.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Parallel CNF conversion of bit-blasted atoms
+ **
+ ** Parallel CNF conversion of bit-blasted atoms.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BITBLAST__PARALLEL_CNF_H
+#define CVC4__THEORY__BV__BITBLAST__PARALLEL_CNF_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "prop/cnf_stream.h"
+#include "prop/sat_solver.h"
+#include "util/statistics_registry.h"
+#include "util/stats_timer.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+/**
+ * Tseitin conversion of the bit-blasted atoms to CNF in several threads.
+ *
+ * The atoms are split into as many chunks as there are threads, and each
+ * thread converts the cones of its chunk to clauses over its own variables,
+ * in a buffer. The buffers are then merged into the SAT solver one after the
+ * other by the calling thread, which renumbers the variables of each buffer:
+ * the leaves and the formulas that already have a literal in the CNF stream,
+ * including the ones defined by the buffers merged before, get their
+ * literal, and the other formulas get a new literal and their clauses.
+ *
+ * The nodes cannot be created or reference counted by several threads, the
+ * threads only traverse the bit-blasted atoms, which must not contain theory
+ * atoms other than bits and Boolean variables. The bit-blasting itself stays
+ * sequential.
+ */
+class ParallelCnf
+{
+ public:
+  ParallelCnf(prop::CnfStream* cnf,
+              prop::SatSolver* satSolver,
+              unsigned numThreads,
+              const std::string& name);
+  ~ParallelCnf() {}
+
+  /**
+   * Ensure that each of atoms has a literal in the CNF stream that is
+   * definitionally equal to it.
+   */
+  void ensureLiterals(const std::vector<Node>& atoms);
+
+ private:
+  /** The clauses of a chunk over local variables */
+  struct Buffer
+  {
+    /** The local variable of each formula or leaf */
+    std::unordered_map<TNode, uint32_t, TNodeHashFunction> d_varOf;
+    /** The formula or leaf of each local variable, children first */
+    std::vector<TNode> d_nodes;
+    /**
+     * The definitional clauses of the local variables, the clauses of
+     * variable i being the ones in between d_defs[i] and d_defs[i+1] in
+     * d_lits. A literal is twice its variable plus one if it is negated, and
+     * the clauses are terminated by s_end.
+     */
+    std::vector<size_t> d_defs;
+    std::vector<uint32_t> d_lits;
+  };
+
+  /** Convert the atoms in between begin and end to clauses in buf */
+  void convert(const std::vector<Node>& atoms,
+               size_t begin,
+               size_t end,
+               Buffer& buf) const;
+  /** Get the local literal of n in buf, which must have its variable */
+  static uint32_t localLit(const Buffer& buf, TNode n);
+  /** Whether the conversion defines n by clauses or takes it as a leaf */
+  bool isGate(TNode n) const;
+  /** Add the clauses of buf to the SAT solver */
+  void merge(const Buffer& buf);
+
+  /** The terminator of the clauses in the buffers */
+  static const uint32_t s_end;
+
+  prop::CnfStream* d_cnf;
+  prop::SatSolver* d_satSolver;
+  unsigned d_numThreads;
+
+  class Statistics
+  {
+   public:
+    TimerStat d_convertTime;
+    TimerStat d_mergeTime;
+    IntStat d_numCalls;
+    IntStat d_numGates;
+    IntStat d_numSharedGates;
+    Statistics(const std::string& name);
+    ~Statistics();
+  };
+  Statistics d_statistics;
+}; /* class ParallelCnf */
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__BV__BITBLAST__PARALLEL_CNF_H */
@@ -14,6 +14,10 @@
  **/
 #include "theory/bv/bitblast/simple_bitblaster.h"
 
+#include <algorithm>
+
+#include "options/bv_options.h"
+
 #include "theory/theory_model.h"
 #include "theory/theory_state.h"
 
@@ -21,7 +25,13 @@ namespace cvc5 {
 namespace theory {
 namespace bv {
 
-BBSimple::BBSimple(TheoryState* s) : TBitblaster<Node>(), d_state(s) {}
+BBSimple::BBSimple(TheoryState* s)
+    : TBitblaster<Node>(),
+      d_templates(options::bvBBTemplates() ? new BBTemplateCache() : nullptr),
+      d_abstract(options::bvAbstractArith()),
+      d_state(s)
+{
+}
 
 void BBSimple::bbAtom(TNode node)
 {
@@ -81,11 +91,64 @@ void BBSimple::bbTerm(TNode node, Bits& bits)
     getBBTerm(node, bits);
     return;
   }
-  d_termBBStrategies[node.getKind()](node, bits, this);
+  Kind k = node.getKind();
+  if (d_abstract
+      && (k == kind::BITVECTOR_MULT || k == kind::BITVECTOR_UDIV
+          || k == kind::BITVECTOR_UREM)
+      && utils::getSize(node) >= options::bvAbstractArithWidth())
+  {
+    /* Bit-blast the children, so that the model gives them values, and
+     * abstract the term by its own fresh bits. */
+    for (const Node& child : node)
+    {
+      Bits child_bits;
+      bbTerm(child, child_bits);
+    }
+    for (unsigned i = 0, size = utils::getSize(node); i < size; ++i)
+    {
+      bits.push_back(utils::mkBitOf(node, i));
+    }
+    d_abstractions.push_back(node);
+  }
+  else if (d_templates != nullptr && BBTemplateCache::hasTemplate(k))
+  {
+    d_templates->bbTerm(node, this, bits);
+  }
+  else
+  {
+    d_termBBStrategies[k](node, bits, this);
+  }
   Assert(bits.size() == utils::getSize(node));
   storeBBTerm(node, bits);
 }
 
+Node BBSimple::refine(TNode term)
+{
+  auto it = std::find(d_abstractions.begin(), d_abstractions.end(), term);
+  Assert(it != d_abstractions.end());
+  d_abstractions.erase(it);
+
+  Bits bits, precise;
+  getBBTerm(term, bits);
+  if (d_templates != nullptr && BBTemplateCache::hasTemplate(term.getKind()))
+  {
+    d_templates->bbTerm(term, this, precise);
+  }
+  else
+  {
+    d_termBBStrategies[term.getKind()](term, precise, this);
+  }
+  Assert(bits.size() == precise.size());
+
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> eqs;
+  for (size_t i = 0, size = bits.size(); i < size; ++i)
+  {
+    eqs.push_back(nm->mkNode(kind::EQUAL, bits[i], precise[i]));
+  }
+  return nm->mkAnd(eqs);
+}
+
 Node BBSimple::getStoredBBAtom(TNode node)
 {
   bool negated = false;
@@ -100,6 +163,36 @@ Node BBSimple::getStoredBBAtom(TNode node)
   return negated ? atom_bb.negate() : atom_bb;
 }
 
+Node BBSimple::bbFormula(TNode node)
+{
+  std::vector<Node> atoms, atoms_bb;
+  std::vector<TNode> visit;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  visit.push_back(node);
+  do
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    /* Boolean nodes over bit-vectors are atoms, other Boolean nodes are
+     * connectives whose children are traversed. */
+    if (cur.getNumChildren() > 0 && cur[0].getType().isBitVector())
+    {
+      bbAtom(cur);
+      atoms.push_back(cur);
+      atoms_bb.push_back(getStoredBBAtom(cur));
+      continue;
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  } while (!visit.empty());
+
+  return node.substitute(
+      atoms.begin(), atoms.end(), atoms_bb.begin(), atoms_bb.end());
+}
+
 Node BBSimple::getModelFromSatSolver(TNode a, bool fullModel)
 {
   if (!hasBBTerm(a))
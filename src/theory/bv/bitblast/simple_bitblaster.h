@@ -18,6 +18,7 @@
 #define CVC4__THEORY__BV__BITBLAST_SIMPLE_BITBLASTER_H
 
 #include "theory/bv/bitblast/bitblaster.h"
+#include "theory/bv/bitblast/bitblast_template_cache.h"
 
 namespace cvc5 {
 namespace theory {
@@ -50,6 +51,11 @@ class BBSimple : public TBitblaster<Node>
   bool hasBBAtom(TNode atom) const override;
   /** Get bit-blasted node stored for atom. */
   Node getStoredBBAtom(TNode node);
+  /**
+   * Bit-blast the bit-vector atoms of Boolean formula 'node' and return the
+   * formula with its atoms replaced by their bit-blasted nodes.
+   */
+  Node bbFormula(TNode node);
   /** Create 'bits' for variable 'var'. */
   void makeVariable(TNode var, Bits& bits) override;
 
@@ -61,12 +67,30 @@ class BBSimple : public TBitblaster<Node>
   /** Checks whether node is a variable introduced via `makeVariable`.*/
   bool isVariable(TNode node);
 
+  /**
+   * Get the terms whose bits are abstracted by fresh bits and not refined
+   * yet (only with options::bvAbstractArith()). Their children are
+   * bit-blasted.
+   */
+  const std::vector<Node>& getAbstractions() const { return d_abstractions; }
+  /**
+   * Refine the abstraction of term, return the formula equating its fresh
+   * bits with the bits of the precise bit-blasting of term.
+   */
+  Node refine(TNode term);
+
  private:
   /** Query SAT solver for assignment of node 'a'. */
   Node getModelFromSatSolver(TNode a, bool fullModel) override;
 
   /** Caches variables for which we already created bits. */
   TNodeSet d_variables;
+  /** Templates for bit-blasting terms (only with options::bvBBTemplates()). */
+  std::unique_ptr<BBTemplateCache> d_templates;
+  /** Whether to abstract multiplications, divisions and remainders. */
+  bool d_abstract;
+  /** The abstracted terms that are not refined yet. */
+  std::vector<Node> d_abstractions;
   /** Stores bit-blasted atoms. */
   std::unordered_map<Node, Node, NodeHashFunction> d_bbAtoms;
   /** Theory state. */
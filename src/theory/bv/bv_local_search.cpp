@@ -0,0 +1,749 @@
+/*********************                                                        */
+/*! \file bv_local_search.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Word-level local search for bit-vector models
+ **
+ ** Word-level propagation-based local search for bit-vector models.
+ **/
+
+#include "theory/bv/bv_local_search.h"
+
+#include <functional>
+#include <queue>
+#include <unordered_set>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/theory.h"
+#include "util/random.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/** The probability of a move to pick an inverse value over a random one */
+const double s_probInverse = 0.9;
+
+BitVector mkBool(bool b)
+{
+  return b ? BitVector::mkOne(1) : BitVector::mkZero(1);
+}
+
+/** Get the number of trailing zeros of the non-zero value x */
+unsigned countTrailingZeros(const BitVector& x)
+{
+  unsigned k = 0;
+  while (!x.isBitSet(k))
+  {
+    ++k;
+  }
+  return k;
+}
+
+/** Get the multiplicative inverse of the odd value x */
+BitVector inverseOdd(const BitVector& x)
+{
+  // x is its own inverse modulo 8, and each Newton step doubles the number
+  // of correct low bits
+  BitVector two(x.getSize(), 2u);
+  BitVector y = x;
+  for (unsigned correct = 3; correct < x.getSize(); correct *= 2)
+  {
+    y = y * (two - x * y);
+  }
+  return y;
+}
+
+}  // namespace
+
+BVLocalSearch::BVLocalSearch(const std::string& name) : d_statistics(name) {}
+
+BitVector BVLocalSearch::randomValue(unsigned width)
+{
+  Integer value;
+  for (unsigned i = 0; i < width; i += 64)
+  {
+    value = value.multiplyByPow2(64) + Integer(Random::getRandom().rand());
+  }
+  return BitVector(width, value);
+}
+
+BitVector BVLocalSearch::randomValue(const BitVector& lo, const BitVector& hi)
+{
+  BitVector span = hi - lo + BitVector::mkOne(lo.getSize());
+  BitVector r = randomValue(lo.getSize());
+  // a span of zero is the full range
+  return span.getValue().isZero() ? r : lo + r.unsignedRemTotal(span);
+}
+
+bool BVLocalSearch::solve(const std::vector<Node>& facts, uint64_t maxMoves)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_time);
+  ++d_statistics.d_numCalls;
+  if (!build(facts))
+  {
+    Trace("bv-ls") << "BVLocalSearch: unsupported facts" << std::endl;
+    ++d_statistics.d_numUnsupported;
+    return false;
+  }
+
+  uint64_t moves = 0;
+  while (!d_unsatRoots.empty() && moves < maxMoves)
+  {
+    size_t r =
+        d_unsatRoots[Random::getRandom().pick(0, d_unsatRoots.size() - 1)];
+    move(r);
+    ++moves;
+  }
+  d_statistics.d_numMoves += moves;
+  Trace("bv-ls") << "BVLocalSearch: " << d_unsatRoots.size()
+                 << " unsatisfied facts after " << moves << " moves"
+                 << std::endl;
+  if (!d_unsatRoots.empty())
+  {
+    return false;
+  }
+  ++d_statistics.d_numSolved;
+  for (const Node& leaf : d_leaves)
+  {
+    d_model[leaf] = d_vertices[d_vertexOf[leaf]].d_value;
+  }
+  return true;
+}
+
+Node BVLocalSearch::getValue(TNode leaf) const
+{
+  auto it = d_model.find(leaf);
+  if (it == d_model.end())
+  {
+    return Node();
+  }
+  return utils::mkConst(it->second);
+}
+
+bool BVLocalSearch::build(const std::vector<Node>& facts)
+{
+  d_vertices.clear();
+  d_vertexOf.clear();
+  d_leaves.clear();
+  d_isRoot.clear();
+  d_unsatRoots.clear();
+  d_unsatPos.clear();
+
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  for (const Node& fact : facts)
+  {
+    visit.push_back(fact);
+    do
+    {
+      TNode cur = visit.back();
+      if (d_vertexOf.find(cur) != d_vertexOf.end())
+      {
+        visit.pop_back();
+        continue;
+      }
+      bool isLeaf = cur.isConst()
+                    || (cur.getType().isBitVector()
+                        && Theory::isLeafOf(cur, THEORY_BV));
+      if (!isLeaf && visited.insert(cur).second)
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+        continue;
+      }
+      visit.pop_back();
+      if (!addVertex(cur))
+      {
+        return false;
+      }
+    } while (!visit.empty());
+  }
+
+  d_isRoot.resize(d_vertices.size(), false);
+  for (const Node& fact : facts)
+  {
+    size_t r = d_vertexOf[fact];
+    if (!d_isRoot[r])
+    {
+      d_isRoot[r] = true;
+      updateRoot(r);
+    }
+  }
+  return true;
+}
+
+bool BVLocalSearch::addVertex(TNode n)
+{
+  size_t id = d_vertices.size();
+  Vertex v;
+  v.d_high = 0;
+  v.d_low = 0;
+
+  if (n.isConst())
+  {
+    v.d_kind = kind::CONST_BITVECTOR;
+    if (n.getKind() == kind::CONST_BOOLEAN)
+    {
+      v.d_value = mkBool(n.getConst<bool>());
+    }
+    else if (n.getKind() == kind::CONST_BITVECTOR)
+    {
+      v.d_value = n.getConst<BitVector>();
+    }
+    else
+    {
+      return false;
+    }
+  }
+  else if (n.getType().isBitVector() && Theory::isLeafOf(n, THEORY_BV))
+  {
+    // leaves have kind VARIABLE, and start with their value in the previous
+    // model, if any
+    v.d_kind = kind::VARIABLE;
+    auto it = d_model.find(n);
+    v.d_value = it != d_model.end() ? it->second
+                                    : BitVector::mkZero(utils::getSize(n));
+    d_leaves.push_back(n);
+  }
+  else
+  {
+    // Boolean operators are represented by their bit-vector counterpart,
+    // and the greater-than predicates by less-than with swapped children
+    bool swap = false;
+    v.d_kind = n.getKind();
+    switch (n.getKind())
+    {
+      case kind::NOT: v.d_kind = kind::BITVECTOR_NOT; break;
+      case kind::AND: v.d_kind = kind::BITVECTOR_AND; break;
+      case kind::OR: v.d_kind = kind::BITVECTOR_OR; break;
+      case kind::XOR: v.d_kind = kind::BITVECTOR_XOR; break;
+      case kind::EQUAL: v.d_kind = kind::BITVECTOR_COMP; break;
+      case kind::ITE: v.d_kind = kind::BITVECTOR_ITE; break;
+      case kind::BITVECTOR_ULTBV: v.d_kind = kind::BITVECTOR_ULT; break;
+      case kind::BITVECTOR_SLTBV: v.d_kind = kind::BITVECTOR_SLT; break;
+      case kind::BITVECTOR_UGT:
+        v.d_kind = kind::BITVECTOR_ULT;
+        swap = true;
+        break;
+      case kind::BITVECTOR_UGE:
+        v.d_kind = kind::BITVECTOR_ULE;
+        swap = true;
+        break;
+      case kind::BITVECTOR_SGT:
+        v.d_kind = kind::BITVECTOR_SLT;
+        swap = true;
+        break;
+      case kind::BITVECTOR_SGE:
+        v.d_kind = kind::BITVECTOR_SLE;
+        swap = true;
+        break;
+      case kind::BITVECTOR_EXTRACT:
+        v.d_high = utils::getExtractHigh(n);
+        v.d_low = utils::getExtractLow(n);
+        break;
+      case kind::BITVECTOR_ZERO_EXTEND:
+      case kind::BITVECTOR_SIGN_EXTEND:
+        v.d_low = utils::getSize(n) - utils::getSize(n[0]);
+        break;
+      case kind::BITVECTOR_CONCAT:
+      case kind::BITVECTOR_AND:
+      case kind::BITVECTOR_OR:
+      case kind::BITVECTOR_XOR:
+      case kind::BITVECTOR_NOT:
+      case kind::BITVECTOR_NAND:
+      case kind::BITVECTOR_NOR:
+      case kind::BITVECTOR_XNOR:
+      case kind::BITVECTOR_COMP:
+      case kind::BITVECTOR_MULT:
+      case kind::BITVECTOR_NEG:
+      case kind::BITVECTOR_PLUS:
+      case kind::BITVECTOR_SUB:
+      case kind::BITVECTOR_UDIV:
+      case kind::BITVECTOR_UREM:
+      case kind::BITVECTOR_ASHR:
+      case kind::BITVECTOR_LSHR:
+      case kind::BITVECTOR_SHL:
+      case kind::BITVECTOR_ULE:
+      case kind::BITVECTOR_ULT:
+      case kind::BITVECTOR_SLE:
+      case kind::BITVECTOR_SLT:
+      case kind::BITVECTOR_REDAND:
+      case kind::BITVECTOR_REDOR:
+      case kind::BITVECTOR_ITE: break;
+      default:
+        Trace("bv-ls") << "BVLocalSearch: unsupported term " << n << std::endl;
+        return false;
+    }
+    for (const Node& child : n)
+    {
+      Assert(d_vertexOf.find(child) != d_vertexOf.end());
+      size_t c = d_vertexOf[child];
+      v.d_children.push_back(c);
+      std::vector<size_t>& parents = d_vertices[c].d_parents;
+      if (parents.empty() || parents.back() != id)
+      {
+        parents.push_back(id);
+      }
+    }
+    if (swap)
+    {
+      std::swap(v.d_children[0], v.d_children[1]);
+    }
+    v.d_value = compute(v, childValues(v));
+  }
+  d_vertices.push_back(v);
+  d_vertexOf[n] = id;
+  return true;
+}
+
+std::vector<BitVector> BVLocalSearch::childValues(const Vertex& v) const
+{
+  std::vector<BitVector> args;
+  for (size_t c : v.d_children)
+  {
+    args.push_back(d_vertices[c].d_value);
+  }
+  return args;
+}
+
+BitVector BVLocalSearch::compute(const Vertex& v,
+                                 const std::vector<BitVector>& args) const
+{
+  BitVector res;
+  switch (v.d_kind)
+  {
+    case kind::BITVECTOR_CONCAT:
+      res = args[0];
+      for (size_t i = 1, size = args.size(); i < size; ++i)
+      {
+        res = res.concat(args[i]);
+      }
+      return res;
+    case kind::BITVECTOR_AND:
+      res = args[0];
+      for (size_t i = 1, size = args.size(); i < size; ++i)
+      {
+        res = res & args[i];
+      }
+      return res;
+    case kind::BITVECTOR_OR:
+      res = args[0];
+      for (size_t i = 1, size = args.size(); i < size; ++i)
+      {
+        res = res | args[i];
+      }
+      return res;
+    case kind::BITVECTOR_XOR:
+      res = args[0];
+      for (size_t i = 1, size = args.size(); i < size; ++i)
+      {
+        res = res ^ args[i];
+      }
+      return res;
+    case kind::BITVECTOR_MULT:
+      res = args[0];
+      for (size_t i = 1, size = args.size(); i < size; ++i)
+      {
+        res = res * args[i];
+      }
+      return res;
+    case kind::BITVECTOR_PLUS:
+      res = args[0];
+      for (size_t i = 1, size = args.size(); i < size; ++i)
+      {
+        res = res + args[i];
+      }
+      return res;
+    case kind::BITVECTOR_NOT: return ~args[0];
+    case kind::BITVECTOR_NAND: return ~(args[0] & args[1]);
+    case kind::BITVECTOR_NOR: return ~(args[0] | args[1]);
+    case kind::BITVECTOR_XNOR: return ~(args[0] ^ args[1]);
+    case kind::BITVECTOR_COMP: return mkBool(args[0] == args[1]);
+    case kind::BITVECTOR_NEG: return -args[0];
+    case kind::BITVECTOR_SUB: return args[0] - args[1];
+    case kind::BITVECTOR_UDIV: return args[0].unsignedDivTotal(args[1]);
+    case kind::BITVECTOR_UREM: return args[0].unsignedRemTotal(args[1]);
+    case kind::BITVECTOR_ASHR: return args[0].arithRightShift(args[1]);
+    case kind::BITVECTOR_LSHR: return args[0].logicalRightShift(args[1]);
+    case kind::BITVECTOR_SHL: return args[0].leftShift(args[1]);
+    case kind::BITVECTOR_ULE:
+      return mkBool(args[0].unsignedLessThanEq(args[1]));
+    case kind::BITVECTOR_ULT: return mkBool(args[0].unsignedLessThan(args[1]));
+    case kind::BITVECTOR_SLE: return mkBool(args[0].signedLessThanEq(args[1]));
+    case kind::BITVECTOR_SLT: return mkBool(args[0].signedLessThan(args[1]));
+    case kind::BITVECTOR_REDAND:
+      return mkBool(args[0] == BitVector::mkOnes(args[0].getSize()));
+    case kind::BITVECTOR_REDOR:
+      return mkBool(!args[0].getValue().isZero());
+    case kind::BITVECTOR_ITE: return args[0].isBitSet(0) ? args[1] : args[2];
+    case kind::BITVECTOR_EXTRACT: return args[0].extract(v.d_high, v.d_low);
+    case kind::BITVECTOR_ZERO_EXTEND: return args[0].zeroExtend(v.d_low);
+    case kind::BITVECTOR_SIGN_EXTEND: return args[0].signExtend(v.d_low);
+    default: Unreachable() << "Unexpected kind " << v.d_kind;
+  }
+  return res;
+}
+
+bool BVLocalSearch::inverseValue(const Vertex& v,
+                                 size_t pos,
+                                 const BitVector& target,
+                                 BitVector& x) const
+{
+  std::vector<BitVector> args = childValues(v);
+  unsigned width = args[pos].getSize();
+  BitVector zero = BitVector::mkZero(width);
+  BitVector one = BitVector::mkOne(width);
+  BitVector ones = BitVector::mkOnes(width);
+  // the value of the other child of binary operators
+  const BitVector& s = args.size() == 2 ? args[1 - pos] : args[0];
+
+  switch (v.d_kind)
+  {
+    case kind::BITVECTOR_NOT: x = ~target; break;
+    case kind::BITVECTOR_NEG: x = -target; break;
+    case kind::BITVECTOR_PLUS:
+      x = target;
+      for (size_t i = 0, size = args.size(); i < size; ++i)
+      {
+        if (i != pos)
+        {
+          x = x - args[i];
+        }
+      }
+      break;
+    case kind::BITVECTOR_XOR:
+      x = target;
+      for (size_t i = 0, size = args.size(); i < size; ++i)
+      {
+        if (i != pos)
+        {
+          x = x ^ args[i];
+        }
+      }
+      break;
+    case kind::BITVECTOR_XNOR: x = ~target ^ s; break;
+    case kind::BITVECTOR_SUB: x = pos == 0 ? target + s : s - target; break;
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_NAND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_NOR:
+    {
+      bool isAnd = v.d_kind == kind::BITVECTOR_AND
+                   || v.d_kind == kind::BITVECTOR_NAND;
+      BitVector t = (v.d_kind == kind::BITVECTOR_AND
+                     || v.d_kind == kind::BITVECTOR_OR)
+                        ? target
+                        : ~target;
+      BitVector other = isAnd ? ones : zero;
+      for (size_t i = 0, size = args.size(); i < size; ++i)
+      {
+        if (i != pos)
+        {
+          other = isAnd ? (other & args[i]) : (other | args[i]);
+        }
+      }
+      // the bits that are not fixed by the other children are random
+      BitVector r = randomValue(width);
+      x = isAnd ? (t | (r & ~other)) : ((t & ~other) | (r & t & other));
+      break;
+    }
+    case kind::BITVECTOR_MULT:
+    {
+      BitVector other = one;
+      for (size_t i = 0, size = args.size(); i < size; ++i)
+      {
+        if (i != pos)
+        {
+          other = other * args[i];
+        }
+      }
+      if (other.getValue().isZero())
+      {
+        return false;
+      }
+      unsigned k = countTrailingZeros(other);
+      if (!target.getValue().isZero() && countTrailingZeros(target) < k)
+      {
+        return false;
+      }
+      BitVector shift(width, k);
+      x = target.logicalRightShift(shift)
+          * inverseOdd(other.logicalRightShift(shift));
+      // the k high bits of x do not matter
+      BitVector mask = ones.logicalRightShift(shift);
+      x = (x & mask) | (randomValue(width) & ~mask);
+      break;
+    }
+    case kind::BITVECTOR_CONCAT:
+    {
+      unsigned offset = 0;
+      for (size_t i = pos + 1, size = args.size(); i < size; ++i)
+      {
+        offset += args[i].getSize();
+      }
+      x = target.extract(offset + width - 1, offset);
+      break;
+    }
+    case kind::BITVECTOR_COMP:
+      if (target.isBitSet(0))
+      {
+        x = s;
+      }
+      else
+      {
+        x = randomValue(width);
+        if (x == s)
+        {
+          x = x + one;
+        }
+      }
+      break;
+    case kind::BITVECTOR_ULT:
+    case kind::BITVECTOR_ULE:
+    case kind::BITVECTOR_SLT:
+    case kind::BITVECTOR_SLE:
+    {
+      bool isSigned = v.d_kind == kind::BITVECTOR_SLT
+                      || v.d_kind == kind::BITVECTOR_SLE;
+      bool strict = v.d_kind == kind::BITVECTOR_ULT
+                    || v.d_kind == kind::BITVECTOR_SLT;
+      // the signed order is the unsigned order with the sign bit flipped
+      BitVector flip = isSigned ? BitVector::mkMinSigned(width) : zero;
+      BitVector u = s ^ flip;
+      // x < u, x <= u, x > u or x >= u
+      bool below = (pos == 0) == target.isBitSet(0);
+      bool orEqual = target.isBitSet(0) != strict;
+      if (below)
+      {
+        if (!orEqual && u == zero)
+        {
+          return false;
+        }
+        x = randomValue(zero, orEqual ? u : u - one);
+      }
+      else
+      {
+        if (!orEqual && u == ones)
+        {
+          return false;
+        }
+        x = randomValue(orEqual ? u : u + one, ones);
+      }
+      x = x ^ flip;
+      break;
+    }
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    case kind::BITVECTOR_ASHR:
+    {
+      // only the shifted operand has an inverse value
+      if (pos != 0)
+      {
+        return false;
+      }
+      if (v.d_kind == kind::BITVECTOR_SHL)
+      {
+        BitVector mask = ones.logicalRightShift(s);
+        x = target.logicalRightShift(s) | (randomValue(width) & ~mask);
+      }
+      else
+      {
+        BitVector mask = ones.leftShift(s);
+        x = target.leftShift(s) | (randomValue(width) & ~mask);
+      }
+      break;
+    }
+    case kind::BITVECTOR_UDIV:
+      x = pos == 0 ? target * s : s.unsignedDivTotal(target);
+      break;
+    case kind::BITVECTOR_UREM:
+      x = pos == 0 ? target : (s == target ? zero : s - target);
+      break;
+    case kind::BITVECTOR_REDAND:
+    case kind::BITVECTOR_REDOR:
+    {
+      bool isAnd = v.d_kind == kind::BITVECTOR_REDAND;
+      if (target.isBitSet(0) == isAnd)
+      {
+        x = isAnd ? ones : zero;
+      }
+      else
+      {
+        x = randomValue(width);
+        if (x == (isAnd ? ones : zero))
+        {
+          x = x ^ one;
+        }
+      }
+      break;
+    }
+    case kind::BITVECTOR_ITE:
+      if (pos == 0)
+      {
+        x = mkBool(args[1] == target);
+      }
+      else
+      {
+        x = target;
+      }
+      break;
+    case kind::BITVECTOR_EXTRACT:
+      x = args[0];
+      for (unsigned i = v.d_low; i <= v.d_high; ++i)
+      {
+        x.setBit(i, target.isBitSet(i - v.d_low));
+      }
+      break;
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND:
+      x = target.extract(width - 1, 0);
+      break;
+    default: return false;
+  }
+  // the candidates above are not always inverse values, e.g., when the
+  // target value cannot be reached by changing this child only
+  args[pos] = x;
+  return compute(v, args) == target;
+}
+
+bool BVLocalSearch::move(size_t r)
+{
+  size_t cur = r;
+  BitVector target = BitVector::mkOne(1);
+  while (d_vertices[cur].d_kind != kind::VARIABLE)
+  {
+    const Vertex& v = d_vertices[cur];
+    std::vector<size_t> positions;
+    for (size_t i = 0, size = v.d_children.size(); i < size; ++i)
+    {
+      if (d_vertices[v.d_children[i]].d_kind != kind::CONST_BITVECTOR)
+      {
+        positions.push_back(i);
+      }
+    }
+    if (positions.empty())
+    {
+      return false;
+    }
+    size_t start = Random::getRandom().pick(0, positions.size() - 1);
+    size_t pos = positions[start];
+    BitVector x;
+    bool found = false;
+    if (Random::getRandom().pickWithProb(s_probInverse))
+    {
+      for (size_t i = 0, size = positions.size(); i < size && !found; ++i)
+      {
+        pos = positions[(start + i) % size];
+        found = inverseValue(v, pos, target, x);
+      }
+    }
+    if (!found)
+    {
+      pos = positions[start];
+      x = randomValue(d_vertices[v.d_children[pos]].d_value.getSize());
+    }
+    cur = v.d_children[pos];
+    target = x;
+  }
+  Trace("bv-ls-debug") << "BVLocalSearch: set leaf " << cur << " to "
+                       << target << std::endl;
+  update(cur, target);
+  return true;
+}
+
+void BVLocalSearch::update(size_t leaf, const BitVector& value)
+{
+  d_vertices[leaf].d_value = value;
+  // the vertices are in topological order, so updating them by increasing
+  // index computes every vertex after its children
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> queue;
+  std::unordered_set<size_t> queued;
+  for (size_t p : d_vertices[leaf].d_parents)
+  {
+    if (queued.insert(p).second)
+    {
+      queue.push(p);
+    }
+  }
+  while (!queue.empty())
+  {
+    size_t i = queue.top();
+    queue.pop();
+    Vertex& v = d_vertices[i];
+    BitVector val = compute(v, childValues(v));
+    if (val == v.d_value)
+    {
+      continue;
+    }
+    v.d_value = val;
+    if (d_isRoot[i])
+    {
+      updateRoot(i);
+    }
+    for (size_t p : v.d_parents)
+    {
+      if (queued.insert(p).second)
+      {
+        queue.push(p);
+      }
+    }
+  }
+}
+
+void BVLocalSearch::updateRoot(size_t r)
+{
+  bool sat = d_vertices[r].d_value.isBitSet(0);
+  auto it = d_unsatPos.find(r);
+  if (sat && it != d_unsatPos.end())
+  {
+    size_t last = d_unsatRoots.back();
+    d_unsatRoots[it->second] = last;
+    d_unsatPos[last] = it->second;
+    d_unsatRoots.pop_back();
+    d_unsatPos.erase(r);
+  }
+  else if (!sat && it == d_unsatPos.end())
+  {
+    d_unsatPos[r] = d_unsatRoots.size();
+    d_unsatRoots.push_back(r);
+  }
+}
+
+BVLocalSearch::Statistics::Statistics(const std::string& name)
+    : d_time(name + "::LocalSearch::Time"),
+      d_numCalls(name + "::LocalSearch::NumCalls", 0),
+      d_numSolved(name + "::LocalSearch::NumSolved", 0),
+      d_numUnsupported(name + "::LocalSearch::NumUnsupported", 0),
+      d_numMoves(name + "::LocalSearch::NumMoves", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_time);
+  smtStatisticsRegistry()->registerStat(&d_numCalls);
+  smtStatisticsRegistry()->registerStat(&d_numSolved);
+  smtStatisticsRegistry()->registerStat(&d_numUnsupported);
+  smtStatisticsRegistry()->registerStat(&d_numMoves);
+}
+
+BVLocalSearch::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_time);
+  smtStatisticsRegistry()->unregisterStat(&d_numCalls);
+  smtStatisticsRegistry()->unregisterStat(&d_numSolved);
+  smtStatisticsRegistry()->unregisterStat(&d_numUnsupported);
+  smtStatisticsRegistry()->unregisterStat(&d_numMoves);
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
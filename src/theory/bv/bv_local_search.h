@@ -0,0 +1,154 @@
+/*********************                                                        */
+/*! \file bv_local_search.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Word-level local search for bit-vector models
+ **
+ ** Word-level propagation-based local search for bit-vector models, used to
+ ** find a model of the asserted facts before bit-blasting them.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__BV__BV_LOCAL_SEARCH_H
+#define CVC4__THEORY__BV__BV_LOCAL_SEARCH_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/bitvector.h"
+#include "util/statistics_registry.h"
+#include "util/stats_timer.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+/**
+ * Propagation-based local search on the word level, in the style of
+ * Niemetz, Preiner and Biere, "Propagation based local search for
+ * bit-precise reasoning".
+ *
+ * The facts are translated to a DAG whose vertices hold the values of the
+ * terms under the current assignment of the leaves, Boolean terms being
+ * represented as bit-vectors of size one. A move picks an unsatisfied fact
+ * and propagates its target value down a path of the DAG, selecting at each
+ * vertex a child and a value for it such that the vertex gets its target
+ * value (an inverse value), or a random value if there is none, until it
+ * reaches a leaf, which is updated. The search stops when all facts are
+ * satisfied or when it runs out of moves.
+ *
+ * The search is incomplete, it can only find models, and it gives up on
+ * facts with operators it does not support.
+ */
+class BVLocalSearch
+{
+ public:
+  BVLocalSearch(const std::string& name);
+  ~BVLocalSearch() {}
+
+  /**
+   * Search an assignment of the leaves of facts that satisfies all facts,
+   * doing at most maxMoves moves. The search starts from the assignment
+   * found by the previous call, if any. Returns true if it found one.
+   */
+  bool solve(const std::vector<Node>& facts, uint64_t maxMoves);
+
+  /**
+   * Get the value of leaf in the assignment found by the last successful
+   * call to solve(), or the null node if leaf did not occur in the facts.
+   */
+  Node getValue(TNode leaf) const;
+
+ private:
+  /** A vertex of the DAG of the facts */
+  struct Vertex
+  {
+    /** The operator, in terms of the bit-vector kinds */
+    Kind d_kind;
+    /** The children, in the order of the operator */
+    std::vector<size_t> d_children;
+    /** The vertices of which this vertex is a child */
+    std::vector<size_t> d_parents;
+    /** The value under the current assignment */
+    BitVector d_value;
+    /** The bounds of extracts, d_low is also the amount of extensions */
+    unsigned d_high;
+    unsigned d_low;
+  };
+
+  /**
+   * Build the DAG of the facts, and set the roots. Returns false if a fact
+   * contains an operator that is not supported.
+   */
+  bool build(const std::vector<Node>& facts);
+  /** Add the vertex of n, whose children have their vertices already */
+  bool addVertex(TNode n);
+  /** Compute the value of v if its children have the values args */
+  BitVector compute(const Vertex& v, const std::vector<BitVector>& args) const;
+  /** Get the values of the children of v */
+  std::vector<BitVector> childValues(const Vertex& v) const;
+  /**
+   * Get a value x of the child of v at position pos such that v has value
+   * target when its other children have their current values, if such a
+   * value is found. Returns false otherwise.
+   */
+  bool inverseValue(const Vertex& v,
+                    size_t pos,
+                    const BitVector& target,
+                    BitVector& x) const;
+  /** Do one move for the unsatisfied root r. Returns false if it is stuck */
+  bool move(size_t r);
+  /** Set the value of leaf to value and update the values of its cone */
+  void update(size_t leaf, const BitVector& value);
+  /** Add or remove root r from the unsatisfied roots according to its value */
+  void updateRoot(size_t r);
+
+  /** Get a random value of size width */
+  static BitVector randomValue(unsigned width);
+  /** Get a random value between lo and hi, both included */
+  static BitVector randomValue(const BitVector& lo, const BitVector& hi);
+
+  /** The vertices, in topological order */
+  std::vector<Vertex> d_vertices;
+  /** The vertex of each term */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_vertexOf;
+  /** The leaves */
+  std::vector<Node> d_leaves;
+  /** Whether each vertex is a root, i.e., the vertex of a fact */
+  std::vector<bool> d_isRoot;
+  /** The roots that are unsatisfied under the current assignment */
+  std::vector<size_t> d_unsatRoots;
+  /** The position of each unsatisfied root in d_unsatRoots */
+  std::unordered_map<size_t, size_t> d_unsatPos;
+  /** The assignment of the leaves found by the last successful solve() */
+  std::unordered_map<Node, BitVector, NodeHashFunction> d_model;
+
+  class Statistics
+  {
+   public:
+    TimerStat d_time;
+    IntStat d_numCalls;
+    IntStat d_numSolved;
+    IntStat d_numUnsupported;
+    IntStat d_numMoves;
+    Statistics(const std::string& name);
+    ~Statistics();
+  };
+  Statistics d_statistics;
+}; /* class BVLocalSearch */
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__BV__BV_LOCAL_SEARCH_H */
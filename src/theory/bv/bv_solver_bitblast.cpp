@@ -16,11 +16,14 @@
 
 #include "theory/bv/bv_solver_bitblast.h"
 
+#include <unordered_set>
+
 #include "options/bv_options.h"
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/theory_bv.h"
 #include "theory/bv/theory_bv_utils.h"
+#include "theory/evaluator.h"
 #include "theory/theory_model.h"
 
 namespace cvc5 {
@@ -38,11 +41,17 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
       d_assumptions(s->getSatContext()),
       d_invalidateModelCache(s->getSatContext(), true),
       d_inSatMode(s->getSatContext(), false),
+      d_localSearch(options::bvLocalSearch()
+                        ? new BVLocalSearch("theory::bv::BVSolverBitblast")
+                        : nullptr),
+      d_facts(s->getSatContext()),
+      d_inLocalSearchMode(s->getSatContext(), false),
       d_epg(pnm ? new EagerProofGenerator(pnm, s->getUserContext(), "")
                 : nullptr),
       d_factLiteralCache(s->getSatContext()),
       d_literalFactCache(s->getSatContext()),
-      d_propagate(options::bitvectorPropagate())
+      d_propagate(options::bitvectorPropagate()),
+      d_statistics()
 {
   if (pnm != nullptr)
   {
@@ -64,6 +73,13 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
                                         d_nullContext.get(),
                                         nullptr,
                                         smt::currentResourceManager()));
+  if (options::bvBBThreads() > 1)
+  {
+    d_parallelCnf.reset(new ParallelCnf(d_cnfStream.get(),
+                                        d_satSolver.get(),
+                                        options::bvBBThreads(),
+                                        "theory::bv::BVSolverBitblast"));
+  }
 }
 
 void BVSolverBitblast::postCheck(Theory::Effort level)
@@ -77,29 +93,77 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
     }
   }
 
+  /* Try to find a model on the word level before bit-blasting the facts,
+   * which stay in the bit-blast queue in case the search fails. */
+  if (level == Theory::Effort::EFFORT_FULL && d_localSearch != nullptr)
+  {
+    std::vector<Node> facts(d_facts.begin(), d_facts.end());
+    if (d_localSearch->solve(facts, options::bvLocalSearchMoves()))
+    {
+      d_invalidateModelCache.set(true);
+      d_inSatMode = true;
+      d_inLocalSearchMode = true;
+      Debug("bv-bitblast") << "model found by local search" << std::endl;
+      return;
+    }
+  }
+
   /* Process bit-blast queue and store SAT literals. */
+  std::vector<Node> facts, new_facts, bb_facts;
+  std::unordered_set<Node, NodeHashFunction> seen;
   while (!d_bbFacts.empty())
   {
     Node fact = d_bbFacts.front();
     d_bbFacts.pop();
-    /* Bit-blast fact and cache literal. */
-    if (d_factLiteralCache.find(fact) == d_factLiteralCache.end())
+    facts.push_back(fact);
+    /* Bit-blast fact. */
+    if (d_factLiteralCache.find(fact) == d_factLiteralCache.end()
+        && seen.insert(fact).second)
     {
-      d_bitblaster->bbAtom(fact);
-      Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
-      d_cnfStream->ensureLiteral(bb_fact);
-
-      prop::SatLiteral lit = d_cnfStream->getLiteral(bb_fact);
-      d_factLiteralCache[fact] = lit;
-      d_literalFactCache[lit] = fact;
+      if (fact.getKind() == kind::BITVECTOR_EAGER_ATOM)
+      {
+        /* Eager atoms wrap whole assertions, whose literal acts as the
+         * activation literal of the clauses of the assertion: the clauses
+         * stay in the SAT solver and are only enabled while the assertion is
+         * asserted, which supports push and pop. */
+        bb_facts.push_back(d_bitblaster->bbFormula(fact[0]));
+      }
+      else
+      {
+        d_bitblaster->bbAtom(fact);
+        bb_facts.push_back(d_bitblaster->getStoredBBAtom(fact));
+      }
+      new_facts.push_back(fact);
     }
+  }
+
+  /* Convert the bit-blasted facts to CNF and cache their literals. */
+  if (d_parallelCnf != nullptr)
+  {
+    d_parallelCnf->ensureLiterals(bb_facts);
+  }
+  for (size_t i = 0, size = new_facts.size(); i < size; ++i)
+  {
+    d_cnfStream->ensureLiteral(bb_facts[i]);
+
+    prop::SatLiteral lit = d_cnfStream->getLiteral(bb_facts[i]);
+    d_factLiteralCache[new_facts[i]] = lit;
+    d_literalFactCache[lit] = new_facts[i];
+  }
+  for (const Node& fact : facts)
+  {
     d_assumptions.push_back(d_factLiteralCache[fact]);
   }
 
   d_invalidateModelCache.set(true);
   std::vector<prop::SatLiteral> assumptions(d_assumptions.begin(),
                                             d_assumptions.end());
-  prop::SatValue val = d_satSolver->solve(assumptions);
+  d_inLocalSearchMode = false;
+  prop::SatValue val;
+  do
+  {
+    val = d_satSolver->solve(assumptions);
+  } while (val == prop::SatValue::SAT_VALUE_TRUE && refineAbstractions());
   d_inSatMode = val == prop::SatValue::SAT_VALUE_TRUE;
   Debug("bv-bitblast") << "d_inSatMode: " << d_inSatMode << std::endl;
 
@@ -126,6 +190,11 @@ bool BVSolverBitblast::preNotifyFact(
     TNode atom, bool pol, TNode fact, bool isPrereg, bool isInternal)
 {
   d_bbFacts.push_back(fact);
+  if (d_localSearch != nullptr)
+  {
+    d_facts.push_back(fact.getKind() == kind::BITVECTOR_EAGER_ATOM ? fact[0]
+                                                                    : fact);
+  }
   return false;  // Return false to enable equality engine reasoning in Theory.
 }
 
@@ -140,12 +209,23 @@ bool BVSolverBitblast::collectModelValues(TheoryModel* m,
 {
   for (const auto& term : termSet)
   {
-    if (!d_bitblaster->isVariable(term))
+    Node value;
+    if (d_inLocalSearchMode)
+    {
+      value = d_localSearch->getValue(term);
+      if (value.isNull())
+      {
+        continue;
+      }
+    }
+    else if (!d_bitblaster->isVariable(term))
     {
       continue;
     }
-
-    Node value = getValueFromSatSolver(term, true);
+    else
+    {
+      value = getValueFromSatSolver(term, true);
+    }
     Assert(value.isConst());
     if (!m->assertEquality(term, value, true))
     {
@@ -176,6 +256,40 @@ EqualityStatus BVSolverBitblast::getEqualityStatus(TNode a, TNode b)
   return EQUALITY_FALSE_IN_MODEL;
 }
 
+bool BVSolverBitblast::refineAbstractions()
+{
+  const std::vector<Node>& abstractions = d_bitblaster->getAbstractions();
+  if (abstractions.empty())
+  {
+    return false;
+  }
+  ++d_statistics.d_numAbstractionChecks;
+
+  std::vector<Node> refine;
+  Evaluator eval;
+  for (const Node& term : abstractions)
+  {
+    std::vector<Node> args(term.begin(), term.end());
+    std::vector<Node> vals;
+    for (const Node& arg : args)
+    {
+      vals.push_back(getValueFromSatSolver(arg, true));
+    }
+    Node expected = eval.eval(term, args, vals);
+    if (getValueFromSatSolver(term, true) != expected)
+    {
+      refine.push_back(term);
+    }
+  }
+  for (const Node& term : refine)
+  {
+    Debug("bv-bitblast") << "refine abstraction of " << term << std::endl;
+    d_cnfStream->convertAndAssert(d_bitblaster->refine(term), false, false);
+    ++d_statistics.d_numRefinements;
+  }
+  return !refine.empty();
+}
+
 Node BVSolverBitblast::getValueFromSatSolver(TNode node, bool initialize)
 {
   if (node.isConst())
@@ -183,6 +297,17 @@ Node BVSolverBitblast::getValueFromSatSolver(TNode node, bool initialize)
     return node;
   }
 
+  if (d_inLocalSearchMode)
+  {
+    /* The local search only assigns the leaves of the facts. */
+    Node value = d_localSearch->getValue(node);
+    if (value.isNull() && initialize)
+    {
+      return utils::mkConst(utils::getSize(node), 0u);
+    }
+    return value;
+  }
+
   if (!d_bitblaster->hasBBTerm(node))
   {
     return initialize ? utils::mkConst(utils::getSize(node), 0u) : Node();
@@ -279,6 +404,21 @@ Node BVSolverBitblast::getValue(TNode node)
   return it->second;
 }
 
+BVSolverBitblast::Statistics::Statistics()
+    : d_numAbstractionChecks(
+        "theory::bv::BVSolverBitblast::NumAbstractionChecks", 0),
+      d_numRefinements("theory::bv::BVSolverBitblast::NumRefinements", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_numAbstractionChecks);
+  smtStatisticsRegistry()->registerStat(&d_numRefinements);
+}
+
+BVSolverBitblast::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_numAbstractionChecks);
+  smtStatisticsRegistry()->unregisterStat(&d_numRefinements);
+}
+
 }  // namespace bv
 }  // namespace theory
 }  // namespace cvc5
@@ -24,7 +24,9 @@
 #include "context/cdqueue.h"
 #include "prop/cnf_stream.h"
 #include "prop/sat_solver.h"
+#include "theory/bv/bitblast/parallel_cnf.h"
 #include "theory/bv/bitblast/simple_bitblaster.h"
+#include "theory/bv/bv_local_search.h"
 #include "theory/bv/bv_solver.h"
 #include "theory/bv/proof_checker.h"
 #include "theory/eager_proof_generator.h"
@@ -88,6 +90,13 @@ class BVSolverBitblast : public BVSolver
    */
   Node getValue(TNode node);
 
+  /**
+   * Check the abstracted terms of the bit-blaster against the model of the
+   * SAT solver, and refine the ones whose value is wrong. Returns true if a
+   * term was refined.
+   */
+  bool refineAbstractions();
+
   /**
    * Cache for getValue() calls.
    *
@@ -107,6 +116,11 @@ class BVSolverBitblast : public BVSolver
   std::unique_ptr<prop::SatSolver> d_satSolver;
   /** CNF stream. */
   std::unique_ptr<prop::CnfStream> d_cnfStream;
+  /**
+   * Converts the bit-blasted facts to CNF in threads (only with
+   * options::bvBBThreads() > 1).
+   */
+  std::unique_ptr<ParallelCnf> d_parallelCnf;
 
   /**
    * Bit-blast queue for facts sent to this solver.
@@ -124,6 +138,21 @@ class BVSolverBitblast : public BVSolver
   /** Indicates whether the last check() call was satisfiable. */
   context::CDO<bool> d_inSatMode;
 
+  /**
+   * Local search tried on the facts before solving them with the SAT solver
+   * (only with options::bvLocalSearch()).
+   */
+  std::unique_ptr<BVLocalSearch> d_localSearch;
+
+  /** The facts sent to this solver, used by the local search. */
+  context::CDList<Node> d_facts;
+
+  /**
+   * Indicates whether the model of the last check() call was found by the
+   * local search instead of the SAT solver.
+   */
+  context::CDO<bool> d_inLocalSearchMode;
+
   /** Proof generator that manages proofs for lemmas generated by this class. */
   std::unique_ptr<EagerProofGenerator> d_epg;
 
@@ -139,6 +168,16 @@ class BVSolverBitblast : public BVSolver
 
   /** Option to enable/disable bit-level propagation. */
   bool d_propagate;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numAbstractionChecks;
+    IntStat d_numRefinements;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
 };
 
 }  // namespace bv
@@ -27,6 +27,8 @@
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "theory/bv/theory_bv_utils.h"
+#include "theory/rewrite_profiler.h"
+#include "theory/rewriter.h"
 #include "theory/theory.h"
 #include "util/statistics_registry.h"
 
@@ -446,7 +448,24 @@ public:
       Debug("theory::bv::rewrite") << "RewriteRule<" << rule << ">(" << node << ")" << std::endl;
       Assert(checkApplies || applies(node));
       //++ s_statistics->d_ruleApplications;
-      Node result = apply(node);
+      Node result;
+      RewriteProfiler* rp = Rewriter::getProfiler();
+      if (rp != nullptr)
+      {
+        std::ostringstream rname;
+        rname << rule;
+        RewriteProfiler::RuleStats& rs =
+            rp->getRuleStats("bv", rname.str(), true);
+        {
+          CodeTimer timer(rs.d_time, true);
+          result = apply(node);
+        }
+        rp->notifyRewrite(rs, node, result);
+      }
+      else
+      {
+        result = apply(node);
+      }
       if (result != node) {
         if(Dump.isOn("bv-rewrites")) {
           std::ostringstream os;
@@ -15,9 +15,11 @@
 #include "theory/combination_care_graph.h"
 
 #include "expr/node_visitor.h"
+#include "options/theory_options.h"
 #include "prop/prop_engine.h"
 #include "theory/care_graph.h"
 #include "theory/model_manager.h"
+#include "theory/shared_solver.h"
 #include "theory/theory_engine.h"
 
 namespace cvc5 {
@@ -27,7 +29,8 @@ CombinationCareGraph::CombinationCareGraph(
     TheoryEngine& te,
     const std::vector<Theory*>& paraTheories,
     ProofNodeManager* pnm)
-    : CombinationEngine(te, paraTheories, pnm)
+    : CombinationEngine(te, paraTheories, pnm),
+      d_changedSharedTermsIndex(te.getSatContext(), 0)
 {
 }
 
@@ -40,10 +43,25 @@ void CombinationCareGraph::combineTheories()
   // Care graph we'll be building
   CareGraph careGraph;
 
+  // If the care graph is computed incrementally, get the shared terms whose
+  // equivalence class changed since the last round. The status of the pairs
+  // of the other shared terms is unchanged since then: they were either known
+  // to be equal or disequal, or we split on them in the last round.
+  std::unordered_set<TNode, TNodeHashFunction> changed;
+  bool incremental = options::careGraphIncremental();
+  if (incremental)
+  {
+    d_changedSharedTermsIndex = d_sharedSolver->getChangedSharedTerms(
+        d_changedSharedTermsIndex, changed);
+    Trace("combineTheories")
+        << "TheoryEngine::combineTheories(): " << changed.size()
+        << " changed shared terms" << std::endl;
+  }
+
   // get the care graph from the parametric theories
   for (Theory* t : d_paraTheories)
   {
-    t->getCareGraph(&careGraph);
+    t->getCareGraph(&careGraph, incremental ? &changed : nullptr);
   }
 
   Trace("combineTheories")
@@ -89,6 +107,14 @@ void CombinationCareGraph::combineTheories()
     // explore more -Clark
     Node e = d_valuation.ensureLiteral(equality);
     propEngine->requirePhase(e, true);
+
+    if (incremental)
+    {
+      // consider the pair again in the next round, in case splitting on it
+      // does not change the equivalence classes of its terms
+      d_sharedSolver->markSharedTermChanged(carePair.d_a);
+      d_sharedSolver->markSharedTermChanged(carePair.d_b);
+    }
   }
 }
 
@@ -17,8 +17,10 @@
 #ifndef CVC4__THEORY__COMBINATION_CARE_GRAPH__H
 #define CVC4__THEORY__COMBINATION_CARE_GRAPH__H
 
+#include <unordered_set>
 #include <vector>
 
+#include "context/cdo.h"
 #include "theory/combination_engine.h"
 
 namespace cvc5 {
@@ -44,6 +46,14 @@ class CombinationCareGraph : public CombinationEngine
    * Combine theories using a care graph.
    */
   void combineTheories() override;
+
+ private:
+  /**
+   * The number of changes of the shared terms that were recorded when we last
+   * combined theories in the current SAT context. This is used for computing
+   * the care graph incrementally.
+   */
+  context::CDO<size_t> d_changedSharedTermsIndex;
 };
 
 }  // namespace theory
@@ -833,6 +833,22 @@ void TheoryDatatypes::getPossibleCons( EqcInfo* eqc, Node n, std::vector< bool >
   }
 }
 
+int TheoryDatatypes::getLabelPosition(Node n, size_t n_lbl, unsigned tindex)
+{
+  std::map<Node, std::vector<size_t> >::const_iterator it =
+      d_labels_pos.find(n);
+  if (it == d_labels_pos.end() || tindex >= it->second.size())
+  {
+    return -1;
+  }
+  size_t pos = it->second[tindex];
+  if (pos < n_lbl && d_labels_tindex[n][pos] == tindex)
+  {
+    return static_cast<int>(pos);
+  }
+  return -1;
+}
+
 void TheoryDatatypes::mkExpDefSkolem( Node sel, TypeNode dt, TypeNode rt ) {
   if( d_exp_def_skolem[dt].find( sel )==d_exp_def_skolem[dt].end() ){
     std::stringstream ss;
@@ -900,22 +916,16 @@ void TheoryDatatypes::addTester(
     NodeUIntMap::iterator lbl_i = d_labels.find(n);
     Assert(lbl_i != d_labels.end());
     size_t n_lbl = (*lbl_i).second;
-    std::map< int, bool > neg_testers;
-    for (size_t i = 0; i < n_lbl; i++)
+    int pos = getLabelPosition(n, n_lbl, ttindex);
+    if (pos >= 0)
     {
-      Assert(d_labels_data[n][i].getKind() == NOT);
-      unsigned jtindex = d_labels_tindex[n][i];
-      if( jtindex==ttindex ){
-        if( tpolarity ){  //we are in conflict
-          j = d_labels_data[n][i];
-          jt = j[0];
-          makeConflict = true;
-          break;
-        }else{            //it is redundant
-          return;
-        }
-      }else{
-        neg_testers[jtindex] = true;
+      Assert(d_labels_data[n][pos].getKind() == NOT);
+      if( tpolarity ){  //we are in conflict
+        j = d_labels_data[n][pos];
+        jt = j[0];
+        makeConflict = true;
+      }else{            //it is redundant
+        return;
       }
     }
     if( !makeConflict ){
@@ -932,9 +942,16 @@ void TheoryDatatypes::addTester(
         d_labels_args[n].push_back(t_arg);
         d_labels_tindex[n].push_back(ttindex);
       }
+      const DType& dt = t_arg.getType().getDType();
+      std::vector<size_t>& lpos = d_labels_pos[n];
+      if (lpos.empty())
+      {
+        lpos.resize(dt.getNumConstructors(), 0);
+      }
+      Assert(ttindex < lpos.size());
+      lpos[ttindex] = n_lbl;
       n_lbl++;
 
-      const DType& dt = t_arg.getType().getDType();
       Debug("datatypes-labels") << "Labels at " << n_lbl << " / " << dt.getNumConstructors() << std::endl;
       if( tpolarity ){
         instantiate( eqc, n );
@@ -1035,23 +1052,17 @@ void TheoryDatatypes::addConstructor( Node c, EqcInfo* eqc, Node n ){
   if( lbl_i != d_labels.end() ){
     size_t constructorIndex = utils::indexOf(c.getOperator());
     size_t n_lbl = (*lbl_i).second;
-    for (size_t i = 0; i < n_lbl; i++)
+    int pos = getLabelPosition(n, n_lbl, constructorIndex);
+    if (pos >= 0 && d_labels_data[n][pos].getKind() == NOT)
     {
-      Node t = d_labels_data[n][i];
-      if (d_labels_data[n][i].getKind() == NOT)
-      {
-        unsigned tindex = d_labels_tindex[n][i];
-        if (tindex == constructorIndex)
-        {
-          std::vector<Node> conf;
-          conf.push_back(t);
-          conf.push_back(t[0][0].eqNode(c));
-          Trace("dt-conflict")
-              << "CONFLICT: Tester merge eq conflict : " << conf << std::endl;
-          d_im.sendDtConflict(conf, InferenceId::DATATYPES_TESTER_CONFLICT);
-          return;
-        }
-      }
+      Node t = d_labels_data[n][pos];
+      std::vector<Node> conf;
+      conf.push_back(t);
+      conf.push_back(t[0][0].eqNode(c));
+      Trace("dt-conflict")
+          << "CONFLICT: Tester merge eq conflict : " << conf << std::endl;
+      d_im.sendDtConflict(conf, InferenceId::DATATYPES_TESTER_CONFLICT);
+      return;
     }
   }
   //check selectors
@@ -1579,6 +1590,11 @@ void TheoryDatatypes::instantiate( EqcInfo* eqc, Node n ){
 void TheoryDatatypes::checkCycles() {
   Trace("datatypes-cycle-check") << "Check acyclicity" << std::endl;
   std::vector< Node > cdt_eqc;
+  // The equivalence classes whose search finished without finding a cycle.
+  // Nothing reachable from them is on a cycle, so they are shared by the
+  // searches from all equivalence classes, which makes the check linear in
+  // the size of the graph of the constructors.
+  std::map< TNode, bool > proc;
   eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(d_equalityEngine);
   while( !eqcs_i.isFinished() ){
     Node eqc = (*eqcs_i);
@@ -1588,7 +1604,6 @@ void TheoryDatatypes::checkCycles() {
         if( options::dtCyclic() ){
           //do cycle checks
           std::map< TNode, bool > visited;
-          std::map< TNode, bool > proc;
           std::vector<Node> expl;
           Trace("datatypes-cycle-check") << "...search for cycle starting at " << eqc << std::endl;
           Node cn = searchForCycle( eqc, eqc, visited, proc, expl );
@@ -97,6 +97,12 @@ private:
   bool hasTester( Node n );
   /** get the possible constructors for n */
   void getPossibleCons( EqcInfo* eqc, Node n, std::vector< bool >& cons );
+  /**
+   * Get the position in d_labels_data[n] of the tester for the constructor
+   * with index tindex, if it is among the first n_lbl labels of n, the number
+   * of labels that are valid in the current context, or -1 otherwise.
+   */
+  int getLabelPosition(Node n, size_t n_lbl, unsigned tindex);
   /** mkExpDefSkolem */
   void mkExpDefSkolem( Node sel, TypeNode dt, TypeNode rt );
   /** skolems for terms */
@@ -134,6 +140,16 @@ private:
   std::map<Node, std::vector<Node> > d_labels_args;
   /** the tester index of each node in d_labels_data */
   std::map<Node, std::vector<unsigned> > d_labels_tindex;
+  /**
+   * For each eqc r, the position in d_labels_data[r] where a tester for each
+   * constructor index (in the order of the datatype) was last stored. This
+   * indexes the labels so that finding the tester for a constructor does not
+   * scan them, and is valid for tindex if the position is among the valid
+   * labels and d_labels_tindex also has tindex at that position, since a
+   * tester is only stored if there is no valid tester for the same
+   * constructor before it.
+   */
+  std::map<Node, std::vector<size_t> > d_labels_pos;
   //---------------------------------end labels
   /** selector apps for eqch equivalence class */
   NodeUIntMap d_selector_apps;
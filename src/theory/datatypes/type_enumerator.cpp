@@ -23,6 +23,74 @@ using namespace cvc5;
 using namespace theory;
 using namespace datatypes;
 
+namespace {
+
+/** The number of enumerations of caches that are being extended */
+thread_local size_t s_numExtending = 0;
+
+/** Marks the scope in which an enumeration of a cache is extended */
+class ExtendingScope
+{
+ public:
+  ExtendingScope() { s_numExtending++; }
+  ~ExtendingScope() { s_numExtending--; }
+};
+
+}  // namespace
+
+DatatypesEnumerationCache::DatatypesEnumerationCache(TypeNode type)
+    : d_type(type)
+{
+}
+
+DatatypesEnumerationCache::~DatatypesEnumerationCache() {}
+
+Node DatatypesEnumerationCache::getTerm(bool childEnum, size_t i)
+{
+  std::vector<Node>& terms = d_terms[childEnum];
+  if (i < terms.size())
+  {
+    return terms[i];
+  }
+  ExtendingScope es;
+  std::unique_ptr<DatatypesEnumerator>& te = d_enum[childEnum];
+  if (te == nullptr)
+  {
+    te.reset(new DatatypesEnumerator(d_type, childEnum));
+    terms.push_back(**te);
+  }
+  while (i >= terms.size())
+  {
+    if (te->isFinished())
+    {
+      return Node::null();
+    }
+    ++(*te);
+    if (te->isFinished())
+    {
+      return Node::null();
+    }
+    terms.push_back(**te);
+  }
+  Trace("dt-enum-cache") << "Enumerated " << terms.size() << " values of "
+                         << d_type << std::endl;
+  return terms[i];
+}
+
+DatatypesEnumerationCache* DatatypesEnumerationCache::get(TypeNode type)
+{
+  const DType& dt = type.getDType();
+  DTypeEnumerationCache* c = dt.getEnumerationCache(type);
+  if (c == nullptr)
+  {
+    c = new DatatypesEnumerationCache(type);
+    dt.setEnumerationCache(type, c);
+  }
+  return static_cast<DatatypesEnumerationCache*>(c);
+}
+
+bool DatatypesEnumerationCache::isExtending() { return s_numExtending > 0; }
+
 Node DatatypesEnumerator::getTermEnum( TypeNode tn, unsigned i ){
    Node ret;
    if( i<d_terms[tn].size() ){
@@ -194,6 +262,15 @@ Node DatatypesEnumerator::getTermEnum( TypeNode tn, unsigned i ){
 
  void DatatypesEnumerator::init()
  {
+   if (d_tep == nullptr && !DatatypesEnumerationCache::isExtending())
+   {
+     // use the shared enumeration of the type
+     d_cache = DatatypesEnumerationCache::get(d_type);
+     d_has_debruijn = 0;
+     d_size_limit = 0;
+     AlwaysAssert(!isFinished());
+     return;
+   }
    Debug("dt-enum") << "datatype is datatype? " << d_type.isDatatype()
                     << std::endl;
    Debug("dt-enum") << "datatype is kind " << d_type.getKind() << std::endl;
@@ -280,6 +357,11 @@ Node DatatypesEnumerator::getTermEnum( TypeNode tn, unsigned i ){
  DatatypesEnumerator& DatatypesEnumerator::operator++()
  {
    Debug("dt-enum-debug") << ": increment " << this << std::endl;
+   if (d_cache != nullptr)
+   {
+     d_index++;
+     return *this;
+   }
    if (d_zeroTermActive)
    {
      d_zeroTermActive = false;
@@ -19,6 +19,9 @@
 #ifndef CVC4__THEORY__DATATYPES__TYPE_ENUMERATOR_H
 #define CVC4__THEORY__DATATYPES__TYPE_ENUMERATOR_H
 
+#include <memory>
+#include <vector>
+
 #include "expr/dtype.h"
 #include "expr/kind.h"
 #include "expr/type_node.h"
@@ -29,8 +32,52 @@ namespace cvc5 {
 namespace theory {
 namespace datatypes {
 
+class DatatypesEnumerator;
+
+/**
+ * The values of a datatype type in the order in which the enumerators of the
+ * type without type enumerator properties enumerate them, which is stored in
+ * the datatype and shared by all these enumerators. The enumeration is
+ * extended on demand by an enumerator of its own, so that the i-th value is
+ * only computed once, by whichever enumerator first asks for it.
+ */
+class DatatypesEnumerationCache : public DTypeEnumerationCache
+{
+ public:
+  DatatypesEnumerationCache(TypeNode type);
+  ~DatatypesEnumerationCache();
+  /**
+   * Get the i-th value of the enumeration, where childEnum is as for the
+   * enumerator, or null if there are at most i values.
+   */
+  Node getTerm(bool childEnum, size_t i);
+  /** Get the cache of type, which is created if it does not exist */
+  static DatatypesEnumerationCache* get(TypeNode type);
+  /**
+   * Whether an enumeration is being extended, in which case the enumerators
+   * that are created, i.e. the ones of the subfields, do not use caches,
+   * since they could otherwise extend the enumeration being extended.
+   */
+  static bool isExtending();
+
+ private:
+  /** The type */
+  TypeNode d_type;
+  /** The values enumerated so far, for each value of childEnum */
+  std::vector<Node> d_terms[2];
+  /** The enumerators extending d_terms */
+  std::unique_ptr<DatatypesEnumerator> d_enum[2];
+};
 
 class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
+  /**
+   * The shared cache of the enumeration, if any, in which case this
+   * enumerator is the cursor d_index into it, and the fields below are
+   * unused.
+   */
+  DatatypesEnumerationCache* d_cache;
+  /** The index of the current value in d_cache */
+  size_t d_index;
   /** type properties */
   TypeEnumeratorProperties * d_tep;
   /** The datatype we're enumerating */
@@ -86,6 +133,8 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
  public:
   DatatypesEnumerator(TypeNode type, TypeEnumeratorProperties* tep = nullptr)
       : TypeEnumeratorBase<DatatypesEnumerator>(type),
+        d_cache(nullptr),
+        d_index(0),
         d_tep(tep),
         d_datatype(type.getDType()),
         d_type(type),
@@ -99,6 +148,8 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
                       bool childEnum,
                       TypeEnumeratorProperties* tep = nullptr)
       : TypeEnumeratorBase<DatatypesEnumerator>(type),
+        d_cache(nullptr),
+        d_index(0),
         d_tep(tep),
         d_datatype(type.getDType()),
         d_type(type),
@@ -110,6 +161,8 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
   }
   DatatypesEnumerator(const DatatypesEnumerator& de)
       : TypeEnumeratorBase<DatatypesEnumerator>(de.getType()),
+        d_cache(de.d_cache),
+        d_index(de.d_index),
         d_tep(de.d_tep),
         d_datatype(de.d_datatype),
         d_type(de.d_type),
@@ -142,6 +195,15 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
   Node operator*() override
   {
     Debug("dt-enum-debug") << ": get term " << this << std::endl;
+    if (d_cache != nullptr)
+    {
+      Node n = d_cache->getTerm(d_child_enum, d_index);
+      if (n.isNull())
+      {
+        throw NoMoreValuesException(getType());
+      }
+      return n;
+    }
     if (d_zeroTermActive)
     {
       return d_zeroTerm;
@@ -157,6 +219,10 @@ class DatatypesEnumerator : public TypeEnumeratorBase<DatatypesEnumerator> {
 
   bool isFinished() override
   {
+    if (d_cache != nullptr)
+    {
+      return d_cache->getTerm(d_child_enum, d_index).isNull();
+    }
     return d_ctor >= d_has_debruijn+d_datatype.getNumConstructors();
   }
 
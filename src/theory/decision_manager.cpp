@@ -15,6 +15,9 @@
 
 #include "theory/decision_manager.h"
 
+#include <algorithm>
+
+#include "smt/smt_statistics_registry.h"
 #include "theory/rewriter.h"
 
 using namespace cvc5::kind;
@@ -22,9 +25,23 @@ using namespace cvc5::kind;
 namespace cvc5 {
 namespace theory {
 
-DecisionManager::DecisionManager(context::Context* userContext)
-    : d_strategyCacheC(userContext)
+DecisionManager::DecisionManager(context::Context* userContext,
+                                 context::Context* satContext)
+    : d_numChanges(0),
+      d_firstActive(satContext, 0),
+      d_numChangesC(satContext, 0),
+      d_strategyCacheC(userContext),
+      d_decisions("theory::DecisionManager::decisions"),
+      d_refuted("theory::DecisionManager::refuted")
 {
+  smtStatisticsRegistry()->registerStat(&d_decisions);
+  smtStatisticsRegistry()->registerStat(&d_refuted);
+}
+
+DecisionManager::~DecisionManager()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_decisions);
+  smtStatisticsRegistry()->unregisterStat(&d_refuted);
 }
 
 void DecisionManager::presolve()
@@ -39,19 +56,17 @@ void DecisionManager::presolve()
     active.insert(*i);
   }
   active.insert(d_strategyCache.begin(), d_strategyCache.end());
-  std::map<StrategyId, std::vector<DecisionStrategy*> > tmp = d_reg_strategy;
-  d_reg_strategy.clear();
-  for (std::pair<const StrategyId, std::vector<DecisionStrategy*> >& rs : tmp)
+  size_t nactive = 0;
+  for (const std::pair<StrategyId, DecisionStrategy*>& rs : d_strategies)
   {
-    for (DecisionStrategy* ds : rs.second)
+    if (active.find(rs.second) != active.end())
     {
-      if (active.find(ds) != active.end())
-      {
-        // if its active, we keep it
-        d_reg_strategy[rs.first].push_back(ds);
-      }
+      // if its active, we keep it
+      d_strategies[nactive++] = rs;
     }
   }
+  d_strategies.resize(nactive);
+  notifyStrategiesChanged();
 }
 
 void DecisionManager::registerStrategy(StrategyId id,
@@ -61,7 +76,17 @@ void DecisionManager::registerStrategy(StrategyId id,
   Trace("dec-manager") << "DecisionManager: Register strategy : "
                        << ds->identify() << ", id = " << id << std::endl;
   ds->initialize();
-  d_reg_strategy[id].push_back(ds);
+  // insert after the strategies with the same id
+  std::vector<std::pair<StrategyId, DecisionStrategy*>>::iterator it =
+      std::upper_bound(
+          d_strategies.begin(),
+          d_strategies.end(),
+          id,
+          [](StrategyId i, const std::pair<StrategyId, DecisionStrategy*>& rs) {
+            return i < rs.first;
+          });
+  d_strategies.emplace(it, id, ds);
+  notifyStrategiesChanged();
   if (sscope == STRAT_SCOPE_USER_CTX_DEPENDENT)
   {
     // store it in the user-context-dependent list
@@ -79,26 +104,55 @@ void DecisionManager::registerStrategy(StrategyId id,
   }
 }
 
+void DecisionManager::notifyStrategiesChanged()
+{
+  // The indices in d_strategies stored in the SAT context are no longer
+  // valid. They are ignored since d_numChangesC differs from d_numChanges in
+  // all SAT contexts.
+  d_numChanges++;
+}
+
 Node DecisionManager::getNextDecisionRequest()
 {
   Trace("dec-manager-debug")
       << "DecisionManager: Get next decision..." << std::endl;
-  for (const std::pair<const StrategyId, std::vector<DecisionStrategy*> >& rs :
-       d_reg_strategy)
+  size_t i = d_numChangesC.get() == d_numChanges ? d_firstActive.get() : 0;
+  // whether all strategies before index i are done in this context
+  bool prefixDone = true;
+  for (size_t size = d_strategies.size(); i < size; i++)
   {
-    for (unsigned i = 0, size = rs.second.size(); i < size; i++)
+    StrategyId id = d_strategies[i].first;
+    DecisionStrategy* ds = d_strategies[i].second;
+    uint64_t numRefuted = ds->getNumRefuted();
+    Node lit = ds->getNextDecisionRequest();
+    for (uint64_t r = numRefuted, nr = ds->getNumRefuted(); r < nr; r++)
+    {
+      d_refuted << id;
+    }
+    if (!lit.isNull())
+    {
+      Trace("dec-manager")
+          << "DecisionManager:  -> literal " << lit << " decided by strategy "
+          << ds->identify() << std::endl;
+      ds->d_numDecisions++;
+      d_decisions << id;
+      return lit;
+    }
+    Trace("dec-manager-debug") << "DecisionManager:  " << ds->identify()
+                               << " has no decisions." << std::endl;
+    if (prefixDone)
     {
-      DecisionStrategy* ds = rs.second[i];
-      Node lit = ds->getNextDecisionRequest();
-      if (!lit.isNull())
+      if (ds->isDoneInContext())
+      {
+        // the strategies up to this one need not be polled again in this
+        // context
+        d_firstActive = i + 1;
+        d_numChangesC = d_numChanges;
+      }
+      else
       {
-        Trace("dec-manager")
-            << "DecisionManager:  -> literal " << lit << " decided by strategy "
-            << ds->identify() << std::endl;
-        return lit;
+        prefixDone = false;
       }
-      Trace("dec-manager-debug") << "DecisionManager:  " << ds->identify()
-                                 << " has no decisions." << std::endl;
     }
   }
   Trace("dec-manager-debug")
@@ -106,5 +160,45 @@ Node DecisionManager::getNextDecisionRequest()
   return Node::null();
 }
 
+std::ostream& operator<<(std::ostream& out, DecisionManager::StrategyId id)
+{
+  switch (id)
+  {
+    case DecisionManager::STRAT_QUANT_CEGQI_FEASIBLE:
+      out << "QUANT_CEGQI_FEASIBLE";
+      break;
+    case DecisionManager::STRAT_QUANT_SYGUS_FEASIBLE:
+      out << "QUANT_SYGUS_FEASIBLE";
+      break;
+    case DecisionManager::STRAT_LAST_M_SOUND: out << "LAST_M_SOUND"; break;
+    case DecisionManager::STRAT_UF_COMBINED_CARD:
+      out << "UF_COMBINED_CARD";
+      break;
+    case DecisionManager::STRAT_UF_CARD: out << "UF_CARD"; break;
+    case DecisionManager::STRAT_DT_SYGUS_ENUM_ACTIVE:
+      out << "DT_SYGUS_ENUM_ACTIVE";
+      break;
+    case DecisionManager::STRAT_DT_SYGUS_ENUM_SIZE:
+      out << "DT_SYGUS_ENUM_SIZE";
+      break;
+    case DecisionManager::STRAT_STRINGS_SUM_LENGTHS:
+      out << "STRINGS_SUM_LENGTHS";
+      break;
+    case DecisionManager::STRAT_QUANT_BOUND_INT_SIZE:
+      out << "QUANT_BOUND_INT_SIZE";
+      break;
+    case DecisionManager::STRAT_QUANT_CEGIS_UNIF_NUM_ENUMS:
+      out << "QUANT_CEGIS_UNIF_NUM_ENUMS";
+      break;
+    case DecisionManager::STRAT_SEP_NEG_GUARD: out << "SEP_NEG_GUARD"; break;
+    case DecisionManager::STRAT_LAST_FM_COMPLETE:
+      out << "LAST_FM_COMPLETE";
+      break;
+    case DecisionManager::STRAT_ARRAYS: out << "ARRAYS"; break;
+    default: out << "?"; break;
+  }
+  return out;
+}
+
 }  // namespace theory
 }  // namespace cvc5
@@ -18,9 +18,15 @@
 #ifndef CVC4__THEORY__DECISION_MANAGER__H
 #define CVC4__THEORY__DECISION_MANAGER__H
 
-#include <map>
+#include <iosfwd>
+#include <unordered_set>
+#include <vector>
+
 #include "context/cdlist.h"
+#include "context/cdo.h"
 #include "theory/decision_strategy.h"
+#include "util/statistics_registry.h"
+#include "util/stats_histogram.h"
 
 namespace cvc5 {
 namespace theory {
@@ -43,7 +49,13 @@ namespace theory {
  *
  * Decision strategies have a fixed order, which is managed by the enumeration
  * type StrategyId, where strategies with smaller id have higher precedence
- * in our global decision strategy.
+ * in our global decision strategy. Strategies with the same id are ordered by
+ * the time of their registration.
+ *
+ * Since a strategy that is done in a SAT context remains done in all its
+ * extensions (see DecisionStrategy::isDoneInContext), this class maintains a
+ * SAT-context-dependent index of the first strategy that is not done, such
+ * that the strategies before it are not polled again until backtracking.
  */
 class DecisionManager
 {
@@ -97,8 +109,9 @@ class DecisionManager
     // The strategy is context-independent.
     STRAT_SCOPE_CTX_INDEPENDENT,
   };
-  DecisionManager(context::Context* userContext);
-  ~DecisionManager() {}
+  DecisionManager(context::Context* userContext,
+                  context::Context* satContext);
+  ~DecisionManager();
   /** presolve
    *
    * This clears all decision strategies that are registered to this manager
@@ -132,14 +145,42 @@ class DecisionManager
   Node getNextDecisionRequest();
 
  private:
-  /** Map containing all strategies registered to this manager */
-  std::map<StrategyId, std::vector<DecisionStrategy*> > d_reg_strategy;
+  /**
+   * Notify that the list of registered strategies has changed, which
+   * invalidates the index of the first strategy that is not done.
+   */
+  void notifyStrategiesChanged();
+  /**
+   * The strategies registered to this manager with their ids, ordered by ids
+   * and by the time of their registration.
+   */
+  std::vector<std::pair<StrategyId, DecisionStrategy*>> d_strategies;
+  /** The number of changes of d_strategies */
+  uint64_t d_numChanges;
+  /**
+   * The (SAT-context-dependent) index in d_strategies of the first strategy
+   * that is not done in the current context, which is valid if d_numChangesC
+   * is equal to d_numChanges.
+   */
+  context::CDO<size_t> d_firstActive;
+  /** The value of d_numChanges when d_firstActive was set */
+  context::CDO<uint64_t> d_numChangesC;
   /** Set of decision strategies in this user context */
   DecisionStrategyList d_strategyCacheC;
   /** Set of decision strategies that are context independent */
   std::unordered_set<DecisionStrategy*> d_strategyCache;
+  /** The decisions returned by getNextDecisionRequest, per strategy id */
+  IntegralHistogramStat<StrategyId> d_decisions;
+  /**
+   * The decisions of the strategies that were found to be asserted false,
+   * e.g. due to a conflict, per strategy id.
+   */
+  IntegralHistogramStat<StrategyId> d_refuted;
 };
 
+/** Print the strategy id to out */
+std::ostream& operator<<(std::ostream& out, DecisionManager::StrategyId id);
+
 }  // namespace theory
 }  // namespace cvc5
 
@@ -65,6 +65,7 @@ Node DecisionStrategyFmf::getNextDecisionRequest()
         Trace("dec-strategy-debug")
             << "...assigned false, increment." << std::endl;
         // asserted false, the current literal is incremented
+        d_numRefuted++;
         curr_lit = d_curr_literal.get() + 1;
         d_curr_literal.set(curr_lit);
         // repeat
@@ -85,6 +86,11 @@ Node DecisionStrategyFmf::getNextDecisionRequest()
   return Node::null();
 }
 
+bool DecisionStrategyFmf::isDoneInContext() const
+{
+  return d_has_curr_literal.get();
+}
+
 bool DecisionStrategyFmf::getAssertedLiteralIndex(unsigned& i) const
 {
   if (d_has_curr_literal.get())
@@ -30,8 +30,10 @@ namespace theory {
  */
 class DecisionStrategy
 {
+  friend class DecisionManager;
+
  public:
-  DecisionStrategy() {}
+  DecisionStrategy() : d_numDecisions(0), d_numRefuted(0) {}
   virtual ~DecisionStrategy() {}
   /**
    * Initalize this strategy, This is called once per satisfiability call by
@@ -44,8 +46,29 @@ class DecisionStrategy
    * the current CNF stream.
    */
   virtual Node getNextDecisionRequest() = 0;
+  /**
+   * Return true if this strategy has no further decisions in the current SAT
+   * context and all its extensions, that is, if getNextDecisionRequest
+   * returns null until the SAT context is backtracked. This is used by the
+   * DecisionManager for not polling this strategy again. The default
+   * implementation returns false.
+   */
+  virtual bool isDoneInContext() const { return false; }
   /** identify this strategy (for debugging) */
   virtual std::string identify() const = 0;
+  /** Get the number of decisions of this strategy taken by the SAT solver */
+  uint64_t getNumDecisions() const { return d_numDecisions; }
+  /**
+   * Get the number of times a literal of this strategy was found to be
+   * asserted false, e.g. due to a conflict.
+   */
+  uint64_t getNumRefuted() const { return d_numRefuted; }
+
+ protected:
+  /** The number of decisions, incremented by the DecisionManager */
+  uint64_t d_numDecisions;
+  /** The number of refuted decisions, incremented by subclasses */
+  uint64_t d_numRefuted;
 };
 
 /**
@@ -73,6 +96,11 @@ class DecisionStrategyFmf : public DecisionStrategy
   void initialize() override;
   /** get next decision request */
   Node getNextDecisionRequest() override;
+  /**
+   * This strategy is done if a literal is asserted true or the literals are
+   * exhausted, which is determined by the last call to getNextDecisionRequest.
+   */
+  bool isDoneInContext() const override;
   /** Make the n^th literal of this strategy */
   virtual Node mkLiteral(unsigned n) = 0;
   /**
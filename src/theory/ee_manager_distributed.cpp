@@ -114,5 +114,12 @@ void EqEngineManagerDistributed::MasterNotifyClass::eqNotifyNewClass(TNode t)
   d_quantEngine->eqNotifyNewClass(t);
 }
 
+void EqEngineManagerDistributed::MasterNotifyClass::eqNotifyMerge(TNode t1,
+                                                                  TNode t2)
+{
+  // counts the merges in the quantifiers term database
+  d_quantEngine->eqNotifyMerge(t1, t2);
+}
+
 }  // namespace theory
 }  // namespace cvc5
@@ -129,6 +129,10 @@ void EngineOutputChannel::demandRestart()
   lemma(restartVar, LemmaProperty::REMOVABLE);
 }
 
+void EngineOutputChannel::beginLemmaBatch() { d_engine->beginLemmaBatch(); }
+
+void EngineOutputChannel::endLemmaBatch() { d_engine->endLemmaBatch(); }
+
 void EngineOutputChannel::requirePhase(TNode n, bool phase)
 {
   Trace("theory") << "EngineOutputChannel::requirePhase(" << n << ", " << phase
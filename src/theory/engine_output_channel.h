@@ -56,6 +56,10 @@ class EngineOutputChannel : public theory::OutputChannel
 
   void demandRestart() override;
 
+  void beginLemmaBatch() override;
+
+  void endLemmaBatch() override;
+
   void requirePhase(TNode n, bool phase) override;
 
   void setIncomplete() override;
@@ -25,6 +25,457 @@
 namespace cvc5 {
 namespace theory {
 
+namespace {
+
+/**
+ * Get the evaluation result of the constant n, or an invalid result if n is
+ * not a constant supported in the EvalResult class.
+ */
+EvalResult evalConst(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::CONST_BOOLEAN: return EvalResult(n.getConst<bool>());
+    case kind::CONST_RATIONAL: return EvalResult(n.getConst<Rational>());
+    case kind::UNINTERPRETED_CONSTANT:
+      return EvalResult(n.getConst<UninterpretedConstant>());
+    case kind::CONST_STRING: return EvalResult(n.getConst<String>());
+    case kind::CONST_BITVECTOR: return EvalResult(n.getConst<BitVector>());
+    default: break;
+  }
+  return EvalResult();
+}
+
+/**
+ * Evaluate the application n, where c(i) is the (valid) result of evaluating
+ * the i^th child of n. Returns an invalid result if the kind of n is not
+ * supported. This is shared by Evaluator and PreparedEvaluator.
+ */
+template <typename ChildResult>
+EvalResult evalApp(TNode n, ChildResult c)
+{
+  switch (n.getKind())
+  {
+    case kind::NOT:
+    {
+      return EvalResult(!(c(0).d_bool));
+    }
+
+    case kind::AND:
+    {
+      bool res = c(0).d_bool;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res && c(i).d_bool;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::OR:
+    {
+      bool res = c(0).d_bool;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res || c(i).d_bool;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::PLUS:
+    {
+      Rational res = c(0).d_rat;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res + c(i).d_rat;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::MINUS:
+    {
+      const Rational& x = c(0).d_rat;
+      const Rational& y = c(1).d_rat;
+      return EvalResult(x - y);
+    }
+
+    case kind::UMINUS:
+    {
+      const Rational& x = c(0).d_rat;
+      return EvalResult(-x);
+    }
+    case kind::MULT:
+    case kind::NONLINEAR_MULT:
+    {
+      Rational res = c(0).d_rat;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res * c(i).d_rat;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::GEQ:
+    {
+      const Rational& x = c(0).d_rat;
+      const Rational& y = c(1).d_rat;
+      return EvalResult(x >= y);
+    }
+    case kind::LEQ:
+    {
+      const Rational& x = c(0).d_rat;
+      const Rational& y = c(1).d_rat;
+      return EvalResult(x <= y);
+    }
+    case kind::GT:
+    {
+      const Rational& x = c(0).d_rat;
+      const Rational& y = c(1).d_rat;
+      return EvalResult(x > y);
+    }
+    case kind::LT:
+    {
+      const Rational& x = c(0).d_rat;
+      const Rational& y = c(1).d_rat;
+      return EvalResult(x < y);
+    }
+    case kind::ABS:
+    {
+      const Rational& x = c(0).d_rat;
+      return EvalResult(x.abs());
+    }
+    case kind::STRING_CONCAT:
+    {
+      String res = c(0).d_str;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(c(i).d_str);
+      }
+      return EvalResult(res);
+    }
+
+    case kind::STRING_LENGTH:
+    {
+      const String& s = c(0).d_str;
+      return EvalResult(Rational(s.size()));
+    }
+
+    case kind::STRING_SUBSTR:
+    {
+      const String& s = c(0).d_str;
+      Integer s_len(s.size());
+      Integer i = c(1).d_rat.getNumerator();
+      Integer j = c(2).d_rat.getNumerator();
+
+      if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
+      {
+        return EvalResult(String(""));
+      }
+      else if (i + j > s_len)
+      {
+        return EvalResult(s.suffix((s_len - i).toUnsignedInt()));
+      }
+      else
+      {
+        return EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
+      }
+    }
+
+    case kind::STRING_UPDATE:
+    {
+      const String& s = c(0).d_str;
+      Integer s_len(s.size());
+      Integer i = c(1).d_rat.getNumerator();
+      const String& t = c(2).d_str;
+
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        return EvalResult(s);
+      }
+      else
+      {
+        return EvalResult(s.update(i.toUnsignedInt(), t));
+      }
+    }
+    case kind::STRING_CHARAT:
+    {
+      const String& s = c(0).d_str;
+      Integer s_len(s.size());
+      Integer i = c(1).d_rat.getNumerator();
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        return EvalResult(String(""));
+      }
+      else
+      {
+        return EvalResult(s.substr(i.toUnsignedInt(), 1));
+      }
+    }
+
+    case kind::STRING_STRCTN:
+    {
+      const String& s = c(0).d_str;
+      const String& t = c(1).d_str;
+      return EvalResult(s.find(t) != std::string::npos);
+    }
+
+    case kind::STRING_STRIDOF:
+    {
+      const String& s = c(0).d_str;
+      Integer s_len(s.size());
+      const String& x = c(1).d_str;
+      Integer i = c(2).d_rat.getNumerator();
+
+      if (i.strictlyNegative())
+      {
+        return EvalResult(Rational(-1));
+      }
+      else
+      {
+        size_t r = s.find(x, i.toUnsignedInt());
+        if (r == std::string::npos)
+        {
+          return EvalResult(Rational(-1));
+        }
+        else
+        {
+          return EvalResult(Rational(r));
+        }
+      }
+    }
+
+    case kind::STRING_STRREPL:
+    {
+      const String& s = c(0).d_str;
+      const String& x = c(1).d_str;
+      const String& y = c(2).d_str;
+      return EvalResult(s.replace(x, y));
+    }
+
+    case kind::STRING_PREFIX:
+    {
+      const String& t = c(0).d_str;
+      const String& s = c(1).d_str;
+      if (s.size() < t.size())
+      {
+        return EvalResult(false);
+      }
+      else
+      {
+        return EvalResult(s.prefix(t.size()) == t);
+      }
+    }
+
+    case kind::STRING_SUFFIX:
+    {
+      const String& t = c(0).d_str;
+      const String& s = c(1).d_str;
+      if (s.size() < t.size())
+      {
+        return EvalResult(false);
+      }
+      else
+      {
+        return EvalResult(s.suffix(t.size()) == t);
+      }
+    }
+
+    case kind::STRING_ITOS:
+    {
+      Integer i = c(0).d_rat.getNumerator();
+      if (i.strictlyNegative())
+      {
+        return EvalResult(String(""));
+      }
+      else
+      {
+        return EvalResult(String(i.toString()));
+      }
+    }
+
+    case kind::STRING_STOI:
+    {
+      const String& s = c(0).d_str;
+      if (s.isNumber())
+      {
+        return EvalResult(Rational(s.toNumber()));
+      }
+      else
+      {
+        return EvalResult(Rational(-1));
+      }
+    }
+
+    case kind::STRING_FROM_CODE:
+    {
+      Integer i = c(0).d_rat.getNumerator();
+      if (i >= 0 && i < strings::utils::getAlphabetCardinality())
+      {
+        std::vector<unsigned> svec = {i.toUnsignedInt()};
+        return EvalResult(String(svec));
+      }
+      else
+      {
+        return EvalResult(String(""));
+      }
+    }
+
+    case kind::STRING_TO_CODE:
+    {
+      const String& s = c(0).d_str;
+      if (s.size() == 1)
+      {
+        return EvalResult(Rational(s.getVec()[0]));
+      }
+      else
+      {
+        return EvalResult(Rational(-1));
+      }
+    }
+
+    case kind::BITVECTOR_NOT:
+      return EvalResult(~c(0).d_bv);
+
+    case kind::BITVECTOR_NEG:
+      return EvalResult(-c(0).d_bv);
+
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned lo = bv::utils::getExtractLow(n);
+      unsigned hi = bv::utils::getExtractHigh(n);
+      return EvalResult(c(0).d_bv.extract(hi, lo));
+    }
+
+    case kind::BITVECTOR_CONCAT:
+    {
+      BitVector res = c(0).d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(c(i).d_bv);
+      }
+      return EvalResult(res);
+    }
+
+    case kind::BITVECTOR_PLUS:
+    {
+      BitVector res = c(0).d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res + c(i).d_bv;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::BITVECTOR_MULT:
+    {
+      BitVector res = c(0).d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res * c(i).d_bv;
+      }
+      return EvalResult(res);
+    }
+    case kind::BITVECTOR_AND:
+    {
+      BitVector res = c(0).d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res & c(i).d_bv;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::BITVECTOR_OR:
+    {
+      BitVector res = c(0).d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res | c(i).d_bv;
+      }
+      return EvalResult(res);
+    }
+
+    case kind::BITVECTOR_XOR:
+    {
+      BitVector res = c(0).d_bv;
+      for (size_t i = 1, end = n.getNumChildren(); i < end; i++)
+      {
+        res = res ^ c(i).d_bv;
+      }
+      return EvalResult(res);
+    }
+    case kind::BITVECTOR_UDIV:
+    {
+      BitVector res = c(0).d_bv;
+      res = res.unsignedDivTotal(c(1).d_bv);
+      return EvalResult(res);
+    }
+    case kind::BITVECTOR_UREM:
+    {
+      BitVector res = c(0).d_bv;
+      res = res.unsignedRemTotal(c(1).d_bv);
+      return EvalResult(res);
+    }
+
+    case kind::EQUAL:
+    {
+      const EvalResult& lhs = c(0);
+      const EvalResult& rhs = c(1);
+
+      switch (lhs.d_tag)
+      {
+        case EvalResult::BOOL:
+        {
+          return EvalResult(lhs.d_bool == rhs.d_bool);
+        }
+
+        case EvalResult::BITVECTOR:
+        {
+          return EvalResult(lhs.d_bv == rhs.d_bv);
+        }
+
+        case EvalResult::RATIONAL:
+        {
+          return EvalResult(lhs.d_rat == rhs.d_rat);
+        }
+
+        case EvalResult::STRING:
+        {
+          return EvalResult(lhs.d_str == rhs.d_str);
+        }
+        case EvalResult::UCONST:
+        {
+          return EvalResult(lhs.d_uc == rhs.d_uc);
+        }
+
+        default:
+        {
+          Trace("evaluator") << "Theory " << Theory::theoryOf(n[0])
+                             << " not supported" << std::endl;
+          return EvalResult();
+        }
+      }
+    }
+
+    case kind::ITE:
+    {
+      if (c(0).d_bool)
+      {
+        return c(1);
+      }
+      else
+      {
+        return c(2);
+      }
+    }
+
+
+    default: break;
+  }
+  return EvalResult();
+}
+
+}  // namespace
+
 EvalResult::EvalResult(const EvalResult& other)
 {
   d_tag = other.d_tag;
@@ -55,28 +506,9 @@ EvalResult& EvalResult::operator=(const EvalResult& other)
 {
   if (this != &other)
   {
-    d_tag = other.d_tag;
-    switch (d_tag)
-    {
-      case BOOL: d_bool = other.d_bool; break;
-      case BITVECTOR:
-        new (&d_bv) BitVector;
-        d_bv = other.d_bv;
-        break;
-      case RATIONAL:
-        new (&d_rat) Rational;
-        d_rat = other.d_rat;
-        break;
-      case STRING:
-        new (&d_str) String;
-        d_str = other.d_str;
-        break;
-      case UCONST:
-        new (&d_uc)
-            UninterpretedConstant(other.d_uc.getType(), other.d_uc.getIndex());
-        break;
-      case INVALID: break;
-    }
+    // destroy the current value, which may be of another type than other
+    this->~EvalResult();
+    new (this) EvalResult(other);
   }
   return *this;
 }
@@ -381,503 +813,24 @@ EvalResult Evaluator::evalInternal(
           }
         }
         break;
-        case kind::CONST_BOOLEAN:
-          results[currNode] = EvalResult(currNodeVal.getConst<bool>());
-          break;
-
-        case kind::NOT:
-        {
-          results[currNode] = EvalResult(!(results[currNode[0]].d_bool));
-          break;
-        }
-
-        case kind::AND:
-        {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res && results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::OR:
-        {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res || results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::CONST_RATIONAL:
-        {
-          const Rational& r = currNodeVal.getConst<Rational>();
-          results[currNode] = EvalResult(r);
-          break;
-        }
-        case kind::UNINTERPRETED_CONSTANT:
-        {
-          const UninterpretedConstant& uc =
-              currNodeVal.getConst<UninterpretedConstant>();
-          results[currNode] = EvalResult(uc);
-          break;
-        }
-        case kind::PLUS:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::MINUS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x - y);
-          break;
-        }
-
-        case kind::UMINUS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(-x);
-          break;
-        }
-        case kind::MULT:
-        case kind::NONLINEAR_MULT:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::GEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x >= y);
-          break;
-        }
-        case kind::LEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x <= y);
-          break;
-        }
-        case kind::GT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x > y);
-          break;
-        }
-        case kind::LT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x < y);
-          break;
-        }
-        case kind::ABS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x.abs());
-          break;
-        }
-        case kind::CONST_STRING:
-          results[currNode] = EvalResult(currNodeVal.getConst<String>());
-          break;
-
-        case kind::STRING_CONCAT:
-        {
-          String res = results[currNode[0]].d_str;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_str);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::STRING_LENGTH:
-        {
-          const String& s = results[currNode[0]].d_str;
-          results[currNode] = EvalResult(Rational(s.size()));
-          break;
-        }
-
-        case kind::STRING_SUBSTR:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          Integer j = results[currNode[2]].d_rat.getNumerator();
-
-          if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else if (i + j > s_len)
-          {
-            results[currNode] =
-                EvalResult(s.suffix((s_len - i).toUnsignedInt()));
-          }
-          else
-          {
-            results[currNode] =
-                EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
-          }
-          break;
-        }
-
-        case kind::STRING_UPDATE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          const String& t = results[currNode[2]].d_str;
-
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(s);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.update(i.toUnsignedInt(), t));
-          }
-          break;
-        }
-        case kind::STRING_CHARAT:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.substr(i.toUnsignedInt(), 1));
-          }
-          break;
-        }
-
-        case kind::STRING_STRCTN:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& t = results[currNode[1]].d_str;
-          results[currNode] = EvalResult(s.find(t) != std::string::npos);
-          break;
-        }
-
-        case kind::STRING_STRIDOF:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          const String& x = results[currNode[1]].d_str;
-          Integer i = results[currNode[2]].d_rat.getNumerator();
-
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          else
-          {
-            size_t r = s.find(x, i.toUnsignedInt());
-            if (r == std::string::npos)
-            {
-              results[currNode] = EvalResult(Rational(-1));
-            }
-            else
-            {
-              results[currNode] = EvalResult(Rational(r));
-            }
-          }
-          break;
-        }
-
-        case kind::STRING_STRREPL:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& x = results[currNode[1]].d_str;
-          const String& y = results[currNode[2]].d_str;
-          results[currNode] = EvalResult(s.replace(x, y));
-          break;
-        }
-
-        case kind::STRING_PREFIX:
-        {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.prefix(t.size()) == t);
-          }
-          break;
-        }
-
-        case kind::STRING_SUFFIX:
-        {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.suffix(t.size()) == t);
-          }
-          break;
-        }
-
-        case kind::STRING_ITOS:
-        {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(i.toString()));
-          }
-          break;
-        }
-
-        case kind::STRING_STOI:
-        {
-          const String& s = results[currNode[0]].d_str;
-          if (s.isNumber())
-          {
-            results[currNode] = EvalResult(Rational(s.toNumber()));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
-        }
-
-        case kind::STRING_FROM_CODE:
-        {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i >= 0 && i < strings::utils::getAlphabetCardinality())
-          {
-            std::vector<unsigned> svec = {i.toUnsignedInt()};
-            results[currNode] = EvalResult(String(svec));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          break;
-        }
-
-        case kind::STRING_TO_CODE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          if (s.size() == 1)
-          {
-            results[currNode] = EvalResult(Rational(s.getVec()[0]));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
-        }
-
-        case kind::CONST_BITVECTOR:
-          results[currNode] = EvalResult(currNodeVal.getConst<BitVector>());
-          break;
-
-        case kind::BITVECTOR_NOT:
-          results[currNode] = EvalResult(~results[currNode[0]].d_bv);
-          break;
-
-        case kind::BITVECTOR_NEG:
-          results[currNode] = EvalResult(-results[currNode[0]].d_bv);
-          break;
-
-        case kind::BITVECTOR_EXTRACT:
-        {
-          unsigned lo = bv::utils::getExtractLow(currNodeVal);
-          unsigned hi = bv::utils::getExtractHigh(currNodeVal);
-          results[currNode] =
-              EvalResult(results[currNode[0]].d_bv.extract(hi, lo));
-          break;
-        }
-
-        case kind::BITVECTOR_CONCAT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_bv);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::BITVECTOR_PLUS:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::BITVECTOR_MULT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_AND:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res & results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::BITVECTOR_OR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res | results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::BITVECTOR_XOR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res ^ results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_UDIV:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.unsignedDivTotal(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_UREM:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.unsignedRemTotal(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
-          break;
-        }
-
-        case kind::EQUAL:
-        {
-          EvalResult lhs = results[currNode[0]];
-          EvalResult rhs = results[currNode[1]];
-
-          switch (lhs.d_tag)
-          {
-            case EvalResult::BOOL:
-            {
-              results[currNode] = EvalResult(lhs.d_bool == rhs.d_bool);
-              break;
-            }
-
-            case EvalResult::BITVECTOR:
-            {
-              results[currNode] = EvalResult(lhs.d_bv == rhs.d_bv);
-              break;
-            }
-
-            case EvalResult::RATIONAL:
-            {
-              results[currNode] = EvalResult(lhs.d_rat == rhs.d_rat);
-              break;
-            }
-
-            case EvalResult::STRING:
-            {
-              results[currNode] = EvalResult(lhs.d_str == rhs.d_str);
-              break;
-            }
-            case EvalResult::UCONST:
-            {
-              results[currNode] = EvalResult(lhs.d_uc == rhs.d_uc);
-              break;
-            }
-
-            default:
-            {
-              Trace("evaluator") << "Theory " << Theory::theoryOf(currNode[0])
-                                 << " not supported" << std::endl;
-              results[currNode] = EvalResult();
-              evalAsNode[currNode] =
-                  needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                                   : currNodeVal;
-              break;
-            }
-          }
-
-          break;
-        }
-
-        case kind::ITE:
+        default:
         {
-          if (results[currNode[0]].d_bool)
-          {
-            results[currNode] = results[currNode[1]];
-          }
-          else
+          EvalResult res =
+              currNodeVal.getNumChildren() == 0
+                  ? evalConst(currNodeVal)
+                  : evalApp(currNodeVal,
+                            [&results, &currNode](size_t i) -> EvalResult& {
+                              return results[currNode[i]];
+                            });
+          results[currNode] = res;
+          if (res.d_tag == EvalResult::INVALID)
           {
-            results[currNode] = results[currNode[2]];
+            Trace("evaluator") << "Kind " << currNodeVal.getKind()
+                               << " not supported" << std::endl;
+            evalAsNode[currNode] =
+                needsReconstruct ? reconstruct(currNode, results, evalAsNode)
+                                 : currNodeVal;
           }
-          break;
-        }
-
-        default:
-        {
-          Trace("evaluator") << "Kind " << currNodeVal.getKind()
-                             << " not supported" << std::endl;
-          results[currNode] = EvalResult();
-          evalAsNode[currNode] =
-              needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                               : currNodeVal;
         }
       }
     }
@@ -951,5 +904,129 @@ Node Evaluator::reconstruct(
   return nn;
 }
 
+bool PreparedEvaluator::prepare(TNode n, const std::vector<Node>& args)
+{
+  d_term = n;
+  d_vars = args;
+  d_code.clear();
+  d_args.clear();
+  d_slots.clear();
+  std::unordered_map<TNode, size_t, TNodeHashFunction> slot;
+  std::unordered_map<TNode, size_t, TNodeHashFunction>::iterator it;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    if (slot.find(cur) != slot.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    // applications of non-constant operators, e.g. APPLY_UF, and binders are
+    // handled by substitution and rewriting in Evaluator
+    if (cur.isClosure()
+        || (cur.getMetaKind() == kind::metakind::PARAMETERIZED
+            && !cur.getOperator().isConst()))
+    {
+      Trace("evaluator") << "PreparedEvaluator: cannot prepare " << cur
+                         << std::endl;
+      d_code.clear();
+      return false;
+    }
+    bool ready = true;
+    for (const Node& cn : cur)
+    {
+      if (slot.find(cn) == slot.end())
+      {
+        visit.push_back(cn);
+        ready = false;
+      }
+    }
+    if (!ready)
+    {
+      continue;
+    }
+    visit.pop_back();
+    Instr ins{Instr::APP, cur, 0, 0};
+    EvalResult res;
+    if (cur.isVar())
+    {
+      std::vector<Node>::const_iterator itv =
+          std::find(args.begin(), args.end(), cur);
+      if (itv == args.end())
+      {
+        // a free variable does not evaluate to a constant
+        d_code.clear();
+        return false;
+      }
+      ins.d_kind = Instr::VAR;
+      ins.d_index = std::distance(args.begin(), itv);
+    }
+    else if (cur.getNumChildren() == 0)
+    {
+      res = evalConst(cur);
+      if (res.d_tag == EvalResult::INVALID)
+      {
+        d_code.clear();
+        return false;
+      }
+      ins.d_kind = Instr::CONST;
+    }
+    else
+    {
+      ins.d_index = d_args.size();
+      ins.d_numArgs = cur.getNumChildren();
+      for (const Node& cn : cur)
+      {
+        d_args.push_back(slot[cn]);
+      }
+    }
+    slot[cur] = d_code.size();
+    d_code.push_back(ins);
+    d_slots.push_back(res);
+  } while (!visit.empty());
+  Trace("evaluator") << "PreparedEvaluator: prepared " << n << " with "
+                     << d_code.size() << " instructions" << std::endl;
+  return true;
+}
+
+Node PreparedEvaluator::eval(const std::vector<Node>& vals)
+{
+  if (d_code.empty())
+  {
+    return Node::null();
+  }
+  Assert(vals.size() == d_vars.size());
+  for (size_t i = 0, ncode = d_code.size(); i < ncode; i++)
+  {
+    const Instr& ins = d_code[i];
+    switch (ins.d_kind)
+    {
+      case Instr::CONST: break;
+      case Instr::VAR: d_slots[i] = evalConst(vals[ins.d_index]); break;
+      case Instr::APP:
+      {
+        const size_t* args = &d_args[ins.d_index];
+        d_slots[i] =
+            evalApp(ins.d_node, [this, args](size_t j) -> const EvalResult& {
+              return d_slots[args[j]];
+            });
+        break;
+      }
+    }
+    if (d_slots[i].d_tag == EvalResult::INVALID)
+    {
+      return Node::null();
+    }
+  }
+  Node ret = d_slots.back().toNode();
+  // should be the same as substitution + rewriting
+  Assert(ret
+         == Rewriter::rewrite(d_term.substitute(
+             d_vars.begin(), d_vars.end(), vals.begin(), vals.end())));
+  return ret;
+}
+
 }  // namespace theory
 }  // namespace cvc5
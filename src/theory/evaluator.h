@@ -158,6 +158,72 @@ class Evaluator
       std::unordered_map<TNode, Node, NodeHashFunction>& evalAsNode) const;
 };
 
+/**
+ * A term prepared for evaluation under many substitutions of the same
+ * variables, e.g. on the sample points or examples of a sygus conjecture.
+ *
+ * Whereas Evaluator::eval traverses the term and maintains maps from its
+ * subterms to their results on each call, the term is compiled here once to
+ * a flat sequence of instructions in post-order, whose arguments are indices
+ * of the instructions of the children. Evaluating under a substitution runs
+ * these instructions on a reused vector of results, without map lookups or
+ * the construction of Nodes for intermediate results.
+ *
+ * Only terms whose subterms can all be evaluated by EvalResult can be
+ * prepared, that is, terms without applications of non-constant operators,
+ * binders or variables not in the domain of the substitution.
+ */
+class PreparedEvaluator
+{
+ public:
+  /**
+   * Prepare n for evaluation under substitutions of the variables args.
+   * Returns false if n cannot be prepared.
+   */
+  bool prepare(TNode n, const std::vector<Node>& args);
+  /** Get the term given to the last call to prepare */
+  Node getTerm() const { return d_term; }
+  /**
+   * Evaluate the prepared term under the substitution { args -> vals }. The
+   * result is either Rewriter::rewrite(n.substitute(args, vals)) or the null
+   * node if evaluation failed, e.g. if a value in vals is not a constant
+   * supported by EvalResult, in which case Evaluator::eval should be used.
+   */
+  Node eval(const std::vector<Node>& vals);
+
+ private:
+  /** An instruction, whose result is stored at its index in d_slots */
+  struct Instr
+  {
+    enum Kind
+    {
+      /** A constant, whose result is stored when preparing */
+      CONST,
+      /** The d_index^th variable of the substitution */
+      VAR,
+      /** An application whose arguments start at d_index in d_args */
+      APP
+    };
+    Kind d_kind;
+    /** The subterm of this instruction */
+    TNode d_node;
+    /** The index of the variable or of the first argument */
+    size_t d_index;
+    /** The number of arguments */
+    size_t d_numArgs;
+  };
+  /** The prepared term */
+  Node d_term;
+  /** The variables of the substitution */
+  std::vector<Node> d_vars;
+  /** The instructions, in post-order */
+  std::vector<Instr> d_code;
+  /** The indices of the arguments of all instructions */
+  std::vector<size_t> d_args;
+  /** The results of the instructions */
+  std::vector<EvalResult> d_slots;
+};
+
 }  // namespace theory
 }  // namespace cvc5
 
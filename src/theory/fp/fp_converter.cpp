@@ -18,6 +18,7 @@
 
 #include "base/check.h"
 #include "expr/node_builder.h"
+#include "options/fp_options.h"
 #include "theory/theory.h"  // theory.h Only needed for the leaf test
 #include "util/floatingpoint.h"
 #include "util/floatingpoint_literal_symfpu.h"
@@ -826,7 +827,8 @@ Node FpConverter::sbvToNode(const sbv &s) const { return s; }
 FpConverter::uf FpConverter::buildComponents(TNode current)
 {
   Assert(Theory::isLeafOf(current, THEORY_FP)
-         || current.getKind() == kind::FLOATINGPOINT_TO_FP_REAL);
+         || current.getKind() == kind::FLOATINGPOINT_TO_FP_REAL
+         || isLazilyBlasted(current));
 
   NodeManager *nm = NodeManager::currentNM();
   uf tmp(nm->mkNode(kind::FLOATINGPOINT_COMPONENT_NAN, current),
@@ -916,7 +918,13 @@ Node FpConverter::convert(TNode node)
 
       if (i == d_fpMap.end())
       {
-        if (Theory::isLeafOf(current, THEORY_FP))
+        if (isLazilyBlasted(current))
+        {
+          /******** Lazily converted operations ********/
+          // The result is a variable until the operation is blasted.
+          d_fpMap.insert(current, buildComponents(current));
+        }
+        else if (Theory::isLeafOf(current, THEORY_FP))
         {
           if (current.getKind() == kind::CONST_FLOATINGPOINT)
           {
@@ -1708,9 +1716,81 @@ Node FpConverter::convert(TNode node)
 
 #undef CVC4_FPCONV_PASSTHROUGH
 
+bool FpConverter::isLazilyBlasted(TNode node)
+{
+  if (!options::fpLazyWb())
+  {
+    return false;
+  }
+  switch (node.getKind())
+  {
+    case kind::FLOATINGPOINT_MULT:
+    case kind::FLOATINGPOINT_DIV:
+    case kind::FLOATINGPOINT_FMA:
+    case kind::FLOATINGPOINT_SQRT:
+    case kind::FLOATINGPOINT_REM: return true;
+    default: return false;
+  }
+}
+
+void FpConverter::blast(TNode node)
+{
+  Assert(isLazilyBlasted(node));
+#ifdef CVC4_USE_SYMFPU
+  // convert the arguments, which were skipped when converting node
+  for (const Node& n : node)
+  {
+    convert(n);
+  }
+  fpMap::const_iterator i(d_fpMap.find(node));
+  Assert(i != d_fpMap.end());
+  fpt format(node.getType());
+  d_additionalAssertions.push_back(symfpu::smtlibEqual<traits>(
+      format, (*i).second, blastOperation(node)));
+#else
+  Unimplemented() << "Conversion is dependent on SymFPU";
+#endif
+}
+
+#ifdef CVC4_USE_SYMFPU
+FpConverter::uf FpConverter::blastOperation(TNode node)
+{
+  fpt format(node.getType());
+  switch (node.getKind())
+  {
+    case kind::FLOATINGPOINT_MULT:
+      return symfpu::multiply<traits>(format,
+                                      (*d_rmMap.find(node[0])).second,
+                                      (*d_fpMap.find(node[1])).second,
+                                      (*d_fpMap.find(node[2])).second);
+    case kind::FLOATINGPOINT_DIV:
+      return symfpu::divide<traits>(format,
+                                    (*d_rmMap.find(node[0])).second,
+                                    (*d_fpMap.find(node[1])).second,
+                                    (*d_fpMap.find(node[2])).second);
+    case kind::FLOATINGPOINT_FMA:
+      return symfpu::fma<traits>(format,
+                                 (*d_rmMap.find(node[0])).second,
+                                 (*d_fpMap.find(node[1])).second,
+                                 (*d_fpMap.find(node[2])).second,
+                                 (*d_fpMap.find(node[3])).second);
+    case kind::FLOATINGPOINT_SQRT:
+      return symfpu::sqrt<traits>(format,
+                                  (*d_rmMap.find(node[0])).second,
+                                  (*d_fpMap.find(node[1])).second);
+    case kind::FLOATINGPOINT_REM:
+      return symfpu::remainder<traits>(format,
+                                       (*d_fpMap.find(node[0])).second,
+                                       (*d_fpMap.find(node[1])).second);
+    default: Unreachable() << "Unknown lazily converted operation"; break;
+  }
+  return (*d_fpMap.find(node)).second;
+}
+#endif
+
 Node FpConverter::getValue(Valuation &val, TNode var)
 {
-  Assert(Theory::isLeafOf(var, THEORY_FP));
+  Assert(Theory::isLeafOf(var, THEORY_FP) || isLazilyBlasted(var));
 
 #ifdef CVC4_USE_SYMFPU
   TypeNode t(var.getType());
@@ -310,6 +310,18 @@ class FpConverter
   /** Gives the node representing the value of a given variable */
   Node getValue(Valuation&, TNode);
 
+  /**
+   * Is node an operation that is converted lazily, that is, whose result is
+   * converted as a variable until blast is called on it? This is the case for
+   * the operations with large circuits when --fp-lazy-wb is enabled.
+   */
+  static bool isLazilyBlasted(TNode node);
+  /**
+   * Adds to the additional assertions the equality between the result of
+   * node, which is converted lazily, and its word-blasted circuit.
+   */
+  void blast(TNode node);
+
   context::CDList<Node> d_additionalAssertions;
 
  protected:
@@ -334,6 +346,9 @@ class FpConverter
   ubvMap d_ubvMap;
   sbvMap d_sbvMap;
 
+  /** Builds the circuit of node, which is converted lazily */
+  uf blastOperation(TNode node);
+
   /* These functions take a symfpu object and convert it to a node.
    * These should ensure that constant folding it will give a
    * constant of the right type.
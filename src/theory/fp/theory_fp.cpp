@@ -114,6 +114,8 @@ TheoryFp::TheoryFp(context::Context* c,
       d_registeredTerms(u),
       d_conv(new FpConverter(u)),
       d_expansionRequested(false),
+      d_lazyTerms(u),
+      d_blastedTerms(u),
       d_minMap(u),
       d_maxMap(u),
       d_toUBVMap(u),
@@ -746,6 +748,69 @@ bool TheoryFp::refineAbstraction(TheoryModel *m, TNode abstract, TNode concrete)
   return false;
 }
 
+void TheoryFp::abstractionLemmas(TNode node)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = node.getKind();
+  // the result is NaN if an argument is NaN
+  std::vector<Node> nanArgs;
+  for (const Node& n : node)
+  {
+    if (n.getType().isFloatingPoint())
+    {
+      nanArgs.push_back(nm->mkNode(kind::FLOATINGPOINT_ISNAN, n));
+    }
+  }
+  Node nanNode = nm->mkNode(kind::FLOATINGPOINT_ISNAN, node);
+  Node nanArg =
+      nanArgs.size() == 1 ? nanArgs[0] : nm->mkNode(kind::OR, nanArgs);
+  handleLemma(nm->mkNode(kind::IMPLIES, nanArg, nanNode));
+  if (k == kind::FLOATINGPOINT_MULT || k == kind::FLOATINGPOINT_DIV)
+  {
+    // the sign of the result is the exclusive or of the signs of the arguments
+    Node sign = nm->mkNode(kind::XOR,
+                           nm->mkNode(kind::FLOATINGPOINT_ISNEG, node[1]),
+                           nm->mkNode(kind::FLOATINGPOINT_ISNEG, node[2]));
+    handleLemma(nm->mkNode(
+        kind::IMPLIES,
+        nanNode.notNode(),
+        nm->mkNode(kind::FLOATINGPOINT_ISNEG, node).eqNode(sign)));
+  }
+  else if (k == kind::FLOATINGPOINT_SQRT)
+  {
+    // the result is negative only if it is -0
+    handleLemma(nm->mkNode(kind::IMPLIES,
+                           nm->mkNode(kind::FLOATINGPOINT_ISNEG, node),
+                           nm->mkNode(kind::FLOATINGPOINT_ISZ, node)));
+  }
+}
+
+bool TheoryFp::refineLazyTerm(TheoryModel* m, TNode node)
+{
+  Node abstractValue =
+      Rewriter::rewrite(m->getValue(d_conv->getValue(d_valuation, node)));
+  NodeBuilder<> nb(node.getKind());
+  for (const Node& n : node)
+  {
+    nb << m->getValue(n);
+  }
+  Node concreteValue = Rewriter::rewrite(nb.constructNode());
+  Trace("fp-refineAbstraction")
+      << "TheoryFp::refineLazyTerm(): " << node << " = " << abstractValue
+      << ", concretely " << concreteValue << std::endl;
+  if (abstractValue.isConst() && abstractValue == concreteValue)
+  {
+    // No refinement needed
+    return false;
+  }
+  // blast the operation, which generates its circuit
+  d_blastedTerms.insert(node);
+  size_t oldAdditionalAssertions = d_conv->d_additionalAssertions.size();
+  d_conv->blast(node);
+  handleAdditionalAssertions(oldAdditionalAssertions);
+  return true;
+}
+
 void TheoryFp::convertAndEquateTerm(TNode node) {
   Trace("fp-convertTerm") << "TheoryFp::convertTerm(): " << node << std::endl;
   size_t oldAdditionalAssertions = d_conv->d_additionalAssertions.size();
@@ -759,26 +824,7 @@ void TheoryFp::convertAndEquateTerm(TNode node) {
         << "TheoryFp::convertTerm(): after  " << converted << std::endl;
   }
 
-  size_t newAdditionalAssertions = d_conv->d_additionalAssertions.size();
-  Assert(oldAdditionalAssertions <= newAdditionalAssertions);
-
-  while (oldAdditionalAssertions < newAdditionalAssertions) {
-    Node addA = d_conv->d_additionalAssertions[oldAdditionalAssertions];
-
-    Debug("fp-convertTerm") << "TheoryFp::convertTerm(): additional assertion  "
-                            << addA << std::endl;
-
-#ifdef SYMFPUPROPISBOOL
-    handleLemma(addA, false, true);
-#else
-    NodeManager *nm = NodeManager::currentNM();
-
-    handleLemma(
-        nm->mkNode(kind::EQUAL, addA, nm->mkConst(::cvc5::BitVector(1U, 1U))));
-#endif
-
-    ++oldAdditionalAssertions;
-  }
+  handleAdditionalAssertions(oldAdditionalAssertions);
 
   // Equate the floating-point atom and the converted one.
   // Also adds the bit-vectors to the bit-vector solver.
@@ -814,6 +860,30 @@ void TheoryFp::convertAndEquateTerm(TNode node) {
   return;
 }
 
+void TheoryFp::handleAdditionalAssertions(size_t oldAdditionalAssertions)
+{
+  size_t newAdditionalAssertions = d_conv->d_additionalAssertions.size();
+  Assert(oldAdditionalAssertions <= newAdditionalAssertions);
+
+  while (oldAdditionalAssertions < newAdditionalAssertions) {
+    Node addA = d_conv->d_additionalAssertions[oldAdditionalAssertions];
+
+    Debug("fp-convertTerm") << "TheoryFp::convertTerm(): additional assertion  "
+                            << addA << std::endl;
+
+#ifdef SYMFPUPROPISBOOL
+    handleLemma(addA, false, true);
+#else
+    NodeManager *nm = NodeManager::currentNM();
+
+    handleLemma(
+        nm->mkNode(kind::EQUAL, addA, nm->mkConst(::cvc5::BitVector(1U, 1U))));
+#endif
+
+    ++oldAdditionalAssertions;
+  }
+}
+
 void TheoryFp::registerTerm(TNode node) {
   Trace("fp-registerTerm") << "TheoryFp::registerTerm(): " << node << std::endl;
 
@@ -883,6 +953,12 @@ void TheoryFp::registerTerm(TNode node) {
 
     // Use symfpu to produce an equivalent bit-vector statement
     convertAndEquateTerm(node);
+
+    if (FpConverter::isLazilyBlasted(node))
+    {
+      d_lazyTerms.insert(node);
+      abstractionLemmas(node);
+    }
   }
   return;
 }
@@ -943,9 +1019,9 @@ void TheoryFp::conflictEqConstantMerge(TNode t1, TNode t2)
 
 bool TheoryFp::needsCheckLastEffort() 
 { 
-  // only need to check if we have added to the abstraction map, otherwise
-  // postCheck below is a no-op.
-  return !d_abstractionMap.empty(); 
+  // only need to check if we have added to the abstraction map or have
+  // lazily converted operations, otherwise postCheck below is a no-op.
+  return !d_abstractionMap.empty() || !d_lazyTerms.empty();
 }
 
 void TheoryFp::postCheck(Effort level)
@@ -966,6 +1042,14 @@ void TheoryFp::postCheck(Effort level)
         lemmaAdded |= refineAbstraction(m, (*i).first, (*i).second);
       }
     }
+
+    for (const Node& n : d_lazyTerms)
+    {
+      if (d_blastedTerms.find(n) == d_blastedTerms.end() && m->hasTerm(n))
+      {
+        lemmaAdded |= refineLazyTerm(m, n);
+      }
+    }
   }
 
   Trace("fp") << "TheoryFp::check(): completed" << std::endl;
@@ -141,6 +141,26 @@ class TheoryFp : public Theory
   bool d_expansionRequested;
 
   void convertAndEquateTerm(TNode node);
+  /** Send the additional assertions of the converter from index start */
+  void handleAdditionalAssertions(size_t start);
+
+  /**
+   * The operations that are converted lazily (see
+   * FpConverter::isLazilyBlasted), and those of them that are blasted.
+   */
+  context::CDHashSet<Node, NodeHashFunction> d_lazyTerms;
+  context::CDHashSet<Node, NodeHashFunction> d_blastedTerms;
+  /**
+   * Send the sign and NaN propagation lemmas for the lazily converted
+   * operation node, which hold without its circuit.
+   */
+  void abstractionLemmas(TNode node);
+  /**
+   * Blast the lazily converted operation node if its value in m differs from
+   * the result of the operation on the values of its arguments. Returns true
+   * if node was blasted.
+   */
+  bool refineLazyTerm(TheoryModel* m, TNode node);
 
   /** Interaction with the rest of the solver **/
   void handleLemma(Node node, InferenceId id = InferenceId::UNKNOWN);
@@ -38,6 +38,7 @@ const char* toString(InferenceId i)
     case InferenceId::ARITH_BB_LEMMA: return "ARITH_BB_LEMMA";
     case InferenceId::ARITH_DIO_CUT: return "ARITH_DIO_CUT";
     case InferenceId::ARITH_DIO_DECOMPOSITION: return "ARITH_DIO_DECOMPOSITION";
+    case InferenceId::ARITH_DIO_SUBSTITUTION: return "ARITH_DIO_SUBSTITUTION";
     case InferenceId::ARITH_SPLIT_FOR_NL_MODEL:
       return "ARITH_SPLIT_FOR_NL_MODEL";
     case InferenceId::ARITH_PP_ELIM_OPERATORS: return "ARITH_PP_ELIM_OPERATORS";
@@ -320,6 +321,7 @@ const char* toString(InferenceId i)
       return "STRINGS_RE_INTER_INCLUDE";
     case InferenceId::STRINGS_RE_INTER_CONF: return "STRINGS_RE_INTER_CONF";
     case InferenceId::STRINGS_RE_INTER_INFER: return "STRINGS_RE_INTER_INFER";
+    case InferenceId::STRINGS_RE_EAGER_CONF: return "STRINGS_RE_EAGER_CONF";
     case InferenceId::STRINGS_RE_DELTA: return "STRINGS_RE_DELTA";
     case InferenceId::STRINGS_RE_DELTA_CONF: return "STRINGS_RE_DELTA_CONF";
     case InferenceId::STRINGS_RE_DERIVE: return "STRINGS_RE_DERIVE";
@@ -66,6 +66,8 @@ enum class InferenceId
   ARITH_BB_LEMMA,
   ARITH_DIO_CUT,
   ARITH_DIO_DECOMPOSITION,
+  // a variable elimination solved by the dio solver
+  ARITH_DIO_SUBSTITUTION,
   ARITH_SPLIT_FOR_NL_MODEL,
   //-------------------- preprocessing
   // equivalence of term and its preprocessed form
@@ -604,6 +606,10 @@ enum class InferenceId
   // intersection inference
   //   (x in R1 ^ y in R2 ^ x = y) => (x in re.inter(R1,R2))
   STRINGS_RE_INTER_INFER,
+  // eager conflict for a membership of a constant
+  //   (x = c ^ x in R) => false   where [[c in R]] = false, or
+  //   (x = c ^ ~ x in R) => false   where [[c in R]] = true
+  STRINGS_RE_EAGER_CONF,
   // regular expression delta
   //   (x = "" ^ x in R) => C
   // where "" in R holds if and only if C holds.
@@ -14,6 +14,7 @@
 
 #include "theory/inference_manager_buffered.h"
 
+#include "options/theory_options.h"
 #include "theory/rewriter.h"
 #include "theory/theory.h"
 #include "theory/theory_state.h"
@@ -117,6 +118,11 @@ void InferenceManagerBuffered::doPendingLemmas()
     return;
   }
   d_processingPendingLemmas = true;
+  bool batch = options::lemmaBatching();
+  if (batch)
+  {
+    d_out.beginLemmaBatch();
+  }
   size_t i = 0;
   while (i < d_pendingLem.size())
   {
@@ -126,6 +132,10 @@ void InferenceManagerBuffered::doPendingLemmas()
     i++;
   }
   d_pendingLem.clear();
+  if (batch)
+  {
+    d_out.endLemmaBatch();
+  }
   d_processingPendingLemmas = false;
 }
 
@@ -186,7 +186,7 @@ void ModelManager::collectAssertedTerms(TheoryId tid,
 {
   Theory* t = d_te.theoryOf(tid);
   // Collect all terms appearing in assertions
-  context::CDList<Assertion>::const_iterator assert_it = t->facts_begin(),
+  context::CDChunkList<Assertion>::const_iterator assert_it = t->facts_begin(),
                                              assert_it_end = t->facts_end();
   for (; assert_it != assert_it_end; ++assert_it)
   {
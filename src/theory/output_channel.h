@@ -179,6 +179,17 @@ class OutputChannel {
    */
   virtual void demandRestart() {}
 
+  /**
+   * Begin a batch of lemmas. The lemmas sent until the matching call to
+   * endLemmaBatch() may be buffered and asserted together when the batch
+   * ends. Batches may be nested, in which case the lemmas are asserted when
+   * the outermost batch ends. Note that the literals of the atoms of buffered
+   * lemmas may not exist until then.
+   */
+  virtual void beginLemmaBatch() {}
+  /** End a batch of lemmas, see beginLemmaBatch() */
+  virtual void endLemmaBatch() {}
+
   //---------------------------- new proof
   /**
    * Let pconf be the pair (Node conf, ProofGenerator * pfg). This method
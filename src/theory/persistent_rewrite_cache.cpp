@@ -0,0 +1,762 @@
+/*********************                                                        */
+/*! \file persistent_rewrite_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A rewrite cache that is persisted on disk across runs.
+ **/
+
+#include "theory/persistent_rewrite_cache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "base/configuration.h"
+#include "base/output.h"
+#include "expr/attribute.h"
+#include "expr/node_builder.h"
+#include "expr/node_manager.h"
+#include "expr/type_checker.h"
+#include "options/options.h"
+#include "options/set_language.h"
+#include "theory/logic_info.h"
+#include "util/bitvector.h"
+#include "util/hash.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace theory {
+
+namespace {
+
+/** Attribute caching the structural hash of a node */
+struct StructuralHashAttributeId
+{
+};
+typedef expr::Attribute<StructuralHashAttributeId, uint64_t>
+    StructuralHashAttribute;
+
+/** Marks the start of a record, "RWC1" */
+const uint32_t s_recordMagic = 0x31435752;
+
+/** The tags of the entries of keys and values */
+enum EntryTag : char
+{
+  /** A leaf (constant or variable) of a key, identified by its printed form */
+  ENTRY_LEAF = 'L',
+  /** An internal node, followed by its kind and children */
+  ENTRY_NODE = 'N',
+  /** A constant of a value, followed by its kind and value */
+  ENTRY_CONST = 'C',
+  /** A reference from a value to a DAG node of the key */
+  ENTRY_REF = 'R',
+};
+
+uint64_t hashBytes(const char* data, size_t len, uint64_t hash)
+{
+  for (size_t i = 0; i < len; ++i)
+  {
+    hash = fnv1a::fnv1a_64(static_cast<unsigned char>(data[i]), hash);
+  }
+  return hash;
+}
+
+void putU32(std::string& out, uint32_t v)
+{
+  out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void putString(std::string& out, const std::string& s)
+{
+  putU32(out, static_cast<uint32_t>(s.size()));
+  out.append(s);
+}
+
+/** Reads from a buffer, remembering whether it ran past its end */
+class Reader
+{
+ public:
+  Reader(const char* data, size_t len) : d_data(data), d_end(data + len) {}
+  bool atEnd() const { return d_data == d_end; }
+  bool failed() const { return d_failed; }
+  char getChar()
+  {
+    if (d_data == d_end)
+    {
+      d_failed = true;
+      return 0;
+    }
+    return *d_data++;
+  }
+  uint32_t getU32()
+  {
+    uint32_t v = 0;
+    if (static_cast<size_t>(d_end - d_data) < sizeof(v))
+    {
+      d_failed = true;
+      return 0;
+    }
+    std::memcpy(&v, d_data, sizeof(v));
+    d_data += sizeof(v);
+    return v;
+  }
+  std::string getString()
+  {
+    uint32_t len = getU32();
+    if (static_cast<size_t>(d_end - d_data) < len)
+    {
+      d_failed = true;
+      return std::string();
+    }
+    std::string s(d_data, len);
+    d_data += len;
+    return s;
+  }
+
+ private:
+  const char* d_data;
+  const char* d_end;
+  bool d_failed = false;
+};
+
+/**
+ * The children of n in the DAG of the encoding, which includes the operator
+ * of parameterized nodes.
+ */
+void getDagChildren(TNode n, std::vector<TNode>& children)
+{
+  children.clear();
+  if (n.getMetaKind() == kind::metakind::PARAMETERIZED)
+  {
+    children.push_back(n.getOperator());
+  }
+  children.insert(children.end(), n.begin(), n.end());
+}
+
+/**
+ * The printed form of a leaf n, which identifies it (together with its
+ * kind) across runs.
+ */
+std::string getLeafString(TNode n)
+{
+  std::stringstream ss;
+  ss << language::SetLanguage(language::output::LANG_SMTLIB_V2_6) << n
+     << " : " << n.getType();
+  return ss.str();
+}
+
+/**
+ * Encode the value of a constant n that can be reconstructed by
+ * decodeConstant() into out. Returns false if n is not such a constant.
+ */
+bool encodeConstant(TNode n, std::string& out)
+{
+  std::string payload;
+  switch (n.getKind())
+  {
+    case kind::CONST_BOOLEAN: payload = n.getConst<bool>() ? "1" : "0"; break;
+    case kind::CONST_RATIONAL:
+      payload = n.getConst<Rational>().toString();
+      break;
+    case kind::CONST_BITVECTOR:
+    {
+      const BitVector& bv = n.getConst<BitVector>();
+      payload = std::to_string(bv.getSize()) + " " + bv.getValue().toString();
+      break;
+    }
+    case kind::CONST_STRING:
+      for (unsigned c : n.getConst<String>().getVec())
+      {
+        putU32(payload, c);
+      }
+      break;
+    default: return false;
+  }
+  out.push_back(ENTRY_CONST);
+  putU32(out, static_cast<uint32_t>(n.getKind()));
+  putString(out, payload);
+  return true;
+}
+
+/** Return true if s is a decimal numeral, possibly negative */
+bool isNumeral(const std::string& s, bool allowNegative)
+{
+  size_t start = allowNegative && !s.empty() && s[0] == '-' ? 1 : 0;
+  if (start == s.size())
+  {
+    return false;
+  }
+  for (size_t i = start, size = s.size(); i < size; i++)
+  {
+    if (s[i] < '0' || s[i] > '9')
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if s is written as Rational::toString() does, i.e., as an
+ * integer or as a fraction with a non-zero denominator.
+ */
+bool isRationalString(const std::string& s)
+{
+  size_t slash = s.find('/');
+  if (slash == std::string::npos)
+  {
+    return isNumeral(s, true);
+  }
+  std::string den = s.substr(slash + 1);
+  return isNumeral(s.substr(0, slash), true) && isNumeral(den, false)
+         && den.find_first_not_of('0') != std::string::npos;
+}
+
+/**
+ * Reconstruct a constant encoded by encodeConstant(), or return the null node
+ * if payload is malformed.
+ */
+Node decodeConstant(Kind k, const std::string& payload)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  switch (k)
+  {
+    case kind::CONST_BOOLEAN:
+      if (payload != "0" && payload != "1")
+      {
+        return Node::null();
+      }
+      return nm->mkConst(payload == "1");
+    case kind::CONST_RATIONAL:
+      if (!isRationalString(payload))
+      {
+        return Node::null();
+      }
+      return nm->mkConst(Rational(payload));
+    case kind::CONST_BITVECTOR:
+    {
+      size_t pos = payload.find(' ');
+      if (pos == std::string::npos)
+      {
+        return Node::null();
+      }
+      std::string size = payload.substr(0, pos);
+      std::string value = payload.substr(pos + 1);
+      // at most 10 digits, so that std::stoull cannot throw
+      if (!isNumeral(size, false) || size.size() > 10
+          || !isNumeral(value, false))
+      {
+        return Node::null();
+      }
+      uint64_t width = std::stoull(size);
+      Integer v(value);
+      if (width == 0 || width > std::numeric_limits<uint32_t>::max()
+          || v.length() > width)
+      {
+        return Node::null();
+      }
+      return nm->mkConst(BitVector(static_cast<unsigned>(width), v));
+    }
+    case kind::CONST_STRING:
+    {
+      if (payload.size() % sizeof(uint32_t) != 0)
+      {
+        return Node::null();
+      }
+      std::vector<unsigned> vec(payload.size() / sizeof(uint32_t));
+      for (size_t i = 0, size = vec.size(); i < size; ++i)
+      {
+        uint32_t c;
+        std::memcpy(&c, payload.data() + i * sizeof(uint32_t), sizeof(c));
+        if (c >= String::num_codes())
+        {
+          return Node::null();
+        }
+        vec[i] = c;
+      }
+      return nm->mkConst(String(vec));
+    }
+    default: return Node::null();
+  }
+}
+
+}  // namespace
+
+PersistentRewriteCache::PersistentRewriteCache(const std::string& filename,
+                                               uint64_t fingerprint)
+    : d_filename(filename),
+      d_fingerprint(fingerprint),
+      d_fd(-1),
+      d_data(nullptr),
+      d_size(0)
+{
+  d_fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (d_fd < 0)
+  {
+    Warning() << "cannot open rewrite cache " << filename << ": "
+              << std::strerror(errno) << std::endl;
+    return;
+  }
+  struct stat st;
+  if (::fstat(d_fd, &st) == 0 && st.st_size > 0)
+  {
+    void* data = ::mmap(nullptr,
+                        static_cast<size_t>(st.st_size),
+                        PROT_READ,
+                        MAP_SHARED,
+                        d_fd,
+                        0);
+    if (data != MAP_FAILED)
+    {
+      d_data = static_cast<const char*>(data);
+      d_size = static_cast<size_t>(st.st_size);
+      indexRecords();
+    }
+  }
+  Trace("rewrite-cache") << "opened rewrite cache " << filename << " with "
+                         << d_index.size() << " keys" << std::endl;
+}
+
+PersistentRewriteCache::~PersistentRewriteCache()
+{
+  if (d_data != nullptr)
+  {
+    ::munmap(const_cast<char*>(d_data), d_size);
+  }
+  if (d_fd >= 0)
+  {
+    ::close(d_fd);
+  }
+}
+
+void PersistentRewriteCache::indexRecords()
+{
+  size_t offset = 0;
+  while (d_size - offset >= sizeof(RecordHeader))
+  {
+    RecordHeader h;
+    std::memcpy(&h, d_data + offset, sizeof(h));
+    size_t len = sizeof(h) + size_t(h.d_keyLen) + h.d_valLen;
+    if (h.d_magic != s_recordMagic || len > d_size - offset
+        || h.d_checksum
+               != static_cast<uint32_t>(hashBytes(
+                   d_data + offset + sizeof(h), len - sizeof(h), h.d_hash)))
+    {
+      // a partially written or corrupted record, ignore the rest
+      Trace("rewrite-cache") << "corrupt record at offset " << offset
+                             << std::endl;
+      break;
+    }
+    if (h.d_fingerprint == d_fingerprint)
+    {
+      d_index[h.d_hash].push_back(offset);
+    }
+    offset += len;
+  }
+}
+
+void PersistentRewriteCache::discardFrom(size_t offset)
+{
+  Trace("rewrite-cache") << "discard records from offset " << offset
+                         << std::endl;
+  for (auto it = d_index.begin(); it != d_index.end();)
+  {
+    // the offsets are in increasing order
+    std::vector<size_t>& offsets = it->second;
+    offsets.erase(std::lower_bound(offsets.begin(), offsets.end(), offset),
+                  offsets.end());
+    it = offsets.empty() ? d_index.erase(it) : std::next(it);
+  }
+}
+
+uint64_t PersistentRewriteCache::computeFingerprint(const Options& opts,
+                                                    const LogicInfo& logic)
+{
+  static const std::vector<std::string> s_ignored = {"rewrite-cache",
+                                                     "tlimit",
+                                                     "rlimit",
+                                                     "seed",
+                                                     "random-seed",
+                                                     "verbosity",
+                                                     "stats",
+                                                     "portfolio-jobs",
+                                                     "cube-index"};
+  uint64_t h = fnv1a::fnv1a_64(s_recordMagic);
+  // the rewriters depend on the version and on the logic
+  std::string version =
+      Configuration::getVersionString() + " " + Configuration::getGitId();
+  h = hashBytes(version.data(), version.size(), h);
+  // the logic is only locked once the SmtEngine is initialized
+  LogicInfo locked = logic;
+  locked.lock();
+  std::string logicString = locked.getLogicString();
+  h = hashBytes(logicString.data(), logicString.size(), h);
+  for (const std::vector<std::string>& o : opts.getOptions())
+  {
+    const std::string& name = o[0];
+    bool ignore = false;
+    for (const std::string& prefix : s_ignored)
+    {
+      if (name.compare(0, prefix.size(), prefix) == 0)
+      {
+        ignore = true;
+        break;
+      }
+    }
+    if (!ignore)
+    {
+      h = hashBytes(name.data(), name.size(), h);
+      h = hashBytes(o[1].data(), o[1].size(), h);
+    }
+  }
+  return h;
+}
+
+uint64_t PersistentRewriteCache::structuralHash(TNode n)
+{
+  StructuralHashAttribute sha;
+  uint64_t h;
+  if (n.getAttribute(sha, h))
+  {
+    return h;
+  }
+  std::vector<std::pair<TNode, bool>> visit;
+  std::vector<TNode> children;
+  visit.emplace_back(n, false);
+  while (!visit.empty())
+  {
+    std::pair<TNode, bool> cur = visit.back();
+    visit.pop_back();
+    if (cur.first.hasAttribute(sha))
+    {
+      continue;
+    }
+    getDagChildren(cur.first, children);
+    if (!cur.second)
+    {
+      visit.emplace_back(cur.first, true);
+      for (const TNode& c : children)
+      {
+        visit.emplace_back(c, false);
+      }
+      continue;
+    }
+    h = fnv1a::fnv1a_64(static_cast<uint64_t>(cur.first.getKind()));
+    if (children.empty())
+    {
+      std::string s = getLeafString(cur.first);
+      h = hashBytes(s.data(), s.size(), h);
+    }
+    for (const TNode& c : children)
+    {
+      h = fnv1a::fnv1a_64(c.getAttribute(sha), h);
+    }
+    cur.first.setAttribute(sha, h);
+  }
+  return n.getAttribute(sha);
+}
+
+bool PersistentRewriteCache::encodeKey(TNode n,
+                                       std::string& key,
+                                       std::vector<TNode>& dag)
+{
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> index;
+  std::vector<std::pair<TNode, bool>> visit;
+  std::vector<TNode> children;
+  visit.emplace_back(n, false);
+  while (!visit.empty())
+  {
+    std::pair<TNode, bool> cur = visit.back();
+    visit.pop_back();
+    if (index.find(cur.first) != index.end())
+    {
+      continue;
+    }
+    getDagChildren(cur.first, children);
+    if (!cur.second)
+    {
+      visit.emplace_back(cur.first, true);
+      // push in reverse, so that children are numbered left to right
+      for (size_t i = children.size(); i > 0; --i)
+      {
+        visit.emplace_back(children[i - 1], false);
+      }
+      continue;
+    }
+    if (dag.size() >= s_maxDagSize)
+    {
+      return false;
+    }
+    if (children.empty())
+    {
+      key.push_back(ENTRY_LEAF);
+      putU32(key, static_cast<uint32_t>(cur.first.getKind()));
+      putString(key, getLeafString(cur.first));
+    }
+    else
+    {
+      key.push_back(ENTRY_NODE);
+      putU32(key, static_cast<uint32_t>(cur.first.getKind()));
+      putU32(key, static_cast<uint32_t>(children.size()));
+      for (const TNode& c : children)
+      {
+        putU32(key, index[c]);
+      }
+    }
+    index[cur.first] = static_cast<uint32_t>(dag.size());
+    dag.push_back(cur.first);
+  }
+  return true;
+}
+
+bool PersistentRewriteCache::encodeValue(TNode ret,
+                                         const std::vector<TNode>& dag,
+                                         std::string& val)
+{
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> keyIndex;
+  for (size_t i = 0, n = dag.size(); i < n; ++i)
+  {
+    keyIndex[dag[i]] = static_cast<uint32_t>(i);
+  }
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> index;
+  std::vector<std::pair<TNode, bool>> visit;
+  std::vector<TNode> children;
+  visit.emplace_back(ret, false);
+  while (!visit.empty())
+  {
+    std::pair<TNode, bool> cur = visit.back();
+    visit.pop_back();
+    if (index.find(cur.first) != index.end())
+    {
+      continue;
+    }
+    if (index.size() >= s_maxDagSize)
+    {
+      return false;
+    }
+    std::unordered_map<TNode, uint32_t, TNodeHashFunction>::iterator it =
+        keyIndex.find(cur.first);
+    if (it != keyIndex.end())
+    {
+      val.push_back(ENTRY_REF);
+      putU32(val, it->second);
+    }
+    else
+    {
+      getDagChildren(cur.first, children);
+      if (children.empty())
+      {
+        if (!encodeConstant(cur.first, val))
+        {
+          // e.g. a fresh variable, which we cannot reconstruct
+          return false;
+        }
+      }
+      else if (!cur.second)
+      {
+        visit.emplace_back(cur.first, true);
+        for (size_t i = children.size(); i > 0; --i)
+        {
+          visit.emplace_back(children[i - 1], false);
+        }
+        continue;
+      }
+      else
+      {
+        val.push_back(ENTRY_NODE);
+        putU32(val, static_cast<uint32_t>(cur.first.getKind()));
+        putU32(val, static_cast<uint32_t>(children.size()));
+        for (const TNode& c : children)
+        {
+          putU32(val, index[c]);
+        }
+      }
+    }
+    uint32_t i = static_cast<uint32_t>(index.size());
+    index[cur.first] = i;
+  }
+  return true;
+}
+
+Node PersistentRewriteCache::decodeValue(const char* val,
+                                         size_t len,
+                                         const std::vector<TNode>& dag)
+{
+  std::vector<Node> nodes;
+  Reader r(val, len);
+  while (!r.atEnd() && !r.failed())
+  {
+    char tag = r.getChar();
+    if (tag == ENTRY_REF)
+    {
+      uint32_t i = r.getU32();
+      if (i >= dag.size())
+      {
+        return Node::null();
+      }
+      nodes.push_back(dag[i]);
+      continue;
+    }
+    uint32_t k = r.getU32();
+    if (r.failed() || k >= static_cast<uint32_t>(kind::LAST_KIND))
+    {
+      return Node::null();
+    }
+    Kind kind = static_cast<Kind>(k);
+    Node n;
+    if (tag == ENTRY_CONST)
+    {
+      n = decodeConstant(kind, r.getString());
+    }
+    else if (tag == ENTRY_NODE)
+    {
+      uint32_t nchildren = r.getU32();
+      kind::MetaKind mk = kind::metaKindOf(kind);
+      uint32_t nargs =
+          mk == kind::metakind::PARAMETERIZED ? nchildren - 1 : nchildren;
+      if (nchildren == 0 || mk == kind::metakind::CONSTANT
+          || mk == kind::metakind::VARIABLE
+          || nargs < kind::metakind::getMinArityForKind(kind)
+          || nargs > kind::metakind::getMaxArityForKind(kind))
+      {
+        return Node::null();
+      }
+      NodeBuilder<> nb(kind);
+      for (uint32_t j = 0; j < nchildren; ++j)
+      {
+        uint32_t c = r.getU32();
+        if (c >= nodes.size())
+        {
+          return Node::null();
+        }
+        nb << nodes[c];
+      }
+      n = nb.constructNode();
+    }
+    if (n.isNull())
+    {
+      return Node::null();
+    }
+    nodes.push_back(n);
+  }
+  if (r.failed() || nodes.empty())
+  {
+    return Node::null();
+  }
+  return nodes.back();
+}
+
+Node PersistentRewriteCache::lookup(TNode n)
+{
+  if (d_index.empty())
+  {
+    return Node::null();
+  }
+  uint64_t h = structuralHash(n);
+  std::unordered_map<uint64_t, std::vector<size_t>>::const_iterator it =
+      d_index.find(h);
+  if (it == d_index.end())
+  {
+    return Node::null();
+  }
+  std::string key;
+  std::vector<TNode> dag;
+  if (!encodeKey(n, key, dag))
+  {
+    return Node::null();
+  }
+  for (size_t offset : it->second)
+  {
+    RecordHeader rh;
+    std::memcpy(&rh, d_data + offset, sizeof(rh));
+    const char* k = d_data + offset + sizeof(rh);
+    if (rh.d_keyLen != key.size() || std::memcmp(k, key.data(), key.size()) != 0)
+    {
+      continue;
+    }
+    Node ret = decodeValue(k + rh.d_keyLen, rh.d_valLen, dag);
+    if (!ret.isNull())
+    {
+      try
+      {
+        if (!ret.getType(true).isComparableTo(n.getType()))
+        {
+          ret = Node::null();
+        }
+      }
+      catch (TypeCheckingExceptionPrivate& e)
+      {
+        ret = Node::null();
+      }
+    }
+    if (ret.isNull())
+    {
+      // the checksum of the record is valid, so it was not written by a
+      // crashed writer; we do not trust the log from there on
+      discardFrom(offset);
+      return Node::null();
+    }
+    Trace("rewrite-cache") << "hit for " << n << ": " << ret << std::endl;
+    return ret;
+  }
+  return Node::null();
+}
+
+void PersistentRewriteCache::store(TNode n, TNode ret)
+{
+  if (d_fd < 0)
+  {
+    return;
+  }
+  std::string key;
+  std::vector<TNode> dag;
+  std::string val;
+  if (!encodeKey(n, key, dag) || !encodeValue(ret, dag, val))
+  {
+    Trace("rewrite-cache") << "cannot store rewrite of " << n << std::endl;
+    return;
+  }
+  RecordHeader h;
+  h.d_magic = s_recordMagic;
+  h.d_keyLen = static_cast<uint32_t>(key.size());
+  h.d_valLen = static_cast<uint32_t>(val.size());
+  h.d_fingerprint = d_fingerprint;
+  h.d_hash = structuralHash(n);
+  std::string record(reinterpret_cast<const char*>(&h), sizeof(h));
+  record.append(key);
+  record.append(val);
+  h.d_checksum = static_cast<uint32_t>(hashBytes(
+      record.data() + sizeof(h), record.size() - sizeof(h), h.d_hash));
+  std::memcpy(&record[0], &h, sizeof(h));
+  // a single write to a file opened for appending, so that records of
+  // concurrent processes do not interleave
+  if (::write(d_fd, record.data(), record.size())
+      != static_cast<ssize_t>(record.size()))
+  {
+    Warning() << "cannot write to rewrite cache " << d_filename << ": "
+              << std::strerror(errno) << std::endl;
+    ::close(d_fd);
+    d_fd = -1;
+  }
+}
+
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,154 @@
+/*********************                                                        */
+/*! \file persistent_rewrite_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A rewrite cache that is persisted on disk across runs.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__PERSISTENT_REWRITE_CACHE_H
+#define CVC4__THEORY__PERSISTENT_REWRITE_CACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+
+class LogicInfo;
+class Options;
+
+namespace theory {
+
+/**
+ * A content-addressed cache of rewrites that lives in a file, so that it is
+ * shared by all runs (and processes) that use the same file.
+ *
+ * The file is an append-only sequence of records, each mapping the encoding
+ * of a node to the encoding of its rewritten form. Nodes are encoded
+ * structurally: the nodes of their DAG are listed in post-order, where
+ * constants are identified by their value and type, and variables by their
+ * kind, name and type. The rewritten form is encoded relative to the DAG of
+ * the original node, so that it can only refer to variables and constants
+ * occurring in the original node, or to Boolean, rational, bit-vector and
+ * string constants. Rewrites whose result is not encodable in this way are
+ * not cached.
+ *
+ * Records are tagged with a fingerprint of the version, the logic and the
+ * options, since rewriting depends on them; records with a different
+ * fingerprint are ignored. The
+ * file is memory-mapped when the cache is opened and indexed by a structural
+ * hash of the original node. Records appended afterwards (by this or by
+ * concurrent processes) become visible the next time the file is opened. A
+ * truncated or corrupted tail, e.g. from a crashed writer, is ignored. So is
+ * the tail starting at a record that is well-formed but whose value cannot
+ * be decoded, or is ill-typed.
+ *
+ * Note that nodes with the same encoding in different runs may rewrite to
+ * different nodes, e.g. when a theory rewriter orders terms by node id.
+ * Callers should therefore rewrite the result of lookup() again; see
+ * Rewriter::rewrite().
+ */
+class PersistentRewriteCache
+{
+ public:
+  /**
+   * Open the cache in the given file, which is created if it does not
+   * exist. Records not tagged with fingerprint are ignored.
+   */
+  PersistentRewriteCache(const std::string& filename, uint64_t fingerprint);
+  ~PersistentRewriteCache();
+
+  /** Whether the file could be opened */
+  bool isOpen() const { return d_fd >= 0; }
+
+  /**
+   * Get the rewritten form of n stored in the cache, or the null node if
+   * there is none.
+   */
+  Node lookup(TNode n);
+
+  /**
+   * Store that n rewrites to ret. Does nothing if ret can not be encoded
+   * relative to n, or if n is too large.
+   */
+  void store(TNode n, TNode ret);
+
+  /** The structural hash of n, which is cached in an attribute */
+  static uint64_t structuralHash(TNode n);
+
+  /**
+   * A fingerprint of the version, the logic and the options that may affect
+   * rewriting. Options that certainly do not (e.g. resource limits and
+   * verbosity) are ignored, so that runs differing only in these share their
+   * records.
+   */
+  static uint64_t computeFingerprint(const Options& opts,
+                                     const LogicInfo& logic);
+
+ private:
+  /** The header of a record, followed by the key and the value */
+  struct RecordHeader
+  {
+    uint32_t d_magic;
+    uint32_t d_keyLen;
+    uint32_t d_valLen;
+    uint32_t d_checksum;
+    uint64_t d_fingerprint;
+    uint64_t d_hash;
+  };
+  /** The maximal number of DAG nodes of the keys and values */
+  static constexpr size_t s_maxDagSize = 1 << 16;
+
+  /** Index the records in the mapped file */
+  void indexRecords();
+  /** Remove the records from the given offset on from the index */
+  void discardFrom(size_t offset);
+  /**
+   * Encode n into key, and store the DAG nodes of n in post-order in dag.
+   * Returns false if n has more than s_maxDagSize DAG nodes.
+   */
+  static bool encodeKey(TNode n, std::string& key, std::vector<TNode>& dag);
+  /**
+   * Encode ret relative to the DAG nodes dag of the key into val. Returns
+   * false if that is not possible.
+   */
+  static bool encodeValue(TNode ret,
+                          const std::vector<TNode>& dag,
+                          std::string& val);
+  /**
+   * Decode the value val relative to the DAG nodes dag of the key, or
+   * return the null node if val is malformed.
+   */
+  static Node decodeValue(const char* val,
+                          size_t len,
+                          const std::vector<TNode>& dag);
+
+  /** The name of the file */
+  std::string d_filename;
+  /** The fingerprint of the records of this run */
+  uint64_t d_fingerprint;
+  /** The file descriptor, or -1 if the file could not be opened */
+  int d_fd;
+  /** The mapped contents of the file */
+  const char* d_data;
+  /** The size of the mapped contents */
+  size_t d_size;
+  /** Maps structural hashes to the offsets of the records with that hash */
+  std::unordered_map<uint64_t, std::vector<size_t>> d_index;
+};
+
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__PERSISTENT_REWRITE_CACHE_H */
@@ -15,6 +15,8 @@
 
 #include "theory/quantifiers/alpha_equivalence.h"
 
+#include "expr/alpha_hash.h"
+
 using namespace cvc5::kind;
 
 namespace cvc5 {
@@ -59,6 +61,18 @@ Node AlphaEquivalenceDb::addTerm(Node q)
 {
   Assert(q.getKind() == FORALL);
   Trace("aeq") << "Alpha equivalence : register " << q << std::endl;
+  // check the quantified formulas with the same alpha-hash first
+  std::vector<std::pair<Node, Node>>& bucket = d_hashed[expr::getAlphaHash(q)];
+  for (const std::pair<Node, Node>& qh : bucket)
+  {
+    if (qh.first == q || expr::isAlphaEquivalent(q, qh.first))
+    {
+      Trace("aeq") << "  ...result (hashed) : " << qh.second << std::endl;
+      return qh.second;
+    }
+  }
+  // Otherwise, fall back on the canonical form, which in contrast to the
+  // alpha-hash is invariant under the reordering of commutative operators.
   //construct canonical quantified formula
   Node t = d_tc->getCanonicalTerm(q[1], true);
   Trace("aeq") << "  canonical form: " << t << std::endl;
@@ -78,6 +92,7 @@ Node AlphaEquivalenceDb::addTerm(Node q)
   Trace("aeq-debug") << "  ";
   Node ret = d_ae_typ_trie.registerNode(q, t, typs, typCount);
   Trace("aeq") << "  ...result : " << ret << std::endl;
+  bucket.emplace_back(q, ret);
   return ret;
 }
 
@@ -17,6 +17,8 @@
 #ifndef CVC4__ALPHA_EQUIVALENCE_H
 #define CVC4__ALPHA_EQUIVALENCE_H
 
+#include <unordered_map>
+
 #include "theory/quantifiers/quant_util.h"
 
 #include "expr/term_canonize.h"
@@ -68,6 +70,14 @@ class AlphaEquivalenceDb
   Node addTerm(Node q);
 
  private:
+  /**
+   * Map from alpha-hashes (see expr::getAlphaHash) to the quantified formulas
+   * added to this database with that hash, paired with the result of addTerm
+   * for them. These are checked first, so that the canonization of q below is
+   * only computed for quantified formulas whose structure is new, up to the
+   * renaming of their variables.
+   */
+  std::unordered_map<uint64_t, std::vector<std::pair<Node, Node>>> d_hashed;
   /** a trie per # of variables per type */
   AlphaEquivalenceTypeNode d_ae_typ_trie;
   /** pointer to the term canonize utility */
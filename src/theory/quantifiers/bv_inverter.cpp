@@ -103,6 +103,88 @@ Node BvInverter::getInversionNode(Node cond, TypeNode tn, BvInverterQuery* m)
 
 /*---------------------------------------------------------------------------*/
 
+Node BvInverter::getIC(
+    bool pol, Kind litk, Kind k, unsigned idx, Node x, Node s, Node t)
+{
+  TypeNode tn = x.getType();
+  ICKey key(k, idx, litk, pol, tn);
+  std::map<ICKey, Node>::iterator it = d_ic_templates.find(key);
+  std::map<TypeNode, std::pair<Node, Node>>::iterator itv =
+      d_ic_vars.find(tn);
+  if (itv == d_ic_vars.end())
+  {
+    NodeManager* nm = NodeManager::currentNM();
+    itv = d_ic_vars
+              .emplace(tn,
+                       std::pair<Node, Node>(nm->mkSkolem("ics", tn),
+                                             nm->mkSkolem("ict", tn)))
+              .first;
+  }
+  Node vs = itv->second.first;
+  Node vt = itv->second.second;
+  Node ic;
+  if (it != d_ic_templates.end())
+  {
+    ic = it->second;
+  }
+  else
+  {
+    switch (k)
+    {
+      case BITVECTOR_MULT:
+        ic = utils::getICBvMult(pol, litk, k, idx, x, vs, vt);
+        break;
+      case BITVECTOR_SHL:
+        ic = utils::getICBvShl(pol, litk, k, idx, x, vs, vt);
+        break;
+      case BITVECTOR_UREM:
+        ic = utils::getICBvUrem(pol, litk, k, idx, x, vs, vt);
+        break;
+      case BITVECTOR_UDIV:
+        ic = utils::getICBvUdiv(pol, litk, k, idx, x, vs, vt);
+        break;
+      case BITVECTOR_AND:
+      case BITVECTOR_OR:
+        ic = utils::getICBvAndOr(pol, litk, k, idx, x, vs, vt);
+        break;
+      case BITVECTOR_LSHR:
+        ic = utils::getICBvLshr(pol, litk, k, idx, x, vs, vt);
+        break;
+      case BITVECTOR_ASHR:
+        ic = utils::getICBvAshr(pol, litk, k, idx, x, vs, vt);
+        break;
+      case UNDEFINED_KIND:
+        if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT)
+        {
+          ic = utils::getICBvUltUgt(pol, litk, x, vt);
+        }
+        else if (litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
+        {
+          ic = utils::getICBvSltSgt(pol, litk, x, vt);
+        }
+        break;
+      default: break;
+    }
+    Trace("bv-invert-debug") << "IC template for " << k << " " << idx << " "
+                             << litk << " " << pol << " : " << ic << std::endl;
+    d_ic_templates[key] = ic;
+  }
+  if (ic.isNull())
+  {
+    return ic;
+  }
+  std::vector<Node> vars{vt};
+  std::vector<Node> subs{t};
+  if (!s.isNull())
+  {
+    vars.push_back(vs);
+    subs.push_back(s);
+  }
+  return ic.substitute(vars.begin(), vars.end(), subs.begin(), subs.end());
+}
+
+/*---------------------------------------------------------------------------*/
+
 static bool isInvertible(Kind k, unsigned index)
 {
   return k == NOT || k == EQUAL || k == BITVECTOR_ULT || k == BITVECTOR_SLT
@@ -306,33 +388,11 @@ Node BvInverter::solveBvLit(Node sv,
       Node inv = bv::utils::mkConst(w, inv_val);
       t = nm->mkNode(BITVECTOR_MULT, inv, t);
     }
-    else if (k == BITVECTOR_MULT)
-    {
-      ic = utils::getICBvMult(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_SHL)
-    {
-      ic = utils::getICBvShl(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_UREM)
+    else if (k == BITVECTOR_MULT || k == BITVECTOR_SHL || k == BITVECTOR_UREM
+             || k == BITVECTOR_UDIV || k == BITVECTOR_AND || k == BITVECTOR_OR
+             || k == BITVECTOR_LSHR || k == BITVECTOR_ASHR)
     {
-      ic = utils::getICBvUrem(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_UDIV)
-    {
-      ic = utils::getICBvUdiv(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_AND || k == BITVECTOR_OR)
-    {
-      ic = utils::getICBvAndOr(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_LSHR)
-    {
-      ic = utils::getICBvLshr(pol, litk, k, index, x, s, t);
-    }
-    else if (k == BITVECTOR_ASHR)
-    {
-      ic = utils::getICBvAshr(pol, litk, k, index, x, s, t);
+      ic = getIC(pol, litk, k, index, x, s, t);
     }
     else if (k == BITVECTOR_CONCAT)
     {
@@ -373,13 +433,10 @@ Node BvInverter::solveBvLit(Node sv,
     {
       ic = utils::getICBvSext(pol, litk, index, x, sv_t, t);
     }
-    else if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT)
-    {
-      ic = utils::getICBvUltUgt(pol, litk, x, t);
-    }
-    else if (litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
+    else if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT
+             || litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
     {
-      ic = utils::getICBvSltSgt(pol, litk, x, t);
+      ic = getIC(pol, litk, UNDEFINED_KIND, 0, x, Node::null(), t);
     }
     else if (pol == false)
     {
@@ -419,13 +476,10 @@ Node BvInverter::solveBvLit(Node sv,
   TypeNode solve_tn = sv.getType();
   Node x = getSolveVariable(solve_tn);
   Node ic;
-  if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT)
-  {
-    ic = utils::getICBvUltUgt(pol, litk, x, t);
-  }
-  else if (litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
+  if (litk == BITVECTOR_ULT || litk == BITVECTOR_UGT
+      || litk == BITVECTOR_SLT || litk == BITVECTOR_SGT)
   {
-    ic = utils::getICBvSltSgt(pol, litk, x, t);
+    ic = getIC(pol, litk, UNDEFINED_KIND, 0, x, Node::null(), t);
   }
   else if (pol == false)
   {
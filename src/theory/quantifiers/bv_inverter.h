@@ -18,10 +18,12 @@
 #define CVC4__BV_INVERTER_H
 
 #include <map>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "expr/kind.h"
 #include "expr/node.h"
 
 namespace cvc5 {
@@ -97,6 +99,32 @@ class BvInverter
  private:
   /** Dummy variables for each type */
   std::map<TypeNode, Node> d_solve_var;
+  /**
+   * The variables standing for s and t in the templates of invertibility
+   * conditions, for each type
+   */
+  std::map<TypeNode, std::pair<Node, Node>> d_ic_vars;
+  /**
+   * The key of a template of an invertibility condition, i.e., the kind k of
+   * the operator (or UNDEFINED_KIND for the predicate of the literal itself),
+   * the index of x, the kind litk of the literal, its polarity and the type
+   * of x.
+   */
+  using ICKey = std::tuple<Kind, unsigned, Kind, bool, TypeNode>;
+  /** The templates of invertibility conditions */
+  std::map<ICKey, Node> d_ic_templates;
+
+  /**
+   * Get the invertibility condition for x <k> s <litk> t with polarity pol,
+   * where x is the index idx child of <k>, or for x <litk> t if k is
+   * UNDEFINED_KIND, in which case s is null. This supports the operators
+   * whose invertibility condition only depends on their arguments through s
+   * and t, and returns the null node otherwise.
+   *
+   * The condition is computed once for each key (see ICKey) over the
+   * variables of d_ic_vars, and instantiated with s and t by substitution.
+   */
+  Node getIC(bool pol, Kind litk, Kind k, unsigned idx, Node x, Node s, Node t);
 
   /** Helper function for getPathToPv */
   Node getPathToPv(Node lit,
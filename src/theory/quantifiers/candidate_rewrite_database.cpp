@@ -15,6 +15,7 @@
 #include "theory/quantifiers/candidate_rewrite_database.h"
 
 #include "options/base_options.h"
+#include "options/quantifiers_options.h"
 #include "printer/printer.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
@@ -41,7 +42,8 @@ CandidateRewriteDatabase::CandidateRewriteDatabase(bool doCheck,
       d_rewAccel(rewAccel),
       d_silent(silent),
       d_filterPairs(filterPairs),
-      d_using_sygus(false)
+      d_using_sygus(false),
+      d_shardPoints(0)
 {
 }
 void CandidateRewriteDatabase::initialize(const std::vector<Node>& vars,
@@ -57,6 +59,7 @@ void CandidateRewriteDatabase::initialize(const std::vector<Node>& vars,
     d_crewrite_filter.initialize(ss, nullptr, false);
   }
   ExprMiner::initialize(vars, ss);
+  d_shardPoints = ss->getNumSamplePoints();
 }
 
 void CandidateRewriteDatabase::initializeSygus(const std::vector<Node>& vars,
@@ -74,6 +77,7 @@ void CandidateRewriteDatabase::initializeSygus(const std::vector<Node>& vars,
     d_crewrite_filter.initialize(ss, d_tds, d_using_sygus);
   }
   ExprMiner::initialize(vars, ss);
+  d_shardPoints = ss->getNumSamplePoints();
 }
 
 Node CandidateRewriteDatabase::addTerm(Node sol,
@@ -99,6 +103,12 @@ Node CandidateRewriteDatabase::addTerm(Node sol,
       addTerm(solc, rec, out, rew_printc);
     }
   }
+  if (!isInShard(sol))
+  {
+    // another instance checks the terms equivalent to sol
+    d_add_term_cache[sol] = sol;
+    return sol;
+  }
   // register the term
   bool is_unique_term = true;
   Node eq_sol = d_sampler->registerTerm(sol);
@@ -287,6 +297,17 @@ bool CandidateRewriteDatabase::addTerm(Node sol, std::ostream& out)
   return sol == rsol;
 }
 
+bool CandidateRewriteDatabase::isInShard(Node sol)
+{
+  unsigned nshards = options::sygusRewSynthShards();
+  if (nshards <= 1)
+  {
+    return true;
+  }
+  size_t h = d_sampler->getSignatureHash(sol, d_shardPoints);
+  return h % nshards == options::sygusRewSynthShard();
+}
+
 void CandidateRewriteDatabase::setSilent(bool flag) { d_silent = flag; }
 
 void CandidateRewriteDatabase::setExtendedRewriter(ExtendedRewriter* er)
@@ -124,6 +124,15 @@ class CandidateRewriteDatabase : public ExprMiner
   CandidateRewriteFilter d_crewrite_filter;
   /** the cache for results of addTerm */
   std::unordered_map<Node, Node, NodeHashFunction> d_add_term_cache;
+  /**
+   * The number of initial sample points, which are the same in all solver
+   * instances running the shards of --sygus-rr-synth-shards. Terms with
+   * distinct values on them are never equivalent, hence each class of
+   * equivalent terms belongs to a single shard.
+   */
+  unsigned d_shardPoints;
+  /** Is sol in the shard of this instance? */
+  bool isInShard(Node sol);
 };
 
 }  // namespace quantifiers
@@ -15,6 +15,7 @@
 #include "theory/quantifiers/cegqi/ceg_bv_instantiator.h"
 
 #include <stack>
+#include "expr/node_algorithm.h"
 #include "options/quantifiers_options.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/quantifiers/cegqi/ceg_bv_instantiator_utils.h"
@@ -84,40 +85,62 @@ void BvInstantiator::processLiteral(CegInstantiator* ci,
                                     CegInstEffort effort)
 {
   Assert(d_inverter != NULL);
-  // find path to pv
-  std::vector<unsigned> path;
-  Node sv = d_inverter->getSolveVariable(pv.getType());
   Node pvs = ci->getModelValue(pv);
-  Trace("cegqi-bv") << "Get path to " << pv << " : " << lit << std::endl;
-  Node slit =
-      d_inverter->getPathToPv(lit, pv, sv, pvs, path, options::cegqiBvSolveNl());
-  if (!slit.isNull())
+  std::pair<Node, Node> key(pv, lit);
+  Node inst;
+  std::unordered_map<std::pair<Node, Node>,
+                     std::pair<Node, Node>,
+                     PairHashFunction<Node,
+                                      Node,
+                                      NodeHashFunction,
+                                      NodeHashFunction>>::iterator itc =
+      d_solve_cache.find(key);
+  if (itc != d_solve_cache.end() && itc->second.first == pvs)
   {
-    CegInstantiatorBvInverterQuery m(ci);
-    unsigned iid = d_inst_id_counter;
-    Trace("cegqi-bv") << "Solve lit to bv inverter : " << slit << std::endl;
-    Node inst = d_inverter->solveBvLit(sv, slit, path, &m);
-    if (!inst.isNull())
+    inst = itc->second.second;
+    Trace("cegqi-bv") << "Cached solved form for " << pv << " : " << lit
+                      << " is " << inst << std::endl;
+  }
+  else
+  {
+    // find path to pv
+    std::vector<unsigned> path;
+    Node sv = d_inverter->getSolveVariable(pv.getType());
+    Trace("cegqi-bv") << "Get path to " << pv << " : " << lit << std::endl;
+    Node slit = d_inverter->getPathToPv(
+        lit, pv, sv, pvs, path, options::cegqiBvSolveNl());
+    if (!slit.isNull())
     {
-      inst = Rewriter::rewrite(inst);
-      if (inst.isConst() || !ci->hasNestedQuantification())
+      CegInstantiatorBvInverterQuery m(ci);
+      Trace("cegqi-bv") << "Solve lit to bv inverter : " << slit << std::endl;
+      inst = d_inverter->solveBvLit(sv, slit, path, &m);
+      if (!inst.isNull())
       {
-        Trace("cegqi-bv") << "...solved form is " << inst << std::endl;
-        // store information for id and increment
-        d_var_to_inst_id[pv].push_back(iid);
-        d_inst_id_to_term[iid] = inst;
-        d_inst_id_to_alit[iid] = alit;
-        d_inst_id_counter++;
+        inst = Rewriter::rewrite(inst);
+      }
+      else
+      {
+        Trace("cegqi-bv") << "...failed to solve." << std::endl;
       }
     }
     else
     {
-      Trace("cegqi-bv") << "...failed to solve." << std::endl;
+      Trace("cegqi-bv") << "...no path." << std::endl;
+    }
+    if (inst.isNull() || !expr::hasBoundVar(inst))
+    {
+      d_solve_cache[key] = std::pair<Node, Node>(pvs, inst);
     }
   }
-  else
+  if (!inst.isNull() && (inst.isConst() || !ci->hasNestedQuantification()))
   {
-    Trace("cegqi-bv") << "...no path." << std::endl;
+    Trace("cegqi-bv") << "...solved form is " << inst << std::endl;
+    // store information for id and increment
+    unsigned iid = d_inst_id_counter;
+    d_var_to_inst_id[pv].push_back(iid);
+    d_inst_id_to_term[iid] = inst;
+    d_inst_id_to_alit[iid] = alit;
+    d_inst_id_counter++;
   }
 }
 
@@ -117,6 +117,22 @@ class BvInstantiator : public Instantiator
   std::unordered_map<Node, unsigned, NodeHashFunction> d_var_to_curr_inst_id;
   /** the amount of slack we added for asserted literals */
   std::unordered_map<Node, Node, NodeHashFunction> d_alit_to_model_slack;
+  /**
+   * Map from (variable, literal) pairs to the model value of the variable and
+   * the solved form for the variable computed by processLiteral for that
+   * model value, or null if solving failed. The solved form only depends on
+   * these, except for the bound variables of witness terms, which depend on
+   * the current state of the CegInstantiator. Hence, solved forms with
+   * witness terms are not stored. Unlike the maps above, this is not cleared
+   * on reset, so that the paths are not explored again for the same model.
+   */
+  std::unordered_map<std::pair<Node, Node>,
+                     std::pair<Node, Node>,
+                     PairHashFunction<Node,
+                                      Node,
+                                      NodeHashFunction,
+                                      NodeHashFunction>>
+      d_solve_cache;
   //--------------------------------end solved forms
   /** rewrite assertion for solve pv
    *
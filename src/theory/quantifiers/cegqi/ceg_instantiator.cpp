@@ -1344,7 +1344,7 @@ void CegInstantiator::processAssertions() {
                         << std::endl;
     d_curr_asserts[tid].clear();
     // collect all assertions from theory
-    for (context::CDList<Assertion>::const_iterator
+    for (context::CDChunkList<Assertion>::const_iterator
              it = d_qstate.factsBegin(tid),
              itEnd = d_qstate.factsEnd(tid);
          it != itEnd;
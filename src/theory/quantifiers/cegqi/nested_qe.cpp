@@ -15,14 +15,63 @@
 
 #include "theory/quantifiers/cegqi/nested_qe.h"
 
+#include "expr/alpha_hash.h"
+#include "expr/attribute.h"
 #include "expr/node_algorithm.h"
 #include "expr/subs.h"
+#include "options/quantifiers_options.h"
+#include "theory/rewriter.h"
 #include "theory/smt_engine_subsolver.h"
 
 namespace cvc5 {
 namespace theory {
 namespace quantifiers {
 
+/**
+ * Attribute for the skolem replacing a bound variable in nested quantifier
+ * elimination. Using the same skolem for a variable in each call makes the
+ * nested quantified formulas, and hence their cached results, identical
+ * across calls.
+ */
+struct NestedQeSkolemAttributeId
+{
+};
+using NestedQeSkolemAttribute =
+    expr::Attribute<NestedQeSkolemAttributeId, Node>;
+
+Node NestedQeCache::getKey(Node q)
+{
+  return NodeManager::currentNM()->mkNode(
+      q.getKind(), q[0], Rewriter::rewrite(q[1]));
+}
+
+Node NestedQeCache::find(Node q) const
+{
+  Node key = getKey(q);
+  std::unordered_map<uint64_t, std::vector<std::pair<Node, Node>>>::
+      const_iterator it = d_cache.find(expr::getAlphaHash(key));
+  if (it != d_cache.end())
+  {
+    for (const std::pair<Node, Node>& e : it->second)
+    {
+      if (e.first == key || expr::isAlphaEquivalent(key, e.first))
+      {
+        Trace("cegqi-nested-qe") << "  ...cached result for " << q << " : "
+                                 << e.second << std::endl;
+        return e.second;
+      }
+    }
+  }
+  return Node::null();
+}
+
+void NestedQeCache::add(Node q, Node qqe)
+{
+  Assert(!expr::hasBoundVar(qqe));
+  Node key = getKey(q);
+  d_cache[expr::getAlphaHash(key)].emplace_back(key, qqe);
+}
+
 NestedQe::NestedQe(context::UserContext* u) : d_qnqe(u) {}
 
 bool NestedQe::process(Node q, std::vector<Node>& lems)
@@ -34,7 +83,8 @@ bool NestedQe::process(Node q, std::vector<Node>& lems)
     return (*it).second != q;
   }
   Trace("cegqi-nested-qe") << "Check nested QE on " << q << std::endl;
-  Node qqe = doNestedQe(q, true);
+  Node qqe =
+      doNestedQe(q, true, options::cegqiNestedQeCache() ? &d_cache : nullptr);
   d_qnqe[q] = qqe;
   if (qqe == q)
   {
@@ -67,7 +117,27 @@ bool NestedQe::hasNestedQuantification(Node q)
   return getNestedQuantification(q, nqs);
 }
 
-Node NestedQe::doNestedQe(Node q, bool keepTopLevel)
+Node NestedQe::doNestedQe(Node q, bool keepTopLevel, NestedQeCache* cache)
+{
+  if (keepTopLevel || cache == nullptr)
+  {
+    return doNestedQeInternal(q, keepTopLevel, cache);
+  }
+  Node qqe = cache->find(q);
+  if (qqe.isNull())
+  {
+    qqe = doNestedQeInternal(q, false, cache);
+    if (!expr::hasBoundVar(qqe))
+    {
+      cache->add(q, qqe);
+    }
+  }
+  return qqe;
+}
+
+Node NestedQe::doNestedQeInternal(Node q,
+                                  bool keepTopLevel,
+                                  NestedQeCache* cache)
 {
   NodeManager* nm = NodeManager::currentNM();
   Node qOrig = q;
@@ -95,16 +165,23 @@ Node NestedQe::doNestedQe(Node q, bool keepTopLevel)
   Trace("cegqi-nested-qe-debug")
       << "..." << nqs.size() << " nested quantifiers" << std::endl;
   // otherwise, skolemize the arguments of this and apply
-  std::vector<Node> vars(q[0].begin(), q[0].end());
   Subs sk;
-  sk.add(vars);
+  NestedQeSkolemAttribute nqsa;
+  for (Node v : q[0])
+  {
+    if (!v.hasAttribute(nqsa))
+    {
+      v.setAttribute(nqsa, nm->mkSkolem("sk", v.getType()));
+    }
+    sk.add(v, v.getAttribute(nqsa));
+  }
   // do nested quantifier elimination on each nested quantifier, skolemizing the
   // free variables
   Subs snqe;
   for (const Node& nq : nqs)
   {
     Node nqk = sk.apply(nq);
-    Node nqqe = doNestedQe(nqk);
+    Node nqqe = doNestedQe(nqk, false, cache);
     if (nqqe == nqk)
     {
       // failed
@@ -18,7 +18,9 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__CEQGI__NESTED_QE_H
 #define CVC4__THEORY__QUANTIFIERS__CEQGI__NESTED_QE_H
 
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "context/cdhashmap.h"
 #include "expr/node.h"
@@ -27,6 +29,32 @@ namespace cvc5 {
 namespace theory {
 namespace quantifiers {
 
+/**
+ * A cache of the results of quantifier elimination computed by NestedQe::doQe,
+ * which uses a subsolver without assertions, so that the results only depend
+ * on the quantified formula. Quantified formulas are canonized by rewriting
+ * their body, and
+ * are looked up modulo alpha-equivalence (see expr::isAlphaEquivalent), so
+ * that the results are shared by formulas that differ only in the names or
+ * the order of their variables.
+ *
+ * Only successful results, i.e. quantifier-free formulas, are cached.
+ */
+class NestedQeCache
+{
+ public:
+  /** Get the cached result for q, or null if there is none */
+  Node find(Node q) const;
+  /** Cache that the result of quantifier elimination on q is qqe */
+  void add(Node q, Node qqe);
+
+ private:
+  /** Get the key of q in this cache */
+  static Node getKey(Node q);
+  /** Map from alpha-hashes to the keys and results with that hash */
+  std::unordered_map<uint64_t, std::vector<std::pair<Node, Node>>> d_cache;
+};
+
 class NestedQe
 {
   using NodeNodeMap = context::CDHashMap<Node, Node, NodeHashFunction>;
@@ -63,8 +91,14 @@ class NestedQe
    * q and has no nested quantification. If keepTopLevel is false, then the
    * returned formula is quantifier-free. Otherwise, it is a quantified formula
    * with no nested quantification.
+   *
+   * If cache is not null, the results of quantifier elimination on q (if
+   * keepTopLevel is false) and on its nested quantified formulas are looked
+   * up in and added to cache.
    */
-  static Node doNestedQe(Node q, bool keepTopLevel = false);
+  static Node doNestedQe(Node q,
+                         bool keepTopLevel = false,
+                         NestedQeCache* cache = nullptr);
   /**
    * Run quantifier elimination on quantified formula q, where q has no nested
    * quantification. This method invokes a subsolver for performing quantifier
@@ -73,10 +107,16 @@ class NestedQe
   static Node doQe(Node q);
 
  private:
+  /** The implementation of doNestedQe, without looking up q in cache */
+  static Node doNestedQeInternal(Node q,
+                                 bool keepTopLevel,
+                                 NestedQeCache* cache);
   /**
    * Mapping from quantified formulas q to the result of doNestedQe(q, true).
    */
   NodeNodeMap d_qnqe;
+  /** The cache of the results of quantifier elimination */
+  NestedQeCache d_cache;
 };
 
 }  // namespace quantifiers
@@ -0,0 +1,272 @@
+/*********************                                                        */
+/*! \file code_tree.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of code tree for matching simple triggers
+ **/
+
+#include "theory/quantifiers/ematching/code_tree.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+CodeTree::CodeTree(QuantifiersState& qs, TermRegistry& tr, unsigned numThreads)
+    : d_qstate(qs), d_treg(tr), d_numThreads(numThreads)
+{
+}
+
+CodeTree::~CodeTree() {}
+
+CodeTree::Leaf* CodeTree::addCode(Node op,
+                                  Node eqc,
+                                  bool pol,
+                                  const std::vector<Instruction>& code)
+{
+  std::unique_ptr<Group>& g = d_groups[std::make_tuple(op, eqc, pol)];
+  if (g == nullptr)
+  {
+    g.reset(new Group);
+    g->d_op = op;
+    g->d_eqc = eqc;
+    g->d_pol = pol;
+    g->d_numSlots = 0;
+    g->d_computed = false;
+    g->d_tat = nullptr;
+  }
+  // the matches of the group are recomputed with the new code
+  g->d_computed = false;
+  CodeNode* cn = &g->d_root;
+  for (const Instruction& i : code)
+  {
+    if (i.d_kind == Instruction::BIND)
+    {
+      g->d_numSlots = std::max(g->d_numSlots, i.d_slot + 1);
+    }
+    CodeNode* next = nullptr;
+    for (std::pair<Instruction, std::unique_ptr<CodeNode>>& c : cn->d_children)
+    {
+      if (c.first == i)
+      {
+        next = c.second.get();
+        break;
+      }
+    }
+    if (next == nullptr)
+    {
+      cn->d_children.emplace_back(i, std::unique_ptr<CodeNode>(new CodeNode));
+      next = cn->d_children.back().second.get();
+    }
+    cn = next;
+  }
+  if (cn->d_leaf == nullptr)
+  {
+    cn->d_leaf.reset(new Leaf(g.get()));
+  }
+  return cn->d_leaf.get();
+}
+
+void CodeTree::resetInstantiationRound()
+{
+  for (std::pair<const std::tuple<Node, Node, bool>, std::unique_ptr<Group>>&
+           g : d_groups)
+  {
+    g.second->d_computed = false;
+  }
+}
+
+const std::vector<TNode>& CodeTree::getMatches(Leaf* l)
+{
+  Group& g = *l->d_group;
+  if (!g.d_computed)
+  {
+    if (d_numThreads > 1)
+    {
+      computeAllMatches();
+    }
+    else
+    {
+      computeMatches(g);
+    }
+    Assert(g.d_computed);
+  }
+  return l->d_matches;
+}
+
+void CodeTree::clearMatches(CodeNode& cn)
+{
+  if (cn.d_leaf != nullptr)
+  {
+    cn.d_leaf->d_matches.clear();
+  }
+  for (std::pair<Instruction, std::unique_ptr<CodeNode>>& c : cn.d_children)
+  {
+    clearMatches(*c.second);
+  }
+}
+
+void CodeTree::computeMatches(Group& g)
+{
+  if (prepareMatches(g))
+  {
+    matchPrepared(g);
+  }
+  g.d_computed = true;
+}
+
+void CodeTree::computeAllMatches()
+{
+  std::vector<Group*> groups;
+  for (std::pair<const std::tuple<Node, Node, bool>, std::unique_ptr<Group>>&
+           g : d_groups)
+  {
+    if (!g.second->d_computed)
+    {
+      if (prepareMatches(*g.second))
+      {
+        groups.push_back(g.second.get());
+      }
+      g.second->d_computed = true;
+    }
+  }
+  size_t numThreads = std::min<size_t>(d_numThreads, groups.size());
+  Trace("code-tree") << "Match " << groups.size() << " groups with "
+                     << numThreads << " threads" << std::endl;
+  if (numThreads <= 1)
+  {
+    for (Group* g : groups)
+    {
+      matchPrepared(*g);
+    }
+    return;
+  }
+  // the groups are distributed round-robin, their leaves are disjoint
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < numThreads; t++)
+  {
+    threads.emplace_back([&groups, t, numThreads]() {
+      for (size_t i = t, ngroups = groups.size(); i < ngroups; i += numThreads)
+      {
+        matchPrepared(*groups[i]);
+      }
+    });
+  }
+  for (size_t i = 0, ngroups = groups.size(); i < ngroups; i += numThreads)
+  {
+    matchPrepared(*groups[i]);
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+}
+
+bool CodeTree::prepareMatches(Group& g)
+{
+  Trace("code-tree") << "Compute matches for " << g.d_op << " " << g.d_eqc
+                     << " " << g.d_pol << std::endl;
+  clearMatches(g.d_root);
+  TermDb* tdb = d_treg.getTermDatabase();
+  if (g.d_eqc.isNull())
+  {
+    g.d_tat = tdb->getTermArgTrie(g.d_op);
+  }
+  else if (g.d_pol)
+  {
+    g.d_tat = tdb->getTermArgTrie(g.d_eqc, g.d_op);
+  }
+  else
+  {
+    // iterate over all classes except the one of the equivalence class
+    g.d_tat = tdb->getTermArgTrie(Node::null(), g.d_op);
+    g.d_eqcRep = d_qstate.getRepresentative(g.d_eqc);
+  }
+  if (g.d_tat == nullptr)
+  {
+    return false;
+  }
+  prepareGround(g.d_root);
+  return true;
+}
+
+void CodeTree::prepareGround(CodeNode& cn)
+{
+  for (std::pair<Instruction, std::unique_ptr<CodeNode>>& c : cn.d_children)
+  {
+    if (c.first.d_kind == Instruction::GROUND)
+    {
+      c.second->d_groundRep = d_qstate.getRepresentative(c.first.d_ground);
+    }
+    prepareGround(*c.second);
+  }
+}
+
+void CodeTree::matchPrepared(Group& g)
+{
+  Assert(g.d_tat != nullptr);
+  std::vector<TNode> slots(g.d_numSlots);
+  if (g.d_eqc.isNull() || g.d_pol)
+  {
+    match(g.d_root, g.d_tat, slots);
+    return;
+  }
+  for (std::pair<const TNode, TNodeTrie>& t : g.d_tat->d_data)
+  {
+    if (t.first != g.d_eqcRep)
+    {
+      match(g.d_root, &t.second, slots);
+    }
+  }
+}
+
+void CodeTree::match(CodeNode& cn, TNodeTrie* tat, std::vector<TNode>& slots)
+{
+  if (cn.d_leaf != nullptr)
+  {
+    Assert(!tat->d_data.empty());
+    cn.d_leaf->d_matches.push_back(tat->getData());
+  }
+  for (std::pair<Instruction, std::unique_ptr<CodeNode>>& c : cn.d_children)
+  {
+    const Instruction& i = c.first;
+    if (i.d_kind == Instruction::BIND)
+    {
+      // the arguments are representatives, the instructions below it share
+      // this scan of the term index
+      for (std::pair<const TNode, TNodeTrie>& tt : tat->d_data)
+      {
+        slots[i.d_slot] = tt.first;
+        match(*c.second, &tt.second, slots);
+      }
+      continue;
+    }
+    // only TNodes are used, which does not touch reference counts
+    TNode r = i.d_kind == Instruction::GROUND ? TNode(c.second->d_groundRep)
+                                              : slots[i.d_slot];
+    std::map<TNode, TNodeTrie>::iterator it = tat->d_data.find(r);
+    if (it != tat->d_data.end())
+    {
+      match(*c.second, &it->second, slots);
+    }
+  }
+}
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,201 @@
+/*********************                                                        */
+/*! \file code_tree.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief code tree for matching simple triggers
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__CODE_TREE_H
+#define CVC4__THEORY__QUANTIFIERS__CODE_TREE_H
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_trie.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+class TermRegistry;
+
+namespace inst {
+
+/** CodeTree class
+ *
+ * This class shares the work of matching the simple single triggers of all
+ * quantified formulas (see InstMatchGeneratorSimple).
+ *
+ * A simple trigger f( t1, ..., tn ) is compiled to a sequence of n
+ * instructions, one for each argument ti, which is either:
+ * - BIND s, if ti is a variable not seen before in the trigger, which is
+ *   matched with any term and stored in slot s,
+ * - CHECK s, if ti is the variable of slot s, which is matched with the term
+ *   stored in slot s,
+ * - GROUND ti, which is matched with the representative of ti.
+ * The slots are numbered by first occurrence in the trigger, so that the
+ * triggers f( x, a ) of a quantified formula and f( y, a ) of another one
+ * have the same code, BIND 0 GROUND a.
+ *
+ * The code of the triggers with the same operator, and the same equivalence
+ * class and polarity if any, are stored in a trie, whose leaves are the
+ * triggers with the same code. Matching traverses the term index of the
+ * operator in TermDb and the trie together, so that the triggers with a
+ * common prefix of instructions share the traversal of the term index for
+ * this prefix. The terms matched by each leaf are computed for all its
+ * triggers at once, on the first request in each instantiation round.
+ *
+ * If the code tree uses more than one thread, the first request in an
+ * instantiation round computes the matches of all groups at once. The term
+ * indices and the representatives of the ground terms are computed first,
+ * sequentially. The groups are then matched in parallel, which only
+ * traverses the term indices through TNodes and does not create nodes or
+ * touch reference counts. The instantiations are sent sequentially by the
+ * generators (see InstMatchGeneratorCodeTree), which is where they are
+ * filtered for duplicates and turned into lemmas.
+ */
+class CodeTree
+{
+ public:
+  CodeTree(QuantifiersState& qs, TermRegistry& tr, unsigned numThreads = 1);
+  ~CodeTree();
+
+  /** An instruction for matching an argument of a trigger */
+  struct Instruction
+  {
+    enum Kind
+    {
+      BIND,
+      CHECK,
+      GROUND
+    };
+    Kind d_kind;
+    /** The slot, for BIND and CHECK */
+    size_t d_slot;
+    /** The ground term, for GROUND */
+    Node d_ground;
+    bool operator==(const Instruction& i) const
+    {
+      return d_kind == i.d_kind && d_slot == i.d_slot && d_ground == i.d_ground;
+    }
+  };
+  class Leaf;
+  /**
+   * Add the code of a trigger of operator op, which only matches terms that
+   * are not entailed to be disequal to eqc if pol is true, or equal to eqc if
+   * pol is false, when eqc is non-null. Returns the leaf of the code.
+   */
+  Leaf* addCode(Node op,
+                Node eqc,
+                bool pol,
+                const std::vector<Instruction>& code);
+  /** Invalidate the matches computed in the previous instantiation round */
+  void resetInstantiationRound();
+  /**
+   * Get the ground terms matched by the code of leaf l in the current
+   * instantiation round.
+   */
+  const std::vector<TNode>& getMatches(Leaf* l);
+
+ private:
+  /** A node of the trie of the code */
+  struct CodeNode
+  {
+    /** The children, by instruction */
+    std::vector<std::pair<Instruction, std::unique_ptr<CodeNode>>> d_children;
+    /** The leaf, if this is the end of the code of a trigger */
+    std::unique_ptr<Leaf> d_leaf;
+    /**
+     * The representative of the ground term of the instruction of this node,
+     * if it is a GROUND instruction, for the current round.
+     */
+    Node d_groundRep;
+  };
+  /** The triggers of an operator, equivalence class and polarity */
+  struct Group
+  {
+    Node d_op;
+    Node d_eqc;
+    bool d_pol;
+    /** The number of slots used by the code */
+    size_t d_numSlots;
+    /** The root of the trie of the code */
+    CodeNode d_root;
+    /** Whether the matches are computed for the current round */
+    bool d_computed;
+    /** The term index to match, for the current round */
+    TNodeTrie* d_tat;
+    /**
+     * The representative of d_eqc if d_pol is false, whose class is not
+     * matched, for the current round.
+     */
+    Node d_eqcRep;
+  };
+  /** Compute the matches of the leaves of group g */
+  void computeMatches(Group& g);
+  /** Compute the matches of the leaves of all groups, in parallel */
+  void computeAllMatches();
+  /**
+   * Prepare the matching of group g, which computes its term index and the
+   * representatives of its ground terms. Returns false if g has no matches.
+   */
+  bool prepareMatches(Group& g);
+  /** Prepare the GROUND instructions below cn, see prepareMatches */
+  void prepareGround(CodeNode& cn);
+  /**
+   * Match the prepared group g. This only reads the term indices through
+   * TNodes, and can be called for distinct groups in parallel.
+   */
+  static void matchPrepared(Group& g);
+  /** Clear the matches of the leaves below cn */
+  static void clearMatches(CodeNode& cn);
+  /**
+   * Match the code below cn with the terms below tat in the term index,
+   * where slots are the terms matched by the slots.
+   */
+  static void match(CodeNode& cn, TNodeTrie* tat, std::vector<TNode>& slots);
+
+  /** Reference to the quantifiers state */
+  QuantifiersState& d_qstate;
+  /** Reference to the term registry */
+  TermRegistry& d_treg;
+  /** The number of threads used for matching */
+  unsigned d_numThreads;
+  /** The groups, by operator, equivalence class and polarity */
+  std::map<std::tuple<Node, Node, bool>, std::unique_ptr<Group>> d_groups;
+};
+
+/** A leaf of the code tree, for the triggers with the same code */
+class CodeTree::Leaf
+{
+  friend class CodeTree;
+
+ public:
+  Leaf(CodeTree::Group* g) : d_group(g) {}
+
+ private:
+  /** The group of the code */
+  CodeTree::Group* d_group;
+  /** The ground terms matched in the current round */
+  std::vector<TNode> d_matches;
+};
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
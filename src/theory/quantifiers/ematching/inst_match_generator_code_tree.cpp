@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file inst_match_generator_code_tree.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of code tree inst match generator class
+ **/
+
+#include "theory/quantifiers/ematching/inst_match_generator_code_tree.h"
+
+#include "options/quantifiers_options.h"
+#include "theory/quantifiers/ematching/trigger_term_info.h"
+#include "theory/quantifiers/inst_match.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
+#include "theory/quantifiers/term_util.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+InstMatchGeneratorCodeTree::InstMatchGeneratorCodeTree(Trigger* tparent,
+                                                       Node q,
+                                                       Node pat,
+                                                       CodeTree* ct)
+    : IMGenerator(tparent), d_match_pattern(pat), d_ct(ct), d_leaf(nullptr)
+{
+  bool pol = true;
+  if (d_match_pattern.getKind() == NOT)
+  {
+    d_match_pattern = d_match_pattern[0];
+    pol = false;
+  }
+  Node eqc;
+  if (d_match_pattern.getKind() == EQUAL)
+  {
+    eqc = d_match_pattern[1];
+    d_match_pattern = d_match_pattern[0];
+    Assert(!TermUtil::hasInstConstAttr(eqc));
+  }
+  Assert(TriggerTermInfo::isSimpleTrigger(d_match_pattern));
+  // compile the arguments, the variables of other quantified formulas are
+  // treated as ground terms, as in InstMatchGeneratorSimple
+  std::vector<CodeTree::Instruction> code;
+  std::map<int, size_t> slots;
+  for (size_t i = 0, nchild = d_match_pattern.getNumChildren(); i < nchild; i++)
+  {
+    Node pc = d_match_pattern[i];
+    CodeTree::Instruction ins{CodeTree::Instruction::GROUND, 0, pc};
+    if (pc.getKind() == INST_CONSTANT
+        && (!options::cegqi() || TermUtil::getInstConstAttr(pc) == q))
+    {
+      int v = pc.getAttribute(InstVarNumAttribute());
+      d_var_num[i] = v;
+      std::map<int, size_t>::iterator it = slots.find(v);
+      if (it == slots.end())
+      {
+        ins = CodeTree::Instruction{CodeTree::Instruction::BIND, slots.size()};
+        slots[v] = ins.d_slot;
+      }
+      else
+      {
+        ins = CodeTree::Instruction{CodeTree::Instruction::CHECK, it->second};
+      }
+    }
+    code.push_back(ins);
+  }
+  TermDb* tdb = d_treg.getTermDatabase();
+  d_op = tdb->getMatchOperator(d_match_pattern);
+  d_leaf = d_ct->addCode(d_op, eqc, pol, code);
+}
+
+void InstMatchGeneratorCodeTree::resetInstantiationRound()
+{
+  d_ct->resetInstantiationRound();
+}
+
+uint64_t InstMatchGeneratorCodeTree::addInstantiations(Node q)
+{
+  uint64_t addedLemmas = 0;
+  if (d_qstate.isInConflict())
+  {
+    return addedLemmas;
+  }
+  const std::vector<TNode>& matches = d_ct->getMatches(d_leaf);
+  Debug("simple-trigger-debug")
+      << "Adding instantiations for " << matches.size() << " matches of "
+      << d_match_pattern << std::endl;
+  for (TNode t : matches)
+  {
+    InstMatch m(q);
+    for (const std::pair<const size_t, int>& v : d_var_num)
+    {
+      Assert(v.first < t.getNumChildren());
+      m.setValue(v.second, t[v.first]);
+    }
+    if (sendInstantiation(m, InferenceId::QUANTIFIERS_INST_E_MATCHING_SIMPLE))
+    {
+      addedLemmas++;
+      Debug("simple-trigger") << "-> Produced instantiation " << m << std::endl;
+    }
+    if (d_qstate.isInConflict())
+    {
+      break;
+    }
+  }
+  return addedLemmas;
+}
+
+int InstMatchGeneratorCodeTree::getActiveScore()
+{
+  TermDb* tdb = d_treg.getTermDatabase();
+  return static_cast<int>(tdb->getNumGroundTerms(d_op));
+}
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
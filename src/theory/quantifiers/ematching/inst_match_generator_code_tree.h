@@ -0,0 +1,70 @@
+/*********************                                                        */
+/*! \file inst_match_generator_code_tree.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief code tree inst match generator class
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__INST_MATCH_GENERATOR_CODE_TREE_H
+#define CVC4__THEORY__QUANTIFIERS__INST_MATCH_GENERATOR_CODE_TREE_H
+
+#include <map>
+
+#include "theory/quantifiers/ematching/code_tree.h"
+#include "theory/quantifiers/ematching/im_generator.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+/** InstMatchGeneratorCodeTree class
+ *
+ * This is the generator class for simple single triggers when the option
+ * --e-matching-code-tree is enabled. It produces the same instantiations as
+ * InstMatchGeneratorSimple, from the terms matched by its code in a code
+ * tree shared by the simple triggers of all quantified formulas.
+ */
+class InstMatchGeneratorCodeTree : public IMGenerator
+{
+ public:
+  InstMatchGeneratorCodeTree(Trigger* tparent, Node q, Node pat, CodeTree* ct);
+
+  /** Reset instantiation round. */
+  void resetInstantiationRound() override;
+  /** Add instantiations. */
+  uint64_t addInstantiations(Node q) override;
+  /** Get active score. */
+  int getActiveScore() override;
+
+ private:
+  /** the trigger term */
+  Node d_match_pattern;
+  /** The match operator d_match_pattern (see TermDb::getMatchOperator). */
+  Node d_op;
+  /**
+   * Map from child number of d_match_pattern to variable index, for the
+   * children that are variables of the quantified formula.
+   */
+  std::map<size_t, int> d_var_num;
+  /** The code tree */
+  CodeTree* d_ct;
+  /** The leaf of the code of the trigger in the code tree */
+  CodeTree::Leaf* d_leaf;
+};
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
@@ -13,7 +13,10 @@
  **/
 #include "theory/quantifiers/ematching/inst_match_generator_simple.h"
 
+#include <unordered_set>
+
 #include "options/quantifiers_options.h"
+#include "options/uf_options.h"
 #include "theory/quantifiers/ematching/trigger_term_info.h"
 #include "theory/quantifiers/instantiate.h"
 #include "theory/quantifiers/quantifiers_state.h"
@@ -31,7 +34,13 @@ namespace inst {
 InstMatchGeneratorSimple::InstMatchGeneratorSimple(Trigger* tparent,
                                                    Node q,
                                                    Node pat)
-    : IMGenerator(tparent), d_quant(q), d_match_pattern(pat)
+    : IMGenerator(tparent),
+      d_quant(q),
+      d_match_pattern(pat),
+      d_incremental(false),
+      d_mergeIndependent(false),
+      d_numMatchedTerms(d_qstate.getSatContext(), 0),
+      d_lastNumMerges(0)
 {
   if (d_match_pattern.getKind() == NOT)
   {
@@ -67,6 +76,22 @@ InstMatchGeneratorSimple::InstMatchGeneratorSimple(Trigger* tparent,
   }
   TermDb* tdb = d_treg.getTermDatabase();
   d_op = tdb->getMatchOperator(d_match_pattern);
+  // the triggers with a negative polarity are not matched incrementally, since
+  // their matches are not monotonic with respect to the equalities
+  d_incremental = options::eMatchingIncremental() && options::termDbCd()
+                  && !options::ufHo() && (d_eqc.isNull() || d_pol);
+  d_mergeIndependent = d_eqc.isNull();
+  std::unordered_set<int> vars;
+  for (size_t i = 0, nchild = d_match_pattern.getNumChildren(); i < nchild; i++)
+  {
+    std::map<size_t, int>::iterator it = d_var_num.find(i);
+    if (it == d_var_num.end() || it->second == -1
+        || !vars.insert(it->second).second)
+    {
+      d_mergeIndependent = false;
+      break;
+    }
+  }
 }
 
 void InstMatchGeneratorSimple::resetInstantiationRound() {}
@@ -75,6 +100,12 @@ uint64_t InstMatchGeneratorSimple::addInstantiations(Node q)
   uint64_t addedLemmas = 0;
   TNodeTrie* tat;
   TermDb* tdb = d_treg.getTermDatabase();
+  if (d_incremental
+      && (d_mergeIndependent || tdb->getNumMerges() == d_lastNumMerges))
+  {
+    addInstantiationsIncremental(q, addedLemmas);
+    return addedLemmas;
+  }
   if (d_eqc.isNull())
   {
     tat = tdb->getTermArgTrie(d_op);
@@ -116,9 +147,79 @@ uint64_t InstMatchGeneratorSimple::addInstantiations(Node q)
     InstMatch m(q);
     addInstantiations(m, addedLemmas, 0, tat);
   }
+  if (d_incremental && !d_qstate.isInConflict())
+  {
+    // all current terms are matched
+    d_numMatchedTerms = tdb->getNumGroundTerms(d_op);
+    d_lastNumMerges = tdb->getNumMerges();
+  }
   return addedLemmas;
 }
 
+void InstMatchGeneratorSimple::addInstantiationsIncremental(
+    Node q, uint64_t& addedLemmas)
+{
+  TermDb* tdb = d_treg.getTermDatabase();
+  size_t nterms = tdb->getNumGroundTerms(d_op);
+  Debug("simple-trigger-debug")
+      << "Adding instantiations incrementally for terms " << d_numMatchedTerms
+      << "..." << nterms << " of " << d_op << std::endl;
+  for (size_t i = d_numMatchedTerms; i < nterms; i++)
+  {
+    if (d_qstate.isInConflict())
+    {
+      // the remaining terms are matched in the next round
+      d_numMatchedTerms = i;
+      return;
+    }
+    // the term of the term index that is congruent to the new term, if any
+    Node n = tdb->getGroundTerm(d_op, i);
+    TNode t = tdb->getCongruentTerm(d_op, n);
+    if (t.isNull() || (!d_eqc.isNull() && !d_qstate.areEqual(t, d_eqc)))
+    {
+      continue;
+    }
+    InstMatch m(q);
+    if (matchTerm(m, t)
+        && sendInstantiation(m,
+                             InferenceId::QUANTIFIERS_INST_E_MATCHING_SIMPLE))
+    {
+      addedLemmas++;
+      Debug("simple-trigger") << "-> Produced instantiation " << m << std::endl;
+    }
+  }
+  d_numMatchedTerms = nterms;
+}
+
+bool InstMatchGeneratorSimple::matchTerm(InstMatch& m, TNode t)
+{
+  Debug("simple-trigger") << "Match term " << t << std::endl;
+  Assert(t.getNumChildren() == d_match_pattern.getNumChildren());
+  std::map<int, Node> reps;
+  for (size_t i = 0, nchild = d_match_pattern.getNumChildren(); i < nchild; i++)
+  {
+    Node r = d_qstate.getRepresentative(t[i]);
+    std::map<size_t, int>::iterator it = d_var_num.find(i);
+    if (it == d_var_num.end() || it->second == -1)
+    {
+      // ground argument
+      if (r != d_qstate.getRepresentative(d_match_pattern[i]))
+      {
+        return false;
+      }
+      continue;
+    }
+    std::map<int, Node>::iterator itr = reps.find(it->second);
+    if (itr != reps.end() && itr->second != r)
+    {
+      return false;
+    }
+    reps[it->second] = r;
+    m.setValue(it->second, t[i]);
+  }
+  return true;
+}
+
 void InstMatchGeneratorSimple::addInstantiations(InstMatch& m,
                                                  uint64_t& addedLemmas,
                                                  size_t argIndex,
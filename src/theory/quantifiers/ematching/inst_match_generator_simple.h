@@ -20,6 +20,7 @@
 #include <map>
 #include <vector>
 
+#include "context/cdo.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/ematching/inst_match_generator.h"
 
@@ -41,6 +42,16 @@ namespace inst {
  * The implementation traverses the term indices in TermDatabase for adding
  * instantiations, which is more efficient than the techniques required for
  * handling non-simple single triggers.
+ *
+ * If the option --e-matching-incremental is enabled, the generator only
+ * matches the terms that were added to the term database since its last
+ * complete round, provided that none of its previous matches may be
+ * different. This is the case if no merge happened since then, or if the
+ * trigger has distinct variables as arguments and no equivalence class
+ * information, as the matches of f( x, y ) for a term do not depend on the
+ * equalities. Terms that are removed from the database on backtracking are
+ * matched again when they are re-added, since the number of matched terms is
+ * context dependent.
  */
 class InstMatchGeneratorSimple : public IMGenerator
 {
@@ -82,6 +93,20 @@ class InstMatchGeneratorSimple : public IMGenerator
    * child is not a variable.
    */
   std::map<size_t, int> d_var_num;
+  /** Whether we match incrementally, see --e-matching-incremental */
+  bool d_incremental;
+  /**
+   * Whether the matches of a term do not depend on the equalities, that is,
+   * the arguments of d_match_pattern are distinct variables and d_eqc is null.
+   */
+  bool d_mergeIndependent;
+  /**
+   * The number of ground terms for d_op in the term database that have been
+   * matched by this generator.
+   */
+  context::CDO<size_t> d_numMatchedTerms;
+  /** The number of merges of the term database at the last complete round */
+  uint64_t d_lastNumMerges;
   /** add instantiations, helper function.
    *
    * @param m the current match we are building,
@@ -95,6 +120,16 @@ class InstMatchGeneratorSimple : public IMGenerator
                          uint64_t& addedLemmas,
                          size_t argIndex,
                          TNodeTrie* tat);
+  /**
+   * Add the instantiations for the ground terms for d_op that have not been
+   * matched yet, used in incremental mode.
+   */
+  void addInstantiationsIncremental(Node q, uint64_t& addedLemmas);
+  /**
+   * Match the ground term t with d_match_pattern, which stores the match in m.
+   * Returns false if t does not match.
+   */
+  bool matchTerm(InstMatch& m, TNode t);
 };
 
 }  // namespace inst
@@ -18,6 +18,7 @@
 #include "options/quantifiers_options.h"
 #include "theory/quantifiers/ematching/candidate_generator.h"
 #include "theory/quantifiers/ematching/inst_match_generator.h"
+#include "theory/quantifiers/ematching/inst_match_generator_code_tree.h"
 #include "theory/quantifiers/ematching/inst_match_generator_multi.h"
 #include "theory/quantifiers/ematching/inst_match_generator_multi_linear.h"
 #include "theory/quantifiers/ematching/inst_match_generator_simple.h"
@@ -45,7 +46,8 @@ Trigger::Trigger(QuantifiersState& qs,
                  QuantifiersRegistry& qr,
                  TermRegistry& tr,
                  Node q,
-                 std::vector<Node>& nodes)
+                 std::vector<Node>& nodes,
+                 CodeTree* ct)
     : d_qstate(qs), d_qim(qim), d_qreg(qr), d_treg(tr), d_quant(q)
 {
   // We must ensure that the ground subterms of the trigger have been
@@ -70,7 +72,14 @@ Trigger::Trigger(QuantifiersState& qs,
   if( d_nodes.size()==1 ){
     if (TriggerTermInfo::isSimpleTrigger(d_nodes[0]))
     {
-      d_mg = new InstMatchGeneratorSimple(this, q, d_nodes[0]);
+      if (ct != nullptr)
+      {
+        d_mg = new InstMatchGeneratorCodeTree(this, q, d_nodes[0], ct);
+      }
+      else
+      {
+        d_mg = new InstMatchGeneratorSimple(this, q, d_nodes[0]);
+      }
       ++(stats.d_triggers);
     }else{
       d_mg = InstMatchGenerator::mkInstMatchGenerator(this, q, d_nodes[0]);
@@ -35,6 +35,7 @@ class InstMatch;
 
 namespace inst {
 
+class CodeTree;
 class IMGenerator;
 class InstMatchGenerator;
 /** A collection of nodes representing a trigger.
@@ -102,13 +103,18 @@ class Trigger {
   friend class IMGenerator;
 
  public:
-  /** trigger constructor */
+  /** trigger constructor
+   *
+   * If ct is non-null, a simple single trigger is matched by its code in the
+   * code tree ct (see InstMatchGeneratorCodeTree).
+   */
   Trigger(QuantifiersState& qs,
           QuantifiersInferenceManager& qim,
           QuantifiersRegistry& qr,
           TermRegistry& tr,
           Node q,
-          std::vector<Node>& nodes);
+          std::vector<Node>& nodes,
+          CodeTree* ct = nullptr);
   virtual ~Trigger();
   /** get the generator associated with this trigger */
   IMGenerator* getGenerator() { return d_mg; }
@@ -14,6 +14,7 @@
 
 #include "theory/quantifiers/ematching/trigger_database.h"
 
+#include "options/quantifiers_options.h"
 #include "theory/quantifiers/ematching/ho_trigger.h"
 #include "theory/quantifiers/ematching/trigger.h"
 #include "theory/quantifiers/term_util.h"
@@ -29,6 +30,10 @@ TriggerDatabase::TriggerDatabase(QuantifiersState& qs,
                                  TermRegistry& tr)
     : d_qs(qs), d_qim(qim), d_qreg(qr), d_treg(tr)
 {
+  if (options::eMatchingCodeTree())
+  {
+    d_codeTree.reset(new CodeTree(qs, tr, options::eMatchingThreads()));
+  }
 }
 TriggerDatabase::~TriggerDatabase() {}
 
@@ -81,7 +86,8 @@ Trigger* TriggerDatabase::mkTrigger(Node q,
   }
   else
   {
-    t = new Trigger(d_qs, d_qim, d_qreg, d_treg, q, trNodes);
+    t = new Trigger(
+        d_qs, d_qim, d_qreg, d_treg, q, trNodes, d_codeTree.get());
   }
   d_trie.addTrigger(trNodes, t);
   return t;
@@ -17,9 +17,11 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__TRIGGER_DATABASE_H
 #define CVC4__THEORY__QUANTIFIERS__TRIGGER_DATABASE_H
 
+#include <memory>
 #include <vector>
 
 #include "expr/node.h"
+#include "theory/quantifiers/ematching/code_tree.h"
 #include "theory/quantifiers/ematching/trigger_trie.h"
 
 namespace cvc5 {
@@ -92,6 +94,11 @@ class TriggerDatabase
  private:
   /** The trigger trie, containing the triggers */
   TriggerTrie d_trie;
+  /**
+   * The code tree of the simple single triggers, if option
+   * --e-matching-code-tree is enabled
+   */
+  std::unique_ptr<CodeTree> d_codeTree;
   /** Reference to the quantifiers state */
   QuantifiersState& d_qs;
   /** Reference to the quantifiers inference manager */
@@ -19,6 +19,7 @@
 #include "theory/arith/arith_msum.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/datatypes/datatypes_rewriter.h"
+#include "theory/quantifiers/extended_rewrite_cache.h"
 #include "theory/quantifiers/term_util.h"
 #include "theory/rewriter.h"
 #include "theory/strings/sequences_rewriter.h"
@@ -31,16 +32,6 @@ namespace cvc5 {
 namespace theory {
 namespace quantifiers {
 
-struct ExtRewriteAttributeId
-{
-};
-typedef expr::Attribute<ExtRewriteAttributeId, Node> ExtRewriteAttribute;
-
-struct ExtRewriteAggAttributeId
-{
-};
-typedef expr::Attribute<ExtRewriteAggAttributeId, Node> ExtRewriteAggAttribute;
-
 ExtendedRewriter::ExtendedRewriter(bool aggr) : d_aggr(aggr)
 {
   d_true = NodeManager::currentNM()->mkConst(true);
@@ -49,35 +40,12 @@ ExtendedRewriter::ExtendedRewriter(bool aggr) : d_aggr(aggr)
 
 void ExtendedRewriter::setCache(Node n, Node ret)
 {
-  if (d_aggr)
-  {
-    ExtRewriteAggAttribute erga;
-    n.setAttribute(erga, ret);
-  }
-  else
-  {
-    ExtRewriteAttribute era;
-    n.setAttribute(era, ret);
-  }
+  Rewriter::getExtRewriteCache()->set(d_aggr, n, ret);
 }
 
 Node ExtendedRewriter::getCache(Node n)
 {
-  if (d_aggr)
-  {
-    if (n.hasAttribute(ExtRewriteAggAttribute()))
-    {
-      return n.getAttribute(ExtRewriteAggAttribute());
-    }
-  }
-  else
-  {
-    if (n.hasAttribute(ExtRewriteAttribute()))
-    {
-      return n.getAttribute(ExtRewriteAttribute());
-    }
-  }
-  return Node::null();
+  return Rewriter::getExtRewriteCache()->get(d_aggr, n);
 }
 
 bool ExtendedRewriter::addToChildren(Node nc,
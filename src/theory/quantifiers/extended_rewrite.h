@@ -67,7 +67,10 @@ class ExtendedRewriter
   /** true/false nodes */
   Node d_true;
   Node d_false;
-  /** cache that the extended rewritten form of n is ret */
+  /**
+   * Cache that the extended rewritten form of n is ret, in the cache shared
+   * by all extended rewriters (see ExtRewriteCache).
+   */
   void setCache(Node n, Node ret);
   /** get the cache for n */
   Node getCache(Node n);
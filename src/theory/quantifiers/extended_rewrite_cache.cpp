@@ -0,0 +1,84 @@
+/*********************                                                        */
+/*! \file extended_rewrite_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the cache of extended rewriting
+ **/
+
+#include "theory/quantifiers/extended_rewrite_cache.h"
+
+#include "base/output.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+ExtRewriteCache::ExtRewriteCache(size_t capacity, StatisticsRegistry& stats)
+    : d_capacity(capacity),
+      d_registry(stats),
+      d_hits("theory::quantifiers::ExtRewriteCache::hits", 0),
+      d_misses("theory::quantifiers::ExtRewriteCache::misses", 0),
+      d_clears("theory::quantifiers::ExtRewriteCache::clears", 0)
+{
+  d_registry.registerStat(&d_hits);
+  d_registry.registerStat(&d_misses);
+  d_registry.registerStat(&d_clears);
+}
+
+ExtRewriteCache::~ExtRewriteCache()
+{
+  d_registry.unregisterStat(&d_hits);
+  d_registry.unregisterStat(&d_misses);
+  d_registry.unregisterStat(&d_clears);
+}
+
+Node ExtRewriteCache::get(bool aggr, TNode n)
+{
+  const std::unordered_map<Node, Node, NodeHashFunction>& cache =
+      d_cache[aggr ? 1 : 0];
+  std::unordered_map<Node, Node, NodeHashFunction>::const_iterator it =
+      cache.find(n);
+  if (it == cache.end())
+  {
+    ++d_misses;
+    return Node::null();
+  }
+  ++d_hits;
+  return it->second;
+}
+
+void ExtRewriteCache::set(bool aggr, TNode n, TNode ret)
+{
+  std::unordered_map<Node, Node, NodeHashFunction>& cache =
+      d_cache[aggr ? 1 : 0];
+  if (d_capacity > 0 && size() >= d_capacity && cache.find(n) == cache.end())
+  {
+    Trace("ext-rew-cache") << "ExtRewriteCache: clear after " << size()
+                           << " entries" << std::endl;
+    clear();
+    ++d_clears;
+  }
+  cache[n] = ret;
+}
+
+void ExtRewriteCache::clear()
+{
+  d_cache[0].clear();
+  d_cache[1].clear();
+}
+
+size_t ExtRewriteCache::size() const
+{
+  return d_cache[0].size() + d_cache[1].size();
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
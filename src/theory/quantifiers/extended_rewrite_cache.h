@@ -0,0 +1,86 @@
+/*********************                                                        */
+/*! \file extended_rewrite_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The cache of extended rewriting shared by all extended rewriters
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__EXTENDED_REWRITE_CACHE_H
+#define CVC4__THEORY__QUANTIFIERS__EXTENDED_REWRITE_CACHE_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include "expr/node.h"
+#include "util/statistics_registry.h"
+#include "util/stats_base.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/**
+ * The cache of the results of extended rewriting, which is owned by the
+ * Rewriter and shared by all instances of ExtendedRewriter, e.g. those of
+ * sygus, of the extended rewriter preprocessing pass, of strings and of
+ * the builtin proof checker. There is a separate cache for aggressive and
+ * non-aggressive extended rewriting.
+ *
+ * The total number of entries is bounded by --ext-rewrite-cache-limit. When
+ * an entry is inserted in a full cache, the cache is cleared first, which is
+ * sound since the cached results can be recomputed. Unless
+ * --ext-rewrite-cache-persist is set, the cache is also cleared at the start
+ * of each round of the quantifiers engine.
+ */
+class ExtRewriteCache
+{
+ public:
+  /**
+   * @param capacity The maximal number of entries, 0 for no bound
+   * @param stats The registry for the statistics of this class
+   */
+  ExtRewriteCache(size_t capacity, StatisticsRegistry& stats);
+  ~ExtRewriteCache();
+
+  /**
+   * Get the cached result of the (aggressive if aggr is true) extended
+   * rewriting of n, or null if there is none.
+   */
+  Node get(bool aggr, TNode n);
+  /** Cache ret as the result of the extended rewriting of n */
+  void set(bool aggr, TNode n, TNode ret);
+  /** Clear all entries */
+  void clear();
+  /** Return the number of entries */
+  size_t size() const;
+
+ private:
+  /** The maximal number of entries, 0 for no bound */
+  size_t d_capacity;
+  /** The entries of non-aggressive (0) and aggressive (1) rewriting */
+  std::unordered_map<Node, Node, NodeHashFunction> d_cache[2];
+
+  /** The registry of the statistics */
+  StatisticsRegistry& d_registry;
+  /** The number of lookups that found an entry */
+  IntStat d_hits;
+  /** The number of lookups that did not find an entry */
+  IntStat d_misses;
+  /** The number of times the cache was cleared because it was full */
+  IntStat d_clears;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__EXTENDED_REWRITE_CACHE_H */
@@ -200,6 +200,94 @@ int Def::getGeneralizationIndex( FirstOrderModelFmc * m, std::vector<Node>& inst
   return d_et.getGeneralizationIndex(m, inst);
 }
 
+DefIndex::DefIndex(FirstOrderModelFmc* m, Def& d)
+{
+  size_t nentries = d.d_cond.size();
+  size_t nargs = nentries == 0 ? 0 : d.d_cond[0].getNumChildren();
+  d_numWords = (nentries + 63) / 64;
+  d_valueRow.resize(nargs);
+  d_conj.resize(d_numWords);
+  for (size_t i = 0; i < nargs; i++)
+  {
+    // the row of the values that do not occur at position i
+    size_t star = d_rows.size();
+    d_starRow.push_back(star);
+    d_rows.resize(star + d_numWords, 0);
+    for (size_t j = 0; j < nentries; j++)
+    {
+      if (m->isStar(d.d_cond[j][i]))
+      {
+        d_rows[star + j / 64] |= uint64_t(1) << (j % 64);
+      }
+    }
+    for (size_t j = 0; j < nentries; j++)
+    {
+      Node v = d.d_cond[j][i];
+      if (m->isStar(v))
+      {
+        continue;
+      }
+      std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+          d_valueRow[i].find(v);
+      size_t row;
+      if (it == d_valueRow[i].end())
+      {
+        row = d_rows.size();
+        d_valueRow[i][v] = row;
+        d_rows.resize(row + d_numWords);
+        std::copy(d_rows.begin() + star,
+                  d_rows.begin() + star + d_numWords,
+                  d_rows.begin() + row);
+      }
+      else
+      {
+        row = it->second;
+      }
+      d_rows[row + j / 64] |= uint64_t(1) << (j % 64);
+    }
+  }
+}
+
+int DefIndex::getGeneralizationIndex(const std::vector<Node>& inst)
+{
+  Assert(inst.size() == d_starRow.size());
+  if (inst.empty())
+  {
+    return d_numWords == 0 ? -1 : 0;
+  }
+  for (size_t i = 0, nargs = inst.size(); i < nargs; i++)
+  {
+    std::unordered_map<Node, size_t, NodeHashFunction>::const_iterator it =
+        d_valueRow[i].find(inst[i]);
+    size_t row = it == d_valueRow[i].end() ? d_starRow[i] : it->second;
+    const uint64_t* r = &d_rows[row];
+    if (i == 0)
+    {
+      std::copy(r, r + d_numWords, d_conj.begin());
+      continue;
+    }
+    for (size_t w = 0; w < d_numWords; w++)
+    {
+      d_conj[w] &= r[w];
+    }
+  }
+  for (size_t w = 0; w < d_numWords; w++)
+  {
+    uint64_t word = d_conj[w];
+    if (word != 0)
+    {
+      int index = static_cast<int>(w * 64);
+      while ((word & 1) == 0)
+      {
+        word >>= 1;
+        index++;
+      }
+      return index;
+    }
+  }
+  return -1;
+}
+
 void Def::basic_simplify( FirstOrderModelFmc * m ) {
   d_has_simplified = true;
   std::vector< Node > cond;
@@ -833,6 +921,11 @@ bool FullModelChecker::exhaustiveInstantiate(FirstOrderModelFmc* fm,
   {
     Trace("fmc-exh-debug") << "Set element domains..." << std::endl;
     int addedLemmas = 0;
+    std::unique_ptr<DefIndex> dindex;
+    if (options::fmfFmcIndex())
+    {
+      dindex.reset(new DefIndex(fm, d_quant_models[f]));
+    }
     //now do full iteration
     Instantiate* ie = d_qim.getInstantiate();
     while( !riter.isFinished() ){
@@ -854,7 +947,10 @@ bool FullModelChecker::exhaustiveInstantiate(FirstOrderModelFmc* fm,
         ev_inst.push_back( r );
         inst.push_back( rr );
       }
-      int ev_index = d_quant_models[f].getGeneralizationIndex(fm, ev_inst);
+      int ev_index =
+          dindex != nullptr
+              ? dindex->getGeneralizationIndex(ev_inst)
+              : d_quant_models[f].getGeneralizationIndex(fm, ev_inst);
       Trace("fmc-exh-debug") << ", index = " << ev_index << " / " << d_quant_models[f].d_value.size();
       Node ev = ev_index==-1 ? Node::null() : d_quant_models[f].d_value[ev_index];
       if (ev!=d_true) {
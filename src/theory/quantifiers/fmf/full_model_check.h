@@ -78,6 +78,41 @@ public:
   void debugPrint(const char * tr, Node op, FullModelChecker * m);
 };/* class Def */
 
+/** Compiled generalization index of a definition
+ *
+ * This class computes the same result as Def::getGeneralizationIndex, i.e.
+ * the index of the first entry whose condition generalizes a tuple of
+ * values, with bitset operations instead of a traversal of the entry trie.
+ * It is used by exhaustive instantiation, which evaluates the definition of
+ * a quantified formula on every tuple of an enumeration.
+ *
+ * For each argument position i, the table stores a row of bits over the
+ * entries for each value v occurring at position i in a condition, whose bit
+ * for entry j is set if the condition of j at i is v or the star, and a row
+ * for the other values, whose bits are set for the conditions that are the
+ * star at i. The generalization index of a tuple is the first bit set in the
+ * conjunction of the rows of its values. The rows are stored contiguously.
+ */
+class DefIndex
+{
+ public:
+  DefIndex(FirstOrderModelFmc* m, Def& d);
+  /** Get the generalization index of inst, or -1 if none exists */
+  int getGeneralizationIndex(const std::vector<Node>& inst);
+
+ private:
+  /** The number of 64-bit words of a row */
+  size_t d_numWords;
+  /** For each position, the offsets of the rows of the values in d_rows */
+  std::vector<std::unordered_map<Node, size_t, NodeHashFunction>> d_valueRow;
+  /** For each position, the offset of the row of the other values */
+  std::vector<size_t> d_starRow;
+  /** The rows */
+  std::vector<uint64_t> d_rows;
+  /** The conjunction of the rows, used by getGeneralizationIndex */
+  std::vector<uint64_t> d_conj;
+};
+
 
 class FullModelChecker : public QModelBuilder
 {
@@ -25,6 +25,13 @@ namespace cvc5 {
 namespace theory {
 namespace quantifiers {
 
+namespace {
+
+/** The number of cached calls beyond which the cache is cleared */
+const size_t s_maxCachedCalls = 1 << 20;
+
+}  // namespace
+
 FunDefEvaluator::FunDefEvaluator() {}
 
 void FunDefEvaluator::assertDefinition(Node q)
@@ -44,6 +51,11 @@ void FunDefEvaluator::assertDefinition(Node q)
   fdi.d_body = QuantAttributes::getFunDefBody(q);
   Assert(!fdi.d_body.isNull());
   fdi.d_args.insert(fdi.d_args.end(), q[0].begin(), q[0].end());
+  fdi.d_prepared.reset(new PreparedEvaluator);
+  if (fdi.d_args.empty() || !fdi.d_prepared->prepare(fdi.d_body, fdi.d_args))
+  {
+    fdi.d_prepared.reset();
+  }
   Trace("fd-eval") << "FunDefEvaluator: function " << f << " is defined with "
                    << fdi.d_args << " / " << fdi.d_body << std::endl;
 }
@@ -58,6 +70,10 @@ Node FunDefEvaluator::evaluate(Node n) const
   std::unordered_map<TNode, unsigned, TNodeHashFunction>::iterator itCount;
   std::unordered_map<TNode, Node, TNodeHashFunction> visited;
   std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it;
+  // the applications to constant arguments whose results are pending, for
+  // the subterms whose result is the result of their body
+  std::unordered_map<TNode, Node, TNodeHashFunction> pendingCalls;
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator itc;
   std::map<Node, FunDefInfo>::const_iterator itf;
   std::vector<TNode> visit;
   TNode cur;
@@ -140,12 +156,14 @@ Node FunDefEvaluator::evaluate(Node n) const
           continue;
         }
         unsigned child CVC4_UNUSED = 0;
+        bool childrenConst = true;
         for (const Node& cn : cur)
         {
           it = visited.find(cn);
           Assert(it != visited.end());
           Assert(!it->second.isNull());
           childChanged = childChanged || cn != it->second;
+          childrenConst = childrenConst && it->second.isConst();
           children.push_back(it->second);
           Trace("fd-eval-debug2") << "argument " << child++
                                   << " eval : " << it->second << std::endl;
@@ -156,6 +174,22 @@ Node FunDefEvaluator::evaluate(Node n) const
           f = cur.getOperator();
           Trace("fd-eval-debug2")
               << "FunDefEvaluator: need to eval " << f << "\n";
+          Node app;
+          if (childrenConst)
+          {
+            std::vector<Node> achildren;
+            achildren.push_back(f);
+            achildren.insert(achildren.end(), children.begin(), children.end());
+            app = nm->mkNode(APPLY_UF, achildren);
+            itc = d_callCache.find(app);
+            if (itc != d_callCache.end())
+            {
+              Trace("fd-eval-debug2")
+                  << "FunDefEvaluator: cached " << itc->second << "\n";
+              visited[cur] = itc->second;
+              continue;
+            }
+          }
           itf = d_funDefMap.find(f);
           itCount = funDefCount.find(f);
           if (itCount == funDefCount.end())
@@ -179,6 +213,17 @@ Node FunDefEvaluator::evaluate(Node n) const
           Trace("fd-eval-debug2")
               << "FunDefEvaluator: definition: " << sbody << "\n";
           const std::vector<Node>& args = itf->second.d_args;
+          if (childrenConst && itf->second.d_prepared != nullptr)
+          {
+            // the body does not apply functions, evaluate it directly
+            Node pret = itf->second.d_prepared->eval(children);
+            if (!pret.isNull() && pret.isConst())
+            {
+              visited[cur] = pret;
+              cacheCall(app, pret);
+              continue;
+            }
+          }
           if (!args.empty())
           {
             // invoke it on arguments using the evaluator
@@ -207,6 +252,14 @@ Node FunDefEvaluator::evaluate(Node n) const
                                     << " from body " << sbody << "\n";
             visit.push_back(cur);
             visit.push_back(sbody);
+            if (!app.isNull())
+            {
+              pendingCalls[cur] = app;
+            }
+          }
+          else if (!app.isNull())
+          {
+            cacheCall(app, sbody);
           }
         }
         else
@@ -238,6 +291,14 @@ Node FunDefEvaluator::evaluate(Node n) const
           Trace("fd-eval-debug2")
               << "eval with definition " << it->second << "\n";
           visited[cur] = it->second;
+          if (it->second.isConst())
+          {
+            it = pendingCalls.find(cur);
+            if (it != pendingCalls.end())
+            {
+              cacheCall(it->second, visited[cur]);
+            }
+          }
       }
     }
     }
@@ -250,6 +311,16 @@ Node FunDefEvaluator::evaluate(Node n) const
 
 bool FunDefEvaluator::hasDefinitions() const { return !d_funDefMap.empty(); }
 
+void FunDefEvaluator::cacheCall(Node app, Node ret) const
+{
+  Assert(ret.isConst());
+  if (d_callCache.size() >= s_maxCachedCalls)
+  {
+    d_callCache.clear();
+  }
+  d_callCache[app] = ret;
+}
+
 }  // namespace quantifiers
 }  // namespace theory
 }  // namespace cvc5
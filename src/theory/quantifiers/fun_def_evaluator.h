@@ -18,7 +18,10 @@
 #define CVC4__QUANTIFIERS_FUN_DEF_EVALUATOR_H
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
+
 #include "expr/node.h"
 #include "theory/evaluator.h"
 
@@ -43,6 +46,11 @@ class FunDefEvaluator
    * Simplify node based on the (recursive) function definitions known by this
    * class. If n cannot be simplified to a constant, then this method returns
    * null.
+   *
+   * The constant results of the applications of functions to constant
+   * arguments are cached across calls (tabling), so that e.g. the recursive
+   * calls shared by the evaluations of a function on many points are only
+   * unfolded once.
    */
   Node evaluate(Node n) const;
   /**
@@ -61,11 +69,24 @@ class FunDefEvaluator
     Node d_body;
     /** the formal argument list */
     std::vector<Node> d_args;
+    /**
+     * The body prepared for evaluation, if it could be prepared, which is
+     * the case if it does not apply functions, e.g. for non-recursive
+     * helper functions on arithmetic or bit-vectors.
+     */
+    std::unique_ptr<PreparedEvaluator> d_prepared;
   };
+  /** Cache the constant result of the application app of a function */
+  void cacheCall(Node app, Node ret) const;
   /** maps functions to the above information */
   std::map<Node, FunDefInfo> d_funDefMap;
   /** evaluator utility */
   Evaluator d_eval;
+  /**
+   * Maps applications of functions to constant arguments to their constant
+   * results.
+   */
+  mutable std::unordered_map<Node, Node, NodeHashFunction> d_callCache;
 };
 
 }  // namespace quantifiers
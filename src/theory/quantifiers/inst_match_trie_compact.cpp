@@ -0,0 +1,309 @@
+/*********************                                                        */
+/*! \file inst_match_trie_compact.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of compact inst match trie class
+ **/
+
+#include "theory/quantifiers/inst_match_trie_compact.h"
+
+#include <limits>
+
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/uf/equality_engine_iterator.h"
+
+using namespace cvc5::context;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+const uint32_t InstMatchTrieCompact::s_null =
+    std::numeric_limits<uint32_t>::max();
+
+void InstMatchTrieCompact::TrailCleanUp::operator()(TrailEntry* e)
+{
+  d_trie->undo(*e);
+}
+
+InstMatchTrieCompact::InstMatchTrieCompact(context::Context* c)
+    : d_slots(16, s_null), d_trail(c, true, TrailCleanUp(this))
+{
+  // the root
+  d_nodes.push_back(TrieNode{Node::null(), s_null, s_null, s_null, false});
+}
+
+InstMatchTrieCompact::~InstMatchTrieCompact() {}
+
+void InstMatchTrieCompact::undo(const TrailEntry& e)
+{
+  uint32_t i = e.d_node;
+  switch (e.d_kind)
+  {
+    case TrailEntry::CREATE:
+    {
+      // nodes are undone in the reverse order of their creation
+      Assert(i + 1 == d_nodes.size());
+      uint32_t p = d_nodes[i].d_parent;
+      Assert(d_nodes[p].d_firstChild == i);
+      d_nodes[p].d_firstChild = d_nodes[i].d_nextSibling;
+      eraseSlot(i);
+      d_nodes.pop_back();
+      break;
+    }
+    case TrailEntry::REMOVE: d_nodes[i].d_removed = false; break;
+    case TrailEntry::READD: d_nodes[i].d_removed = true; break;
+  }
+}
+
+size_t InstMatchTrieCompact::getSlot(uint32_t parent, uint64_t id) const
+{
+  uint64_t h = static_cast<uint64_t>(parent) * 0x9E3779B97F4A7C15ULL;
+  h ^= id * 0xC2B2AE3D27D4EB4FULL;
+  h ^= h >> 32;
+  return static_cast<size_t>(h) & (d_slots.size() - 1);
+}
+
+uint32_t InstMatchTrieCompact::getChild(uint32_t parent, TNode n) const
+{
+  size_t mask = d_slots.size() - 1;
+  for (size_t s = getSlot(parent, n.getId()); d_slots[s] != s_null;
+       s = (s + 1) & mask)
+  {
+    const TrieNode& c = d_nodes[d_slots[s]];
+    if (c.d_parent == parent && c.d_label == n)
+    {
+      return d_slots[s];
+    }
+  }
+  return s_null;
+}
+
+uint32_t InstMatchTrieCompact::mkChild(uint32_t parent, Node n)
+{
+  uint32_t i = d_nodes.size();
+  uint32_t sibling = d_nodes[parent].d_firstChild;
+  d_nodes.push_back(TrieNode{n, parent, s_null, sibling, false});
+  d_nodes[parent].d_firstChild = i;
+  // keep the load factor of the hash table at most 1/2
+  if (2 * d_nodes.size() > d_slots.size())
+  {
+    grow();
+  }
+  else
+  {
+    insertSlot(i);
+  }
+  d_trail.push_back(TrailEntry{TrailEntry::CREATE, i});
+  return i;
+}
+
+void InstMatchTrieCompact::insertSlot(uint32_t i)
+{
+  size_t mask = d_slots.size() - 1;
+  size_t s = getSlot(d_nodes[i].d_parent, d_nodes[i].d_label.getId());
+  while (d_slots[s] != s_null)
+  {
+    s = (s + 1) & mask;
+  }
+  d_slots[s] = i;
+}
+
+void InstMatchTrieCompact::eraseSlot(uint32_t i)
+{
+  size_t mask = d_slots.size() - 1;
+  size_t s = getSlot(d_nodes[i].d_parent, d_nodes[i].d_label.getId());
+  while (d_slots[s] != i)
+  {
+    Assert(d_slots[s] != s_null);
+    s = (s + 1) & mask;
+  }
+  // backward shift deletion, which moves the entries of the cluster after s
+  // whose home slot is not between s and their slot
+  size_t j = s;
+  while (true)
+  {
+    j = (j + 1) & mask;
+    if (d_slots[j] == s_null)
+    {
+      break;
+    }
+    const TrieNode& c = d_nodes[d_slots[j]];
+    size_t k = getSlot(c.d_parent, c.d_label.getId());
+    if (s < j ? (s < k && k <= j) : (s < k || k <= j))
+    {
+      continue;
+    }
+    d_slots[s] = d_slots[j];
+    s = j;
+  }
+  d_slots[s] = s_null;
+}
+
+void InstMatchTrieCompact::grow()
+{
+  d_slots.assign(2 * d_slots.size(), s_null);
+  for (uint32_t i = 1, size = d_nodes.size(); i < size; i++)
+  {
+    insertSlot(i);
+  }
+}
+
+bool InstMatchTrieCompact::exists(QuantifiersState& qs,
+                                  const std::vector<Node>& m,
+                                  bool modEq,
+                                  uint32_t node,
+                                  size_t index) const
+{
+  if (index == m.size())
+  {
+    return !d_nodes[node].d_removed;
+  }
+  const Node& n = m[index];
+  uint32_t c = getChild(node, n);
+  if (c != s_null && exists(qs, m, modEq, c, index + 1))
+  {
+    return true;
+  }
+  if (modEq && !n.isNull() && qs.hasTerm(n))
+  {
+    // check modulo equality if any other instantiation match exists
+    eq::EqClassIterator eqc(qs.getRepresentative(n), qs.getEqualityEngine());
+    while (!eqc.isFinished())
+    {
+      Node en = (*eqc);
+      if (en != n)
+      {
+        c = getChild(node, en);
+        if (c != s_null && exists(qs, m, modEq, c, index + 1))
+        {
+          return true;
+        }
+      }
+      ++eqc;
+    }
+  }
+  return false;
+}
+
+bool InstMatchTrieCompact::existsInstMatch(QuantifiersState& qs,
+                                           Node q,
+                                           const std::vector<Node>& m,
+                                           bool modEq)
+{
+  Assert(m.size() == q[0].getNumChildren());
+  return exists(qs, m, modEq, 0, 0);
+}
+
+bool InstMatchTrieCompact::addInstMatch(QuantifiersState& qs,
+                                        Node q,
+                                        const std::vector<Node>& m,
+                                        bool modEq)
+{
+  Assert(m.size() == q[0].getNumChildren());
+  if (exists(qs, m, modEq, 0, 0))
+  {
+    return false;
+  }
+  uint32_t node = 0;
+  for (const Node& n : m)
+  {
+    uint32_t c = getChild(node, n);
+    node = c == s_null ? mkChild(node, n) : c;
+  }
+  if (d_nodes[node].d_removed)
+  {
+    d_nodes[node].d_removed = false;
+    d_trail.push_back(TrailEntry{TrailEntry::READD, node});
+  }
+  return true;
+}
+
+bool InstMatchTrieCompact::removeInstMatch(Node q, const std::vector<Node>& m)
+{
+  Assert(m.size() == q[0].getNumChildren());
+  uint32_t node = 0;
+  for (const Node& n : m)
+  {
+    node = getChild(node, n);
+    if (node == s_null)
+    {
+      return false;
+    }
+  }
+  if (d_nodes[node].d_removed)
+  {
+    return false;
+  }
+  d_nodes[node].d_removed = true;
+  d_trail.push_back(TrailEntry{TrailEntry::REMOVE, node});
+  return true;
+}
+
+void InstMatchTrieCompact::getInstantiations(
+    Node q, std::vector<std::vector<Node>>& insts) const
+{
+  std::vector<Node> terms;
+  getInstantiations(0, q[0].getNumChildren(), insts, terms);
+}
+
+void InstMatchTrieCompact::getInstantiations(
+    uint32_t node,
+    size_t nvars,
+    std::vector<std::vector<Node>>& insts,
+    std::vector<Node>& terms) const
+{
+  if (terms.size() == nvars)
+  {
+    if (!d_nodes[node].d_removed)
+    {
+      insts.push_back(terms);
+    }
+    return;
+  }
+  // the children are visited in the order of their creation
+  std::vector<uint32_t> children;
+  for (uint32_t c = d_nodes[node].d_firstChild; c != s_null;
+       c = d_nodes[c].d_nextSibling)
+  {
+    children.push_back(c);
+  }
+  for (std::vector<uint32_t>::reverse_iterator it = children.rbegin();
+       it != children.rend();
+       ++it)
+  {
+    terms.push_back(d_nodes[*it].d_label);
+    getInstantiations(*it, nvars, insts, terms);
+    terms.pop_back();
+  }
+}
+
+void InstMatchTrieCompact::print(std::ostream& out, Node q) const
+{
+  std::vector<std::vector<Node>> insts;
+  getInstantiations(q, insts);
+  for (const std::vector<Node>& terms : insts)
+  {
+    out << "  ( ";
+    for (size_t i = 0, size = terms.size(); i < size; i++)
+    {
+      if (i > 0)
+      {
+        out << ", ";
+      }
+      out << terms[i];
+    }
+    out << " )" << std::endl;
+  }
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,170 @@
+/*********************                                                        */
+/*! \file inst_match_trie_compact.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief compact inst match trie class
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__INST_MATCH_TRIE_COMPACT_H
+#define CVC4__THEORY__QUANTIFIERS__INST_MATCH_TRIE_COMPACT_H
+
+#include <vector>
+
+#include "context/cdlist.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+
+/** compact trie for the instantiations of a quantified formula
+ *
+ * This is a replacement of CDInstMatchTrie and InstMatchTrie that is used by
+ * Instantiate if the option --inst-trie-compact is enabled. It has the same
+ * interface for adding, removing and checking the existence of instantiations,
+ * possibly modulo equality, but a more compact representation.
+ *
+ * The nodes of the trie are stored in a single vector, in the order they are
+ * created, and refer to each other by index. Each node stores its parent, its
+ * label (the term of the edge from its parent), its first child and its next
+ * sibling. The children of a node are found by a single open addressing hash
+ * table for the whole trie, keyed by the parent and the id of the label, whose
+ * slots only store the index of the child. Hence there is one allocation per
+ * growth of the vectors instead of one per node of the trie.
+ *
+ * The trie is context dependent. The creation of a node, and the removal and
+ * re-addition of an instantiation, are recorded in a context-dependent trail,
+ * which undoes them when the context is popped. Since nodes are undone in the
+ * reverse order of their creation, undoing a node only pops it from the back
+ * of the vector.
+ */
+class InstMatchTrieCompact
+{
+ public:
+  InstMatchTrieCompact(context::Context* c);
+  ~InstMatchTrieCompact();
+  /** exists inst match
+   *
+   * Returns true if m, whose domain is the bound variables of quantified
+   * formula q, exists in this trie. If modEq is true, we check for duplication
+   * modulo equality the current equalities in the equality engine of qs.
+   */
+  bool existsInstMatch(QuantifiersState& qs,
+                       Node q,
+                       const std::vector<Node>& m,
+                       bool modEq = false);
+  /** add inst match
+   *
+   * Adds m to this trie, and returns true if and only if m did not already
+   * occur in this trie, where the arguments are the same as above.
+   */
+  bool addInstMatch(QuantifiersState& qs,
+                    Node q,
+                    const std::vector<Node>& m,
+                    bool modEq = false);
+  /**
+   * Remove m from this trie. Returns true if and only if this entry existed
+   * in this trie.
+   */
+  bool removeInstMatch(Node q, const std::vector<Node>& m);
+  /** Adds the instantiations for q into insts. */
+  void getInstantiations(Node q, std::vector<std::vector<Node>>& insts) const;
+  /** print this class */
+  void print(std::ostream& out, Node q) const;
+  /** Get the number of nodes of this trie, including its root */
+  size_t getNumNodes() const { return d_nodes.size(); }
+
+ private:
+  /** The index of no node */
+  static const uint32_t s_null;
+  /** A node of the trie */
+  struct TrieNode
+  {
+    /** The label of the edge from the parent */
+    Node d_label;
+    /** The parent */
+    uint32_t d_parent;
+    /** The most recently created child */
+    uint32_t d_firstChild;
+    /** The next older sibling */
+    uint32_t d_nextSibling;
+    /** Whether the instantiation of this leaf is removed */
+    bool d_removed;
+  };
+  /** An entry of the trail */
+  struct TrailEntry
+  {
+    enum Kind
+    {
+      /** Creation of a node */
+      CREATE,
+      /** Removal of an instantiation */
+      REMOVE,
+      /** Re-addition of a removed instantiation */
+      READD
+    };
+    Kind d_kind;
+    uint32_t d_node;
+  };
+  /** Undoes the trail entries that are popped */
+  class TrailCleanUp
+  {
+   public:
+    TrailCleanUp(InstMatchTrieCompact* t) : d_trie(t) {}
+    void operator()(TrailEntry* e);
+
+   private:
+    InstMatchTrieCompact* d_trie;
+  };
+  /** Undo the trail entry e */
+  void undo(const TrailEntry& e);
+  /** The slot of the hash table for the child of parent with label id */
+  size_t getSlot(uint32_t parent, uint64_t id) const;
+  /** Get the child of parent with label n, or s_null if none */
+  uint32_t getChild(uint32_t parent, TNode n) const;
+  /** Make a child of parent with label n */
+  uint32_t mkChild(uint32_t parent, Node n);
+  /** Insert node i in the hash table */
+  void insertSlot(uint32_t i);
+  /** Erase node i from the hash table */
+  void eraseSlot(uint32_t i);
+  /** Double the capacity of the hash table */
+  void grow();
+  /** Does the suffix of m starting at index exist below node? */
+  bool exists(QuantifiersState& qs,
+              const std::vector<Node>& m,
+              bool modEq,
+              uint32_t node,
+              size_t index) const;
+  /** Helper for getInstantiations and print */
+  void getInstantiations(uint32_t node,
+                         size_t nvars,
+                         std::vector<std::vector<Node>>& insts,
+                         std::vector<Node>& terms) const;
+  /** The nodes, where the root has index 0 */
+  std::vector<TrieNode> d_nodes;
+  /**
+   * The hash table, mapping the parent and the id of the label of each node
+   * but the root to its index, with linear probing.
+   */
+  std::vector<uint32_t> d_slots;
+  /** The trail */
+  context::CDList<TrailEntry, TrailCleanUp> d_trail;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__INST_MATCH_TRIE_COMPACT_H */
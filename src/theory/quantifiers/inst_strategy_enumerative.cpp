@@ -179,10 +179,29 @@ bool InstStrategyEnum::process(Node quantifier, bool fullEffort, bool isRd)
   {
     return false;
   }
+  bool rdSkip = isRd && options::relDomIncremental();
+  if (rdSkip)
+  {
+    std::map<Node, std::pair<uint64_t, bool>>::iterator it =
+        d_rdExhausted.find(quantifier);
+    if (it != d_rdExhausted.end() && (it->second.second || !fullEffort)
+        && d_rd->isUnchangedSince(quantifier, it->second.first))
+    {
+      Trace("inst-alg-rd") << "Skip " << quantifier
+                           << ", relevant domain is unchanged" << std::endl;
+      return false;
+    }
+  }
 
   TermTupleEnumeratorEnv ttec;
   ttec.d_fullEffort = fullEffort;
   ttec.d_increaseSum = options::fullSaturateSum();
+  ttec.d_costBound = options::fullSaturateCostBound();
+  // the relevant domain orders the ground terms if it has been computed
+  ttec.d_rdOrder = !isRd && d_rd != nullptr && options::fullSaturateQuantRd()
+                           && options::fullSaturateRdOrder()
+                       ? d_rd
+                       : nullptr;
   // make the enumerator, which is either relevant domain or term database
   // based on the flag isRd.
   std::unique_ptr<TermTupleEnumeratorInterface> enumerator(
@@ -200,8 +219,15 @@ bool InstStrategyEnum::process(Node quantifier, bool fullEffort, bool isRd)
       return false;
     }
     enumerator->next(terms);
-    // try instantiation
     failMask.clear();
+    if (options::fullSaturateEntailPrune()
+        && isEntailedPrefix(quantifier, terms, failMask))
+    {
+      // skip the tuples extending the entailed prefix
+      enumerator->failureReason(failMask);
+      continue;
+    }
+    // try instantiation
     /* if (ie->addInstantiation(quantifier, terms)) */
     if (ie->addInstantiationExpFail(
             quantifier, terms, failMask, InferenceId::QUANTIFIERS_INST_ENUM))
@@ -214,10 +240,56 @@ bool InstStrategyEnum::process(Node quantifier, bool fullEffort, bool isRd)
       enumerator->failureReason(failMask);
     }
   }
+  if (rdSkip)
+  {
+    d_rdExhausted[quantifier] =
+        std::pair<uint64_t, bool>(d_rd->getRound(), fullEffort);
+  }
   return false;
   // TODO : term enumerator instantiation?
 }
 
+bool InstStrategyEnum::isEntailedPrefix(Node q,
+                                        const std::vector<Node>& terms,
+                                        std::vector<bool>& mask)
+{
+  size_t nvars = terms.size();
+  for (const Node& t : terms)
+  {
+    if (t.isNull())
+    {
+      return false;
+    }
+  }
+  TermDb* tdb = d_treg.getTermDatabase();
+  std::map<TNode, TNode> subs;
+  for (size_t i = 0; i < nvars; i++)
+  {
+    subs[q[0][i]] = terms[i];
+  }
+  if (!tdb->isEntailed(q[1], subs, false, true))
+  {
+    return false;
+  }
+  // find the shortest entailed prefix, which does not depend on the variables
+  // after it
+  size_t len = nvars;
+  subs.clear();
+  for (size_t i = 0; i + 1 < nvars; i++)
+  {
+    subs[q[0][i]] = terms[i];
+    if (tdb->isEntailed(q[1], subs, false, true))
+    {
+      len = i + 1;
+      break;
+    }
+  }
+  Trace("inst-alg-rd") << "Entailed prefix of length " << len << std::endl;
+  mask.assign(nvars, false);
+  std::fill(mask.begin(), mask.begin() + len, true);
+  return true;
+}
+
 }  // namespace quantifiers
 }  // namespace theory
 }  // namespace cvc5
@@ -17,6 +17,8 @@
 #ifndef CVC4__INST_STRATEGY_ENUMERATIVE_H
 #define CVC4__INST_STRATEGY_ENUMERATIVE_H
 
+#include <map>
+
 #include "theory/quantifiers/quant_module.h"
 
 namespace cvc5 {
@@ -106,12 +108,27 @@ class InstStrategyEnum : public QuantifiersModule
    * term instantiations.
    */
   bool process(Node q, bool fullEffort, bool isRd);
+  /**
+   * Whether the instance of q for terms is entailed, in which case mask is
+   * set to the shortest prefix of terms whose instance is entailed. All tuples
+   * extending this prefix can then be skipped by the enumerator.
+   */
+  bool isEntailedPrefix(Node q,
+                        const std::vector<Node>& terms,
+                        std::vector<bool>& mask);
   /**
    * A limit on the number of rounds to apply this strategy, where a value < 0
    * means no limit. This value is set to the value of fullSaturateLimit()
    * during presolve.
    */
   int32_t d_fullSaturateLimit;
+  /**
+   * Maps the quantified formulas whose relevant domain enumeration was
+   * exhausted to the round of the relevant domain in which this happened, and
+   * whether it was at full effort. If the relevant domain of such a formula
+   * is unchanged since that round, enumerating it again is redundant.
+   */
+  std::map<Node, std::pair<uint64_t, bool>> d_rdExhausted;
 }; /* class InstStrategyEnum */
 
 }  // namespace quantifiers
@@ -90,6 +90,39 @@ void Instantiate::addRewriter(InstantiationRewriter* ir)
   d_instRewrite.push_back(ir);
 }
 
+void Instantiate::notifyFlushLemmas() { d_batchLemmas.clear(); }
+
+void Instantiate::notifyRelevantInstantiations(
+    const std::map<Node, std::vector<std::vector<Node>>>& insts)
+{
+  if (!options::quantProfile())
+  {
+    return;
+  }
+  for (const std::pair<const Node, std::vector<std::vector<Node>>>& i : insts)
+  {
+    d_statistics.d_profile.notifyRelevant(
+        i.first, d_qreg.getNameForQuant(i.first), i.second.size());
+  }
+}
+
+void Instantiate::notifyInstance(Node q, InferenceId id, bool added)
+{
+  if (added)
+  {
+    d_statistics.d_instIds << id;
+  }
+  else
+  {
+    d_statistics.d_redundantIds << id;
+  }
+  if (options::quantProfile())
+  {
+    d_statistics.d_profile.notifyInstance(
+        q, d_qreg.getNameForQuant(q), id, added);
+  }
+}
+
 bool Instantiate::addInstantiation(Node q,
                                    std::vector<Node>& terms,
                                    InferenceId id,
@@ -204,6 +237,7 @@ bool Instantiate::addInstantiation(Node q,
     {
       Trace("inst-add-debug") << " --> Currently entailed." << std::endl;
       ++(d_statistics.d_inst_duplicate_ent);
+      notifyInstance(q, id, false);
       return false;
     }
   }
@@ -226,6 +260,7 @@ bool Instantiate::addInstantiation(Node q,
   {
     Trace("inst-add-debug") << " --> Already exists (no record)." << std::endl;
     ++(d_statistics.d_inst_duplicate_eq);
+    notifyInstance(q, id, false);
     return false;
   }
 
@@ -269,6 +304,18 @@ bool Instantiate::addInstantiation(Node q,
   }
   Trace("inst-debug") << "...preprocess to " << body << std::endl;
 
+  // The instance may only be entailed after rewriting, e.g. if the
+  // substitution makes some of its literals trivial, which the entailment
+  // check above on the body of q does not see.
+  if (options::instBatchFilter() && options::instNoEntail()
+      && tdb->isEntailed(Rewriter::rewrite(body), true))
+  {
+    Trace("inst-add-debug") << " --> Rewritten body entailed." << std::endl;
+    ++(d_statistics.d_inst_duplicate_ent_rw);
+    notifyInstance(q, id, false);
+    return false;
+  }
+
   // construct the lemma
   Trace("inst-assert") << "(assert " << body << ")" << std::endl;
 
@@ -308,6 +355,17 @@ bool Instantiate::addInstantiation(Node q,
     lem = Rewriter::rewrite(lem);
   }
 
+  // Distinct instances may have the same lemma, e.g. if a variable does not
+  // occur in the body after rewriting. The inference manager only checks for
+  // lemmas that were already sent, hence we check the lemmas of the batch.
+  if (options::instBatchFilter() && !d_batchLemmas.insert(lem).second)
+  {
+    Trace("inst-add-debug") << " --> Lemma already pending." << std::endl;
+    ++(d_statistics.d_inst_duplicate_batch);
+    notifyInstance(q, id, false);
+    return false;
+  }
+
   // added lemma, which checks for lemma duplication
   bool addedLem = false;
   if (hasProof)
@@ -325,6 +383,7 @@ bool Instantiate::addInstantiation(Node q,
   {
     Trace("inst-add-debug") << " --> Lemma already exists." << std::endl;
     ++(d_statistics.d_inst_duplicate);
+    notifyInstance(q, id, false);
     return false;
   }
 
@@ -378,6 +437,7 @@ bool Instantiate::addInstantiation(Node q,
   }
   Trace("inst-add-debug") << " --> Success." << std::endl;
   ++(d_statistics.d_instantiations);
+  notifyInstance(q, id, true);
   return true;
 }
 
@@ -490,7 +550,16 @@ bool Instantiate::existsInstantiation(Node q,
                                       std::vector<Node>& terms,
                                       bool modEq)
 {
-  if (options::incrementalSolving())
+  if (options::instTrieCompact())
+  {
+    std::map<Node, std::unique_ptr<InstMatchTrieCompact>>::iterator it =
+        d_compact_inst_match_trie.find(q);
+    if (it != d_compact_inst_match_trie.end())
+    {
+      return it->second->existsInstMatch(d_qstate, q, terms, modEq);
+    }
+  }
+  else if (options::incrementalSolving())
   {
     std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
     if (it != d_c_inst_match_trie.end())
@@ -562,6 +631,17 @@ bool Instantiate::recordInstantiationInternal(Node q,
                                               std::vector<Node>& terms,
                                               bool modEq)
 {
+  if (options::instTrieCompact())
+  {
+    Trace("inst-add-debug") << "Adding into compact inst trie, modEq = "
+                            << modEq << std::endl;
+    std::unique_ptr<InstMatchTrieCompact>& imt = d_compact_inst_match_trie[q];
+    if (imt == nullptr)
+    {
+      imt.reset(new InstMatchTrieCompact(d_qstate.getUserContext()));
+    }
+    return imt->addInstMatch(d_qstate, q, terms, modEq);
+  }
   if (options::incrementalSolving())
   {
     Trace("inst-add-debug")
@@ -587,6 +667,16 @@ bool Instantiate::recordInstantiationInternal(Node q,
 
 bool Instantiate::removeInstantiationInternal(Node q, std::vector<Node>& terms)
 {
+  if (options::instTrieCompact())
+  {
+    std::map<Node, std::unique_ptr<InstMatchTrieCompact>>::iterator it =
+        d_compact_inst_match_trie.find(q);
+    if (it != d_compact_inst_match_trie.end())
+    {
+      return it->second->removeInstMatch(q, terms);
+    }
+    return false;
+  }
   if (options::incrementalSolving())
   {
     std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
@@ -612,8 +702,16 @@ void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs) const
 void Instantiate::getInstantiationTermVectors(
     Node q, std::vector<std::vector<Node> >& tvecs)
 {
-
-  if (options::incrementalSolving())
+  if (options::instTrieCompact())
+  {
+    std::map<Node, std::unique_ptr<InstMatchTrieCompact>>::const_iterator it =
+        d_compact_inst_match_trie.find(q);
+    if (it != d_compact_inst_match_trie.end())
+    {
+      it->second->getInstantiations(q, tvecs);
+    }
+  }
+  else if (options::incrementalSolving())
   {
     std::map<Node, CDInstMatchTrie*>::const_iterator it =
         d_c_inst_match_trie.find(q);
@@ -636,7 +734,14 @@ void Instantiate::getInstantiationTermVectors(
 void Instantiate::getInstantiationTermVectors(
     std::map<Node, std::vector<std::vector<Node> > >& insts)
 {
-  if (options::incrementalSolving())
+  if (options::instTrieCompact())
+  {
+    for (const auto& t : d_compact_inst_match_trie)
+    {
+      getInstantiationTermVectors(t.first, insts[t.first]);
+    }
+  }
+  else if (options::incrementalSolving())
   {
     for (const auto& t : d_c_inst_match_trie)
     {
@@ -742,12 +847,26 @@ Instantiate::Statistics::Statistics()
     : d_instantiations("Instantiate::Instantiations_Total", 0),
       d_inst_duplicate("Instantiate::Duplicate_Inst", 0),
       d_inst_duplicate_eq("Instantiate::Duplicate_Inst_Eq", 0),
-      d_inst_duplicate_ent("Instantiate::Duplicate_Inst_Entailed", 0)
+      d_inst_duplicate_ent("Instantiate::Duplicate_Inst_Entailed", 0),
+      d_inst_duplicate_ent_rw("Instantiate::Duplicate_Inst_Entailed_Rewritten",
+                              0),
+      d_inst_duplicate_batch("Instantiate::Duplicate_Inst_Batch", 0),
+      d_instIds("Instantiate::Instantiations_Id"),
+      d_redundantIds("Instantiate::Redundant_Inst_Id"),
+      d_profile("Instantiate::Profile")
 {
   smtStatisticsRegistry()->registerStat(&d_instantiations);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_eq);
   smtStatisticsRegistry()->registerStat(&d_inst_duplicate_ent);
+  smtStatisticsRegistry()->registerStat(&d_inst_duplicate_ent_rw);
+  smtStatisticsRegistry()->registerStat(&d_inst_duplicate_batch);
+  smtStatisticsRegistry()->registerStat(&d_instIds);
+  smtStatisticsRegistry()->registerStat(&d_redundantIds);
+  if (options::quantProfile())
+  {
+    smtStatisticsRegistry()->registerStat(&d_profile);
+  }
 }
 
 Instantiate::Statistics::~Statistics()
@@ -756,6 +875,14 @@ Instantiate::Statistics::~Statistics()
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate);
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_eq);
   smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_ent);
+  smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_ent_rw);
+  smtStatisticsRegistry()->unregisterStat(&d_inst_duplicate_batch);
+  smtStatisticsRegistry()->unregisterStat(&d_instIds);
+  smtStatisticsRegistry()->unregisterStat(&d_redundantIds);
+  if (options::quantProfile())
+  {
+    smtStatisticsRegistry()->unregisterStat(&d_profile);
+  }
 }
 
 }  // namespace quantifiers
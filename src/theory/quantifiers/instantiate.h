@@ -18,14 +18,18 @@
 #define CVC4__THEORY__QUANTIFIERS__INSTANTIATE_H
 
 #include <map>
+#include <unordered_set>
 
 #include "context/cdhashset.h"
 #include "expr/node.h"
 #include "expr/proof.h"
 #include "theory/inference_id.h"
 #include "theory/quantifiers/inst_match_trie.h"
+#include "theory/quantifiers/inst_match_trie_compact.h"
+#include "theory/quantifiers/quant_profile.h"
 #include "theory/quantifiers/quant_util.h"
 #include "util/statistics_registry.h"
+#include "util/stats_histogram.h"
 
 namespace cvc5 {
 
@@ -125,9 +129,17 @@ class Instantiate : public QuantifiersUtil
   /** notify flush lemmas
    *
    * This is called just before the quantifiers engine flushes its lemmas to
-   * the output channel.
+   * the output channel. It ends the batch of instantiation lemmas of the
+   * current round (see --inst-batch-filter).
    */
   void notifyFlushLemmas();
+  /**
+   * Notify that insts are the instantiations of each quantified formula that
+   * occur in the proof of an unsatisfiable result, which are recorded in the
+   * profile of --quant-profile.
+   */
+  void notifyRelevantInstantiations(
+      const std::map<Node, std::vector<std::vector<Node>>>& insts);
   //--------------------------------------end rewrite objects
 
   /** do instantiation specified by m
@@ -288,12 +300,27 @@ class Instantiate : public QuantifiersUtil
     IntStat d_inst_duplicate;
     IntStat d_inst_duplicate_eq;
     IntStat d_inst_duplicate_ent;
+    /** instances whose rewritten body is entailed, with --inst-batch-filter */
+    IntStat d_inst_duplicate_ent_rw;
+    /** lemmas already pending in the round, with --inst-batch-filter */
+    IntStat d_inst_duplicate_batch;
+    /** instantiations per inference identifier (the source strategy) */
+    IntegralHistogramStat<InferenceId> d_instIds;
+    /** redundant instances per inference identifier, for all criteria */
+    IntegralHistogramStat<InferenceId> d_redundantIds;
+    /** the profile of each quantified formula, with --quant-profile */
+    QuantProfile d_profile;
     Statistics();
     ~Statistics();
   }; /* class Instantiate::Statistics */
   Statistics d_statistics;
 
  private:
+  /**
+   * Record in the statistics that an instance of q with identifier id was
+   * added, or was redundant if added is false.
+   */
+  void notifyInstance(Node q, InferenceId id, bool added);
   /** record instantiation, return true if it was not a duplicate
    *
    * modEq : whether to check for duplication modulo equality in instantiation
@@ -340,6 +367,12 @@ class Instantiate : public QuantifiersUtil
   std::map<Node, std::vector<Node> > d_recordedInst;
   /** statistics for debugging total instantiations per quantifier per round */
   std::map<Node, uint32_t> d_temp_inst_debug;
+  /**
+   * The rewritten instantiation lemmas added since the last flush of the
+   * pending lemmas, if --inst-batch-filter is enabled. The cache of the
+   * inference manager only contains the lemmas that were sent.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_batchLemmas;
 
   /** list of all instantiations produced for each quantifier
    *
@@ -348,6 +381,13 @@ class Instantiate : public QuantifiersUtil
    */
   std::map<Node, InstMatchTrie> d_inst_match_trie;
   std::map<Node, CDInstMatchTrie*> d_c_inst_match_trie;
+  /**
+   * The compact versions of the above, which are used instead of them if
+   * --inst-trie-compact is enabled. They are context dependent, which has no
+   * effect if incremental solving is disabled.
+   */
+  std::map<Node, std::unique_ptr<InstMatchTrieCompact>>
+      d_compact_inst_match_trie;
   /**
    * The list of quantified formulas for which the domain of d_c_inst_match_trie
    * is valid.
@@ -1861,7 +1861,9 @@ QuantConflictFind::QuantConflictFind(QuantifiersState& qs,
       d_conflict(qs.getSatContext(), false),
       d_true(NodeManager::currentNM()->mkConst<bool>(true)),
       d_false(NodeManager::currentNM()->mkConst<bool>(false)),
-      d_effort(EFFORT_INVALID)
+      d_effort(EFFORT_INVALID),
+      d_round(0),
+      d_failedVersion(0)
 {
 }
 
@@ -2018,6 +2020,14 @@ void QuantConflictFind::check(Theory::Effort level, QEffort quant_e)
   // reset the round-specific information
   d_irr_func.clear();
   d_irr_quant.clear();
+  d_round++;
+  uint64_t version = getTermDatabase()->getStateVersion();
+  if (version != d_failedVersion)
+  {
+    // the failed matches may succeed in the new state
+    d_failedMatches.clear();
+    d_failedVersion = version;
+  }
 
   if (Trace.isOn("qcf-debug"))
   {
@@ -2043,6 +2053,12 @@ void QuantConflictFind::check(Theory::Effort level, QEffort quant_e)
           && d_irr_quant.find(q) == d_irr_quant.end()
           && fm->isQuantifierActive(q))
       {
+        if (isSkipped(q))
+        {
+          Trace("qcf-check") << "Skip " << q << " by back-off" << std::endl;
+          ++(d_statistics.d_skipped);
+          continue;
+        }
         // check this quantified formula
         checkQuantifiedFormula(q, isConflict, addedLemmas);
         if (d_conflict || d_qstate.isInConflict())
@@ -2116,6 +2132,14 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
   // try to make a matches making the body false or propagating
   Trace("qcf-check-debug") << "Get next match..." << std::endl;
   Instantiate* qinst = d_qim.getInstantiate();
+  uint32_t matchLimit = options::qcfMatchLimit();
+  uint32_t nmatches = 0;
+  int qid = d_quant_id[q];
+  std::set<std::vector<Node>>* failed = nullptr;
+  if (options::qcfFailCache())
+  {
+    failed = &d_failedMatches[std::pair<Node, Effort>(q, d_effort)];
+  }
   while (qi->getNextMatch(this))
   {
     if (d_qstate.isInConflict())
@@ -2126,6 +2150,16 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
                          << std::endl;
       return;
     }
+    if (matchLimit > 0 && nmatches == matchLimit)
+    {
+      Trace("qcf-check") << "   ... Exceeded match limit" << std::endl;
+      ++(d_statistics.d_matchLimitExceeded);
+      updateBackoff(q, true, false);
+      return;
+    }
+    nmatches++;
+    ++(d_statistics.d_matches);
+    d_statistics.d_matchesPerQuant << qid;
     if (Trace.isOn("qcf-inst"))
     {
       Trace("qcf-inst") << "*** Produced match at effort " << d_effort << " : "
@@ -2140,12 +2174,28 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
                         << std::endl;
       continue;
     }
+    // check whether the match failed in a previous round with the same state
+    std::vector<Node> failedKey;
+    if (failed != nullptr)
+    {
+      getFailedMatchKey(qi, failedKey);
+      if (failed->find(failedKey) != failed->end())
+      {
+        Trace("qcf-inst") << "   ... Spurious (cached)" << std::endl;
+        ++(d_statistics.d_failedCacheHits);
+        continue;
+      }
+    }
     // check whether match can be completed
     std::vector<int> assigned;
     if (!qi->completeMatch(this, assigned))
     {
       Trace("qcf-inst") << "   ... Spurious (cannot assign unassigned vars)"
                         << std::endl;
+      if (failed != nullptr)
+      {
+        failed->insert(failedKey);
+      }
       continue;
     }
     // check whether the match is spurious according to (T-)entailment checks
@@ -2156,6 +2206,10 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
     {
       Trace("qcf-inst") << "   ... Spurious (match is T-inconsistent)"
                         << std::endl;
+      if (failed != nullptr)
+      {
+        failed->insert(failedKey);
+      }
     }
     else
     {
@@ -2184,6 +2238,8 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
         return;
       }
       Trace("qcf-check") << "   ... Added instantiation" << std::endl;
+      d_statistics.d_instancesPerQuant << qid;
+      updateBackoff(q, false, true);
       if (Trace.isOn("qcf-inst"))
       {
         Trace("qcf-inst") << "*** Was from effort " << d_effort << " : "
@@ -2221,6 +2277,41 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
   Trace("qcf-check") << "Done, conflict = " << d_conflict << std::endl;
 }
 
+bool QuantConflictFind::isSkipped(Node q) const
+{
+  std::map<Node, Backoff>::const_iterator it = d_backoff.find(q);
+  return it != d_backoff.end() && d_round < it->second.d_skipUntil;
+}
+
+void QuantConflictFind::updateBackoff(Node q, bool exhausted, bool productive)
+{
+  if (productive)
+  {
+    d_backoff.erase(q);
+    return;
+  }
+  if (!exhausted)
+  {
+    return;
+  }
+  // skip q for 2^k - 1 rounds after the k^th consecutive round in which it
+  // exceeded the match limit, where k is at most 10
+  Backoff& b = d_backoff[q];
+  b.d_unproductive = std::min<uint32_t>(b.d_unproductive + 1, 10);
+  b.d_skipUntil = d_round + (uint64_t(1) << b.d_unproductive);
+  Trace("qcf-check") << "Back-off " << q << " until round " << b.d_skipUntil
+                     << std::endl;
+}
+
+void QuantConflictFind::getFailedMatchKey(QuantInfo* qi,
+                                          std::vector<Node>& key)
+{
+  for (TNode m : qi->d_match)
+  {
+    key.push_back(m.isNull() ? Node::null() : Node(getRepresentative(m)));
+  }
+}
+
 //-------------------------------------------------- debugging
 
 void QuantConflictFind::debugPrint( const char * c ) {
@@ -2272,15 +2363,33 @@ void QuantConflictFind::debugPrintQuantBody( const char * c, Node q, Node n, boo
 
 QuantConflictFind::Statistics::Statistics():
   d_inst_rounds("QuantConflictFind::Inst_Rounds", 0),
-  d_entailment_checks("QuantConflictFind::Entailment_Checks",0)
+  d_entailment_checks("QuantConflictFind::Entailment_Checks",0),
+  d_matches("QuantConflictFind::Matches", 0),
+  d_matchLimitExceeded("QuantConflictFind::Match_Limit_Exceeded", 0),
+  d_skipped("QuantConflictFind::Skipped_By_Backoff", 0),
+  d_failedCacheHits("QuantConflictFind::Failed_Match_Cache_Hits", 0),
+  d_matchesPerQuant("QuantConflictFind::Matches_Per_Quant"),
+  d_instancesPerQuant("QuantConflictFind::Instances_Per_Quant")
 {
   smtStatisticsRegistry()->registerStat(&d_inst_rounds);
   smtStatisticsRegistry()->registerStat(&d_entailment_checks);
+  smtStatisticsRegistry()->registerStat(&d_matches);
+  smtStatisticsRegistry()->registerStat(&d_matchLimitExceeded);
+  smtStatisticsRegistry()->registerStat(&d_skipped);
+  smtStatisticsRegistry()->registerStat(&d_failedCacheHits);
+  smtStatisticsRegistry()->registerStat(&d_matchesPerQuant);
+  smtStatisticsRegistry()->registerStat(&d_instancesPerQuant);
 }
 
 QuantConflictFind::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_inst_rounds);
   smtStatisticsRegistry()->unregisterStat(&d_entailment_checks);
+  smtStatisticsRegistry()->unregisterStat(&d_matches);
+  smtStatisticsRegistry()->unregisterStat(&d_matchLimitExceeded);
+  smtStatisticsRegistry()->unregisterStat(&d_skipped);
+  smtStatisticsRegistry()->unregisterStat(&d_failedCacheHits);
+  smtStatisticsRegistry()->unregisterStat(&d_matchesPerQuant);
+  smtStatisticsRegistry()->unregisterStat(&d_instancesPerQuant);
 }
 
 TNode QuantConflictFind::getZero( Kind k ) {
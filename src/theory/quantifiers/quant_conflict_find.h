@@ -17,13 +17,16 @@
 #ifndef QUANT_CONFLICT_FIND
 #define QUANT_CONFLICT_FIND
 
+#include <map>
 #include <ostream>
+#include <set>
 #include <vector>
 
 #include "context/cdhashmap.h"
 #include "context/cdlist.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_module.h"
+#include "util/stats_histogram.h"
 
 namespace cvc5 {
 namespace theory {
@@ -271,6 +274,43 @@ private:  //for equivalence classes
    * this method when applicable.
    */
   void checkQuantifiedFormula(Node q, bool& isConflict, unsigned& addedLemmas);
+  /**
+   * Is the quantified formula q skipped in this round, because it exceeded
+   * the match limit (see --qcf-match-limit) in previous rounds without
+   * producing an instance?
+   */
+  bool isSkipped(Node q) const;
+  /**
+   * Update the back-off of q after checking it, where exhausted is whether
+   * it exceeded the match limit and productive is whether it produced an
+   * instance.
+   */
+  void updateBackoff(Node q, bool exhausted, bool productive);
+  /** Get the key of the current match of qi in the cache of failed matches */
+  void getFailedMatchKey(QuantInfo* qi, std::vector<Node>& key);
+  /** The back-off information of a quantified formula */
+  struct Backoff
+  {
+    Backoff() : d_unproductive(0), d_skipUntil(0) {}
+    /** The number of consecutive rounds that exceeded the match limit */
+    uint32_t d_unproductive;
+    /** The quantified formula is skipped until this round */
+    uint64_t d_skipUntil;
+  };
+  /** The back-off information of the quantified formulas */
+  std::map<Node, Backoff> d_backoff;
+  /** The number of rounds */
+  uint64_t d_round;
+  /**
+   * The matches (by the representatives of their values) that failed to
+   * complete or were T-inconsistent, per quantified formula and effort,
+   * which is valid for the state version d_failedVersion of the term
+   * database (see --qcf-fail-cache).
+   */
+  std::map<std::pair<Node, Effort>, std::set<std::vector<Node>>>
+      d_failedMatches;
+  /** The state version of the term database for d_failedMatches */
+  uint64_t d_failedVersion;
 
  private:
   void debugPrint( const char * c );
@@ -285,6 +325,18 @@ public:
   public:
     IntStat d_inst_rounds;
     IntStat d_entailment_checks;
+    /** The number of matches tried */
+    IntStat d_matches;
+    /** The number of times a quantified formula exceeded the match limit */
+    IntStat d_matchLimitExceeded;
+    /** The number of times a quantified formula was skipped by back-off */
+    IntStat d_skipped;
+    /** The number of matches that were skipped by the cache of failures */
+    IntStat d_failedCacheHits;
+    /** The matches tried, by quantified formula (see debugPrintQuant) */
+    IntegralHistogramStat<int> d_matchesPerQuant;
+    /** The instances produced, by quantified formula */
+    IntegralHistogramStat<int> d_instancesPerQuant;
     Statistics();
     ~Statistics();
   };
@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file quant_profile.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the statistic profiling the instances of each
+ ** quantified formula
+ **/
+
+#include "theory/quantifiers/quant_profile.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "util/safe_print.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+QuantProfile::QuantProfile(const std::string& name) : Stat(name) {}
+
+QuantProfile::Entry& QuantProfile::getEntry(Node q, Node name)
+{
+  std::map<Node, size_t>::iterator it = d_index.find(q);
+  if (it != d_index.end())
+  {
+    return d_entries[it->second];
+  }
+  d_index[q] = d_entries.size();
+  d_entries.emplace_back();
+  std::stringstream ss;
+  ss << name;
+  d_entries.back().d_name = ss.str();
+  return d_entries.back();
+}
+
+void QuantProfile::notifyInstance(Node q,
+                                  Node name,
+                                  InferenceId id,
+                                  bool added)
+{
+  if (!CVC4_USE_STATISTICS)
+  {
+    return;
+  }
+  Entry& e = getEntry(q, name);
+  if (id >= InferenceId::QUANTIFIERS_INST_E_MATCHING
+      && id <= InferenceId::QUANTIFIERS_INST_E_MATCHING_VAR_GEN)
+  {
+    e.d_matches++;
+  }
+  if (!added)
+  {
+    e.d_redundant++;
+    return;
+  }
+  e.d_instances++;
+  if (id == InferenceId::QUANTIFIERS_INST_CBQI_CONFLICT)
+  {
+    e.d_conflict++;
+  }
+}
+
+void QuantProfile::notifyRelevant(Node q, Node name, size_t num)
+{
+  if (CVC4_USE_STATISTICS)
+  {
+    getEntry(q, name).d_relevant += num;
+  }
+}
+
+void QuantProfile::flushInformation(std::ostream& out) const
+{
+  std::vector<size_t> order(d_entries.size());
+  for (size_t i = 0, size = order.size(); i < size; i++)
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [this](size_t i, size_t j) {
+    return d_entries[i].d_instances > d_entries[j].d_instances;
+  });
+  out << "[";
+  for (size_t i = 0, size = order.size(); i < size; i++)
+  {
+    const Entry& e = d_entries[order[i]];
+    out << (i > 0 ? ", " : "") << "(" << e.d_name << " : instances "
+        << e.d_instances << ", redundant " << e.d_redundant << ", matches "
+        << e.d_matches << ", conflict " << e.d_conflict << ", relevant "
+        << e.d_relevant << ")";
+  }
+  out << "]";
+}
+
+void QuantProfile::safeFlushInformation(int fd) const
+{
+  // the entries are not sorted, which would allocate
+  safe_print(fd, "[");
+  for (size_t i = 0, size = d_entries.size(); i < size; i++)
+  {
+    const Entry& e = d_entries[i];
+    if (i > 0)
+    {
+      safe_print(fd, ", ");
+    }
+    safe_print(fd, "(");
+    safe_print(fd, e.d_name);
+    safe_print(fd, " : instances ");
+    safe_print<uint64_t>(fd, e.d_instances);
+    safe_print(fd, ", redundant ");
+    safe_print<uint64_t>(fd, e.d_redundant);
+    safe_print(fd, ", matches ");
+    safe_print<uint64_t>(fd, e.d_matches);
+    safe_print(fd, ", conflict ");
+    safe_print<uint64_t>(fd, e.d_conflict);
+    safe_print(fd, ", relevant ");
+    safe_print<uint64_t>(fd, e.d_relevant);
+    safe_print(fd, ")");
+  }
+  safe_print(fd, "]");
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
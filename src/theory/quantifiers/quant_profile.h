@@ -0,0 +1,82 @@
+/*********************                                                        */
+/*! \file quant_profile.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A statistic profiling the instances of each quantified formula
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__QUANT_PROFILE_H
+#define CVC4__THEORY__QUANTIFIERS__QUANT_PROFILE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "theory/inference_id.h"
+#include "util/stats_base.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/** QuantProfile
+ *
+ * This statistic is enabled by the option --quant-profile. For each quantified
+ * formula that was instantiated, it records:
+ * - the number of instances that were added,
+ * - the number of redundant instances, which were rejected for being entailed
+ *   or duplicate,
+ * - the number of instances attempted by matching a trigger,
+ * - the number of instances added by conflict-based instantiation,
+ * - the number of instances occurring in the proof of an unsatisfiable
+ *   result, if proofs are enabled.
+ * The quantified formulas are printed by their names (:qid) if they have one,
+ * by decreasing number of instances. Matching loops show up as quantified
+ * formulas with many instances, none of which are used.
+ */
+class QuantProfile : public Stat
+{
+ public:
+  QuantProfile(const std::string& name);
+  /** Notify that an instance of q with identifier id was tried */
+  void notifyInstance(Node q, Node name, InferenceId id, bool added);
+  /** Notify that num instances of q occur in the proof of unsatisfiability */
+  void notifyRelevant(Node q, Node name, size_t num);
+
+  void flushInformation(std::ostream& out) const override;
+  void safeFlushInformation(int fd) const override;
+
+ private:
+  /** The counters of a quantified formula */
+  struct Entry
+  {
+    std::string d_name;
+    uint64_t d_instances = 0;
+    uint64_t d_redundant = 0;
+    uint64_t d_matches = 0;
+    uint64_t d_conflict = 0;
+    uint64_t d_relevant = 0;
+  };
+  /** Get the entry of q, whose printed name is name */
+  Entry& getEntry(Node q, Node name);
+  /** Map from quantified formulas to their index in d_entries */
+  std::map<Node, size_t> d_index;
+  /** The entries, in the order the quantified formulas were instantiated */
+  std::vector<Entry> d_entries;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__QUANT_PROFILE_H */
@@ -47,6 +47,7 @@ Skolemize* QuantifiersInferenceManager::getSkolemize()
 
 void QuantifiersInferenceManager::doPending()
 {
+  d_instantiate->notifyFlushLemmas();
   doPendingLemmas();
   doPendingPhaseRequirements();
 }
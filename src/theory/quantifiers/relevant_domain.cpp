@@ -14,6 +14,7 @@
 
 #include "theory/quantifiers/relevant_domain.h"
 
+#include "options/quantifiers_options.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers/quantifiers_registry.h"
@@ -28,19 +29,28 @@ namespace cvc5 {
 namespace theory {
 namespace quantifiers {
 
-void RelevantDomain::RDomain::merge( RDomain * r ) {
+void RelevantDomain::RDomain::merge(RDomain* r, uint64_t rd)
+{
   Assert(!d_parent);
   Assert(!r->d_parent);
   d_parent = r;
   for( unsigned i=0; i<d_terms.size(); i++ ){
-    r->addTerm( d_terms[i] );
+    r->addTerm(d_terms[i], rd);
   }
   d_terms.clear();
+  d_termSet.clear();
+  d_numOldTerms = 0;
+  // the domain of r is now also the domain of the variables of this
+  r->d_lastUpdate = rd;
+  d_lastUpdate = rd;
 }
 
-void RelevantDomain::RDomain::addTerm( Node t ) {
-  if( std::find( d_terms.begin(), d_terms.end(), t )==d_terms.end() ){
+void RelevantDomain::RDomain::addTerm(Node t, uint64_t r)
+{
+  if (d_termSet.insert(t).second)
+  {
     d_terms.push_back( t );
+    d_lastUpdate = r;
   }
 }
 
@@ -56,28 +66,45 @@ RelevantDomain::RDomain * RelevantDomain::RDomain::getParent() {
 
 void RelevantDomain::RDomain::removeRedundantTerms(QuantifiersState& qs)
 {
-  std::map< Node, Node > rterms;
-  for( unsigned i=0; i<d_terms.size(); i++ ){
+  std::unordered_set<Node, NodeHashFunction> reps;
+  size_t nterms = 0;
+  size_t numOldTerms = 0;
+  for (size_t i = 0, size = d_terms.size(); i < size; i++)
+  {
     Node r = d_terms[i];
     if( !TermUtil::hasInstConstAttr( d_terms[i] ) ){
       r = qs.getRepresentative(d_terms[i]);
     }
-    if( rterms.find( r )==rterms.end() ){
-      rterms[r] = d_terms[i];
+    if (reps.insert(r).second)
+    {
+      d_terms[nterms++] = d_terms[i];
+      if (i < d_numOldTerms)
+      {
+        numOldTerms++;
+      }
+    }
+    else
+    {
+      d_termSet.erase(d_terms[i]);
     }
   }
-  d_terms.clear();
-  for( std::map< Node, Node >::iterator it = rterms.begin(); it != rterms.end(); ++it ){
-    d_terms.push_back( it->second );
-  }
+  d_terms.resize(nterms);
+  d_numOldTerms = numOldTerms;
 }
 
 RelevantDomain::RelevantDomain(QuantifiersState& qs,
                                QuantifiersRegistry& qr,
                                TermRegistry& tr)
-    : d_qs(qs), d_qreg(qr), d_treg(tr)
+    : d_qs(qs),
+      d_qreg(qr),
+      d_treg(tr),
+      d_is_computed(false),
+      d_round(0),
+      d_computedRound(qs.getSatContext(), 0),
+      d_fullRound(0),
+      d_numQuantProcessed(0),
+      d_numMerges(0)
 {
-  d_is_computed = false;
 }
 
 RelevantDomain::~RelevantDomain() {
@@ -93,6 +120,7 @@ RelevantDomain::~RelevantDomain() {
 RelevantDomain::RDomain * RelevantDomain::getRDomain( Node n, int i, bool getParent ) {
   if( d_rel_doms.find( n )==d_rel_doms.end() || d_rel_doms[n].find( i )==d_rel_doms[n].end() ){
     d_rel_doms[n][i] = new RDomain;
+    d_rel_doms[n][i]->reset(d_round);
     d_rn_map[d_rel_doms[n][i]] = n;
     d_ri_map[d_rel_doms[n][i]] = i;
   }
@@ -105,40 +133,90 @@ bool RelevantDomain::reset( Theory::Effort e ) {
 }
 
 void RelevantDomain::registerQuantifier(Node q) {}
+
+bool RelevantDomain::isUnchangedSince(Node q, uint64_t round)
+{
+  if (round < d_fullRound)
+  {
+    return false;
+  }
+  for (size_t i = 0, nvars = q[0].getNumChildren(); i < nvars; i++)
+  {
+    if (getRDomain(q, i)->getLastUpdate() > round)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 void RelevantDomain::compute(){
   if( !d_is_computed ){
     d_is_computed = true;
+    TermDb* db = d_treg.getTermDatabase();
+    // We update the domains of the previous round if the SAT context was not
+    // backtracked below it, hence the lists of quantified formulas and ground
+    // terms were only extended. If the term database is not
+    // context-dependent, its terms are cleared by presolve instead.
+    bool incremental = options::relDomIncremental() && options::termDbCd()
+                       && d_round > 0 && d_computedRound.get() == d_round;
+    d_round++;
     for( std::map< Node, std::map< int, RDomain * > >::iterator it = d_rel_doms.begin(); it != d_rel_doms.end(); ++it ){
       for( std::map< int, RDomain * >::iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2 ){
-        it2->second->reset();
+        if (incremental)
+        {
+          it2->second->startRound();
+        }
+        else
+        {
+          it2->second->reset(d_round);
+        }
       }
     }
+    if (!incremental)
+    {
+      d_fullRound = d_round;
+      d_numQuantProcessed = 0;
+      d_opProcessed.clear();
+    }
+    Trace("rel-dom-debug") << "compute relevant domain, incremental = "
+                           << incremental << std::endl;
     FirstOrderModel* fm = d_treg.getModel();
-    for( unsigned i=0; i<fm->getNumAssertedQuantifiers(); i++ ){
+    size_t nquant = fm->getNumAssertedQuantifiers();
+    for (size_t i = d_numQuantProcessed; i < nquant; i++)
+    {
       Node q = fm->getAssertedQuantifier( i );
       Node icf = d_qreg.getInstConstantBody(q);
       Trace("rel-dom-debug") << "compute relevant domain for " << icf << std::endl;
       computeRelevantDomain( q, icf, true, true );
     }
+    d_numQuantProcessed = nquant;
 
     Trace("rel-dom-debug") << "account for ground terms" << std::endl;
-    TermDb* db = d_treg.getTermDatabase();
     for (unsigned k = 0; k < db->getNumOperators(); k++)
     {
       Node op = db->getOperator(k);
-      unsigned sz = db->getNumGroundTerms( op );
-      for( unsigned i=0; i<sz; i++ ){
+      size_t& processed = d_opProcessed[op];
+      size_t sz = db->getNumGroundTerms(op);
+      for (size_t i = processed; i < sz; i++)
+      {
         Node n = db->getGroundTerm(op, i);
         //if it is a non-redundant term
         if( db->isTermActive( n ) ){
           for( unsigned j=0; j<n.getNumChildren(); j++ ){
             RDomain * rf = getRDomain( op, j );
-            rf->addTerm( n[j] );
+            rf->addTerm(n[j], d_round);
             Trace("rel-dom-debug") << "...add ground term " << n[j] << " to rel dom " << op << "[" << j << "]" << std::endl;
           }
         }
       }
+      processed = sz;
     }
+    // The terms may become redundant by merges, otherwise only the domains
+    // that were extended in this round may have redundant terms.
+    bool merged = !incremental || db->getNumMerges() != d_numMerges;
+    d_numMerges = db->getNumMerges();
+    d_computedRound = d_round;
     //print debug
     for( std::map< Node, std::map< int, RDomain * > >::iterator it = d_rel_doms.begin(); it != d_rel_doms.end(); ++it ){
       Trace("rel-dom") << "Relevant domain for " << it->first << " : " << std::endl;
@@ -147,7 +225,10 @@ void RelevantDomain::compute(){
         RDomain * r = it2->second;
         RDomain * rp = r->getParent();
         if( r==rp ){
-          r->removeRedundantTerms(d_qs);
+          if (merged || r->getLastUpdate() == d_round)
+          {
+            r->removeRedundantTerms(d_qs);
+          }
           for( unsigned i=0; i<r->d_terms.size(); i++ ){
             Trace("rel-dom") << r->d_terms[i] << " ";
           }
@@ -193,13 +274,13 @@ void RelevantDomain::computeRelevantDomain( Node q, Node n, bool hasPol, bool po
       RDomain * rd1 = d_rel_dom_lit[hasPol][pol][n].d_rd[0]->getParent();
       RDomain * rd2 = d_rel_dom_lit[hasPol][pol][n].d_rd[1]->getParent();
       if( rd1!=rd2 ){
-        rd1->merge( rd2 );
+        rd1->merge(rd2, d_round);
       }
     }else{
       if( d_rel_dom_lit[hasPol][pol][n].d_rd[0]!=NULL ){
         RDomain * rd = d_rel_dom_lit[hasPol][pol][n].d_rd[0]->getParent();
         for( unsigned i=0; i<d_rel_dom_lit[hasPol][pol][n].d_val.size(); i++ ){
-          rd->addTerm( d_rel_dom_lit[hasPol][pol][n].d_val[i] );
+          rd->addTerm(d_rel_dom_lit[hasPol][pol][n].d_val[i], d_round);
         }
       }
     }
@@ -218,12 +299,12 @@ void RelevantDomain::computeRelevantDomainOpCh( RDomain * rf, Node n ) {
                            << std::endl;
     RDomain * rq = getRDomain( q, id );
     if( rf!=rq ){
-      rq->merge( rf );
+      rq->merge(rf, d_round);
     }
   }else if( !TermUtil::hasInstConstAttr( n ) ){
     Trace("rel-dom-debug") << "...add ground term to rel dom " << n << std::endl;
     //term to add
-    rf->addTerm( n );
+    rf->addTerm(n, d_round);
   }
 }
 
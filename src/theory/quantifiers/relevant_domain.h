@@ -17,6 +17,9 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__RELEVANT_DOMAIN_H
 #define CVC4__THEORY__QUANTIFIERS__RELEVANT_DOMAIN_H
 
+#include <unordered_set>
+
+#include "context/cdo.h"
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers/quant_util.h"
 
@@ -40,6 +43,13 @@ class TermRegistry;
  * by getRDomain(...) calls. It is intended to be called
  * at full effort check, after we have initialized
  * the term database.
+ *
+ * If --rel-dom-inc is enabled and the SAT context was not backtracked
+ * below the level of the previous call to compute(), the relevant domains
+ * of the previous call are updated only with the quantified formulas and
+ * ground terms added to the term database since then, which are found as
+ * the suffixes of their context-dependent lists. The terms added by the last
+ * call are given by RDomain::beginNewTerms().
  */
 class RelevantDomain : public QuantifiersUtil
 {
@@ -69,34 +79,57 @@ class RelevantDomain : public QuantifiersUtil
   class RDomain
   {
   public:
-    RDomain() : d_parent( NULL ) {}
+    RDomain() : d_parent(NULL), d_numOldTerms(0), d_lastUpdate(0) {}
     /** the set of terms in this relevant domain */
     std::vector< Node > d_terms;
-    /** reset this object */
-    void reset()
+    /** reset this object in round r */
+    void reset(uint64_t r)
     {
       d_parent = NULL;
       d_terms.clear();
+      d_termSet.clear();
+      d_numOldTerms = 0;
+      d_lastUpdate = r;
     }
-    /** merge this with r
+    /**
+     * The terms that were added by the last call to compute, which follow
+     * the terms of the previous calls in d_terms.
+     */
+    std::vector<Node>::const_iterator beginNewTerms() const
+    {
+      return d_terms.begin() + d_numOldTerms;
+    }
+    /** the number of terms added by the last call to compute */
+    size_t getNumNewTerms() const { return d_terms.size() - d_numOldTerms; }
+    /** merge this with r in round rd
      * This sets d_parent of this to r and
      * copies the terms of this to r.
      */
-    void merge( RDomain * r );
-    /** add term to the relevant domain */
-    void addTerm( Node t );
+    void merge(RDomain* r, uint64_t rd);
+    /** add term to the relevant domain in round r */
+    void addTerm(Node t, uint64_t r);
     /** get the parent of this */
     RDomain * getParent();
     /** remove redundant terms for d_terms, removes
-     * duplicates modulo equality.
+     * duplicates modulo equality, keeping the order of the other terms.
      */
     void removeRedundantTerms(QuantifiersState& qs);
     /** is n in this relevant domain? */
-    bool hasTerm( Node n ) { return std::find( d_terms.begin(), d_terms.end(), n )!=d_terms.end(); }
+    bool hasTerm(Node n) { return d_termSet.find(n) != d_termSet.end(); }
+    /** the last round in which terms were added to this relevant domain */
+    uint64_t getLastUpdate() const { return d_lastUpdate; }
+    /** start a round, in which the current terms become old terms */
+    void startRound() { d_numOldTerms = d_terms.size(); }
 
    private:
     /** the parent of this relevant domain */
     RDomain* d_parent;
+    /** the terms of d_terms, for fast lookup */
+    std::unordered_set<Node, NodeHashFunction> d_termSet;
+    /** the number of terms of d_terms added before the last round */
+    size_t d_numOldTerms;
+    /** the last round in which terms were added */
+    uint64_t d_lastUpdate;
   };
   /** get the relevant domain
    *
@@ -107,6 +140,15 @@ class RelevantDomain : public QuantifiersUtil
    * which is computed as a union find (see RDomain::d_parent).
    */
   RDomain* getRDomain(Node n, int i, bool getParent = true);
+  /** get the number of the last call to compute */
+  uint64_t getRound() const { return d_round; }
+  /**
+   * Return true if the relevant domains of the variables of q did not change
+   * since the call to compute with number round, in the sense that they were
+   * neither reset nor extended. Then, the relevant domains of the variables of
+   * q are subsets of the ones in that round.
+   */
+  bool isUnchangedSince(Node q, uint64_t round);
 
  private:
   /** the relevant domains for each quantified formula and function,
@@ -129,6 +171,22 @@ class RelevantDomain : public QuantifiersUtil
   TermRegistry& d_treg;
   /** have we computed the relevant domain on this full effort check? */
   bool d_is_computed;
+  /** the number of calls to compute */
+  uint64_t d_round;
+  /**
+   * The number of the last call to compute in the current SAT context, which
+   * is different from d_round if the context was backtracked below the level
+   * of the last call to compute.
+   */
+  context::CDO<uint64_t> d_computedRound;
+  /** the number of the last call to compute that reset all domains */
+  uint64_t d_fullRound;
+  /** the number of asserted quantified formulas that were processed */
+  size_t d_numQuantProcessed;
+  /** the number of the ground terms of each operator that were processed */
+  std::map<Node, size_t> d_opProcessed;
+  /** the number of merges of the term database at the last call to compute */
+  uint64_t d_numMerges;
   /** relevant domain literal
    * Caches the effect of literals on the relevant domain.
    */
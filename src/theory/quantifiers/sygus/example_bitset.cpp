@@ -0,0 +1,154 @@
+/*********************                                                        */
+/*! \file example_bitset.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of dense sets of example indices
+ **/
+
+#include "theory/quantifiers/sygus/example_bitset.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+ExampleBitset::ExampleBitset(size_t size, bool full)
+    : d_size(size), d_words((size + 63) / 64, full ? ~uint64_t(0) : 0)
+{
+  if (full && size % 64 != 0)
+  {
+    d_words.back() = (uint64_t(1) << (size % 64)) - 1;
+  }
+}
+
+ExampleBitset ExampleBitset::mkTrueSet(const std::vector<Node>& vals)
+{
+  ExampleBitset s(vals.size(), false);
+  for (size_t i = 0, nvals = vals.size(); i < nvals; i++)
+  {
+    const Node& v = vals[i];
+    if (!v.isNull() && v.isConst() && v.getType().isBoolean()
+        && v.getConst<bool>())
+    {
+      s.set(i, true);
+    }
+  }
+  return s;
+}
+
+void ExampleBitset::set(size_t i, bool val)
+{
+  Assert(i < d_size);
+  uint64_t bit = uint64_t(1) << (i % 64);
+  if (val)
+  {
+    d_words[i / 64] |= bit;
+  }
+  else
+  {
+    d_words[i / 64] &= ~bit;
+  }
+}
+
+size_t ExampleBitset::count() const
+{
+  size_t c = 0;
+  for (uint64_t w : d_words)
+  {
+    c += __builtin_popcountll(w);
+  }
+  return c;
+}
+
+size_t ExampleBitset::countAnd(const ExampleBitset& s) const
+{
+  Assert(d_size == s.d_size);
+  size_t c = 0;
+  for (size_t i = 0, nwords = d_words.size(); i < nwords; i++)
+  {
+    c += __builtin_popcountll(d_words[i] & s.d_words[i]);
+  }
+  return c;
+}
+
+size_t ExampleBitset::countAnd(const ExampleBitset& s,
+                               bool pol,
+                               const ExampleBitset& t) const
+{
+  Assert(d_size == s.d_size && d_size == t.d_size);
+  // the bits of the complement of s beyond d_size are cleared by this set
+  uint64_t flip = pol ? 0 : ~uint64_t(0);
+  size_t c = 0;
+  for (size_t i = 0, nwords = d_words.size(); i < nwords; i++)
+  {
+    c += __builtin_popcountll(d_words[i] & (s.d_words[i] ^ flip)
+                              & t.d_words[i]);
+  }
+  return c;
+}
+
+bool ExampleBitset::isSubsetOf(const ExampleBitset& s) const
+{
+  Assert(d_size == s.d_size);
+  for (size_t i = 0, nwords = d_words.size(); i < nwords; i++)
+  {
+    if ((d_words[i] & ~s.d_words[i]) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ExampleBitset::empty() const
+{
+  for (uint64_t w : d_words)
+  {
+    if (w != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+ExampleBitset& ExampleBitset::operator&=(const ExampleBitset& s)
+{
+  Assert(d_size == s.d_size);
+  for (size_t i = 0, nwords = d_words.size(); i < nwords; i++)
+  {
+    d_words[i] &= s.d_words[i];
+  }
+  return *this;
+}
+
+ExampleBitset& ExampleBitset::operator|=(const ExampleBitset& s)
+{
+  Assert(d_size == s.d_size);
+  for (size_t i = 0, nwords = d_words.size(); i < nwords; i++)
+  {
+    d_words[i] |= s.d_words[i];
+  }
+  return *this;
+}
+
+size_t ExampleBitset::hash() const
+{
+  // FNV-1a over the words
+  uint64_t h = 14695981039346656037ULL;
+  for (uint64_t w : d_words)
+  {
+    h = (h ^ w) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(h ^ d_size);
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file example_bitset.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Dense sets of example indices
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__SYGUS__EXAMPLE_BITSET_H
+#define CVC4__THEORY__QUANTIFIERS__SYGUS__EXAMPLE_BITSET_H
+
+#include <cstdint>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/** ExampleBitset
+ *
+ * A set of indices of I/O examples, stored densely as a bitset of 64-bit
+ * words. This is used by SygusUnifIo for the examples that are active in
+ * the current context of the decision tree construction, for the examples
+ * on which a condition evaluates to true, and for the examples that are
+ * solved by a cached solution, so that intersecting them and counting their
+ * elements are word operations and popcounts.
+ */
+class ExampleBitset
+{
+ public:
+  ExampleBitset() : d_size(0) {}
+  /** Make the set of size indices, containing all of them if full is true */
+  ExampleBitset(size_t size, bool full);
+  /**
+   * Make the set of indices i such that vals[i] is the constant true, where
+   * vals is a vector of Boolean constants or null nodes.
+   */
+  static ExampleBitset mkTrueSet(const std::vector<Node>& vals);
+  /** Get the number of indices of the universe of this set */
+  size_t size() const { return d_size; }
+  /** Does this set contain index i? */
+  bool get(size_t i) const
+  {
+    return (d_words[i / 64] >> (i % 64)) & 1;
+  }
+  /** Add (resp. remove if val is false) index i to this set */
+  void set(size_t i, bool val);
+  /** Get the number of elements of this set */
+  size_t count() const;
+  /** Get the number of elements of the intersection of this set and s */
+  size_t countAnd(const ExampleBitset& s) const;
+  /**
+   * Get the number of elements of the intersection of this set, s and t if
+   * pol is true, or of this set, the complement of s and t if pol is false.
+   */
+  size_t countAnd(const ExampleBitset& s,
+                  bool pol,
+                  const ExampleBitset& t) const;
+  /** Is this set a subset of s? */
+  bool isSubsetOf(const ExampleBitset& s) const;
+  /** Is this set empty? */
+  bool empty() const;
+  /** intersect this set with s */
+  ExampleBitset& operator&=(const ExampleBitset& s);
+  /** union this set with s */
+  ExampleBitset& operator|=(const ExampleBitset& s);
+  bool operator==(const ExampleBitset& s) const
+  {
+    return d_size == s.d_size && d_words == s.d_words;
+  }
+  bool operator!=(const ExampleBitset& s) const { return !(*this == s); }
+  /** Get a hash of this set */
+  size_t hash() const;
+
+ private:
+  /** The number of indices of the universe */
+  size_t d_size;
+  /** The words, whose bits beyond d_size are zero */
+  std::vector<uint64_t> d_words;
+};
+
+/** Hash function for example bitsets */
+struct ExampleBitsetHashFunction
+{
+  size_t operator()(const ExampleBitset& s) const { return s.hash(); }
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__SYGUS__EXAMPLE_BITSET_H */
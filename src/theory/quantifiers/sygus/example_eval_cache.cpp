@@ -14,8 +14,10 @@
  **/
 #include "theory/quantifiers/sygus/example_eval_cache.h"
 
+#include "options/quantifiers_options.h"
 #include "theory/quantifiers/sygus/example_min_eval.h"
 #include "theory/quantifiers/sygus/synth_conjecture.h"
+#include "theory/quantifiers/sygus/sygus_vec_eval.h"
 
 using namespace cvc5;
 using namespace cvc5::kind;
@@ -52,8 +54,8 @@ Node ExampleEvalCache::addSearchVal(TypeNode tn, Node bv)
   }
   std::vector<Node> vals;
   evaluateVec(bv, vals, true);
-  Trace("sygus-pbe-debug") << "Add to trie..." << std::endl;
-  Node ret = d_trie[tn].addOrGetTerm(bv, vals);
+  Trace("sygus-pbe-debug") << "Add to index..." << std::endl;
+  Node ret = d_searchVals[tn].emplace(vals, bv).first->second;
   Trace("sygus-pbe-debug") << "...got " << ret << std::endl;
   // Only save the cache data if necessary: if the enumerated term
   // is redundant, its cached data will not be used later and thus should
@@ -91,9 +93,19 @@ void ExampleEvalCache::evaluateVec(Node bv,
 void ExampleEvalCache::evaluateVecInternal(Node bv,
                                            std::vector<Node>& exOut) const
 {
-  // use ExampleMinEval
   SygusTypeInfo& ti = d_tds->getTypeInfo(d_stn);
   const std::vector<Node>& varlist = ti.getVarList();
+  if (options::sygusEvalVec())
+  {
+    // evaluate on all examples at once if bv only has supported operators
+    SygusVecEvaluator sve;
+    if (sve.compile(bv, varlist) && sve.evaluate(d_examples, exOut))
+    {
+      return;
+    }
+    exOut.clear();
+  }
+  // use ExampleMinEval
   EmeEvalTds emetds(d_tds, d_stn);
   ExampleMinEval eme(bv, varlist, &emetds);
   for (size_t j = 0, esize = d_examples.size(); j < esize; j++)
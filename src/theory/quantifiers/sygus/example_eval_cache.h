@@ -17,7 +17,10 @@
 #ifndef CVC4__THEORY__QUANTIFIERS__EXAMPLE_EVAL_CACHE_H
 #define CVC4__THEORY__QUANTIFIERS__EXAMPLE_EVAL_CACHE_H
 
-#include "expr/node_trie.h"
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
 #include "theory/quantifiers/sygus/example_infer.h"
 
 namespace cvc5 {
@@ -27,14 +30,35 @@ namespace quantifiers {
 class SynthConjecture;
 class TermDbSygus;
 
+/**
+ * The hash of a vector of values, e.g. the evaluation of a term on a list of
+ * points, which are compared by the ids of their nodes.
+ */
+struct ValueVectorHashFunction
+{
+  size_t operator()(const std::vector<Node>& vals) const
+  {
+    uint64_t h = vals.size();
+    for (const Node& v : vals)
+    {
+      h = (h ^ v.getId()) * 0x100000001B3ULL;
+    }
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+};
+
+/** Map from vectors of values to the first term with these values */
+typedef std::unordered_map<std::vector<Node>, Node, ValueVectorHashFunction>
+    ValueVectorMap;
+
 /** ExampleEvalCache
  *
  * This class caches the evaluation of nodes on a fixed list of examples. It
  * serves two purposes:
  * (1) To maintain a cache of the results of evaluation of nodes so that
  * evaluation is not recomputed in different contexts, and
- * (2) To maintain a trie of terms indexed by their evaluation on the list
- * of examples to recognize when two terms are equivalent up to examples.
+ * (2) To maintain an index of terms by their evaluation on the list of
+ * examples to recognize when two terms are equivalent up to examples.
  *
  * This class is associated with a function to synthesize and an enumerator,
  * which determine which examples are taken from the conjecture and how
@@ -142,18 +166,19 @@ class ExampleEvalCache
    * of this class is variable agnostic.
    */
   bool d_indexSearchVals;
-  /** trie of search values
+  /** index of search values
    *
-   * This trie is an index of candidate solutions for PBE synthesis and their
-   * (concrete) evaluation on the set of input examples. For example, if the
-   * set of input examples for (x,y) is (0,1), (1,3), then:
+   * This is an index of candidate solutions for PBE synthesis by their
+   * (concrete) evaluation on the set of input examples, per sygus type. For
+   * example, if the set of input examples for (x,y) is (0,1), (1,3), then:
    *   term x is indexed by 0,1
    *   term x+y is indexed by 1,4
    *   term 0 is indexed by 0,0.
-   * This is used for symmetry breaking in quantifier-free reasoning
-   * about SyGuS datatypes.
+   * The lookup is a single hash of the vector of values, rather than one map
+   * lookup per example as in a trie. This is used for symmetry breaking in
+   * quantifier-free reasoning about SyGuS datatypes.
    */
-  std::map< TypeNode, NodeTrie> d_trie;
+  std::map<TypeNode, ValueVectorMap> d_searchVals;
   /** cache for evaluate */
   std::map<Node, std::vector<Node>> d_exOutCache;
 };
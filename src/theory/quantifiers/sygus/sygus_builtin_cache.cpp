@@ -0,0 +1,89 @@
+/*********************                                                        */
+/*! \file sygus_builtin_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the cache of the builtin terms of sygus
+ ** constructor applications
+ **/
+
+#include "theory/quantifiers/sygus/sygus_builtin_cache.h"
+
+#include "expr/dtype_cons.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/datatypes/sygus_datatype_utils.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+size_t SygusBuiltinCache::KeyHashFunction::operator()(
+    const std::vector<Node>& key) const
+{
+  size_t h = 0;
+  for (const Node& n : key)
+  {
+    h = h * 31 + n.getId();
+  }
+  return h;
+}
+
+SygusBuiltinCache::SygusBuiltinCache(size_t capacity) : d_capacity(capacity)
+{
+}
+
+SygusBuiltinCache::~SygusBuiltinCache() {}
+
+Node SygusBuiltinCache::mkSygusTerm(const DType& dt,
+                                    unsigned i,
+                                    const std::vector<Node>& children)
+{
+  d_key.clear();
+  d_key.push_back(dt[i].getConstructor());
+  d_key.insert(d_key.end(), children.begin(), children.end());
+  std::unordered_map<std::vector<Node>, Node, KeyHashFunction>::iterator it =
+      d_cache.find(d_key);
+  if (it != d_cache.end())
+  {
+    ++(d_statistics.d_hits);
+    return it->second;
+  }
+  ++(d_statistics.d_misses);
+  Node ret = datatypes::utils::mkSygusTerm(dt, i, children);
+  if (d_cache.size() >= d_capacity)
+  {
+    Trace("sygus-builtin-cache")
+        << "Clear builtin cache of size " << d_cache.size() << std::endl;
+    ++(d_statistics.d_clears);
+    d_cache.clear();
+  }
+  d_cache.emplace(d_key, ret);
+  return ret;
+}
+
+SygusBuiltinCache::Statistics::Statistics()
+    : d_hits("SygusBuiltinCache::hits", 0),
+      d_misses("SygusBuiltinCache::misses", 0),
+      d_clears("SygusBuiltinCache::clears", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_hits);
+  smtStatisticsRegistry()->registerStat(&d_misses);
+  smtStatisticsRegistry()->registerStat(&d_clears);
+}
+
+SygusBuiltinCache::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_hits);
+  smtStatisticsRegistry()->unregisterStat(&d_misses);
+  smtStatisticsRegistry()->unregisterStat(&d_clears);
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file sygus_builtin_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Cache of the builtin terms of sygus constructor applications
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_BUILTIN_CACHE_H
+#define CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_BUILTIN_CACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/dtype.h"
+#include "expr/node.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/** SygusBuiltinCache
+ *
+ * This class caches the builtin term of the application of the i^th
+ * constructor of a sygus datatype to a list of builtin arguments, that is,
+ * the result of datatypes::utils::mkSygusTerm, which involves the beta
+ * reduction of the sygus operator if it is a lambda.
+ *
+ * The cache is keyed by the constructor and the builtin arguments, so it is
+ * shared by all sygus terms that have the same builtin children, including
+ * the terms with free variables constructed by the explanation and
+ * unfolding utilities, and it survives the garbage collection of the sygus
+ * terms themselves, whose attribute caches are lost with them. It is owned
+ * by TermDbSygus and hence shared by all of its clients.
+ *
+ * Since the cache keeps its entries alive, its size is bounded: when it
+ * exceeds its capacity it is cleared.
+ */
+class SygusBuiltinCache
+{
+ public:
+  /** Make a cache of at most capacity entries */
+  SygusBuiltinCache(size_t capacity);
+  ~SygusBuiltinCache();
+  /**
+   * Get the builtin term of the application of the i^th constructor of dt to
+   * children, which are builtin terms.
+   */
+  Node mkSygusTerm(const DType& dt,
+                   unsigned i,
+                   const std::vector<Node>& children);
+
+ private:
+  /** Hash function for the keys of the cache */
+  struct KeyHashFunction
+  {
+    size_t operator()(const std::vector<Node>& key) const;
+  };
+  /** The capacity */
+  size_t d_capacity;
+  /**
+   * Maps lists consisting of a sygus constructor followed by builtin
+   * arguments to the builtin term of the application.
+   */
+  std::unordered_map<std::vector<Node>, Node, KeyHashFunction> d_cache;
+  /** The key used for lookups, which avoids allocating one per lookup */
+  std::vector<Node> d_key;
+  /** statistics class */
+  class Statistics
+  {
+   public:
+    IntStat d_hits;
+    IntStat d_misses;
+    IntStat d_clears;
+    Statistics();
+    ~Statistics();
+  };
+  /** statistics */
+  Statistics d_statistics;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_BUILTIN_CACHE_H */
@@ -33,11 +33,15 @@ namespace quantifiers {
 SygusEnumerator::SygusEnumerator(TermDbSygus* tds,
                                  SynthConjecture* p,
                                  SygusStatistics& s,
-                                 bool enumShapes)
+                                 bool enumShapes,
+                                 bool sharded)
     : d_tds(tds),
       d_parent(p),
       d_stats(s),
       d_enumShapes(enumShapes),
+      d_numShards(sharded ? options::sygusEnumShards() : 1),
+      d_shard(sharded ? options::sygusEnumShard() : 0),
+      d_numValues(0),
       d_tlEnum(nullptr),
       d_abortSize(-1)
 {
@@ -144,6 +148,14 @@ Node SygusEnumerator::getCurrent()
       ret = Node::null();
     }
   }
+  if (!ret.isNull() && d_numShards > 1)
+  {
+    // the shards are disjoint since all shards enumerate the same stream
+    if (d_numValues++ % d_numShards != d_shard)
+    {
+      ret = Node::null();
+    }
+  }
   if (Trace.isOn("sygus-enum"))
   {
     Trace("sygus-enum") << "Enumerate : ";
@@ -162,7 +174,8 @@ SygusEnumerator::TermCache::TermCache()
       d_numConClasses(0),
       d_sizeEnum(0),
       d_isComplete(false),
-      d_sampleRrVInit(false)
+      d_sampleRrVInit(false),
+      d_sampleEqInit(false)
 {
 }
 
@@ -371,6 +384,37 @@ bool SygusEnumerator::TermCache::addTerm(Node n)
         }
       }
     }
+    else if (options::sygusEnumSampleEquiv() > 0
+             && !d_tds->isVariableAgnosticEnumerator(d_enum))
+    {
+      if (!d_sampleEqInit)
+      {
+        d_sampleEqInit = true;
+        d_samplerEq.initializeSygus(
+            d_tds, d_enum, options::sygusEnumSampleEquiv(), false);
+      }
+      unsigned npts = d_samplerEq.getNumSamplePoints();
+      if (npts > 0)
+      {
+        ++(d_stats->d_enumTermsSampleEval);
+        // Is it equivalent on the sample points? Unlike examples, the sample
+        // points do not determine the specification, hence this is
+        // incomplete.
+        std::vector<Node> vals;
+        for (unsigned i = 0; i < npts; i++)
+        {
+          vals.push_back(d_samplerEq.evaluate(bnr, i));
+        }
+        Node bne = d_sampleVals.emplace(vals, bnr).first->second;
+        if (bnr != bne)
+        {
+          Trace("sygus-enum-exc")
+              << "Exclude (by samples): " << bn << ", since we already have "
+              << bne << std::endl;
+          return false;
+        }
+      }
+    }
     Trace("sygus-enum-terms") << "tc(" << d_tn << "): term " << bn << std::endl;
   }
   ++(d_stats->d_enumTerms);
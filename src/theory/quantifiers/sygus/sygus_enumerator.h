@@ -55,10 +55,17 @@ class SygusPbe;
 class SygusEnumerator : public EnumValGenerator
 {
  public:
+  /**
+   * If sharded is true, this enumerator only generates the values of the
+   * shard given by --sygus-enum-shard, where the i^th value generated by the
+   * enumerator is in shard i modulo --sygus-enum-shards. The values of the
+   * other shards are generated as null.
+   */
   SygusEnumerator(TermDbSygus* tds,
                   SynthConjecture* p,
                   SygusStatistics& s,
-                  bool enumShapes = false);
+                  bool enumShapes = false,
+                  bool sharded = false);
   ~SygusEnumerator() {}
   /** initialize this class with enumerator e */
   void initialize(Node e) override;
@@ -80,6 +87,12 @@ class SygusEnumerator : public EnumValGenerator
   SygusStatistics& d_stats;
   /** Whether we are enumerating shapes */
   bool d_enumShapes;
+  /** The number of shards, which is one if this enumerator is not sharded */
+  unsigned d_numShards;
+  /** The shard of this enumerator */
+  unsigned d_shard;
+  /** The number of non-null values generated so far */
+  uint64_t d_numValues;
   /** Term cache
    *
    * This stores a list of terms for a given sygus type. The key features of
@@ -217,6 +230,12 @@ class SygusEnumerator : public EnumValGenerator
     quantifiers::SygusSampler d_samplerRrV;
     /** is the above sampler initialized? */
     bool d_sampleRrVInit;
+    /** sampler (for --sygus-enum-sample-equiv) */
+    quantifiers::SygusSampler d_samplerEq;
+    /** is the above sampler initialized? */
+    bool d_sampleEqInit;
+    /** the terms of this cache indexed by their values on d_samplerEq */
+    ValueVectorMap d_sampleVals;
   };
   /** above cache for each sygus type */
   std::map<TypeNode, TermCache> d_tcache;
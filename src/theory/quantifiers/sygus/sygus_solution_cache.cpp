@@ -0,0 +1,246 @@
+/*********************                                                        */
+/*! \file sygus_solution_cache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the persistent cache of solutions of synthesis
+ ** conjectures
+ **/
+
+#include "theory/quantifiers/sygus/sygus_solution_cache.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+#include "expr/dtype.h"
+#include "expr/dtype_cons.h"
+#include "expr/term_canonize.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+SygusSolutionCache::SygusSolutionCache(const std::string& file) : d_file(file)
+{
+  std::ifstream in(d_file);
+  std::string line;
+  while (std::getline(in, line))
+  {
+    size_t pos = line.find(' ');
+    if (pos != std::string::npos)
+    {
+      // later entries for the same key take precedence
+      d_sols[line.substr(0, pos)] = line.substr(pos + 1);
+    }
+  }
+  Trace("sygus-sol-cache") << "Read " << d_sols.size() << " solutions from "
+                           << d_file << std::endl;
+}
+
+std::string SygusSolutionCache::computeKey(Node q)
+{
+  Assert(q.getKind() == FORALL);
+  std::stringstream ss;
+  expr::TermCanonize tcanon;
+  ss << tcanon.getCanonicalTerm(q, true);
+  // the grammars of the functions to synthesize
+  std::unordered_set<TypeNode, TypeNodeHashFunction> visited;
+  std::vector<TypeNode> visit;
+  for (const Node& f : q[0])
+  {
+    visit.push_back(f.getType());
+  }
+  for (size_t i = 0; i < visit.size(); i++)
+  {
+    TypeNode tn = visit[i];
+    if (!visited.insert(tn).second)
+    {
+      continue;
+    }
+    ss << " " << tn;
+    if (!tn.isDatatype() || !tn.getDType().isSygus())
+    {
+      continue;
+    }
+    const DType& dt = tn.getDType();
+    ss << " (" << dt.getSygusType();
+    for (size_t j = 0, ncons = dt.getNumConstructors(); j < ncons; j++)
+    {
+      const DTypeConstructor& c = dt[j];
+      ss << " (" << c.getSygusOp();
+      for (size_t k = 0, nargs = c.getNumArgs(); k < nargs; k++)
+      {
+        TypeNode atn = c.getArgType(k);
+        ss << " " << atn;
+        visit.push_back(atn);
+      }
+      ss << ")";
+    }
+    ss << ")";
+  }
+  // FNV-1a hash of the above
+  std::string str = ss.str();
+  uint64_t h = 0xCBF29CE484222325ULL;
+  for (char c : str)
+  {
+    h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+  }
+  std::stringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << h;
+  Trace("sygus-sol-cache") << "Key of " << q << " is " << key.str()
+                           << std::endl;
+  return key.str();
+}
+
+bool SygusSolutionCache::lookup(const std::string& key,
+                                const std::vector<TypeNode>& types,
+                                std::vector<Node>& sols) const
+{
+  std::unordered_map<std::string, std::string>::const_iterator it =
+      d_sols.find(key);
+  if (it == d_sols.end())
+  {
+    return false;
+  }
+  std::stringstream is(it->second);
+  for (const TypeNode& tn : types)
+  {
+    Node v = read(is, tn);
+    if (v.isNull())
+    {
+      Trace("sygus-sol-cache") << "...malformed solution for " << key
+                               << std::endl;
+      sols.clear();
+      return false;
+    }
+    sols.push_back(v);
+  }
+  return true;
+}
+
+void SygusSolutionCache::store(const std::string& key,
+                               const std::vector<Node>& sols)
+{
+  std::stringstream ss;
+  for (const Node& s : sols)
+  {
+    if (!write(s, ss))
+    {
+      Trace("sygus-sol-cache") << "...cannot store " << s << std::endl;
+      return;
+    }
+  }
+  std::string str = ss.str();
+  std::unordered_map<std::string, std::string>::iterator it = d_sols.find(key);
+  if (it != d_sols.end() && it->second == str)
+  {
+    return;
+  }
+  d_sols[key] = str;
+  std::ofstream out(d_file, std::ios::app);
+  out << key << " " << str << std::endl;
+}
+
+bool SygusSolutionCache::write(Node v, std::ostream& os)
+{
+  if (v.getKind() == APPLY_CONSTRUCTOR)
+  {
+    os << " ( " << DType::indexOf(v.getOperator());
+    for (const Node& vc : v)
+    {
+      if (!write(vc, os))
+      {
+        return false;
+      }
+    }
+    os << " )";
+    return true;
+  }
+  // the builtin arguments of constructors for any constant
+  switch (v.getKind())
+  {
+    case CONST_BOOLEAN: os << " " << (v.getConst<bool>() ? 1 : 0); break;
+    case CONST_RATIONAL: os << " " << v.getConst<Rational>(); break;
+    case CONST_BITVECTOR:
+      os << " " << v.getConst<BitVector>().getValue();
+      break;
+    default: return false;
+  }
+  return true;
+}
+
+Node SygusSolutionCache::read(std::istream& is, TypeNode tn)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::string tok;
+  if (!(is >> tok))
+  {
+    return Node::null();
+  }
+  if (tn.isDatatype())
+  {
+    const DType& dt = tn.getDType();
+    size_t index;
+    if (tok != "(" || !(is >> index) || index >= dt.getNumConstructors())
+    {
+      return Node::null();
+    }
+    const DTypeConstructor& c = dt[index];
+    std::vector<Node> children;
+    children.push_back(c.getConstructor());
+    for (size_t k = 0, nargs = c.getNumArgs(); k < nargs; k++)
+    {
+      Node vc = read(is, c.getArgType(k));
+      if (vc.isNull())
+      {
+        return Node::null();
+      }
+      children.push_back(vc);
+    }
+    if (!(is >> tok) || tok != ")")
+    {
+      return Node::null();
+    }
+    return nm->mkNode(APPLY_CONSTRUCTOR, children);
+  }
+  // only rationals may have a sign or a denominator
+  if (tok.find_first_not_of(tn.isReal() ? "-/0123456789" : "0123456789")
+      != std::string::npos)
+  {
+    return Node::null();
+  }
+  if (tn.isBoolean())
+  {
+    return nm->mkConst(tok == "1");
+  }
+  if (tn.isBitVector())
+  {
+    return nm->mkConst(BitVector(tn.getBitVectorSize(), Integer(tok)));
+  }
+  if (tn.isReal())
+  {
+    Rational r(tok);
+    if (tn.isInteger() && !r.isIntegral())
+    {
+      return Node::null();
+    }
+    return nm->mkConst(r);
+  }
+  return Node::null();
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
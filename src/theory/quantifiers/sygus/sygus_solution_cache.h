@@ -0,0 +1,83 @@
+/*********************                                                        */
+/*! \file sygus_solution_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A persistent cache of solutions of synthesis conjectures
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__SYGUS_SOLUTION_CACHE_H
+#define CVC4__THEORY__QUANTIFIERS__SYGUS_SOLUTION_CACHE_H
+
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/** SygusSolutionCache
+ *
+ * This class stores the solutions of synthesis conjectures in a file, which
+ * is used if the option --sygus-solution-cache=FILE is set, so that solving
+ * a conjecture that was already solved, possibly in another run and up to
+ * the renaming of its bound variables, starts from its previous solution.
+ *
+ * The key of a conjecture is a hash of its canonical form (see TermCanonize)
+ * and of the grammars of its functions to synthesize. A solution is stored
+ * as the constructor indices of the values of the sygus datatypes of these
+ * grammars, which can be rebuilt without parsing since the grammars are part
+ * of the key. Since keys are hashes, a solution found in this cache is only
+ * a candidate, which must be verified against the current conjecture.
+ *
+ * Each line of the file is a key followed by a solution. The file is read
+ * when this class is constructed and new solutions are appended to it.
+ */
+class SygusSolutionCache
+{
+ public:
+  SygusSolutionCache(const std::string& file);
+  /**
+   * Get the key of the (embedded) synthesis conjecture q, whose bound
+   * variables are the functions to synthesize, of sygus datatype types.
+   */
+  static std::string computeKey(Node q);
+  /**
+   * Get the solution stored for key, whose values are of the sygus datatype
+   * types in types. Returns false if there is no such solution, or if it
+   * does not conform to types.
+   */
+  bool lookup(const std::string& key,
+              const std::vector<TypeNode>& types,
+              std::vector<Node>& sols) const;
+  /** Store the solution sols for key */
+  void store(const std::string& key, const std::vector<Node>& sols);
+
+ private:
+  /** Write value v to os, returns false if it is not supported */
+  static bool write(Node v, std::ostream& os);
+  /** Read a value of type tn from is, returns null if it is malformed */
+  static Node read(std::istream& is, TypeNode tn);
+  /** The file of this cache */
+  std::string d_file;
+  /** Map from keys to the (written) solutions for them */
+  std::unordered_map<std::string, std::string> d_sols;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__SYGUS_SOLUTION_CACHE_H */
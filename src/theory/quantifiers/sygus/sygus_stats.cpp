@@ -31,6 +31,7 @@ SygusStatistics::SygusStatistics()
                                  0),
       d_enumTermsRewrite("SygusEnumerator::enumTermsRewrite", 0),
       d_enumTermsExampleEval("SygusEnumerator::enumTermsEvalExamples", 0),
+      d_enumTermsSampleEval("SygusEnumerator::enumTermsEvalSamples", 0),
       d_enumTerms("SygusEnumerator::enumTerms", 0)
 
 {
@@ -42,6 +43,7 @@ SygusStatistics::SygusStatistics()
   smtStatisticsRegistry()->registerStat(&d_candidate_rewrites_print);
   smtStatisticsRegistry()->registerStat(&d_enumTermsRewrite);
   smtStatisticsRegistry()->registerStat(&d_enumTermsExampleEval);
+  smtStatisticsRegistry()->registerStat(&d_enumTermsSampleEval);
   smtStatisticsRegistry()->registerStat(&d_enumTerms);
 }
 
@@ -55,6 +57,7 @@ SygusStatistics::~SygusStatistics()
   smtStatisticsRegistry()->unregisterStat(&d_candidate_rewrites_print);
   smtStatisticsRegistry()->unregisterStat(&d_enumTermsRewrite);
   smtStatisticsRegistry()->unregisterStat(&d_enumTermsExampleEval);
+  smtStatisticsRegistry()->unregisterStat(&d_enumTermsSampleEval);
   smtStatisticsRegistry()->unregisterStat(&d_enumTerms);
 }
 
@@ -47,6 +47,8 @@ class SygusStatistics
   IntStat d_enumTermsRewrite;
   /** Number of terms checked for example-based symmetry in fast enumerators */
   IntStat d_enumTermsExampleEval;
+  /** Number of terms checked for sample-based symmetry in fast enumerators */
+  IntStat d_enumTermsSampleEval;
   /** Number of non-redundant terms generated by fast enumerators */
   IntStat d_enumTerms;
 };
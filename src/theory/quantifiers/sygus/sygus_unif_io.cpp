@@ -25,6 +25,7 @@
 #include "util/random.h"
 
 #include <math.h>
+#include <algorithm>
 
 using namespace cvc5::kind;
 
@@ -61,6 +62,7 @@ bool UnifContextIo::updateContext(SygusUnifIo* sui,
       if (d_vals[i] == d_true)
       {
         d_vals[i] = d_false;
+        d_active.set(i, false);
         changed = true;
       }
     }
@@ -108,6 +110,7 @@ void UnifContextIo::initialize(SygusUnifIo* sui)
   {
     d_vals.push_back(d_true);
   }
+  d_active = ExampleBitset(sz, true);
 
   if (!sui->d_examples_out.empty())
   {
@@ -532,6 +535,8 @@ void SygusUnifIo::initializeCandidate(
   ExampleInfer* ei = d_parent->getExampleInfer();
   d_examples.clear();
   d_examples_out.clear();
+  d_examples_out_classes.clear();
+  d_examples_out_class.clear();
   // copy the examples
   if (ei->hasExamples(f))
   {
@@ -544,6 +549,32 @@ void SygusUnifIo::initializeCandidate(
       d_examples_out.push_back(output);
     }
   }
+  // group the examples by their output
+  size_t nex = d_examples_out.size();
+  std::map<Node, ExampleBitset> outClasses;
+  for (size_t i = 0; i < nex; i++)
+  {
+    std::map<Node, ExampleBitset>::iterator it =
+        outClasses.find(d_examples_out[i]);
+    if (it == outClasses.end())
+    {
+      it = outClasses.emplace(d_examples_out[i], ExampleBitset(nex, false))
+               .first;
+    }
+    it->second.set(i, true);
+  }
+  d_examples_out_class.resize(nex);
+  for (std::pair<const Node, ExampleBitset>& oc : outClasses)
+  {
+    for (size_t i = 0; i < nex; i++)
+    {
+      if (oc.second.get(i))
+      {
+        d_examples_out_class[i] = d_examples_out_classes.size();
+      }
+    }
+    d_examples_out_classes.push_back(oc.second);
+  }
   d_ecache.clear();
   SygusUnif::initializeCandidate(tds, f, enums, strategy_lemmas);
   // learn redundant operators based on the strategy
@@ -997,6 +1028,7 @@ void SygusUnifIo::EnumCache::addEnumValue(Node v, std::vector<Node>& results)
   d_enum_val_to_index[v] = d_enum_vals.size();
   d_enum_vals.push_back(v);
   d_enum_vals_res.push_back(results);
+  d_enum_vals_true.push_back(ExampleBitset::mkTrueSet(results));
 }
 
 void SygusUnifIo::initializeConstructSol()
@@ -1126,41 +1158,18 @@ Node SygusUnifIo::constructSol(
     // maybe we can find one in the cache
     if (ret_dt.isNull() && !retValMod)
     {
-      bool firstTime = true;
-      std::unordered_set<Node, NodeHashFunction> intersection;
-      std::map<TypeNode, std::unordered_set<Node, NodeHashFunction>>::iterator
-          pit;
-      for (size_t i = 0, nvals = x.d_vals.size(); i < nvals; i++)
+      // the cached solutions that solve all active points
+      std::vector<Node> intersection;
+      std::map<TypeNode, std::map<Node, ExampleBitset>>::iterator pit =
+          d_psolutions.find(etn);
+      if (pit != d_psolutions.end() && !x.d_active.empty())
       {
-        if (x.d_vals[i].getConst<bool>())
+        for (const std::pair<const Node, ExampleBitset>& ps : pit->second)
         {
-          pit = d_psolutions[i].find(etn);
-          if (pit == d_psolutions[i].end())
+          if (x.d_active.isSubsetOf(ps.second))
           {
-            // no cached solution
-            intersection.clear();
-            break;
-          }
-          if (firstTime)
-          {
-            intersection = pit->second;
-            firstTime = false;
-          }
-          else
-          {
-            std::vector<Node> rm;
-            for (const Node& a : intersection)
-            {
-              if (pit->second.find(a) == pit->second.end())
-              {
-                rm.push_back(a);
-              }
-            }
-            for (const Node& a : rm)
-            {
-              intersection.erase(a);
-            }
-            if (intersection.empty())
+            intersection.push_back(ps.first);
+            if (!d_enableMinimality)
             {
               break;
             }
@@ -1174,14 +1183,11 @@ Node SygusUnifIo::constructSol(
           // if we are enabling minimality, the minimal cached solution may
           // still not be the best solution, thus we remember it and keep it if
           // we don't construct a better one below
-          std::vector<Node> intervec;
-          intervec.insert(
-              intervec.begin(), intersection.begin(), intersection.end());
-          cached_ret_dt = getMinimalTerm(intervec);
+          cached_ret_dt = getMinimalTerm(intersection);
         }
         else
         {
-          ret_dt = *intersection.begin();
+          ret_dt = intersection[0];
         }
         if (Trace.isOn("sygus-sui-dt"))
         {
@@ -1375,12 +1381,14 @@ Node SygusUnifIo::constructSol(
 
         // update the context
         std::vector<Node> prev;
+        ExampleBitset prevActive;
         if (strat == strat_ITE && sc > 0)
         {
           EnumCache& ecache_cond = d_ecache[split_cond_enum];
           Assert(set_split_cond_res_index);
           Assert(split_cond_res_index < ecache_cond.d_enum_vals_res.size());
           prev = x.d_vals;
+          prevActive = x.d_active;
           x.updateContext(this,
                           ecache_cond.d_enum_vals_res[split_cond_res_index],
                           sc == 1);
@@ -1478,6 +1486,7 @@ Node SygusUnifIo::constructSol(
         if (strat == strat_ITE && sc > 0)
         {
           x.d_vals = prev;
+          x.d_active = prevActive;
         }
         if (!rec_c.isNull())
         {
@@ -1545,19 +1554,23 @@ Node SygusUnifIo::constructSol(
   {
     if (!retValMod && !ret_dt.isNull())
     {
-      for (size_t i = 0, nvals = x.d_vals.size(); i < nvals; i++)
+      if (Trace.isOn("sygus-sui-cache"))
       {
-        if (x.d_vals[i].getConst<bool>())
-        {
-          if (Trace.isOn("sygus-sui-cache"))
-          {
-            indent("sygus-sui-cache", ind);
-            Trace("sygus-sui-cache") << "Cache solution (#" << i << ") : ";
-            TermDbSygus::toStreamSygus("sygus-sui-cache", ret_dt);
-            Trace("sygus-sui-cache") << std::endl;
-          }
-          d_psolutions[i][etn].insert(ret_dt);
-        }
+        indent("sygus-sui-cache", ind);
+        Trace("sygus-sui-cache") << "Cache solution (#" << x.d_active.count()
+                                 << " points) : ";
+        TermDbSygus::toStreamSygus("sygus-sui-cache", ret_dt);
+        Trace("sygus-sui-cache") << std::endl;
+      }
+      std::map<Node, ExampleBitset>& psols = d_psolutions[etn];
+      std::map<Node, ExampleBitset>::iterator it = psols.find(ret_dt);
+      if (it == psols.end())
+      {
+        psols[ret_dt] = x.d_active;
+      }
+      else
+      {
+        it->second |= x.d_active;
       }
     }
   }
@@ -1577,40 +1590,54 @@ Node SygusUnifIo::constructBestConditional(Node ce,
   Trace("sygus-sui-dt-igain") << "Best information gain in context ";
   print_val("sygus-sui-dt-igain", x.d_vals);
   Trace("sygus-sui-dt-igain") << std::endl;
-  // set of indices that are active in this branch, i.e. x.d_vals[i] is true
-  std::vector<unsigned> activeIndices;
-  // map (j,t,s) -> n, such that the j^th condition in the vector conds
-  // evaluates to t (typically true/false) on n active I/O pairs with output s.
-  std::map<unsigned, std::map<Node, std::map<Node, unsigned>>> eval;
-  // map (j,t) -> m, such that the j^th condition in the vector conds
-  // evaluates to t (typically true/false) for m active I/O pairs.
-  std::map<unsigned, std::map<Node, unsigned>> evalCount;
+  const ExampleBitset& active = x.d_active;
+  size_t activePoints = active.count();
+  AlwaysAssert(activePoints > 0);
   unsigned nconds = conds.size();
   EnumCache& ecache = d_ecache[ce];
-  // Get the index of conds[j] in the enumerator cache, this is to look up
-  // its evaluation on each point.
-  std::vector<unsigned> eindex;
+  // Get the set of points on which conds[j] evaluates to true from the
+  // enumerator cache, where conditions evaluate to true or false on all points.
+  std::vector<const ExampleBitset*> condTrue;
   for (unsigned j = 0; j < nconds; j++)
   {
-    eindex.push_back(ecache.d_enum_val_to_index[conds[j]]);
+    unsigned eindex = ecache.d_enum_val_to_index[conds[j]];
+    condTrue.push_back(&ecache.d_enum_vals_true[eindex]);
   }
-  unsigned activePoints = 0;
-  for (unsigned i = 0, npoints = x.d_vals.size(); i < npoints; i++)
+  // the output classes that have active points, and the local index of each
+  size_t nclassesAll = d_examples_out_classes.size();
+  std::vector<size_t> classes;
+  std::vector<size_t> classIndex(nclassesAll);
+  for (size_t k = 0; k < nclassesAll; k++)
   {
-    if (x.d_vals[i].getConst<bool>())
+    if (active.countAnd(d_examples_out_classes[k]) > 0)
     {
-      activePoints++;
-      Node eo = d_examples_out[i];
-      for (unsigned j = 0; j < nconds; j++)
+      classIndex[k] = classes.size();
+      classes.push_back(k);
+    }
+  }
+  // The branches in the order of their values, where the entropy is
+  // accumulated as a sum over branches and classes in this order.
+  bool pols[2] = {d_true < d_false, !(d_true < d_false)};
+  // We count the points of each class in each branch by popcounts if there
+  // are few classes, and by traversing the active points otherwise.
+  size_t nwords = (active.size() + 63) / 64;
+  bool usePopcount = classes.size() * nwords <= activePoints;
+  std::vector<size_t> activeIndices;
+  if (!usePopcount)
+  {
+    for (size_t i = 0, npoints = active.size(); i < npoints; i++)
+    {
+      if (active.get(i))
       {
-        Node resn = ecache.d_enum_vals_res[eindex[j]][i];
-        Assert(resn.isConst());
-        eval[j][resn][eo]++;
-        evalCount[j][resn]++;
+        activeIndices.push_back(i);
       }
     }
   }
-  AlwaysAssert(activePoints > 0);
+  // counts[b][c] is the number of active points with output class classes[c]
+  // on which the current condition evaluates to pols[b]
+  std::vector<size_t> counts[2];
+  counts[0].resize(classes.size());
+  counts[1].resize(classes.size());
   // find the condition that leads to the lowest entropy
   // initially set minEntropy to > 1.0.
   double minEntropy = 2.0;
@@ -1625,22 +1652,47 @@ Node SygusUnifIo::constructBestConditional(Node ce,
     // Then, the entropy of C is:
     //   sum{t}. prob(t)*( sum{s}. -prob(s|t)*log2(prob(s|t)) )
     // where notice this is always between 0 and 1.
+    const ExampleBitset& ct = *condTrue[j];
+    size_t ntrue = active.countAnd(ct);
+    for (size_t b = 0; b < 2; b++)
+    {
+      std::fill(counts[b].begin(), counts[b].end(), 0);
+    }
+    if (usePopcount)
+    {
+      for (size_t b = 0; b < 2; b++)
+      {
+        for (size_t c = 0, nclasses = classes.size(); c < nclasses; c++)
+        {
+          counts[b][c] = active.countAnd(
+              ct, pols[b], d_examples_out_classes[classes[c]]);
+        }
+      }
+    }
+    else
+    {
+      for (size_t i : activeIndices)
+      {
+        size_t b = ct.get(i) == pols[0] ? 0 : 1;
+        counts[b][classIndex[d_examples_out_class[i]]]++;
+      }
+    }
     double entropySum = 0.0;
     Trace("sygus-sui-dt-igain") << j << " : ";
-    for (std::pair<const Node, std::map<Node, unsigned>>& ej : eval[j])
+    for (size_t b = 0; b < 2; b++)
     {
-      unsigned ecount = evalCount[j][ej.first];
+      size_t ecount = pols[b] ? ntrue : activePoints - ntrue;
       if (ecount > 0)
       {
         double probBranch = double(ecount) / double(activePoints);
-        Trace("sygus-sui-dt-igain") << ej.first << " -> ( ";
-        for (std::pair<const Node, unsigned>& eej : ej.second)
+        Trace("sygus-sui-dt-igain") << pols[b] << " -> ( ";
+        for (size_t c = 0, nclasses = classes.size(); c < nclasses; c++)
         {
-          if (eej.second > 0)
+          if (counts[b][c] > 0)
           {
-            double probVal = double(eej.second) / double(ecount);
+            double probVal = double(counts[b][c]) / double(ecount);
             Trace("sygus-sui-dt-igain")
-                << eej.first << ":" << eej.second << " ";
+                << "#" << classes[c] << ":" << counts[b][c] << " ";
             double factor = -probVal * log2(probVal);
             entropySum += probBranch * factor;
           }
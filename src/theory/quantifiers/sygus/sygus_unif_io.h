@@ -18,6 +18,8 @@
 #define CVC4__THEORY__QUANTIFIERS__SYGUS_UNIF_IO_H
 
 #include <map>
+
+#include "theory/quantifiers/sygus/example_bitset.h"
 #include "theory/quantifiers/sygus/sygus_unif.h"
 
 namespace cvc5 {
@@ -54,10 +56,13 @@ class UnifContextIo : public UnifContext
   * if d_vals[i] = false, i/o pair #i is inactive according to this context
   */
   std::vector<Node> d_vals;
+  /** The set of indices i such that d_vals[i] is true */
+  ExampleBitset d_active;
   /** update the examples
   *
   * if pol=true, this method updates d_vals to d_vals & vals
   * if pol=false, this method updates d_vals to d_vals & ( ~vals )
+  * and updates d_active accordingly.
   */
   bool updateContext(SygusUnifIo* sui, std::vector<Node>& vals, bool pol);
   //----------end for ITE strategy
@@ -305,14 +310,16 @@ class SygusUnifIo : public SygusUnif
   unsigned d_sol_term_size;
   /** partial solutions
    *
-   * Maps indices for I/O points to a list of solutions for that point, for each
-   * type. We may have more than one type for solutions, e.g. for grammar:
+   * Maps each type to the solutions of that type that were constructed, and
+   * each such solution to the set of indices of the I/O points for which it
+   * is a solution. We may have more than one type for solutions, e.g. for
+   * grammar:
    *   A -> ite( A, B, C ) | ...
-   * where terms of type B and C can both act as solutions.
+   * where terms of type B and C can both act as solutions. A cached solution
+   * applies to a context if its set of points includes the active points of
+   * the context.
    */
-  std::map<size_t,
-           std::map<TypeNode, std::unordered_set<Node, NodeHashFunction>>>
-      d_psolutions;
+  std::map<TypeNode, std::map<Node, ExampleBitset>> d_psolutions;
   /**
    * This flag is set to true if the solution construction was
    * non-deterministic with respect to failure/success.
@@ -346,6 +353,13 @@ class SygusUnifIo : public SygusUnif
   std::vector<std::vector<Node>> d_examples;
   /** output of I/O examples */
   std::vector<Node> d_examples_out;
+  /**
+   * The classes of the outputs of the I/O examples, which are the sets of
+   * indices of the examples with the same output, ordered by their output.
+   */
+  std::vector<ExampleBitset> d_examples_out_classes;
+  /** The index in d_examples_out_classes of the class of each example */
+  std::vector<size_t> d_examples_out_class;
 
   /**
   * This class stores information regarding an enumerator, including:
@@ -377,6 +391,11 @@ class SygusUnifIo : public SygusUnif
       * or the value of f( I ) = O if d_role==enum_io
       */
     std::vector<std::vector<Node>> d_enum_vals_res;
+    /**
+     * For each value in d_enum_vals, the set of indices of the examples on
+     * which it evaluates to true, which is used for conditions.
+     */
+    std::vector<ExampleBitset> d_enum_vals_true;
     /**
     * The set of values in d_enum_vals that have been "subsumed" by others
     * (see SubsumeTrie for explanation of subsumed).
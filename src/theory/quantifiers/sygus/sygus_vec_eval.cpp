@@ -0,0 +1,509 @@
+/*********************                                                        */
+/*! \file sygus_vec_eval.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the evaluation of terms on many points at once
+ **/
+
+#include "theory/quantifiers/sygus/sygus_vec_eval.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+namespace {
+
+/** The bit pattern of word w */
+inline uint64_t u(int64_t w) { return static_cast<uint64_t>(w); }
+
+/** The word of bit pattern b */
+inline int64_t s(uint64_t b) { return static_cast<int64_t>(b); }
+
+/** The mask of a bit-vector of the given width */
+inline uint64_t mask(unsigned width)
+{
+  return width >= 64 ? ~static_cast<uint64_t>(0)
+                     : (static_cast<uint64_t>(1) << width) - 1;
+}
+
+/** The signed value of the bit-vector of the given width whose bits are b */
+inline int64_t sext(uint64_t b, unsigned width)
+{
+  if (width < 64 && (b >> (width - 1)) != 0)
+  {
+    b |= ~mask(width);
+  }
+  return s(b);
+}
+
+}  // namespace
+
+SygusVecEvaluator::SygusVecEvaluator() {}
+
+bool SygusVecEvaluator::getType(TypeNode tn, Type& t, unsigned& width)
+{
+  width = 0;
+  if (tn.isBoolean())
+  {
+    t = Type::BOOL;
+    return true;
+  }
+  if (tn.isInteger())
+  {
+    t = Type::INT;
+    return true;
+  }
+  if (tn.isBitVector() && tn.getBitVectorSize() <= 64)
+  {
+    t = Type::BV;
+    width = tn.getBitVectorSize();
+    return true;
+  }
+  return false;
+}
+
+bool SygusVecEvaluator::getWord(Node c, Type t, int64_t& w)
+{
+  switch (t)
+  {
+    case Type::BOOL:
+      if (c.getKind() != CONST_BOOLEAN)
+      {
+        return false;
+      }
+      w = c.getConst<bool>() ? 1 : 0;
+      return true;
+    case Type::INT:
+    {
+      if (c.getKind() != CONST_RATIONAL)
+      {
+        return false;
+      }
+      const Rational& r = c.getConst<Rational>();
+      if (!r.isIntegral() || !r.getNumerator().fitsSignedLong())
+      {
+        return false;
+      }
+      w = r.getNumerator().getLong();
+      return true;
+    }
+    case Type::BV:
+      if (c.getKind() != CONST_BITVECTOR)
+      {
+        return false;
+      }
+      w = s(c.getConst<BitVector>().getValue().getUnsignedLong());
+      return true;
+  }
+  return false;
+}
+
+Node SygusVecEvaluator::mkValue(int64_t w, Type t, unsigned width)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  switch (t)
+  {
+    case Type::BOOL: return nm->mkConst(w != 0);
+    case Type::INT: return nm->mkConst(Rational(w));
+    case Type::BV: return nm->mkConst(BitVector(width, u(w)));
+  }
+  return Node::null();
+}
+
+size_t SygusVecEvaluator::push(
+    Op op, Type t, unsigned width, size_t a, size_t b, size_t c)
+{
+  d_tape.push_back(Instr{op, t, width, {a, b, c}, 0});
+  return d_tape.size() - 1;
+}
+
+bool SygusVecEvaluator::compile(Node n, const std::vector<Node>& vars)
+{
+  d_tape.clear();
+  d_slot.clear();
+  d_term = n;
+  d_vars = vars;
+  std::unordered_map<TNode, bool, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    std::unordered_map<TNode, bool, TNodeHashFunction>::iterator it =
+        visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = false;
+      visit.push_back(cur);
+      // the children of constants and variables are not evaluated
+      if (!cur.isConst())
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+      }
+    }
+    else if (!it->second)
+    {
+      it->second = true;
+      if (!addInstr(cur))
+      {
+        Trace("sygus-vec-eval") << "Cannot compile " << cur << std::endl;
+        d_tape.clear();
+        d_slot.clear();
+        return false;
+      }
+    }
+  } while (!visit.empty());
+  Trace("sygus-vec-eval") << "Compiled " << n << " to " << d_tape.size()
+                          << " instructions" << std::endl;
+  return true;
+}
+
+bool SygusVecEvaluator::addInstr(TNode n)
+{
+  Type t;
+  unsigned width;
+  if (!getType(n.getType(), t, width))
+  {
+    return false;
+  }
+  if (n.isConst())
+  {
+    int64_t w;
+    if (!getWord(n, t, w))
+    {
+      return false;
+    }
+    size_t slot = push(Op::CONST, t, width, 0, 0, 0);
+    d_tape[slot].d_value = w;
+    d_slot[n] = slot;
+    return true;
+  }
+  Kind k = n.getKind();
+  if (n.getNumChildren() == 0)
+  {
+    std::vector<Node>::iterator it =
+        std::find(d_vars.begin(), d_vars.end(), n);
+    if (it == d_vars.end())
+    {
+      return false;
+    }
+    size_t slot = push(Op::VAR, t, width, 0, 0, 0);
+    d_tape[slot].d_value = static_cast<int64_t>(it - d_vars.begin());
+    d_slot[n] = slot;
+    return true;
+  }
+  std::vector<size_t> args;
+  for (const Node& nc : n)
+  {
+    args.push_back(d_slot[nc]);
+  }
+  // the n-ary operators are compiled to a chain of binary ones
+  Op chain;
+  switch (k)
+  {
+    case AND: chain = Op::AND; break;
+    case OR: chain = Op::OR; break;
+    case XOR: chain = Op::XOR; break;
+    case PLUS: chain = Op::ADD; break;
+    case MULT:
+    case NONLINEAR_MULT: chain = Op::MUL; break;
+    case BITVECTOR_PLUS: chain = Op::BV_ADD; break;
+    case BITVECTOR_MULT: chain = Op::BV_MUL; break;
+    case BITVECTOR_AND: chain = Op::BV_AND; break;
+    case BITVECTOR_OR: chain = Op::BV_OR; break;
+    case BITVECTOR_XOR: chain = Op::BV_XOR; break;
+    default: chain = Op::CONST; break;
+  }
+  if (chain != Op::CONST)
+  {
+    size_t slot = args[0];
+    for (size_t i = 1, nargs = args.size(); i < nargs; i++)
+    {
+      slot = push(chain, t, width, slot, args[i], 0);
+    }
+    d_slot[n] = slot;
+    return true;
+  }
+  size_t slot;
+  // the width of the arguments of bit-vector comparisons
+  unsigned awidth = d_tape[args[0]].d_width;
+  switch (k)
+  {
+    case ITE: slot = push(Op::ITE, t, width, args[0], args[1], args[2]); break;
+    case EQUAL:
+      slot = push(Op::EQUAL, t, width, args[0], args[1], 0);
+      break;
+    case NOT: slot = push(Op::NOT, t, width, args[0], 0, 0); break;
+    case IMPLIES:
+      slot = push(Op::NOT, t, width, args[0], 0, 0);
+      slot = push(Op::OR, t, width, slot, args[1], 0);
+      break;
+    case MINUS: slot = push(Op::SUB, t, width, args[0], args[1], 0); break;
+    case UMINUS: slot = push(Op::NEG, t, width, args[0], 0, 0); break;
+    case LT: slot = push(Op::LT, t, width, args[0], args[1], 0); break;
+    case LEQ: slot = push(Op::LEQ, t, width, args[0], args[1], 0); break;
+    case GT: slot = push(Op::LT, t, width, args[1], args[0], 0); break;
+    case GEQ: slot = push(Op::LEQ, t, width, args[1], args[0], 0); break;
+    case BITVECTOR_SUB:
+      slot = push(Op::BV_SUB, t, width, args[0], args[1], 0);
+      break;
+    case BITVECTOR_NEG: slot = push(Op::BV_NEG, t, width, args[0], 0, 0); break;
+    case BITVECTOR_NOT: slot = push(Op::BV_NOT, t, width, args[0], 0, 0); break;
+    case BITVECTOR_SHL:
+      slot = push(Op::BV_SHL, t, width, args[0], args[1], 0);
+      break;
+    case BITVECTOR_LSHR:
+      slot = push(Op::BV_LSHR, t, width, args[0], args[1], 0);
+      break;
+    case BITVECTOR_ULT:
+      slot = push(Op::BV_ULT, t, awidth, args[0], args[1], 0);
+      break;
+    case BITVECTOR_ULE:
+      slot = push(Op::BV_ULE, t, awidth, args[0], args[1], 0);
+      break;
+    case BITVECTOR_UGT:
+      slot = push(Op::BV_ULT, t, awidth, args[1], args[0], 0);
+      break;
+    case BITVECTOR_UGE:
+      slot = push(Op::BV_ULE, t, awidth, args[1], args[0], 0);
+      break;
+    case BITVECTOR_SLT:
+      slot = push(Op::BV_SLT, t, awidth, args[0], args[1], 0);
+      break;
+    case BITVECTOR_SLE:
+      slot = push(Op::BV_SLE, t, awidth, args[0], args[1], 0);
+      break;
+    case BITVECTOR_SGT:
+      slot = push(Op::BV_SLT, t, awidth, args[1], args[0], 0);
+      break;
+    case BITVECTOR_SGE:
+      slot = push(Op::BV_SLE, t, awidth, args[1], args[0], 0);
+      break;
+    default: return false;
+  }
+  d_slot[n] = slot;
+  return true;
+}
+
+bool SygusVecEvaluator::evaluate(const std::vector<std::vector<Node>>& points,
+                                 std::vector<Node>& out)
+{
+  if (d_tape.empty())
+  {
+    return false;
+  }
+  size_t npts = points.size();
+  d_lanes.resize(d_tape.size() * npts);
+  bool overflow = false;
+  for (size_t i = 0, ninstr = d_tape.size(); i < ninstr; i++)
+  {
+    const Instr& ins = d_tape[i];
+    int64_t* r = &d_lanes[i * npts];
+    const int64_t* a = &d_lanes[ins.d_args[0] * npts];
+    const int64_t* b = &d_lanes[ins.d_args[1] * npts];
+    const int64_t* c = &d_lanes[ins.d_args[2] * npts];
+    uint64_t m = mask(ins.d_width);
+    switch (ins.d_op)
+    {
+      case Op::CONST: std::fill(r, r + npts, ins.d_value); break;
+      case Op::VAR:
+        for (size_t j = 0; j < npts; j++)
+        {
+          Assert(static_cast<size_t>(ins.d_value) < points[j].size());
+          if (!getWord(points[j][ins.d_value], ins.d_type, r[j]))
+          {
+            return false;
+          }
+        }
+        break;
+      case Op::ITE:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] != 0 ? b[j] : c[j];
+        }
+        break;
+      case Op::EQUAL:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] == b[j];
+        }
+        break;
+      case Op::NOT:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] == 0;
+        }
+        break;
+      case Op::AND:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] & b[j];
+        }
+        break;
+      case Op::OR:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] | b[j];
+        }
+        break;
+      case Op::XOR:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] ^ b[j];
+        }
+        break;
+      case Op::ADD:
+        for (size_t j = 0; j < npts; j++)
+        {
+          overflow |= __builtin_add_overflow(a[j], b[j], &r[j]);
+        }
+        break;
+      case Op::SUB:
+        for (size_t j = 0; j < npts; j++)
+        {
+          overflow |= __builtin_sub_overflow(a[j], b[j], &r[j]);
+        }
+        break;
+      case Op::NEG:
+        for (size_t j = 0; j < npts; j++)
+        {
+          overflow |= __builtin_sub_overflow(int64_t(0), a[j], &r[j]);
+        }
+        break;
+      case Op::MUL:
+        for (size_t j = 0; j < npts; j++)
+        {
+          overflow |= __builtin_mul_overflow(a[j], b[j], &r[j]);
+        }
+        break;
+      case Op::LT:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] < b[j];
+        }
+        break;
+      case Op::LEQ:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] <= b[j];
+        }
+        break;
+      case Op::BV_ADD:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = s((u(a[j]) + u(b[j])) & m);
+        }
+        break;
+      case Op::BV_SUB:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = s((u(a[j]) - u(b[j])) & m);
+        }
+        break;
+      case Op::BV_NEG:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = s((0 - u(a[j])) & m);
+        }
+        break;
+      case Op::BV_MUL:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = s((u(a[j]) * u(b[j])) & m);
+        }
+        break;
+      case Op::BV_AND:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] & b[j];
+        }
+        break;
+      case Op::BV_OR:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] | b[j];
+        }
+        break;
+      case Op::BV_XOR:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = a[j] ^ b[j];
+        }
+        break;
+      case Op::BV_NOT:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = s(~u(a[j]) & m);
+        }
+        break;
+      case Op::BV_SHL:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = u(b[j]) >= ins.d_width ? 0 : s((u(a[j]) << u(b[j])) & m);
+        }
+        break;
+      case Op::BV_LSHR:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = u(b[j]) >= ins.d_width ? 0 : s(u(a[j]) >> u(b[j]));
+        }
+        break;
+      case Op::BV_ULT:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = u(a[j]) < u(b[j]);
+        }
+        break;
+      case Op::BV_ULE:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = u(a[j]) <= u(b[j]);
+        }
+        break;
+      case Op::BV_SLT:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = sext(u(a[j]), ins.d_width) < sext(u(b[j]), ins.d_width);
+        }
+        break;
+      case Op::BV_SLE:
+        for (size_t j = 0; j < npts; j++)
+        {
+          r[j] = sext(u(a[j]), ins.d_width) <= sext(u(b[j]), ins.d_width);
+        }
+        break;
+    }
+    if (overflow)
+    {
+      Trace("sygus-vec-eval") << "Overflow evaluating " << d_term << std::endl;
+      return false;
+    }
+  }
+  size_t res = d_slot[d_term];
+  const Instr& ins = d_tape[res];
+  for (size_t j = 0; j < npts; j++)
+  {
+    out.push_back(mkValue(d_lanes[res * npts + j], ins.d_type, ins.d_width));
+  }
+  return true;
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,147 @@
+/*********************                                                        */
+/*! \file sygus_vec_eval.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Evaluation of terms on many points at once
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_VEC_EVAL_H
+#define CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_VEC_EVAL_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+/** SygusVecEvaluator
+ *
+ * This class evaluates a builtin term on a list of points at once, which is
+ * used for evaluating sygus candidates on the examples of a PBE conjecture
+ * and on the points of a sygus sampler (--sygus-eval-vec).
+ *
+ * The term is first compiled to a tape, which is the list of the distinct
+ * subterms of the term in post-order, whose operators refer to the slots of
+ * their arguments. Evaluation then runs the tape once, where each slot holds
+ * the values of its subterm on all points as a lane of 64-bit machine words.
+ * Hence each operator is a loop over the points, without constructing nodes
+ * except for the final values.
+ *
+ * Only Booleans, integers and bit-vectors of width at most 64 are supported,
+ * with their linear arithmetic, comparison, bitwise and ite operators. The
+ * methods below return false for the terms and points that cannot be handled
+ * this way, including when an integer operation overflows, in which case the
+ * caller should fall back to the evaluator.
+ */
+class SygusVecEvaluator
+{
+ public:
+  SygusVecEvaluator();
+  /**
+   * Compile term n, whose free variables are in vars. Returns false if n has
+   * an unsupported operator or type.
+   */
+  bool compile(Node n, const std::vector<Node>& vars);
+  /**
+   * Evaluate the compiled term on the given points, which are values for the
+   * variables passed to compile, and adds its values to out. Returns false
+   * if it failed, in which case out is unchanged.
+   */
+  bool evaluate(const std::vector<std::vector<Node>>& points,
+                std::vector<Node>& out);
+
+ private:
+  /** The operators of the tape */
+  enum class Op
+  {
+    CONST,
+    VAR,
+    ITE,
+    EQUAL,
+    NOT,
+    AND,
+    OR,
+    XOR,
+    ADD,
+    SUB,
+    NEG,
+    MUL,
+    LT,
+    LEQ,
+    BV_ADD,
+    BV_SUB,
+    BV_NEG,
+    BV_MUL,
+    BV_AND,
+    BV_OR,
+    BV_XOR,
+    BV_NOT,
+    BV_SHL,
+    BV_LSHR,
+    BV_ULT,
+    BV_ULE,
+    BV_SLT,
+    BV_SLE
+  };
+  /** The types of values */
+  enum class Type
+  {
+    BOOL,
+    INT,
+    BV
+  };
+  /** An instruction of the tape */
+  struct Instr
+  {
+    Op d_op;
+    /** The type of the result */
+    Type d_type;
+    /** The bit-width of the result or of the arguments of a BV comparison */
+    unsigned d_width;
+    /** The slots of the arguments */
+    size_t d_args[3];
+    /** The value of CONST, or the index of the variable of VAR */
+    int64_t d_value;
+  };
+  /** Get the type of tn, returns false if it is unsupported */
+  static bool getType(TypeNode tn, Type& t, unsigned& width);
+  /** Get the machine word of constant c of type t, false if unsupported */
+  static bool getWord(Node c, Type t, int64_t& w);
+  /** Make the value of word w of type t with the given width */
+  static Node mkValue(int64_t w, Type t, unsigned width);
+  /**
+   * Add the instruction for n, whose arguments have been added, returns false
+   * if it is unsupported.
+   */
+  bool addInstr(TNode n);
+  /** Add an instruction, returns its slot */
+  size_t push(Op op, Type t, unsigned width, size_t a, size_t b, size_t c);
+  /** The tape */
+  std::vector<Instr> d_tape;
+  /** The slot of each subterm of the compiled term */
+  std::unordered_map<TNode, size_t, TNodeHashFunction> d_slot;
+  /** The term compiled to the tape */
+  Node d_term;
+  /** The variables */
+  std::vector<Node> d_vars;
+  /** The lanes of the slots, one after the other */
+  std::vector<int64_t> d_lanes;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__QUANTIFIERS__SYGUS__SYGUS_VEC_EVAL_H */
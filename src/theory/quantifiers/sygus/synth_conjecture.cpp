@@ -20,8 +20,10 @@
 #include "options/quantifiers_options.h"
 #include "printer/printer.h"
 #include "smt/logic_exception.h"
+#include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "smt/smt_statistics_registry.h"
+#include "smt/sygus_solution_listener.h"
 #include "theory/datatypes/sygus_datatype_utils.h"
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers/instantiate.h"
@@ -70,7 +72,8 @@ SynthConjecture::SynthConjecture(QuantifiersState& qs,
       d_set_ce_sk_vars(false),
       d_repair_index(0),
       d_refine_count(0),
-      d_guarded_stream_exc(false)
+      d_guarded_stream_exc(false),
+      d_solCacheTried(false)
 {
   if (options::sygusSymBreakPbe() || options::sygusUnifPbe())
   {
@@ -186,6 +189,12 @@ void SynthConjecture::assign(Node q)
   }
   Trace("cegqi") << "Base instantiation is :      " << d_base_inst << std::endl;
 
+  if (!options::sygusSolutionCache().empty())
+  {
+    d_solCache.reset(new SygusSolutionCache(options::sygusSolutionCache()));
+    d_solCacheKey = SygusSolutionCache::computeKey(d_embed_quant);
+  }
+
   // initialize the sygus constant repair utility
   if (options::sygusRepairConst())
   {
@@ -329,12 +338,30 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
   std::vector<Node> candidate_values;
   bool constructed_cand = false;
 
+  // first, try the solution stored for this conjecture in the solution cache,
+  // which is verified below as any other candidate
+  if (d_solCache != nullptr && !d_solCacheTried)
+  {
+    d_solCacheTried = true;
+    std::vector<TypeNode> types;
+    for (const Node& c : d_candidates)
+    {
+      types.push_back(c.getType());
+    }
+    if (d_solCache->lookup(d_solCacheKey, types, candidate_values))
+    {
+      Trace("sygus-engine") << "CegConjuncture : try cached solution"
+                            << std::endl;
+      constructed_cand = true;
+    }
+  }
+
   // If a module is not trying to repair constants in solutions and the option
   // sygusRepairConst  is true, we use a default scheme for trying to repair
   // constants here.
   bool doRepairConst =
       options::sygusRepairConst() && !d_master->usingRepairConst();
-  if (doRepairConst)
+  if (doRepairConst && !constructed_cand)
   {
     // have we tried to repair the previous solution?
     // if not, call the repair constant utility
@@ -540,7 +567,21 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
     {
       for (const Node& v : inst[0][0])
       {
-        Node sk = nm->mkSkolem("rsk", v.getType());
+        Node sk;
+        if (options::sygusVerifyInc())
+        {
+          // the skolems are shared by the queries of the incremental subsolver
+          Node& vsk = d_verifySks[v];
+          if (vsk.isNull())
+          {
+            vsk = nm->mkSkolem("rsk", v.getType());
+          }
+          sk = vsk;
+        }
+        else
+        {
+          sk = nm->mkSkolem("rsk", v.getType());
+        }
         sks.push_back(sk);
         vars.push_back(v);
         Trace("cegqi-check-debug")
@@ -576,7 +617,7 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
   if (!query.isConst() || query.getConst<bool>())
   {
     Trace("sygus-engine") << "  *** Verify with subcall..." << std::endl;
-    Result r = checkWithSubsolver(query, d_ce_sk_vars, d_ce_sk_var_mvs);
+    Result r = checkVerification(query, d_ce_sk_vars, d_ce_sk_var_mvs);
     Trace("sygus-engine") << "  ...got " << r << std::endl;
     if (r.asSatisfiabilityResult().isSat() == Result::SAT)
     {
@@ -624,10 +665,17 @@ bool SynthConjecture::doCheck(std::vector<Node>& lems)
   if (options::sygusStream())
   {
     // immediately print the current solution
-    printAndContinueStream(terms, candidate_values);
-    // streaming means now we immediately are looking for a new solution
-    d_hasSolution = false;
-    return false;
+    if (!printAndContinueStream(terms, candidate_values))
+    {
+      // streaming means now we immediately are looking for a new solution
+      d_hasSolution = false;
+      return false;
+    }
+    // otherwise the listener stopped the stream at the current solution
+  }
+  if (d_solCache != nullptr)
+  {
+    d_solCache->store(d_solCacheKey, candidate_values);
   }
   // Use lemma to terminate with "unsat", this is justified by the verification
   // check above, which confirms the synthesis conjecture is solved.
@@ -654,6 +702,36 @@ bool SynthConjecture::checkSideCondition(const std::vector<Node>& cvals) const
   return true;
 }
 
+Result SynthConjecture::checkVerification(Node query,
+                                          const std::vector<Node>& vars,
+                                          std::vector<Node>& modelVals)
+{
+  query = Rewriter::rewrite(query);
+  if (!options::sygusVerifyInc() || query.isConst())
+  {
+    return checkWithSubsolver(query, vars, modelVals);
+  }
+  if (d_verifyChecker == nullptr)
+  {
+    initializeSubsolver(d_verifyChecker);
+    d_verifyChecker->setOption("incremental", "true");
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Node sel = nm->mkSkolem("GV", nm->booleanType());
+  d_verifyChecker->assertFormula(nm->mkNode(IMPLIES, sel, query));
+  Result r = d_verifyChecker->checkSat(sel);
+  if (r.asSatisfiabilityResult().isSat() == Result::SAT)
+  {
+    for (const Node& v : vars)
+    {
+      modelVals.push_back(d_verifyChecker->getValue(v));
+    }
+  }
+  // the query of this candidate is never checked again
+  d_verifyChecker->assertFormula(sel.negate());
+  return r;
+}
+
 bool SynthConjecture::doRefine()
 {
   std::vector<Node> lems;
@@ -848,7 +926,12 @@ Node SynthConjecture::getEnumeratedValue(Node e, bool& activeIncomplete)
                    == options::SygusActiveGenMode::ENUM
                || options::sygusActiveGenMode()
                       == options::SygusActiveGenMode::AUTO);
-        d_evg[e].reset(new SygusEnumerator(d_tds, this, d_stats));
+        // Only the enumerator of a single function-to-synthesize may be
+        // sharded, since the candidates of several enumerators are combined.
+        bool sharded = options::sygusEnumShards() > 1
+                       && d_candidates.size() == 1 && e == d_candidates[0];
+        d_evg[e].reset(
+            new SygusEnumerator(d_tds, this, d_stats, false, sharded));
       }
     }
     Trace("sygus-active-gen")
@@ -979,15 +1062,30 @@ void SynthConjecture::debugPrint(const char* c)
   Trace(c) << "  * Counterexample skolems : " << d_ce_sk_vars << std::endl;
 }
 
-void SynthConjecture::printAndContinueStream(const std::vector<Node>& enums,
+bool SynthConjecture::printAndContinueStream(const std::vector<Node>& enums,
                                              const std::vector<Node>& values)
 {
   Assert(d_master != nullptr);
-  // we have generated a solution, print it
-  // get the current output stream
-  Options& sopts = smt::currentSmtEngine()->getOptions();
-  printSynthSolution(*sopts.getOut());
+  SmtEngine* smte = smt::currentSmtEngine();
+  smt::SygusSolutionListener* sl = smte->getSygusSolutionListener();
+  if (sl != nullptr)
+  {
+    std::map<Node, std::map<Node, Node>> solMap;
+    if (getSynthSolutions(solMap) && sl->notifySolution(solMap[d_quant]))
+    {
+      Trace("cegqi-engine") << "...stream stopped by listener" << std::endl;
+      return true;
+    }
+  }
+  else
+  {
+    // we have generated a solution, print it
+    // get the current output stream
+    Options& sopts = smte->getOptions();
+    printSynthSolution(*sopts.getOut());
+  }
   excludeCurrentSolution(enums, values);
+  return false;
 }
 
 void SynthConjecture::excludeCurrentSolution(const std::vector<Node>& enums,
@@ -29,6 +29,7 @@
 #include "theory/quantifiers/sygus/example_infer.h"
 #include "theory/quantifiers/sygus/sygus_process_conj.h"
 #include "theory/quantifiers/sygus/sygus_repair_const.h"
+#include "theory/quantifiers/sygus/sygus_solution_cache.h"
 #include "theory/quantifiers/sygus/sygus_stats.h"
 #include "theory/quantifiers/sygus/template_infer.h"
 
@@ -198,6 +199,14 @@ class SynthConjecture
    * if it exists, and true otherwise.
    */
   bool checkSideCondition(const std::vector<Node>& cvals) const;
+  /**
+   * Check the satisfiability of the verification query of a candidate, and
+   * add the model values of vars to modelVals if it is satisfiable. This
+   * uses d_verifyChecker if --sygus-verify-inc is set.
+   */
+  Result checkVerification(Node query,
+                           const std::vector<Node>& vars,
+                           std::vector<Node>& modelVals);
 
   /** get a reference to the statistics of parent */
   SygusStatistics& getSygusStatistics() { return d_stats; };
@@ -397,10 +406,16 @@ class SynthConjecture
    * the Options object, send a lemma blocking the current solution to the
    * output channel, which we refer to as a "stream exclusion lemma".
    *
+   * If a sygus solution listener is registered with the SMT engine, the
+   * current solution is passed to it instead of being printed. If the
+   * listener accepts it, this method returns true and sends no exclusion
+   * lemma, and the current solution is the final one. Otherwise, this method
+   * returns false.
+   *
    * The argument enums is the set of enumerators that comprise the current
    * solution, and values is their current values.
    */
-  void printAndContinueStream(const std::vector<Node>& enums,
+  bool printAndContinueStream(const std::vector<Node>& enums,
                               const std::vector<Node>& values);
   /** exclude the current solution { enums -> values } */
   void excludeCurrentSolution(const std::vector<Node>& enums,
@@ -422,6 +437,29 @@ class SynthConjecture
    * rewrite rules.
    */
   std::map<Node, ExpressionMinerManager> d_exprm;
+  //-------------------------------- incremental verification
+  /**
+   * The subsolver for verifying candidates, if --sygus-verify-inc is set.
+   * Each verification query is asserted under a fresh selector literal that
+   * is assumed for its check and asserted false afterwards, so that the
+   * clauses learned by this subsolver are kept across candidates.
+   */
+  std::unique_ptr<SmtEngine> d_verifyChecker;
+  /**
+   * Map from the variables of the existential of the base instantiation to
+   * the skolems used for them in all verification queries, which are shared
+   * if --sygus-verify-inc is set.
+   */
+  std::map<Node, Node> d_verifySks;
+  //-------------------------------- end incremental verification
+  //-------------------------------- solution cache
+  /** The solution cache, if --sygus-solution-cache is set */
+  std::unique_ptr<SygusSolutionCache> d_solCache;
+  /** The key of this conjecture in the solution cache */
+  std::string d_solCacheKey;
+  /** Have we tried the solution of the cache for this conjecture? */
+  bool d_solCacheTried;
+  //-------------------------------- end solution cache
 };
 
 }  // namespace quantifiers
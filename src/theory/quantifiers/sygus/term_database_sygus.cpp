@@ -59,6 +59,10 @@ TermDbSygus::TermDbSygus(QuantifiersState& qs)
 {
   d_true = NodeManager::currentNM()->mkConst( true );
   d_false = NodeManager::currentNM()->mkConst( false );
+  if (options::sygusBuiltinCache() > 0)
+  {
+    d_builtinCache.reset(new SygusBuiltinCache(options::sygusBuiltinCache()));
+  }
 }
 
 void TermDbSygus::finishInit(QuantifiersInferenceManager* qim) { d_qim = qim; }
@@ -212,7 +216,9 @@ Node TermDbSygus::mkGeneric(const DType& dt,
     Assert(!a.isNull());
     children.push_back( a );
   }
-  Node ret = datatypes::utils::mkSygusTerm(dt, c, children, doBetaRed);
+  Node ret = doBetaRed && d_builtinCache != nullptr
+                 ? d_builtinCache->mkSygusTerm(dt, c, children)
+                 : datatypes::utils::mkSygusTerm(dt, c, children, doBetaRed);
   Trace("sygus-db-debug") << "mkGeneric returns " << ret << std::endl;
   return ret;
 }
@@ -300,9 +306,10 @@ typedef expr::Attribute<SygusToBuiltinAttributeId, Node>
 
 Node TermDbSygus::sygusToBuiltin(Node n, TypeNode tn)
 {
-  if (n.isConst())
+  if (n.isConst() && d_builtinCache == nullptr)
   {
-    // if its a constant, we use the datatype utility version
+    // if its a constant, we use the datatype utility version, otherwise we
+    // convert it below, where mkGeneric uses the builtin cache
     return datatypes::utils::sygusToBuiltin(n);
   }
   Assert(n.getType().isComparableTo(tn));
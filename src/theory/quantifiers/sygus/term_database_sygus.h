@@ -23,6 +23,7 @@
 #include "theory/evaluator.h"
 #include "theory/quantifiers/extended_rewrite.h"
 #include "theory/quantifiers/fun_def_evaluator.h"
+#include "theory/quantifiers/sygus/sygus_builtin_cache.h"
 #include "theory/quantifiers/sygus/sygus_eval_unfold.h"
 #include "theory/quantifiers/sygus/sygus_explain.h"
 #include "theory/quantifiers/sygus/type_info.h"
@@ -332,6 +333,11 @@ class TermDbSygus {
   std::unique_ptr<FunDefEvaluator> d_funDefEval;
   /** evaluation function unfolding utility */
   std::unique_ptr<SygusEvalUnfold> d_eval_unfold;
+  /**
+   * The cache of the builtin terms of sygus constructor applications, used by
+   * mkGeneric and sygusToBuiltin, or null if --sygus-builtin-cache=0.
+   */
+  std::unique_ptr<SygusBuiltinCache> d_builtinCache;
   //------------------------------end utilities
 
   //------------------------------enumerators
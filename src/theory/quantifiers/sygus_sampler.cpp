@@ -14,6 +14,8 @@
 
 #include "theory/quantifiers/sygus_sampler.h"
 
+#include <algorithm>
+#include <functional>
 #include <sstream>
 
 #include "expr/dtype.h"
@@ -35,7 +37,10 @@ namespace theory {
 namespace quantifiers {
 
 SygusSampler::SygusSampler()
-    : d_tds(nullptr), d_use_sygus_type(false), d_is_valid(false)
+    : d_tds(nullptr),
+      d_prepValid(false),
+      d_use_sygus_type(false),
+      d_is_valid(false)
 {
 }
 
@@ -473,8 +478,41 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   Assert(index < d_samples.size());
   // do beta-reductions in n first
   n = Rewriter::rewrite(n);
+  if (options::sygusEvalVec())
+  {
+    // the values of n on all sample points are computed at once, since n is
+    // typically evaluated on each of them in turn
+    if (n != d_vecTerm || d_vecValues.size() != d_samples.size())
+    {
+      d_vecTerm = n;
+      d_vecValues.clear();
+      if (!d_vecEval.compile(n, d_vars)
+          || !d_vecEval.evaluate(d_samples, d_vecValues))
+      {
+        d_vecValues.clear();
+      }
+    }
+    if (!d_vecValues.empty())
+    {
+      return d_vecValues[index];
+    }
+  }
+  // n is typically evaluated on each sample point in turn, so we prepare it
+  // once for evaluation on all of them
+  if (n != d_prepEval.getTerm())
+  {
+    d_prepValid = d_prepEval.prepare(n, d_vars);
+  }
+  Node ev;
+  if (d_prepValid)
+  {
+    ev = d_prepEval.eval(d_samples[index]);
+  }
   // use efficient rewrite for substitution + rewrite
-  Node ev = d_eval.eval(n, d_vars, d_samples[index]);
+  if (ev.isNull())
+  {
+    ev = d_eval.eval(n, d_vars, d_samples[index]);
+  }
   Trace("sygus-sample-ev") << "Evaluate ( " << n << ", " << index << " ) -> ";
   if (!ev.isNull())
   {
@@ -491,6 +529,24 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   return ev;
 }
 
+size_t SygusSampler::getSignatureHash(Node n, unsigned npts)
+{
+  if (!d_is_valid)
+  {
+    return 0;
+  }
+  Node bn = d_use_sygus_type ? d_tds->sygusToBuiltin(n) : n;
+  std::hash<std::string> shash;
+  size_t h = 0;
+  for (unsigned i = 0, nsamp = std::min<size_t>(npts, d_samples.size());
+       i < nsamp;
+       i++)
+  {
+    h = h * 31 + shash(evaluate(bn, i).toString());
+  }
+  return h;
+}
+
 int SygusSampler::getDiffSamplePointIndex(Node a, Node b)
 {
   for (unsigned i = 0, nsamp = d_samples.size(); i < nsamp; i++)
@@ -20,6 +20,7 @@
 #include <map>
 #include "theory/evaluator.h"
 #include "theory/quantifiers/lazy_trie.h"
+#include "theory/quantifiers/sygus/sygus_vec_eval.h"
 #include "theory/quantifiers/sygus/term_database_sygus.h"
 #include "theory/quantifiers/term_enumeration.h"
 
@@ -115,6 +116,12 @@ class SygusSampler : public LazyTrieEvaluator
   void addSamplePoint(std::vector<Node>& pt);
   /** evaluate n on sample point index */
   Node evaluate(Node n, unsigned index) override;
+  /**
+   * Get a hash of the values of n on the first npts sample points. Unlike
+   * node ids, this hash does not depend on the node manager, hence samplers
+   * with the same sample points in different solver instances agree on it.
+   */
+  size_t getSignatureHash(Node n, unsigned npts);
   /**
    * Compute the variables from the domain of d_var_index that occur in n,
    * store these in the vector fvs.
@@ -181,6 +188,19 @@ class SygusSampler : public LazyTrieEvaluator
   std::vector<std::vector<Node> > d_samples;
   /** evaluator class */
   Evaluator d_eval;
+  /** the prepared evaluation of the last term evaluated */
+  PreparedEvaluator d_prepEval;
+  /** whether the term of d_prepEval could be prepared */
+  bool d_prepValid;
+  /** evaluator of terms on all sample points, used if --sygus-eval-vec */
+  SygusVecEvaluator d_vecEval;
+  /** the last term evaluated by d_vecEval */
+  Node d_vecTerm;
+  /**
+   * The values of d_vecTerm on all sample points, which is empty if it could
+   * not be evaluated by d_vecEval.
+   */
+  std::vector<Node> d_vecValues;
   /** data structure to check duplication of sample points */
   class PtTrie
   {
@@ -46,6 +46,10 @@ TermDb::TermDb(QuantifiersState& qs, QuantifiersRegistry& qr)
       d_typeMap(d_termsContextUse),
       d_ops(d_termsContextUse),
       d_opMap(d_termsContextUse),
+      d_numMerges(0),
+      d_numUpdates(0),
+      d_stateVersion(qs.getSatContext(), 0),
+      d_resetVersion(0),
       d_inactive_map(qs.getSatContext())
 {
   d_consistent_ee = true;
@@ -206,6 +210,7 @@ Node TermDb::getMatchOperator( Node n ) {
 
 void TermDb::addTerm(Node n)
 {
+  notifyUpdate();
   if (d_processed.find(n) != d_processed.end())
   {
     return;
@@ -245,6 +250,49 @@ void TermDb::addTerm(Node n)
   }
 }
 
+void TermDb::eqNotifyMerge(TNode t1, TNode t2)
+{
+  Trace("term-db-debug") << "merge : " << t1 << " " << t2 << std::endl;
+  d_numMerges++;
+  notifyUpdate();
+}
+
+void TermDb::notifyUpdate()
+{
+  d_numUpdates++;
+  d_stateVersion = d_numUpdates;
+}
+
+void TermDb::clearTermIndices(bool reuse)
+{
+  d_arg_reps.clear();
+  if (!reuse)
+  {
+    d_op_nonred_count.clear();
+    d_func_map_trie.clear();
+    d_func_map_eqc_trie.clear();
+    d_func_map_rel_dom.clear();
+    d_op_computed_size.clear();
+    return;
+  }
+  std::map<Node, size_t>::iterator it = d_op_computed_size.begin();
+  while (it != d_op_computed_size.end())
+  {
+    Node f = it->first;
+    if (getNumGroundTerms(f) == it->second)
+    {
+      Trace("term-db-reuse") << "Reuse term indices of " << f << std::endl;
+      ++it;
+      continue;
+    }
+    d_op_nonred_count.erase(f);
+    d_func_map_trie.erase(f);
+    d_func_map_eqc_trie.erase(f);
+    d_func_map_rel_dom.erase(f);
+    it = d_op_computed_size.erase(it);
+  }
+}
+
 DbList* TermDb::getOrMkDbListForType(TypeNode tn)
 {
   TypeNodeDbListMap::iterator it = d_typeMap.find(tn);
@@ -290,6 +338,7 @@ void TermDb::computeUfEqcTerms( TNode f ) {
     return;
   }
   d_func_map_eqc_trie[f].clear();
+  d_op_computed_size[f] = getNumGroundTerms(f);
   // get the matchable operators in the equivalence class of f
   std::vector<TNode> ops;
   ops.push_back(f);
@@ -321,6 +370,7 @@ void TermDb::computeUfTerms( TNode f ) {
   }
   Assert(f == getOperatorRepresentative(f));
   d_op_nonred_count[f] = 0;
+  d_op_computed_size[f] = getNumGroundTerms(f);
   // get the matchable operators in the equivalence class of f
   std::vector<TNode> ops;
   ops.push_back(f);
@@ -1002,11 +1052,13 @@ void TermDb::presolve() {
 }
 
 bool TermDb::reset( Theory::Effort effort ){
-  d_op_nonred_count.clear();
-  d_arg_reps.clear();
-  d_func_map_trie.clear();
-  d_func_map_eqc_trie.clear();
-  d_func_map_rel_dom.clear();
+  // the term indices only depend on the state of the equality engine and the
+  // terms of the operators (and on relevance and higher-order operators)
+  bool reuse = options::termDbReuse() && d_consistent_ee
+               && d_stateVersion.get() == d_resetVersion && !options::ufHo()
+               && options::termDbMode() != options::TermDbMode::RELEVANT;
+  d_resetVersion = d_stateVersion.get();
+  clearTermIndices(reuse);
   d_consistent_ee = true;
 
   eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
@@ -1089,7 +1141,7 @@ bool TermDb::reset( Theory::Effort effort ){
       {
         continue;
       }
-      for (context::CDList<Assertion>::const_iterator
+      for (context::CDChunkList<Assertion>::const_iterator
                it = d_qstate.factsBegin(theoryId),
                it_end = d_qstate.factsEnd(theoryId);
            it != it_end;
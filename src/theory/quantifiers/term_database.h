@@ -22,6 +22,7 @@
 
 #include "context/cdhashmap.h"
 #include "context/cdhashset.h"
+#include "context/cdo.h"
 #include "expr/attribute.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/quant_util.h"
@@ -62,6 +63,13 @@ class DbList
  * This initializes the database for the round. However,
  * notice that TNodeTrie objects are computed
  * lazily for performance reasons.
+ *
+ * If the option --term-db-reuse is enabled, the TNodeTrie objects of an
+ * operator are kept by reset(...) if the state of the equality engine and the
+ * list of terms of the operator did not change since the previous round. The
+ * state is given by a context-dependent version, which is set to a new value
+ * whenever a term is added or two classes are merged. Since it is restored
+ * on backtracking, an equal version means the same merges and terms.
  */
 class TermDb : public QuantifiersUtil {
   using NodeBoolMap = context::CDHashMap<Node, bool, NodeHashFunction>;
@@ -124,6 +132,23 @@ class TermDb : public QuantifiersUtil {
    * matched with via E-matching, and can be used in entailment tests below.
    */
   void addTerm(Node n);
+  /**
+   * Notification when the equivalence classes of t1 and t2 are merged in the
+   * master equality engine.
+   */
+  void eqNotifyMerge(TNode t1, TNode t2);
+  /**
+   * Get the number of merges notified so far. This counter is not context
+   * dependent, it is used to check that no merge happened since a previous
+   * instantiation round.
+   */
+  uint64_t getNumMerges() const { return d_numMerges; }
+  /**
+   * Get the version of the state of the term database and the master
+   * equality engine, which changes whenever a term is added or two classes
+   * are merged, and is restored on backtracking.
+   */
+  uint64_t getStateVersion() const { return d_stateVersion.get(); }
   /** Get the currently added ground terms of the given type */
   DbList* getOrMkDbListForType(TypeNode tn);
   /** Get the currently added ground terms for the given operator */
@@ -311,6 +336,29 @@ class TermDb : public QuantifiersUtil {
   std::map< Node, std::map< TypeNode, Node > > d_par_op_map;
   /** whether master equality engine is UF-inconsistent */
   bool d_consistent_ee;
+  /** the number of merges notified so far */
+  uint64_t d_numMerges;
+  /** the number of updates (merges or additions of terms) so far */
+  uint64_t d_numUpdates;
+  /**
+   * The version of the state, which is the number of the last update in the
+   * current context.
+   */
+  context::CDO<uint64_t> d_stateVersion;
+  /** the version of the state at the last call to reset */
+  uint64_t d_resetVersion;
+  /** Notification of an update, which sets a new version of the state */
+  void notifyUpdate();
+  /**
+   * Map from operators to the number of their terms when their term indices
+   * were computed, used for reusing them, see --term-db-reuse.
+   */
+  std::map<Node, size_t> d_op_computed_size;
+  /**
+   * Clear the term indices of the previous round, except the ones that can be
+   * reused if reuse is true.
+   */
+  void clearTermIndices(bool reuse);
   /** boolean terms */
   Node d_true;
   Node d_false;
@@ -18,6 +18,7 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <unordered_set>
 #include <vector>
 
 #include "base/map_util.h"
@@ -114,6 +115,11 @@ class TermTupleEnumeratorBase : public TermTupleEnumeratorInterface
   std::vector<TypeNode> d_typeCache;
   /** number of candidate terms for each variable */
   std::vector<size_t> d_termsSizes;
+  /**
+   * The candidate terms of each variable in the order they are enumerated, if
+   * they are ordered by cost or by relevant domain (see orderTerms).
+   */
+  std::vector<std::vector<Node>> d_orderedTerms;
   /** tuple of indices of the current terms */
   std::vector<size_t> d_termIndex;
   /** total number of steps of the enumerator */
@@ -154,6 +160,18 @@ class TermTupleEnumeratorBase : public TermTupleEnumeratorInterface
   /** Get a given term for a given variable.  */
   virtual Node getTerm(size_t variableIx,
                        size_t term_index) CVC4_WARN_UNUSED_RESULT = 0;
+  /**
+   * Whether term t is in the relevant domain of a given variable, where these
+   * terms are enumerated first if TermTupleEnumeratorEnv::d_rdOrder is set.
+   */
+  virtual bool isRelevant(size_t variableIx, Node t) { return true; }
+  /**
+   * Order the terms of a given variable by relevance and cost, and skip the
+   * terms whose cost exceeds the cost bound, and return their number.
+   */
+  size_t orderTerms(size_t variableIx, size_t termsSize);
+  /** Get the cost of term t, the product of its size and depth. */
+  static uint64_t getCost(Node t);
 };
 
 /**
@@ -177,6 +195,9 @@ class TermTupleEnumeratorBasic : public TermTupleEnumeratorBase
   std::map<TypeNode, std::vector<Node> > d_termDbList;
   virtual size_t prepareTerms(size_t variableIx) override;
   virtual Node getTerm(size_t variableIx, size_t term_index) override;
+  virtual bool isRelevant(size_t variableIx, Node t) override;
+  /** the representatives of the relevant domain of each variable */
+  std::map<size_t, std::unordered_set<Node, NodeHashFunction>> d_rdReps;
   /** Reference to quantifiers state */
   QuantifiersState& d_qs;
   /** Pointer to term database */
@@ -229,7 +250,11 @@ void TermTupleEnumeratorBase::init()
   for (size_t variableIx = 0; variableIx < d_variableCount; variableIx++)
   {
     d_typeCache.push_back(d_quantifier[0][variableIx].getType());
-    const size_t termsSize = prepareTerms(variableIx);
+    size_t termsSize = prepareTerms(variableIx);
+    if (d_env->d_costBound > 0 || d_env->d_rdOrder != nullptr)
+    {
+      termsSize = orderTerms(variableIx, termsSize);
+    }
     Trace("inst-alg-rd") << "Variable " << variableIx << " has " << termsSize
                          << " in relevant domain." << std::endl;
     if (termsSize == 0 && !d_env->d_fullEffort)
@@ -285,9 +310,13 @@ void TermTupleEnumeratorBase::next(/*out*/ std::vector<Node>& terms)
   terms.resize(d_variableCount);
   for (size_t variableIx = 0; variableIx < d_variableCount; variableIx++)
   {
-    const Node t = d_termsSizes[variableIx] == 0
-                       ? Node::null()
-                       : getTerm(variableIx, d_termIndex[variableIx]);
+    Node t;
+    if (d_termsSizes[variableIx] > 0)
+    {
+      t = d_orderedTerms.empty()
+              ? getTerm(variableIx, d_termIndex[variableIx])
+              : d_orderedTerms[variableIx][d_termIndex[variableIx]];
+    }
     terms[variableIx] = t;
     Trace("inst-alg-rd") << t << "  ";
     Assert(terms[variableIx].isNull()
@@ -297,6 +326,62 @@ void TermTupleEnumeratorBase::next(/*out*/ std::vector<Node>& terms)
   Trace("inst-alg-rd") << std::endl;
 }
 
+size_t TermTupleEnumeratorBase::orderTerms(size_t variableIx,
+                                           size_t termsSize)
+{
+  d_orderedTerms.resize(d_variableCount);
+  // the terms with their relevance and cost, which are stably sorted to keep
+  // the order of the terms with the same key
+  std::vector<std::pair<std::pair<bool, uint64_t>, Node>> keyed;
+  for (size_t i = 0; i < termsSize; i++)
+  {
+    Node t = getTerm(variableIx, i);
+    uint64_t cost = 0;
+    if (d_env->d_costBound > 0)
+    {
+      cost = getCost(t);
+      if (cost > d_env->d_costBound)
+      {
+        continue;
+      }
+    }
+    bool irrelevant =
+        d_env->d_rdOrder != nullptr && !isRelevant(variableIx, t);
+    keyed.emplace_back(std::make_pair(irrelevant, cost), t);
+  }
+  std::stable_sort(keyed.begin(),
+                   keyed.end(),
+                   [](const std::pair<std::pair<bool, uint64_t>, Node>& a,
+                      const std::pair<std::pair<bool, uint64_t>, Node>& b) {
+                     return a.first < b.first;
+                   });
+  std::vector<Node>& terms = d_orderedTerms[variableIx];
+  for (const std::pair<std::pair<bool, uint64_t>, Node>& k : keyed)
+  {
+    terms.push_back(k.second);
+  }
+  Trace("inst-alg-rd") << "Ordered terms for child " << variableIx << ": "
+                       << terms << std::endl;
+  return terms.size();
+}
+
+uint64_t TermTupleEnumeratorBase::getCost(Node t)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit{t};
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (visited.insert(cur).second)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  }
+  uint64_t depth = static_cast<uint64_t>(TermUtil::getTermDepth(t)) + 1;
+  return visited.size() * depth;
+}
+
 bool TermTupleEnumeratorBase::increaseStageSum()
 {
   const size_t lowerBound = d_currentStage + 1;
@@ -490,6 +575,25 @@ Node TermTupleEnumeratorBasic::getTerm(size_t variableIx, size_t term_index)
   return d_termDbList[type_node][term_index];
 }
 
+bool TermTupleEnumeratorBasic::isRelevant(size_t variableIx, Node t)
+{
+  Assert(d_env->d_rdOrder != nullptr);
+  std::map<size_t, std::unordered_set<Node, NodeHashFunction>>::iterator it =
+      d_rdReps.find(variableIx);
+  if (it == d_rdReps.end())
+  {
+    std::unordered_set<Node, NodeHashFunction>& reps = d_rdReps[variableIx];
+    RelevantDomain::RDomain* rd =
+        d_env->d_rdOrder->getRDomain(d_quantifier, variableIx);
+    for (const Node& rt : rd->d_terms)
+    {
+      reps.insert(d_qs.getRepresentative(rt));
+    }
+    it = d_rdReps.find(variableIx);
+  }
+  return it->second.find(d_qs.getRepresentative(t)) != it->second.end();
+}
+
 TermTupleEnumeratorInterface* mkTermTupleEnumerator(
     Node q, const TermTupleEnumeratorEnv* env, QuantifiersState& qs, TermDb* td)
 {
@@ -62,6 +62,17 @@ struct TermTupleEnumeratorEnv
   bool d_fullEffort;
   /** Whether we increase tuples based on sum instead of max (see below) */
   bool d_increaseSum;
+  /**
+   * If non-zero, the terms of each variable are enumerated by increasing cost,
+   * which is the product of their size and depth, and the terms whose cost
+   * exceeds this bound are skipped.
+   */
+  uint64_t d_costBound;
+  /**
+   * If non-null, the terms of each variable whose representative is the one
+   * of a term in its relevant domain are enumerated before the others.
+   */
+  RelevantDomain* d_rdOrder;
 };
 
 /**  A function to construct a tuple enumerator.
@@ -81,7 +92,8 @@ struct TermTupleEnumeratorEnv
  *
  * In this method, the returned enumerator draws ground terms from the term
  * database (provided by td). The quantifiers state (qs) is used to eliminate
- * duplicates modulo equality.
+ * duplicates modulo equality, and to order the terms by their relevant domain
+ * if TermTupleEnumeratorEnv::d_rdOrder is set.
  */
 TermTupleEnumeratorInterface* mkTermTupleEnumerator(
     Node q,
@@ -20,6 +20,7 @@
 #include "options/uf_options.h"
 #include "smt/smt_engine_scope.h"
 #include "theory/quantifiers/equality_query.h"
+#include "theory/quantifiers/extended_rewrite_cache.h"
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers/fmf/first_order_model_fmc.h"
 #include "theory/quantifiers/fmf/full_model_check.h"
@@ -33,7 +34,9 @@
 #include "theory/quantifiers/quantifiers_statistics.h"
 #include "theory/quantifiers/relevant_domain.h"
 #include "theory/quantifiers/skolemize.h"
+#include "theory/quantifiers/term_database.h"
 #include "theory/quantifiers/term_registry.h"
+#include "theory/rewriter.h"
 #include "theory/theory_engine.h"
 
 using namespace std;
@@ -111,6 +114,7 @@ quantifiers::TermDbSygus* QuantifiersEngine::getTermDatabaseSygus() const
 void QuantifiersEngine::presolve() {
   Trace("quant-engine-proc") << "QuantifiersEngine : presolve " << std::endl;
   d_qim.clearPending();
+  d_qim.getInstantiate()->notifyFlushLemmas();
   for( unsigned i=0; i<d_modules.size(); i++ ){
     d_modules[i]->presolve();
   }
@@ -252,6 +256,12 @@ void QuantifiersEngine::check( Theory::Effort e ){
       d_te->printAssertions("quant-engine-assert");
     }
 
+    if (!options::extRewriteCachePersist())
+    {
+      // the results of extended rewriting are only cached within a round
+      Rewriter::getExtRewriteCache()->clear();
+    }
+
     //reset utilities
     Trace("quant-engine-debug") << "Resetting all utilities..." << std::endl;
     for (QuantifiersUtil*& util : d_util)
@@ -599,6 +609,11 @@ void QuantifiersEngine::assertQuantifier( Node f, bool pol ){
 
 void QuantifiersEngine::eqNotifyNewClass(TNode t) { d_treg.addTerm(t); }
 
+void QuantifiersEngine::eqNotifyMerge(TNode t1, TNode t2)
+{
+  d_treg.getTermDatabase()->eqNotifyMerge(t1, t2);
+}
+
 void QuantifiersEngine::markRelevant( Node q ) {
   d_model->markRelevant( q );
 }
@@ -611,6 +626,12 @@ void QuantifiersEngine::getInstantiationTermVectors( std::map< Node, std::vector
   d_qim.getInstantiate()->getInstantiationTermVectors(insts);
 }
 
+void QuantifiersEngine::notifyRelevantInstantiations(
+    const std::map<Node, std::vector<std::vector<Node>>>& insts)
+{
+  d_qim.getInstantiate()->notifyRelevantInstantiations(insts);
+}
+
 void QuantifiersEngine::getInstantiations(Node q, std::vector<Node>& insts)
 {
   d_qim.getInstantiate()->getInstantiations(q, insts);
@@ -119,6 +119,8 @@ private:
 public:
  /** notification when master equality engine is updated */
  void eqNotifyNewClass(TNode t);
+ /** notification when two classes are merged in the master equality engine */
+ void eqNotifyMerge(TNode t1, TNode t2);
  /** mark relevant quantified formula, this will indicate it should be checked
   * before the others */
  void markRelevant(Node q);
@@ -144,6 +146,12 @@ public:
                                   std::vector<std::vector<Node> >& tvecs);
  void getInstantiationTermVectors(
      std::map<Node, std::vector<std::vector<Node> > >& insts);
+ /**
+  * Notify the instantiations of each quantified formula that occur in the
+  * proof of an unsatisfiable result, for the profile of --quant-profile.
+  */
+ void notifyRelevantInstantiations(
+     const std::map<Node, std::vector<std::vector<Node>>>& insts);
  /**
   * Get instantiations for quantified formula q. If q is (forall ((x T)) (P x)),
   * this is a list of the form (P t1) ... (P tn) for ground terms ti.
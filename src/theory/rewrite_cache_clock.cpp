@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file rewrite_cache_clock.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief CLOCK eviction for a size-bounded rewrite cache.
+ **/
+
+#include "theory/rewrite_cache_clock.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+#include "base/output.h"
+
+namespace cvc5 {
+namespace theory {
+
+RewriteCacheClock::RewriteCacheClock(size_t budget,
+                                     EvictFn evict,
+                                     StatisticsRegistry& stats)
+    : d_capacity(std::max(budget / s_bytesPerEntry, size_t(1))),
+      d_evict(evict),
+      d_hand(0),
+      d_registry(stats),
+      d_hits("theory::Rewriter::cacheHits", 0),
+      d_misses("theory::Rewriter::cacheMisses", 0),
+      d_evictions("theory::Rewriter::cacheEvictions", 0)
+{
+  d_registry.registerStat(&d_hits);
+  d_registry.registerStat(&d_misses);
+  d_registry.registerStat(&d_evictions);
+}
+
+RewriteCacheClock::~RewriteCacheClock()
+{
+  d_registry.unregisterStat(&d_hits);
+  d_registry.unregisterStat(&d_misses);
+  d_registry.unregisterStat(&d_evictions);
+}
+
+void RewriteCacheClock::notifyLookup(bool pre,
+                                     TheoryId tid,
+                                     TNode node,
+                                     bool found)
+{
+  if (!found)
+  {
+    ++d_misses;
+    return;
+  }
+  ++d_hits;
+  std::unordered_map<Key, size_t, KeyHashFunction>::iterator it =
+      d_index.find(mkKey(pre, tid, node));
+  // entries set before the last clear() are not tracked
+  if (it != d_index.end())
+  {
+    d_slots[it->second].d_referenced = true;
+  }
+}
+
+void RewriteCacheClock::notifyInsert(bool pre, TheoryId tid, TNode node)
+{
+  Key key = mkKey(pre, tid, node);
+  std::unordered_map<Key, size_t, KeyHashFunction>::iterator it =
+      d_index.find(key);
+  if (it != d_index.end())
+  {
+    d_slots[it->second].d_referenced = true;
+    return;
+  }
+  if (d_slots.size() < d_capacity)
+  {
+    d_index[key] = d_slots.size();
+    d_slots.push_back(Slot{node, tid, pre, true});
+    return;
+  }
+  // advance the hand to the first unreferenced slot, which terminates after
+  // at most one round since we clear the marks on the way
+  while (d_slots[d_hand].d_referenced)
+  {
+    d_slots[d_hand].d_referenced = false;
+    d_hand = (d_hand + 1) % d_capacity;
+  }
+  Slot& victim = d_slots[d_hand];
+  Trace("rewrite-cache-clock")
+      << "evict " << (victim.d_pre ? "pre" : "post") << "-rewrite of "
+      << victim.d_node << std::endl;
+  d_index.erase(mkKey(victim.d_pre, victim.d_tid, victim.d_node));
+  d_evict(victim.d_pre, victim.d_tid, victim.d_node);
+  ++d_evictions;
+  victim.d_node = node;
+  victim.d_tid = tid;
+  victim.d_pre = pre;
+  victim.d_referenced = true;
+  d_index[key] = d_hand;
+  d_hand = (d_hand + 1) % d_capacity;
+}
+
+void RewriteCacheClock::clear()
+{
+  d_slots.clear();
+  d_index.clear();
+  d_hand = 0;
+}
+
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,140 @@
+/*********************                                                        */
+/*! \file rewrite_cache_clock.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief CLOCK eviction for a size-bounded rewrite cache.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__REWRITE_CACHE_CLOCK_H
+#define CVC4__THEORY__REWRITE_CACHE_CLOCK_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "theory/theory_id.h"
+#include "util/statistics_registry.h"
+#include "util/stats_base.h"
+
+namespace cvc5 {
+namespace theory {
+
+/**
+ * Keeps track of the entries of the rewrite caches of a Rewriter, and evicts
+ * entries with the CLOCK algorithm (an approximation of LRU) once there are
+ * more than a given number of them.
+ *
+ * Each entry is identified by a node, a theory and whether it is an entry of
+ * the pre- or the post-rewrite cache. Entries are kept in a ring of slots.
+ * An entry is marked as referenced when it is inserted or hit. To make room
+ * for a new entry, the clock hand sweeps the ring, clearing the mark of
+ * referenced entries, and evicts the first unreferenced one.
+ *
+ * The entries themselves live in node attributes; evicting an entry calls
+ * the eviction callback, which is responsible for removing it.
+ */
+class RewriteCacheClock
+{
+ public:
+  /** The callback for evicting the given entry */
+  using EvictFn = std::function<void(bool pre, TheoryId tid, TNode node)>;
+
+  /**
+   * An estimate of the memory used per entry in bytes, taking into account
+   * the slot, the index and the attribute table entry.
+   */
+  static constexpr size_t s_bytesPerEntry = 128;
+
+  /**
+   * @param budget The budget of the rewrite caches in bytes
+   * @param evict The eviction callback
+   * @param stats The registry for the statistics of this class
+   */
+  RewriteCacheClock(size_t budget, EvictFn evict, StatisticsRegistry& stats);
+  ~RewriteCacheClock();
+
+  /** Notify that the given entry was looked up, and whether it was found */
+  void notifyLookup(bool pre, TheoryId tid, TNode node, bool found);
+
+  /**
+   * Notify that the given entry was set, which may evict another entry.
+   * Entries that are set again are only marked as referenced.
+   */
+  void notifyInsert(bool pre, TheoryId tid, TNode node);
+
+  /** Forget all entries, without evicting them */
+  void clear();
+
+ private:
+  /** A slot of the ring */
+  struct Slot
+  {
+    /** The node of the entry, which we keep alive while it is cached */
+    Node d_node;
+    /** The theory of the entry */
+    TheoryId d_tid;
+    /** Whether this is an entry of the pre-rewrite cache */
+    bool d_pre;
+    /** Whether the entry was referenced since the hand last passed */
+    bool d_referenced;
+  };
+  /** The key of an entry in the index */
+  struct Key
+  {
+    /** The id of the node */
+    uint64_t d_id;
+    /** The theory and whether it is a pre-rewrite entry */
+    uint32_t d_tag;
+    bool operator==(const Key& k) const
+    {
+      return d_id == k.d_id && d_tag == k.d_tag;
+    }
+  };
+  struct KeyHashFunction
+  {
+    size_t operator()(const Key& k) const
+    {
+      return static_cast<size_t>(k.d_id * 2 * THEORY_LAST + k.d_tag);
+    }
+  };
+  /** The key of the given entry */
+  static Key mkKey(bool pre, TheoryId tid, TNode node)
+  {
+    return Key{node.getId(), static_cast<uint32_t>(tid) * 2 + (pre ? 1 : 0)};
+  }
+
+  /** The maximal number of entries */
+  size_t d_capacity;
+  /** The eviction callback */
+  EvictFn d_evict;
+  /** The ring of slots */
+  std::vector<Slot> d_slots;
+  /** Maps entries to their slot */
+  std::unordered_map<Key, size_t, KeyHashFunction> d_index;
+  /** The clock hand, the next slot to consider for eviction */
+  size_t d_hand;
+
+  /** The registry of the statistics */
+  StatisticsRegistry& d_registry;
+  /** The number of lookups that found an entry */
+  IntStat d_hits;
+  /** The number of lookups that did not find an entry */
+  IntStat d_misses;
+  /** The number of evicted entries */
+  IntStat d_evictions;
+};
+
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__REWRITE_CACHE_CLOCK_H */
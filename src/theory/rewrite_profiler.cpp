@@ -0,0 +1,136 @@
+/*********************                                                        */
+/*! \file rewrite_profiler.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Profiling of the rewrite rules of the theory rewriters
+ **/
+
+#include "theory/rewrite_profiler.h"
+
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+#include "base/check.h"
+#include "theory/rewriter.h"
+
+namespace cvc5 {
+namespace theory {
+
+namespace {
+
+/** Get the number of distinct subterms of n */
+int64_t getDagSize(TNode n)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (visited.insert(cur).second)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  } while (!visit.empty());
+  return static_cast<int64_t>(visited.size());
+}
+
+}  // namespace
+
+RewriteProfiler::RuleStats::RuleStats(const std::string& name, bool timed)
+    : d_fires(name + "::fires", 0),
+      d_sizeReduction(name + "::sizeReduction", 0),
+      d_time(name + "::time"),
+      d_timed(timed)
+{
+}
+
+RewriteProfiler::RewriteProfiler(StatisticsRegistry& stats)
+    : d_registry(stats)
+{
+  for (size_t i = 0; i < THEORY_LAST; i++)
+  {
+    d_theoryStats[i][0] = nullptr;
+    d_theoryStats[i][1] = nullptr;
+  }
+}
+
+RewriteProfiler::~RewriteProfiler()
+{
+  for (std::pair<const std::string, std::unique_ptr<RuleStats>>& r : d_rules)
+  {
+    d_registry.unregisterStat(&r.second->d_fires);
+    d_registry.unregisterStat(&r.second->d_sizeReduction);
+    if (r.second->d_timed)
+    {
+      d_registry.unregisterStat(&r.second->d_time);
+    }
+  }
+}
+
+RewriteProfiler::RuleStats& RewriteProfiler::getRuleStats(
+    const std::string& theory, const std::string& rule, bool timed)
+{
+  std::string name = "rewriteProfile::" + theory + "::" + rule;
+  std::unique_ptr<RuleStats>& rs = d_rules[name];
+  if (rs == nullptr)
+  {
+    rs.reset(new RuleStats(name, timed));
+    d_registry.registerStat(&rs->d_fires);
+    d_registry.registerStat(&rs->d_sizeReduction);
+    if (timed)
+    {
+      d_registry.registerStat(&rs->d_time);
+    }
+  }
+  Assert(rs->d_timed || !timed);
+  return *rs;
+}
+
+RewriteProfiler::RuleStats& RewriteProfiler::getTheoryStats(TheoryId tid,
+                                                            bool pre)
+{
+  RuleStats*& rs = d_theoryStats[tid][pre ? 0 : 1];
+  if (rs == nullptr)
+  {
+    std::stringstream ss;
+    ss << tid;
+    rs = &getRuleStats(ss.str(), pre ? "preRewrite" : "postRewrite", true);
+  }
+  return *rs;
+}
+
+void RewriteProfiler::notifyRewrite(RuleStats& rs, TNode n, TNode ret)
+{
+  if (ret.isNull() || ret == n)
+  {
+    return;
+  }
+  ++rs.d_fires;
+  rs.d_sizeReduction += getDagSize(n) - getDagSize(ret);
+}
+
+void RewriteProfiler::notifyRule(const std::string& theory,
+                                 const std::string& rule,
+                                 TNode n,
+                                 TNode ret)
+{
+  RewriteProfiler* rp = Rewriter::getProfiler();
+  if (rp != nullptr)
+  {
+    rp->notifyRewrite(rp->getRuleStats(theory, rule), n, ret);
+  }
+}
+
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,104 @@
+/*********************                                                        */
+/*! \file rewrite_profiler.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Profiling of the rewrite rules of the theory rewriters
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__REWRITE_PROFILER_H
+#define CVC4__THEORY__REWRITE_PROFILER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "expr/node.h"
+#include "theory/theory_id.h"
+#include "util/statistics_registry.h"
+#include "util/stats_base.h"
+#include "util/stats_timer.h"
+
+namespace cvc5 {
+namespace theory {
+
+/**
+ * Collects, for each rewrite rule of the theory rewriters, the number of
+ * times it fired, the total reduction of the DAG size of the rewritten terms
+ * and, for the rules that are timed, the time spent in applying it. The
+ * statistics of a rule are registered when it first fires, under the names
+ * rewriteProfile::<theory>::<rule>::{fires,sizeReduction,time}.
+ *
+ * In addition, the pre- and post-rewrite calls of the Rewriter are profiled
+ * for each theory as the rules "preRewrite" and "postRewrite", which covers
+ * the theory rewriters that do not name their rules.
+ *
+ * The profiler of the rewriter in scope is obtained by
+ * Rewriter::getProfiler(), which returns nullptr unless --rewrite-profile is
+ * set.
+ */
+class RewriteProfiler
+{
+ public:
+  /** The statistics of a rewrite rule */
+  struct RuleStats
+  {
+    RuleStats(const std::string& name, bool timed);
+    /** The number of times the rule changed a term */
+    IntStat d_fires;
+    /** The sum of the DAG sizes of the terms minus those of their results */
+    IntStat d_sizeReduction;
+    /** The time spent applying the rule, if it is timed */
+    TimerStat d_time;
+    /** Whether d_time is registered */
+    bool d_timed;
+  };
+
+  RewriteProfiler(StatisticsRegistry& stats);
+  ~RewriteProfiler();
+
+  /**
+   * Get the statistics of the given rule of the given theory, which are
+   * registered on the first call. If timed is true, the time statistic of the
+   * rule is registered, which the caller is responsible for updating.
+   */
+  RuleStats& getRuleStats(const std::string& theory,
+                          const std::string& rule,
+                          bool timed = false);
+  /** Get the statistics of the pre- or post-rewrite calls for theory tid */
+  RuleStats& getTheoryStats(TheoryId tid, bool pre);
+  /**
+   * Record that the rule of rs rewrote n to ret. Nothing is recorded if ret
+   * is n or null.
+   */
+  void notifyRewrite(RuleStats& rs, TNode n, TNode ret);
+  /**
+   * Record that the given rule of the given theory rewrote n to ret, if the
+   * rewriter in scope has a profiler.
+   */
+  static void notifyRule(const std::string& theory,
+                         const std::string& rule,
+                         TNode n,
+                         TNode ret);
+
+ private:
+  /** The statistics registry */
+  StatisticsRegistry& d_registry;
+  /** Maps the qualified names of the rules to their statistics */
+  std::unordered_map<std::string, std::unique_ptr<RuleStats>> d_rules;
+  /** The statistics of the pre- (index 0) and post-rewrite calls */
+  RuleStats* d_theoryStats[THEORY_LAST][2];
+};
+
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__REWRITE_PROFILER_H */
@@ -18,11 +18,16 @@
 #include "theory/rewriter.h"
 
 #include "expr/term_conversion_proof_generator.h"
+#include "options/quantifiers_options.h"
 #include "options/theory_options.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/builtin/proof_checker.h"
+#include "theory/persistent_rewrite_cache.h"
+#include "theory/quantifiers/extended_rewrite_cache.h"
+#include "theory/rewrite_cache_clock.h"
+#include "theory/rewrite_profiler.h"
 #include "theory/rewriter_tables.h"
 #include "theory/theory.h"
 #include "util/resource_manager.h"
@@ -59,17 +64,36 @@ static TheoryId theoryOf(TNode node) {
  */
 struct RewriteStackElement {
   /**
-   * Construct a fresh stack element.
+   * Construct an unused stack element, see init().
    */
-  RewriteStackElement(TNode node, TheoryId theoryId)
-      : d_node(node),
-        d_original(node),
-        d_theoryId(theoryId),
-        d_originalTheoryId(theoryId),
+  RewriteStackElement()
+      : d_theoryId(THEORY_BUILTIN),
+        d_originalTheoryId(THEORY_BUILTIN),
         d_nextChild(0)
   {
   }
 
+  /** Start rewriting node with the given theory */
+  void init(TNode node, TheoryId theoryId)
+  {
+    d_node = node;
+    d_original = node;
+    d_theoryId = theoryId;
+    d_originalTheoryId = theoryId;
+    d_nextChild = 0;
+  }
+
+  /**
+   * Release the nodes held by this element, so that it can be reused without
+   * keeping them alive.
+   */
+  void release()
+  {
+    d_node = Node::null();
+    d_original = Node::null();
+    d_builder.clear();
+  }
+
   TheoryId getTheoryId() { return static_cast<TheoryId>(d_theoryId); }
 
   TheoryId getOriginalTheoryId()
@@ -92,11 +116,72 @@ struct RewriteStackElement {
   NodeBuilder<> d_builder;
 };
 
+/**
+ * The stack of one call to Rewriter::rewriteTo. Its elements are taken from
+ * the arena of the rewriter, on top of the elements of the enclosing calls,
+ * so that the elements and their node builders are allocated only once and
+ * then reused by all later rewrites.
+ */
+class RewriteStack
+{
+ public:
+  RewriteStack(std::vector<std::unique_ptr<RewriteStackElement>>& arena,
+               size_t& top)
+      : d_arena(arena), d_top(top), d_base(top)
+  {
+  }
+  ~RewriteStack()
+  {
+    // only non-empty if rewriting was aborted by an exception
+    while (d_top > d_base)
+    {
+      pop();
+    }
+  }
+
+  /** Push an element for rewriting node with the given theory */
+  void push(TNode node, TheoryId theoryId)
+  {
+    if (d_top == d_arena.size())
+    {
+      d_arena.emplace_back(new RewriteStackElement());
+    }
+    d_arena[d_top++]->init(node, theoryId);
+  }
+  /** Pop the top element */
+  void pop()
+  {
+    Assert(d_top > d_base);
+    d_arena[--d_top]->release();
+  }
+  /** The number of elements of this stack */
+  size_t size() const { return d_top - d_base; }
+  /**
+   * The element at the given depth from the top. References to elements stay
+   * valid until they are popped.
+   */
+  RewriteStackElement& fromTop(size_t depth)
+  {
+    Assert(depth < size());
+    return *d_arena[d_top - 1 - depth];
+  }
+
+ private:
+  /** The arena of stack elements */
+  std::vector<std::unique_ptr<RewriteStackElement>>& d_arena;
+  /** The number of elements in use in the arena */
+  size_t& d_top;
+  /** The number of elements in use by the enclosing calls */
+  size_t d_base;
+};
+
 RewriteResponse identityRewrite(RewriteEnvironment* re, TNode n)
 {
   return RewriteResponse(REWRITE_DONE, n);
 }
 
+Rewriter::~Rewriter() {}
+
 Node Rewriter::rewrite(TNode node) {
   if (node.getNumChildren() == 0)
   {
@@ -104,7 +189,201 @@ Node Rewriter::rewrite(TNode node) {
     // eagerly for the sake of efficiency here.
     return node;
   }
-  return getInstance()->rewriteTo(theoryOf(node), node);
+  Rewriter* r = getInstance();
+  PersistentRewriteCache* pc = r->getPersistentCache();
+  if (pc != nullptr)
+  {
+    return r->rewriteWithPersistentCache(theoryOf(node), node, pc);
+  }
+  return r->rewriteTo(theoryOf(node), node);
+}
+
+void Rewriter::rewriteAll(std::vector<Node>& nodes)
+{
+  Rewriter* r = getInstance();
+  PersistentRewriteCache* pc = r->getPersistentCache();
+  std::unordered_map<Node, Node, NodeHashFunction> rewritten;
+  for (Node& n : nodes)
+  {
+    if (n.getNumChildren() == 0)
+    {
+      continue;
+    }
+    std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+        rewritten.find(n);
+    if (it != rewritten.end())
+    {
+      n = it->second;
+      continue;
+    }
+    Node ret = pc != nullptr
+                   ? r->rewriteWithPersistentCache(theoryOf(n), n, pc)
+                   : r->rewriteTo(theoryOf(n), n);
+    rewritten[n] = ret;
+    n = ret;
+  }
+}
+
+quantifiers::ExtRewriteCache* Rewriter::getExtRewriteCache()
+{
+  Rewriter* r = getInstance();
+  if (r->d_extRewriteCache == nullptr)
+  {
+    r->d_extRewriteCache.reset(new quantifiers::ExtRewriteCache(
+        options::extRewriteCacheLimit(), *smtStatisticsRegistry()));
+  }
+  return r->d_extRewriteCache.get();
+}
+
+PersistentRewriteCache* Rewriter::getPersistentCache()
+{
+  if (!d_persistentCacheInit)
+  {
+    d_persistentCacheInit = true;
+    const std::string& filename = options::rewriteCacheFile();
+    if (!filename.empty())
+    {
+      SmtEngine* smt = smt::currentSmtEngine();
+      uint64_t fingerprint = PersistentRewriteCache::computeFingerprint(
+          smt->getOptions(), smt->getLogicInfo());
+      d_persistentCache.reset(new PersistentRewriteCache(filename, fingerprint));
+      if (!d_persistentCache->isOpen())
+      {
+        d_persistentCache.reset(nullptr);
+      }
+    }
+  }
+  return d_persistentCache.get();
+}
+
+RewriteCacheClock* Rewriter::getCacheClock()
+{
+  if (!d_cacheClockInit)
+  {
+    d_cacheClockInit = true;
+    if (options::rewriteCacheBudget() > 0)
+    {
+      d_cacheClock.reset(new RewriteCacheClock(
+          options::rewriteCacheBudget(),
+          [this](bool pre, TheoryId tid, TNode node) {
+            if (pre)
+            {
+              removePreRewriteCacheInternal(tid, node);
+            }
+            else
+            {
+              removePostRewriteCacheInternal(tid, node);
+            }
+          },
+          *smtStatisticsRegistry()));
+    }
+  }
+  return d_cacheClock.get();
+}
+
+RewriteProfiler* Rewriter::getProfiler()
+{
+  if (!options::rewriteProfile())
+  {
+    return nullptr;
+  }
+  return getInstance()->getProfilerInternal();
+}
+
+RewriteProfiler* Rewriter::getProfilerInternal()
+{
+  if (!d_profilerInit)
+  {
+    d_profilerInit = true;
+    if (options::rewriteProfile())
+    {
+      d_profiler.reset(new RewriteProfiler(*smtStatisticsRegistry()));
+    }
+  }
+  return d_profiler.get();
+}
+
+Node Rewriter::getPreRewriteCache(theory::TheoryId theoryId, TNode node)
+{
+  Node cached = getPreRewriteCacheInternal(theoryId, node);
+  if (d_countCacheHits && !cached.isNull())
+  {
+    ++d_numCacheHits;
+  }
+  RewriteCacheClock* clock = getCacheClock();
+  if (clock != nullptr)
+  {
+    clock->notifyLookup(true, theoryId, node, !cached.isNull());
+  }
+  return cached;
+}
+
+Node Rewriter::getPostRewriteCache(theory::TheoryId theoryId, TNode node)
+{
+  Node cached = getPostRewriteCacheInternal(theoryId, node);
+  if (d_countCacheHits && !cached.isNull())
+  {
+    ++d_numCacheHits;
+  }
+  RewriteCacheClock* clock = getCacheClock();
+  if (clock != nullptr)
+  {
+    clock->notifyLookup(false, theoryId, node, !cached.isNull());
+  }
+  return cached;
+}
+
+void Rewriter::setPreRewriteCache(theory::TheoryId theoryId,
+                                  TNode node,
+                                  TNode cache)
+{
+  setPreRewriteCacheInternal(theoryId, node, cache);
+  RewriteCacheClock* clock = getCacheClock();
+  if (clock != nullptr)
+  {
+    clock->notifyInsert(true, theoryId, node);
+  }
+}
+
+void Rewriter::setPostRewriteCache(theory::TheoryId theoryId,
+                                   TNode node,
+                                   TNode cache)
+{
+  setPostRewriteCacheInternal(theoryId, node, cache);
+  RewriteCacheClock* clock = getCacheClock();
+  if (clock != nullptr)
+  {
+    clock->notifyInsert(false, theoryId, node);
+  }
+}
+
+Node Rewriter::rewriteWithPersistentCache(theory::TheoryId theoryId,
+                                          TNode node,
+                                          PersistentRewriteCache* pc)
+{
+  // the in-memory cache is much cheaper, try it first
+  Node cached = getPostRewriteCache(theoryId, node);
+  if (!cached.isNull())
+  {
+    return cached;
+  }
+  Node ret = pc->lookup(node);
+  if (!ret.isNull())
+  {
+    // The stored result is equivalent to node, but not necessarily in the
+    // normal form of this run (e.g. if it depends on node ids), so rewrite it
+    // again, which is cheap if it is in normal form already.
+    ret = rewriteTo(theoryOf(ret), ret);
+    setPostRewriteCache(theoryId, node, ret);
+    return ret;
+  }
+  uint64_t steps = d_numRewriteSteps;
+  ret = rewriteTo(theoryId, node);
+  if (d_numRewriteSteps - steps >= options::rewriteCacheMinSteps())
+  {
+    pc->store(node, ret);
+  }
+  return ret;
 }
 
 TrustNode Rewriter::rewriteWithProof(TNode node,
@@ -202,16 +481,19 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
 
   Trace("rewriter") << "Rewriter::rewriteTo(" << theoryId << "," << node << ")"<< std::endl;
 
-  // Check if it's been cached already
+  // Check if it's been cached already. If proofs are enabled, we may use the
+  // rewritten forms computed without proofs only if they are trivial, since
+  // they require no rewrite steps.
   Node cached = getPostRewriteCache(theoryId, node);
-  if (!cached.isNull() && (tcpg == nullptr || node.getAttribute(rpfa)))
+  if (!cached.isNull()
+      && (tcpg == nullptr || cached == node || node.getAttribute(rpfa)))
   {
     return cached;
   }
 
   // Put the node on the stack in order to start the "recursive" rewrite
-  vector<RewriteStackElement> rewriteStack;
-  rewriteStack.push_back(RewriteStackElement(node, theoryId));
+  RewriteStack rewriteStack(d_stackArena, d_stackTop);
+  rewriteStack.push(node, theoryId);
 
   ResourceManager* rm = NULL;
   bool hasSmtEngine = smt::smtEngineInScope();
@@ -220,13 +502,14 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
   }
   // Rewrite until the stack is empty
   for (;;){
+    ++d_numRewriteSteps;
     if (hasSmtEngine)
     {
       rm->spendResource(ResourceManager::Resource::RewriteStep);
     }
 
     // Get the top of the recursion stack
-    RewriteStackElement& rewriteStackTop = rewriteStack.back();
+    RewriteStackElement& rewriteStackTop = rewriteStack.fromTop(0);
 
     Trace("rewriter") << "Rewriter::rewriting: "
                       << rewriteStackTop.getTheoryId() << ","
@@ -239,7 +522,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
       cached = getPreRewriteCache(rewriteStackTop.getTheoryId(),
                                   rewriteStackTop.d_node);
       if (cached.isNull()
-          || (tcpg != nullptr && !rewriteStackTop.d_node.getAttribute(rpfa)))
+          || (tcpg != nullptr && cached != rewriteStackTop.d_node
+              && !rewriteStackTop.d_node.getAttribute(rpfa)))
       {
         // Rewrite until fix-point is reached
         for(;;) {
@@ -278,7 +562,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
                                  rewriteStackTop.d_node);
     // If not, go through the children
     if (cached.isNull()
-        || (tcpg != nullptr && !rewriteStackTop.d_node.getAttribute(rpfa)))
+        || (tcpg != nullptr && cached != rewriteStackTop.d_node
+            && !rewriteStackTop.d_node.getAttribute(rpfa)))
     {
       // The child we need to rewrite
       unsigned child = rewriteStackTop.d_nextChild++;
@@ -301,8 +586,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
       {
         // The child node
         Node childNode = rewriteStackTop.d_node[child];
-        // Push the rewrite request to the stack (NOTE: rewriteStackTop might be a bad reference now)
-        rewriteStack.push_back(RewriteStackElement(childNode, theoryOf(childNode)));
+        // Push the rewrite request to the stack
+        rewriteStack.push(childNode, theoryOf(childNode));
         // Go on with the rewriting
         continue;
       }
@@ -415,8 +700,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
     }
 
     // We're done with this node, append it to the parent
-    rewriteStack[rewriteStack.size() - 2].d_builder << rewriteStackTop.d_node;
-    rewriteStack.pop_back();
+    rewriteStack.fromTop(1).d_builder << rewriteStackTop.d_node;
+    rewriteStack.pop();
   }
 
   Unreachable();
@@ -425,6 +710,39 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
 RewriteResponse Rewriter::preRewrite(theory::TheoryId theoryId,
                                      TNode n,
                                      TConvProofGenerator* tcpg)
+{
+  RewriteProfiler* rp = getProfilerInternal();
+  if (rp == nullptr)
+  {
+    return callPreRewrite(theoryId, n, tcpg);
+  }
+  RewriteProfiler::RuleStats& rs = rp->getTheoryStats(theoryId, true);
+  // theory rewriters may call the rewriter recursively
+  CodeTimer timer(rs.d_time, true);
+  RewriteResponse response = callPreRewrite(theoryId, n, tcpg);
+  rp->notifyRewrite(rs, n, response.d_node);
+  return response;
+}
+
+RewriteResponse Rewriter::postRewrite(theory::TheoryId theoryId,
+                                      TNode n,
+                                      TConvProofGenerator* tcpg)
+{
+  RewriteProfiler* rp = getProfilerInternal();
+  if (rp == nullptr)
+  {
+    return callPostRewrite(theoryId, n, tcpg);
+  }
+  RewriteProfiler::RuleStats& rs = rp->getTheoryStats(theoryId, false);
+  CodeTimer timer(rs.d_time, true);
+  RewriteResponse response = callPostRewrite(theoryId, n, tcpg);
+  rp->notifyRewrite(rs, n, response.d_node);
+  return response;
+}
+
+RewriteResponse Rewriter::callPreRewrite(theory::TheoryId theoryId,
+                                         TNode n,
+                                         TConvProofGenerator* tcpg)
 {
   Kind k = n.getKind();
   std::function<RewriteResponse(RewriteEnvironment*, TNode)> fn =
@@ -445,9 +763,9 @@ RewriteResponse Rewriter::preRewrite(theory::TheoryId theoryId,
   return fn(&d_re, n);
 }
 
-RewriteResponse Rewriter::postRewrite(theory::TheoryId theoryId,
-                                      TNode n,
-                                      TConvProofGenerator* tcpg)
+RewriteResponse Rewriter::callPostRewrite(theory::TheoryId theoryId,
+                                          TNode n,
+                                          TConvProofGenerator* tcpg)
 {
   Kind k = n.getKind();
   std::function<RewriteResponse(RewriteEnvironment*, TNode)> fn =
@@ -507,8 +825,16 @@ void Rewriter::clearCaches() {
 #ifdef CVC4_ASSERTIONS
   rewriter->d_rewriteStack.reset(nullptr);
 #endif
+  if (rewriter->d_stackTop == 0)
+  {
+    rewriter->d_stackArena.clear();
+  }
 
   rewriter->clearCachesInternal();
+  if (rewriter->d_extRewriteCache != nullptr)
+  {
+    rewriter->d_extRewriteCache->clear();
+  }
 }
 
 }  // namespace theory
@@ -28,11 +28,18 @@ class ProofNodeManager;
 
 namespace theory {
 
+class PersistentRewriteCache;
+class RewriteCacheClock;
+class RewriteProfiler;
+struct RewriteStackElement;
 class TrustNode;
 
 namespace builtin {
 class BuiltinProofRuleChecker;
 }
+namespace quantifiers {
+class ExtRewriteCache;
+}
 
 /**
  * The rewrite environment holds everything that the individual rewrites have
@@ -51,6 +58,24 @@ class RewriteEnvironment
  */
 RewriteResponse identityRewrite(RewriteEnvironment* re, TNode n);
 
+/**
+ * The rewriter of the theories that are not instantiated since they are not
+ * enabled by the logic, which leaves all terms unchanged. The terms of these
+ * theories are rejected when they are registered with the theory engine.
+ */
+class IdentityTheoryRewriter : public TheoryRewriter
+{
+ public:
+  RewriteResponse postRewrite(TNode node) override
+  {
+    return RewriteResponse(REWRITE_DONE, node);
+  }
+  RewriteResponse preRewrite(TNode node) override
+  {
+    return RewriteResponse(REWRITE_DONE, node);
+  }
+};
+
 /**
  * The main rewriter class.
  */
@@ -59,6 +84,7 @@ class Rewriter {
 
  public:
   Rewriter();
+  ~Rewriter();
 
   /**
    * Rewrites the node using theoryOf() to determine which rewriter to
@@ -66,6 +92,14 @@ class Rewriter {
    */
   static Node rewrite(TNode node);
 
+  /**
+   * Rewrites each of the given nodes in place. This is equivalent to calling
+   * rewrite() on each of them, but is intended for rewriting many nodes at
+   * once, e.g. all assertions: the nodes share the rewrite caches and the
+   * stack of the rewriter, and identical nodes are only rewritten once.
+   */
+  static void rewriteAll(std::vector<Node>& nodes);
+
   /**
    * Rewrites the equality node using theoryOf() to determine which rewriter to
    * use on the node corresponding to an equality s = t.
@@ -95,11 +129,31 @@ class Rewriter {
   /** Set proof node manager */
   void setProofNodeManager(ProofNodeManager* pnm);
 
+  /**
+   * The number of lookups in the rewrite caches that found an entry. They
+   * are only counted after a call to setCountCacheHits(true).
+   */
+  uint64_t getNumCacheHits() const { return d_numCacheHits; }
+  /** Enable or disable counting the hits in the rewrite caches */
+  void setCountCacheHits(bool count) { d_countCacheHits = count; }
+
   /**
    * Garbage collects the rewrite caches.
    */
   static void clearCaches();
 
+  /**
+   * Get the cache of extended rewriting of the rewriter in scope, which is
+   * shared by all extended rewriters and is created on the first call.
+   */
+  static quantifiers::ExtRewriteCache* getExtRewriteCache();
+
+  /**
+   * Get the rewrite profiler of the rewriter in scope, which is created on the
+   * first call. Returns nullptr if --rewrite-profile is not set.
+   */
+  static RewriteProfiler* getProfiler();
+
   /**
    * Registers a theory rewriter with this rewriter. The rewriter does not own
    * the theory rewriters.
@@ -169,6 +223,47 @@ class Rewriter {
   /** Sets the appropriate cache for a node */
   void setPostRewriteCache(theory::TheoryId theoryId, TNode node, TNode cache);
 
+  /**
+   * The accessors of the cache attributes themselves, which are generated
+   * in rewriter_tables.h. The accessors above additionally keep the cache
+   * clock up to date.
+   */
+  Node getPreRewriteCacheInternal(theory::TheoryId theoryId, TNode node);
+  Node getPostRewriteCacheInternal(theory::TheoryId theoryId, TNode node);
+  void setPreRewriteCacheInternal(theory::TheoryId theoryId,
+                                  TNode node,
+                                  TNode cache);
+  void setPostRewriteCacheInternal(theory::TheoryId theoryId,
+                                   TNode node,
+                                   TNode cache);
+  void removePreRewriteCacheInternal(theory::TheoryId theoryId, TNode node);
+  void removePostRewriteCacheInternal(theory::TheoryId theoryId, TNode node);
+
+  /**
+   * Get the cache clock, which is created on the first call if
+   * --rewrite-cache-budget is set. Returns nullptr if there is none, i.e. if
+   * the rewrite caches are unbounded.
+   */
+  RewriteCacheClock* getCacheClock();
+
+  /** Get the rewrite profiler, which is created on the first call */
+  RewriteProfiler* getProfilerInternal();
+
+  /**
+   * Get the persistent rewrite cache, which is opened on the first call if
+   * --rewrite-cache-file is set. Returns nullptr if there is none.
+   */
+  PersistentRewriteCache* getPersistentCache();
+
+  /**
+   * Rewrites the node using the given theory rewriter, consulting the
+   * persistent rewrite cache pc first and storing the result in it if
+   * rewriting took at least --rewrite-cache-min-steps steps.
+   */
+  Node rewriteWithPersistentCache(theory::TheoryId theoryId,
+                                  TNode node,
+                                  PersistentRewriteCache* pc);
+
   /**
    * Rewrites the node using the given theory rewriter.
    */
@@ -176,15 +271,28 @@ class Rewriter {
                  Node node,
                  TConvProofGenerator* tcpg = nullptr);
 
-  /** Calls the pre-rewriter for the given theory */
+  /**
+   * Calls the pre-rewriter for the given theory, profiling the call if
+   * --rewrite-profile is set.
+   */
   RewriteResponse preRewrite(theory::TheoryId theoryId,
                              TNode n,
                              TConvProofGenerator* tcpg = nullptr);
 
-  /** Calls the post-rewriter for the given theory */
+  /** Same as above, for the post-rewriter */
   RewriteResponse postRewrite(theory::TheoryId theoryId,
                               TNode n,
                               TConvProofGenerator* tcpg = nullptr);
+
+  /** Calls the pre-rewriter for the given theory */
+  RewriteResponse callPreRewrite(theory::TheoryId theoryId,
+                                 TNode n,
+                                 TConvProofGenerator* tcpg);
+
+  /** Calls the post-rewriter for the given theory */
+  RewriteResponse callPostRewrite(theory::TheoryId theoryId,
+                                  TNode n,
+                                  TConvProofGenerator* tcpg);
   /** processes a trust rewrite response */
   RewriteResponse processTrustRewriteResponse(
       theory::TheoryId theoryId,
@@ -201,6 +309,8 @@ class Rewriter {
 
   /** Theory rewriters used by this rewriter instance */
   TheoryRewriter* d_theoryRewriters[theory::THEORY_LAST];
+  /** The rewriter of the theories without a registered rewriter */
+  IdentityTheoryRewriter d_identityRewriter;
 
   /** Rewriter table for prewrites. Maps kinds to rewriter function. */
   std::function<RewriteResponse(RewriteEnvironment*, TNode)>
@@ -225,6 +335,33 @@ class Rewriter {
 
   /** The proof generator */
   std::unique_ptr<TConvProofGenerator> d_tpg;
+  /** The persistent rewrite cache, if enabled */
+  std::unique_ptr<PersistentRewriteCache> d_persistentCache;
+  /** Whether we tried to open the persistent rewrite cache */
+  bool d_persistentCacheInit;
+  /** The cache clock bounding the size of the rewrite caches, if enabled */
+  std::unique_ptr<RewriteCacheClock> d_cacheClock;
+  /** Whether we tried to create the cache clock */
+  bool d_cacheClockInit;
+  /** The rewrite profiler, if enabled */
+  std::unique_ptr<RewriteProfiler> d_profiler;
+  /** Whether we tried to create the rewrite profiler */
+  bool d_profilerInit;
+  /** The cache of extended rewriting */
+  std::unique_ptr<quantifiers::ExtRewriteCache> d_extRewriteCache;
+  /**
+   * The elements of the stacks of rewriteTo, which are reused across calls
+   * to avoid allocating a stack element and node builder per visited node.
+   */
+  std::vector<std::unique_ptr<RewriteStackElement>> d_stackArena;
+  /** The number of elements of d_stackArena in use */
+  size_t d_stackTop;
+  /** The number of rewrite steps taken by this rewriter */
+  uint64_t d_numRewriteSteps;
+  /** The number of hits in the rewrite caches */
+  uint64_t d_numCacheHits;
+  /** Whether d_numCacheHits is updated */
+  bool d_countCacheHits;
 #ifdef CVC4_ASSERTIONS
   std::unique_ptr<std::unordered_set<Node, NodeHashFunction>> d_rewriteStack =
       nullptr;
@@ -29,8 +29,10 @@ struct RewriteCacheTag {};
 template <theory::TheoryId theoryId>
 struct RewriteAttibute {
 
-  typedef expr::Attribute< RewriteCacheTag<true, theoryId>, Node> pre_rewrite;
-  typedef expr::Attribute< RewriteCacheTag<false, theoryId>, Node> post_rewrite;
+  typedef expr::DenseAttribute<RewriteCacheTag<true, theoryId>, Node>
+      pre_rewrite;
+  typedef expr::DenseAttribute<RewriteCacheTag<false, theoryId>, Node>
+      post_rewrite;
 
   /**
    * Get the value of the pre-rewrite cache.
@@ -96,6 +98,18 @@ struct RewriteAttibute {
       node.setAttribute(post_rewrite(), cache);
     }
   }
+
+  /** Remove the value of the pre-rewrite cache, if any. */
+  static void removePreRewriteCache(TNode node)
+  {
+    NodeManager::currentNM()->removeAttribute(node, pre_rewrite());
+  }
+
+  /** Remove the value of the post-rewrite cache, if any. */
+  static void removePostRewriteCache(TNode node)
+  {
+    NodeManager::currentNM()->removeAttribute(node, post_rewrite());
+  }
 };/* struct RewriteAttribute */
 
 }  // namespace theory
@@ -29,7 +29,7 @@ ${rewriter_includes}
 namespace cvc5 {
 namespace theory {
 
-Node Rewriter::getPreRewriteCache(theory::TheoryId theoryId, TNode node) {
+Node Rewriter::getPreRewriteCacheInternal(theory::TheoryId theoryId, TNode node) {
   switch(theoryId) {
 ${pre_rewrite_get_cache}
   default:
@@ -37,7 +37,7 @@ ${pre_rewrite_get_cache}
   }
 }
 
-Node Rewriter::getPostRewriteCache(theory::TheoryId theoryId, TNode node) {
+Node Rewriter::getPostRewriteCacheInternal(theory::TheoryId theoryId, TNode node) {
   switch(theoryId) {
 ${post_rewrite_get_cache}
     default:
@@ -45,7 +45,7 @@ ${post_rewrite_get_cache}
   }
 }
 
-void Rewriter::setPreRewriteCache(theory::TheoryId theoryId, TNode node, TNode cache) {
+void Rewriter::setPreRewriteCacheInternal(theory::TheoryId theoryId, TNode node, TNode cache) {
   switch(theoryId) {
 ${pre_rewrite_set_cache}
   default:
@@ -53,7 +53,7 @@ ${pre_rewrite_set_cache}
   }
 }
 
-void Rewriter::setPostRewriteCache(theory::TheoryId theoryId, TNode node, TNode cache) {
+void Rewriter::setPostRewriteCacheInternal(theory::TheoryId theoryId, TNode node, TNode cache) {
   switch(theoryId) {
 ${post_rewrite_set_cache}
   default:
@@ -61,7 +61,35 @@ ${post_rewrite_set_cache}
   }
 }
 
-Rewriter::Rewriter() : d_tpg(nullptr)
+void Rewriter::removePreRewriteCacheInternal(theory::TheoryId theoryId,
+                                             TNode node)
+{
+  switch(theoryId) {
+${pre_rewrite_remove_cache}
+  default:
+    Unreachable();
+  }
+}
+
+void Rewriter::removePostRewriteCacheInternal(theory::TheoryId theoryId,
+                                              TNode node)
+{
+  switch(theoryId) {
+${post_rewrite_remove_cache}
+  default:
+    Unreachable();
+  }
+}
+
+Rewriter::Rewriter()
+    : d_tpg(nullptr),
+      d_persistentCacheInit(false),
+      d_cacheClockInit(false),
+      d_profilerInit(false),
+      d_stackTop(0),
+      d_numRewriteSteps(0),
+      d_numCacheHits(0),
+      d_countCacheHits(false)
 {
 for (size_t i = 0; i < kind::LAST_KIND; ++i)
 {
@@ -71,6 +99,7 @@ for (size_t i = 0; i < kind::LAST_KIND; ++i)
 
 for (size_t i = 0; i < theory::THEORY_LAST; ++i)
 {
+  d_theoryRewriters[i] = &d_identityRewriter;
   d_preRewritersEqual[i] = nullptr;
   d_postRewritersEqual[i] = nullptr;
 }
@@ -92,6 +121,10 @@ void Rewriter::clearCachesInternal() {
     allids.push_back(&postids[i]);
   }
   NodeManager::currentNM()->deleteAttributes(allids);
+  if (d_cacheClock != nullptr)
+  {
+    d_cacheClock->clear();
+  }
 }
 
 }  // namespace theory
@@ -612,21 +612,9 @@ void TheorySep::postCheck(Effort level)
       setInactiveAssertionRec(fact, lbl_to_assertions, assert_active);
     }
   }
-  // set up model information based on active assertions
-  for (NodeList::const_iterator i = d_spatial_assertions.begin();
-       i != d_spatial_assertions.end();
-       ++i)
-  {
-    Node fact = (*i);
-    bool polarity = fact.getKind() != NOT;
-    TNode atom = polarity ? fact : fact[0];
-    TNode satom = atom[0];
-    TNode slbl = atom[1];
-    if (assert_active[fact])
-    {
-      computeLabelModel(slbl);
-    }
-  }
+  // The model information of labels is computed on demand by
+  // computeLabelModel below, since only the labels of active negated
+  // assertions, their sublabels and the base labels are queried.
   // debug print
   if (Trace.isOn("sep-process"))
   {
@@ -719,6 +707,7 @@ void TheorySep::postCheck(Effort level)
       TypeNode tn = getReferenceType(satom);
       tn = nm->mkSetType(tn);
       // tn = nm->mkSetType(nm->mkRefType(tn));
+      computeLabelModel(slbl);
       Node o_b_lbl_mval = d_label_model[slbl].getValue(tn);
       Trace("sep-process") << "    Model for " << slbl << " : " << o_b_lbl_mval
                            << std::endl;
@@ -876,7 +865,7 @@ void TheorySep::postCheck(Effort level)
   Trace("sep-process-debug") << "...preparing sep model..." << std::endl;
   d_heap_locs_nptos.clear();
   // collect data points that are not pointed to
-  for (context::CDList<Assertion>::const_iterator it = facts_begin();
+  for (context::CDChunkList<Assertion>::const_iterator it = facts_begin();
        it != facts_end();
        ++it)
   {
@@ -1559,8 +1548,10 @@ void TheorySep::getLabelChildren(Node satom,
 }
 
 void TheorySep::computeLabelModel( Node lbl ) {
-  if( !d_label_model[lbl].d_computed ){
-    d_label_model[lbl].d_computed = true;
+  HeapInfo& hi = d_label_model[lbl];
+  if (!hi.d_computed)
+  {
+    hi.d_computed = true;
 
     //we must get the value of lbl from the model: this is being run at last call, after the model is constructed
     //Assert(...); TODO
@@ -1569,18 +1560,18 @@ void TheorySep::computeLabelModel( Node lbl ) {
     if( v_val.getKind()!=kind::EMPTYSET ){
       while( v_val.getKind()==kind::UNION ){
         Assert(v_val[0].getKind() == kind::SINGLETON);
-        d_label_model[lbl].d_heap_locs_model.push_back(v_val[0]);
+        hi.d_heap_locs_model.push_back(v_val[0]);
         v_val = v_val[1];
       }
       if( v_val.getKind()==kind::SINGLETON ){
-        d_label_model[lbl].d_heap_locs_model.push_back( v_val );
+        hi.d_heap_locs_model.push_back( v_val );
       }else{
         throw Exception("Could not establish value of heap in model.");
         Assert(false);
       }
     }
-    for( unsigned j=0; j<d_label_model[lbl].d_heap_locs_model.size(); j++ ){
-      Node u = d_label_model[lbl].d_heap_locs_model[j];
+    for( unsigned j=0; j<hi.d_heap_locs_model.size(); j++ ){
+      Node u = hi.d_heap_locs_model[j];
       Assert(u.getKind() == kind::SINGLETON);
       u = u[0];
       Node tt;
@@ -1601,7 +1592,7 @@ void TheorySep::computeLabelModel( Node lbl ) {
       // TODO(project##230): Find a safe type for the singleton operator
       Node stt = NodeManager::currentNM()->mkSingleton(tt.getType(), tt);
       Trace("sep-process-debug") << "...model : add " << tt << " for " << u << " in lbl " << lbl << std::endl;
-      d_label_model[lbl].d_heap_locs.push_back( stt );
+      hi.d_heap_locs.push_back( stt );
     }
   }
 }
@@ -170,6 +170,7 @@ void TheorySetsRels::check(Theory::Effort level)
     d_membership_trie.clear();
     d_rel_nodes.clear();
     d_rReps_memberReps_cache.clear();
+    d_rReps_memberReps_set.clear();
     d_rRep_tcGraph.clear();
     d_tcr_tcGraph_exps.clear();
     d_tcr_tcGraph.clear();
@@ -1028,13 +1029,58 @@ void TheorySetsRels::check(Theory::Effort level)
     }
     NodeManager* nm = NodeManager::currentNM();
 
-    std::vector<Node> r1_rep_exps = d_rReps_memberReps_exp_cache[r1_rep];
-    std::vector<Node> r2_rep_exps = d_rReps_memberReps_exp_cache[r2_rep];
+    const std::vector<Node>& r1_rep_exps = d_rReps_memberReps_exp_cache[r1_rep];
+    const std::vector<Node>& r2_rep_exps = d_rReps_memberReps_exp_cache[r2_rep];
     unsigned int r1_tuple_len = r1.getType().getSetElementType().getTupleLength();
     unsigned int r2_tuple_len = r2.getType().getSetElementType().getTupleLength();
 
+    // For joins, index the members of r2 by the representative of their first
+    // element, so that each member of r1 is only composed with the members of
+    // r2 it may join with, instead of all of them. The members whose joined
+    // element is not in the equality engine are compared with all of them,
+    // since areEqual below makes them shared.
+    std::vector<unsigned> r2_all;
+    std::vector<unsigned> r2_unindexed;
+    std::unordered_map<Node, std::vector<unsigned>, NodeHashFunction> r2_index;
+    for (unsigned j = 0, size = r2_rep_exps.size(); j < size; j++)
+    {
+      r2_all.push_back(j);
+      if (rel.getKind() == kind::JOIN)
+      {
+        Node r2_lmost = RelsUtils::nthElementOfTuple(r2_rep_exps[j][0], 0);
+        if (hasTerm(r2_lmost))
+        {
+          r2_index[getRepresentative(r2_lmost)].push_back(j);
+        }
+        else
+        {
+          r2_unindexed.push_back(j);
+        }
+      }
+    }
+
     for( unsigned int i = 0; i < r1_rep_exps.size(); i++ ) {
-      for( unsigned int j = 0; j < r2_rep_exps.size(); j++ ) {
+      const std::vector<unsigned>* r2_cands = &r2_all;
+      std::vector<unsigned> r2_joined;
+      if (rel.getKind() == kind::JOIN)
+      {
+        Node r1_rmost =
+            RelsUtils::nthElementOfTuple(r1_rep_exps[i][0], r1_tuple_len - 1);
+        if (hasTerm(r1_rmost))
+        {
+          std::unordered_map<Node, std::vector<unsigned>, NodeHashFunction>::
+              const_iterator itj = r2_index.find(getRepresentative(r1_rmost));
+          if (itj != r2_index.end())
+          {
+            r2_joined = itj->second;
+          }
+          r2_joined.insert(
+              r2_joined.end(), r2_unindexed.begin(), r2_unindexed.end());
+          r2_cands = &r2_joined;
+        }
+      }
+      for (unsigned j : *r2_cands)
+      {
         std::vector<Node> tuple_elements;
         TypeNode tn = rel.getType().getSetElementType();
         Node r1_rmost = RelsUtils::nthElementOfTuple( r1_rep_exps[i][0], r1_tuple_len-1 );
@@ -1172,24 +1218,14 @@ void TheorySetsRels::check(Theory::Effort level)
    * Make sure duplicate members are not added in map
    */
   bool TheorySetsRels::safelyAddToMap(std::map< Node, std::vector<Node> >& map, Node rel_rep, Node member) {
-    std::map< Node, std::vector< Node > >::iterator mem_it = map.find(rel_rep);
-    if(mem_it == map.end()) {
-      std::vector<Node> members;
-      members.push_back(member);
-      map[rel_rep] = members;
-      return true;
-    } else {
-      std::vector<Node>::iterator mems = mem_it->second.begin();
-      while(mems != mem_it->second.end()) {
-        if(areEqual(*mems, member)) {
-          return false;
-        }
-        ++mems;
-      }
-      map[rel_rep].push_back(member);
-      return true;
+    // members are representatives, hence equal members are identical
+    Assert(getRepresentative(member) == member);
+    if (!d_rReps_memberReps_set[rel_rep].insert(member).second)
+    {
+      return false;
     }
-    return false;
+    map[rel_rep].push_back(member);
+    return true;
   }
 
   void TheorySetsRels::makeSharedTerm(Node n, TypeNode t)
@@ -110,6 +110,10 @@ private:
   /** Mapping between relation and its member representatives */
   std::map< Node, std::vector< Node > >           d_rReps_memberReps_cache;
 
+  /** The set of member representatives of each relation in the above map */
+  std::map<Node, std::unordered_set<Node, NodeHashFunction>>
+      d_rReps_memberReps_set;
+
   /** Mapping between relation and its member representatives explanation */
   std::map< Node, std::vector< Node > >           d_rReps_memberReps_exp_cache;
 
@@ -103,6 +103,17 @@ EqualityStatus SharedSolver::getEqualityStatus(TNode a, TNode b)
   return EQUALITY_UNKNOWN;
 }
 
+size_t SharedSolver::getChangedSharedTerms(
+    size_t start, std::unordered_set<TNode, TNodeHashFunction>& terms) const
+{
+  return d_sharedTerms.getChangedTerms(start, terms);
+}
+
+void SharedSolver::markSharedTermChanged(TNode t)
+{
+  d_sharedTerms.markChanged(t);
+}
+
 void SharedSolver::sendLemma(TrustNode trn, TheoryId atomsTo)
 {
   d_te.lemma(trn, LemmaProperty::NONE, atomsTo);
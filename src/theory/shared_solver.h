@@ -17,6 +17,8 @@
 #ifndef CVC4__THEORY__SHARED_SOLVER__H
 #define CVC4__THEORY__SHARED_SOLVER__H
 
+#include <unordered_set>
+
 #include "expr/node.h"
 #include "theory/shared_terms_database.h"
 #include "theory/term_registration_visitor.h"
@@ -106,6 +108,17 @@ class SharedSolver
   /** Is term t a shared term? */
   virtual bool isShared(TNode t) const;
 
+  /**
+   * Add to terms the shared terms whose equivalence class changed since the
+   * start^th change recorded by the shared terms database, and return the
+   * number of changes recorded so far. Changes are only recorded if the care
+   * graph is computed incrementally.
+   */
+  size_t getChangedSharedTerms(
+      size_t start, std::unordered_set<TNode, TNodeHashFunction>& terms) const;
+  /** Mark that the equivalence class of shared term t changed */
+  void markSharedTermChanged(TNode t);
+
   /**
    * Method called by equalityEngine when a becomes (dis-)equal to b and a and b
    * are shared with the theory. Returns false if there is a direct conflict
@@ -15,6 +15,7 @@
 
 #include "theory/shared_terms_database.h"
 
+#include "options/theory_options.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/theory_engine.h"
 
@@ -33,6 +34,8 @@ SharedTermsDatabase::SharedTermsDatabase(TheoryEngine* theoryEngine,
       d_termsToTheories(context),
       d_alreadyNotifiedMap(context),
       d_registeredEqualities(context),
+      d_recordChanges(options::careGraphIncremental()),
+      d_changedTerms(context),
       d_EENotify(*this),
       d_theoryEngine(theoryEngine),
       d_inConflict(context, false),
@@ -110,6 +113,40 @@ SharedTermsDatabase::shared_terms_iterator SharedTermsDatabase::end(TNode atom)
   return d_atomsToTerms.find(atom)->second.end();
 }
 
+size_t SharedTermsDatabase::getChangedTerms(
+    size_t start, std::unordered_set<TNode, TNodeHashFunction>& terms) const
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  for (size_t i = start, size = d_changedTerms.size(); i < size; ++i)
+  {
+    TNode t = d_changedTerms[i];
+    if (d_equalityEngine == nullptr || !d_equalityEngine->hasTerm(t))
+    {
+      if (isShared(t))
+      {
+        terms.insert(t);
+      }
+      continue;
+    }
+    // all the shared terms of the equivalence class of t changed
+    TNode r = d_equalityEngine->getRepresentative(t);
+    if (!visited.insert(r).second)
+    {
+      continue;
+    }
+    eq::EqClassIterator eqc(r, d_equalityEngine);
+    for (; !eqc.isFinished(); ++eqc)
+    {
+      TNode n = *eqc;
+      if (isShared(n))
+      {
+        terms.insert(n);
+      }
+    }
+  }
+  return d_changedTerms.size();
+}
+
 bool SharedTermsDatabase::hasSharedTerms(TNode atom) const {
   return d_atomsToTerms.find(atom) != d_atomsToTerms.end();
 }
@@ -197,6 +234,8 @@ void SharedTermsDatabase::markNotified(TNode term, TheoryIdSet theories)
   // First update the set of notified theories for this term
   d_alreadyNotifiedMap[term] =
       TheoryIdSetUtil::setUnion(newlyNotified, alreadyNotified);
+  // the term may now be in the care graph of the newly notified theories
+  markChanged(term);
 
   if (d_equalityEngine == nullptr)
   {
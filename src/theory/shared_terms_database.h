@@ -18,8 +18,10 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
 
 #include "context/cdhashset.h"
+#include "context/cdlist.h"
 #include "expr/node.h"
 #include "expr/proof_node_manager.h"
 #include "theory/ee_setup_info.h"
@@ -73,6 +75,14 @@ class SharedTermsDatabase : public context::ContextNotifyObj {
   typedef context::CDHashSet<Node, NodeHashFunction> RegisteredEqualitiesSet;
   RegisteredEqualitiesSet d_registeredEqualities;
 
+  /** Whether we record the shared terms whose equivalence class changed */
+  bool d_recordChanges;
+  /**
+   * The shared terms, or the representatives of the equivalence classes of
+   * shared terms, that changed, in the order of the changes.
+   */
+  context::CDList<Node> d_changedTerms;
+
  private:
   /** This method removes all the un-necessary stuff from the maps */
   void backtrack();
@@ -103,8 +113,15 @@ class SharedTermsDatabase : public context::ContextNotifyObj {
     }
 
     void eqNotifyNewClass(TNode t) override {}
-    void eqNotifyMerge(TNode t1, TNode t2) override {}
-    void eqNotifyDisequal(TNode t1, TNode t2, TNode reason) override {}
+    void eqNotifyMerge(TNode t1, TNode t2) override
+    {
+      d_sharedTerms.markChanged(t1);
+    }
+    void eqNotifyDisequal(TNode t1, TNode t2, TNode reason) override
+    {
+      d_sharedTerms.markChanged(t1);
+      d_sharedTerms.markChanged(t2);
+    }
   };
 
   /** The notify class for d_equalityEngine */
@@ -205,6 +222,25 @@ class SharedTermsDatabase : public context::ContextNotifyObj {
    */
   void markNotified(TNode term, theory::TheoryIdSet theories);
 
+  /**
+   * Mark that the equivalence class of t changed. This is only recorded if
+   * the care graph is computed incrementally.
+   */
+  void markChanged(TNode t)
+  {
+    if (d_recordChanges)
+    {
+      d_changedTerms.push_back(t);
+    }
+  }
+
+  /**
+   * Add to terms the shared terms whose equivalence class changed since the
+   * start^th change, and return the number of changes so far.
+   */
+  size_t getChangedTerms(
+      size_t start, std::unordered_set<TNode, TNodeHashFunction>& terms) const;
+
   /**
    * Returns true if the atom contains any shared terms, false otherwise.
    */
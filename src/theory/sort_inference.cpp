@@ -21,6 +21,9 @@
 
 #include "theory/sort_inference.h"
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
@@ -38,8 +41,12 @@ namespace cvc5 {
 namespace theory {
 
 void SortInference::UnionFind::print(const char * c){
-  for( std::map< int, int >::iterator it = d_eqc.begin(); it != d_eqc.end(); ++it ){
-    Trace(c) << "s_" << it->first << " = s_" << it->second << ", ";
+  for (size_t i = 0, size = d_eqc.size(); i < size; i++)
+  {
+    if (d_eqc[i] != static_cast<int>(i))
+    {
+      Trace(c) << "s_" << i << " = s_" << d_eqc[i] << ", ";
+    }
   }
   for( unsigned i=0; i<d_deq.size(); i++ ){
     Trace(c) << "s_" << d_deq[i].first << " != s_" << d_deq[i].second << ", ";
@@ -48,25 +55,40 @@ void SortInference::UnionFind::print(const char * c){
 }
 void SortInference::UnionFind::set( UnionFind& c ) {
   clear();
-  for( std::map< int, int >::iterator it = c.d_eqc.begin(); it != c.d_eqc.end(); ++it ){
-    d_eqc[ it->first ] = it->second;
-  }
+  d_eqc = c.d_eqc;
   d_deq.insert( d_deq.end(), c.d_deq.begin(), c.d_deq.end() );
 }
 int SortInference::UnionFind::getRepresentative( int t ){
-  std::map< int, int >::iterator it = d_eqc.find( t );
-  if( it==d_eqc.end() || it->second==t ){
+  if (t < 0 || static_cast<size_t>(t) >= d_eqc.size())
+  {
     return t;
-  }else{
-    int rt = getRepresentative( it->second );
+  }
+  int rt = t;
+  while (d_eqc[rt] != rt)
+  {
+    rt = d_eqc[rt];
+  }
+  // path compression
+  while (d_eqc[t] != rt)
+  {
+    int next = d_eqc[t];
     d_eqc[t] = rt;
-    return rt;
+    t = next;
   }
+  return rt;
 }
 void SortInference::UnionFind::setEqual( int t1, int t2 ){
   if( t1!=t2 ){
     int rt1 = getRepresentative( t1 );
     int rt2 = getRepresentative( t2 );
+    size_t size = static_cast<size_t>(std::max(rt1, rt2)) + 1;
+    if (size > d_eqc.size())
+    {
+      // the new ids are their own representatives
+      size_t osize = d_eqc.size();
+      d_eqc.resize(size);
+      std::iota(d_eqc.begin() + osize, d_eqc.end(), static_cast<int>(osize));
+    }
     if( rt1>rt2 ){
       d_eqc[rt1] = rt2;
     }else{
@@ -122,13 +144,13 @@ void SortInference::initialize(const std::vector<Node>& assertions)
 {
   Trace("sort-inference-proc") << "Calculating sort inference..." << std::endl;
   // process all assertions
-  std::map<Node, int> visited;
+  std::unordered_map<Node, int, NodeHashFunction> visited;
   NodeManager * nm = NodeManager::currentNM();
   int btId = getIdForType( nm->booleanType() );
   for (const Node& a : assertions)
   {
     Trace("sort-inference-debug") << "Process " << a << std::endl;
-    std::map<Node, Node> var_bound;
+    std::unordered_map<Node, Node, NodeHashFunction> var_bound;
     int pid = process(a, var_bound, visited);
     // the type of the topmost term must be Boolean
     setEqual( pid, btId );
@@ -206,7 +228,7 @@ Node SortInference::simplify(Node n,
                              std::map<Node, std::map<TypeNode, Node> >& visited)
 {
   Trace("sort-inference-debug") << "Simplify " << n << std::endl;
-  std::map<Node, Node> var_bound;
+  std::unordered_map<Node, Node, NodeHashFunction> var_bound;
   TypeNode tnn;
   Node ret = simplifyNode(n, var_bound, tnn, model_replace_f, visited);
   ret = theory::Rewriter::rewrite(ret);
@@ -334,7 +356,8 @@ void SortInference::setEqual( int t1, int t2 ){
         rt1 = rt2;
         rt2 = swap;
       }
-      std::map< int, TypeNode >::iterator it1 = d_type_types.find( rt1 );
+      std::unordered_map<int, TypeNode>::iterator it1 =
+          d_type_types.find(rt1);
       if( it1!=d_type_types.end() ){
         if( d_type_types.find( rt2 )==d_type_types.end() ){
           d_type_types[rt2] = it1->second;
@@ -344,14 +367,15 @@ void SortInference::setEqual( int t1, int t2 ){
           return;
         }
       }
-      d_type_union_find.d_eqc[rt1] = rt2;
+      d_type_union_find.setEqual(rt1, rt2);
     }
   }
 }
 
 int SortInference::getIdForType( TypeNode tn ){
   //register the return type
-  std::map< TypeNode, int >::iterator it = d_id_for_types.find( tn );
+  std::unordered_map<TypeNode, int, TypeNodeHashFunction>::iterator it =
+      d_id_for_types.find(tn);
   if( it==d_id_for_types.end() ){
     int sc = d_sortCount;
     d_type_types[d_sortCount] = tn;
@@ -363,14 +387,19 @@ int SortInference::getIdForType( TypeNode tn ){
   }
 }
 
-int SortInference::process( Node n, std::map< Node, Node >& var_bound, std::map< Node, int >& visited ){
-  std::map< Node, int >::iterator itv = visited.find( n );
+int SortInference::process(
+    Node n,
+    std::unordered_map<Node, Node, NodeHashFunction>& var_bound,
+    std::unordered_map<Node, int, NodeHashFunction>& visited)
+{
+  std::unordered_map<Node, int, NodeHashFunction>::iterator itv =
+      visited.find(n);
   if( itv!=visited.end() ){
     return itv->second;
   }else{
     //add to variable bindings
     bool use_new_visited = false;
-    std::map< Node, int > new_visited;
+    std::unordered_map<Node, int, NodeHashFunction> new_visited;
     if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
       if( d_var_types.find( n )!=d_var_types.end() ){
         return getIdForType( n.getType() );
@@ -476,7 +505,8 @@ int SortInference::process( Node n, std::map< Node, Node >& var_bound, std::map<
       //return type is the return type
       retType = d_op_return_types[op];
     }else{
-      std::map< Node, Node >::iterator it = var_bound.find( n );
+      std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+          var_bound.find(n);
       if( it!=var_bound.end() ){
         Trace("sort-inference-debug") << n << " is a bound variable." << std::endl;
         //the return type was specified while binding
@@ -621,160 +651,272 @@ Node SortInference::getNewSymbol( Node old, TypeNode tn ){
   }
 }
 
+namespace {
+
+/** A frame of the traversal of SortInference::simplifyNode */
+struct SimplifyFrame
+{
+  SimplifyFrame(Node n,
+                TypeNode tnn,
+                std::map<Node, std::map<TypeNode, Node> >* visited)
+      : d_node(n),
+        d_tnn(tnn),
+        d_visited(visited),
+        d_init(false),
+        d_nextChild(0),
+        d_childChanged(false)
+  {
+  }
+  /** The term to simplify */
+  Node d_node;
+  /** Its type context */
+  TypeNode d_tnn;
+  /** The cache that d_node is simplified with */
+  std::map<Node, std::map<TypeNode, Node> >* d_visited;
+  /**
+   * The cache for the body of a quantified formula, which is separate since
+   * its bound variables are mapped to new symbols.
+   */
+  std::shared_ptr<std::map<Node, std::map<TypeNode, Node> > > d_bodyVisited;
+  /** Whether d_node was previsited */
+  bool d_init;
+  /** The children of the simplified form of d_node */
+  std::vector<Node> d_children;
+  /** The index of the next child of d_node to simplify */
+  size_t d_nextChild;
+  /** Whether a child was changed by simplification */
+  bool d_childChanged;
+};
+
+}  // namespace
+
+TypeNode SortInference::getChildTypeContext(Node n, size_t i)
+{
+  if (isHandledApplyUf(n.getKind()))
+  {
+    Assert(d_op_arg_types.find(n.getOperator()) != d_op_arg_types.end());
+    TypeNode tnnc = getOrCreateTypeForId(d_op_arg_types[n.getOperator()][i],
+                                         n[i].getType());
+    Assert(!tnnc.isNull());
+    return tnnc;
+  }
+  else if (n.getKind() == kind::EQUAL && !n[0].getType().isBoolean())
+  {
+    // both sides have the type of the equality
+    Assert(d_equality_types.find(n) != d_equality_types.end());
+    TypeNode tnnc = getOrCreateTypeForId(d_equality_types[n], n[0].getType());
+    Assert(!tnnc.isNull());
+    return tnnc;
+  }
+  return TypeNode::null();
+}
+
 Node SortInference::simplifyNode(
     Node n,
-    std::map<Node, Node>& var_bound,
+    std::unordered_map<Node, Node, NodeHashFunction>& var_bound,
     TypeNode tnn,
     std::map<Node, Node>& model_replace_f,
     std::map<Node, std::map<TypeNode, Node> >& visited)
 {
-  std::map< TypeNode, Node >::iterator itv = visited[n].find( tnn );
-  if( itv!=visited[n].end() ){
-    return itv->second;
-  }else{
-    Trace("sort-inference-debug2") << "Simplify " << n << ", type context=" << tnn << std::endl;
-    std::vector< Node > children;
-    std::map< Node, std::map< TypeNode, Node > > new_visited;
-    bool use_new_visited = false;
-    if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
-      //recreate based on types of variables
-      std::vector< Node > new_children;
-      for( size_t i=0; i<n[0].getNumChildren(); i++ ){
-        TypeNode tn = getOrCreateTypeForId( d_var_types[n][ n[0][i] ], n[0][i].getType() );
-        Node v = getNewSymbol( n[0][i], tn );
-        Trace("sort-inference-debug2") << "Map variable " << n[0][i] << " to " << v << std::endl;
-        new_children.push_back( v );
-        var_bound[ n[0][i] ] = v;
-      }
-      children.push_back( NodeManager::currentNM()->mkNode( n[0].getKind(), new_children ) );
-      use_new_visited = true;
-    }
-
-    //process children
-    if( n.getMetaKind() == kind::metakind::PARAMETERIZED ){
-      children.push_back( n.getOperator() );
-    }
-    Node op;
-    if( n.hasOperator() ){
-      op = n.getOperator();
-    }
-    bool childChanged = false;
-    TypeNode tnnc;
-    for( size_t i=0; i<n.getNumChildren(); i++ ){
-      bool processChild = true;
-      if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
-        processChild =
-            options::userPatternsQuant() == options::UserPatMode::IGNORE
-                ? i == 1
-                : i >= 1;
+  NodeManager* nm = NodeManager::currentNM();
+  std::map<TypeNode, Node>::iterator itv;
+  std::vector<SimplifyFrame> visit;
+  visit.emplace_back(n, tnn, &visited);
+  Node ret;
+  do
+  {
+    SimplifyFrame& f = visit.back();
+    Node cur = f.d_node;
+    Kind ck = cur.getKind();
+    bool isQuant = ck == kind::FORALL || ck == kind::EXISTS;
+    if (!f.d_init)
+    {
+      std::map<TypeNode, Node>& vcur = (*f.d_visited)[cur];
+      itv = vcur.find(f.d_tnn);
+      if (itv != vcur.end())
+      {
+        ret = itv->second;
+        visit.pop_back();
       }
-      if( processChild ){
-        if (isHandledApplyUf(n.getKind()))
+      else
+      {
+        Trace("sort-inference-debug2") << "Simplify " << cur
+                                       << ", type context=" << f.d_tnn
+                                       << std::endl;
+        f.d_init = true;
+        if (isQuant)
         {
-          Assert(d_op_arg_types.find(op) != d_op_arg_types.end());
-          tnnc = getOrCreateTypeForId( d_op_arg_types[op][i], n[i].getType() );
-          Assert(!tnnc.isNull());
+          //recreate based on types of variables
+          std::vector<Node> new_children;
+          for (const Node& v : cur[0])
+          {
+            TypeNode tn =
+                getOrCreateTypeForId(d_var_types[cur][v], v.getType());
+            Node nv = getNewSymbol(v, tn);
+            Trace("sort-inference-debug2")
+                << "Map variable " << v << " to " << nv << std::endl;
+            new_children.push_back(nv);
+            var_bound[v] = nv;
+          }
+          f.d_children.push_back(nm->mkNode(cur[0].getKind(), new_children));
+          f.d_bodyVisited =
+              std::make_shared<std::map<Node, std::map<TypeNode, Node> > >();
         }
-        else if (n.getKind() == kind::EQUAL && !n[0].getType().isBoolean()
-                 && i == 0)
+        if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
         {
-          Assert(d_equality_types.find(n) != d_equality_types.end());
-          tnnc = getOrCreateTypeForId( d_equality_types[n], n[0].getType() );
-          Assert(!tnnc.isNull());
+          f.d_children.push_back(cur.getOperator());
         }
-        Node nc = simplifyNode(n[i],
-                               var_bound,
-                               tnnc,
-                               model_replace_f,
-                               use_new_visited ? new_visited : visited);
-        Trace("sort-inference-debug2") << "Simplify " << i << " " << n[i] << " returned " << nc << std::endl;
-        children.push_back( nc );
-        childChanged = childChanged || nc!=n[i];
+        continue;
       }
     }
-
-    //remove from variable bindings
-    Node ret;
-    if( n.getKind()==kind::FORALL || n.getKind()==kind::EXISTS ){
-      //erase from variable bound
-      for( size_t i=0; i<n[0].getNumChildren(); i++ ){
-        Trace("sort-inference-debug2") << "Remove bound for " << n[0][i] << std::endl;
-        var_bound.erase( n[0][i] );
+    else
+    {
+      size_t nchild = cur.getNumChildren();
+      if (isQuant)
+      {
+        // the variable list is processed above, and the patterns are not
+        // processed if they are ignored
+        f.d_nextChild = std::max<size_t>(f.d_nextChild, 1);
+        if (options::userPatternsQuant() == options::UserPatMode::IGNORE)
+        {
+          nchild = 2;
+        }
       }
-      ret = NodeManager::currentNM()->mkNode( n.getKind(), children );
-    }else if( n.getKind()==kind::EQUAL ){
-      TypeNode tn1 = children[0].getType();
-      TypeNode tn2 = children[1].getType();
-      if( !tn1.isComparableTo( tn2 ) ){
-        Trace("sort-inference-warn") << "Sort inference created bad equality: " << children[0] << " = " << children[1] << std::endl;
-        Trace("sort-inference-warn") << "  Types : " << children[0].getType() << " " << children[1].getType() << std::endl;
-        Assert(false);
+      if (f.d_nextChild < nchild)
+      {
+        size_t i = f.d_nextChild;
+        TypeNode tnnc = getChildTypeContext(cur, i);
+        std::map<Node, std::map<TypeNode, Node> >* cvisited =
+            f.d_bodyVisited != nullptr ? f.d_bodyVisited.get() : f.d_visited;
+        // note this invalidates f
+        visit.emplace_back(cur[i], tnnc, cvisited);
+        continue;
       }
-      ret = NodeManager::currentNM()->mkNode( kind::EQUAL, children );
-    }
-    else if (isHandledApplyUf(n.getKind()))
-    {
-      if( d_symbol_map.find( op )==d_symbol_map.end() ){
-        //make the new operator if necessary
-        bool opChanged = false;
-        std::vector< TypeNode > argTypes;
-        for( size_t i=0; i<n.getNumChildren(); i++ ){
-          TypeNode tn = getOrCreateTypeForId( d_op_arg_types[op][i], n[i].getType() );
-          argTypes.push_back( tn );
-          if( tn!=n[i].getType() ){
+      std::vector<Node>& children = f.d_children;
+      Node op;
+      if (cur.hasOperator())
+      {
+        op = cur.getOperator();
+      }
+      if (isQuant)
+      {
+        //erase from variable bound
+        for (const Node& v : cur[0])
+        {
+          Trace("sort-inference-debug2")
+              << "Remove bound for " << v << std::endl;
+          var_bound.erase(v);
+        }
+        ret = nm->mkNode(ck, children);
+      }
+      else if (ck == kind::EQUAL)
+      {
+        TypeNode tn1 = children[0].getType();
+        TypeNode tn2 = children[1].getType();
+        if( !tn1.isComparableTo( tn2 ) ){
+          Trace("sort-inference-warn") << "Sort inference created bad equality: " << children[0] << " = " << children[1] << std::endl;
+          Trace("sort-inference-warn") << "  Types : " << children[0].getType() << " " << children[1].getType() << std::endl;
+          Assert(false);
+        }
+        ret = nm->mkNode(kind::EQUAL, children);
+      }
+      else if (isHandledApplyUf(ck))
+      {
+        if( d_symbol_map.find( op )==d_symbol_map.end() ){
+          //make the new operator if necessary
+          bool opChanged = false;
+          std::vector< TypeNode > argTypes;
+          for (size_t i = 0, size = cur.getNumChildren(); i < size; i++)
+          {
+            TypeNode tn = getOrCreateTypeForId(d_op_arg_types[op][i],
+                                               cur[i].getType());
+            argTypes.push_back( tn );
+            if (tn != cur[i].getType())
+            {
+              opChanged = true;
+            }
+          }
+          TypeNode retType =
+              getOrCreateTypeForId(d_op_return_types[op], cur.getType());
+          if (retType != cur.getType())
+          {
             opChanged = true;
           }
+          if( opChanged ){
+            std::stringstream ss;
+            ss << "io_" << op;
+            TypeNode typ = nm->mkFunctionType(argTypes, retType);
+            d_symbol_map[op] = nm->mkSkolem(
+                ss.str(), typ, "op created during sort inference");
+            Trace("setp-model") << "Function " << op << " is replaced with " << d_symbol_map[op] << std::endl;
+            model_replace_f[op] = d_symbol_map[op];
+          }else{
+            d_symbol_map[op] = op;
+          }
         }
-        TypeNode retType = getOrCreateTypeForId( d_op_return_types[op], n.getType() );
-        if( retType!=n.getType() ){
-          opChanged = true;
-        }
-        if( opChanged ){
-          std::stringstream ss;
-          ss << "io_" << op;
-          TypeNode typ = NodeManager::currentNM()->mkFunctionType( argTypes, retType );
-          d_symbol_map[op] = NodeManager::currentNM()->mkSkolem( ss.str(), typ, "op created during sort inference" );
-          Trace("setp-model") << "Function " << op << " is replaced with " << d_symbol_map[op] << std::endl;
-          model_replace_f[op] = d_symbol_map[op];
-        }else{
-          d_symbol_map[op] = op;
+        children[0] = d_symbol_map[op];
+        // make sure all children have been given proper types
+        for (size_t i = 0, size = cur.getNumChildren(); i < size; i++)
+        {
+          TypeNode tn = children[i+1].getType();
+          TypeNode tna = getTypeForId( d_op_arg_types[op][i] );
+          if (!tn.isSubtypeOf(tna))
+          {
+            Trace("sort-inference-warn")
+                << "Sort inference created bad child: " << cur << " "
+                << cur[i] << " " << tn << " " << tna << std::endl;
+            Assert(false);
+          }
         }
+        ret = nm->mkNode(kind::APPLY_UF, children);
       }
-      children[0] = d_symbol_map[op];
-      // make sure all children have been given proper types
-      for (size_t i = 0, size = n.getNumChildren(); i < size; i++)
+      else
       {
-        TypeNode tn = children[i+1].getType();
-        TypeNode tna = getTypeForId( d_op_arg_types[op][i] );
-        if (!tn.isSubtypeOf(tna))
+        std::unordered_map<Node, Node, NodeHashFunction>::iterator it =
+            var_bound.find(cur);
+        if( it!=var_bound.end() ){
+          ret = it->second;
+        }
+        else if (ck == kind::VARIABLE || ck == kind::SKOLEM)
         {
-          Trace("sort-inference-warn") << "Sort inference created bad child: " << n << " " << n[i] << " " << tn << " " << tna << std::endl;
-          Assert(false);
+          if (d_symbol_map.find(cur) == d_symbol_map.end())
+          {
+            TypeNode tn =
+                getOrCreateTypeForId(d_op_return_types[cur], cur.getType());
+            d_symbol_map[cur] = getNewSymbol(cur, tn);
+          }
+          ret = d_symbol_map[cur];
         }
-      }
-      ret = NodeManager::currentNM()->mkNode( kind::APPLY_UF, children );
-    }else{
-      std::map< Node, Node >::iterator it = var_bound.find( n );
-      if( it!=var_bound.end() ){
-        ret = it->second;
-      }else if( n.getKind() == kind::VARIABLE || n.getKind() == kind::SKOLEM ){
-        if( d_symbol_map.find( n )==d_symbol_map.end() ){
-          TypeNode tn = getOrCreateTypeForId( d_op_return_types[n], n.getType() );
-          d_symbol_map[n] = getNewSymbol( n, tn );
+        else if (cur.isConst())
+        {
+          //type is determined by context
+          ret = getNewSymbol(cur, f.d_tnn);
+        }
+        else if (f.d_childChanged)
+        {
+          ret = nm->mkNode(ck, children);
+        }
+        else
+        {
+          ret = cur;
         }
-        ret = d_symbol_map[n];
-      }else if( n.isConst() ){
-        //type is determined by context
-        ret = getNewSymbol( n, tnn );
-      }else if( childChanged ){
-        ret = NodeManager::currentNM()->mkNode( n.getKind(), children );
-      }else{
-        ret = n;
       }
+      (*f.d_visited)[cur][f.d_tnn] = ret;
+      visit.pop_back();
     }
-    visited[n][tnn] = ret;
-    return ret;
-  }
+    // the term is simplified, add it to its parent
+    if (!visit.empty())
+    {
+      SimplifyFrame& p = visit.back();
+      size_t i = p.d_nextChild;
+      Trace("sort-inference-debug2") << "Simplify " << i << " " << p.d_node[i]
+                                     << " returned " << ret << std::endl;
+      p.d_children.push_back(ret);
+      p.d_childChanged = p.d_childChanged || ret != p.d_node[i];
+      p.d_nextChild++;
+    }
+  } while (!visit.empty());
+  return ret;
 }
 
 Node SortInference::mkInjection( TypeNode tn1, TypeNode tn2 ) {
@@ -815,8 +957,8 @@ void SortInference::setSkolemVar( Node f, Node v, Node sk ){
   Trace("sort-inference-temp") << "Set skolem var for " << f << ", variable " << v << std::endl;
   if( isWellSortedFormula( f ) && d_var_types.find( f )==d_var_types.end() ){
     //calculate the sort for variables if not done so already
-    std::map< Node, Node > var_bound;
-    std::map< Node, int > visited;
+    std::unordered_map<Node, Node, NodeHashFunction> var_bound;
+    std::unordered_map<Node, int, NodeHashFunction> visited;
     process( f, var_bound, visited );
   }
   d_op_return_types[sk] = getSortId( f, v );
@@ -18,6 +18,7 @@
 #define CVC4__SORT_INFERENCE_H
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "expr/node.h"
@@ -42,13 +43,21 @@ private:
   std::map< TypeNode, std::vector< int > > d_type_sub_sorts;
   void recordSubsort( TypeNode tn, int s );
 public:
+  /**
+   * A union-find data structure over the sort ids, which are allocated
+   * densely. The representative of an equivalence class is its smallest id.
+   */
   class UnionFind {
   public:
     UnionFind(){}
     UnionFind( UnionFind& c ){
       set( c );
     }
-    std::map< int, int > d_eqc;
+    /**
+     * The parent of each id, where the ids not in the domain of this vector
+     * and the representatives are their own parents.
+     */
+    std::vector<int> d_eqc;
     //pairs that must be disequal
     std::vector< std::pair< int, int > > d_deq;
     void print(const char * c);
@@ -65,12 +74,12 @@ public:
   /** the id count for all subsorts we have allocated */
   int d_sortCount;
   UnionFind d_type_union_find;
-  std::map< int, TypeNode > d_type_types;
-  std::map< TypeNode, int > d_id_for_types;
+  std::unordered_map<int, TypeNode> d_type_types;
+  std::unordered_map<TypeNode, int, TypeNodeHashFunction> d_id_for_types;
   //for apply uf operators
   std::map< Node, int > d_op_return_types;
   std::map< Node, std::vector< int > > d_op_arg_types;
-  std::map< Node, int > d_equality_types;
+  std::unordered_map<Node, int, NodeHashFunction> d_equality_types;
   //for bound variables
   std::map< Node, std::map< Node, int > > d_var_types;
   //get representative
@@ -78,7 +87,9 @@ public:
   int getIdForType( TypeNode tn );
   void printSort( const char* c, int t );
   //process
-  int process( Node n, std::map< Node, Node >& var_bound, std::map< Node, int >& visited );
+  int process(Node n,
+              std::unordered_map<Node, Node, NodeHashFunction>& var_bound,
+              std::unordered_map<Node, int, NodeHashFunction>& visited);
   // for monotonicity inference
  private:
   void processMonotonic( Node n, bool pol, bool hasPol, std::map< Node, Node >& var_bound, std::map< Node, std::map< int, bool > >& visited, bool typeMode = false );
@@ -86,19 +97,28 @@ public:
 //for rewriting
 private:
   //mapping from old symbols to new symbols
-  std::map< Node, Node > d_symbol_map;
+  std::unordered_map<Node, Node, NodeHashFunction> d_symbol_map;
   //mapping from constants to new symbols
   std::map< TypeNode, std::map< Node, Node > > d_const_map;
   //helper functions for simplify
   TypeNode getOrCreateTypeForId( int t, TypeNode pref );
   TypeNode getTypeForId( int t );
   Node getNewSymbol( Node old, TypeNode tn );
-  //simplify
+  /**
+   * Simplify n in the type context tnn, i.e. the type that n is expected to
+   * have if not null, where var_bound maps the bound variables in scope to
+   * their new symbols. The terms are rebuilt by an iterative traversal.
+   */
   Node simplifyNode(Node n,
-                    std::map<Node, Node>& var_bound,
+                    std::unordered_map<Node, Node, NodeHashFunction>& var_bound,
                     TypeNode tnn,
                     std::map<Node, Node>& model_replace_f,
                     std::map<Node, std::map<TypeNode, Node> >& visited);
+  /**
+   * Get the type context of the i^th child of n in simplifyNode, or null if
+   * it is not constrained.
+   */
+  TypeNode getChildTypeContext(Node n, size_t i);
   //make injection
   Node mkInjection( TypeNode tn1, TypeNode tn2 );
   //reset
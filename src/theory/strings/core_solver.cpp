@@ -19,6 +19,7 @@
 #include "base/configuration.h"
 #include "options/strings_options.h"
 #include "smt/logic_exception.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/rewriter.h"
 #include "theory/strings/sequences_rewriter.h"
 #include "theory/strings/strings_entail.h"
@@ -43,7 +44,9 @@ CoreSolver::CoreSolver(SolverState& s,
       d_im(im),
       d_termReg(tr),
       d_bsolver(bs),
-      d_nfPairs(s.getSatContext())
+      d_nfPairs(s.getSatContext()),
+      d_nfCacheTrail(s.getSatContext()),
+      d_nfIdCounter(1)
 {
   d_zero = NodeManager::currentNM()->mkConst( Rational( 0 ) );
   d_one = NodeManager::currentNM()->mkConst( Rational( 1 ) );
@@ -56,6 +59,20 @@ CoreSolver::~CoreSolver() {
 
 }
 
+CoreSolver::Statistics::Statistics()
+    : d_nfComputed("theory::strings::CoreSolver::nfComputed", 0),
+      d_nfReused("theory::strings::CoreSolver::nfReused", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_nfComputed);
+  smtStatisticsRegistry()->registerStat(&d_nfReused);
+}
+
+CoreSolver::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_nfComputed);
+  smtStatisticsRegistry()->unregisterStat(&d_nfReused);
+}
+
 void CoreSolver::debugPrintFlatForms( const char * tc ){
   for( unsigned k=0; k<d_strings_eqc.size(); k++ ){
     Node eqc = d_strings_eqc[k];
@@ -542,6 +559,7 @@ void CoreSolver::checkNormalFormsEq()
   // calculate normal forms for each equivalence class, possibly adding
   // splitting lemmas
   d_normal_form.clear();
+  d_nfId.clear();
   std::map<Node, Node> nf_to_eqc;
   std::map<Node, Node> eqc_to_nf;
   std::map<Node, Node> eqc_to_exp;
@@ -619,11 +637,23 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
     //do nothing
     Trace("strings-process-debug") << "Return process equivalence class " << eqc << " : empty." << std::endl;
     d_normal_form[eqc].init(emp);
+    d_nfId[eqc] = 0;
   }
   else
   {
     // should not have computed the normal form of this equivalence class yet
     Assert(d_normal_form.find(eqc) == d_normal_form.end());
+    std::vector<Node> sig;
+    std::vector<size_t> childIds;
+    if (options::stringIncNormalForms())
+    {
+      getNormalFormSignature(eqc, sig, childIds);
+      if (reuseNormalForm(eqc, sig, childIds))
+      {
+        return;
+      }
+    }
+    ++d_statistics.d_nfComputed;
     // Normal forms for the relevant terms in the equivalence class of eqc
     std::vector<NormalForm> normal_forms;
     // map each term to its index in the above vector
@@ -653,10 +683,86 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
       nf_index = it->second;
     }
     d_normal_form[eqc] = normal_forms[nf_index];
+    d_nfId[eqc] = d_nfIdCounter++;
     Trace("strings-process-debug")
         << "Return process equivalence class " << eqc
         << " : returned = " << d_normal_form[eqc].d_nf << std::endl;
+    if (options::stringIncNormalForms())
+    {
+      // Only cache the normal form if all terms have the same normal form,
+      // since processNEqc may otherwise make inferences based on the
+      // current context beyond the inputs of the normal form.
+      for (const NormalForm& nf : normal_forms)
+      {
+        if (nf.d_nf != normal_forms[0].d_nf)
+        {
+          return;
+        }
+      }
+      CachedNormalForm& cnf = d_nfCache[eqc];
+      cnf.d_sig = sig;
+      cnf.d_childIds = childIds;
+      cnf.d_nf = d_normal_form[eqc];
+      cnf.d_id = d_nfId[eqc];
+      cnf.d_trailIndex = d_nfCacheTrail.size();
+      d_nfCacheTrail.push_back(eqc);
+    }
+  }
+}
+
+void CoreSolver::getNormalFormSignature(Node eqc,
+                                        std::vector<Node>& sig,
+                                        std::vector<size_t>& childIds)
+{
+  eq::EqualityEngine* ee = d_state.getEqualityEngine();
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, ee);
+  while (!eqc_i.isFinished())
+  {
+    Node n = (*eqc_i);
+    ++eqc_i;
+    if (d_bsolver.isCongruent(n))
+    {
+      continue;
+    }
+    sig.push_back(n);
+    if (n.getKind() != STRING_CONCAT)
+    {
+      continue;
+    }
+    for (const Node& nc : n)
+    {
+      Node nr = ee->getRepresentative(nc);
+      sig.push_back(nr);
+      std::map<Node, size_t>::iterator it = d_nfId.find(nr);
+      // a component without a normal form never matches
+      childIds.push_back(it == d_nfId.end() ? d_nfIdCounter++ : it->second);
+    }
   }
+  sig.push_back(d_bsolver.getConstantEqc(eqc));
+}
+
+bool CoreSolver::reuseNormalForm(Node eqc,
+                                 const std::vector<Node>& sig,
+                                 const std::vector<size_t>& childIds)
+{
+  std::map<Node, CachedNormalForm>::iterator it = d_nfCache.find(eqc);
+  if (it == d_nfCache.end())
+  {
+    return false;
+  }
+  CachedNormalForm& cnf = it->second;
+  if (cnf.d_trailIndex >= d_nfCacheTrail.size()
+      || d_nfCacheTrail[cnf.d_trailIndex] != eqc || cnf.d_sig != sig
+      || cnf.d_childIds != childIds)
+  {
+    return false;
+  }
+  Trace("strings-process-debug")
+      << "Reuse normal form of equivalence class " << eqc << std::endl;
+  d_normal_form[eqc] = cnf.d_nf;
+  d_nfId[eqc] = cnf.d_id;
+  ++d_statistics.d_nfReused;
+  return true;
 }
 
 NormalForm& CoreSolver::getNormalForm(Node n)
@@ -2446,7 +2552,7 @@ void CoreSolver::addNormalFormPair( Node n1, Node n2 ){
     {
       index = (*it).second;
     }
-    d_nfPairs[n1] = index + 1;
+    d_nfPairs.insert(n1, index + 1);
     if( index<(int)d_nf_pairs_data[n1].size() ){
       d_nf_pairs_data[n1][index] = n2;
     }else{
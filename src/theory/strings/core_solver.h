@@ -20,12 +20,14 @@
 
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
+#include "context/cdundo_hashmap.h"
 #include "theory/strings/base_solver.h"
 #include "theory/strings/infer_info.h"
 #include "theory/strings/inference_manager.h"
 #include "theory/strings/normal_form.h"
 #include "theory/strings/solver_state.h"
 #include "theory/strings/term_registry.h"
+#include "util/statistics_registry.h"
 
 namespace cvc5 {
 namespace theory {
@@ -78,7 +80,7 @@ class CoreInferInfo
 class CoreSolver
 {
   friend class InferenceManager;
-  using NodeIntMap = context::CDHashMap<Node, int, NodeHashFunction>;
+  using NodeIntMap = context::CDUndoHashMap<Node, int, NodeHashFunction>;
 
  public:
   CoreSolver(SolverState& s,
@@ -519,6 +521,70 @@ class CoreSolver
    * the argument number of the t1 ... tn they were generated from.
    */
   std::map<Node, std::vector<int> > d_flat_form_index;
+
+  //--------------------------for incremental normal forms
+  /**
+   * A normal form cached across the calls to checkNormalFormsEq, when option
+   * stringIncNormalForms is true.
+   */
+  struct CachedNormalForm
+  {
+    /** The inputs of the normal form, see getNormalFormSignature */
+    std::vector<Node> d_sig;
+    /** The identifiers of the normal forms of the components */
+    std::vector<size_t> d_childIds;
+    /** The normal form */
+    NormalForm d_nf;
+    /** The identifier of the normal form */
+    size_t d_id;
+    /** The index of the equivalence class in d_nfCacheTrail */
+    size_t d_trailIndex;
+  };
+  /**
+   * Get the inputs of the normal form of equivalence class eqc: its
+   * non-congruent terms, the representatives of the components of its
+   * concatenation terms and its constant in sig, and the identifiers of the
+   * normal forms of these representatives in childIds. The normal form of
+   * eqc is computed from these inputs only, hence it can be reused if they
+   * did not change.
+   */
+  void getNormalFormSignature(Node eqc,
+                              std::vector<Node>& sig,
+                              std::vector<size_t>& childIds);
+  /**
+   * Set the normal form of eqc to its cached normal form, if the cached
+   * normal form is valid in the current context and its inputs did not
+   * change. Returns true if it did.
+   */
+  bool reuseNormalForm(Node eqc,
+                       const std::vector<Node>& sig,
+                       const std::vector<size_t>& childIds);
+  /** The cached normal forms of the equivalence classes */
+  std::map<Node, CachedNormalForm> d_nfCache;
+  /**
+   * The equivalence classes whose normal form was cached in the current SAT
+   * context. A cached normal form is only valid while its equivalence class
+   * is at its index in this list, since it is explained by literals that may
+   * be retracted when the SAT context is popped.
+   */
+  context::CDList<Node> d_nfCacheTrail;
+  /** The identifiers of the normal forms computed in this call */
+  std::map<Node, size_t> d_nfId;
+  /** The next identifier of a normal form, 0 is the empty normal form */
+  size_t d_nfIdCounter;
+
+  class Statistics
+  {
+   public:
+    /** The number of normal forms that were computed */
+    IntStat d_nfComputed;
+    /** The number of normal forms that were reused */
+    IntStat d_nfReused;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+  //--------------------------end for incremental normal forms
 }; /* class CoreSolver */
 
 }  // namespace strings
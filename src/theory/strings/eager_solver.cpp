@@ -14,6 +14,9 @@
 
 #include "theory/strings/eager_solver.h"
 
+#include "options/strings_options.h"
+#include "theory/rewriter.h"
+#include "theory/strings/regexp_entail.h"
 #include "theory/strings/theory_strings_utils.h"
 
 using namespace cvc5::kind;
@@ -67,6 +70,7 @@ void EagerSolver::eqNotifyMerge(TNode t1, TNode t2)
   }
   Assert(t1.getType().isStringLike());
   EqcInfo* e1 = d_state.getOrMakeEqcInfo(t1);
+  bool wasConst1 = !getConstant(e1).isNull();
   // add information from e2 to e1
   if (!e2->d_lengthTerm.get().isNull())
   {
@@ -94,6 +98,28 @@ void EagerSolver::eqNotifyMerge(TNode t1, TNode t2)
   {
     e1->d_normalizedLength.set(e2->d_normalizedLength);
   }
+  // the memberships that were not checked are checked if the merged class
+  // has a constant, and are kept otherwise
+  Node c = getConstant(e1);
+  for (unsigned i = 0; i < 2; i++)
+  {
+    if (i == 0 && (wasConst1 || c.isNull()))
+    {
+      continue;
+    }
+    EqcInfo* ei = i == 0 ? e1 : e2;
+    for (const Node& mem : ei->d_mems)
+    {
+      if (c.isNull())
+      {
+        e1->d_mems.push_back(mem);
+      }
+      else
+      {
+        checkConstMembership(mem, c);
+      }
+    }
+  }
 }
 
 void EagerSolver::eqNotifyDisequal(TNode t1, TNode t2, TNode reason)
@@ -130,6 +156,50 @@ void EagerSolver::addEndpointsToEqcInfo(Node t, Node concat, Node eqc)
   }
 }
 
+Node EagerSolver::getConstant(EqcInfo* ei)
+{
+  // the prefix of an equivalence class is its constant if it has one
+  Node p = ei->d_prefixC;
+  return !p.isNull() && p.isConst() ? p : Node::null();
+}
+
+void EagerSolver::addMembership(Node mem, EqcInfo* ei)
+{
+  Node c = getConstant(ei);
+  if (c.isNull())
+  {
+    ei->d_mems.push_back(mem);
+  }
+  else
+  {
+    checkConstMembership(mem, c);
+  }
+}
+
+void EagerSolver::checkConstMembership(Node mem, Node c)
+{
+  bool polarity = mem.getKind() != NOT;
+  Node atom = polarity ? mem : mem[0];
+  Assert(atom.getKind() == STRING_IN_REGEXP);
+  NodeManager* nm = NodeManager::currentNM();
+  Node res = Rewriter::rewrite(nm->mkNode(STRING_IN_REGEXP, c, atom[1]));
+  if (!res.isConst() || res.getConst<bool>() == polarity)
+  {
+    return;
+  }
+  Trace("strings-eager-re")
+      << "String: eager membership conflict: " << mem << " for " << c
+      << std::endl;
+  InferInfo iiMemConf(InferenceId::STRINGS_RE_EAGER_CONF);
+  iiMemConf.d_conc = nm->mkConst(false);
+  iiMemConf.d_premises.push_back(mem);
+  if (atom[0] != c)
+  {
+    iiMemConf.d_premises.push_back(atom[0].eqNode(c));
+  }
+  d_state.setPendingConflict(iiMemConf);
+}
+
 void EagerSolver::notifyFact(TNode atom,
                              bool polarity,
                              TNode fact,
@@ -137,12 +207,16 @@ void EagerSolver::notifyFact(TNode atom,
 {
   if (atom.getKind() == STRING_IN_REGEXP)
   {
+    eq::EqualityEngine* ee = d_state.getEqualityEngine();
+    Node eqc = ee->getRepresentative(atom[0]);
     if (polarity && atom[1].getKind() == REGEXP_CONCAT)
     {
-      eq::EqualityEngine* ee = d_state.getEqualityEngine();
-      Node eqc = ee->getRepresentative(atom[0]);
       addEndpointsToEqcInfo(atom, atom[1], eqc);
     }
+    if (options::stringEagerRegExp() && RegExpEntail::isConstRegExp(atom[1]))
+    {
+      addMembership(fact, d_state.getOrMakeEqcInfo(eqc));
+    }
   }
 }
 
@@ -57,6 +57,21 @@ class EagerSolver
    * for some eqc that is currently equal to z.
    */
   void addEndpointsToEqcInfo(Node t, Node concat, Node eqc);
+  /**
+   * Add the membership literal mem, of the form (str.in.re x R) or its
+   * negation for a constant R, to the eqc info ei of the equivalence class of
+   * x. If the equivalence class contains a constant, the literal is checked
+   * instead, see checkConstMembership.
+   */
+  void addMembership(Node mem, EqcInfo* ei);
+  /**
+   * Check the membership literal mem, of the form (str.in.re x R) or its
+   * negation for a constant R, where x is equal to the constant c. If it does
+   * not hold, this sets a pending conflict of the solver state.
+   */
+  void checkConstMembership(Node mem, Node c);
+  /** Get the constant of the equivalence class of ei, or null if none */
+  static Node getConstant(EqcInfo* ei);
   /** Reference to the solver state */
   SolverState& d_state;
 };
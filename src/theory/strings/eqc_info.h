@@ -19,6 +19,7 @@
 
 #include <map>
 
+#include "context/cdlist.h"
 #include "context/cdo.h"
 #include "context/context.h"
 #include "expr/node.h"
@@ -72,6 +73,12 @@ class EqcInfo
   context::CDO<Node> d_prefixC;
   /** same as above, for suffix. */
   context::CDO<Node> d_suffixC;
+  /**
+   * The literals (str.in.re x R) and (not (str.in.re x R)) asserted in this
+   * SAT context for a term x of this equivalence class and a constant R,
+   * while this equivalence class did not contain a constant.
+   */
+  context::CDList<Node> d_mems;
 };
 
 }  // namespace strings
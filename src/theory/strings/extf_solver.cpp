@@ -250,6 +250,11 @@ void ExtfSolver::checkExtfEval(int effort)
   std::vector<Node> terms = d_extt.getActive();
   // the set of terms we have done extf inferences for
   std::unordered_set<Node, NodeHashFunction> inferProcessed;
+  // The current substitution of the children of the terms, with its
+  // explanation. The extended terms typically share many children, whose
+  // substitution is computed once for all terms.
+  std::unordered_map<Node, std::pair<Node, std::vector<Node>>, NodeHashFunction>
+      subsCache;
   for (const Node& n : terms)
   {
     // Setup information about n, including if it is equal to a constant.
@@ -274,7 +279,15 @@ void ExtfSolver::checkExtfEval(int effort)
     bool schanged = false;
     for (const Node& nc : n)
     {
-      Node sc = getCurrentSubstitutionFor(effort, nc, exp);
+      auto it = subsCache.find(nc);
+      if (it == subsCache.end())
+      {
+        std::vector<Node> sexp;
+        Node sc = getCurrentSubstitutionFor(effort, nc, sexp);
+        it = subsCache.emplace(nc, std::make_pair(sc, sexp)).first;
+      }
+      const Node& sc = it->second.first;
+      exp.insert(exp.end(), it->second.second.begin(), it->second.second.end());
       schildren.push_back(sc);
       schanged = schanged || sc != nc;
     }
@@ -0,0 +1,101 @@
+/*********************                                                        */
+/*! \file regexp_cache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Bounded caches for the operations on regular expressions
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__REGEXP_CACHE_H
+#define CVC4__THEORY__STRINGS__REGEXP_CACHE_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+/** The statistics shared by the caches of the regular expression operations */
+struct RegExpCacheStats
+{
+  /** The number of lookups that found a value */
+  IntStat* d_hits;
+  /** The number of lookups that did not find a value */
+  IntStat* d_misses;
+  /** The number of times a cache was cleared because it was full */
+  IntStat* d_clears;
+};
+
+/**
+ * A hash map for caching the results of context-independent operations on
+ * regular expressions, whose number of entries is bounded. When an entry is
+ * inserted in a full cache, the cache is cleared first, which is sound since
+ * the cached results can be recomputed.
+ */
+template <class Key, class Value, class KeyHash = std::hash<Key>>
+class RegExpCache
+{
+ public:
+  /** Make a cache of at most capacity entries, or unbounded if it is 0 */
+  RegExpCache(size_t capacity, const RegExpCacheStats& stats)
+      : d_capacity(capacity), d_stats(stats)
+  {
+  }
+
+  /**
+   * Return the cached value of k, or nullptr if there is none. The pointer is
+   * invalidated by the next insertion.
+   */
+  const Value* find(const Key& k) const
+  {
+    typename std::unordered_map<Key, Value, KeyHash>::const_iterator it =
+        d_map.find(k);
+    if (it == d_map.end())
+    {
+      ++(*d_stats.d_misses);
+      return nullptr;
+    }
+    ++(*d_stats.d_hits);
+    return &it->second;
+  }
+
+  /** Cache v as the value of k */
+  void insert(const Key& k, const Value& v)
+  {
+    if (d_capacity > 0 && d_map.size() >= d_capacity
+        && d_map.find(k) == d_map.end())
+    {
+      d_map.clear();
+      ++(*d_stats.d_clears);
+    }
+    d_map[k] = v;
+  }
+
+  /** Return the number of entries */
+  size_t size() const { return d_map.size(); }
+
+ private:
+  /** The maximal number of entries, 0 for no bound */
+  size_t d_capacity;
+  /** The statistics */
+  RegExpCacheStats d_stats;
+  /** The entries */
+  std::unordered_map<Key, Value, KeyHash> d_map;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__STRINGS__REGEXP_CACHE_H */
@@ -0,0 +1,463 @@
+/*********************                                                        */
+/*! \file regexp_dfa.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Compiled automata for constant regular expressions
+ **
+ ** Automata for testing the membership of constant strings in constant
+ ** regular expressions.
+ **/
+
+#include "theory/strings/regexp_dfa.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "theory/strings/theory_strings_utils.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+namespace {
+
+/** The maximal number of states of the nondeterministic automata */
+const size_t s_maxNfaStates = 1 << 16;
+/** The maximal number of entries of the transition tables */
+const size_t s_maxTableSize = 1 << 22;
+/** The maximal number of pairs of states explored in products */
+const size_t s_maxProductStates = 1 << 16;
+
+}  // namespace
+
+const uint32_t RegExpDfa::s_unknown = std::numeric_limits<uint32_t>::max();
+
+RegExpDfa::RegExpDfa(TNode r) : d_supported(false), d_final(0), d_initial(0)
+{
+  Fragment f;
+  if (!compile(r, f))
+  {
+    Trace("regexp-dfa") << "Unsupported regular expression " << r << std::endl;
+    d_nfa.clear();
+    return;
+  }
+  d_supported = true;
+  d_final = f.d_end;
+  computeClasses();
+  std::vector<uint32_t> initial{f.d_start};
+  d_initial = getDfaState(initial);
+  Trace("regexp-dfa") << "Compiled " << r << " to " << d_nfa.size()
+                      << " states and " << (d_bounds.size() + 1)
+                      << " character classes" << std::endl;
+}
+
+uint32_t RegExpDfa::mkState()
+{
+  d_nfa.emplace_back();
+  return d_nfa.size() - 1;
+}
+
+void RegExpDfa::addEdge(uint32_t from, uint32_t to, unsigned lo, unsigned hi)
+{
+  d_nfa[from].push_back(Edge{lo, hi, false, to});
+}
+
+void RegExpDfa::addEpsilon(uint32_t from, uint32_t to)
+{
+  d_nfa[from].push_back(Edge{0, 0, true, to});
+}
+
+bool RegExpDfa::compile(TNode r, Fragment& f)
+{
+  if (d_nfa.size() > s_maxNfaStates)
+  {
+    return false;
+  }
+  switch (r.getKind())
+  {
+    case STRING_TO_REGEXP:
+    {
+      if (!r[0].isConst())
+      {
+        return false;
+      }
+      f.d_start = mkState();
+      f.d_end = f.d_start;
+      for (unsigned c : r[0].getConst<String>().getVec())
+      {
+        uint32_t next = mkState();
+        addEdge(f.d_end, next, c, c);
+        f.d_end = next;
+      }
+      return true;
+    }
+    case REGEXP_CONCAT:
+    {
+      for (size_t i = 0, nchild = r.getNumChildren(); i < nchild; ++i)
+      {
+        Fragment fc;
+        if (!compile(r[i], fc))
+        {
+          return false;
+        }
+        if (i == 0)
+        {
+          f.d_start = fc.d_start;
+        }
+        else
+        {
+          addEpsilon(f.d_end, fc.d_start);
+        }
+        f.d_end = fc.d_end;
+      }
+      return true;
+    }
+    case REGEXP_UNION:
+    {
+      f.d_start = mkState();
+      f.d_end = mkState();
+      for (TNode rc : r)
+      {
+        Fragment fc;
+        if (!compile(rc, fc))
+        {
+          return false;
+        }
+        addEpsilon(f.d_start, fc.d_start);
+        addEpsilon(fc.d_end, f.d_end);
+      }
+      return true;
+    }
+    case REGEXP_STAR:
+    {
+      Fragment fc;
+      if (!compile(r[0], fc))
+      {
+        return false;
+      }
+      f.d_start = mkState();
+      f.d_end = mkState();
+      addEpsilon(f.d_start, fc.d_start);
+      addEpsilon(f.d_start, f.d_end);
+      addEpsilon(fc.d_end, fc.d_start);
+      addEpsilon(fc.d_end, f.d_end);
+      return true;
+    }
+    case REGEXP_EMPTY:
+    {
+      f.d_start = mkState();
+      f.d_end = mkState();
+      return true;
+    }
+    case REGEXP_SIGMA:
+    {
+      f.d_start = mkState();
+      f.d_end = mkState();
+      addEdge(f.d_start, f.d_end, 0, String::num_codes() - 1);
+      return true;
+    }
+    case REGEXP_RANGE:
+    {
+      if (!r[0].isConst() || !r[1].isConst()
+          || r[0].getConst<String>().size() != 1
+          || r[1].getConst<String>().size() != 1)
+      {
+        return false;
+      }
+      f.d_start = mkState();
+      f.d_end = mkState();
+      unsigned a = r[0].getConst<String>().front();
+      unsigned b = r[1].getConst<String>().front();
+      if (a <= b)
+      {
+        addEdge(f.d_start, f.d_end, a, b);
+      }
+      return true;
+    }
+    case REGEXP_LOOP:
+    {
+      uint32_t l = utils::getLoopMinOccurrences(r);
+      uint32_t u = utils::getLoopMaxOccurrences(r);
+      if (l > s_maxNfaStates || (u > l && u - l > s_maxNfaStates))
+      {
+        return false;
+      }
+      f.d_start = mkState();
+      f.d_end = f.d_start;
+      if (u < l)
+      {
+        f.d_end = mkState();
+        return true;
+      }
+      // r{l,u} is l copies of r followed by u - l optional copies of r, each
+      // of which can skip to the end
+      uint32_t end = mkState();
+      for (uint32_t i = 0; i < u; ++i)
+      {
+        Fragment fc;
+        if (!compile(r[0], fc))
+        {
+          return false;
+        }
+        if (i >= l)
+        {
+          addEpsilon(f.d_end, end);
+        }
+        addEpsilon(f.d_end, fc.d_start);
+        f.d_end = fc.d_end;
+      }
+      addEpsilon(f.d_end, end);
+      f.d_end = end;
+      return true;
+    }
+    default:
+    {
+      // REGEXP_INTER, REGEXP_COMPLEMENT and the internal operators
+      return false;
+    }
+  }
+}
+
+void RegExpDfa::computeClasses()
+{
+  for (const std::vector<Edge>& edges : d_nfa)
+  {
+    for (const Edge& e : edges)
+    {
+      if (e.d_epsilon)
+      {
+        continue;
+      }
+      if (e.d_lo > 0)
+      {
+        d_bounds.push_back(e.d_lo);
+      }
+      if (e.d_hi + 1 < String::num_codes())
+      {
+        d_bounds.push_back(e.d_hi + 1);
+      }
+    }
+  }
+  std::sort(d_bounds.begin(), d_bounds.end());
+  d_bounds.erase(std::unique(d_bounds.begin(), d_bounds.end()),
+                 d_bounds.end());
+}
+
+uint32_t RegExpDfa::getClass(unsigned c) const
+{
+  return std::upper_bound(d_bounds.begin(), d_bounds.end(), c)
+         - d_bounds.begin();
+}
+
+uint32_t RegExpDfa::getDfaState(std::vector<uint32_t>& states)
+{
+  // the epsilon-closure of states
+  std::vector<bool> inClosure(d_nfa.size(), false);
+  std::vector<uint32_t> visit(states);
+  states.clear();
+  while (!visit.empty())
+  {
+    uint32_t cur = visit.back();
+    visit.pop_back();
+    if (inClosure[cur])
+    {
+      continue;
+    }
+    inClosure[cur] = true;
+    states.push_back(cur);
+    for (const Edge& e : d_nfa[cur])
+    {
+      if (e.d_epsilon)
+      {
+        visit.push_back(e.d_target);
+      }
+    }
+  }
+  std::sort(states.begin(), states.end());
+
+  auto it = d_dfaStateOf.find(states);
+  if (it != d_dfaStateOf.end())
+  {
+    return it->second;
+  }
+  uint32_t q = d_dfaStates.size();
+  d_dfaStateOf[states] = q;
+  d_accepting.push_back(inClosure[d_final]);
+  d_dfaStates.push_back(states);
+  d_table.resize(d_table.size() + d_bounds.size() + 1, s_unknown);
+  return q;
+}
+
+uint32_t RegExpDfa::computeSuccessor(uint32_t q, uint32_t c)
+{
+  // all characters of class c have the transitions of its lower bound
+  unsigned rep = c == 0 ? 0 : d_bounds[c - 1];
+  std::vector<uint32_t> next;
+  for (uint32_t s : d_dfaStates[q])
+  {
+    for (const Edge& e : d_nfa[s])
+    {
+      if (!e.d_epsilon && e.d_lo <= rep && rep <= e.d_hi)
+      {
+        next.push_back(e.d_target);
+      }
+    }
+  }
+  uint32_t succ = getDfaState(next);
+  d_table[q * (d_bounds.size() + 1) + c] = succ;
+  return succ;
+}
+
+uint32_t RegExpDfa::getSuccessor(uint32_t q, unsigned c)
+{
+  uint32_t cc = getClass(c);
+  uint32_t succ = d_table[q * (d_bounds.size() + 1) + cc];
+  if (succ == s_unknown && d_table.size() <= s_maxTableSize)
+  {
+    succ = computeSuccessor(q, cc);
+  }
+  return succ;
+}
+
+bool RegExpDfa::test(const String& s, size_t index_start, bool& result)
+{
+  Assert(d_supported);
+  Assert(index_start <= s.size());
+  const std::vector<unsigned>& vec = s.getVec();
+  uint32_t q = d_initial;
+  for (size_t i = index_start, size = vec.size(); i < size; ++i)
+  {
+    if (isDead(q))
+    {
+      break;
+    }
+    q = getSuccessor(q, vec[i]);
+    if (q == s_unknown)
+    {
+      return false;
+    }
+  }
+  result = d_accepting[q];
+  return true;
+}
+
+RegExpDfa* RegExpDfaCache::getDfa(TNode r)
+{
+  std::unique_ptr<RegExpDfa>& dfa = d_dfas[r];
+  if (dfa == nullptr)
+  {
+    dfa.reset(new RegExpDfa(r));
+  }
+  return dfa->isSupported() ? dfa.get() : nullptr;
+}
+
+bool RegExpDfaCache::test(const String& s,
+                          size_t index_start,
+                          TNode r,
+                          bool& result)
+{
+  RegExpDfa* dfa = getDfa(r);
+  return dfa != nullptr && dfa->test(s, index_start, result);
+}
+
+bool RegExpDfaCache::includes(TNode r1, TNode r2, bool& result)
+{
+  RegExpDfa* d1 = getDfa(r1);
+  RegExpDfa* d2 = getDfa(r2);
+  if (d1 == nullptr || d2 == nullptr)
+  {
+    return false;
+  }
+  // r1 includes r2 if no word is accepted by r2 and not by r1
+  bool found;
+  if (!findInProduct(*d1, *d2, true, found))
+  {
+    return false;
+  }
+  result = !found;
+  return true;
+}
+
+bool RegExpDfaCache::isIntersectionEmpty(TNode r1, TNode r2, bool& result)
+{
+  RegExpDfa* d1 = getDfa(r1);
+  RegExpDfa* d2 = getDfa(r2);
+  if (d1 == nullptr || d2 == nullptr)
+  {
+    return false;
+  }
+  bool found;
+  if (!findInProduct(*d1, *d2, false, found))
+  {
+    return false;
+  }
+  result = !found;
+  return true;
+}
+
+bool RegExpDfaCache::findInProduct(RegExpDfa& d1,
+                                   RegExpDfa& d2,
+                                   bool neg1,
+                                   bool& found)
+{
+  // the characters of the classes of the product, which are the
+  // intersections of the classes of d1 and d2
+  std::vector<unsigned> reps{0};
+  reps.insert(reps.end(), d1.getBounds().begin(), d1.getBounds().end());
+  reps.insert(reps.end(), d2.getBounds().begin(), d2.getBounds().end());
+  std::sort(reps.begin(), reps.end());
+  reps.erase(std::unique(reps.begin(), reps.end()), reps.end());
+
+  std::set<std::pair<uint32_t, uint32_t>> visited;
+  std::vector<std::pair<uint32_t, uint32_t>> visit;
+  visit.emplace_back(d1.getInitial(), d2.getInitial());
+  while (!visit.empty())
+  {
+    std::pair<uint32_t, uint32_t> cur = visit.back();
+    visit.pop_back();
+    // the words accepted from dead states of d2, or of d1 if it must accept,
+    // are not relevant
+    if (d2.isDead(cur.second) || (!neg1 && d1.isDead(cur.first))
+        || !visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (d2.isAccepting(cur.second) && d1.isAccepting(cur.first) != neg1)
+    {
+      found = true;
+      return true;
+    }
+    if (visited.size() > s_maxProductStates)
+    {
+      return false;
+    }
+    for (unsigned c : reps)
+    {
+      uint32_t succ1 = d1.getSuccessor(cur.first, c);
+      uint32_t succ2 = d2.getSuccessor(cur.second, c);
+      if (succ1 == RegExpDfa::s_unknown || succ2 == RegExpDfa::s_unknown)
+      {
+        return false;
+      }
+      visit.emplace_back(succ1, succ2);
+    }
+  }
+  found = false;
+  return true;
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
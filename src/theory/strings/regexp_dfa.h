@@ -0,0 +1,203 @@
+/*********************                                                        */
+/*! \file regexp_dfa.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Compiled automata for constant regular expressions
+ **
+ ** Automata for testing the membership of constant strings in constant
+ ** regular expressions.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__REGEXP_DFA_H
+#define CVC4__THEORY__STRINGS__REGEXP_DFA_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+/**
+ * A deterministic automaton for a constant regular expression, built lazily.
+ *
+ * The regular expression is first compiled to a nondeterministic automaton
+ * with epsilon transitions (Thompson's construction), whose transitions are
+ * labeled by ranges of characters. The bounds of these ranges split the
+ * alphabet into character classes, such that all characters of a class have
+ * the same transitions. The states of the deterministic automaton are the
+ * epsilon-closed sets of states of the nondeterministic one, and are built by
+ * the subset construction on demand, when a string reaches them. Its
+ * transitions are stored in a table indexed by state and character class.
+ *
+ * Intersection and complement are not supported, nor are loops whose
+ * expansion is too large. Constant regular expressions containing them are
+ * rejected by the constructor, see isSupported().
+ *
+ * The product of two automata decides the emptiness of the intersection of
+ * their languages, and the inclusion of their languages, without building
+ * the regular expression of the intersection, see RegExpDfaCache.
+ */
+class RegExpDfa
+{
+ public:
+  RegExpDfa(TNode r);
+  ~RegExpDfa() {}
+
+  /** Was r compiled, i.e., does it only contain supported operators? */
+  bool isSupported() const { return d_supported; }
+  /**
+   * Set result to whether the suffix of s starting at index_start is in the
+   * language of r. Returns false if this could not be decided because the
+   * automaton grew too large, in which case result is not set.
+   */
+  bool test(const String& s, size_t index_start, bool& result);
+
+  /** Value of missing transitions in d_table */
+  static const uint32_t s_unknown;
+
+  /** Get the initial state */
+  uint32_t getInitial() const { return d_initial; }
+  /** Is q an accepting state? */
+  bool isAccepting(uint32_t q) const { return d_accepting[q]; }
+  /** Is q the dead state, from which no word is accepted? */
+  bool isDead(uint32_t q) const { return d_dfaStates[q].empty(); }
+  /** Get the lower bounds of the character classes other than the first */
+  const std::vector<unsigned>& getBounds() const { return d_bounds; }
+  /**
+   * Get the successor of state q on character c, or s_unknown if it could
+   * not be computed because the automaton grew too large.
+   */
+  uint32_t getSuccessor(uint32_t q, unsigned c);
+
+ private:
+  /** A transition of the nondeterministic automaton */
+  struct Edge
+  {
+    /** The range of characters, empty for epsilon transitions */
+    unsigned d_lo;
+    unsigned d_hi;
+    /** Whether this is an epsilon transition */
+    bool d_epsilon;
+    /** The target state */
+    uint32_t d_target;
+  };
+  /** A fragment of the nondeterministic automaton, with one start and end */
+  struct Fragment
+  {
+    uint32_t d_start;
+    uint32_t d_end;
+  };
+
+  /** Add a state to the nondeterministic automaton */
+  uint32_t mkState();
+  /** Add a transition from state from to state to */
+  void addEdge(uint32_t from, uint32_t to, unsigned lo, unsigned hi);
+  void addEpsilon(uint32_t from, uint32_t to);
+  /**
+   * Compile r to a fragment of the nondeterministic automaton. Returns false
+   * if r contains an unsupported operator or is too large.
+   */
+  bool compile(TNode r, Fragment& f);
+  /** Compute the character classes from the ranges of the transitions */
+  void computeClasses();
+  /** Get the character class of character c */
+  uint32_t getClass(unsigned c) const;
+  /**
+   * Get the state of the deterministic automaton for the epsilon-closure of
+   * states, adding it if it is new.
+   */
+  uint32_t getDfaState(std::vector<uint32_t>& states);
+  /** Compute the successor of dfa state q on the characters of class c */
+  uint32_t computeSuccessor(uint32_t q, uint32_t c);
+
+  /** Whether r only contains supported operators */
+  bool d_supported;
+  /** The transitions of each state of the nondeterministic automaton */
+  std::vector<std::vector<Edge>> d_nfa;
+  /** The final state of the nondeterministic automaton */
+  uint32_t d_final;
+  /** The lower bounds of the character classes other than the first one */
+  std::vector<unsigned> d_bounds;
+  /** The sets of states of the nondeterministic automaton of each state */
+  std::vector<std::vector<uint32_t>> d_dfaStates;
+  /** The state of each set of states of the nondeterministic automaton */
+  std::map<std::vector<uint32_t>, uint32_t> d_dfaStateOf;
+  /** The accepting states */
+  std::vector<bool> d_accepting;
+  /** The transitions, d_table[q * numClasses + c] is the successor of q */
+  std::vector<uint32_t> d_table;
+  /** The initial state */
+  uint32_t d_initial;
+};
+
+/**
+ * A cache of the automata of constant regular expressions, which decides
+ * membership, inclusion and emptiness of intersection of the constant
+ * regular expressions whose automata are supported.
+ */
+class RegExpDfaCache
+{
+ public:
+  RegExpDfaCache() {}
+  ~RegExpDfaCache() {}
+
+  /**
+   * Set result to whether the suffix of s starting at index_start is in the
+   * language of r, which must be constant, by running the automaton of r,
+   * built the first time r is given. Returns false if the automaton of r is
+   * not supported, in which case result is not set.
+   */
+  bool test(const String& s, size_t index_start, TNode r, bool& result);
+  /**
+   * Set result to whether the language of r1 includes the language of r2,
+   * which must be constant. Returns false if this could not be decided, in
+   * which case result is not set.
+   */
+  bool includes(TNode r1, TNode r2, bool& result);
+  /**
+   * Set result to whether the intersection of the languages of r1 and r2,
+   * which must be constant, is empty. Returns false if this could not be
+   * decided, in which case result is not set.
+   */
+  bool isIntersectionEmpty(TNode r1, TNode r2, bool& result);
+
+ private:
+  /** Get the automaton of r, or nullptr if it is not supported */
+  RegExpDfa* getDfa(TNode r);
+  /**
+   * Explore the product of the automata d1 and d2 from their initial states,
+   * and set found to whether it reaches a pair of states where d2 accepts
+   * and d1 accepts, or does not accept if neg1 is true. Returns false if the
+   * product is too large, in which case found is not set.
+   */
+  static bool findInProduct(RegExpDfa& d1,
+                            RegExpDfa& d2,
+                            bool neg1,
+                            bool& found);
+
+  /** The automaton of each regular expression */
+  std::unordered_map<Node, std::unique_ptr<RegExpDfa>, NodeHashFunction>
+      d_dfas;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC4__THEORY__STRINGS__REGEXP_DFA_H */
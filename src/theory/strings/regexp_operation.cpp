@@ -20,6 +20,7 @@
 
 #include "expr/node_algorithm.h"
 #include "options/strings_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/rewriter.h"
 #include "theory/strings/regexp_entail.h"
 #include "theory/strings/theory_strings_utils.h"
@@ -42,6 +43,16 @@ RegExpOpr::RegExpOpr(SkolemCache* sc)
                                                std::vector<Node>{})),
       d_sigma_star(
           NodeManager::currentNM()->mkNode(kind::REGEXP_STAR, d_sigma)),
+      d_cacheStats{&d_statistics.d_cacheHits,
+                   &d_statistics.d_cacheMisses,
+                   &d_statistics.d_cacheClears},
+      d_simpCache(options::regExpCacheLimit(), d_cacheStats),
+      d_delta_cache(options::regExpCacheLimit(), d_cacheStats),
+      d_dv_cache(options::regExpCacheLimit(), d_cacheStats),
+      d_deriv_cache(options::regExpCacheLimit(), d_cacheStats),
+      d_fset_cache(options::regExpCacheLimit(), d_cacheStats),
+      d_inter_cache(options::regExpCacheLimit(), d_cacheStats),
+      d_inclusionCache(options::regExpCacheLimit(), d_cacheStats),
       d_sc(sc)
 {
   d_emptyString = Word::mkEmptyWord(NodeManager::currentNM()->stringType());
@@ -121,13 +132,12 @@ RegExpConstType RegExpOpr::getRegExpConstType(Node r)
 
 // 0-unknown, 1-yes, 2-no
 int RegExpOpr::delta( Node r, Node &exp ) {
-  std::map<Node, std::pair<int, Node> >::const_iterator itd =
-      d_delta_cache.find(r);
-  if (itd != d_delta_cache.end())
+  const std::pair<int, Node>* itd = d_delta_cache.find(r);
+  if (itd != nullptr)
   {
     // already computed
-    exp = itd->second.second;
-    return itd->second.first;
+    exp = itd->second;
+    return itd->first;
   }
   Trace("regexp-delta") << "RegExpOpr::delta: " << r << std::endl;
   int ret = 0;
@@ -259,7 +269,7 @@ int RegExpOpr::delta( Node r, Node &exp ) {
     exp = Rewriter::rewrite(exp);
   }
   std::pair<int, Node> p(ret, exp);
-  d_delta_cache[r] = p;
+  d_delta_cache.insert(r, p);
   Trace("regexp-delta") << "RegExpOpr::delta returns " << ret << " for " << r
                         << ", expr = " << exp << std::endl;
   return ret;
@@ -276,9 +286,11 @@ int RegExpOpr::derivativeS(Node r, cvc5::String c, Node& retNode)
   NodeManager* nm = NodeManager::currentNM();
 
   PairNodeStr dv = std::make_pair( r, c );
-  if( d_deriv_cache.find( dv ) != d_deriv_cache.end() ) {
-    retNode = d_deriv_cache[dv].first;
-    ret = d_deriv_cache[dv].second;
+  const std::pair<Node, int>* itdv = d_deriv_cache.find(dv);
+  if (itdv != nullptr)
+  {
+    retNode = itdv->first;
+    ret = itdv->second;
   }
   else if (c.empty())
   {
@@ -290,7 +302,7 @@ int RegExpOpr::derivativeS(Node r, cvc5::String c, Node& retNode)
       retNode = r;
     }
     std::pair< Node, int > p(retNode, ret);
-    d_deriv_cache[dv] = p;
+    d_deriv_cache.insert(dv, p);
   } else {
     switch( r.getKind() ) {
       case kind::REGEXP_EMPTY: {
@@ -514,7 +526,7 @@ int RegExpOpr::derivativeS(Node r, cvc5::String c, Node& retNode)
       retNode = Rewriter::rewrite( retNode );
     }
     std::pair< Node, int > p(retNode, ret);
-    d_deriv_cache[dv] = p;
+    d_deriv_cache.insert(dv, p);
   }
 
   Trace("regexp-derive") << "RegExp-derive returns : /" << mkString( retNode ) << "/" << std::endl;
@@ -528,8 +540,10 @@ Node RegExpOpr::derivativeSingle(Node r, cvc5::String c)
   Node retNode = d_emptyRegexp;
   PairNodeStr dv = std::make_pair( r, c );
   NodeManager* nm = NodeManager::currentNM();
-  if( d_dv_cache.find( dv ) != d_dv_cache.end() ) {
-    retNode = d_dv_cache[dv];
+  const Node* itdv = d_dv_cache.find(dv);
+  if (itdv != nullptr)
+  {
+    retNode = *itdv;
   }
   else if (c.empty())
   {
@@ -695,7 +709,7 @@ Node RegExpOpr::derivativeSingle(Node r, cvc5::String c)
     if(retNode != d_emptyRegexp) {
       retNode = Rewriter::rewrite( retNode );
     }
-    d_dv_cache[dv] = retNode;
+    d_dv_cache.insert(dv, retNode);
   }
   Trace("regexp-derive") << "RegExp-derive returns : /" << mkString( retNode ) << "/" << std::endl;
   return retNode;
@@ -704,11 +718,11 @@ Node RegExpOpr::derivativeSingle(Node r, cvc5::String c)
 void RegExpOpr::firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset)
 {
   Trace("regexp-fset") << "Start FSET(" << mkString(r) << ")" << std::endl;
-  std::map<Node, std::pair<std::set<unsigned>, SetNodes> >::const_iterator itr =
-      d_fset_cache.find(r);
-  if(itr != d_fset_cache.end()) {
-    pcset.insert((itr->second).first.begin(), (itr->second).first.end());
-    pvset.insert((itr->second).second.begin(), (itr->second).second.end());
+  const std::pair<std::set<unsigned>, SetNodes>* itr = d_fset_cache.find(r);
+  if (itr != nullptr)
+  {
+    pcset.insert(itr->first.begin(), itr->first.end());
+    pvset.insert(itr->second.begin(), itr->second.end());
   } else {
     // cset is code points
     std::set<unsigned> cset;
@@ -808,7 +822,7 @@ void RegExpOpr::firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset)
     pcset.insert(cset.begin(), cset.end());
     pvset.insert(vset.begin(), vset.end());
     std::pair<std::set<unsigned>, SetNodes> p(cset, vset);
-    d_fset_cache[r] = p;
+    d_fset_cache.insert(r, p);
   }
 
   if(Trace.isOn("regexp-fset")) {
@@ -834,10 +848,10 @@ Node RegExpOpr::simplify(Node t, bool polarity)
   Assert(t.getKind() == kind::STRING_IN_REGEXP);
   Node tlit = polarity ? t : t.notNode();
   Node conc;
-  std::map<Node, Node>::const_iterator itr = d_simpCache.find(tlit);
-  if (itr != d_simpCache.end())
+  const Node* itr = d_simpCache.find(tlit);
+  if (itr != nullptr)
   {
-    return itr->second;
+    return *itr;
   }
   if (polarity)
   {
@@ -867,7 +881,7 @@ Node RegExpOpr::simplify(Node t, bool polarity)
       conc = reduceRegExpNeg(tlit);
     }
   }
-  d_simpCache[tlit] = conc;
+  d_simpCache.insert(tlit, conc);
   Trace("strings-regexp-simpl")
       << "RegExpOpr::simplify: returns " << conc << std::endl;
   return conc;
@@ -1220,10 +1234,11 @@ Node RegExpOpr::intersectInternal( Node r1, Node r2, std::map< PairNodes, Node >
   }
   Trace("regexp-int") << "Starting INTERSECT(" << cnt << "):\n  "<< mkString(r1) << ",\n  " << mkString(r2) << std::endl;
   std::pair < Node, Node > p(r1, r2);
-  std::map < PairNodes, Node >::const_iterator itr = d_inter_cache.find(p);
+  const Node* itr = d_inter_cache.find(p);
   Node rNode;
-  if(itr != d_inter_cache.end()) {
-    rNode = itr->second;
+  if (itr != nullptr)
+  {
+    rNode = *itr;
   } else {
     Trace("regexp-int-debug") << " ... not in cache" << std::endl;
     if(r1 == d_emptyRegexp || r2 == d_emptyRegexp) {
@@ -1334,7 +1349,7 @@ Node RegExpOpr::intersectInternal( Node r1, Node r2, std::map< PairNodes, Node >
     Trace("regexp-int-debug") << "  ... try testing no RV of " << mkString(rNode) << std::endl;
     if (!expr::hasSubtermKind(REGEXP_RV, rNode))
     {
-      d_inter_cache[p] = rNode;
+      d_inter_cache.insert(p, rNode);
     }
   }
   Trace("regexp-int") << "End(" << cnt << ") of INTERSECT( " << mkString(r1) << ", " << mkString(r2) << " ) = " << mkString(rNode) << std::endl;
@@ -1561,18 +1576,54 @@ std::string RegExpOpr::mkString( Node r ) {
   return retStr;
 }
 
+RegExpOpr::Statistics::Statistics()
+    : d_cacheHits("theory::strings::RegExpOpr::cacheHits", 0),
+      d_cacheMisses("theory::strings::RegExpOpr::cacheMisses", 0),
+      d_cacheClears("theory::strings::RegExpOpr::cacheClears", 0)
+{
+  smtStatisticsRegistry()->registerStat(&d_cacheHits);
+  smtStatisticsRegistry()->registerStat(&d_cacheMisses);
+  smtStatisticsRegistry()->registerStat(&d_cacheClears);
+}
+
+RegExpOpr::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_cacheHits);
+  smtStatisticsRegistry()->unregisterStat(&d_cacheMisses);
+  smtStatisticsRegistry()->unregisterStat(&d_cacheClears);
+}
+
 bool RegExpOpr::regExpIncludes(Node r1, Node r2)
 {
-  const auto& it = d_inclusionCache.find(std::make_pair(r1, r2));
-  if (it != d_inclusionCache.end())
+  const bool* it = d_inclusionCache.find(std::make_pair(r1, r2));
+  if (it != nullptr)
   {
-    return (*it).second;
+    return *it;
   }
   bool result = RegExpEntail::regExpIncludes(r1, r2);
-  d_inclusionCache[std::make_pair(r1, r2)] = result;
+  if (!result && options::regExpDfa() && checkConstRegExp(r1)
+      && checkConstRegExp(r2))
+  {
+    bool included;
+    if (d_dfaCache.includes(r1, r2, included))
+    {
+      result = included;
+    }
+  }
+  d_inclusionCache.insert(std::make_pair(r1, r2), result);
   return result;
 }
 
+bool RegExpOpr::isIntersectionEmpty(Node r1, Node r2)
+{
+  if (!options::regExpDfa() || !checkConstRegExp(r1) || !checkConstRegExp(r2))
+  {
+    return false;
+  }
+  bool empty;
+  return d_dfaCache.isIntersectionEmpty(r1, r2, empty) && empty;
+}
+
 /**
  * Associating formulas with their "exists form", or an existentially
  * quantified formula that is equivalent to it. This is currently used
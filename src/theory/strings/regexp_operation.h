@@ -25,7 +25,11 @@
 #include <vector>
 
 #include "expr/node.h"
+#include "theory/strings/regexp_cache.h"
+#include "theory/strings/regexp_dfa.h"
 #include "theory/strings/skolem_cache.h"
+#include "util/hash.h"
+#include "util/statistics_registry.h"
 #include "util/string.h"
 
 namespace cvc5 {
@@ -58,6 +62,13 @@ class RegExpOpr {
   typedef std::pair<Node, cvc5::String> PairNodeStr;
   typedef std::set< Node > SetNodes;
   typedef std::pair< Node, Node > PairNodes;
+  typedef PairHashFunction<Node,
+                           String,
+                           NodeHashFunction,
+                           cvc5::strings::StringHashFunction>
+      PairNodeStrHashFunction;
+  typedef PairHashFunction<Node, Node, NodeHashFunction, NodeHashFunction>
+      PairNodesHashFunction;
 
  private:
   /** the code point of the last character in the alphabet we are using */
@@ -73,17 +84,38 @@ class RegExpOpr {
   Node d_sigma;
   Node d_sigma_star;
 
+  class Statistics
+  {
+   public:
+    /** The number of lookups in the caches that found a value */
+    IntStat d_cacheHits;
+    /** The number of lookups in the caches that did not find a value */
+    IntStat d_cacheMisses;
+    /** The number of times a cache was cleared because it was full */
+    IntStat d_cacheClears;
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+  /** The statistics given to the caches */
+  RegExpCacheStats d_cacheStats;
+
   /** A cache for simplify */
-  std::map<Node, Node> d_simpCache;
-  std::map<Node, std::pair<int, Node> > d_delta_cache;
-  std::map<PairNodeStr, Node> d_dv_cache;
-  std::map<PairNodeStr, std::pair<Node, int> > d_deriv_cache;
+  RegExpCache<Node, Node, NodeHashFunction> d_simpCache;
+  RegExpCache<Node, std::pair<int, Node>, NodeHashFunction> d_delta_cache;
+  RegExpCache<PairNodeStr, Node, PairNodeStrHashFunction> d_dv_cache;
+  RegExpCache<PairNodeStr, std::pair<Node, int>, PairNodeStrHashFunction>
+      d_deriv_cache;
   /** cache mapping regular expressions to whether they contain constants */
   std::unordered_map<Node, RegExpConstType, NodeHashFunction> d_constCache;
-  std::map<Node, std::pair<std::set<unsigned>, std::set<Node> > > d_fset_cache;
-  std::map<PairNodes, Node> d_inter_cache;
-  std::map<Node, std::vector<PairNodes> > d_split_cache;
-  std::map<PairNodes, bool> d_inclusionCache;
+  RegExpCache<Node,
+              std::pair<std::set<unsigned>, std::set<Node> >,
+              NodeHashFunction>
+      d_fset_cache;
+  RegExpCache<PairNodes, Node, PairNodesHashFunction> d_inter_cache;
+  RegExpCache<PairNodes, bool, PairNodesHashFunction> d_inclusionCache;
+  /** The automata of the constant regular expressions */
+  RegExpDfaCache d_dfaCache;
   /**
    * Helper function for mkString, pretty prints constant or variable regular
    * expression r.
@@ -185,10 +217,18 @@ class RegExpOpr {
    * Returns true if we can show that the regular expression `r1` includes
    * the regular expression `r2` (i.e. `r1` matches a superset of sequences
    * that `r2` matches). See documentation in RegExpEntail::regExpIncludes for
-   * more details. This call caches the result (which is context-independent),
-   * for performance reasons.
+   * more details. If the syntactic check of RegExpEntail fails and both are
+   * constant, the inclusion is decided by the product of their automata.
+   * This call caches the result (which is context-independent), for
+   * performance reasons.
    */
   bool regExpIncludes(Node r1, Node r2);
+  /**
+   * Returns true if we can show that the intersection of the regular
+   * expressions `r1` and `r2` is empty, using the product of their automata
+   * when they are constant.
+   */
+  bool isIntersectionEmpty(Node r1, Node r2);
 
  private:
   /**
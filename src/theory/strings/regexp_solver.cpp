@@ -463,10 +463,18 @@ bool RegExpSolver::checkEqcIntersect(const std::vector<Node>& mems)
       rcti = rct;
       continue;
     }
-    Node resR = d_regexp_opr.intersect(mi[1], m[1]);
-    // intersection should be computable
-    Assert(!resR.isNull());
-    if (resR == d_emptyRegexp)
+    // the product of the automata decides the emptiness of the intersection
+    // without computing it
+    bool empty = d_regexp_opr.isIntersectionEmpty(mi[1], m[1]);
+    Node resR;
+    if (!empty)
+    {
+      resR = d_regexp_opr.intersect(mi[1], m[1]);
+      // intersection should be computable
+      Assert(!resR.isNull());
+      empty = resR == d_emptyRegexp;
+    }
+    if (empty)
     {
       // conflict, explain
       std::vector<Node> vec_nodes;
@@ -212,6 +212,7 @@ const char* toString(Rewrite r)
     case Rewrite::SEQ_UNIT_EVAL: return "SEQ_UNIT_EVAL";
     case Rewrite::SEQ_NTH_EVAL: return "SEQ_NTH_EVAL";
     case Rewrite::SEQ_NTH_TOTAL_OOB: return "SEQ_NTH_TOTAL_OOB";
+    case Rewrite::SEQ_NTH_TOTAL_CONST: return "SEQ_NTH_TOTAL_CONST";
     default: return "?";
   }
 }
@@ -214,7 +214,8 @@ enum class Rewrite : uint32_t
   CHARAT_ELIM,
   SEQ_UNIT_EVAL,
   SEQ_NTH_EVAL,
-  SEQ_NTH_TOTAL_OOB
+  SEQ_NTH_TOTAL_OOB,
+  SEQ_NTH_TOTAL_CONST
 };
 
 /**
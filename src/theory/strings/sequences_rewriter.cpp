@@ -19,6 +19,8 @@
 #include "expr/attribute.h"
 #include "expr/node_builder.h"
 #include "expr/sequence.h"
+#include "options/strings_options.h"
+#include "theory/rewrite_profiler.h"
 #include "theory/rewriter.h"
 #include "theory/strings/arith_entail.h"
 #include "theory/strings/regexp_entail.h"
@@ -804,7 +806,7 @@ Node SequencesRewriter::rewriteConcatRegExp(TNode node)
       // if empty, drop it
       // e.g. this ensures we rewrite (_)* ++ (a)* ---> (_)*
       if (RegExpEntail::isConstRegExp(curr)
-          && RegExpEntail::testConstStringInRegExp(emptyStr, 0, curr))
+          && testConstStringInRegExp(emptyStr, 0, curr))
       {
         curr = Node::null();
       }
@@ -826,7 +828,7 @@ Node SequencesRewriter::rewriteConcatRegExp(TNode node)
           // go back and remove empty ones from back of cvec
           // e.g. this ensures we rewrite (a)* ++ (_)* ---> (_)*
           while (!cvec.empty() && RegExpEntail::isConstRegExp(cvec.back())
-                 && RegExpEntail::testConstStringInRegExp(
+                 && testConstStringInRegExp(
                      emptyStr, 0, cvec.back()))
           {
             cvec.pop_back();
@@ -979,7 +981,13 @@ Node SequencesRewriter::rewriteAndOrRegExp(TNode node)
       // inclusion test for conflicting case m1 contains m2
       // (re.inter (re.comp R1) R2) --> re.none where R1 includes R2
       // (re.union R1 (re.comp R2)) --> (re.* re.allchar) where R1 includes R2
-      if (RegExpEntail::regExpIncludes(m1, m2))
+      bool included = RegExpEntail::regExpIncludes(m1, m2);
+      if (!included && options::regExpDfa() && RegExpEntail::isConstRegExp(m1)
+          && RegExpEntail::isConstRegExp(m2))
+      {
+        d_regExpDfaCache.includes(m1, m2, included);
+      }
+      if (included)
       {
         Node retNode;
         if (nk == REGEXP_INTER)
@@ -1142,7 +1150,7 @@ Node SequencesRewriter::rewriteMembership(TNode node)
   {
     // test whether x in node[1]
     cvc5::String s = x.getConst<String>();
-    bool test = RegExpEntail::testConstStringInRegExp(s, 0, r);
+    bool test = testConstStringInRegExp(s, 0, r);
     Node retNode = NodeManager::currentNM()->mkConst(test);
     return returnRewrite(node, retNode, Rewrite::RE_IN_EVAL);
   }
@@ -1525,7 +1533,7 @@ Node SequencesRewriter::rewriteSeqNth(Node node)
     size_t pos = i.getConst<Rational>().getNumerator().toUnsignedInt();
     if (pos < len)
     {
-      std::vector<Node> elements = s.getConst<Sequence>().getVec();
+      const std::vector<Node>& elements = s.getConst<Sequence>().getVec();
       const Node& ret = elements[pos];
       return returnRewrite(node, ret, Rewrite::SEQ_NTH_EVAL);
     }
@@ -1540,10 +1548,36 @@ Node SequencesRewriter::rewriteSeqNth(Node node)
       return node;
     }
   }
-  else
+  else if (s.isConst() && node.getKind() == SEQ_NTH_TOTAL)
   {
-    return node;
+    size_t len = Word::getLength(s);
+    if (len > 0 && len <= options::seqNthConstLimit())
+    {
+      // seq.nth_total(c, i) --->
+      //   ite(i = 0, c_0, ite(i = 1, c_1, ... ite(i = n-1, c_{n-1}, v)))
+      // where v is the value of the out of bounds indices, as above. This
+      // eliminates the extraction from constant sequences, e.g. of bytes, in
+      // favor of reasoning on the index and the elements.
+      Node oob = s.getType().getSequenceElementType().mkGroundValue();
+      Node ret = mkSeqNthCases(s, i, oob);
+      return returnRewrite(node, ret, Rewrite::SEQ_NTH_TOTAL_CONST);
+    }
   }
+  return node;
+}
+
+Node SequencesRewriter::mkSeqNthCases(Node s, Node i, Node oob)
+{
+  Assert(s.isConst());
+  NodeManager* nm = NodeManager::currentNM();
+  const std::vector<Node>& elements = s.getConst<Sequence>().getVec();
+  Node ret = oob;
+  for (size_t j = elements.size(); j-- > 0;)
+  {
+    Node cond = i.eqNode(nm->mkConst(Rational(j)));
+    ret = nm->mkNode(ITE, cond, elements[j], ret);
+  }
+  return ret;
 }
 
 Node SequencesRewriter::rewriteCharAt(Node node)
@@ -3051,7 +3085,7 @@ Node SequencesRewriter::rewriteReplaceRe(Node node)
     }
     // str.replace_re( x, y, z ) ---> z ++ x if "" in y ---> true
     String emptyStr("");
-    if (RegExpEntail::testConstStringInRegExp(emptyStr, 0, y))
+    if (testConstStringInRegExp(emptyStr, 0, y))
     {
       Node ret = nm->mkNode(STRING_CONCAT, z, x);
       return returnRewrite(node, ret, Rewrite::REPLACE_RE_EMP_RE);
@@ -3114,7 +3148,7 @@ std::pair<size_t, size_t> SequencesRewriter::firstMatch(Node n, Node r)
 
   if (s.size() == 0)
   {
-    if (RegExpEntail::testConstStringInRegExp(s, 0, r))
+    if (testConstStringInRegExp(s, 0, r))
     {
       return std::make_pair(0, 0);
     }
@@ -3126,12 +3160,12 @@ std::pair<size_t, size_t> SequencesRewriter::firstMatch(Node n, Node r)
 
   for (size_t i = 0, size = s.size(); i < size; i++)
   {
-    if (RegExpEntail::testConstStringInRegExp(s, i, re))
+    if (testConstStringInRegExp(s, i, re))
     {
       for (size_t j = i; j <= size; j++)
       {
         String substr = s.substr(i, j - i);
-        if (RegExpEntail::testConstStringInRegExp(substr, 0, r))
+        if (testConstStringInRegExp(substr, 0, r))
         {
           return std::make_pair(i, j);
         }
@@ -3142,6 +3176,19 @@ std::pair<size_t, size_t> SequencesRewriter::firstMatch(Node n, Node r)
   return std::make_pair(string::npos, string::npos);
 }
 
+bool SequencesRewriter::testConstStringInRegExp(String& s,
+                                                unsigned index_start,
+                                                TNode r)
+{
+  bool result;
+  if (options::regExpDfa()
+      && d_regExpDfaCache.test(s, index_start, r, result))
+  {
+    return result;
+  }
+  return RegExpEntail::testConstStringInRegExp(s, index_start, r);
+}
+
 Node SequencesRewriter::rewriteStrReverse(Node node)
 {
   Assert(node.getKind() == STRING_REV);
@@ -3352,6 +3399,7 @@ Node SequencesRewriter::returnRewrite(Node node, Node ret, Rewrite r)
   {
     (*d_statistics) << r;
   }
+  RewriteProfiler::notifyRule("strings", toString(r), node, ret);
 
   // standard post-processing
   // We rewrite (string) equalities immediately here. This allows us to forego
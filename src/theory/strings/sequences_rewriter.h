@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "expr/node.h"
+#include "theory/strings/regexp_dfa.h"
 #include "theory/strings/rewrites.h"
 #include "theory/strings/sequences_stats.h"
 #include "theory/strings/strings_entail.h"
@@ -270,6 +271,13 @@ class SequencesRewriter : public TheoryRewriter
    * Returns the rewritten form of node.
    */
   Node rewriteSeqNth(Node node);
+  /**
+   * Make the case split on the index i of the constant sequence s
+   *   ite(i = 0, s_0, ite(i = 1, s_1, ... ite(i = n-1, s_{n-1}, oob)))
+   * which is equal to the i^th element of s if 0 <= i < n, where n is the
+   * length of s, and to oob otherwise.
+   */
+  static Node mkSeqNthCases(Node s, Node i, Node oob);
 
   /** length preserving rewrite
    *
@@ -287,11 +295,21 @@ class SequencesRewriter : public TheoryRewriter
    */
   static Node canonicalStrForSymbolicLength(Node n, TypeNode stype);
 
+  /**
+   * Does the substring of s starting at index_start occur in constant regular
+   * expression r? This runs the cached automaton of r if it is supported,
+   * and falls back to RegExpEntail::testConstStringInRegExp otherwise.
+   */
+  bool testConstStringInRegExp(String& s, unsigned index_start, TNode r);
+
   /** Reference to the rewriter statistics. */
   IntegralHistogramStat<Rewrite>* d_statistics;
 
   /** Instance of the entailment checker for strings. */
   StringsEntail d_stringsEntail;
+
+  /** The automata of the constant regular expressions */
+  RegExpDfaCache d_regExpDfaCache;
 }; /* class SequencesRewriter */
 
 }  // namespace strings
@@ -14,6 +14,8 @@
 
 #include "theory/strings/sequences_stats.h"
 
+#include <sstream>
+
 #include "smt/smt_statistics_registry.h"
 
 namespace cvc5 {
@@ -31,7 +33,9 @@ SequencesStatistics::SequencesStatistics()
       d_rewrites("theory::strings::rewrites"),
       d_conflictsEqEngine("theory::strings::conflictsEqEngine", 0),
       d_conflictsEager("theory::strings::conflictsEager", 0),
-      d_conflictsInfer("theory::strings::conflictsInfer", 0)
+      d_conflictsInfer("theory::strings::conflictsInfer", 0),
+      d_stepRuns("theory::strings::stepRuns"),
+      d_stepsProcessed("theory::strings::stepsProcessed")
 {
   smtStatisticsRegistry()->registerStat(&d_checkRuns);
   smtStatisticsRegistry()->registerStat(&d_strategyRuns);
@@ -44,6 +48,18 @@ SequencesStatistics::SequencesStatistics()
   smtStatisticsRegistry()->registerStat(&d_conflictsEqEngine);
   smtStatisticsRegistry()->registerStat(&d_conflictsEager);
   smtStatisticsRegistry()->registerStat(&d_conflictsInfer);
+  smtStatisticsRegistry()->registerStat(&d_stepRuns);
+  smtStatisticsRegistry()->registerStat(&d_stepsProcessed);
+  for (int s = BREAK; s <= CHECK_CARDINALITY; ++s)
+  {
+    std::stringstream ss;
+    ss << "theory::strings::stepTime::" << static_cast<InferStep>(s);
+    d_stepTimers.emplace_back(new TimerStat(ss.str()));
+    if (s != BREAK)
+    {
+      smtStatisticsRegistry()->registerStat(d_stepTimers.back().get());
+    }
+  }
 }
 
 SequencesStatistics::~SequencesStatistics()
@@ -59,6 +75,12 @@ SequencesStatistics::~SequencesStatistics()
   smtStatisticsRegistry()->unregisterStat(&d_conflictsEqEngine);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsEager);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsInfer);
+  smtStatisticsRegistry()->unregisterStat(&d_stepRuns);
+  smtStatisticsRegistry()->unregisterStat(&d_stepsProcessed);
+  for (int s = CHECK_INIT; s <= CHECK_CARDINALITY; ++s)
+  {
+    smtStatisticsRegistry()->unregisterStat(d_stepTimers[s].get());
+  }
 }
 
 }
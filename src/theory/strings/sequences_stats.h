@@ -17,9 +17,13 @@
 #ifndef CVC4__THEORY__STRINGS__SEQUENCES_STATS_H
 #define CVC4__THEORY__STRINGS__SEQUENCES_STATS_H
 
+#include <memory>
+#include <vector>
+
 #include "expr/kind.h"
 #include "theory/strings/infer_info.h"
 #include "theory/strings/rewrites.h"
+#include "theory/strings/strategy.h"
 #include "util/statistics_registry.h"
 #include "util/stats_histogram.h"
 
@@ -33,7 +37,8 @@ namespace strings {
  * This is roughly broken up into the following parts:
  * (1) Inferences,
  * (2) Conflicts,
- * (3) Lemmas.
+ * (3) Lemmas,
+ * (4) Steps of the strategy.
  *
  * "Inferences" (1) are steps invoked during solving, which either trigger:
  * (a) An internal update to the state of the solver (e.g. adding an inferred
@@ -47,6 +52,10 @@ namespace strings {
  *
  * "Conflicts" (2) arise from various kinds of reasoning, listed below,
  * where inferences are one of the possible methods for deriving conflicts.
+ *
+ * "Steps" (4) are the calls to TheoryStrings::runInferStep, for which we
+ * track the time spent in the inferences of each step, and how often they
+ * yield facts, lemmas or conflicts.
  */
 class SequencesStatistics
 {
@@ -95,6 +104,21 @@ class SequencesStatistics
   /** Number of inference conflicts */
   IntStat d_conflictsInfer;
   //--------------- end of conflicts
+  //--------------- steps of the strategy
+  /** Counts the number of runs of each step */
+  IntegralHistogramStat<InferStep> d_stepRuns;
+  /**
+   * Counts the number of runs of each step that added a fact or a lemma, or
+   * found a conflict
+   */
+  IntegralHistogramStat<InferStep> d_stepsProcessed;
+  /** Get the timer of the runs of step s */
+  TimerStat& getStepTimer(InferStep s) { return *d_stepTimers[s]; }
+  //--------------- end of steps of the strategy
+
+ private:
+  /** The time spent in the runs of each step, indexed by InferStep */
+  std::vector<std::unique_ptr<TimerStat>> d_stepTimers;
 };
 
 }
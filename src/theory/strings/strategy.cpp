@@ -30,10 +30,14 @@ std::ostream& operator<<(std::ostream& out, InferStep s)
     case CHECK_EXTF_EVAL: out << "check_extf_eval"; break;
     case CHECK_CYCLES: out << "check_cycles"; break;
     case CHECK_FLAT_FORMS: out << "check_flat_forms"; break;
+    case CHECK_REGISTER_TERMS_PRE_NF:
+      out << "check_register_terms_pre_nf";
+      break;
     case CHECK_NORMAL_FORMS_EQ: out << "check_normal_forms_eq"; break;
     case CHECK_NORMAL_FORMS_DEQ: out << "check_normal_forms_deq"; break;
     case CHECK_CODES: out << "check_codes"; break;
     case CHECK_LENGTH_EQC: out << "check_length_eqc"; break;
+    case CHECK_REGISTER_TERMS_NF: out << "check_register_terms_nf"; break;
     case CHECK_EXTF_REDUCTION: out << "check_extf_reduction"; break;
     case CHECK_MEMBERSHIP: out << "check_membership"; break;
     case CHECK_CARDINALITY: out << "check_cardinality"; break;
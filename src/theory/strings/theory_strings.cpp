@@ -988,6 +988,10 @@ void TheoryStrings::runInferStep(InferStep s, int effort)
     Trace("strings-process") << ", effort = " << effort;
   }
   Trace("strings-process") << "..." << std::endl;
+  d_statistics.d_stepRuns << s;
+  bool processedBefore = d_im.hasProcessed();
+  uint32_t sentBefore = d_im.numSentFacts() + d_im.numSentLemmas();
+  TimerStat::CodeTimer stepTimer(d_statistics.getStepTimer(s));
   switch (s)
   {
     case CHECK_INIT: d_bsolver.checkInit(); break;
@@ -1006,6 +1010,11 @@ void TheoryStrings::runInferStep(InferStep s, int effort)
     case CHECK_CARDINALITY: d_bsolver.checkCardinality(); break;
     default: Unreachable(); break;
   }
+  if ((d_im.hasProcessed() && !processedBefore)
+      || d_im.numSentFacts() + d_im.numSentLemmas() != sentBefore)
+  {
+    d_statistics.d_stepsProcessed << s;
+  }
   Trace("strings-process") << "Done " << s
                            << ", addedFact = " << d_im.hasPendingFact()
                            << ", addedLemma = " << d_im.hasPendingLemma()
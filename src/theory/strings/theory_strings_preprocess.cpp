@@ -414,6 +414,17 @@ Node StringsPreprocess::reduce(Node t,
 
     retNode = stoit;
   }
+  else if (t.getKind() == kind::SEQ_NTH && t[0].isConst()
+           && Word::getLength(t[0]) > 0
+           && Word::getLength(t[0]) <= options::seqNthConstLimit())
+  {
+    // processing term:  seq.nth( c, n ) for a short constant sequence c
+    // The extraction is a case split on n, whose out of bounds case is the
+    // same as below.
+    Node uf = sc->mkSkolemSeqNth(t[0].getType(), "Uf");
+    Node oob = nm->mkNode(APPLY_UF, uf, t[0], t[1]);
+    retNode = SequencesRewriter::mkSeqNthCases(t[0], t[1], oob);
+  }
   else if (t.getKind() == kind::SEQ_NTH)
   {
     // processing term:  str.nth( s, n)
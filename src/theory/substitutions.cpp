@@ -62,6 +62,7 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
     {
       Debug("substitution::internal") << "--not substituting under quantifier" << endl;
       cache[current] = current;
+      d_cacheOpaque.push_back(current);
       toVisit.pop_back();
       continue;
     }
@@ -73,6 +74,7 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
       internalSubstitute(rhs, cache);
       d_substitutions[current] = cache[rhs];
       cache[current] = cache[rhs];
+      addCacheUser(rhs, current);
       toVisit.pop_back();
       continue;
     }
@@ -84,16 +86,19 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
       NodeBuilder<> builder(current.getKind());
       if (current.getMetaKind() == kind::metakind::PARAMETERIZED) {
         builder << Node(cache[current.getOperator()]);
+        addCacheUser(current.getOperator(), current);
       }
       for (unsigned i = 0; i < current.getNumChildren(); ++ i) {
         Assert(cache.find(current[i]) != cache.end());
         builder << Node(cache[current[i]]);
+        addCacheUser(current[i], current);
       }
       // Mark the substitution and continue
       Node result = builder;
       if (result != current) {
         find = cache.find(result);
         if (find != cache.end()) {
+          addCacheUser(result, current);
           result = find->second;
         }
         else {
@@ -104,6 +109,8 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
             internalSubstitute(rhs, cache);
             d_substitutions[result] = cache[rhs];
             cache[result] = cache[rhs];
+            addCacheUser(rhs, result);
+            addCacheUser(result, current);
             result = cache[rhs];
           }
         }
@@ -146,6 +153,68 @@ Node SubstitutionMap::internalSubstitute(TNode t, NodeCache& cache) {
   return cache[t];
 }/* SubstitutionMap::internalSubstitute() */
 
+void SubstitutionMap::addCacheUser(TNode t, TNode user)
+{
+  d_cacheUsers[t].push_back(user);
+}
+
+void SubstitutionMap::invalidateCache(TNode x)
+{
+  if (d_cacheInvalidated)
+  {
+    // the whole cache is cleared anyway
+    return;
+  }
+  if (x.getNumChildren() > 0
+      || x.getMetaKind() == kind::metakind::PARAMETERIZED)
+  {
+    // A term with children may also be the result of a term that is not x,
+    // which is not tracked by d_cacheUsers.
+    d_cacheInvalidated = true;
+    return;
+  }
+  std::vector<Node> toErase;
+  toErase.push_back(x);
+  std::vector<Node> opaque;
+  for (const Node& n : d_cacheOpaque)
+  {
+    NodeCache::iterator it = d_substitutionCache.find(n);
+    if (it == d_substitutionCache.end())
+    {
+      continue;
+    }
+    if (expr::hasSubterm(it->second, x))
+    {
+      toErase.push_back(n);
+    }
+    else
+    {
+      opaque.push_back(n);
+    }
+  }
+  d_cacheOpaque.swap(opaque);
+  size_t nerased = 0;
+  while (!toErase.empty())
+  {
+    Node cur = toErase.back();
+    toErase.pop_back();
+    if (d_substitutionCache.erase(cur) > 0)
+    {
+      nerased++;
+    }
+    // the users may be in the cache even if cur is not, e.g. if the entry of
+    // cur was replaced after they were computed
+    NodeListMap::iterator it = d_cacheUsers.find(cur);
+    if (it != d_cacheUsers.end())
+    {
+      toErase.insert(toErase.end(), it->second.begin(), it->second.end());
+      d_cacheUsers.erase(it);
+    }
+  }
+  Debug("substitution") << "-- invalidated " << nerased
+                        << " cached results for " << x << endl;
+}
+
 
 void SubstitutionMap::addSubstitution(TNode x, TNode t, bool invalidateCache)
 {
@@ -160,10 +229,11 @@ void SubstitutionMap::addSubstitution(TNode x, TNode t, bool invalidateCache)
 
   // Also invalidate the cache if necessary
   if (invalidateCache) {
-    d_cacheInvalidated = true;
+    this->invalidateCache(x);
   }
   else {
     d_substitutionCache[x] = d_substitutions[x];
+    d_cacheOpaque.push_back(x);
   }
 }
 
@@ -175,13 +245,14 @@ void SubstitutionMap::addSubstitutions(SubstitutionMap& subMap, bool invalidateC
   for (; it != it_end; ++ it) {
     Assert(d_substitutions.find((*it).first) == d_substitutions.end());
     d_substitutions[(*it).first] = (*it).second;
-    if (!invalidateCache) {
+    if (invalidateCache) {
+      this->invalidateCache((*it).first);
+    }
+    else {
       d_substitutionCache[(*it).first] = d_substitutions[(*it).first];
+      d_cacheOpaque.push_back((*it).first);
     }
   }
-  if (invalidateCache) {
-    d_cacheInvalidated = true;
-  }
 }
 
 Node SubstitutionMap::apply(TNode t, bool doRewrite) {
@@ -191,6 +262,8 @@ Node SubstitutionMap::apply(TNode t, bool doRewrite) {
   // Setup the cache
   if (d_cacheInvalidated) {
     d_substitutionCache.clear();
+    d_cacheUsers.clear();
+    d_cacheOpaque.clear();
     d_cacheInvalidated = false;
     Debug("substitution") << "-- reset the cache" << endl;
   }
@@ -53,6 +53,8 @@ public:
 private:
 
   typedef std::unordered_map<Node, Node, NodeHashFunction> NodeCache;
+  typedef std::unordered_map<Node, std::vector<Node>, NodeHashFunction>
+      NodeListMap;
 
   /** The variables, in order of addition */
   NodeMap d_substitutions;
@@ -63,12 +65,37 @@ private:
   /** Whether or not to substitute under quantifiers */
   bool d_substituteUnderQuantifiers;
 
+  /**
+   * Maps each term of d_substitutionCache to the terms whose cached result
+   * was computed from its cached result, e.g. its parents.
+   */
+  NodeListMap d_cacheUsers;
+
+  /**
+   * The terms of d_substitutionCache whose cached result was not computed
+   * from the cached results of other terms, i.e. closures that are not
+   * substituted under, and substitutions added without invalidating the
+   * cache.
+   */
+  std::vector<Node> d_cacheOpaque;
+
   /** Has the cache been invalidated? */
   bool d_cacheInvalidated;
 
   /** Internal method that performs substitution */
   Node internalSubstitute(TNode t, NodeCache& cache);
 
+  /** Record that the cached result of user is computed from that of t */
+  void addCacheUser(TNode t, TNode user);
+
+  /**
+   * Invalidate the cached results that may change by a substitution for x,
+   * i.e. the results that contain x. These are found by following
+   * d_cacheUsers from x and from the results of d_cacheOpaque that contain
+   * x.
+   */
+  void invalidateCache(TNode x);
+
   /** Helper class to invalidate cache on user pop */
   class CacheInvalidator : public context::ContextNotifyObj {
     bool& d_cacheInvalidated;
@@ -95,13 +122,17 @@ public:
      : d_substitutions(context),
        d_substitutionCache(),
        d_substituteUnderQuantifiers(substituteUnderQuantifiers),
+       d_cacheUsers(),
+       d_cacheOpaque(),
        d_cacheInvalidated(false),
        d_cacheInvalidator(context, d_cacheInvalidated)
  {
   }
 
   /**
-   * Adds a substitution from x to t.
+   * Adds a substitution from x to t. If invalidateCache is true, the cached
+   * results of apply() that contain x are invalidated, and the others are
+   * kept. Otherwise, x is mapped to t in the cache.
    */
   void addSubstitution(TNode x, TNode t, bool invalidateCache = true);
 
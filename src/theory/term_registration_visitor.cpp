@@ -110,19 +110,25 @@ void PreRegisterVisitor::visit(TNode current, TNode parent) {
   }
 
   // get the theories we already preregistered with
-  TheoryIdSet visitedTheories = d_visited[current];
+  TNodeToTheorySetMap::const_iterator find = d_visited.find(current);
+  TheoryIdSet preregTheories = find == d_visited.end() ? 0 : (*find).second;
 
   // call the preregistration on current, parent or type theories and update
   // visitedTheories. The set of preregistering theories coincides with
   // visitedTheories here.
-  preRegister(d_engine, visitedTheories, current, parent, visitedTheories);
+  TheoryIdSet visitedTheories = preregTheories;
+  preRegister(d_engine, visitedTheories, current, parent, preregTheories);
 
   Debug("register::internal")
       << "PreRegisterVisitor::visit(" << current << "," << parent
       << "): now registered with "
       << TheoryIdSetUtil::setToString(visitedTheories) << std::endl;
-  // update the theories set for current
-  d_visited[current] = visitedTheories;
+  // update the theories set for current, which saves the context-dependent
+  // map only if it changed
+  if (find == d_visited.end() || visitedTheories != preregTheories)
+  {
+    d_visited[current] = visitedTheories;
+  }
   Assert(d_visited.find(current) != d_visited.end());
   Assert(alreadyVisited(current, parent));
 }
@@ -252,19 +258,26 @@ void SharedTermsVisitor::visit(TNode current, TNode parent) {
   if (Debug.isOn("register::internal")) {
     Debug("register::internal") << toString() << std::endl;
   }
-  TheoryIdSet visitedTheories = d_visited[current];
-  TheoryIdSet preregTheories = d_preregistered[current];
-
-  // preregister the term with the current, parent or type theories, as needed
+  // Look up current once in each cache. The reference into d_visited remains
+  // valid while preregistering, and we do not insert into the
+  // context-dependent d_preregistered unless its value changes, since each
+  // insertion saves the map in the SAT context.
+  TheoryIdSet& visitedTheories = d_visited[current];
+  TNodeToTheorySetMap::const_iterator itp = d_preregistered.find(current);
+  TheoryIdSet preregTheories = itp == d_preregistered.end() ? 0 : (*itp).second;
+
+  // preregister the term with the current, parent or type theories, as needed,
+  // which records the new theories that we visited
   PreRegisterVisitor::preRegister(
       d_engine, visitedTheories, current, parent, preregTheories);
 
-  // Record the new theories that we visited
-  d_visited[current] = visitedTheories;
-
   // add visited theories to those who have preregistered
-  d_preregistered[current] =
+  TheoryIdSet newPreregTheories =
       TheoryIdSetUtil::setUnion(preregTheories, visitedTheories);
+  if (newPreregTheories != preregTheories)
+  {
+    d_preregistered[current] = newPreregTheories;
+  }
 
   // If there is more than two theories and a new one has been added notify the shared terms database
   TheoryId currentTheoryId = Theory::theoryOf(current);
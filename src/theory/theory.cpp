@@ -73,8 +73,10 @@ Theory::Theory(TheoryId id,
       d_logicInfo(logicInfo),
       d_facts(satContext),
       d_factsHead(satContext, 0),
+      d_factsQueue(satContext),
       d_sharedTermsIndex(satContext, 0),
       d_careGraph(nullptr),
+      d_careGraphChanged(nullptr),
       d_instanceName(name),
       d_checkTime(getStatsPrefix(id) + name + "::checkTime"),
       d_computeCareGraphTime(getStatsPrefix(id) + name
@@ -276,13 +278,43 @@ void Theory::notifySharedTerm(TNode n)
   // do nothing
 }
 
+unsigned Theory::getFactPriority(TNode fact)
+{
+  bool polarity = fact.getKind() != kind::NOT;
+  TNode atom = polarity ? fact : fact[0];
+  if (atom.getKind() == kind::EQUAL)
+  {
+    return polarity ? 0 : 2;
+  }
+  return 1;
+}
+
 void Theory::computeCareGraph() {
   Debug("sharing") << "Theory::computeCareGraph<" << getId() << ">()" << endl;
   for (unsigned i = 0; i < d_sharedTerms.size(); ++ i) {
     TNode a = d_sharedTerms[i];
+    bool aChanged = d_careGraphChanged == nullptr
+                    || d_careGraphChanged->find(a) != d_careGraphChanged->end();
+    if (d_careGraphChanged != nullptr && !aChanged)
+    {
+      // the pairs of a with changed terms are considered with the latter
+      continue;
+    }
     TypeNode aType = a.getType();
-    for (unsigned j = i + 1; j < d_sharedTerms.size(); ++ j) {
+    unsigned jStart = d_careGraphChanged == nullptr ? i + 1 : 0;
+    for (unsigned j = jStart; j < d_sharedTerms.size(); ++j)
+    {
+      if (j == i)
+      {
+        continue;
+      }
       TNode b = d_sharedTerms[j];
+      if (j < i && d_careGraphChanged != nullptr
+          && d_careGraphChanged->find(b) != d_careGraphChanged->end())
+      {
+        // already considered when b was the first term of the pair
+        continue;
+      }
       if (b.getType() != aType) {
         // We don't care about the terms of different types
         continue;
@@ -420,14 +452,19 @@ void Theory::addCarePair(TNode t1, TNode t2) {
   }
 }
 
-void Theory::getCareGraph(CareGraph* careGraph) {
+void Theory::getCareGraph(
+    CareGraph* careGraph,
+    const std::unordered_set<TNode, TNodeHashFunction>* changed)
+{
   Assert(careGraph != NULL);
 
   Trace("sharing") << "Theory<" << getId() << ">::getCareGraph()" << std::endl;
   TimerStat::CodeTimer computeCareGraphTime(d_computeCareGraphTime);
   d_careGraph = careGraph;
+  d_careGraphChanged = changed;
   computeCareGraph();
   d_careGraph = NULL;
+  d_careGraphChanged = nullptr;
 }
 
 bool Theory::proofsEnabled() const
@@ -19,13 +19,17 @@
 #ifndef CVC4__THEORY__THEORY_H
 #define CVC4__THEORY__THEORY_H
 
+#include <functional>
 #include <iosfwd>
 #include <set>
 #include <string>
 #include <unordered_set>
+#include <utility>
 
+#include "context/cdchunk_list.h"
 #include "context/cdlist.h"
 #include "context/cdo.h"
+#include "context/cdpriority_queue.h"
 #include "context/context.h"
 #include "expr/node.h"
 #include "options/theory_options.h"
@@ -121,17 +125,39 @@ class Theory {
    * These can not be TNodes as some atoms (such as equalities) are sent
    * across theories without being stored in a global map.
    */
-  context::CDList<Assertion> d_facts;
+  context::CDChunkList<Assertion> d_facts;
 
   /** Index into the head of the facts list */
   context::CDO<unsigned> d_factsHead;
 
+  /**
+   * The indices in d_facts of the facts that were not processed by get(),
+   * ordered by getFactPriority, which is used if theoryFactsPriority is true.
+   * The number of facts processed is still d_factsHead.
+   */
+  context::CDPriorityQueue<std::pair<unsigned, size_t>,
+                           std::greater<std::pair<unsigned, size_t>>>
+      d_factsQueue;
+  /**
+   * Get the priority of fact, where facts of lower priority are returned
+   * first by get() if theoryFactsPriority is true. Positive equalities are
+   * processed first, and disequalities last.
+   */
+  static unsigned getFactPriority(TNode fact);
+
   /** Indices for splitting on the shared terms. */
   context::CDO<unsigned> d_sharedTermsIndex;
 
   /** The care graph the theory will use during combination. */
   CareGraph* d_careGraph;
 
+  /**
+   * The shared terms whose equivalence class changed since the last
+   * combination round, if the care graph is computed incrementally, and null
+   * otherwise.
+   */
+  const std::unordered_set<TNode, TNodeHashFunction>* d_careGraphChanged;
+
   /** Pointer to the decision manager. */
   DecisionManager* d_decManager;
 
@@ -155,6 +181,9 @@ class Theory {
   /**
    * The function should compute the care graph over the shared terms.
    * The default function returns all the pairs among the shared variables.
+   * If d_careGraphChanged is set, it only returns the pairs that contain one
+   * of the changed shared terms, since the status of the other pairs is the
+   * same as in the previous combination round.
    */
   virtual void computeCareGraph();
 
@@ -536,6 +565,11 @@ class Theory {
     Trace("theory") << "Theory<" << getId() << ">::assertFact["
                     << d_satContext->getLevel() << "](" << assertion << ", "
                     << (isPreregistered ? "true" : "false") << ")" << std::endl;
+    if (options::theoryFactsPriority())
+    {
+      d_factsQueue.enqueue(std::pair<unsigned, size_t>(
+          getFactPriority(assertion), d_facts.size()));
+    }
     d_facts.push_back(Assertion(assertion, isPreregistered));
   }
 
@@ -546,8 +580,14 @@ class Theory {
    * Return the current theory care graph. Theories should overload
    * computeCareGraph to do the actual computation, and use addCarePair to add
    * pairs to the care graph.
+   *
+   * If changed is non-null, it contains the shared terms whose equivalence
+   * class changed since the last combination round. Theories may use it to
+   * only compute the care pairs that involve these terms.
    */
-  void getCareGraph(CareGraph* careGraph);
+  void getCareGraph(
+      CareGraph* careGraph,
+      const std::unordered_set<TNode, TNodeHashFunction>* changed = nullptr);
 
   /**
    * Return the status of two terms in the current context. Should be
@@ -795,7 +835,7 @@ class Theory {
                     << " doesn't support Theory::setUserAttribute interface";
   }
 
-  typedef context::CDList<Assertion>::const_iterator assertions_iterator;
+  typedef context::CDChunkList<Assertion>::const_iterator assertions_iterator;
 
   /**
    * Provides access to the facts queue, primarily intended for theory
@@ -907,7 +947,13 @@ inline theory::Assertion Theory::get() {
   Assert(!done()) << "Theory::get() called with assertion queue empty!";
 
   // Get the assertion
-  Assertion fact = d_facts[d_factsHead];
+  size_t index = d_factsHead;
+  if (options::theoryFactsPriority())
+  {
+    index = d_factsQueue.front().second;
+    d_factsQueue.dequeue();
+  }
+  Assertion fact = d_facts[index];
   d_factsHead = d_factsHead + 1;
 
   Trace("theory") << "Theory::get() => " << fact << " (" << d_facts.size() - d_factsHead << " left)" << std::endl;
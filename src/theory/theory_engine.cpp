@@ -16,9 +16,13 @@
 
 #include "theory/theory_engine.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <unordered_set>
 
 #include "base/map_util.h"
+#include "context/context_mm.h"
 #include "decision/decision_engine.h"
 #include "expr/attribute.h"
 #include "expr/lazy_proof.h"
@@ -142,6 +146,17 @@ void TheoryEngine::finishInit()
   // manager below
   CVC4_FOR_EACH_THEORY;
 
+  // Collect the theories that have a check method, in their default order
+#undef CVC4_FOR_EACH_THEORY_STATEMENT
+#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
+  if (theory::TheoryTraits<THEORY>::hasCheck   \
+      && THEORY != THEORY_QUANTIFIERS          \
+      && d_logicInfo.isTheoryEnabled(THEORY))  \
+  {                                            \
+    d_checkOrder.push_back(THEORY);            \
+  }
+  CVC4_FOR_EACH_THEORY;
+
   // Initialize the theory combination architecture
   if (options::tcMode() == options::TcMode::CARE_GRAPH)
   {
@@ -226,7 +241,7 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_tc(nullptr),
       d_sharedSolver(nullptr),
       d_quantEngine(nullptr),
-      d_decManager(new DecisionManager(userContext)),
+      d_decManager(new DecisionManager(userContext, context)),
       d_relManager(nullptr),
       d_eager_model_building(false),
       d_inConflict(context, false),
@@ -238,7 +253,29 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_propagatedLiterals(context),
       d_propagatedLiteralsIndex(context, 0),
       d_atomRequests(context),
+      d_inputAtoms(userContext),
+      d_lemmaAtoms(userContext),
+      d_deferredFacts(context),
+      d_deferredFactsAsserted(context),
+      d_lemmaBatchDepth(0),
+      d_checksSinceSort(0),
       d_combineTheoriesTime("TheoryEngine::combineTheoriesTime"),
+      d_checkOrderSorts("TheoryEngine::checkOrderSorts", 0),
+      d_lemmaBatches("TheoryEngine::lemmaBatches", 0),
+      d_batchedLemmas("TheoryEngine::batchedLemmas", 0),
+      d_batchDuplicateLemmas("TheoryEngine::batchDuplicateLemmas", 0),
+      d_deferredFactsStat("TheoryEngine::deferredFacts", 0),
+      d_deferredFactsAssertedStat("TheoryEngine::deferredFactsAsserted", 0),
+      d_satContextPushes("TheoryEngine::satContextPushes",
+                         context->getCMM()->getNumPushes()),
+      d_satContextBytesSaved("TheoryEngine::satContextBytesSaved",
+                             context->getCMM()->getBytesSaved()),
+      d_satContextBytesRestored("TheoryEngine::satContextBytesRestored",
+                                context->getCMM()->getBytesRestored()),
+      d_satContextMaxBytesPerPush("TheoryEngine::satContextMaxBytesPerPush",
+                                  context->getCMM()->getMaxBytesPerPush()),
+      d_satContextChunkBytes("TheoryEngine::satContextChunkBytes",
+                             context->getCMM()->getChunkBytes()),
       d_true(),
       d_false(),
       d_interrupted(false),
@@ -252,6 +289,8 @@ TheoryEngine::TheoryEngine(context::Context* context,
   {
     d_theoryTable[theoryId] = NULL;
     d_theoryOut[theoryId] = NULL;
+    d_checkTime[theoryId] = 0;
+    d_checkConflicts[theoryId] = 0;
   }
 
   if (options::sortInference())
@@ -260,6 +299,17 @@ TheoryEngine::TheoryEngine(context::Context* context,
   }
 
   smtStatisticsRegistry()->registerStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->registerStat(&d_checkOrderSorts);
+  smtStatisticsRegistry()->registerStat(&d_lemmaBatches);
+  smtStatisticsRegistry()->registerStat(&d_batchedLemmas);
+  smtStatisticsRegistry()->registerStat(&d_batchDuplicateLemmas);
+  smtStatisticsRegistry()->registerStat(&d_deferredFactsStat);
+  smtStatisticsRegistry()->registerStat(&d_deferredFactsAssertedStat);
+  smtStatisticsRegistry()->registerStat(&d_satContextPushes);
+  smtStatisticsRegistry()->registerStat(&d_satContextBytesSaved);
+  smtStatisticsRegistry()->registerStat(&d_satContextBytesRestored);
+  smtStatisticsRegistry()->registerStat(&d_satContextMaxBytesPerPush);
+  smtStatisticsRegistry()->registerStat(&d_satContextChunkBytes);
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
 }
@@ -275,6 +325,17 @@ TheoryEngine::~TheoryEngine() {
   }
 
   smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->unregisterStat(&d_checkOrderSorts);
+  smtStatisticsRegistry()->unregisterStat(&d_lemmaBatches);
+  smtStatisticsRegistry()->unregisterStat(&d_batchedLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_batchDuplicateLemmas);
+  smtStatisticsRegistry()->unregisterStat(&d_deferredFactsStat);
+  smtStatisticsRegistry()->unregisterStat(&d_deferredFactsAssertedStat);
+  smtStatisticsRegistry()->unregisterStat(&d_satContextPushes);
+  smtStatisticsRegistry()->unregisterStat(&d_satContextBytesSaved);
+  smtStatisticsRegistry()->unregisterStat(&d_satContextBytesRestored);
+  smtStatisticsRegistry()->unregisterStat(&d_satContextMaxBytesPerPush);
+  smtStatisticsRegistry()->unregisterStat(&d_satContextChunkBytes);
 }
 
 void TheoryEngine::interrupt() { d_interrupted = true; }
@@ -321,9 +382,8 @@ void TheoryEngine::printAssertions(const char* tag) {
         Trace(tag) << "--------------------------------------------" << endl;
         Trace(tag) << "Assertions of " << theory->getId() << ": " << endl;
         {
-          context::CDList<Assertion>::const_iterator it = theory->facts_begin(),
-                                                     it_end =
-                                                         theory->facts_end();
+          theory::Theory::assertions_iterator it = theory->facts_begin(),
+                                              it_end = theory->facts_end();
           for (unsigned i = 0; it != it_end; ++it, ++i)
           {
             if ((*it).d_isPreregistered)
@@ -374,7 +434,7 @@ void TheoryEngine::dumpAssertions(const char* tag) {
 
         // Dump the assertions
         printer.toStreamCmdComment(out, "Assertions");
-        context::CDList<Assertion>::const_iterator it = theory->facts_begin(), it_end = theory->facts_end();
+        theory::Theory::assertions_iterator it = theory->facts_begin(), it_end = theory->facts_end();
         for (; it != it_end; ++ it) {
           // Get the assertion
           Node assertionNode = (*it).d_assertion;
@@ -408,6 +468,15 @@ void TheoryEngine::check(Theory::Effort effort) {
   // Reset the interrupt flag
   d_interrupted = false;
 
+  if (d_resourceManager->shedCachesRequested())
+  {
+    // No rewriting is in progress here, hence the caches may be cleared.
+    Trace("theory") << "TheoryEngine::check(): shed caches" << std::endl;
+    theory::Rewriter::clearCaches();
+    d_context->getCMM()->releaseFreeChunks();
+    d_resourceManager->notifyCachesShed();
+  }
+
 #ifdef CVC4_FOR_EACH_THEORY_STATEMENT
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
@@ -445,6 +514,12 @@ void TheoryEngine::check(Theory::Effort effort) {
         d_relManager->resetRound();
       }
       d_tc->resetRound();
+      // with a full assignment, we can determine which of the deferred facts
+      // are relevant
+      if (options::relevanceLazyAssert())
+      {
+        assertDeferredFacts();
+      }
     }
 
     // Check until done
@@ -468,7 +543,17 @@ void TheoryEngine::check(Theory::Effort effort) {
       d_factsAsserted = false;
 
       // Do the checking
-      CVC4_FOR_EACH_THEORY;
+      if (options::theoryCheckAdaptive())
+      {
+        if (checkTheoriesAdaptive(effort))
+        {
+          break;
+        }
+      }
+      else
+      {
+        CVC4_FOR_EACH_THEORY;
+      }
 
       Debug("theory") << "TheoryEngine::check(" << effort << "): running propagation after the initial check" << endl;
 
@@ -666,7 +751,8 @@ bool TheoryEngine::presolve() {
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
-    if (theory::TheoryTraits<THEORY>::hasPresolve) {    \
+    if (theory::TheoryTraits<THEORY>::hasPresolve \
+        && d_theoryTable[THEORY] != nullptr) { \
       theoryOf(THEORY)->presolve(); \
       if(d_inConflict) { \
         return true; \
@@ -694,12 +780,13 @@ void TheoryEngine::postsolve() {
 #ifdef CVC4_FOR_EACH_THEORY_STATEMENT
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
-#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY)    \
-  if (theory::TheoryTraits<THEORY>::hasPostsolve) \
-  {                                               \
-    theoryOf(THEORY)->postsolve();                \
-    Assert(!d_inConflict || wasInConflict)        \
-        << "conflict raised during postsolve()";  \
+#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY)   \
+  if (theory::TheoryTraits<THEORY>::hasPostsolve \
+      && d_theoryTable[THEORY] != nullptr)       \
+  {                                              \
+    theoryOf(THEORY)->postsolve();               \
+    Assert(!d_inConflict || wasInConflict)       \
+        << "conflict raised during postsolve()"; \
   }
 
     // Postsolve for each theory using the statement above
@@ -736,7 +823,8 @@ void TheoryEngine::ppStaticLearn(TNode in, NodeBuilder<>& learned) {
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
-  if (theory::TheoryTraits<THEORY>::hasPpStaticLearn) { \
+  if (theory::TheoryTraits<THEORY>::hasPpStaticLearn \
+      && d_theoryTable[THEORY] != nullptr) { \
     theoryOf(THEORY)->ppStaticLearn(in, learned); \
   }
 
@@ -776,7 +864,7 @@ theory::Theory::PPAssertStatus TheoryEngine::solve(
 
   TNode literal = tliteral.getNode();
   TNode atom = literal.getKind() == kind::NOT ? literal[0] : literal;
-  Trace("theory::solve") << "TheoryEngine::solve(" << literal << "): solving with " << theoryOf(atom)->getId() << endl;
+  Trace("theory::solve") << "TheoryEngine::solve(" << literal << "): solving with " << Theory::theoryOf(atom) << endl;
 
   if(! d_logicInfo.isTheoryEnabled(Theory::theoryOf(atom)) &&
      Theory::theoryOf(atom) != THEORY_SAT_SOLVER) {
@@ -798,8 +886,14 @@ theory::Theory::PPAssertStatus TheoryEngine::solve(
 theory::TrustNode TheoryEngine::ppRewriteEquality(TNode eq)
 {
   Assert(eq.getKind() == kind::EQUAL);
+  Theory* t = theoryOf(eq);
+  if (t == nullptr)
+  {
+    // the theory is not enabled by the logic
+    return TrustNode::null();
+  }
   std::vector<SkolemLemma> lems;
-  TrustNode trn = theoryOf(eq)->ppRewrite(eq, lems);
+  TrustNode trn = t->ppRewrite(eq, lems);
   // should never introduce a skolem to eliminate an equality
   Assert(lems.empty());
   return trn;
@@ -818,6 +912,69 @@ void TheoryEngine::notifyPreprocessedAssertions(
   {
     d_relManager->notifyPreprocessedAssertions(assertions);
   }
+  if (options::relevanceLazyAssert())
+  {
+    for (const Node& a : assertions)
+    {
+      addBooleanAtoms(a, d_inputAtoms);
+    }
+  }
+}
+
+void TheoryEngine::addBooleanAtoms(
+    TNode n, context::CDHashSet<Node, NodeHashFunction>& atoms)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    Kind k = cur.getKind();
+    if (k == kind::NOT || k == kind::AND || k == kind::OR
+        || k == kind::IMPLIES || k == kind::XOR
+        || (k == kind::ITE && cur.getType().isBoolean())
+        || (k == kind::EQUAL && cur[0].getType().isBoolean()))
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else if (!cur.isConst())
+    {
+      atoms.insert(cur);
+    }
+  } while (!visit.empty());
+}
+
+void TheoryEngine::assertDeferredFacts()
+{
+  Trace("theory::deferred") << "TheoryEngine::assertDeferredFacts: "
+                            << d_deferredFacts.size() << " deferred facts"
+                            << std::endl;
+  for (const Node& lit : d_deferredFacts)
+  {
+    if (d_inConflict)
+    {
+      return;
+    }
+    if (d_deferredFactsAsserted.find(lit) != d_deferredFactsAsserted.end())
+    {
+      continue;
+    }
+    TNode atom = lit.getKind() == kind::NOT ? lit[0] : lit;
+    if (isRelevant(lit) || d_lemmaAtoms.find(atom) != d_lemmaAtoms.end())
+    {
+      Trace("theory::deferred")
+          << "TheoryEngine::assertDeferredFacts: assert " << lit << std::endl;
+      d_deferredFactsAsserted.insert(lit);
+      ++d_deferredFactsAssertedStat;
+      assertFactInternal(lit);
+    }
+  }
 }
 
 bool TheoryEngine::markPropagation(TNode assertion, TNode originalAssertion, theory::TheoryId toTheoryId, theory::TheoryId fromTheoryId) {
@@ -991,6 +1148,28 @@ void TheoryEngine::assertFact(TNode literal)
     return;
   }
 
+  if (options::relevanceLazyAssert())
+  {
+    // Literals whose atom only occurs in the input formulas may not be needed
+    // for satisfying them, we assert them at full effort if they are relevant.
+    // The atoms of lemmas are always asserted, since the lemmas may be needed
+    // for making progress, e.g. splits for theory combination.
+    TNode atom = literal.getKind() == kind::NOT ? literal[0] : literal;
+    if (d_inputAtoms.find(atom) != d_inputAtoms.end()
+        && d_lemmaAtoms.find(atom) == d_lemmaAtoms.end())
+    {
+      Trace("theory::deferred")
+          << "TheoryEngine::assertFact: defer " << literal << std::endl;
+      d_deferredFacts.push_back(literal);
+      ++d_deferredFactsStat;
+      return;
+    }
+  }
+  assertFactInternal(literal);
+}
+
+void TheoryEngine::assertFactInternal(TNode literal)
+{
   // Get the atom
   bool polarity = literal.getKind() != kind::NOT;
   TNode atom = polarity ? literal : literal[0];
@@ -1088,8 +1267,11 @@ void TheoryEngine::declareSepHeap(TypeNode locT, TypeNode dataT)
 #ifdef CVC4_FOR_EACH_THEORY_STATEMENT
 #undef CVC4_FOR_EACH_THEORY_STATEMENT
 #endif
-#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
-  theoryOf(THEORY)->declareSepHeap(locT, dataT);
+#define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY)     \
+  if (d_theoryTable[THEORY] != nullptr)            \
+  {                                                \
+    theoryOf(THEORY)->declareSepHeap(locT, dataT); \
+  }
 
   // notify each theory using the statement above
   CVC4_FOR_EACH_THEORY;
@@ -1322,9 +1504,37 @@ void TheoryEngine::lemma(theory::TrustNode tlemma,
     printer.toStreamCmdCheckSat(out, n);
   }
 
+  if (d_lemmaBatchDepth > 0)
+  {
+    if (tlemma.getKind() == TrustNodeKind::LEMMA)
+    {
+      // buffer the lemma, it is asserted when the batch ends
+      Trace("te-lemma-batch") << "Buffer lemma " << lemma << std::endl;
+      d_lemmaBatch.emplace_back(tlemma, p);
+      d_lemmasAdded = true;
+      return;
+    }
+    // conflicts are not delayed, but the lemmas buffered so far precede them
+    flushLemmaBatch();
+  }
+
   // assert the lemma
+  assertLemmaInternal(tlemma, p);
+
+  // Mark that we added some lemmas
+  d_lemmasAdded = true;
+}
+
+void TheoryEngine::assertLemmaInternal(theory::TrustNode tlemma,
+                                       theory::LemmaProperty p)
+{
   d_propEngine->assertLemma(tlemma, p);
+  notifyRelevanceLemma(tlemma, p);
+}
 
+void TheoryEngine::notifyRelevanceLemma(theory::TrustNode tlemma,
+                                        theory::LemmaProperty p)
+{
   // If specified, we must add this lemma to the set of those that need to be
   // justified, where note we pass all auxiliary lemmas in skAsserts as well,
   // since these by extension must be justified as well.
@@ -1337,9 +1547,68 @@ void TheoryEngine::lemma(theory::TrustNode tlemma,
     d_relManager->notifyPreprocessedAssertion(retLemma);
     d_relManager->notifyPreprocessedAssertions(skAsserts);
   }
+  if (options::relevanceLazyAssert())
+  {
+    // the literals of the atoms of the lemma, as seen by the propositional
+    // engine, are not deferred
+    std::vector<Node> skAsserts;
+    std::vector<Node> sks;
+    Node retLemma =
+        d_propEngine->getPreprocessedTerm(tlemma.getProven(), skAsserts, sks);
+    addBooleanAtoms(retLemma, d_lemmaAtoms);
+    for (const Node& ska : skAsserts)
+    {
+      addBooleanAtoms(ska, d_lemmaAtoms);
+    }
+  }
+}
 
-  // Mark that we added some lemmas
-  d_lemmasAdded = true;
+void TheoryEngine::beginLemmaBatch() { d_lemmaBatchDepth++; }
+
+void TheoryEngine::endLemmaBatch()
+{
+  Assert(d_lemmaBatchDepth > 0);
+  d_lemmaBatchDepth--;
+  if (d_lemmaBatchDepth == 0)
+  {
+    flushLemmaBatch();
+  }
+}
+
+void TheoryEngine::flushLemmaBatch()
+{
+  if (d_lemmaBatch.empty())
+  {
+    return;
+  }
+  // take the buffered lemmas, since asserting them may send new lemmas
+  std::vector<std::pair<TrustNode, LemmaProperty>> batch;
+  batch.swap(d_lemmaBatch);
+  // drop lemmas that were sent more than once in this batch
+  std::unordered_set<Node, NodeHashFunction> seen;
+  std::unordered_set<Node, NodeHashFunction> seenRemovable;
+  size_t j = 0;
+  for (size_t i = 0, bsize = batch.size(); i < bsize; ++i)
+  {
+    std::unordered_set<Node, NodeHashFunction>& s =
+        isLemmaPropertyRemovable(batch[i].second) ? seenRemovable : seen;
+    if (!s.insert(batch[i].first.getProven()).second)
+    {
+      ++d_batchDuplicateLemmas;
+      continue;
+    }
+    batch[j++] = batch[i];
+  }
+  batch.resize(j);
+  Trace("te-lemma-batch") << "Assert batch of " << batch.size() << " lemmas"
+                          << std::endl;
+  ++d_lemmaBatches;
+  d_batchedLemmas += batch.size();
+  d_propEngine->assertLemmas(batch);
+  for (const std::pair<TrustNode, LemmaProperty>& b : batch)
+  {
+    notifyRelevanceLemma(b.first, b.second);
+  }
 }
 
 void TheoryEngine::conflict(theory::TrustNode tconflict, TheoryId theoryId)
@@ -1780,11 +2049,76 @@ void TheoryEngine::handleUserAttribute(const char* attr, Theory* t) {
   d_attr_handle[ str ].push_back( t );
 }
 
+bool TheoryEngine::checkTheoriesAdaptive(Theory::Effort effort)
+{
+  // The order is recomputed periodically, which amortizes the cost of sorting
+  // and gives the measurements time to change the order
+  if (++d_checksSinceSort >= 256)
+  {
+    sortCheckOrder();
+  }
+  for (TheoryId tid : d_checkOrder)
+  {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    theoryOf(tid)->check(effort);
+    d_checkTime[tid] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    if (d_inConflict)
+    {
+      Debug("conflict") << tid << " in conflict. " << std::endl;
+      ++d_checkConflicts[tid];
+      return true;
+    }
+  }
+  // quantifiers are checked last, since they rely on the other theories
+  if (d_logicInfo.isTheoryEnabled(THEORY_QUANTIFIERS))
+  {
+    theoryOf(THEORY_QUANTIFIERS)->check(effort);
+    if (d_inConflict)
+    {
+      Debug("conflict") << THEORY_QUANTIFIERS << " in conflict. " << std::endl;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TheoryEngine::sortCheckOrder()
+{
+  d_checksSinceSort = 0;
+  ++d_checkOrderSorts;
+  // The yield of a theory is its number of conflicts per millisecond, where we
+  // assume one conflict and one millisecond for each theory initially, so that
+  // theories that were not measured much are not starved.
+  std::vector<std::pair<double, TheoryId>> yields;
+  for (TheoryId tid : d_checkOrder)
+  {
+    double yield = (d_checkConflicts[tid] + 1) / (d_checkTime[tid] * 1e-6 + 1);
+    // sort by decreasing yield, and by the default order for equal yields
+    yields.emplace_back(-yield, tid);
+  }
+  std::stable_sort(yields.begin(),
+                   yields.end(),
+                   [](const std::pair<double, TheoryId>& a,
+                      const std::pair<double, TheoryId>& b) {
+                     return a.first < b.first;
+                   });
+  for (size_t i = 0, size = yields.size(); i < size; ++i)
+  {
+    d_checkOrder[i] = yields[i].second;
+    Trace("theory-check-order") << "TheoryEngine::sortCheckOrder: " << i
+                                << ": " << yields[i].second << ", "
+                                << -yields[i].first << std::endl;
+  }
+}
+
 void TheoryEngine::checkTheoryAssertionsWithModel(bool hardFailure) {
   for(TheoryId theoryId = THEORY_FIRST; theoryId < THEORY_LAST; ++theoryId) {
     Theory* theory = d_theoryTable[theoryId];
     if(theory && d_logicInfo.isTheoryEnabled(theoryId)) {
-      for(context::CDList<Assertion>::const_iterator it = theory->facts_begin(),
+      for(theory::Theory::assertions_iterator it = theory->facts_begin(),
             it_end = theory->facts_end();
           it != it_end;
           ++it) {
@@ -24,6 +24,8 @@
 
 #include "base/check.h"
 #include "context/cdhashmap.h"
+#include "context/cdhashset.h"
+#include "context/cdlist.h"
 #include "expr/node.h"
 #include "options/theory_options.h"
 #include "theory/atom_requests.h"
@@ -258,6 +260,29 @@ class TheoryEngine {
   /** Atom requests from lemmas */
   AtomRequests d_atomRequests;
 
+  /**
+   * Add the atoms of the Boolean structure of n to atoms. This is used for
+   * tracking which atoms can be deferred when relevanceLazyAssert is true.
+   */
+  static void addBooleanAtoms(
+      TNode n, context::CDHashSet<Node, NodeHashFunction>& atoms);
+  /**
+   * Assert the facts deferred by assertFact that are now relevant, or whose
+   * atom now occurs in a lemma, to the theories.
+   */
+  void assertDeferredFacts();
+  /** The atoms of the input formulas, if relevanceLazyAssert is true */
+  context::CDHashSet<Node, NodeHashFunction> d_inputAtoms;
+  /** The atoms of the lemmas, if relevanceLazyAssert is true */
+  context::CDHashSet<Node, NodeHashFunction> d_lemmaAtoms;
+  /**
+   * The literals that the propositional engine asserted but were not asserted
+   * to the theories yet, since their atom only occurs in the input formulas.
+   */
+  context::CDList<Node> d_deferredFacts;
+  /** The literals of d_deferredFacts that were asserted to the theories */
+  context::CDHashSet<Node, NodeHashFunction> d_deferredFactsAsserted;
+
   /**
    * Adds a new lemma, returning its status.
    * @param node the lemma
@@ -270,14 +295,94 @@ class TheoryEngine {
              theory::TheoryId atomsTo = theory::THEORY_LAST,
              theory::TheoryId from = theory::THEORY_LAST);
 
+  /**
+   * Assert the lemma tlemma with properties p to the propositional engine, and
+   * notify the relevance manager of it if necessary.
+   */
+  void assertLemmaInternal(theory::TrustNode tlemma, theory::LemmaProperty p);
+
+  /**
+   * Begin a batch of lemmas, see OutputChannel::beginLemmaBatch(). While a
+   * batch is open, lemma() buffers the lemmas in d_lemmaBatch instead of
+   * asserting them to the propositional engine.
+   */
+  void beginLemmaBatch();
+  /**
+   * End a batch of lemmas. If this closes the outermost batch, the buffered
+   * lemmas are asserted to the propositional engine at once, where a lemma
+   * that is buffered more than once is asserted only once.
+   */
+  void endLemmaBatch();
+  /**
+   * Assert the lemmas buffered in d_lemmaBatch to the propositional engine,
+   * and clear the buffer.
+   */
+  void flushLemmaBatch();
+  /**
+   * Notify the relevance manager of lemma tlemma if p requires it, and record
+   * the atoms of tlemma if relevanceLazyAssert is true.
+   */
+  void notifyRelevanceLemma(theory::TrustNode tlemma, theory::LemmaProperty p);
+  /** The number of open lemma batches */
+  size_t d_lemmaBatchDepth;
+  /** The lemmas buffered in the current batch */
+  std::vector<std::pair<theory::TrustNode, theory::LemmaProperty>> d_lemmaBatch;
+
   /** Enusre that the given atoms are send to the given theory */
   void ensureLemmaAtoms(const std::vector<TNode>& atoms, theory::TheoryId theory);
 
   /** sort inference module */
   std::unique_ptr<theory::SortInference> d_sortInfer;
 
+  /**
+   * Check the theories in the order of d_checkOrder, which is used instead of
+   * the fixed order of CVC4_FOR_EACH_THEORY if theoryCheckAdaptive is true.
+   * Returns true if a theory found a conflict, in which case the remaining
+   * theories are not checked.
+   */
+  bool checkTheoriesAdaptive(theory::Theory::Effort effort);
+  /**
+   * Sort d_checkOrder by decreasing number of conflicts found per time spent
+   * in the check of each theory.
+   */
+  void sortCheckOrder();
+  /**
+   * The theories that have a check method, except quantifiers which is always
+   * checked last, in the order they are checked when theoryCheckAdaptive is
+   * true.
+   */
+  std::vector<theory::TheoryId> d_checkOrder;
+  /** The time spent in the check of each theory, in nanoseconds */
+  uint64_t d_checkTime[theory::THEORY_LAST];
+  /** The number of conflicts found by the check of each theory */
+  uint64_t d_checkConflicts[theory::THEORY_LAST];
+  /** The number of calls to checkTheoriesAdaptive since the last sort */
+  uint32_t d_checksSinceSort;
+
   /** Time spent in theory combination */
   TimerStat d_combineTheoriesTime;
+  /** Number of times the order of the theory checks was recomputed */
+  IntStat d_checkOrderSorts;
+  /** Number of lemma batches asserted to the propositional engine */
+  IntStat d_lemmaBatches;
+  /** Number of lemmas asserted as part of a batch */
+  IntStat d_batchedLemmas;
+  /** Number of duplicate lemmas dropped from batches */
+  IntStat d_batchDuplicateLemmas;
+  /** Number of facts whose assertion to the theories was deferred */
+  IntStat d_deferredFactsStat;
+  /** Number of deferred facts that were eventually asserted */
+  IntStat d_deferredFactsAssertedStat;
+  /** Number of pushes of the SAT context */
+  ReferenceStat<uint64_t> d_satContextPushes;
+  /** Number of bytes saved in the memory of the SAT context */
+  ReferenceStat<uint64_t> d_satContextBytesSaved;
+  /** Number of bytes of the SAT context memory released by pops */
+  ReferenceStat<uint64_t> d_satContextBytesRestored;
+  /** Maximal number of bytes saved in a single SAT context level */
+  ReferenceStat<uint64_t> d_satContextMaxBytesPerPush;
+  /** The bytes of the memory chunks of the SAT context */
+  ReferenceStat<uint64_t> d_satContextChunkBytes;
 
   Node d_true;
   Node d_false;
@@ -487,6 +592,8 @@ class TheoryEngine {
    * @param node the assertion
    */
   void assertFact(TNode node);
+  /** Assert the fact to the theories, called by assertFact */
+  void assertFactInternal(TNode literal);
 
   /**
    * Check all (currently-active) theories for conflicts.
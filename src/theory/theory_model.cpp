@@ -20,6 +20,7 @@
 #include "options/uf_options.h"
 #include "smt/smt_engine.h"
 #include "theory/rewriter.h"
+#include "theory/theory_model_builder.h"
 
 using namespace std;
 using namespace cvc5::kind;
@@ -85,6 +86,8 @@ void TheoryModel::reset(){
   d_uf_terms.clear();
   d_ho_uf_terms.clear();
   d_uf_models.clear();
+  d_lazyFuncs.clear();
+  d_lazyEqc.clear();
   d_using_model_core = false;
   d_model_core.clear();
 }
@@ -283,6 +286,13 @@ Node TheoryModel::getModelValue(TNode n) const
     Debug("model-getvalue-debug")
         << "get value from representative " << ret << "..." << std::endl;
     ret = d_equalityEngine->getRepresentative(ret);
+    if (d_lazyEqc.find(ret) != d_lazyEqc.end())
+    {
+      // evaluate the representative, which has an evaluated kind
+      ret = getModelValue(ret);
+      d_modelCache[n] = ret;
+      return ret;
+    }
     Assert(d_reps.find(ret) != d_reps.end());
     std::map<Node, Node>::const_iterator it2 = d_reps.find(ret);
     if (it2 != d_reps.end())
@@ -301,6 +311,9 @@ Node TheoryModel::getModelValue(TNode n) const
     {
       if (d_enableFuncModels)
       {
+        // the value of n may not have been constructed yet, which modifies
+        // the model but not its meaning
+        const_cast<TheoryModel*>(this)->assignLazyFunction(n);
         std::map<Node, Node>::const_iterator entry = d_uf_models.find(n);
         if (entry != d_uf_models.end())
         {
@@ -633,6 +646,11 @@ Node TheoryModel::getRepresentative(TNode a)
     Node r = d_equalityEngine->getRepresentative( a );
     if( d_reps.find( r )!=d_reps.end() ){
       return d_reps[ r ];
+    }else if (d_lazyEqc.find(r) != d_lazyEqc.end()){
+      // the value of r is computed when it is first needed
+      Node v = getModelValue(r);
+      d_reps[r] = v;
+      return v;
     }else{
       return r;
     }
@@ -706,6 +724,19 @@ void TheoryModel::assignFunctionDefinition( Node f, Node f_def ) {
   }
 }
 
+bool TheoryModel::assignLazyFunction(TNode f)
+{
+  std::unordered_set<Node, NodeHashFunction>::iterator it = d_lazyFuncs.find(f);
+  if (it == d_lazyFuncs.end())
+  {
+    return false;
+  }
+  Node fn = *it;
+  d_lazyFuncs.erase(it);
+  TheoryEngineModelBuilder::assignFunction(this, fn);
+  return true;
+}
+
 std::vector< Node > TheoryModel::getFunctionsToAssign() {
   std::vector< Node > funcs_to_assign;
   std::map< Node, Node > func_to_rep;
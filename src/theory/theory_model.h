@@ -429,7 +429,25 @@ public:
   * type that appear as terms in d_equalityEngine.
   */
   std::map<Node, Node> d_uf_models;
+  /**
+   * The functions whose values have not been constructed yet, since the model
+   * builder leaves the construction of the values of functions to the first
+   * query when modelLazyFunctions is true.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_lazyFuncs;
+  /**
+   * Construct the value of f if it is in d_lazyFuncs, return true if we
+   * did so.
+   */
+  bool assignLazyFunction(TNode f);
   //---------------------------- end function values
+  /**
+   * The equivalence classes whose value is computed from the values of the
+   * children of their representative when it is first queried, since the
+   * model builder does not assign them when modelLazyEval is true. Each term
+   * of these equivalence classes has an evaluated kind and children.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_lazyEqc;
 };/* class TheoryModel */
 
 }  // namespace theory
@@ -167,6 +167,29 @@ bool TheoryEngineModelBuilder::isAssignable(TNode n)
   }
 }
 
+bool TheoryEngineModelBuilder::isLazyEvaluable(TheoryModel* tm, TNode eqc)
+{
+  TypeNode tn = eqc.getType();
+  if (tn.isSort() || !tn.isFirstClass() || tn.isFunction())
+  {
+    return false;
+  }
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, tm->d_equalityEngine);
+  for (; !eqc_i.isFinished(); ++eqc_i)
+  {
+    Node n = *eqc_i;
+    Kind k = n.getKind();
+    if (n.getNumChildren() == 0
+        || tm->d_unevaluated_kinds.find(k) != tm->d_unevaluated_kinds.end()
+        || tm->d_semi_evaluated_kinds.find(k)
+               != tm->d_semi_evaluated_kinds.end())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 void TheoryEngineModelBuilder::addAssignableSubterms(TNode n,
                                                      TheoryModel* tm,
                                                      NodeSet& cache)
@@ -400,6 +423,7 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
 
   // The constant representatives, per equivalence class
   d_constantReps.clear();
+  tm->d_lazyEqc.clear();
   // The representatives that have been asserted by theories. This includes
   // non-constant "skeletons" that have been specified by parametric theories.
   std::map<Node, Node> assertedReps;
@@ -425,6 +449,12 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
   // an expression in them that is not assignable, and have not already been
   // assigned a constant.
   std::unordered_set<Node, NodeHashFunction> evaluableEqc;
+  // The equivalence classes that are candidates for being evaluated on demand
+  // by the model (see isLazyEvaluable), and the base types of the equivalence
+  // classes that are assigned values.
+  TypeSet typeLazySet;
+  std::unordered_set<TypeNode, TypeNodeHashFunction> assignedTypes;
+  bool lazyEval = options::modelLazyEval();
   // Assigner objects for relevant equivalence classes that require special
   // ways of assigning values, e.g. those that take into account assignment
   // exclusion sets.
@@ -584,9 +614,16 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
     {
       assertedReps[eqc] = rep;
       typeRepSet.add(eqct.getBaseType(), eqc);
+      assignedTypes.insert(eqct.getBaseType());
       std::unordered_set<TypeNode, TypeNodeHashFunction> visiting;
       addToTypeList(eqct.getBaseType(), type_list, visiting);
     }
+    else if (lazyEval && !assignable && isLazyEvaluable(tm, eqc))
+    {
+      Assert(evaluable);
+      typeLazySet.add(eqct, eqc);
+      continue;
+    }
     else
     {
       typeNoRepSet.add(eqct, eqc);
@@ -597,6 +634,7 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
     if (assignable)
     {
       assignableEqc.insert(eqc);
+      assignedTypes.insert(eqct.getBaseType());
     }
     if (evaluable)
     {
@@ -647,6 +685,32 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
 
   // Now finished initialization
 
+  // The values of equivalence classes in typeLazySet are computed by the
+  // model when they are queried. This is only done if no values are assigned
+  // to the equivalence classes of their type, since otherwise the assigned
+  // values must be distinct from the evaluated ones.
+  for (TypeSet::iterator itl = typeLazySet.begin(); itl != typeLazySet.end();
+       ++itl)
+  {
+    TypeNode lt = TypeSet::getType(itl);
+    std::set<Node>& lazySet = TypeSet::getSet(itl);
+    if (assignedTypes.find(lt.getBaseType()) == assignedTypes.end())
+    {
+      Trace("model-builder") << "Evaluate " << lazySet.size()
+                             << " equivalence classes of type " << lt
+                             << " on demand" << std::endl;
+      tm->d_lazyEqc.insert(lazySet.begin(), lazySet.end());
+      continue;
+    }
+    for (const Node& eqc : lazySet)
+    {
+      typeNoRepSet.add(lt, eqc);
+      evaluableEqc.insert(eqc);
+    }
+    std::unordered_set<TypeNode, TypeNodeHashFunction> visiting;
+    addToTypeList(lt, type_list, visiting);
+  }
+
   // Compute type enumerator properties. This code ensures we do not
   // enumerate terms that have uninterpreted constants that violate the
   // bounds imposed by finite model finding. For example, if finite
@@ -1161,14 +1225,19 @@ Node TheoryEngineModelBuilder::normalize(TheoryModel* m, TNode r, bool evalOnly)
       {
         if (m->d_equalityEngine->hasTerm(ri))
         {
-          itMap =
-              d_constantReps.find(m->d_equalityEngine->getRepresentative(ri));
+          Node rr = m->d_equalityEngine->getRepresentative(ri);
+          itMap = d_constantReps.find(rr);
           if (itMap != d_constantReps.end())
           {
             ri = (*itMap).second;
             Trace("model-builder-debug") << i << ": const child " << ri << std::endl;
             recurse = false;
           }
+          else if (m->d_lazyEqc.find(rr) != m->d_lazyEqc.end())
+          {
+            // not assigned, the child is evaluated instead
+            Trace("model-builder-debug") << i << ": lazy " << ri << std::endl;
+          }
           else if (!evalOnly)
           {
             recurse = false;
@@ -1405,6 +1474,14 @@ void TheoryEngineModelBuilder::assignFunctions(TheoryModel* m)
     }
   }
 
+  if (options::modelLazyFunctions() && !options::ufHo())
+  {
+    // the values are constructed by the model when they are first queried
+    Trace("model-builder") << "Defer assigning function values." << std::endl;
+    m->d_lazyFuncs.insert(funcs_to_assign.begin(), funcs_to_assign.end());
+    return;
+  }
+
   // construct function values
   for (unsigned k = 0; k < funcs_to_assign.size(); k++)
   {
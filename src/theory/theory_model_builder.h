@@ -43,6 +43,7 @@ namespace theory {
  */
 class TheoryEngineModelBuilder
 {
+  friend class TheoryModel;
   typedef std::unordered_map<Node, Node, NodeHashFunction> NodeMap;
   typedef std::unordered_set<Node, NodeHashFunction> NodeSet;
 
@@ -136,6 +137,14 @@ class TheoryEngineModelBuilder
    * terms are not assignable if they have a higher-order (function) type.
    */
   bool isAssignable(TNode n);
+  /** is the value of eqc computable on demand?
+   *
+   * This returns true if the value of the equivalence class eqc can be left
+   * to be computed by tm when it is queried (see TheoryModel::d_lazyEqc),
+   * that is, if all terms in eqc are applications of evaluated kinds and eqc
+   * is not of an uninterpreted sort or of a higher-order type.
+   */
+  bool isLazyEvaluable(TheoryModel* tm, TNode eqc);
   /** add assignable subterms
    * Adds all assignable subterms of n to tm's equality engine.
    */
@@ -178,7 +187,7 @@ class TheoryEngineModelBuilder
   *                 (ite (and (= x 0) (= y 2)) 2
   *                 (ite (and (= x 1) (= y 1)) 3 ...)))
   */
-  void assignFunction(TheoryModel* m, Node f);
+  static void assignFunction(TheoryModel* m, Node f);
   /** assign function f based on the model m.
   * This construction is based on "dag form". For example:
   * (f 0 1) = 1
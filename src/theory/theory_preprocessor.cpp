@@ -16,6 +16,7 @@
 
 #include "expr/lazy_proof.h"
 #include "expr/skolem_manager.h"
+#include "options/smt_options.h"
 #include "smt/logic_exception.h"
 #include "theory/logic_info.h"
 #include "theory/rewriter.h"
@@ -31,8 +32,11 @@ TheoryPreprocessor::TheoryPreprocessor(TheoryEngine& engine,
                                        ProofNodeManager* pnm)
     : d_engine(engine),
       d_logicInfo(engine.getLogicInfo()),
-      d_ppCache(userContext),
-      d_rtfCache(userContext),
+      d_persistent(pnm == nullptr && options::ppPersistentCache()),
+      d_definedSkolems(userContext),
+      d_definedTerms(userContext),
+      d_ppCache(d_persistent ? &d_cacheContext : userContext),
+      d_rtfCache(d_persistent ? &d_cacheContext : userContext),
       d_tfr(userContext, pnm),
       d_tpg(pnm ? new TConvProofGenerator(
                       pnm,
@@ -104,8 +108,13 @@ TrustNode TheoryPreprocessor::preprocessInternal(
   Node irNode = rewriteWithProof(node, d_tpgRew.get(), true);
 
   // run theory preprocessing
+  size_t start = newSkolems.size();
   TrustNode tpp = theoryPreprocess(irNode, newLemmas, newSkolems);
   Node ppNode = tpp.getNode();
+  if (d_persistent)
+  {
+    addSkolemDefinitions(ppNode, start, newLemmas, newSkolems);
+  }
 
   if (Trace.isOn("tpp-debug"))
   {
@@ -227,6 +236,51 @@ TrustNode TheoryPreprocessor::preprocessLemmaInternal(
   return TrustNode::mkTrustLemma(lemmap, d_lp.get());
 }
 
+void TheoryPreprocessor::addSkolemDefinitions(
+    TNode n,
+    size_t start,
+    std::vector<TrustNode>& newLemmas,
+    std::vector<Node>& newSkolems)
+{
+  Assert(newLemmas.size() == newSkolems.size());
+  for (size_t i = start, nsks = newSkolems.size(); i < nsks; i++)
+  {
+    d_skolemDefs.emplace(newSkolems[i], newLemmas[i]);
+    d_definedSkolems.insert(newSkolems[i]);
+  }
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (d_definedTerms.find(cur) != d_definedTerms.end())
+    {
+      continue;
+    }
+    d_definedTerms.insert(cur);
+    if (!cur.isVar())
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    std::unordered_map<Node, TrustNode, NodeHashFunction>::iterator it =
+        d_skolemDefs.find(cur);
+    if (it != d_skolemDefs.end()
+        && d_definedSkolems.find(cur) == d_definedSkolems.end())
+    {
+      // the skolem was introduced in a popped user context, add its
+      // definition again, which is preprocessed along with the other lemmas
+      Trace("tpp") << "Re-add definition of " << cur << " : "
+                   << it->second.getProven() << std::endl;
+      newLemmas.push_back(it->second);
+      newSkolems.push_back(cur);
+      d_definedSkolems.insert(cur);
+    }
+  } while (!visit.empty());
+}
+
 RemoveTermFormulas& TheoryPreprocessor::getRemoveTermFormulas()
 {
   return d_tfr;
@@ -461,8 +515,15 @@ Node TheoryPreprocessor::preprocessWithProof(Node term,
   {
     return term;
   }
+  Theory* t = d_engine.theoryOf(term);
+  if (t == nullptr)
+  {
+    // the theory of term is not enabled by the logic, in which case term is
+    // rejected when it is registered
+    return term;
+  }
   // call ppRewrite for the given theory
-  TrustNode trn = d_engine.theoryOf(term)->ppRewrite(term, lems);
+  TrustNode trn = t->ppRewrite(term, lems);
   Trace("tpp-debug2") << "preprocessWithProof returned " << trn
                       << ", #lems = " << lems.size() << std::endl;
   if (trn.isNull())
@@ -20,6 +20,7 @@
 #include <unordered_map>
 
 #include "context/cdhashmap.h"
+#include "context/cdhashset.h"
 #include "context/context.h"
 #include "expr/lazy_proof.h"
 #include "expr/node.h"
@@ -72,6 +73,7 @@ namespace theory {
 class TheoryPreprocessor
 {
   typedef context::CDHashMap<Node, Node, NodeHashFunction> NodeMap;
+  typedef context::CDHashSet<Node, NodeHashFunction> NodeSet;
 
  public:
   /** Constructs a theory preprocessor */
@@ -140,10 +142,42 @@ class TheoryPreprocessor
                                     std::vector<TrustNode>& newLemmas,
                                     std::vector<Node>& newSkolems,
                                     bool procLemmas);
+  /**
+   * Add the definitions of the skolems of n to newLemmas and newSkolems, for
+   * the skolems whose definitions were not added in the current user context.
+   * This is required when the caches persist across user contexts, since the
+   * preprocessed form of a term may then be taken from the cache and contain
+   * skolems that were introduced in a popped user context. The skolems
+   * newSkolems[start], ..., newSkolems[newSkolems.size()-1] are the ones that
+   * were introduced while preprocessing n, whose definitions are remembered.
+   */
+  void addSkolemDefinitions(TNode n,
+                            size_t start,
+                            std::vector<TrustNode>& newLemmas,
+                            std::vector<Node>& newSkolems);
   /** Reference to owning theory engine */
   TheoryEngine& d_engine;
   /** Logic info of theory engine */
   const LogicInfo& d_logicInfo;
+  /**
+   * Whether the caches below persist across user contexts, which is the case
+   * if option ppPersistentCache is set and proofs are disabled.
+   */
+  bool d_persistent;
+  /**
+   * The context of d_ppCache and d_rtfCache if d_persistent is true, which is
+   * never pushed.
+   */
+  context::UserContext d_cacheContext;
+  /**
+   * The definitions of the skolems introduced by preprocessing, which are
+   * only remembered if d_persistent is true.
+   */
+  std::unordered_map<Node, TrustNode, NodeHashFunction> d_skolemDefs;
+  /** The skolems whose definitions were added in the current user context */
+  NodeSet d_definedSkolems;
+  /** The terms whose skolems have definitions in the current user context */
+  NodeSet d_definedTerms;
   /**
    * Cache for theory-preprocessing of theory atoms. The domain of this map
    * are terms that appear within theory atoms given to this class.
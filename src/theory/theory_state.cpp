@@ -162,11 +162,13 @@ bool TheoryState::hasSatValue(TNode n, bool& value) const
   return d_valuation.hasSatValue(n, value);
 }
 
-context::CDList<Assertion>::const_iterator TheoryState::factsBegin(TheoryId tid)
+context::CDChunkList<Assertion>::const_iterator TheoryState::factsBegin(
+    TheoryId tid)
 {
   return d_valuation.factsBegin(tid);
 }
-context::CDList<Assertion>::const_iterator TheoryState::factsEnd(TheoryId tid)
+context::CDChunkList<Assertion>::const_iterator TheoryState::factsEnd(
+    TheoryId tid)
 {
   return d_valuation.factsEnd(tid);
 }
@@ -97,9 +97,9 @@ class TheoryState
    * assertions from other theories.
    */
   /** The beginning iterator of facts for theory tid.*/
-  context::CDList<Assertion>::const_iterator factsBegin(TheoryId tid);
+  context::CDChunkList<Assertion>::const_iterator factsBegin(TheoryId tid);
   /** The beginning iterator of facts for theory tid.*/
-  context::CDList<Assertion>::const_iterator factsEnd(TheoryId tid);
+  context::CDChunkList<Assertion>::const_iterator factsEnd(TheoryId tid);
 
   /** Get the underlying valuation class */
   Valuation& getValuation();
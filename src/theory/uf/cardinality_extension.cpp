@@ -14,6 +14,7 @@
 
 #include "theory/uf/cardinality_extension.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "options/smt_options.h"
@@ -165,8 +166,8 @@ void Region::setDisequal( Node n1, Node n2, int type, bool valid ){
       d_total_diseq_internal = d_total_diseq_internal + ( valid ? 1 : -1 );
       if( valid ){
         //if they are both a part of testClique, then remove split
-        if( d_testClique.find( n1 )!=d_testClique.end() && d_testClique[n1] &&
-            d_testClique.find( n2 )!=d_testClique.end() && d_testClique[n2] ){
+        if (isInTestClique(n1) && isInTestClique(n2))
+        {
           Node eq = NodeManager::currentNM()->mkNode( EQUAL, n1, n2 );
           if( d_splits.find( eq )!=d_splits.end() && d_splits[ eq ] ){
             Debug("uf-ss-debug") << "removing split for " << n1 << " " << n2
@@ -188,7 +189,8 @@ void Region::setRep( Node n, bool valid ) {
   d_nodes[n]->setValid(valid);
   d_reps_size = d_reps_size + ( valid ? 1 : -1 );
   //removing a member of the test clique from this region
-  if( d_testClique.find( n ) != d_testClique.end() && d_testClique[n] ){
+  if (isInTestClique(n))
+  {
     Assert(!valid);
     d_testClique[n] = false;
     d_testCliqueSize = d_testCliqueSize - 1;
@@ -209,22 +211,6 @@ bool Region::isDisequal( Node n1, Node n2, int type ) {
   return del->isSet(n2) && del->getDisequalityValue(n2);
 }
 
-struct sortInternalDegree {
-  Region* r;
-  bool operator() (Node i, Node j) {
-    return (r->getRegionInfo(i)->getNumInternalDisequalities() >
-            r->getRegionInfo(j)->getNumInternalDisequalities());
-  }
-};
-
-struct sortExternalDegree {
-  Region* r;
-  bool operator() (Node i,Node j) {
-    return (r->getRegionInfo(i)->getNumExternalDisequalities() >
-            r->getRegionInfo(j)->getNumExternalDisequalities());
-  }
-};
-
 int gmcCount = 0;
 
 bool Region::getMustCombine( int cardinality ){
@@ -293,23 +279,30 @@ bool Region::check( Theory::Effort level, int cardinality,
       if( d_testCliqueSize<=unsigned(cardinality) ){
         std::vector< Node > newClique;
         if( d_testCliqueSize<unsigned(cardinality) ){
+          // the candidates not in the test clique, paired with their degree
+          std::vector<std::pair<int, Node>> cands;
           for( iterator it = begin(); it != end(); ++it ){
-            //if not in the test clique, add it to the set of new members
-            if( it->second->valid() &&
-                ( d_testClique.find( it->first ) == d_testClique.end() ||
-                  !d_testClique[ it->first ] ) ){
-              //if( it->second->getNumInternalDisequalities()>cardinality ||
-              //    level==Theory::EFFORT_FULL ){
-              newClique.push_back( it->first );
-              //}
+            if (it->second->valid() && !isInTestClique(it->first))
+            {
+              cands.emplace_back(
+                  it->second->getNumInternalDisequalities(), it->first);
             }
           }
-          //choose remaining nodes with the highest degrees
-          sortInternalDegree sidObj;
-          sidObj.r = this;
-          std::sort( newClique.begin(), newClique.end(), sidObj );
-          int offset = ( cardinality - d_testCliqueSize ) + 1;
-          newClique.erase( newClique.begin() + offset, newClique.end() );
+          // choose remaining nodes with the highest degrees, which only
+          // requires ordering the chosen prefix of the candidates
+          size_t offset = (cardinality - d_testCliqueSize) + 1;
+          Assert(offset <= cands.size());
+          std::partial_sort(cands.begin(),
+                            cands.begin() + offset,
+                            cands.end(),
+                            [](const std::pair<int, Node>& i,
+                               const std::pair<int, Node>& j) {
+                              return i.first > j.first;
+                            });
+          for (size_t j = 0; j < offset; j++)
+          {
+            newClique.push_back(cands[j].second);
+          }
         }else{
           //scan for the highest degree
           int maxDeg = -1;
@@ -317,9 +310,8 @@ bool Region::check( Theory::Effort level, int cardinality,
           for( std::map< Node, RegionNodeInfo* >::iterator
                  it = d_nodes.begin(); it != d_nodes.end(); ++it ){
             //if not in the test clique, add it to the set of new members
-            if( it->second->valid() &&
-                ( d_testClique.find( it->first )==d_testClique.end() ||
-                  !d_testClique[ it->first ] ) ){
+            if (it->second->valid() && !isInTestClique(it->first))
+            {
               if( it->second->getNumInternalDisequalities()>maxDeg ){
                 maxDeg = it->second->getNumInternalDisequalities();
                 maxNode = it->first;
@@ -189,7 +189,14 @@ class CardinalityExtension
       size_t getTestCliqueSize() const { return d_testCliqueSize; }
       // has representative
       bool hasRep( Node n ) {
-        return d_nodes.find(n) != d_nodes.end() && d_nodes[n]->valid();
+        std::map<Node, RegionNodeInfo*>::const_iterator it = d_nodes.find(n);
+        return it != d_nodes.end() && it->second->valid();
+      }
+      /** is n a member of the test clique? */
+      bool isInTestClique(Node n) const
+      {
+        NodeBoolMap::const_iterator it = d_testClique.find(n);
+        return it != d_testClique.end() && (*it).second;
       }
       // is disequal
       bool isDisequal( Node n1, Node n2, int type );
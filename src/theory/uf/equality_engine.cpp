@@ -17,6 +17,8 @@
 
 #include "theory/uf/equality_engine.h"
 
+#include <unordered_set>
+
 #include "base/output.h"
 #include "options/smt_options.h"
 #include "proof/proof_manager.h"
@@ -200,8 +202,8 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
   EqualityNodeId funId = newNode(original);
   FunctionApplication funOriginal(type, t1, t2);
   // The function application we're creating
-  EqualityNodeId t1ClassId = getEqualityNode(t1).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2).getFind();
+  EqualityNodeId t1ClassId = getFind(t1);
+  EqualityNodeId t2ClassId = getFind(t2);
   FunctionApplication funNormalized(type, t1ClassId, t2ClassId);
 
   Debug("equality") << d_name << "::eq::newApplicationNode: funOriginal: ("
@@ -270,6 +272,8 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_isInternal.push_back(true);
   // Add the equality node to the nodes
   d_equalityNodes.push_back(EqualityNode(newId));
+  // The node is its own representative
+  d_findIds.push_back(newId);
 
   // Increase the counters
   d_nodesCount = d_nodesCount + 1;
@@ -531,8 +535,8 @@ bool EqualityEngine::assertEquality(TNode eq,
     // If both have constant representatives, we don't notify anyone
     EqualityNodeId a = getNodeId(eq[0]);
     EqualityNodeId b = getNodeId(eq[1]);
-    EqualityNodeId aClassId = getEqualityNode(a).getFind();
-    EqualityNodeId bClassId = getEqualityNode(b).getFind();
+    EqualityNodeId aClassId = getFind(a);
+    EqualityNodeId bClassId = getFind(b);
     if (d_isConstant[aClassId] && d_isConstant[bClassId]) {
       return true;
     }
@@ -592,32 +596,31 @@ bool EqualityEngine::assertEquality(TNode eq,
 TNode EqualityEngine::getRepresentative(TNode t) const {
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ")" << std::endl;
   Assert(hasTerm(t));
-  EqualityNodeId representativeId = getEqualityNode(t).getFind();
+  EqualityNodeId representativeId = getFind(t);
   Assert(!d_isInternal[representativeId]);
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ") => " << d_nodes[representativeId] << std::endl;
   return d_nodes[representativeId];
 }
 
-bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggersFired) {
-
-  Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << ")" << std::endl;
+bool EqualityEngine::merge(EqualityNodeId class1Id,
+                           EqualityNodeId class2Id,
+                           std::vector<TriggerId>& triggersFired)
+{
+  Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   Assert(triggersFired.empty());
+  Assert(getFind(class1Id) == class1Id);
+  Assert(getFind(class2Id) == class2Id);
 
   ++d_stats.d_mergesCount;
 
-  EqualityNodeId class1Id = class1.getFind();
-  EqualityNodeId class2Id = class2.getFind();
-
   Node n1 = d_nodes[class1Id];
   Node n2 = d_nodes[class2Id];
-  EqualityNode cc1 = getEqualityNode(n1);
-  EqualityNode cc2 = getEqualityNode(n2);
   bool doNotify = false;
   // Determine if we should notify the owner of this class of this merge.
   // The second part of this check is needed due to the internal implementation
   // of this class. It ensures that we are merging terms and not operators.
-  if (d_performNotify && class1Id == cc1.getFind() && class2Id == cc2.getFind())
+  if (d_performNotify && class1Id == getFind(n1) && class2Id == getFind(n2))
   {
     doNotify = true;
   }
@@ -658,15 +661,15 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Update class2 representative information
-  Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating class " << class2Id << std::endl;
+  Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating class " << class2Id << std::endl;
   EqualityNodeId currentId = class2Id;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
     // Update it's find to class1 id
-    Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << currentId << "->" << class1Id << std::endl;
-    currentNode.setFind(class1Id);
+    Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << currentId << "->" << class1Id << std::endl;
+    d_findIds[currentId] = class1Id;
 
     // Go through the triggers and inform if necessary
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -698,11 +701,11 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   // Update class2 table lookup and information if not a boolean
   // since booleans can't be in an application
   if (!d_isEquality[class2Id]) {
-    Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of " << class2Id << std::endl;
+    Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of " << class2Id << std::endl;
     do {
       // Get the current node
       EqualityNode& currentNode = getEqualityNode(currentId);
-      Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of node " << currentId << std::endl;
+      Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of node " << currentId << std::endl;
 
       // Go through the uselist and check for congruences
       UseListNodeId currentUseId = currentNode.getUseList();
@@ -711,7 +714,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         UseListNode& useNode = d_useListNodes[currentUseId];
         // Get the function application
         EqualityNodeId funId = useNode.getApplicationId();
-        Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
+        Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
         const FunctionApplication& fun =
             d_applications[useNode.getApplicationId()].d_normalized;
         // If it's interpreted and we can interpret
@@ -722,13 +725,13 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
           subtermEvaluates(getNodeId(term));
         }
         // Check if there is an application with find arguments
-        EqualityNodeId aNormalized = getEqualityNode(fun.d_a).getFind();
-        EqualityNodeId bNormalized = getEqualityNode(fun.d_b).getFind();
+        EqualityNodeId aNormalized = getFind(fun.d_a);
+        EqualityNodeId bNormalized = getFind(fun.d_b);
         FunctionApplication funNormalized(fun.d_type, aNormalized, bNormalized);
         ApplicationIdsMap::iterator find = d_applicationLookup.find(funNormalized);
         if (find != d_applicationLookup.end()) {
           // Applications fun and the funNormalized can be merged due to congruence
-          if (getEqualityNode(funId).getFind() != getEqualityNode(find->second).getFind()) {
+          if (getFind(funId) != getFind(find->second)) {
             enqueue(MergeCandidate(funId, find->second, MERGED_THROUGH_CONGRUENCE, TNode::null()));
           }
         } else {
@@ -746,7 +749,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Now merge the lists
-  class1.merge<true>(class2);
+  d_equalityNodes[class1Id].merge<true>(d_equalityNodes[class2Id]);
 
   // notify the theory
   if (doNotify) {
@@ -834,22 +837,22 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   return true;
 }
 
-void EqualityEngine::undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id) {
-
-  Debug("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << ")" << std::endl;
+void EqualityEngine::undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id)
+{
+  Debug("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   // Now unmerge the lists (same as merge)
-  class1.merge<false>(class2);
+  d_equalityNodes[class1Id].merge<false>(d_equalityNodes[class2Id]);
 
   // Update class2 representative information
   EqualityNodeId currentId = class2Id;
-  Debug("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << "): undoing representative info" << std::endl;
+  Debug("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << "): undoing representative info" << std::endl;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
-    // Update it's find to class1 id
-    currentNode.setFind(class2Id);
+    // Update it's find to class2 id
+    d_findIds[currentId] = class2Id;
 
     // Go through the trigger list (if any) and undo the class
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -886,8 +889,7 @@ void EqualityEngine::backtrack() {
       // Undo the merge
       if (eq.d_lhs != null_id)
       {
-        undoMerge(
-            d_equalityNodes[eq.d_lhs], d_equalityNodes[eq.d_rhs], eq.d_rhs);
+        undoMerge(eq.d_lhs, eq.d_rhs);
       }
     }
 
@@ -903,6 +905,15 @@ void EqualityEngine::backtrack() {
     }
 
     d_equalityEdges.resize(2 * d_assertedEqualitiesCount);
+
+    // Forget the explanations that used the removed edges
+    while (!d_explanationCacheTrail.empty()
+           && d_explanationCacheTrail.back().second
+                  > d_assertedEqualitiesCount)
+    {
+      d_explanationCache.erase(d_explanationCacheTrail.back().first);
+      d_explanationCacheTrail.pop_back();
+    }
   }
 
   if (d_triggerTermSetUpdates.size() > d_triggerTermSetUpdatesSize) {
@@ -966,6 +977,7 @@ void EqualityEngine::backtrack() {
     d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
     d_equalityNodes.resize(d_nodesCount);
+    d_findIds.resize(d_nodesCount);
   }
 
   if (d_deducedDisequalities.size() > d_deducedDisequalitiesSize) {
@@ -1255,6 +1267,23 @@ void EqualityEngine::explainEquality(TNode t1, TNode t2, bool polarity,
   }
 }
 
+void EqualityEngine::explainEqualities(
+    const std::vector<std::pair<TNode, TNode>>& eqs,
+    std::vector<TNode>& equalities) const
+{
+  // share the cache among the equalities, so that each sub-explanation is
+  // added once
+  std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
+  for (const std::pair<TNode, TNode>& eq : eqs)
+  {
+    Debug("equality") << d_name << "::eq::explainEqualities(" << eq.first
+                      << ", " << eq.second << ")" << std::endl;
+    Assert(hasTerm(eq.first) && hasTerm(eq.second));
+    getExplanation(
+        getNodeId(eq.first), getNodeId(eq.second), equalities, cache, nullptr);
+  }
+}
+
 void EqualityEngine::explainPredicate(TNode p, bool polarity,
                                       std::vector<TNode>& assertions,
                                       EqProof* eqp) const {
@@ -1355,6 +1384,46 @@ void EqualityEngine::getExplanation(
     {
       return;
     }
+    cache[cacheKey] = nullptr;
+    if (t1Id == t2Id)
+    {
+      return;
+    }
+    // Use the memoized explanation if we have it, otherwise compute it in
+    // isolation, so that it includes the sub-explanations that are already
+    // in cache, and memoize it.
+    std::unordered_map<EqualityPair,
+                       std::vector<TNode>,
+                       EqualityPairHashFunction>::const_iterator itm =
+        d_explanationCache.find(cacheKey);
+    if (itm == d_explanationCache.end())
+    {
+      std::vector<TNode> reasons;
+      std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> subCache;
+      subCache[cacheKey] = nullptr;
+      computeExplanation(t1Id, t2Id, reasons, subCache, nullptr);
+      // remove the duplicates, which come from sub-explanations sharing edges
+      std::unordered_set<TNode, TNodeHashFunction> seen;
+      std::vector<TNode>& cached = d_explanationCache[cacheKey];
+      for (TNode r : reasons)
+      {
+        if (seen.insert(r).second)
+        {
+          cached.push_back(r);
+        }
+      }
+      d_explanationCacheTrail.emplace_back(cacheKey,
+                                           d_assertedEqualities.size());
+      itm = d_explanationCache.find(cacheKey);
+    }
+    else
+    {
+      Trace("eq-exp") << d_name << "::eq::getExplanation(): cached"
+                      << std::endl;
+    }
+    equalities.insert(
+        equalities.end(), itm->second.begin(), itm->second.end());
+    return;
   }
   else
   {
@@ -1385,16 +1454,25 @@ void EqualityEngine::getExplanation(
     }
   }
   cache[cacheKey] = eqp;
+  computeExplanation(t1Id, t2Id, equalities, cache, eqp);
+}
 
+void EqualityEngine::computeExplanation(
+    EqualityNodeId t1Id,
+    EqualityNodeId t2Id,
+    std::vector<TNode>& equalities,
+    std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
+    EqProof* eqp) const
+{
   // We can only explain the nodes that got merged
 #ifdef CVC4_ASSERTIONS
-  bool canExplain = getEqualityNode(t1Id).getFind() == getEqualityNode(t2Id).getFind()
+  bool canExplain = getFind(t1Id) == getFind(t2Id)
                   || (d_done && isConstant(t1Id) && isConstant(t2Id));
 
   if (!canExplain) {
     Warning() << "Can't explain equality:" << std::endl;
-    Warning() << d_nodes[t1Id] << " with find " << d_nodes[getEqualityNode(t1Id).getFind()] << std::endl;
-    Warning() << d_nodes[t2Id] << " with find " << d_nodes[getEqualityNode(t2Id).getFind()] << std::endl;
+    Warning() << d_nodes[t1Id] << " with find " << d_nodes[getFind(t1Id)] << std::endl;
+    Warning() << d_nodes[t2Id] << " with find " << d_nodes[getFind(t2Id)] << std::endl;
   }
   Assert(canExplain);
 #endif
@@ -1603,7 +1681,7 @@ void EqualityEngine::getExplanation(
                 std::shared_ptr<EqProof> eqpcc =
                     eqpc ? std::make_shared<EqProof>() : nullptr;
                 getExplanation(childId,
-                               getEqualityNode(childId).getFind(),
+                               getFind(childId),
                                equalities,
                                cache,
                                eqpcc.get());
@@ -1803,13 +1881,13 @@ void EqualityEngine::addTriggerEqualityInternal(TNode t1, TNode t2, TNode trigge
 
   // Get the information about t1
   EqualityNodeId t1Id = getNodeId(t1);
-  EqualityNodeId t1classId = getEqualityNode(t1Id).getFind();
+  EqualityNodeId t1classId = getFind(t1Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t1TriggerId = d_nodeTriggers[t1classId];
 
   // Get the information about t2
   EqualityNodeId t2Id = getNodeId(t2);
-  EqualityNodeId t2classId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t2classId = getFind(t2Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t2TriggerId = d_nodeTriggers[t2classId];
 
@@ -1912,8 +1990,8 @@ void EqualityEngine::propagate() {
     d_propagationQueue.pop_front();
 
     // Get the representatives
-    EqualityNodeId t1classId = getEqualityNode(current.d_t1Id).getFind();
-    EqualityNodeId t2classId = getEqualityNode(current.d_t2Id).getFind();
+    EqualityNodeId t1classId = getFind(current.d_t1Id);
+    EqualityNodeId t2classId = getFind(current.d_t2Id);
 
     // If already the same, we're done
     if (t1classId == t2classId) {
@@ -1927,9 +2005,6 @@ void EqualityEngine::propagate() {
     EqualityNode& node1 = getEqualityNode(t1classId);
     EqualityNode& node2 = getEqualityNode(t2classId);
 
-    Assert(node1.getFind() == t1classId);
-    Assert(node2.getFind() == t2classId);
-
     // Add the actual equality to the equality graph
     addGraphEdge(
         current.d_t1Id, current.d_t2Id, current.d_type, current.d_reason);
@@ -1983,7 +2058,7 @@ void EqualityEngine::propagate() {
                         << d_nodes[current.d_t2Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t2classId, t1classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-      if (!merge(node2, node1, triggers)) {
+      if (!merge(t2classId, t1classId, triggers)) {
         d_done = true;
       }
     } else {
@@ -1992,7 +2067,7 @@ void EqualityEngine::propagate() {
                         << d_nodes[current.d_t1Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t1classId, t2classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-    if (!merge(node1, node2, triggers)) {
+    if (!merge(t1classId, t2classId, triggers)) {
         d_done = true;
       }
     }
@@ -2061,7 +2136,7 @@ void EqualityEngine::debugPrintGraph() const {
   Debug("equality::graph") << std::endl << "Dumping graph" << std::endl;
   for (EqualityNodeId nodeId = 0; nodeId < d_nodes.size(); ++ nodeId) {
 
-    Debug("equality::graph") << d_nodes[nodeId] << " " << nodeId << "(" << getEqualityNode(nodeId).getFind() << "):";
+    Debug("equality::graph") << d_nodes[nodeId] << " " << nodeId << "(" << getFind(nodeId) << "):";
 
     EqualityEdgeId edgeId = d_equalityGraph[nodeId];
     while (edgeId != null_edge) {
@@ -2104,7 +2179,7 @@ bool EqualityEngine::areEqual(TNode t1, TNode t2) const {
   Assert(hasTerm(t1));
   Assert(hasTerm(t2));
 
-  bool result = getEqualityNode(t1).getFind() == getEqualityNode(t2).getFind();
+  bool result = getFind(t1) == getFind(t2);
   Debug("equality") << (result ? "\t(YES)" : "\t(NO)") << std::endl;
   return result;
 }
@@ -2128,8 +2203,8 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   }
 
   // Get equivalence classes
-  EqualityNodeId t1ClassId = getEqualityNode(t1Id).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t1ClassId = getFind(t1Id);
+  EqualityNodeId t2ClassId = getFind(t2Id);
 
   // We are semantically const, for remembering stuff
   EqualityEngine* nonConst = const_cast<EqualityEngine*>(this);
@@ -2149,7 +2224,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   FunctionApplication eqNormalized(APP_EQUALITY, t1ClassId, t2ClassId);
   ApplicationIdsMap::const_iterator find = d_applicationLookup.find(eqNormalized);
   if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+    if (getFind(find->second) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original =
             d_applications[find->second].d_original;
@@ -2169,7 +2244,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   std::swap(eqNormalized.d_a, eqNormalized.d_b);
   find = d_applicationLookup.find(eqNormalized);
   if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+    if (getFind(find->second) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original =
             d_applications[find->second].d_original;
@@ -2193,7 +2268,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
 size_t EqualityEngine::getSize(TNode t) {
   // Add the term
   addTermInternal(t);
-  return getEqualityNode(getEqualityNode(t).getFind()).getSize();
+  return getEqualityNode(getFind(t)).getSize();
 }
 
 std::string EqualityEngine::identify() const { return d_name; }
@@ -2219,8 +2294,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
   // Get the node id
   EqualityNodeId eqNodeId = getNodeId(t);
-  EqualityNode& eqNode = getEqualityNode(eqNodeId);
-  EqualityNodeId classId = eqNode.getFind();
+  EqualityNodeId classId = getFind(eqNodeId);
 
   // Possibly existing set of triggers
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
@@ -2287,7 +2361,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
 bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
   if (!hasTerm(t)) return false;
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
   return triggerSetRef != +null_set_id && getTriggerTermSet(triggerSetRef).hasTrigger(tag);
 }
@@ -2295,7 +2369,7 @@ bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
 
 TNode EqualityEngine::getTriggerTermRepresentative(TNode t, TheoryId tag) const {
   Assert(isTriggerTerm(t, tag));
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   const TriggerTermSet& triggerSet = getTriggerTermSet(d_nodeIndividualTrigger[classId]);
   unsigned i = 0;
   TheoryIdSet tags = triggerSet.d_tags;
@@ -2331,7 +2405,7 @@ void EqualityEngine::storeApplicationLookup(FunctionApplication& funNormalized,
 void EqualityEngine::getUseListTerms(TNode t, std::set<TNode>& output) {
   if (hasTerm(t)) {
     // Get the equivalence class
-    EqualityNodeId classId = getEqualityNode(t).getFind();
+    EqualityNodeId classId = getFind(t);
     // Go through the equivalence class and get where t is used in
     EqualityNodeId currentId = classId;
     do {
@@ -2444,8 +2518,8 @@ void EqualityEngine::storePropagatedDisequality(TheoryId tag, EqualityNodeId lhs
     for (unsigned i = ref.d_mergesStart; i < ref.d_mergesEnd; ++i)
     {
       Assert(
-          getEqualityNode(d_deducedDisequalityReasons[i].first).getFind()
-          == getEqualityNode(d_deducedDisequalityReasons[i].second).getFind());
+          getFind(d_deducedDisequalityReasons[i].first)
+          == getFind(d_deducedDisequalityReasons[i].second));
     }
 #endif
     if (Debug.isOn("equality::disequality")) {
@@ -2511,7 +2585,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
       const FunctionApplication& fun =
           d_applications[useListNode.getApplicationId()].d_original;
       // If it's an equality asserted to false, we do the work
-      if (fun.isEquality() && getEqualityNode(funId).getFind() == getEqualityNode(d_false).getFind()) {
+      if (fun.isEquality() && getFind(funId) == getFind(d_false)) {
         // Get the other equality member
         bool lhs = false;
         EqualityNodeId toCompare = fun.d_b;
@@ -2520,7 +2594,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
           lhs = true;
         }
         // Representative of the other member
-        EqualityNodeId toCompareRep = getEqualityNode(toCompare).getFind();
+        EqualityNodeId toCompareRep = getFind(toCompare);
         if (toCompareRep == classId) {
           // We're in conflict, so we will send it out from merge
           out.clear();
@@ -2585,7 +2659,7 @@ bool EqualityEngine::propagateTriggerTermDisequalities(
     // Figure out who we are comparing to in the original equality
     EqualityNodeId toCompare = disequalityInfo.d_lhs ? fun.d_a : fun.d_b;
     EqualityNodeId myCompare = disequalityInfo.d_lhs ? fun.d_b : fun.d_a;
-    if (getEqualityNode(toCompare).getFind() == getEqualityNode(myCompare).getFind()) {
+    if (getFind(toCompare) == getFind(myCompare)) {
       // We're propagating a != a, which means we're inconsistent, just bail and let it go into
       // a regular conflict
       return !d_done;
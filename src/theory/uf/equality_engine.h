@@ -171,6 +171,13 @@ private:
   /** Map from ids to the equality nodes */
   std::vector<EqualityNode> d_equalityNodes;
 
+  /**
+   * Map from ids to the ids of their representatives. This is kept apart from
+   * d_equalityNodes so that find lookups, the most frequent access of the
+   * congruence closure, read a contiguous array of ids.
+   */
+  std::vector<EqualityNodeId> d_findIds;
+
   /** Number of asserted equalities we have so far */
   context::CDO<DefaultSizeType> d_assertedEqualitiesCount;
 
@@ -270,14 +277,26 @@ private:
   /** Returns the id of the node */
   EqualityNodeId getNodeId(TNode node) const;
 
+  /** Returns the id of the representative of the node with the given id */
+  EqualityNodeId getFind(EqualityNodeId nodeId) const
+  {
+    Assert(nodeId < d_findIds.size());
+    return d_findIds[nodeId];
+  }
+
+  /** Returns the id of the representative of the given node */
+  EqualityNodeId getFind(TNode node) const { return getFind(getNodeId(node)); }
+
   /**
    * Merge the class2 into class1
    * @return true if ok, false if to break out
    */
-  bool merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggers);
+  bool merge(EqualityNodeId class1Id,
+             EqualityNodeId class2Id,
+             std::vector<TriggerId>& triggers);
 
   /** Undo the merge of class2 into class1 */
-  void undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id);
+  void undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id);
 
   /** Backtrack the information if necessary */
   void backtrack();
@@ -363,7 +382,7 @@ private:
    * Returns true if it's a constant
    */
   bool isConstant(EqualityNodeId id) const {
-    return d_isConstant[getEqualityNode(id).getFind()];
+    return d_isConstant[getFind(id)];
   }
 
   /**
@@ -431,7 +450,9 @@ private:
    * children such that it is a proof of t1 = t2.
    *
    * We cache results of this call in cache, where cache[t1Id][t2Id] stores
-   * a proof of t1 = t2.
+   * a proof of t1 = t2. If eqp is null, the explanation is moreover memoized
+   * in d_explanationCache, so that later calls, and the explanations of
+   * congruences that need t1 = t2, do not search the equality graph again.
    */
   void getExplanation(
       EqualityEdgeId t1Id,
@@ -440,6 +461,38 @@ private:
       std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
       EqProof* eqp) const;
 
+  /**
+   * Compute the explanation of t1 = t2 by searching the path from t1 to t2 in
+   * the equality graph. This is the uncached part of getExplanation, which
+   * takes the same arguments.
+   */
+  void computeExplanation(
+      EqualityEdgeId t1Id,
+      EqualityNodeId t2Id,
+      std::vector<TNode>& equalities,
+      std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
+      EqProof* eqp) const;
+
+  /**
+   * Memoized explanations of the equalities between the (ordered) pairs of
+   * ids, computed when proofs are not being constructed. An explanation only
+   * depends on the edges of the equality graph that existed when it was
+   * computed, hence it stays valid until we backtrack below that point.
+   */
+  mutable std::unordered_map<EqualityPair,
+                             std::vector<TNode>,
+                             EqualityPairHashFunction>
+      d_explanationCache;
+
+  /**
+   * The keys of d_explanationCache in the order they were added, with the
+   * number of asserted equalities at that time. Since this number never
+   * decreases between two backtracks, backtrack() removes the explanations
+   * that became invalid from the back of this list.
+   */
+  mutable std::vector<std::pair<EqualityPair, DefaultSizeType>>
+      d_explanationCacheTrail;
+
   /**
    * Print the equality graph.
    */
@@ -756,6 +809,15 @@ private:
                        std::vector<TNode>& assertions,
                        EqProof* eqp = nullptr) const;
 
+  /**
+   * Get an explanation of all the equalities t1 = t2 for the pairs (t1, t2) in
+   * eqs, which must hold. Returns the reasons that imply them in the
+   * assertions vector. The sub-explanations shared by several of the
+   * equalities are only added once.
+   */
+  void explainEqualities(const std::vector<std::pair<TNode, TNode>>& eqs,
+                         std::vector<TNode>& assertions) const;
+
   /**
    * Get an explanation of the predicate being true or false.
    * Returns the reasons (added when asserting) that imply imply it
@@ -29,7 +29,7 @@ EqClassesIterator::EqClassesIterator(const eq::EqualityEngine* ee) : d_ee(ee)
   // Go to the first non-internal node that is it's own representative
   if (d_it < d_ee->d_nodesCount
       && (d_ee->d_isInternal[d_it]
-          || d_ee->getEqualityNode(d_it).getFind() != d_it))
+          || d_ee->getFind(d_it) != d_it))
   {
     ++d_it;
   }
@@ -52,7 +52,7 @@ EqClassesIterator& EqClassesIterator::operator++()
   ++d_it;
   while (d_it < d_ee->d_nodesCount
          && (d_ee->d_isInternal[d_it]
-             || d_ee->getEqualityNode(d_it).getFind() != d_it))
+             || d_ee->getFind(d_it) != d_it))
   {
     ++d_it;
   }
@@ -81,7 +81,7 @@ EqClassIterator::EqClassIterator(Node eqc, const eq::EqualityEngine* ee)
 {
   Assert(d_ee->consistent());
   d_current = d_start = d_ee->getNodeId(eqc);
-  Assert(d_start == d_ee->getEqualityNode(d_start).getFind());
+  Assert(d_start == d_ee->getFind(d_start));
   Assert(!d_ee->d_isInternal[d_start]);
 }
 
@@ -101,7 +101,7 @@ EqClassIterator& EqClassIterator::operator++()
 {
   Assert(!isFinished());
 
-  Assert(d_start == d_ee->getEqualityNode(d_current).getFind());
+  Assert(d_start == d_ee->getFind(d_current));
   Assert(!d_ee->d_isInternal[d_current]);
 
   // Find the next one
@@ -110,7 +110,7 @@ EqClassIterator& EqClassIterator::operator++()
     d_current = d_ee->getEqualityNode(d_current).getNext();
   } while (d_ee->d_isInternal[d_current]);
 
-  Assert(d_start == d_ee->getEqualityNode(d_current).getFind());
+  Assert(d_start == d_ee->getFind(d_current));
   Assert(!d_ee->d_isInternal[d_current]);
 
   if (d_current == d_start)
@@ -171,7 +171,8 @@ public:
  * size. Each individual node carries with itself the uselist of
  * function applications it appears in and the list of asserted
  * disequalities it belongs to. In order to get these lists one must
- * traverse the entire class and pick up all the individual lists.
+ * traverse the entire class and pick up all the individual lists. The
+ * representatives of the nodes are stored separately by the equality engine.
  */
 class EqualityNode {
 
@@ -180,9 +181,6 @@ private:
   /** The size of this equivalence class (if it's a representative) */
   DefaultSizeType d_size;
 
-  /** The id (in the eq-manager) of the representative equality node */
-  EqualityNodeId d_findId;
-
   /** The next equality node in this class */
   EqualityNodeId d_nextId;
 
@@ -196,7 +194,6 @@ public:
    */
   EqualityNode(EqualityNodeId nodeId = null_id)
   : d_size(1)
-  , d_findId(nodeId)
   , d_nextId(nodeId)
   , d_useList(null_uselist_id)
   {}
@@ -236,16 +233,6 @@ public:
     }
   }
 
-  /**
-   * Returns the class representative.
-   */
-  EqualityNodeId getFind() const { return d_findId; }
-
-  /**
-   * Set the class representative.
-   */
-  void setFind(EqualityNodeId findId) { d_findId = findId; }
-
   /**
    * Note that this node is used in a function application funId, or
    * a negatively asserted equality (dis-equality) with funId.
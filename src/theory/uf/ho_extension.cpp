@@ -31,7 +31,9 @@ HoExtension::HoExtension(TheoryState& state, TheoryInferenceManager& im)
     : d_state(state),
       d_im(im),
       d_extensionality(state.getUserContext()),
-      d_uf_std_skolem(state.getUserContext())
+      d_uf_std_skolem(state.getUserContext()),
+      d_ho_apply(state.getUserContext()),
+      d_app_completed(state.getSatContext())
 {
   d_true = NodeManager::currentNM()->mkConst(true);
 }
@@ -275,10 +277,17 @@ unsigned HoExtension::checkExtensionality(TheoryModel* m)
 unsigned HoExtension::applyAppCompletion(TNode n)
 {
   Assert(n.getKind() == APPLY_UF);
+  if (d_app_completed.find(n) != d_app_completed.end())
+  {
+    return 0;
+  }
 
   eq::EqualityEngine* ee = d_state.getEqualityEngine();
   // must expand into APPLY_HO version if not there already
-  Node ret = TheoryUfRewriter::getHoApplyForApplyUf(n);
+  Node ret = getHoApplyForApplyUf(n);
+  // the equality below is asserted to the equality engine, hence n is
+  // completed in this SAT context in either case
+  d_app_completed.insert(n);
   if (!ee->hasTerm(ret) || !ee->areEqual(ret, n))
   {
     Node eq = n.eqNode(ret);
@@ -384,6 +393,18 @@ unsigned HoExtension::checkAppCompletion()
   return 0;
 }
 
+Node HoExtension::getHoApplyForApplyUf(TNode n)
+{
+  NodeNodeMap::const_iterator it = d_ho_apply.find(n);
+  if (it != d_ho_apply.end())
+  {
+    return (*it).second;
+  }
+  Node ret = TheoryUfRewriter::getHoApplyForApplyUf(n);
+  d_ho_apply[n] = ret;
+  return ret;
+}
+
 unsigned HoExtension::check()
 {
   Trace("uf-ho") << "HoExtension::checkHigherOrder..." << std::endl;
@@ -440,7 +461,7 @@ bool HoExtension::collectModelInfoHoTerm(Node n, TheoryModel* m)
 {
   if (n.getKind() == APPLY_UF)
   {
-    Node hn = TheoryUfRewriter::getHoApplyForApplyUf(n);
+    Node hn = getHoApplyForApplyUf(n);
     if (!m->assertEquality(n, hn, true))
     {
       Node eq = n.eqNode(hn);
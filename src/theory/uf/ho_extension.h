@@ -171,6 +171,12 @@ class HoExtension
    * pair of terms in the equality engine.
    */
   unsigned checkAppCompletion();
+  /**
+   * Get the HO_APPLY equivalent of APPLY_UF term n, which is cached since
+   * the APPLY_UF terms of the equality engine are revisited on every
+   * call to checkAppCompletion.
+   */
+  Node getHoApplyForApplyUf(TNode n);
   /** collect model info for higher-order term
    *
    * This adds required constraints to m for term n. In particular, if n is
@@ -194,6 +200,13 @@ class HoExtension
 
   /** map from non-standard operators to their skolems */
   NodeNodeMap d_uf_std_skolem;
+  /** cache of getHoApplyForApplyUf */
+  NodeNodeMap d_ho_apply;
+  /**
+   * The APPLY_UF terms that are equal to their HO_APPLY equivalent in the
+   * current SAT context, which app completion need not consider again.
+   */
+  NodeSet d_app_completed;
 }; /* class TheoryUF */
 
 }  // namespace uf
@@ -208,13 +208,15 @@ bool Valuation::needCheck() const{
 
 bool Valuation::isRelevant(Node lit) const { return d_engine->isRelevant(lit); }
 
-context::CDList<Assertion>::const_iterator Valuation::factsBegin(TheoryId tid)
+context::CDChunkList<Assertion>::const_iterator Valuation::factsBegin(
+    TheoryId tid)
 {
   Theory* theory = d_engine->theoryOf(tid);
   Assert(theory != nullptr);
   return theory->facts_begin();
 }
-context::CDList<Assertion>::const_iterator Valuation::factsEnd(TheoryId tid)
+context::CDChunkList<Assertion>::const_iterator Valuation::factsEnd(
+    TheoryId tid)
 {
   Theory* theory = d_engine->theoryOf(tid);
   Assert(theory != nullptr);
@@ -21,7 +21,7 @@
 #ifndef CVC4__THEORY__VALUATION_H
 #define CVC4__THEORY__VALUATION_H
 
-#include "context/cdlist.h"
+#include "context/cdchunk_list.h"
 #include "expr/node.h"
 #include "options/theory_options.h"
 
@@ -211,9 +211,9 @@ public:
    * assertions from other theories.
    */
   /** The beginning iterator of facts for theory tid.*/
-  context::CDList<Assertion>::const_iterator factsBegin(TheoryId tid);
+  context::CDChunkList<Assertion>::const_iterator factsBegin(TheoryId tid);
   /** The beginning iterator of facts for theory tid.*/
-  context::CDList<Assertion>::const_iterator factsEnd(TheoryId tid);
+  context::CDChunkList<Assertion>::const_iterator factsEnd(TheoryId tid);
 };/* class Valuation */
 
 }  // namespace theory
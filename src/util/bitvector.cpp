@@ -18,28 +18,94 @@
 
 #include "util/bitvector.h"
 
+#include "base/check.h"
 #include "base/exception.h"
 
 namespace cvc5 {
 
+BitVector::BitVector(unsigned size, const BitVector& q)
+    : d_size(size), d_small(0)
+{
+  if (isSmall() && q.isSmall())
+  {
+    d_small = q.d_small & mask(size);
+  }
+  else
+  {
+    setValue(q.getValue().modByPow2(size));
+  }
+}
+
+void BitVector::setValue(Integer val)
+{
+  if (isSmall())
+  {
+    d_small = val.extractBitRange(32, 32).toUnsignedInt();
+    d_small = (d_small << 32) | val.extractBitRange(32, 0).toUnsignedInt();
+    d_value.reset();
+  }
+  else
+  {
+    d_value.reset(new Integer(std::move(val)));
+  }
+}
+
+int64_t BitVector::toSignedSmall() const
+{
+  Assert(isSmall());
+  if (d_size > 0 && d_size < 64 && (d_small >> (d_size - 1)))
+  {
+    return static_cast<int64_t>(d_small | ~mask(d_size));
+  }
+  return static_cast<int64_t>(d_small);
+}
+
 unsigned BitVector::getSize() const { return d_size; }
 
-const Integer& BitVector::getValue() const { return d_value; }
+const Integer& BitVector::getValue() const
+{
+  if (!d_value)
+  {
+    Assert(isSmall());
+    d_value.reset(new Integer(d_small));
+  }
+  return *d_value;
+}
 
-Integer BitVector::toInteger() const { return d_value; }
+Integer BitVector::toInteger() const { return getValue(); }
 
 Integer BitVector::toSignedInteger() const
 {
+  if (isSmall())
+  {
+    if (toSignedSmall() >= 0)
+    {
+      return getValue();
+    }
+    return getValue() - Integer(1).multiplyByPow2(d_size);
+  }
   unsigned size = d_size;
-  Integer sign_bit = d_value.extractBitRange(1, size - 1);
-  Integer val = d_value.extractBitRange(size - 1, 0);
+  Integer sign_bit = d_value->extractBitRange(1, size - 1);
+  Integer val = d_value->extractBitRange(size - 1, 0);
   Integer res = Integer(-1) * sign_bit.multiplyByPow2(size - 1) + val;
   return res;
 }
 
 std::string BitVector::toString(unsigned int base) const
 {
-  std::string str = d_value.toString(base);
+  if (base == 2 && isSmall())
+  {
+    std::string str(d_size, '0');
+    for (unsigned i = 0; i < d_size; ++i)
+    {
+      if ((d_small >> i) & 1)
+      {
+        str[d_size - 1 - i] = '1';
+      }
+    }
+    return str;
+  }
+  std::string str = getValue().toString(base);
   if (base == 2 && d_size > str.size())
   {
     std::string zeroes;
@@ -57,25 +123,53 @@ std::string BitVector::toString(unsigned int base) const
 
 size_t BitVector::hash() const
 {
-  return d_value.hash() + d_size;
+  if (isSmall())
+  {
+    return std::hash<uint64_t>()(d_small) + d_size;
+  }
+  return d_value->hash() + d_size;
 }
 
 BitVector& BitVector::setBit(uint32_t i, bool value)
 {
   CheckArgument(i < d_size, i);
-  d_value.setBit(i, value);
+  if (isSmall())
+  {
+    uint64_t bit = static_cast<uint64_t>(1) << i;
+    d_small = value ? (d_small | bit) : (d_small & ~bit);
+    d_value.reset();
+    return *this;
+  }
+  d_value->setBit(i, value);
   return *this;
 }
 
 bool BitVector::isBitSet(uint32_t i) const
 {
   CheckArgument(i < d_size, i);
-  return d_value.isBitSet(i);
+  if (isSmall())
+  {
+    return (d_small >> i) & 1;
+  }
+  return d_value->isBitSet(i);
 }
 
 unsigned BitVector::isPow2() const
 {
-  return d_value.isPow2();
+  if (isSmall())
+  {
+    if (d_small == 0 || (d_small & (d_small - 1)) != 0)
+    {
+      return 0;
+    }
+    unsigned k = 1;
+    for (uint64_t v = d_small; v > 1; v >>= 1)
+    {
+      ++k;
+    }
+    return k;
+  }
+  return d_value->isPow2();
 }
 
 /* -----------------------------------------------------------------------
@@ -86,16 +180,26 @@ unsigned BitVector::isPow2() const
 
 BitVector BitVector::concat(const BitVector& other) const
 {
-  return BitVector(d_size + other.d_size,
-                   (d_value.multiplyByPow2(other.d_size)) + other.d_value);
+  unsigned size = d_size + other.d_size;
+  if (size <= s_maxSmallSize)
+  {
+    uint64_t high = other.d_size >= 64 ? 0 : d_small << other.d_size;
+    return BitVector(size, high | other.d_small);
+  }
+  return BitVector(
+      size, (getValue().multiplyByPow2(other.d_size)) + other.getValue());
 }
 
 BitVector BitVector::extract(unsigned high, unsigned low) const
 {
   CheckArgument(high < d_size, high);
   CheckArgument(low <= high, low);
+  if (isSmall())
+  {
+    return BitVector(high - low + 1, d_small >> low);
+  }
   return BitVector(high - low + 1,
-                   d_value.extractBitRange(high - low + 1, low));
+                   d_value->extractBitRange(high - low + 1, low));
 }
 
 /* (Dis)Equality --------------------------------------------------------- */
@@ -103,51 +207,59 @@ BitVector BitVector::extract(unsigned high, unsigned low) const
 bool BitVector::operator==(const BitVector& y) const
 {
   if (d_size != y.d_size) return false;
-  return d_value == y.d_value;
+  if (isSmall()) return d_small == y.d_small;
+  return *d_value == *y.d_value;
 }
 
 bool BitVector::operator!=(const BitVector& y) const
 {
   if (d_size != y.d_size) return true;
-  return d_value != y.d_value;
+  if (isSmall()) return d_small != y.d_small;
+  return *d_value != *y.d_value;
 }
 
 /* Unsigned Inequality --------------------------------------------------- */
 
 bool BitVector::operator<(const BitVector& y) const
 {
-  return d_value < y.d_value;
+  if (isSmall() && y.isSmall()) return d_small < y.d_small;
+  return getValue() < y.getValue();
 }
 
 bool BitVector::operator<=(const BitVector& y) const
 {
-  return d_value <= y.d_value;
+  if (isSmall() && y.isSmall()) return d_small <= y.d_small;
+  return getValue() <= y.getValue();
 }
 
 bool BitVector::operator>(const BitVector& y) const
 {
-  return d_value > y.d_value;
+  if (isSmall() && y.isSmall()) return d_small > y.d_small;
+  return getValue() > y.getValue();
 }
 
 bool BitVector::operator>=(const BitVector& y) const
 {
-  return d_value >= y.d_value;
+  if (isSmall() && y.isSmall()) return d_small >= y.d_small;
+  return getValue() >= y.getValue();
 }
 
 bool BitVector::unsignedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value < y.d_value;
+  if (isSmall()) return d_small < y.d_small;
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value >= 0, y);
+  return *d_value < *y.d_value;
 }
 
 bool BitVector::unsignedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, this);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value <= y.d_value;
+  if (isSmall()) return d_small <= y.d_small;
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value >= 0, y);
+  return *d_value <= *y.d_value;
 }
 
 /* Signed Inequality ----------------------------------------------------- */
@@ -155,8 +267,9 @@ bool BitVector::unsignedLessThanEq(const BitVector& y) const
 bool BitVector::signedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isSmall()) return toSignedSmall() < y.toSignedSmall();
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value >= 0, y);
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -166,8 +279,9 @@ bool BitVector::signedLessThan(const BitVector& y) const
 bool BitVector::signedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isSmall()) return toSignedSmall() <= y.toSignedSmall();
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value >= 0, y);
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -179,24 +293,28 @@ bool BitVector::signedLessThanEq(const BitVector& y) const
 BitVector BitVector::operator^(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseXor(y.d_value));
+  if (isSmall()) return BitVector(d_size, d_small ^ y.d_small);
+  return BitVector(d_size, d_value->bitwiseXor(*y.d_value));
 }
 
 BitVector BitVector::operator|(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseOr(y.d_value));
+  if (isSmall()) return BitVector(d_size, d_small | y.d_small);
+  return BitVector(d_size, d_value->bitwiseOr(*y.d_value));
 }
 
 BitVector BitVector::operator&(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseAnd(y.d_value));
+  if (isSmall()) return BitVector(d_size, d_small & y.d_small);
+  return BitVector(d_size, d_value->bitwiseAnd(*y.d_value));
 }
 
 BitVector BitVector::operator~() const
 {
-  return BitVector(d_size, d_value.bitwiseNot());
+  if (isSmall()) return BitVector(d_size, ~d_small);
+  return BitVector(d_size, d_value->bitwiseNot());
 }
 
 /* Arithmetic operations ------------------------------------------------- */
@@ -204,13 +322,15 @@ BitVector BitVector::operator~() const
 BitVector BitVector::operator+(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  Integer sum = d_value + y.d_value;
+  if (isSmall()) return BitVector(d_size, d_small + y.d_small);
+  Integer sum = *d_value + *y.d_value;
   return BitVector(d_size, sum);
 }
 
 BitVector BitVector::operator-(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isSmall()) return BitVector(d_size, d_small - y.d_small);
   // to maintain the invariant that we are only adding BitVectors of the
   // same size
   BitVector one(d_size, Integer(1));
@@ -219,6 +339,7 @@ BitVector BitVector::operator-(const BitVector& y) const
 
 BitVector BitVector::operator-() const
 {
+  if (isSmall()) return BitVector(d_size, ~d_small + 1);
   BitVector one(d_size, Integer(1));
   return ~(*this) + one;
 }
@@ -226,50 +347,67 @@ BitVector BitVector::operator-() const
 BitVector BitVector::operator*(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  Integer prod = d_value * y.d_value;
+  if (isSmall()) return BitVector(d_size, d_small * y.d_small);
+  Integer prod = *d_value * *y.d_value;
   return BitVector(d_size, prod);
 }
 
 BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isSmall())
+  {
+    /* d_small / 0 = -1 = 2^d_size - 1 */
+    return BitVector(d_size,
+                     y.d_small == 0 ? mask(d_size) : d_small / y.d_small);
+  }
   /* d_value / 0 = -1 = 2^d_size - 1 */
-  if (y.d_value == 0)
+  if (*y.d_value == 0)
   {
     return BitVector(d_size, Integer(1).oneExtend(1, d_size - 1));
   }
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value > 0, y);
-  return BitVector(d_size, d_value.floorDivideQuotient(y.d_value));
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value > 0, y);
+  return BitVector(d_size, d_value->floorDivideQuotient(*y.d_value));
 }
 
 BitVector BitVector::unsignedRemTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  if (y.d_value == 0)
+  if (isSmall())
+  {
+    return BitVector(d_size, y.d_small == 0 ? d_small : d_small % y.d_small);
+  }
+  if (*y.d_value == 0)
   {
-    return BitVector(d_size, d_value);
+    return BitVector(d_size, *d_value);
   }
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value > 0, y);
-  return BitVector(d_size, d_value.floorDivideRemainder(y.d_value));
+  CheckArgument(*d_value >= 0, this);
+  CheckArgument(*y.d_value > 0, y);
+  return BitVector(d_size, d_value->floorDivideRemainder(*y.d_value));
 }
 
 /* Extend operations ----------------------------------------------------- */
 
 BitVector BitVector::zeroExtend(unsigned n) const
 {
-  return BitVector(d_size + n, d_value);
+  if (d_size + n <= s_maxSmallSize) return BitVector(d_size + n, d_small);
+  return BitVector(d_size + n, getValue());
 }
 
 BitVector BitVector::signExtend(unsigned n) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
+  if (d_size + n <= s_maxSmallSize)
+  {
+    return BitVector(d_size + n, static_cast<uint64_t>(toSignedSmall()));
+  }
+  const Integer& value = getValue();
+  Integer sign_bit = value.extractBitRange(1, d_size - 1);
   if (sign_bit == Integer(0))
   {
-    return BitVector(d_size + n, d_value);
+    return BitVector(d_size + n, value);
   }
-  Integer val = d_value.oneExtend(d_size, n);
+  Integer val = value.oneExtend(d_size, n);
   return BitVector(d_size + n, val);
 }
 
@@ -277,38 +415,58 @@ BitVector BitVector::signExtend(unsigned n) const
 
 BitVector BitVector::leftShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isSmall() && y.isSmall())
+  {
+    return BitVector(d_size, y.d_small >= d_size ? 0 : d_small << y.d_small);
+  }
+  const Integer& amount_value = y.getValue();
+  if (amount_value > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
-  if (y.d_value == 0)
+  if (amount_value == 0)
   {
     return *this;
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.multiplyByPow2(amount);
+  CheckArgument(amount_value < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = amount_value.toUnsignedInt();
+  Integer res = getValue().multiplyByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::logicalRightShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isSmall() && y.isSmall())
+  {
+    return BitVector(d_size, y.d_small >= d_size ? 0 : d_small >> y.d_small);
+  }
+  const Integer& amount_value = y.getValue();
+  if (amount_value > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.divByPow2(amount);
+  CheckArgument(amount_value < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = amount_value.toUnsignedInt();
+  Integer res = getValue().divByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::arithRightShift(const BitVector& y) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
-  if (y.d_value > Integer(d_size))
+  if (isSmall() && y.isSmall())
+  {
+    int64_t val = toSignedSmall();
+    uint64_t amount = y.d_small >= d_size ? d_size - 1 : y.d_small;
+    /* the shift of a signed value is arithmetic */
+    return BitVector(d_size,
+                     static_cast<uint64_t>(d_size == 0 ? 0 : val >> amount));
+  }
+  const Integer& value = getValue();
+  const Integer& amount_value = y.getValue();
+  Integer sign_bit = value.extractBitRange(1, d_size - 1);
+  if (amount_value > Integer(d_size))
   {
     if (sign_bit == Integer(0))
     {
@@ -320,16 +478,16 @@ BitVector BitVector::arithRightShift(const BitVector& y) const
     }
   }
 
-  if (y.d_value == 0)
+  if (amount_value == 0)
   {
     return *this;
   }
 
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
+  CheckArgument(amount_value < Integer(1).multiplyByPow2(32), y);
 
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer rest = d_value.divByPow2(amount);
+  uint32_t amount = amount_value.toUnsignedInt();
+  Integer rest = value.divByPow2(amount);
 
   if (sign_bit == Integer(0))
   {
@@ -358,6 +516,7 @@ BitVector BitVector::mkOne(unsigned size)
 BitVector BitVector::mkOnes(unsigned size)
 {
   CheckArgument(size > 0, size);
+  if (size <= s_maxSmallSize) return BitVector(size, mask(size));
   return BitVector(1, Integer(1)).signExtend(size - 1);
 }
 
@@ -11,7 +11,8 @@
  **
  ** \brief A fixed-size bit-vector.
  **
- ** A fixed-size bit-vector, implemented as a wrapper around Integer.
+ ** A fixed-size bit-vector, implemented as a machine word for sizes up to 64
+ ** and as a wrapper around Integer otherwise.
  **/
 
 #include "cvc4_public.h"
@@ -19,8 +20,10 @@
 #ifndef CVC4__BITVECTOR_H
 #define CVC4__BITVECTOR_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <iostream>
+#include <memory>
 
 #include "base/exception.h"
 #include "util/integer.h"
@@ -30,12 +33,18 @@ namespace cvc5 {
 class BitVector
 {
  public:
-  BitVector(unsigned size, const Integer& val)
-      : d_size(size), d_value(val.modByPow2(size))
+  BitVector(unsigned size, const Integer& val) : d_size(size), d_small(0)
   {
+    setValue(val.modByPow2(size));
   }
 
-  BitVector(unsigned size = 0) : d_size(size), d_value(0) {}
+  BitVector(unsigned size = 0) : d_size(size), d_small(0)
+  {
+    if (!isSmall())
+    {
+      d_value.reset(new Integer(0));
+    }
+  }
 
   /**
    * BitVector constructor using a 32-bit unsigned integer for the value.
@@ -44,9 +53,9 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint32_t z) : d_size(size), d_value(z)
+  BitVector(unsigned size, uint32_t z)
+      : BitVector(size, static_cast<uint64_t>(z))
   {
-    d_value = d_value.modByPow2(size);
   }
 
   /**
@@ -56,15 +65,15 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint64_t z) : d_size(size), d_value(z)
+  BitVector(unsigned size, uint64_t z) : d_size(size), d_small(z & mask(size))
   {
-    d_value = d_value.modByPow2(size);
+    if (!isSmall())
+    {
+      d_value.reset(new Integer(z));
+    }
   }
 
-  BitVector(unsigned size, const BitVector& q)
-      : d_size(size), d_value(q.d_value)
-  {
-  }
+  BitVector(unsigned size, const BitVector& q);
 
   /**
    * BitVector constructor.
@@ -79,16 +88,33 @@ class BitVector
    * @param num The value of the bit-vector in string representation.
    * @param base The base of the string representation.
    */
-  BitVector(const std::string& num, unsigned base = 2)
+  BitVector(const std::string& num, unsigned base = 2) : d_small(0)
   {
     CheckArgument(base == 2 || base == 10 || base == 16, base);
-    d_value = Integer(num, base);
+    Integer val(num, base);
     switch (base)
     {
-      case 10: d_size = d_value.length(); break;
+      case 10: d_size = val.length(); break;
       case 16: d_size = num.size() * 4; break;
       default: d_size = num.size();
     }
+    setValue(val);
+  }
+
+  BitVector(const BitVector& x) : d_size(x.d_size), d_small(x.d_small)
+  {
+    if (!isSmall())
+    {
+      d_value.reset(new Integer(*x.d_value));
+    }
+  }
+
+  /** The moved-from bit-vector x is left as the bit-vector of size 0. */
+  BitVector(BitVector&& x)
+      : d_size(x.d_size), d_small(x.d_small), d_value(std::move(x.d_value))
+  {
+    x.d_size = 0;
+    x.d_small = 0;
   }
 
   ~BitVector() {}
@@ -97,7 +123,27 @@ class BitVector
   {
     if (this == &x) return *this;
     d_size = x.d_size;
-    d_value = x.d_value;
+    d_small = x.d_small;
+    if (isSmall())
+    {
+      d_value.reset();
+    }
+    else
+    {
+      d_value.reset(new Integer(*x.d_value));
+    }
+    return *this;
+  }
+
+  /** The moved-from bit-vector x is left as the bit-vector of size 0. */
+  BitVector& operator=(BitVector&& x)
+  {
+    if (this == &x) return *this;
+    d_size = x.d_size;
+    d_small = x.d_small;
+    d_value = std::move(x.d_value);
+    x.d_size = 0;
+    x.d_small = 0;
     return *this;
   }
 
@@ -268,10 +314,34 @@ class BitVector
    * Class invariants:
    *  - no overflows: 2^d_size < d_value
    *  - no negative numbers: d_value >= 0
+   *
+   * The value of a bit-vector of size at most s_maxSmallSize is stored in a
+   * machine word, d_small, on which the operations are done without GMP. Its
+   * Integer value is only computed when getValue() asks for it, and is cached
+   * in d_value. The value of a larger bit-vector is always in d_value.
    */
 
+  /** The largest size of the bit-vectors stored in a machine word */
+  static constexpr unsigned s_maxSmallSize = 64;
+
+  /** Return true if the value of this is stored in d_small. */
+  bool isSmall() const { return d_size <= s_maxSmallSize; }
+  /** Return the mask of the lower 'size' bits of a machine word. */
+  static uint64_t mask(unsigned size)
+  {
+    return size >= 64 ? ~static_cast<uint64_t>(0)
+                      : (static_cast<uint64_t>(1) << size) - 1;
+  }
+  /** Return the two's complement interpretation of d_small. */
+  int64_t toSignedSmall() const;
+  /** Set the value of this to 'val', which must fit into d_size bits. */
+  void setValue(Integer val);
+
   unsigned d_size;
-  Integer d_value;
+  /** The value, if isSmall() */
+  uint64_t d_small;
+  /** The value, if !isSmall(), or the cached value otherwise */
+  mutable std::unique_ptr<Integer> d_value;
 
 }; /* class BitVector */
 
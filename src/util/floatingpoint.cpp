@@ -20,6 +20,10 @@
 
 #include <math.h>
 
+#include <cfenv>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 #include <limits>
 
 #include "base/check.h"
@@ -32,6 +36,125 @@ namespace cvc5 {
 
 /* -------------------------------------------------------------------------- */
 
+namespace {
+
+/** The operations that are evaluated natively when possible */
+enum class NativeOp
+{
+  PLUS,
+  SUB,
+  MULT,
+  DIV,
+  FMA,
+  SQRT,
+  REM
+};
+
+/** Convert the literal fpl, whose format is that of T, to a native value */
+template <typename T, typename Bits>
+T toNative(const FloatingPointLiteral& fpl)
+{
+  // unsigned long may have only 32 bits, hence the bits are extracted in
+  // two halves
+  const Integer& val = fpl.pack().getValue();
+  uint64_t high = val.extractBitRange(32, 32).toUnsignedInt();
+  uint64_t low = val.extractBitRange(32, 0).toUnsignedInt();
+  Bits bits = static_cast<Bits>((high << 32) | low);
+  T res;
+  std::memcpy(&res, &bits, sizeof(T));
+  return res;
+}
+
+/** Convert the native value val to a literal of the given size */
+template <typename T, typename Bits>
+FloatingPointLiteral* fromNative(const FloatingPointSize& size, T val)
+{
+  if (std::isnan(val))
+  {
+    // there is only one NaN in SMT-LIB, the payload is ignored
+    return new FloatingPointLiteral(size, FloatingPointLiteral::FPNAN);
+  }
+  Bits bits;
+  std::memcpy(&bits, &val, sizeof(T));
+  return new FloatingPointLiteral(
+      size, BitVector(size.packedWidth(), static_cast<uint64_t>(bits)));
+}
+
+/** Evaluate op natively on values in the format of T, see evaluateNative */
+template <typename T, typename Bits>
+FloatingPointLiteral* evaluateNativeIn(NativeOp op,
+                                       const RoundingMode& rm,
+                                       const FloatingPointLiteral& a,
+                                       const FloatingPointLiteral* b,
+                                       const FloatingPointLiteral* c)
+{
+  // The operands and the result are volatile so that the operation is not
+  // moved across the changes of rounding mode, nor folded by the compiler
+  // with its default rounding mode.
+  volatile T x = toNative<T, Bits>(a);
+  volatile T y = b == nullptr ? T(0) : toNative<T, Bits>(*b);
+  volatile T z = c == nullptr ? T(0) : toNative<T, Bits>(*c);
+  volatile T r;
+  int oldRm = std::fegetround();
+  bool setRm = oldRm != static_cast<int>(rm);
+  if (setRm && std::fesetround(static_cast<int>(rm)) != 0)
+  {
+    return nullptr;
+  }
+  switch (op)
+  {
+    case NativeOp::PLUS: r = x + y; break;
+    case NativeOp::SUB: r = x - y; break;
+    case NativeOp::MULT: r = x * y; break;
+    case NativeOp::DIV: r = x / y; break;
+    case NativeOp::FMA: r = std::fma(T(x), T(y), T(z)); break;
+    case NativeOp::SQRT: r = std::sqrt(T(x)); break;
+    case NativeOp::REM: r = std::remainder(T(x), T(y)); break;
+  }
+  if (setRm)
+  {
+    std::fesetround(oldRm);
+  }
+  return fromNative<T, Bits>(a.getSize(), r);
+}
+
+/**
+ * Evaluate op on a, b and c (the arguments that op does not take are null)
+ * with rounding mode rm using the native float or double operations, which
+ * are the IEEE-754 binary32 and binary64 operations. Returns null if the
+ * format or the rounding mode are not supported natively, in which case the
+ * operation is evaluated by symfpu.
+ */
+FloatingPointLiteral* evaluateNative(NativeOp op,
+                                     const RoundingMode& rm,
+                                     const FloatingPointLiteral& a,
+                                     const FloatingPointLiteral* b = nullptr,
+                                     const FloatingPointLiteral* c = nullptr)
+{
+  // The native operations must be evaluated in the precision of their type,
+  // and ties-to-away has no native rounding mode.
+#if FLT_EVAL_METHOD == 0
+  if (rm == ROUND_NEAREST_TIES_TO_AWAY
+      || !std::numeric_limits<float>::is_iec559
+      || !std::numeric_limits<double>::is_iec559)
+  {
+    return nullptr;
+  }
+  const FloatingPointSize& size = a.getSize();
+  if (size.exponentWidth() == 8 && size.significandWidth() == 24)
+  {
+    return evaluateNativeIn<float, uint32_t>(op, rm, a, b, c);
+  }
+  if (size.exponentWidth() == 11 && size.significandWidth() == 53)
+  {
+    return evaluateNativeIn<double, uint64_t>(op, rm, a, b, c);
+  }
+#endif
+  return nullptr;
+}
+
+}  // namespace
+
 uint32_t FloatingPoint::getUnpackedExponentWidth(FloatingPointSize& size)
 {
   return FloatingPointLiteral::getUnpackedExponentWidth(size);
@@ -267,18 +390,36 @@ FloatingPoint FloatingPoint::negate(void) const
 FloatingPoint FloatingPoint::plus(const RoundingMode& rm,
                                   const FloatingPoint& arg) const
 {
+  FloatingPointLiteral* res =
+      evaluateNative(NativeOp::PLUS, rm, *d_fpl, arg.d_fpl.get());
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(new FloatingPointLiteral(d_fpl->add(rm, *arg.d_fpl)));
 }
 
 FloatingPoint FloatingPoint::sub(const RoundingMode& rm,
                                  const FloatingPoint& arg) const
 {
+  FloatingPointLiteral* res =
+      evaluateNative(NativeOp::SUB, rm, *d_fpl, arg.d_fpl.get());
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(new FloatingPointLiteral(d_fpl->sub(rm, *arg.d_fpl)));
 }
 
 FloatingPoint FloatingPoint::mult(const RoundingMode& rm,
                                   const FloatingPoint& arg) const
 {
+  FloatingPointLiteral* res =
+      evaluateNative(NativeOp::MULT, rm, *d_fpl, arg.d_fpl.get());
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(new FloatingPointLiteral(d_fpl->mult(rm, *arg.d_fpl)));
 }
 
@@ -286,6 +427,12 @@ FloatingPoint FloatingPoint::fma(const RoundingMode& rm,
                                  const FloatingPoint& arg1,
                                  const FloatingPoint& arg2) const
 {
+  FloatingPointLiteral* res = evaluateNative(
+      NativeOp::FMA, rm, *d_fpl, arg1.d_fpl.get(), arg2.d_fpl.get());
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(
       new FloatingPointLiteral(d_fpl->fma(rm, *arg1.d_fpl, *arg2.d_fpl)));
 }
@@ -293,11 +440,22 @@ FloatingPoint FloatingPoint::fma(const RoundingMode& rm,
 FloatingPoint FloatingPoint::div(const RoundingMode& rm,
                                  const FloatingPoint& arg) const
 {
+  FloatingPointLiteral* res =
+      evaluateNative(NativeOp::DIV, rm, *d_fpl, arg.d_fpl.get());
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(new FloatingPointLiteral(d_fpl->div(rm, *arg.d_fpl)));
 }
 
 FloatingPoint FloatingPoint::sqrt(const RoundingMode& rm) const
 {
+  FloatingPointLiteral* res = evaluateNative(NativeOp::SQRT, rm, *d_fpl);
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(new FloatingPointLiteral(d_fpl->sqrt(rm)));
 }
 
@@ -308,6 +466,13 @@ FloatingPoint FloatingPoint::rti(const RoundingMode& rm) const
 
 FloatingPoint FloatingPoint::rem(const FloatingPoint& arg) const
 {
+  // the remainder is exact, so any rounding mode can be used
+  FloatingPointLiteral* res = evaluateNative(
+      NativeOp::REM, ROUND_NEAREST_TIES_TO_EVEN, *d_fpl, arg.d_fpl.get());
+  if (res != nullptr)
+  {
+    return FloatingPoint(res);
+  }
   return FloatingPoint(new FloatingPointLiteral(d_fpl->rem(*arg.d_fpl)));
 }
 
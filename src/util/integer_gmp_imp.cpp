@@ -48,6 +48,12 @@ Integer& Integer::operator=(const Integer& x)
   return *this;
 }
 
+Integer& Integer::operator=(Integer&& x)
+{
+  d_value = std::move(x.d_value);
+  return *this;
+}
+
 bool Integer::operator==(const Integer& y) const
 {
   return d_value == y.d_value;
@@ -24,6 +24,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <utility>
 
 #include "cvc4_export.h"  // remove when Cvc language support is removed
 
@@ -40,6 +41,8 @@ class CVC4_EXPORT Integer
    * Constructs an Integer by copying a GMP C++ primitive.
    */
   Integer(const mpz_class& val) : d_value(val) {}
+  /** Constructs an Integer by taking over a GMP C++ primitive. */
+  Integer(mpz_class&& val) : d_value(std::move(val)) {}
 
   /** Constructs a rational with the value 0. */
   Integer() : d_value(0) {}
@@ -54,6 +57,7 @@ class CVC4_EXPORT Integer
   explicit Integer(const std::string& s, unsigned base = 10);
 
   Integer(const Integer& q) : d_value(q.d_value) {}
+  Integer(Integer&& q) : d_value(std::move(q.d_value)) {}
 
   Integer(signed int z) : d_value(z) {}
   Integer(unsigned int z) : d_value(z) {}
@@ -73,6 +77,8 @@ class CVC4_EXPORT Integer
 
   /** Overload copy assignment operator. */
   Integer& operator=(const Integer& x);
+  /** Overload move assignment operator. */
+  Integer& operator=(Integer&& x);
 
   /** Overload equality comparison operator. */
   bool operator==(const Integer& y) const;
@@ -23,6 +23,7 @@
 #include <gmp.h>
 
 #include <string>
+#include <utility>
 
 #include "cvc4_export.h"  // remove when Cvc language support is removed
 #include "util/gmp_util.h"
@@ -56,6 +57,8 @@ class CVC4_EXPORT Rational
    * have to call canonicalize() on the value.
    */
   Rational(const mpq_class& val) : d_value(val) {}
+  /** As above, but takes over the value instead of copying it. */
+  Rational(mpq_class&& val) : d_value(std::move(val)) {}
 
   /**
    * Creates a rational from a decimal string (e.g., <code>"1.5"</code>).
@@ -66,7 +69,7 @@ class CVC4_EXPORT Rational
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0) { d_value.canonicalize(); }
+  Rational() : d_value(0) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -87,25 +90,22 @@ class CVC4_EXPORT Rational
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) { d_value.canonicalize(); }
+  Rational(const Rational& q) : d_value(q.d_value) {}
+  /** Creates a Rational by taking over the value of q, which becomes 0. */
+  Rational(Rational&& q) : d_value(std::move(q.d_value)) {}
 
   /**
-   * Constructs a canonical Rational from a numerator.
+   * Constructs a canonical Rational from a numerator. A value with
+   * denominator 1 is canonical, so there is no need to canonicalize it.
    */
-  Rational(signed int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(signed long int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned long int n) : d_value(n, 1) { d_value.canonicalize(); }
+  Rational(signed int n) : d_value(n, 1) {}
+  Rational(unsigned int n) : d_value(n, 1) {}
+  Rational(signed long int n) : d_value(n, 1) {}
+  Rational(unsigned long int n) : d_value(n, 1) {}
 
 #ifdef CVC4_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1)
-  {
-    d_value.canonicalize();
-  }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1)
-  {
-    d_value.canonicalize();
-  }
+  Rational(int64_t n) : d_value(static_cast<long>(n), 1) {}
+  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1) {}
 #endif /* CVC4_NEED_INT64_T_OVERLOADS */
 
   /**
@@ -146,7 +146,7 @@ class CVC4_EXPORT Rational
   {
     d_value.canonicalize();
   }
-  Rational(const Integer& n) : d_value(n.get_mpz()) { d_value.canonicalize(); }
+  Rational(const Integer& n) : d_value(n.get_mpz()) {}
   ~Rational() {}
 
   /**
@@ -233,7 +233,18 @@ class CVC4_EXPORT Rational
     return *this;
   }
 
-  Rational operator-() const { return Rational(-(d_value)); }
+  Rational& operator=(Rational&& x)
+  {
+    d_value = std::move(x.d_value);
+    return *this;
+  }
+
+  Rational operator-() const
+  {
+    Rational res;
+    mpq_neg(res.d_value.get_mpq_t(), d_value.get_mpq_t());
+    return res;
+  }
 
   bool operator==(const Rational& y) const { return d_value == y.d_value; }
 
@@ -249,16 +260,56 @@ class CVC4_EXPORT Rational
 
   Rational operator+(const Rational& y) const
   {
-    return Rational(d_value + y.d_value);
+    Rational res;
+    if (isIntegral() && y.isIntegral())
+    {
+      // fast path, avoiding the computations on the denominators
+      mpz_add(res.d_value.get_num_mpz_t(),
+              d_value.get_num_mpz_t(),
+              y.d_value.get_num_mpz_t());
+    }
+    else
+    {
+      mpq_add(res.d_value.get_mpq_t(),
+              d_value.get_mpq_t(),
+              y.d_value.get_mpq_t());
+    }
+    return res;
   }
   Rational operator-(const Rational& y) const
   {
-    return Rational(d_value - y.d_value);
+    Rational res;
+    if (isIntegral() && y.isIntegral())
+    {
+      mpz_sub(res.d_value.get_num_mpz_t(),
+              d_value.get_num_mpz_t(),
+              y.d_value.get_num_mpz_t());
+    }
+    else
+    {
+      mpq_sub(res.d_value.get_mpq_t(),
+              d_value.get_mpq_t(),
+              y.d_value.get_mpq_t());
+    }
+    return res;
   }
 
   Rational operator*(const Rational& y) const
   {
-    return Rational(d_value * y.d_value);
+    Rational res;
+    if (isIntegral() && y.isIntegral())
+    {
+      mpz_mul(res.d_value.get_num_mpz_t(),
+              d_value.get_num_mpz_t(),
+              y.d_value.get_num_mpz_t());
+    }
+    else
+    {
+      mpq_mul(res.d_value.get_mpq_t(),
+              d_value.get_mpq_t(),
+              y.d_value.get_mpq_t());
+    }
+    return res;
   }
   Rational operator/(const Rational& y) const
   {
@@ -288,7 +339,10 @@ class CVC4_EXPORT Rational
     return (*this);
   }
 
-  bool isIntegral() const { return getDenominator() == 1; }
+  bool isIntegral() const
+  {
+    return mpz_cmp_ui(d_value.get_den_mpz_t(), 1) == 0;
+  }
 
   /** Returns a string representing the rational in the given base. */
   std::string toString(int base = 10) const { return d_value.get_str(base); }
@@ -307,8 +361,10 @@ class CVC4_EXPORT Rational
 
   uint32_t complexity() const
   {
-    uint32_t numLen = getNumerator().length();
-    uint32_t denLen = getDenominator().length();
+    // as Integer::length(), without copying the numerator and denominator
+    uint32_t numLen =
+        sgn() == 0 ? 1 : mpz_sizeinbase(d_value.get_num_mpz_t(), 2);
+    uint32_t denLen = mpz_sizeinbase(d_value.get_den_mpz_t(), 2);
     return numLen + denLen;
   }
 
@@ -16,7 +16,14 @@
 **/
 #include "util/resource_manager.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <fstream>
+#include <mutex>
 #include <ostream>
 
 #include "base/check.h"
@@ -25,11 +32,117 @@
 #include "options/options.h"
 #include "options/smt_options.h"
 #include "util/statistics_registry.h"
+#include "util/stats_timer.h"
 
 using namespace std;
 
 namespace cvc5 {
 
+namespace {
+/**
+ * The number of calls to ResourceManager::spendResource() between two checks
+ * whether the progress listener is due.
+ */
+const uint32_t s_progressCheckPeriod = 256;
+
+/**
+ * The number of calls to ResourceManager::spendResource() between two samples
+ * of the resident memory if a memory limit is set.
+ */
+const uint32_t s_memoryCheckPeriod = 1024;
+
+/**
+ * The number of memory samples after a request to shed the caches until the
+ * memory limit is enforced if no caches were shed.
+ */
+const uint32_t s_memoryShedGrace = 4;
+
+/**
+ * Get the resident memory of this process in bytes. Where the current value
+ * is not available, this is the peak value.
+ */
+uint64_t getResidentMemory()
+{
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size = 0;
+  uint64_t resident = 0;
+  if (statm >> size >> resident)
+  {
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif /* __linux__ */
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    // in bytes on macOS
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif /* __APPLE__ */
+  }
+#endif
+  return 0;
+}
+
+/** Protects s_profileTruncated and the writes to the profile files */
+std::mutex s_profileMutex;
+/**
+ * Whether a profile file was already written by this process. The first
+ * resource manager to write its profile truncates the file, the others,
+ * e.g. those of subsolvers, append to it.
+ */
+bool s_profileTruncated = false;
+
+const char* toString(ResourceManager::Resource r)
+{
+  switch (r)
+  {
+    case ResourceManager::Resource::ArithPivotStep: return "ArithPivotStep";
+    case ResourceManager::Resource::ArithNlLemmaStep: return "ArithNlLemmaStep";
+    case ResourceManager::Resource::BitblastStep: return "BitblastStep";
+    case ResourceManager::Resource::BvEagerAssertStep:
+      return "BvEagerAssertStep";
+    case ResourceManager::Resource::BvPropagationStep:
+      return "BvPropagationStep";
+    case ResourceManager::Resource::BvSatConflictsStep:
+      return "BvSatConflictsStep";
+    case ResourceManager::Resource::BvSatPropagateStep:
+      return "BvSatPropagateStep";
+    case ResourceManager::Resource::BvSatSimplifyStep:
+      return "BvSatSimplifyStep";
+    case ResourceManager::Resource::CnfStep: return "CnfStep";
+    case ResourceManager::Resource::DecisionStep: return "DecisionStep";
+    case ResourceManager::Resource::LemmaStep: return "LemmaStep";
+    case ResourceManager::Resource::NewSkolemStep: return "NewSkolemStep";
+    case ResourceManager::Resource::ParseStep: return "ParseStep";
+    case ResourceManager::Resource::PreprocessStep: return "PreprocessStep";
+    case ResourceManager::Resource::QuantifierStep: return "QuantifierStep";
+    case ResourceManager::Resource::RestartStep: return "RestartStep";
+    case ResourceManager::Resource::RewriteStep: return "RewriteStep";
+    case ResourceManager::Resource::SatConflictStep: return "SatConflictStep";
+    case ResourceManager::Resource::TheoryCheckStep: return "TheoryCheckStep";
+    default: return "UnknownStep";
+  }
+}
+
+/** Append the name of a frame to a folded stack */
+void appendFrame(std::string& stack, const std::string& name)
+{
+  if (!stack.empty())
+  {
+    stack += ';';
+  }
+  for (char c : name)
+  {
+    // spaces and semicolons separate the counts and the frames
+    stack += (c == ' ' || c == ';') ? '_' : c;
+  }
+}
+}  // namespace
+
 bool WallClockTimer::on() const
 {
   // default-constructed time points are at the respective epoch
@@ -70,6 +183,8 @@ bool WallClockTimer::expired() const
 struct ResourceManager::Statistics
 {
   ReferenceStat<std::uint64_t> d_resourceUnitsUsed;
+  ReferenceStat<std::uint64_t> d_memoryUsed;
+  IntStat d_cachesShed;
   IntStat d_spendResourceCalls;
   IntStat d_numArithPivotStep;
   IntStat d_numArithNlLemmaStep;
@@ -99,6 +214,8 @@ struct ResourceManager::Statistics
 
 ResourceManager::Statistics::Statistics(StatisticsRegistry& stats)
     : d_resourceUnitsUsed("resource::resourceUnitsUsed"),
+      d_memoryUsed("resource::memoryUsed"),
+      d_cachesShed("resource::cachesShed", 0),
       d_spendResourceCalls("resource::spendResourceCalls", 0),
       d_numArithPivotStep("resource::ArithPivotStep", 0),
       d_numArithNlLemmaStep("resource::ArithNlLemmaStep", 0),
@@ -122,6 +239,8 @@ ResourceManager::Statistics::Statistics(StatisticsRegistry& stats)
       d_statisticsRegistry(stats)
 {
   d_statisticsRegistry.registerStat(&d_resourceUnitsUsed);
+  d_statisticsRegistry.registerStat(&d_memoryUsed);
+  d_statisticsRegistry.registerStat(&d_cachesShed);
   d_statisticsRegistry.registerStat(&d_spendResourceCalls);
   d_statisticsRegistry.registerStat(&d_numArithPivotStep);
   d_statisticsRegistry.registerStat(&d_numArithNlLemmaStep);
@@ -147,6 +266,8 @@ ResourceManager::Statistics::Statistics(StatisticsRegistry& stats)
 ResourceManager::Statistics::~Statistics()
 {
   d_statisticsRegistry.unregisterStat(&d_resourceUnitsUsed);
+  d_statisticsRegistry.unregisterStat(&d_memoryUsed);
+  d_statisticsRegistry.unregisterStat(&d_cachesShed);
   d_statisticsRegistry.unregisterStat(&d_spendResourceCalls);
   d_statisticsRegistry.unregisterStat(&d_numArithPivotStep);
   d_statisticsRegistry.unregisterStat(&d_numArithNlLemmaStep);
@@ -178,17 +299,46 @@ ResourceManager::ResourceManager(StatisticsRegistry& stats, Options& options)
       d_resourceBudgetPerCall(0),
       d_cumulativeTimeUsed(0),
       d_cumulativeResourceUsed(0),
+      d_memoryLimit(0),
+      d_memoryUsed(0),
+      d_memoryCountdown(s_memoryCheckPeriod),
+      d_shedRequested(false),
+      d_shedDone(false),
+      d_shedGrace(0),
       d_thisCallResourceUsed(0),
       d_thisCallResourceBudget(0),
       d_on(false),
+      d_interrupted(false),
+      d_thisCallConflicts(0),
+      d_thisCallLemmas(0),
+      d_progressListener(nullptr),
+      d_progressInterval(0),
+      d_progressCountdown(0),
+      d_profileInterval(0),
+      d_profileCountdown(0),
       d_statistics(new ResourceManager::Statistics(stats)),
       d_options(options)
 
 {
   d_statistics->d_resourceUnitsUsed.set(d_cumulativeResourceUsed);
+  d_statistics->d_memoryUsed.set(d_memoryUsed);
+  if (!d_options[options::resourceProfile].empty())
+  {
+    d_profileInterval =
+        std::max(d_options[options::resourceProfileInterval], 1u);
+    d_profileCountdown = d_profileInterval;
+    TimerStat::recordRunningTimers(true);
+  }
 }
 
-ResourceManager::~ResourceManager() {}
+ResourceManager::~ResourceManager()
+{
+  if (d_profileInterval > 0)
+  {
+    TimerStat::recordRunningTimers(false);
+    writeProfile();
+  }
+}
 
 void ResourceManager::setResourceLimit(uint64_t units, bool cumulative)
 {
@@ -218,6 +368,47 @@ void ResourceManager::setTimeLimit(uint64_t millis)
   // perCall timer will be set in beginCall
 }
 
+void ResourceManager::setMemoryLimit(uint64_t megabytes)
+{
+  d_on = true;
+  Trace("limit") << "ResourceManager: setting memory limit to " << megabytes
+                 << " MB" << endl;
+  d_memoryLimit = megabytes * 1024 * 1024;
+  d_memoryUsed = getResidentMemory();
+}
+
+void ResourceManager::sampleMemory()
+{
+  d_memoryUsed = getResidentMemory();
+  if (d_memoryUsed < d_memoryLimit || d_shedDone)
+  {
+    return;
+  }
+  if (!d_shedRequested)
+  {
+    Trace("limit") << "ResourceManager: memory limit reached, shed caches"
+                   << std::endl;
+    d_shedRequested = true;
+    d_shedGrace = s_memoryShedGrace;
+  }
+  else if (--d_shedGrace == 0)
+  {
+    // no point to shed the caches was reached, enforce the limit
+    d_shedRequested = false;
+    d_shedDone = true;
+  }
+}
+
+void ResourceManager::notifyCachesShed()
+{
+  ++d_statistics->d_cachesShed;
+  d_shedRequested = false;
+  d_shedDone = true;
+  d_memoryUsed = getResidentMemory();
+  Trace("limit") << "ResourceManager: shed caches, resident memory is "
+                 << d_memoryUsed << " bytes" << std::endl;
+}
+
 uint64_t ResourceManager::getResourceUsage() const
 {
   return d_cumulativeResourceUsed;
@@ -235,10 +426,25 @@ void ResourceManager::spendResource(unsigned amount)
 {
   ++d_statistics->d_spendResourceCalls;
   d_cumulativeResourceUsed += amount;
-  if (!d_on) return;
+  if (d_progressListener != nullptr && --d_progressCountdown == 0)
+  {
+    // only look at the clock every so often, since this is called a lot
+    d_progressCountdown = s_progressCheckPeriod;
+    if (d_progressTimer.expired())
+    {
+      d_progressTimer.set(d_progressInterval);
+      d_progressListener->notify();
+    }
+  }
+  if (!d_on && !interrupted()) return;
 
   Debug("limit") << "ResourceManager::spendResource()" << std::endl;
   d_thisCallResourceUsed += amount;
+  if (d_memoryLimit > 0 && --d_memoryCountdown == 0)
+  {
+    d_memoryCountdown = s_memoryCheckPeriod;
+    sampleMemory();
+  }
   if (out())
   {
     Trace("limit") << "ResourceManager::spendResource: interrupt!" << std::endl;
@@ -249,6 +455,11 @@ void ResourceManager::spendResource(unsigned amount)
       Trace("limit") << "ResourceManager::spendResource: elapsed time"
                      << d_perCallTimer.elapsed() << std::endl;
     }
+    if (outOfMemory())
+    {
+      Trace("limit") << "ResourceManager::spendResource: resident memory "
+                     << d_memoryUsed << std::endl;
+    }
 
     for (Listener* l : d_listeners)
     {
@@ -305,6 +516,7 @@ void ResourceManager::spendResource(Resource r)
     case Resource::LemmaStep:
       amount = d_options[options::lemmaStep];
       ++d_statistics->d_numLemmaStep;
+      ++d_thisCallLemmas;
       break;
     case Resource::NewSkolemStep:
       amount = d_options[options::newSkolemStep];
@@ -333,6 +545,7 @@ void ResourceManager::spendResource(Resource r)
     case Resource::SatConflictStep:
       amount = d_options[options::satConflictStep];
       ++d_statistics->d_numSatConflictStep;
+      ++d_thisCallConflicts;
       break;
     case Resource::TheoryCheckStep:
       amount = d_options[options::theoryCheckStep];
@@ -340,13 +553,68 @@ void ResourceManager::spendResource(Resource r)
       break;
     default: Unreachable() << "Invalid resource " << std::endl;
   }
+  if (d_profileInterval > 0)
+  {
+    if (amount >= d_profileCountdown)
+    {
+      // the number of sampling points in the units spent
+      uint64_t rest = amount - d_profileCountdown;
+      addProfileSample(r, 1 + rest / d_profileInterval);
+      d_profileCountdown = d_profileInterval - rest % d_profileInterval;
+    }
+    else
+    {
+      d_profileCountdown -= amount;
+    }
+  }
   spendResource(amount);
 }
 
+void ResourceManager::addProfileSample(Resource r, uint64_t count)
+{
+  std::string stack;
+  for (const TimerStat* t : TimerStat::getRunningTimers())
+  {
+    appendFrame(stack, t->getName());
+  }
+  appendFrame(stack, toString(r));
+  d_profile[stack] += count;
+}
+
+void ResourceManager::writeProfile()
+{
+  if (d_profile.empty())
+  {
+    return;
+  }
+  const std::string& filename = d_options[options::resourceProfile];
+  std::lock_guard<std::mutex> lock(s_profileMutex);
+  std::ofstream out(filename,
+                    s_profileTruncated ? std::ios::app : std::ios::trunc);
+  s_profileTruncated = true;
+  if (!out)
+  {
+    Warning() << "Cannot write the resource profile to " << filename
+              << std::endl;
+    return;
+  }
+  for (const std::pair<const std::string, uint64_t>& p : d_profile)
+  {
+    out << p.first << " " << p.second << "\n";
+  }
+}
+
 void ResourceManager::beginCall()
 {
   d_perCallTimer.set(d_timeBudgetPerCall);
   d_thisCallResourceUsed = 0;
+  d_thisCallStart = std::chrono::system_clock::now();
+  d_thisCallConflicts = 0;
+  d_thisCallLemmas = 0;
+  d_progressTimer.set(d_progressInterval);
+  d_progressCountdown = s_progressCheckPeriod;
+  d_shedRequested = false;
+  d_shedDone = false;
   if (!d_on) return;
 
   if (d_resourceBudgetCumulative > 0)
@@ -370,6 +638,9 @@ void ResourceManager::endCall()
   d_cumulativeTimeUsed += d_perCallTimer.elapsed();
   d_perCallTimer.set(0);
   d_thisCallResourceUsed = 0;
+  // the memory limit is enforced anew in the next call
+  d_shedRequested = false;
+  d_shedDone = false;
 }
 
 bool ResourceManager::cumulativeLimitOn() const
@@ -409,15 +680,44 @@ bool ResourceManager::outOfTime() const
   return d_perCallTimer.expired();
 }
 
+bool ResourceManager::outOfMemory() const
+{
+  return d_memoryLimit > 0 && d_shedDone && d_memoryUsed >= d_memoryLimit;
+}
+
 void ResourceManager::enable(bool on)
 {
   Trace("limit") << "ResourceManager::enable(" << on << ")\n";
   d_on = on;
 }
 
+void ResourceManager::interrupt()
+{
+  // no tracing here, this may be called from a different thread
+  d_interrupted.store(true);
+}
+
+void ResourceManager::clearInterrupt() { d_interrupted.store(false); }
+
 void ResourceManager::registerListener(Listener* listener)
 {
   return d_listeners.push_back(listener);
 }
 
+void ResourceManager::setProgressListener(Listener* listener, uint64_t millis)
+{
+  d_progressListener = listener;
+  // a zero interval would deactivate the timer
+  d_progressInterval = millis == 0 ? 1 : millis;
+  d_progressTimer.set(d_progressInterval);
+  d_progressCountdown = s_progressCheckPeriod;
+}
+
+uint64_t ResourceManager::getTimeThisCall() const
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now() - d_thisCallStart)
+      .count();
+}
+
 }  // namespace cvc5
@@ -22,8 +22,12 @@
 #define CVC4__RESOURCE_MANAGER_H
 
 #include <stdint.h>
+
+#include <atomic>
 #include <chrono>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace cvc5 {
@@ -122,8 +126,19 @@ class ResourceManager
   bool outOfResources() const;
   /** Checks whether time has been exhausted. */
   bool outOfTime() const;
+  /**
+   * Checks whether the memory limit has been exceeded, after the caches were
+   * shed (see shedCachesRequested()).
+   */
+  bool outOfMemory() const;
+  /** Checks whether an asynchronous interrupt was requested. */
+  bool interrupted() const { return d_interrupted.load(); }
   /** Checks whether any limit has been exhausted. */
-  bool out() const { return d_on && (outOfResources() || outOfTime()); }
+  bool out() const
+  {
+    return interrupted()
+           || (d_on && (outOfResources() || outOfTime() || outOfMemory()));
+  }
 
   /** Retrieves amount of resources used overall. */
   uint64_t getResourceUsage() const;
@@ -145,9 +160,37 @@ class ResourceManager
   void setResourceLimit(uint64_t units, bool cumulative = false);
   /** Sets the time limit. */
   void setTimeLimit(uint64_t millis);
+  /** Sets the limit on the resident memory of the process, in megabytes. */
+  void setMemoryLimit(uint64_t megabytes);
+  /** Retrieves the resident memory at the last sample, in bytes. */
+  uint64_t getMemoryUsage() const { return d_memoryUsed; }
+
+  /**
+   * Checks whether the memory limit was reached in this call and the caches
+   * should be shed. This is polled at points where that is safe, which call
+   * notifyCachesShed() afterwards. If the memory limit is still exceeded
+   * after that, or if no such point is reached within a few samples of the
+   * memory, then outOfMemory() holds.
+   */
+  bool shedCachesRequested() const { return d_shedRequested; }
+  /** Notifies that the caches were shed, see shedCachesRequested(). */
+  void notifyCachesShed();
   /** Sets whether resource limitation is enabled. */
   void enable(bool on);
 
+  /**
+   * Requests an interrupt of the solver that owns this resource manager.
+   * Unlike all other methods of this class, this method may be called from a
+   * different thread than the one running the solver. The request is sticky:
+   * the next call to spendResource() (and every call after it) notifies the
+   * registered listeners, until clearInterrupt() is called. The SmtEngine
+   * clears it at the end of each satisfiability check, so that a request
+   * interrupts the running check, or the next one if no check is running.
+   */
+  void interrupt();
+  /** Clears a pending interrupt request (see interrupt()). */
+  void clearInterrupt();
+
   /**
    * Resets perCall limits to mark the start of a new call,
    * updates budget for current call and starts the timer
@@ -166,6 +209,20 @@ class ResourceManager
    */
   void registerListener(Listener* listener);
 
+  /**
+   * Sets the listener that is notified about the progress of each call,
+   * about every millis milliseconds, or removes it if listener is null. The
+   * listener is notified in spendResource(), i.e., on the thread running the
+   * solver, and may query the progress through the methods below.
+   */
+  void setProgressListener(Listener* listener, uint64_t millis);
+  /** Retrieves the number of SAT conflicts in the current call. */
+  uint64_t getConflictsThisCall() const { return d_thisCallConflicts; }
+  /** Retrieves the number of lemmas in the current call. */
+  uint64_t getLemmasThisCall() const { return d_thisCallLemmas; }
+  /** Retrieves the number of milliseconds elapsed in the current call. */
+  uint64_t getTimeThisCall() const;
+
  private:
   /** The per-call wall clock timer. */
   WallClockTimer d_perCallTimer;
@@ -182,6 +239,19 @@ class ResourceManager
   /** The total amount of resources used. */
   uint64_t d_cumulativeResourceUsed;
 
+  /** The memory limit in bytes. 0 = no limit. */
+  uint64_t d_memoryLimit;
+  /** The resident memory at the last sample, in bytes. */
+  uint64_t d_memoryUsed;
+  /** The number of calls to spendResource() until the next memory sample. */
+  uint32_t d_memoryCountdown;
+  /** Whether the caches should be shed, see shedCachesRequested() */
+  bool d_shedRequested;
+  /** Whether the caches were shed in this call */
+  bool d_shedDone;
+  /** The number of memory samples until a request to shed expires */
+  uint32_t d_shedGrace;
+
   /** The amount of resources used during this call. */
   uint64_t d_thisCallResourceUsed;
 
@@ -194,11 +264,46 @@ class ResourceManager
   /** A flag indicating whether resource limitation is active. */
   bool d_on;
 
+  /** Set by interrupt(), possibly from another thread. */
+  std::atomic<bool> d_interrupted;
+
   /** Receives a notification on reaching a limit. */
   std::vector<Listener*> d_listeners;
 
+  /** The start of the current call. */
+  std::chrono::system_clock::time_point d_thisCallStart;
+  /** The number of SAT conflicts in the current call. */
+  uint64_t d_thisCallConflicts;
+  /** The number of lemmas in the current call. */
+  uint64_t d_thisCallLemmas;
+  /** Receives notifications about the progress of calls, if not null. */
+  Listener* d_progressListener;
+  /** The interval between two notifications of d_progressListener. */
+  uint64_t d_progressInterval;
+  /** The timer for the next notification of d_progressListener. */
+  WallClockTimer d_progressTimer;
+  /** The number of calls to spendResource() until the next progress check. */
+  uint32_t d_progressCountdown;
+
   void spendResource(unsigned amount);
 
+  /** Samples the resident memory and requests to shed the caches if needed */
+  void sampleMemory();
+
+  /**
+   * Add count samples to the resource profile (see options::resourceProfile),
+   * i.e. to the stack of running timers followed by r.
+   */
+  void addProfileSample(Resource r, uint64_t count);
+  /** Append the samples of the resource profile to its file */
+  void writeProfile();
+  /** The resource units between two samples, 0 if profiling is disabled */
+  uint64_t d_profileInterval;
+  /** The resource units until the next sample */
+  uint64_t d_profileCountdown;
+  /** The number of samples per folded stack */
+  std::map<std::string, uint64_t> d_profile;
+
   struct Statistics;
   std::unique_ptr<Statistics> d_statistics;
 
@@ -44,6 +44,7 @@ void StatisticsRegistry::registerStat(Stat* s)
       s,
       "Statistic `%s' is already registered with this registry.",
       s->getName().c_str());
+  std::lock_guard<std::mutex> lock(d_mutex);
   d_stats.insert(s);
 #endif /* CVC4_STATISTICS_ON */
 }/* StatisticsRegistry::registerStat_() */
@@ -52,12 +53,29 @@ void StatisticsRegistry::unregisterStat(Stat* s)
 {
 #ifdef CVC4_STATISTICS_ON
   AlwaysAssert(s != nullptr);
+  std::lock_guard<std::mutex> lock(d_mutex);
   AlwaysAssert(d_stats.erase(s) > 0)
       << "Statistic `" << s->getName()
       << "' was not registered with this registry.";
 #endif /* CVC4_STATISTICS_ON */
 } /* StatisticsRegistry::unregisterStat() */
 
+void StatisticsRegistry::snapshot(
+    std::vector<std::pair<std::string, int64_t>>& values) const
+{
+#ifdef CVC4_STATISTICS_ON
+  std::lock_guard<std::mutex> lock(d_mutex);
+  for (const Stat* s : d_stats)
+  {
+    int64_t value;
+    if (s->getSnapshotValue(value))
+    {
+      values.emplace_back(s->getName(), value);
+    }
+  }
+#endif /* CVC4_STATISTICS_ON */
+}
+
 void StatisticsRegistry::flushStat(std::ostream &out) const {
 #ifdef CVC4_STATISTICS_ON
   flushInformation(out);
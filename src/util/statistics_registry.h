@@ -87,7 +87,10 @@
 #include <ctime>
 #include <iomanip>
 #include <map>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #ifdef CVC4_STATISTICS_ON
@@ -177,6 +180,20 @@ public:
   /** Unregister a new statistic */
   void unregisterStat(Stat* s);
 
+  /**
+   * Take a snapshot of the statistics that support it (see
+   * Stat::getSnapshotValue), adding the pairs of their names and values to
+   * values. This may be called by another thread than the one using the
+   * registry and its statistics, and does not interrupt that thread. Each
+   * value is read atomically, although the values are not read at the same
+   * instant.
+   */
+  void snapshot(std::vector<std::pair<std::string, int64_t>>& values) const;
+
+ private:
+  /** Protects d_stats from concurrent registration and snapshots */
+  mutable std::mutex d_mutex;
+
 }; /* class StatisticsRegistry */
 
 /**
@@ -30,62 +30,17 @@ Stat::Stat(const std::string& name) : d_name(name)
   }
 }
 
-IntStat::IntStat(const std::string& name, int64_t init)
-    : BackedStat<int64_t>(name, init)
-{
-}
-
-/** Increment the underlying integer statistic. */
-IntStat& IntStat::operator++()
-{
-  if (CVC4_USE_STATISTICS)
-  {
-    ++d_data;
-  }
-  return *this;
-}
-/** Increment the underlying integer statistic. */
-IntStat& IntStat::operator++(int)
-{
-  if (CVC4_USE_STATISTICS)
-  {
-    ++d_data;
-  }
-  return *this;
-}
-
-/** Increment the underlying integer statistic by the given amount. */
-IntStat& IntStat::operator+=(int64_t val)
-{
-  if (CVC4_USE_STATISTICS)
-  {
-    d_data += val;
-  }
-  return *this;
-}
+bool Stat::getSnapshotValue(int64_t& value) const { return false; }
 
-/** Keep the maximum of the current statistic value and the given one. */
-void IntStat::maxAssign(int64_t val)
+IntStat::IntStat(const std::string& name, int64_t init)
+    : Stat(name), d_data(init)
 {
-  if (CVC4_USE_STATISTICS)
-  {
-    if (d_data < val)
-    {
-      d_data = val;
-    }
-  }
 }
 
-/** Keep the minimum of the current statistic value and the given one. */
-void IntStat::minAssign(int64_t val)
+bool IntStat::getSnapshotValue(int64_t& value) const
 {
-  if (CVC4_USE_STATISTICS)
-  {
-    if (d_data > val)
-    {
-      d_data = val;
-    }
-  }
+  value = get();
+  return true;
 }
 
 AverageStat::AverageStat(const std::string& name)
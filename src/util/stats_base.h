@@ -19,6 +19,8 @@
 #ifndef CVC4__UTIL__STATS_BASE_H
 #define CVC4__UTIL__STATS_BASE_H
 
+#include <atomic>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -81,6 +83,14 @@ class CVC4_EXPORT Stat
     return SExpr(ss.str());
   }
 
+  /**
+   * Get the value of this statistic for a snapshot (see
+   * StatisticsRegistry::snapshot). Returns false if this statistic does not
+   * support snapshots. In contrast to the methods above, this may be called
+   * by another thread than the one updating the statistic.
+   */
+  virtual bool getSnapshotValue(int64_t& value) const;
+
  protected:
   /** The name of this statistic */
   std::string d_name;
@@ -189,10 +199,13 @@ class ReferenceStat : public Stat
 
 /**
  * A backed integer-valued (64-bit signed) statistic.
- * This doesn't functionally differ from its base class BackedStat<int64_t>,
- * except for adding convenience functions for dealing with integers.
+ *
+ * The value may be read by other threads, e.g. for snapshots, while it is
+ * updated. It is only updated by one thread, so the updates are a relaxed
+ * load and store of an atomic, which is as cheap as updating a plain
+ * integer, rather than an atomic read-modify-write.
  */
-class IntStat : public BackedStat<int64_t>
+class IntStat : public Stat
 {
  public:
   /**
@@ -201,22 +214,69 @@ class IntStat : public BackedStat<int64_t>
    */
   IntStat(const std::string& name, int64_t init);
 
+  /** Set the underlying integer statistic to the given value. */
+  void set(int64_t val)
+  {
+    if (CVC4_USE_STATISTICS)
+    {
+      d_data.store(val, std::memory_order_relaxed);
+    }
+  }
+
+  int64_t get() const { return d_data.load(std::memory_order_relaxed); }
+
   /** Increment the underlying integer statistic. */
-  IntStat& operator++();
+  IntStat& operator++()
+  {
+    set(get() + 1);
+    return *this;
+  }
   /** Increment the underlying integer statistic. */
-  IntStat& operator++(int);
+  IntStat& operator++(int)
+  {
+    set(get() + 1);
+    return *this;
+  }
 
   /** Increment the underlying integer statistic by the given amount. */
-  IntStat& operator+=(int64_t val);
+  IntStat& operator+=(int64_t val)
+  {
+    set(get() + val);
+    return *this;
+  }
 
   /** Keep the maximum of the current statistic value and the given one. */
-  void maxAssign(int64_t val);
+  void maxAssign(int64_t val)
+  {
+    if (get() < val)
+    {
+      set(val);
+    }
+  }
 
   /** Keep the minimum of the current statistic value and the given one. */
-  void minAssign(int64_t val);
+  void minAssign(int64_t val)
+  {
+    if (get() > val)
+    {
+      set(val);
+    }
+  }
+
+  void flushInformation(std::ostream& out) const override { out << get(); }
+
+  void safeFlushInformation(int fd) const override
+  {
+    safe_print<int64_t>(fd, get());
+  }
 
-  SExpr getValue() const override { return SExpr(Integer(d_data)); }
+  SExpr getValue() const override { return SExpr(Integer(get())); }
 
+  bool getSnapshotValue(int64_t& value) const override;
+
+ private:
+  /** The value of the statistic */
+  std::atomic<int64_t> d_data;
 }; /* class IntStat */
 
 /**
@@ -0,0 +1,83 @@
+/*********************                                                        */
+/*! \file stats_series.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Series statistics
+ **
+ ** Stat classes that represent series of values, e.g. time series
+ **/
+
+#include "cvc4_private_library.h"
+
+#ifndef CVC4__UTIL__STATS_SERIES_H
+#define CVC4__UTIL__STATS_SERIES_H
+
+#include <vector>
+
+#include "util/stats_base.h"
+
+namespace cvc5 {
+
+/**
+ * A statistic that records a series of values in the order they are added,
+ * e.g. one value per restart of the SAT solver. The values are printed as a
+ * list.
+ */
+template <typename T>
+class SeriesStat : public Stat
+{
+ public:
+  /** Construct an empty series. */
+  SeriesStat(const std::string& name) : Stat(name) {}
+
+  void flushInformation(std::ostream& out) const override
+  {
+    out << "[";
+    for (size_t i = 0, n = d_series.size(); i < n; ++i)
+    {
+      if (i > 0)
+      {
+        out << ", ";
+      }
+      out << d_series[i];
+    }
+    out << "]";
+  }
+
+  void safeFlushInformation(int fd) const override
+  {
+    safe_print(fd, "[");
+    for (size_t i = 0, n = d_series.size(); i < n; ++i)
+    {
+      if (i > 0)
+      {
+        safe_print(fd, ", ");
+      }
+      safe_print<T>(fd, d_series[i]);
+    }
+    safe_print(fd, "]");
+  }
+
+  SeriesStat& operator<<(const T& val)
+  {
+    if (CVC4_USE_STATISTICS)
+    {
+      d_series.push_back(val);
+    }
+    return (*this);
+  }
+
+ private:
+  std::vector<T> d_series;
+}; /* class SeriesStat */
+
+}  // namespace cvc5
+
+#endif
@@ -16,13 +16,22 @@
 
 #include "util/stats_timer.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 #include "base/check.h"
 #include "util/ostream_util.h"
 
 namespace cvc5 {
 
+namespace {
+/** The number of enabled recordings of running timers on this thread */
+thread_local uint32_t s_recordRunning = 0;
+/** The running timers of this thread, if s_recordRunning is not zero */
+thread_local std::vector<const TimerStat*> s_running;
+}  // namespace
+
 template <>
 void safe_print(int fd, const timer_stat_detail::duration& t)
 {
@@ -38,6 +47,10 @@ void TimerStat::start()
     PrettyCheckArgument(!d_running, *this, "timer already running");
     d_start = timer_stat_detail::clock::now();
     d_running = true;
+    if (s_recordRunning > 0)
+    {
+      s_running.push_back(this);
+    }
   }
 }
 
@@ -48,7 +61,36 @@ void TimerStat::stop()
     AlwaysAssert(d_running) << "timer not running";
     d_data += timer_stat_detail::clock::now() - d_start;
     d_running = false;
+    if (s_recordRunning > 0)
+    {
+      // timers are usually stopped in the reverse order of starting them
+      std::vector<const TimerStat*>::reverse_iterator it =
+          std::find(s_running.rbegin(), s_running.rend(), this);
+      if (it != s_running.rend())
+      {
+        s_running.erase(std::next(it).base());
+      }
+    }
+  }
+}
+
+void TimerStat::recordRunningTimers(bool on)
+{
+  if (on)
+  {
+    s_recordRunning++;
+    return;
   }
+  Assert(s_recordRunning > 0);
+  if (--s_recordRunning == 0)
+  {
+    s_running.clear();
+  }
+}
+
+const std::vector<const TimerStat*>& TimerStat::getRunningTimers()
+{
+  return s_running;
 }
 
 bool TimerStat::running() const { return d_running; }
@@ -20,6 +20,7 @@
 #define CVC4__UTIL__STATS_TIMER_H
 
 #include <chrono>
+#include <vector>
 
 #include "cvc4_export.h"
 #include "util/stats_base.h"
@@ -79,6 +80,20 @@ class CVC4_EXPORT TimerStat : public BackedStat<timer_stat_detail::duration>
 
   SExpr getValue() const override;
 
+  /**
+   * Enable or disable the recording of the running timers of the current
+   * thread (see getRunningTimers). Calls may be nested, the recording is
+   * enabled until each call with on = true is matched by one with
+   * on = false.
+   */
+  static void recordRunningTimers(bool on);
+  /**
+   * The timers of the current thread that are running, in the order they
+   * were started, if recording is enabled. Timers that were started before
+   * recording was enabled are not included.
+   */
+  static const std::vector<const TimerStat*>& getRunningTimers();
+
  private:
   /** The last start time of this timer */
   timer_stat_detail::time_point d_start;
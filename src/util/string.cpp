@@ -16,12 +16,14 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
 #include "base/check.h"
 #include "base/exception.h"
+#include "util/hash.h"
 
 using namespace std;
 
@@ -39,24 +41,59 @@ String::String(const std::vector<unsigned> &s) : d_str(s)
 #endif
 }
 
+String::String(std::vector<unsigned>&& s) : d_str(std::move(s))
+{
+#ifdef CVC4_ASSERTIONS
+  for (unsigned u : d_str)
+  {
+    Assert(u < num_codes());
+  }
+#endif
+}
+
+bool String::equalRange(std::size_t i,
+                        const String& y,
+                        std::size_t j,
+                        std::size_t n) const
+{
+  Assert(i + n <= size() && j + n <= y.size());
+  // the characters are contiguous, memcmp compares them word-wise
+  return n == 0
+         || std::memcmp(
+                d_str.data() + i, y.d_str.data() + j, n * sizeof(unsigned))
+                == 0;
+}
+
 int String::cmp(const String &y) const {
   if (size() != y.size()) {
     return size() < y.size() ? -1 : 1;
   }
-  for (unsigned int i = 0; i < size(); ++i) {
-    if (d_str[i] != y.d_str[i]) {
-      unsigned cp = d_str[i];
-      unsigned cpy = y.d_str[i];
-      return cp < cpy ? -1 : 1;
-    }
+  if (equalRange(0, y, 0, size()))
+  {
+    return 0;
   }
-  return 0;
+  std::pair<std::vector<unsigned>::const_iterator,
+            std::vector<unsigned>::const_iterator>
+      mm = std::mismatch(d_str.begin(), d_str.end(), y.d_str.begin());
+  return *mm.first < *mm.second ? -1 : 1;
+}
+
+size_t String::hash() const
+{
+  uint64_t ret = fnv1a::fnv1a_64(d_str.size());
+  for (unsigned c : d_str)
+  {
+    ret = fnv1a::fnv1a_64(c, ret);
+  }
+  return static_cast<size_t>(ret);
 }
 
 String String::concat(const String &other) const {
-  std::vector<unsigned int> ret_vec(d_str);
+  std::vector<unsigned int> ret_vec;
+  ret_vec.reserve(d_str.size() + other.d_str.size());
+  ret_vec.insert(ret_vec.end(), d_str.begin(), d_str.end());
   ret_vec.insert(ret_vec.end(), other.d_str.begin(), other.d_str.end());
-  return String(ret_vec);
+  return String(std::move(ret_vec));
 }
 
 bool String::strncmp(const String& y, std::size_t n) const
@@ -70,10 +107,7 @@ bool String::strncmp(const String& y, std::size_t n) const
       return false;
     }
   }
-  for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[i] != y.d_str[i]) return false;
-  }
-  return true;
+  return equalRange(0, y, 0, n);
 }
 
 bool String::rstrncmp(const String& y, std::size_t n) const
@@ -87,10 +121,7 @@ bool String::rstrncmp(const String& y, std::size_t n) const
       return false;
     }
   }
-  for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[size() - i - 1] != y.d_str[y.size() - i - 1]) return false;
-  }
-  return true;
+  return equalRange(size() - n, y, y.size() - n, n);
 }
 
 void String::addCharToInternal(unsigned char ch, std::vector<unsigned>& str)
@@ -353,10 +384,20 @@ std::size_t String::find(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_iterator itr = std::search(
-      d_str.begin() + start, d_str.end(), y.d_str.begin(), y.d_str.end());
-  if (itr != d_str.end()) {
-    return itr - d_str.begin();
+  // scan for the first character of y, and compare the rest of y at each of
+  // its occurrences
+  unsigned first = y.d_str[0];
+  std::size_t last = size() - y.size();
+  std::vector<unsigned>::const_iterator itr = d_str.begin() + start;
+  std::vector<unsigned>::const_iterator end = d_str.begin() + last + 1;
+  while ((itr = std::find(itr, end, first)) != end)
+  {
+    std::size_t i = itr - d_str.begin();
+    if (equalRange(i + 1, y, 1, y.size() - 1))
+    {
+      return i;
+    }
+    ++itr;
   }
   return std::string::npos;
 }
@@ -366,10 +407,19 @@ std::size_t String::rfind(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_reverse_iterator itr = std::search(
-      d_str.rbegin() + start, d_str.rend(), y.d_str.rbegin(), y.d_str.rend());
-  if (itr != d_str.rend()) {
-    return itr - d_str.rbegin();
+  // the same as find, on the reversed strings
+  unsigned last = y.d_str.back();
+  std::vector<unsigned>::const_reverse_iterator itr = d_str.rbegin() + start;
+  std::vector<unsigned>::const_reverse_iterator end =
+      d_str.rbegin() + (size() - y.size() + 1);
+  while ((itr = std::find(itr, end, last)) != end)
+  {
+    std::size_t i = itr - d_str.rbegin();
+    if (equalRange(size() - i - y.size(), y, 0, y.size() - 1))
+    {
+      return i;
+    }
+    ++itr;
   }
   return std::string::npos;
 }
@@ -382,14 +432,7 @@ bool String::hasPrefix(const String& y) const
   {
     return false;
   }
-  for (size_t i = 0; i < ys; i++)
-  {
-    if (d_str[i] != y.d_str[i])
-    {
-      return false;
-    }
-  }
-  return true;
+  return equalRange(0, y, 0, ys);
 }
 
 bool String::hasSuffix(const String& y) const
@@ -400,15 +443,7 @@ bool String::hasSuffix(const String& y) const
   {
     return false;
   }
-  size_t idiff = s - ys;
-  for (size_t i = 0; i < ys; i++)
-  {
-    if (d_str[i + idiff] != y.d_str[i])
-    {
-      return false;
-    }
-  }
-  return true;
+  return equalRange(s - ys, y, 0, ys);
 }
 
 String String::update(std::size_t i, const String& t) const
@@ -447,18 +482,13 @@ String String::replace(const String &s, const String &t) const {
 
 String String::substr(std::size_t i) const {
   Assert(i <= size());
-  std::vector<unsigned> ret_vec;
-  std::vector<unsigned>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, d_str.end());
-  return String(ret_vec);
+  return String(std::vector<unsigned>(d_str.begin() + i, d_str.end()));
 }
 
 String String::substr(std::size_t i, std::size_t j) const {
   Assert(i + j <= size());
-  std::vector<unsigned> ret_vec;
   std::vector<unsigned>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, itr + j);
-  return String(ret_vec);
+  return String(std::vector<unsigned>(itr, itr + j));
 }
 
 bool String::noOverlapWith(const String& y) const
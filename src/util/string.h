@@ -73,6 +73,7 @@ class String
   {
   }
   explicit String(const std::vector<unsigned>& s);
+  explicit String(std::vector<unsigned>&& s);
 
   String& operator=(const String& y) {
     if (this != &y) {
@@ -128,6 +129,8 @@ class String
   bool isLeq(const String& y) const;
   /** Return the length of the string */
   std::size_t size() const { return d_str.size(); }
+  /** Return a hash value of this string */
+  size_t hash() const;
 
   bool isRepeated() const;
   bool tailcmp(const String& y, int& c) const;
@@ -257,6 +260,12 @@ class String
    * positive number if *this > y.
    */
   int cmp(const String& y) const;
+  /**
+   * Returns true if the n characters of this string starting at index i are
+   * equal to the n characters of y starting at index j.
+   */
+  bool equalRange(std::size_t i, const String& y, std::size_t j, std::size_t n)
+      const;
 
   std::vector<unsigned> d_str;
 }; /* class String */
@@ -267,7 +276,7 @@ struct StringHashFunction
 {
   size_t operator()(const ::cvc5::String& s) const
   {
-    return std::hash<std::string>()(s.toString());
+    return s.hash();
   }
 }; /* struct StringHashFunction */
 
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#####################
+#! \file api_trace_replay.py
+## \verbatim
+## Top contributors (to current version):
+##   agent
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+## in the top-level source directory) and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.\endverbatim
+##
+## \brief Records a trace of API calls with --api-trace and replays it with
+## cvc4-replay
+#####################
+
+import os
+import subprocess
+import sys
+import tempfile
+
+BENCHMARK = """
+(set-option :incremental true)
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (+ x y) 2))
+(check-sat)
+(push 1)
+(assert (< x 0))
+(assert (< y 0))
+(check-sat)
+(pop 1)
+(check-sat-assuming ((= x 3)))
+"""
+
+EXPECTED = ["sat", "unsat", "sat"]
+
+
+def check_api_trace_replay(trace):
+    """
+    Records the API calls of CVC4 on BENCHMARK in trace, replays them, and
+    checks that the results are the same. Returns 0 on success.
+    """
+
+    # Record the trace
+    cvc4 = subprocess.run(
+        ["bin/cvc4", "--lang=smt2", "--api-trace=" + trace],
+        input=BENCHMARK.encode(),
+        stdout=subprocess.PIPE)
+    if cvc4.returncode != 0 or cvc4.stdout.decode().split() != EXPECTED:
+        print("unexpected output of cvc4: " + cvc4.stdout.decode())
+        return 1
+
+    # Replay the trace, which has the same results without errors
+    replay = subprocess.run(["bin/cvc4-replay", trace],
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE)
+    if replay.returncode != 0 or replay.stdout.decode().split() != EXPECTED:
+        print("unexpected output of cvc4-replay: " + replay.stdout.decode())
+        print(replay.stderr.decode())
+        return 1
+
+    # Replay a truncated trace, which is reported
+    with open(trace, "rb") as f:
+        data = f.read()
+    with open(trace, "wb") as f:
+        f.write(data[:-1])
+    replay = subprocess.run(["bin/cvc4-replay", trace],
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE)
+    if (replay.returncode != 1
+            or "truncated or malformed trace" not in replay.stderr.decode()):
+        print("truncated trace not reported: " + replay.stderr.decode())
+        return 1
+
+    return 0
+
+
+def main():
+    """
+    Runs the test from the build directory, in which the binaries are in bin/
+    """
+
+    fd, trace = tempfile.mkstemp(prefix="cvc4_api_trace")
+    os.close(fd)
+    try:
+        sys.exit(check_api_trace_replay(trace))
+    finally:
+        os.remove(trace)
+
+if __name__ == "__main__":
+    main()
+
+# EOF
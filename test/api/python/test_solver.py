@@ -0,0 +1,61 @@
+#####################
+## test_solver.py
+## Top contributors (to current version):
+##   agent
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+## in the top-level source directory and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+from array import array
+import pytest
+
+import pycvc4
+from pycvc4 import kinds
+
+
+def testMkTerms():
+    solver = pycvc4.Solver()
+    intSort = solver.getIntegerSort()
+    x = solver.mkConst(intSort, "x")
+    y = solver.mkConst(intSort, "y")
+    terms = solver.mkTerms([x, y], [kinds.Plus, kinds.Mult],
+                           array('I', [2, 0, 1, 2, 2, 0]))
+    assert len(terms) == 2
+    assert terms[0] == solver.mkTerm(kinds.Plus, x, y)
+    assert terms[1] == solver.mkTerm(kinds.Mult, terms[0], x)
+    with pytest.raises(RuntimeError):
+        solver.mkTerms([x, y], [kinds.Plus], [2, 0, 2])
+
+
+def testGetValues():
+    solver = pycvc4.Solver()
+    solver.setOption("produce-models", "true")
+    intSort = solver.getIntegerSort()
+    x = solver.mkConst(intSort, "x")
+    y = solver.mkConst(intSort, "y")
+    solver.assertFormula(solver.mkTerm(kinds.Equal, x, solver.mkInteger(3)))
+    solver.assertFormula(solver.mkTerm(kinds.Equal, y, solver.mkInteger(4)))
+    assert solver.checkSat().isSat()
+    values = solver.getValues([x, y])
+    assert [v.toPythonObj() for v in values] == [3, 4]
+
+
+def testGetBitVectorValues():
+    solver = pycvc4.Solver()
+    solver.setOption("produce-models", "true")
+    bvSort = solver.mkBitVectorSort(64)
+    x = solver.mkConst(bvSort, "x")
+    y = solver.mkConst(bvSort, "y")
+    solver.assertFormula(solver.mkTerm(
+        kinds.Equal, x, solver.mkBitVector("8000000000000005", 16)))
+    solver.assertFormula(
+        solver.mkTerm(kinds.Equal, y, solver.mkBitVector(64, 7)))
+    assert solver.checkSat().isSat()
+    values = solver.getBitVectorValues([x, y])
+    assert values.typecode == 'Q'
+    assert list(values) == [2**63 + 5, 7]
+    intSort = solver.getIntegerSort()
+    with pytest.raises(ValueError):
+        solver.getBitVectorValues([solver.mkConst(intSort, "z")])
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+#####################
+#! \file server_mode.py
+## \verbatim
+## Top contributors (to current version):
+##   agent
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+## in the top-level source directory) and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.\endverbatim
+##
+## \brief Sends SMT-LIB 2 scripts to CVC4 running with --server
+#####################
+
+import os
+import socket
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+SAT_SCRIPT = """
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(assert (> x 2))
+(check-sat)
+"""
+
+UNSAT_SCRIPT = """
+(set-option :incremental true)
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(assert (> x 2))
+(check-sat)
+(assert (< x 0))
+(check-sat)
+"""
+
+
+def send_script(address, script):
+    """
+    Sends script to the server listening on the unix socket address and
+    returns its response.
+    """
+
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as s:
+        s.connect(address)
+        s.sendall(script.encode())
+        s.shutdown(socket.SHUT_WR)
+        response = b""
+        while True:
+            data = s.recv(4096)
+            if not data:
+                break
+            response += data
+    return response.decode()
+
+
+def check_server(address):
+    """
+    Starts CVC4 as a server on address and checks that requests, including
+    concurrent ones, are answered independently. Returns 0 on success.
+    """
+
+    server = subprocess.Popen(["bin/cvc4", "--server=" + address])
+    try:
+        # Wait for the server to listen
+        for _ in range(100):
+            if os.path.exists(address):
+                break
+            time.sleep(0.1)
+
+        # The declarations of a request are not visible to the next one
+        for script, expected in [(SAT_SCRIPT, ["sat"]),
+                                 (UNSAT_SCRIPT, ["sat", "unsat"]),
+                                 (SAT_SCRIPT, ["sat"])]:
+            response = send_script(address, script)
+            if response.split() != expected:
+                print("unexpected response: " + response)
+                return 1
+
+        # Concurrent requests
+        responses = [None] * 8
+        def request(i):
+            script = SAT_SCRIPT if i % 2 == 0 else UNSAT_SCRIPT
+            responses[i] = send_script(address, script)
+        threads = [threading.Thread(target=request, args=(i,))
+                   for i in range(len(responses))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for i, response in enumerate(responses):
+            expected = ["sat"] if i % 2 == 0 else ["sat", "unsat"]
+            if response.split() != expected:
+                print("unexpected response: " + response)
+                return 1
+
+        # The error of a request is reported, and the server keeps running
+        response = send_script(address, "(assert (> y 0))")
+        if "error" not in response:
+            print("unexpected response: " + response)
+            return 1
+        response = send_script(address, SAT_SCRIPT)
+        if response.split() != ["sat"] or server.poll() is not None:
+            print("server did not survive an erroneous request")
+            return 1
+    finally:
+        server.kill()
+        server.wait()
+
+    return 0
+
+
+def main():
+    """
+    Runs the test from the build directory, in which the binaries are in bin/
+    """
+
+    tmpdir = tempfile.mkdtemp(prefix="cvc4_server")
+    address = os.path.join(tmpdir, "socket")
+    try:
+        sys.exit(check_server(address))
+    finally:
+        if os.path.exists(address):
+            os.remove(address)
+        os.rmdir(tmpdir)
+
+if __name__ == "__main__":
+    main()
+
+# EOF
@@ -0,0 +1,55 @@
+/*********************                                                        */
+/*! \file benchmark_smt.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Common environment of the microbenchmarks.
+ **/
+
+#ifndef CVC4__TEST__BENCHMARK__BENCHMARK_SMT_H
+#define CVC4__TEST__BENCHMARK__BENCHMARK_SMT_H
+
+#include <memory>
+
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+
+namespace cvc5 {
+namespace test {
+
+/**
+ * A node manager and an initialized SmtEngine in scope, for the lifetime of
+ * this object. Benchmarks create one per run, outside of the timed loop.
+ */
+class BenchmarkSmt
+{
+ public:
+  BenchmarkSmt()
+      : d_nodeManager(new NodeManager()),
+        d_nmScope(new NodeManagerScope(d_nodeManager.get())),
+        d_smtEngine(new SmtEngine(d_nodeManager.get()))
+  {
+    d_smtEngine->finishInit();
+    d_smtScope.reset(new smt::SmtScope(d_smtEngine.get()));
+  }
+
+  NodeManager* getNodeManager() { return d_nodeManager.get(); }
+  SmtEngine* getSmtEngine() { return d_smtEngine.get(); }
+
+ private:
+  std::unique_ptr<NodeManager> d_nodeManager;
+  std::unique_ptr<NodeManagerScope> d_nmScope;
+  std::unique_ptr<SmtEngine> d_smtEngine;
+  std::unique_ptr<smt::SmtScope> d_smtScope;
+};
+
+}  // namespace test
+}  // namespace cvc5
+#endif
@@ -0,0 +1,141 @@
+/*********************                                                        */
+/*! \file cnf_stream_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of the CNF conversion of CnfStream.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "benchmark_smt.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "prop/cnf_stream.h"
+#include "prop/registrar.h"
+#include "prop/sat_solver.h"
+
+namespace cvc5 {
+namespace test {
+
+using namespace prop;
+
+namespace {
+
+/**
+ * A SAT solver that only counts clauses, so that the benchmarks measure the
+ * conversion. This relies on the fact that a MiniSat variable is an int.
+ */
+class CountingSatSolver : public SatSolver
+{
+ public:
+  CountingSatSolver() : d_nextVar(0), d_numClauses(0) {}
+  SatVariable newVar(bool theoryAtom, bool preRegister, bool canErase) override
+  {
+    return d_nextVar++;
+  }
+  SatVariable trueVar() override { return d_nextVar++; }
+  SatVariable falseVar() override { return d_nextVar++; }
+  ClauseId addClause(SatClause& c, bool lemma) override
+  {
+    d_numClauses++;
+    return ClauseIdUndef;
+  }
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
+  {
+    d_numClauses++;
+    return ClauseIdUndef;
+  }
+  bool nativeXor() override { return false; }
+  unsigned getAssertionLevel() const override { return 0; }
+  void interrupt() override {}
+  SatValue solve() override { return SAT_VALUE_UNKNOWN; }
+  SatValue solve(long unsigned int& resource) override
+  {
+    return SAT_VALUE_UNKNOWN;
+  }
+  SatValue value(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
+  SatValue modelValue(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
+  bool ok() const override { return true; }
+  uint64_t getNumClauses() const { return d_numClauses; }
+
+ private:
+  SatVariable d_nextVar;
+  uint64_t d_numClauses;
+};
+
+/**
+ * A formula over n Boolean variables with shared subformulas of all kinds
+ * handled by the conversion.
+ */
+Node mkCircuit(NodeManager* nm, size_t n)
+{
+  std::vector<Node> level;
+  for (size_t i = 0; i < n; ++i)
+  {
+    level.push_back(nm->mkVar(nm->booleanType()));
+  }
+  const Kind kinds[] = {kind::AND, kind::OR, kind::XOR, kind::EQUAL};
+  for (size_t k = 0; level.size() > 1; ++k)
+  {
+    std::vector<Node> next;
+    for (size_t i = 0; i + 1 < level.size(); i += 2)
+    {
+      Node a = level[i];
+      Node b = level[i + 1];
+      if (i % 6 == 4)
+      {
+        next.push_back(nm->mkNode(kind::ITE, a, b, a.notNode()));
+      }
+      else
+      {
+        next.push_back(nm->mkNode(kinds[(i + k) % 4], a, b));
+      }
+    }
+    if (level.size() % 2 == 1)
+    {
+      next.push_back(level.back());
+    }
+    level = next;
+  }
+  return level[0];
+}
+
+/** Convert and assert the circuit in a pushed context, and pop it. */
+void BM_CnfStreamConvert(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  SmtEngine* smt = env.getSmtEngine();
+  CountingSatSolver satSolver;
+  NullRegistrar registrar;
+  context::Context context;
+  CnfStream cnf(&satSolver,
+                &registrar,
+                &context,
+                &smt->getOutputManager(),
+                smt->getResourceManager());
+  Node f = mkCircuit(env.getNodeManager(), state.range(0));
+  for (auto _ : state)
+  {
+    context.push();
+    cnf.convertAndAssert(f, false, false);
+    context.pop();
+  }
+  state.counters["clauses"] = benchmark::Counter(
+      satSolver.getNumClauses(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CnfStreamConvert)->Arg(1 << 8)->Arg(1 << 14);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
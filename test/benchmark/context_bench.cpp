@@ -0,0 +1,134 @@
+/*********************                                                        */
+/*! \file context_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of context-dependent data structures.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include "context/cdhashmap.h"
+#include "context/cdlist.h"
+#include "context/context.h"
+
+namespace cvc5 {
+namespace test {
+
+using cvc5::context::CDHashMap;
+using cvc5::context::CDList;
+using cvc5::context::Context;
+
+namespace {
+
+/** Insert n keys in a pushed context, and pop it. */
+void BM_CDHashMapInsertPop(benchmark::State& state)
+{
+  Context context;
+  CDHashMap<int32_t, int32_t> map(&context);
+  int32_t n = state.range(0);
+  for (auto _ : state)
+  {
+    context.push();
+    for (int32_t i = 0; i < n; ++i)
+    {
+      map.insert(i, i);
+    }
+    context.pop();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CDHashMapInsertPop)->Arg(1 << 8)->Arg(1 << 16);
+
+/** Overwrite n keys, one context level per key, and pop all levels. */
+void BM_CDHashMapOverwriteLevels(benchmark::State& state)
+{
+  Context context;
+  CDHashMap<int32_t, int32_t> map(&context);
+  int32_t n = state.range(0);
+  for (int32_t i = 0; i < n; ++i)
+  {
+    map.insert(i, 0);
+  }
+  for (auto _ : state)
+  {
+    for (int32_t i = 0; i < n; ++i)
+    {
+      context.push();
+      map[i] = i;
+    }
+    context.popto(0);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CDHashMapOverwriteLevels)->Arg(1 << 8)->Arg(1 << 12);
+
+/** Look up n keys. */
+void BM_CDHashMapFind(benchmark::State& state)
+{
+  Context context;
+  CDHashMap<int32_t, int32_t> map(&context);
+  int32_t n = state.range(0);
+  for (int32_t i = 0; i < n; ++i)
+  {
+    map.insert(i, i);
+  }
+  for (auto _ : state)
+  {
+    for (int32_t i = 0; i < n; ++i)
+    {
+      benchmark::DoNotOptimize(map.find(i));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CDHashMapFind)->Arg(1 << 8)->Arg(1 << 16);
+
+/** Push back n elements in a pushed context, and pop it. */
+void BM_CDListPushBackPop(benchmark::State& state)
+{
+  Context context;
+  CDList<int32_t> list(&context);
+  int32_t n = state.range(0);
+  for (auto _ : state)
+  {
+    context.push();
+    for (int32_t i = 0; i < n; ++i)
+    {
+      list.push_back(i);
+    }
+    context.pop();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CDListPushBackPop)->Arg(1 << 8)->Arg(1 << 16);
+
+/** Push back one element per context level, and pop all levels. */
+void BM_CDListPushBackLevels(benchmark::State& state)
+{
+  Context context;
+  CDList<int32_t> list(&context);
+  int32_t n = state.range(0);
+  for (auto _ : state)
+  {
+    for (int32_t i = 0; i < n; ++i)
+    {
+      context.push();
+      list.push_back(i);
+    }
+    context.popto(0);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CDListPushBackLevels)->Arg(1 << 8)->Arg(1 << 12);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,118 @@
+/*********************                                                        */
+/*! \file equality_engine_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of merging and explaining in the EqualityEngine.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "benchmark_smt.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "theory/uf/equality_engine.h"
+
+namespace cvc5 {
+namespace test {
+
+using namespace theory;
+using namespace theory::eq;
+
+namespace {
+
+/**
+ * Terms x_0, ..., x_n and f(x_0), ..., f(x_n) of an uninterpreted sort, and
+ * the equalities x_i = x_{i+1}.
+ */
+class ChainTerms
+{
+ public:
+  ChainTerms(NodeManager* nm, size_t n)
+  {
+    TypeNode sort = nm->mkSort("U");
+    Node f = nm->mkVar("f", nm->mkFunctionType(sort, sort));
+    for (size_t i = 0; i <= n; ++i)
+    {
+      d_vars.push_back(nm->mkVar(sort));
+      d_apps.push_back(nm->mkNode(kind::APPLY_UF, f, d_vars.back()));
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+      d_eqs.push_back(d_vars[i].eqNode(d_vars[i + 1]));
+    }
+  }
+
+  /** Add the terms to ee */
+  void addTerms(EqualityEngine& ee) const
+  {
+    for (const Node& app : d_apps)
+    {
+      ee.addTerm(app);
+    }
+  }
+
+  std::vector<Node> d_vars;
+  std::vector<Node> d_apps;
+  std::vector<Node> d_eqs;
+};
+
+/** Merge a chain of n equalities, with congruence, and backtrack. */
+void BM_EqualityEngineMerge(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  context::Context context;
+  EqualityEngine ee(&context, "bench", false);
+  ee.addFunctionKind(kind::APPLY_UF);
+  ChainTerms terms(env.getNodeManager(), state.range(0));
+  terms.addTerms(ee);
+  for (auto _ : state)
+  {
+    context.push();
+    for (const Node& eq : terms.d_eqs)
+    {
+      ee.assertEquality(eq, true, eq);
+    }
+    context.pop();
+  }
+  state.SetItemsProcessed(state.iterations() * terms.d_eqs.size());
+}
+BENCHMARK(BM_EqualityEngineMerge)->Arg(1 << 6)->Arg(1 << 12);
+
+/** Explain f(x_0) = f(x_n) after merging the chain. */
+void BM_EqualityEngineExplain(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  context::Context context;
+  EqualityEngine ee(&context, "bench", false);
+  ee.addFunctionKind(kind::APPLY_UF);
+  ChainTerms terms(env.getNodeManager(), state.range(0));
+  terms.addTerms(ee);
+  // merge in reverse order, so that the proof forest is not a path
+  for (size_t i = terms.d_eqs.size(); i-- > 0;)
+  {
+    ee.assertEquality(terms.d_eqs[i], true, terms.d_eqs[i]);
+  }
+  for (auto _ : state)
+  {
+    std::vector<TNode> assumptions;
+    ee.explainEquality(
+        terms.d_apps.front(), terms.d_apps.back(), true, assumptions);
+    benchmark::DoNotOptimize(assumptions.data());
+  }
+}
+BENCHMARK(BM_EqualityEngineExplain)->Arg(1 << 6)->Arg(1 << 12);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
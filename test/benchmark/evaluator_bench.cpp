@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file evaluator_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of evaluating a term under many substitutions.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "benchmark_smt.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "theory/evaluator.h"
+#include "util/bitvector.h"
+
+namespace cvc5 {
+namespace test {
+
+using namespace theory;
+
+namespace {
+
+/**
+ * The variables x, y of sort (_ BitVec 64), a term over them with n
+ * operators, and 64 substitutions of constants for them.
+ */
+class EvalTerm
+{
+ public:
+  EvalTerm(NodeManager* nm, size_t n)
+  {
+    TypeNode bv64 = nm->mkBitVectorType(64);
+    d_args.push_back(nm->mkVar("x", bv64));
+    d_args.push_back(nm->mkVar("y", bv64));
+    const Kind kinds[] = {
+        kind::BITVECTOR_PLUS, kind::BITVECTOR_MULT, kind::BITVECTOR_XOR};
+    d_term = d_args[0];
+    for (size_t i = 0; i < n; ++i)
+    {
+      d_term = nm->mkNode(kinds[i % 3], d_term, d_args[i % 2]);
+    }
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+      d_vals.push_back({nm->mkConst(BitVector(64, i * 7919u)),
+                        nm->mkConst(BitVector(64, i * 104729u + 1))});
+    }
+  }
+
+  std::vector<Node> d_args;
+  Node d_term;
+  std::vector<std::vector<Node>> d_vals;
+};
+
+/** Evaluate with Evaluator::eval on each substitution. */
+void BM_Evaluator(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  EvalTerm t(env.getNodeManager(), state.range(0));
+  Evaluator ev;
+  for (auto _ : state)
+  {
+    for (const std::vector<Node>& vals : t.d_vals)
+    {
+      benchmark::DoNotOptimize(ev.eval(t.d_term, t.d_args, vals, false));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * t.d_vals.size());
+}
+BENCHMARK(BM_Evaluator)->Arg(1 << 4)->Arg(1 << 8);
+
+/** Evaluate with a PreparedEvaluator on each substitution. */
+void BM_PreparedEvaluator(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  EvalTerm t(env.getNodeManager(), state.range(0));
+  PreparedEvaluator pe;
+  if (!pe.prepare(t.d_term, t.d_args))
+  {
+    state.SkipWithError("term cannot be prepared");
+    return;
+  }
+  for (auto _ : state)
+  {
+    for (const std::vector<Node>& vals : t.d_vals)
+    {
+      benchmark::DoNotOptimize(pe.eval(vals));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * t.d_vals.size());
+}
+BENCHMARK(BM_PreparedEvaluator)->Arg(1 << 4)->Arg(1 << 8);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file matrix_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of pivots in the tableau of the arithmetic solver.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "theory/arith/matrix.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+namespace test {
+
+using namespace theory::arith;
+
+namespace {
+
+/**
+ * Build a tableau with m rows, for the basic variables 0, ..., m - 1, over
+ * the non-basic variables m, ..., 2m - 1, with k random entries per row.
+ */
+void mkTableau(Tableau& tab, size_t m, size_t k, std::mt19937& rng)
+{
+  tab.increaseSizeTo(2 * m);
+  std::uniform_int_distribution<ArithVar> var(m, 2 * m - 1);
+  std::uniform_int_distribution<int> coeff(-9, 9);
+  for (ArithVar b = 0; b < m; ++b)
+  {
+    std::vector<ArithVar> vars;
+    std::vector<Rational> coeffs;
+    while (vars.size() < k)
+    {
+      ArithVar v = var(rng);
+      int c = coeff(rng);
+      if (c != 0 && std::find(vars.begin(), vars.end(), v) == vars.end())
+      {
+        vars.push_back(v);
+        coeffs.push_back(Rational(c));
+      }
+    }
+    tab.addRow(b, coeffs, vars);
+  }
+}
+
+/** Pivot a random basic variable with a random variable of its row. */
+void BM_TableauPivot(benchmark::State& state)
+{
+  std::mt19937 rng(0);
+  Tableau tab;
+  size_t m = state.range(0);
+  mkTableau(tab, m, 5, rng);
+  std::vector<ArithVar> basics;
+  for (ArithVar b = 0; b < m; ++b)
+  {
+    basics.push_back(b);
+  }
+  NoEffectCCCB cb;
+  for (auto _ : state)
+  {
+    size_t i = rng() % basics.size();
+    ArithVar basic = basics[i];
+    ArithVar entering = basic;
+    for (Tableau::RowIterator it = tab.basicRowIterator(basic); !it.atEnd();
+         ++it)
+    {
+      if ((*it).getColVar() != basic)
+      {
+        entering = (*it).getColVar();
+        if (rng() % 2 == 0)
+        {
+          break;
+        }
+      }
+    }
+    tab.pivot(basic, entering, cb);
+    basics[i] = entering;
+  }
+  state.counters["entries"] = tab.getNumEntriesInTableau();
+}
+BENCHMARK(BM_TableauPivot)->Arg(1 << 6)->Arg(1 << 10);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file node_manager_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of NodeManager::mkNode.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "benchmark_smt.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+
+namespace cvc5 {
+namespace test {
+
+namespace {
+
+/** Fresh applications: each node is created and garbage collected. */
+void BM_MkNodeFresh(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  NodeManager* nm = env.getNodeManager();
+  size_t n = state.range(0);
+  std::vector<Node> vars;
+  for (size_t i = 0; i <= n; ++i)
+  {
+    vars.push_back(nm->mkVar(nm->integerType()));
+  }
+  for (auto _ : state)
+  {
+    std::vector<Node> terms;
+    terms.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      terms.push_back(nm->mkNode(kind::PLUS, vars[i], vars[i + 1]));
+    }
+    benchmark::DoNotOptimize(terms.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_MkNodeFresh)->Arg(1 << 10)->Arg(1 << 16);
+
+/** Applications that already exist: each mkNode is a hash-consing hit. */
+void BM_MkNodeHit(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  NodeManager* nm = env.getNodeManager();
+  size_t n = state.range(0);
+  std::vector<Node> vars;
+  std::vector<Node> terms;
+  for (size_t i = 0; i <= n; ++i)
+  {
+    vars.push_back(nm->mkVar(nm->integerType()));
+  }
+  for (size_t i = 0; i < n; ++i)
+  {
+    terms.push_back(nm->mkNode(kind::PLUS, vars[i], vars[i + 1]));
+  }
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      Node t = nm->mkNode(kind::PLUS, vars[i], vars[i + 1]);
+      benchmark::DoNotOptimize(t);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_MkNodeHit)->Arg(1 << 10)->Arg(1 << 16);
+
+/** A deep chain of applications, each with the previous as a child. */
+void BM_MkNodeChain(benchmark::State& state)
+{
+  BenchmarkSmt env;
+  NodeManager* nm = env.getNodeManager();
+  size_t n = state.range(0);
+  Node x = nm->mkVar(nm->mkBitVectorType(32));
+  Node y = nm->mkVar(nm->mkBitVectorType(32));
+  for (auto _ : state)
+  {
+    Node t = x;
+    for (size_t i = 0; i < n; ++i)
+    {
+      t = nm->mkNode(kind::BITVECTOR_PLUS, t, i % 2 == 0 ? y : x);
+    }
+    benchmark::DoNotOptimize(t);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_MkNodeChain)->Arg(1 << 10)->Arg(1 << 14);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
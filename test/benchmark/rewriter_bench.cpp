@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file rewriter_bench.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Microbenchmarks of Rewriter::rewrite on common shapes of terms.
+ **/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "benchmark_smt.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/rewriter.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+namespace test {
+
+using namespace theory;
+
+namespace {
+
+/**
+ * Rewrite the term built by mkTerm(nm, n) with empty rewrite caches. The
+ * cache is cleared outside of the timed region, such that each iteration
+ * measures a full rewrite.
+ */
+template <class F>
+void rewriteTerm(benchmark::State& state, F mkTerm)
+{
+  BenchmarkSmt env;
+  NodeManager* nm = env.getNodeManager();
+  Node t = mkTerm(nm, state.range(0));
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    Rewriter::clearCaches();
+    state.ResumeTiming();
+    Node r = Rewriter::rewrite(t);
+    benchmark::DoNotOptimize(r);
+  }
+}
+
+/** A sum of n products 2 * x_i, with constants interleaved */
+Node mkArithSum(NodeManager* nm, size_t n)
+{
+  std::vector<Node> children;
+  Node two = nm->mkConst(Rational(2));
+  for (size_t i = 0; i < n; ++i)
+  {
+    Node x = nm->mkVar(nm->integerType());
+    children.push_back(nm->mkNode(kind::MULT, two, x));
+    children.push_back(nm->mkConst(Rational(i)));
+  }
+  return nm->mkNode(kind::PLUS, children);
+}
+
+/** A left-nested chain of n bit-vector additions and multiplications */
+Node mkBvChain(NodeManager* nm, size_t n)
+{
+  TypeNode bv32 = nm->mkBitVectorType(32);
+  Node x = nm->mkVar(bv32);
+  Node t = x;
+  for (size_t i = 0; i < n; ++i)
+  {
+    Node c = bv::utils::mkConst(32, static_cast<unsigned>(i));
+    t = nm->mkNode(
+        i % 2 == 0 ? kind::BITVECTOR_PLUS : kind::BITVECTOR_MULT, t, c);
+  }
+  return nm->mkNode(kind::EQUAL, t, x);
+}
+
+/** A balanced Boolean formula over n variables with repeated literals */
+Node mkBoolTree(NodeManager* nm, size_t n)
+{
+  std::vector<Node> level;
+  for (size_t i = 0; i < n; ++i)
+  {
+    level.push_back(nm->mkVar(nm->booleanType()));
+  }
+  for (size_t k = 0; level.size() > 1; ++k)
+  {
+    std::vector<Node> next;
+    for (size_t i = 0; i + 1 < level.size(); i += 2)
+    {
+      Kind kind = k % 2 == 0 ? kind::AND : kind::OR;
+      next.push_back(nm->mkNode(kind, level[i], level[i + 1], level[i]));
+    }
+    if (level.size() % 2 == 1)
+    {
+      next.push_back(level.back().notNode());
+    }
+    level = next;
+  }
+  return level[0];
+}
+
+void BM_RewriteArithSum(benchmark::State& state)
+{
+  rewriteTerm(state, mkArithSum);
+}
+BENCHMARK(BM_RewriteArithSum)->Arg(1 << 6)->Arg(1 << 10);
+
+void BM_RewriteBvChain(benchmark::State& state)
+{
+  rewriteTerm(state, mkBvChain);
+}
+BENCHMARK(BM_RewriteBvChain)->Arg(1 << 6)->Arg(1 << 10);
+
+void BM_RewriteBoolTree(benchmark::State& state)
+{
+  rewriteTerm(state, mkBoolTree);
+}
+BENCHMARK(BM_RewriteBoolTree)->Arg(1 << 8)->Arg(1 << 12);
+
+}  // namespace
+
+}  // namespace test
+}  // namespace cvc5
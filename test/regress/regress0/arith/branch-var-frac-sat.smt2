@@ -0,0 +1,14 @@
+; COMMAND-LINE: --arith-branch-var=rr
+; COMMAND-LINE: --arith-branch-var=frac
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (= (+ (* 3 x) (* 5 y) (* 7 z)) 101))
+(assert (>= (* 2 x) (+ y 3)))
+(assert (<= (* 4 z) (+ x 1)))
+(assert (<= 0 x 20))
+(assert (<= 0 y 20))
+(assert (<= 1 z 20))
+(check-sat)
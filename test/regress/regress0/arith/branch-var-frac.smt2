@@ -0,0 +1,13 @@
+; COMMAND-LINE: --arith-branch-var=rr
+; COMMAND-LINE: --arith-branch-var=frac
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+; the relaxation is feasible, but there is no integral solution
+(assert (= (+ (* 2 x) (* 4 y) (* 6 z)) 7))
+(assert (<= 0 x 10))
+(assert (<= 0 y 10))
+(assert (<= 0 z 10))
+(check-sat)
@@ -0,0 +1,13 @@
+; REQUIRES: cadical
+; COMMAND-LINE: --sat-solver=cadical
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (or (> (+ x y) 10) (< (- x z) (- 5))))
+(assert (or (<= x 3) (>= y 8)))
+(assert (or (= z (* 2 y)) (> z 20)))
+(assert (and (>= x 0) (>= y 0) (<= z 30)))
+(assert (not (= (+ x y z) 17)))
+(check-sat)
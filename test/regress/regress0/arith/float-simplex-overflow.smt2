@@ -0,0 +1,17 @@
+; COMMAND-LINE: --arith-float-simplex --arith-int64-simplex
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+; coefficients whose products do not fit in 64 bits, so that the exact
+; simplex gives up and the floating point one is used
+(assert (>= (+ (* 9223372036854775 x) (* 4611686018427387 y)) 1))
+(assert (<= (- (* 3074457345618258 x) (* 6148914691236517 z)) 2))
+(assert (>= (+ y (* 1152921504606846976 z)) (- 5)))
+(check-sat)
+(assert (<= x 0))
+(assert (<= y 0))
+(check-sat)
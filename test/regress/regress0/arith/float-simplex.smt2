@@ -0,0 +1,19 @@
+; COMMAND-LINE: --arith-float-simplex
+; COMMAND-LINE: --arith-float-simplex --arith-int64-simplex
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (>= (+ (* 3 x) (* 2 y) (- z)) 1))
+(assert (<= (+ x (- y) (* (/ 1 3) z)) (/ 7 2)))
+(assert (> (+ (* 2 x) y z) 0))
+(assert (< (- x (* 4 z)) 5))
+(assert (and (>= x (- 10)) (<= y 10) (>= z (- 3))))
+(check-sat)
+(assert (< (+ (* 3 x) (* 2 y) z) (- 40)))
+(assert (>= x 0))
+(assert (>= y 0))
+(check-sat)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --pb-native
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun x () Int)
+(assert (= (+ (ite a 3 0) (ite b 2 0) (ite c 1 0)) 4))
+(assert (or a (> x 5)))
+(assert (< x 5))
+(check-sat)
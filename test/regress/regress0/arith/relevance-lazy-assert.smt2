@@ -0,0 +1,16 @@
+; COMMAND-LINE: --incremental --relevance-lazy-assert
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+; the atoms under the disjunction not chosen are irrelevant
+(assert (or (and (> x 5) (< y 0)) (and p (= x (+ y 3)))))
+(assert (=> p (> y 10)))
+(assert (< x 10))
+(check-sat)
+(assert (< x 5))
+(assert (>= y 0))
+(assert (< y 2))
+(check-sat)
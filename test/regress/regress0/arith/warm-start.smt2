@@ -0,0 +1,22 @@
+; COMMAND-LINE: --incremental --arith-warm-start
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (<= (+ x y z) 10))
+(assert (>= (- x y) 1))
+(assert (>= z 2))
+(check-sat)
+(push 1)
+(assert (>= (+ x (* 2 y)) 6))
+(check-sat)
+; the last feasible basis is no longer feasible
+(assert (>= (+ y z) 9))
+(check-sat)
+(pop 1)
+(assert (<= x 3))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --arrays-lazy-row
+; EXPECT: sat
+(set-logic QF_ALIA)
+(declare-fun a () (Array Int Int))
+(declare-fun b () (Array Int Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(declare-fun k () Int)
+(declare-fun v () Int)
+(declare-fun w () Int)
+(assert (= b (store (store a i v) j w)))
+(assert (not (= (select b k) (select a k))))
+(assert (not (= (select b i) v)))
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --arrays-lazy-row
+; COMMAND-LINE: --arrays-lazy-row --arrays-eager-lemmas
+; EXPECT: unsat
+(set-logic QF_ALIA)
+(declare-fun a () (Array Int Int))
+(declare-fun b () (Array Int Int))
+(declare-fun c () (Array Int Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(declare-fun k () Int)
+(declare-fun v () Int)
+(declare-fun w () Int)
+(assert (= b (store (store a i v) j w)))
+(assert (= c (store b k (select a k))))
+(assert (not (= i j)))
+(assert (not (= i k)))
+(assert (or (not (= (select c i) v)) (not (= (select c j) (select b j)))))
+(assert (not (= j k)))
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --theory-check-adaptive
+; COMMAND-LINE: --theory-check-adaptive --incremental
+; EXPECT: unsat
+(set-logic QF_AUFBV)
+(declare-fun a () (Array (_ BitVec 8) (_ BitVec 8)))
+(declare-fun f ((_ BitVec 8)) (_ BitVec 8))
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (select a x) (f y)))
+(assert (= (bvadd x #x01) (bvadd y #x01)))
+(assert (or (not (= (f x) (select a y))) (bvult (f x) #x00)))
+(check-sat)
@@ -0,0 +1,33 @@
+; COMMAND-LINE: --incremental --cnf-gate-simp --no-check-proofs
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun x () U)
+(declare-fun y () U)
+(declare-fun f (U) U)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+; gates that share the AND of a and b
+(assert (=> (and a b) c))
+(assert (or (and b a) (= (f x) y)))
+(assert (ite a (not (= (f x) y)) c))
+; a complementary input makes the inner AND false
+(assert (not (and c (not c) b)))
+(check-sat)
+(push 1)
+(assert (not c))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (xor a b))
+(assert (= a (not b)))
+(assert (ite b b a))
+(check-sat)
+(pop 1)
+; an ITE with equal branches
+(assert (and (ite a b b) (not b)))
+(check-sat)
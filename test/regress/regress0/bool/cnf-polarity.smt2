@@ -0,0 +1,22 @@
+; COMMAND-LINE: --incremental --cnf-polarity --no-check-proofs
+; COMMAND-LINE: --cnf-polarity --no-check-proofs
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun x () U)
+(declare-fun y () U)
+(declare-fun f (U) U)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+; formulas occurring positively, negatively and in both polarities
+(assert (=> (and a b) c))
+(assert (or (and b a) (= (f x) y)))
+(assert (ite a (not (= (f x) y)) c))
+(assert (= (or a c) (not (and b (= x y)))))
+(check-sat)
+(assert (not c))
+(assert (= x y))
+(check-sat)
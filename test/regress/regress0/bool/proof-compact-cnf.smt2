@@ -0,0 +1,12 @@
+; COMMAND-LINE: --proof-compact-cnf
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun d () Bool)
+(assert (= a (xor b c)))
+(assert (ite d (and a b) (or (not a) c)))
+(assert (=> c (not b)))
+(assert (or (and d (not b)) (and (not d) c (not a))))
+(check-sat)
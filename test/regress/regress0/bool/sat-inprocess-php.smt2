@@ -0,0 +1,117 @@
+; COMMAND-LINE: --sat-inprocess-interval=1 --no-check-proofs --no-check-unsat-cores
+; COMMAND-LINE: --sat-inprocess-interval=20 --no-check-proofs --no-check-unsat-cores
+; EXPECT: unsat
+(set-logic QF_UF)
+; 6 pigeons do not fit into 5 holes
+(declare-fun p0_0 () Bool)
+(declare-fun p0_1 () Bool)
+(declare-fun p0_2 () Bool)
+(declare-fun p0_3 () Bool)
+(declare-fun p0_4 () Bool)
+(declare-fun p1_0 () Bool)
+(declare-fun p1_1 () Bool)
+(declare-fun p1_2 () Bool)
+(declare-fun p1_3 () Bool)
+(declare-fun p1_4 () Bool)
+(declare-fun p2_0 () Bool)
+(declare-fun p2_1 () Bool)
+(declare-fun p2_2 () Bool)
+(declare-fun p2_3 () Bool)
+(declare-fun p2_4 () Bool)
+(declare-fun p3_0 () Bool)
+(declare-fun p3_1 () Bool)
+(declare-fun p3_2 () Bool)
+(declare-fun p3_3 () Bool)
+(declare-fun p3_4 () Bool)
+(declare-fun p4_0 () Bool)
+(declare-fun p4_1 () Bool)
+(declare-fun p4_2 () Bool)
+(declare-fun p4_3 () Bool)
+(declare-fun p4_4 () Bool)
+(declare-fun p5_0 () Bool)
+(declare-fun p5_1 () Bool)
+(declare-fun p5_2 () Bool)
+(declare-fun p5_3 () Bool)
+(declare-fun p5_4 () Bool)
+(assert (or p0_0 p0_1 p0_2 p0_3 p0_4))
+(assert (or p1_0 p1_1 p1_2 p1_3 p1_4))
+(assert (or p2_0 p2_1 p2_2 p2_3 p2_4))
+(assert (or p3_0 p3_1 p3_2 p3_3 p3_4))
+(assert (or p4_0 p4_1 p4_2 p4_3 p4_4))
+(assert (or p5_0 p5_1 p5_2 p5_3 p5_4))
+(assert (or (not p0_0) (not p1_0)))
+(assert (or (not p0_0) (not p2_0)))
+(assert (or (not p0_0) (not p3_0)))
+(assert (or (not p0_0) (not p4_0)))
+(assert (or (not p0_0) (not p5_0)))
+(assert (or (not p1_0) (not p2_0)))
+(assert (or (not p1_0) (not p3_0)))
+(assert (or (not p1_0) (not p4_0)))
+(assert (or (not p1_0) (not p5_0)))
+(assert (or (not p2_0) (not p3_0)))
+(assert (or (not p2_0) (not p4_0)))
+(assert (or (not p2_0) (not p5_0)))
+(assert (or (not p3_0) (not p4_0)))
+(assert (or (not p3_0) (not p5_0)))
+(assert (or (not p4_0) (not p5_0)))
+(assert (or (not p0_1) (not p1_1)))
+(assert (or (not p0_1) (not p2_1)))
+(assert (or (not p0_1) (not p3_1)))
+(assert (or (not p0_1) (not p4_1)))
+(assert (or (not p0_1) (not p5_1)))
+(assert (or (not p1_1) (not p2_1)))
+(assert (or (not p1_1) (not p3_1)))
+(assert (or (not p1_1) (not p4_1)))
+(assert (or (not p1_1) (not p5_1)))
+(assert (or (not p2_1) (not p3_1)))
+(assert (or (not p2_1) (not p4_1)))
+(assert (or (not p2_1) (not p5_1)))
+(assert (or (not p3_1) (not p4_1)))
+(assert (or (not p3_1) (not p5_1)))
+(assert (or (not p4_1) (not p5_1)))
+(assert (or (not p0_2) (not p1_2)))
+(assert (or (not p0_2) (not p2_2)))
+(assert (or (not p0_2) (not p3_2)))
+(assert (or (not p0_2) (not p4_2)))
+(assert (or (not p0_2) (not p5_2)))
+(assert (or (not p1_2) (not p2_2)))
+(assert (or (not p1_2) (not p3_2)))
+(assert (or (not p1_2) (not p4_2)))
+(assert (or (not p1_2) (not p5_2)))
+(assert (or (not p2_2) (not p3_2)))
+(assert (or (not p2_2) (not p4_2)))
+(assert (or (not p2_2) (not p5_2)))
+(assert (or (not p3_2) (not p4_2)))
+(assert (or (not p3_2) (not p5_2)))
+(assert (or (not p4_2) (not p5_2)))
+(assert (or (not p0_3) (not p1_3)))
+(assert (or (not p0_3) (not p2_3)))
+(assert (or (not p0_3) (not p3_3)))
+(assert (or (not p0_3) (not p4_3)))
+(assert (or (not p0_3) (not p5_3)))
+(assert (or (not p1_3) (not p2_3)))
+(assert (or (not p1_3) (not p3_3)))
+(assert (or (not p1_3) (not p4_3)))
+(assert (or (not p1_3) (not p5_3)))
+(assert (or (not p2_3) (not p3_3)))
+(assert (or (not p2_3) (not p4_3)))
+(assert (or (not p2_3) (not p5_3)))
+(assert (or (not p3_3) (not p4_3)))
+(assert (or (not p3_3) (not p5_3)))
+(assert (or (not p4_3) (not p5_3)))
+(assert (or (not p0_4) (not p1_4)))
+(assert (or (not p0_4) (not p2_4)))
+(assert (or (not p0_4) (not p3_4)))
+(assert (or (not p0_4) (not p4_4)))
+(assert (or (not p0_4) (not p5_4)))
+(assert (or (not p1_4) (not p2_4)))
+(assert (or (not p1_4) (not p3_4)))
+(assert (or (not p1_4) (not p4_4)))
+(assert (or (not p1_4) (not p5_4)))
+(assert (or (not p2_4) (not p3_4)))
+(assert (or (not p2_4) (not p4_4)))
+(assert (or (not p2_4) (not p5_4)))
+(assert (or (not p3_4) (not p4_4)))
+(assert (or (not p3_4) (not p5_4)))
+(assert (or (not p4_4) (not p5_4)))
+(check-sat)
@@ -0,0 +1,26 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-abstract-arith
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-abstract-arith --bv-abstract-arith-width=8
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun u () (_ BitVec 8))
+(declare-fun v () (_ BitVec 8))
+; the abstracted terms are refined until the model satisfies them
+(assert (= (bvmul x y) #x0001e240))
+(assert (bvugt x #x00000001))
+(assert (bvugt y #x00000001))
+(assert (bvult x #x00010000))
+(assert (bvult y #x00010000))
+(check-sat)
+(push 1)
+(assert (= (bvurem x #x00000002) #x00000001))
+(assert (= (bvurem y #x00000002) #x00000001))
+(check-sat)
+(pop 1)
+(assert (= (bvudiv u v) #x03))
+(assert (= (bvurem u v) #x02))
+(assert (bvugt v #x04))
+(check-sat)
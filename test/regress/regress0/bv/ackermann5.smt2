@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --ackermann --no-check-models --no-check-unsat-cores
+; COMMAND-LINE: --ackermann --ackermann-ite --no-check-models --no-check-unsat-cores
 ; EXPECT: sat
 (set-logic QF_UFBV)
 
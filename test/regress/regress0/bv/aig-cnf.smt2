@@ -0,0 +1,12 @@
+; REQUIRES: abc
+; COMMAND-LINE: --bitblast-aig --bv-aig-cnf=mapped --no-check-unsat-cores
+; COMMAND-LINE: --bitblast-aig --bv-aig-cnf=fast --no-check-unsat-cores
+; COMMAND-LINE: --bitblast-aig --bv-aig-simp=balance --no-check-unsat-cores
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+(assert (= (bvadd x y) (bvadd y z)))
+(assert (bvult (bvand x #x0f) (bvand z #x0f)))
+(check-sat)
@@ -0,0 +1,24 @@
+; COMMAND-LINE: --bv-bb-templates
+; COMMAND-LINE: --bv-bb-templates --bv-mult-bb=wallace --bv-solver=bitblast
+; COMMAND-LINE: --bv-bb-templates --bv-solver=simple
+; COMMAND-LINE: --bv-bb-templates --bitblast=eager --no-check-unsat-cores
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(declare-fun c () (_ BitVec 8))
+(declare-fun d () (_ BitVec 8))
+; terms of the same shapes, which instantiate the same templates
+(assert (= (bvmul a b) #x8f))
+(assert (= (bvmul c d) #x8f))
+(assert (bvugt a #x0a))
+(assert (bvult a #x0c))
+(assert (= c (bvadd a #x02)))
+; a = 11, b = 13, c = 13 and d = 11
+(assert (or (not (= d #x0b))
+            (not (= (bvudiv b c) #x01))
+            (not (= (bvurem c a) #x02))
+            (not (= (bvshl a #x02) #x2c))
+            (not (= (bvlshr d #x01) #x05))
+            (not (= (bvashr (bvneg c) #x02) #xfc))))
+(check-sat)
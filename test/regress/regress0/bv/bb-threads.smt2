@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-bb-threads=2
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-bb-threads=4
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(declare-fun c () (_ BitVec 8))
+(declare-fun d () (_ BitVec 8))
+; facts sharing gates, which are defined in several chunks
+(assert (= (bvadd a b) (bvmul c d)))
+(assert (bvult (bvadd a b) #x40))
+(assert (bvugt (bvadd a b) #x20))
+(assert (= (bvxor c d) #x06))
+(assert (not (= (bvmul c d) #x00)))
+(check-sat)
+(assert (= (bvand c #x01) #x00))
+(assert (= (bvand d #x01) #x00))
+(assert (= (bvand a #x03) #x01))
+(assert (= (bvand b #x03) #x02))
+(check-sat)
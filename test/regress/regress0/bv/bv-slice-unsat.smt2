@@ -0,0 +1,10 @@
+; COMMAND-LINE: --bv-slice
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(assert (= x y))
+(assert (= ((_ extract 11 4) x) #x5a))
+(assert (bvult ((_ extract 7 0) y) #x90))
+(assert (= ((_ extract 3 0) x) #xf))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --bv-slice
+; EXPECT: sat
+; EXPECT: ((x #xa53c) (y #xa53c))
+(set-logic QF_BV)
+(set-option :produce-models true)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 8))
+; the cut points of x are shared with y, which is equal to it
+(assert (= x y))
+(assert (= ((_ extract 15 8) x) #xa5))
+(assert (= ((_ extract 7 4) y) #x3))
+(assert (= ((_ extract 3 0) x) ((_ extract 3 0) z)))
+(assert (= z #xcc))
+(check-sat)
+(get-value (x y))
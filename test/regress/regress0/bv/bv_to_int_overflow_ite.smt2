@@ -0,0 +1,14 @@
+; COMMAND-LINE: --solve-bv-as-int=sum --solve-bv-as-int-overflow-ite
+; COMMAND-LINE: --solve-bv-as-int=iand --solve-bv-as-int-overflow-ite
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun z () (_ BitVec 8))
+; the additions overflow, and bvsub and bvneg are eliminated to bvadd
+(assert (bvugt x #xf0))
+(assert (bvugt y #xf0))
+(assert (= z (bvadd x y)))
+(assert (= (bvsub z x) (bvneg (bvneg y))))
+(assert (bvult z #xe2))
+(check-sat)
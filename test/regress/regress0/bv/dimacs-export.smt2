@@ -0,0 +1,9 @@
+; COMMAND-LINE: --bitblast=eager --simplification=none --bv-export-dimacs=/dev/stdout
+; SCRUBBER: grep -o -E "^(p cnf|sat)"
+; EXPECT: p cnf
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(assert (= (bvand x y) #b1111))
+(check-sat)
@@ -0,0 +1,8 @@
+; COMMAND-LINE: --bitblast=eager --simplification=none --bv-import-sat-model=dimacs-import-malformed.model
+; EXPECT: (error "unexpected line in SAT model file dimacs-import-malformed.model: v 1 -2 x 0")
+; EXIT: 1
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(assert (= (bvand x y) #b1111))
+(check-sat)
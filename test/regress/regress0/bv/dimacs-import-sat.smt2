@@ -0,0 +1,10 @@
+; COMMAND-LINE: --bitblast=eager --simplification=none --bv-import-sat-model=dimacs-import-sat.model
+; EXPECT: sat
+; EXPECT: ((x #b1111) (y #b1111))
+(set-option :produce-models true)
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(assert (= (bvand x y) #b1111))
+(check-sat)
+(get-value (x y))
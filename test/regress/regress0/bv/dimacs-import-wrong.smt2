@@ -0,0 +1,8 @@
+; COMMAND-LINE: --bitblast=eager --simplification=none --bv-import-sat-model=dimacs-import-wrong.model
+; EXPECT: (error "the model of dimacs-import-wrong.model does not satisfy the clauses of the problem")
+; EXIT: 1
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(assert (= (bvand x y) #b1111))
+(check-sat)
@@ -0,0 +1,22 @@
+; COMMAND-LINE: --incremental --bitblast=eager --bv-solver=bitblast
+; COMMAND-LINE: --incremental --bitblast=eager --bv-solver=bitblast --bv-local-search
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvadd x y) #x10))
+(check-sat)
+(push 1)
+; 2x = 19 has no solution
+(assert (= (bvsub x y) #x03))
+(check-sat)
+(pop 1)
+; the clauses of the popped assertion are kept but no longer assumed
+(assert (= (bvsub x y) #x04))
+(check-sat)
+(assert (bvult x #x0a))
+(assert (bvult y #x0a))
+(check-sat)
@@ -0,0 +1,8 @@
+; COMMAND-LINE: --bv-solver=bitblast --bv-local-search
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= (bvadd x y) #x10))
+(assert (= (bvsub x y) #x03))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --bv-solver=bitblast --bv-local-search
+; COMMAND-LINE: --bv-solver=bitblast --bv-local-search --bv-local-search-moves=1
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 16))
+(assert (= (bvadd x y) #x1234))
+(assert (bvult x y))
+(assert (= (bvand z #x00ff) #x0042))
+(assert (not (= (bvmul z #x0003) x)))
+(assert (bvuge (bvor x z) #x0100))
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --produce-models --model-lazy-eval
+; EXPECT: sat
+; EXPECT: (((bvmul x y) #x0a) ((bvadd x y) #x07) ((bvudiv (bvmul x y) y) #x05))
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (= x #x05))
+(assert (bvult y #x03))
+(assert (bvugt y #x01))
+(assert (distinct (bvmul x y) (bvadd x x x)))
+(check-sat)
+(get-value ((bvmul x y) (bvadd x y) (bvudiv (bvmul x y) y)))
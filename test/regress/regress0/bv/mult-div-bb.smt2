@@ -0,0 +1,40 @@
+; COMMAND-LINE: --incremental --bv-mult-bb=shift-add --bv-div-bb=restoring
+; COMMAND-LINE: --incremental --bv-mult-bb=wallace --bv-div-bb=non-restoring
+; COMMAND-LINE: --incremental --bv-mult-bb=booth --bv-div-bb=non-restoring
+; COMMAND-LINE: --incremental --bv-mult-bb=booth --bv-solver=bitblast
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(declare-fun q () (_ BitVec 8))
+(declare-fun r () (_ BitVec 8))
+(push 1)
+; 11 * 13 = 143
+(assert (= (bvmul x y) #x8f))
+(assert (bvugt x #x0a))
+(assert (bvult x #x0c))
+(check-sat)
+(assert (not (= y #x0d)))
+(check-sat)
+(pop 1)
+(push 1)
+; 200 = 7 * 27 + 11
+(assert (= (bvudiv x y) q))
+(assert (= (bvurem x y) r))
+(assert (= x #xc8))
+(assert (bvugt y #x1a))
+(assert (bvult y #x1c))
+(check-sat)
+(assert (not (and (= q #x07) (= r #x0b))))
+(check-sat)
+(pop 1)
+; a negative product, for the signed partial products of Booth multipliers
+(assert (= (bvmul x y) #xf4))
+(assert (bvslt x #x00))
+(assert (bvsgt x #xfc))
+(assert (bvsgt y #x00))
+(check-sat)
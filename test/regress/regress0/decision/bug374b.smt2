@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --decision=justification --no-unconstrained
+; COMMAND-LINE: --decision=justification-inc --no-unconstrained
 ; EXPECT: unsat
 
 (set-logic QF_ALL_SUPPORTED)
@@ -0,0 +1,32 @@
+; COMMAND-LINE: --decision=justification-inc
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+; term ITEs, whose skolem definitions become roots of the justification
+(assert (> (ite a (f x) (+ y 1)) (ite b z (f z))))
+(assert (or (and a (not b)) (= (f x) (f y)) (< x (ite (> y z) y z))))
+(assert (=> (and a b) (= x (+ y z))))
+(check-sat)
+(push 1)
+(assert (= x y))
+(assert (= y z))
+(assert (= (f x) x))
+(assert a)
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not a))
+(assert (>= y (f z)))
+(check-sat)
+(assert (< (+ y 1) (f z)))
+(check-sat)
+(pop 1)
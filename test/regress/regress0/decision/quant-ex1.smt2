@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --decision=justification -q
+; COMMAND-LINE: --decision=justification-inc -q
 ; EXPECT: sat
 
 (set-logic AUFLIRA)
@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --decision=justification
+; COMMAND-LINE: --decision=justification-inc
 ; EXPECT: unsat
 (set-option :incremental false)
 (set-info :status unsat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --finite-model-find --fmf-fmc-index
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun P (U U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U) (y U)) (or (= x y) (P x y))))
+(assert (forall ((x U)) (not (P x (f x)))))
+(assert (forall ((x U)) (not (= (f x) x))))
+(assert (= a (f (f a))))
+(check-sat)
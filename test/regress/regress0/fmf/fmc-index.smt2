@@ -0,0 +1,15 @@
+; COMMAND-LINE: --finite-model-find --fmf-fmc-index
+; COMMAND-LINE: --finite-model-find --fmf-fmc-index --incremental
+; EXPECT: sat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun P (U U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U)) (not (= (f x) x))))
+(assert (forall ((x U) (y U)) (=> (P x y) (not (P y x)))))
+(assert (forall ((x U) (y U)) (or (P x y) (Q y) (= x y))))
+(assert (P a (f a)))
+(assert (not (Q (f a))))
+(check-sat)
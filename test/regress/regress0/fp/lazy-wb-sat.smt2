@@ -0,0 +1,12 @@
+; REQUIRES: symfpu
+; COMMAND-LINE: --fp-lazy-wb
+; EXPECT: sat
+(set-logic QF_FP)
+(declare-const x (_ FloatingPoint 3 5))
+(declare-const y (_ FloatingPoint 3 5))
+(define-fun one () (_ FloatingPoint 3 5) ((_ to_fp 3 5) RNE 1.0))
+(assert (fp.gt x one))
+(assert (fp.isNormal y))
+(assert (fp.eq (fp.mul RNE x y) (fp.fma RNE y x (fp.rem y y))))
+(assert (fp.lt (fp.div RNE y x) y))
+(check-sat)
@@ -0,0 +1,14 @@
+; REQUIRES: symfpu
+; COMMAND-LINE: --fp-lazy-wb
+; EXPECT: unsat
+(set-logic QF_FP)
+(declare-const x (_ FloatingPoint 3 5))
+(declare-const y (_ FloatingPoint 3 5))
+(declare-const z (_ FloatingPoint 3 5))
+(define-fun one () (_ FloatingPoint 3 5) ((_ to_fp 3 5) RNE 1.0))
+(assert (fp.eq x one))
+(assert (not (fp.isNaN y)))
+(assert (or (not (fp.eq (fp.mul RNE x y) y))
+            (not (fp.eq (fp.div RNE y x) y))
+            (not (fp.eq (fp.sqrt RNE (fp.mul RNE x x)) one))))
+(check-sat)
@@ -0,0 +1,8 @@
+; COMMAND-LINE: --cube-depth=17
+; ERROR-SCRUBBER: grep -o "is not a legal setting"
+; EXPECT-ERROR: is not a legal setting
+; EXIT: 1
+(set-logic QF_UF)
+(declare-fun p () Bool)
+(assert p)
+(check-sat)
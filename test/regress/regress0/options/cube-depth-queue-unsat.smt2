@@ -0,0 +1,12 @@
+; COMMAND-LINE: --cube-depth=3 --portfolio-jobs=2 --no-check-unsat-cores --no-check-proofs
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (or (> x 3) (< y 0)))
+(assert (or (> y 2) (< z 0)))
+(assert (or (> z 1) (< x 0)))
+(assert (and (>= x 0) (>= y 0) (>= z 0)))
+(assert (< (+ x y z) 8))
+(check-sat)
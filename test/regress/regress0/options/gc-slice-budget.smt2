@@ -0,0 +1,20 @@
+; COMMAND-LINE: --gc-zombie-threshold=10
+; COMMAND-LINE: --gc-zombie-threshold=10 --gc-slice-budget=1
+; COMMAND-LINE: --gc-slice-budget=100000
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (or (> (+ x y) 10) (< (- x z) (- 5))))
+(assert (or (<= x 3) (>= y 8)))
+(assert (or (= z (* 2 y)) (> z 20)))
+(assert (and (>= x 0) (>= y 0) (<= z 30)))
+(check-sat)
+(push 1)
+(assert (< (+ x y z) 3))
+(assert (> (* 3 z) (+ x 20)))
+(check-sat)
+(pop 1)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --portfolio-jobs=2
+; COMMAND-LINE: --portfolio-jobs=3
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (or (= (f x) (+ y 1)) (> x 5)))
+(assert (distinct (f x) (f y)))
+(check-sat)
+(assert (= x y))
+(check-sat)
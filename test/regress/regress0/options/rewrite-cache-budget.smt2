@@ -0,0 +1,17 @@
+; COMMAND-LINE: --rewrite-cache-budget=1
+; COMMAND-LINE: --rewrite-cache-budget=2048
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (= (f (+ x y 1)) (+ (* 2 z) (- y x))))
+(assert (or (> (+ x (* 3 y)) (- z 2)) (= (f x) (f (+ y 1)))))
+(assert (<= (+ (f z) (* 2 (f (+ x y 1)))) (+ 7 (* 4 z) (* 2 y))))
+(check-sat)
+(assert (= x (+ y 1)))
+(assert (= (f x) (+ (f (+ y 1)) 1)))
+(check-sat)
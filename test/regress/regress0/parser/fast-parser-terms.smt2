@@ -0,0 +1,26 @@
+; COMMAND-LINE: --smt2-fast-parser --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic ALL)
+(define-sort Byte () (_ BitVec 8))
+(declare-fun |a b| () Byte)
+(declare-fun s () String)
+(declare-fun r () Real)
+(assert (! (let ((x ((_ extract 3 0) |a b|)))
+             (let ((y (bvadd x #b0001)))
+               (and (= y #x6) (= ((_ extract 7 4) |a b|) #b0000))))
+           :named bits))
+(assert (= s "a""b"))
+(assert (= r (/ (to_real 3) 2.0)))
+(check-sat)
+(push 1)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun c () U)
+(assert (forall ((x U)) (! (= (f x) x) :pattern ((f x)))))
+(assert (not (= (f (f c)) c)))
+(check-sat)
+(pop 1)
+(assert (= |a b| (_ bv5 8)))
+(check-sat)
@@ -0,0 +1,89 @@
+; COMMAND-LINE: --smt2-fast-parser --smt2-fast-parser-threads=2
+; COMMAND-LINE: --smt2-fast-parser --smt2-fast-parser-threads=4
+; EXPECT: unsat
+(set-logic QF_LIA)
+; a string and a quoted symbol containing parentheses and semicolons
+(set-info :source "a (quoted) ""string""; not a comment")
+(declare-fun |x (0);| () Int)
+(declare-fun x1 () Int) ; x1 )
+(assert (= x1 (+ |x (0);| 1)))
+(declare-fun x2 () Int) ; x2 )
+(assert (= x2 (+ |x (0);| 2)))
+(declare-fun x3 () Int) ; x3 )
+(assert (= x3 (+ |x (0);| 3)))
+(declare-fun x4 () Int) ; x4 )
+(assert (= x4 (+ |x (0);| 4)))
+(declare-fun x5 () Int) ; x5 )
+(assert (= x5 (+ |x (0);| 5)))
+(declare-fun x6 () Int) ; x6 )
+(assert (= x6 (+ |x (0);| 6)))
+(declare-fun x7 () Int) ; x7 )
+(assert (= x7 (+ |x (0);| 7)))
+(declare-fun x8 () Int) ; x8 )
+(assert (= x8 (+ |x (0);| 8)))
+(declare-fun x9 () Int) ; x9 )
+(assert (= x9 (+ |x (0);| 9)))
+(declare-fun x10 () Int) ; x10 )
+(assert (= x10 (+ |x (0);| 10)))
+(declare-fun x11 () Int) ; x11 )
+(assert (= x11 (+ |x (0);| 11)))
+(declare-fun x12 () Int) ; x12 )
+(assert (= x12 (+ |x (0);| 12)))
+(declare-fun x13 () Int) ; x13 )
+(assert (= x13 (+ |x (0);| 13)))
+(declare-fun x14 () Int) ; x14 )
+(assert (= x14 (+ |x (0);| 14)))
+(declare-fun x15 () Int) ; x15 )
+(assert (= x15 (+ |x (0);| 15)))
+(declare-fun x16 () Int) ; x16 )
+(assert (= x16 (+ |x (0);| 16)))
+(declare-fun x17 () Int) ; x17 )
+(assert (= x17 (+ |x (0);| 17)))
+(declare-fun x18 () Int) ; x18 )
+(assert (= x18 (+ |x (0);| 18)))
+(declare-fun x19 () Int) ; x19 )
+(assert (= x19 (+ |x (0);| 19)))
+(declare-fun x20 () Int) ; x20 )
+(assert (= x20 (+ |x (0);| 20)))
+(declare-fun x21 () Int) ; x21 )
+(assert (= x21 (+ |x (0);| 21)))
+(declare-fun x22 () Int) ; x22 )
+(assert (= x22 (+ |x (0);| 22)))
+(declare-fun x23 () Int) ; x23 )
+(assert (= x23 (+ |x (0);| 23)))
+(declare-fun x24 () Int) ; x24 )
+(assert (= x24 (+ |x (0);| 24)))
+(declare-fun x25 () Int) ; x25 )
+(assert (= x25 (+ |x (0);| 25)))
+(declare-fun x26 () Int) ; x26 )
+(assert (= x26 (+ |x (0);| 26)))
+(declare-fun x27 () Int) ; x27 )
+(assert (= x27 (+ |x (0);| 27)))
+(declare-fun x28 () Int) ; x28 )
+(assert (= x28 (+ |x (0);| 28)))
+(declare-fun x29 () Int) ; x29 )
+(assert (= x29 (+ |x (0);| 29)))
+(declare-fun x30 () Int) ; x30 )
+(assert (= x30 (+ |x (0);| 30)))
+(declare-fun x31 () Int) ; x31 )
+(assert (= x31 (+ |x (0);| 31)))
+(declare-fun x32 () Int) ; x32 )
+(assert (= x32 (+ |x (0);| 32)))
+(declare-fun x33 () Int) ; x33 )
+(assert (= x33 (+ |x (0);| 33)))
+(declare-fun x34 () Int) ; x34 )
+(assert (= x34 (+ |x (0);| 34)))
+(declare-fun x35 () Int) ; x35 )
+(assert (= x35 (+ |x (0);| 35)))
+(declare-fun x36 () Int) ; x36 )
+(assert (= x36 (+ |x (0);| 36)))
+(declare-fun x37 () Int) ; x37 )
+(assert (= x37 (+ |x (0);| 37)))
+(declare-fun x38 () Int) ; x38 )
+(assert (= x38 (+ |x (0);| 38)))
+(declare-fun x39 () Int) ; x39 )
+(assert (= x39 (+ |x (0);| 39)))
+(declare-fun x40 () Int) ; x40 )
+(assert (= x40 (+ |x (0);| 40)))
+(assert (> x40 (+ x1 39)))
+(check-sat)
@@ -0,0 +1,10 @@
+; REQUIRES: no-competition
+; COMMAND-LINE: --smt2-fast-parser
+; SCRUBBER: grep -o "not supported by --smt2-fast-parser"
+; EXPECT: not supported by --smt2-fast-parser
+; EXIT: 1
+(set-logic QF_DT)
+(declare-datatypes ((D 0)) (((c) (d))))
+(declare-fun x () D)
+(assert (= x c))
+(check-sat)
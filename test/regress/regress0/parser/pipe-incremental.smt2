@@ -0,0 +1,17 @@
+; COMMAND-LINE: --pipe
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: ((|x(| false))
+(set-logic QF_UF)
+(set-option :produce-models true)
+(declare-fun |x(| () Bool)
+(declare-fun y () Bool)
+(assert (or |x(| y)) ; a comment with a parenthesis (
+(check-sat-assuming ((not |x(|)))
+(push 1)
+(assert (not y))
+(check-sat-assuming ((not |x(|)))
+(pop 1)
+(check-sat-assuming ((not |x(|)))
+(get-value (|x(|))
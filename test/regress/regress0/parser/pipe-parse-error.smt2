@@ -0,0 +1,15 @@
+; REQUIRES: no-competition
+; COMMAND-LINE: --pipe
+; SCRUBBER: sed -e 's/(error.*/(error)/'
+; EXPECT: (error)
+; EXPECT: (error)
+; EXPECT: sat
+; EXIT: 1
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(assert ())
+; the scope of the let binder is closed after the error
+(assert (let ((b a)) (and b ())))
+(declare-fun b () Bool)
+(assert (and a b))
+(check-sat)
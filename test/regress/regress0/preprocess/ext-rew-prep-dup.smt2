@@ -0,0 +1,17 @@
+; COMMAND-LINE: --ext-rew-prep
+; COMMAND-LINE: --ext-rew-prep --ext-rew-prep-agg
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun b () Bool)
+; the same assertion several times, which is transformed only once
+(assert (ite b (= (f x) (+ y 1)) (= (f x) (- y 1))))
+(assert (ite b (= (f x) (+ y 1)) (= (f x) (- y 1))))
+(assert (or (= x y) (> (f (+ x 0)) (* 2 y))))
+(assert (ite b (= (f x) (+ y 1)) (= (f x) (- y 1))))
+(assert (= x y))
+(assert (> y 3))
+(assert (> (f y) (+ y 4)))
+(check-sat)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --dump-proofs --proof-format-mode=steps
+; EXPECT: (step t
+; SCRUBBER: grep -m 1 -o -E "^\(step t"
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (= a b))
+(assert (not (= (f a) (f b))))
+(check-sat)
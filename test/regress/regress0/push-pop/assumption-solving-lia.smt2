@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --assumption-solving --no-check-proofs
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (<= (+ x y) 10))
+(assert (>= x 0))
+(check-sat-assuming ((>= y 11)))
+(check-sat-assuming ((>= y 10)))
+(check-sat-assuming ((>= y 10) (> x 0)))
+(check-sat)
+(check-sat-assuming ((= x 3) (= y 7)))
+(push 1)
+(assert (>= y 10))
+(check-sat-assuming ((> x 0)))
+(pop 1)
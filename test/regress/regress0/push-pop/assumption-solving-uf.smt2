@@ -0,0 +1,25 @@
+; COMMAND-LINE: --incremental --assumption-solving --no-check-proofs
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun p () Bool)
+(assert (= (f a) b))
+(check-sat-assuming ((= a b)))
+(check-sat-assuming ((= a b) (= (f b) a) (not (= (f (f a)) a))))
+(push 1)
+(assert p)
+(check-sat-assuming ((not p)))
+(pop 1)
+(check-sat-assuming ((not p)))
+; the assumption is solved modulo the top-level substitution of a
+(assert (= a b))
+(check-sat-assuming ((distinct (f a) (f b))))
+(check-sat)
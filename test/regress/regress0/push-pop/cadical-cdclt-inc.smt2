@@ -0,0 +1,22 @@
+; REQUIRES: cadical
+; COMMAND-LINE: --incremental --sat-solver=cadical
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(assert (or p (> x 5)))
+(assert (or (not p) (< y 0)))
+(check-sat)
+(push 1)
+(assert (<= x 5))
+(assert (>= y 0))
+(check-sat)
+(pop 1)
+(check-sat-assuming ((<= x 5)))
+(check-sat-assuming ((<= x 5) (>= y 0)))
+(check-sat)
@@ -0,0 +1,30 @@
+; COMMAND-LINE: --incremental --pp-persistent-cache
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun b () Bool)
+
+(push 1)
+(assert (> (ite b x y) 10))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (> (ite b x y) 10))
+(assert (< x 0))
+(assert (< y 0))
+(check-sat)
+(pop 1)
+
+(push 1)
+(assert (= (div x 3) 5))
+(check-sat)
+(pop 1)
+
+(assert (= (div x 3) 5))
+(assert (< x 0))
+(check-sat)
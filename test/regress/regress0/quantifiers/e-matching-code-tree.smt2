@@ -0,0 +1,20 @@
+; COMMAND-LINE: --e-matching-code-tree
+; COMMAND-LINE: --e-matching-code-tree --no-quant-cf
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun h (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+; triggers of several quantified formulas sharing the symbol f
+(assert (forall ((x U)) (! (= (f (g x)) x) :pattern ((g x)))))
+(assert (forall ((x U)) (! (P (f x)) :pattern ((f x)))))
+(assert (forall ((x U) (y U)) (! (= (h x y) (f y)) :pattern ((h x y)))))
+(assert (= b (g a)))
+(assert (= c (h a b)))
+(assert (or (not (P a)) (not (= c a))))
+(check-sat)
@@ -0,0 +1,31 @@
+; COMMAND-LINE: --incremental --e-matching-incremental
+; COMMAND-LINE: --incremental --e-matching-incremental --e-matching-code-tree
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun h (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+; triggers of several quantified formulas sharing the symbol f
+(assert (forall ((x U)) (! (= (f (g x)) x) :pattern ((g x)))))
+(assert (forall ((x U)) (! (P (f x)) :pattern ((f x)))))
+(assert (forall ((x U) (y U)) (! (= (h x y) (f y)) :pattern ((h x y)))))
+(assert (= b (g a)))
+(push 1)
+; the terms added in this context are matched in the next rounds
+(assert (= c (h a b)))
+(assert (not (= c a)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (P (h b b))))
+(check-sat)
+(pop 1)
+(assert (not (= (f (g b)) b)))
+(check-sat)
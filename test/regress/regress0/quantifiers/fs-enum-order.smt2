@@ -0,0 +1,21 @@
+; COMMAND-LINE: --full-saturate-quant --no-e-matching --no-quant-cf --fs-rd-order
+; COMMAND-LINE: --full-saturate-quant --no-e-matching --no-quant-cf --fs-cost-bound=4
+; COMMAND-LINE: --full-saturate-quant --no-e-matching --no-quant-cf --fs-entail-prune --fs-rd-order
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun h (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+; triggers of several quantified formulas sharing the symbol f
+(assert (forall ((x U)) (! (= (f (g x)) x) :pattern ((g x)))))
+(assert (forall ((x U)) (! (P (f x)) :pattern ((f x)))))
+(assert (forall ((x U) (y U)) (! (= (h x y) (f y)) :pattern ((h x y)))))
+(assert (= b (g a)))
+(assert (= c (h a b)))
+(assert (or (not (P a)) (not (= c a))))
+(check-sat)
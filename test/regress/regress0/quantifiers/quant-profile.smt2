@@ -0,0 +1,16 @@
+; REQUIRES: statistics
+; COMMAND-LINE: --quant-profile
+; SCRUBBER: grep -c -e "Instantiate::Profile.*(inv : instances [1-9]"
+; EXPECT: 1
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U)) (! (= (f (g x)) x) :pattern ((g x)) :qid inv)))
+(assert (forall ((x U)) (! (P (f x)) :pattern ((f x)))))
+(assert (not (P a)))
+(assert (P (g a)))
+(check-sat)
+(get-info :all-statistics)
@@ -0,0 +1,10 @@
+; COMMAND-LINE: --strings-exp
+; COMMAND-LINE: --strings-exp --seq-nth-const-limit=0
+; EXPECT: sat
+(set-logic ALL)
+(declare-fun i () Int)
+(define-fun c () (Seq Int) (seq.++ (seq.unit 3) (seq.unit 5) (seq.unit 7)))
+(assert (<= 0 i 2))
+(assert (> (seq.nth c i) 4))
+(assert (not (= i 1)))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --strings-exp
+; COMMAND-LINE: --strings-exp --seq-nth-const-limit=2
+; COMMAND-LINE: --strings-exp --seq-nth-const-limit=0
+; EXPECT: unsat
+(set-logic ALL)
+(declare-fun i () Int)
+(declare-fun j () Int)
+(define-fun c () (Seq Int) (seq.++ (seq.unit 3) (seq.unit 5) (seq.unit 7)))
+; the elements of c at symbolic indices in its bounds are 3, 5 or 7
+(assert (<= 0 i 2))
+(assert (<= 0 j 2))
+(assert (or (= (seq.nth c i) 6) (= (+ (seq.nth c i) (seq.nth c j)) 11)))
+(check-sat)
@@ -0,0 +1,21 @@
+; COMMAND-LINE: --incremental --strings-eager-re
+; COMMAND-LINE: --incremental --no-strings-eager-re
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(assert (str.in_re x (re.* (str.to_re "ab"))))
+(assert (not (str.in_re y (re.++ (str.to_re "a") (re.* re.allchar)))))
+(check-sat)
+(push 1)
+; x becomes equal to a constant on a merge
+(assert (= x z))
+(assert (= z "aba"))
+(check-sat)
+(pop 1)
+; y starts with the constant "a"
+(assert (= y (str.++ "a" x)))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --incremental --strings-inc-nf
+; COMMAND-LINE: --incremental --strings-inc-nf --strings-exp
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(declare-fun w () String)
+(assert (= (str.++ x "ab" y) (str.++ z w)))
+(assert (= (str.len z) (+ (str.len x) 1)))
+(assert (> (str.len y) 2))
+(push 1)
+(check-sat)
+(pop 1)
+(assert (= (str.++ x "b") z))
+(check-sat)
@@ -0,0 +1,22 @@
+; COMMAND-LINE: --lemma-batching
+; COMMAND-LINE: --lemma-batching --strings-exp
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-option :incremental true)
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(assert (= (str.++ x y) "abcd"))
+(assert (= (str.len x) 2))
+(assert (= (str.substr z 1 2) y))
+(assert (< (str.len z) 5))
+(check-sat)
+(push 1)
+(assert (str.prefixof "b" z))
+(assert (not (str.contains z "c")))
+(check-sat)
+(pop 1)
+(assert (= (str.len z) 2))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --strings-len-check
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (= (str.++ x y) (str.++ "abc" x)))
+(assert (> (str.len y) 2))
+(assert (str.contains y "c"))
+(check-sat)
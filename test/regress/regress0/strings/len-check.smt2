@@ -0,0 +1,12 @@
+; COMMAND-LINE: --strings-len-check --no-check-unsat-cores --no-check-proofs
+; COMMAND-LINE: --strings-len-check --strings-len-check-timeout=100 --no-check-unsat-cores --no-check-proofs
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+; the length abstraction alone is unsatisfiable
+(assert (= (str.++ x y) (str.++ "abc" z)))
+(assert (< (+ (str.len x) (str.len y)) 3))
+(assert (or (str.prefixof "ab" z) (= z "")))
+(check-sat)
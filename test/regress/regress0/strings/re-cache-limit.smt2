@@ -0,0 +1,10 @@
+; COMMAND-LINE: --re-cache-limit=1
+; COMMAND-LINE: --re-cache-limit=0
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+; the caches of the intersections and derivatives are cleared when full
+(assert (str.in_re x (re.++ (re.* (str.to_re "ab")) (str.to_re "c"))))
+(assert (str.in_re x (re.++ (re.* (re.union (str.to_re "a") (str.to_re "c"))) (str.to_re "c"))))
+(assert (str.in_re x (re.++ re.allchar re.allchar (re.* re.allchar))))
+(check-sat)
@@ -0,0 +1,8 @@
+; COMMAND-LINE: --re-dfa
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(assert (str.in_re x (re.+ (re.++ (str.to_re "ab") (re.range "0" "5")))))
+(assert (str.in_re x (re.++ (re.* re.allchar) (re.range "4" "9"))))
+(assert (not (str.in_re x (re.* (re.++ (re.union (str.to_re "a") (str.to_re "b")) re.allchar)))))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --re-dfa
+; COMMAND-LINE: --no-re-dfa
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+; the intersection of the memberships of x is empty, and the membership of y
+; in a language including the other one is redundant
+(assert (str.in_re x (re.+ (re.++ (str.to_re "ab") (re.range "0" "3")))))
+(assert (str.in_re x (re.++ (re.* re.allchar) (re.range "4" "9"))))
+(assert (str.in_re y (re.* (re.union (str.to_re "a") (str.to_re "b")))))
+(assert (str.in_re y (re.* (str.to_re "ab"))))
+(check-sat)
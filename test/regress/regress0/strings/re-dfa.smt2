@@ -0,0 +1,12 @@
+; COMMAND-LINE: --re-dfa
+; COMMAND-LINE: --no-re-dfa
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (= x "ab12ab7ab"))
+(assert (= y (str.++ x "c")))
+(assert (not (or (str.in_re x (re.+ (re.++ (str.to_re "ab") ((_ re.loop 0 2) (re.range "0" "9")))))
+                 (not (str.in_re y (re.++ (re.* re.allchar) (str.to_re "bc"))))
+                 (str.in_re y (re.++ (re.* (re.union (str.to_re "a") (str.to_re "b"))) (str.to_re "c"))))))
+(check-sat)
@@ -0,0 +1,17 @@
+; REQUIRES: cadical
+; COMMAND-LINE: --sat-solver=cadical --no-check-unsat-cores --no-check-proofs
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun p (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (or (= a b) (= a c)))
+(assert (or (not (= a b)) (p (f a))))
+(assert (or (not (= a c)) (p (f a))))
+(assert (= (f b) (f c)))
+(assert (or (not (p (f b))) (not (p (f c)))))
+(assert (or (= b c) (not (p (f a)))))
+(check-sat)
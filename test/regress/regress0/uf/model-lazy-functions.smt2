@@ -0,0 +1,16 @@
+; COMMAND-LINE: --model-lazy-functions
+; EXPECT: sat
+; EXPECT: (((f 0) 3) ((f 1) 4) ((g a) true))
+(set-logic QF_UFLIA)
+(set-option :produce-models true)
+(declare-sort U 0)
+(declare-fun f (Int) Int)
+(declare-fun g (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (= (f 0) 3))
+(assert (= (f 1) (+ (f 0) 1)))
+(assert (g a))
+(assert (not (g b)))
+(check-sat)
+(get-value ((f 0) (f 1) (g a)))
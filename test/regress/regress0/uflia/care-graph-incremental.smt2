@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental --care-graph-incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun g (Int Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (not (= (f x) (f y))))
+(assert (= (g x z) (+ (f z) 1)))
+(assert (<= x y))
+(check-sat)
+(push 1)
+; x and y become equal in arithmetic only, which the care graph must notice
+(assert (<= y x))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= z (+ x 1)))
+(assert (= (g x z) (f y)))
+(check-sat)
+(assert (= y z))
+(assert (= (f z) (f x)))
+(check-sat)
+(pop 1)
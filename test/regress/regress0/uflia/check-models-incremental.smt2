@@ -0,0 +1,23 @@
+; COMMAND-LINE: --incremental --check-models
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+; assertions that are evaluated by compiled code, and one that is not
+(assert (and (> x 0) (< x 10)))
+(assert (ite (> y x) (= z (+ x y)) (= z (- x y))))
+(assert (= (f x) z))
+(check-sat)
+(push 1)
+(assert (> y 20))
+(check-sat)
+(assert (< z 0))
+(check-sat)
+(pop 1)
+(assert (= y 3))
+(check-sat)
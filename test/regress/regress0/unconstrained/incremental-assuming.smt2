@@ -0,0 +1,14 @@
+; COMMAND-LINE: --incremental --unconstrained-simp
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 4))
+(declare-fun y () (_ BitVec 4))
+(assert (= (bvadd x y) #x3))
+(check-sat)
+; x and y were eliminated by the first call, the assumptions constrain them
+(check-sat-assuming ((= x #x1) (= y #x1)))
+(check-sat-assuming ((= x #x1)))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --unsat-cores-assumptions --no-check-proofs
+; COMMAND-LINE: --unsat-cores-assumptions --unsat-cores-minimize --no-check-proofs
+; EXPECT: unsat
+; EXPECT: (
+; EXPECT: a1
+; EXPECT: a3
+; EXPECT: )
+(set-logic QF_LIA)
+(set-option :produce-unsat-cores true)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (! (> x 0) :named a1))
+(assert (! (< y 0) :named a2))
+(assert (! (< x 0) :named a3))
+(check-sat)
+(get-unsat-core)
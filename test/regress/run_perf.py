@@ -0,0 +1,306 @@
+#!/usr/bin/env python3
+#####################
+## run_perf.py
+## Top contributors (to current version):
+##   Mathias Preiner
+## This file is part of the CVC4 project.
+## Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+## in the top-level source directory and their institutional affiliations.
+## All rights reserved.  See the file COPYING in the top-level source
+## directory for licensing information.
+##
+"""
+Runs a subset of the regressions and records the wall time, the peak
+resident set size and the resource units spent by CVC4 on each of them. The
+results can be stored as a baseline and compared against a stored baseline.
+
+Since the resource units spent on a benchmark are deterministic for a given
+build, a change in resource units indicates a change in the work done by the
+solver, independently from the load of the machine. Wall time and memory are
+recorded to be reported, and are only checked if a tolerance is given.
+
+Example:
+
+  run_perf.py --level 0 --filter 'regress0/bv/' --output perf.json \\
+      build/bin/cvc4
+  run_perf.py --level 0 --filter 'regress0/bv/' --baseline perf.json \\
+      build/bin/cvc4
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+from run_regression import COMMAND_LINE, REQUIRES, get_cvc4_features
+
+RESOURCE_UNITS_REGEX = re.compile(r'^resource::resourceUnitsUsed, (\d+)$',
+                                  re.MULTILINE)
+COMMENT_CHARS = {
+    '.smt': ';',
+    '.smt2': ';',
+    '.sy': ';',
+    '.cvc': '%',
+    '.p': '%'
+}
+
+
+def get_regressions(cmake_file, level):
+    """Returns the regressions of level `level` listed in the CMake file
+    `cmake_file`, relative to the directory of that file."""
+
+    with open(cmake_file, 'r') as f:
+        content = f.read()
+    match = re.search(r'set\(regress_{}_tests(.*?)\)'.format(level), content,
+                      re.DOTALL)
+    if not match:
+        sys.exit('No regressions of level {} in "{}"'.format(level, cmake_file))
+    files = []
+    for line in match.group(1).splitlines():
+        line = line.split('#')[0].strip()
+        if line:
+            files.append(line)
+    return files
+
+
+def get_benchmark_args(benchmark_path, features):
+    """Returns the options of the first COMMAND-LINE directive of the
+    benchmark `benchmark_path`, or None if the benchmark requires a feature
+    that is not in `features`."""
+
+    ext = os.path.splitext(benchmark_path)[1]
+    comment_char = COMMENT_CHARS.get(ext)
+    if comment_char is None:
+        return None
+    command_line = None
+    with open(benchmark_path, 'r') as f:
+        for line in f:
+            if not line.startswith(comment_char):
+                continue
+            line = line[1:].lstrip()
+            if line.startswith(COMMAND_LINE) and command_line is None:
+                command_line = line[len(COMMAND_LINE):].strip()
+            elif line.startswith(REQUIRES):
+                req = line[len(REQUIRES):].strip()
+                if req.startswith('no-'):
+                    if req[len('no-'):] in features:
+                        return None
+                elif req not in features:
+                    return None
+    return shlex.split(command_line) if command_line else []
+
+
+def measure(args, cwd, timeout):
+    """Runs `args` in the directory `cwd` with a timeout `timeout` in seconds
+    and returns the exit code, the wall time in seconds, the peak resident set
+    size in kilobytes and the error output of the process. The exit code is
+    None if the process timed out."""
+
+    with tempfile.TemporaryFile() as out, tempfile.TemporaryFile() as err:
+        start = time.monotonic()
+        proc = subprocess.Popen(args,
+                                cwd=cwd,
+                                stdin=subprocess.DEVNULL,
+                                stdout=out,
+                                stderr=err)
+        timer = threading.Timer(timeout, lambda p: p.kill(), [proc])
+        timer.start()
+        # Reap the process ourselves to get its resource usage.
+        _, status, rusage = os.wait4(proc.pid, 0)
+        wall = time.monotonic() - start
+        timed_out = not timer.is_alive()
+        timer.cancel()
+        if os.WIFSIGNALED(status):
+            proc.returncode = -os.WTERMSIG(status)
+        else:
+            proc.returncode = os.WEXITSTATUS(status)
+        err.seek(0)
+        error = err.read().decode(errors='replace')
+    exit_code = None if timed_out else proc.returncode
+    return exit_code, wall, rusage.ru_maxrss, error
+
+
+def run_benchmark(cvc4_binary, regress_dir, benchmark, features, timeout):
+    """Runs CVC4 on `benchmark` and returns its measurements, or None if the
+    benchmark is skipped."""
+
+    path = os.path.join(regress_dir, benchmark)
+    args = get_benchmark_args(path, features)
+    if args is None:
+        return None
+    args = [cvc4_binary] + args + ['--stats', os.path.basename(path)]
+    exit_code, wall, rss, error = measure(args, os.path.dirname(path),
+                                          timeout)
+    match = RESOURCE_UNITS_REGEX.search(error)
+    return {
+        'flags': args[1:-2],
+        'status': 'timeout' if exit_code is None else exit_code,
+        'time': round(wall, 3),
+        'rss': rss,
+        'resource_units': int(match.group(1)) if match else None
+    }
+
+
+def relative_change(value, base):
+    """Returns the relative change from `base` to `value`, or None if it is
+    undefined."""
+
+    if value is None or base is None or base == 0:
+        return None
+    return (value - base) / base
+
+
+def compare(results, baseline, tolerances):
+    """Compares `results` with `baseline` and returns the rows of the report
+    and the number of regressions. A metric regresses if it increased by more
+    than its tolerance in `tolerances`; metrics without tolerance are only
+    reported."""
+
+    rows = []
+    regressions = 0
+    for benchmark in sorted(results):
+        if benchmark not in baseline:
+            continue
+        new = results[benchmark]
+        old = baseline[benchmark]
+        changes = {}
+        failed = []
+        for metric, tolerance in tolerances.items():
+            change = relative_change(new[metric], old[metric])
+            changes[metric] = change
+            if tolerance is not None and change is not None \
+               and change > tolerance:
+                failed.append(metric)
+        if new['status'] != old['status']:
+            failed.append('status')
+        if failed:
+            regressions += 1
+        rows.append((benchmark, changes, failed))
+    return rows, regressions
+
+
+def format_change(change):
+    return '-' if change is None else '{:+.1%}'.format(change)
+
+
+def print_report(results, baseline, tolerances):
+    """Prints a summary of the comparison of `results` with `baseline` and
+    returns the number of regressions."""
+
+    rows, regressions = compare(results, baseline, tolerances)
+    print('{:<60} {:>10} {:>10} {:>10}'.format('benchmark', 'units', 'time',
+                                               'rss'))
+    for benchmark, changes, failed in rows:
+        if not failed and all(c is None or c == 0 for c in changes.values()):
+            continue
+        print('{:<60} {:>10} {:>10} {:>10}{}'.format(
+            benchmark, format_change(changes['resource_units']),
+            format_change(changes['time']), format_change(changes['rss']),
+            '  REGRESSION ({})'.format(', '.join(failed)) if failed else ''))
+    print()
+    common = [b for b in results if b in baseline]
+    for metric in tolerances:
+        pairs = [(results[b][metric], baseline[b][metric]) for b in common
+                 if results[b][metric] is not None
+                 and baseline[b][metric] is not None]
+        new = sum(n for n, _ in pairs)
+        old = sum(o for _, o in pairs)
+        print('Total {:<15} {:>16} -> {:<16} {}'.format(
+            metric, round(old, 3), round(new, 3),
+            format_change(relative_change(new, old))))
+    missing = [b for b in baseline if b not in results]
+    added = [b for b in results if b not in baseline]
+    print()
+    print('{} benchmarks compared, {} regressions, {} without baseline, '
+          '{} of the baseline not run'.format(len(common), regressions,
+                                              len(added), len(missing)))
+    return regressions
+
+
+def main():
+    """Parses the command line arguments and runs the benchmarks."""
+
+    regress_dir = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(
+        description='Records and compares the performance of CVC4 on the '
+        'regressions.')
+    parser.add_argument('--level', type=int, action='append', default=[],
+                        help='run the regressions of the given level')
+    parser.add_argument('--filter', default=None,
+                        help='only run regressions whose path matches the '
+                        'given regular expression')
+    parser.add_argument('--output', default=None,
+                        help='write the results in JSON format to the given '
+                        'file, e.g. to store them as a baseline')
+    parser.add_argument('--baseline', default=None,
+                        help='compare the results with the given file')
+    parser.add_argument('--tolerance', type=float, default=0.02,
+                        help='tolerated relative increase of resource units '
+                        '(default: 0.02)')
+    parser.add_argument('--time-tolerance', type=float, default=None,
+                        help='tolerated relative increase of wall time')
+    parser.add_argument('--rss-tolerance', type=float, default=None,
+                        help='tolerated relative increase of peak memory')
+    parser.add_argument('cvc4_binary')
+    parser.add_argument('benchmarks', nargs='*',
+                        help='regressions to run, relative to {}'.format(
+                            regress_dir))
+    args = parser.parse_args()
+
+    cvc4_binary = os.path.abspath(args.cvc4_binary)
+    if not os.access(cvc4_binary, os.X_OK):
+        sys.exit('"{}" does not exist or is not executable'.format(cvc4_binary))
+    features, _ = get_cvc4_features(cvc4_binary)
+    if 'statistics' not in features:
+        print('Warning: statistics are disabled, resource units are not '
+              'recorded')
+
+    benchmarks = list(args.benchmarks)
+    for level in args.level:
+        benchmarks += get_regressions(
+            os.path.join(regress_dir, 'CMakeLists.txt'), level)
+    if args.filter:
+        benchmarks = [b for b in benchmarks if re.search(args.filter, b)]
+    if not benchmarks:
+        sys.exit('No regressions selected')
+
+    timeout = float(os.getenv('TEST_TIMEOUT', '600'))
+    results = {}
+    for i, benchmark in enumerate(benchmarks):
+        result = run_benchmark(cvc4_binary, regress_dir, benchmark, features,
+                               timeout)
+        if result is None:
+            print('[{}/{}] {}: skipped'.format(i + 1, len(benchmarks),
+                                                benchmark))
+            continue
+        print('[{}/{}] {}: {} units, {:.3f} s, {} KB'.format(
+            i + 1, len(benchmarks), benchmark, result['resource_units'],
+            result['time'], result['rss']))
+        results[benchmark] = result
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'benchmarks': results}, f, indent=2, sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline, 'r') as f:
+            baseline = json.load(f)['benchmarks']
+        print()
+        tolerances = {
+            'resource_units': args.tolerance,
+            'time': args.time_tolerance,
+            'rss': args.rss_tolerance
+        }
+        if print_report(results, baseline, tolerances) > 0:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
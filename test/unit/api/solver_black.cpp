@@ -14,6 +14,10 @@
  ** Black box testing of the Solver class of the  C++ API.
  **/
 
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
 #include "test_api.h"
 
 namespace cvc5 {
@@ -47,6 +51,28 @@ TEST_F(TestApiBlackSolver, supportsFloatingPoint)
   }
 }
 
+TEST_F(TestApiBlackSolver, cloneConfiguration)
+{
+  d_solver.setLogic("QF_BV");
+  d_solver.setOption("produce-models", "true");
+  Sort bvSort = d_solver.mkBitVectorSort(8);
+  Term x = d_solver.mkConst(bvSort, "x");
+  Term zero = d_solver.mkBitVector(8, 0);
+  d_solver.assertFormula(d_solver.mkTerm(DISTINCT, x, zero));
+
+  std::unique_ptr<Solver> clone;
+  ASSERT_NO_THROW(clone = d_solver.cloneConfiguration());
+  ASSERT_EQ(clone->getOption("produce-models"), "true");
+  ASSERT_THROW(clone->setLogic("QF_LIA"), CVC4ApiException);
+  ASSERT_THROW(d_solver.setLogic("QF_LIA"), CVC4ApiException);
+  // the clone shares the terms, but not the assertions
+  clone->assertFormula(x.eqTerm(zero));
+  ASSERT_TRUE(clone->checkSat().isSat());
+  ASSERT_EQ(clone->getValue(x), zero);
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  ASSERT_NE(d_solver.getValue(x), zero);
+}
+
 TEST_F(TestApiBlackSolver, getBooleanSort)
 {
   ASSERT_NO_THROW(d_solver.getBooleanSort());
@@ -753,6 +779,166 @@ TEST_F(TestApiBlackSolver, mkTerm)
   ASSERT_THROW(d_solver.mkTerm(DISTINCT, v6), CVC4ApiException);
 }
 
+TEST_F(TestApiBlackSolver, mkTerms)
+{
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term y = d_solver.mkConst(intSort, "y");
+  Solver slv;
+
+  // (+ x y), (* (+ x y) x), (= (* (+ x y) x) (+ x y))
+  std::vector<Term> terms;
+  ASSERT_NO_THROW(terms = d_solver.mkTerms(
+                      {x, y}, {PLUS, MULT, EQUAL}, {2, 0, 1, 2, 2, 0, 2, 3, 2}));
+  ASSERT_EQ(terms.size(), 3);
+  Term sum = d_solver.mkTerm(PLUS, x, y);
+  Term prod = d_solver.mkTerm(MULT, sum, x);
+  ASSERT_EQ(terms[0], sum);
+  ASSERT_EQ(terms[1], prod);
+  ASSERT_EQ(terms[2], d_solver.mkTerm(EQUAL, prod, sum));
+  ASSERT_TRUE(d_solver.mkTerms({x}, {}, {}).empty());
+  // kinds with special handling, e.g. chainable kinds
+  ASSERT_EQ(d_solver.mkTerms({x, y}, {LT}, {3, 0, 1, 0})[0],
+            d_solver.mkTerm(LT, {x, y, x}));
+
+  // missing or extra records and children
+  ASSERT_THROW(d_solver.mkTerms({x, y}, {PLUS}, {}), CVC4ApiException);
+  ASSERT_THROW(d_solver.mkTerms({x, y}, {PLUS}, {2, 0}), CVC4ApiException);
+  ASSERT_THROW(d_solver.mkTerms({x, y}, {PLUS}, {2, 0, 1, 0}),
+               CVC4ApiException);
+  // a reference to the term itself or to a later term
+  ASSERT_THROW(d_solver.mkTerms({x, y}, {PLUS}, {2, 0, 2}), CVC4ApiException);
+  ASSERT_THROW(d_solver.mkTerms({x, y}, {PLUS, MULT}, {2, 0, 3, 2, 2, 0}),
+               CVC4ApiException);
+  // ill-typed terms, wrong arities and invalid leaves
+  ASSERT_THROW(d_solver.mkTerms({x, d_solver.mkTrue()}, {PLUS}, {2, 0, 1}),
+               CVC4ApiException);
+  ASSERT_THROW(d_solver.mkTerms({x}, {NOT}, {2, 0, 0}), CVC4ApiException);
+  ASSERT_THROW(d_solver.mkTerms({x, Term()}, {PLUS}, {2, 0, 1}),
+               CVC4ApiException);
+  ASSERT_THROW(d_solver.mkTerms({x}, {UNDEFINED_KIND}, {1, 0}),
+               CVC4ApiException);
+  ASSERT_THROW(slv.mkTerms({x, y}, {PLUS}, {2, 0, 1}), CVC4ApiException);
+}
+
+TEST_F(TestApiBlackSolver, sharedTerms)
+{
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term gt = d_solver.mkTerm(GT, x, d_solver.mkInteger(0));
+
+  Solver shared(d_solver, nullptr);
+  Solver other;
+  // the terms and sorts of each solver are valid in the other one
+  Term lt = shared.mkTerm(LT, x, shared.mkInteger(0));
+  ASSERT_EQ(shared.getIntegerSort(), intSort);
+  ASSERT_EQ(shared.mkTerm(GT, x, shared.mkInteger(0)), gt);
+  ASSERT_NO_THROW(d_solver.mkTerm(AND, gt, lt));
+  ASSERT_THROW(other.mkTerm(AND, gt, lt), CVC4ApiException);
+  // terms are shared by all solvers constructed from one another
+  Solver shared2(shared, nullptr);
+  ASSERT_NO_THROW(shared2.mkTerm(AND, gt, lt));
+
+  // the assertions are per solver
+  d_solver.assertFormula(gt);
+  shared.assertFormula(lt);
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  ASSERT_TRUE(shared.checkSat().isSat());
+  ASSERT_TRUE(shared2.checkSatAssuming(d_solver.mkTerm(AND, gt, lt)).isUnsat());
+  ASSERT_EQ(d_solver.getValue(x).getSort(), intSort);
+}
+
+TEST_F(TestApiBlackSolver, checkSatAsync)
+{
+  /** Cancels the check when it is first notified. */
+  class Listener : public CheckProgressListener
+  {
+   public:
+    Listener(const Solver& slv) : d_slv(slv), d_calls(0) {}
+    void notify(uint64_t conflicts,
+                uint64_t lemmas,
+                uint64_t elapsedMs) override
+    {
+      if (d_calls++ == 0)
+      {
+        d_slv.cancel();
+      }
+    }
+    const Solver& d_slv;
+    size_t d_calls;
+  };
+
+  Term x = d_solver.mkConst(d_solver.getIntegerSort(), "x");
+  d_solver.assertFormula(d_solver.mkTerm(GT, x, d_solver.mkInteger(0)));
+  // a cancel request before the check is discarded
+  d_solver.cancel();
+  std::future<cvc5::api::Result> res = d_solver.checkSatAsync();
+  ASSERT_TRUE(res.get().isSat());
+
+  // the pigeonhole problem of 10 pigeons and 9 holes, which takes many
+  // conflicts to refute
+  Solver slv;
+  size_t n = 9;
+  std::vector<std::vector<Term>> p(n + 1);
+  for (size_t i = 0; i <= n; ++i)
+  {
+    for (size_t j = 0; j < n; ++j)
+    {
+      p[i].push_back(slv.mkConst(slv.getBooleanSort()));
+    }
+    slv.assertFormula(slv.mkTerm(OR, p[i]));
+  }
+  for (size_t j = 0; j < n; ++j)
+  {
+    for (size_t i = 0; i <= n; ++i)
+    {
+      for (size_t k = i + 1; k <= n; ++k)
+      {
+        slv.assertFormula(
+            slv.mkTerm(OR, p[i][j].notTerm(), p[k][j].notTerm()));
+      }
+    }
+  }
+  Listener l(slv);
+  res = slv.checkSatAsync(&l, 0);
+  cvc5::api::Result r = res.get();
+  ASSERT_GT(l.d_calls, 0);
+  ASSERT_TRUE(r.isSatUnknown());
+  ASSERT_EQ(r.getUnknownExplanation(), cvc5::api::Result::INTERRUPTED);
+}
+
+TEST_F(TestApiBlackSolver, apiChecks)
+{
+  // full: the arguments are checked and terms are type checked on creation
+  Term x = d_solver.mkConst(d_solver.getIntegerSort(), "x");
+  ASSERT_THROW(d_solver.mkTerm(PLUS, x, d_solver.mkTrue()), CVC4ApiException);
+
+  // light: the arguments are checked, but not the types of terms
+  Solver light;
+  light.setOption("api-checks", "light");
+  Term lx = light.mkConst(light.getIntegerSort(), "x");
+  ASSERT_NO_THROW(light.mkTerm(PLUS, lx, light.mkTrue()));
+  ASSERT_THROW(light.mkTerm(NOT, Term()), CVC4ApiException);
+  ASSERT_THROW(light.mkTerm(NOT, {lx, lx}), CVC4ApiException);
+  ASSERT_THROW(light.mkTerm(NOT, d_solver.mkTrue()), CVC4ApiException);
+
+  // none: nothing is checked
+  Solver none;
+  none.setOption("api-checks", "none");
+  Term nx = none.mkConst(none.getIntegerSort(), "x");
+  ASSERT_NO_THROW(none.mkTerm(PLUS, nx, none.mkTrue()));
+
+  // well-typed terms are the same at all levels
+  for (Solver* slv : {&light, &none})
+  {
+    Term a = slv->mkConst(slv->getIntegerSort(), "a");
+    Term t = slv->mkTerm(GT, slv->mkTerm(PLUS, a, slv->mkInteger(1)), a);
+    ASSERT_EQ(t.getSort(), slv->getBooleanSort());
+    slv->assertFormula(t.notTerm());
+    ASSERT_TRUE(slv->checkSat().isUnsat());
+  }
+}
+
 TEST_F(TestApiBlackSolver, mkTermFromOp)
 {
   Sort bv32 = d_solver.mkBitVectorSort(32);
@@ -1762,6 +1948,53 @@ TEST_F(TestApiBlackSolver, blockModelValues5)
   ASSERT_NO_THROW(d_solver.blockModelValues({x}));
 }
 
+namespace {
+
+/** A model listener that collects the values of the models */
+class CollectModels : public ModelListener
+{
+ public:
+  bool notify(const std::vector<Term>& terms,
+              const std::vector<Term>& values) override
+  {
+    d_models.push_back(values);
+    return false;
+  }
+  std::vector<std::vector<Term>> d_models;
+};
+
+}  // namespace
+
+TEST_F(TestApiBlackSolver, enumerateModels)
+{
+  Term x = d_solver.mkConst(d_solver.getBooleanSort(), "x");
+  Term y = d_solver.mkConst(d_solver.getBooleanSort(), "y");
+  Term z = d_solver.mkConst(d_solver.getBooleanSort(), "z");
+  CollectModels cm;
+  ASSERT_THROW(d_solver.enumerateModels({x}, cm), CVC4ApiException);
+  d_solver.setOption("produce-models", "true");
+  d_solver.setOption("incremental", "true");
+  d_solver.assertFormula(d_solver.mkTerm(OR, x, y, z));
+  // the projection on x and y has 4 models
+  ASSERT_TRUE(d_solver.enumerateModels({x, y}, cm).isUnsat());
+  ASSERT_EQ(cm.d_models.size(), 4);
+  for (size_t i = 0; i < cm.d_models.size(); i++)
+  {
+    for (size_t j = 0; j < i; j++)
+    {
+      ASSERT_NE(cm.d_models[i], cm.d_models[j]);
+    }
+  }
+  // the blocking clauses do not affect subsequent checks
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  CollectModels cm2;
+  ASSERT_TRUE(d_solver.enumerateModels({x, y, z}, cm2, 3).isSat());
+  ASSERT_EQ(cm2.d_models.size(), 3);
+  CollectModels cm3;
+  ASSERT_TRUE(d_solver.enumerateModels({x, y, z}, cm3).isUnsat());
+  ASSERT_EQ(cm3.d_models.size(), 7);
+}
+
 TEST_F(TestApiBlackSolver, setInfo)
 {
   ASSERT_THROW(d_solver.setInfo("cvc4-lagic", "QF_BV"), CVC4ApiException);
@@ -1951,6 +2184,27 @@ TEST_F(TestApiBlackSolver, checkSat)
   ASSERT_THROW(d_solver.checkSat(), CVC4ApiException);
 }
 
+TEST_F(TestApiBlackSolver, cancel)
+{
+  d_solver.setOption("incremental", "true");
+  Term x = d_solver.mkConst(d_solver.getBooleanSort(), "x");
+  d_solver.assertFormula(x);
+  // a request without a running check interrupts the next check
+  d_solver.cancel();
+  cvc5::api::Result res = d_solver.checkSat();
+  ASSERT_TRUE(res.isSatUnknown());
+  ASSERT_EQ(res.getUnknownExplanation(), cvc5::api::Result::INTERRUPTED);
+  // and is cleared by it
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  d_solver.cancel();
+  ASSERT_TRUE(d_solver.checkSatAssuming(x).isSatUnknown());
+  ASSERT_TRUE(d_solver.checkSatAssuming(x).isSat());
+  // a request before an asynchronous check is discarded
+  d_solver.cancel();
+  ASSERT_TRUE(d_solver.checkSatAsync().get().isSat());
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+}
+
 TEST_F(TestApiBlackSolver, checkSatAssuming)
 {
   d_solver.setOption("incremental", "false");
@@ -2285,6 +2539,50 @@ TEST_F(TestApiBlackSolver, getSynthSolutions)
   ASSERT_THROW(slv.getSynthSolutions({x}), CVC4ApiException);
 }
 
+TEST_F(TestApiBlackSolver, checkSynthAnytime)
+{
+  /** Stops the search at the given number of solutions. */
+  class Listener : public SynthSolutionListener
+  {
+   public:
+    Listener(size_t stop) : d_stop(stop) {}
+    bool notify(const std::vector<Term>& fs,
+                const std::vector<Term>& sols,
+                uint64_t elapsedMs) override
+    {
+      d_fs = fs;
+      d_sols.push_back(sols);
+      return d_sols.size() == d_stop;
+    }
+    size_t d_stop;
+    std::vector<Term> d_fs;
+    std::vector<std::vector<Term>> d_sols;
+  };
+
+  d_solver.setOption("lang", "sygus2");
+  d_solver.setOption("incremental", "false");
+
+  Sort integer = d_solver.getIntegerSort();
+  Term x = d_solver.mkVar(integer, "x");
+  Term f = d_solver.synthFun("f", {x}, integer);
+  Term y = d_solver.mkSygusVar(integer, "y");
+  d_solver.addSygusConstraint(d_solver.mkTerm(
+      GEQ, d_solver.mkTerm(APPLY_UF, f, y), y));
+
+  Listener l(2);
+  // requires sygus-stream
+  ASSERT_THROW(d_solver.checkSynthAnytime(l), CVC4ApiException);
+  d_solver.setOption("sygus-stream", "true");
+
+  ASSERT_TRUE(d_solver.checkSynthAnytime(l).isUnsat());
+  ASSERT_EQ(l.d_fs, std::vector<Term>({f}));
+  ASSERT_EQ(l.d_sols.size(), 2);
+  // the solutions are excluded, hence distinct
+  ASSERT_NE(l.d_sols[0], l.d_sols[1]);
+  // the last solution is the solution of the conjecture
+  ASSERT_EQ(d_solver.getSynthSolution(f), l.d_sols[1][0]);
+}
+
 TEST_F(TestApiBlackSolver, tupleProject)
 {
   std::vector<Sort> sorts = {d_solver.getBooleanSort(),
@@ -2342,5 +2640,119 @@ TEST_F(TestApiBlackSolver, tupleProject)
       projection.toString());
 }
 
+TEST_F(TestApiBlackSolver, saveLoadSnapshot)
+{
+  char* filename = strdup("/tmp/snapshot.XXXXXX");
+  int32_t fd = mkstemp(filename);
+  ASSERT_NE(fd, -1);
+  close(fd);
+
+  // the term-level ite is purified by a skolem while preprocessing
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term b = d_solver.mkConst(d_solver.getBooleanSort(), "b");
+  Term f = d_solver.mkConst(d_solver.mkFunctionSort(intSort, intSort), "f");
+  Term abs = d_solver.mkTerm(ITE, b, x, d_solver.mkTerm(UMINUS, x));
+  d_solver.assertFormula(d_solver.mkTerm(GT, abs, d_solver.mkInteger(3)));
+  d_solver.assertFormula(d_solver.mkTerm(LT, x, d_solver.mkInteger(2)));
+  d_solver.assertFormula(d_solver.mkTerm(EQUAL,
+                                         d_solver.mkTerm(APPLY_UF, f, abs),
+                                         d_solver.mkTerm(APPLY_UF, f, x)));
+  ASSERT_NO_THROW(d_solver.saveSnapshot(filename));
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+
+  Solver s1;
+  Term x1 = s1.mkConst(s1.getIntegerSort(), "x");
+  Term b1 = s1.mkConst(s1.getBooleanSort(), "b");
+  Term f1 = s1.mkConst(
+      s1.mkFunctionSort(s1.getIntegerSort(), s1.getIntegerSort()), "f");
+  ASSERT_NO_THROW(s1.loadSnapshot(filename, {x1, b1, f1}));
+  ASSERT_TRUE(s1.checkSat().isSat());
+
+  // x > -4 is inconsistent with the snapshot only if its skolem is restored
+  // with the definition of the ite
+  Solver s2;
+  Term x2 = s2.mkConst(s2.getIntegerSort(), "x");
+  Term b2 = s2.mkConst(s2.getBooleanSort(), "b");
+  Term f2 = s2.mkConst(
+      s2.mkFunctionSort(s2.getIntegerSort(), s2.getIntegerSort()), "f");
+  ASSERT_NO_THROW(s2.loadSnapshot(filename, {x2, b2, f2}));
+  s2.assertFormula(s2.mkTerm(GT, x2, s2.mkInteger(-4)));
+  ASSERT_TRUE(s2.checkSat().isUnsat());
+
+  Solver s3;
+  ASSERT_THROW(s3.loadSnapshot("/dev/null", {}), CVC4ApiException);
+
+  remove(filename);
+  free(filename);
+}
+
+TEST_F(TestApiBlackSolver, getLearnedClauses)
+{
+  d_solver.setOption("incremental", "true");
+  // three pigeons in two holes unless e holds, which requires conflicts to
+  // find a model
+  Sort boolSort = d_solver.getBooleanSort();
+  Term e = d_solver.mkConst(boolSort, "e");
+  std::vector<std::vector<Term>> p(3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = 0; j < 2; ++j)
+    {
+      p[i].push_back(d_solver.mkConst(boolSort));
+    }
+    d_solver.assertFormula(d_solver.mkTerm(OR, {p[i][0], p[i][1], e}));
+  }
+  for (size_t j = 0; j < 2; ++j)
+  {
+    for (size_t i = 0; i < 3; ++i)
+    {
+      for (size_t k = i + 1; k < 3; ++k)
+      {
+        d_solver.assertFormula(d_solver.mkTerm(
+            OR, p[i][j].notTerm(), p[k][j].notTerm()));
+      }
+    }
+  }
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+
+  std::vector<Term> clauses;
+  ASSERT_NO_THROW(clauses = d_solver.getLearnedClauses());
+  for (const Term& c : clauses)
+  {
+    ASSERT_EQ(c.getSort(), boolSort);
+    // the learned clauses are consequences of the assertions
+    d_solver.push();
+    d_solver.assertFormula(c.notTerm());
+    ASSERT_TRUE(d_solver.checkSat().isUnsat());
+    d_solver.pop();
+  }
+  ASSERT_NO_THROW(clauses = d_solver.getLearnedClauses(1));
+  for (const Term& c : clauses)
+  {
+    ASSERT_NE(c.getKind(), OR);
+  }
+  ASSERT_NO_THROW(d_solver.addLearnedClauses(clauses));
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+}
+
+TEST_F(TestApiBlackSolver, getLearnedClausesCadical)
+{
+  try
+  {
+    d_solver.setOption("sat-solver", "cadical");
+  }
+  catch (CVC4ApiException&)
+  {
+    // not built with CaDiCaL
+    return;
+  }
+  Term x = d_solver.mkConst(d_solver.getBooleanSort(), "x");
+  d_solver.assertFormula(x);
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  // CaDiCaL does not support learned clauses
+  ASSERT_THROW(d_solver.getLearnedClauses(), CVC4ApiException);
+}
+
 }  // namespace test
 }  // namespace cvc5
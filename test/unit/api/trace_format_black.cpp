@@ -0,0 +1,182 @@
+/*********************                                                        */
+/*! \file trace_format_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the format of the traces of API calls.
+ **
+ ** Black box testing of the format of the traces of API calls.
+ **/
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "api/trace_format.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace api;
+
+namespace test {
+
+class TestApiBlackTraceFormat : public TestInternal
+{
+ protected:
+  /** Returns a call of operation op with the given arguments. */
+  static TraceCall mkCall(TraceOp op,
+                          const std::vector<int64_t>& ints,
+                          const std::vector<std::string>& strs)
+  {
+    TraceCall call;
+    call.d_op = op;
+    call.d_ints = ints;
+    call.d_strs = strs;
+    return call;
+  }
+
+  /** Returns a trace of the given calls. */
+  static std::string mkTrace(const std::vector<TraceCall>& calls)
+  {
+    std::stringstream ss;
+    writeTraceHeader(ss);
+    for (const TraceCall& call : calls)
+    {
+      writeTraceCall(ss, call);
+    }
+    return ss.str();
+  }
+};
+
+TEST_F(TestApiBlackTraceFormat, round_trip)
+{
+  std::vector<TraceCall> calls = {
+      mkCall(TraceOp::SET_OPTION, {}, {"produce-models", "true"}),
+      mkCall(TraceOp::SET_LOGIC, {}, {"QF_BV"}),
+      mkCall(TraceOp::MK_BV_SORT, {8}, {}),
+      mkCall(TraceOp::MK_CONST, {0}, {""}),
+      mkCall(TraceOp::MK_INTEGER,
+             {-1,
+              0,
+              63,
+              64,
+              -64,
+              -65,
+              std::numeric_limits<int64_t>::max(),
+              std::numeric_limits<int64_t>::min()},
+             {std::string("a\0b", 3), std::string(300, 'x')}),
+      mkCall(TraceOp::CHECK_SAT, {}, {}),
+      mkCall(TraceOp::SIMPLIFY, {3}, {})};
+  std::stringstream ss(mkTrace(calls));
+  TraceReader reader(ss);
+  ASSERT_TRUE(reader.isValid());
+  TraceCall call;
+  for (const TraceCall& expected : calls)
+  {
+    ASSERT_TRUE(reader.read(call));
+    ASSERT_EQ(call.d_op, expected.d_op);
+    ASSERT_EQ(call.d_ints, expected.d_ints);
+    ASSERT_EQ(call.d_strs, expected.d_strs);
+  }
+  // the end of the trace, which is still valid
+  ASSERT_FALSE(reader.read(call));
+  ASSERT_TRUE(reader.isValid());
+}
+
+TEST_F(TestApiBlackTraceFormat, empty)
+{
+  std::stringstream ss(mkTrace({}));
+  TraceReader reader(ss);
+  ASSERT_TRUE(reader.isValid());
+  TraceCall call;
+  ASSERT_FALSE(reader.read(call));
+  ASSERT_TRUE(reader.isValid());
+}
+
+TEST_F(TestApiBlackTraceFormat, invalid_header)
+{
+  for (const std::string& s : {std::string(""),
+                               std::string("CVC4"),
+                               std::string("CVC4TRC0"),
+                               std::string("(set-logic QF_UF)")})
+  {
+    std::stringstream ss(s);
+    TraceReader reader(ss);
+    ASSERT_FALSE(reader.isValid()) << s;
+    TraceCall call;
+    ASSERT_FALSE(reader.read(call));
+  }
+}
+
+TEST_F(TestApiBlackTraceFormat, truncated)
+{
+  std::string trace =
+      mkTrace({mkCall(TraceOp::PUSH, {1}, {}),
+               mkCall(TraceOp::SET_LOGIC, {}, {"QF_UF"}),
+               mkCall(TraceOp::MK_TERM, {5, 300, 301}, {})});
+  size_t first = mkTrace({mkCall(TraceOp::PUSH, {1}, {})}).size();
+  size_t second = mkTrace({mkCall(TraceOp::PUSH, {1}, {}),
+                           mkCall(TraceOp::SET_LOGIC, {}, {"QF_UF"})})
+                      .size();
+  // every proper prefix of the last two calls is rejected
+  for (size_t n = first + 1; n < trace.size(); n++)
+  {
+    if (n == second)
+    {
+      continue;
+    }
+    std::stringstream ss(trace.substr(0, n));
+    TraceReader reader(ss);
+    ASSERT_TRUE(reader.isValid());
+    TraceCall call;
+    ASSERT_TRUE(reader.read(call));
+    ASSERT_EQ(call.d_op, TraceOp::PUSH);
+    while (reader.read(call))
+    {
+      ASSERT_EQ(call.d_op, TraceOp::SET_LOGIC);
+    }
+    ASSERT_FALSE(reader.isValid()) << n;
+    // an invalid trace stays invalid
+    ASSERT_FALSE(reader.read(call));
+  }
+}
+
+TEST_F(TestApiBlackTraceFormat, malformed)
+{
+  std::string header = mkTrace({});
+  TraceCall call;
+  {
+    // an unknown operation
+    std::stringstream ss(header
+                         + std::string(1, static_cast<char>(TraceOp::LAST)));
+    TraceReader reader(ss);
+    ASSERT_FALSE(reader.read(call));
+    ASSERT_FALSE(reader.isValid());
+  }
+  {
+    // a number of integers that is too large
+    std::stringstream ss(header + std::string(1, '\0')
+                         + "\xff\xff\xff\xff\x7f");
+    TraceReader reader(ss);
+    ASSERT_FALSE(reader.read(call));
+    ASSERT_FALSE(reader.isValid());
+  }
+  {
+    // a variable-length integer with more than 64 bits
+    std::stringstream ss(header + std::string(1, '\0')
+                         + std::string(11, '\x80'));
+    TraceReader reader(ss);
+    ASSERT_FALSE(reader.read(call));
+    ASSERT_FALSE(reader.isValid());
+  }
+}
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,174 @@
+/*********************                                                        */
+/*! \file trace_recorder_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the recording of API calls by --api-trace.
+ **
+ ** Black box testing of the recording of API calls by --api-trace.
+ **/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "api/trace_format.h"
+#include "options/options.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace api;
+
+namespace test {
+
+class TestApiBlackTraceRecorder : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    TestInternal::SetUp();
+    char filename[] = "/tmp/cvc4_api_trace.XXXXXX";
+    int32_t fd = mkstemp(filename);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    d_filename = filename;
+    d_options.setOption("api-trace", d_filename);
+    d_solver.reset(new Solver(&d_options));
+  }
+
+  void TearDown() override
+  {
+    d_solver.reset(nullptr);
+    remove(d_filename.c_str());
+  }
+
+  /** Destroys the solver, and returns the calls of its trace. */
+  std::vector<TraceCall> readTrace()
+  {
+    d_solver.reset(nullptr);
+    std::ifstream in(d_filename, std::ios::in | std::ios::binary);
+    TraceReader reader(in);
+    EXPECT_TRUE(reader.isValid());
+    std::vector<TraceCall> calls;
+    TraceCall call;
+    while (reader.read(call))
+    {
+      calls.push_back(call);
+    }
+    EXPECT_TRUE(reader.isValid());
+    return calls;
+  }
+
+  /** Returns true if call is of operation op with the given arguments. */
+  static bool isCall(const TraceCall& call,
+                     TraceOp op,
+                     const std::vector<int64_t>& ints,
+                     const std::vector<std::string>& strs)
+  {
+    return call.d_op == op && call.d_ints == ints && call.d_strs == strs;
+  }
+
+  std::string d_filename;
+  Options d_options;
+  std::unique_ptr<Solver> d_solver;
+};
+
+TEST_F(TestApiBlackTraceRecorder, record)
+{
+  d_solver->setOption("incremental", "true");
+  d_solver->setLogic("QF_UF");
+  Sort b = d_solver->getBooleanSort();
+  Term x = d_solver->mkConst(b, "x");
+  Term y = d_solver->mkConst(b, "y");
+  Term a = d_solver->mkTerm(AND, x, y);
+  d_solver->push(1);
+  d_solver->assertFormula(a);
+  ASSERT_TRUE(d_solver->checkSat().isSat());
+  d_solver->pop(1);
+  d_solver->checkSatAssuming({x, d_solver->mkTerm(NOT, x)});
+
+  std::vector<TraceCall> calls = readTrace();
+  ASSERT_EQ(calls.size(), 12);
+  ASSERT_TRUE(
+      isCall(calls[0], TraceOp::SET_OPTION, {}, {"incremental", "true"}));
+  ASSERT_TRUE(isCall(calls[1], TraceOp::SET_LOGIC, {}, {"QF_UF"}));
+  ASSERT_TRUE(isCall(calls[2], TraceOp::GET_BOOLEAN_SORT, {}, {}));
+  // the results of the calls are numbered from 0
+  ASSERT_TRUE(isCall(calls[3], TraceOp::MK_CONST, {0}, {"x"}));
+  ASSERT_TRUE(isCall(calls[4], TraceOp::MK_CONST, {0}, {"y"}));
+  ASSERT_TRUE(isCall(calls[5], TraceOp::MK_TERM, {AND, 0, 1}, {}));
+  ASSERT_TRUE(isCall(calls[6], TraceOp::PUSH, {1}, {}));
+  ASSERT_TRUE(isCall(calls[7], TraceOp::ASSERT, {2}, {}));
+  ASSERT_TRUE(isCall(calls[8], TraceOp::CHECK_SAT, {}, {}));
+  ASSERT_TRUE(isCall(calls[9], TraceOp::POP, {1}, {}));
+  ASSERT_TRUE(isCall(calls[10], TraceOp::MK_TERM, {NOT, 0}, {}));
+  ASSERT_TRUE(isCall(calls[11], TraceOp::CHECK_SAT_ASSUMING, {0, 3}, {}));
+}
+
+TEST_F(TestApiBlackTraceRecorder, unknown_arguments)
+{
+  d_solver->setLogic("QF_UF");
+  Sort b = d_solver->getBooleanSort();
+  Term x = d_solver->mkConst(b, "x");
+  // a term that is not the result of a recorded call
+  Term n = x.notTerm();
+  d_solver->assertFormula(n);
+  d_solver->assertFormula(d_solver->mkTerm(OR, n, x));
+  // the child of a recorded term is known
+  Term a = d_solver->mkTerm(AND, x, x);
+  d_solver->assertFormula(a[0]);
+
+  std::vector<TraceCall> calls = readTrace();
+  ASSERT_EQ(calls.size(), 5);
+  ASSERT_TRUE(isCall(calls[0], TraceOp::SET_LOGIC, {}, {"QF_UF"}));
+  ASSERT_TRUE(isCall(calls[1], TraceOp::GET_BOOLEAN_SORT, {}, {}));
+  ASSERT_TRUE(isCall(calls[2], TraceOp::MK_CONST, {0}, {"x"}));
+  // the calls using n and the result of the call using n are not recorded,
+  // and the ids of the recorded results are consecutive
+  ASSERT_TRUE(isCall(calls[3], TraceOp::MK_TERM, {AND, 0, 0}, {}));
+  ASSERT_TRUE(isCall(calls[4], TraceOp::ASSERT, {0}, {}));
+}
+
+TEST_F(TestApiBlackTraceRecorder, failed_calls)
+{
+  d_solver->setLogic("QF_BV");
+  // the calls that raise an exception are not recorded, whether in the
+  // checks of their arguments or in their execution
+  ASSERT_THROW(d_solver->mkBitVectorSort(0), CVC4ApiException);
+  Sort s = d_solver->mkBitVectorSort(4);
+  Term x = d_solver->mkConst(s, "x");
+  Term c = d_solver->mkBitVector(4, 3);
+  Term t = d_solver->mkTrue();
+  ASSERT_THROW(d_solver->mkTerm(BITVECTOR_PLUS, x, t), CVC4ApiException);
+  d_solver->mkTerm(BITVECTOR_PLUS, x, c);
+
+  std::vector<TraceCall> calls = readTrace();
+  ASSERT_EQ(calls.size(), 6);
+  ASSERT_TRUE(isCall(calls[0], TraceOp::SET_LOGIC, {}, {"QF_BV"}));
+  ASSERT_TRUE(isCall(calls[1], TraceOp::MK_BV_SORT, {4}, {}));
+  ASSERT_TRUE(isCall(calls[2], TraceOp::MK_CONST, {0}, {"x"}));
+  ASSERT_TRUE(isCall(calls[3], TraceOp::MK_BV, {4}, {"3"}));
+  ASSERT_TRUE(isCall(calls[4], TraceOp::MK_BOOLEAN, {1}, {}));
+  ASSERT_TRUE(isCall(calls[5], TraceOp::MK_TERM, {BITVECTOR_PLUS, 0, 1}, {}));
+}
+
+TEST_F(TestApiBlackTraceRecorder, bad_file)
+{
+  Options opts;
+  opts.setOption("api-trace", "/nonexistent/dir/trace");
+  ASSERT_ANY_THROW(Solver slv(&opts));
+}
+}  // namespace test
+}  // namespace cvc5
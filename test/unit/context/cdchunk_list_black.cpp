@@ -0,0 +1,187 @@
+/*********************                                                        */
+/*! \file cdchunk_list_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::context::CDChunkList<>.
+ **
+ ** Black box testing of cvc5::context::CDChunkList<>.
+ **/
+
+#include <vector>
+
+#include "context/cdchunk_list.h"
+#include "test_context.h"
+
+namespace cvc5 {
+
+using namespace context;
+
+namespace test {
+
+struct DtorSensitiveObject
+{
+  bool& d_dtorCalled;
+  DtorSensitiveObject(bool& dtorCalled) : d_dtorCalled(dtorCalled) {}
+  ~DtorSensitiveObject() { d_dtorCalled = true; }
+};
+
+class TestContextBlackCDChunkList : public TestContext
+{
+ protected:
+  void list_test(int32_t n)
+  {
+    list_test(n, true);
+    list_test(n, false);
+  }
+
+  void list_test(int32_t n, bool callDestructor)
+  {
+    CDChunkList<int32_t> list(d_context.get(), callDestructor);
+
+    ASSERT_TRUE(list.empty());
+    for (int32_t i = 0; i < n; ++i)
+    {
+      ASSERT_EQ(list.size(), (uint32_t)i);
+      list.push_back(i);
+      ASSERT_FALSE(list.empty());
+      ASSERT_EQ(list.back(), i);
+      int32_t i2 = 0;
+      for (CDChunkList<int32_t>::const_iterator j = list.begin();
+           j != list.end();
+           ++j)
+      {
+        ASSERT_EQ(*j, i2++);
+      }
+      ASSERT_EQ(i2, i + 1);
+    }
+    ASSERT_EQ(list.size(), (uint32_t)n);
+
+    for (int32_t i = 0; i < n; ++i)
+    {
+      ASSERT_EQ(list[i], i);
+    }
+  }
+};
+
+TEST_F(TestContextBlackCDChunkList, CDChunkList10) { list_test(10); }
+
+TEST_F(TestContextBlackCDChunkList, CDChunkList16) { list_test(16); }
+
+TEST_F(TestContextBlackCDChunkList, CDChunkList17) { list_test(17); }
+
+TEST_F(TestContextBlackCDChunkList, CDChunkList48) { list_test(48); }
+
+TEST_F(TestContextBlackCDChunkList, CDChunkList500) { list_test(500); }
+
+TEST_F(TestContextBlackCDChunkList, stable_addresses)
+{
+  CDChunkList<int32_t> list(d_context.get());
+  list.push_back(0);
+  const int32_t* first = &list[0];
+  std::vector<const int32_t*> addrs;
+  for (int32_t i = 1; i < 10000; ++i)
+  {
+    list.push_back(i);
+    addrs.push_back(&list.back());
+  }
+  ASSERT_EQ(first, &list[0]);
+  for (size_t i = 0, n = addrs.size(); i < n; ++i)
+  {
+    ASSERT_EQ(addrs[i], &list[i + 1]);
+  }
+}
+
+TEST_F(TestContextBlackCDChunkList, pop_across_chunks)
+{
+  for (bool callDestructor : {true, false})
+  {
+    CDChunkList<int32_t> list(d_context.get(), callDestructor);
+    for (int32_t i = 0; i < 15; ++i)
+    {
+      list.push_back(i);
+    }
+    d_context->push();
+    for (int32_t i = 15; i < 100; ++i)
+    {
+      list.push_back(i);
+    }
+    d_context->push();
+    list.push_back(100);
+    d_context->pop();
+    ASSERT_EQ(list.size(), 100u);
+    ASSERT_EQ(list.back(), 99);
+    d_context->pop();
+    ASSERT_EQ(list.size(), 15u);
+    ASSERT_EQ(list.back(), 14);
+    int32_t i2 = 0;
+    for (int32_t v : list)
+    {
+      ASSERT_EQ(v, i2++);
+    }
+    ASSERT_EQ(i2, 15);
+    for (int32_t i = 15; i < 40; ++i)
+    {
+      list.push_back(-i);
+    }
+    ASSERT_EQ(list.size(), 40u);
+    ASSERT_EQ(list[15], -15);
+    ASSERT_EQ(list[39], -39);
+    ASSERT_EQ(*(list.begin() + 39), -39);
+  }
+}
+
+TEST_F(TestContextBlackCDChunkList, destructor_called)
+{
+  bool shouldRemainFalse = false;
+  bool shouldFlipToTrue = false;
+  bool shouldAlsoRemainFalse = false;
+
+  CDChunkList<DtorSensitiveObject> listT(d_context.get(), true);
+  CDChunkList<DtorSensitiveObject> listF(d_context.get(), false);
+
+  DtorSensitiveObject shouldRemainFalseDSO(shouldRemainFalse);
+  DtorSensitiveObject shouldFlipToTrueDSO(shouldFlipToTrue);
+  DtorSensitiveObject shouldAlsoRemainFalseDSO(shouldAlsoRemainFalse);
+
+  listT.push_back(shouldAlsoRemainFalseDSO);
+  listF.push_back(shouldAlsoRemainFalseDSO);
+
+  d_context->push();
+
+  listT.push_back(shouldFlipToTrueDSO);
+  listF.push_back(shouldRemainFalseDSO);
+
+  ASSERT_EQ(shouldRemainFalse, false);
+  ASSERT_EQ(shouldFlipToTrue, false);
+  ASSERT_EQ(shouldAlsoRemainFalse, false);
+
+  d_context->pop();
+
+  ASSERT_EQ(shouldRemainFalse, false);
+  ASSERT_EQ(shouldFlipToTrue, true);
+  ASSERT_EQ(shouldAlsoRemainFalse, false);
+}
+
+TEST_F(TestContextBlackCDChunkList, empty_iterator)
+{
+  CDChunkList<int>* list = new (true) CDChunkList<int>(d_context.get());
+  ASSERT_EQ(list->begin(), list->end());
+  list->deleteSelf();
+}
+
+TEST_F(TestContextBlackCDChunkList, pop_below_level_created)
+{
+  d_context->push();
+  CDChunkList<int32_t> list(d_context.get());
+  d_context->popto(0);
+  list.push_back(42);
+}
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,225 @@
+/*********************                                                        */
+/*! \file cdpriority_queue_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::context::CDPriorityQueue<>.
+ **
+ ** Black box testing of cvc5::context::CDPriorityQueue<>.
+ **/
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "context/cdpriority_queue.h"
+#include "test_context.h"
+
+namespace cvc5 {
+
+using namespace context;
+
+namespace test {
+
+class TestContextBlackCDPriorityQueue : public TestContext
+{
+ protected:
+  /** Compares pairs by their first component only. */
+  struct FirstCmp
+  {
+    bool operator()(const std::pair<int32_t, int32_t>& a,
+                    const std::pair<int32_t, int32_t>& b) const
+    {
+      return a.first < b.first;
+    }
+  };
+
+  /**
+   * Returns the elements of the queue in the order of dequeuing. The queue
+   * is emptied in a pushed context, which is popped afterwards.
+   */
+  std::vector<int32_t> get_elements(CDPriorityQueue<int32_t>& queue)
+  {
+    std::vector<int32_t> elements;
+    d_context->push();
+    while (!queue.empty())
+    {
+      elements.push_back(queue.front());
+      queue.dequeue();
+    }
+    d_context->pop();
+    return elements;
+  }
+};
+
+TEST_F(TestContextBlackCDPriorityQueue, enqueue_dequeue)
+{
+  CDPriorityQueue<int32_t> queue(d_context.get());
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.size(), 0);
+
+  for (int32_t i : {3, 1, 4, 1, 5, 9, 2, 6})
+  {
+    queue.enqueue(i);
+  }
+  ASSERT_FALSE(queue.empty());
+  ASSERT_EQ(queue.size(), 8);
+  ASSERT_EQ(queue.front(), 9);
+
+  std::vector<int32_t> expected = {9, 6, 5, 4, 3, 2, 1, 1};
+  for (int32_t i : expected)
+  {
+    ASSERT_EQ(queue.front(), i);
+    queue.dequeue();
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(TestContextBlackCDPriorityQueue, comparator_and_ties)
+{
+  using Pair = std::pair<int32_t, int32_t>;
+  CDPriorityQueue<Pair, FirstCmp> queue(d_context.get());
+  queue.enqueue(Pair(1, 0));
+  queue.enqueue(Pair(2, 1));
+  queue.enqueue(Pair(1, 2));
+  queue.enqueue(Pair(2, 3));
+  queue.enqueue(Pair(2, 4));
+
+  // equal elements are dequeued in the order of insertion
+  std::vector<int32_t> expected = {1, 3, 4, 0, 2};
+  for (int32_t i : expected)
+  {
+    ASSERT_EQ(queue.front().second, i);
+    queue.dequeue();
+  }
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST_F(TestContextBlackCDPriorityQueue, push_pop)
+{
+  CDPriorityQueue<int32_t> queue(d_context.get());
+  queue.enqueue(5);
+  queue.enqueue(1);
+
+  d_context->push();
+  queue.enqueue(7);
+  ASSERT_EQ(queue.size(), 3);
+  ASSERT_EQ(queue.front(), 7);
+  queue.dequeue();
+  queue.dequeue();
+  ASSERT_EQ(queue.size(), 1);
+  ASSERT_EQ(queue.front(), 1);
+  queue.enqueue(3);
+  ASSERT_EQ(queue.front(), 3);
+  d_context->pop();
+
+  // 7 and 3 are removed, 5 is put back
+  ASSERT_EQ(queue.size(), 2);
+  ASSERT_EQ(get_elements(queue), std::vector<int32_t>({5, 1}));
+
+  d_context->push();
+  queue.dequeue();
+  queue.dequeue();
+  ASSERT_TRUE(queue.empty());
+  d_context->pop();
+  ASSERT_EQ(get_elements(queue), std::vector<int32_t>({5, 1}));
+}
+
+TEST_F(TestContextBlackCDPriorityQueue, pop_to_level)
+{
+  CDPriorityQueue<int32_t> queue(d_context.get());
+  queue.enqueue(10);
+  queue.enqueue(20);
+
+  d_context->push();
+  queue.dequeue();
+  queue.enqueue(15);
+
+  d_context->push();
+  queue.enqueue(30);
+  queue.dequeue();
+  queue.dequeue();
+
+  d_context->push();
+  // a context that does not modify the queue
+  d_context->push();
+  queue.enqueue(25);
+  ASSERT_EQ(get_elements(queue), std::vector<int32_t>({25, 10}));
+
+  d_context->popto(2);
+  ASSERT_EQ(get_elements(queue), std::vector<int32_t>({10}));
+
+  d_context->popto(1);
+  ASSERT_EQ(get_elements(queue), std::vector<int32_t>({15, 10}));
+
+  d_context->push();
+  queue.dequeue();
+  d_context->push();
+  queue.dequeue();
+  ASSERT_TRUE(queue.empty());
+
+  // pop several levels at once, whose changes are undone together
+  d_context->popto(0);
+  ASSERT_EQ(queue.size(), 2);
+  ASSERT_EQ(get_elements(queue), std::vector<int32_t>({20, 10}));
+}
+
+TEST_F(TestContextBlackCDPriorityQueue, random_sequence)
+{
+  CDPriorityQueue<int32_t> queue(d_context.get());
+  // the content of the queue at each level, sorted in decreasing order
+  std::vector<std::vector<int32_t>> expected(1);
+  uint32_t seed = 1;
+  auto next = [&seed](uint32_t bound) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % bound;
+  };
+  for (size_t step = 0; step < 2000; ++step)
+  {
+    uint32_t op = next(10);
+    if (op < 4)
+    {
+      int32_t value = static_cast<int32_t>(next(50));
+      queue.enqueue(value);
+      std::vector<int32_t>& current = expected.back();
+      current.insert(std::upper_bound(current.begin(),
+                                      current.end(),
+                                      value,
+                                      std::greater<int32_t>()),
+                     value);
+    }
+    else if (op < 6)
+    {
+      if (!expected.back().empty())
+      {
+        queue.dequeue();
+        expected.back().erase(expected.back().begin());
+      }
+    }
+    else if (op < 8)
+    {
+      d_context->push();
+      expected.push_back(expected.back());
+    }
+    else if (expected.size() > 1)
+    {
+      uint32_t level = next(static_cast<uint32_t>(expected.size()));
+      d_context->popto(level);
+      expected.resize(level + 1);
+    }
+    ASSERT_EQ(queue.size(), expected.back().size());
+    if (!expected.back().empty())
+    {
+      ASSERT_EQ(queue.front(), expected.back().front());
+    }
+  }
+  ASSERT_EQ(get_elements(queue), expected.back());
+}
+}  // namespace test
+}  // namespace cvc5
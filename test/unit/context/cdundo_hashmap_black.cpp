@@ -0,0 +1,273 @@
+/*********************                                                        */
+/*! \file cdundo_hashmap_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::context::CDUndoHashMap<>.
+ **
+ ** Black box testing of cvc5::context::CDUndoHashMap<>.
+ **/
+
+#include <map>
+#include <vector>
+
+#include "context/cdundo_hashmap.h"
+#include "test_context.h"
+
+namespace cvc5 {
+namespace test {
+
+using cvc5::context::CDUndoHashMap;
+using cvc5::context::Context;
+
+class TestContextBlackCDUndoHashMap : public TestContext
+{
+ protected:
+  /** A poor hash function, which makes the keys collide in the table. */
+  struct CollidingHash
+  {
+    size_t operator()(int32_t k) const { return static_cast<size_t>(k % 3); }
+  };
+
+  /** Returns the elements in a CDUndoHashMap. */
+  template <class HashFcn>
+  static std::map<int32_t, int32_t> get_elements(
+      const CDUndoHashMap<int32_t, int32_t, HashFcn>& map)
+  {
+    return std::map<int32_t, int32_t>{map.begin(), map.end()};
+  }
+
+  /**
+   * Returns true if the elements in map are the same as expected, and are
+   * all found by lookups.
+   */
+  template <class HashFcn>
+  static bool elements_are(const CDUndoHashMap<int32_t, int32_t, HashFcn>& map,
+                           const std::map<int32_t, int32_t>& expected)
+  {
+    if (get_elements(map) != expected || map.size() != expected.size())
+    {
+      return false;
+    }
+    for (const std::pair<const int32_t, int32_t>& p : expected)
+    {
+      if (!map.contains(p.first) || map[p.first] != p.second)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+TEST_F(TestContextBlackCDUndoHashMap, simple_sequence)
+{
+  CDUndoHashMap<int32_t, int32_t> map(d_context.get());
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(elements_are(map, {}));
+
+  ASSERT_TRUE(map.insert(3, 4));
+  ASSERT_TRUE(elements_are(map, {{3, 4}}));
+
+  {
+    d_context->push();
+    ASSERT_TRUE(elements_are(map, {{3, 4}}));
+
+    ASSERT_TRUE(map.insert(5, 6));
+    ASSERT_TRUE(map.insert(9, 8));
+    ASSERT_TRUE(elements_are(map, {{3, 4}, {5, 6}, {9, 8}}));
+
+    {
+      d_context->push();
+      ASSERT_TRUE(elements_are(map, {{3, 4}, {5, 6}, {9, 8}}));
+
+      ASSERT_TRUE(map.insert(1, 2));
+      ASSERT_TRUE(elements_are(map, {{1, 2}, {3, 4}, {5, 6}, {9, 8}}));
+
+      {
+        d_context->push();
+        ASSERT_FALSE(map.insert(1, 45));
+        ASSERT_FALSE(map.insert(3, 7));
+        ASSERT_TRUE(elements_are(map, {{1, 45}, {3, 7}, {5, 6}, {9, 8}}));
+        d_context->pop();
+      }
+
+      ASSERT_TRUE(elements_are(map, {{1, 2}, {3, 4}, {5, 6}, {9, 8}}));
+      d_context->pop();
+    }
+
+    ASSERT_TRUE(elements_are(map, {{3, 4}, {5, 6}, {9, 8}}));
+    d_context->pop();
+  }
+
+  ASSERT_TRUE(elements_are(map, {{3, 4}}));
+  ASSERT_FALSE(map.contains(5));
+  ASSERT_EQ(map.count(5), 0);
+  ASSERT_EQ(map.find(5), map.end());
+}
+
+TEST_F(TestContextBlackCDUndoHashMap, overwrite)
+{
+  CDUndoHashMap<int32_t, int32_t> map(d_context.get());
+  map.insert(1, 10);
+
+  d_context->push();
+  // overwrite several times in the same context, only the first value of
+  // the key before the context is restored
+  ASSERT_FALSE(map.insert(1, 11));
+  ASSERT_FALSE(map.insert(1, 12));
+  ASSERT_TRUE(map.insert(2, 20));
+  ASSERT_FALSE(map.insert(2, 21));
+  ASSERT_TRUE(elements_are(map, {{1, 12}, {2, 21}}));
+
+  d_context->push();
+  ASSERT_FALSE(map.insert(2, 22));
+  ASSERT_FALSE(map.insert(1, 13));
+  ASSERT_TRUE(elements_are(map, {{1, 13}, {2, 22}}));
+  d_context->pop();
+
+  ASSERT_TRUE(elements_are(map, {{1, 12}, {2, 21}}));
+  d_context->pop();
+
+  ASSERT_TRUE(elements_are(map, {{1, 10}}));
+}
+
+TEST_F(TestContextBlackCDUndoHashMap, insertion_order)
+{
+  CDUndoHashMap<int32_t, int32_t> map(d_context.get());
+  std::vector<int32_t> keys = {42, 7, 19, 3, 100};
+  for (int32_t k : keys)
+  {
+    map.insert(k, -k);
+  }
+  d_context->push();
+  map.insert(7, 0);
+  map.insert(55, 1);
+  std::vector<int32_t> order;
+  for (const std::pair<int32_t, int32_t>& p : map)
+  {
+    order.push_back(p.first);
+  }
+  ASSERT_EQ(order, std::vector<int32_t>({42, 7, 19, 3, 100, 55}));
+  d_context->pop();
+
+  order.clear();
+  for (const std::pair<int32_t, int32_t>& p : map)
+  {
+    order.push_back(p.first);
+  }
+  ASSERT_EQ(order, keys);
+  ASSERT_EQ(map[7], -7);
+}
+
+TEST_F(TestContextBlackCDUndoHashMap, pop_to_level)
+{
+  CDUndoHashMap<int32_t, int32_t> map(d_context.get());
+  map.insert(1, 1);
+
+  d_context->push();
+  map.insert(2, 2);
+  map.insert(1, 10);
+
+  d_context->push();
+  // a context that does not modify the map
+  d_context->push();
+  map.insert(3, 3);
+  map.insert(2, 20);
+
+  d_context->push();
+  map.insert(4, 4);
+  map.insert(1, 100);
+  ASSERT_TRUE(elements_are(map, {{1, 100}, {2, 20}, {3, 3}, {4, 4}}));
+
+  d_context->popto(2);
+  ASSERT_TRUE(elements_are(map, {{1, 10}, {2, 2}}));
+
+  d_context->push();
+  map.insert(5, 5);
+  d_context->push();
+  map.insert(2, 200);
+  d_context->popto(0);
+  ASSERT_TRUE(elements_are(map, {{1, 1}}));
+}
+
+TEST_F(TestContextBlackCDUndoHashMap, grow_and_collisions)
+{
+  // the keys collide, and the table grows past its initial 16 slots, so that
+  // removing the elements on pop moves the elements in their probe sequences
+  CDUndoHashMap<int32_t, int32_t, CollidingHash> map(d_context.get());
+  std::map<int32_t, int32_t> expected;
+  for (int32_t i = 0; i < 10; ++i)
+  {
+    map.insert(i, i);
+    expected[i] = i;
+  }
+  ASSERT_TRUE(elements_are(map, expected));
+
+  d_context->push();
+  for (int32_t i = 10; i < 100; ++i)
+  {
+    map.insert(i, i);
+  }
+  for (int32_t i = 0; i < 100; i += 7)
+  {
+    map.insert(i, -i);
+  }
+  ASSERT_EQ(map.size(), 100);
+  ASSERT_EQ(map[49], -49);
+  ASSERT_EQ(map[50], 50);
+  d_context->pop();
+
+  ASSERT_TRUE(elements_are(map, expected));
+  for (int32_t i = 10; i < 100; ++i)
+  {
+    ASSERT_FALSE(map.contains(i));
+  }
+}
+
+TEST_F(TestContextBlackCDUndoHashMap, random_sequence)
+{
+  CDUndoHashMap<int32_t, int32_t, CollidingHash> map(d_context.get());
+  // the content of the map at each level
+  std::vector<std::map<int32_t, int32_t>> expected(1);
+  uint32_t seed = 1;
+  auto next = [&seed](uint32_t bound) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % bound;
+  };
+  for (size_t step = 0; step < 3000; ++step)
+  {
+    uint32_t op = next(10);
+    if (op < 6)
+    {
+      int32_t k = static_cast<int32_t>(next(200));
+      int32_t d = static_cast<int32_t>(next(1000));
+      bool isNew = expected.back().find(k) == expected.back().end();
+      ASSERT_EQ(map.insert(k, d), isNew);
+      expected.back()[k] = d;
+    }
+    else if (op < 8)
+    {
+      d_context->push();
+      expected.push_back(expected.back());
+    }
+    else if (expected.size() > 1)
+    {
+      uint32_t level = next(static_cast<uint32_t>(expected.size()));
+      d_context->popto(level);
+      expected.resize(level + 1);
+      ASSERT_TRUE(elements_are(map, expected.back()));
+    }
+  }
+  ASSERT_TRUE(elements_are(map, expected.back()));
+  d_context->popto(0);
+  ASSERT_TRUE(elements_are(map, expected.front()));
+}
+}  // namespace test
+}  // namespace cvc5
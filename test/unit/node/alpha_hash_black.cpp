@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file alpha_hash_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of alpha_hash.{h,cpp}
+ **/
+
+#include "expr/alpha_hash.h"
+#include "expr/node_manager.h"
+#include "test_node.h"
+
+namespace cvc5 {
+
+using namespace expr;
+using namespace kind;
+
+namespace test {
+
+class TestNodeBlackAlphaHash : public TestNode
+{
+ protected:
+  void SetUp() override
+  {
+    TestNode::SetUp();
+    TypeNode intType = d_nodeManager->integerType();
+    d_x = d_nodeManager->mkBoundVar("x", intType);
+    d_y = d_nodeManager->mkBoundVar("y", intType);
+    d_u = d_nodeManager->mkBoundVar("u", intType);
+    d_v = d_nodeManager->mkBoundVar("v", intType);
+    d_b = d_nodeManager->mkBoundVar("b", d_nodeManager->booleanType());
+    d_f = d_nodeManager->mkSkolem(
+        "f", d_nodeManager->mkFunctionType({intType, intType}, intType));
+  }
+
+  Node mkForall(const std::vector<Node>& vars, Node body)
+  {
+    return d_nodeManager->mkNode(
+        FORALL, d_nodeManager->mkNode(BOUND_VAR_LIST, vars), body);
+  }
+
+  /** f(x1, x2) > x1 */
+  Node mkBody(Node x1, Node x2)
+  {
+    return d_nodeManager->mkNode(
+        GT, d_nodeManager->mkNode(APPLY_UF, d_f, x1, x2), x1);
+  }
+
+  Node d_x;
+  Node d_y;
+  Node d_u;
+  Node d_v;
+  Node d_b;
+  Node d_f;
+};
+
+TEST_F(TestNodeBlackAlphaHash, renaming)
+{
+  Node q1 = mkForall({d_x, d_y}, mkBody(d_x, d_y));
+  Node q2 = mkForall({d_u, d_v}, mkBody(d_u, d_v));
+  Node q3 = mkForall({d_v, d_u}, mkBody(d_u, d_v));
+  ASSERT_NE(q1, q2);
+  ASSERT_TRUE(isAlphaEquivalent(q1, q2));
+  ASSERT_TRUE(isAlphaEquivalent(q1, q3));
+  ASSERT_EQ(getAlphaHash(q1), getAlphaHash(q2));
+  ASSERT_EQ(getAlphaHash(q1), getAlphaHash(q3));
+  // the hash is cached
+  ASSERT_EQ(getAlphaHash(q1), getAlphaHash(q1));
+}
+
+TEST_F(TestNodeBlackAlphaHash, not_equivalent)
+{
+  Node q1 = mkForall({d_x, d_y}, mkBody(d_x, d_y));
+  // the variables are swapped in the body
+  Node q2 = mkForall({d_x, d_y}, mkBody(d_y, d_x));
+  ASSERT_TRUE(isAlphaEquivalent(q1, q2));
+  // x is used twice
+  Node q3 = mkForall({d_x, d_y}, mkBody(d_x, d_x));
+  ASSERT_FALSE(isAlphaEquivalent(q1, q3));
+  ASSERT_NE(getAlphaHash(q1), getAlphaHash(q3));
+  // y is free
+  Node q4 = mkForall({d_x}, mkBody(d_x, d_y));
+  Node q5 = mkForall({d_u}, mkBody(d_u, d_v));
+  ASSERT_FALSE(isAlphaEquivalent(q4, q5));
+  ASSERT_TRUE(isAlphaEquivalent(q4, mkForall({d_u}, mkBody(d_u, d_y))));
+  // the types of the variables differ
+  Node q6 = mkForall({d_x, d_b}, mkBody(d_x, d_x));
+  Node q7 = mkForall({d_x, d_y}, mkBody(d_x, d_x));
+  ASSERT_FALSE(isAlphaEquivalent(q6, q7));
+  ASSERT_NE(getAlphaHash(q6), getAlphaHash(q7));
+}
+
+TEST_F(TestNodeBlackAlphaHash, nested)
+{
+  Node q1 = mkForall({d_x}, mkForall({d_y}, mkBody(d_x, d_y)));
+  Node q2 = mkForall({d_u}, mkForall({d_v}, mkBody(d_u, d_v)));
+  ASSERT_TRUE(isAlphaEquivalent(q1, q2));
+  ASSERT_EQ(getAlphaHash(q1), getAlphaHash(q2));
+  // the variables of the binders are exchanged
+  Node q3 = mkForall({d_x}, mkForall({d_y}, mkBody(d_y, d_x)));
+  ASSERT_FALSE(isAlphaEquivalent(q1, q3));
+}
+
+}  // namespace test
+}  // namespace cvc5
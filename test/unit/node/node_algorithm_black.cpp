@@ -80,6 +80,37 @@ TEST_F(TestNodeBlackNodeAlgorithm, get_symbols2)
   ASSERT_EQ(syms.find(var), syms.end());
 }
 
+TEST_F(TestNodeBlackNodeAlgorithm, summaries)
+{
+  Node x = d_nodeManager->mkSkolem("x", d_nodeManager->integerType());
+  Node y = d_nodeManager->mkVar("y", d_nodeManager->integerType());
+  Node z = d_nodeManager->mkVar("z", d_nodeManager->integerType());
+  Node var = d_nodeManager->mkBoundVar(*d_intTypeNode);
+  Node sum = d_nodeManager->mkNode(PLUS, var, y);
+  Node lt = d_nodeManager->mkNode(LT, sum, x);
+  Node eq = d_nodeManager->mkNode(EQUAL, y, z);
+
+  ASSERT_EQ(getDagDepth(x), 0);
+  ASSERT_EQ(getDagDepth(sum), 1);
+  ASSERT_EQ(getDagDepth(lt), 2);
+
+  ASSERT_TRUE(hasSkolem(lt));
+  ASSERT_FALSE(hasSkolem(sum));
+  ASSERT_TRUE(hasBoundVar(lt));
+  ASSERT_TRUE(hasFreeVar(lt));
+  ASSERT_FALSE(hasBoundVar(eq));
+  ASSERT_FALSE(hasFreeVar(eq));
+
+  ASSERT_TRUE(hasSubterm(lt, sum));
+  ASSERT_TRUE(hasSubterm(lt, y, true));
+  ASSERT_FALSE(hasSubterm(lt, lt, true));
+  ASSERT_FALSE(hasSubterm(sum, lt));
+  ASSERT_FALSE(hasSubterm(lt, eq));
+  ASSERT_FALSE(hasSubterm(lt, z));
+  ASSERT_TRUE(hasSubtermKind(PLUS, lt));
+  ASSERT_FALSE(hasSubtermKind(EQUAL, lt));
+}
+
 TEST_F(TestNodeBlackNodeAlgorithm, get_operators_map)
 {
   // map to store result
@@ -226,6 +226,26 @@ TEST_F(TestNodeBlackNode, operator_assign)
   ASSERT_EQ(a, c);
 }
 
+/* move constructor and move assignment */
+TEST_F(TestNodeBlackNode, move)
+{
+  Node c = d_nodeManager->mkNode(
+      NOT, d_nodeManager->mkSkolem("c", d_nodeManager->booleanType()));
+  Node a = c;
+  Node b(std::move(a));
+  ASSERT_TRUE(a.isNull());
+  ASSERT_EQ(b, c);
+
+  Node d;
+  d = std::move(b);
+  ASSERT_EQ(d, c);
+
+  NodeBuilder<> nb(AND);
+  nb << std::move(d) << c;
+  ASSERT_TRUE(d.isNull());
+  ASSERT_EQ(nb.constructNode(), c.andNode(c));
+}
+
 /* operator< */
 TEST_F(TestNodeBlackNode, operator_less_than)
 {
@@ -0,0 +1,197 @@
+/*********************                                                        */
+/*! \file node_dag_io_white.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of node_dag_io.{h,cpp}
+ **/
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/exception.h"
+#include "expr/node_dag_io.h"
+#include "expr/node_manager.h"
+#include "test_node.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+#include "util/roundingmode.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+using namespace kind;
+
+namespace test {
+
+class TestNodeWhiteNodeDagIo : public TestNode
+{
+ protected:
+  /** Write the DAG of roots, returning its words */
+  std::vector<uint32_t> write(const std::vector<Node>& roots)
+  {
+    std::stringstream ss;
+    NodeDagWriter().write(ss, roots);
+    std::string data = ss.str();
+    std::vector<uint32_t> words(data.size() / sizeof(uint32_t));
+    std::memcpy(words.data(), data.data(), data.size());
+    return words;
+  }
+  /** Read the DAG in words with reader, adding its roots */
+  void read(NodeDagReader& reader,
+            const std::vector<uint32_t>& words,
+            std::vector<Node>& roots)
+  {
+    reader.read(reinterpret_cast<const char*>(words.data()),
+                words.size() * sizeof(uint32_t),
+                roots);
+  }
+  /** Check that reading words throws and adds no roots */
+  void checkMalformed(const std::vector<uint32_t>& words)
+  {
+    NodeDagReader reader;
+    std::vector<Node> roots;
+    ASSERT_THROW(read(reader, words, roots), Exception);
+    ASSERT_TRUE(roots.empty());
+  }
+  /** The index of the first word after the header */
+  static constexpr size_t s_body = 7;
+};
+
+TEST_F(TestNodeWhiteNodeDagIo, round_trip)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  TypeNode bvType = d_nodeManager->mkBitVectorType(8);
+  Node x = d_nodeManager->mkVar("x", intType);
+  Node f = d_nodeManager->mkVar(
+      "f", d_nodeManager->mkFunctionType(intType, intType));
+  Node y = d_nodeManager->mkVar("y", bvType);
+  Node s = d_nodeManager->mkVar("s", d_nodeManager->stringType());
+  Node half = d_nodeManager->mkConst(Rational(-1, 2));
+  Node fx = d_nodeManager->mkNode(APPLY_UF, f, x);
+  Node n1 = d_nodeManager->mkNode(
+      GT, d_nodeManager->mkNode(PLUS, fx, half), x);
+  Node n2 = d_nodeManager->mkNode(
+      EQUAL,
+      d_nodeManager->mkNode(
+          d_nodeManager->mkConst(BitVectorExtract(3, 0)), y),
+      d_nodeManager->mkConst(BitVector(4, 5u)));
+  Node n3 = d_nodeManager->mkNode(
+      EQUAL,
+      s,
+      d_nodeManager->mkConst(String(std::vector<unsigned>{0, 97, 0x2fff})));
+  Node rm = d_nodeManager->mkConst(ROUND_TOWARD_ZERO);
+  std::vector<Node> orig = {n1, n2, n3, n1, rm};
+  std::vector<uint32_t> words = write(orig);
+
+  // with all variables bound, the same nodes are read
+  NodeDagReader reader;
+  reader.bind(x);
+  reader.bind(f);
+  reader.bind(y);
+  reader.bind(s);
+  std::vector<Node> roots = {d_nodeManager->mkConst(true)};
+  read(reader, words, roots);
+  ASSERT_EQ(roots.size(), orig.size() + 1);
+  for (size_t i = 0, n = orig.size(); i < n; i++)
+  {
+    ASSERT_EQ(roots[i + 1], orig[i]);
+  }
+
+  // otherwise, they are read fresh
+  NodeDagReader fresh;
+  roots.clear();
+  read(fresh, words, roots);
+  ASSERT_EQ(roots.size(), orig.size());
+  ASSERT_NE(roots[0], n1);
+  ASSERT_EQ(roots[0], roots[3]);
+  ASSERT_EQ(roots[0].getKind(), GT);
+  ASSERT_NE(roots[0][1], x);
+  ASSERT_EQ(roots[0][1].getType(), intType);
+  ASSERT_EQ(roots[4], rm);
+}
+
+TEST_F(TestNodeWhiteNodeDagIo, truncated)
+{
+  Node x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+  std::vector<uint32_t> words =
+      write({d_nodeManager->mkNode(GT, x, d_nodeManager->mkConst(Rational(1)))});
+  for (size_t size = 0, n = words.size(); size < n; size++)
+  {
+    checkMalformed(std::vector<uint32_t>(words.begin(), words.begin() + size));
+  }
+  words[2]++;
+  checkMalformed(words);
+}
+
+TEST_F(TestNodeWhiteNodeDagIo, invalid_string)
+{
+  std::vector<uint32_t> words = write(
+      {d_nodeManager->mkConst(String(std::vector<unsigned>{97, 98}))});
+  // no strings and no types
+  ASSERT_EQ(words[s_body], static_cast<uint32_t>(CONST_STRING));
+  ASSERT_EQ(words[s_body + 1], 2u);
+  words[s_body + 3] = String::num_codes();
+  checkMalformed(words);
+}
+
+TEST_F(TestNodeWhiteNodeDagIo, invalid_bitvector)
+{
+  std::vector<uint32_t> words = write({d_nodeManager->mkConst(BitVector(4, 5u))});
+  // the string "5", then the constant
+  ASSERT_EQ(words[s_body], 1u);
+  size_t rec = s_body + 2;
+  ASSERT_EQ(words[rec], static_cast<uint32_t>(CONST_BITVECTOR));
+  ASSERT_EQ(words[rec + 2], 4u);
+  std::vector<uint32_t> zero = words;
+  zero[rec + 2] = 0;
+  checkMalformed(zero);
+  std::vector<uint32_t> tooNarrow = words;
+  tooNarrow[rec + 2] = 2;
+  checkMalformed(tooNarrow);
+  std::vector<uint32_t> notNumeral = words;
+  reinterpret_cast<char*>(&notNumeral[s_body + 1])[0] = 'x';
+  checkMalformed(notNumeral);
+}
+
+TEST_F(TestNodeWhiteNodeDagIo, invalid_floatingpoint_type)
+{
+  Node z =
+      d_nodeManager->mkVar("z", d_nodeManager->mkFloatingPointType(8, 24));
+  std::vector<uint32_t> words = write({z});
+  // the string "z", then the type
+  size_t rec = s_body + 2;
+  ASSERT_EQ(words[rec], static_cast<uint32_t>(FLOATINGPOINT_TYPE));
+  ASSERT_EQ(words[rec + 2], 8u);
+  ASSERT_EQ(words[rec + 3], 24u);
+  std::vector<uint32_t> exp = words;
+  exp[rec + 2] = 1;
+  checkMalformed(exp);
+  std::vector<uint32_t> sig = words;
+  sig[rec + 3] = 0;
+  checkMalformed(sig);
+}
+
+TEST_F(TestNodeWhiteNodeDagIo, ill_typed)
+{
+  Node p = d_nodeManager->mkVar("p", d_nodeManager->booleanType());
+  Node q = d_nodeManager->mkVar("q", d_nodeManager->booleanType());
+  std::vector<uint32_t> words = write({d_nodeManager->mkNode(AND, p, q)});
+  // the strings "p" and "q", then the Boolean type
+  size_t rec = s_body + 4;
+  ASSERT_EQ(words[rec], static_cast<uint32_t>(TYPE_CONSTANT));
+  ASSERT_EQ(words[rec + 2], static_cast<uint32_t>(BOOLEAN_TYPE));
+  words[rec + 2] = static_cast<uint32_t>(INTEGER_TYPE);
+  checkMalformed(words);
+}
+
+}  // namespace test
+}  // namespace cvc5
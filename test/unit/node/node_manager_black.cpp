@@ -136,6 +136,37 @@ TEST_F(TestNodeBlackNodeManager, mkNode_vector_of_tnode)
   }
 }
 
+TEST_F(TestNodeBlackNodeManager, mkNode_initializer_list)
+{
+  Node x1 = d_nodeManager->mkSkolem("x1", d_nodeManager->booleanType());
+  Node x2 = d_nodeManager->mkSkolem("x2", d_nodeManager->booleanType());
+  Node x3 = d_nodeManager->mkSkolem("x3", d_nodeManager->booleanType());
+  Node n = d_nodeManager->mkNode(AND, {x1, x2, x3});
+  ASSERT_EQ(n.getNumChildren(), 3u);
+  ASSERT_EQ(n.getKind(), AND);
+  ASSERT_EQ(n[0], x1);
+  ASSERT_EQ(n[1], x2);
+  ASSERT_EQ(n[2], x3);
+  std::vector<Node> args = {x1, x2, x3};
+  ASSERT_EQ(n, d_nodeManager->mkNode(AND, args));
+}
+
+TEST_F(TestNodeBlackNodeManager, mkNode_existing)
+{
+  // more children than fit in the node value on the stack of mkNode
+  std::vector<Node> args;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    args.push_back(d_nodeManager->mkSkolem("x", d_nodeManager->booleanType()));
+  }
+  Node n = d_nodeManager->mkNode(OR, args);
+  ASSERT_EQ(n.getNumChildren(), args.size());
+  ASSERT_EQ(n, d_nodeManager->mkNode(OR, args));
+  Node m = d_nodeManager->mkNode(AND, args[0], args[1]);
+  ASSERT_EQ(m, d_nodeManager->mkNode(AND, {args[0], args[1]}));
+  ASSERT_EQ(m, args[0].andNode(args[1]));
+}
+
 TEST_F(TestNodeBlackNodeManager, mkSkolem_with_name)
 {
   Node x = d_nodeManager->mkSkolem(
@@ -326,7 +357,8 @@ TEST_F(TestNodeBlackNodeManager, mkNode_too_many_children)
     vars.push_back(skolem_j);
     vars.push_back(orNode);
   }
-  ASSERT_DEATH(d_nodeManager->mkNode(AND, vars), "toSize > d_nvMaxChildren");
+  ASSERT_DEATH(d_nodeManager->mkNode(AND, vars),
+               "Nodes with kind AND must have at most");
 #endif
 }
 }  // namespace test
@@ -15,6 +15,7 @@
  **/
 
 #include <string>
+#include <vector>
 
 #include "expr/node_manager.h"
 #include "test_node.h"
@@ -80,5 +81,78 @@ TEST_F(TestNodeWhiteNodeManager, topological_sort)
     ASSERT_EQ(NodeManager::TopologicalSort(roots), result);
   }
 }
+
+TEST_F(TestNodeWhiteNodeManager, pool)
+{
+  size_t size = d_nodeManager->poolSize();
+  d_nodeManager->setTrackPoolPeakSize(true);
+  d_nodeManager->resetPoolPeakSize();
+  Node x = d_nodeManager->mkSkolem("x", *d_intTypeNode);
+  {
+    std::vector<Node> nodes;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+      nodes.push_back(d_nodeManager->mkNode(
+          kind::PLUS, x, d_nodeManager->mkConst(Rational(i))));
+    }
+    ASSERT_EQ(d_nodeManager->poolSize(), size + 2000);
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+      Node n = d_nodeManager->mkNode(kind::PLUS,
+                                     x,
+                                     d_nodeManager->mkConst(Rational(i)));
+      ASSERT_EQ(n, nodes[i]);
+      ASSERT_EQ(d_nodeManager->poolLookup(n.d_nv), n.d_nv);
+    }
+    ASSERT_EQ(d_nodeManager->poolSize(), size + 2000);
+  }
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_EQ(d_nodeManager->poolSize(), size);
+  ASSERT_EQ(d_nodeManager->poolPeakSize(), size + 2000);
+  d_nodeManager->resetPoolPeakSize();
+  ASSERT_EQ(d_nodeManager->poolPeakSize(), size);
+}
+
+TEST_F(TestNodeWhiteNodeManager, gc_threshold)
+{
+  size_t size = d_nodeManager->poolSize();
+  d_nodeManager->setGcOptions(10, 0);
+  for (int32_t i = 0; i < 100; ++i)
+  {
+    d_nodeManager->mkConst(Rational(i));
+    // zombies are reclaimed once there are more than 10 of them
+    ASSERT_LE(d_nodeManager->poolSize(), size + 10);
+  }
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_EQ(d_nodeManager->poolSize(), size);
+}
+
+TEST_F(TestNodeWhiteNodeManager, gc_slice)
+{
+  size_t size = d_nodeManager->poolSize();
+  // without a slice budget, reclaimZombiesSlice() does nothing
+  d_nodeManager->setGcOptions(1000, 0);
+  for (int32_t i = 0; i < 500; ++i)
+  {
+    d_nodeManager->mkConst(Rational(i));
+  }
+  ASSERT_EQ(d_nodeManager->poolSize(), size + 500);
+  d_nodeManager->reclaimZombiesSlice();
+  ASSERT_EQ(d_nodeManager->poolSize(), size + 500);
+
+  // a budget of a minute is enough to reclaim all zombies in one slice
+  d_nodeManager->setGcOptions(1000, 60000000);
+  d_nodeManager->reclaimZombiesSlice();
+  ASSERT_EQ(d_nodeManager->poolSize(), size);
+
+  // zombies are not reclaimed while the threshold is not exceeded
+  for (int32_t i = 0; i < 1000; ++i)
+  {
+    d_nodeManager->mkConst(Rational(i));
+  }
+  ASSERT_EQ(d_nodeManager->poolSize(), size + 1000);
+  d_nodeManager->mkConst(Rational(1000));
+  ASSERT_EQ(d_nodeManager->poolSize(), size);
+}
 }  // namespace test
 }  // namespace cvc5
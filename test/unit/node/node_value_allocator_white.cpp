@@ -0,0 +1,120 @@
+/*********************                                                        */
+/*! \file node_value_allocator_white.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of cvc5::expr::NodeValueAllocator.
+ **
+ ** White box testing of cvc5::expr::NodeValueAllocator.
+ **/
+
+#include <set>
+#include <vector>
+
+#include "expr/node_value.h"
+#include "expr/node_value_allocator.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace cvc5::expr;
+
+namespace test {
+
+class TestNodeWhiteNodeValueAllocator : public TestInternal
+{
+ protected:
+  /** Allocate a node value of kind k with nchildren (unset) children. */
+  static NodeValue* allocate(NodeValueAllocator& alloc,
+                             Kind k,
+                             size_t nchildren)
+  {
+    NodeValue* nv = alloc.allocate(nchildren);
+    nv->d_kind = NodeValue::kindToDKind(k);
+    nv->d_nchildren = nchildren;
+    return nv;
+  }
+};
+
+TEST_F(TestNodeWhiteNodeValueAllocator, reuse)
+{
+  NodeValueAllocator alloc;
+  ASSERT_EQ(alloc.getNumLive(), 0);
+  ASSERT_EQ(alloc.getSlabBytes(), 0);
+
+  NodeValue* a = allocate(alloc, kind::PLUS, 2);
+  NodeValue* b = allocate(alloc, kind::PLUS, 2);
+  ASSERT_EQ(alloc.getNumLive(), 2);
+  ASSERT_GT(alloc.getSlabBytes(), 0);
+  // consecutive allocations are adjacent in memory
+  ASSERT_EQ(reinterpret_cast<char*>(b),
+            reinterpret_cast<char*>(a) + sizeof(NodeValue)
+                + 2 * sizeof(NodeValue*));
+
+  // freed blocks are reused by the next allocation of their size class
+  alloc.deallocate(a);
+  ASSERT_EQ(alloc.getNumLive(), 1);
+  NodeValue* c = allocate(alloc, kind::MULT, 1);
+  ASSERT_NE(c, a);
+  ASSERT_EQ(allocate(alloc, kind::AND, 2), a);
+  ASSERT_EQ(alloc.getNumLive(), 3);
+
+  alloc.deallocate(a);
+  alloc.deallocate(b);
+  alloc.deallocate(c);
+  ASSERT_EQ(alloc.getNumLive(), 0);
+}
+
+TEST_F(TestNodeWhiteNodeValueAllocator, size_classes)
+{
+  NodeValueAllocator alloc;
+  std::vector<NodeValue*> nvs;
+  std::set<NodeValue*> distinct;
+  // enough node values to need several slabs per size class
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    NodeValue* nv = allocate(
+        alloc, kind::AND, i % (NodeValueAllocator::s_maxSlabChildren + 1));
+    nvs.push_back(nv);
+    distinct.insert(nv);
+  }
+  ASSERT_EQ(distinct.size(), nvs.size());
+  ASSERT_EQ(alloc.getNumLive(), nvs.size());
+  size_t slabBytes = alloc.getSlabBytes();
+  for (NodeValue* nv : nvs)
+  {
+    alloc.deallocate(nv);
+  }
+  ASSERT_EQ(alloc.getNumLive(), 0);
+  // the slabs are kept for later allocations
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    nvs[i] = allocate(
+        alloc, kind::AND, i % (NodeValueAllocator::s_maxSlabChildren + 1));
+  }
+  ASSERT_EQ(alloc.getSlabBytes(), slabBytes);
+  for (NodeValue* nv : nvs)
+  {
+    alloc.deallocate(nv);
+  }
+}
+
+TEST_F(TestNodeWhiteNodeValueAllocator, large)
+{
+  NodeValueAllocator alloc;
+  // node values with many children are allocated with malloc
+  NodeValue* nv =
+      allocate(alloc, kind::AND, NodeValueAllocator::s_maxSlabChildren + 1);
+  ASSERT_EQ(alloc.getNumLive(), 0);
+  ASSERT_EQ(alloc.getSlabBytes(), 0);
+  alloc.deallocate(nv);
+  ASSERT_EQ(alloc.getNumLive(), 0);
+}
+}  // namespace test
+}  // namespace cvc5
@@ -139,6 +139,45 @@ TEST_F(TestNodeBlackSymbolTable, push_scope)
   ASSERT_EQ(symtab.lookup("x"), x);
 }
 
+TEST_F(TestNodeBlackSymbolTable, nested_scopes)
+{
+  SymbolTable symtab;
+  api::Sort booleanType = d_solver.getBooleanSort();
+  api::Term x = d_solver.mkConst(booleanType);
+  api::Term y = d_solver.mkConst(booleanType);
+  api::Term z = d_solver.mkConst(booleanType);
+  symtab.bind("x", x);
+  symtab.pushScope();
+  symtab.bind("x", y);
+  symtab.bind("y", y);
+  // rebinding in the same scope
+  symtab.bind("x", z);
+  symtab.pushScope();
+  symtab.bind("z", z, true);
+  symtab.bind("y", x);
+  ASSERT_EQ(symtab.getLevel(), 3);
+  ASSERT_EQ(symtab.lookup("x"), z);
+  ASSERT_EQ(symtab.lookup("y"), x);
+
+  symtab.popScope();
+  ASSERT_EQ(symtab.lookup("x"), z);
+  ASSERT_EQ(symtab.lookup("y"), y);
+  symtab.popScope();
+  ASSERT_EQ(symtab.getLevel(), 1);
+  ASSERT_EQ(symtab.lookup("x"), x);
+  ASSERT_FALSE(symtab.isBound("y"));
+  // bindings at level zero survive popping their scope
+  ASSERT_TRUE(symtab.isBound("z"));
+  ASSERT_EQ(symtab.lookup("z"), z);
+
+  symtab.pushScope();
+  symtab.bind("y", y);
+  symtab.resetAssertions();
+  ASSERT_EQ(symtab.getLevel(), 1);
+  ASSERT_FALSE(symtab.isBound("y"));
+  ASSERT_TRUE(symtab.isBound("z"));
+}
+
 TEST_F(TestNodeBlackSymbolTable, bad_pop)
 {
   SymbolTable symtab;
@@ -391,5 +391,119 @@ TEST_F(TestParserBlackSmt2Parser, bad_exprs)
   tryBadExpr("(* 5 01)", true);  // '01' is not a valid integer constant
 #endif
 }
+
+/* -------------------------------------------------------------------------- */
+
+class TestParserBlackSmt2FastParser : public TestParserBlackSmt2Parser
+{
+ protected:
+  void SetUp() override
+  {
+    TestParserBlackSmt2Parser::SetUp();
+    d_options.setOption("smt2-fast-parser", "true");
+  }
+};
+
+TEST_F(TestParserBlackSmt2FastParser, good_inputs)
+{
+  tryGoodInput("");  // empty string is OK
+  tryGoodInput("(set-logic QF_UF)");
+  tryGoodInput("(set-info :notes |This is a note, take note!|)");
+  tryGoodInput("(set-logic QF_UF) (assert true) (check-sat)");
+  tryGoodInput(
+      "(set-logic QF_UF) (declare-sort a 0) "
+      "(declare-fun f (a) a) (declare-fun x () a) "
+      "(assert (= (f x) x))");
+  tryGoodInput(";; nothing but a comment");
+  tryGoodInput("; a comment\n(check-sat ; goodbye\n)");
+  tryGoodInput(
+      "(set-logic QF_UF) (define-sort B () Bool) (declare-fun |a b| () B) "
+      "(define-fun f ((x B)) B (not x)) "
+      "(assert (! (let ((y (f |a b|))) (let ((z (and y y))) z)) :named n))");
+  tryGoodInput(
+      "(set-logic QF_BV) (declare-fun x () (_ BitVec 8)) "
+      "(assert (= ((_ extract 3 0) x) #b0101 ((_ extract 7 4) (_ bv5 8))))");
+  tryGoodInput(
+      "(set-logic UF) (declare-sort U 0) (push 1) "
+      "(assert (forall ((x U) (y U)) (! (= x y) :pattern ((= x y))))) "
+      "(pop 1) (check-sat)");
+  tryGoodInput(
+      "(set-logic ALL) (declare-fun s () String) "
+      "(assert (= s \"a\"\"b\")) (assert (= (to_real 1) 1.0))");
+}
+
+TEST_F(TestParserBlackSmt2FastParser, bad_inputs)
+{
+  // competition builds don't do any checking
+#ifndef CVC4_COMPETITION_MODE
+  // no arguments
+  tryBadInput("(assert)");
+  // illegal character in symbol
+  tryBadInput("(set-info :notes |Symbols can't contain the | character|)");
+  // check-sat should not have an argument
+  tryBadInput("(set-logic QF_UF) (check-sat true)", true);
+  // no argument
+  tryBadInput("(declare-sort a)");
+  // double declaration
+  tryBadInput("(declare-sort a 0) (declare-sort a 0)");
+  // should be "(declare-fun p () Bool)"
+  tryBadInput("(set-logic QF_UF) (declare-fun p Bool)");
+  // unbalanced parentheses
+  tryBadInput("(set-logic QF_UF) (assert (not true)");
+  tryBadInput("(set-logic QF_UF))");
+  // unterminated string and quoted symbol
+  tryBadInput("(set-info :notes \"abc)");
+  tryBadInput("(set-info :notes |abc)");
+  // datatypes are not supported by the fast parser
+  tryBadInput(
+      "(set-logic QF_DT) (declare-datatypes ((D 0)) (((c))))");
+  tryBadInput("(set-logic QF_DT) (declare-datatype D ((c)))");
+  // strict mode
+  // no set-logic, core theory symbol "true" undefined
+  tryBadInput("(assert true)", true);
+  // core theory symbol "Bool" undefined
+  tryBadInput("(declare-fun p Bool)", true);
+#endif
+}
+
+TEST_F(TestParserBlackSmt2FastParser, good_exprs)
+{
+  tryGoodExpr("(and a b)");
+  tryGoodExpr("(or (and a b) c)");
+  tryGoodExpr("(=> (and (=> a b) a) b)");
+  tryGoodExpr("(= (xor a b) (and (or a b) (not (and a b))))");
+  tryGoodExpr("(ite a (f x) y)");
+  tryGoodExpr("(let ((d (and a b))) (or d c))");
+  tryGoodExpr("1");
+  tryGoodExpr("1.5");
+  tryGoodExpr("#xfab09c7");
+  tryGoodExpr("#b0001011");
+  tryGoodExpr("(* 5 1)");
+}
+
+TEST_F(TestParserBlackSmt2FastParser, bad_exprs)
+{
+// competition builds don't do any checking
+#ifndef CVC4_COMPETITION_MODE
+  tryBadExpr("(and)");             // wrong arity
+  tryBadExpr("(and a b");          // no closing paren
+  tryBadExpr("(a and b)");         // infix
+  tryBadExpr("(implies a b)");     // no implies in v2
+  tryBadExpr("(OR (AND a b) c)");  // wrong case
+  tryBadExpr("(not a b)");         // wrong arity
+  tryBadExpr("(ite a x)");         // wrong arity
+  tryBadExpr("(a b)");             // using non-function as function
+  tryBadExpr("(let ((d a)) e)");   // e is not declared
+  tryBadExpr(".5");  // rational constants must have integer prefix
+  tryBadExpr("#x");  // hex constants must have at least one digit
+  tryBadExpr("#b");  // ditto binary constants
+  tryBadExpr("#xg0f");
+  tryBadExpr("#b9");
+  tryBadExpr("\"abc");  // unterminated string
+  // Bad strict exprs
+  tryBadExpr("(and a)", true);   // no unary and's
+  tryBadExpr("(* 5 01)", true);  // '01' is not a valid integer constant
+#endif
+}
 }  // namespace test
 }  // namespace cvc5
@@ -27,6 +27,7 @@
 #include "options/language.h"
 #include "parser/parser.h"
 #include "parser/parser_builder.h"
+#include "smt/command.h"
 #include "test_api.h"
 
 namespace cvc5 {
@@ -133,5 +134,35 @@ TEST_F(TestParseBlackParserBuilder, true_stream_input)
                      .withStreamInput(ss));
 }
 
+TEST_F(TestParseBlackParserBuilder, pipe_input)
+{
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  std::string input =
+      "(set-logic QF_UF) ; (a comment)\n"
+      "(declare-const |a(| Bool)\n"
+      "(assert |a(|)";
+  ASSERT_EQ(write(fds[1], input.c_str(), input.size()),
+            static_cast<ssize_t>(input.size()));
+  close(fds[1]);
+
+  size_t idle = 0;
+  std::unique_ptr<Parser> parser(
+      ParserBuilder(&d_solver, d_symman.get(), "foo")
+          .withInputLanguage(LANG_SMTLIB_V2_6)
+          .withPipeInput(fds[0], [&idle]() { idle++; })
+          .build());
+  std::unique_ptr<Command> cmd(parser->nextCommand());
+  ASSERT_NE(dynamic_cast<SetBenchmarkLogicCommand*>(cmd.get()), nullptr);
+  cmd.reset(parser->nextCommand());
+  ASSERT_NE(dynamic_cast<DeclareFunctionCommand*>(cmd.get()), nullptr);
+  cmd.reset(parser->nextCommand());
+  ASSERT_NE(dynamic_cast<AssertCommand*>(cmd.get()), nullptr);
+  cmd.reset(parser->nextCommand());
+  ASSERT_EQ(cmd, nullptr);
+  close(fds[0]);
+  ASSERT_GE(idle, 1u);
+}
+
 }  // namespace test
 }  // namespace cvc5
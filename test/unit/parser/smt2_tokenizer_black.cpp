@@ -0,0 +1,174 @@
+/*********************                                                        */
+/*! \file smt2_tokenizer_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::parser::Smt2Tokenizer.
+ **
+ ** Black box testing of cvc5::parser::Smt2Tokenizer.
+ **/
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/smt2/smt2_tokenizer.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace parser;
+
+namespace test {
+
+class TestParserBlackSmt2Tokenizer : public TestInternal
+{
+ protected:
+  using Tokens = std::vector<std::pair<Smt2TokenKind, std::string>>;
+
+  /** Returns the tokens of input, excluding the end of file. */
+  static Tokens lex(const std::string& input,
+                    bool escapeDupDblQuote = false,
+                    size_t threads = 1)
+  {
+    Smt2Tokenizer tokenizer(input);
+    tokenizer.setEscapeDupDblQuote(escapeDupDblQuote);
+    tokenizer.setThreads(threads);
+    Tokens tokens;
+    for (Smt2Token t = tokenizer.next(); t.d_kind != Smt2TokenKind::END_OF_FILE;
+         t = tokenizer.next())
+    {
+      tokens.emplace_back(t.d_kind, std::string(t.d_text));
+    }
+    return tokens;
+  }
+};
+
+TEST_F(TestParserBlackSmt2Tokenizer, tokens)
+{
+  Tokens expected = {{Smt2TokenKind::LPAREN, "("},
+                     {Smt2TokenKind::SYMBOL, "assert"},
+                     {Smt2TokenKind::LPAREN, "("},
+                     {Smt2TokenKind::SYMBOL, "!"},
+                     {Smt2TokenKind::SYMBOL, "x.y@1"},
+                     {Smt2TokenKind::KEYWORD, ":named"},
+                     {Smt2TokenKind::QUOTED_SYMBOL, "a b"},
+                     {Smt2TokenKind::NUMERAL, "42"},
+                     {Smt2TokenKind::DECIMAL, "3.25"},
+                     {Smt2TokenKind::HEX, "#xA0f"},
+                     {Smt2TokenKind::BINARY, "#b01"},
+                     {Smt2TokenKind::STRING, "\"s\""},
+                     {Smt2TokenKind::RPAREN, ")"},
+                     {Smt2TokenKind::RPAREN, ")"}};
+  ASSERT_EQ(lex("(assert (! x.y@1 :named |a b| 42 3.25 #xA0f #b01 \"s\"))"),
+            expected);
+  // whitespace and comments are skipped
+  ASSERT_EQ(lex(" \t; a comment\r\n(assert ; another ( comment\n"
+                "(! x.y@1\f:named\n|a b| 42 3.25 #xA0f #b01 \"s\")) ; end"),
+            expected);
+  ASSERT_TRUE(lex("").empty());
+  ASSERT_TRUE(lex("  ; only a comment").empty());
+}
+
+TEST_F(TestParserBlackSmt2Tokenizer, numbers)
+{
+  // a numeral followed by a dot without digits is not a decimal
+  ASSERT_EQ(lex("1."),
+            Tokens({{Smt2TokenKind::NUMERAL, "1"},
+                    {Smt2TokenKind::SYMBOL, "."}}));
+  ASSERT_EQ(lex("007"), Tokens({{Smt2TokenKind::NUMERAL, "007"}}));
+  ASSERT_EQ(lex("#xg"),
+            Tokens({{Smt2TokenKind::INVALID, "#x"},
+                    {Smt2TokenKind::SYMBOL, "g"}}));
+  ASSERT_EQ(lex("#b2"),
+            Tokens({{Smt2TokenKind::INVALID, "#b"},
+                    {Smt2TokenKind::NUMERAL, "2"}}));
+}
+
+TEST_F(TestParserBlackSmt2Tokenizer, strings)
+{
+  // SMT-LIB 2.0 escapes the double quote by a backslash
+  ASSERT_EQ(lex("\"a\\\"b\" \"\""),
+            Tokens({{Smt2TokenKind::STRING, "\"a\\\"b\""},
+                    {Smt2TokenKind::STRING, "\"\""}}));
+  // SMT-LIB 2.5 escapes it by doubling it
+  ASSERT_EQ(lex("\"a\"\"b\" \"\"", true),
+            Tokens({{Smt2TokenKind::STRING, "\"a\"\"b\""},
+                    {Smt2TokenKind::STRING, "\"\""}}));
+  ASSERT_EQ(lex("\"a\"\"b\""),
+            Tokens({{Smt2TokenKind::STRING, "\"a\""},
+                    {Smt2TokenKind::STRING, "\"b\""}}));
+  ASSERT_EQ(lex("\"abc"),
+            Tokens({{Smt2TokenKind::UNTERMINATED_STRING, "\"abc"}}));
+}
+
+TEST_F(TestParserBlackSmt2Tokenizer, invalid)
+{
+  ASSERT_EQ(lex("|ab"),
+            Tokens({{Smt2TokenKind::UNTERMINATED_QUOTED_SYMBOL, "|ab"}}));
+  // the text of a quoted symbol with a backslash ends with the backslash
+  ASSERT_EQ(lex("|a\\b|"),
+            Tokens({{Smt2TokenKind::UNTERMINATED_QUOTED_SYMBOL, "|a\\"},
+                    {Smt2TokenKind::SYMBOL, "b"},
+                    {Smt2TokenKind::UNTERMINATED_QUOTED_SYMBOL, "|"}}));
+  ASSERT_EQ(lex(": {"),
+            Tokens({{Smt2TokenKind::INVALID, ":"},
+                    {Smt2TokenKind::INVALID, "{"}}));
+}
+
+TEST_F(TestParserBlackSmt2Tokenizer, peek_and_offsets)
+{
+  std::string input = "(a\n  bc)";
+  Smt2Tokenizer tokenizer(input);
+  ASSERT_EQ(tokenizer.peek().d_kind, Smt2TokenKind::LPAREN);
+  ASSERT_EQ(tokenizer.peek().d_kind, Smt2TokenKind::LPAREN);
+  ASSERT_EQ(tokenizer.next().d_kind, Smt2TokenKind::LPAREN);
+  ASSERT_EQ(tokenizer.next().d_text, "a");
+  Smt2Token t = tokenizer.next();
+  ASSERT_EQ(t.d_text, "bc");
+  ASSERT_EQ(tokenizer.getLastOffset(), 5);
+  size_t line, column;
+  tokenizer.getLineColumn(tokenizer.getLastOffset(), line, column);
+  ASSERT_EQ(line, 2);
+  ASSERT_EQ(column, 2);
+  ASSERT_EQ(tokenizer.next().d_kind, Smt2TokenKind::RPAREN);
+  ASSERT_EQ(tokenizer.next().d_kind, Smt2TokenKind::END_OF_FILE);
+  ASSERT_EQ(tokenizer.next().d_kind, Smt2TokenKind::END_OF_FILE);
+
+  // the position of the first character is taken into account on its line
+  std::string next = "x y\nz";
+  tokenizer.reset(next, 3, 10);
+  ASSERT_EQ(tokenizer.next().d_text, "x");
+  ASSERT_EQ(tokenizer.next().d_text, "y");
+  tokenizer.getLineColumn(tokenizer.getLastOffset(), line, column);
+  ASSERT_EQ(line, 3);
+  ASSERT_EQ(column, 12);
+  ASSERT_EQ(tokenizer.next().d_text, "z");
+  tokenizer.getLineColumn(tokenizer.getLastOffset(), line, column);
+  ASSERT_EQ(line, 4);
+  ASSERT_EQ(column, 0);
+}
+
+TEST_F(TestParserBlackSmt2Tokenizer, threads)
+{
+  std::string input;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    input += "(assert (= |x " + std::to_string(i) + "| \"a)\" #b1))";
+    input += "; comment )\n";
+  }
+  // an unterminated string is lexed sequentially
+  input += "(assert \"abc";
+  Tokens expected = lex(input);
+  ASSERT_EQ(expected.size(), 1000 * 9 + 3);
+  ASSERT_EQ(lex(input, false, 4), expected);
+  ASSERT_EQ(lex(input, true, 3), lex(input, true));
+}
+}  // namespace test
+}  // namespace cvc5
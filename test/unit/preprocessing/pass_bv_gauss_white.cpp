@@ -881,6 +881,77 @@ TEST_F(TestPPWhiteBVGauss, elim_partial2)
   testGaussElimX(Integer(11), rhs, lhs, BVGauss::Result::PARTIAL);
 }
 
+TEST_F(TestPPWhiteBVGauss, elim_sparse_chain)
+{
+  /* -------------------------------------------------------------------
+   * x_i + 3 x_{i+1} = i  for 0 <= i < n - 1
+   * x_{n-1}     = 5       modulo 2^64, 2^32 and 11
+   * ------------------------------------------------------------------- */
+  size_t n = 100;
+  for (uint64_t mod : {uint64_t(0), uint64_t(1) << 32, uint64_t(11)})
+  {
+    std::vector<BVGauss::SparseRow> lhs(n);
+    std::vector<uint64_t> rhs(n);
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+      lhs[i] = {{i, 1}, {i + 1, 3}};
+      rhs[i] = mod == 0 ? i : i % mod;
+    }
+    lhs[n - 1] = {{n - 1, 1}};
+    rhs[n - 1] = 5;
+    std::vector<size_t> pivots;
+    ASSERT_EQ(BVGauss::gaussElimSparse(mod, n, rhs, lhs, pivots),
+              BVGauss::Result::UNIQUE);
+    /* back substitution on the original system */
+    std::vector<Integer> x(n);
+    Integer imod = mod == 0 ? Integer(1).multiplyByPow2(64) : Integer(mod);
+    x[n - 1] = Integer(5);
+    for (size_t i = n - 1; i-- > 0;)
+    {
+      x[i] = (Integer(i) - x[i + 1] * Integer(3)).euclidianDivideRemainder(
+          imod);
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+      ASSERT_EQ(lhs[i].size(), 1);
+      ASSERT_EQ(lhs[i][0].second, 1);
+      ASSERT_EQ(Integer(rhs[i]), x[lhs[i][0].first]);
+      ASSERT_EQ(pivots[i], lhs[i][0].first);
+    }
+  }
+}
+
+TEST_F(TestPPWhiteBVGauss, elim_sparse_not_coprime)
+{
+  std::vector<BVGauss::SparseRow> lhs;
+  std::vector<uint64_t> rhs;
+  std::vector<size_t> pivots;
+
+  /* -------------------------------------------------------------------
+   *  x y  modulo 2^64, no pivot for y after eliminating x
+   *  2 4  2
+   *  3 4  5
+   * ------------------------------------------------------------------- */
+  lhs = {{{0, 2}, {1, 4}}, {{0, 3}, {1, 4}}};
+  rhs = {2, 5};
+  ASSERT_EQ(BVGauss::gaussElimSparse(0, 2, rhs, lhs, pivots),
+            BVGauss::Result::INVALID);
+
+  /* -------------------------------------------------------------------
+   *  x y          x y
+   *  2 1  2  -->  0 1   4  modulo 2^64
+   *  3 2  5       1 0  -1
+   * ------------------------------------------------------------------- */
+  lhs = {{{0, 2}, {1, 1}}, {{0, 3}, {1, 2}}};
+  rhs = {2, 5};
+  ASSERT_EQ(BVGauss::gaussElimSparse(0, 2, rhs, lhs, pivots),
+            BVGauss::Result::UNIQUE);
+  ASSERT_EQ(pivots[0], 1);
+  ASSERT_EQ(pivots[1], 0);
+  ASSERT_EQ(rhs[0], 4);
+  ASSERT_EQ(rhs[1], uint64_t(-1));
+}
+
 TEST_F(TestPPWhiteBVGauss, elim_rewrite_for_urem_unique1)
 {
   /* -------------------------------------------------------------------
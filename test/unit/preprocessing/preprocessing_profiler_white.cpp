@@ -0,0 +1,145 @@
+/*********************                                                        */
+/*! \file preprocessing_profiler_white.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of cvc5::preprocessing::PreprocessingProfiler.
+ **
+ ** White box testing of cvc5::preprocessing::PreprocessingProfiler.
+ **/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_profiler.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/rewriter.h"
+#include "theory/smt_engine_subsolver.h"
+
+namespace cvc5 {
+
+using namespace preprocessing;
+using namespace smt;
+using namespace theory;
+
+namespace test {
+
+class TestPPWhitePreprocessingProfiler : public TestSmtNoFinishInit
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmtNoFinishInit::SetUp();
+    char filename[] = "/tmp/cvc4_pp_profile.XXXXXX";
+    int32_t fd = mkstemp(filename);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    d_filename = filename;
+  }
+
+  void TearDown() override { remove(d_filename.c_str()); }
+
+  /** Returns the content of the report file. */
+  std::string readReport() const
+  {
+    std::ifstream in(d_filename);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  /** The formula x + 1 > 2 for an integer variable x. */
+  Node mkFormula()
+  {
+    Node x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+    Node one = d_nodeManager->mkConst(Rational(1));
+    Node two = d_nodeManager->mkConst(Rational(2));
+    return d_nodeManager->mkNode(
+        kind::GT, d_nodeManager->mkNode(kind::PLUS, x, one), two);
+  }
+
+  std::string d_filename;
+};
+
+TEST_F(TestPPWhitePreprocessingProfiler, record_invocation)
+{
+  d_smtEngine->finishInit();
+  SmtScope scope(d_smtEngine.get());
+  Rewriter* rr = d_smtEngine->getRewriter();
+  Node f = mkFormula();
+
+  // the hits in the rewrite caches are only counted while profiling
+  Rewriter::rewrite(f);
+  Rewriter::rewrite(f);
+  ASSERT_EQ(rr->getNumCacheHits(), 0);
+
+  {
+    PreprocessingProfiler profiler(d_filename, d_nodeManager.get(), rr);
+    AssertionPipeline assertions;
+    assertions.push_back(f);
+    PreprocessingProfiler::Scope profile(profiler, "test-pass", assertions);
+    assertions.replace(0, Rewriter::rewrite(f));
+    profile.finish(assertions, false);
+    ASSERT_GT(rr->getNumCacheHits(), 0);
+
+    std::stringstream ss;
+    profiler.toStreamJson(ss);
+    std::string report = ss.str();
+    ASSERT_EQ(report.find("{\"passes\": ["), 0);
+    ASSERT_NE(report.find("\"pass\": \"test-pass\""), std::string::npos);
+    ASSERT_NE(report.find("\"assertions_before\": 1"), std::string::npos);
+    ASSERT_NE(report.find("\"assertions_after\": 1"), std::string::npos);
+    ASSERT_NE(report.find("\"conflict\": false"), std::string::npos);
+  }
+
+  // the report is written when the profiler is destroyed
+  ASSERT_NE(readReport().find("\"pass\": \"test-pass\""), std::string::npos);
+}
+
+TEST_F(TestPPWhitePreprocessingProfiler, solver_report)
+{
+  d_smtEngine->setOption("pp-profile", d_filename);
+  d_smtEngine->setLogic("QF_LIA");
+  d_smtEngine->assertFormula(mkFormula());
+  ASSERT_TRUE(d_smtEngine->checkSat().isSat() == Result::SAT);
+  d_smtEngine.reset();
+  std::string report = readReport();
+  ASSERT_EQ(report.find("{\"passes\": ["), 0);
+  ASSERT_NE(report.find("\"pass\": "), std::string::npos);
+}
+
+TEST_F(TestPPWhitePreprocessingProfiler, subsolver_no_report)
+{
+  d_smtEngine->setOption("pp-profile", d_filename);
+  d_smtEngine->setLogic("QF_LIA");
+  d_smtEngine->finishInit();
+  {
+    SmtScope scope(d_smtEngine.get());
+    std::unique_ptr<SmtEngine> subsolver;
+    initializeSubsolver(subsolver);
+    subsolver->assertFormula(mkFormula());
+    ASSERT_TRUE(subsolver->checkSat().isSat() == Result::SAT);
+  }
+  // the subsolver inherits the option, but does not write a report
+  ASSERT_TRUE(readReport().empty());
+  d_smtEngine.reset();
+  ASSERT_EQ(readReport().find("{\"passes\": ["), 0);
+}
+}  // namespace test
+}  // namespace cvc5
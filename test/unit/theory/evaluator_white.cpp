@@ -155,5 +155,50 @@ TEST_F(TestTheoryWhiteEvaluator, code)
     ASSERT_EQ(r, d_nodeManager->mkConst(Rational(-1)));
   }
 }
+
+TEST_F(TestTheoryWhiteEvaluator, prepared)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  Node x = d_nodeManager->mkBoundVar("x", intType);
+  Node y = d_nodeManager->mkBoundVar("y", intType);
+  Node one = d_nodeManager->mkConst(Rational(1));
+
+  // (ite (< x y) (+ x 1) (* y y))
+  Node t = d_nodeManager->mkNode(
+      kind::ITE,
+      d_nodeManager->mkNode(kind::LT, x, y),
+      d_nodeManager->mkNode(kind::PLUS, x, one),
+      d_nodeManager->mkNode(kind::MULT, y, y));
+  std::vector<Node> args = {x, y};
+
+  PreparedEvaluator peval;
+  ASSERT_TRUE(peval.prepare(t, args));
+  ASSERT_EQ(peval.getTerm(), t);
+  // the same prepared term is evaluated under several substitutions
+  for (int32_t i = -2; i <= 2; ++i)
+  {
+    for (int32_t j = -2; j <= 2; ++j)
+    {
+      std::vector<Node> vals = {d_nodeManager->mkConst(Rational(i)),
+                                d_nodeManager->mkConst(Rational(j))};
+      Node r = peval.eval(vals);
+      ASSERT_EQ(r,
+                Rewriter::rewrite(t.substitute(
+                    args.begin(), args.end(), vals.begin(), vals.end())));
+    }
+  }
+
+  // a value that is not a constant
+  Node z = d_nodeManager->mkVar("z", intType);
+  ASSERT_TRUE(peval.eval({z, one}).isNull());
+
+  // free variables and applications of uninterpreted functions cannot be
+  // prepared
+  ASSERT_FALSE(peval.prepare(d_nodeManager->mkNode(kind::PLUS, x, z), args));
+  TypeNode fType = d_nodeManager->mkFunctionType(intType, intType);
+  Node f = d_nodeManager->mkVar("f", fType);
+  ASSERT_FALSE(
+      peval.prepare(d_nodeManager->mkNode(kind::APPLY_UF, f, x), args));
+}
 }  // namespace test
 }  // namespace cvc5
@@ -0,0 +1,222 @@
+/*********************                                                        */
+/*! \file persistent_rewrite_cache_white.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of cvc5::theory::PersistentRewriteCache.
+ **
+ ** White box testing of cvc5::theory::PersistentRewriteCache.
+ **/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "options/options.h"
+#include "test_smt.h"
+#include "theory/logic_info.h"
+#include "theory/persistent_rewrite_cache.h"
+#include "util/hash.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+
+namespace test {
+
+class TestTheoryWhitePersistentRewriteCache : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    char filename[] = "/tmp/cvc4_rewrite_cache.XXXXXX";
+    int32_t fd = mkstemp(filename);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    d_filename = filename;
+    d_x = d_nodeManager->mkVar("x", d_nodeManager->integerType());
+    d_zero = d_nodeManager->mkConst(Rational(0));
+    d_one = d_nodeManager->mkConst(Rational(1));
+  }
+
+  void TearDown() override { remove(d_filename.c_str()); }
+
+  /** Append a record mapping n to the encoded value val to the file. */
+  void appendRecord(TNode n, const std::string& val)
+  {
+    std::string key;
+    std::vector<TNode> dag;
+    ASSERT_TRUE(PersistentRewriteCache::encodeKey(n, key, dag));
+    PersistentRewriteCache::RecordHeader h;
+    h.d_magic = 0x31435752;
+    h.d_keyLen = static_cast<uint32_t>(key.size());
+    h.d_valLen = static_cast<uint32_t>(val.size());
+    h.d_fingerprint = d_fingerprint;
+    h.d_hash = PersistentRewriteCache::structuralHash(n);
+    uint64_t checksum = h.d_hash;
+    for (char c : key + val)
+    {
+      checksum = fnv1a::fnv1a_64(static_cast<unsigned char>(c), checksum);
+    }
+    h.d_checksum = static_cast<uint32_t>(checksum);
+    std::ofstream out(d_filename, std::ios::binary | std::ios::app);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out << key << val;
+  }
+
+  /** Append a 32-bit number to s. */
+  static void putU32(std::string& s, uint32_t v)
+  {
+    s.append(reinterpret_cast<const char*>(&v), sizeof(v));
+  }
+
+  /** The encoding of a constant value of kind k with the given payload. */
+  static std::string mkConstValue(Kind k, const std::string& payload)
+  {
+    std::string val(1, 'C');
+    putU32(val, static_cast<uint32_t>(k));
+    putU32(val, static_cast<uint32_t>(payload.size()));
+    return val + payload;
+  }
+
+  std::string d_filename;
+  uint64_t d_fingerprint = 42;
+  Node d_x;
+  Node d_zero;
+  Node d_one;
+};
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, store_lookup)
+{
+  Node n = d_nodeManager->mkNode(PLUS, d_x, d_zero);
+  Node m = d_nodeManager->mkNode(PLUS, d_x, d_one);
+  Node c = d_nodeManager->mkNode(PLUS, d_one, d_one);
+  {
+    PersistentRewriteCache cache(d_filename, d_fingerprint);
+    ASSERT_TRUE(cache.isOpen());
+    cache.store(n, d_x);
+    cache.store(c, d_nodeManager->mkConst(Rational(2)));
+    // records are visible the next time the file is opened
+    ASSERT_TRUE(cache.lookup(n).isNull());
+  }
+  {
+    PersistentRewriteCache cache(d_filename, d_fingerprint);
+    ASSERT_EQ(cache.lookup(n), d_x);
+    ASSERT_EQ(cache.lookup(c), d_nodeManager->mkConst(Rational(2)));
+    ASSERT_TRUE(cache.lookup(m).isNull());
+  }
+  {
+    // records of other fingerprints are ignored
+    PersistentRewriteCache cache(d_filename, d_fingerprint + 1);
+    ASSERT_TRUE(cache.lookup(n).isNull());
+  }
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, fingerprint)
+{
+  Options opts;
+  LogicInfo lia("QF_LIA");
+  LogicInfo bv("QF_BV");
+  ASSERT_EQ(PersistentRewriteCache::computeFingerprint(opts, lia),
+            PersistentRewriteCache::computeFingerprint(opts, lia));
+  ASSERT_NE(PersistentRewriteCache::computeFingerprint(opts, lia),
+            PersistentRewriteCache::computeFingerprint(opts, bv));
+  // the logic need not be locked
+  LogicInfo unlocked;
+  unlocked.enableTheory(THEORY_ARITH);
+  PersistentRewriteCache::computeFingerprint(opts, unlocked);
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, truncated)
+{
+  Node n = d_nodeManager->mkNode(PLUS, d_x, d_zero);
+  {
+    PersistentRewriteCache cache(d_filename, d_fingerprint);
+    cache.store(n, d_x);
+  }
+  // a partially written record
+  std::ofstream(d_filename, std::ios::binary | std::ios::app) << "RWC1abc";
+  PersistentRewriteCache cache(d_filename, d_fingerprint);
+  ASSERT_EQ(cache.lookup(n), d_x);
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, malformed_constant)
+{
+  std::string s;
+  putU32(s, 0x41);
+  putU32(s, 0xffffffff);
+  std::vector<std::pair<Kind, std::string>> payloads = {
+      {CONST_BOOLEAN, "2"},
+      {CONST_RATIONAL, ""},
+      {CONST_RATIONAL, "abc"},
+      {CONST_RATIONAL, "1/0"},
+      {CONST_RATIONAL, "1/-2"},
+      {CONST_BITVECTOR, "4"},
+      {CONST_BITVECTOR, "x 12"},
+      {CONST_BITVECTOR, "99999999999999999999 1"},
+      {CONST_BITVECTOR, "0 0"},
+      {CONST_BITVECTOR, "4 -1"},
+      {CONST_BITVECTOR, "4 16"},
+      {CONST_STRING, "abc"},
+      {CONST_STRING, s},
+      {BOUND_VARIABLE, "x"}};
+  Node n = d_nodeManager->mkNode(PLUS, d_x, d_zero);
+  Node m = d_nodeManager->mkNode(PLUS, d_x, d_one);
+  for (const std::pair<Kind, std::string>& p : payloads)
+  {
+    remove(d_filename.c_str());
+    appendRecord(n, mkConstValue(p.first, p.second));
+    appendRecord(m, mkConstValue(CONST_RATIONAL, "7"));
+    PersistentRewriteCache cache(d_filename, d_fingerprint);
+    ASSERT_TRUE(cache.lookup(n).isNull()) << p.second;
+    // the records after a malformed one are discarded
+    ASSERT_TRUE(cache.lookup(m).isNull()) << p.second;
+  }
+  // a well-formed record
+  remove(d_filename.c_str());
+  appendRecord(n, mkConstValue(CONST_BITVECTOR, "4 15"));
+  appendRecord(m, mkConstValue(CONST_RATIONAL, "7"));
+  PersistentRewriteCache cache(d_filename, d_fingerprint);
+  ASSERT_EQ(cache.lookup(m), d_nodeManager->mkConst(Rational(7)));
+}
+
+TEST_F(TestTheoryWhitePersistentRewriteCache, ill_typed)
+{
+  Node n = d_nodeManager->mkNode(PLUS, d_x, d_zero);
+  Node m = d_nodeManager->mkNode(PLUS, d_x, d_one);
+  // (not x) for the integer x
+  std::string notX(1, 'R');
+  putU32(notX, 0);
+  notX.push_back('N');
+  putU32(notX, static_cast<uint32_t>(NOT));
+  putU32(notX, 1);
+  putU32(notX, 0);
+  // a value of another type
+  std::string boolValue = mkConstValue(CONST_BOOLEAN, "1");
+  for (const std::string& val : {notX, boolValue})
+  {
+    remove(d_filename.c_str());
+    appendRecord(n, val);
+    appendRecord(m, mkConstValue(CONST_RATIONAL, "7"));
+    PersistentRewriteCache cache(d_filename, d_fingerprint);
+    ASSERT_TRUE(cache.lookup(n).isNull());
+    ASSERT_TRUE(cache.lookup(m).isNull());
+  }
+}
+}  // namespace test
+}  // namespace cvc5
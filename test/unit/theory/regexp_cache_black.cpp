@@ -0,0 +1,88 @@
+/*********************                                                        */
+/*! \file regexp_cache_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::strings::RegExpCache.
+ **
+ ** Black box testing of cvc5::theory::strings::RegExpCache.
+ **/
+
+#include "test.h"
+#include "theory/strings/regexp_cache.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+
+using namespace theory::strings;
+
+namespace test {
+
+class TestTheoryBlackRegExpCache : public TestInternal
+{
+ protected:
+  TestTheoryBlackRegExpCache()
+      : d_hits("hits", 0), d_misses("misses", 0), d_clears("clears", 0)
+  {
+    d_stats.d_hits = &d_hits;
+    d_stats.d_misses = &d_misses;
+    d_stats.d_clears = &d_clears;
+  }
+
+  IntStat d_hits;
+  IntStat d_misses;
+  IntStat d_clears;
+  RegExpCacheStats d_stats;
+};
+
+TEST_F(TestTheoryBlackRegExpCache, find_insert)
+{
+  RegExpCache<int32_t, int32_t> cache(0, d_stats);
+  ASSERT_EQ(cache.find(1), nullptr);
+  cache.insert(1, 10);
+  cache.insert(2, 20);
+  ASSERT_EQ(*cache.find(1), 10);
+  cache.insert(1, 11);
+  ASSERT_EQ(*cache.find(1), 11);
+  ASSERT_EQ(cache.size(), 2);
+  // an unbounded cache is never cleared
+  for (int32_t i = 3; i < 1000; ++i)
+  {
+    cache.insert(i, i);
+  }
+  ASSERT_EQ(cache.size(), 999);
+  ASSERT_EQ(*cache.find(2), 20);
+#ifdef CVC4_STATISTICS_ON
+  ASSERT_EQ(d_hits.get(), 3);
+  ASSERT_EQ(d_misses.get(), 1);
+  ASSERT_EQ(d_clears.get(), 0);
+#endif
+}
+
+TEST_F(TestTheoryBlackRegExpCache, capacity)
+{
+  RegExpCache<int32_t, int32_t> cache(3, d_stats);
+  cache.insert(1, 1);
+  cache.insert(2, 2);
+  cache.insert(3, 3);
+  // updating a value of a full cache keeps the other values
+  cache.insert(2, 4);
+  ASSERT_EQ(cache.size(), 3);
+  ASSERT_EQ(*cache.find(2), 4);
+  // inserting a new key in a full cache clears it first
+  cache.insert(4, 4);
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(cache.find(1), nullptr);
+  ASSERT_EQ(*cache.find(4), 4);
+#ifdef CVC4_STATISTICS_ON
+  ASSERT_EQ(d_clears.get(), 1);
+#endif
+}
+}  // namespace test
+}  // namespace cvc5
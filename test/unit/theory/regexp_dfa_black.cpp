@@ -0,0 +1,168 @@
+/*********************                                                        */
+/*! \file regexp_dfa_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::strings::RegExpDfa.
+ **
+ ** Black box testing of cvc5::theory::strings::RegExpDfa and
+ ** cvc5::theory::strings::RegExpDfaCache.
+ **/
+
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "test_smt.h"
+#include "theory/strings/regexp_dfa.h"
+#include "util/regexp.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory::strings;
+
+namespace test {
+
+class TestTheoryBlackRegExpDfa : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_a = mkStr("a");
+    d_b = mkStr("b");
+    d_abc = mkStr("abc");
+    d_sigma = d_nodeManager->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+    d_digit = d_nodeManager->mkNode(REGEXP_RANGE,
+                                    d_nodeManager->mkConst(String("0")),
+                                    d_nodeManager->mkConst(String("9")));
+  }
+
+  /** Returns the regular expression of the constant string s. */
+  Node mkStr(const std::string& s)
+  {
+    return d_nodeManager->mkNode(STRING_TO_REGEXP,
+                                 d_nodeManager->mkConst(String(s)));
+  }
+
+  /** Returns whether s is in the language of r, which must be supported. */
+  bool test(RegExpDfa& dfa, const std::string& s, size_t index_start = 0)
+  {
+    bool result = false;
+    EXPECT_TRUE(dfa.test(String(s), index_start, result));
+    return result;
+  }
+
+  Node d_a;
+  Node d_b;
+  Node d_abc;
+  Node d_sigma;
+  Node d_digit;
+};
+
+TEST_F(TestTheoryBlackRegExpDfa, test)
+{
+  // (a | b)* abc
+  Node r = d_nodeManager->mkNode(
+      REGEXP_CONCAT,
+      d_nodeManager->mkNode(REGEXP_STAR,
+                            d_nodeManager->mkNode(REGEXP_UNION, d_a, d_b)),
+      d_abc);
+  RegExpDfa dfa(r);
+  ASSERT_TRUE(dfa.isSupported());
+  ASSERT_TRUE(test(dfa, "abc"));
+  ASSERT_TRUE(test(dfa, "ababbabc"));
+  ASSERT_FALSE(test(dfa, "ab"));
+  ASSERT_FALSE(test(dfa, "abca"));
+  ASSERT_FALSE(test(dfa, "cabc"));
+  // only the suffix starting at index_start is tested
+  ASSERT_TRUE(test(dfa, "cabc", 1));
+  ASSERT_FALSE(test(dfa, ""));
+
+  // the states built by the previous tests are reused
+  ASSERT_TRUE(test(dfa, "bbbabc"));
+}
+
+TEST_F(TestTheoryBlackRegExpDfa, ranges_and_loops)
+{
+  // [0-9]{2,3} . a*
+  Node r = d_nodeManager->mkNode(
+      REGEXP_CONCAT,
+      d_nodeManager->mkNode(d_nodeManager->mkConst(RegExpLoop(2, 3)), d_digit),
+      d_sigma,
+      d_nodeManager->mkNode(REGEXP_STAR, d_a));
+  RegExpDfa dfa(r);
+  ASSERT_TRUE(dfa.isSupported());
+  ASSERT_TRUE(test(dfa, "12x"));
+  ASSERT_TRUE(test(dfa, "123xaaa"));
+  ASSERT_TRUE(test(dfa, "1234"));
+  ASSERT_FALSE(test(dfa, "1x"));
+  ASSERT_FALSE(test(dfa, "12345"));
+  ASSERT_FALSE(test(dfa, "12xab"));
+
+  // the empty language
+  RegExpDfa empty(d_nodeManager->mkNode(REGEXP_EMPTY, std::vector<Node>{}));
+  ASSERT_TRUE(empty.isSupported());
+  ASSERT_FALSE(test(empty, ""));
+  ASSERT_FALSE(test(empty, "a"));
+}
+
+TEST_F(TestTheoryBlackRegExpDfa, unsupported)
+{
+  Node comp = d_nodeManager->mkNode(REGEXP_COMPLEMENT, d_a);
+  ASSERT_FALSE(RegExpDfa(comp).isSupported());
+  Node inter = d_nodeManager->mkNode(REGEXP_INTER, d_a, d_abc);
+  ASSERT_FALSE(RegExpDfa(d_nodeManager->mkNode(REGEXP_CONCAT, d_b, inter))
+                   .isSupported());
+
+  RegExpDfaCache cache;
+  bool result = false;
+  ASSERT_FALSE(cache.test(String("a"), 0, comp, result));
+  ASSERT_FALSE(cache.includes(comp, d_a, result));
+}
+
+TEST_F(TestTheoryBlackRegExpDfa, cache)
+{
+  RegExpDfaCache cache;
+  Node abStar = d_nodeManager->mkNode(
+      REGEXP_STAR, d_nodeManager->mkNode(REGEXP_UNION, d_a, d_b));
+  Node aStar = d_nodeManager->mkNode(REGEXP_STAR, d_a);
+  Node bPlus = d_nodeManager->mkNode(REGEXP_CONCAT,
+                                     d_b,
+                                     d_nodeManager->mkNode(REGEXP_STAR, d_b));
+  Node digits = d_nodeManager->mkNode(REGEXP_STAR, d_digit);
+
+  bool result = false;
+  ASSERT_TRUE(cache.test(String("abba"), 0, abStar, result));
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(cache.test(String("abc"), 0, abStar, result));
+  ASSERT_FALSE(result);
+
+  ASSERT_TRUE(cache.includes(abStar, aStar, result));
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(cache.includes(abStar, bPlus, result));
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(cache.includes(aStar, abStar, result));
+  ASSERT_FALSE(result);
+  ASSERT_TRUE(cache.includes(abStar, d_abc, result));
+  ASSERT_FALSE(result);
+
+  // a* and b+ share no word, a* and [0-9]* share the empty word
+  ASSERT_TRUE(cache.isIntersectionEmpty(aStar, bPlus, result));
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(cache.isIntersectionEmpty(aStar, digits, result));
+  ASSERT_FALSE(result);
+  ASSERT_TRUE(cache.isIntersectionEmpty(abStar, bPlus, result));
+  ASSERT_FALSE(result);
+}
+}  // namespace test
+}  // namespace cvc5
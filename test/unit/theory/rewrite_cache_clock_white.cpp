@@ -0,0 +1,143 @@
+/*********************                                                        */
+/*! \file rewrite_cache_clock_white.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of cvc5::theory::RewriteCacheClock.
+ **
+ ** White box testing of cvc5::theory::RewriteCacheClock.
+ **/
+
+#include <tuple>
+#include <vector>
+
+#include "expr/node.h"
+#include "test_node.h"
+#include "theory/rewrite_cache_clock.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+
+using namespace theory;
+
+namespace test {
+
+class TestTheoryWhiteRewriteCacheClock : public TestNode
+{
+ protected:
+  using Entry = std::tuple<bool, TheoryId, Node>;
+
+  void SetUp() override
+  {
+    TestNode::SetUp();
+    for (int32_t i = 0; i < 6; ++i)
+    {
+      d_nodes.push_back(d_nodeManager->mkConst(Rational(i)));
+    }
+  }
+
+  /** A clock with room for n entries, which records the evicted entries. */
+  RewriteCacheClock* mkClock(size_t n)
+  {
+    d_clock.reset(new RewriteCacheClock(
+        n * RewriteCacheClock::s_bytesPerEntry,
+        [this](bool pre, TheoryId tid, TNode node) {
+          d_evicted.emplace_back(pre, tid, node);
+        },
+        d_registry));
+    return d_clock.get();
+  }
+
+  StatisticsRegistry d_registry;
+  std::unique_ptr<RewriteCacheClock> d_clock;
+  std::vector<Entry> d_evicted;
+  std::vector<Node> d_nodes;
+};
+
+TEST_F(TestTheoryWhiteRewriteCacheClock, evict)
+{
+  RewriteCacheClock* clock = mkClock(3);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[0]);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[1]);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[2]);
+  // setting an entry again does not evict
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[0]);
+  ASSERT_TRUE(d_evicted.empty());
+
+  // all entries are referenced, the hand clears them and evicts the first
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[3]);
+  ASSERT_EQ(d_evicted,
+            std::vector<Entry>({Entry(false, THEORY_ARITH, d_nodes[0])}));
+
+  // a hit gives the entry a second chance
+  clock->notifyLookup(false, THEORY_ARITH, d_nodes[1], true);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[4]);
+  ASSERT_EQ(d_evicted.back(), Entry(false, THEORY_ARITH, d_nodes[2]));
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[5]);
+  ASSERT_EQ(d_evicted.back(), Entry(false, THEORY_ARITH, d_nodes[1]));
+  ASSERT_EQ(d_evicted.size(), 3);
+  ASSERT_EQ(d_clock->d_evictions.get(), 3);
+}
+
+TEST_F(TestTheoryWhiteRewriteCacheClock, keys)
+{
+  RewriteCacheClock* clock = mkClock(3);
+  // the pre- and post-rewrite entries of a node for a theory are distinct
+  clock->notifyInsert(true, THEORY_BOOL, d_nodes[0]);
+  clock->notifyInsert(false, THEORY_BOOL, d_nodes[0]);
+  clock->notifyInsert(false, THEORY_UF, d_nodes[0]);
+  ASSERT_TRUE(d_evicted.empty());
+  clock->notifyInsert(true, THEORY_UF, d_nodes[0]);
+  ASSERT_EQ(d_evicted,
+            std::vector<Entry>({Entry(true, THEORY_BOOL, d_nodes[0])}));
+}
+
+TEST_F(TestTheoryWhiteRewriteCacheClock, lookups_and_clear)
+{
+  RewriteCacheClock* clock = mkClock(2);
+  clock->notifyLookup(false, THEORY_ARITH, d_nodes[0], false);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[0]);
+  clock->notifyLookup(false, THEORY_ARITH, d_nodes[0], true);
+  clock->notifyLookup(false, THEORY_ARITH, d_nodes[0], true);
+  ASSERT_EQ(d_clock->d_hits.get(), 2);
+  ASSERT_EQ(d_clock->d_misses.get(), 1);
+
+  // entries are forgotten without being evicted
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[1]);
+  clock->clear();
+  ASSERT_TRUE(d_clock->d_index.empty());
+  // hits of entries set before clear() are counted but not tracked
+  clock->notifyLookup(false, THEORY_ARITH, d_nodes[0], true);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[2]);
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[3]);
+  ASSERT_TRUE(d_evicted.empty());
+  clock->notifyInsert(false, THEORY_ARITH, d_nodes[4]);
+  ASSERT_EQ(d_evicted,
+            std::vector<Entry>({Entry(false, THEORY_ARITH, d_nodes[2])}));
+  ASSERT_EQ(d_clock->d_hits.get(), 3);
+}
+
+TEST_F(TestTheoryWhiteRewriteCacheClock, capacity)
+{
+  // a budget below the size of an entry still allows one entry
+  d_clock.reset(new RewriteCacheClock(
+      1,
+      [this](bool pre, TheoryId tid, TNode node) {
+        d_evicted.emplace_back(pre, tid, node);
+      },
+      d_registry));
+  d_clock->notifyInsert(false, THEORY_ARITH, d_nodes[0]);
+  ASSERT_TRUE(d_evicted.empty());
+  d_clock->notifyInsert(false, THEORY_ARITH, d_nodes[1]);
+  ASSERT_EQ(d_evicted,
+            std::vector<Entry>({Entry(false, THEORY_ARITH, d_nodes[0])}));
+}
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file rewriter_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::Rewriter.
+ **
+ ** Black box testing of cvc5::theory::Rewriter.
+ **/
+
+#include <vector>
+
+#include "expr/node.h"
+#include "test_smt.h"
+#include "theory/rewriter.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+
+namespace test {
+
+class TestTheoryBlackRewriter : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_x = d_nodeManager->mkSkolem("x", d_nodeManager->integerType());
+    d_b = d_nodeManager->mkSkolem("b", d_nodeManager->booleanType());
+    d_zero = d_nodeManager->mkConst(Rational(0));
+    d_one = d_nodeManager->mkConst(Rational(1));
+  }
+
+  Node d_x;
+  Node d_b;
+  Node d_zero;
+  Node d_one;
+};
+
+TEST_F(TestTheoryBlackRewriter, rewrite_all)
+{
+  Node plus = d_nodeManager->mkNode(PLUS, d_x, d_zero);
+  Node geq = d_nodeManager->mkNode(
+      GEQ, d_nodeManager->mkNode(PLUS, d_x, d_one), d_x);
+  Node ite = d_nodeManager->mkNode(ITE, d_b, d_x, plus);
+  Node conj = d_nodeManager->mkNode(AND, d_b, d_nodeManager->mkConst(true));
+  std::vector<Node> nodes = {plus, geq, d_x, ite, plus, conj, d_one, geq};
+  std::vector<Node> expected;
+  for (const Node& n : nodes)
+  {
+    expected.push_back(Rewriter::rewrite(n));
+  }
+  Rewriter::rewriteAll(nodes);
+  ASSERT_EQ(nodes, expected);
+  ASSERT_EQ(nodes[0], d_x);
+  ASSERT_EQ(nodes[1], d_nodeManager->mkConst(true));
+  ASSERT_EQ(nodes[3], d_x);
+  ASSERT_EQ(nodes[5], d_b);
+
+  // rewriting again is the identity
+  Rewriter::rewriteAll(nodes);
+  ASSERT_EQ(nodes, expected);
+
+  std::vector<Node> empty;
+  Rewriter::rewriteAll(empty);
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST_F(TestTheoryBlackRewriter, deep)
+{
+  // deep terms reuse the elements of the stack of the rewriter
+  Node sum = d_x;
+  Node neg = d_b;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    sum = d_nodeManager->mkNode(PLUS, d_one, sum);
+    neg = d_nodeManager->mkNode(NOT, neg);
+  }
+  Node expected = Rewriter::rewrite(d_nodeManager->mkNode(
+      PLUS, d_nodeManager->mkConst(Rational(10000)), d_x));
+  ASSERT_EQ(Rewriter::rewrite(sum), expected);
+  ASSERT_EQ(Rewriter::rewrite(neg), d_b);
+
+  std::vector<Node> nodes = {neg, sum, d_nodeManager->mkNode(NOT, neg)};
+  Rewriter::rewriteAll(nodes);
+  ASSERT_EQ(nodes,
+            std::vector<Node>({d_b, expected, d_nodeManager->mkNode(NOT, d_b)}));
+}
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file theory_arith_int64_rational_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::arith::Int64Rational.
+ **
+ ** Black box testing of cvc5::theory::arith::Int64Rational and
+ ** cvc5::theory::arith::Int64DeltaRational.
+ **/
+
+#include <cstdint>
+#include <limits>
+
+#include "test.h"
+#include "theory/arith/delta_rational.h"
+#include "theory/arith/int64_rational.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory::arith;
+
+namespace test {
+
+class TestTheoryArithBlackInt64Rational : public TestInternal
+{
+ protected:
+  static Int64Rational mk(const char* s)
+  {
+    return Int64Rational::fromRational(Rational(s));
+  }
+};
+
+TEST_F(TestTheoryArithBlackInt64Rational, arithmetic)
+{
+  Int64Rational a = mk("1/3");
+  Int64Rational b = mk("-5/6");
+  ASSERT_EQ((a + b).toRational(), Rational(-1, 2));
+  ASSERT_EQ((a - b).toRational(), Rational(7, 6));
+  ASSERT_EQ((a * b).toRational(), Rational(-5, 18));
+  ASSERT_EQ((a / b).toRational(), Rational(-2, 5));
+  ASSERT_EQ((-b).toRational(), Rational(5, 6));
+  ASSERT_EQ((Int64Rational(1) / mk("-4")).toRational(), Rational(-1, 4));
+  // the results are in lowest terms
+  ASSERT_EQ(mk("1/2") + mk("1/2"), Int64Rational(1));
+  ASSERT_TRUE((a - a).isZero());
+  ASSERT_EQ((a - a).sgn(), 0);
+  ASSERT_EQ(b.sgn(), -1);
+}
+
+TEST_F(TestTheoryArithBlackInt64Rational, comparisons)
+{
+  Int64Rational a = mk("1/3");
+  Int64Rational b = mk("-5/6");
+  ASSERT_TRUE(b < a);
+  ASSERT_TRUE(a > b);
+  ASSERT_TRUE(a <= a);
+  ASSERT_TRUE(a >= b);
+  ASSERT_FALSE(a < a);
+  ASSERT_TRUE(a != b);
+  // cross products that do not fit in 64 bits are compared exactly
+  Int64Rational c = mk("9223372036854775807/9223372036854775806");
+  Int64Rational d = mk("9223372036854775806/9223372036854775805");
+  ASSERT_TRUE(c < d);
+}
+
+TEST_F(TestTheoryArithBlackInt64Rational, overflow)
+{
+  ASSERT_FALSE(mk("9223372036854775808").isValid());
+  ASSERT_FALSE(mk("1/9223372036854775808").isValid());
+  Int64Rational max(std::numeric_limits<int64_t>::max());
+  Int64Rational min(std::numeric_limits<int64_t>::min());
+  ASSERT_TRUE(max.isValid());
+  ASSERT_FALSE((max + Int64Rational(1)).isValid());
+  ASSERT_FALSE((min - Int64Rational(1)).isValid());
+  ASSERT_FALSE((-min).isValid());
+  ASSERT_FALSE((max * Int64Rational(2)).isValid());
+  ASSERT_FALSE((Int64Rational(1) / Int64Rational(0)).isValid());
+  // an intermediate result that does not fit is reduced
+  ASSERT_EQ(max * (Int64Rational(1) / max), Int64Rational(1));
+  ASSERT_EQ((max / Int64Rational(2)) * Int64Rational(2), max);
+  // an invalid operand makes the result invalid
+  Int64Rational inv = Int64Rational::invalid();
+  ASSERT_FALSE(inv.isValid());
+  ASSERT_FALSE(inv.isZero());
+  ASSERT_FALSE((inv + Int64Rational(1)).isValid());
+  ASSERT_FALSE((Int64Rational(0) * inv).isValid());
+  ASSERT_FALSE((-inv).isValid());
+}
+
+TEST_F(TestTheoryArithBlackInt64Rational, delta_rational)
+{
+  DeltaRational d(Rational(3, 2), Rational(-1));
+  Int64DeltaRational a = Int64DeltaRational::fromDeltaRational(d);
+  ASSERT_TRUE(a.isValid());
+  ASSERT_EQ(a.toDeltaRational(), d);
+  Int64DeltaRational b = Int64DeltaRational::fromDeltaRational(
+      DeltaRational(Rational(3, 2)));
+  // 3/2 - delta < 3/2
+  ASSERT_TRUE(a < b);
+  ASSERT_TRUE(b > a);
+  ASSERT_FALSE(b < b);
+  ASSERT_EQ((a + b).toDeltaRational(),
+            DeltaRational(Rational(3), Rational(-1)));
+  ASSERT_EQ((a - b).toDeltaRational(),
+            DeltaRational(Rational(0), Rational(-1)));
+  ASSERT_EQ((mk("2") * a).toDeltaRational(),
+            DeltaRational(Rational(3), Rational(-2)));
+  ASSERT_EQ((a / mk("-3")).toDeltaRational(),
+            DeltaRational(Rational(-1, 2), Rational(1, 3)));
+  ASSERT_FALSE(Int64DeltaRational::fromDeltaRational(
+                   DeltaRational(Rational(0), Rational("9223372036854775808")))
+                   .isValid());
+  ASSERT_FALSE((a / mk("0")).isValid());
+}
+}  // namespace test
+}  // namespace cvc5
@@ -135,5 +135,57 @@ TEST_F(TestTheoryWhiteIntOpt, result)
 
   std::cout << "Result is :" << r << std::endl;
 }
+
+TEST_F(TestTheoryWhiteIntOpt, binary)
+{
+  Node ub = d_nodeManager->mkConst(Rational("1000"));
+  Node lb = d_nodeManager->mkConst(Rational("0"));
+
+  Node max_cost = d_nodeManager->mkVar(*d_intType);
+
+  Node upb = d_nodeManager->mkNode(kind::GT, ub, max_cost);
+  Node lowb = d_nodeManager->mkNode(kind::GT, max_cost, lb);
+
+  /* Result of asserts is:
+      0 < max_cost < 1000
+  */
+  d_smtEngine->assertFormula(upb);
+  d_smtEngine->assertFormula(lowb);
+
+  OptimizationSolver optslv(d_smtEngine.get(), OPT_SEARCH_BINARY);
+  optslv.activateObj(max_cost, OBJECTIVE_MAXIMIZE);
+
+  OptResult r = optslv.checkOpt();
+
+  ASSERT_EQ(r, OPT_OPTIMAL);
+  // We expect max_cost == 999
+  ASSERT_EQ(optslv.objectiveGetValue(),
+            d_nodeManager->mkConst(Rational("999")));
+}
+
+TEST_F(TestTheoryWhiteIntOpt, soft)
+{
+  Node x = d_nodeManager->mkVar(*d_intType);
+  Node zero = d_nodeManager->mkConst(Rational("0"));
+  Node ten = d_nodeManager->mkConst(Rational("10"));
+
+  // 0 <= x <= 10
+  d_smtEngine->assertFormula(d_nodeManager->mkNode(kind::LEQ, zero, x));
+  d_smtEngine->assertFormula(d_nodeManager->mkNode(kind::LEQ, x, ten));
+
+  // at most two of x = 0, x = 10 and x > 5 can be satisfied
+  d_optslv->addSoftConstraint(d_nodeManager->mkNode(kind::EQUAL, x, zero));
+  d_optslv->addSoftConstraint(d_nodeManager->mkNode(kind::EQUAL, x, ten));
+  Node five = d_nodeManager->mkConst(Rational("5"));
+  d_optslv->addSoftConstraint(d_nodeManager->mkNode(kind::GT, x, five));
+  d_optslv->activateObj(x, OBJECTIVE_MINIMIZE);
+
+  OptResult r = d_optslv->checkOpt();
+
+  ASSERT_EQ(r, OPT_OPTIMAL);
+  ASSERT_EQ(d_optslv->softConstraintsGetCost(),
+            d_nodeManager->mkConst(Rational("1")));
+  ASSERT_EQ(d_optslv->objectiveGetValue(), ten);
+}
 }  // namespace test
 }  // namespace cvc5
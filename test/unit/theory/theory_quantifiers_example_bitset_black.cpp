@@ -0,0 +1,126 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_example_bitset_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::quantifiers::ExampleBitset.
+ **
+ ** Black box testing of cvc5::theory::quantifiers::ExampleBitset.
+ **/
+
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "test_smt.h"
+#include "theory/quantifiers/sygus/example_bitset.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory::quantifiers;
+
+namespace test {
+
+class TestTheoryBlackQuantifiersExampleBitset : public TestSmt
+{
+ protected:
+  /** Make the set of size indices containing the elements of elems. */
+  static ExampleBitset mkSet(size_t size, const std::vector<size_t>& elems)
+  {
+    ExampleBitset s(size, false);
+    for (size_t i : elems)
+    {
+      s.set(i, true);
+    }
+    return s;
+  }
+};
+
+TEST_F(TestTheoryBlackQuantifiersExampleBitset, construct)
+{
+  // sizes below, at and beyond a word boundary
+  for (size_t size : {0, 1, 63, 64, 65, 130})
+  {
+    ExampleBitset empty(size, false);
+    ExampleBitset full(size, true);
+    ASSERT_EQ(empty.size(), size);
+    ASSERT_EQ(full.size(), size);
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.count(), 0);
+    ASSERT_EQ(full.count(), size);
+    ASSERT_EQ(full.empty(), size == 0);
+    for (size_t i = 0; i < size; i++)
+    {
+      ASSERT_FALSE(empty.get(i));
+      ASSERT_TRUE(full.get(i));
+    }
+    ASSERT_TRUE(empty.isSubsetOf(full));
+    ASSERT_EQ(full.isSubsetOf(empty), size == 0);
+  }
+}
+
+TEST_F(TestTheoryBlackQuantifiersExampleBitset, set_and_count)
+{
+  ExampleBitset s = mkSet(100, {0, 5, 63, 64, 99});
+  ASSERT_EQ(s.count(), 5);
+  ASSERT_TRUE(s.get(63));
+  ASSERT_TRUE(s.get(64));
+  ASSERT_FALSE(s.get(62));
+  s.set(63, false);
+  s.set(5, true);
+  ASSERT_EQ(s.count(), 4);
+  ASSERT_FALSE(s.get(63));
+  ASSERT_EQ(s, mkSet(100, {0, 5, 64, 99}));
+  ASSERT_NE(s, mkSet(100, {0, 5, 64}));
+  // sets of different sizes are different
+  ASSERT_NE(ExampleBitset(3, false), ExampleBitset(4, false));
+}
+
+TEST_F(TestTheoryBlackQuantifiersExampleBitset, operations)
+{
+  ExampleBitset a = mkSet(70, {1, 2, 3, 65, 69});
+  ExampleBitset b = mkSet(70, {2, 3, 4, 65});
+  ExampleBitset c = mkSet(70, {3, 4, 65, 69});
+  ASSERT_EQ(a.countAnd(b), 3);
+  // a & b & c = {3, 65}
+  ASSERT_EQ(a.countAnd(b, true, c), 2);
+  // a & ~b & c = {69}, the complement does not add indices beyond the size
+  ASSERT_EQ(a.countAnd(b, false, c), 1);
+  ASSERT_EQ(ExampleBitset(70, true).countAnd(b, false, ExampleBitset(70, true)),
+            66);
+
+  ExampleBitset i = a;
+  i &= b;
+  ASSERT_EQ(i, mkSet(70, {2, 3, 65}));
+  ASSERT_TRUE(i.isSubsetOf(a));
+  ASSERT_TRUE(i.isSubsetOf(b));
+  ASSERT_FALSE(a.isSubsetOf(b));
+  ExampleBitset u = a;
+  u |= b;
+  ASSERT_EQ(u, mkSet(70, {1, 2, 3, 4, 65, 69}));
+  ASSERT_TRUE(a.isSubsetOf(u));
+
+  ExampleBitsetHashFunction h;
+  ASSERT_EQ(h(i), h(mkSet(70, {2, 3, 65})));
+}
+
+TEST_F(TestTheoryBlackQuantifiersExampleBitset, true_set)
+{
+  Node t = d_nodeManager->mkConst(true);
+  Node f = d_nodeManager->mkConst(false);
+  Node one = d_nodeManager->mkConst(Rational(1));
+  Node x = d_nodeManager->mkBoundVar("x", d_nodeManager->booleanType());
+  // only the constant true is in the set
+  ExampleBitset s = ExampleBitset::mkTrueSet({t, f, Node::null(), t, one, x});
+  ASSERT_EQ(s, mkSet(6, {0, 3}));
+  ASSERT_TRUE(ExampleBitset::mkTrueSet({}).empty());
+}
+}  // namespace test
+}  // namespace cvc5
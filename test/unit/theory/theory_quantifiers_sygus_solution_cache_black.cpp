@@ -0,0 +1,163 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_sygus_solution_cache_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::quantifiers::SygusSolutionCache.
+ **
+ ** Black box testing of cvc5::theory::quantifiers::SygusSolutionCache.
+ **/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expr/dtype.h"
+#include "expr/dtype_cons.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "test_smt.h"
+#include "theory/quantifiers/sygus/sygus_solution_cache.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory::quantifiers;
+
+namespace test {
+
+class TestTheoryBlackQuantifiersSygusSolutionCache : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    char filename[] = "/tmp/cvc4_sygus_solution_cache.XXXXXX";
+    int32_t fd = mkstemp(filename);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    d_filename = filename;
+    // (declare-datatype E ((none) (num (n Int)) (flag (b Bool))))
+    DType e("E");
+    std::shared_ptr<DTypeConstructor> none =
+        std::make_shared<DTypeConstructor>("none");
+    std::shared_ptr<DTypeConstructor> num =
+        std::make_shared<DTypeConstructor>("num");
+    num->addArg("n", d_nodeManager->integerType());
+    std::shared_ptr<DTypeConstructor> flag =
+        std::make_shared<DTypeConstructor>("flag");
+    flag->addArg("b", d_nodeManager->booleanType());
+    e.addConstructor(none);
+    e.addConstructor(num);
+    e.addConstructor(flag);
+    d_eType = d_nodeManager->mkDatatypeType(e);
+    // (declare-datatype P ((pair (fst E) (snd (_ BitVec 4)))))
+    DType p("P");
+    std::shared_ptr<DTypeConstructor> pair =
+        std::make_shared<DTypeConstructor>("pair");
+    pair->addArg("fst", d_eType);
+    pair->addArg("snd", d_nodeManager->mkBitVectorType(4));
+    p.addConstructor(pair);
+    d_pType = d_nodeManager->mkDatatypeType(p);
+  }
+
+  void TearDown() override { remove(d_filename.c_str()); }
+
+  /** Make the application of the i^th constructor of tn to children. */
+  Node mkApply(TypeNode tn, size_t i, const std::vector<Node>& children = {})
+  {
+    std::vector<Node> args;
+    args.push_back(tn.getDType()[i].getConstructor());
+    args.insert(args.end(), children.begin(), children.end());
+    return d_nodeManager->mkNode(APPLY_CONSTRUCTOR, args);
+  }
+
+  std::string d_filename;
+  TypeNode d_eType;
+  TypeNode d_pType;
+};
+
+TEST_F(TestTheoryBlackQuantifiersSygusSolutionCache, store_lookup)
+{
+  Node num = mkApply(d_eType, 1, {d_nodeManager->mkConst(Rational(-3))});
+  Node flag = mkApply(d_eType, 2, {d_nodeManager->mkConst(true)});
+  Node pair =
+      mkApply(d_pType, 0, {num, d_nodeManager->mkConst(BitVector(4, 11u))});
+  std::vector<TypeNode> types = {d_pType, d_eType};
+  std::vector<Node> sols;
+  {
+    SygusSolutionCache cache(d_filename);
+    ASSERT_FALSE(cache.lookup("k1", types, sols));
+    cache.store("k1", {pair, flag});
+    cache.store("k2", {mkApply(d_eType, 0)});
+    ASSERT_TRUE(cache.lookup("k1", types, sols));
+    ASSERT_EQ(sols, std::vector<Node>({pair, flag}));
+  }
+  // the solutions are read from the file by another cache
+  SygusSolutionCache cache(d_filename);
+  sols.clear();
+  ASSERT_TRUE(cache.lookup("k1", types, sols));
+  ASSERT_EQ(sols, std::vector<Node>({pair, flag}));
+  sols.clear();
+  ASSERT_TRUE(cache.lookup("k2", {d_eType}, sols));
+  ASSERT_EQ(sols, std::vector<Node>({mkApply(d_eType, 0)}));
+  sols.clear();
+  ASSERT_FALSE(cache.lookup("k3", {d_eType}, sols));
+}
+
+TEST_F(TestTheoryBlackQuantifiersSygusSolutionCache, overwrite)
+{
+  Node none = mkApply(d_eType, 0);
+  Node flag = mkApply(d_eType, 2, {d_nodeManager->mkConst(false)});
+  {
+    SygusSolutionCache cache(d_filename);
+    cache.store("k", {none});
+    cache.store("k", {flag});
+  }
+  // later entries take precedence
+  SygusSolutionCache cache(d_filename);
+  std::vector<Node> sols;
+  ASSERT_TRUE(cache.lookup("k", {d_eType}, sols));
+  ASSERT_EQ(sols, std::vector<Node>({flag}));
+}
+
+TEST_F(TestTheoryBlackQuantifiersSygusSolutionCache, malformed)
+{
+  std::ofstream(d_filename) << "index ( 5 )\n"
+                            << "real ( 1 1/2 )\n"
+                            << "unterminated ( 1 7\n"
+                            << "types ( 0 ( 0 ) 3 )\n"
+                            << "no_space\n";
+  SygusSolutionCache cache(d_filename);
+  std::vector<Node> sols;
+  // a constructor index that is out of range
+  ASSERT_FALSE(cache.lookup("index", {d_eType}, sols));
+  // a non-integral value of an integer argument
+  ASSERT_FALSE(cache.lookup("real", {d_eType}, sols));
+  ASSERT_FALSE(cache.lookup("unterminated", {d_eType}, sols));
+  ASSERT_FALSE(cache.lookup("no_space", {d_eType}, sols));
+  // the solution does not conform to the types
+  ASSERT_FALSE(cache.lookup("types", {d_eType}, sols));
+  ASSERT_TRUE(sols.empty());
+  ASSERT_TRUE(cache.lookup("types", {d_pType}, sols));
+  ASSERT_EQ(sols,
+            std::vector<Node>({mkApply(
+                d_pType,
+                0,
+                {mkApply(d_eType, 0),
+                 d_nodeManager->mkConst(BitVector(4, 3u))})}));
+}
+}  // namespace test
+}  // namespace cvc5
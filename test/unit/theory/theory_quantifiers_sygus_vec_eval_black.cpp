@@ -0,0 +1,126 @@
+/*********************                                                        */
+/*! \file theory_quantifiers_sygus_vec_eval_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::theory::quantifiers::SygusVecEvaluator.
+ **
+ ** Black box testing of cvc5::theory::quantifiers::SygusVecEvaluator.
+ **/
+
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "test_smt.h"
+#include "theory/quantifiers/sygus/sygus_vec_eval.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory::quantifiers;
+
+namespace test {
+
+class TestTheoryBlackQuantifiersSygusVecEval : public TestSmt
+{
+ protected:
+  Node mkInt(int64_t i) { return d_nodeManager->mkConst(Rational(i)); }
+  Node mkBv(unsigned width, uint64_t v)
+  {
+    return d_nodeManager->mkConst(BitVector(width, v));
+  }
+};
+
+TEST_F(TestTheoryBlackQuantifiersSygusVecEval, integers)
+{
+  Node x = d_nodeManager->mkBoundVar("x", d_nodeManager->integerType());
+  Node y = d_nodeManager->mkBoundVar("y", d_nodeManager->integerType());
+  // ite(x < y, x + 2 * y, x - y)
+  Node n = d_nodeManager->mkNode(
+      ITE,
+      d_nodeManager->mkNode(LT, x, y),
+      d_nodeManager->mkNode(PLUS, x, d_nodeManager->mkNode(MULT, mkInt(2), y)),
+      d_nodeManager->mkNode(MINUS, x, y));
+  SygusVecEvaluator eval;
+  ASSERT_TRUE(eval.compile(n, {x, y}));
+  std::vector<Node> out;
+  ASSERT_TRUE(eval.evaluate(
+      {{mkInt(1), mkInt(2)}, {mkInt(5), mkInt(-3)}, {mkInt(-4), mkInt(-4)}},
+      out));
+  ASSERT_EQ(out, std::vector<Node>({mkInt(5), mkInt(8), mkInt(0)}));
+
+  // a Boolean term
+  Node b = d_nodeManager->mkNode(OR,
+                                 d_nodeManager->mkNode(GEQ, x, y),
+                                 d_nodeManager->mkNode(EQUAL, x, mkInt(0)));
+  ASSERT_TRUE(eval.compile(b, {x, y}));
+  out.clear();
+  ASSERT_TRUE(eval.evaluate({{mkInt(0), mkInt(1)}, {mkInt(1), mkInt(2)}}, out));
+  ASSERT_EQ(out,
+            std::vector<Node>(
+                {d_nodeManager->mkConst(true), d_nodeManager->mkConst(false)}));
+}
+
+TEST_F(TestTheoryBlackQuantifiersSygusVecEval, bitvectors)
+{
+  TypeNode bv8 = d_nodeManager->mkBitVectorType(8);
+  Node x = d_nodeManager->mkBoundVar("x", bv8);
+  Node y = d_nodeManager->mkBoundVar("y", bv8);
+  // bvadd(x, bvshl(y, 1)), which wraps around
+  Node n = d_nodeManager->mkNode(
+      BITVECTOR_PLUS, x, d_nodeManager->mkNode(BITVECTOR_SHL, y, mkBv(8, 1)));
+  SygusVecEvaluator eval;
+  ASSERT_TRUE(eval.compile(n, {x, y}));
+  std::vector<Node> out;
+  ASSERT_TRUE(eval.evaluate(
+      {{mkBv(8, 3), mkBv(8, 4)}, {mkBv(8, 0xff), mkBv(8, 0x81)}}, out));
+  ASSERT_EQ(out, std::vector<Node>({mkBv(8, 11), mkBv(8, 0x01)}));
+
+  // signed and unsigned comparisons differ on negative values
+  Node c = d_nodeManager->mkNode(
+      AND,
+      d_nodeManager->mkNode(BITVECTOR_SLT, x, y),
+      d_nodeManager->mkNode(BITVECTOR_UGT, x, y));
+  ASSERT_TRUE(eval.compile(c, {x, y}));
+  out.clear();
+  ASSERT_TRUE(eval.evaluate(
+      {{mkBv(8, 0x80), mkBv(8, 1)}, {mkBv(8, 1), mkBv(8, 2)}}, out));
+  ASSERT_EQ(out,
+            std::vector<Node>(
+                {d_nodeManager->mkConst(true), d_nodeManager->mkConst(false)}));
+}
+
+TEST_F(TestTheoryBlackQuantifiersSygusVecEval, unsupported)
+{
+  Node x = d_nodeManager->mkBoundVar("x", d_nodeManager->integerType());
+  Node y = d_nodeManager->mkBoundVar("y", d_nodeManager->integerType());
+  SygusVecEvaluator eval;
+  std::vector<Node> out;
+  // not compiled
+  ASSERT_FALSE(eval.evaluate({{mkInt(1), mkInt(1)}}, out));
+  // an unsupported operator
+  Node div = d_nodeManager->mkNode(INTS_DIVISION, x, y);
+  ASSERT_FALSE(eval.compile(div, {x, y}));
+  // an unsupported type
+  TypeNode bv128 = d_nodeManager->mkBitVectorType(128);
+  Node z = d_nodeManager->mkBoundVar("z", bv128);
+  ASSERT_FALSE(eval.compile(z, {z}));
+
+  // an overflow, and a value that does not fit in a machine word
+  ASSERT_TRUE(eval.compile(d_nodeManager->mkNode(MULT, x, y), {x, y}));
+  ASSERT_FALSE(eval.evaluate({{mkInt(INT64_MAX), mkInt(2)}}, out));
+  Node big = d_nodeManager->mkConst(Rational(Integer("100000000000000000000")));
+  ASSERT_FALSE(eval.evaluate({{big, mkInt(1)}}, out));
+  ASSERT_TRUE(out.empty());
+}
+}  // namespace test
+}  // namespace cvc5
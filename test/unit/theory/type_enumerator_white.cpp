@@ -241,6 +241,18 @@ TEST_F(TestTheoryWhiteTypeEnumerator, dtypes_infinite)
                 red,
                 d_nodeManager->mkNode(APPLY_CONSTRUCTOR, cons, orange, nil)));
   ASSERT_FALSE(te.isFinished());
+
+  // a new enumerator starts over, using the values enumerated by te
+  TypeEnumerator te2(listColorsType);
+  ASSERT_EQ(*te2, nil);
+  ASSERT_EQ(*++te2, d_nodeManager->mkNode(APPLY_CONSTRUCTOR, cons, red, nil));
+  for (size_t i = 0; i < 6; i++)
+  {
+    ++te2;
+  }
+  ASSERT_EQ(*te2, *te);
+  ASSERT_EQ(*++te2, *++te);
+  ASSERT_FALSE(te2.isFinished());
 }
 
 TEST_F(TestTheoryWhiteTypeEnumerator, arrays_infinite)
@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file async_ostream_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::AsyncOstream.
+ **
+ ** Black box testing of cvc5::AsyncOstream.
+ **/
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include "smt/async_ostream.h"
+#include "test.h"
+
+namespace cvc5 {
+namespace test {
+
+/**
+ * A stream buffer collecting the characters written to it, which may be read
+ * while another thread writes to it.
+ */
+class SyncStringBuf : public std::streambuf
+{
+ public:
+  std::string str()
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_str;
+  }
+
+ protected:
+  std::streamsize xsputn(const char* s, std::streamsize n) override
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_str.append(s, n);
+    return n;
+  }
+  int_type overflow(int_type c) override
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      char ch = traits_type::to_char_type(c);
+      xsputn(&ch, 1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+ private:
+  std::mutex d_mutex;
+  std::string d_str;
+};
+
+class TestUtilBlackAsyncOstream : public TestInternal
+{
+ protected:
+  /** Wait until the target contains s, for at most a minute */
+  bool waitFor(SyncStringBuf& buf, const std::string& s)
+  {
+    for (size_t i = 0; i < 60000; ++i)
+    {
+      if (buf.str() == s)
+      {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+};
+
+TEST_F(TestUtilBlackAsyncOstream, close)
+{
+  SyncStringBuf buf;
+  std::ostream target(&buf);
+  std::stringstream expected;
+  {
+    AsyncOstream out(&target, false, 16, 64);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      out << "line " << i << "\n";
+      expected << "line " << i << "\n";
+    }
+  }
+  ASSERT_EQ(buf.str(), expected.str());
+}
+
+TEST_F(TestUtilBlackAsyncOstream, flush)
+{
+  SyncStringBuf buf;
+  std::ostream target(&buf);
+  AsyncOstream out(&target, false);
+  // the flushed characters are written before the chunk is full
+  out << "(assert a)" << std::endl;
+  ASSERT_TRUE(waitFor(buf, "(assert a)\n"));
+  out << "(assert b)" << std::flush;
+  ASSERT_TRUE(waitFor(buf, "(assert a)\n(assert b)"));
+  // characters that are not flushed yet are written when the stream is
+  // destroyed
+  out << "(check-sat)\n";
+  ASSERT_EQ(buf.str(), "(assert a)\n(assert b)");
+}
+
+TEST_F(TestUtilBlackAsyncOstream, flush_small_chunks)
+{
+  SyncStringBuf buf;
+  std::ostream target(&buf);
+  std::stringstream expected;
+  {
+    AsyncOstream out(&target, false, 8, 32);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      out << i << std::endl;
+      expected << i << std::endl;
+    }
+  }
+  ASSERT_EQ(buf.str(), expected.str());
+}
+}  // namespace test
+}  // namespace cvc5
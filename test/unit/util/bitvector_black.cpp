@@ -202,5 +202,82 @@ TEST_F(TestUtilBlackBitVector, static_helpers)
   ASSERT_EQ(BitVector::mkMinSigned(4).toSignedInteger(), Integer(-8));
   ASSERT_EQ(BitVector::mkMaxSigned(4).toSignedInteger(), Integer(7));
 }
+
+TEST_F(TestUtilBlackBitVector, small_large_boundary)
+{
+  Integer two64 = Integer(1).multiplyByPow2(64);
+  BitVector ones64 = BitVector::mkOnes(64);
+  BitVector ones65 = BitVector::mkOnes(65);
+  ASSERT_EQ(ones64.getValue(), two64 - 1);
+  ASSERT_EQ(ones65.getValue(), two64.multiplyByPow2(1) - 1);
+
+  ASSERT_EQ(ones64 + BitVector::mkOne(64), BitVector::mkZero(64));
+  ASSERT_EQ(ones65 + BitVector::mkOne(65), BitVector::mkZero(65));
+  ASSERT_EQ(BitVector::mkMinSigned(64) * BitVector(64, 2u),
+            BitVector::mkZero(64));
+  ASSERT_EQ(BitVector(65, two64) * BitVector(65, 2u), BitVector::mkZero(65));
+  ASSERT_EQ(ones64.unsignedDivTotal(BitVector(64, 2u)),
+            BitVector::mkMaxSigned(64));
+  ASSERT_EQ(ones65.unsignedDivTotal(BitVector(65, 2u)),
+            BitVector::mkMaxSigned(65));
+  ASSERT_EQ(ones65.unsignedRemTotal(BitVector(65, two64)),
+            ones64.zeroExtend(1));
+  ASSERT_EQ(BitVector::mkMinSigned(64).toSignedInteger(),
+            -Integer(1).multiplyByPow2(63));
+  ASSERT_EQ(BitVector::mkMinSigned(65).toSignedInteger(), -two64);
+
+  ASSERT_EQ(BitVector::mkOne(64).leftShift(BitVector(64, 63u)),
+            BitVector::mkMinSigned(64));
+  ASSERT_EQ(BitVector::mkOne(65).leftShift(BitVector(65, 64u)),
+            BitVector::mkMinSigned(65));
+  ASSERT_EQ(BitVector::mkMinSigned(65).logicalRightShift(BitVector(65, 64u)),
+            BitVector::mkOne(65));
+  ASSERT_EQ(BitVector::mkMinSigned(65).arithRightShift(BitVector(65, 64u)),
+            ones65);
+
+  // results that cross the boundary between the two representations
+  BitVector ext = ones64.zeroExtend(1);
+  ASSERT_EQ(ext.getSize(), 65u);
+  ASSERT_EQ(ext.getValue(), two64 - 1);
+  ASSERT_EQ(ones64.signExtend(1), ones65);
+  ASSERT_EQ(ones65.extract(63, 0), ones64);
+  ASSERT_EQ(ones65.extract(64, 1), ones64);
+  ASSERT_EQ(BitVector(65, two64).extract(64, 64), BitVector::mkOne(1));
+  BitVector cat = BitVector::mkOne(33).concat(BitVector::mkOnes(32));
+  ASSERT_EQ(cat.getSize(), 65u);
+  ASSERT_EQ(cat.getValue(), Integer(1).multiplyByPow2(33) - 1);
+  ASSERT_EQ(BitVector::mkZero(1).concat(ones64), ext);
+  ASSERT_EQ(BitVector::mkOnes(32).concat(BitVector::mkOnes(32)), ones64);
+  ASSERT_EQ(BitVector(65, ones64), ext);
+  ASSERT_EQ(BitVector(64, ones65), ones64);
+  ASSERT_TRUE(ones64.zeroExtend(1) < ones65);
+  ASSERT_TRUE(ones65.signedLessThan(BitVector::mkZero(65)));
+  ASSERT_FALSE(ext.signedLessThan(BitVector::mkZero(65)));
+}
+
+TEST_F(TestUtilBlackBitVector, move)
+{
+  BitVector large = BitVector::mkOnes(65);
+  BitVector moved(std::move(large));
+  ASSERT_EQ(moved, BitVector::mkOnes(65));
+  // the moved-from bit-vector is the bit-vector of size 0
+  ASSERT_EQ(large.getSize(), 0u);
+  ASSERT_EQ(large.getValue(), Integer(0));
+  ASSERT_EQ(BitVector(large), BitVector());
+  large = BitVector::mkOne(65);
+  ASSERT_EQ(large, BitVector::mkOne(65));
+
+  BitVector small = BitVector::mkOne(64);
+  small = std::move(moved);
+  ASSERT_EQ(small, BitVector::mkOnes(65));
+  ASSERT_EQ(moved.getSize(), 0u);
+
+  BitVector other = d_two;
+  large = std::move(other);
+  ASSERT_EQ(large, d_two);
+  ASSERT_EQ(large.getValue(), Integer(2));
+  ASSERT_EQ(other.getSize(), 0u);
+  ASSERT_EQ((large + d_one).toString(), "0011");
+}
 }  // namespace test
 }  // namespace cvc5
@@ -14,16 +14,89 @@
  ** Black box testing of cvc5::FloatingPoint.
  **/
 
+#include <vector>
+
 #include "test.h"
 #include "util/floatingpoint.h"
+#include "util/floatingpoint_literal_symfpu.h"
 
 namespace cvc5 {
 namespace test {
 
 class TestUtilBlackFloatingPoint : public TestInternal
 {
+ protected:
+  /**
+   * Check that the operations on Float32 and Float64, which are evaluated
+   * natively, agree with their evaluation by symfpu on all pairs of values.
+   */
+  void checkNativeOps(const FloatingPointSize& size,
+                      const std::vector<uint64_t>& values)
+  {
+    std::vector<RoundingMode> rms = {ROUND_NEAREST_TIES_TO_EVEN,
+                                     ROUND_TOWARD_POSITIVE,
+                                     ROUND_TOWARD_NEGATIVE,
+                                     ROUND_TOWARD_ZERO};
+    for (uint64_t va : values)
+    {
+      FloatingPoint a(size, BitVector(size.packedWidth(), va));
+      const FloatingPointLiteral& la = *a.getLiteral();
+      for (uint64_t vb : values)
+      {
+        FloatingPoint b(size, BitVector(size.packedWidth(), vb));
+        const FloatingPointLiteral& lb = *b.getLiteral();
+        for (RoundingMode rm : rms)
+        {
+          ASSERT_TRUE(*a.plus(rm, b).getLiteral() == la.add(rm, lb));
+          ASSERT_TRUE(*a.sub(rm, b).getLiteral() == la.sub(rm, lb));
+          ASSERT_TRUE(*a.mult(rm, b).getLiteral() == la.mult(rm, lb));
+          ASSERT_TRUE(*a.div(rm, b).getLiteral() == la.div(rm, lb));
+          ASSERT_TRUE(*a.fma(rm, b, a).getLiteral() == la.fma(rm, lb, la));
+        }
+        ASSERT_TRUE(*a.rem(b).getLiteral() == la.rem(lb));
+      }
+      for (RoundingMode rm : rms)
+      {
+        ASSERT_TRUE(*a.sqrt(rm).getLiteral() == la.sqrt(rm));
+      }
+    }
+  }
 };
 
+TEST_F(TestUtilBlackFloatingPoint, nativeFloat32)
+{
+  checkNativeOps(FloatingPointSize(8, 24),
+                 {0x00000000,    // +0
+                  0x80000000,    // -0
+                  0x00000001,    // min. subnormal
+                  0x807fffff,    // -max. subnormal
+                  0x00800000,    // min. normal
+                  0x3f800000,    // 1
+                  0xbfc00000,    // -1.5
+                  0x3dcccccd,    // 0.1
+                  0x7f7fffff,    // max. normal
+                  0xff800000,    // -oo
+                  0x7f800000,    // +oo
+                  0x7fc00000});  // NaN
+}
+
+TEST_F(TestUtilBlackFloatingPoint, nativeFloat64)
+{
+  checkNativeOps(FloatingPointSize(11, 53),
+                 {0x0000000000000000,    // +0
+                  0x8000000000000000,    // -0
+                  0x0000000000000001,    // min. subnormal
+                  0x800fffffffffffff,    // -max. subnormal
+                  0x0010000000000000,    // min. normal
+                  0x3ff0000000000000,    // 1
+                  0xbff8000000000000,    // -1.5
+                  0x3fb999999999999a,    // 0.1
+                  0x7fefffffffffffff,    // max. normal
+                  0xfff0000000000000,    // -oo
+                  0x7ff0000000000000,    // +oo
+                  0x7ff8000000000000});  // NaN
+}
+
 TEST_F(TestUtilBlackFloatingPoint, makeMinSubnormal)
 {
   FloatingPointSize size16(5, 11);
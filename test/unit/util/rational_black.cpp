@@ -15,6 +15,7 @@
  **/
 
 #include <sstream>
+#include <utility>
 
 #include "test.h"
 #include "util/rational.h"
@@ -43,5 +44,55 @@ TEST_F(TestUtilBlackRational, fromDecimal)
   ASSERT_THROW(Rational::fromDecimal("1.2/3");, std::invalid_argument);
   ASSERT_THROW(Rational::fromDecimal("Hello, world!");, std::invalid_argument);
 }
+
+TEST_F(TestUtilBlackRational, arithmetic)
+{
+  Rational two(2);
+  Rational three(3);
+  Rational half(1, 2);
+  Rational third(-1, 3);
+  Rational big("123456789012345678901234567890");
+
+  // integral operands
+  ASSERT_EQ(two + three, Rational(5));
+  ASSERT_EQ(two - three, Rational(-1));
+  ASSERT_EQ(two * three, Rational(6));
+  ASSERT_EQ(big - big, Rational(0));
+  ASSERT_TRUE((big * three).isIntegral());
+  ASSERT_EQ((big + two) - big, two);
+
+  // non-integral operands
+  ASSERT_EQ(two + half, Rational(5, 2));
+  ASSERT_EQ(half + half, Rational(1));
+  ASSERT_TRUE((half + half).isIntegral());
+  ASSERT_EQ(half - third, Rational(5, 6));
+  ASSERT_EQ(third * three, Rational(-1));
+  ASSERT_EQ((third * three).getDenominator(), Integer(1));
+  ASSERT_EQ(two / Rational(4), half);
+  ASSERT_EQ(-third, Rational(1, 3));
+  ASSERT_EQ(-two, Rational(-2));
+
+  // constructions are canonical
+  ASSERT_EQ(Rational(4, 6), Rational(2, 3));
+  ASSERT_EQ(Rational(Integer(-7)).getDenominator(), Integer(1));
+  ASSERT_EQ(Rational(-3, -6).getNumerator(), Integer(1));
+}
+
+TEST_F(TestUtilBlackRational, move)
+{
+  Rational a(7, 3);
+  Rational b(std::move(a));
+  ASSERT_EQ(b, Rational(7, 3));
+  Rational c;
+  c = std::move(b);
+  ASSERT_EQ(c, Rational(7, 3));
+  // moved from values remain usable
+  a = Rational(1, 2);
+  ASSERT_EQ(a + c, Rational(17, 6));
+
+  Integer i("98765432109876543210");
+  Integer j(std::move(i));
+  ASSERT_EQ(j, Integer("98765432109876543210"));
+}
 }  // namespace test
 }  // namespace cvc5
@@ -25,6 +25,7 @@
 #include "test.h"
 #include "util/statistics_registry.h"
 #include "util/stats_histogram.h"
+#include "util/stats_series.h"
 #include "util/stats_timer.h"
 
 namespace cvc5 {
@@ -160,5 +161,20 @@ TEST_F(TestUtilBlackStats, stats)
   ASSERT_EQ(ret, 0);
 #endif
 }
+
+TEST_F(TestUtilBlackStats, series)
+{
+#ifdef CVC4_STATISTICS_ON
+  SeriesStat<uint64_t> series("series");
+  std::stringstream ss;
+  series.flushInformation(ss);
+  ASSERT_EQ(ss.str(), "[]");
+
+  series << 1 << 2 << 3;
+  ss.str("");
+  series.flushInformation(ss);
+  ASSERT_EQ(ss.str(), "[1, 2, 3]");
+#endif
+}
 }  // namespace test
 }  // namespace cvc5
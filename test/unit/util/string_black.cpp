@@ -0,0 +1,106 @@
+/*********************                                                        */
+/*! \file string_black.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ ** in the top-level source directory and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of cvc5::String.
+ **
+ ** Black box testing of cvc5::String.
+ **/
+
+#include <string>
+#include <vector>
+
+#include "test.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace test {
+
+class TestUtilBlackString : public TestInternal
+{
+};
+
+TEST_F(TestUtilBlackString, compare)
+{
+  String abc("abc");
+  String abd("abd");
+  String ab("ab");
+  ASSERT_EQ(abc, String("abc"));
+  ASSERT_NE(abc, abd);
+  ASSERT_LT(abc, abd);
+  ASSERT_GT(abd, abc);
+  // shorter strings are smaller
+  ASSERT_LT(abd, String("aaaa"));
+  ASSERT_LE(ab, abc);
+
+  // characters beyond the range of char are compared by their code points
+  String high(std::vector<unsigned>{0x100, 0x61});
+  String low(std::vector<unsigned>{0xff, 0x62});
+  ASSERT_GT(high, low);
+
+  ASSERT_TRUE(abc.strncmp(abd, 2));
+  ASSERT_FALSE(abc.strncmp(abd, 3));
+  ASSERT_FALSE(abc.strncmp(ab, 3));
+  ASSERT_TRUE(abc.strncmp(String("abc"), 5));
+  ASSERT_TRUE(abc.rstrncmp(String("xbc"), 2));
+  ASSERT_FALSE(abc.rstrncmp(abd, 1));
+  ASSERT_TRUE(abc.hasPrefix(ab));
+  ASSERT_TRUE(abc.hasPrefix(String()));
+  ASSERT_FALSE(ab.hasPrefix(abc));
+  ASSERT_TRUE(abc.hasSuffix(String("bc")));
+  ASSERT_FALSE(abc.hasSuffix(ab));
+}
+
+TEST_F(TestUtilBlackString, find)
+{
+  String s("abcabcab");
+  ASSERT_EQ(s.find(String("bc")), 1);
+  ASSERT_EQ(s.find(String("bc"), 2), 4);
+  ASSERT_EQ(s.find(String("bca"), 5), std::string::npos);
+  ASSERT_EQ(s.find(String("ab"), 6), 6);
+  ASSERT_EQ(s.find(String("abd")), std::string::npos);
+  ASSERT_EQ(s.find(String(), 3), 3);
+  ASSERT_EQ(String().find(String("a")), std::string::npos);
+
+  // rfind returns the distance from the end of the last occurrence to the
+  // end of the string
+  ASSERT_EQ(s.rfind(String("ab")), 0);
+  ASSERT_EQ(s.rfind(String("bc")), 2);
+  ASSERT_EQ(s.rfind(String("bc"), 3), 5);
+  ASSERT_EQ(s.rfind(String("ca"), 6), std::string::npos);
+  ASSERT_EQ(s.rfind(String("abcabcab")), 0);
+  ASSERT_EQ(s.rfind(String("x")), std::string::npos);
+}
+
+TEST_F(TestUtilBlackString, concat_substr)
+{
+  String abc("abc");
+  ASSERT_EQ(abc.concat(String("de")), String("abcde"));
+  ASSERT_EQ(abc.concat(String()), abc);
+  ASSERT_EQ(String().concat(abc), abc);
+  ASSERT_EQ(abc.substr(1), String("bc"));
+  ASSERT_EQ(abc.substr(1, 1), String("b"));
+  ASSERT_EQ(abc.substr(3), String());
+  ASSERT_EQ(abc.prefix(2), String("ab"));
+  ASSERT_EQ(abc.suffix(2), String("bc"));
+}
+
+TEST_F(TestUtilBlackString, hash)
+{
+  strings::StringHashFunction h;
+  ASSERT_EQ(h(String("abc")), h(String("abc")));
+  ASSERT_NE(h(String("abc")), h(String("acb")));
+  ASSERT_NE(h(String("a")), h(String()));
+  // characters beyond the range of char are hashed by their code points
+  ASSERT_NE(h(String(std::vector<unsigned>{0x100})),
+            h(String(std::vector<unsigned>{0x101})));
+}
+}  // namespace test
+}  // namespace cvc5